@@ -122,6 +122,16 @@ macro(dune_probe_cxx)
         set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -pg")
       endif(PROFILE)
 
+      # Binaries specialized for one configuration drop unreferenced code.
+      if(TASK_CONFIG)
+        check_cxx_compiler_flag("-ffunction-sections -fdata-sections" has_function_sections)
+        if(has_function_sections)
+          set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -ffunction-sections -fdata-sections")
+          set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -ffunction-sections -fdata-sections")
+          set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -Wl,--gc-sections")
+        endif(has_function_sections)
+      endif(TASK_CONFIG)
+
       set(DUNE_CXX_FLAGS_STRICT "-Wall -Wshadow -pedantic")
       set(DUNE_CXX_FLAGS_LOOSE  "")
       set(DUNE_CXX_FLAGS_DEBUG  "")
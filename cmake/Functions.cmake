@@ -170,6 +170,12 @@ macro(dune_probe_functions)
     "signal.h"
     DUNE_SYS_HAS_PTHREAD_KILL)
 
+  dune_test_function(pthread_setaffinity_np
+    "int"
+    "pthread_t;size_t;cpu_set_t*"
+    "pthread.h;sched.h"
+    DUNE_SYS_HAS_PTHREAD_SETAFFINITY_NP)
+
   dune_test_function(pthread_barrier_init
     "int"
     "pthread_barrier_t*;pthread_barrierattr_t*;unsigned"
@@ -206,6 +212,12 @@ macro(dune_probe_functions)
     "pthread.h"
     DUNE_SYS_HAS_PTHREAD_CONDATTR_SETCLOCK)
 
+  dune_test_function(pthread_getcpuclockid
+    "int"
+    "pthread_t;clockid_t*"
+    "pthread.h"
+    DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
+
   dune_test_function(sigaction
     "int"
     "int;struct sigaction*;struct sigaction*"
@@ -470,6 +482,18 @@ macro(dune_probe_functions)
     "sys/types.h;sys/socket.h;winsock2.h"
     DUNE_SYS_HAS_SOCKET)
 
+  dune_test_function(sendmmsg
+    "int"
+    "int;mmsghdr*;unsigned int;int"
+    "sys/socket.h"
+    DUNE_SYS_HAS_SENDMMSG)
+
+  dune_test_function(recvmmsg
+    "int"
+    "int;mmsghdr*;unsigned int;int;struct timespec*"
+    "sys/socket.h;time.h"
+    DUNE_SYS_HAS_RECVMMSG)
+
   dune_test_function(WSAStartup
     "int"
     "WORD;WSADATA*"
@@ -686,12 +710,48 @@ macro(dune_probe_functions)
     ""
     DUNE_SYS_HAS___SYNC_SUB_AND_FETCH)
 
+  dune_test_function(__sync_bool_compare_and_swap
+    "bool"
+    "int*;int;int"
+    ""
+    DUNE_SYS_HAS___SYNC_BOOL_COMPARE_AND_SWAP)
+
+  dune_test_function(__sync_synchronize
+    "void"
+    ""
+    ""
+    DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+
+  dune_test_function(__atomic_fetch_add
+    "int"
+    "int*;int;int"
+    ""
+    DUNE_SYS_HAS___ATOMIC_FETCH_ADD)
+
+  dune_test_function(__atomic_compare_exchange_n
+    "bool"
+    "int*;int*;int;bool;int;int"
+    ""
+    DUNE_SYS_HAS___ATOMIC_COMPARE_EXCHANGE_N)
+
   dune_test_function(fork
     "pid_t"
     ""
     "unistd.h"
     DUNE_SYS_HAS_FORK)
 
+  dune_test_function(link
+    "int"
+    "char*;char*"
+    "unistd.h"
+    DUNE_SYS_HAS_LINK)
+
+  dune_test_function(fdatasync
+    "int"
+    "int"
+    "unistd.h"
+    DUNE_SYS_HAS_FDATASYNC)
+
   dune_test_function(shm_unlink
     "int"
     "char*"
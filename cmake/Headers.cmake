@@ -106,6 +106,8 @@ macro(dune_probe_headers)
   dune_test_header(linux/i2c.h)
   dune_test_header(linux/rtc.h)
   dune_test_header(linux/input.h)
+  dune_test_header(linux/netlink.h)
+  dune_test_header(linux/rtnetlink.h)
   dune_test_header(netdb.h)
   dune_test_header(pthread.h)
   dune_test_header(signal.h)
@@ -117,6 +119,9 @@ macro(dune_probe_headers)
   dune_test_header(sys/stat.h)
   dune_test_header(sys/statfs.h)
   dune_test_header(sys/sendfile.h)
+  dune_test_header(sys/epoll.h)
+  dune_test_header(sys/inotify.h)
+  dune_test_header(sys/timerfd.h)
   dune_test_header(sys/time.h)
   dune_test_header(sys/types.h)
   dune_test_header(sys/file.h)
@@ -152,6 +157,7 @@ macro(dune_probe_headers)
   dune_test_header_deps(netinet/in.h "sys/types.h")
   dune_test_header_deps(netinet/tcp.h "sys/types.h")
   dune_test_header_deps(sys/select.h "sys/types.h")
+  dune_test_header_deps(sys/event.h "sys/types.h")
   dune_test_header_deps(sys/sysctl.h "sys/types.h")
   dune_test_header_deps(sys/resource.h "sys/types.h")
   dune_test_header_deps(sys/mman.h "sys/types.h")
@@ -0,0 +1,41 @@
+############################################################################
+# Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      #
+# Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  #
+############################################################################
+# This file is part of DUNE: Unified Navigation Environment.               #
+#                                                                          #
+# Commercial Licence Usage                                                 #
+# Licencees holding valid commercial DUNE licences may use this file in    #
+# accordance with the commercial licence agreement provided with the       #
+# Software or, alternatively, in accordance with the terms contained in a  #
+# written agreement between you and Universidade do Porto. For licensing   #
+# terms, conditions, and further information contact lsts@fe.up.pt.        #
+#                                                                          #
+# European Union Public Licence - EUPL v.1.1 Usage                         #
+# Alternatively, this file may be used under the terms of the EUPL,        #
+# Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       #
+# included in the packaging of this file. You may not use this work        #
+# except in compliance with the Licence. Unless required by applicable     #
+# law or agreed to in writing, software distributed under the Licence is   #
+# distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     #
+# ANY KIND, either express or implied. See the Licence for the specific    #
+# language governing permissions and limitations at                        #
+# https://www.lsts.pt/dune/licence.                                        #
+############################################################################
+# Author: Ricardo Martins                                                  #
+############################################################################
+
+# FFmpeg decodes the H.264 streams shown by the video client. It is
+# not linked with the DUNE library.
+CHECK_LIBRARY_EXISTS(avcodec avcodec_send_packet "" HAVE_LIB_AVCODEC)
+CHECK_LIBRARY_EXISTS(swscale sws_scale "" HAVE_LIB_SWSCALE)
+dune_test_header(libavcodec/avcodec.h)
+dune_test_header(libswscale/swscale.h)
+
+if(HAVE_LIB_AVCODEC AND HAVE_LIB_SWSCALE AND DUNE_SYS_HAS_LIBAVCODEC_AVCODEC_H AND DUNE_SYS_HAS_LIBSWSCALE_SWSCALE_H)
+  set(DUNE_USING_FFMPEG 1 CACHE INTERNAL "FFmpeg libraries")
+  set(DUNE_FFMPEG_LIBS avcodec swscale avutil CACHE INTERNAL "FFmpeg libraries")
+else(HAVE_LIB_AVCODEC AND HAVE_LIB_SWSCALE AND DUNE_SYS_HAS_LIBAVCODEC_AVCODEC_H AND DUNE_SYS_HAS_LIBSWSCALE_SWSCALE_H)
+  set(DUNE_USING_FFMPEG 0 CACHE INTERNAL "FFmpeg libraries")
+  set(DUNE_FFMPEG_LIBS "" CACHE INTERNAL "FFmpeg libraries")
+endif(HAVE_LIB_AVCODEC AND HAVE_LIB_SWSCALE AND DUNE_SYS_HAS_LIBAVCODEC_AVCODEC_H AND DUNE_SYS_HAS_LIBSWSCALE_SWSCALE_H)
@@ -0,0 +1,99 @@
+############################################################################
+# Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      #
+# Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  #
+############################################################################
+# This file is part of DUNE: Unified Navigation Environment.               #
+#                                                                          #
+# Commercial Licence Usage                                                 #
+# Licencees holding valid commercial DUNE licences may use this file in    #
+# accordance with the commercial licence agreement provided with the       #
+# Software or, alternatively, in accordance with the terms contained in a  #
+# written agreement between you and Universidade do Porto. For licensing   #
+# terms, conditions, and further information contact lsts@fe.up.pt.        #
+#                                                                          #
+# European Union Public Licence - EUPL v.1.1 Usage                         #
+# Alternatively, this file may be used under the terms of the EUPL,        #
+# Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       #
+# included in the packaging of this file. You may not use this work        #
+# except in compliance with the Licence. Unless required by applicable     #
+# law or agreed to in writing, software distributed under the Licence is   #
+# distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     #
+# ANY KIND, either express or implied. See the Licence for the specific    #
+# language governing permissions and limitations at                        #
+# https://www.lsts.pt/dune/licence.                                        #
+############################################################################
+# Author: Ricardo Martins                                                  #
+############################################################################
+
+# Collect the 'Enabled' assignments of a configuration file, in the
+# order they are parsed, as a list of '<section>=<profiles>' entries.
+# [Require ...] and [Include ...] directives are followed relative to
+# the including file, as in DUNE::Parsers::Config.
+function(dune_parse_task_config file var)
+  if(NOT EXISTS ${file})
+    message(FATAL_ERROR "configuration file not found: ${file}")
+  endif(NOT EXISTS ${file})
+
+  get_filename_component(dir ${file} PATH)
+  file(STRINGS ${file} lines REGEX "^[ \t]*(\\[|Enabled[ \t]*=)")
+  set(section)
+  set(entries)
+
+  foreach(line ${lines})
+    if(line MATCHES "^[ \t]*\\[(Require|Include)[ \t]+([^]]+)\\]")
+      string(STRIP "${CMAKE_MATCH_2}" child)
+      set(section)
+      if(CMAKE_MATCH_1 STREQUAL "Include" AND NOT EXISTS ${dir}/${child})
+        message(WARNING "configuration file not found: ${dir}/${child}")
+      else()
+        dune_parse_task_config(${dir}/${child} child_entries)
+        list(APPEND entries ${child_entries})
+      endif()
+    elseif(line MATCHES "^[ \t]*\\[([^]]+)\\]")
+      string(STRIP "${CMAKE_MATCH_1}" section)
+    elseif(section AND line MATCHES "=[ \t]*([^#;]*)")
+      string(STRIP "${CMAKE_MATCH_1}" profiles)
+      list(APPEND entries "${section}=${profiles}")
+    endif()
+  endforeach(line ${lines})
+
+  set(${var} ${entries} PARENT_SCOPE)
+endfunction(dune_parse_task_config file var)
+
+# Load a configuration file and set DUNE_CONFIG_TASKS to the labels of
+# the tasks it may instantiate, i.e., those with at least one section
+# whose final 'Enabled' value is not 'Never'. Relative paths are
+# resolved against 'etc' and then the build directory.
+macro(dune_load_task_config file)
+  if(IS_ABSOLUTE "${file}")
+    set(cfg_file ${file})
+  elseif(EXISTS ${PROJECT_SOURCE_DIR}/etc/${file})
+    set(cfg_file ${PROJECT_SOURCE_DIR}/etc/${file})
+  else()
+    set(cfg_file ${CMAKE_CURRENT_BINARY_DIR}/${file})
+  endif()
+
+  dune_parse_task_config(${cfg_file} cfg_entries)
+
+  set(cfg_sections)
+  foreach(cfg_entry ${cfg_entries})
+    string(REGEX REPLACE "=.*$" "" cfg_section "${cfg_entry}")
+    string(REGEX REPLACE "^[^=]*=" "" cfg_profiles "${cfg_entry}")
+    string(MAKE_C_IDENTIFIER "${cfg_section}" cfg_key)
+    set(cfg_enabled_${cfg_key} "${cfg_profiles}")
+    list(APPEND cfg_sections ${cfg_section})
+  endforeach(cfg_entry ${cfg_entries})
+
+  set(DUNE_CONFIG_TASKS)
+  foreach(cfg_section ${cfg_sections})
+    string(MAKE_C_IDENTIFIER "${cfg_section}" cfg_key)
+    if(NOT "${cfg_enabled_${cfg_key}}" STREQUAL "Never")
+      string(REGEX REPLACE "/.*$" "" cfg_label "${cfg_section}")
+      list(APPEND DUNE_CONFIG_TASKS ${cfg_label})
+    endif()
+  endforeach(cfg_section ${cfg_sections})
+
+  if(DUNE_CONFIG_TASKS)
+    list(REMOVE_DUPLICATES DUNE_CONFIG_TASKS)
+  endif(DUNE_CONFIG_TASKS)
+endmacro(dune_load_task_config file)
@@ -84,7 +84,19 @@ macro(dune_add_task root_folder task)
     endforeach(dep ${deps})
   endif(TASK_REQUIRES)
 
-  if(deps_met AND TASK_ENABLED)
+  # Skip tasks not referenced by the selected configuration.
+  set(task_excluded 0)
+
+  if(TASK_CONFIG)
+    list(FIND DUNE_CONFIG_TASKS ${TASK_LABEL} task_index)
+    if(task_index EQUAL -1)
+      set(task_excluded 1)
+    endif(task_index EQUAL -1)
+  endif(TASK_CONFIG)
+
+  if(task_excluded)
+    set(DUNE_TASKS_EXCLUDED ${DUNE_TASKS_EXCLUDED} ${TASK_LABEL})
+  elseif(deps_met AND TASK_ENABLED)
     set(DUNE_TASKS_ENABLED ${DUNE_TASKS_ENABLED} ${TASK_LABEL})
 
     task_files_hook()
@@ -144,9 +156,9 @@ macro(dune_add_task root_folder task)
       install(TARGETS ${TASK_LABEL} RUNTIME DESTINATION lib LIBRARY DESTINATION lib)
     endif(DUNE_SHARED)
 
-  else(deps_met AND TASK_ENABLED)
+  else()
     set(DUNE_TASKS_DISABLED ${DUNE_TASKS_DISABLED} ${TASK_LABEL})
-  endif(deps_met AND TASK_ENABLED)
+  endif()
 endmacro(dune_add_task root_folder task)
 
 macro(dune_add_tasks root_folder)
@@ -161,6 +173,13 @@ message(STATUS "******************************************")
 message(STATUS "***                Tasks               ***")
 message(STATUS "******************************************")
 
+if(TASK_CONFIG)
+  include(${PROJECT_SOURCE_DIR}/cmake/TaskConfig.cmake)
+  dune_load_task_config(${TASK_CONFIG})
+  message(STATUS "Configuration: ${cfg_file}")
+  message(STATUS "")
+endif(TASK_CONFIG)
+
 if(TASK_FILE)
   if(NOT IS_ABSOLUTE "${TASK_FILE}")
     include(${CMAKE_CURRENT_BINARY_DIR}/${TASK_FILE})
@@ -186,4 +205,10 @@ if(DUNE_TASKS_DISABLED)
   endforeach(disabled_tasks ${DUNE_TASKS_DISABLED})
 endif(DUNE_TASKS_DISABLED)
 
+if(DUNE_TASKS_EXCLUDED)
+  list(LENGTH DUNE_TASKS_EXCLUDED excluded_count)
+  message(STATUS "")
+  message(STATUS "Excluded by configuration: ${excluded_count} tasks")
+endif(DUNE_TASKS_EXCLUDED)
+
 message(STATUS "")
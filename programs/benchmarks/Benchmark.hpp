@@ -0,0 +1,196 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_PROGRAMS_BENCHMARKS_BENCHMARK_HPP_INCLUDED_
+#define DUNE_PROGRAMS_BENCHMARKS_BENCHMARK_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+//! Piece of code to be measured.
+class BenchmarkCase
+{
+public:
+  virtual
+  ~BenchmarkCase(void)
+  { }
+
+  //! Run the code a number of times.
+  //! @param[in] iterations number of repetitions.
+  virtual void
+  run(unsigned iterations) = 0;
+};
+
+//! Runs benchmark cases and reports their results in JSON, so
+//! that results of different builds and targets can be compared.
+//! Each case is warmed up and then timed over several samples of a
+//! fixed number of iterations; the minimum, median and mean time per
+//! iteration are reported.
+//!
+//! Programs accept an optional path of the JSON report (standard
+//! output by default) and an optional scale applied to the number
+//! of iterations (e.g. 0.1 on slow targets).
+class Benchmark
+{
+public:
+  //! Number of timed samples per case.
+  static const unsigned c_samples = 7;
+
+  Benchmark(const char* suite, int argc, char** argv):
+    m_suite(suite),
+    m_output(stdout),
+    m_scale(1.0)
+  {
+    if (argc > 1 && std::strcmp(argv[1], "-") != 0)
+    {
+      m_output = std::fopen(argv[1], "w");
+      if (m_output == NULL)
+      {
+        std::fprintf(stderr, "unable to open '%s'\n", argv[1]);
+        std::exit(1);
+      }
+    }
+
+    if (argc > 2)
+      m_scale = std::max(std::atof(argv[2]), 0.001);
+
+    std::fprintf(stderr, "* %s\n", suite);
+  }
+
+  ~Benchmark(void)
+  {
+    std::fprintf(m_output, "{\n");
+    std::fprintf(m_output, "  \"suite\": \"%s\",\n", m_suite.c_str());
+    std::fprintf(m_output, "  \"version\": \"%s\",\n", DUNE_VERSION_STR);
+    std::fprintf(m_output, "  \"system\": \"%s\",\n", DUNE_SYSTEM_NAME);
+    std::fprintf(m_output, "  \"build\": \"%s\",\n", DUNE_BUILD_TYPE);
+    std::fprintf(m_output, "  \"scale\": %g,\n", m_scale);
+    std::fprintf(m_output, "  \"results\": [");
+
+    for (unsigned i = 0; i < m_results.size(); ++i)
+    {
+      const Result& r = m_results[i];
+      std::fprintf(m_output, "%s\n    {\"name\": \"%s\", \"iterations\": %u, \"samples\": %u,"
+                   " \"ns_min\": %.2f, \"ns_median\": %.2f, \"ns_mean\": %.2f",
+                   i ? "," : "", r.name.c_str(), r.iterations, c_samples,
+                   r.ns_min, r.ns_median, r.ns_mean);
+
+      if (r.bytes > 0)
+        std::fprintf(m_output, ", \"mb_per_s\": %.2f", r.bytes / r.ns_median * 1e3);
+
+      std::fprintf(m_output, "}");
+    }
+
+    std::fprintf(m_output, "\n  ]\n}\n");
+
+    if (m_output != stdout)
+      std::fclose(m_output);
+  }
+
+  //! Measure a case.
+  //! @param[in] name case name.
+  //! @param[in] bcase case to run.
+  //! @param[in] iterations iterations per sample (before scaling).
+  //! @param[in] bytes bytes processed per iteration (0 if not
+  //! applicable).
+  void
+  measure(const char* name, BenchmarkCase& bcase, unsigned iterations, unsigned bytes = 0)
+  {
+    iterations = std::max(1U, (unsigned)(iterations * m_scale));
+
+    // Warm up caches and lazily allocated buffers.
+    bcase.run(std::max(1U, iterations / 10));
+
+    std::vector<double> samples(c_samples);
+    for (unsigned i = 0; i < c_samples; ++i)
+    {
+      uint64_t start = DUNE::Time::Clock::getNsec();
+      bcase.run(iterations);
+      samples[i] = (double)(DUNE::Time::Clock::getNsec() - start) / iterations;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    Result r;
+    r.name = name;
+    r.iterations = iterations;
+    r.bytes = bytes;
+    r.ns_min = samples.front();
+    r.ns_median = samples[c_samples / 2];
+    r.ns_mean = 0;
+    for (unsigned i = 0; i < c_samples; ++i)
+      r.ns_mean += samples[i] / c_samples;
+
+    m_results.push_back(r);
+
+    std::fprintf(stderr, "  %-40s %12.1f ns\n", name, r.ns_median);
+  }
+
+  //! Keep a value alive so that the compiler does not optimize
+  //! away the code that computed it.
+  //! @param[in] value value.
+  template <typename T>
+  static void
+  keep(const T& value)
+  {
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&value);
+    (void)sink;
+  }
+
+private:
+  //! Result of a case.
+  struct Result
+  {
+    std::string name;
+    unsigned iterations;
+    unsigned bytes;
+    double ns_min;
+    double ns_median;
+    double ns_mean;
+  };
+
+  //! Suite name.
+  std::string m_suite;
+  //! JSON report.
+  std::FILE* m_output;
+  //! Iteration scale.
+  double m_scale;
+  //! Results.
+  std::vector<Result> m_results;
+};
+
+#endif
@@ -0,0 +1,179 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+#include <DUNE/Tasks/Consumer.hpp>
+#include <DUNE/Tasks/Context.hpp>
+#include <DUNE/Tasks/Recipient.hpp>
+
+// Local headers.
+#include "Benchmark.hpp"
+
+using namespace DUNE;
+
+//! Minimal task consuming messages from the bus.
+class Sink: public Tasks::AbstractTask
+{
+public:
+  Sink(Tasks::Context& ctx):
+    m_recipient(this, ctx),
+    m_consumed(0)
+  {
+    m_recipient.bind(IMC::EstimatedState::getIdStatic(),
+                     new Tasks::Consumer<Sink, IMC::EstimatedState>(*this, &Sink::consume));
+  }
+
+  void
+  receive(const IMC::Message* msg)
+  {
+    m_recipient.put(msg);
+  }
+
+  void
+  receive(IMC::SharedMessage* msg)
+  {
+    m_recipient.put(msg);
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Sink";
+  }
+
+  void
+  drain(void)
+  {
+    m_recipient.runCallBacks();
+  }
+
+  void
+  consume(const IMC::EstimatedState* msg)
+  {
+    (void)msg;
+    ++m_consumed;
+  }
+
+private:
+  Tasks::Recipient m_recipient;
+  unsigned m_consumed;
+
+  void
+  run(void)
+  { }
+};
+
+//! Dispatch to a number of recipients and let all of them consume
+//! the message.
+struct Dispatch: public BenchmarkCase
+{
+  Tasks::Context& ctx;
+  std::vector<Sink*> sinks;
+  IMC::EstimatedState msg;
+
+  Dispatch(Tasks::Context& c, unsigned count):
+    ctx(c)
+  {
+    for (unsigned i = 0; i < count; ++i)
+      sinks.push_back(new Sink(ctx));
+  }
+
+  ~Dispatch(void)
+  {
+    for (unsigned i = 0; i < sinks.size(); ++i)
+      delete sinks[i];
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      ctx.mbus.dispatch(&msg);
+
+      for (unsigned j = 0; j < sinks.size(); ++j)
+        sinks[j]->drain();
+    }
+  }
+};
+
+//! Queue bursts of messages in one recipient and consume them.
+struct Queue: public BenchmarkCase
+{
+  static const unsigned c_burst = 32;
+  Sink sink;
+  IMC::SharedMessage* msg;
+
+  Queue(Tasks::Context& ctx):
+    sink(ctx)
+  {
+    IMC::EstimatedState es;
+    msg = IMC::SharedMessage::create(&es);
+  }
+
+  ~Queue(void)
+  {
+    msg->release();
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      for (unsigned j = 0; j < c_burst; ++j)
+        sink.receive(msg);
+
+      sink.drain();
+    }
+  }
+};
+
+int
+main(int argc, char** argv)
+{
+  Benchmark bench("Bus", argc, argv);
+
+  const unsigned counts[] = {1, 4, 16};
+  for (unsigned i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i)
+  {
+    Tasks::Context ctx;
+    Dispatch dispatch(ctx, counts[i]);
+    std::string name = "Bus::dispatch/" + Utils::String::str(counts[i]) + " recipients";
+    bench.measure(name.c_str(), dispatch, 100000);
+  }
+
+  Tasks::Context ctx;
+  Queue queue(ctx);
+  bench.measure("Recipient::put+runCallBacks/32 messages", queue, 20000);
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Algorithms/CRC16.hpp>
+#include <DUNE/Compression.hpp>
+#include <DUNE/IMC.hpp>
+#include <DUNE/Math/Random/Factory.hpp>
+
+// Local headers.
+#include "Benchmark.hpp"
+
+using namespace DUNE;
+
+//! Size of the sample data.
+static const unsigned c_data_size = 64 * 1024;
+
+//! Build a log-like stream of EstimatedState packets.
+//! @param[out] data stream.
+static void
+makeStream(std::vector<char>& data)
+{
+  Math::Random::Generator* prng = Math::Random::Factory::create(Math::Random::Factory::c_default, 42);
+  IMC::EstimatedState es;
+  uint8_t bfr[256];
+
+  data.clear();
+  while (data.size() < c_data_size)
+  {
+    es.setTimeStamp(es.getTimeStamp() + 0.1);
+    es.x += prng->gaussian() * 0.1;
+    es.y += prng->gaussian() * 0.1;
+    es.depth = 10 + prng->gaussian();
+    es.psi = prng->uniform(-3.14, 3.14);
+
+    uint16_t rv = IMC::Packet::serialize(&es, bfr, sizeof(bfr));
+    data.insert(data.end(), bfr, bfr + rv);
+  }
+
+  data.resize(c_data_size);
+  delete prng;
+}
+
+struct CRC16: public BenchmarkCase
+{
+  const std::vector<char>& data;
+  unsigned size;
+
+  CRC16(const std::vector<char>& d, unsigned s):
+    data(d),
+    size(s)
+  { }
+
+  void
+  run(unsigned iterations)
+  {
+    uint16_t crc = 0;
+    for (unsigned i = 0; i < iterations; ++i)
+      crc = Algorithms::CRC16::compute((const uint8_t*)&data[0], size, crc);
+
+    Benchmark::keep(crc);
+  }
+};
+
+struct Compress: public BenchmarkCase
+{
+  std::vector<char>& data;
+  Compression::Compressor* comp;
+  Utils::ByteBuffer out;
+
+  Compress(std::vector<char>& d, Compression::Compressor* c):
+    data(d),
+    comp(c)
+  { }
+
+  ~Compress(void)
+  {
+    delete comp;
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+      comp->compress(out, &data[0], data.size());
+  }
+};
+
+struct Decompress: public BenchmarkCase
+{
+  Utils::ByteBuffer in;
+  std::vector<char> out;
+  Compression::Decompressor* dec;
+
+  Decompress(std::vector<char>& d, Compression::Compressor* c, Compression::Decompressor* dc):
+    out(d.size()),
+    dec(dc)
+  {
+    c->compress(in, &d[0], d.size());
+    delete c;
+  }
+
+  ~Decompress(void)
+  {
+    delete dec;
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+      dec->decompress(&out[0], out.size(), in.getBufferSigned(), in.getSize());
+  }
+};
+
+int
+main(int argc, char** argv)
+{
+  Benchmark bench("Codecs", argc, argv);
+
+  std::vector<char> data;
+  makeStream(data);
+
+  CRC16 crc_small(data, 64);
+  bench.measure("CRC16::compute/64 B", crc_small, 1000000, 64);
+
+  CRC16 crc_large(data, 4096);
+  bench.measure("CRC16::compute/4 KiB", crc_large, 20000, 4096);
+
+  Compress zlib(data, new Compression::ZlibCompressor);
+  bench.measure("ZlibCompressor::compress/64 KiB", zlib, 100, data.size());
+
+  Decompress unzlib(data, new Compression::ZlibCompressor, new Compression::ZlibDecompressor);
+  bench.measure("ZlibDecompressor::decompress/64 KiB", unzlib, 1000, data.size());
+
+  Compress lz4(data, new Compression::Lz4Compressor);
+  bench.measure("Lz4Compressor::compress/64 KiB", lz4, 1000, data.size());
+
+  Decompress unlz4(data, new Compression::Lz4Compressor, new Compression::Lz4Decompressor);
+  bench.measure("Lz4Decompressor::decompress/64 KiB", unlz4, 1000, data.size());
+
+  Compress bzip2(data, new Compression::Bzip2Compressor);
+  bench.measure("Bzip2Compressor::compress/64 KiB", bzip2, 20, data.size());
+
+  Decompress unbzip2(data, new Compression::Bzip2Compressor, new Compression::Bzip2Decompressor);
+  bench.measure("Bzip2Decompressor::decompress/64 KiB", unbzip2, 50, data.size());
+
+  return 0;
+}
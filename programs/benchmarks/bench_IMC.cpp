@@ -0,0 +1,212 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+// Local headers.
+#include "Benchmark.hpp"
+
+using namespace DUNE;
+
+//! Serialization buffer size.
+static const unsigned c_bfr_size = 65535;
+
+struct Serialize: public BenchmarkCase
+{
+  const IMC::Message* msg;
+  std::vector<uint8_t> bfr;
+
+  Serialize(const IMC::Message* m):
+    msg(m),
+    bfr(c_bfr_size)
+  { }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+      Benchmark::keep(IMC::Packet::serialize(msg, &bfr[0], bfr.size()));
+  }
+};
+
+struct Deserialize: public BenchmarkCase
+{
+  std::vector<uint8_t> bfr;
+  IMC::Message* out;
+
+  Deserialize(const IMC::Message* m):
+    bfr(c_bfr_size)
+  {
+    bfr.resize(IMC::Packet::serialize(m, &bfr[0], bfr.size()));
+    out = m->clone();
+  }
+
+  ~Deserialize(void)
+  {
+    delete out;
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+      IMC::Packet::deserialize(&bfr[0], bfr.size(), out);
+  }
+};
+
+struct Parse: public BenchmarkCase
+{
+  std::vector<uint8_t> stream;
+  unsigned count;
+  IMC::Parser parser;
+
+  Parse(const std::vector<IMC::Message*>& msgs):
+    count(msgs.size())
+  {
+    uint8_t bfr[c_bfr_size];
+    for (unsigned i = 0; i < msgs.size(); ++i)
+    {
+      uint16_t rv = IMC::Packet::serialize(msgs[i], bfr, sizeof(bfr));
+      stream.insert(stream.end(), bfr, bfr + rv);
+    }
+
+    parser.setReuse(true);
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      unsigned pos = 0;
+      while (pos < stream.size())
+      {
+        unsigned consumed = 0;
+        Benchmark::keep(parser.parse(&stream[pos], stream.size() - pos, consumed));
+        pos += consumed;
+      }
+    }
+  }
+};
+
+struct JSON: public BenchmarkCase
+{
+  const IMC::Message* msg;
+  Utils::ByteBuffer bfr;
+
+  JSON(const IMC::Message* m):
+    msg(m)
+  { }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      bfr.setSize(0);
+      msg->toJSON(bfr);
+    }
+  }
+};
+
+int
+main(int argc, char** argv)
+{
+  Benchmark bench("IMC", argc, argv);
+
+  std::vector<IMC::Message*> msgs;
+
+  msgs.push_back(new IMC::Heartbeat);
+
+  IMC::EstimatedState* es = new IMC::EstimatedState;
+  es->lat = 0.7188;
+  es->lon = -0.1525;
+  es->depth = 12.5;
+  es->psi = 1.2;
+  msgs.push_back(es);
+
+  IMC::GpsFix* fix = new IMC::GpsFix;
+  fix->lat = 0.7188;
+  fix->lon = -0.1525;
+  fix->satellites = 9;
+  msgs.push_back(fix);
+
+  IMC::EntityInfo* info = new IMC::EntityInfo;
+  info->label = "Navigation";
+  info->component = "Navigation.AUV.Navigation";
+  msgs.push_back(info);
+
+  IMC::SonarData* sonar = new IMC::SonarData;
+  sonar->data.assign(4096, 'x');
+  msgs.push_back(sonar);
+
+  IMC::PlanControl* pc = new IMC::PlanControl;
+  pc->plan_id = "survey";
+  IMC::PlanSpecification spec;
+  spec.plan_id = "survey";
+  for (unsigned i = 0; i < 16; ++i)
+  {
+    IMC::PlanManeuver pm;
+    pm.maneuver_id = "goto";
+    pm.data.set(IMC::Goto());
+    spec.maneuvers.push_back(pm);
+  }
+  pc->arg.set(spec);
+  msgs.push_back(pc);
+
+  for (unsigned i = 0; i < msgs.size(); ++i)
+  {
+    std::string name = msgs[i]->getName();
+    unsigned size = msgs[i]->getSerializationSize();
+
+    Serialize ser(msgs[i]);
+    bench.measure(("Packet::serialize/" + name).c_str(), ser, 100000, size);
+
+    Deserialize des(msgs[i]);
+    bench.measure(("Packet::deserialize/" + name).c_str(), des, 100000, size);
+  }
+
+  Parse parse(msgs);
+  bench.measure("Parser::parse/mixed", parse, 20000, parse.stream.size());
+
+  for (unsigned i = 0; i < msgs.size(); ++i)
+  {
+    std::string name = msgs[i]->getName();
+    JSON json(msgs[i]);
+    bench.measure(("Message::toJSON/" + name).c_str(), json, 20000);
+  }
+
+  for (unsigned i = 0; i < msgs.size(); ++i)
+    delete msgs[i];
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Math.hpp>
+#include <DUNE/Navigation/KalmanFilter.hpp>
+#include <DUNE/Utils/String.hpp>
+
+// Local headers.
+#include "Benchmark.hpp"
+
+using namespace DUNE;
+
+//! Fill a matrix with a well conditioned pattern.
+static void
+fill(Math::Matrix& m)
+{
+  for (int i = 0; i < (int)m.rows(); ++i)
+  {
+    for (int j = 0; j < (int)m.columns(); ++j)
+      m(i, j) = (i == j) ? 4.0 + i : 1.0 / (1.0 + i + j);
+  }
+}
+
+struct Multiply: public BenchmarkCase
+{
+  Math::Matrix a;
+  Math::Matrix b;
+  Math::Matrix c;
+
+  Multiply(size_t n):
+    a(n, n),
+    b(n, n)
+  {
+    fill(a);
+    fill(b);
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+      c = a * b;
+
+    Benchmark::keep(c(0, 0));
+  }
+};
+
+struct Inverse: public BenchmarkCase
+{
+  Math::Matrix a;
+  Math::Matrix c;
+
+  Inverse(size_t n):
+    a(n, n)
+  {
+    fill(a);
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+      c = inverse(a);
+
+    Benchmark::keep(c(0, 0));
+  }
+};
+
+//! Predict and update a constant velocity filter with position
+//! measurements.
+struct Kalman: public BenchmarkCase
+{
+  Navigation::KalmanFilter kal;
+  unsigned outputs;
+
+  Kalman(unsigned states, unsigned outs, Navigation::KalmanFilter::UpdateMode mode):
+    outputs(outs)
+  {
+    kal.reset(states, outputs);
+    kal.setUpdateMode(mode);
+
+    Math::Matrix a(states, states);
+    a.identity();
+    for (unsigned i = 0; i + 1 < states; i += 2)
+      a(i, i + 1) = 0.1;
+    kal.setTransitions(a);
+
+    kal.setCovariance(1.0);
+    kal.setProcessNoise(0.01);
+    kal.setMeasurementNoise(0.5);
+
+    for (unsigned i = 0; i < outputs; ++i)
+      kal.setObservation(i, (2 * i) % states, 1.0);
+  }
+
+  void
+  run(unsigned iterations)
+  {
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+      kal.predict();
+
+      for (unsigned j = 0; j < outputs; ++j)
+        kal.setInnovation(j, 0.01 * ((i + j) % 7));
+
+      kal.update(0);
+    }
+
+    Benchmark::keep(kal.getState(0));
+  }
+};
+
+int
+main(int argc, char** argv)
+{
+  Benchmark bench("Math", argc, argv);
+
+  const size_t sizes[] = {3, 6, 12};
+  for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    std::string n = Utils::String::str((unsigned)sizes[i]);
+
+    Multiply mul(sizes[i]);
+    bench.measure(("Matrix::operator*/" + n + "x" + n).c_str(), mul, 100000);
+
+    Inverse inv(sizes[i]);
+    bench.measure(("Math::inverse/" + n + "x" + n).c_str(), inv, 20000);
+  }
+
+  Kalman batch(12, 6, Navigation::KalmanFilter::UPDATE_STANDARD);
+  bench.measure("KalmanFilter::step/12x6 standard", batch, 20000);
+
+  Kalman seq(12, 6, Navigation::KalmanFilter::UPDATE_SEQUENTIAL);
+  bench.measure("KalmanFilter::step/12x6 sequential", seq, 20000);
+
+  return 0;
+}
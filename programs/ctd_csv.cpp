@@ -33,6 +33,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <map>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -117,13 +118,6 @@ main(int32_t argc, char** argv)
 
   for (int32_t i = 1; i < argc; ++i)
   {
-    std::istream* is = 0;
-    Compression::Methods method = Compression::Factory::detect(argv[i]);
-    if (method == METHOD_UNKNOWN)
-      is = new std::ifstream(argv[i], std::ios::binary);
-    else
-      is = new Compression::FileInput(argv[i], method);
-
     IMC::Message* msg = NULL;
 
     bool got_name = false;
@@ -140,7 +134,18 @@ main(int32_t argc, char** argv)
 
     try
     {
-      while ((msg = IMC::Packet::deserialize(*is)) != 0)
+      std::set<uint16_t> ids;
+      ids.insert(DUNE_IMC_LOGGINGCONTROL);
+      ids.insert(DUNE_IMC_ENTITYINFO);
+      ids.insert(DUNE_IMC_ESTIMATEDSTATE);
+      ids.insert(DUNE_IMC_CONDUCTIVITY);
+      ids.insert(DUNE_IMC_TEMPERATURE);
+      ids.insert(DUNE_IMC_DEPTH);
+
+      IMC::LogReader reader(argv[i]);
+      reader.setFilter(ids);
+
+      while ((msg = reader.read()) != 0)
       {
         if (msg->getId() == DUNE_IMC_LOGGINGCONTROL)
         {
@@ -229,8 +234,6 @@ main(int32_t argc, char** argv)
 
     csv.flush();
 
-    delete is;
-
     if (ignore)
     {
       std::cerr << "... ignoring " << log_name << std::endl;
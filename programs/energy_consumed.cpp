@@ -33,6 +33,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <map>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -97,12 +98,15 @@ main(int32_t argc, char** argv)
 
   for (int32_t i = start_index; i < argc; ++i)
   {
-    std::istream* is = 0;
-    DUNE::Compression::Methods method = DUNE::Compression::Factory::detect(argv[i]);
-    if (method == DUNE::Compression::METHOD_UNKNOWN)
-      is = new std::ifstream(argv[i], std::ios::binary);
-    else
-      is = new DUNE::Compression::FileInput(argv[i], method);
+    DUNE::IMC::LogReader reader(argv[i]);
+    std::set<uint16_t> ids;
+    ids.insert(DUNE_IMC_LOGGINGCONTROL);
+    ids.insert(DUNE_IMC_ENTITYINFO);
+    ids.insert(DUNE_IMC_VOLTAGE);
+    ids.insert(DUNE_IMC_CURRENT);
+    ids.insert(DUNE_IMC_RPM);
+    ids.insert(DUNE_IMC_SIMULATEDSTATE);
+    reader.setFilter(ids);
 
     DUNE::IMC::Message* msg = NULL;
 
@@ -127,7 +131,7 @@ main(int32_t argc, char** argv)
 
     try
     {
-      while ((msg = DUNE::IMC::Packet::deserialize(*is)) != 0)
+      while ((msg = reader.read()) != 0)
       {
 
         if (msg->getId() == DUNE_IMC_LOGGINGCONTROL)
@@ -215,8 +219,6 @@ main(int32_t argc, char** argv)
       std::cerr << "ERROR: " << e.what() << std::endl;
     }
 
-    delete is;
-
     if (ignore)
     {
       std::cerr << "... ignoring" << std::endl;
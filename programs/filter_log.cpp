@@ -33,6 +33,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <map>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -49,18 +50,10 @@ main(int32_t argc, char** argv)
     return 1;
   }
 
-  std::istream* is = 0;
-  Compression::Methods method = Compression::Factory::detect(argv[1]);
-  if (method == METHOD_UNKNOWN)
-    is = new std::ifstream(argv[1], std::ios::binary);
-  else
-    is = new Compression::FileInput(argv[1], method);
 
   ByteBuffer buffer;
   std::ofstream lsf("FilteredData.lsf", std::ios::binary);
 
-  IMC::Message* msg;
-
   unsigned i = 0;
 
   // place an empty estimatedstate message in the log
@@ -68,22 +61,21 @@ main(int32_t argc, char** argv)
   IMC::Packet::serialize(&state, buffer);
   lsf.write(buffer.getBufferSigned(), buffer.getSize());
 
-  uint32_t id;
-  id = IMC::Factory::getIdFromAbbrev(argv[2]);
-
   try
   {
-    while ((msg = IMC::Packet::deserialize(*is)) != 0)
-    {
-      if (msg->getId() == id)
-      {
-        IMC::Packet::serialize(msg, buffer);
-        lsf.write(buffer.getBufferSigned(), buffer.getSize());
+    IMC::PacketFilter filter;
+    filter.addId(IMC::Factory::getIdFromAbbrev(argv[2]));
 
-        ++i;
-      }
+    // Packets are filtered by header and copied without being
+    // deserialized.
+    IMC::LogReader reader(argv[1]);
+    reader.setFilter(filter);
 
-      delete msg;
+    const IMC::LogReader::Record* record = NULL;
+    while ((record = reader.next()) != NULL)
+    {
+      lsf.write((const char*)record->getData(), record->getSize());
+      ++i;
     }
   }
   catch (std::runtime_error& e)
@@ -94,8 +86,6 @@ main(int32_t argc, char** argv)
 
   lsf.close();
 
-  delete is;
-
   std::cerr << "Got " << i << " " << argv[1] << " messages." << std::endl;
 
   return 0;
@@ -116,8 +116,9 @@ class Enum:
         return out
 
 class Function:
-    def __init__(self, name, rett = None, args = None, const = False, inline = False, static = False):
+    def __init__(self, name, rett = None, args = None, const = False, inline = False, static = False, inits = None):
         self._data = {}
+        self._inits = inits
         self._name = name
         self._rett = rett
         self._args = args
@@ -175,6 +176,11 @@ class Function:
         else:
             name = self._name
 
+        if self._inits:
+            inits = ':\n' + ',\n'.join(self._inits)
+        else:
+            inits = ''
+
         return out + \
-               name + '(' + self._args_str + ')' + self._const_str +'\n' \
+               name + '(' + self._args_str + ')' + self._const_str + inits + '\n' \
                '{\n'+ self._body + '\n}\n'
@@ -74,6 +74,7 @@ def get_cxx_copyright():
 def beautify(text):
     indent = 0
     blank = False
+    init = False
     list0 = []
 
     # Remove extra empty lines and indent.
@@ -96,14 +97,23 @@ def beautify(text):
         if strip == '{':
             list0.append(' ' * indent + strip)
             indent += 2
+            init = False
         elif strip == '}' or strip == '};':
             indent -=2
             list0.append(' ' * indent + strip)
         elif strip == 'public:' or strip == 'protected:' or strip == 'public:':
             list0.append(' ' * (indent - 2) + strip)
+        elif strip.startswith('#'):
+            list0.append(strip)
+        elif init:
+            # Constructor initializer list.
+            list0.append(' ' * (indent + 2) + strip)
         else:
             list0.append(' ' * indent + strip)
 
+        if strip.endswith('):'):
+            init = True
+
     # Remove empty lines between blocks.
     list1 = []
     for line in list0:
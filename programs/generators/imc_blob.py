@@ -41,7 +41,7 @@ import xml.etree.ElementTree as ET
 tree = ET.parse(xml)
 
 # Remove 'description' tags.
-for parent in tree.getiterator():
+for parent in tree.iter():
     for child in parent:
         if child.tag == 'description':
             parent.remove(child)
@@ -51,12 +51,20 @@ root = tree.getroot()
 text = b'<?xml version="1.0" encoding="UTF-8"?>\n' + ET.tostring(root, encoding = 'utf-8')
 
 # Compress to temporary file.
+# Digest of the uncompressed document.
+import hashlib
+digest = hashlib.md5(text).hexdigest()
+
+# Compress without a timestamp so that the blob only changes when the
+# document does.
 import tempfile
 tmp = tempfile.NamedTemporaryFile(delete = False)
 import gzip
-f_out = gzip.open(tmp.name, 'wb', compresslevel = 9)
+f_raw = open(tmp.name, 'wb')
+f_out = gzip.GzipFile(filename = '', mode = 'wb', compresslevel = 9, fileobj = f_raw, mtime = 0)
 f_out.write(text)
 f_out.close()
+f_raw.close()
 
 ################################################################################
 # Blob.cpp                                                                     #
@@ -96,4 +104,8 @@ f = Function('Blob::getSize', 'unsigned int')
 f.body('return sizeof(c_imc_blob);')
 fd.append(f)
 
+f = Function('Blob::getDigest', 'const char*')
+f.body('return "' + digest + '";')
+fd.append(f)
+
 fd.write()
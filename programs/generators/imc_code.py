@@ -105,6 +105,38 @@ class Message:
             f.add_body(get_name(field) + '.setParent(this);')
         public.append(f)
 
+        # Copy constructor: nested messages must have this message as
+        # parent, not the one they were copied from.
+        if self.count_nested() > 0:
+            inits = ['%s(other__)' % name for name in self.get_bases()]
+            inits += ['{0}(other__.{0})'.format(name) for name in get_field_names(node)]
+            f = Function(node.get('abbrev'), args = [Var('other__', 'const %s&' % node.get('abbrev'))], inits = inits)
+            for field in node.findall("field[@type='message']"):
+                f.add_body(get_name(field) + '.setParent(this);')
+            for field in node.findall("field[@type='message-list']"):
+                f.add_body(get_name(field) + '.setParent(this);')
+            public.append(f)
+
+        # swap(): exchange variable size fields without copying them.
+        if len(self.get_variable_fields()) > 0:
+            f = Function('swap', 'void', [Var('other__', '%s&' % node.get('abbrev'))])
+            f.add_body('swapHeader(other__);')
+            for field in node.findall('field'):
+                if is_fixed(field):
+                    f.add_body('std::swap({0}, other__.{0});'.format(get_name(field)))
+                else:
+                    f.add_body('{0}.swap(other__.{0});'.format(get_name(field)))
+            public.append(f)
+
+        # Assignment operator: copy and swap, so nested messages keep
+        # this message as parent.
+        if self.count_nested() > 0:
+            f = Function('operator=', '%s&' % node.get('abbrev'), [Var('other__', 'const %s&' % node.get('abbrev'))])
+            f.add_body('%s copy__(other__);' % node.get('abbrev'))
+            f.add_body('swap(copy__);')
+            f.add_body('return *this;')
+            public.append(f)
+
         # clone()
         f = Function('clone', 'Message*', const = True, inline = True)
         f.body('return new %(abbrev)s(*this);' % node.attrib)
@@ -128,10 +160,22 @@ class Message:
         f.body('return false;')
         public.append(f);
 
+        # Condition under which packed fields can be copied in bulk.
+        packed = self.get_packed_fields()
+        if packed is not None:
+            last = get_name(packed[-1])
+            packed_test = '#if defined(DUNE_IMC_BULK_SERIALIZATION)\n' + \
+                          'if (IMC::isPacked(&{0}, &{1}, sizeof({1}), {2}))\n'.format(get_name(packed[0]), last, self.get_fixed_size()) + \
+                          '{'
+
         # serializeFields()
         f = Function('serializeFields', 'uint8_t*', [Var('bfr__', 'uint8_t*')], const = True)
         if self.has_fields():
             f.add_body('uint8_t* ptr__ = bfr__;')
+            if packed is not None:
+                f.add_body(packed_test)
+                f.add_body('return ptr__ + IMC::serializeBlock(&{0}, {1}, ptr__);'.format(get_name(packed[0]), self.get_fixed_size()))
+                f.add_body('}\n#endif')
             for field in node.findall('field'):
                 if field.get('type').startswith('message'):
                     f.add_body('ptr__ += %s.serialize(ptr__);' % get_name(field))
@@ -142,10 +186,50 @@ class Message:
             f.add_body('return bfr__;')
         public.append(f)
 
+        # scatterFields(): reference data fields instead of copying them.
+        if len(node.findall("field[@type='rawdata']")) > 0:
+            f = Function('scatterFields', 'void', [Var('packet__', 'ScatterPacket&')], const = True)
+            group = []
+            declared = False
+            for field in node.findall('field') + [None]:
+                if field is not None and field.get('type') != 'rawdata':
+                    group.append(field)
+                    continue
+                sizes = []
+                fixed = 0
+                for g in group:
+                    if is_fixed(g):
+                        fixed += self._consts['sizes'][g.get('type')]
+                    elif g.get('type').startswith('message'):
+                        sizes.append(get_name(g) + '.getSerializationSize()')
+                    else:
+                        sizes.append('IMC::getSerializationSize(%s)' % get_name(g))
+                if field is not None:
+                    fixed += 2
+                if fixed > 0 or len(sizes) == 0:
+                    sizes.insert(0, str(fixed))
+                if len(group) > 0 or field is not None:
+                    f.add_body('{0}ptr__ = packet__.grow({1});'.format('' if declared else 'uint8_t* ', ' + '.join(sizes)))
+                    declared = True
+                for g in group:
+                    if g.get('type').startswith('message'):
+                        f.add_body('ptr__ += %s.serialize(ptr__);' % get_name(g))
+                    else:
+                        f.add_body('ptr__ += IMC::serialize(%s, ptr__);' % get_name(g))
+                if field is not None:
+                    f.add_body('IMC::serialize((uint16_t){0}.size(), ptr__);'.format(get_name(field)))
+                    f.add_body('packet__.append(%s);' % get_name(field))
+                group = []
+            public.append(f)
+
         # deserializeFields()
         f = Function('deserializeFields', 'uint16_t', [Var('bfr__', 'const uint8_t*'), Var('size__', 'uint16_t')])
         if self.has_fields():
             f.add_body('const uint8_t* start__ = bfr__;')
+            if packed is not None:
+                f.add_body(packed_test)
+                f.add_body('return IMC::deserializeBlock(&{0}, {1}, bfr__, size__);'.format(get_name(packed[0]), self.get_fixed_size()))
+                f.add_body('}\n#endif')
             for field in node.findall('field'):
                 if field.get('type').startswith('message'):
                     f.add_body('bfr__ += %s.deserialize(bfr__, size__);' % get_name(field))
@@ -161,6 +245,13 @@ class Message:
         f = Function('reverseDeserializeFields', 'uint16_t', [Var('bfr__', 'const uint8_t*'), Var('size__', 'uint16_t')])
         if self.has_fields():
             f.add_body('const uint8_t* start__ = bfr__;')
+            if packed is not None:
+                f.add_body(packed_test)
+                f.add_body('bfr__ += IMC::deserializeBlock(&{0}, {1}, bfr__, size__);'.format(get_name(packed[0]), self.get_fixed_size()))
+                for run in self.get_runs(packed):
+                    f.add_body('IMC::reverseBlock(&{0}, {1}, {2});'.format(get_name(run[0]), consts['sizes'][run[0].get('type')], len(run)))
+                f.add_body('return bfr__ - start__;')
+                f.add_body('}\n#endif')
             for field in node.findall('field'):
                 if consts['sizes'][field.get('type')] == 1:
                     f.add_body('bfr__ += IMC::deserialize({0}, bfr__, size__);'.format(get_name(field)))
@@ -226,6 +317,15 @@ class Message:
             f.add_body(self.fields_to_json())
             public.append(f)
 
+            f = Function('fieldsToJSON', 'void', [Var('bfr__', 'Utils::ByteBuffer&')], const = True)
+            f.add_body(self.fields_to_json_buffer())
+            public.append(f)
+
+            # fieldFromJSON()
+            f = Function('fieldFromJSON', 'bool', [Var('label__', 'const char*'), Var('reader__', 'JSONReader&')])
+            f.add_body(self.field_from_json())
+            public.append(f)
+
         # Nested functions.
         if self.count_nested() > 0:
             funcs = [('TimeStamp', 'double'), ('Source', 'uint16_t'),
@@ -240,12 +340,7 @@ class Message:
                 protected.append(f)
 
         # HPP.
-        base = []
-        for group in root.findall('message-groups/message-group'):
-            if group.find("message-type[@abbrev='%s']" % node.get('abbrev')) is not None:
-                base.append(group.get('abbrev'))
-        if len(base) == 0:
-            base.append('Message')
+        base = self.get_bases()
         hpp.append(comment(node.get('name'), nl = ''))
         hpp.append('class %s: public %s' % (node.get('abbrev'), ', '.join(base)));
         hpp.append('{')
@@ -310,6 +405,30 @@ class Message:
                 lines.append('IMC::toJSON(os__, "{0}", {0}, nindent__);'.format(get_name(field)))
         return '\n'.join(lines)
 
+    def fields_to_json_buffer(self):
+        lines = []
+        for field in self._node.findall('field'):
+            if field.get('type').startswith('message'):
+                lines.append('{0}.toJSON(bfr__, "{0}");'.format(get_name(field)))
+            else:
+                lines.append('IMC::toJSON(bfr__, "{0}", {0});'.format(get_name(field)))
+        return '\n'.join(lines)
+
+    def field_from_json(self):
+        lines = []
+        for field in self._node.findall('field'):
+            lines.append('if (std::strcmp(label__, "{0}") == 0)'.format(get_name(field)))
+            lines.append('{')
+            if field.get('type').startswith('message'):
+                lines.append('{0}.fromJSON(reader__);'.format(get_name(field)))
+            else:
+                lines.append('reader__.read({0});'.format(get_name(field)))
+            lines.append('return true;')
+            lines.append('}')
+            lines.append('')
+        lines.append('return false;')
+        return '\n'.join(lines)
+
     def validate(field):
         min_value = field.get('min', None)
         cond = ''
@@ -345,6 +464,50 @@ class Message:
                 ret.append(get_name(field))
         return ret
 
+    # Retrieve the list of fields if all of them are scalars placed at
+    # offsets that are multiples of their sizes, i.e., if the host
+    # representation can match the serialized one.
+    def get_packed_fields(self):
+        fields = self._node.findall('field')
+        if len(fields) < 2:
+            return None
+        offset = 0
+        for field in fields:
+            if not is_fixed(field):
+                return None
+            size = self._consts['sizes'][field.get('type')]
+            if offset % size != 0:
+                return None
+            offset += size
+        return fields
+
+    # Split a list of fields in runs of consecutive multi-byte fields
+    # with the same size.
+    def get_runs(self, fields):
+        runs = []
+        last = 0
+        for field in fields:
+            size = self._consts['sizes'][field.get('type')]
+            if size == 1:
+                last = 0
+                continue
+            if size == last:
+                runs[-1].append(field)
+            else:
+                runs.append([field])
+            last = size
+        return runs
+
+    # Retrieve the list of base classes.
+    def get_bases(self):
+        base = []
+        for group in self._root.findall('message-groups/message-group'):
+            if group.find("message-type[@abbrev='%s']" % self._node.get('abbrev')) is not None:
+                base.append(group.get('abbrev'))
+        if len(base) == 0:
+            base.append('Message')
+        return base
+
     def has_fields(self):
         return len(self._node.findall('field')) > 0
 
@@ -447,6 +610,7 @@ f.append(Macro('CONST_HEADER_SIZE', consts['header_size'], 'Size of the header i
 f.append(Macro('CONST_FOOTER_SIZE', consts['footer_size'], 'Size of the footer in bytes'))
 f.append(Macro('CONST_NULL_ID', CONST_NULL_ID, 'Identification number of the null message'))
 f.append(Macro('CONST_MAX_SIZE', 2**16-1, 'Maximum message data size'))
+f.append(Macro('CONST_MAX_ID', max([int(m.get('id')) for m in root.findall('message')]), 'Largest message identification number'))
 f.append(Macro('CONST_UNK_EID', 255, 'Unknown entity identifier'))
 f.append(Macro('CONST_SYS_EID', 0, 'System entity identifier'))
 f.write()
@@ -483,6 +647,72 @@ for msg in root.findall('message'):
 f.append('#undef MESSAGE')
 f.write()
 
+################################################################################
+# FactoryIndex.def                                                             #
+################################################################################
+msgs_by_id = {}
+for msg in root.findall('message'):
+    msgs_by_id[int(msg.get('id'))] = msg.get('abbrev')
+
+f = File('FactoryIndex.def', folder, ns = False)
+for i in range(0, max(msgs_by_id.keys()) + 1):
+    if i in msgs_by_id:
+        f.append('MESSAGE(%d, %s)' % (i, msgs_by_id[i]))
+    else:
+        f.append('NO_MESSAGE(%d)' % i)
+f.append('#undef MESSAGE')
+f.append('#undef NO_MESSAGE')
+f.write()
+
+################################################################################
+# FactoryHash.def                                                              #
+################################################################################
+# Perfect hash of message abbreviations (hash and displace). Keys are
+# distributed by bucket using fnv1a(0, key) % len(seeds), and each bucket
+# has a seed such that fnv1a(seed, key) % len(slots) does not collide.
+def fnv1a(seed, text):
+    h = (2166136261 ^ seed) & 0xffffffff
+    for c in text.encode('ascii'):
+        h = ((h ^ c) * 16777619) & 0xffffffff
+    return h
+
+abbrevs = list(msgs_by_id.values())
+hash_buckets = max(1, len(abbrevs) // 4)
+hash_slots = 1
+while hash_slots < 2 * len(abbrevs):
+    hash_slots *= 2
+
+buckets = [[] for i in range(0, hash_buckets)]
+for abbrev in abbrevs:
+    buckets[fnv1a(0, abbrev) % hash_buckets].append(abbrev)
+
+abbrev_ids = dict([(v, k) for (k, v) in msgs_by_id.items()])
+seeds = [0] * hash_buckets
+slots = [0xffff] * hash_slots
+for b in sorted(range(0, hash_buckets), key = lambda i: -len(buckets[i])):
+    if len(buckets[b]) == 0:
+        continue
+    seed = 1
+    while True:
+        pos = [fnv1a(seed, k) % hash_slots for k in buckets[b]]
+        if len(set(pos)) == len(pos) and all([slots[p] == 0xffff for p in pos]):
+            break
+        seed += 1
+        if seed > 0xffff:
+            raise Exception('failed to compute perfect hash of abbreviations')
+    seeds[b] = seed
+    for k, p in zip(buckets[b], pos):
+        slots[p] = abbrev_ids[k]
+
+f = File('FactoryHash.def', folder, ns = False)
+for seed in seeds:
+    f.append('HASH_SEED(%d)' % seed)
+for slot in slots:
+    f.append('HASH_SLOT(%d)' % slot)
+f.append('#undef HASH_SEED')
+f.append('#undef HASH_SLOT')
+f.write()
+
 ################################################################################
 # SuperTypes.hpp                                                               #
 ################################################################################
@@ -508,7 +738,7 @@ hpp.add_dune_headers('Config.hpp', 'IMC/Message.hpp',
 # Definitions.cpp                                                              #
 ################################################################################
 cpp = File('Definitions.cpp', folder)
-cpp.add_isoc_headers('algorithm','iostream', 'iomanip', 'string', 'cstdio')
+cpp.add_isoc_headers('algorithm','iostream', 'iomanip', 'string', 'cstdio', 'cstring')
 cpp.add_dune_headers('Utils/ByteCopy.hpp', 'Utils/Utils.hpp',
                      'IMC/Exceptions.hpp', 'IMC/Definitions.hpp',
                      'IMC/Factory.hpp', 'IMC/Serialization.hpp')
@@ -0,0 +1,199 @@
+# -*- coding: utf-8 -*-
+############################################################################
+# Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      #
+# Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  #
+############################################################################
+# This file is part of DUNE: Unified Navigation Environment.               #
+#                                                                          #
+# Commercial Licence Usage                                                 #
+# Licencees holding valid commercial DUNE licences may use this file in    #
+# accordance with the commercial licence agreement provided with the       #
+# Software or, alternatively, in accordance with the terms contained in a  #
+# written agreement between you and Universidade do Porto. For licensing   #
+# terms, conditions, and further information contact lsts@fe.up.pt.        #
+#                                                                          #
+# European Union Public Licence - EUPL v.1.1 Usage                         #
+# Alternatively, this file may be used under the terms of the EUPL,        #
+# Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       #
+# included in the packaging of this file. You may not use this work        #
+# except in compliance with the Licence. Unless required by applicable     #
+# law or agreed to in writing, software distributed under the Licence is   #
+# distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     #
+# ANY KIND, either express or implied. See the Licence for the specific    #
+# language governing permissions and limitations at                        #
+# https://www.lsts.pt/dune/licence.                                        #
+############################################################################
+# Author: Ricardo Martins                                                  #
+############################################################################
+
+import sys
+import math
+
+from imc.utils import *
+from imc.file import *
+from imc.code import *
+
+xml = sys.argv[1]
+folder = sys.argv[2]
+
+# Parse XML specification.
+import xml.etree.ElementTree as ET
+tree = ET.parse(xml)
+root = tree.getroot()
+
+# Width of integer types.
+c_widths = {
+    'int8_t': 8, 'uint8_t': 8,
+    'int16_t': 16, 'uint16_t': 16,
+    'int32_t': 32, 'uint32_t': 32,
+    'int64_t': 64
+}
+
+# Number of bits needed to hold 'count' + 1 distinct values.
+def bits_for(count):
+    return max(1, int(count).bit_length())
+
+def fatal(msg, field, text):
+    sys.stderr.write('ERROR: %s.%s: %s\n' % (msg.get('abbrev'), field.get('abbrev'), text))
+    sys.exit(1)
+
+# Retrieve the values of an enumeration or bitfield field.
+def get_values(field):
+    values = field.findall('value')
+    if field.get('enum-def') is not None:
+        values = root.findall("enumerations/def[@abbrev='%s']/value" % field.get('enum-def'))
+    elif field.get('bitfield-def') is not None:
+        values = root.findall("bitfields/def[@abbrev='%s']/value" % field.get('bitfield-def'))
+    return [int(v.get('id'), 0) for v in values]
+
+# Retrieve range of a field, giving precedence to compact annotations.
+def get_range(field):
+    lo = field.get('compact-min', field.get('min'))
+    hi = field.get('compact-max', field.get('max'))
+    if lo is None or hi is None:
+        return None
+    return (lo, hi)
+
+# Encode/decode statements of a quantized real field.
+def real_field(msg, field, name):
+    rng = get_range(field)
+    if rng is None:
+        fatal(msg, field, 'quantized fields need a range')
+    precision = float(field.get('compact-precision'))
+    bits = bits_for(round((float(rng[1]) - float(rng[0])) / precision))
+    dbits = 0
+    if field.get('compact-delta') is not None:
+        dbits = bits_for(math.ceil(float(field.get('compact-delta')) / precision)) + 1
+    args = '%s, %s, %d' % (rng[0], field.get('compact-precision'), bits)
+    if dbits == 0:
+        return (bits, dbits,
+                'w__.putReal(msg__.%s, %s);' % (name, args),
+                'msg__.%s = static_cast<%s>(r__.getReal(%s));' % (name, field.get('type'), args))
+
+    args = 'ref__ ? ref__->%s : 0, ref__ != NULL, %s, %d' % (name, args, dbits)
+    return (bits + 1, dbits,
+            'w__.putDelta(msg__.%s, %s);' % (name, args),
+            'msg__.%s = static_cast<%s>(r__.getDelta(%s));' % (name, field.get('type'), args))
+
+# Encode/decode statements of an integer field.
+def integer_field(msg, field, name):
+    type = field.get('type')
+    rng = get_range(field)
+    values = get_values(field)
+    if rng is None and values and field.get('unit') == 'Enumerated':
+        rng = ('0', str(max(values)))
+    elif rng is None and values and field.get('unit') == 'Bitfield':
+        rng = ('0', str((1 << bits_for(max(values))) - 1))
+
+    if rng is None:
+        bits = c_widths[type]
+        return (bits,
+                'w__.putUnsigned(static_cast<uint64_t>(msg__.%s), %d);' % (name, bits),
+                'msg__.%s = static_cast<%s>(r__.getUnsigned(%d));' % (name, type, bits))
+
+    bits = bits_for(int(rng[1]) - int(rng[0]))
+    return (bits,
+            'w__.putInteger(msg__.%s, %s, %d);' % (name, rng[0], bits),
+            'msg__.%s = static_cast<%s>(r__.getInteger(%s, %d));' % (name, type, rng[0], bits))
+
+################################################################################
+# CompactCodec.def                                                             #
+################################################################################
+f = File('CompactCodec.def', folder, ns = False)
+
+msgs = [m for m in root.findall('message') if m.get('compact-id') is not None]
+msgs.sort(key = lambda m: int(m.get('compact-id')))
+entries = []
+ids = set()
+
+for msg in msgs:
+    cid = int(msg.get('compact-id'))
+    if cid < 1 or cid > 255 or cid in ids:
+        sys.stderr.write('ERROR: %s: invalid compact identifier %d\n' % (msg.get('abbrev'), cid))
+        sys.exit(1)
+    ids.add(cid)
+
+    abbrev = msg.get('abbrev')
+    enc = Function('encode' + abbrev, 'void',
+                   [Var('msg_', 'const Message&'), Var('ref_', 'const Message*'), Var('w__', 'CompactCodec::Writer&')],
+                   static = True)
+    dec = Function('decode' + abbrev, 'void',
+                   [Var('msg_', 'Message&'), Var('ref_', 'const Message*'), Var('r__', 'CompactCodec::Reader&')],
+                   static = True)
+
+    fields = msg.findall('field')
+    if fields:
+        enc.add_body('const %s& msg__ = static_cast<const %s&>(msg_);' % (abbrev, abbrev))
+        dec.add_body('%s& msg__ = static_cast<%s&>(msg_);' % (abbrev, abbrev))
+    else:
+        enc.add_body('(void)msg_;\n(void)w__;')
+        dec.add_body('(void)msg_;\n(void)r__;')
+
+    if [fl for fl in fields if fl.get('compact-delta') is not None]:
+        enc.add_body('const %s* ref__ = static_cast<const %s*>(ref_);' % (abbrev, abbrev))
+        dec.add_body('const %s* ref__ = static_cast<const %s*>(ref_);' % (abbrev, abbrev))
+    else:
+        enc.add_body('(void)ref_;')
+        dec.add_body('(void)ref_;')
+
+    bits = 8
+    for field in fields:
+        name = get_name(field)
+        type = field.get('type')
+        if type in ('fp32_t', 'fp64_t') and field.get('compact-precision') is not None:
+            b, d, e, r = real_field(msg, field, name)
+            bits += b
+        elif type == 'fp32_t':
+            bits += 32
+            e = 'w__.putFP32(msg__.%s);' % name
+            r = 'msg__.%s = r__.getFP32();' % name
+        elif type == 'fp64_t':
+            bits += 64
+            e = 'w__.putFP64(msg__.%s);' % name
+            r = 'msg__.%s = r__.getFP64();' % name
+        elif type in c_widths:
+            b, e, r = integer_field(msg, field, name)
+            bits += b
+        elif type == 'plaintext':
+            bits += 8
+            e = 'w__.putText(msg__.%s);' % name
+            r = 'r__.getText(msg__.%s);' % name
+        elif type == 'rawdata':
+            bits += 8
+            e = 'w__.putData(msg__.%s);' % name
+            r = 'r__.getData(msg__.%s);' % name
+        else:
+            fatal(msg, field, 'type %s cannot be compacted' % type)
+        enc.add_body(e)
+        dec.add_body(r)
+
+
+    f.append(comment('%s: at least %d bits' % (msg.get('name'), bits), dox = False, nl = ''))
+    f.append(enc)
+    f.append(dec)
+    entries.append('{%d, %s, encode%s, decode%s}' % (cid, msg.get('id'), abbrev, abbrev))
+
+f.append('static const CompactEntry c_compact_entries[] =\n{')
+f.append(',\n'.join(entries))
+f.append('};')
+f.write()
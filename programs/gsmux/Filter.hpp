@@ -31,7 +31,9 @@
 // ISO C++ 98 headers.
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <cstring>
+#include <cstdlib>
 #include <cstdio>
 #include <iostream>
 
@@ -39,12 +41,24 @@
 static const unsigned c_pubx00_fields = 21;
 //! Minimum number of fields of PUBX,04 sentence.
 static const unsigned c_pubx04_fields = 10;
+//! Maximum number of fields of a sentence.
+static const unsigned c_max_fields = 32;
+//! Size of the output buffer.
+static const size_t c_output_size = 256 * 1024;
+//! Maximum size of an output line.
+static const size_t c_line_size = 4096;
+//! Navigation status codes of PUBX,00, in order.
+static const char* c_fix_types[] = {"NF", "DR", "G2", "G3", "D2", "D3", "RK", "TT"};
+//! Number of navigation status codes.
+static const unsigned c_fix_type_count = sizeof(c_fix_types) / sizeof(c_fix_types[0]);
 
 class Filter
 {
 public:
   Filter(std::FILE* fd):
-    m_fd(fd)
+    m_fd(fd),
+    m_output(c_output_size),
+    m_output_size(0)
   {
 #define FIELD(label, var, type, fmt)            \
     var = 0;
@@ -52,48 +66,47 @@ public:
 
     std::memset(m_sync_status, 0, sizeof(m_sync_status));
 
-    m_fix_type["NF"] = 0;
-    m_fix_type["DR"] = 1;
-    m_fix_type["G2"] = 2;
-    m_fix_type["G3"] = 3;
-    m_fix_type["D2"] = 4;
-    m_fix_type["D3"] = 5;
-    m_fix_type["RK"] = 6;
-    m_fix_type["TT"] = 7;
-
     printHeader();
   }
 
   ~Filter(void)
   {
+    flush();
   }
 
+  //! Write buffered output lines.
   void
-  putGPS(const std::vector<uint8_t>& data)
+  flush(void)
   {
-    if (m_sync_status[0] == 1)
+    if (m_output_size == 0)
       return;
 
-    std::fflush(m_fd);
+    std::fwrite(&m_output[0], 1, m_output_size, m_fd);
+    m_output_size = 0;
+  }
+
+  //! Interpret the GPS sentences of a block. Sentences are split in
+  //! place, so the data is modified.
+  //! @param[in] data GPS data.
+  void
+  putGPS(std::vector<uint8_t>& data)
+  {
+    if (m_sync_status[0] == 1)
+      return;
 
     m_sample_msec = 0;
 
-    unsigned off = 0;
-    unsigned size = 0;
+    char* ptr = (char*)&data[0];
+    char* end = ptr + data.size();
 
-    for (unsigned i = 0; i < data.size(); ++i)
+    while (ptr < end)
     {
-      if (data[i] == '\n')
-      {
-        std::string stn((const char*)&data[off], size);
-        interpret(stn);
-        off = size + 1;
-        size = 0;
-      }
-      else
-      {
-        ++size;
-      }
+      char* eol = (char*)std::memchr(ptr, '\n', end - ptr);
+      if (eol == NULL)
+        break;
+
+      interpret(ptr, eol - ptr);
+      ptr = eol + 1;
     }
   }
 
@@ -246,101 +259,132 @@ public:
     m_utc_tow = (m_utc_tow_msec + (index * 10)) / 1000.0;
     m_utc_second = (m_utc_second_msec + (index * 10)) / 1000.0;
 
-    fprintf(m_fd,
-            "%u" "\t"
-            "%u"
+    if (m_output.size() - m_output_size < c_line_size)
+      flush();
+
+    int rv = String::format(&m_output[m_output_size], c_line_size,
+                            "%u" "\t"
+                            "%u"
 #define FIELD(label, var, type, fmt) "\t" fmt
 #include "Fields.def"
-            "\r\n",
-            m_sync_status[index],
-            index
+                            "\r\n",
+                            m_sync_status[index],
+                            index
 #define FIELD(label, var, type, fmt) , var
 #include "Fields.def"
-            );
+                            );
+
+    if (rv > 0)
+      m_output_size += std::min((size_t)rv, c_line_size - 1);
 
     m_sample_msec += 10;
   }
 
 private:
   bool
-  readLatitude(const std::string& str, const std::string& h, double& dst)
+  readLatitude(const char* str, const char* h, double& dst)
   {
     int degrees = 0;
     double minutes = 0;
 
-    if (std::sscanf(str.c_str(), "%02d%lf", &degrees, &minutes) != 2)
+    if (std::sscanf(str, "%02d%lf", &degrees, &minutes) != 2)
       return false;
 
     dst = Angles::convertDMSToDecimal(degrees, minutes);
 
-    if (h == "S")
+    if (std::strcmp(h, "S") == 0)
       dst = -dst;
 
     return true;
   }
 
   double
-  readLongitude(const std::string& str, const std::string& h, double& dst)
+  readLongitude(const char* str, const char* h, double& dst)
   {
     int degrees = 0;
     double minutes = 0;
 
-    if (std::sscanf(str.c_str(), "%03d%lf", &degrees, &minutes) != 2)
+    if (std::sscanf(str, "%03d%lf", &degrees, &minutes) != 2)
       return false;
 
     dst = Angles::convertDMSToDecimal(degrees, minutes);
 
-    if (h == "W")
+    if (std::strcmp(h, "W") == 0)
       dst = -dst;
 
     return true;
   }
 
-  template <typename T>
   bool
-  readDecimal(const std::string& str, T& dst)
+  readDecimal(const char* str, unsigned& dst)
   {
-    unsigned idx = 0;
-    while (str[idx] == '0')
-      ++idx;
+    char* end = NULL;
+    unsigned long value = std::strtoul(str, &end, 10);
+    if (end == str)
+      return false;
 
-    return castLexical(std::string(str, idx), dst);
+    dst = (unsigned)value;
+    return true;
   }
 
-  template <typename T>
   bool
-  readNumber(const std::string& str, T& dst)
+  readNumber(const char* str, double& dst)
   {
-    return castLexical(str, dst);
+    char* end = NULL;
+    double value = std::strtod(str, &end);
+    if (end == str)
+      return false;
+
+    dst = value;
+    return true;
   }
 
+  //! Interpret one sentence.
+  //! @param[in] stn sentence, without the line feed. The sentence
+  //! is split in place.
+  //! @param[in] size size of the sentence.
   void
-  interpret(std::string stn)
+  interpret(char* stn, size_t size)
   {
-    if (stn.size() < 5)
+    if (size < 5)
       return;
 
     // Remove checksum.
-    stn.resize(stn.size() - 4);
+    size -= 4;
+    stn[size] = '\0';
 
-    std::vector<std::string> parts;
-    String::split(stn, ",", parts);
+    const char* parts[c_max_fields];
+    unsigned count = 0;
+    parts[count++] = stn;
 
-    if ((parts[0] == "$PUBX") && (parts[1] == "00"))
-      interpretPUBX00(parts);
-    else if ((parts[0] == "$PUBX") && (parts[1] == "04"))
-      interpretPUBX04(parts);
+    for (char* ptr = stn; *ptr != '\0'; ++ptr)
+    {
+      if (*ptr == ',' && count < c_max_fields)
+      {
+        *ptr = '\0';
+        parts[count++] = ptr + 1;
+      }
+    }
+
+    if (count > 1 && (std::strcmp(parts[0], "$PUBX") == 0) && (std::strcmp(parts[1], "00") == 0))
+      interpretPUBX00(parts, count);
+    else if (count > 1 && (std::strcmp(parts[0], "$PUBX") == 0) && (std::strcmp(parts[1], "04") == 0))
+      interpretPUBX04(parts, count);
     else
     {
+      // Undo the split to report the sentence.
+      for (unsigned i = 1; i < count; ++i)
+        *(char*)(parts[i] - 1) = ',';
+
       std::cerr << "ERROR: unknown NMEA message." << std::endl;
-      std::cerr << sanitize(stn) << std::endl;
+      std::cerr << sanitize(std::string(stn, size)) << std::endl;
     }
   }
 
   void
-  interpretPUBX04(const std::vector<std::string>& parts)
+  interpretPUBX04(const char* const* parts, unsigned count)
   {
-    if (parts.size() < c_pubx04_fields)
+    if (count < c_pubx04_fields)
     {
       std::cerr << "WARNING: invalid PUBX,04 sentence" << std::endl;
       return;
@@ -351,7 +395,7 @@ private:
     unsigned m = 0;
     double s = 0;
 
-    if (std::sscanf(parts[2].c_str(), "%02u%02u%lf", &h, &m, &s) == 3)
+    if (std::sscanf(parts[2], "%02u%02u%lf", &h, &m, &s) == 3)
     {
       m_utc_hour = h;
       m_utc_minute = m;
@@ -363,7 +407,7 @@ private:
     unsigned month = 0;
     unsigned year = 0;
 
-    if (std::sscanf(parts[3].c_str(), "%02u%02u%02u", &day, &month, &year) != 3)
+    if (std::sscanf(parts[3], "%02u%02u%02u", &day, &month, &year) != 3)
     {
       std::cerr << "WARNING: invalid date" << std::endl;
     }
@@ -376,7 +420,7 @@ private:
 
     // Read UTC week number.
     unsigned wno;
-    if (castLexical(parts[5], wno))
+    if (readDecimal(parts[5], wno))
     {
       m_utc_wno = wno;
     }
@@ -387,7 +431,7 @@ private:
 
     // Read UTC time of week.
     double tow;
-    if (std::sscanf(parts[4].c_str(), "%lf", &tow))
+    if (std::sscanf(parts[4], "%lf", &tow))
     {
       m_utc_tow_msec = static_cast<unsigned>(tow * 1000);
     }
@@ -398,20 +442,24 @@ private:
   }
 
   void
-  interpretPUBX00(const std::vector<std::string>& parts)
+  interpretPUBX00(const char* const* parts, unsigned count)
   {
-    if (parts.size() < c_pubx00_fields)
+    if (count < c_pubx00_fields)
     {
       std::cerr << "WARNING: invalid PUBX,00 sentence\n" << std::endl;
       return;
     }
 
     // Navigation status.
-    std::map<std::string, unsigned>::iterator itr = m_fix_type.find(parts[8]);
-    if (itr == m_fix_type.end())
-      m_nav_status = 99;
-    else
-      m_nav_status = itr->second;
+    m_nav_status = 99;
+    for (unsigned i = 0; i < c_fix_type_count; ++i)
+    {
+      if (std::strcmp(parts[8], c_fix_types[i]) == 0)
+      {
+        m_nav_status = i;
+        break;
+      }
+    }
 
     readLatitude(parts[3], parts[4], m_lat);
     readLongitude(parts[5], parts[6], m_lon);
@@ -420,35 +468,35 @@ private:
 
     // HDOP.
     double hdop = 0;
-    if (std::sscanf(parts[15].c_str(), "%lf", &hdop) == 1)
+    if (std::sscanf(parts[15], "%lf", &hdop) == 1)
     {
       m_hdop = hdop;
     }
 
     // VDOP.
     double vdop = 0;
-    if (std::sscanf(parts[16].c_str(), "%lf", &vdop) == 1)
+    if (std::sscanf(parts[16], "%lf", &vdop) == 1)
     {
       m_vdop = vdop;
     }
 
     // TDOP.
     double tdop = 0;
-    if (std::sscanf(parts[17].c_str(), "%lf", &tdop) == 1)
+    if (std::sscanf(parts[17], "%lf", &tdop) == 1)
     {
       m_tdop = tdop;
     }
 
     // Speed over ground.
     double sog = 0;
-    if (std::sscanf(parts[11].c_str(), "%lf", &sog) == 1)
+    if (std::sscanf(parts[11], "%lf", &sog) == 1)
     {
       m_sog = sog;
     }
 
     // Course over ground.
     double cog = 0;
-    if (std::sscanf(parts[12].c_str(), "%lf", &cog) == 1)
+    if (std::sscanf(parts[12], "%lf", &cog) == 1)
     {
       m_cog = cog;
     }
@@ -460,8 +508,10 @@ private:
   uint8_t m_sync_status[100];
   //! Sample millisecond.
   unsigned m_sample_msec;
-  //! Fix type.
-  std::map<std::string, unsigned> m_fix_type;
+  //! Output buffer.
+  std::vector<char> m_output;
+  //! Size of buffered output.
+  size_t m_output_size;
 
 #define FIELD(label, var, type, fmt)            \
   type var;
@@ -32,6 +32,7 @@
 #include <vector>
 #include <string>
 #include <cstdio>
+#include <cstring>
 
 // Local headers.
 #include "Filter.hpp"
@@ -51,6 +52,9 @@ enum Channels
   CHANNEL_COUNT = 0x04
 };
 
+//! Number of samples per block (one second).
+static const unsigned c_block_samples = 100;
+
 class Parser
 {
 public:
@@ -64,115 +68,83 @@ public:
     m_sample_count = 0;
   }
 
+  //! Parse a chunk of the multiplexed stream. Chunks may end
+  //! anywhere, the state is kept between calls.
+  //! @param[in] data chunk data.
+  //! @param[in] size chunk size.
   void
-  parse(uint8_t byte)
+  parse(const uint8_t* data, size_t size)
   {
-    switch (m_state)
+    const uint8_t* end = data + size;
+
+    for (; data < end; ++data)
     {
-      case STATE_SYNC:
-        if (byte == 0x3a)
-        {
+      switch (m_state)
+      {
+        case STATE_SYNC:
+          // Skip to the next synchronization byte.
+          data = (const uint8_t*)std::memchr(data, 0x3a, end - data);
+          if (data == NULL)
+            return;
           m_state = STATE_CHAN;
-        }
-        break;
-
-      case STATE_CHAN:
-        if (byte < CHANNEL_COUNT)
-        {
-          m_channel = byte;
-          m_state = STATE_BYTE;
-        }
-        else
-        {
-          m_state = STATE_SYNC;
-        }
-        break;
-
-      case STATE_BYTE:
-        m_state = STATE_SYNC;
-        if (m_channel == CHANNEL_IDX)
-        {
-          uint8_t sync = byte >> 7;
-          uint8_t index = byte & 0x7f;
-
-          if ((m_block_cnt < 5) && (index == 0))
-            ++m_block_cnt;
+          break;
 
-          if (m_block_cnt < 5)
-            break;
-
-          ++m_sample_count;
-          m_sample = index;
-
-          m_filter.putSyncStatus(index, sync);
-
-          if (m_sample == 0)
+        case STATE_CHAN:
+          if (*data < CHANNEL_COUNT)
           {
-            if (m_sample_count == 100)
-              filter();
-            m_sample_count = 0;
-          }
-        }
-        else if (m_sample != -1)
-        {
-          if ((m_sample < 100) && (m_channel < CHANNEL_COUNT))
-          {
-            //printf("%d, %d\n", m_channel - 1, m_sample);
-
-            //fprintf(stderr, "%d / %d\n", m_channel - 1, m_sample);
-
-            m_buffer[m_channel - 1][m_sample].push_back(byte);
+            m_channel = *data;
+            m_state = STATE_BYTE;
           }
           else
           {
-            std::cerr << "ERROR: sample " << m_sample << ", channel "
-                      << m_channel << std::endl;
+            m_state = STATE_SYNC;
           }
-        }
-        break;
+          break;
+
+        case STATE_BYTE:
+          m_state = STATE_SYNC;
+          parseByte(*data);
+          break;
+      }
     }
   }
 
+  //! Write pending output.
   void
-  filter(void)
+  flush(void)
   {
-    std::vector<uint8_t> data(0);
+    m_filter.flush();
+  }
 
+  void
+  filter(void)
+  {
     // GPS.
-    for (unsigned i = 0; i < 100; ++i)
+    m_gps.clear();
+    for (unsigned i = 0; i < c_block_samples; ++i)
     {
-      for (unsigned j = 0; j < m_buffer[CHANNEL_GPS - 1][i].size(); ++j)
-        data.push_back(m_buffer[CHANNEL_GPS - 1][i][j]);
-      m_buffer[CHANNEL_GPS - 1][i].clear();
+      std::vector<uint8_t>& sample = m_buffer[CHANNEL_GPS - 1][i];
+      m_gps.insert(m_gps.end(), sample.begin(), sample.end());
+      sample.clear();
     }
 
-    // for (unsigned i = 0; i < data.size(); ++i)
-    //   printf("%c", data[i]);
-
-    if (data.size() == 0)
+    if (m_gps.size() == 0)
     {
       std::cerr << "ERROR: empty GPS data." << std::endl;
       return;
     }
 
-    m_filter.putGPS(data);
+    m_filter.putGPS(m_gps);
 
-    // MTi.
-    for (unsigned i = 0; i < 100; ++i)
+    for (unsigned i = 0; i < c_block_samples; ++i)
     {
       // MTi.
-      data.clear();
-      for (unsigned j = 0; j < m_buffer[CHANNEL_MTI - 1][i].size(); ++j)
-        data.push_back(m_buffer[CHANNEL_MTI - 1][i][j]);
+      m_filter.putXMTI(m_buffer[CHANNEL_MTI - 1][i], i);
       m_buffer[CHANNEL_MTI - 1][i].clear();
-      m_filter.putXMTI(data, i);
 
       // LIMU.
-      data.clear();
-      for (unsigned j = 0; j < m_buffer[CHANNEL_LIMU - 1][i].size(); ++j)
-        data.push_back(m_buffer[CHANNEL_LIMU - 1][i][j]);
+      m_filter.putLIMU(m_buffer[CHANNEL_LIMU - 1][i], i);
       m_buffer[CHANNEL_LIMU - 1][i].clear();
-      m_filter.putLIMU(data, i);
 
       m_filter.print(i);
     }
@@ -186,8 +158,54 @@ private:
     STATE_BYTE
   };
 
+  //! Handle the data byte of a channel.
+  //! @param[in] byte data byte.
+  void
+  parseByte(uint8_t byte)
+  {
+    if (m_channel == CHANNEL_IDX)
+    {
+      uint8_t sync = byte >> 7;
+      uint8_t index = byte & 0x7f;
+
+      if ((m_block_cnt < 5) && (index == 0))
+        ++m_block_cnt;
+
+      if (m_block_cnt < 5)
+        return;
+
+      ++m_sample_count;
+      m_sample = index;
+
+      m_filter.putSyncStatus(index, sync);
+
+      if (m_sample == 0)
+      {
+        if (m_sample_count == c_block_samples)
+          filter();
+        m_sample_count = 0;
+      }
+    }
+    else if (m_sample != -1)
+    {
+      if ((m_sample < (int)c_block_samples) && (m_channel < CHANNEL_COUNT))
+      {
+        m_buffer[m_channel - 1][m_sample].push_back(byte);
+      }
+      else
+      {
+        std::cerr << "ERROR: sample " << m_sample << ", channel "
+                  << m_channel << std::endl;
+      }
+    }
+  }
+
   unsigned m_block_cnt;
-  std::vector<uint8_t> m_buffer[CHANNEL_COUNT - 1][100];
+  //! Data of each channel and sample. Buffers keep their capacity
+  //! between blocks.
+  std::vector<uint8_t> m_buffer[CHANNEL_COUNT - 1][c_block_samples];
+  //! GPS data of the current block.
+  std::vector<uint8_t> m_gps;
   State m_state;
   int m_channel;
   int m_sample;
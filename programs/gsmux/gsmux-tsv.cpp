@@ -38,6 +38,9 @@ using DUNE_NAMESPACES;
 // Local headers.
 #include "Parser.hpp"
 
+//! Size of the read buffer.
+static const size_t c_read_size = 1024 * 1024;
+
 int
 main(int argc, char** argv)
 {
@@ -64,19 +67,20 @@ main(int argc, char** argv)
     return 1;
   }
 
-  uint8_t bfr[1024] = {0};
+  std::vector<uint8_t> bfr(c_read_size);
   ::Parser parser(tsv);
 
   while (!std::feof(bin))
   {
-    size_t rv = std::fread(bfr, 1, sizeof(bfr), bin);
+    size_t rv = std::fread(&bfr[0], 1, bfr.size(), bin);
     if (rv <= 0)
       break;
 
-    for (size_t i = 0; i < rv; ++i)
-      parser.parse(bfr[i]);
+    parser.parse(&bfr[0], rv);
   }
 
+  parser.flush();
+
   std::fclose(bin);
   std::fclose(tsv);
 
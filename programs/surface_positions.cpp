@@ -33,6 +33,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <map>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -52,12 +53,6 @@ main(int32_t argc, char** argv)
     return 1;
   }
 
-  std::istream* is = 0;
-  Compression::Methods method = Compression::Factory::detect(argv[1]);
-  if (method == METHOD_UNKNOWN)
-    is = new std::ifstream(argv[1], std::ios::binary);
-  else
-    is = new Compression::FileInput(argv[1], method);
 
   ByteBuffer buffer;
   std::ofstream lsf("SurfaceData.lsf", std::ios::binary);
@@ -73,23 +68,26 @@ main(int32_t argc, char** argv)
 
   try
   {
-    while ((msg = IMC::Packet::deserialize(*is)) != 0)
+    std::set<uint16_t> ids;
+    ids.insert(DUNE_IMC_GPSFIX);
+
+    IMC::LogReader reader(argv[1]);
+    reader.setFilter(ids);
+
+    while ((msg = reader.read()) != 0)
     {
-      if (msg->getId() == DUNE_IMC_GPSFIX)
-      {
-        IMC::GpsFix* fix = dynamic_cast<IMC::GpsFix*>(msg);
+      IMC::GpsFix* fix = dynamic_cast<IMC::GpsFix*>(msg);
 
-        if ((fix->hacc <= MIN_HACC) &&
-            (fix->validity & IMC::GpsFix::GFV_VALID_POS) &&
-            (fix->getTimeStamp() >= timestamp))
-        {
-          timestamp = fix->getTimeStamp();
+      if ((fix->hacc <= MIN_HACC) &&
+          (fix->validity & IMC::GpsFix::GFV_VALID_POS) &&
+          (fix->getTimeStamp() >= timestamp))
+      {
+        timestamp = fix->getTimeStamp();
 
-          IMC::Packet::serialize(msg, buffer);
-          lsf.write(buffer.getBufferSigned(), buffer.getSize());
+        IMC::Packet::serialize(msg, buffer);
+        lsf.write(buffer.getBufferSigned(), buffer.getSize());
 
-          ++i;
-        }
+        ++i;
       }
 
       delete msg;
@@ -103,8 +101,6 @@ main(int32_t argc, char** argv)
 
   lsf.close();
 
-  delete is;
-
   std::cerr << "Got " << i << " GpsFix messages." << std::endl;
 
   return 0;
@@ -0,0 +1,157 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Navigation::AAKR.                                 *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Navigation/AAKR.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Math::Matrix;
+using DUNE::Navigation::AAKR;
+
+//! Sample dimension.
+static const unsigned c_dim = 3;
+
+static double
+uniform(void)
+{
+  return std::rand() / (double)RAND_MAX;
+}
+
+//! Reference estimate: kernel-weighted mean over every sample of the
+//! window, in normalized coordinates.
+static Matrix
+bruteForce(const std::vector<std::vector<double> >& window, const Matrix& query, double variance)
+{
+  double n = window.size();
+  std::vector<double> mean(c_dim, 0.0);
+  std::vector<double> std(c_dim, 0.0);
+
+  for (unsigned i = 0; i < window.size(); ++i)
+    for (unsigned j = 0; j < c_dim; ++j)
+      mean[j] += window[i][j] / n;
+
+  for (unsigned i = 0; i < window.size(); ++i)
+    for (unsigned j = 0; j < c_dim; ++j)
+      std[j] += (window[i][j] - mean[j]) * (window[i][j] - mean[j]) / n;
+
+  for (unsigned j = 0; j < c_dim; ++j)
+    std[j] = std::sqrt(std[j]);
+
+  double s = 0;
+  std::vector<double> acc(c_dim, 0.0);
+  for (unsigned i = 0; i < window.size(); ++i)
+  {
+    double d = 0;
+    for (unsigned j = 0; j < c_dim; ++j)
+    {
+      double x = (query(j) - window[i][j]) / std[j];
+      d += x * x;
+    }
+
+    double w = std::exp(- d / (variance * variance));
+    s += w;
+    for (unsigned j = 0; j < c_dim; ++j)
+      acc[j] += w * window[i][j];
+  }
+
+  Matrix result(1, c_dim);
+  for (unsigned j = 0; j < c_dim; ++j)
+    result(j) = acc[j] / s;
+
+  return result;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Navigation::AAKR");
+
+  std::srand(7);
+
+  const unsigned size = 500;
+  AAKR aakr;
+  aakr.resize(size, c_dim);
+
+  std::vector<std::vector<double> > samples;
+  bool exact = true;
+  bool far = true;
+
+  for (unsigned k = 0; k < 1300; ++k)
+  {
+    // Correlated, slowly drifting signals.
+    Matrix v(1, c_dim);
+    double t = k * 0.01;
+    v(0) = std::sin(t) + 0.1 * uniform();
+    v(1) = 10.0 * std::cos(t) + uniform();
+    v(2) = 0.5 * v(0) + 0.01 * k + 0.05 * uniform();
+    aakr.add(v);
+
+    samples.push_back(std::vector<double>(c_dim));
+    for (unsigned j = 0; j < c_dim; ++j)
+      samples.back()[j] = v(j);
+
+    if (k % 97 != 96)
+      continue;
+
+    unsigned first = samples.size() > size ? samples.size() - size : 0;
+    std::vector<std::vector<double> > window(samples.begin() + first, samples.end());
+
+    Matrix q(1, c_dim);
+    q(0) = v(0) + 0.05;
+    q(1) = v(1) - 0.3;
+    q(2) = v(2) + 0.02;
+
+    Matrix e = aakr.estimate(q, 0.5);
+    Matrix r = bruteForce(window, q, 0.5);
+    for (unsigned j = 0; j < c_dim; ++j)
+      exact = exact && std::fabs(e(j) - r(j)) < 1e-6 * (1.0 + std::fabs(r(j)));
+
+    // A query far from every sample falls back to the exhaustive sum.
+    Matrix f(1, c_dim);
+    f(0) = 100.0;
+    f(1) = 100.0;
+    f(2) = 100.0;
+    Matrix g = aakr.estimate(f, 0.5);
+    for (unsigned j = 0; j < c_dim; ++j)
+      far = far && g(j) == g(j);
+  }
+
+  test.boolean("estimate() matches the exhaustive estimate", exact);
+  test.boolean("estimate() handles queries outside the kernel radius", far);
+
+  return test.getReturnValue();
+}
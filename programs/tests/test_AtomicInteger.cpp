@@ -26,7 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
-#include <iostream>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Concurrency.hpp>
@@ -36,62 +36,113 @@
 
 using namespace DUNE::Concurrency;
 
+//! Number of worker threads.
+static const unsigned c_workers = 4;
+//! Number of iterations of each worker.
+static const unsigned c_iterations = 100000;
+
+//! Worker that increments shared values, half of the time inside a
+//! critical section protected by a spin lock.
+class Worker: public Thread
+{
+public:
+  Worker(AtomicInteger& value, AtomicCounter& counter, AtomicFlag& lock, long& guarded):
+    m_value(value),
+    m_counter(counter),
+    m_lock(lock),
+    m_guarded(guarded)
+  { }
+
+private:
+  AtomicInteger& m_value;
+  AtomicCounter& m_counter;
+  AtomicFlag& m_lock;
+  long& m_guarded;
+
+  void
+  run(void)
+  {
+    for (unsigned i = 0; i < c_iterations; ++i)
+    {
+      m_value.increment();
+      m_counter.add(2, MEMORY_ORDER_RELAXED);
+
+      if (i % 2 == 0)
+      {
+        while (m_lock.testAndSet(MEMORY_ORDER_ACQUIRE))
+          ;
+        ++m_guarded;
+        m_lock.clear(MEMORY_ORDER_RELEASE);
+      }
+    }
+  }
+};
+
 int
 main(void)
 {
   Test test("Concurrency::AtomicInteger");
 
-  //  AtomicInteger aint(10);
+  {
+    AtomicInteger aint = 10;
+    test.boolean("increment()", aint.increment() == 11);
+    test.boolean("decrement()", aint.decrement() == 10);
+    test.boolean("add()", aint.add(-15) == -5);
+    test.boolean("swap()", aint.swap(3) == -5 && aint.value() == 3);
+    test.boolean("compareAndSwap() (match)", aint.compareAndSwap(3, 4) && aint.value() == 4);
+    test.boolean("compareAndSwap() (mismatch)", !aint.compareAndSwap(3, 5) && aint.value() == 4);
+
+    AtomicInteger copy = aint;
+    test.boolean("copy", copy.value() == 4);
+  }
 
-  AtomicInteger aint2 = 0;
+  {
+    AtomicCounter counter(5);
+    test.boolean("AtomicCounter", counter.add(3) == 8 && counter.sub(10) == -2 && counter.value() == -2);
+  }
+
+  {
+    AtomicFlag flag;
+    test.boolean("AtomicFlag::testAndSet() (clear)", !flag.testAndSet() && flag.test());
+    test.boolean("AtomicFlag::testAndSet() (set)", flag.testAndSet());
+    flag.clear();
+    test.boolean("AtomicFlag::clear()", !flag.test());
+  }
+
+  {
+    int a = 1;
+    int b = 2;
+    AtomicPointer<int> ptr(&a);
+    test.boolean("AtomicPointer::exchange()", ptr.exchange(&b) == &a && ptr.load() == &b);
+
+    int* expected = &a;
+    test.boolean("AtomicPointer::compareExchange() (mismatch)", !ptr.compareExchange(expected, &a) && expected == &b);
+    test.boolean("AtomicPointer::compareExchange() (match)", ptr.compareExchange(expected, NULL) && ptr.load() == NULL);
+  }
 
-  for (int i = 0; i < 10; ++i)
   {
-    std::cerr << aint2.increment() << std::endl;
+    AtomicInteger value;
+    AtomicCounter counter;
+    AtomicFlag lock;
+    long guarded = 0;
+
+    std::vector<Worker*> workers;
+    for (unsigned i = 0; i < c_workers; ++i)
+    {
+      workers.push_back(new Worker(value, counter, lock, guarded));
+      workers.back()->start();
+    }
+
+    for (unsigned i = 0; i < c_workers; ++i)
+    {
+      workers[i]->join();
+      delete workers[i];
+    }
+
+    test.boolean("concurrent increment()", value.value() == (long)(c_workers * c_iterations));
+    test.boolean("concurrent add()", counter.value() == (int)(2 * c_workers * c_iterations));
+    test.boolean("concurrent testAndSet()", guarded == (long)(c_workers * c_iterations / 2));
   }
 
-  // {
-  //   Address a = Address::Any;
-  //   test.boolean("Static address (Any)", a.str() == "0.0.0.0");
-  // }
-
-  // {
-  //   Address a = Address::Loopback;
-  //   test.boolean("Static address (Loopback)", a.str() == "127.0.0.1");
-  // }
-
-  // {
-  //   Address a = Address::Broadcast;
-  //   test.boolean("Static address (Broadcast)", a.str() == "255.255.255.255");
-  // }
-
-  // {
-  //   Address a = "140.130.23.1";
-  //   Address b = a;
-  //   test.boolean("Assignment operator (Address)", a == b);
-  // }
-
-  // {
-  //   Address a = "140.130.23.1";
-  //   Address b = a.toNativeInteger();
-  //   test.boolean("Assignment operator (uint32_t)", a == b);
-  // }
-
-  // {
-  //   Address a = "whale.fe.up.pt";
-  //   a.resolve();
-  //   test.boolean("Hostname resolution (valid)", a.str() == "193.136.28.163");
-  // }
-
-  // {
-  //   Address a = "xxxwwwxxxx.com";
-  //   test.boolean("Hostname resolution (invalid)", !a.resolve());
-  // }
-
-  // {
-  //   Address a = "192.168.106.1";
-  //   test.boolean("IP address resolution", a.resolve());
-  // }
-
-  return 0;
+  return test.getReturnValue();
 }
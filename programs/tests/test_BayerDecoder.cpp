@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Media/BayerDecoder.hpp>
+#include <DUNE/Utils/String.hpp>
+#include <DUNE/Media/JPEGCompressor.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Media::BayerDecoder;
+using DUNE::Media::JPEGCompressor;
+using DUNE::Utils::String;
+
+//! Colors of each tile format (0: red, 1: green, 2: blue).
+static const int c_sites[4][4] =
+{
+  {1, 2, 0, 1},
+  {1, 0, 2, 1},
+  {0, 1, 1, 2},
+  {2, 1, 1, 0}
+};
+
+static int
+avg(int a, int b)
+{
+  return (a + b + 1) >> 1;
+}
+
+static int
+mirror(int i, int n)
+{
+  return i < 0 ? -i : (i >= n ? 2 * n - 2 - i : i);
+}
+
+//! Straightforward implementation of the documented conversion.
+static void
+reference(int tile, const std::vector<uint8_t>& bayer, int w, int h,
+          std::vector<uint8_t>& y, std::vector<uint8_t>& cb, std::vector<uint8_t>& cr)
+{
+  static const int c_luma[3] = {77, 150, 29};
+
+  for (int j = 0; j < h; ++j)
+  {
+    for (int i = 0; i < w; ++i)
+    {
+      int n = mirror(j - 1, h) * w;
+      int c = j * w;
+      int s = mirror(j + 1, h) * w;
+      int wi = mirror(i - 1, w);
+      int ei = mirror(i + 1, w);
+
+      int hz = avg(bayer[c + wi], bayer[c + ei]);
+      int vt = avg(bayer[n + i], bayer[s + i]);
+      int dg = avg(avg(bayer[n + wi], bayer[n + ei]), avg(bayer[s + wi], bayer[s + ei]));
+
+      int site = c_sites[tile][(j & 1) * 2 + (i & 1)];
+      int next = c_sites[tile][(j & 1) * 2 + ((i & 1) ^ 1)];
+      int sum = c_luma[site] * bayer[c + i] + 128;
+
+      if (site == 1)
+        sum += c_luma[next] * hz + c_luma[2 - next] * vt;
+      else
+        sum += c_luma[1] * avg(hz, vt) + c_luma[2 - site] * dg;
+
+      y[c + i] = (uint8_t)(sum >> 8);
+    }
+  }
+
+  for (int j = 0; j < h / 2; ++j)
+  {
+    for (int i = 0; i < w / 2; ++i)
+    {
+      int rgb[3] = {0, 0, 0};
+      int greens[2] = {0, 0};
+      int g = 0;
+      for (int k = 0; k < 4; ++k)
+      {
+        int v = bayer[(2 * j + k / 2) * w + 2 * i + k % 2];
+        if (c_sites[tile][k] == 1)
+          greens[g++] = v;
+        else
+          rgb[c_sites[tile][k]] = v;
+      }
+      rgb[1] = avg(greens[0], greens[1]);
+
+      int u = 128 + ((-22 * rgb[0] - 42 * rgb[1] + 64 * rgb[2] + 64) >> 7);
+      int v = 128 + ((64 * rgb[0] - 54 * rgb[1] - 10 * rgb[2] + 64) >> 7);
+      cb[j * (w / 2) + i] = (uint8_t)std::min(u, 255);
+      cr[j * (w / 2) + i] = (uint8_t)std::min(v, 255);
+    }
+  }
+}
+
+int
+main(void)
+{
+  Test test("Media::BayerDecoder");
+
+  static const BayerDecoder::Tile c_tiles[4] =
+  {
+    BayerDecoder::TILE_GBRG,
+    BayerDecoder::TILE_GRBG,
+    BayerDecoder::TILE_RGGB,
+    BayerDecoder::TILE_BGGR
+  };
+
+  static const int c_sizes[][2] = {{2, 2}, {16, 4}, {38, 10}, {64, 6}, {82, 34}};
+
+  std::srand(2205);
+
+  for (int t = 0; t < 4; ++t)
+  {
+    BayerDecoder decoder(c_tiles[t]);
+    bool ok = true;
+
+    for (unsigned s = 0; s < sizeof(c_sizes) / sizeof(c_sizes[0]); ++s)
+    {
+      int w = c_sizes[s][0];
+      int h = c_sizes[s][1];
+      std::vector<uint8_t> bayer(w * h);
+      for (unsigned i = 0; i < bayer.size(); ++i)
+        bayer[i] = (i % 7 == 0) ? 255 : (uint8_t)(std::rand() & 0xff);
+
+      std::vector<uint8_t> y(w * h), cb(w * h / 4), cr(w * h / 4);
+      std::vector<uint8_t> ry(w * h), rcb(w * h / 4), rcr(w * h / 4);
+      decoder.decodeToYCbCr420(&bayer[0], &y[0], &cb[0], &cr[0], w, h);
+      reference(t, bayer, w, h, ry, rcb, rcr);
+      ok = ok && y == ry && cb == rcb && cr == rcr;
+    }
+
+    test.boolean(String::str("tile %d matches reference", t).c_str(), ok);
+  }
+
+  // Gray is gray in every tile format.
+  {
+    std::vector<uint8_t> bayer(40 * 20, 100);
+    std::vector<uint8_t> y(40 * 20), cb(10 * 20), cr(10 * 20);
+    BayerDecoder decoder(BayerDecoder::TILE_RGGB);
+    decoder.decodeToYCbCr420(&bayer[0], &y[0], &cb[0], &cr[0], 40, 20);
+    bool ok = true;
+    for (unsigned i = 0; i < y.size(); ++i)
+      ok = ok && y[i] == 100;
+    for (unsigned i = 0; i < cb.size(); ++i)
+      ok = ok && cb[i] == 128 && cr[i] == 128;
+    test.boolean("gray mosaic", ok);
+  }
+
+  // Planes of any size compress to a JPEG image.
+  {
+    int w = 38;
+    int h = 22;
+    std::vector<uint8_t> bayer(w * h);
+    for (unsigned i = 0; i < bayer.size(); ++i)
+      bayer[i] = (uint8_t)(i * 13);
+
+    std::vector<uint8_t> yuv(w * h * 3 / 2);
+    uint8_t* cb = &yuv[w * h];
+    uint8_t* cr = cb + w * h / 4;
+    BayerDecoder decoder(BayerDecoder::TILE_GBRG);
+    decoder.decodeToYCbCr420(&bayer[0], &yuv[0], cb, cr, w, h);
+
+    JPEGCompressor jpeg;
+    jpeg.setInputDimensions(w, h);
+    jpeg.compressYCbCr420(&yuv[0], cb, cr, 80);
+    const uint8_t* data = jpeg.imageData();
+    uint32_t size = jpeg.imageSize();
+    test.boolean("JPEG markers", size > 4 && data[0] == 0xff && data[1] == 0xd8
+                 && data[size - 2] == 0xff && data[size - 1] == 0xd9);
+
+    // RGB compression keeps working afterwards.
+    std::vector<uint8_t> rgb(w * h * 3, 50);
+    jpeg.compress(&rgb[0], 80);
+    test.boolean("RGB after YCbCr", jpeg.imageSize() > 4);
+  }
+
+  return test.getReturnValue();
+}
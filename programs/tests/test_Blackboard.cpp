@@ -0,0 +1,108 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::IMC;
+
+//! Dispatch a copy of an estimated state through the bus.
+static void
+dispatch(Bus& bus, unsigned source, unsigned entity, double depth)
+{
+  EstimatedState msg;
+  msg.setSource(source);
+  msg.setSourceEntity(entity);
+  msg.depth = depth;
+  bus.dispatch(&msg);
+}
+
+int
+main(void)
+{
+  Test test("IMC::Blackboard");
+
+  AddressResolver resolver;
+  resolver.id(0x1234);
+
+  Blackboard board(resolver);
+  Bus bus;
+  bus.setBlackboard(&board);
+
+  dispatch(bus, 0x1234, 1, 1.0);
+  test.boolean("untracked types are not stored", board.getSequence(DUNE_IMC_ESTIMATEDSTATE) == 0
+               && board.getLatest(DUNE_IMC_ESTIMATEDSTATE) == NULL);
+
+  board.track(DUNE_IMC_ESTIMATEDSTATE);
+  board.track(DUNE_IMC_ESTIMATEDSTATE);
+  test.boolean("track() is idempotent", board.isTracked(DUNE_IMC_ESTIMATEDSTATE));
+
+  dispatch(bus, 0x4321, 1, 1.0);
+  test.boolean("other systems are not stored", board.getSequence(DUNE_IMC_ESTIMATEDSTATE) == 0);
+
+  dispatch(bus, 0x1234, 1, 2.0);
+  dispatch(bus, 0x1234, 2, 3.0);
+  dispatch(bus, 0x1234, 1, 4.0);
+  test.boolean("sequence counts updates", board.getSequence(DUNE_IMC_ESTIMATEDSTATE) == 3);
+
+  SharedMessage* msg = board.get(DUNE_IMC_ESTIMATEDSTATE, 1);
+  test.boolean("get() returns latest of entity", msg != NULL
+               && static_cast<const EstimatedState*>(msg->get())->depth == 4.0);
+  if (msg != NULL)
+    msg->release();
+
+  msg = board.get(DUNE_IMC_ESTIMATEDSTATE, 3);
+  test.boolean("get() of unknown entity", msg == NULL);
+
+  msg = board.getLatest(DUNE_IMC_ESTIMATEDSTATE);
+  test.boolean("getLatest() returns most recent", msg != NULL
+               && msg->get()->getSourceEntity() == 1);
+  if (msg != NULL)
+    msg->release();
+
+  std::vector<SharedMessage*> changes;
+  uint32_t seq = board.getChanges(DUNE_IMC_ESTIMATEDSTATE, 0, changes);
+  test.boolean("getChanges() since start", seq == 3 && changes.size() == 2);
+  for (unsigned i = 0; i < changes.size(); ++i)
+    changes[i]->release();
+  changes.clear();
+
+  dispatch(bus, 0x1234, 2, 5.0);
+  seq = board.getChanges(DUNE_IMC_ESTIMATEDSTATE, seq, changes);
+  test.boolean("getChanges() since last poll", seq == 4 && changes.size() == 1
+               && changes[0]->get()->getSourceEntity() == 2);
+  for (unsigned i = 0; i < changes.size(); ++i)
+    changes[i]->release();
+  changes.clear();
+
+  seq = board.getChanges(DUNE_IMC_ESTIMATEDSTATE, seq, changes);
+  test.boolean("getChanges() without changes", seq == 4 && changes.empty());
+
+  return 0;
+}
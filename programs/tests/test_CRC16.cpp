@@ -0,0 +1,90 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ headers
+#include <cstring>
+#include "Test.hpp"
+
+// DUNE headers
+#include <DUNE/Algorithms/CRC16.hpp>
+#include <DUNE/Algorithms/XORChecksum.hpp>
+
+using namespace DUNE::Algorithms;
+
+//! Reference CRC-16-IBM, one byte at a time.
+static uint16_t
+crc16(const uint8_t* buffer, uint16_t len, uint16_t crc = 0)
+{
+  while (len--)
+    crc = CRC16::compute(*buffer++, crc);
+
+  return crc;
+}
+
+//! Reference XOR checksum, one byte at a time.
+static uint8_t
+xorsum(const uint8_t* buffer, uint16_t len)
+{
+  uint8_t sum = 0;
+  while (len--)
+    sum ^= *buffer++;
+
+  return sum;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Algorithms::CRC16");
+
+  // Check value of CRC-16/ARC (CRC-16-IBM, reflected, initial value 0).
+  const char* check = "123456789";
+  test.boolean("check value", CRC16::compute((const uint8_t*)check, std::strlen(check)) == 0xBB3D);
+
+  uint8_t data[1031];
+  for (unsigned i = 0; i < sizeof(data); ++i)
+    data[i] = (uint8_t)(i * 131 + (i >> 3));
+
+  bool crc_ok = true;
+  bool xor_ok = true;
+  for (unsigned len = 0; len <= sizeof(data); len += (len < 80) ? 1 : 37)
+  {
+    for (unsigned offset = 0; offset < 8 && offset + len <= sizeof(data); ++offset)
+    {
+      if (CRC16::compute(data + offset, len, 0x1234) != crc16(data + offset, len, 0x1234))
+        crc_ok = false;
+
+      if (XORChecksum::compute(data + offset, len) != xorsum(data + offset, len))
+        xor_ok = false;
+    }
+  }
+
+  test.boolean("CRC16 of any length and alignment", crc_ok);
+  test.boolean("XOR checksum of any length and alignment", xor_ok);
+
+  return 0;
+}
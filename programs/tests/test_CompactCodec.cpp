@@ -0,0 +1,156 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::IMC;
+
+static bool
+near(double a, double b, double tolerance)
+{
+  return std::fabs(a - b) <= tolerance;
+}
+
+int
+main(void)
+{
+  Test test("IMC::CompactCodec");
+
+  CompactCodec codec;
+  test.boolean("EstimatedState is supported", CompactCodec::isSupported(EstimatedState::getIdStatic()));
+  test.boolean("Heartbeat is not supported", !CompactCodec::isSupported(Heartbeat::getIdStatic()));
+
+  EstimatedState es;
+  es.lat = 0.71949;
+  es.lon = -0.15002;
+  es.height = 120.3f;
+  es.x = -1234.5f;
+  es.psi = 1.57f;
+  es.u = 1.25f;
+  es.depth = 42.7f;
+  es.alt = -1.0f;
+
+  std::vector<char> bfr;
+  unsigned size = codec.encode(es, bfr);
+  unsigned full = es.getSerializationSize();
+  test.boolean(DUNE::Utils::String::str("EstimatedState takes %u bytes instead of %u", size, full).c_str(),
+               size == bfr.size() && size * 2 < full);
+
+  unsigned used = 0;
+  EstimatedState* out = static_cast<EstimatedState*>(codec.decode(&bfr[0], bfr.size(), used));
+  test.boolean("decode() uses all bytes", used == size);
+  test.boolean("positions within precision", near(out->lat, es.lat, 1e-7) && near(out->lon, es.lon, 1e-7));
+  test.boolean("offsets within precision", near(out->x, es.x, 0.05) && near(out->y, 0, 0.05));
+  test.boolean("attitude within precision", near(out->psi, es.psi, 0.005));
+  test.boolean("velocities within precision", near(out->u, es.u, 0.005));
+  test.boolean("depth and altitude within precision", near(out->depth, es.depth, 0.05) && near(out->alt, -1.0, 0.05));
+
+  // Delta encoding against a reference.
+  CompactCodec sender;
+  CompactCodec receiver;
+  sender.setReference(*out);
+  receiver.setReference(*out);
+  delete out;
+
+  es.lat += 1e-4;
+  es.x += 10.0f;
+  std::vector<char> delta;
+  sender.encode(es, delta);
+  test.boolean("delta encoding is smaller", delta.size() < size);
+
+  bool missing = false;
+  try
+  {
+    codec.decode(&delta[0], delta.size(), used);
+  }
+  catch (MissingReference& e)
+  {
+    missing = true;
+  }
+  test.boolean("delta without reference throws", missing);
+
+  out = static_cast<EstimatedState*>(receiver.decode(&delta[0], delta.size(), used));
+  test.boolean("delta position within precision", near(out->lat, es.lat, 2e-7) && near(out->x, es.x, 0.1));
+  delete out;
+
+  // Out of range values saturate.
+  es.depth = 1e6f;
+  es.u = -100.0f;
+  bfr.clear();
+  codec.encode(es, bfr);
+  out = static_cast<EstimatedState*>(codec.decode(&bfr[0], bfr.size(), used));
+  test.boolean("out of range values saturate", near(out->depth, 6553.5, 0.05) && near(out->u, -10.0, 0.005));
+  delete out;
+
+  // Several messages in one frame.
+  PlanControlState pcs;
+  pcs.state = PlanControlState::PCS_EXECUTING;
+  pcs.plan_id = "survey";
+  pcs.plan_eta = 1200;
+  pcs.plan_progress = 37.5f;
+  pcs.man_id = "goto1";
+  pcs.man_type = Goto::getIdStatic();
+  pcs.man_eta = -1;
+  pcs.last_outcome = PlanControlState::LPO_SUCCESS;
+  Abort abort;
+
+  bfr.clear();
+  codec.encode(pcs, bfr);
+  codec.encode(abort, bfr);
+
+  PlanControlState* pcs_out = static_cast<PlanControlState*>(codec.decode(&bfr[0], bfr.size(), used));
+  test.boolean("integers and text are exact", pcs_out->state == pcs.state && pcs_out->plan_id == pcs.plan_id
+               && pcs_out->plan_eta == 1200 && pcs_out->man_id == pcs.man_id && pcs_out->man_type == pcs.man_type
+               && pcs_out->man_eta == -1 && pcs_out->last_outcome == pcs.last_outcome);
+  test.boolean("progress within precision", near(pcs_out->plan_progress, 37.5, 0.25));
+  delete pcs_out;
+
+  Message* next = codec.decode(&bfr[used], bfr.size() - used, used);
+  test.boolean("concatenated message decoded", next->getId() == Abort::getIdStatic());
+  delete next;
+
+  bool truncated = false;
+  try
+  {
+    codec.decode(&bfr[0], 3, used);
+  }
+  catch (BufferTooShort& e)
+  {
+    truncated = true;
+  }
+  test.boolean("truncated message throws", truncated);
+
+  return test.getReturnValue();
+}
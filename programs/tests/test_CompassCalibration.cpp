@@ -0,0 +1,156 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Navigation/CompassCalibration.hpp>
+#include <DUNE/Math/Constants.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Navigation::CompassCalibration;
+using DUNE::Math::Matrix;
+
+//! Hard-iron offset.
+static const double c_offset[3] = {0.12, -0.07, 0.31};
+//! Soft-iron distortion (symmetric).
+static const double c_distortion[9] = {1.10, 0.05, 0.02,
+                                       0.05, 0.92, -0.03,
+                                       0.02, -0.03, 1.00};
+//! Earth field magnitude (Gauss).
+static const double c_field = 0.45;
+
+//! Feed distorted samples of the field rotated through a set of
+//! headings and pitch angles.
+static void
+feed(CompassCalibration& ccal, unsigned count)
+{
+  DUNE::IMC::MagneticField msg;
+
+  for (unsigned n = 0; n < count; ++n)
+  {
+    double psi = n * 0.0731;
+    double theta = 0.6 * std::sin(n * 0.0173);
+    double b[3] = {c_field * std::cos(theta) * std::cos(psi),
+                   c_field * std::cos(theta) * std::sin(psi),
+                   c_field * std::sin(theta)};
+
+    msg.x = c_offset[0];
+    msg.y = c_offset[1];
+    msg.z = c_offset[2];
+    for (unsigned j = 0; j < 3; ++j)
+    {
+      msg.x += c_distortion[j] * b[j];
+      msg.y += c_distortion[3 + j] * b[j];
+      msg.z += c_distortion[6 + j] * b[j];
+    }
+
+    ccal.updateField(msg);
+  }
+}
+
+int
+main(void)
+{
+  Test test("Navigation::CompassCalibration");
+
+  {
+    CompassCalibration ccal;
+    test.boolean("empty fit is invalid", !ccal.isValid());
+    test.boolean("empty fit is not converged", !ccal.isConverged());
+    feed(ccal, 5);
+    test.boolean("too few samples do not converge", !ccal.isConverged());
+  }
+
+  {
+    CompassCalibration ccal;
+    ccal.setConvergence(1e-3, 200);
+    feed(ccal, 2000);
+
+    test.boolean("fit is valid", ccal.isValid());
+    test.boolean("fit converged", ccal.isConverged());
+
+    Matrix hi = ccal.getHardIron();
+    double err = 0.0;
+    for (unsigned i = 0; i < 3; ++i)
+      err += std::fabs(hi(i) - c_offset[i]);
+    test.boolean("hard-iron offset", err < 1e-4);
+
+    // Corrected samples lie on a sphere.
+    Matrix w = ccal.getSoftIron();
+    double r = ccal.getFieldStrength();
+    double worst = 0.0;
+    for (unsigned n = 0; n < 64; ++n)
+    {
+      double psi = n * 0.37;
+      double theta = 0.5 * std::cos(n * 0.21);
+      double b[3] = {c_field * std::cos(theta) * std::cos(psi),
+                     c_field * std::cos(theta) * std::sin(psi),
+                     c_field * std::sin(theta)};
+      double m[3];
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m[i] = 0.0;
+        for (unsigned j = 0; j < 3; ++j)
+          m[i] += c_distortion[i * 3 + j] * b[j];
+      }
+
+      double norm = 0.0;
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        double v = 0.0;
+        for (unsigned j = 0; j < 3; ++j)
+          v += w(i, j) * m[j];
+        norm += v * v;
+      }
+
+      worst = std::max(worst, std::fabs(std::sqrt(norm) - r) / r);
+    }
+    test.boolean("soft-iron correction", worst < 1e-4);
+
+    Matrix params = ccal.getCalibrationParams();
+    test.boolean("calibration parameters", std::fabs(params(2) - c_offset[2]) < 1e-4);
+    test.boolean("calibration clears fit", ccal.getSamples() == 0 && !ccal.isValid());
+  }
+
+  {
+    // Without a valid fit the mid point of the extremes is used.
+    CompassCalibration ccal;
+    DUNE::IMC::MagneticField msg;
+    msg.x = 1.0;
+    ccal.updateField(msg);
+    msg.x = -0.5;
+    ccal.updateField(msg);
+    Matrix params = ccal.getCalibrationParams();
+    test.boolean("fallback to extremes", params(0) == 0.25);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,193 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Compression.hpp>
+#include <DUNE/Utils/String.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::Compression;
+
+//! Build sample data: text-like records with some noise.
+static std::string
+sample(unsigned size)
+{
+  std::string data;
+  unsigned seed = 1;
+
+  while (data.size() < size)
+  {
+    seed = seed * 1103515245 + 12345;
+    data += Utils::String::str("EstimatedState,%u,%u;", seed % 1000, (seed >> 16) % 97);
+  }
+
+  data.resize(size);
+  return data;
+}
+
+//! Write data in chunks to a compressed file and read it back.
+static bool
+roundTrip(const char* fname, Methods method, const std::string& data,
+          unsigned chunk, const std::string& dictionary = std::string())
+{
+  {
+    FileOutput ofs(fname, method, dictionary);
+    for (unsigned i = 0; i < data.size(); i += chunk)
+    {
+      ofs.write(data.data() + i, std::min(chunk, (unsigned)data.size() - i));
+      // Each flush ends a compressed stream.
+      if ((i / chunk) % 7 == 0)
+        ofs.flush();
+    }
+  }
+
+  if (!dictionary.empty())
+  {
+    std::ofstream dict(Factory::dictionaryPath(fname).c_str(), std::ios::binary);
+    dict.write(dictionary.data(), dictionary.size());
+  }
+
+  if (!data.empty() && Factory::detect(fname) != method)
+    return false;
+
+  FileInput ifs(fname, method);
+  std::string result;
+  char bfr[1000];
+
+  while (true)
+  {
+    ifs.read(bfr, sizeof(bfr));
+    if (ifs.gcount() <= 0)
+      break;
+    result.append(bfr, (size_t)ifs.gcount());
+  }
+
+  std::remove(Factory::dictionaryPath(fname).c_str());
+  std::remove(fname);
+  return result == data;
+}
+
+int
+main(void)
+{
+  Test test("Compression");
+  std::string data = sample(1500 * 1000);
+  const char* fname = "test_Compression.tmp";
+
+  test.boolean("method names", Factory::method("lz4") == METHOD_LZ4
+               && Factory::method(METHOD_ZSTD) == "zstd"
+               && Factory::extension(METHOD_LZ4) == ".lz4");
+
+  test.boolean("gzip round trip", roundTrip(fname, METHOD_GZIP, data, 100000));
+  test.boolean("lz4 round trip", roundTrip(fname, METHOD_LZ4, data, 100000));
+  test.boolean("lz4 round trip (small writes)", roundTrip(fname, METHOD_LZ4, data.substr(0, 300000), 777));
+  test.boolean("lz4 round trip (empty)", roundTrip(fname, METHOD_LZ4, "", 1));
+
+  {
+    Compressor* com = Factory::compressor(METHOD_LZ4);
+    std::string small = data.substr(0, 50000);
+    Utils::ByteBuffer frame = com->compress((char*)small.data(), small.size());
+    delete com;
+
+    // Corrupt the content checksum.
+    frame.getBuffer()[frame.getSize() - 1] ^= 1;
+
+    Decompressor* dec = Factory::decompressor(METHOD_LZ4);
+    std::vector<char> out(small.size());
+    bool rejected = false;
+    try
+    {
+      dec->decompress(&out[0], out.size(), frame.getBufferSigned(), frame.getSize());
+      // Output was full, feed the rest of the frame.
+      dec->decompress(&out[0], out.size(), frame.getBufferSigned() + dec->processed(), dec->unprocessed());
+    }
+    catch (CorruptedData& e)
+    {
+      rejected = true;
+    }
+    delete dec;
+    test.boolean("lz4 checksum", rejected);
+  }
+
+  {
+    // Small packets, compressed one at a time.
+    std::vector<std::string> packets;
+    for (unsigned i = 0; i < 400; ++i)
+      packets.push_back(data.substr(i * 997, 60 + i % 40));
+
+    DictionaryTrainer trainer;
+    for (unsigned i = 0; i < 300; ++i)
+      trainer.addSample(packets[i].data(), packets[i].size());
+
+    std::string dictionary = trainer.train(4096);
+    test.boolean("dictionary size", !dictionary.empty() && dictionary.size() <= 4096);
+
+    Compressor* plain = Factory::compressor(METHOD_DEFLATE);
+    Compressor* com = Factory::compressor(METHOD_DEFLATE, dictionary);
+    Decompressor* dec = Factory::decompressor(METHOD_DEFLATE, dictionary);
+    unsigned long plain_size = 0;
+    unsigned long dict_size = 0;
+    bool equal = true;
+
+    // Packets not used for training.
+    for (unsigned i = 300; i < packets.size(); ++i)
+    {
+      char* src = (char*)packets[i].data();
+      plain_size += plain->compress(src, packets[i].size()).getSize();
+
+      Utils::ByteBuffer bfr = com->compress(src, packets[i].size());
+      dict_size += bfr.getSize();
+
+      char out[256];
+      dec->decompress(out, sizeof(out), bfr.getBufferSigned(), bfr.getSize());
+      equal = equal && packets[i] == std::string(out, dec->decompressed());
+    }
+
+    delete plain;
+    delete com;
+    delete dec;
+
+    test.boolean("deflate round trip (dictionary)", equal);
+    test.boolean("deflate dictionary gain", dict_size < plain_size);
+  }
+
+#if defined(DUNE_USING_ZSTD)
+  test.boolean("zstd round trip", roundTrip(fname, METHOD_ZSTD, data, 100000));
+  test.boolean("zstd round trip (dictionary)", roundTrip(fname, METHOD_ZSTD, data, 4000, data.substr(0, 16384)));
+#endif
+
+  return test.getReturnValue();
+}
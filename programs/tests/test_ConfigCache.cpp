@@ -0,0 +1,118 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/FileSystem.hpp>
+#include <DUNE/Parsers.hpp>
+#include <DUNE/Utils.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::FileSystem::Path;
+using DUNE::Parsers::Config;
+using DUNE::Parsers::ConfigCache;
+
+static void
+writeFile(const Path& path, const std::string& contents)
+{
+  std::ofstream ofs(path.c_str());
+  ofs << contents;
+}
+
+int
+main(void)
+{
+  Test test("Parsers::ConfigCache");
+
+  Path dir = Path("/tmp") / Utils::String::str("dune-config-cache-%u", (unsigned)getpid());
+  dir.create();
+
+  Path base = dir / "base.ini";
+  Path main = dir / "main.ini";
+  Path extra = dir / "extra.ini";
+  std::string cache = (dir / "main.cache").str();
+
+  writeFile(base, "[General]\nVehicle = base\nSpeed = 1.0\n");
+  writeFile(main, "[Require base.ini]\n[Include extra.ini]\n\n"
+            "[General]\nVehicle = main\n\n[Task]\nList = a, b,\n  c\n"
+            "Copy = $(General, Speed)\n");
+
+  {
+    Config cfg;
+    test.boolean("load() (parse)", !ConfigCache::load(main.str(), cache, cfg));
+    test.boolean("load() (cache written)", Path(cache).exists());
+  }
+
+  {
+    Config cfg;
+    test.boolean("load() (cached)", ConfigCache::load(main.str(), cache, cfg));
+    test.boolean("get() (override)", cfg.get("General", "Vehicle") == "main");
+    test.boolean("get() (multiline)", cfg.get("Task", "List") == "a, b, c");
+    test.boolean("get() (reference)", cfg.get("Task", "Copy") == "1.0");
+    test.boolean("files()", cfg.files().size() == 2 && cfg.files().back() == main.str());
+  }
+
+  {
+    Config cfg;
+    test.boolean("read() (other file)", !ConfigCache::read(base.str(), cache, cfg));
+    test.boolean("read() (unchanged on failure)", cfg.sections().empty());
+  }
+
+  {
+    writeFile(base, "[General]\nVehicle = base\nSpeed = 2.50\n");
+    Config cfg;
+    test.boolean("load() (required file changed)", !ConfigCache::load(main.str(), cache, cfg));
+    test.boolean("get() (required file changed)", cfg.get("Task", "Copy") == "2.50");
+  }
+
+  {
+    writeFile(extra, "[Extra]\nValue = 1\n");
+    Config cfg;
+    test.boolean("load() (missing include created)", !ConfigCache::load(main.str(), cache, cfg));
+    test.boolean("get() (missing include created)", cfg.get("Extra", "Value") == "1");
+  }
+
+  {
+    std::fstream fs(cache.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    fs.seekp(20);
+    fs.put('\xff');
+    fs.close();
+
+    Config cfg;
+    test.boolean("read() (corrupted)", !ConfigCache::read(main.str(), cache, cfg));
+  }
+
+  dir.remove(Path::MODE_RECURSIVE);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,136 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Concurrency;
+
+//! Number of worker threads.
+static const unsigned c_workers = 4;
+//! Number of iterations of each worker.
+static const unsigned c_iterations = 50000;
+
+class Worker: public Thread
+{
+public:
+  Worker(Mutex& mutex, unsigned& value):
+    m_mutex(mutex),
+    m_value(value)
+  { }
+
+private:
+  Mutex& m_mutex;
+  unsigned& m_value;
+
+  void
+  run(void)
+  {
+    for (unsigned i = 0; i < c_iterations; ++i)
+    {
+      ScopedMutex l(m_mutex);
+      ++m_value;
+    }
+  }
+};
+
+//! Find the counters of a lock.
+static const Contention::Sample*
+find(const std::vector<Contention::Sample>& samples, const std::string& name)
+{
+  for (unsigned i = 0; i < samples.size(); ++i)
+  {
+    if (samples[i].name == name)
+      return &samples[i];
+  }
+
+  return NULL;
+}
+
+int
+main(void)
+{
+  Test test("Concurrency::Contention");
+
+  Mutex mutex;
+  mutex.setName("Test Mutex");
+  Contention::setEnabled(true);
+
+  std::vector<Contention::Sample> before;
+  Contention::collect(before);
+  test.boolean("collect() (named lock)", find(before, "Test Mutex") != NULL);
+
+  unsigned value = 0;
+  std::vector<Worker*> workers;
+  for (unsigned i = 0; i < c_workers; ++i)
+  {
+    workers.push_back(new Worker(mutex, value));
+    workers.back()->start();
+  }
+
+  for (unsigned i = 0; i < c_workers; ++i)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  test.boolean("mutual exclusion", value == c_workers * c_iterations);
+
+  std::vector<Contention::Sample> after;
+  Contention::collect(after);
+  Contention::subtract(after, before);
+
+  const Contention::Sample* s = find(after, "Test Mutex");
+  test.boolean("acquisitions", s != NULL && s->acquisitions == c_workers * c_iterations);
+  test.boolean("contentions", s != NULL && s->spins + s->contentions <= s->acquisitions);
+
+  Contention::setEnabled(false);
+  mutex.lock();
+  mutex.unlock();
+
+  std::vector<Contention::Sample> disabled;
+  Contention::collect(disabled);
+  Contention::subtract(disabled, before);
+  s = find(disabled, "Test Mutex");
+  test.boolean("disabled", s != NULL && s->acquisitions == c_workers * c_iterations);
+
+  {
+    Mutex temporary;
+    temporary.setName("Temporary");
+  }
+
+  Contention::collect(after);
+  test.boolean("unregister", find(after, "Temporary") == NULL);
+
+  return test.getReturnValue();
+}
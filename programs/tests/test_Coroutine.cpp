@@ -0,0 +1,109 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Tasks/Coroutine.hpp>
+#include <DUNE/Time/Delay.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::Tasks;
+
+//! Request/reply exchange written as a coroutine.
+class Exchange
+{
+public:
+  Coroutine co;
+  bool reply;
+  bool timed_out;
+  unsigned steps;
+
+  Exchange(void):
+    reply(false),
+    timed_out(false),
+    steps(0)
+  { }
+
+  void
+  run(void)
+  {
+    DUNE_CO_BEGIN(co);
+    ++steps;
+    DUNE_CO_YIELD(co);
+    ++steps;
+    DUNE_CO_AWAIT(co, reply);
+    ++steps;
+    reply = false;
+    DUNE_CO_AWAIT_FOR(co, reply, 0.05);
+    timed_out = co.timedOut();
+    ++steps;
+    DUNE_CO_SLEEP(co, 0.05);
+    ++steps;
+    DUNE_CO_END(co);
+  }
+};
+
+int
+main(void)
+{
+  Test test("Tasks::Coroutine");
+
+  Exchange ex;
+  ex.run();
+  test.boolean("runs until yield", ex.steps == 1 && ex.co.isWaiting() && ex.co.isPolled());
+
+  ex.run();
+  ex.run();
+  test.boolean("waits for condition", ex.steps == 2 && ex.co.getDeadline() < 0);
+
+  ex.reply = true;
+  ex.run();
+  test.boolean("resumes when condition holds", ex.steps == 3 && ex.co.getDeadline() >= 0);
+
+  Time::Delay::wait(0.1);
+  ex.run();
+  test.boolean("wait times out", ex.timed_out && ex.steps == 4);
+  test.boolean("sleep is not polled", ex.co.isWaiting() && !ex.co.isPolled());
+
+  ex.run();
+  test.boolean("sleeps until deadline", ex.steps == 4);
+
+  Time::Delay::wait(0.1);
+  ex.run();
+  test.boolean("finishes", ex.steps == 5 && ex.co.isDone() && !ex.co.isWaiting());
+
+  ex.run();
+  test.boolean("finished coroutine does nothing", ex.steps == 5);
+
+  ex.co.reset();
+  ex.run();
+  test.boolean("reset restarts", ex.steps == 6 && !ex.co.isDone());
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,120 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Maneuvers::CoveragePlanner.                       *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Maneuvers/CoveragePlanner.hpp>
+#include <DUNE/Math/Constants.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Maneuvers::CoveragePlanner;
+
+//! Rectangle with sides along and across a given direction.
+static std::vector<CoveragePlanner::Point>
+rectangle(double length, double width, double angle)
+{
+  double c = std::cos(angle);
+  double s = std::sin(angle);
+  double u[] = {0, length, length, 0};
+  double v[] = {0, 0, width, width};
+
+  std::vector<CoveragePlanner::Point> poly;
+  for (unsigned i = 0; i < 4; ++i)
+    poly.push_back(CoveragePlanner::Point(u[i] * c - v[i] * s, u[i] * s + v[i] * c));
+
+  return poly;
+}
+
+int
+main(void)
+{
+  Test test("Maneuvers::CoveragePlanner");
+
+  {
+    CoveragePlanner planner(rectangle(100.0, 50.0, 0.0));
+    test.boolean("plan()", planner.plan(10.0));
+    test.boolean("rows along the longest side", planner.getRows().size() == 5 &&
+                 std::fabs(planner.getDirection()) < 1e-9);
+
+    const std::vector<CoveragePlanner::Row>& rows = planner.getRows();
+    bool ok = true;
+    for (unsigned i = 0; i < rows.size(); ++i)
+    {
+      double len = std::fabs(rows[i].end.x - rows[i].start.x);
+      ok = ok && std::fabs(len - 100.0) < 1e-6;
+      ok = ok && std::fabs(rows[i].start.y - (5.0 + 10.0 * i)) < 1e-6;
+      // Rows alternate sense.
+      ok = ok && ((i % 2) == 0) == (rows[i].start.x < rows[i].end.x);
+    }
+    test.boolean("row geometry", ok);
+    test.boolean("path length", std::fabs(planner.getLength() - (5 * 100.0 + 4 * 10.0)) < 1e-6);
+  }
+
+  {
+    double angle = 0.3;
+    CoveragePlanner single(rectangle(300.0, 40.0, angle));
+    CoveragePlanner multi(rectangle(300.0, 40.0, angle));
+    single.plan(5.0, 1);
+    multi.plan(5.0, 4);
+    test.boolean("rotated area", single.getRows().size() == 8 &&
+                 std::fabs(single.getDirection() - angle) < 1e-9);
+    test.boolean("threads give the same plan",
+                 single.getDirection() == multi.getDirection() &&
+                 single.getLength() == multi.getLength());
+  }
+
+  {
+    // L-shaped area.
+    std::vector<CoveragePlanner::Point> poly;
+    poly.push_back(CoveragePlanner::Point(0, 0));
+    poly.push_back(CoveragePlanner::Point(100, 0));
+    poly.push_back(CoveragePlanner::Point(100, 20));
+    poly.push_back(CoveragePlanner::Point(20, 20));
+    poly.push_back(CoveragePlanner::Point(20, 100));
+    poly.push_back(CoveragePlanner::Point(0, 100));
+
+    CoveragePlanner planner(poly);
+    test.boolean("non-convex area", planner.plan(10.0, 2) && !planner.getRows().empty());
+  }
+
+  {
+    std::vector<CoveragePlanner::Point> poly;
+    poly.push_back(CoveragePlanner::Point(0, 0));
+    poly.push_back(CoveragePlanner::Point(1, 1));
+    CoveragePlanner planner(poly);
+    test.boolean("degenerate area", !planner.plan(10.0));
+  }
+
+  return test.getReturnValue();
+}
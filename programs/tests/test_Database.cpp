@@ -29,6 +29,7 @@
 // ISO C++ headers
 #include <iostream>
 #include <sstream>
+#include <cstdio>
 #include "Test.hpp"
 
 // DUNE headers
@@ -285,5 +286,109 @@ main(int argc, char** argv)
 
   test.boolean("Connection -- Row count", passed);
 
+  // Statement cache test.
+  passed = false;
+  try
+  {
+    Statement& first = db.prepare("SELECT COUNT(*) FROM TEST");
+    first.execute();
+    Statement& second = db.prepare("SELECT COUNT(*) FROM TEST");
+    int count = -1;
+    if (&first == &second && second.execute())
+      second >> count;
+    passed = (count == 0);
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+  test.boolean("Connection::prepare()", passed);
+
+  // Transaction guard test.
+  passed = false;
+  try
+  {
+    {
+      Transaction t(db);
+      Statement& insertion = db.prepare("INSERT INTO TEST VALUES(?,?,?,?)");
+      insertion << 1 << 0.1 << "NAME1" << Null();
+      insertion.execute();
+    }
+
+    bool rolled_back = !db.inTransaction();
+
+    {
+      Transaction t(db, 2);
+      bool committed = false;
+      for (int i = 0; i < 5; ++i)
+      {
+        Statement& insertion = db.prepare("INSERT INTO TEST VALUES(?,?,?,?)");
+        insertion << i << 0.1 * i << "NAME" << Null();
+        insertion.execute();
+        committed = t.step() || committed;
+      }
+
+      // The fifth row is still pending and is rolled back.
+      passed = rolled_back && committed && t.getPending() == 1;
+    }
+
+    Statement& query = db.prepare("SELECT COUNT(*) FROM TEST");
+    int count = -1;
+    query.execute();
+    query >> count;
+    passed = passed && count == 4;
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+  test.boolean("Transaction", passed);
+
+  // WAL and background checkpoints test.
+  passed = false;
+  std::string path = "test_Database.tmp";
+  try
+  {
+    Connection::Options options;
+    options.journal_mode = "WAL";
+    options.synchronous = "NORMAL";
+    options.mmap_size = 1 << 20;
+    options.statement_cache = 2;
+    options.checkpoint_period = 0.05;
+
+    Connection wal(path.c_str(), true, options);
+    wal.execute("CREATE TABLE TEST (ID INTEGER PRIMARY KEY NOT NULL)");
+
+    Transaction t(wal, 100);
+    for (int i = 0; i < 1000; ++i)
+    {
+      Statement& insertion = wal.prepare("INSERT INTO TEST VALUES(?)");
+      insertion << i;
+      insertion.execute();
+      t.step();
+    }
+    t.commit();
+
+    // Exceed the cache capacity.
+    wal.prepare("SELECT 1");
+    wal.prepare("SELECT 2");
+    Statement& query = wal.prepare("SELECT COUNT(*) FROM TEST");
+    int count = -1;
+    query.execute();
+    query >> count;
+    query.reset();
+    wal.checkpoint();
+
+    passed = (count == 1000);
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+  std::remove(path.c_str());
+  std::remove((path + "-wal").c_str());
+  std::remove((path + "-shm").c_str());
+  test.boolean("Connection -- WAL options", passed);
+
   return 0;
 }
@@ -0,0 +1,147 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/FileSystem.hpp>
+#include <DUNE/IMC.hpp>
+#include <DUNE/Utils.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::FileSystem::DirectoryIndex;
+using DUNE::FileSystem::Path;
+using DUNE::IMC::LogCatalog;
+using DUNE::IMC::LogIndex;
+
+static void
+writeFile(const Path& path, const std::string& contents)
+{
+  std::ofstream ofs(path.c_str(), std::ios::binary);
+  ofs << contents;
+}
+
+static const DirectoryIndex::Entry*
+find(const std::vector<DirectoryIndex::Entry>& entries, const std::string& name)
+{
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (entries[i].name == name)
+      return &entries[i];
+  }
+
+  return NULL;
+}
+
+int
+main(void)
+{
+  Test test("FileSystem::DirectoryIndex");
+
+  Path dir = Path("/tmp") / Utils::String::str("dune-directory-index-%u", (unsigned)getpid());
+  dir.create();
+
+  {
+    DirectoryIndex index;
+    std::vector<DirectoryIndex::Entry> entries;
+
+    writeFile(dir / "b.txt", "12345");
+    (dir / "a").create();
+
+    test.boolean("list()", index.list(dir, entries));
+    test.boolean("list() (sorted)", entries.size() == 2 && entries[0].name == "a" && entries[1].name == "b.txt");
+    test.boolean("list() (directory)", entries[0].type == Path::PT_DIRECTORY);
+    test.boolean("list() (size)", entries[1].type == Path::PT_FILE && entries[1].size == 5);
+
+    writeFile(dir / "c.txt", "123");
+    index.list(dir, entries);
+    test.boolean("list() (created)", find(entries, "c.txt") != NULL && find(entries, "c.txt")->size == 3);
+
+    writeFile(dir / "c.txt", "1234567");
+    index.list(dir, entries);
+    test.boolean("list() (modified)", find(entries, "c.txt") != NULL && find(entries, "c.txt")->size == 7);
+
+    (dir / "b.txt").remove();
+    index.list(dir, entries);
+    test.boolean("list() (removed)", entries.size() == 2 && find(entries, "b.txt") == NULL);
+
+    test.boolean("list() (missing)", !index.list(dir / "missing", entries));
+
+    DirectoryIndex::Entry entry;
+    test.boolean("stat()", DirectoryIndex::stat(dir / "c.txt", entry) && entry.size == 7);
+  }
+
+  {
+    DirectoryIndex index;
+    Path log = dir / "logs" / "20140721" / "103015_test";
+    log.create();
+    writeFile(log / "Data.lsf.gz", "0123456789");
+    writeFile(log / "Output.txt", "01234");
+
+    LogCatalog catalog(dir / "logs", index);
+    std::vector<LogCatalog::Summary> logs;
+    catalog.get(logs);
+    test.boolean("LogCatalog::get()", logs.size() == 1 && logs[0].name == "20140721/103015_test");
+    test.boolean("LogCatalog::get() (file)", logs.size() == 1 && logs[0].file == "Data.lsf.gz");
+    test.boolean("LogCatalog::get() (unindexed)", logs.size() == 1 && !logs[0].indexed);
+
+    LogIndex::Entry block;
+    block.start = 10.0;
+    block.end = 20.0;
+    block.counts[350] = 100;
+    block.counts[3] = 5;
+    {
+      std::ofstream ofs((log / "Data.lsf.idx").c_str(), std::ios::binary);
+      LogIndex::writeHeader(ofs, Compression::METHOD_GZIP);
+      LogIndex::writeEntry(ofs, block);
+      block.start = 20.0;
+      block.end = 30.0;
+      LogIndex::writeEntry(ofs, block);
+    }
+
+    LogCatalog::Summary summary;
+    test.boolean("LogCatalog::get(name)", catalog.get("20140721/103015_test", summary));
+    test.boolean("LogCatalog::get(name) (indexed)", summary.indexed);
+    test.boolean("LogCatalog::get(name) (range)", summary.start == 10.0 && summary.end == 30.0);
+    test.boolean("LogCatalog::get(name) (counts)", summary.counts[350] == 200 && summary.counts[3] == 10);
+    test.boolean("LogCatalog::get(name) (escape)", !catalog.get("../logs", summary));
+
+    (dir / "logs" / "20140721").remove(Path::MODE_RECURSIVE);
+    catalog.get(logs);
+    test.boolean("LogCatalog::get() (removed)", logs.empty());
+  }
+
+  dir.remove(Path::MODE_RECURSIVE);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,132 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Maneuvers::Dubins.                                *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Maneuvers/Dubins.hpp>
+#include <DUNE/Math/Constants.hpp>
+#include <DUNE/Math/Random.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Maneuvers::Dubins;
+
+//! Distance between two poses, including heading.
+static double
+poseError(const Dubins::Pose& a, const Dubins::Pose& b)
+{
+  double dpsi = std::fmod(std::fabs(a.psi - b.psi), DUNE::Math::c_two_pi);
+  dpsi = std::min(dpsi, DUNE::Math::c_two_pi - dpsi);
+  return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y)) + dpsi;
+}
+
+int
+main(void)
+{
+  Test test("Maneuvers::Dubins");
+
+  {
+    Dubins::Path path;
+    Dubins::compute(Dubins::Pose(0, 0, 0), Dubins::Pose(100, 0, 0), 10.0, path);
+    test.boolean("straight path", std::fabs(path.length() - 100.0) < 1e-9);
+
+    Dubins::compute(Dubins::Pose(0, 0, 0), Dubins::Pose(0, 20, DUNE::Math::c_pi), 10.0, path);
+    Dubins::Pose mid = Dubins::sample(path, path.length() / 2);
+    test.boolean("u-turn to the right",
+                 std::fabs(path.length() - DUNE::Math::c_pi * 10.0) < 1e-9 &&
+                 poseError(mid, Dubins::Pose(10, 10, DUNE::Math::c_half_pi)) < 1e-9);
+  }
+
+  DUNE::Math::Random::Generator* rng = DUNE::Math::Random::Factory::create(DUNE::Math::Random::Factory::c_default, 42);
+
+  std::vector<Dubins::Query> queries;
+  for (unsigned i = 0; i < 500; ++i)
+  {
+    Dubins::Pose a(rng->uniform(-200, 200), rng->uniform(-200, 200), rng->uniform(-4, 4));
+    Dubins::Pose b(rng->uniform(-200, 200), rng->uniform(-200, 200), rng->uniform(-4, 4));
+    queries.push_back(Dubins::Query(a, b));
+  }
+
+  Dubins dubins(25.0);
+  std::vector<Dubins::Path> paths;
+  test.boolean("batch solves all queries", dubins.solve(queries, paths) == queries.size());
+
+  bool reach = true;
+  bool shortest = true;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    Dubins::Pose end = Dubins::sample(paths[i], paths[i].length());
+    reach = reach && poseError(end, queries[i].second) < 1e-6;
+
+    Dubins::Path ref;
+    Dubins::compute(queries[i].first, queries[i].second, 25.0, ref);
+    shortest = shortest && std::fabs(ref.length() - paths[i].length()) < 1e-9;
+  }
+
+  test.boolean("paths reach the goal", reach);
+  test.boolean("batch matches single queries", shortest);
+
+  // Same relative geometry, translated and rotated.
+  std::vector<Dubins::Query> moved;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    const Dubins::Pose& a = queries[i].first;
+    const Dubins::Pose& b = queries[i].second;
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double c = std::cos(0.7);
+    double s = std::sin(0.7);
+    Dubins::Pose na(a.x + 1000, a.y - 500, a.psi + 0.7);
+    Dubins::Pose nb(na.x + dx * c - dy * s, na.y + dx * s + dy * c, b.psi + 0.7);
+    moved.push_back(Dubins::Query(na, nb));
+  }
+
+  std::vector<Dubins::Path> moved_paths;
+  dubins.solve(moved, moved_paths);
+
+  bool same = true;
+  for (size_t i = 0; i < moved.size(); ++i)
+  {
+    Dubins::Pose end = Dubins::sample(moved_paths[i], moved_paths[i].length());
+    same = same && poseError(end, moved[i].second) < 1e-6;
+    same = same && std::fabs(moved_paths[i].length() - paths[i].length()) < 1e-6;
+  }
+
+  test.boolean("cache hits for moved queries", dubins.getCacheHits() >= moved.size() * 9 / 10);
+  test.boolean("cached paths are exact", same);
+
+  delete rng;
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,163 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+#include <DUNE/Tasks/EntityDataBase.hpp>
+#include <DUNE/Utils/String.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::Tasks::EntityDataBase;
+
+//! Number of ids reserved while readers run.
+static const unsigned c_entities = 200;
+
+//! Looks up every published id while entities are being reserved.
+class Reader: public Concurrency::Thread
+{
+public:
+  Reader(EntityDataBase& db):
+    m_consistent(true),
+    m_db(db)
+  { }
+
+  bool m_consistent;
+
+private:
+  EntityDataBase& m_db;
+
+  void
+  run(void)
+  {
+    unsigned seen = 0;
+
+    while (seen < c_entities)
+    {
+      for (; m_db.idExists(seen); ++seen)
+      {
+        const EntityDataBase::Entity* entity = m_db.find(seen);
+        if (entity == NULL || entity->id != seen
+            || entity->label != "E" + Utils::String::str(seen))
+          m_consistent = false;
+      }
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("Tasks::EntityDataBase");
+
+  {
+    EntityDataBase db;
+    unsigned a = db.reserve("A", "Task", 0, 0);
+    unsigned b = db.reserve("B", "Task", 0, 0);
+    test.boolean("reserve()", a == 0 && b == 1);
+    test.boolean("resolve(label)", db.resolve("B") == b);
+    test.boolean("resolve(id)", db.resolve(a) == "A");
+    test.boolean("find() (unknown)", db.find(2) == NULL);
+
+    std::vector<std::string> labels;
+    labels.push_back("B");
+    labels.push_back("A");
+    std::vector<unsigned> ids;
+    db.resolve(labels, ids);
+    test.boolean("resolve(labels)", ids.size() == 2 && ids[0] == b && ids[1] == a);
+
+    try
+    {
+      labels.push_back("C");
+      db.resolve(labels, ids);
+      test.failed("resolve(labels) (nonexistent)");
+    }
+    catch (EntityDataBase::NonexistentLabel& e)
+    {
+      test.passed("resolve(labels) (nonexistent)");
+    }
+
+    try
+    {
+      db.resolve(2);
+      test.failed("resolve(id) (invalid)");
+    }
+    catch (EntityDataBase::InvalidId& e)
+    {
+      test.passed("resolve(id) (invalid)");
+    }
+
+    test.boolean("reserve() (same task)", db.reserve("A", "Task", 0, 0) == a
+                 && db.find(2) == NULL);
+
+    try
+    {
+      db.reserve("A", "Other", 0, 0);
+      test.failed("reserve() (other task)");
+    }
+    catch (EntityDataBase::ReservedUnique& e)
+    {
+      test.passed("reserve() (other task)");
+    }
+  }
+
+  {
+    EntityDataBase db;
+    for (unsigned i = 0; i < EntityDataBase::c_max_entities; ++i)
+      db.reserve("E" + Utils::String::str(i), "Task", 0, 0);
+
+    try
+    {
+      db.reserve("Overflow", "Task", 0, 0);
+      test.failed("reserve() (too many)");
+    }
+    catch (EntityDataBase::TooManyEntities& e)
+    {
+      test.passed("reserve() (too many)");
+    }
+  }
+
+  {
+    EntityDataBase db;
+    Reader reader(db);
+    reader.start();
+
+    for (unsigned i = 0; i < c_entities; ++i)
+      db.reserve("E" + Utils::String::str(i), "Task", 0, 0);
+
+    reader.join();
+    test.boolean("concurrent find()", reader.m_consistent);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,156 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Tasks.hpp>
+#include <DUNE/Time/Delay.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Pooled task counting its steps.
+class Stepper: public Tasks::Task
+{
+public:
+  Stepper(const std::string& name, Tasks::Context& ctx, double duration, double period):
+    Tasks::Task(name, ctx),
+    steps(0),
+    releases(0),
+    active(false),
+    m_duration(duration),
+    m_period(period)
+  {
+    loadConfig();
+  }
+
+  bool
+  canStep(void) const
+  {
+    return true;
+  }
+
+  double
+  onStep(void)
+  {
+    active = true;
+    if (m_duration > 0)
+      Time::Delay::wait(m_duration);
+    ++steps;
+    active = false;
+    return m_period;
+  }
+
+  void
+  onResourceRelease(void)
+  {
+    ++releases;
+  }
+
+  void
+  onMain(void)
+  { }
+
+  //! Number of steps executed.
+  volatile unsigned steps;
+  //! Number of times resources were released.
+  volatile unsigned releases;
+  //! True while a step is running.
+  volatile bool active;
+
+private:
+  //! Duration of each step.
+  double m_duration;
+  //! Time between steps.
+  double m_period;
+};
+
+int
+main(void)
+{
+  Test test("Tasks::Executor");
+  Tasks::Context ctx;
+
+  {
+    Tasks::Executor pool(2);
+    Stepper fast("Fast", ctx, 0.0, 0.05);
+    Stepper slow("Slow", ctx, 0.0, 0.2);
+    Stepper busy1("Busy 1", ctx, 0.02, 0.0);
+    Stepper busy2("Busy 2", ctx, 0.02, 0.0);
+
+    pool.add(&fast);
+    pool.add(&slow);
+    pool.add(&busy1);
+    pool.add(&busy2);
+    pool.start();
+    Time::Delay::wait(1.0);
+
+    // Deadlines shorter than the idle timeout must wake up workers.
+    test.boolean("timers wake up workers", fast.steps >= 10 && slow.steps >= 3);
+    test.boolean("all tasks are executed", busy1.steps > 0 && busy2.steps > 0);
+
+    pool.stop();
+    unsigned steps = fast.steps + slow.steps + busy1.steps + busy2.steps;
+    Time::Delay::wait(0.2);
+    test.boolean("stop halts execution", steps == fast.steps + slow.steps + busy1.steps + busy2.steps);
+    test.boolean("stop releases resources", fast.releases > 0 && busy2.releases > 0);
+  }
+
+  {
+    Tasks::Executor pool(2);
+    Stepper slow("Slow", ctx, 0.2, 0.0);
+    Stepper fast("Fast", ctx, 0.0, 0.01);
+
+    pool.add(&slow);
+    pool.add(&fast);
+    pool.start();
+
+    while (!slow.active)
+      Time::Delay::wait(0.001);
+
+    pool.remove(&slow);
+    test.boolean("remove waits for a running step", !slow.active);
+
+    unsigned steps = slow.steps;
+    Time::Delay::wait(0.5);
+    test.boolean("removed task is not executed", slow.steps == steps);
+    test.boolean("other tasks keep running", fast.steps > 10);
+
+    pool.remove(&fast);
+    steps = fast.steps;
+    Time::Delay::wait(0.1);
+    test.boolean("remove cancels a scheduled step", fast.steps == steps);
+
+    pool.add(&fast);
+    Time::Delay::wait(0.2);
+    test.boolean("removed task can be added again", fast.steps > steps);
+    pool.stop();
+  }
+
+  return test.getReturnValue();
+}
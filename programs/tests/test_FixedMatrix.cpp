@@ -0,0 +1,140 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Math::FixedMatrix class.                          *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/FixedMatrix.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+template <unsigned R, unsigned C>
+static bool
+equal(const FixedMatrix<R, C>& a, const Matrix& b)
+{
+  if (b.rows() != R || b.columns() != C)
+    return false;
+
+  for (unsigned i = 0; i < R; ++i)
+    for (unsigned j = 0; j < C; ++j)
+      if (std::fabs(a(i, j) - b(i, j)) > 1e-9)
+        return false;
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math::FixedMatrix");
+
+  double da[] = {4, -2, 1, 3, 6, -4, 2, 1, 8};
+  double db[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  double dv[] = {1, -1, 2};
+
+  FixedMatrix<3, 3> a(da);
+  FixedMatrix<3, 3> b(db);
+  FixedMatrix<3, 1> v(dv);
+  Matrix ma(da, 3, 3);
+  Matrix mb(db, 3, 3);
+  Matrix mv(dv, 3, 1);
+
+  {
+    FixedMatrix<3, 3> r = a + b * 2.0 - transpose(a);
+    test.boolean("expressions match Matrix", equal(r, ma + mb * 2.0 - transpose(ma)));
+  }
+
+  {
+    FixedMatrix<3, 1> r = a * b * v;
+    test.boolean("products match Matrix", equal(r, ma * mb * mv));
+  }
+
+  {
+    FixedMatrix<1, 1> r = transpose(v) * a * v;
+    test.boolean("products of expressions match Matrix", equal(r, transpose(mv) * ma * mv));
+  }
+
+  {
+    FixedMatrix<3, 3> r = inverse(a);
+    FixedMatrix<3, 3> i;
+    i.identity();
+    test.boolean("inverse matches Matrix", equal(r, inverse(ma)));
+    test.boolean("inverse times matrix is identity", FixedMatrix<3, 3>(r * a - i).norm_2() < 1e-12);
+  }
+
+  {
+    bool thrown = false;
+    try
+    {
+      inverse(b);
+    }
+    catch (Matrix::Error& e)
+    {
+      (void)e;
+      thrown = true;
+    }
+    test.boolean("singular matrix is not inverted", thrown);
+  }
+
+  {
+    FixedMatrix<3, 3> r(a);
+    r = transpose(r);
+    test.boolean("assignment from aliased expression", equal(r, transpose(ma)));
+  }
+
+  {
+    FixedMatrix<6, 6> p;
+    p.set(0, 0, a);
+    p.set(3, 3, b);
+    test.boolean("blocks", p.get<3, 3>(3, 3) == b && p.get<3, 3>(0, 3) == FixedMatrix<3, 3>());
+  }
+
+  {
+    FixedMatrix<3, 3> r(ma);
+    bool thrown = false;
+    try
+    {
+      FixedMatrix<3, 1> w(ma);
+    }
+    catch (Matrix::Error& e)
+    {
+      (void)e;
+      thrown = true;
+    }
+    test.boolean("conversion from Matrix", r == a && thrown);
+    test.boolean("conversion to Matrix", a.toMatrix() == ma);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,96 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Media/FrameAssembler.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Media::FrameAssembler;
+
+static bool
+add(FrameAssembler& fa, unsigned frame, unsigned chunk, unsigned chunks, bool key, const char* data)
+{
+  return fa.add(frame, chunk, chunks, key, data, std::string(data).size());
+}
+
+static std::string
+frame(const FrameAssembler& fa)
+{
+  return std::string(fa.getFrame().begin(), fa.getFrame().end());
+}
+
+int
+main(void)
+{
+  Test test("Frame Assembler");
+
+  {
+    FrameAssembler fa;
+    test.boolean("waits for key frame", !add(fa, 3, 0, 1, false, "P") && fa.isWaitingKeyFrame());
+    test.boolean("predicted frame discarded", fa.getLost() == 1);
+
+    test.boolean("key chunk 1", !add(fa, 4, 1, 2, true, "DR"));
+    test.boolean("key chunk 0", add(fa, 4, 0, 2, true, "I"));
+    test.boolean("chunks reordered", frame(fa) == "IDR");
+    test.boolean("synchronized", !fa.isWaitingKeyFrame());
+
+    test.boolean("late duplicate ignored", !add(fa, 4, 1, 2, true, "DR") && fa.getLost() == 1);
+
+    test.boolean("predicted frame", add(fa, 5, 0, 1, false, "P5") && frame(fa) == "P5");
+  }
+
+  {
+    FrameAssembler fa;
+    add(fa, 0xfffe, 0, 1, true, "I");
+    test.boolean("wrap around", add(fa, 0xffff, 0, 1, false, "P") && add(fa, 0, 0, 1, false, "P"));
+
+    test.boolean("gap breaks stream", !add(fa, 2, 0, 1, false, "P") && fa.isWaitingKeyFrame());
+    test.boolean("gap counted", fa.getLost() == 2);
+  }
+
+  {
+    FrameAssembler fa;
+    add(fa, 10, 0, 1, true, "I");
+    test.boolean("incomplete frame", !add(fa, 11, 0, 2, false, "P"));
+    test.boolean("incomplete frame dropped", !add(fa, 12, 0, 1, false, "P") && fa.getLost() == 2);
+    test.boolean("key frame resynchronizes", add(fa, 13, 0, 1, true, "I") && !fa.isWaitingKeyFrame());
+
+    test.boolean("invalid chunk", !add(fa, 14, 1, 1, false, "P"));
+    test.boolean("duplicate chunk", !add(fa, 14, 0, 2, false, "P") && !add(fa, 14, 0, 2, false, "P"));
+    test.boolean("completed after duplicate", add(fa, 14, 1, 2, false, "Q") && frame(fa) == "PQ");
+
+    fa.reset();
+    test.boolean("reset", fa.isWaitingKeyFrame() && !add(fa, 15, 0, 1, false, "P"));
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,132 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Simulation::GriddedField.                         *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/FileSystem/Path.hpp>
+#include <DUNE/Simulation/GriddedField.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::FileSystem::Path;
+using DUNE::Simulation::GriddedField;
+
+//! Linear field, reproduced exactly by trilinear interpolation.
+static double
+field(double x, double y, double z)
+{
+  return 2.0 * x + 3.0 * y - z + 1.0;
+}
+
+static double
+uniform(double a, double b)
+{
+  return a + (b - a) * std::rand() / (double)RAND_MAX;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Simulation::GriddedField");
+
+  std::srand(5);
+
+  GriddedField::Layout l;
+  l.nx = 50;
+  l.ny = 37;
+  l.nz = 5;
+  l.tile = 8;
+  l.lat = 0.7;
+  l.lon = -0.15;
+  l.x0 = -100;
+  l.y0 = 20;
+  l.z0 = 0;
+  l.dx = 4;
+  l.dy = 5;
+  l.dz = 10;
+
+  std::vector<float> values(l.nx * l.ny * l.nz);
+  for (unsigned k = 0; k < l.nz; ++k)
+    for (unsigned j = 0; j < l.ny; ++j)
+      for (unsigned i = 0; i < l.nx; ++i)
+        values[(k * l.ny + j) * l.nx + i] = field(l.x0 + i * l.dx, l.y0 + j * l.dy, l.z0 + k * l.dz);
+
+  // Hole in the data.
+  values[(2 * l.ny + 10) * l.nx + 10] = std::numeric_limits<float>::quiet_NaN();
+
+  Path path = Path::current() / "test_GriddedField.grd";
+  GriddedField::write(path.c_str(), l, &values[0]);
+
+  {
+    GriddedField grid(path.c_str(), 4);
+
+    test.boolean("getLayout()", grid.getLayout().nx == l.nx && grid.getLayout().tile == l.tile
+                 && grid.getLayout().lat == l.lat && grid.getLayout().dz == l.dz);
+
+    const unsigned n = 5000;
+    std::vector<double> x(n), y(n), z(n), v(n);
+    bool* valid = new bool[n];
+    for (unsigned p = 0; p < n; ++p)
+    {
+      x[p] = uniform(l.x0, l.x0 + (l.nx - 1) * l.dx);
+      y[p] = uniform(l.y0, l.y0 + (l.ny - 1) * l.dy);
+      z[p] = uniform(l.z0, l.z0 + (l.nz - 1) * l.dz);
+    }
+
+    grid.sample(&x[0], &y[0], &z[0], n, &v[0], valid);
+
+    bool exact = true;
+    for (unsigned p = 0; p < n; ++p)
+    {
+      if (valid[p])
+        exact = exact && std::fabs(v[p] - field(x[p], y[p], z[p])) < 1e-3;
+    }
+    delete [] valid;
+    test.boolean("sample() interpolates trilinearly across tiles", exact);
+
+    double r;
+    test.boolean("sample() at grid corner", grid.sample(l.x0 + (l.nx - 1) * l.dx, l.y0 + (l.ny - 1) * l.dy,
+                                                         l.z0 + (l.nz - 1) * l.dz, r)
+                 && std::fabs(r - field(l.x0 + (l.nx - 1) * l.dx, l.y0 + (l.ny - 1) * l.dy,
+                                        l.z0 + (l.nz - 1) * l.dz)) < 1e-3);
+    test.boolean("sample() outside the grid", !grid.sample(l.x0 - 1, l.y0, l.z0, r));
+    test.boolean("sample() next to missing data",
+                 !grid.sample(l.x0 + 10.5 * l.dx, l.y0 + 9.5 * l.dy, l.z0 + 2.5 * l.dz, r));
+  }
+
+  path.remove();
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,101 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Media/H264Encoder.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Media::H264Encoder;
+
+int
+main(void)
+{
+  Test test("H.264 Encoder");
+
+  {
+    // White, black, and saturated primaries in 2x2 blocks.
+    static const uint8_t c_colors[4][3] =
+    {
+      {255, 255, 255},
+      {0, 0, 0},
+      {255, 0, 0},
+      {0, 0, 255}
+    };
+
+    const unsigned w = 8;
+    const unsigned h = 2;
+    std::vector<uint8_t> rgb(w * h * 3);
+    for (unsigned j = 0; j < h; ++j)
+    {
+      for (unsigned i = 0; i < w; ++i)
+      {
+        for (unsigned k = 0; k < 3; ++k)
+          rgb[(j * w + i) * 3 + k] = c_colors[i / 2][k];
+      }
+    }
+
+    // Padded strides must be honoured.
+    std::vector<uint8_t> y(10 * h, 0xaa);
+    std::vector<uint8_t> u(5, 0xaa);
+    std::vector<uint8_t> v(5, 0xaa);
+    H264Encoder::convertRGB24(&rgb[0], w, h, &y[0], 10, &u[0], &v[0], 5);
+
+    test.boolean("white luma", y[0] == 235 && y[11] == 235);
+    test.boolean("black luma", y[2] == 16 && y[13] == 16);
+    test.boolean("red luma", y[4] == 82);
+    test.boolean("blue luma", y[6] == 41);
+    test.boolean("gray chroma", u[0] == 128 && v[0] == 128 && u[1] == 128 && v[1] == 128);
+    test.boolean("red chroma", u[2] == 90 && v[2] == 240);
+    test.boolean("blue chroma", u[3] == 240 && v[3] == 110);
+    test.boolean("padding untouched", y[8] == 0xaa && y[19] == 0xaa && u[4] == 0xaa);
+  }
+
+  {
+    // SPS, PPS and IDR slice.
+    static const uint8_t c_idr[] =
+    {
+      0, 0, 0, 1, 0x67, 0x42, 0, 0, 1, 0x68, 0xce, 0, 0, 1, 0x65, 0x88
+    };
+
+    // Non-IDR slice whose payload holds a byte that looks like one.
+    static const uint8_t c_slice[] =
+    {
+      0, 0, 0, 1, 0x41, 0x9a, 0x65, 0x00, 0x01
+    };
+
+    test.boolean("IDR is key frame", H264Encoder::isKeyFrame(c_idr, sizeof(c_idr)));
+    test.boolean("slice is not key frame", !H264Encoder::isKeyFrame(c_slice, sizeof(c_slice)));
+    test.boolean("truncated", !H264Encoder::isKeyFrame(c_idr, 14));
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,163 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+#include "Test.hpp"
+
+static bool
+roundTrip(const IMC::Message& msg)
+{
+  Utils::ByteBuffer bfr;
+  msg.toJSON(bfr);
+
+  IMC::Message* msg_d = IMC::fromJSON(bfr.getBufferSigned(), bfr.getSize());
+  bool rv = (msg == *msg_d);
+  delete msg_d;
+  return rv;
+}
+
+int
+main(void)
+{
+  Test test("IMC JSON Serialization/Deserialization");
+
+  {
+    std::vector<uint32_t> ids;
+    IMC::Factory::getIds(ids);
+
+    unsigned failed = 0;
+    for (unsigned i = 0; i < ids.size(); ++i)
+    {
+      IMC::Message* msg = IMC::Factory::produce(ids[i]);
+      msg->setTimeStamp(1400000000.123456789);
+      msg->setSource(0x2001);
+      msg->setSourceEntity(11);
+      msg->setDestination(0x4001);
+      msg->setDestinationEntity(22);
+
+      if (!roundTrip(*msg))
+      {
+        std::fprintf(stderr, "  %s\n", msg->getName());
+        ++failed;
+      }
+
+      delete msg;
+    }
+
+    test.boolean("all default messages", failed == 0);
+  }
+
+  {
+    IMC::EstimatedState msg;
+    msg.lat = 0.71881385238689;
+    msg.lon = -0.15195186369214;
+    msg.height = -1e-9;
+    msg.z = 3.14159265f;
+    msg.phi = -0.1f;
+    test.boolean("floating point fields", roundTrip(msg));
+  }
+
+  {
+    IMC::LogBookEntry msg;
+    msg.type = IMC::LogBookEntry::LBET_ERROR;
+    msg.htime = 12.5;
+    msg.context.assign("quote \" backslash \\ newline \n tab \t bell \a");
+    msg.text.assign("{\"not\": [\"an\", \"object\"]}");
+    test.boolean("escaped strings", roundTrip(msg));
+  }
+
+  {
+    IMC::DevDataBinary msg;
+    const char data[] = {0, 1, -1, 127, -128, 'a'};
+    msg.value.assign(data, data + sizeof(data));
+    test.boolean("raw data", roundTrip(msg));
+  }
+
+  {
+    IMC::Goto man;
+    man.timeout = 60;
+    man.lat = 0.7188;
+    man.z = 2.0f;
+    man.speed_units = IMC::SUNITS_RPM;
+
+    IMC::PlanManeuver pman;
+    pman.maneuver_id = "1";
+    pman.data.set(man);
+
+    IMC::PlanSpecification spec;
+    spec.plan_id = "test";
+    spec.start_man_id = "1";
+    spec.maneuvers.push_back(pman);
+    spec.maneuvers.push_back(pman);
+
+    IMC::PlanControl msg;
+    msg.setTimeStamp(10.0);
+    msg.type = IMC::PlanControl::PC_REQUEST;
+    msg.op = IMC::PlanControl::PC_START;
+    msg.plan_id = "test";
+    msg.arg.set(spec);
+    test.boolean("nested messages", roundTrip(msg));
+  }
+
+  {
+    IMC::Temperature msg;
+    msg.setTimeStamp(10.0);
+    msg.value = 21.5f;
+
+    const char* json = "{ \"value\": 21.5, \"timestamp\": \"10\", \"unknown\": [1, {\"a\": null}], \"abbrev\": \"Temperature\" }";
+    IMC::Message* msg_d = IMC::fromJSON(json, std::strlen(json));
+    test.boolean("bare values and unknown keys", msg == *msg_d);
+    delete msg_d;
+  }
+
+  {
+    const char* json = "{\"abbrev\":\"Temperature\",\"value\":\"1\"";
+    try
+    {
+      IMC::Message* msg_d = IMC::fromJSON(json, std::strlen(json));
+      delete msg_d;
+      test.failed("truncated document");
+    }
+    catch (IMC::InvalidJSON&)
+    {
+      test.passed("truncated document");
+    }
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,155 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ headers
+#include <vector>
+#include "Test.hpp"
+
+// DUNE headers
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Decode a stream fed in chunks of a given size.
+static unsigned
+decode(IMC::Parser& parser, const std::vector<uint8_t>& stream, unsigned chunk,
+       std::vector<IMC::Message*>& msgs)
+{
+  unsigned count = 0;
+
+  for (unsigned i = 0; i < stream.size(); i += chunk)
+  {
+    const uint8_t* p = &stream[i];
+    unsigned n = std::min(chunk, (unsigned)stream.size() - i);
+    unsigned consumed = 0;
+
+    while (n > 0)
+    {
+      IMC::Message* m = parser.parse(p, n, consumed);
+      p += consumed;
+      n -= consumed;
+
+      if (m)
+      {
+        msgs.push_back(m->clone());
+        parser.release(m);
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+static void
+clear(std::vector<IMC::Message*>& msgs)
+{
+  for (unsigned i = 0; i < msgs.size(); ++i)
+    delete msgs[i];
+  msgs.clear();
+}
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::Parser");
+
+  IMC::EntityState state;
+  state.setSource(0x1234);
+  state.state = 2;
+  state.description = "ok";
+
+  IMC::Heartbeat hbeat;
+  hbeat.setSource(0x4321);
+
+  std::vector<uint8_t> stream;
+  Utils::ByteBuffer bfr;
+
+  // Leading garbage, a corrupted frame and three valid frames.
+  stream.push_back(0x00);
+  stream.push_back(0xfe);
+  IMC::Packet::serialize(&state, bfr);
+  stream.insert(stream.end(), bfr.getBuffer(), bfr.getBuffer() + bfr.getSize());
+  stream.back() ^= 0xff;
+  IMC::Packet::serialize(&state, bfr);
+  stream.insert(stream.end(), bfr.getBuffer(), bfr.getBuffer() + bfr.getSize());
+  IMC::Packet::serialize(&hbeat, bfr);
+  stream.insert(stream.end(), bfr.getBuffer(), bfr.getBuffer() + bfr.getSize());
+  state.state = 3;
+  IMC::Packet::serialize(&state, bfr);
+  stream.insert(stream.end(), bfr.getBuffer(), bfr.getBuffer() + bfr.getSize());
+  state.state = 2;
+
+  std::vector<IMC::Message*> msgs;
+  bool ok = true;
+
+  for (unsigned chunk = 1; chunk <= stream.size(); ++chunk)
+  {
+    IMC::Parser parser;
+    parser.setReuse(chunk % 2 == 0);
+
+    if (decode(parser, stream, chunk, msgs) != 3
+        || !(*msgs[0] == state)
+        || !(*msgs[1] == hbeat)
+        || static_cast<IMC::EntityState*>(msgs[2])->state != 3)
+      ok = false;
+
+    clear(msgs);
+  }
+
+  test.boolean("span decoding of any chunk size", ok);
+
+  {
+    IMC::Parser parser;
+    unsigned count = 0;
+    for (unsigned i = 0; i < stream.size(); ++i)
+    {
+      IMC::Message* m = parser.parse(stream[i]);
+      if (m)
+      {
+        ++count;
+        delete m;
+      }
+    }
+
+    test.boolean("byte decoding", count == 3);
+  }
+
+  {
+    IMC::Parser parser;
+    IMC::EntityState bound;
+    parser.bind(&bound);
+
+    unsigned consumed = 0;
+    IMC::Message* m = parser.parse(&stream[0], stream.size(), consumed);
+    test.boolean("decode into bound message", m == &bound && bound == state);
+    parser.release(m);
+  }
+
+  return test.getReturnValue();
+}
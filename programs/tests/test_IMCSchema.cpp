@@ -0,0 +1,86 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ headers
+#include <vector>
+#include "Test.hpp"
+
+// DUNE headers
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+int
+main(void)
+{
+  Test test("DUNE::IMC::Schema");
+
+  IMC::Schema schema;
+  test.boolean("version", !schema.getVersion().empty());
+
+  std::vector<uint32_t> ids;
+  IMC::Factory::getIds(ids);
+  test.boolean("one definition per message", schema.getDefinitions().size() == ids.size());
+
+  bool names_ok = true;
+  bool sizes_ok = true;
+
+  for (unsigned i = 0; i < ids.size(); ++i)
+  {
+    const IMC::Schema::Definition* def = schema.find(ids[i]);
+    if (def == NULL || def->abbrev != IMC::Factory::getAbbrevFromId(ids[i]))
+    {
+      names_ok = false;
+      continue;
+    }
+
+    // Fixed size fields must add up to the generated fixed size.
+    unsigned size = 0;
+    for (unsigned j = 0; j < def->fields.size(); ++j)
+      size += IMC::Schema::getSize(def->fields[j].type);
+
+    IMC::Message* msg = IMC::Factory::produce(ids[i]);
+    if (size != msg->getFixedSerializationSize())
+      sizes_ok = false;
+    delete msg;
+  }
+
+  test.boolean("names match the factory", names_ok);
+  test.boolean("fixed sizes match the messages", sizes_ok);
+
+  const IMC::Schema::Definition* def = schema.find(DUNE_IMC_ENTITYINFO);
+  test.boolean("field order and types",
+               def != NULL && def->fields.size() == 5
+               && def->fields[1].abbrev == "label"
+               && def->fields[1].type == IMC::Schema::TYPE_PLAINTEXT
+               && def->fields[3].unit == "s");
+
+  test.boolean("unknown message", schema.find(65000) == NULL);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,228 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Navigation/InertialIntegrator.hpp>
+#include <DUNE/Navigation/InertialStream.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::Navigation;
+
+//! Number of samples pushed by the writer thread.
+static const unsigned c_samples = 200000;
+
+//! Thread pushing samples with increasing times.
+class Writer: public Concurrency::Thread
+{
+public:
+  Writer(InertialStream& stream):
+    m_stream(stream)
+  { }
+
+private:
+  InertialStream& m_stream;
+
+  void
+  run(void)
+  {
+    InertialSample sample;
+    for (unsigned i = 0; i < c_samples; ++i)
+    {
+      sample.time = i;
+      for (unsigned j = 0; j < 3; ++j)
+      {
+        sample.angvel[j] = i;
+        sample.accel[j] = i;
+      }
+
+      m_stream.push(sample);
+    }
+  }
+};
+
+static InertialSample
+makeSample(double time, double p, double q, double r, double ax, double ay, double az)
+{
+  InertialSample sample;
+  sample.time = time;
+  sample.angvel[0] = p;
+  sample.angvel[1] = q;
+  sample.angvel[2] = r;
+  sample.accel[0] = ax;
+  sample.accel[1] = ay;
+  sample.accel[2] = az;
+  return sample;
+}
+
+int
+main(void)
+{
+  Test test("Navigation::InertialStream");
+
+  {
+    InertialStream stream;
+    stream.push(makeSample(0, 0, 0, 0, 0, 0, 0));
+
+    InertialStream::Reader reader(stream);
+    InertialSample samples[8];
+    test.boolean("reader starts at the head", reader.read(samples, 8) == 0);
+
+    for (unsigned i = 1; i <= 5; ++i)
+      stream.push(makeSample(i, 0, 0, 0, 0, 0, 0));
+
+    unsigned n = reader.read(samples, 3);
+    test.boolean("partial read", n == 3 && samples[0].time == 1 && samples[2].time == 3);
+    n = reader.read(samples, 8);
+    test.boolean("remaining samples", n == 2 && samples[1].time == 5);
+    test.boolean("nothing lost", reader.getLost() == 0);
+
+    for (unsigned i = 0; i < InertialStream::c_capacity * 2; ++i)
+      stream.push(makeSample(100 + i, 0, 0, 0, 0, 0, 0));
+
+    unsigned total = 0;
+    bool ordered = true;
+    double last = 0;
+    while ((n = reader.read(samples, 8)) > 0)
+    {
+      for (unsigned i = 0; i < n; ++i)
+      {
+        ordered = ordered && samples[i].time > last;
+        last = samples[i].time;
+      }
+
+      total += n;
+    }
+
+    test.boolean("overrun keeps the newest samples",
+                 ordered && last == 100 + InertialStream::c_capacity * 2 - 1);
+    test.boolean("overrun is reported",
+                 reader.getLost() + total == InertialStream::c_capacity * 2);
+  }
+
+  {
+    InertialStream stream;
+    InertialStream::Reader reader(stream);
+    Writer writer(stream);
+    writer.start();
+
+    InertialSample samples[16];
+    unsigned long received = 0;
+    bool consistent = true;
+    double last = -1;
+    while (received + reader.getLost() < c_samples)
+    {
+      unsigned n = reader.read(samples, 16);
+      for (unsigned i = 0; i < n; ++i)
+      {
+        consistent = consistent && samples[i].time > last;
+        consistent = consistent && samples[i].angvel[2] == samples[i].time;
+        consistent = consistent && samples[i].accel[0] == samples[i].time;
+        last = samples[i].time;
+      }
+
+      received += n;
+    }
+
+    writer.stopAndJoin();
+    test.boolean("concurrent samples are consistent", consistent);
+    test.boolean("concurrent samples are accounted", received + reader.getLost() == c_samples);
+  }
+
+  {
+    InertialStreams streams;
+    test.boolean("streams are created once", &streams.get(3) == &streams.get(3));
+    test.boolean("streams are per entity", &streams.get(3) != &streams.get(4));
+  }
+
+  {
+    InertialIntegrator integ;
+    integ.add(makeSample(0.01, 1, 0, 0, 1, 0, 0), 0.01);
+    integ.add(makeSample(0.02, 3, 0, 0, 3, 0, 0), 0.01);
+
+    double v[3];
+    integ.getAngularVelocity(v);
+    test.boolean("mean angular velocity", v[0] == 2);
+    integ.getAcceleration(v);
+    test.boolean("mean acceleration", v[0] == 2);
+    integ.getDeltaAngle(v);
+    test.boolean("angle increment", std::fabs(v[0] - 0.04) < 1e-12);
+    test.boolean("block size", integ.getCount() == 2 && std::fabs(integ.getInterval() - 0.02) < 1e-12);
+
+    integ.reset();
+    test.boolean("reset", integ.getCount() == 0);
+
+    // Constant rotation about z with a constant specific force along
+    // the body x axis: the velocity increment resolved in the frame
+    // at the start of the block picks up a y component.
+    const double w = 1.0;
+    const double a = 2.0;
+    const double dt = 0.001;
+    const unsigned n = 100;
+    const double t = n * dt;
+
+    InertialIntegrator plain;
+    integ.setCompensation(true);
+    for (unsigned i = 0; i < n; ++i)
+    {
+      integ.add(makeSample(i * dt, 0, 0, w, a, 0, 0), dt);
+      plain.add(makeSample(i * dt, 0, 0, w, a, 0, 0), dt);
+    }
+
+    double exact = a * (1 - std::cos(w * t)) / w;
+    integ.getDeltaVelocity(v);
+    test.boolean("sculling compensation", std::fabs(v[1] - exact) < 1e-5);
+    plain.getDeltaVelocity(v);
+    test.boolean("uncompensated increment", v[1] == 0);
+    integ.getDeltaAngle(v);
+    test.boolean("no coning about a fixed axis", std::fabs(v[2] - w * t) < 1e-12 && v[0] == 0 && v[1] == 0);
+
+    // Coning motion: oscillation about two axes in quadrature.
+    integ.reset();
+    plain.reset();
+    for (unsigned i = 0; i < n; ++i)
+    {
+      double phase = 2 * M_PI * i * dt / t;
+      InertialSample sample = makeSample(i * dt, std::cos(phase), std::sin(phase), 0, 0, 0, 0);
+      integ.add(sample, dt);
+      plain.add(sample, dt);
+    }
+
+    double coning[3];
+    integ.getDeltaAngle(coning);
+    plain.getDeltaAngle(v);
+    test.boolean("coning correction", std::fabs(coning[2]) > 1e-4 && v[2] == 0);
+  }
+
+  return test.getReturnValue();
+}
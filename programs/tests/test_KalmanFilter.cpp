@@ -0,0 +1,153 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Navigation/KalmanFilter.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Navigation::KalmanFilter;
+
+//! Number of states.
+static const short c_states = 4;
+//! Number of outputs.
+static const short c_outputs = 3;
+
+//! Build a filter with correlated states and sparse observations.
+//! @param kal filter.
+//! @param correlated true to use correlated measurement noise.
+static void
+setup(KalmanFilter& kal, bool correlated)
+{
+  static const double p[c_states][c_states] =
+  {
+    {4.0, 1.0, 0.5, 0.0},
+    {1.0, 3.0, 0.2, 0.1},
+    {0.5, 0.2, 2.0, 0.3},
+    {0.0, 0.1, 0.3, 1.0}
+  };
+
+  kal.reset(c_states, c_outputs);
+
+  for (short i = 0; i < c_states; ++i)
+  {
+    kal.setState(i, 0.1 * i);
+    for (short j = 0; j < c_states; ++j)
+      kal.setCovariance(i, j, p[i][j]);
+  }
+
+  kal.setObservation(0, 0, 1.0);
+  kal.setObservation(1, 1, 1.0);
+  kal.setObservation(1, 2, -0.5);
+  kal.setObservation(2, 3, 2.0);
+
+  kal.setMeasurementNoise(0, 0.5);
+  kal.setMeasurementNoise(1, 0.8);
+  kal.setMeasurementNoise(2, 0.3);
+
+  if (correlated)
+  {
+    kal.setMeasurementNoise(0, 1, 0.2);
+    kal.setMeasurementNoise(1, 0, 0.2);
+    kal.setMeasurementNoise(1, 2, -0.1);
+    kal.setMeasurementNoise(2, 1, -0.1);
+  }
+
+  kal.setInnovation(0, 0.7);
+  kal.setInnovation(1, -0.3);
+  kal.setInnovation(2, 0.4);
+}
+
+//! Compare the sequential update with the standard one.
+//! @param correlated true to use correlated measurement noise.
+//! @return true if states and covariances match.
+static bool
+matches(bool correlated)
+{
+  KalmanFilter std_kal;
+  setup(std_kal, correlated);
+  std_kal.update(0);
+
+  KalmanFilter seq_kal;
+  setup(seq_kal, correlated);
+  seq_kal.setUpdateMode(KalmanFilter::UPDATE_SEQUENTIAL);
+  seq_kal.update(0);
+
+  for (short i = 0; i < c_states; ++i)
+  {
+    if (std::fabs(std_kal.getState(i) - seq_kal.getState(i)) > 1e-9)
+      return false;
+
+    for (short j = 0; j < c_states; ++j)
+    {
+      if (std::fabs(std_kal.getCovariance(i, j) - seq_kal.getCovariance(i, j)) > 1e-9)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("Navigation::KalmanFilter");
+
+  test.boolean("sequential update with diagonal noise", matches(false));
+  test.boolean("sequential update with correlated noise", matches(true));
+
+  {
+    // Very precise measurements of a very uncertain state: the
+    // covariance must stay symmetric with a non-negative diagonal.
+    KalmanFilter kal;
+    kal.reset(2, 1);
+    kal.setUpdateMode(KalmanFilter::UPDATE_SEQUENTIAL);
+    kal.setCovariance(0, 0, 1e8);
+    kal.setCovariance(0, 1, 1e8 - 1);
+    kal.setCovariance(1, 0, 1e8 - 1);
+    kal.setCovariance(1, 1, 1e8);
+    kal.setObservation(0, 0, 1.0);
+    kal.setMeasurementNoise(0, 1e-8);
+
+    bool ok = true;
+    for (unsigned i = 0; i < 100 && ok; ++i)
+    {
+      kal.setInnovation(0, 1e-3);
+      kal.update(0);
+      ok = kal.getCovariance(0, 1) == kal.getCovariance(1, 0)
+      && kal.getCovariance(0, 0) >= 0 && kal.getCovariance(1, 1) >= 0;
+    }
+
+    test.boolean("sequential covariance stays positive", ok);
+  }
+
+  return test.getReturnValue();
+}
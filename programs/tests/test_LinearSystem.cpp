@@ -0,0 +1,128 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Control/LinearSystem.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Control::LinearSystem;
+using DUNE::Math::Matrix;
+
+//! Double integrator: position and velocity driven by acceleration.
+static LinearSystem
+doubleIntegrator(void)
+{
+  double a[] = {0, 1, 0, 0};
+  double b[] = {0, 1};
+  double c[] = {1, 0};
+  double d[] = {0};
+  return LinearSystem(Matrix(a, 2, 2), Matrix(b, 2, 1), Matrix(c, 1, 2), Matrix(d, 1, 1));
+}
+
+int
+main(void)
+{
+  Test test("Control::LinearSystem");
+
+  {
+    LinearSystem sys = doubleIntegrator();
+    double dt = 0.1;
+    sys.c2d(dt);
+    test.boolean("c2d() A", std::fabs(sys.getA()(0, 1) - dt) < 1e-9
+                 && std::fabs(sys.getA()(0, 0) - 1.0) < 1e-9);
+    test.boolean("c2d() B", std::fabs(sys.getB()(0) - dt * dt / 2) < 1e-9
+                 && std::fabs(sys.getB()(1) - dt) < 1e-9);
+  }
+
+  {
+    // Discrete simulation and cached stepping agree.
+    LinearSystem dsys = doubleIntegrator();
+    LinearSystem csys = doubleIntegrator();
+    dsys.c2d(0.05);
+
+    Matrix u(1, 1, 0.5);
+    bool ok = true;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+      Matrix y = dsys.simLinearSystem(u, 0);
+      const Matrix& z = csys.step(u, 0.05);
+      if (std::fabs(y(0) - z(0)) > 1e-9)
+        ok = false;
+    }
+
+    // x = a t^2 / 2 at t = 5 s.
+    test.boolean("step() matches simLinearSystem()", ok);
+    test.boolean("step() position", std::fabs(csys.getY0()(0) - 0.5 * 0.5 * 25.0) < 1e-6);
+    test.boolean("constant step is cached once", csys.getCacheSize() == 1);
+  }
+
+  {
+    // Jittery steps are interpolated from close cached steps.
+    LinearSystem sys = doubleIntegrator();
+    Matrix u(1, 1, 1.0);
+    sys.step(u, 0.098);
+    sys.step(u, 0.102);
+
+    double x0 = sys.getX0()(0);
+    double v0 = sys.getX0()(1);
+    sys.step(u, 0.1);
+    double dx = sys.getX0()(0) - (x0 + v0 * 0.1 + 0.1 * 0.1 / 2);
+    test.boolean("interpolated step is close", std::fabs(dx) < 1e-5);
+    test.boolean("interpolated step is not cached", sys.getCacheSize() == 2);
+  }
+
+  {
+    // Batch simulation matches repeated steps.
+    LinearSystem a = doubleIntegrator();
+    LinearSystem b = doubleIntegrator();
+    Matrix us(1, 50, 0.0);
+    for (unsigned k = 0; k < 50; ++k)
+      us(0, k) = std::sin(k * 0.3);
+
+    Matrix ys;
+    a.simulate(us, 0.02, ys);
+
+    bool ok = ys.rows() == 1 && ys.columns() == 50;
+    for (unsigned k = 0; ok && k < 50; ++k)
+    {
+      Matrix u(1, 1, us(0, k));
+      if (std::fabs(b.step(u, 0.02)(0) - ys(0, k)) > 1e-12)
+        ok = false;
+    }
+
+    test.boolean("simulate() matches step()", ok);
+    test.boolean("simulate() updates state", std::fabs(a.getX0()(0) - b.getX0()(0)) < 1e-12);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,143 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Write a plain log of Rpm messages, with the value holding the time
+//! stamp, and a Voltage message after each.
+static void
+writeLog(const char* path, const double* times, unsigned count)
+{
+  std::ofstream ofs(path, std::ios::binary);
+  Utils::ByteBuffer bfr;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    IMC::Rpm rpm;
+    rpm.setTimeStamp(times[i]);
+    rpm.value = (int16_t)times[i];
+    IMC::Packet::serialize(&rpm, bfr);
+    ofs.write(bfr.getBufferSigned(), rpm.getSerializationSize());
+
+    IMC::Voltage volt;
+    volt.setTimeStamp(times[i]);
+    IMC::Packet::serialize(&volt, bfr);
+    ofs.write(bfr.getBufferSigned(), volt.getSerializationSize());
+  }
+}
+
+//! Read all Rpm messages, as "value:log" items.
+static std::string
+readAll(IMC::LogMerger& merger)
+{
+  std::string rv;
+  IMC::Message* msg = NULL;
+  while ((msg = merger.read()) != NULL)
+  {
+    if (msg->getId() == DUNE_IMC_RPM)
+    {
+      char item[32];
+      std::sprintf(item, "%d:%u ", static_cast<IMC::Rpm*>(msg)->value, merger.getLog());
+      rv += item;
+    }
+
+    delete msg;
+  }
+
+  return rv;
+}
+
+int
+main(void)
+{
+  Test test("IMC::LogMerger");
+
+  const double a[] = {10, 13, 14, 20};
+  const double b[] = {11, 12, 14, 30, 31};
+  writeLog("test_LogMerger_a.tmp", a, 4);
+  writeLog("test_LogMerger_b.tmp", b, 5);
+  std::ofstream("test_LogMerger_c.tmp", std::ios::binary);
+
+  {
+    IMC::LogMerger merger(2);
+    merger.add("test_LogMerger_a.tmp");
+    merger.add("test_LogMerger_c.tmp");
+    merger.add("test_LogMerger_b.tmp");
+    test.boolean("start time", merger.getStartTime() == 10);
+
+    std::set<uint16_t> ids;
+    ids.insert(DUNE_IMC_RPM);
+    merger.setFilter(ids);
+
+    std::string rv = readAll(merger);
+    test.boolean("ordered by time and log", rv == "10:0 11:2 12:2 13:0 14:0 14:2 20:0 30:2 31:2 ");
+    test.boolean("end of logs", merger.read() == NULL);
+  }
+
+  {
+    IMC::LogMerger merger;
+    merger.add("test_LogMerger_b.tmp");
+    merger.add("test_LogMerger_a.tmp");
+    merger.setTimeRange(12, 20);
+    test.boolean("time range", readAll(merger) == "12:0 13:1 14:0 14:1 20:1 ");
+  }
+
+  {
+    IMC::LogMerger merger;
+    merger.add("test_LogMerger_a.tmp");
+    IMC::Message* msg = merger.read();
+    test.boolean("filters are optional", msg != NULL && msg->getId() == DUNE_IMC_RPM);
+    delete msg;
+    msg = merger.read();
+    test.boolean("all messages", msg != NULL && msg->getId() == DUNE_IMC_VOLTAGE);
+    delete msg;
+    // Remaining messages are discarded on destruction.
+  }
+
+  {
+    IMC::LogMerger merger;
+    merger.add("test_LogMerger_c.tmp");
+    test.boolean("empty logs", merger.getStartTime() < 0 && merger.read() == NULL);
+  }
+
+  std::remove("test_LogMerger_a.tmp");
+  std::remove("test_LogMerger_b.tmp");
+  std::remove("test_LogMerger_c.tmp");
+
+  return test.getReturnValue();
+}
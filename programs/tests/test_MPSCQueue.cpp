@@ -0,0 +1,145 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Concurrency;
+
+//! Number of producer threads.
+static const unsigned c_producers = 4;
+//! Number of items pushed by each producer.
+static const unsigned c_items = 20000;
+
+class Producer: public Thread
+{
+public:
+  Producer(MPSCQueue<unsigned>& queue, unsigned id):
+    m_queue(queue),
+    m_id(id)
+  { }
+
+private:
+  MPSCQueue<unsigned>& m_queue;
+  unsigned m_id;
+
+  void
+  run(void)
+  {
+    for (unsigned i = 0; i < c_items; ++i)
+    {
+      while (!m_queue.push((m_id << 24) | i))
+        Scheduler::yield();
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("Concurrency::MPSCQueue");
+
+  {
+    MPSCQueue<unsigned> queue(5);
+    test.boolean("capacity()", queue.capacity() == 8);
+    test.boolean("empty()", queue.empty());
+
+    unsigned v = 0;
+    test.boolean("pop() (empty)", !queue.pop(v));
+
+    bool ok = true;
+    for (unsigned i = 0; i < 8; ++i)
+      ok = ok && queue.push(i);
+    test.boolean("push() (full capacity)", ok && queue.size() == 8);
+    test.boolean("push() (overflow)", !queue.push(8));
+
+    unsigned items[8];
+    test.boolean("pop() (batch)", queue.pop(items, 3) == 3 && items[0] == 0 && items[2] == 2);
+
+    ok = true;
+    for (unsigned i = 3; i < 8; ++i)
+      ok = ok && queue.pop(v) && v == i;
+    test.boolean("pop() (order)", ok && queue.empty());
+    test.boolean("waitForItems() (timeout)", !queue.waitForItems(0.01));
+
+    queue.wakeup();
+    test.boolean("waitForItems() (wakeup)", queue.waitForItems(0.01) && queue.empty());
+    test.boolean("waitForItems() (wakeup consumed)", !queue.waitForItems(0.01));
+  }
+
+  {
+    MPSCQueue<unsigned> queue(256);
+    std::vector<Producer*> producers;
+    for (unsigned i = 0; i < c_producers; ++i)
+    {
+      producers.push_back(new Producer(queue, i));
+      producers.back()->start();
+    }
+
+    std::vector<unsigned> next(c_producers, 0);
+    unsigned total = 0;
+    bool ordered = true;
+
+    unsigned timeouts = 0;
+    while (total < c_producers * c_items && timeouts < 10)
+    {
+      if (!queue.waitForItems(1.0))
+      {
+        ++timeouts;
+        continue;
+      }
+
+      unsigned v = 0;
+      while (queue.pop(v))
+      {
+        unsigned id = v >> 24;
+        if (id >= c_producers || (v & 0xffffff) != next[id])
+          ordered = false;
+        else
+          ++next[id];
+        ++total;
+      }
+    }
+
+    for (unsigned i = 0; i < c_producers; ++i)
+    {
+      producers[i]->join();
+      delete producers[i];
+    }
+
+    test.boolean("concurrent push() (count)", total == c_producers * c_items);
+    test.boolean("concurrent push() (order)", ordered);
+  }
+
+  return test.getReturnValue();
+}
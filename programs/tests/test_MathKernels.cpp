@@ -0,0 +1,137 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Math::Kernels and the Matrix routines using them. *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Math/Kernels.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+static void
+randomize(std::vector<double>& v)
+{
+  for (unsigned i = 0; i < v.size(); ++i)
+    v[i] = (std::rand() % 2001 - 1000) / 100.0;
+}
+
+static double
+maxDifference(const Matrix& a, const Matrix& b)
+{
+  double d = 0;
+  for (int i = 0; i < a.rows(); ++i)
+    for (int j = 0; j < a.columns(); ++j)
+      d = std::max(d, std::fabs(a(i, j) - b(i, j)));
+  return d;
+}
+
+int
+main(void)
+{
+  std::string name = std::string("DUNE::Math::Kernels (") + Kernels::getInstructionSet() + ")";
+  Test test(name.c_str());
+
+  std::srand(1);
+
+  // Products must equal the naive triple loop, term by term.
+  bool exact = true;
+  unsigned dims[][3] = {{1, 1, 1}, {3, 3, 3}, {7, 5, 9}, {12, 12, 12}, {33, 70, 301}, {130, 65, 17}};
+  for (unsigned t = 0; t < sizeof(dims) / sizeof(dims[0]); ++t)
+  {
+    unsigned n = dims[t][0], m = dims[t][1], r = dims[t][2];
+    std::vector<double> a(n * m), b(m * r), c(n * r), e(n * r, 0.0);
+    randomize(a);
+    randomize(b);
+
+    Kernels::gemm(n, m, r, &a[0], &b[0], &c[0]);
+
+    for (unsigned i = 0; i < n; ++i)
+      for (unsigned k = 0; k < m; ++k)
+        for (unsigned j = 0; j < r; ++j)
+          e[i * r + j] += a[i * m + k] * b[k * r + j];
+
+    exact = exact && (c == e);
+  }
+  test.boolean("gemm() matches naive product", exact);
+
+  {
+    std::vector<double> a(45 * 70), t(70 * 45);
+    randomize(a);
+    Kernels::transpose(45, 70, &a[0], &t[0]);
+    bool ok = true;
+    for (unsigned i = 0; i < 45; ++i)
+      for (unsigned j = 0; j < 70; ++j)
+        ok = ok && (t[j * 45 + i] == a[i * 70 + j]);
+    test.boolean("transpose()", ok);
+  }
+
+  {
+    std::vector<double> d(20 * 20);
+    randomize(d);
+    Matrix a(&d[0], 20, 20);
+    Matrix L, U, P;
+    a.lup(L, U, P);
+    test.boolean("lup() factors the matrix", maxDifference(P * a, L * U) < 1e-9);
+
+    Matrix i(20);
+    test.boolean("inverse_lup()", maxDifference(inverse_lup(a) * a, i) < 1e-9);
+    test.boolean("inverse()", maxDifference(inverse(a) * a, i) < 1e-9);
+    test.boolean("inverse_pp()", maxDifference(inverse_pp(a) * a, i) < 1e-9);
+
+    Matrix spd = a * transpose(a) + i;
+    Matrix c = cholesky(spd);
+    bool lower = true;
+    for (unsigned k = 0; k < 20; ++k)
+      for (unsigned j = k + 1; j < 20; ++j)
+        lower = lower && c(k, j) == 0;
+    test.boolean("cholesky() factors the matrix", lower && maxDifference(c * transpose(c), spd) < 1e-9);
+
+    bool thrown = false;
+    try
+    {
+      cholesky(-1.0 * spd);
+    }
+    catch (Matrix::Error& e)
+    {
+      (void)e;
+      thrown = true;
+    }
+    test.boolean("cholesky() rejects indefinite matrices", thrown);
+  }
+
+  return test.getReturnValue();
+}
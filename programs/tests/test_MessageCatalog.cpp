@@ -0,0 +1,152 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Utils.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using DUNE::Utils::MessageCatalog;
+
+static void
+write32(std::string& out, uint32_t value)
+{
+  for (unsigned i = 0; i < 4; ++i)
+    out.push_back((char)((value >> (8 * i)) & 0xff));
+}
+
+//! Write a compiled message catalog (little endian).
+static void
+writeCatalog(const char* path, const std::vector<std::string>& keys, const std::vector<std::string>& values)
+{
+  uint32_t count = keys.size();
+  uint32_t originals = 28;
+  uint32_t translations = originals + count * 8;
+  uint32_t strings = translations + count * 8;
+
+  std::string data;
+  std::string table;
+  std::string contents;
+
+  write32(data, 0x950412de);
+  write32(data, 0);
+  write32(data, count);
+  write32(data, originals);
+  write32(data, translations);
+  write32(data, 0);
+  write32(data, 0);
+
+  for (unsigned pass = 0; pass < 2; ++pass)
+  {
+    const std::vector<std::string>& strs = (pass == 0) ? keys : values;
+    for (size_t i = 0; i < strs.size(); ++i)
+    {
+      write32(table, strs[i].size());
+      write32(table, strings + contents.size());
+      contents += strs[i];
+      contents.push_back(0);
+    }
+  }
+
+  std::ofstream ofs(path, std::ios::binary);
+  ofs << data << table << contents;
+}
+
+int
+main(void)
+{
+  Test test("Utils::MessageCatalog");
+
+  const char* path = "test_MessageCatalog.tmp";
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  keys.push_back("");
+  values.push_back("Content-Type: text/plain; charset=UTF-8\n");
+  keys.push_back("untranslated");
+  values.push_back("");
+  for (unsigned i = 0; i < 1000; ++i)
+  {
+    keys.push_back(Utils::String::str("message %u", i));
+    values.push_back(Utils::String::str("mensagem %u", i));
+  }
+
+  writeCatalog(path, keys, values);
+
+  try
+  {
+    MessageCatalog catalog(path);
+    test.boolean("size()", catalog.size() == 1000);
+
+    bool found = true;
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+      std::string key = Utils::String::str("message %u", i);
+      const char* value = catalog.lookup(key.c_str());
+      if (value == NULL || Utils::String::str("mensagem %u", i) != value)
+        found = false;
+    }
+    test.boolean("lookup() (translated)", found);
+
+    test.boolean("lookup() (missing)", catalog.lookup("message 1000") == NULL);
+    test.boolean("lookup() (untranslated)", catalog.lookup("untranslated") == NULL);
+    test.boolean("lookup() (header)", catalog.lookup("") == NULL);
+  }
+  catch (std::exception& e)
+  {
+    test.boolean(e.what(), false);
+  }
+
+  std::FILE* fd = std::fopen(path, "wb");
+  std::fputs("not a catalog", fd);
+  std::fclose(fd);
+
+  bool rejected = false;
+  try
+  {
+    MessageCatalog catalog(path);
+  }
+  catch (std::runtime_error&)
+  {
+    rejected = true;
+  }
+  test.boolean("MessageCatalog() (invalid)", rejected);
+
+  std::remove(path);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,98 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::IMC;
+
+static PlanSpecification
+createPlan(const std::string& id, unsigned maneuvers)
+{
+  PlanSpecification spec;
+  spec.plan_id = id;
+
+  for (unsigned i = 0; i < maneuvers; ++i)
+  {
+    PlanManeuver man;
+    man.maneuver_id = id;
+    Goto go;
+    go.z = i;
+    man.data.set(go);
+    spec.maneuvers.push_back(man);
+  }
+
+  return spec;
+}
+
+int
+main(void)
+{
+  Test test("IMC::MessageList");
+
+  PlanSpecification a = createPlan("a", 3);
+
+  PlanSpecification copy(a);
+  copy.setSource(0x1234);
+  test.boolean("copy updates own nested headers", (*copy.maneuvers.begin())->getSource() == 0x1234);
+  test.boolean("copy leaves source nested headers", (*a.maneuvers.begin())->getSource() != 0x1234);
+
+  PlanSpecification assigned;
+  assigned = a;
+  test.boolean("assignment copies fields", assigned == a);
+  assigned.setSource(0x1235);
+  test.boolean("assignment updates own nested headers", (*assigned.maneuvers.begin())->getSource() == 0x1235);
+  test.boolean("assignment leaves source nested headers", (*a.maneuvers.begin())->getSource() != 0x1235);
+
+  PlanSpecification b = createPlan("b", 1);
+  b.setSource(0x4321);
+  PlanSpecification a_ref(a);
+  PlanSpecification b_ref(b);
+
+  a.swap(b);
+  test.boolean("swap exchanges messages", a == b_ref && b == a_ref);
+  test.boolean("swap exchanges headers", a.getSource() == 0x4321 && (*a.maneuvers.begin())->getSource() == 0x4321);
+
+  a.maneuvers.swap(b.maneuvers);
+  test.boolean("list swap exchanges elements", a.maneuvers.size() == 3 && b.maneuvers.size() == 1);
+  test.boolean("list swap synchronizes headers", (*a.maneuvers.begin())->getSource() == 0x4321);
+
+  a.maneuvers = a.maneuvers;
+  test.boolean("self assignment keeps elements", a.maneuvers.size() == 3);
+
+  PlanManeuver m;
+  Goto go;
+  m.data.set(go);
+  PlanManeuver n;
+  m.data.swap(n.data);
+  test.boolean("inline swap exchanges messages", m.data.isNull() && !n.data.isNull());
+
+  return test.getReturnValue();
+}
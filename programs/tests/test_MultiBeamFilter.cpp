@@ -0,0 +1,136 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Navigation/MultiBeamFilter.hpp>
+#include <DUNE/Math/Angles.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Navigation::MultiBeamFilter;
+using DUNE::Math::Angles;
+
+static bool
+near(double a, double b, double tol = 1e-6)
+{
+  return std::fabs(a - b) <= tol;
+}
+
+//! Fill ranges of beams hitting a plane seafloor.
+static void
+plane(MultiBeamFilter& filter, const std::vector<double>& angles,
+      double altitude, double slope)
+{
+  // Seafloor: z = altitude - tan(slope) * y.
+  double t = std::tan(slope);
+  for (size_t i = 0; i < angles.size(); ++i)
+    filter.updateBeam(i, altitude / (std::cos(angles[i]) + t * std::sin(angles[i])));
+}
+
+int
+main(void)
+{
+  Test test("Navigation::MultiBeamFilter");
+
+  const size_t beams = 240;
+  std::vector<double> angles(beams);
+  for (size_t i = 0; i < beams; ++i)
+    angles[i] = Angles::radians(-60.0 + 120.0 * i / (beams - 1));
+
+  {
+    MultiBeamFilter filter(beams);
+    test.boolean("no ranges", !filter.process().valid);
+  }
+
+  {
+    MultiBeamFilter filter(beams);
+    filter.setSector(angles.front(), angles.back());
+    plane(filter, angles, 12.0, 0.0);
+
+    const MultiBeamFilter::Estimate& e = filter.process();
+    test.boolean("flat valid", e.valid && e.beams == beams);
+    test.boolean("flat altitude", near(e.altitude, 12.0));
+    test.boolean("flat median", near(e.median, 12.0));
+    test.boolean("flat slope", near(e.slope, 0.0));
+  }
+
+  {
+    MultiBeamFilter filter(beams);
+    filter.setSector(angles.front(), angles.back());
+    plane(filter, angles, 20.0, Angles::radians(10.0));
+
+    const MultiBeamFilter::Estimate& e = filter.process();
+    test.boolean("sloped altitude", near(e.altitude, 20.0));
+    test.boolean("sloped slope", near(e.slope, Angles::radians(10.0)));
+    test.boolean("sloped minimum", e.minimum < e.median);
+  }
+
+  {
+    // Spikes from fish and second returns are rejected.
+    MultiBeamFilter filter(beams);
+    filter.setSector(angles.front(), angles.back());
+    plane(filter, angles, 15.0, 0.0);
+    filter.updateBeam(10, 2.0);
+    filter.updateBeam(120, 3.0);
+    filter.updateBeam(200, 90.0);
+
+    const MultiBeamFilter::Estimate& e = filter.process();
+    test.boolean("outliers rejected", e.beams == beams - 3);
+    test.boolean("outlier flags", !filter.isAccepted(10) && !filter.isAccepted(120) && filter.isAccepted(11));
+    test.boolean("robust altitude", near(e.altitude, 15.0));
+    test.boolean("robust minimum", near(e.minimum, 15.0));
+  }
+
+  {
+    // Dropouts and invalid distances are gated by range.
+    MultiBeamFilter filter(4);
+    filter.setLimits(0.5, 100.0);
+    filter.setMinimumBeams(2);
+    DUNE::IMC::Distance d;
+    d.validity = DUNE::IMC::Distance::DV_VALID;
+    d.value = 8.0;
+    filter.updateBeam(0, d);
+    filter.updateBeam(1, 0.1);
+    d.validity = DUNE::IMC::Distance::DV_INVALID;
+    filter.updateBeam(2, d);
+    filter.updateBeam(3, 8.2);
+
+    const MultiBeamFilter::Estimate& e = filter.process();
+    test.boolean("gated beams", e.valid && e.beams == 2);
+    test.boolean("vertical altitude", near(e.altitude, 8.1));
+
+    filter.updateBeam(3, 200.0);
+    test.boolean("too few beams", !filter.process().valid);
+  }
+
+  return test.getReturnValue();
+}
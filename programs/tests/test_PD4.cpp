@@ -0,0 +1,142 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Parsers/PD4.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Parsers::PD4;
+
+//! Size of ensemble data.
+static const unsigned c_data_size = 43;
+
+//! Append an ensemble with given bottom velocity and beam ranges.
+static void
+ensemble(std::vector<uint8_t>& out, int16_t x_vel, const uint16_t* ranges)
+{
+  std::vector<uint8_t> frm;
+  frm.push_back(0x7d);
+  frm.push_back(0x00);
+  frm.push_back((c_data_size + 4) & 0xff);
+  frm.push_back((c_data_size + 4) >> 8);
+
+  std::vector<uint8_t> data(c_data_size, 0);
+  data[1] = x_vel & 0xff;
+  data[2] = (x_vel >> 8) & 0xff;
+  for (unsigned i = 0; i < 4; ++i)
+  {
+    data[9 + i * 2] = ranges[i] & 0xff;
+    data[10 + i * 2] = ranges[i] >> 8;
+  }
+
+  frm.insert(frm.end(), data.begin(), data.end());
+
+  uint16_t csum = 0;
+  for (unsigned i = 0; i < frm.size(); ++i)
+    csum += frm[i];
+
+  frm.push_back(csum & 0xff);
+  frm.push_back(csum >> 8);
+  out.insert(out.end(), frm.begin(), frm.end());
+}
+
+int
+main(void)
+{
+  Test test("Parsers::PD4");
+
+  const uint16_t ranges[4] = {1000, 0, 250, 5};
+
+  std::vector<uint8_t> stream;
+  stream.push_back(0x12);
+  stream.push_back(0x34);
+  ensemble(stream, 1500, ranges);
+  unsigned first_size = stream.size() - 2;
+  ensemble(stream, -200, ranges);
+
+  {
+    PD4 parser;
+    unsigned count = 0;
+    for (unsigned i = 0; i < stream.size(); ++i)
+    {
+      if (parser.parse(stream[i]))
+        ++count;
+    }
+    test.boolean("byte parser decodes ensembles", count == 2
+                 && parser.data()->x_vel_btm == 0.001 * -200);
+  }
+
+  {
+    PD4 parser;
+    size_t consumed = 0;
+    bool ready = parser.parse(&stream[0], stream.size(), consumed);
+    test.boolean("bulk parser stops after ensemble", ready && consumed == first_size + 2);
+    test.boolean("ensemble is kept verbatim", parser.getEnsembleSize() == first_size
+                 && parser.getEnsemble()[0] == 0x7d);
+
+    const PD4::Data* data = parser.data();
+    test.boolean("velocity is decoded", data->x_vel_btm == 1.5
+                 && (data->vel_btm_validity & PD4::COMP_X));
+    test.boolean("beam validity", data->rng_btm_validity == 0x0d
+                 && data->rng_btm[0] == 10.0 && data->rng_btm[2] == 2.5);
+
+    size_t offset = consumed;
+    ready = parser.parse(&stream[offset], stream.size() - offset, consumed);
+    test.boolean("bulk parser continues", ready && offset + consumed == stream.size()
+                 && parser.data()->x_vel_btm == 0.001 * -200);
+  }
+
+  {
+    std::vector<uint8_t> bad;
+    ensemble(bad, 100, ranges);
+    bad[10] ^= 0xff;
+
+    PD4 parser;
+    size_t consumed = 0;
+    test.boolean("bad checksum is rejected", !parser.parse(&bad[0], bad.size(), consumed));
+  }
+
+  {
+    std::vector<uint8_t> big;
+    ensemble(big, 100, ranges);
+    big[2] = 0xff;
+    big[3] = 0x01;
+    big.resize(600, 0);
+
+    PD4 parser;
+    size_t consumed = 0;
+    test.boolean("oversized ensemble is rejected", !parser.parse(&big[0], big.size(), consumed)
+                 && consumed == big.size());
+  }
+
+  return test.getReturnValue();
+}
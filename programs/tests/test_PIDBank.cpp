@@ -0,0 +1,217 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Control/DiscretePID.hpp>
+#include <DUNE/Control/PIDBank.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Control::DiscretePID;
+using DUNE::Control::PIDBank;
+
+//! Build a gains vector.
+static std::vector<float>
+gains(float p, float i, float d)
+{
+  std::vector<float> v(3);
+  v[0] = p;
+  v[1] = i;
+  v[2] = d;
+  return v;
+}
+
+//! Pseudo-random error sample.
+static float
+sample(void)
+{
+  return (float)(std::rand() % 2001 - 1000) / 100.0f;
+}
+
+int
+main(void)
+{
+  Test test("Control::PIDBank");
+
+  std::srand(1);
+
+  {
+    // Each controller matches a DiscretePID with the same settings.
+    DiscretePID pids[3];
+    PIDBank<3> bank;
+
+    float kp[] = {1.5f, 0.2f, 4.0f};
+    float ki[] = {0.1f, 2.0f, 0.0f};
+    float kd[] = {0.05f, 0.0f, 1.0f};
+    float out_lim[] = {2.0f, 0.0f, 10.0f};
+    float int_lim[] = {0.5f, 0.0f, -1.0f};
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      pids[i].setGains(gains(kp[i], ki[i], kd[i]));
+      pids[i].setOutputLimits(-out_lim[i], out_lim[i]);
+      pids[i].setIntegralLimits(int_lim[i]);
+      bank.setGains(i, gains(kp[i], ki[i], kd[i]));
+      bank.setOutputLimits(i, -out_lim[i], out_lim[i]);
+      bank.setIntegralLimits(i, int_lim[i]);
+    }
+
+    bool same = true;
+    for (unsigned n = 0; n < 1000; ++n)
+    {
+      double dt = 0.01 + (n % 7) * 0.001;
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        float err = sample();
+        float a = 0;
+        float b = 0;
+        if (n % 2)
+        {
+          float derr = sample();
+          a = pids[i].step(dt, err, derr);
+          b = bank.step(i, dt, err, derr);
+        }
+        else
+        {
+          a = pids[i].step(dt, err);
+          b = bank.step(i, dt, err);
+        }
+
+        if (a != b)
+          same = false;
+      }
+    }
+
+    test.boolean("step() matches DiscretePID", same);
+  }
+
+  {
+    // Stepping all controllers at once matches stepping each one.
+    PIDBank<4> all;
+    PIDBank<4> each;
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+      all.setGains(i, gains(1.0f + i, 0.5f, 0.1f * i));
+      each.setGains(i, gains(1.0f + i, 0.5f, 0.1f * i));
+      all.setOutputLimits(i, -3.0f, 3.0f);
+      each.setOutputLimits(i, -3.0f, 3.0f);
+      all.setIntegralLimits(i, 1.0f);
+      each.setIntegralLimits(i, 1.0f);
+    }
+
+    bool same = true;
+    bool limited = true;
+    for (unsigned n = 0; n < 500; ++n)
+    {
+      float errs[4];
+      float derrs[4];
+      float outs[4];
+      for (unsigned i = 0; i < 4; ++i)
+      {
+        errs[i] = sample();
+        derrs[i] = sample();
+      }
+
+      all.step(0.02, errs, (n % 2) ? derrs : NULL, outs);
+
+      for (unsigned i = 0; i < 4; ++i)
+      {
+        float out = (n % 2) ? each.step(i, 0.02, errs[i], derrs[i]) : each.step(i, 0.02, errs[i]);
+        if (out != outs[i])
+          same = false;
+        if (std::fabs(outs[i]) > 3.0f)
+          limited = false;
+      }
+    }
+
+    test.boolean("step() of all controllers matches step() of each one", same);
+    test.boolean("outputs are saturated", limited);
+  }
+
+  {
+    // Reset clears the integral and derivative state.
+    PIDBank<1> bank;
+    bank.setGains(0, gains(0.0f, 1.0f, 1.0f));
+    bank.step(0, 1.0, 2.0f);
+    bank.reset();
+    test.boolean("reset() clears state", bank.step(0, 1.0, 0.0f) == 0.0f);
+  }
+
+  {
+    // Gain schedules are interpolated and clamped to the table.
+    PIDBank<2> bank;
+    bank.setGains(1, gains(7.0f, 8.0f, 9.0f));
+
+    std::vector<float> points;
+    points.push_back(0.0f);
+    points.push_back(1.0f);
+    points.push_back(2.0f);
+
+    std::vector<float> table;
+    table.push_back(1.0f); table.push_back(0.0f); table.push_back(0.0f);
+    table.push_back(3.0f); table.push_back(1.0f); table.push_back(0.0f);
+    table.push_back(4.0f); table.push_back(1.0f); table.push_back(2.0f);
+
+    test.boolean("setGainSchedule() accepts table", bank.setGainSchedule(0, points, table));
+
+    bank.schedule(0.5f);
+    test.boolean("schedule() interpolates",
+                 std::fabs(bank.getProportionalGain(0) - 2.0f) < 1e-6
+                 && std::fabs(bank.getIntegralGain(0) - 0.5f) < 1e-6
+                 && bank.getDerivativeGain(0) == 0.0f);
+
+    bank.schedule(1.5f);
+    test.boolean("schedule() interpolates last segment",
+                 std::fabs(bank.getProportionalGain(0) - 3.5f) < 1e-6
+                 && std::fabs(bank.getDerivativeGain(0) - 1.0f) < 1e-6);
+
+    bank.schedule(-1.0f);
+    test.boolean("schedule() below table", bank.getProportionalGain(0) == 1.0f);
+
+    bank.schedule(5.0f);
+    test.boolean("schedule() above table", bank.getProportionalGain(0) == 4.0f
+                 && bank.getDerivativeGain(0) == 2.0f);
+
+    test.boolean("schedule() keeps unscheduled gains", bank.getProportionalGain(1) == 7.0f);
+
+    std::vector<float> bad(points.rbegin(), points.rend());
+    test.boolean("setGainSchedule() rejects unordered points",
+                 !bank.setGainSchedule(0, bad, table));
+    table.pop_back();
+    test.boolean("setGainSchedule() rejects short table",
+                 !bank.setGainSchedule(0, points, table));
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Plans::Duration.                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Plans/Duration.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Plans::Duration;
+using namespace DUNE;
+
+static IMC::PlanManeuver*
+node(const std::string& id, const IMC::Maneuver& maneuver)
+{
+  IMC::PlanManeuver* pman = new IMC::PlanManeuver;
+  pman->maneuver_id = id;
+  pman->data.set(maneuver);
+  return pman;
+}
+
+static bool
+equal(const Duration::ManeuverDuration& a, const Duration::ManeuverDuration& b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  Duration::ManeuverDuration::const_iterator itr = a.begin();
+  for (; itr != a.end(); ++itr)
+  {
+    Duration::ManeuverDuration::const_iterator jtr = b.find(itr->first);
+    if (jtr == b.end() || jtr->second.size() != itr->second.size())
+      return false;
+
+    for (size_t i = 0; i < itr->second.size(); ++i)
+    {
+      if (std::fabs(itr->second[i] - jtr->second[i]) > 1e-3 * itr->second[i] + 1e-3)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Plans::Duration");
+
+  const double lat = 0.71881;
+  const double lon = -0.15110;
+
+  IMC::PopUp popup;
+  popup.lat = lat;
+  popup.lon = lon;
+  popup.z_units = IMC::Z_DEPTH;
+  popup.speed = 1.5;
+  popup.speed_units = IMC::SUNITS_METERS_PS;
+  popup.duration = 30;
+  popup.flags = IMC::PopUp::FLG_WAIT_AT_SURFACE;
+
+  IMC::Goto go;
+  go.lat = lat + 1e-4;
+  go.lon = lon;
+  go.z = 2;
+  go.z_units = IMC::Z_DEPTH;
+  go.speed = 1000;
+  go.speed_units = IMC::SUNITS_RPM;
+
+  IMC::Rows rows;
+  rows.lat = lat + 2e-4;
+  rows.lon = lon + 1e-4;
+  rows.z = 3;
+  rows.z_units = IMC::Z_DEPTH;
+  rows.speed = 1.2;
+  rows.speed_units = IMC::SUNITS_METERS_PS;
+  rows.width = 300;
+  rows.length = 400;
+  rows.hstep = 20;
+  rows.coff = 10;
+  rows.alternation = 100;
+
+  IMC::Elevator elevator;
+  elevator.lat = lat;
+  elevator.lon = lon + 2e-4;
+  elevator.start_z = 3;
+  elevator.start_z_units = IMC::Z_DEPTH;
+  elevator.end_z = 10;
+  elevator.end_z_units = IMC::Z_DEPTH;
+  elevator.speed = 1.2;
+  elevator.speed_units = IMC::SUNITS_METERS_PS;
+
+  IMC::FollowPath path;
+  path.lat = lat;
+  path.lon = lon;
+  path.z = 5;
+  path.z_units = IMC::Z_DEPTH;
+  path.speed = 1.2;
+  path.speed_units = IMC::SUNITS_METERS_PS;
+  for (int i = 0; i < 20; ++i)
+  {
+    IMC::PathPoint point;
+    point.x = 50.0 * i;
+    point.y = (i % 2) * 30.0;
+    path.points.push_back(point);
+  }
+
+  IMC::StationKeeping sk;
+  sk.lat = lat;
+  sk.lon = lon;
+  sk.z = 0;
+  sk.z_units = IMC::Z_DEPTH;
+  sk.speed = 1.2;
+  sk.speed_units = IMC::SUNITS_METERS_PS;
+  sk.duration = 60;
+
+  std::vector<IMC::PlanManeuver*> nodes;
+  nodes.push_back(node("popup", popup));
+  nodes.push_back(node("goto", go));
+  nodes.push_back(node("rows", rows));
+  nodes.push_back(node("elevator", elevator));
+  nodes.push_back(node("path", path));
+  nodes.push_back(node("sk", sk));
+
+  Duration::SpeedConversion conv;
+  conv.rpm_factor = 0.001f;
+  conv.act_factor = 0.02f;
+
+  Duration::Profile profile;
+  Duration::computeProfile(nodes, profile, conv);
+  test.boolean("computeProfile() starts after the first Goto", profile.first == 2);
+  test.boolean("computeProfile() covers all maneuvers",
+               profile.last == nodes.size() && profile.durations.size() == nodes.size() - 2);
+
+  IMC::EstimatedState state;
+  state.lat = lat;
+  state.lon = lon;
+
+  for (int i = 0; i < 2; ++i)
+  {
+    state.x = i * 250.0;
+    state.y = -i * 120.0;
+    state.depth = i * 4.0;
+
+    Duration::ManeuverDuration serial;
+    Duration::ManeuverDuration::const_iterator a = Duration::parse(nodes, &state, serial, conv);
+    Duration::ManeuverDuration cached;
+    Duration::ManeuverDuration::const_iterator b = Duration::parse(nodes, &state, profile, cached, conv);
+
+    test.boolean("parse() with profile", equal(serial, cached) && a != serial.end()
+                 && b != cached.end() && a->first == "sk" && b->first == "sk");
+    test.boolean("parse() accumulates after Rows",
+                 cached["elevator"].back() > cached["rows"].back()
+                 && cached["sk"].back() > cached["path"].back());
+  }
+
+  // Duration cannot be computed without a speed conversion factor.
+  conv.rpm_factor = 0.0f;
+  Duration::computeProfile(nodes, profile, conv);
+  test.boolean("computeProfile() with unknown duration", profile.first == nodes.size());
+
+  conv.rpm_factor = 0.001f;
+  go.speed_units = IMC::SUNITS_PERCENTAGE;
+  go.speed = 0;
+  nodes.push_back(node("last", go));
+  Duration::computeProfile(nodes, profile, conv);
+  Duration::ManeuverDuration serial;
+  Duration::ManeuverDuration::const_iterator a = Duration::parse(nodes, &state, serial, conv);
+  Duration::ManeuverDuration cached;
+  Duration::ManeuverDuration::const_iterator b = Duration::parse(nodes, &state, profile, cached, conv);
+  test.boolean("parse() stops at unknown duration", profile.last == nodes.size() - 1
+               && equal(serial, cached) && a->first == "sk" && b->first == "sk");
+
+  for (size_t i = 0; i < nodes.size(); ++i)
+    delete nodes[i];
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,112 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Math::QPSolver.                                   *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/QPSolver.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+//! Number of variables of the box-constrained test problem.
+static const int c_n = 8;
+
+//! Build: minimize 0.5 * |x - c|^2 subject to -1 <= x <= 1, written
+//! in the solver's constraint form (A * x + b >= 0).
+static void
+buildProblem(const double* c, Matrix& H, Matrix& f, Matrix& A, Matrix& b)
+{
+  H = Matrix(c_n, c_n, 0.0);
+  f = Matrix(c_n, 1, 0.0);
+  A = Matrix(2 * c_n, c_n, 0.0);
+  b = Matrix(2 * c_n, 1, 1.0);
+
+  for (int i = 0; i < c_n; ++i)
+  {
+    H(i, i) = 1.0;
+    f(i) = -c[i];
+    A(i, i) = -1.0;
+    A(c_n + i, i) = 1.0;
+  }
+}
+
+static bool
+isClamped(const double* c, const Matrix& x)
+{
+  for (int i = 0; i < c_n; ++i)
+  {
+    if (std::fabs(x(i) - std::max(-1.0, std::min(1.0, c[i]))) > 1e-9)
+      return false;
+  }
+
+  return true;
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math::QPSolver");
+
+  double c0[c_n] = {2.0, -3.0, 0.5, 1.5, -0.2, -4.0, 3.0, 0.0};
+  double c1[c_n] = {2.1, -2.9, 0.4, 1.6, -0.1, -3.8, 3.2, 0.1};
+  Matrix H, f, A, b, x;
+
+  buildProblem(c0, H, f, A, b);
+  QPSolver::solve(H, f, A, b, x);
+  test.boolean("solve() clamps to the box", isClamped(c0, x));
+
+  QPSolver cold(c_n, 0, 2 * c_n);
+  cold.setWarmStart(false);
+  QPSolver warm(c_n, 0, 2 * c_n);
+
+  test.boolean("minimize() finds the optimum",
+               warm.minimize(H, f, A, b, x) == QPSolver::QP_OPTIMAL && isClamped(c0, x));
+  test.boolean("active set holds the clamped bounds", warm.getActiveSet().size() == 5);
+
+  buildProblem(c1, H, f, A, b);
+  cold.minimize(H, f, A, b, x);
+  test.boolean("cold start finds the optimum", isClamped(c1, x));
+  test.boolean("warm start finds the optimum",
+               warm.minimize(H, f, A, b, x) == QPSolver::QP_OPTIMAL && isClamped(c1, x));
+  test.boolean("warm start needs no more iterations",
+               warm.getIterations() <= cold.getIterations());
+
+  QPSolver limited;
+  limited.setMaxIterations(2);
+  test.boolean("iteration budget is honoured",
+               limited.minimize(H, f, A, b, x) == QPSolver::QP_MAX_ITERATIONS);
+
+  return test.getReturnValue();
+}
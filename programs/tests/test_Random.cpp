@@ -46,6 +46,9 @@ test_MT19937(void);
 void
 test_KernelDevice(void);
 
+void
+test_Philox(void);
+
 Test test("DUNE::Math::Random");
 
 int
@@ -69,6 +72,8 @@ main(int argc, char** argv)
   test_MT19937();
   // ** FOR KernelDevice: we merely check for sanity if /dev/urandom is available **
   test_KernelDevice();
+  // ** FOR Philox: we check against Random123 known-answer vectors **
+  test_Philox();
 }
 
 // Sample seeds obtained from /dev/urandom
@@ -218,3 +223,52 @@ test_KernelDevice(void)
 
   test.boolean("KernelDevice", b);
 }
+
+void
+test_Philox(void)
+{
+  // Philox4x32-10, key = {0, 0}, counter = {0, 0, 0, 0}.
+  const uint32_t kat[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+  Philox rng(0, 0);
+  int i;
+
+  for (i = 0; i < 4; ++i)
+    if (rng.random32() != kat[i])
+      break;
+  test.boolean("Philox known answer", i == 4);
+
+  // Seeking must reproduce the same sequence.
+  uint32_t ref[16];
+  rng.seek(0);
+  for (i = 0; i < 16; ++i)
+    ref[i] = rng.random32();
+  rng.seek(7);
+  for (i = 7; i < 16; ++i)
+    if (rng.random32() != ref[i])
+      break;
+  test.boolean("Philox seek", i == 16);
+
+  // Different streams of the same seed must differ.
+  Philox a(1234, 1);
+  Philox b(1234, 2);
+  int same = 0;
+  for (i = 0; i < 64; ++i)
+    same += (a.random32() == b.random32());
+  test.boolean("Philox streams", same == 0);
+
+  // Bulk gaussian fill must have sensible moments.
+  const size_t n = 100000;
+  double* v = new double[n];
+  a.fillGaussian(v, n);
+  double m = 0;
+  double m2 = 0;
+  for (size_t j = 0; j < n; ++j)
+  {
+    m += v[j];
+    m2 += v[j] * v[j];
+  }
+  m /= n;
+  m2 = m2 / n - m * m;
+  delete [] v;
+  test.boolean("Philox gaussian fill", std::fabs(m) < 0.02 && std::fabs(m2 - 1.0) < 0.02);
+}
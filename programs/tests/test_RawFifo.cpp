@@ -0,0 +1,134 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+#include <DUNE/Utils/RawFifo.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Concurrency;
+using DUNE::Utils::RawFifo;
+
+//! Total number of bytes streamed by the writer thread.
+static const unsigned c_stream_size = 4 * 1024 * 1024;
+
+class Writer: public Thread
+{
+public:
+  Writer(RawFifo& fifo):
+    m_fifo(fifo)
+  { }
+
+private:
+  RawFifo& m_fifo;
+
+  void
+  run(void)
+  {
+    uint8_t chunk[97];
+    unsigned sent = 0;
+    while (sent < c_stream_size)
+    {
+      unsigned len = std::min((unsigned)sizeof(chunk), c_stream_size - sent);
+      for (unsigned i = 0; i < len; ++i)
+        chunk[i] = (uint8_t)(sent + i);
+
+      unsigned done = 0;
+      while (done < len)
+      {
+        unsigned rv = m_fifo.put(chunk + done, len - done);
+        if (rv == 0)
+          Scheduler::yield();
+        done += rv;
+      }
+
+      sent += len;
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("Utils::RawFifo");
+
+  {
+    RawFifo fifo(5);
+    uint8_t data[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    uint8_t out[8];
+
+    test.boolean("put() (overflow)", fifo.put(data, 8) == 8 && fifo.put(data, 1) == 0);
+    test.boolean("getHead()", fifo.getHead(out, 3) == 3 && fifo.size() == 8 && out[2] == 2);
+    test.boolean("discard()", fifo.discard(5) == 5 && fifo.size() == 3);
+    test.boolean("put() (wrap)", fifo.put(data, 5) == 5 && fifo.size() == 8);
+
+    std::memset(out, 0, sizeof(out));
+    bool ok = fifo.get(out, 8) == 8;
+    ok = ok && out[0] == 5 && out[2] == 7 && out[3] == 0 && out[7] == 4;
+    test.boolean("get() (wrap)", ok && fifo.size() == 0);
+  }
+
+  {
+    RawFifo fifo(256);
+    Writer writer(fifo);
+    writer.start();
+
+    uint8_t bfr[61];
+    unsigned received = 0;
+    bool ordered = true;
+    while (received < c_stream_size)
+    {
+      unsigned rv = fifo.get(bfr, sizeof(bfr));
+      if (rv == 0)
+      {
+        Scheduler::yield();
+        continue;
+      }
+
+      for (unsigned i = 0; i < rv; ++i)
+      {
+        if (bfr[i] != (uint8_t)(received + i))
+          ordered = false;
+      }
+
+      received += rv;
+    }
+
+    writer.join();
+
+    test.boolean("concurrent put()/get() (count)", received == c_stream_size);
+    test.boolean("concurrent put()/get() (order)", ordered);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,167 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+
+// POSIX headers.
+#include <unistd.h>
+
+// DUNE headers.
+#include <DUNE/IO.hpp>
+#include <DUNE/Concurrency.hpp>
+#include <DUNE/Time.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Read end of a POSIX pipe.
+class PipeReader: public IO::Handle
+{
+public:
+  PipeReader(int fd):
+    m_fd(fd)
+  { }
+
+  ~PipeReader(void)
+  {
+    ::close(m_fd);
+  }
+
+private:
+  int m_fd;
+
+  IO::NativeHandle
+  doGetNative(void) const
+  {
+    return m_fd;
+  }
+
+  size_t
+  doWrite(const uint8_t* data, size_t data_size)
+  {
+    (void)data;
+    (void)data_size;
+    return 0;
+  }
+
+  size_t
+  doRead(uint8_t* data, size_t data_size)
+  {
+    ssize_t rv = ::read(m_fd, data, data_size);
+    return (rv < 0) ? 0 : rv;
+  }
+};
+
+class Collector: public IO::Reactor::Listener
+{
+public:
+  Collector(void):
+    errors(0),
+    tstamp(-1)
+  { }
+
+  std::string
+  getData(void)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    return m_data;
+  }
+
+  unsigned errors;
+  double tstamp;
+
+private:
+  Concurrency::Mutex m_mutex;
+  std::string m_data;
+
+  void
+  onData(const uint8_t* data, size_t size, double ts)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    m_data.append((const char*)data, size);
+    tstamp = ts;
+  }
+
+  void
+  onError(const std::string& error)
+  {
+    (void)error;
+    ++errors;
+  }
+};
+
+//! Wait until the collector received a given amount of data.
+static bool
+waitFor(Collector& collector, size_t size)
+{
+  for (unsigned i = 0; i < 200; ++i)
+  {
+    if (collector.getData().size() >= size)
+      return true;
+    Time::Delay::wait(0.01);
+  }
+
+  return false;
+}
+
+int
+main(void)
+{
+  Test test("IO::Reactor");
+
+  int fds[2];
+  if (pipe(fds) != 0)
+    return 1;
+
+  IO::Reactor reactor;
+  PipeReader handle(fds[0]);
+  Collector collector;
+  reactor.add(handle, &collector);
+
+  double before = Time::Clock::getSinceEpoch();
+  test.boolean("write()", ::write(fds[1], "hello", 5) == 5);
+  test.boolean("onData() (content)", waitFor(collector, 5) && collector.getData() == "hello");
+  test.boolean("onData() (timestamp)", collector.tstamp >= before);
+
+  reactor.remove(handle);
+  test.boolean("write() (removed)", ::write(fds[1], "x", 1) == 1);
+  Time::Delay::wait(0.3);
+  test.boolean("remove()", collector.getData() == "hello");
+
+  reactor.add(handle, &collector);
+  test.boolean("add() (again)", waitFor(collector, 6) && collector.getData() == "hellox");
+
+  ::close(fds[1]);
+  for (unsigned i = 0; i < 200 && collector.errors == 0; ++i)
+    Time::Delay::wait(0.01);
+  test.boolean("onError() (end of stream)", collector.errors == 1);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,92 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::IMC;
+
+static bool
+matches(const Message* msg, const ScatterPacket& packet)
+{
+  Utils::ByteBuffer plain;
+  uint16_t n = Packet::serialize(msg, plain);
+  if (n != packet.getSize())
+    return false;
+
+  std::vector<uint8_t> data(packet.getSize());
+  packet.copy(&data[0]);
+  return std::memcmp(&data[0], plain.getBuffer(), n) == 0;
+}
+
+int
+main(void)
+{
+  Test test("IMC::ScatterPacket");
+
+  ScatterPacket packet;
+
+  SonarData sonar;
+  sonar.frequency = 900000;
+  sonar.data.assign(4000, 's');
+  Packet::serialize(&sonar, packet);
+  test.boolean("large data is referenced", packet.getCount() == 3
+               && packet.getBuffers()[1] == (const uint8_t*)&sonar.data[0]);
+  test.boolean("large data packet matches", matches(&sonar, packet));
+
+  sonar.data.assign(10, 's');
+  Packet::serialize(&sonar, packet);
+  test.boolean("small data is copied", packet.getCount() == 1);
+  test.boolean("small data packet matches", matches(&sonar, packet));
+
+  PlanDBState state;
+  state.md5.assign(1000, 'm');
+  state.change_sname = "name";
+  Packet::serialize(&state, packet);
+  test.boolean("fields after data are serialized", packet.getCount() == 3 && matches(&state, packet));
+
+  EstimatedState estate;
+  estate.x = 1.0;
+  Packet::serialize(&estate, packet);
+  test.boolean("messages without data match", packet.getCount() == 1 && matches(&estate, packet));
+
+  SharedMessage* shared = SharedMessage::create(&sonar);
+  Packet::serialize(shared->get(), packet);
+  test.boolean("cached packet is referenced", packet.getCount() == 1 && matches(shared->get(), packet));
+  shared->release();
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,106 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::IMC;
+
+int
+main(void)
+{
+  Test test("IMC::SharedMessagePool");
+
+  SharedMessagePool<SonarData> pool(2);
+
+  SonarData source;
+  source.type = SonarData::ST_SIDESCAN;
+  source.data.assign(1000, 'a');
+  const char* samples = &source.data[0];
+
+  SharedMessage* first = pool.take(source, &SonarData::data);
+  SonarData* msg = SharedMessagePool<SonarData>::get(first);
+  test.boolean("take() moves payload", &msg->data[0] == samples && msg->data.size() == 1000);
+  test.boolean("take() copies fields", msg->type == SonarData::ST_SIDESCAN);
+  test.boolean("take() keeps source size", source.data.size() == 1000);
+
+  // Simulate a recipient holding the message.
+  first->acquire();
+  SharedMessage* second = pool.take();
+  test.boolean("take() skips shared handles", second != first);
+
+  // Recipient done.
+  first->release();
+  test.boolean("take() reuses released handles", pool.take() == first);
+
+  // Exhaust the pool.
+  first->acquire();
+  second->acquire();
+  SharedMessage* third = pool.take();
+  test.boolean("take() replaces when exhausted", third != first && third != second);
+  test.boolean("replaced handle outlives pool slot", first->get()->getId() == SonarData::getIdStatic());
+  first->release();
+  second->release();
+
+  // Serialization cache.
+  SonarData* pooled = SharedMessagePool<SonarData>::get(second);
+  pooled->data.assign(100, 'b');
+  Utils::ByteBuffer plain;
+  Utils::ByteBuffer cached;
+  Packet::serialize(pooled, plain);
+  second->acquire();
+  Packet::serialize(second->get(), cached);
+  pooled->data.clear();
+  Utils::ByteBuffer again;
+  Packet::serialize(second->get(), again);
+  test.boolean("cached packet matches", cached.getSize() == plain.getSize()
+               && std::memcmp(cached.getBuffer(), plain.getBuffer(), plain.getSize()) == 0);
+  test.boolean("cached packet is reused", again.getSize() == plain.getSize()
+               && std::memcmp(again.getBuffer(), plain.getBuffer(), plain.getSize()) == 0);
+
+  Message* copy = second->get()->clone();
+  Packet::serialize(copy, again);
+  test.boolean("copies are not cached", again.getSize() < plain.getSize());
+  delete copy;
+
+  second->release();
+  third->acquire();
+  test.boolean("take() discards cached packet", pool.take() == second);
+  third->release();
+  Packet::serialize(second->get(), again);
+  test.boolean("discarded packet is recomputed", again.getSize() < plain.getSize());
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,128 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Control/SlopeFit.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Control::SlopeFit;
+
+//! Reference least squares gradient of a set of points.
+static double
+gradient(const std::vector<double>& x, const std::vector<double>& z)
+{
+  double mx = 0, mz = 0;
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    mx += x[i];
+    mz += z[i];
+  }
+  mx /= x.size();
+  mz /= x.size();
+
+  double num = 0, den = 0;
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    num += (x[i] - mx) * (z[i] - mz);
+    den += (x[i] - mx) * (x[i] - mx);
+  }
+
+  return num / den;
+}
+
+int
+main(void)
+{
+  Test test("Control::SlopeFit");
+
+  {
+    SlopeFit fit(8);
+    test.boolean("empty fit is invalid", !fit.isValid());
+    fit.add(10.0, 20.0);
+    fit.add(10.0, 21.0);
+    test.boolean("coincident points are invalid", !fit.isValid());
+    test.boolean("invalid gradient is zero", fit.getGradient() == 0.0);
+  }
+
+  {
+    // Bottom rising 1 m every 4 m ahead.
+    SlopeFit fit(8);
+    for (unsigned i = 0; i < 8; ++i)
+      fit.add(i * 2.0, 30.0 - i * 0.5);
+
+    test.boolean("valid fit", fit.isValid());
+    test.boolean("gradient of a line", std::fabs(fit.getGradient() + 0.25) < 1e-9);
+    test.boolean("rising bottom has a positive angle",
+                 std::fabs(fit.getAngle() - std::atan(0.25)) < 1e-9);
+  }
+
+  {
+    // Long run far from the origin: the window only holds the last
+    // points and the sums must not drift.
+    const unsigned window = 10;
+    SlopeFit fit(window);
+    std::vector<double> xs, zs;
+    bool ok = true;
+
+    for (unsigned i = 0; i < 20000; ++i)
+    {
+      double x = 1e5 + i * 0.7;
+      double z = 50.0 + 5.0 * std::sin(x / 13.0) + ((i * 7919) % 13) * 0.01;
+      fit.add(x, z);
+      xs.push_back(x);
+      zs.push_back(z);
+
+      if (xs.size() > window)
+      {
+        xs.erase(xs.begin());
+        zs.erase(zs.begin());
+      }
+
+      if (xs.size() >= 2 && std::fabs(fit.getGradient() - gradient(xs, zs)) > 1e-6)
+        ok = false;
+    }
+
+    test.boolean("sliding window matches batch fit", ok);
+    test.boolean("window size", fit.getSize() == window);
+  }
+
+  {
+    SlopeFit fit(4);
+    fit.add(0.0, 0.0);
+    fit.add(1.0, 1.0);
+    fit.clear();
+    test.boolean("clear()", fit.getSize() == 0 && !fit.isValid());
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,137 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Concurrency;
+
+//! Number of reader threads.
+static const unsigned c_readers = 4;
+//! Number of copies published.
+static const unsigned c_versions = 20000;
+
+//! Value whose fields must always be read consistently.
+struct Pair
+{
+  Pair(unsigned v = 0):
+    a(v),
+    b(~v)
+  { }
+
+  unsigned a;
+  unsigned b;
+};
+
+class Consumer: public Thread
+{
+public:
+  Consumer(Snapshot<Pair>& snapshot):
+    m_consistent(true),
+    m_monotonic(true),
+    m_last(0),
+    m_reader(snapshot)
+  { }
+
+  bool m_consistent;
+  bool m_monotonic;
+  unsigned m_last;
+
+private:
+  Snapshot<Pair>::Reader m_reader;
+
+  void
+  run(void)
+  {
+    while (m_last < c_versions)
+    {
+      m_reader.refresh();
+
+      const Pair& p = m_reader.get();
+      if (p.b != ~p.a)
+        m_consistent = false;
+      if (p.a < m_last)
+        m_monotonic = false;
+
+      m_last = p.a;
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("Concurrency::Snapshot");
+
+  {
+    Snapshot<Pair> snapshot(Pair(1));
+    Snapshot<Pair>::Reader reader(snapshot);
+    test.boolean("get() (initial)", reader.get().a == 1 && reader.getVersion() == 1);
+    test.boolean("refresh() (unchanged)", !reader.refresh());
+
+    snapshot.publish(Pair(2));
+    snapshot.publish(Pair(3));
+    test.boolean("get() (before refresh)", reader->a == 1);
+    test.boolean("refresh() (changed)", reader.refresh());
+    test.boolean("get() (after refresh)", reader->a == 3 && reader.getVersion() == 3);
+    test.boolean("getVersion()", snapshot.getVersion() == 3);
+  }
+
+  {
+    Snapshot<Pair> snapshot;
+    std::vector<Consumer*> consumers;
+    for (unsigned i = 0; i < c_readers; ++i)
+    {
+      consumers.push_back(new Consumer(snapshot));
+      consumers.back()->start();
+    }
+
+    for (unsigned i = 1; i <= c_versions; ++i)
+      snapshot.publish(Pair(i));
+
+    bool consistent = true;
+    bool monotonic = true;
+    for (unsigned i = 0; i < consumers.size(); ++i)
+    {
+      consumers[i]->join();
+      consistent = consistent && consumers[i]->m_consistent;
+      monotonic = monotonic && consumers[i]->m_monotonic;
+      delete consumers[i];
+    }
+
+    test.boolean("concurrent refresh() (consistent)", consistent);
+    test.boolean("concurrent refresh() (monotonic)", monotonic);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,110 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Algorithms/SoundSpeedProfile.hpp>
+#include <DUNE/Algorithms/UNESCO1983.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Algorithms::SoundSpeedProfile;
+using DUNE::Algorithms::UNESCO1983;
+
+static bool
+near(double a, double b, double tol = 1e-9)
+{
+  return std::fabs(a - b) <= tol;
+}
+
+int
+main(void)
+{
+  Test test("Algorithms::SoundSpeedProfile");
+
+  {
+    SoundSpeedProfile ssp(1.0, 100.0, 1480.0);
+    test.boolean("empty profile", ssp.isEmpty());
+    test.boolean("default speed", near(ssp.getSpeed(50.0), 1480.0));
+    test.boolean("default mean speed", near(ssp.getMeanSpeed(0.0, 80.0), 1480.0));
+    test.boolean("default range", near(ssp.getRange(0.1, 10.0, 20.0), 148.0));
+  }
+
+  {
+    SoundSpeedProfile ssp(1.0, 100.0);
+    ssp.add(10.2, 1500.0);
+    ssp.add(10.7, 1502.0);
+    test.boolean("bin mean", near(ssp.getSpeed(10.5), 1501.0));
+    test.boolean("extended to surface", near(ssp.getSpeed(0.0), 1501.0));
+    test.boolean("extended to bottom", near(ssp.getSpeed(200.0), 1501.0));
+
+    ssp.add(20.5, 1511.0);
+    test.boolean("interpolated bins", near(ssp.getSpeed(15.5), 1506.0));
+  }
+
+  {
+    // Two layers: the mean speed is the harmonic mean.
+    SoundSpeedProfile ssp(1.0, 40.0);
+    for (unsigned i = 0; i < 20; ++i)
+    {
+      ssp.add(i + 0.5, 1450.0);
+      ssp.add(i + 20.5, 1550.0);
+    }
+
+    double expected = 40.0 / (20.0 / 1450.0 + 20.0 / 1550.0);
+    test.boolean("harmonic mean", near(ssp.getMeanSpeed(0.0, 40.0), expected));
+    test.boolean("symmetric mean", near(ssp.getMeanSpeed(40.0, 0.0), expected));
+    test.boolean("single layer", near(ssp.getMeanSpeed(2.0, 12.0), 1450.0));
+    test.boolean("horizontal path", near(ssp.getMeanSpeed(30.0, 30.0), 1550.0));
+
+    double h = ssp.getHorizontalRange(0.1, 22.0, 30.0);
+    test.boolean("horizontal range", near(h, std::sqrt(155.0 * 155.0 - 64.0)));
+  }
+
+  {
+    // Running mean saturates so the profile follows changes.
+    SoundSpeedProfile ssp(1.0, 10.0, 1500.0, 4);
+    for (unsigned i = 0; i < 100; ++i)
+      ssp.add(5.5, 1500.0);
+    for (unsigned i = 0; i < 40; ++i)
+      ssp.add(5.5, 1520.0);
+    test.boolean("windowed mean", near(ssp.getSpeed(5.5), 1520.0, 0.1));
+  }
+
+  {
+    SoundSpeedProfile ssp;
+    double speed = ssp.add(3.5, 35.0, 1.35, 15.0);
+    test.boolean("CTD sample", near(speed, UNESCO1983::computeSoundSpeed(35.0, 1.35, 15.0)));
+    test.boolean("CTD profile", near(ssp.getSpeed(3.5), speed));
+    test.boolean("invalid salinity", ssp.add(3.5, -1.0, 1.35, 15.0) < 0.0 && ssp.getSamples() == 1);
+  }
+
+  return test.getReturnValue();
+}
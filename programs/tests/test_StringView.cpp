@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Utils/NMEAParser.hpp>
+#include <DUNE/Utils/String.hpp>
+#include <DUNE/Utils/StringView.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Utils;
+
+int
+main(void)
+{
+  Test test("Utils::StringView");
+
+  {
+    StringView view("  abc \r\n");
+    test.boolean("trim()", view.trim() == "abc");
+    test.boolean("substr()", view.substr(2, 2) == "ab");
+    test.boolean("find()", view.find('c') == 4 && view.find('x') == StringView::npos);
+  }
+
+  {
+    StringView parts[4];
+    unsigned count = Tokenizer("a,,b c,", ',').split(parts, 4);
+    test.boolean("split()", count == 4 && parts[0] == "a" && parts[1].empty()
+                 && parts[2] == "b c" && parts[3].empty());
+    test.boolean("split() (overflow)", Tokenizer("1,2,3", ',').split(parts, 2) == 3);
+  }
+
+  {
+    int32_t i = 0;
+    uint8_t u = 0;
+    test.boolean("toNumber(int32_t)", StringView(" -042 ").toNumber(i) && i == -42);
+    test.boolean("toNumber(uint8_t)", StringView("0").toNumber(u) && u == 0);
+    test.boolean("toNumber(uint8_t) (range)", !StringView("256").toNumber(u));
+    test.boolean("toNumber(uint8_t) (sign)", !StringView("-1").toNumber(u));
+    test.boolean("toNumber(int32_t) (suffix)", !StringView("12a").toNumber(i));
+    test.boolean("toNumber(int32_t) (empty)", !StringView("").toNumber(i));
+  }
+
+  {
+    const char* values[] = {"0", "1.5", "-0.125", "4124.8963", "12345.678901234",
+                            "1e3", "-2.5E-3", "0.000000000000000000001", "123456789012345678901"};
+    bool ok = true;
+    for (unsigned i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+      double value = 0;
+      if (!StringView(values[i]).toNumber(value) || value != std::strtod(values[i], NULL))
+        ok = false;
+    }
+    test.boolean("toNumber(double)", ok);
+
+    double value = 0;
+    test.boolean("toNumber(double) (invalid)", !StringView(".").toNumber(value)
+                 && !StringView("1.2.3").toNumber(value));
+  }
+
+  {
+    StringView body;
+    const char* line = "xx$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+    test.boolean("NMEAParser::validate()", NMEAParser::validate(line, body)
+                 && body == "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+    test.boolean("NMEAParser::validate() (checksum)",
+                 !NMEAParser::validate("$GPGGA,123519*48", body));
+    test.boolean("NMEAParser::validate() (truncated)",
+                 !NMEAParser::validate("$GPGGA,123519*4", body));
+  }
+
+  {
+    std::vector<std::string> lst;
+    String::split(" a , b,,c ", ",", lst);
+    test.boolean("String::split()", lst.size() == 4 && lst[0] == "a" && lst[1] == "b"
+                 && lst[2] == "" && lst[3] == "c");
+    lst.clear();
+    String::split("  ", ",", lst);
+    test.boolean("String::split() (blank)", lst.empty());
+    test.boolean("String::trim()", String::trim("\t x y \n") == "x y");
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,243 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/IMC.hpp>
+#include <DUNE/Tasks/AbstractTask.hpp>
+#include <DUNE/Time/Delay.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::IMC;
+
+//! Task counting the messages delivered by the bus.
+class Counter: public Tasks::AbstractTask
+{
+public:
+  Counter(void):
+    count(0)
+  { }
+
+  void
+  receive(const Message* msg)
+  {
+    (void)msg;
+    ++count;
+  }
+
+  void
+  receive(SharedMessage* msg)
+  {
+    (void)msg;
+    ++count;
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Counter";
+  }
+
+  unsigned count;
+
+private:
+  void
+  run(void)
+  { }
+};
+
+//! Task that takes a while to handle each message.
+class Slow: public Counter
+{
+public:
+  Slow(void):
+    done(false)
+  { }
+
+  void
+  receive(SharedMessage* msg)
+  {
+    Time::Delay::wait(0.2);
+    Counter::receive(msg);
+    done = true;
+  }
+
+  volatile bool done;
+};
+
+//! Thread dispatching one message through the bus.
+class Dispatcher: public Concurrency::Thread
+{
+public:
+  Dispatcher(Bus& bus):
+    m_bus(bus)
+  { }
+
+private:
+  Bus& m_bus;
+
+  void
+  run(void)
+  {
+    Temperature temp;
+    SharedMessage* msg = SharedMessage::create(&temp);
+    m_bus.dispatch(msg);
+    msg->release();
+  }
+};
+
+//! Dispatch a temperature through the bus.
+static void
+dispatch(Bus& bus, unsigned source, unsigned entity, unsigned destination = 0xffff)
+{
+  Temperature msg;
+  msg.setSource(source);
+  msg.setSourceEntity(entity);
+  msg.setDestination(destination);
+  bus.dispatch(&msg);
+}
+
+int
+main(void)
+{
+  Test test("IMC::SubscriptionFilter");
+
+  {
+    SubscriptionFilter all;
+    Temperature msg;
+    msg.setSourceEntity(3);
+    test.boolean("empty filter matches all", all.empty() && all.matches(&msg));
+
+    SubscriptionFilter flt;
+    flt.setSourceEntity(3).setSource(0x10);
+    msg.setSource(0x10);
+    test.boolean("chained criteria match", !flt.empty() && flt.matches(&msg));
+    msg.setSource(0x11);
+    test.boolean("all criteria must match", !flt.matches(&msg));
+  }
+
+  {
+    Bus bus;
+    Counter all;
+    Counter ent;
+    Counter sys;
+    Counter dst;
+
+    bus.registerRecipient(&all, DUNE_IMC_TEMPERATURE);
+
+    SubscriptionFilter flt;
+    flt.setSourceEntity(7);
+    bus.registerRecipient(&ent, DUNE_IMC_TEMPERATURE, &flt);
+
+    flt = SubscriptionFilter();
+    flt.setSource(0x20);
+    bus.registerRecipient(&sys, DUNE_IMC_TEMPERATURE, &flt);
+
+    flt = SubscriptionFilter();
+    flt.setDestination(0x30);
+    bus.registerRecipient(&dst, DUNE_IMC_TEMPERATURE, &flt);
+
+    dispatch(bus, 0x10, 7);
+    dispatch(bus, 0x20, 8);
+    dispatch(bus, 0x10, 8, 0x30);
+    dispatch(bus, 0x10, 9);
+
+    test.boolean("unfiltered recipient receives all", all.count == 4);
+    test.boolean("source entity filter", ent.count == 1);
+    test.boolean("source system filter", sys.count == 1);
+    test.boolean("destination filter", dst.count == 1);
+
+    bus.registerRecipient(&ent, DUNE_IMC_TEMPERATURE);
+    dispatch(bus, 0x10, 9);
+    test.boolean("registering again replaces filter", ent.count == 2);
+
+    bus.unregisterRecipient(&ent, DUNE_IMC_TEMPERATURE);
+    dispatch(bus, 0x10, 7);
+    test.boolean("unregistered recipient receives nothing", ent.count == 2);
+  }
+
+  {
+    Bus bus;
+    Counter sub;
+    Counter lim;
+
+    SubscriptionFilter flt;
+    flt.setSubId(5);
+    bus.registerRecipient(&sub, DUNE_IMC_SERVOPOSITION, &flt);
+
+    ServoPosition pos;
+    pos.id = 4;
+    bus.dispatch(&pos);
+    pos.id = 5;
+    bus.dispatch(&pos);
+    test.boolean("sub-ID filter", sub.count == 1);
+
+    flt = SubscriptionFilter();
+    flt.setMinimumInterval(0.2);
+    bus.registerRecipient(&lim, DUNE_IMC_TEMPERATURE, &flt);
+
+    dispatch(bus, 0x10, 1);
+    dispatch(bus, 0x10, 1);
+    dispatch(bus, 0x10, 2);
+    test.boolean("minimum interval is per entity", lim.count == 2);
+
+    dispatch(bus, 0x11, 1);
+    dispatch(bus, 0x11, 1);
+    test.boolean("minimum interval is per system", lim.count == 3);
+
+    Time::Delay::wait(0.3);
+    dispatch(bus, 0x10, 1);
+    test.boolean("minimum interval expires", lim.count == 4);
+  }
+
+  {
+    Bus bus;
+    Counter all;
+    Slow slow;
+
+    bus.registerRecipient(&all, DUNE_IMC_TEMPERATURE);
+    bus.registerRecipient(&all, DUNE_IMC_SERVOPOSITION);
+    bus.unregisterRecipient(&all);
+    dispatch(bus, 0x10, 1);
+    ServoPosition pos;
+    bus.dispatch(&pos);
+    test.boolean("unregistered from all messages", all.count == 0);
+
+    bus.registerRecipient(&slow, DUNE_IMC_TEMPERATURE);
+    Dispatcher thread(bus);
+    thread.start();
+    Time::Delay::wait(0.05);
+    bus.unregisterRecipient(&slow);
+    bus.synchronize();
+    test.boolean("synchronize waits for dispatches", slow.done);
+    thread.stopAndJoin();
+  }
+
+  return test.getReturnValue();
+}
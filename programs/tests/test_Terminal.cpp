@@ -0,0 +1,132 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+#include <DUNE/Streams/Terminal.hpp>
+#include <DUNE/Utils/String.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Number of writer threads.
+static const unsigned c_writers = 4;
+//! Number of messages written by each thread.
+static const unsigned c_messages = 50;
+//! Output file.
+static const char* c_file = "test_Terminal.txt";
+
+class Writer: public Concurrency::Thread
+{
+public:
+  Writer(Streams::Terminal& term, unsigned id):
+    m_term(term),
+    m_name("Writer " + Utils::String::str(id))
+  { }
+
+private:
+  Streams::Terminal& m_term;
+  std::string m_name;
+
+  void
+  run(void)
+  {
+    for (unsigned i = 0; i < c_messages; ++i)
+      m_term.write(Streams::Terminal::LEVEL_MSG, m_name, Utils::String::str("message %u", i).c_str());
+  }
+};
+
+//! Count the lines of the output file written by a given module.
+static unsigned
+countLines(const std::string& module)
+{
+  std::ifstream ifs(c_file);
+  std::string line;
+  unsigned count = 0;
+
+  while (std::getline(ifs, line))
+  {
+    if (line.find("[" + module + "]") != std::string::npos)
+      ++count;
+  }
+
+  return count;
+}
+
+int
+main(void)
+{
+  Test test("Streams::Terminal");
+
+  {
+    Streams::Terminal term;
+    term.open(c_file);
+    term.write(Streams::Terminal::LEVEL_WRN, "Sync", "synchronous message");
+    term.close();
+    test.boolean("write() (synchronous)", countLines("Sync") == 1);
+  }
+
+  {
+    Streams::Terminal term;
+    term.open(c_file);
+    term.startAsync(c_writers * c_messages);
+
+    std::vector<Writer*> writers;
+    for (unsigned i = 0; i < c_writers; ++i)
+    {
+      writers.push_back(new Writer(term, i));
+      writers.back()->start();
+    }
+
+    for (unsigned i = 0; i < writers.size(); ++i)
+    {
+      writers[i]->join();
+      delete writers[i];
+    }
+
+    term.stopAsync();
+    term.close();
+
+    bool all = true;
+    for (unsigned i = 0; i < c_writers; ++i)
+      all = all && countLines("Writer " + Utils::String::str(i)) == c_messages;
+
+    test.boolean("write() (asynchronous)", all);
+  }
+
+  std::remove(c_file);
+
+  return test.getReturnValue();
+}
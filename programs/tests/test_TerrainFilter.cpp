@@ -0,0 +1,160 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Navigation/TerrainFilter.hpp>
+#include <DUNE/Math.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Navigation::TerrainFilter;
+using DUNE::Simulation::GriddedField;
+
+//! Path of the synthetic bathymetry map.
+static const char* c_map = "/tmp/dune_test_terrain_filter.grd";
+
+//! Synthetic seabed depth.
+static double
+seabed(double x, double y)
+{
+  return 50.0 + 4.0 * std::sin(x / 11.0) + 3.0 * std::cos(y / 7.0) + 2.0 * std::sin((x + 2.0 * y) / 17.0);
+}
+
+//! Write a 200 m x 200 m map with 1 m cells.
+static void
+writeMap(void)
+{
+  GriddedField::Layout layout;
+  layout.nx = 200;
+  layout.ny = 200;
+  layout.nz = 1;
+  layout.tile = 64;
+  layout.lat = 0.0;
+  layout.lon = 0.0;
+  layout.x0 = 0.0;
+  layout.y0 = 0.0;
+  layout.z0 = 0.0;
+  layout.dx = 1.0;
+  layout.dy = 1.0;
+  layout.dz = 1.0;
+
+  std::vector<float> values(layout.nx * layout.ny);
+  for (unsigned j = 0; j < layout.ny; ++j)
+  {
+    for (unsigned i = 0; i < layout.nx; ++i)
+      values[j * layout.nx + i] = (float)seabed(i, j);
+  }
+
+  GriddedField::write(c_map, layout, &values[0]);
+}
+
+//! Navigate along a straight line and return the final error.
+static double
+navigate(TerrainFilter& filter, unsigned steps, DUNE::Math::Random::Generator* gen)
+{
+  // Four DVL beams at 30 degrees and an altimeter, 10 m above the
+  // seabed.
+  double range = 10.0;
+  double s = range * std::sin(DUNE::Math::Angles::radians(30));
+  double offsets[5][2] = {{s, 0}, {-s, 0}, {0, s}, {0, -s}, {0, 0}};
+
+  double x = 60.0;
+  double y = 60.0;
+
+  filter.initialize(x + 6.0, y - 6.0, 8.0);
+
+  for (unsigned k = 0; k < steps; ++k)
+  {
+    x += 1.0;
+    y += 0.5;
+    filter.predict(1.0, 0.5, 0.2);
+
+    double depth = seabed(x, y) - range;
+    TerrainFilter::Beam beams[5];
+    for (unsigned b = 0; b < 5; ++b)
+    {
+      beams[b].x = offsets[b][0];
+      beams[b].y = offsets[b][1];
+      beams[b].z = seabed(x + beams[b].x, y + beams[b].y) - depth + gen->gaussian() * 0.2;
+    }
+
+    filter.update(beams, 5, depth, 0.5);
+  }
+
+  double ex, ey, vx, vy;
+  filter.getEstimate(ex, ey, vx, vy);
+  return std::sqrt((ex - x) * (ex - x) + (ey - y) * (ey - y));
+}
+
+int
+main(void)
+{
+  Test test("Navigation::TerrainFilter");
+  DUNE::Math::Random::Generator* gen = DUNE::Math::Random::Factory::create(DUNE::Math::Random::Factory::c_default, 1);
+
+  writeMap();
+
+  {
+    TerrainFilter filter(c_map, 2000, 1, 1);
+    test.boolean("getSize()", filter.getSize() == 2000);
+    test.boolean("getLayout()", filter.getLayout().nx == 200);
+
+    filter.initialize(500.0, 500.0, 1.0);
+    TerrainFilter::Beam beam = {0.0, 0.0, 10.0};
+    test.boolean("update() (outside map)", !filter.update(&beam, 1, 40.0, 0.5));
+    test.boolean("update() (no beams)", !filter.update(&beam, 0, 40.0, 0.5));
+  }
+
+  {
+    TerrainFilter filter(c_map, 2000, 1, 1);
+    double error = navigate(filter, 60, gen);
+    test.boolean("converges (1 thread)", error < 2.0);
+    test.boolean("getResamplings()", filter.getResamplings() > 0);
+
+    double x, y, vx, vy;
+    filter.getEstimate(x, y, vx, vy);
+    test.boolean("getEstimate() (variance)", vx < 4.0 && vy < 4.0);
+  }
+
+  {
+    TerrainFilter filter(c_map, 2000, 3, 1);
+    double error = navigate(filter, 60, gen);
+    test.boolean("converges (3 threads)", error < 2.0);
+    test.boolean("getEffectiveSize()", filter.getEffectiveSize() > 0.0 && filter.getEffectiveSize() <= 2000.0);
+  }
+
+  std::remove(c_map);
+  delete gen;
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,164 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Compression/TimeSeriesChunk.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Compression;
+
+//! Decode a chunk and compare it with the original samples.
+static bool
+roundTrip(const TimeSeriesChunk& chunk, const std::vector<int64_t>& times,
+          const std::vector<double>& values)
+{
+  TimeSeriesChunk::Reader reader(chunk.getData(), chunk.getSize());
+  if (reader.getCount() != times.size())
+    return false;
+
+  int64_t t = 0;
+  double v = 0;
+  for (unsigned i = 0; i < times.size(); ++i)
+  {
+    if (!reader.next(t, v) || t != times[i])
+      return false;
+
+    // Compare bits, so that NaN matches.
+    if (std::memcmp(&v, &values[i], sizeof(v)) != 0)
+      return false;
+  }
+
+  return !reader.next(t, v);
+}
+
+int
+main(void)
+{
+  Test test("TimeSeriesChunk");
+
+  {
+    TimeSeriesChunk chunk;
+    std::vector<int64_t> times;
+    std::vector<double> values;
+    test.boolean("empty", roundTrip(chunk, times, values));
+  }
+
+  {
+    // Regular 10 Hz depth-like signal.
+    TimeSeriesChunk chunk;
+    std::vector<int64_t> times;
+    std::vector<double> values;
+    for (unsigned i = 0; i < 3600; ++i)
+    {
+      times.push_back(1400000000000LL + i * 100);
+      values.push_back(std::floor(100 * (5.0 + std::sin(i * 0.001))) / 100);
+      chunk.append(times.back(), values.back());
+    }
+
+    test.boolean("regular round trip", roundTrip(chunk, times, values));
+    test.boolean("regular size", chunk.getSize() < times.size() * 4);
+    test.boolean("first/last", chunk.getFirstTime() == times.front()
+                 && chunk.getLastTime() == times.back()
+                 && chunk.getCount() == times.size());
+  }
+
+  {
+    // Irregular time stamps and values covering all encodings.
+    TimeSeriesChunk chunk;
+    std::vector<int64_t> times;
+    std::vector<double> values;
+    int64_t t = -5;
+    unsigned seed = 7;
+    double specials[] = {0.0, -0.0, 1e300, -1e-300,
+                         std::numeric_limits<double>::infinity(),
+                         std::numeric_limits<double>::quiet_NaN()};
+
+    for (unsigned i = 0; i < 5000; ++i)
+    {
+      seed = seed * 1103515245 + 12345;
+      unsigned r = (seed >> 8) % 5;
+      if (r == 1)
+        t += (seed >> 4) % 300;
+      else if (r == 2)
+        t += (seed >> 4) % 5000;
+      else if (r == 3)
+        t += ((int64_t)1 << 40) + seed;
+      else if (r == 4)
+        t -= (seed >> 4) % 100;
+
+      double v = 0;
+      if (i % 11 == 0)
+        v = specials[(i / 11) % 6];
+      else if (i % 3 == 0 && !values.empty())
+        v = values.back();
+      else
+        v = (double)(int)(seed >> 3) / 1024.0;
+
+      times.push_back(t);
+      values.push_back(v);
+      chunk.append(t, v);
+    }
+
+    test.boolean("irregular round trip", roundTrip(chunk, times, values));
+
+    chunk.shrink();
+    test.boolean("shrink", roundTrip(chunk, times, values));
+
+    // Truncated data is rejected.
+    bool rejected = false;
+    try
+    {
+      TimeSeriesChunk::Reader reader(chunk.getData(), chunk.getSize() / 2);
+      int64_t rt = 0;
+      double rv = 0;
+      while (reader.next(rt, rv))
+      { }
+    }
+    catch (CorruptedData& e)
+    {
+      rejected = true;
+    }
+    test.boolean("truncated", rejected);
+
+    chunk.clear();
+    chunk.append(10, 1.5);
+    times.assign(1, 10);
+    values.assign(1, 1.5);
+    test.boolean("clear", roundTrip(chunk, times, values));
+  }
+
+  return test.getReturnValue();
+}
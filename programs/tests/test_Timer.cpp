@@ -0,0 +1,102 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/IO.hpp>
+#include <DUNE/Time.hpp>
+#include <DUNE/Concurrency.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+int
+main(void)
+{
+  Test test("IO::Timer");
+
+  {
+    IO::Timer timer;
+    test.boolean("isRunning() (stopped)", !timer.isRunning());
+    test.boolean("acknowledge() (stopped)", timer.acknowledge() == 0);
+
+    timer.start(0.02);
+    test.boolean("isRunning()", timer.isRunning());
+    test.boolean("acknowledge() (early)", timer.acknowledge() == 0);
+
+    IO::Poll poll;
+    poll.add(timer);
+
+    unsigned count = 0;
+    for (unsigned i = 0; i < 10; ++i)
+    {
+      if (poll.poll(1.0) && poll.wasTriggered(timer))
+        count += timer.acknowledge();
+    }
+
+    test.boolean("poll()", count >= 10);
+    test.boolean("getExpirations()", timer.getExpirations() == count);
+    test.boolean("getOverruns()", timer.getOverruns() == count - 10);
+    test.boolean("getMaximumLatency()", timer.getMaximumLatency() < 0.02);
+    test.boolean("getAverageLatency()", timer.getAverageLatency() <= timer.getMaximumLatency());
+
+    // Miss three expirations.
+    timer.resetStatistics();
+    timer.acknowledge();
+    Time::Delay::waitSystem(0.07);
+    unsigned missed = timer.acknowledge();
+    test.boolean("acknowledge() (late)", missed >= 3);
+    test.boolean("getOverruns() (late)", timer.getOverruns() == missed - 1);
+
+    uint64_t value = 0;
+    Time::Delay::waitSystem(0.03);
+    test.boolean("read()", timer.read((uint8_t*)&value, sizeof(value)) == sizeof(value) && value >= 1);
+
+    timer.stop();
+    Time::Delay::waitSystem(0.05);
+    test.boolean("stop()", !poll.poll(0) && timer.acknowledge() == 0);
+  }
+
+  {
+    IO::Timer timer;
+    timer.start(10.0, 0.01);
+    test.boolean("start() (delay)", IO::Poll::poll(timer, 1.0) && timer.acknowledge() == 1);
+  }
+
+  {
+    Concurrency::Condition cond;
+    cond.lock();
+    uint64_t deadline = Time::Clock::getNsec() + 20000000;
+    bool rv = cond.waitUntilNsec(deadline);
+    uint64_t now = Time::Clock::getNsec();
+    cond.unlock();
+    test.boolean("Condition::waitUntilNsec()", !rv && now >= deadline);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,150 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency.hpp>
+#include <DUNE/IMC.hpp>
+#include <DUNE/Utils/String.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Number of writer threads.
+static const unsigned c_writers = 4;
+//! Number of records written by each thread.
+static const unsigned c_records = 20000;
+//! Dump file.
+static const char* c_file = "test_TraceRing.dtrc";
+
+class Writer: public Concurrency::Thread
+{
+public:
+  Writer(IMC::TraceRing& ring, uint8_t channel):
+    m_ring(ring),
+    m_channel(channel)
+  { }
+
+private:
+  IMC::TraceRing& m_ring;
+  uint8_t m_channel;
+
+  void
+  run(void)
+  {
+    IMC::Heartbeat msg;
+    for (unsigned i = 0; i < c_records; ++i)
+    {
+      // Source and destination always match in a complete record.
+      msg.setSource(i & 0xffff);
+      msg.setDestination(i & 0xffff);
+      m_ring.record(&msg, m_channel, IMC::TraceRing::DIR_OUT, i & 0xffff);
+    }
+  }
+};
+
+int
+main(void)
+{
+  Test test("IMC::TraceRing");
+
+  {
+    IMC::TraceRing ring(8);
+    uint8_t a = ring.getChannel("Task A");
+    uint8_t b = ring.getChannel("Task B");
+    test.boolean("getChannel()", a == 0 && b == 1 && ring.getChannel("Task A") == a);
+
+    IMC::EstimatedState msg;
+    msg.setSource(0x1234);
+    msg.setSourceEntity(7);
+    msg.setTimeStamp(10.0);
+    for (unsigned i = 0; i < 10; ++i)
+      ring.record(&msg, b, IMC::TraceRing::DIR_IN, i);
+
+    std::vector<IMC::TraceRing::Record> records(ring.capacity());
+    unsigned count = ring.copy(&records[0]);
+    const IMC::TraceRing::Record& r = records[0];
+    test.boolean("copy() (wraps)", count == 8 && r.size == 2 && records[7].size == 9);
+    test.boolean("copy() (header)", r.id == DUNE_IMC_ESTIMATEDSTATE && r.src == 0x1234
+                 && r.src_ent == 7 && r.msg_time == 10.0 && r.channel == b
+                 && r.direction == IMC::TraceRing::DIR_IN);
+
+    test.boolean("dump()", ring.dump(c_file));
+
+    std::ifstream ifs(c_file, std::ios::binary);
+    IMC::TraceRing::FileHeader hdr;
+    ifs.read((char*)&hdr, sizeof(hdr));
+    char names[2][IMC::TraceRing::c_channel_name_size];
+    ifs.read((char*)names, sizeof(names));
+    IMC::TraceRing::Record first;
+    ifs.read((char*)&first, sizeof(first));
+    test.boolean("dump() (contents)", ifs && std::memcmp(hdr.magic, "DTRC", 4) == 0
+                 && hdr.channels == 2 && hdr.records == 8
+                 && std::strcmp(names[1], "Task B") == 0 && first.size == 2);
+    std::remove(c_file);
+  }
+
+  {
+    IMC::TraceRing ring(1024);
+    std::vector<Writer*> writers;
+    for (unsigned i = 0; i < c_writers; ++i)
+    {
+      writers.push_back(new Writer(ring, ring.getChannel(Utils::String::str("Writer %u", i))));
+      writers.back()->start();
+    }
+
+    // Snapshots taken while writing must only hold complete records.
+    bool consistent = true;
+    std::vector<IMC::TraceRing::Record> records(ring.capacity());
+    while (ring.getCount() < c_writers * c_records)
+    {
+      unsigned count = ring.copy(&records[0]);
+      for (unsigned i = 0; i < count; ++i)
+      {
+        if (records[i].src != records[i].dst || records[i].src != records[i].size)
+          consistent = false;
+      }
+    }
+
+    for (unsigned i = 0; i < writers.size(); ++i)
+    {
+      writers[i]->join();
+      delete writers[i];
+    }
+
+    test.boolean("concurrent record()", consistent && ring.getCount() == c_writers * c_records);
+  }
+
+  return test.getReturnValue();
+}
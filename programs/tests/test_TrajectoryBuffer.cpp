@@ -0,0 +1,89 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Maneuvers::TrajectoryBuffer.                      *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Maneuvers/TrajectoryBuffer.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Maneuvers::TrajectoryBuffer;
+
+static TrajectoryBuffer::Point
+makePoint(double x, double t)
+{
+  TrajectoryBuffer::Point p;
+  p.x = x;
+  p.y = -x;
+  p.z = 0;
+  p.z_units = 0;
+  p.t = t;
+  return p;
+}
+
+int
+main(void)
+{
+  Test test("Maneuvers::TrajectoryBuffer");
+
+  TrajectoryBuffer buffer(4);
+
+  for (unsigned i = 0; i < 4; ++i)
+    buffer.push(makePoint(i * 10.0, i));
+
+  test.boolean("push() fails when full", !buffer.push(makePoint(40.0, 4)));
+  test.boolean("getFree()", buffer.getFree() == 0);
+
+  TrajectoryBuffer::Point p;
+  test.boolean("sample() interpolates",
+               buffer.sample(2.5, p) && std::fabs(p.x - 25.0) < 1e-9 && std::fabs(p.y + 25.0) < 1e-9);
+  test.boolean("sample() outside", !buffer.sample(3.5, p) && !buffer.sample(-1.0, p));
+
+  buffer.release(2);
+  test.boolean("release()", buffer.getFirst() == 2 && buffer.getEnd() == 4 && buffer.getFree() == 2);
+  test.boolean("contains()", !buffer.contains(1) && buffer.contains(2) && !buffer.contains(4));
+
+  buffer.push(makePoint(40.0, 4));
+  buffer.push(makePoint(50.0, 5));
+  test.boolean("push() after release", buffer.getEnd() == 6 && buffer.at(5).x == 50.0);
+  test.boolean("at() uses trajectory indices", buffer.at(2).x == 20.0 && buffer.at(4).t == 4);
+  test.boolean("sample() after wrap", buffer.sample(4.5, p) && std::fabs(p.x - 45.0) < 1e-9);
+
+  buffer.release(10);
+  test.boolean("release() all", buffer.getFirst() == 6 && buffer.getFree() == 4);
+
+  buffer.setComplete();
+  buffer.clear();
+  test.boolean("clear()", buffer.getFirst() == 0 && buffer.getEnd() == 0 && !buffer.isComplete());
+
+  return test.getReturnValue();
+}
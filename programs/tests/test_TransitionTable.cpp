@@ -0,0 +1,128 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Utils::TransitionTable class.                    *
+//***************************************************************************
+#include "Test.hpp"
+#include <DUNE/Utils/TransitionTable.hpp>
+using namespace DUNE::Utils;
+
+// Mock turnstile: a coin unlocks it, a push locks it again, and
+// pushes while locked are counted.
+class Turnstile
+{
+public:
+  enum State
+  {
+    LOCKED,
+    UNLOCKED,
+    STATE_COUNT
+  };
+
+  typedef TransitionTable<Turnstile, STATE_COUNT> Table;
+
+  Turnstile(void);
+
+  bool
+  gotCoin(void)
+  {
+    return coin;
+  }
+
+  bool
+  gotPush(void)
+  {
+    return push;
+  }
+
+  void
+  onUnlock(void)
+  {
+    ++unlocks;
+  }
+
+  void
+  onAlarm(void)
+  {
+    ++alarms;
+  }
+
+  bool
+  step(bool a_coin, bool a_push)
+  {
+    coin = a_coin;
+    push = a_push;
+    return m_table.step(*this);
+  }
+
+  unsigned
+  state(void) const
+  {
+    return m_table.current();
+  }
+
+  bool coin;
+  bool push;
+  unsigned alarms;
+  unsigned unlocks;
+
+private:
+  static const Table::Transition c_table[];
+  Table m_table;
+};
+
+// Rows are intentionally not sorted by source state.
+const Turnstile::Table::Transition Turnstile::c_table[] =
+{
+  {Turnstile::UNLOCKED, &Turnstile::gotPush, NULL, Turnstile::LOCKED},
+  {Turnstile::LOCKED, &Turnstile::gotCoin, &Turnstile::onUnlock, Turnstile::UNLOCKED},
+  {Turnstile::LOCKED, &Turnstile::gotPush, &Turnstile::onAlarm, Turnstile::LOCKED}
+};
+
+Turnstile::Turnstile(void):
+  coin(false),
+  push(false),
+  alarms(0),
+  unlocks(0),
+  m_table(c_table, sizeof(c_table) / sizeof(c_table[0]), LOCKED)
+{ }
+
+int
+main(void)
+{
+  Test test("DUNE::Utils::TransitionTable");
+
+  Turnstile t;
+  test.boolean("initial state", t.state() == Turnstile::LOCKED);
+  test.boolean("no guard holds", !t.step(false, false) && t.state() == Turnstile::LOCKED);
+  test.boolean("push while locked", t.step(false, true) && t.state() == Turnstile::LOCKED && t.alarms == 1);
+  test.boolean("coin unlocks", t.step(true, false) && t.state() == Turnstile::UNLOCKED && t.unlocks == 1);
+  test.boolean("coin while unlocked", !t.step(true, false) && t.state() == Turnstile::UNLOCKED && t.unlocks == 1);
+  test.boolean("push locks", t.step(false, true) && t.state() == Turnstile::LOCKED && t.alarms == 1);
+  test.boolean("first guard wins", t.step(true, true) && t.state() == Turnstile::UNLOCKED && t.alarms == 1);
+
+  return 0;
+}
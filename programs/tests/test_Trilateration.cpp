@@ -0,0 +1,126 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Navigation/Trilateration.hpp>
+#include <DUNE/Math.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Navigation::Trilateration;
+
+//! Distance between the solution and a point.
+static double
+error(const Trilateration& tri, double x, double y)
+{
+  return std::sqrt((tri.getX() - x) * (tri.getX() - x) + (tri.getY() - y) * (tri.getY() - y));
+}
+
+//! Feed ranges measured along a circle around the origin.
+static void
+feed(Trilateration& tri, double x, double y, double z, unsigned count, double noise,
+     unsigned outlier_period, DUNE::Math::Random::Generator* gen)
+{
+  for (unsigned i = 0; i < count; ++i)
+  {
+    double ax = 50.0 * std::cos(i * 0.3);
+    double ay = 50.0 * std::sin(i * 0.3);
+    double range = std::sqrt((x - ax) * (x - ax) + (y - ay) * (y - ay) + z * z);
+    range += gen->gaussian() * noise;
+
+    if (outlier_period && (i % outlier_period) == 0)
+      range += 40.0;
+
+    tri.add(ax, ay, 0.0, range);
+  }
+}
+
+int
+main(void)
+{
+  Test test("Navigation::Trilateration");
+  DUNE::Math::Random::Generator* gen = DUNE::Math::Random::Factory::create(DUNE::Math::Random::Factory::c_default, 1);
+
+  {
+    Trilateration tri(16);
+    tri.setDepth(10.0);
+    test.boolean("add() (not enough ranges)", !tri.add(0.0, 0.0, 0.0, 10.0));
+    test.boolean("getSize()", tri.getSize() == 1);
+    test.boolean("hasSolution()", !tri.hasSolution());
+  }
+
+  {
+    Trilateration tri(16);
+    tri.setDepth(10.0);
+    feed(tri, 12.0, -7.0, 10.0, 40, 0.0, 0, gen);
+    test.boolean("exact ranges", error(tri, 12.0, -7.0) < 1e-3);
+    test.boolean("window size", tri.getSize() == 16);
+  }
+
+  {
+    Trilateration tri(32);
+    tri.setDepth(10.0);
+    feed(tri, 12.0, -7.0, 10.0, 64, 0.5, 0, gen);
+    test.boolean("noisy ranges", error(tri, 12.0, -7.0) < 0.5);
+    test.boolean("variance", tri.getVarianceX() > 0 && tri.getVarianceX() < 1.0
+                 && tri.getVarianceY() > 0 && tri.getVarianceY() < 1.0);
+  }
+
+  {
+    Trilateration tri(32);
+    tri.setDepth(10.0);
+    tri.setLossScale(2.0);
+    feed(tri, 12.0, -7.0, 10.0, 64, 0.5, 5, gen);
+    test.boolean("outliers (robust loss)", error(tri, 12.0, -7.0) < 1.0);
+
+    Trilateration naive(32);
+    naive.setDepth(10.0);
+    naive.setLossScale(1e9);
+    feed(naive, 12.0, -7.0, 10.0, 64, 0.5, 5, gen);
+    test.boolean("outliers (quadratic loss)", error(naive, 12.0, -7.0) > error(tri, 12.0, -7.0));
+  }
+
+  {
+    Trilateration tri(32);
+    tri.setDepth(10.0);
+    feed(tri, 12.0, -7.0, 10.0, 200, 0.1, 0, gen);
+    test.boolean("cached Jacobian", tri.getRelinearizations() < 50);
+    test.boolean("getExpectedRange()", std::fabs(tri.getExpectedRange(12.0, -7.0, 0.0) - 10.0) < 0.5);
+
+    tri.reset(0.0, 0.0);
+    test.boolean("reset()", tri.getSize() == 0 && !tri.hasSolution()
+                 && tri.getX() == 0.0 && tri.getY() == 0.0);
+  }
+
+  delete gen;
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,104 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Simulation::UAVFleet.                             *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/Constants.hpp>
+#include <DUNE/Simulation/UAVFleet.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Simulation::UAVFleet;
+
+int
+main(void)
+{
+  Test test("DUNE::Simulation::UAVFleet");
+
+  // Coordinated turn: a full circle brings the vehicle back.
+  const double va = 18.0;
+  const double bank = 0.4;
+  const double period = DUNE::Math::c_two_pi * va / (DUNE::Math::c_gravity * std::tan(bank));
+  const unsigned steps = 2000;
+
+  UAVFleet fleet(3);
+  fleet.setIntegrator(UAVFleet::INT_RK4);
+  for (unsigned i = 0; i < fleet.size(); ++i)
+  {
+    fleet.setState(i, 100.0 * i, 0, -50, bank, 0, va);
+    fleet.command(i, bank, va, 50);
+  }
+  fleet.run(period / steps, steps);
+
+  bool circle = true;
+  for (unsigned i = 0; i < fleet.size(); ++i)
+  {
+    double p[6];
+    fleet.getPosition(i, p);
+    circle = circle && std::fabs(p[0] - 100.0 * i) < 1e-3 && std::fabs(p[1]) < 1e-3;
+  }
+  test.boolean("RK4 closes a coordinated turn", circle);
+  test.boolean("getTime()", std::fabs(fleet.getTime() - period) < 1e-9);
+
+  // First-order responses converge to the commands.
+  bool converge = true;
+  for (int k = 0; k < 3; ++k)
+  {
+    UAVFleet f(1);
+    f.setIntegrator((UAVFleet::Integrator)k);
+    f.setTimeConstants(0, 1.0, 3.0, 5.0);
+    f.setLimits(0, 0.5, 1.0, 0.2);
+    f.setState(0, 0, 0, -100, 0, 0, 15);
+    f.command(0, 0.2, 20, 150);
+    f.run(0.05, 4000);
+
+    double p[6];
+    double v[6];
+    f.getPosition(0, p);
+    f.getVelocity(0, v);
+    converge = converge && std::fabs(p[2] + 150) < 0.01 && std::fabs(p[3] - 0.2) < 1e-6
+      && std::fabs(f.getAirspeed(0) - 20) < 1e-6 && std::fabs(v[2]) < 0.01;
+  }
+  test.boolean("Euler, semi-implicit and RK4 converge to commands", converge);
+
+  // Wind drifts the vehicle.
+  UAVFleet w(1);
+  w.setWind(2, -1, 0);
+  w.setState(0, 0, 0, 0, 0, 0, 10);
+  w.command(0, 0, 10, 0);
+  w.run(0.1, 100);
+  double p[6];
+  w.getPosition(0, p);
+  test.boolean("Wind", std::fabs(p[0] - 120) < 1e-6 && std::fabs(p[1] + 10) < 1e-6);
+
+  return test.getReturnValue();
+}
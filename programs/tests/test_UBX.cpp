@@ -0,0 +1,193 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Math/Angles.hpp>
+#include <DUNE/Parsers/UBX.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Parsers::UBX;
+
+//! Store a little-endian value in a payload.
+template <typename T>
+static void
+put(std::vector<uint8_t>& payload, unsigned offset, T value)
+{
+  for (unsigned i = 0; i < sizeof(T); ++i)
+    payload[offset + i] = (uint8_t)((uint64_t)value >> (8 * i));
+}
+
+//! Build a UBX frame.
+static std::vector<uint8_t>
+frame(uint8_t id, const std::vector<uint8_t>& payload)
+{
+  std::vector<uint8_t> frm;
+  frm.push_back(UBX::c_sync0);
+  frm.push_back(UBX::c_sync1);
+  frm.push_back(UBX::CLS_NAV);
+  frm.push_back(id);
+  frm.push_back(payload.size() & 0xff);
+  frm.push_back(payload.size() >> 8);
+  frm.insert(frm.end(), payload.begin(), payload.end());
+
+  uint8_t ck_a = 0;
+  uint8_t ck_b = 0;
+  for (unsigned i = 2; i < frm.size(); ++i)
+  {
+    ck_a += frm[i];
+    ck_b += ck_a;
+  }
+
+  frm.push_back(ck_a);
+  frm.push_back(ck_b);
+  return frm;
+}
+
+//! Build a NAV-PVT frame.
+static std::vector<uint8_t>
+pvt(uint32_t itow, uint8_t fix_type)
+{
+  std::vector<uint8_t> p(92, 0);
+  put<uint32_t>(p, 0, itow);
+  put<uint16_t>(p, 4, 2014);
+  p[6] = 7;
+  p[7] = 21;
+  p[8] = 10;
+  p[9] = 30;
+  p[10] = 15;
+  p[11] = 0x03;
+  put<int32_t>(p, 16, 250000000);
+  p[20] = fix_type;
+  p[21] = 0x03;
+  p[23] = 11;
+  put<int32_t>(p, 24, -87000000);
+  put<int32_t>(p, 28, 411800000);
+  put<int32_t>(p, 32, 55250);
+  put<uint32_t>(p, 40, 1500);
+  put<uint32_t>(p, 44, 2500);
+  put<int32_t>(p, 60, 1200);
+  put<int32_t>(p, 64, 9000000);
+  return frame(UBX::NAV_PVT, p);
+}
+
+//! Build a NAV-DOP frame.
+static std::vector<uint8_t>
+dop(uint32_t itow)
+{
+  std::vector<uint8_t> p(18, 0);
+  put<uint32_t>(p, 0, itow);
+  put<uint16_t>(p, 10, 180);
+  put<uint16_t>(p, 12, 95);
+  return frame(UBX::NAV_DOP, p);
+}
+
+//! Build a NAV-EOE frame.
+static std::vector<uint8_t>
+eoe(uint32_t itow)
+{
+  std::vector<uint8_t> p(4, 0);
+  put<uint32_t>(p, 0, itow);
+  return frame(UBX::NAV_EOE, p);
+}
+
+//! Decode a frame and add it to the decoder.
+static bool
+add(UBX& ubx, const std::vector<uint8_t>& frm)
+{
+  UBX::Frame f;
+  if (!UBX::decode(&frm[0], frm.size(), f))
+    return false;
+
+  return ubx.add(f);
+}
+
+static bool
+near(double a, double b, double tol)
+{
+  return std::fabs(a - b) < tol;
+}
+
+int
+main(void)
+{
+  Test test("Parsers::UBX");
+
+  {
+    std::vector<uint8_t> frm = pvt(1000, UBX::FIX_3D);
+    UBX::Frame f;
+    test.boolean("frame size from header", UBX::getFrameSize(&frm[0], 6) == frm.size());
+    test.boolean("incomplete header", UBX::getFrameSize(&frm[0], 5) == 0);
+    test.boolean("valid frame", UBX::decode(&frm[0], frm.size(), f)
+                 && f.id == UBX::NAV_PVT && f.size == 92 && f.payload == &frm[6]);
+
+    frm[20] ^= 0x01;
+    test.boolean("bad checksum", !UBX::decode(&frm[0], frm.size(), f));
+    test.boolean("truncated frame", !UBX::decode(&frm[0], frm.size() - 1, f));
+  }
+
+  {
+    UBX ubx;
+    bool done = add(ubx, pvt(2000, UBX::FIX_3D));
+    done = done || add(ubx, dop(2000));
+    test.boolean("epoch pending until end of epoch", !done);
+    test.boolean("end of epoch completes solution", add(ubx, eoe(2000)));
+
+    const UBX::Solution& sol = ubx.getSolution();
+    test.boolean("solution aggregates PVT and DOP", sol.has_pvt && sol.has_dop && sol.itow == 2000);
+    test.boolean("date", sol.valid_date && sol.year == 2014 && sol.month == 7 && sol.day == 21);
+    test.boolean("time", sol.valid_time && near(sol.utc_time, 37815.25, 1e-6));
+    test.boolean("fix", sol.fix_ok && sol.differential && sol.fix_type == UBX::FIX_3D && sol.satellites == 11);
+    test.boolean("position",
+                 near(sol.lat, DUNE::Math::Angles::radians(41.18), 1e-9)
+                 && near(sol.lon, DUNE::Math::Angles::radians(-8.7), 1e-9)
+                 && near(sol.height, 55.25, 1e-6));
+    test.boolean("accuracy", near(sol.hacc, 1.5, 1e-6) && near(sol.vacc, 2.5, 1e-6));
+    test.boolean("velocity", near(sol.sog, 1.2, 1e-6) && near(sol.cog, M_PI / 2, 1e-6));
+    test.boolean("dilution of precision", near(sol.hdop, 0.95, 1e-6) && near(sol.vdop, 1.8, 1e-6));
+
+    test.boolean("late frame is ignored", !add(ubx, dop(2000)) && !add(ubx, eoe(2000)));
+  }
+
+  {
+    UBX ubx;
+    add(ubx, pvt(3000, UBX::FIX_2D));
+    test.boolean("new epoch completes previous one", add(ubx, pvt(3200, UBX::FIX_3D)));
+    test.boolean("previous epoch is reported",
+                 ubx.getSolution().itow == 3000 && ubx.getSolution().fix_type == UBX::FIX_2D
+                 && !ubx.getSolution().has_dop);
+    test.boolean("end of epoch after new epoch",
+                 add(ubx, eoe(3200)) && ubx.getSolution().itow == 3200);
+  }
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,232 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <stdexcept>
+
+// POSIX headers.
+#include <unistd.h>
+
+// DUNE headers.
+#include <DUNE/IO.hpp>
+#include <DUNE/Hardware/UCTK/Interface.hpp>
+#include <DUNE/Hardware/UCTK/Parser.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using namespace DUNE::Hardware;
+
+//! Unsolicited frame identifier.
+static const uint8_t c_event_id = 0x50;
+
+//! Microcontroller answering each request with its payload
+//! incremented by one. Replies are written to a pipe.
+class FakeMCU: public IO::Handle
+{
+public:
+  FakeMCU(void):
+    writes(0),
+    error(false)
+  {
+    if (pipe(m_fds) != 0)
+      throw std::runtime_error("failed to create pipe");
+  }
+
+  ~FakeMCU(void)
+  {
+    ::close(m_fds[0]);
+    ::close(m_fds[1]);
+  }
+
+  //! Write a frame to the pipe.
+  void
+  reply(UCTK::Frame& frame)
+  {
+    frame.computeCRC();
+    if (::write(m_fds[1], frame.getData(), frame.getSize()) < 0)
+      throw std::runtime_error("failed to write to pipe");
+  }
+
+  //! Number of writes.
+  unsigned writes;
+  //! Answer with an error frame.
+  bool error;
+
+private:
+  int m_fds[2];
+  UCTK::Parser m_parser;
+  UCTK::Frame m_frame;
+
+  IO::NativeHandle
+  doGetNative(void) const
+  {
+    return m_fds[0];
+  }
+
+  size_t
+  doWrite(const uint8_t* data, size_t data_size)
+  {
+    ++writes;
+
+    // Announce an event before answering.
+    UCTK::Frame event;
+    event.setId(c_event_id);
+    event.setPayloadSize(0);
+    reply(event);
+
+    for (size_t i = 0; i < data_size; ++i)
+    {
+      if (!m_parser.parse(data[i], m_frame))
+        continue;
+
+      if (error)
+      {
+        m_frame.setId(UCTK::PKT_ID_ERR);
+        m_frame.setPayloadSize(1);
+        m_frame.set<uint8_t>(0, 0);
+      }
+      else
+      {
+        for (unsigned j = 0; j < m_frame.getPayloadSize(); ++j)
+          m_frame.setPayload(m_frame.getPayload()[j] + 1, j);
+      }
+
+      reply(m_frame);
+    }
+
+    return data_size;
+  }
+
+  size_t
+  doRead(uint8_t* data, size_t data_size)
+  {
+    ssize_t rv = ::read(m_fds[0], data, data_size);
+    return (rv < 0) ? 0 : rv;
+  }
+};
+
+//! Fill a request frame.
+static void
+request(UCTK::Frame& frame, uint8_t id, uint8_t value)
+{
+  frame.setId(id);
+  frame.setPayloadSize(1);
+  frame.set(value, 0);
+}
+
+int
+main(void)
+{
+  Test test("Hardware::UCTK::Interface");
+
+  FakeMCU mcu;
+  UCTK::Interface itf(&mcu);
+
+  {
+    UCTK::Frame frame;
+    request(frame, 1, 10);
+    uint8_t value = 0;
+    bool rv = itf.sendFrame(frame, 1.0);
+    frame.get(value, 0);
+    test.boolean("single request", rv && frame.getId() == 1 && value == 11);
+  }
+
+  {
+    UCTK::Frame frames[3];
+    request(frames[0], 2, 20);
+    request(frames[1], 3, 30);
+    request(frames[2], 2, 40);
+    mcu.writes = 0;
+
+    bool rv = itf.sendFrames(frames, 3, 1.0);
+    uint8_t a = 0, b = 0, c = 0;
+    frames[0].get(a, 0);
+    frames[1].get(b, 0);
+    frames[2].get(c, 0);
+    test.boolean("batched requests are written at once", rv && mcu.writes == 1);
+    test.boolean("replies are matched in order", a == 21 && b == 31 && c == 41);
+  }
+
+  {
+    UCTK::Frame frames[UCTK::Interface::c_max_batch + 2];
+    for (unsigned i = 0; i < UCTK::Interface::c_max_batch + 2; ++i)
+      request(frames[i], 4, i);
+    mcu.writes = 0;
+
+    bool rv = itf.sendFrames(frames, UCTK::Interface::c_max_batch + 2, 1.0);
+    uint8_t last = 0;
+    frames[UCTK::Interface::c_max_batch + 1].get(last, 0);
+    test.boolean("large batches are split", rv && mcu.writes == 2
+                 && last == UCTK::Interface::c_max_batch + 2);
+  }
+
+  {
+    unsigned events = 0;
+    UCTK::Frame frame;
+    while (itf.pop(frame))
+    {
+      if (frame.getId() == c_event_id)
+        ++events;
+    }
+    test.boolean("unsolicited frames are queued", events == 4);
+  }
+
+  {
+    // More events than the pool holds: the oldest are discarded.
+    UCTK::Frame frame;
+    for (unsigned i = 0; i < UCTK::Interface::c_pool_size + 4; ++i)
+    {
+      request(frame, 5, 0);
+      itf.sendFrame(frame, 1.0);
+    }
+
+    unsigned events = 0;
+    while (itf.pop(frame))
+      ++events;
+    test.boolean("queue is bounded by the pool", events == UCTK::Interface::c_pool_size);
+  }
+
+  {
+    mcu.error = true;
+    UCTK::Frame frame;
+    request(frame, 6, 0);
+    bool thrown = false;
+    try
+    {
+      itf.sendFrame(frame, 1.0);
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+    test.boolean("error replies throw", thrown);
+  }
+
+  return test.getReturnValue();
+}
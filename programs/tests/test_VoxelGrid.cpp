@@ -0,0 +1,117 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Navigation/VoxelGrid.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Navigation::VoxelGrid;
+
+static bool
+near(double a, double b, double tol = 1e-9)
+{
+  return std::fabs(a - b) <= tol;
+}
+
+int
+main(void)
+{
+  Test test("Navigation::VoxelGrid");
+
+  {
+    VoxelGrid grid(1.0);
+    double depth = 0;
+    test.boolean("empty grid", grid.getVoxels() == 0 && !grid.getDepth(0.0, 0.0, depth));
+
+    grid.add(0.2, 0.3, 10.1);
+    grid.add(0.8, 0.5, 10.7);
+    grid.add(-0.5, 0.5, 12.0);
+    test.boolean("voxels", grid.getVoxels() == 2);
+    test.boolean("column depth", grid.getDepth(0.5, 0.5, depth) && near(depth, 10.4));
+    test.boolean("negative cell", grid.getDepth(-0.1, 0.9, depth) && near(depth, 12.0));
+
+    std::vector<VoxelGrid::Point> pts;
+    test.boolean("changed", grid.getChanged() == 2);
+    test.boolean("take changed", grid.takeChanged(pts, 10) == 2 && grid.getChanged() == 0);
+
+    bool centroid = false;
+    for (size_t i = 0; i < pts.size(); ++i)
+    {
+      if (pts[i].count == 2)
+        centroid = near(pts[i].x, 0.5) && near(pts[i].y, 0.4) && near(pts[i].z, 10.4);
+    }
+    test.boolean("centroid", centroid);
+
+    pts.clear();
+    grid.add(0.1, 0.1, 10.2);
+    test.boolean("incremental changes", grid.takeChanged(pts, 10) == 1 && pts[0].count == 3);
+  }
+
+  {
+    // Dense swaths over a sloping seafloor.
+    VoxelGrid grid(2.0);
+    unsigned points = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+      for (int j = -50; j < 50; ++j)
+      {
+        grid.add(i * 0.5, j * 0.5, 30.0 + i * 0.01);
+        ++points;
+      }
+    }
+
+    test.boolean("decimation", grid.getVoxels() < points / 10);
+
+    double depth = 0;
+    test.boolean("bathymetry query", grid.getDepth(51.0, 3.0, depth) && std::fabs(depth - 31.0) < 0.05);
+
+    std::vector<VoxelGrid::Point> all;
+    grid.getPoints(all);
+    test.boolean("all points", all.size() == grid.getVoxels());
+
+    unsigned total = 0;
+    std::vector<VoxelGrid::Point> pts;
+    while (grid.takeChanged(pts, 100) > 0)
+      total = pts.size();
+    test.boolean("changes in batches", total == grid.getVoxels());
+  }
+
+  {
+    VoxelGrid grid(1.0, 2);
+    test.boolean("first voxel", grid.add(0.5, 0.5, 0.5));
+    test.boolean("second voxel", grid.add(1.5, 0.5, 0.5));
+    test.boolean("grid full", !grid.add(2.5, 0.5, 0.5) && grid.add(0.6, 0.6, 0.6));
+  }
+
+  return test.getReturnValue();
+}
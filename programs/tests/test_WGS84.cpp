@@ -0,0 +1,129 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Coordinates::WGS84.                               *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Coordinates/WGS84.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Coordinates::WGS84;
+
+static double
+uniform(double lo, double hi)
+{
+  return lo + (hi - lo) * (std::rand() / (double)RAND_MAX);
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Coordinates::WGS84");
+
+  std::srand(3);
+
+  // Zero offsets must convert to ECEF and back to the same point.
+  bool round_trip = true;
+  for (unsigned i = 0; i < 10000; ++i)
+  {
+    double lat = uniform(-1.55, 1.55);
+    double lon = uniform(-3.1, 3.1);
+    double hae = uniform(-10000.0, 10000.0);
+    double n = 0.0;
+    double e = 0.0;
+    double d = 0.0;
+    double rlat;
+    double rlon;
+    double rhae;
+
+    WGS84::displace(lat, lon, hae, 1, &n, &e, &d, &rlat, &rlon, &rhae);
+    round_trip = round_trip
+    && std::fabs(rlat - lat) * 6.4e6 < 1e-6
+    && std::fabs(rlon - lon) * 6.4e6 < 1e-6
+    && std::fabs(rhae - hae) < 1e-6;
+  }
+
+  test.boolean("closed-form fromECEF() inverts toECEF()", round_trip);
+
+  // Batch routines must match the scalar ones.
+  const unsigned count = 1000;
+  double rlat = 0.7188;
+  double rlon = -0.1512;
+  double rhae = 12.0;
+  std::vector<double> n(count), e(count), d(count);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    n[i] = uniform(-5000.0, 5000.0);
+    e[i] = uniform(-5000.0, 5000.0);
+    d[i] = uniform(-100.0, 100.0);
+  }
+
+  std::vector<double> lat(count), lon(count), hae(count);
+  WGS84::displace(rlat, rlon, rhae, count, &n[0], &e[0], &d[0], &lat[0], &lon[0], &hae[0]);
+
+  bool displace = true;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    double slat = rlat;
+    double slon = rlon;
+    double shae = rhae;
+    WGS84::displace(n[i], e[i], d[i], &slat, &slon, &shae);
+    displace = displace
+    && std::fabs(slat - lat[i]) < 1e-12
+    && std::fabs(slon - lon[i]) < 1e-12
+    && std::fabs(shae - hae[i]) < 1e-6;
+  }
+
+  test.boolean("batch displace() matches displace()", displace);
+
+  std::vector<double> bn(count), be(count), bd(count);
+  WGS84::displacement(rlat, rlon, rhae, count, &lat[0], &lon[0], &hae[0], &bn[0], &be[0], &bd[0]);
+
+  bool displacement = true;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    double sn;
+    double se;
+    double sd;
+    WGS84::displacement(rlat, rlon, rhae, lat[i], lon[i], hae[i], &sn, &se, &sd);
+    displacement = displacement
+    && std::fabs(sn - bn[i]) < 1e-6
+    && std::fabs(se - be[i]) < 1e-6
+    && std::fabs(sd - bd[i]) < 1e-6;
+  }
+
+  test.boolean("batch displacement() matches displacement()", displacement);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,119 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Test program for DUNE::Math::WindowedStatistics.                         *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Math/MovingAverage.hpp>
+#include <DUNE/Math/MultiMovingAverage.hpp>
+#include <DUNE/Math/WindowedStatistics.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Math;
+
+static bool
+close(double a, double b)
+{
+  return std::fabs(a - b) < 1e-9 * (1.0 + std::fabs(b));
+}
+
+int
+main(void)
+{
+  Test test("DUNE::Math::WindowedStatistics");
+
+  std::srand(11);
+
+  const unsigned window = 37;
+  WindowedStatistics<double> ws(window);
+  MovingAverage<double> ma(window);
+  std::vector<unsigned> sizes;
+  sizes.push_back(5);
+  sizes.push_back(window);
+  sizes.push_back(12);
+  MultiMovingAverage<double> mma(sizes);
+
+  std::vector<double> samples;
+  bool stats = true;
+  bool extrema = true;
+  bool average = true;
+  bool multi = true;
+
+  for (unsigned k = 0; k < 2000; ++k)
+  {
+    // Drifting signal with runs of equal values.
+    double v = (k % 50 < 10) ? 3.0 : 100.0 * std::rand() / RAND_MAX + 0.01 * k;
+    samples.push_back(v);
+    ws.update(v);
+    ma.update(v);
+    mma.update(v);
+
+    unsigned first = samples.size() > window ? samples.size() - window : 0;
+    double n = samples.size() - first;
+    double mean = 0;
+    double var = 0;
+    for (unsigned i = first; i < samples.size(); ++i)
+      mean += samples[i] / n;
+    for (unsigned i = first; i < samples.size(); ++i)
+      var += (samples[i] - mean) * (samples[i] - mean) / n;
+
+    double mn = *std::min_element(samples.begin() + first, samples.end());
+    double mx = *std::max_element(samples.begin() + first, samples.end());
+
+    stats = stats && close(ws.mean(), mean) && std::fabs(ws.variance() - var) < 1e-7 * (1.0 + var);
+    extrema = extrema && ws.minimum() == mn && ws.maximum() == mx;
+    average = average && close(ma.mean(), mean) && ma.sampleSize() == n;
+
+    for (unsigned j = 0; j < sizes.size(); ++j)
+    {
+      unsigned f = samples.size() > sizes[j] ? samples.size() - sizes[j] : 0;
+      double m = 0;
+      for (unsigned i = f; i < samples.size(); ++i)
+        m += samples[i];
+      m /= samples.size() - f;
+      multi = multi && close(mma.mean(j), m);
+    }
+  }
+
+  test.boolean("mean() and variance() match the window", stats);
+  test.boolean("minimum() and maximum() match the window", extrema);
+  test.boolean("MovingAverage matches the window", average);
+  test.boolean("MultiMovingAverage matches each window", multi);
+
+  ws.clear();
+  test.boolean("clear()", ws.sampleSize() == 0 && ws.mean() == 0 && ws.stdev() == 0);
+
+  return test.getReturnValue();
+}
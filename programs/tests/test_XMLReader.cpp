@@ -0,0 +1,140 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Utils/Exceptions.hpp>
+#include <DUNE/Utils/XMLReader.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using DUNE::Utils::ParseError;
+using DUNE::Utils::XMLReader;
+
+//! Records parsing events as text.
+class Recorder: public XMLReader::Handler
+{
+public:
+  std::string events;
+
+  void
+  onStartElement(const std::string& name, const XMLReader::Attributes& attrs)
+  {
+    events += "<" + name;
+    for (size_t i = 0; i < attrs.size(); ++i)
+      events += " " + attrs[i].first + "=" + attrs[i].second;
+    events += ">";
+  }
+
+  void
+  onEndElement(const std::string& name)
+  {
+    events += "</" + name + ">";
+  }
+
+  void
+  onText(const std::string& text)
+  {
+    events += "[" + text + "]";
+  }
+};
+
+static const char* c_document =
+  "<?xml version=\"1.0\"?>\n"
+  "<!DOCTYPE messages>\n"
+  "<messages version='5.4'><!-- a > b -->"
+  "<message id=\"1\" name=\"A &amp; B\" note='x>y'>"
+  "t&lt;1&#65;<field abbrev=\"f\" /><![CDATA[<raw&>]]></message >"
+  "</messages>\n";
+
+static const char* c_events =
+  "<messages version=5.4>"
+  "<message id=1 name=A & B note=x>y>"
+  "[t<1A]<field abbrev=f></field>[<raw&>]</message>"
+  "</messages>";
+
+//! Parse a document in chunks of a given size.
+static std::string
+parse(const std::string& xml, size_t chunk)
+{
+  Recorder recorder;
+  XMLReader reader(recorder);
+
+  for (size_t i = 0; i < xml.size(); i += chunk)
+    reader.feed(xml.data() + i, std::min(chunk, xml.size() - i));
+  reader.finish();
+
+  return recorder.events;
+}
+
+//! Check that a document is rejected.
+static bool
+rejected(const std::string& xml)
+{
+  try
+  {
+    parse(xml, xml.size());
+  }
+  catch (ParseError& e)
+  {
+    return true;
+  }
+
+  return false;
+}
+
+int
+main(void)
+{
+  Test test("Utils::XMLReader");
+
+  test.boolean("whole document", parse(c_document, 1024) == c_events);
+  test.boolean("one byte chunks", parse(c_document, 1) == c_events);
+  test.boolean("odd chunks", parse(c_document, 7) == c_events);
+
+  {
+    Recorder recorder;
+    XMLReader reader(recorder);
+    std::istringstream iss(c_document);
+    reader.read(iss);
+    test.boolean("read()", recorder.events == c_events);
+  }
+
+  test.boolean("mismatched tags", rejected("<a><b></a></b>"));
+  test.boolean("unclosed element", rejected("<a><b/>"));
+  test.boolean("unterminated tag", rejected("<a x='1'"));
+  test.boolean("malformed attribute", rejected("<a x=1/>"));
+  test.boolean("two roots", rejected("<a/><b/>"));
+  test.boolean("empty document", rejected(" "));
+
+  return test.getReturnValue();
+}
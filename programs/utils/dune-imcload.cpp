@@ -0,0 +1,667 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to load IMC transports and the message bus with     *
+// synthesized or replayed traffic at a configurable rate.                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_SYS_HAS_SIGNAL_H)
+#  include <signal.h>
+#endif
+
+using DUNE_NAMESPACES;
+
+//! True when the program was asked to stop.
+static bool g_stop = false;
+
+#if defined(DUNE_OS_POSIX)
+extern "C" void
+handleTerminate(int signo)
+{
+  (void)signo;
+  g_stop = true;
+}
+#endif
+
+//! Delivery statistics. Messages are identified by their time
+//! stamps, which are unique and preserved by echoes and the bus.
+class Statistics
+{
+public:
+  Statistics(void):
+    m_sent(0),
+    m_bytes(0),
+    m_acked(0),
+    m_duplicates(0),
+    m_last(0)
+  { }
+
+  //! Stamp and record a message about to be sent.
+  //! @param[in] msg message.
+  void
+  stamp(IMC::Message* msg)
+  {
+    double now = Clock::getSinceEpoch();
+    if (now <= m_last)
+      now = m_last + 1e-6;
+    m_last = now;
+    msg->setTimeStamp(now);
+
+    ScopedMutex l(m_lock);
+    ++m_sent;
+    m_bytes += msg->getSerializationSize();
+    m_outstanding.insert(now);
+  }
+
+  //! Record an acknowledged message.
+  //! @param[in] msg echoed or consumed message.
+  void
+  acknowledge(const IMC::Message* msg)
+  {
+    double now = Clock::getSinceEpoch();
+
+    ScopedMutex l(m_lock);
+    if (m_outstanding.erase(msg->getTimeStamp()) == 0)
+    {
+      ++m_duplicates;
+      return;
+    }
+
+    ++m_acked;
+    m_latencies.push_back(now - msg->getTimeStamp());
+  }
+
+  //! Print a report.
+  //! @param[in] elapsed duration of the test in seconds.
+  //! @param[in] acks true if acknowledgements were expected.
+  void
+  report(double elapsed, bool acks)
+  {
+    ScopedMutex l(m_lock);
+    std::printf("Sent:          %u messages, %.1f msg/s, %.1f kB/s\n",
+                m_sent, m_sent / elapsed, m_bytes / elapsed / 1024.0);
+
+    if (!acks)
+      return;
+
+    double loss = (m_sent > 0) ? 100.0 * (m_sent - m_acked) / m_sent : 0.0;
+    std::printf("Acknowledged:  %u messages, %.1f msg/s, %.3f%% lost, %u duplicates\n",
+                m_acked, m_acked / elapsed, loss, m_duplicates);
+
+    if (m_latencies.empty())
+      return;
+
+    std::sort(m_latencies.begin(), m_latencies.end());
+    std::printf("Latency (ms):  min %.3f, p50 %.3f, p90 %.3f, p99 %.3f, p99.9 %.3f, max %.3f\n",
+                m_latencies.front() * 1e3, percentile(0.5) * 1e3, percentile(0.9) * 1e3,
+                percentile(0.99) * 1e3, percentile(0.999) * 1e3, m_latencies.back() * 1e3);
+  }
+
+private:
+  //! Number of messages sent.
+  unsigned m_sent;
+  //! Number of bytes sent.
+  uint64_t m_bytes;
+  //! Number of messages acknowledged.
+  unsigned m_acked;
+  //! Number of duplicate or unknown acknowledgements.
+  unsigned m_duplicates;
+  //! Time stamp of the last message.
+  double m_last;
+  //! Time stamps of messages waiting for acknowledgement.
+  std::set<double> m_outstanding;
+  //! Latencies of acknowledged messages.
+  std::vector<double> m_latencies;
+  //! Lock (the bus acknowledges from another thread).
+  Concurrency::Mutex m_lock;
+
+  //! Nearest-rank percentile of sorted latencies.
+  double
+  percentile(double p) const
+  {
+    size_t rank = (size_t)(p * m_latencies.size());
+    return m_latencies[std::min(rank, m_latencies.size() - 1)];
+  }
+};
+
+//! Source of messages to send.
+class Source
+{
+public:
+  //! Synthesize a weighted mix of messages with default contents.
+  //! @param[in] mix list of ABBREV[:WEIGHT] items separated by commas.
+  Source(const std::string& mix):
+    m_reader(NULL),
+    m_current(NULL)
+  {
+    std::vector<std::string> items;
+    String::split(mix, ",", items);
+    for (unsigned i = 0; i < items.size(); ++i)
+    {
+      std::vector<std::string> parts;
+      String::split(items[i], ":", parts);
+
+      Item item;
+      item.msg = IMC::Factory::produce(parts[0]);
+      item.weight = (parts.size() > 1) ? std::atoi(parts[1].c_str()) : 1;
+      item.credit = 0;
+      if (item.weight <= 0)
+        throw std::runtime_error("invalid weight of " + parts[0]);
+      m_items.push_back(item);
+    }
+  }
+
+  //! Replay the messages of a log, over and over.
+  //! @param[in] log log file.
+  //! @param[in] replay unused, selects this constructor.
+  Source(const Path& log, bool replay):
+    m_log(log),
+    m_reader(new IMC::LogReader(log.str())),
+    m_current(NULL)
+  {
+    (void)replay;
+  }
+
+  ~Source(void)
+  {
+    for (unsigned i = 0; i < m_items.size(); ++i)
+      delete m_items[i].msg;
+
+    delete m_current;
+    delete m_reader;
+  }
+
+  //! Identifiers of the messages of a synthesized mix.
+  //! @param[out] ids message identifiers.
+  void
+  getIds(std::vector<unsigned>& ids) const
+  {
+    for (unsigned i = 0; i < m_items.size(); ++i)
+      ids.push_back(m_items[i].msg->getId());
+  }
+
+  //! Get the next message. The message remains owned by the source.
+  //! @return message.
+  IMC::Message*
+  next(void)
+  {
+    if (m_reader != NULL)
+      return nextReplayed();
+
+    // Smooth weighted round-robin: interleaves messages evenly while
+    // matching the weights over every cycle.
+    int total = 0;
+    Item* best = NULL;
+    for (unsigned i = 0; i < m_items.size(); ++i)
+    {
+      m_items[i].credit += m_items[i].weight;
+      total += m_items[i].weight;
+      if (best == NULL || m_items[i].credit > best->credit)
+        best = &m_items[i];
+    }
+
+    best->credit -= total;
+    return best->msg;
+  }
+
+private:
+  struct Item
+  {
+    IMC::Message* msg;
+    int weight;
+    int credit;
+  };
+
+  //! Synthesized messages.
+  std::vector<Item> m_items;
+  //! Replayed log.
+  Path m_log;
+  //! Log reader.
+  IMC::LogReader* m_reader;
+  //! Last replayed message.
+  IMC::Message* m_current;
+
+  IMC::Message*
+  nextReplayed(void)
+  {
+    delete m_current;
+    m_current = m_reader->read();
+    if (m_current != NULL)
+      return m_current;
+
+    delete m_reader;
+    m_reader = new IMC::LogReader(m_log.str());
+    m_current = m_reader->read();
+    if (m_current == NULL)
+      throw std::runtime_error(m_log.str() + " contains no messages");
+
+    return m_current;
+  }
+};
+
+//! Transport under test.
+class Transport
+{
+public:
+  virtual
+  ~Transport(void)
+  { }
+
+  //! Send a message.
+  //! @param[in] msg message.
+  virtual void
+  send(const IMC::Message* msg) = 0;
+
+  //! Wait for acknowledgements.
+  //! @param[in] timeout maximum amount of time to wait in seconds.
+  //! @param[in] stats statistics to update.
+  virtual void
+  poll(double timeout, Statistics& stats) = 0;
+};
+
+//! UDP datagrams, acknowledged by an echo server.
+class UDPTransport: public Transport
+{
+public:
+  UDPTransport(const Address& addr, uint16_t port, uint16_t local_port):
+    m_addr(addr),
+    m_port(port)
+  {
+    m_sock.bind(local_port);
+  }
+
+  void
+  send(const IMC::Message* msg)
+  {
+    uint16_t size = IMC::Packet::serialize(msg, m_bfr, sizeof(m_bfr));
+    m_sock.write(m_bfr, size, m_addr, m_port);
+  }
+
+  void
+  poll(double timeout, Statistics& stats)
+  {
+    while (IO::Poll::poll(m_sock, timeout))
+    {
+      size_t size = m_sock.read(m_bfr, sizeof(m_bfr));
+      IMC::Message* msg = IMC::Packet::deserialize(m_bfr, size);
+      if (msg != NULL)
+        stats.acknowledge(msg);
+      delete msg;
+      timeout = 0;
+    }
+  }
+
+private:
+  UDPSocket m_sock;
+  Address m_addr;
+  uint16_t m_port;
+  uint8_t m_bfr[65535];
+};
+
+//! TCP stream, acknowledged by an echo server.
+class TCPTransport: public Transport
+{
+public:
+  TCPTransport(const Address& addr, uint16_t port)
+  {
+    m_sock.connect(addr, port);
+    m_sock.setNoDelay(true);
+  }
+
+  void
+  send(const IMC::Message* msg)
+  {
+    uint16_t size = IMC::Packet::serialize(msg, m_bfr, sizeof(m_bfr));
+    for (uint16_t done = 0; done < size; )
+      done += m_sock.write(m_bfr + done, size - done);
+  }
+
+  void
+  poll(double timeout, Statistics& stats)
+  {
+    while (IO::Poll::poll(m_sock, timeout))
+    {
+      size_t size = m_sock.read(m_in, sizeof(m_in));
+      if (size == 0)
+        throw std::runtime_error("connection closed by peer");
+
+      unsigned consumed = 0;
+      for (size_t offset = 0; offset < size; offset += consumed)
+      {
+        IMC::Message* msg = m_parser.parse(m_in + offset, size - offset, consumed);
+        if (msg != NULL)
+          stats.acknowledge(msg);
+        delete msg;
+      }
+
+      timeout = 0;
+    }
+  }
+
+private:
+  TCPSocket m_sock;
+  IMC::Parser m_parser;
+  uint8_t m_bfr[65535];
+  uint8_t m_in[65535];
+};
+
+//! In-process message bus, acknowledged when a task consumes the
+//! message.
+class BusTransport: public Transport, public Tasks::AbstractTask
+{
+public:
+  BusTransport(const std::vector<unsigned>& ids, Statistics& stats):
+    m_recipient(this, m_ctx),
+    m_stats(stats)
+  {
+    for (unsigned i = 0; i < ids.size(); ++i)
+    {
+      m_recipient.bind(ids[i], new Tasks::Consumer<BusTransport, IMC::Message>(*this, &BusTransport::consume));
+    }
+
+    start();
+  }
+
+  ~BusTransport(void)
+  {
+    stopAndJoin();
+  }
+
+  void
+  send(const IMC::Message* msg)
+  {
+    m_ctx.mbus.dispatch(msg);
+  }
+
+  void
+  poll(double timeout, Statistics& stats)
+  {
+    (void)stats;
+    Delay::wait(timeout);
+  }
+
+  void
+  receive(const IMC::Message* msg)
+  {
+    m_recipient.put(msg);
+  }
+
+  void
+  receive(IMC::SharedMessage* msg)
+  {
+    m_recipient.put(msg);
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Load";
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    m_stats.acknowledge(msg);
+  }
+
+private:
+  Tasks::Context m_ctx;
+  Tasks::Recipient m_recipient;
+  Statistics& m_stats;
+
+  void
+  run(void)
+  {
+    while (!isStopping())
+    {
+      m_recipient.waitForMessages(0.1);
+      m_recipient.runCallBacks();
+    }
+  }
+};
+
+//! Send every received datagram back to its sender.
+static void
+echoUDP(uint16_t port, uint16_t reply_port)
+{
+  UDPSocket sock;
+  sock.bind(port);
+
+  uint8_t bfr[65535];
+  Address addr;
+  while (!g_stop)
+  {
+    if (!IO::Poll::poll(sock, 0.1))
+      continue;
+
+    size_t size = sock.read(bfr, sizeof(bfr), &addr);
+    sock.write(bfr, size, addr, reply_port);
+  }
+}
+
+//! Send every received byte back to its sender, one client at a time.
+static void
+echoTCP(uint16_t port)
+{
+  TCPSocket server;
+  server.bind(port);
+  server.listen(1);
+
+  uint8_t bfr[65535];
+  while (!g_stop)
+  {
+    if (!IO::Poll::poll(server, 0.1))
+      continue;
+
+    TCPSocket* client = server.accept();
+    client->setNoDelay(true);
+    try
+    {
+      while (!g_stop)
+      {
+        if (!IO::Poll::poll(*client, 0.1))
+          continue;
+
+        size_t size = client->read(bfr, sizeof(bfr));
+        if (size == 0)
+          break;
+
+        for (size_t done = 0; done < size; )
+          done += client->write(bfr + done, size - done);
+      }
+    }
+    catch (std::exception& e)
+    {
+      std::fprintf(stderr, "client: %s\n", e.what());
+    }
+
+    delete client;
+  }
+}
+
+int
+main(int argc, char** argv)
+{
+  OptionParser options;
+  options.executable("dune-imcload")
+  .program(DUNE_SHORT_NAME)
+  .copyright(DUNE_COPYRIGHT)
+  .email(DUNE_CONTACT)
+  .version(getFullVersion())
+  .date(getCompileDate())
+  .arch(DUNE_SYSTEM_NAME)
+  .description("Load an IMC transport or the message bus with synthesized or"
+               " replayed traffic and report throughput, loss and latency."
+               " Latency and loss are measured from the messages returned"
+               " by a peer running in echo mode or consumed from the bus.")
+  .add("-t", "--transport",
+       "Transport: udp, tcp or bus (default is udp)", "TRANSPORT")
+  .add("-i", "--address",
+       "Destination address (default is 127.0.0.1)", "ADDRESS")
+  .add("-p", "--port",
+       "Destination port, or listening port in echo mode (default is 6002)", "PORT")
+  .add("-P", "--reply-port",
+       "Local UDP port receiving echoes (default is 6003)", "PORT")
+  .add("-r", "--rate",
+       "Messages per second, zero for as fast as possible (default is 1000)", "RATE")
+  .add("-d", "--duration",
+       "Duration of the test in seconds (default is 10)", "SECONDS")
+  .add("-m", "--mix",
+       "Messages to synthesize as ABBREV[:WEIGHT],... (default is"
+       " EstimatedState:10,Rpm:5,Voltage:1,Heartbeat:1)", "MIX")
+  .add("-l", "--log",
+       "Replay the messages of a log instead of synthesizing them", "FILE")
+  .add("-k", "--acknowledge",
+       "Expect echoes from a peer in echo mode")
+  .add("-e", "--echo",
+       "Echo mode: return every message received");
+
+  if (!options.parse(argc, argv))
+  {
+    if (options.bad())
+      std::fprintf(stderr, "ERROR: %s\n", options.error());
+    options.usage();
+    return 1;
+  }
+
+#if defined(DUNE_OS_POSIX)
+  signal(SIGINT, handleTerminate);
+  signal(SIGTERM, handleTerminate);
+#endif
+
+  std::string transport = options.value("--transport").empty() ? "udp" : options.value("--transport");
+  Address addr(options.value("--address").empty() ? "127.0.0.1" : options.value("--address").c_str());
+  unsigned port = 6002;
+  unsigned reply_port = 6003;
+  double rate = 1000;
+  double duration = 10;
+  std::string mix = "EstimatedState:10,Rpm:5,Voltage:1,Heartbeat:1";
+
+  if ((!options.value("--port").empty() && !castLexical(options.value("--port"), port))
+      || (!options.value("--reply-port").empty() && !castLexical(options.value("--reply-port"), reply_port))
+      || (!options.value("--rate").empty() && !castLexical(options.value("--rate"), rate))
+      || (!options.value("--duration").empty() && !castLexical(options.value("--duration"), duration))
+      || port > 65535 || reply_port > 65535 || rate < 0 || duration <= 0)
+  {
+    std::fprintf(stderr, "ERROR: invalid arguments\n");
+    options.usage();
+    return 1;
+  }
+
+  if (!options.value("--mix").empty())
+    mix = options.value("--mix");
+
+  try
+  {
+    if (options.value("--echo") == "true")
+    {
+      if (transport == "tcp")
+        echoTCP(port);
+      else
+        echoUDP(port, reply_port);
+      return 0;
+    }
+
+    Source* source = NULL;
+    if (options.value("--log").empty())
+      source = new Source(mix);
+    else
+      source = new Source(Path(options.value("--log")), true);
+
+    Statistics stats;
+    Transport* link = NULL;
+    bool acks = options.value("--acknowledge") == "true";
+    if (transport == "tcp")
+    {
+      link = new TCPTransport(addr, port);
+    }
+    else if (transport == "bus")
+    {
+      std::vector<unsigned> ids;
+      source->getIds(ids);
+      if (ids.empty())
+        throw std::runtime_error("the bus can only be loaded with synthesized messages");
+      link = new BusTransport(ids, stats);
+      acks = true;
+    }
+    else if (transport == "udp")
+    {
+      link = new UDPTransport(addr, port, reply_port);
+    }
+    else
+    {
+      throw std::runtime_error("unknown transport " + transport);
+    }
+
+    // Messages are paced on an absolute schedule so that a late
+    // message does not delay the next ones.
+    double start = Clock::get();
+    double elapsed = 0;
+    for (uint64_t n = 0; !g_stop && elapsed < duration; ++n)
+    {
+      double deadline = (rate > 0) ? start + n / rate : 0;
+      if (n % 64 == 0 || Clock::get() < deadline)
+      {
+        do
+          link->poll(std::max(0.0, deadline - Clock::get()), stats);
+        while (!g_stop && Clock::get() < deadline);
+      }
+
+      IMC::Message* msg = source->next();
+      stats.stamp(msg);
+      link->send(msg);
+      elapsed = Clock::get() - start;
+    }
+
+    // Wait for stragglers.
+    double linger = Clock::get() + 1.0;
+    while (acks && !g_stop && Clock::get() < linger)
+      link->poll(0.05, stats);
+
+    stats.report(elapsed, acks);
+
+    delete link;
+    delete source;
+  }
+  catch (std::exception& e)
+  {
+    std::fprintf(stderr, "ERROR: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
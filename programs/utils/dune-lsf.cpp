@@ -0,0 +1,1340 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to process LSF logs with several analyzers in one pass.  *
+// Indexed logs are decoded by a pool of threads, one range of blocks per   *
+// job, and messages are handed to the analyzers in log order.              *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Default number of decoding threads.
+static const unsigned c_default_threads = 4;
+//! Maximum number of indexed blocks decoded by one job.
+static const unsigned c_max_blocks_per_job = 8;
+//! Maximum number of jobs in flight per thread.
+static const unsigned c_max_jobs_per_thread = 2;
+//! Minimum rpm before assuming that the vehicle is moving.
+static const float c_min_rpm = 400.0;
+
+//! Analyzer of logs. Analyzers receive the messages they ask for,
+//! in log order, and write rows to a CSV file named after them. The
+//! first column of every row is the path of the log.
+class Analyzer
+{
+public:
+  //! Constructor.
+  //! @param[in] name analyzer name.
+  //! @param[in] columns CSV columns, after the log column.
+  Analyzer(const char* name, const char* columns):
+    m_name(name),
+    m_columns(columns)
+  { }
+
+  virtual
+  ~Analyzer(void)
+  { }
+
+  //! Get the analyzer name.
+  //! @return analyzer name.
+  const char*
+  getName(void) const
+  {
+    return m_name;
+  }
+
+  //! Open the output file and write the CSV header.
+  //! @param[in] dir output directory.
+  //! @return true if the file was opened, false otherwise.
+  bool
+  open(const Path& dir)
+  {
+    Path path = dir / (std::string(m_name) + ".csv");
+    m_ofs.open(path.c_str());
+    m_ofs << "log," << m_columns << '\n';
+    return m_ofs.good();
+  }
+
+  //! Start processing a log.
+  //! @param[in] log path of the log.
+  void
+  begin(const std::string& log)
+  {
+    m_log = log;
+    onBegin();
+  }
+
+  //! Finish processing a log.
+  void
+  end(void)
+  {
+    onEnd();
+    m_ofs.flush();
+  }
+
+  //! Get the messages used by the analyzer.
+  //! @param[out] ids message identifiers (none to receive all
+  //! messages).
+  virtual void
+  getIds(std::set<uint16_t>& ids) const = 0;
+
+  //! Process a message.
+  //! @param[in] msg message.
+  virtual void
+  consume(const IMC::Message* msg) = 0;
+
+protected:
+  //! Start a CSV row.
+  //! @return output stream, positioned after the log column.
+  std::ostream&
+  row(void)
+  {
+    m_ofs << m_log << ',';
+    return m_ofs;
+  }
+
+  //! Called when a log starts.
+  virtual void
+  onBegin(void)
+  { }
+
+  //! Called when a log ends.
+  virtual void
+  onEnd(void)
+  { }
+
+private:
+  //! Analyzer name.
+  const char* m_name;
+  //! CSV columns.
+  const char* m_columns;
+  //! Output file.
+  std::ofstream m_ofs;
+  //! Path of the current log.
+  std::string m_log;
+};
+
+//! Number of packets and time span per message.
+class CountsAnalyzer: public Analyzer
+{
+public:
+  CountsAnalyzer(void):
+    Analyzer("counts", "message,count,first,last")
+  { }
+
+  void
+  getIds(std::set<uint16_t>& ids) const
+  {
+    (void)ids;
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    Count& c = m_counts[msg->getId()];
+    if (c.count++ == 0)
+      c.first = msg->getTimeStamp();
+    c.last = msg->getTimeStamp();
+  }
+
+private:
+  struct Count
+  {
+    unsigned count;
+    double first;
+    double last;
+
+    Count(void):
+      count(0),
+      first(0),
+      last(0)
+    { }
+  };
+
+  std::map<uint16_t, Count> m_counts;
+
+  void
+  onBegin(void)
+  {
+    m_counts.clear();
+  }
+
+  void
+  onEnd(void)
+  {
+    std::map<uint16_t, Count>::const_iterator itr = m_counts.begin();
+    for (; itr != m_counts.end(); ++itr)
+    {
+      row() << IMC::Factory::getAbbrevFromId(itr->first) << ','
+            << itr->second.count << ','
+            << std::fixed << std::setprecision(3)
+            << itr->second.first << ','
+            << itr->second.last << '\n';
+    }
+  }
+};
+
+//! Accurate GPS fixes (see surface_positions).
+class GpsAnalyzer: public Analyzer
+{
+public:
+  GpsAnalyzer(void):
+    Analyzer("gps", "timestamp,latitude,longitude,height,hacc")
+  { }
+
+  void
+  getIds(std::set<uint16_t>& ids) const
+  {
+    ids.insert(DUNE_IMC_GPSFIX);
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    const IMC::GpsFix* fix = static_cast<const IMC::GpsFix*>(msg);
+
+    if (fix->hacc > c_max_hacc || !(fix->validity & IMC::GpsFix::GFV_VALID_POS))
+      return;
+
+    if (fix->getTimeStamp() < m_timestamp)
+      return;
+
+    m_timestamp = fix->getTimeStamp();
+
+    row() << std::fixed << std::setprecision(3) << fix->getTimeStamp() << ','
+          << std::setprecision(7) << Angles::degrees(fix->lat) << ','
+          << Angles::degrees(fix->lon) << ','
+          << std::setprecision(2) << fix->height << ','
+          << fix->hacc << '\n';
+  }
+
+private:
+  //! Maximum horizontal accuracy.
+  static const float c_max_hacc;
+  //! Time stamp of the last fix.
+  double m_timestamp;
+
+  void
+  onBegin(void)
+  {
+    m_timestamp = -1.0;
+  }
+};
+
+const float GpsAnalyzer::c_max_hacc = 12.0;
+
+//! Synchronized CTD samples (see ctd_csv).
+class CtdAnalyzer: public Analyzer
+{
+public:
+  CtdAnalyzer(void):
+    Analyzer("ctd", "timestamp,latitude,longitude,conductivity,temperature,depth")
+  { }
+
+  void
+  getIds(std::set<uint16_t>& ids) const
+  {
+    ids.insert(DUNE_IMC_ENTITYINFO);
+    ids.insert(DUNE_IMC_ESTIMATEDSTATE);
+    ids.insert(DUNE_IMC_CONDUCTIVITY);
+    ids.insert(DUNE_IMC_TEMPERATURE);
+    ids.insert(DUNE_IMC_DEPTH);
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    switch (msg->getId())
+    {
+      case DUNE_IMC_ENTITYINFO:
+        {
+          const IMC::EntityInfo* info = static_cast<const IMC::EntityInfo*>(msg);
+          if (info->label == "CTD")
+          {
+            m_entity = info->id;
+            m_got_entity = true;
+          }
+        }
+        return;
+
+      case DUNE_IMC_ESTIMATEDSTATE:
+        Coordinates::toWGS84(*static_cast<const IMC::EstimatedState*>(msg), m_lat, m_lon);
+        m_timestamp = msg->getTimeStamp();
+        m_got |= GOT_STATE;
+        return;
+
+      default:
+        break;
+    }
+
+    if (!(m_got & GOT_STATE) || !m_got_entity || msg->getSourceEntity() != m_entity)
+      return;
+
+    switch (msg->getId())
+    {
+      case DUNE_IMC_CONDUCTIVITY:
+        m_cond = static_cast<const IMC::Conductivity*>(msg)->value;
+        m_got |= GOT_COND;
+        break;
+
+      case DUNE_IMC_TEMPERATURE:
+        m_temp = static_cast<const IMC::Temperature*>(msg)->value;
+        m_got |= GOT_TEMP;
+        break;
+
+      case DUNE_IMC_DEPTH:
+        m_depth = static_cast<const IMC::Depth*>(msg)->value;
+        m_got |= GOT_DEPTH;
+        break;
+    }
+
+    if (m_got != GOT_ALL)
+      return;
+
+    row() << std::fixed << std::setprecision(3) << m_timestamp << ','
+          << std::setprecision(7) << Angles::degrees(m_lat) << ','
+          << Angles::degrees(m_lon) << ','
+          << std::setprecision(4) << m_cond << ','
+          << m_temp << ','
+          << m_depth << '\n';
+
+    m_got = 0;
+  }
+
+private:
+  //! Sample contents.
+  enum Content
+  {
+    GOT_COND = 0x01,
+    GOT_TEMP = 0x02,
+    GOT_DEPTH = 0x04,
+    GOT_STATE = 0x08,
+    GOT_ALL = GOT_COND | GOT_TEMP | GOT_DEPTH | GOT_STATE
+  };
+
+  unsigned m_got;
+  bool m_got_entity;
+  unsigned m_entity;
+  double m_timestamp;
+  double m_lat;
+  double m_lon;
+  float m_cond;
+  float m_temp;
+  float m_depth;
+
+  void
+  onBegin(void)
+  {
+    m_got = 0;
+    m_got_entity = false;
+    m_entity = 0;
+  }
+};
+
+//! Distance travelled with the motor on (see distance_travelled).
+class DistanceAnalyzer: public Analyzer
+{
+public:
+  DistanceAnalyzer(void):
+    Analyzer("distance", "name,distance,duration,simulated")
+  { }
+
+  void
+  getIds(std::set<uint16_t>& ids) const
+  {
+    ids.insert(DUNE_IMC_LOGGINGCONTROL);
+    ids.insert(DUNE_IMC_ESTIMATEDSTATE);
+    ids.insert(DUNE_IMC_RPM);
+    ids.insert(DUNE_IMC_SIMULATEDSTATE);
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    switch (msg->getId())
+    {
+      case DUNE_IMC_LOGGINGCONTROL:
+        {
+          const IMC::LoggingControl* lc = static_cast<const IMC::LoggingControl*>(msg);
+          if (m_name.empty() && lc->op == IMC::LoggingControl::COP_STARTED)
+            m_name = lc->name;
+        }
+        break;
+
+      case DUNE_IMC_RPM:
+        m_rpm = static_cast<const IMC::Rpm*>(msg)->value;
+        break;
+
+      case DUNE_IMC_SIMULATEDSTATE:
+        m_simulated = true;
+        break;
+
+      case DUNE_IMC_ESTIMATEDSTATE:
+        onState(static_cast<const IMC::EstimatedState*>(msg));
+        break;
+    }
+  }
+
+private:
+  //! Time between integrated states.
+  static const double c_timestep;
+  //! Maximum speed considered when integrating.
+  static const double c_max_speed;
+
+  std::string m_name;
+  int16_t m_rpm;
+  bool m_simulated;
+  bool m_got_state;
+  double m_last_time;
+  double m_last_lat;
+  double m_last_lon;
+  double m_distance;
+  double m_duration;
+
+  void
+  onState(const IMC::EstimatedState* state)
+  {
+    double time = state->getTimeStamp();
+    if (m_got_state && time - m_last_time <= c_timestep)
+      return;
+
+    double lat = 0;
+    double lon = 0;
+    Coordinates::toWGS84(*state, lat, lon);
+
+    if (m_got_state && m_rpm <= c_min_rpm)
+      return;
+
+    if (m_got_state)
+    {
+      double dist = Coordinates::WGS84::distance(m_last_lat, m_last_lon, 0.0, lat, lon, 0.0);
+      if (dist / (time - m_last_time) < c_max_speed)
+      {
+        m_distance += dist;
+        m_duration += time - m_last_time;
+      }
+    }
+
+    m_got_state = true;
+    m_last_time = time;
+    m_last_lat = lat;
+    m_last_lon = lon;
+  }
+
+  void
+  onBegin(void)
+  {
+    m_name.clear();
+    m_rpm = 0;
+    m_simulated = false;
+    m_got_state = false;
+    m_last_time = 0;
+    m_distance = 0;
+    m_duration = 0;
+  }
+
+  void
+  onEnd(void)
+  {
+    row() << m_name << ','
+          << std::fixed << std::setprecision(1) << m_distance << ','
+          << m_duration << ','
+          << (m_simulated ? 1 : 0) << '\n';
+  }
+};
+
+const double DistanceAnalyzer::c_timestep = 0.5;
+const double DistanceAnalyzer::c_max_speed = 6.0;
+
+//! Energy drawn from the batteries (see energy_consumed).
+class EnergyAnalyzer: public Analyzer
+{
+public:
+  EnergyAnalyzer(void):
+    Analyzer("energy", "name,energy,motor_energy,simulated")
+  { }
+
+  void
+  getIds(std::set<uint16_t>& ids) const
+  {
+    ids.insert(DUNE_IMC_LOGGINGCONTROL);
+    ids.insert(DUNE_IMC_ENTITYINFO);
+    ids.insert(DUNE_IMC_VOLTAGE);
+    ids.insert(DUNE_IMC_CURRENT);
+    ids.insert(DUNE_IMC_RPM);
+    ids.insert(DUNE_IMC_SIMULATEDSTATE);
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    switch (msg->getId())
+    {
+      case DUNE_IMC_LOGGINGCONTROL:
+        {
+          const IMC::LoggingControl* lc = static_cast<const IMC::LoggingControl*>(msg);
+          if (m_name.empty() && lc->op == IMC::LoggingControl::COP_STARTED)
+            m_name = lc->name;
+        }
+        break;
+
+      case DUNE_IMC_ENTITYINFO:
+        {
+          const IMC::EntityInfo* info = static_cast<const IMC::EntityInfo*>(msg);
+          if (info->label == "Batteries")
+          {
+            m_entity = info->id;
+            m_got_entity = true;
+          }
+        }
+        break;
+
+      case DUNE_IMC_CURRENT:
+        if (m_got_entity && msg->getSourceEntity() == m_entity)
+        {
+          m_current = static_cast<const IMC::Current*>(msg)->value;
+          m_got_current = true;
+        }
+        break;
+
+      case DUNE_IMC_VOLTAGE:
+        if (m_got_entity && msg->getSourceEntity() == m_entity)
+          onVoltage(static_cast<const IMC::Voltage*>(msg));
+        break;
+
+      case DUNE_IMC_RPM:
+        m_rpm = static_cast<const IMC::Rpm*>(msg)->value;
+        break;
+
+      case DUNE_IMC_SIMULATEDSTATE:
+        m_simulated = true;
+        break;
+    }
+  }
+
+private:
+  std::string m_name;
+  bool m_got_entity;
+  unsigned m_entity;
+  bool m_got_current;
+  float m_current;
+  double m_last_time;
+  int16_t m_rpm;
+  bool m_simulated;
+  double m_energy;
+  double m_motor_energy;
+
+  void
+  onVoltage(const IMC::Voltage* voltage)
+  {
+    double time = voltage->getTimeStamp();
+
+    if (m_got_current && m_last_time > 0)
+    {
+      double wh = voltage->value * m_current * (time - m_last_time) / 3600.0;
+      m_energy += wh;
+      if (m_rpm > c_min_rpm)
+        m_motor_energy += wh;
+    }
+
+    m_last_time = time;
+  }
+
+  void
+  onBegin(void)
+  {
+    m_name.clear();
+    m_got_entity = false;
+    m_entity = 0;
+    m_got_current = false;
+    m_current = 0;
+    m_last_time = 0;
+    m_rpm = 0;
+    m_simulated = false;
+    m_energy = 0;
+    m_motor_energy = 0;
+  }
+
+  void
+  onEnd(void)
+  {
+    row() << m_name << ','
+          << std::fixed << std::setprecision(3) << m_energy << ','
+          << m_motor_energy << ','
+          << (m_simulated ? 1 : 0) << '\n';
+  }
+};
+
+//! Latency of traced message paths (see Tasks::Tracer). A path
+//! follows the messages dispatched because of a traced message, from
+//! the origin message to a task that consumed the last message and
+//! dispatched nothing in return.
+class LatencyAnalyzer: public Analyzer
+{
+public:
+  LatencyAnalyzer(void):
+    Analyzer("latency", "path,count,mean,p50,p90,p99,max,hops,histogram")
+  { }
+
+  void
+  getIds(std::set<uint16_t>& ids) const
+  {
+    ids.insert(DUNE_IMC_ENTITYINFO);
+    ids.insert(DUNE_IMC_TRACEHOP);
+  }
+
+  void
+  consume(const IMC::Message* msg)
+  {
+    if (msg->getId() == DUNE_IMC_ENTITYINFO)
+    {
+      const IMC::EntityInfo* info = static_cast<const IMC::EntityInfo*>(msg);
+      m_labels[info->id] = info->label;
+      return;
+    }
+
+    const IMC::TraceHop* th = static_cast<const IMC::TraceHop*>(msg);
+    Hop hop;
+    hop.entity = th->getSourceEntity();
+    hop.message = th->message_id;
+    hop.cause = th->cause;
+    hop.consumed = (th->event == IMC::TraceHop::THE_CONSUMED);
+    hop.latency = th->latency;
+    m_traces[th->trace_id].push_back(hop);
+  }
+
+private:
+  //! Upper bound of the first histogram bin (as DeliveryStatistics).
+  static const double c_first_bin;
+  //! Number of histogram bins.
+  static const unsigned c_bins = 16;
+  //! Maximum number of hops in a path.
+  static const unsigned c_max_hops = 32;
+  //! Cause of hops without one.
+  static const uint16_t c_no_cause = 0xFFFF;
+
+  //! Step of a trace.
+  struct Hop
+  {
+    unsigned entity;
+    uint16_t message;
+    uint16_t cause;
+    bool consumed;
+    float latency;
+  };
+
+  //! Latencies of one path.
+  struct Path
+  {
+    //! End-to-end latencies.
+    std::vector<float> latencies;
+    //! Sum of the latencies since the origin at each hop.
+    std::vector<double> hops;
+  };
+
+  //! Entity labels.
+  std::map<unsigned, std::string> m_labels;
+  //! Hops of each trace.
+  std::map<uint32_t, std::vector<Hop> > m_traces;
+  //! Paths by description.
+  std::map<std::string, Path> m_paths;
+
+  std::string
+  label(unsigned entity) const
+  {
+    std::map<unsigned, std::string>::const_iterator itr = m_labels.find(entity);
+    if (itr == m_labels.end())
+      return String::str(entity);
+    return itr->second;
+  }
+
+  //! Find the earliest dispatch of a message in a trace.
+  const Hop*
+  findDispatch(const std::vector<Hop>& hops, uint16_t message) const
+  {
+    const Hop* found = NULL;
+    for (unsigned i = 0; i < hops.size(); ++i)
+    {
+      if (hops[i].consumed || hops[i].message != message)
+        continue;
+
+      if (found == NULL || hops[i].latency < found->latency)
+        found = &hops[i];
+    }
+
+    return found;
+  }
+
+  //! Test if an entity dispatched a message because of another.
+  bool
+  isCause(const std::vector<Hop>& hops, unsigned entity, uint16_t message) const
+  {
+    for (unsigned i = 0; i < hops.size(); ++i)
+    {
+      if (!hops[i].consumed && hops[i].entity == entity && hops[i].cause == message)
+        return true;
+    }
+
+    return false;
+  }
+
+  //! Add the paths of a trace.
+  void
+  addTrace(const std::vector<Hop>& hops)
+  {
+    for (unsigned i = 0; i < hops.size(); ++i)
+    {
+      const Hop& end = hops[i];
+      if (!end.consumed || isCause(hops, end.entity, end.message))
+        continue;
+
+      // Walk back from the last message to the origin.
+      std::vector<const Hop*> chain;
+      const Hop* hop = findDispatch(hops, end.message);
+      while (hop != NULL && chain.size() < c_max_hops)
+      {
+        chain.push_back(hop);
+        if (hop->cause == c_no_cause)
+          break;
+        hop = findDispatch(hops, hop->cause);
+      }
+
+      if (chain.empty() || chain.back()->cause != c_no_cause)
+        continue;
+
+      std::string desc;
+      for (unsigned j = chain.size(); j > 0; --j)
+      {
+        desc += IMC::Factory::getAbbrevFromId(chain[j - 1]->message);
+        desc += "@" + label(chain[j - 1]->entity) + " > ";
+      }
+      desc += label(end.entity);
+
+      Path& path = m_paths[desc];
+      path.latencies.push_back(end.latency);
+      path.hops.resize(chain.size() + 1, 0.0);
+      for (unsigned j = chain.size(); j > 0; --j)
+        path.hops[chain.size() - j] += chain[j - 1]->latency;
+      path.hops[chain.size()] += end.latency;
+    }
+  }
+
+  //! Get a quantile of sorted values.
+  static float
+  quantile(const std::vector<float>& values, double q)
+  {
+    return values[std::min(values.size() - 1, (size_t)(q * values.size()))];
+  }
+
+  void
+  onBegin(void)
+  {
+    m_labels.clear();
+    m_traces.clear();
+    m_paths.clear();
+  }
+
+  void
+  onEnd(void)
+  {
+    std::map<uint32_t, std::vector<Hop> >::const_iterator titr = m_traces.begin();
+    for (; titr != m_traces.end(); ++titr)
+      addTrace(titr->second);
+
+    std::map<std::string, Path>::iterator itr = m_paths.begin();
+    for (; itr != m_paths.end(); ++itr)
+    {
+      std::vector<float>& lat = itr->second.latencies;
+      std::sort(lat.begin(), lat.end());
+
+      double sum = 0;
+      unsigned bins[c_bins] = {0};
+      for (unsigned i = 0; i < lat.size(); ++i)
+      {
+        sum += lat[i];
+
+        unsigned bin = 0;
+        double bound = c_first_bin;
+        while (lat[i] >= bound && bin < c_bins - 1)
+        {
+          bound *= 2.0;
+          ++bin;
+        }
+
+        ++bins[bin];
+      }
+
+      std::ostream& os = row();
+      os << '"' << itr->first << "\"," << lat.size() << ','
+         << std::scientific << std::setprecision(3)
+         << sum / lat.size() << ','
+         << quantile(lat, 0.5) << ','
+         << quantile(lat, 0.9) << ','
+         << quantile(lat, 0.99) << ','
+         << lat.back() << ',';
+
+      for (unsigned i = 0; i < itr->second.hops.size(); ++i)
+        os << (i ? " " : "") << itr->second.hops[i] / lat.size();
+      os << ',';
+
+      for (unsigned i = 0; i < c_bins; ++i)
+        os << (i ? " " : "") << bins[i];
+      os << '\n';
+    }
+  }
+};
+
+const double LatencyAnalyzer::c_first_bin = 10e-6;
+
+//! Registered analyzer.
+struct AnalyzerEntry
+{
+  //! Analyzer name.
+  const char* name;
+  //! Analyzer description.
+  const char* description;
+  //! Create an analyzer.
+  Analyzer* (*create)(void);
+};
+
+template <typename T>
+static Analyzer*
+createAnalyzer(void)
+{
+  return new T;
+}
+
+//! Registered analyzers.
+static const AnalyzerEntry c_analyzers[] =
+{
+  {"counts", "number of packets and time span per message", createAnalyzer<CountsAnalyzer>},
+  {"ctd", "synchronized CTD samples with position", createAnalyzer<CtdAnalyzer>},
+  {"distance", "distance travelled with the motor on", createAnalyzer<DistanceAnalyzer>},
+  {"energy", "energy drawn from the batteries", createAnalyzer<EnergyAnalyzer>},
+  {"gps", "GPS fixes with valid position and good accuracy", createAnalyzer<GpsAnalyzer>},
+  {"latency", "latency of traced message paths", createAnalyzer<LatencyAnalyzer>}
+};
+
+//! Number of registered analyzers.
+static const unsigned c_analyzer_count = sizeof(c_analyzers) / sizeof(c_analyzers[0]);
+
+//! Decoding job: the messages of a range of blocks.
+struct Job
+{
+  //! Path of the log.
+  std::string path;
+  //! First block.
+  unsigned begin;
+  //! Block past the last block.
+  unsigned end;
+  //! True if the job also reads the packets past the last block.
+  bool tail;
+  //! Decoded messages.
+  std::vector<IMC::Message*> messages;
+  //! Error message, if decoding failed.
+  std::string error;
+  //! True if the job was decoded (only used by the main thread).
+  bool done;
+};
+
+//! Decoding thread.
+class Worker: public Concurrency::Thread
+{
+public:
+  Worker(const std::set<uint16_t>& ids, unsigned capacity, Concurrency::MPSCQueue<Job*>& done):
+    m_ids(ids),
+    m_jobs(capacity),
+    m_done(done)
+  { }
+
+  ~Worker(void)
+  {
+    stop();
+    m_jobs.wakeup();
+    join();
+  }
+
+  void
+  push(Job* job)
+  {
+    while (!m_jobs.push(job))
+      Delay::wait(0.001);
+  }
+
+private:
+  //! Messages to decode.
+  std::set<uint16_t> m_ids;
+  //! Jobs to decode.
+  Concurrency::MPSCQueue<Job*> m_jobs;
+  //! Decoded jobs.
+  Concurrency::MPSCQueue<Job*>& m_done;
+
+  void
+  run(void)
+  {
+    Job* job = NULL;
+
+    while (!isStopping())
+    {
+      if (!m_jobs.pop(job))
+      {
+        m_jobs.waitForItems(1.0);
+        continue;
+      }
+
+      try
+      {
+        IMC::LogReader reader(job->path);
+        reader.setFilter(m_ids);
+        reader.setBlockRange(job->begin, job->tail ? UINT_MAX : job->end);
+
+        const IMC::LogReader::Record* record = NULL;
+        while ((record = reader.next()) != NULL)
+          job->messages.push_back(record->decode());
+      }
+      catch (std::exception& e)
+      {
+        job->error = e.what();
+      }
+
+      while (!m_done.push(job))
+        Delay::wait(0.001);
+    }
+  }
+};
+
+//! Runs analyzers over logs.
+class Processor
+{
+public:
+  //! Constructor.
+  //! @param[in] analyzers analyzers.
+  //! @param[in] threads number of decoding threads.
+  Processor(const std::vector<Analyzer*>& analyzers, unsigned threads):
+    m_analyzers(analyzers),
+    m_routes(DUNE_IMC_CONST_MAX_ID + 1),
+    m_done(c_max_jobs_per_thread * std::max(threads, 1U)),
+    m_max_pending(c_max_jobs_per_thread * std::max(threads, 1U)),
+    m_next(0)
+  {
+    // Analyzers that receive all messages disable the filter.
+    bool all = false;
+    for (unsigned i = 0; i < m_analyzers.size(); ++i)
+    {
+      std::set<uint16_t> ids;
+      m_analyzers[i]->getIds(ids);
+
+      if (ids.empty())
+      {
+        all = true;
+        for (unsigned id = 0; id < m_routes.size(); ++id)
+          m_routes[id].push_back(m_analyzers[i]);
+        continue;
+      }
+
+      std::set<uint16_t>::const_iterator itr = ids.begin();
+      for (; itr != ids.end(); ++itr)
+      {
+        m_routes[*itr].push_back(m_analyzers[i]);
+        m_ids.insert(*itr);
+      }
+    }
+
+    if (all)
+      m_ids.clear();
+
+    for (unsigned i = 0; i < threads; ++i)
+    {
+      Worker* worker = new Worker(m_ids, m_max_pending, m_done);
+      m_workers.push_back(worker);
+      worker->start();
+    }
+  }
+
+  ~Processor(void)
+  {
+    for (unsigned i = 0; i < m_workers.size(); ++i)
+      delete m_workers[i];
+  }
+
+  //! Process a log.
+  //! @param[in] path path of the log.
+  //! @return true if the whole log was processed, false otherwise.
+  bool
+  process(const std::string& path)
+  {
+    for (unsigned i = 0; i < m_analyzers.size(); ++i)
+      m_analyzers[i]->begin(path);
+
+    bool ok = true;
+    unsigned blocks = IMC::LogReader(path).getBlockCount();
+
+    if (blocks == 0 || m_workers.empty())
+      ok = processSequential(path);
+    else
+      ok = processParallel(path, blocks);
+
+    for (unsigned i = 0; i < m_analyzers.size(); ++i)
+      m_analyzers[i]->end();
+
+    return ok;
+  }
+
+private:
+  //! Analyzers.
+  std::vector<Analyzer*> m_analyzers;
+  //! Analyzers per message identifier.
+  std::vector<std::vector<Analyzer*> > m_routes;
+  //! Messages used by the analyzers (empty for all).
+  std::set<uint16_t> m_ids;
+  //! Decoding threads.
+  std::vector<Worker*> m_workers;
+  //! Jobs decoded by workers.
+  Concurrency::MPSCQueue<Job*> m_done;
+  //! Maximum number of pending jobs.
+  unsigned m_max_pending;
+  //! Next worker.
+  unsigned m_next;
+  //! Jobs waiting to be consumed, in submission order.
+  std::deque<Job*> m_pending;
+
+  //! Hand a message to the analyzers that use it.
+  //! @param[in] msg message.
+  void
+  dispatch(const IMC::Message* msg)
+  {
+    const std::vector<Analyzer*>& route = m_routes[msg->getId()];
+    for (unsigned i = 0; i < route.size(); ++i)
+      route[i]->consume(msg);
+  }
+
+  //! Read a log without index in the calling thread.
+  //! @param[in] path path of the log.
+  //! @return true if the whole log was read, false otherwise.
+  bool
+  processSequential(const std::string& path)
+  {
+    try
+    {
+      IMC::LogReader reader(path);
+      reader.setFilter(m_ids);
+
+      IMC::Message* msg = NULL;
+      while ((msg = reader.read()) != NULL)
+      {
+        dispatch(msg);
+        delete msg;
+      }
+    }
+    catch (std::exception& e)
+    {
+      std::cerr << path << ": " << e.what() << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+
+  //! Decode ranges of blocks in the worker threads and consume them
+  //! in order.
+  //! @param[in] path path of the log.
+  //! @param[in] blocks number of indexed blocks.
+  //! @return true if the whole log was read, false otherwise.
+  bool
+  processParallel(const std::string& path, unsigned blocks)
+  {
+    unsigned step = (blocks + m_workers.size() - 1) / m_workers.size();
+    step = std::min(step, c_max_blocks_per_job);
+
+    bool ok = true;
+
+    for (unsigned begin = 0; begin < blocks; begin += step)
+    {
+      Job* job = new Job;
+      job->path = path;
+      job->begin = begin;
+      job->end = std::min(begin + step, blocks);
+      job->tail = (job->end == blocks);
+      job->done = false;
+
+      m_pending.push_back(job);
+      m_workers[m_next]->push(job);
+      m_next = (m_next + 1) % m_workers.size();
+
+      while (m_pending.size() >= m_max_pending)
+        ok &= waitCompleted();
+
+      ok &= consumeCompleted();
+    }
+
+    while (!m_pending.empty())
+      ok &= waitCompleted();
+
+    return ok;
+  }
+
+  //! Wait for at least one job to be decoded and consume the
+  //! completed ones.
+  //! @return false if a consumed job failed, true otherwise.
+  bool
+  waitCompleted(void)
+  {
+    if (!m_pending.empty() && !m_pending.front()->done)
+    {
+      m_done.waitForItems(1.0);
+      Job* job = NULL;
+      while (m_done.pop(job))
+        job->done = true;
+    }
+
+    return consumeCompleted();
+  }
+
+  //! Consume decoded jobs, in submission order.
+  //! @return false if a consumed job failed, true otherwise.
+  bool
+  consumeCompleted(void)
+  {
+    Job* job = NULL;
+    while (m_done.pop(job))
+      job->done = true;
+
+    bool ok = true;
+
+    while (!m_pending.empty() && m_pending.front()->done)
+    {
+      job = m_pending.front();
+      m_pending.pop_front();
+
+      for (unsigned i = 0; i < job->messages.size(); ++i)
+      {
+        dispatch(job->messages[i]);
+        delete job->messages[i];
+      }
+
+      if (!job->error.empty())
+      {
+        std::cerr << job->path << ": blocks " << job->begin << " to "
+                  << job->end - 1 << ": " << job->error << std::endl;
+        ok = false;
+      }
+
+      delete job;
+    }
+
+    return ok;
+  }
+};
+
+static void
+usage(void)
+{
+  std::cerr << "Usage:\n\t dune-lsf [options] f1 ... fn\n"
+            << "Options:\n\t-a name1,...,namen: analyzers to run (default is all)\n"
+            << "\t-o dir: output directory (default is the current directory)\n"
+            << "\t-j threads: number of decoding threads (default is "
+            << c_default_threads << ", 0 to decode in the main thread)\n"
+            << "\t-l: list analyzers\n\n"
+            << "f1 ... fn can be:\n"
+            << "\t* block LSF logs (.blk extension)\n"
+            << "\t* gzipped or bzipped LSF files (.gz or .bz2 extension)\n"
+            << "\t* LLF log dir names (will look for Data.lsf.blk, Data.lsf\n"
+            << "\t  and Data.lsf.gz in it)\n"
+            << "\t* plain LSF files\n"
+            << "Each analyzer writes one CSV file named after it, with one\n"
+            << "row per record and the path of the log in the first column.\n"
+            << "Logs with an index (Data.lsf.idx or block logs) are decoded\n"
+            << "in parallel.\n";
+}
+
+static void
+listAnalyzers(void)
+{
+  for (unsigned i = 0; i < c_analyzer_count; ++i)
+    std::cout << std::setw(10) << std::left << c_analyzers[i].name << c_analyzers[i].description << '\n';
+}
+
+//! Find the log of an LLF log directory.
+//! @param[in] dir log directory.
+//! @return path of the log.
+static Path
+findLog(const Path& dir)
+{
+  static const char* c_names[] = {"Data.lsf.blk", "Data.lsf", "Data.lsf.gz", "Data.lsf.bz2"};
+
+  for (unsigned i = 0; i < sizeof(c_names) / sizeof(c_names[0]); ++i)
+  {
+    Path file = dir / c_names[i];
+    if (file.isFile())
+      return file;
+  }
+
+  return dir / "Data.lsf";
+}
+
+int
+main(int argc, char** argv)
+{
+  std::vector<std::string> names;
+  Path output(".");
+  unsigned threads = c_default_threads;
+
+  ++argv; --argc;
+
+  for (; *argv && **argv == '-'; ++argv, --argc)
+  {
+    char opt = (*argv)[1];
+
+    if (opt == 'l')
+    {
+      listAnalyzers();
+      return 0;
+    }
+
+    ++argv; --argc;
+
+    if (!*argv || **argv == '-')
+    {
+      std::cerr << "Invalid options\n";
+      usage();
+      return 1;
+    }
+
+    switch (opt)
+    {
+      case 'a':
+        Utils::String::split(*argv, ",", names);
+        break;
+      case 'o':
+        output = Path(*argv);
+        break;
+      case 'j':
+      {
+        char* aux;
+        long value = std::strtol(*argv, &aux, 10);
+        if (*aux != 0 || value < 0)
+        {
+          std::cerr << "Invalid number of threads: " << *argv << '\n';
+          usage();
+          return 1;
+        }
+        threads = (unsigned)value;
+        break;
+      }
+      default:
+        std::cerr << "Invalid option: '-" << opt << "\'\n";
+        usage();
+        return 1;
+    }
+  }
+
+  if (argc < 1)
+  {
+    std::cerr << "Invalid arguments" << std::endl;
+    usage();
+    return 1;
+  }
+
+  if (names.empty())
+  {
+    for (unsigned i = 0; i < c_analyzer_count; ++i)
+      names.push_back(c_analyzers[i].name);
+  }
+
+  if (!output.isDirectory())
+    output.create();
+
+  std::vector<Analyzer*> analyzers;
+  int rv = 0;
+
+  for (unsigned i = 0; i < names.size() && rv == 0; ++i)
+  {
+    unsigned j = 0;
+    while (j < c_analyzer_count && names[i] != c_analyzers[j].name)
+      ++j;
+
+    if (j == c_analyzer_count)
+    {
+      std::cerr << "Unknown analyzer: " << names[i] << '\n';
+      rv = 1;
+      break;
+    }
+
+    Analyzer* analyzer = c_analyzers[j].create();
+    analyzers.push_back(analyzer);
+
+    if (!analyzer->open(output))
+    {
+      std::cerr << "Unable to open output of " << names[i] << " in " << output << '\n';
+      rv = 1;
+    }
+  }
+
+  if (rv == 0)
+  {
+    Processor processor(analyzers, threads);
+
+    for (; *argv != 0; argv++)
+    {
+      Path file(*argv);
+
+      if (file.isDirectory())
+        file = findLog(file);
+
+      if (!file.isFile())
+      {
+        std::cerr << file << " does not exist\n";
+        rv = 1;
+        continue;
+      }
+
+      if (!processor.process(file.str()))
+        rv = 1;
+    }
+  }
+
+  for (unsigned i = 0; i < analyzers.size(); ++i)
+    delete analyzers[i];
+
+  return rv;
+}
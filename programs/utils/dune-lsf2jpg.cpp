@@ -30,6 +30,7 @@
 // ISO C++ 98 headers.
 #include <iostream>
 #include <fstream>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -44,31 +45,25 @@ main(int argc, char** argv)
     return 1;
   }
 
-  std::istream* is = 0;
-  Compression::Methods method = Compression::Factory::detect(argv[1]);
-  if (method == METHOD_UNKNOWN)
-    is = new std::ifstream(argv[1], std::ios::binary);
-  else
-    is = new Compression::FileInput(argv[1], method);
+  DUNE::IMC::LogReader reader(argv[1]);
+  std::set<uint16_t> ids;
+  ids.insert(DUNE_IMC_COMPRESSEDIMAGE);
+  reader.setFilter(ids);
 
-  DUNE::IMC::Message* msg = NULL;
+  const DUNE::IMC::LogReader::Record* record = NULL;
+  DUNE::IMC::CompressedImage img;
 
   Path folder = Path(argv[1]).dirname();
 
   try
   {
-    while ((msg = DUNE::IMC::Packet::deserialize(*is)) != 0)
+    while ((record = reader.next()) != NULL)
     {
-      if (msg->getId() == DUNE_IMC_COMPRESSEDIMAGE)
-      {
-        DUNE::IMC::CompressedImage* img = dynamic_cast<DUNE::IMC::CompressedImage*>(msg);
+      record->decode(img);
 
-        Path fname = folder / String::str("%0.4f.jpg", img->getTimeStamp());
-        std::ofstream ofs(fname.c_str(), std::ios::binary);
-        ofs.write(&(img->data[0]), img->data.size());
-      }
-
-      delete msg;
+      Path fname = folder / String::str("%0.4f.jpg", img.getTimeStamp());
+      std::ofstream ofs(fname.c_str(), std::ios::binary);
+      ofs.write(&(img.data[0]), img.data.size());
     }
   }
   catch (std::runtime_error& e)
@@ -76,7 +71,5 @@ main(int argc, char** argv)
     std::cerr << "ERROR: " << e.what() << std::endl;
   }
 
-  delete is;
-
   return 0;
 }
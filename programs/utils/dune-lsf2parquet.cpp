@@ -0,0 +1,1216 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to convert LSF logs to one Parquet file per message.     *
+// Columns are named and typed after the IMC XML definitions and payloads   *
+// are decoded straight from the serialized packets.                        *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Default number of rows per row group.
+static const unsigned c_default_group_rows = 65536;
+//! Parquet file magic.
+static const char c_magic[] = "PAR1";
+
+//! Parquet physical types.
+enum PhysicalType
+{
+  PT_INT32 = 1,
+  PT_INT64 = 2,
+  PT_FLOAT = 4,
+  PT_DOUBLE = 5,
+  PT_BYTE_ARRAY = 6
+};
+
+//! Parquet converted types (-1 for none).
+enum ConvertedType
+{
+  CT_NONE = -1,
+  CT_UTF8 = 0,
+  CT_UINT_8 = 11,
+  CT_UINT_16 = 12,
+  CT_INT_8 = 15,
+  CT_INT_16 = 16
+};
+
+//! Parquet encodings.
+enum Encoding
+{
+  ENC_PLAIN = 0,
+  ENC_RLE = 3,
+  ENC_RLE_DICTIONARY = 8
+};
+
+//! Parquet page types.
+enum PageType
+{
+  PAGE_DATA = 0,
+  PAGE_DICTIONARY = 2
+};
+
+//! Parquet GZIP compression codec.
+static const int c_codec_gzip = 2;
+
+//! Writer of Thrift compact protocol structures, as used by Parquet
+//! metadata.
+class ThriftWriter
+{
+public:
+  //! Compact protocol types.
+  enum Type
+  {
+    T_I32 = 5,
+    T_I64 = 6,
+    T_BINARY = 8,
+    T_LIST = 9,
+    T_STRUCT = 12
+  };
+
+  ThriftWriter(std::vector<uint8_t>& out):
+    m_out(out)
+  { }
+
+  void
+  structBegin(void)
+  {
+    m_last.push_back(0);
+  }
+
+  void
+  structEnd(void)
+  {
+    m_out.push_back(0);
+    m_last.pop_back();
+  }
+
+  void
+  fieldI32(int16_t id, int32_t value)
+  {
+    fieldHeader(id, T_I32);
+    i32(value);
+  }
+
+  void
+  fieldI64(int16_t id, int64_t value)
+  {
+    fieldHeader(id, T_I64);
+    varint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+  }
+
+  void
+  fieldBinary(int16_t id, const std::string& value)
+  {
+    fieldHeader(id, T_BINARY);
+    binary(value);
+  }
+
+  //! Start a structure field, to be closed with structEnd().
+  void
+  fieldStruct(int16_t id)
+  {
+    fieldHeader(id, T_STRUCT);
+    structBegin();
+  }
+
+  //! Start a list field, followed by its elements.
+  void
+  fieldList(int16_t id, Type type, unsigned size)
+  {
+    fieldHeader(id, T_LIST);
+
+    if (size < 15)
+    {
+      m_out.push_back((uint8_t)((size << 4) | type));
+    }
+    else
+    {
+      m_out.push_back((uint8_t)(0xf0 | type));
+      varint(size);
+    }
+  }
+
+  void
+  i32(int32_t value)
+  {
+    varint((uint32_t)(((uint32_t)value << 1) ^ (uint32_t)(value >> 31)));
+  }
+
+  void
+  binary(const std::string& value)
+  {
+    varint(value.size());
+    m_out.insert(m_out.end(), value.begin(), value.end());
+  }
+
+private:
+  //! Output buffer.
+  std::vector<uint8_t>& m_out;
+  //! Last field identifier of each open structure.
+  std::vector<int16_t> m_last;
+
+  void
+  fieldHeader(int16_t id, Type type)
+  {
+    int delta = id - m_last.back();
+
+    if (delta > 0 && delta <= 15)
+    {
+      m_out.push_back((uint8_t)((delta << 4) | type));
+    }
+    else
+    {
+      m_out.push_back((uint8_t)type);
+      i32(id);
+    }
+
+    m_last.back() = id;
+  }
+
+  void
+  varint(uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      m_out.push_back((uint8_t)(value | 0x80));
+      value >>= 7;
+    }
+
+    m_out.push_back((uint8_t)value);
+  }
+};
+
+//! Append an unsigned LEB128 integer.
+static void
+putVarint(std::vector<uint8_t>& out, uint32_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back((uint8_t)(value | 0x80));
+    value >>= 7;
+  }
+
+  out.push_back((uint8_t)value);
+}
+
+//! Encode values with the Parquet RLE/bit-packing hybrid encoding.
+//! Runs of at least eight equal values are run length encoded, other
+//! values are bit packed in groups of eight.
+//! @param[in] values values.
+//! @param[in] width bit width.
+//! @param[out] out output buffer.
+static void
+encodeHybrid(const std::vector<uint32_t>& values, unsigned width, std::vector<uint8_t>& out)
+{
+  size_t n = values.size();
+  size_t i = 0;
+
+  while (i < n)
+  {
+    size_t j = i;
+    while (j < n && values[j] == values[i])
+      ++j;
+
+    if (j - i >= 8)
+    {
+      putVarint(out, (uint32_t)((j - i) << 1));
+      for (unsigned k = 0; k < (width + 7) / 8; ++k)
+        out.push_back((uint8_t)(values[i] >> (8 * k)));
+      i = j;
+      continue;
+    }
+
+    // Bit pack groups until a long run starts at a group boundary.
+    size_t start = i;
+    unsigned groups = 0;
+    while (i < n && groups < 63)
+    {
+      j = i;
+      while (j < n && values[j] == values[i] && j - i < 8)
+        ++j;
+
+      if (j - i >= 8)
+        break;
+
+      i += 8;
+      ++groups;
+    }
+
+    putVarint(out, (groups << 1) | 1);
+
+    uint64_t acc = 0;
+    unsigned bits = 0;
+    for (size_t k = start; k < start + groups * 8; ++k)
+    {
+      acc |= (uint64_t)(k < n ? values[k] : 0) << bits;
+      bits += width;
+      while (bits >= 8)
+      {
+        out.push_back((uint8_t)acc);
+        acc >>= 8;
+        bits -= 8;
+      }
+    }
+
+    i = std::min(i, n);
+  }
+}
+
+//! Column of a Parquet file. Values of the current row group are
+//! kept in memory in Parquet's plain encoding, or as dictionary
+//! indices for dictionary columns.
+class Column
+{
+public:
+  //! Column state, used to undo partially appended rows.
+  struct State
+  {
+    size_t data;
+    size_t indices;
+    unsigned count;
+  };
+
+  //! Metadata of a column chunk.
+  struct Chunk
+  {
+    int64_t offset;
+    int64_t dictionary_offset;
+    int64_t values;
+    int64_t size;
+    int64_t compressed_size;
+  };
+
+  Column(const std::string& name, PhysicalType type, ConvertedType converted, bool dictionary):
+    m_name(name),
+    m_type(type),
+    m_converted(converted),
+    m_dictionary(dictionary),
+    m_count(0)
+  { }
+
+  const std::string&
+  getName(void) const
+  {
+    return m_name;
+  }
+
+  PhysicalType
+  getType(void) const
+  {
+    return m_type;
+  }
+
+  ConvertedType
+  getConvertedType(void) const
+  {
+    return m_converted;
+  }
+
+  bool
+  isDictionary(void) const
+  {
+    return m_dictionary;
+  }
+
+  const std::vector<Chunk>&
+  getChunks(void) const
+  {
+    return m_chunks;
+  }
+
+  void
+  putInt32(int32_t value)
+  {
+    put(value);
+  }
+
+  void
+  putInt64(int64_t value)
+  {
+    put(value);
+  }
+
+  void
+  putFloat(fp32_t value)
+  {
+    put(value);
+  }
+
+  void
+  putDouble(fp64_t value)
+  {
+    put(value);
+  }
+
+  void
+  putBytes(const uint8_t* data, size_t size)
+  {
+    ++m_count;
+
+    if (m_dictionary)
+    {
+      std::string value((const char*)data, size);
+      std::map<std::string, uint32_t>::iterator itr = m_dict.find(value);
+      if (itr == m_dict.end())
+      {
+        itr = m_dict.insert(std::make_pair(value, (uint32_t)m_dict_values.size())).first;
+        m_dict_values.push_back(value);
+      }
+
+      m_indices.push_back(itr->second);
+      return;
+    }
+
+    uint8_t len[4];
+    ByteCopy::toLE((uint32_t)size, len);
+    m_data.insert(m_data.end(), len, len + 4);
+    m_data.insert(m_data.end(), data, data + size);
+  }
+
+  void
+  putString(const std::string& value)
+  {
+    putBytes((const uint8_t*)value.data(), value.size());
+  }
+
+  State
+  save(void) const
+  {
+    State state;
+    state.data = m_data.size();
+    state.indices = m_indices.size();
+    state.count = m_count;
+    return state;
+  }
+
+  void
+  restore(const State& state)
+  {
+    m_data.resize(state.data);
+    m_indices.resize(state.indices);
+    m_count = state.count;
+  }
+
+  //! Write the pages of the current row group.
+  //! @param[in] os output file.
+  //! @param[in] gzip compressor.
+  void
+  flush(std::ofstream& os, Compression::Compressor& gzip)
+  {
+    Chunk chunk;
+    chunk.offset = os.tellp();
+    chunk.dictionary_offset = -1;
+    chunk.values = m_count;
+    chunk.size = 0;
+    chunk.compressed_size = 0;
+
+    if (m_dictionary)
+    {
+      std::vector<uint8_t> dict;
+      for (unsigned i = 0; i < m_dict_values.size(); ++i)
+      {
+        uint8_t len[4];
+        ByteCopy::toLE((uint32_t)m_dict_values[i].size(), len);
+        dict.insert(dict.end(), len, len + 4);
+        dict.insert(dict.end(), m_dict_values[i].begin(), m_dict_values[i].end());
+      }
+
+      chunk.dictionary_offset = chunk.offset;
+      writePage(os, gzip, PAGE_DICTIONARY, dict, m_dict_values.size(), ENC_PLAIN, chunk);
+
+      unsigned width = 1;
+      while (width < 32 && (1U << width) < m_dict_values.size())
+        ++width;
+
+      m_data.clear();
+      m_data.push_back((uint8_t)width);
+      encodeHybrid(m_indices, width, m_data);
+    }
+
+    int64_t data_offset = os.tellp();
+    writePage(os, gzip, PAGE_DATA, m_data, m_count, m_dictionary ? ENC_RLE_DICTIONARY : ENC_PLAIN, chunk);
+
+    if (m_dictionary)
+      chunk.offset = data_offset;
+
+    m_chunks.push_back(chunk);
+
+    m_data.clear();
+    m_indices.clear();
+    m_dict.clear();
+    m_dict_values.clear();
+    m_count = 0;
+  }
+
+private:
+  //! Column name.
+  std::string m_name;
+  //! Physical type.
+  PhysicalType m_type;
+  //! Converted type.
+  ConvertedType m_converted;
+  //! True if values are dictionary encoded.
+  bool m_dictionary;
+  //! Plain encoded values.
+  std::vector<uint8_t> m_data;
+  //! Dictionary indices.
+  std::vector<uint32_t> m_indices;
+  //! Dictionary.
+  std::map<std::string, uint32_t> m_dict;
+  //! Dictionary values, by index.
+  std::vector<std::string> m_dict_values;
+  //! Number of values.
+  unsigned m_count;
+  //! Written column chunks.
+  std::vector<Chunk> m_chunks;
+
+  template <typename T>
+  void
+  put(T value)
+  {
+    uint8_t bfr[sizeof(T)];
+    IMC::serialize(value, bfr);
+#if defined(DUNE_CPU_BIG_ENDIAN)
+    std::reverse(bfr, bfr + sizeof(T));
+#endif
+    m_data.insert(m_data.end(), bfr, bfr + sizeof(T));
+    ++m_count;
+  }
+
+  void
+  writePage(std::ofstream& os, Compression::Compressor& gzip, PageType type,
+            std::vector<uint8_t>& data, unsigned count, Encoding encoding, Chunk& chunk)
+  {
+    Utils::ByteBuffer compressed;
+    if (data.empty())
+      data.push_back(0);
+    gzip.compress(compressed, (char*)&data[0], data.size());
+
+    std::vector<uint8_t> header;
+    ThriftWriter w(header);
+    w.structBegin();
+    w.fieldI32(1, type);
+    w.fieldI32(2, (int32_t)data.size());
+    w.fieldI32(3, (int32_t)compressed.getSize());
+
+    if (type == PAGE_DATA)
+    {
+      w.fieldStruct(5);
+      w.fieldI32(1, count);
+      w.fieldI32(2, encoding);
+      w.fieldI32(3, ENC_RLE);
+      w.fieldI32(4, ENC_RLE);
+      w.structEnd();
+    }
+    else
+    {
+      w.fieldStruct(7);
+      w.fieldI32(1, count);
+      w.fieldI32(2, encoding);
+      w.structEnd();
+    }
+
+    w.structEnd();
+
+    os.write((const char*)&header[0], header.size());
+    os.write(compressed.getBufferSigned(), compressed.getSize());
+
+    chunk.size += header.size() + data.size();
+    chunk.compressed_size += header.size() + compressed.getSize();
+  }
+};
+
+//! Parquet file holding the packets of one message.
+class Table
+{
+public:
+  //! Constructor.
+  //! @param[in] path file path.
+  //! @param[in] def message definition.
+  //! @param[in] group_rows number of rows per row group.
+  Table(const Path& path, const IMC::Schema::Definition& def, unsigned group_rows):
+    m_ofs(path.c_str(), std::ios::binary),
+    m_def(def),
+    m_group_rows(group_rows),
+    m_rows(0),
+    m_total_rows(0)
+  {
+    m_ofs.write(c_magic, 4);
+
+    m_header.push_back(new Column("timestamp", PT_DOUBLE, CT_NONE, false));
+    m_header.push_back(new Column("src", PT_INT32, CT_UINT_16, false));
+    m_header.push_back(new Column("src_ent", PT_INT32, CT_UINT_8, false));
+    m_header.push_back(new Column("src_ent_label", PT_BYTE_ARRAY, CT_UTF8, true));
+    m_header.push_back(new Column("dst", PT_INT32, CT_UINT_16, false));
+    m_header.push_back(new Column("dst_ent", PT_INT32, CT_UINT_8, false));
+    m_columns = m_header;
+
+    for (unsigned i = 0; i < def.fields.size(); ++i)
+      m_columns.push_back(createColumn(def.fields[i]));
+  }
+
+  ~Table(void)
+  {
+    close();
+
+    for (unsigned i = 0; i < m_columns.size(); ++i)
+      delete m_columns[i];
+  }
+
+  //! Append a packet.
+  //! @param[in] record packet.
+  //! @param[in] label label of the source entity.
+  //! @return true if the packet was appended, false if its payload
+  //! does not match the message definition.
+  bool
+  append(const IMC::LogReader::Record& record, const std::string& label)
+  {
+    std::vector<Column::State> states(m_columns.size());
+    for (unsigned i = 0; i < m_columns.size(); ++i)
+      states[i] = m_columns[i]->save();
+
+    const IMC::Header& hdr = record.getHeader();
+    m_header[0]->putDouble(hdr.timestamp);
+    m_header[1]->putInt32(hdr.src);
+    m_header[2]->putInt32(hdr.src_ent);
+    m_header[3]->putString(label);
+    m_header[4]->putInt32(hdr.dst);
+    m_header[5]->putInt32(hdr.dst_ent);
+
+    bool reversed = (hdr.sync == DUNE_IMC_CONST_SYNC_REV);
+    const uint8_t* ptr = record.getData() + DUNE_IMC_CONST_HEADER_SIZE;
+    const uint8_t* end = ptr + hdr.size;
+
+    try
+    {
+      for (unsigned i = 0; i < m_def.fields.size(); ++i)
+        ptr = decode(*m_columns[m_header.size() + i], m_def.fields[i].type, ptr, end, reversed);
+    }
+    catch (std::exception& e)
+    {
+      (void)e;
+
+      for (unsigned i = 0; i < m_columns.size(); ++i)
+        m_columns[i]->restore(states[i]);
+      return false;
+    }
+
+    if (++m_rows == m_group_rows)
+      flush();
+
+    return true;
+  }
+
+  //! Write the pending rows and the file footer.
+  void
+  close(void)
+  {
+    if (!m_ofs.is_open())
+      return;
+
+    flush();
+
+    std::vector<uint8_t> meta;
+    ThriftWriter w(meta);
+    w.structBegin();
+    w.fieldI32(1, 1);
+
+    w.fieldList(2, ThriftWriter::T_STRUCT, m_columns.size() + 1);
+    w.structBegin();
+    w.fieldBinary(4, "schema");
+    w.fieldI32(5, m_columns.size());
+    w.structEnd();
+
+    for (unsigned i = 0; i < m_columns.size(); ++i)
+    {
+      w.structBegin();
+      w.fieldI32(1, m_columns[i]->getType());
+      // Required field.
+      w.fieldI32(3, 0);
+      w.fieldBinary(4, m_columns[i]->getName());
+      if (m_columns[i]->getConvertedType() != CT_NONE)
+        w.fieldI32(6, m_columns[i]->getConvertedType());
+      w.structEnd();
+    }
+
+    w.fieldI64(3, m_total_rows);
+
+    w.fieldList(4, ThriftWriter::T_STRUCT, m_groups.size());
+    for (unsigned g = 0; g < m_groups.size(); ++g)
+    {
+      int64_t size = 0;
+
+      w.structBegin();
+      w.fieldList(1, ThriftWriter::T_STRUCT, m_columns.size());
+      for (unsigned i = 0; i < m_columns.size(); ++i)
+      {
+        const Column::Chunk& chunk = m_columns[i]->getChunks()[g];
+        size += chunk.size;
+        writeChunk(w, *m_columns[i], chunk);
+      }
+
+      w.fieldI64(2, size);
+      w.fieldI64(3, m_groups[g]);
+      w.structEnd();
+    }
+
+    w.fieldBinary(6, std::string("DUNE ") + getFullVersion());
+    w.structEnd();
+
+    uint8_t len[4];
+    ByteCopy::toLE((uint32_t)meta.size(), len);
+    m_ofs.write((const char*)&meta[0], meta.size());
+    m_ofs.write((const char*)len, 4);
+    m_ofs.write(c_magic, 4);
+    m_ofs.close();
+  }
+
+private:
+  //! Output file.
+  std::ofstream m_ofs;
+  //! Message definition.
+  IMC::Schema::Definition m_def;
+  //! Header columns.
+  std::vector<Column*> m_header;
+  //! All columns.
+  std::vector<Column*> m_columns;
+  //! Number of rows per row group.
+  unsigned m_group_rows;
+  //! Number of rows of the current row group.
+  unsigned m_rows;
+  //! Number of written rows.
+  int64_t m_total_rows;
+  //! Number of rows of written row groups.
+  std::vector<int64_t> m_groups;
+  //! Page compressor.
+  Compression::GzipCompressor m_gzip;
+
+  static Column*
+  createColumn(const IMC::Schema::Field& field)
+  {
+    switch (field.type)
+    {
+      case IMC::Schema::TYPE_INT8:
+        return new Column(field.abbrev, PT_INT32, CT_INT_8, false);
+      case IMC::Schema::TYPE_UINT8:
+        return new Column(field.abbrev, PT_INT32, CT_UINT_8, false);
+      case IMC::Schema::TYPE_INT16:
+        return new Column(field.abbrev, PT_INT32, CT_INT_16, false);
+      case IMC::Schema::TYPE_UINT16:
+        return new Column(field.abbrev, PT_INT32, CT_UINT_16, false);
+      case IMC::Schema::TYPE_INT32:
+        return new Column(field.abbrev, PT_INT32, CT_NONE, false);
+      case IMC::Schema::TYPE_UINT32:
+      case IMC::Schema::TYPE_INT64:
+        return new Column(field.abbrev, PT_INT64, CT_NONE, false);
+      case IMC::Schema::TYPE_FP32:
+        return new Column(field.abbrev, PT_FLOAT, CT_NONE, false);
+      case IMC::Schema::TYPE_FP64:
+        return new Column(field.abbrev, PT_DOUBLE, CT_NONE, false);
+      case IMC::Schema::TYPE_RAWDATA:
+        return new Column(field.abbrev, PT_BYTE_ARRAY, CT_NONE, false);
+      case IMC::Schema::TYPE_PLAINTEXT:
+        return new Column(field.abbrev, PT_BYTE_ARRAY, CT_UTF8, true);
+      default:
+        // Inline messages and message lists are stored as JSON.
+        return new Column(field.abbrev, PT_BYTE_ARRAY, CT_UTF8, false);
+    }
+  }
+
+  //! Read an integer from a payload.
+  template <typename T>
+  static const uint8_t*
+  read(T& value, const uint8_t* ptr, const uint8_t* end, bool reversed)
+  {
+    uint16_t len = (uint16_t)std::min<ptrdiff_t>(end - ptr, sizeof(T));
+
+    if (reversed)
+      return ptr + IMC::reverseDeserialize(value, ptr, len);
+
+    return ptr + IMC::deserialize(value, ptr, len);
+  }
+
+  //! Read a byte from a payload.
+  template <typename T>
+  static const uint8_t*
+  readByte(T& value, const uint8_t* ptr, const uint8_t* end)
+  {
+    uint16_t len = (uint16_t)std::min<ptrdiff_t>(end - ptr, 1);
+    return ptr + IMC::deserialize(value, ptr, len);
+  }
+
+  //! Decode an inline message and append its JSON form.
+  static const uint8_t*
+  readMessage(Utils::ByteBuffer& json, const uint8_t* ptr, const uint8_t* end, bool reversed)
+  {
+    uint16_t id = 0;
+    ptr = read(id, ptr, end, reversed);
+
+    if (id == DUNE_IMC_CONST_NULL_ID)
+    {
+      json.appendSigned("null", 4);
+      return ptr;
+    }
+
+    IMC::Message* msg = IMC::Factory::produce(id);
+    if (msg == NULL)
+      throw IMC::InvalidMessageId(id);
+
+    try
+    {
+      uint16_t len = (uint16_t)(end - ptr);
+      ptr += reversed ? msg->reverseDeserializeFields(ptr, len) : msg->deserializeFields(ptr, len);
+      msg->toJSON(json);
+    }
+    catch (...)
+    {
+      delete msg;
+      throw;
+    }
+
+    delete msg;
+    return ptr;
+  }
+
+  //! Decode a field and append it to a column.
+  static const uint8_t*
+  decode(Column& col, IMC::Schema::Type type, const uint8_t* ptr, const uint8_t* end, bool reversed)
+  {
+    switch (type)
+    {
+      case IMC::Schema::TYPE_INT8:
+        {
+          int8_t v = 0;
+          ptr = readByte(v, ptr, end);
+          col.putInt32(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_UINT8:
+        {
+          uint8_t v = 0;
+          ptr = readByte(v, ptr, end);
+          col.putInt32(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_INT16:
+        {
+          int16_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putInt32(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_UINT16:
+        {
+          uint16_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putInt32(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_INT32:
+        {
+          int32_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putInt32(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_UINT32:
+        {
+          uint32_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putInt64(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_INT64:
+        {
+          int64_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putInt64(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_FP32:
+        {
+          fp32_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putFloat(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_FP64:
+        {
+          fp64_t v = 0;
+          ptr = read(v, ptr, end, reversed);
+          col.putDouble(v);
+          return ptr;
+        }
+      case IMC::Schema::TYPE_RAWDATA:
+      case IMC::Schema::TYPE_PLAINTEXT:
+        {
+          uint16_t len = 0;
+          ptr = read(len, ptr, end, reversed);
+          if (end - ptr < len)
+            throw IMC::BufferTooShort();
+          col.putBytes(ptr, len);
+          return ptr + len;
+        }
+      case IMC::Schema::TYPE_MESSAGE:
+        {
+          Utils::ByteBuffer json;
+          ptr = readMessage(json, ptr, end, reversed);
+          col.putBytes(json.getBuffer(), json.getSize());
+          return ptr;
+        }
+      case IMC::Schema::TYPE_MESSAGE_LIST:
+        {
+          uint16_t count = 0;
+          ptr = read(count, ptr, end, reversed);
+
+          Utils::ByteBuffer json;
+          json.appendSigned("[", 1);
+          for (unsigned i = 0; i < count; ++i)
+          {
+            if (i > 0)
+              json.appendSigned(",", 1);
+            ptr = readMessage(json, ptr, end, reversed);
+          }
+          json.appendSigned("]", 1);
+
+          col.putBytes(json.getBuffer(), json.getSize());
+          return ptr;
+        }
+    }
+
+    return ptr;
+  }
+
+  void
+  flush(void)
+  {
+    if (m_rows == 0 && !m_groups.empty())
+      return;
+
+    for (unsigned i = 0; i < m_columns.size(); ++i)
+      m_columns[i]->flush(m_ofs, m_gzip);
+
+    m_groups.push_back(m_rows);
+    m_total_rows += m_rows;
+    m_rows = 0;
+  }
+
+  static void
+  writeChunk(ThriftWriter& w, const Column& col, const Column::Chunk& chunk)
+  {
+    int64_t first = (chunk.dictionary_offset >= 0) ? chunk.dictionary_offset : chunk.offset;
+
+    w.structBegin();
+    w.fieldI64(2, first);
+    w.fieldStruct(3);
+    w.fieldI32(1, col.getType());
+
+    if (col.isDictionary())
+    {
+      w.fieldList(2, ThriftWriter::T_I32, 3);
+      w.i32(ENC_PLAIN);
+      w.i32(ENC_RLE);
+      w.i32(ENC_RLE_DICTIONARY);
+    }
+    else
+    {
+      w.fieldList(2, ThriftWriter::T_I32, 2);
+      w.i32(ENC_PLAIN);
+      w.i32(ENC_RLE);
+    }
+
+    w.fieldList(3, ThriftWriter::T_BINARY, 1);
+    w.binary(col.getName());
+    w.fieldI32(4, c_codec_gzip);
+    w.fieldI64(5, chunk.values);
+    w.fieldI64(6, chunk.size);
+    w.fieldI64(7, chunk.compressed_size);
+    w.fieldI64(9, chunk.offset);
+    if (chunk.dictionary_offset >= 0)
+      w.fieldI64(11, chunk.dictionary_offset);
+    w.structEnd();
+    w.structEnd();
+  }
+};
+
+//! Convert a log.
+//! @param[in] log path of the log.
+//! @param[in] dir output directory.
+//! @param[in] ids messages to convert (empty for all).
+//! @param[in] group_rows number of rows per row group.
+//! @param[in] xml IMC XML document to use (empty to use the one
+//! stored with the log, or the built in one).
+//! @return true if the whole log was converted, false otherwise.
+static bool
+convert(const Path& log, const Path& dir, const std::set<uint16_t>& ids,
+        unsigned group_rows, const std::string& xml)
+{
+  Path stored = log.dirname() / "IMC.xml.gz";
+  IMC::Schema* schema = NULL;
+
+  if (!xml.empty())
+    schema = new IMC::Schema(xml);
+  else if (stored.isFile())
+    schema = new IMC::Schema(stored.str());
+  else
+    schema = new IMC::Schema();
+
+  dir.create();
+
+  // Entity labels are needed even if EntityInfo is not converted.
+  std::set<uint16_t> filter(ids);
+  if (!filter.empty())
+    filter.insert(DUNE_IMC_ENTITYINFO);
+
+  std::map<uint16_t, Table*> tables;
+  std::map<uint32_t, std::string> labels;
+  std::map<uint16_t, unsigned> unknown;
+  unsigned malformed = 0;
+  bool ok = true;
+
+  try
+  {
+    IMC::LogReader reader(log.str());
+    reader.setFilter(filter);
+
+    const IMC::LogReader::Record* record = NULL;
+    while ((record = reader.next()) != NULL)
+    {
+      uint16_t id = record->getId();
+
+      if (id == DUNE_IMC_ENTITYINFO)
+      {
+        IMC::Message* msg = record->decode();
+        const IMC::EntityInfo* info = static_cast<const IMC::EntityInfo*>(msg);
+        labels[((uint32_t)info->getSource() << 8) | info->id] = info->label;
+        delete msg;
+
+        if (!ids.empty() && ids.find(id) == ids.end())
+          continue;
+      }
+
+      std::map<uint16_t, Table*>::iterator itr = tables.find(id);
+      if (itr == tables.end())
+      {
+        const IMC::Schema::Definition* def = schema->find(id);
+        if (def == NULL)
+        {
+          ++unknown[id];
+          continue;
+        }
+
+        Table* table = new Table(dir / (def->abbrev + ".parquet"), *def, group_rows);
+        itr = tables.insert(std::make_pair(id, table)).first;
+      }
+
+      uint32_t key = ((uint32_t)record->getSource() << 8) | record->getSourceEntity();
+      std::map<uint32_t, std::string>::const_iterator label = labels.find(key);
+
+      if (!itr->second->append(*record, (label == labels.end()) ? std::string() : label->second))
+        ++malformed;
+    }
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << log << ": " << e.what() << std::endl;
+    ok = false;
+  }
+
+  std::map<uint16_t, Table*>::iterator itr = tables.begin();
+  for (; itr != tables.end(); ++itr)
+    delete itr->second;
+
+  std::map<uint16_t, unsigned>::const_iterator uitr = unknown.begin();
+  for (; uitr != unknown.end(); ++uitr)
+    std::cerr << log << ": " << uitr->second << " packets of undefined message " << uitr->first << std::endl;
+
+  if (malformed > 0)
+    std::cerr << log << ": " << malformed << " packets do not match their definition" << std::endl;
+
+  delete schema;
+  return ok;
+}
+
+static void
+usage(void)
+{
+  std::cerr << "Usage:\n\t dune-lsf2parquet [options] f1 ... fn\n"
+            << "Options:\n\t-o dir: output directory (default is the current directory)\n"
+            << "\t-m msg1,...,msgn: only convert specified messages\n"
+            << "\t-x file: IMC XML definitions (IMC.xml or IMC.xml.gz)\n"
+            << "\t-r rows: rows per row group (default is " << c_default_group_rows << ")\n\n"
+            << "f1 ... fn can be:\n"
+            << "\t* block LSF logs (.blk extension)\n"
+            << "\t* gzipped or bzipped LSF files (.gz or .bz2 extension)\n"
+            << "\t* LLF log dir names (will look for Data.lsf.blk, Data.lsf\n"
+            << "\t  and Data.lsf.gz in it)\n"
+            << "\t* plain LSF files\n"
+            << "Each log is written to a directory named after the log\n"
+            << "directory, with one GZIP compressed Parquet file per message.\n"
+            << "Columns are the header fields (timestamp, src, src_ent,\n"
+            << "src_ent_label, dst, dst_ent) followed by the message fields.\n"
+            << "Unless -x is given, definitions are read from the IMC.xml.gz\n"
+            << "stored with the log, or the ones built into DUNE.\n";
+}
+
+//! Find the log of an LLF log directory.
+//! @param[in] dir log directory.
+//! @return path of the log.
+static Path
+findLog(const Path& dir)
+{
+  static const char* c_names[] = {"Data.lsf.blk", "Data.lsf", "Data.lsf.gz", "Data.lsf.bz2"};
+
+  for (unsigned i = 0; i < sizeof(c_names) / sizeof(c_names[0]); ++i)
+  {
+    Path file = dir / c_names[i];
+    if (file.isFile())
+      return file;
+  }
+
+  return dir / "Data.lsf";
+}
+
+int
+main(int argc, char** argv)
+{
+  Path output(".");
+  std::set<uint16_t> ids;
+  std::string xml;
+  unsigned group_rows = c_default_group_rows;
+
+  ++argv; --argc;
+
+  for (; *argv && **argv == '-'; ++argv, --argc)
+  {
+    char opt = (*argv)[1];
+    ++argv; --argc;
+
+    if (!*argv || **argv == '-')
+    {
+      std::cerr << "Invalid options\n";
+      usage();
+      return 1;
+    }
+
+    switch (opt)
+    {
+      case 'o':
+        output = Path(*argv);
+        break;
+      case 'x':
+        xml = *argv;
+        break;
+      case 'r':
+      {
+        char* aux;
+        long value = std::strtol(*argv, &aux, 10);
+        if (*aux != 0 || value <= 0)
+        {
+          std::cerr << "Invalid number of rows: " << *argv << '\n';
+          usage();
+          return 1;
+        }
+        group_rows = (unsigned)value;
+        break;
+      }
+      case 'm':
+      {
+        std::vector<std::string> list;
+        Utils::String::split(*argv, ",", list);
+        try
+        {
+          for (unsigned i = 0; i < list.size(); ++i)
+            ids.insert(IMC::Factory::getIdFromAbbrev(list[i]));
+        }
+        catch (std::exception& e)
+        {
+          std::cerr << e.what() << '\n';
+          usage();
+          return 1;
+        }
+        break;
+      }
+      default:
+        std::cerr << "Invalid option: '-" << opt << "\'\n";
+        usage();
+        return 1;
+    }
+  }
+
+  if (argc < 1)
+  {
+    std::cerr << "Invalid arguments" << std::endl;
+    usage();
+    return 1;
+  }
+
+  int rv = 0;
+
+  for (; *argv != 0; argv++)
+  {
+    Path file(*argv);
+
+    if (file.isDirectory())
+      file = findLog(file);
+
+    if (!file.isFile())
+    {
+      std::cerr << file << " does not exist\n";
+      rv = 1;
+      continue;
+    }
+
+    Path name = file.absolute().dirname(false).basename();
+
+    try
+    {
+      if (!convert(file, output / name, ids, group_rows, xml))
+        rv = 1;
+    }
+    catch (std::exception& e)
+    {
+      std::cerr << file << ": " << e.what() << std::endl;
+      rv = 1;
+    }
+  }
+
+  return rv;
+}
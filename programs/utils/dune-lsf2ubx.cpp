@@ -31,6 +31,7 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -48,31 +49,27 @@ main(int argc, char** argv)
     return 1;
   }
 
-  std::istream* is = 0;
-  Compression::Methods method = Compression::Factory::detect(argv[1]);
-  if (method == METHOD_UNKNOWN)
-    is = new std::ifstream(argv[1], std::ios::binary);
-  else
-    is = new Compression::FileInput(argv[1], method);
+  DUNE::IMC::LogReader reader(argv[1]);
+  std::set<uint16_t> ids;
+  ids.insert(DUNE_IMC_DEVDATABINARY);
+  reader.setFilter(ids);
 
   std::ofstream ofs(argv[2], std::ios::binary);
 
-  DUNE::IMC::Message* msg = 0;
+  const DUNE::IMC::LogReader::Record* record = NULL;
+  DUNE::IMC::DevDataBinary ddb;
 
   try
   {
-    while ((msg = DUNE::IMC::Packet::deserialize(*is)) != 0)
+    while ((record = reader.next()) != NULL)
     {
-      if (msg->getId() == DUNE_IMC_DEVDATABINARY)
-      {
-        DUNE::IMC::DevDataBinary* ddb = (DUNE::IMC::DevDataBinary*)msg;
+      record->decode(ddb);
 
-        if (ddb->value.size() < 2)
-          continue;
+      if (ddb.value.size() < 2)
+        continue;
 
-        if ((uint8_t)ddb->value[0] == c_ubx_sync0 && (uint8_t)ddb->value[1] == c_ubx_sync1)
-          ofs.write(&ddb->value[0], ddb->value.size());
-      }
+      if ((uint8_t)ddb.value[0] == c_ubx_sync0 && (uint8_t)ddb.value[1] == c_ubx_sync1)
+        ofs.write(&ddb.value[0], ddb.value.size());
     }
   }
   catch (std::runtime_error& e)
@@ -80,7 +77,5 @@ main(int argc, char** argv)
     std::cerr << "ERROR: " << e.what() << std::endl;
   }
 
-  delete is;
-
   return 0;
 }
@@ -0,0 +1,222 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Default dictionary size (deflate window).
+static const unsigned long c_default_size = 32768;
+
+static void
+usage(void)
+{
+  std::cerr << "Usage: dune-lsfdict [options] <output> <log> [log ...]\n"
+            << "Options:\n"
+            << "\t-s <size>\tmaximum dictionary size (default: " << c_default_size << ")\n"
+            << "\t-m <msgs>\tcomma separated list of messages to sample (default: all)\n"
+            << "\t-b <count>\tnumber of packets per sample (default: 1)\n"
+            << "Trains a compression dictionary from the packets of LSF logs.\n"
+            << "Samples should match what is compressed at once, e.g., single\n"
+            << "packets for transports sending one message at a time. The\n"
+            << "dictionary is used by the 'deflate' and 'zstd' methods.\n";
+}
+
+//! Parse an option value.
+//! @param[in] str value.
+//! @param[out] value parsed value.
+//! @return true if the value is a positive number, false otherwise.
+static bool
+parseValue(const char* str, unsigned long& value)
+{
+  char* aux;
+  long rv = std::strtol(str, &aux, 10);
+  if (*aux != 0 || rv <= 0)
+    return false;
+
+  value = (unsigned long)rv;
+  return true;
+}
+
+//! Size of the samples compressed with a compressor.
+//! @param[in] comp compressor.
+//! @param[in] samples samples.
+//! @return total compressed size.
+static unsigned long
+compressedSize(Compression::Compressor& comp, std::vector<std::string>& samples)
+{
+  unsigned long total = 0;
+  for (unsigned i = 0; i < samples.size(); ++i)
+    total += comp.compress(&samples[i][0], samples[i].size()).getSize();
+
+  return total;
+}
+
+int
+main(int argc, char** argv)
+{
+  unsigned long size = c_default_size;
+  unsigned long batch = 1;
+  std::set<uint16_t> ids;
+
+  ++argv; --argc;
+
+  for (; *argv && **argv == '-'; ++argv, --argc)
+  {
+    char opt = (*argv)[1];
+
+    ++argv; --argc;
+
+    if (!*argv)
+    {
+      std::cerr << "Invalid options\n";
+      usage();
+      return 1;
+    }
+
+    switch (opt)
+    {
+      case 's':
+        if (!parseValue(*argv, size))
+        {
+          std::cerr << "Invalid dictionary size: " << *argv << '\n';
+          return 1;
+        }
+        break;
+      case 'b':
+        if (!parseValue(*argv, batch))
+        {
+          std::cerr << "Invalid number of packets: " << *argv << '\n';
+          return 1;
+        }
+        break;
+      case 'm':
+      {
+        std::vector<std::string> names;
+        Utils::String::split(*argv, ",", names);
+        try
+        {
+          for (unsigned i = 0; i < names.size(); ++i)
+            ids.insert(IMC::Factory::getIdFromAbbrev(names[i]));
+        }
+        catch (std::exception& e)
+        {
+          std::cerr << e.what() << '\n';
+          return 1;
+        }
+        break;
+      }
+      default:
+        std::cerr << "Invalid option: '-" << opt << "\'\n";
+        usage();
+        return 1;
+    }
+  }
+
+  if (argc < 2)
+  {
+    std::cerr << "Invalid arguments\n";
+    usage();
+    return 1;
+  }
+
+  const char* output = *argv++;
+  Compression::DictionaryTrainer trainer;
+  std::vector<std::string> samples;
+  std::string sample;
+  unsigned long packets = 0;
+
+  for (; *argv != 0; ++argv)
+  {
+    try
+    {
+      IMC::LogReader reader(*argv);
+      if (!ids.empty())
+        reader.setFilter(ids);
+
+      const IMC::LogReader::Record* record = NULL;
+      while ((record = reader.next()) != NULL)
+      {
+        sample.append((const char*)record->getData(), record->getSize());
+
+        if (++packets % batch == 0)
+        {
+          trainer.addSample(sample.data(), sample.size());
+          samples.push_back(sample);
+          sample.clear();
+        }
+      }
+    }
+    catch (std::exception& e)
+    {
+      std::cerr << *argv << ": " << e.what() << '\n';
+      return 1;
+    }
+  }
+
+  if (!sample.empty())
+  {
+    trainer.addSample(sample.data(), sample.size());
+    samples.push_back(sample);
+  }
+
+  if (samples.empty())
+  {
+    std::cerr << "No packets found\n";
+    return 1;
+  }
+
+  std::string dictionary = trainer.train(size);
+
+  std::ofstream ofs(output, std::ios::binary);
+  ofs.write(dictionary.data(), dictionary.size());
+  if (!ofs)
+  {
+    std::cerr << "Unable to write " << output << '\n';
+    return 1;
+  }
+
+  Compression::DeflateCompressor plain;
+  Compression::DeflateCompressor trained(-1, dictionary);
+
+  std::cout << "Packets: " << packets << '\n'
+            << "Samples: " << samples.size() << " (" << trainer.getSampleSize() << " bytes)\n"
+            << "Dictionary: " << dictionary.size() << " bytes\n"
+            << "Deflate without dictionary: " << compressedSize(plain, samples) << " bytes\n"
+            << "Deflate with dictionary: " << compressedSize(trained, samples) << " bytes\n";
+
+  return 0;
+}
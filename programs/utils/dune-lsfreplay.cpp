@@ -31,6 +31,7 @@
 #include <iostream>
 #include <iomanip>
 #include <map>
+#include <set>
 #include <DUNE/DUNE.hpp>
 
 using DUNE_NAMESPACES;
@@ -46,21 +47,113 @@ usage(void)
             << "\t-m msg1,...,msgn: only replay specified messages\n"
             << "\t-S addr: filter using source address"
             << "\t-D addr: filter using destination adreess\n"
-            << "\t-v [0-2]: verbosity level\n\n"
+            << "\t-v [0-2]: verbosity level\n"
+            << "\t-M : merge all files by time stamp, e.g., logs of several vehicles\n"
+            << "\t     (files are read in parallel)\n\n"
             << "f1 ... fn can be:\n"
             << "\t* Gzipped LSF files (.gz extension)\n"
             << "\t* LLF log dir names (will look for Data.lsf.gz in it)\n"
-            << "\t* plain LSF files\n";
+            << "\t* plain LSF files\n"
+            << "The log index (Data.lsf.idx), if present, is used to seek\n";
+}
+
+//! Replay settings.
+struct Replay
+{
+  double speed;
+  double begin;
+  double end;
+  int verbose;
+  uint16_t src;
+  uint16_t dst;
+  UDPSocket sock;
+  Address dest;
+  uint16_t port;
+};
+
+//! Resolve a file argument to the path of a log.
+//! @param[in] arg file argument.
+//! @return path of the log or an empty path if it does not exist.
+static Path
+resolve(const char* arg)
+{
+  Path file(arg);
+
+  if (file.isDirectory())
+  {
+    file = file / "Data.lsf";
+    if (!file.isFile())
+      file += ".gz";
+  }
+
+  if (!file.isFile())
+  {
+    std::cerr << file << " does not exist\n";
+    return Path();
+  }
+
+  return file;
+}
+
+//! Send the messages of a log reader, or of several merged, with
+//! times relative to a given origin.
+template <typename Reader>
+static void
+replay(Replay& r, Reader& reader, double time_origin, IMC::Message* m)
+{
+  DUNE::Utils::ByteBuffer bb;
+
+  double start_time = Clock::getSinceEpoch();
+  double now = start_time;
+
+  do
+  {
+    double msg_ts = m->getTimeStamp();
+    double vtime = msg_ts - time_origin;
+
+    m->setTimeStamp(start_time + vtime);
+
+    double future = 0;
+
+    if (r.speed > 0 && vtime >= r.begin)
+    {
+      // Delay time to mimic behavior at specified speed
+      future = start_time + vtime / r.speed - r.begin;
+      double delay_time = (future - now);
+      if (delay_time > 0)
+        Delay::wait(delay_time);
+    }
+    now = Clock::getSinceEpoch();
+
+    if (vtime >= r.begin
+        && (r.src == 0xFFFF || r.src == m->getSource())
+        && (r.dst == 0xFFFF || r.dst == m->getDestination()))
+    {
+      // Send message
+      IMC::Packet::serialize(m, bb);
+      r.sock.write(bb.getBuffer(), m->getSerializationSize(), r.dest, r.port);
+      if (r.verbose >= 1)
+        std::cout << (r.begin + now - start_time) << ' ' << vtime << ' ' << now - future << " : " << m->getName() << '\n';
+      if (r.verbose >= 2)
+        m->toText(std::cout);
+    }
+
+    delete m;
+
+    if (r.end >= 0 && vtime >= r.end)
+      break;
+  }
+  while ((m = reader.read()) != 0);
 }
 
 int
 main(int argc, char** argv)
 {
   double speed = 1, begin = 0, end = -1;
-  std::map<std::string, bool> filter;
-  bool filtering = false;
+  std::set<uint16_t> filter;
   int verbose = 0;
   uint16_t src = 0xFFFF, dst = 0xFFFF;
+  bool merge = false;
 
   ++argv; --argc;
 
@@ -73,6 +166,14 @@ main(int argc, char** argv)
   for (; *argv && **argv == '-'; ++argv, --argc)
   {
     char opt = (*argv)[1];
+
+    // Options without arguments.
+    if (opt == 'M')
+    {
+      merge = true;
+      continue;
+    }
+
     ++argv; --argc;
 
     if (!*argv || **argv == '-')
@@ -153,9 +254,17 @@ main(int argc, char** argv)
       {
         std::vector<std::string> list;
         DUNE::Utils::String::split(*argv, ",", list);
-        for (uint16_t i = 0; i < list.size(); ++i)
-          filter[list[i]] = true;
-        filtering = true;
+        try
+        {
+          for (uint16_t i = 0; i < list.size(); ++i)
+            filter.insert(IMC::Factory::getIdFromAbbrev(list[i]));
+        }
+        catch (std::exception& e)
+        {
+          std::cerr << e.what() << '\n';
+          usage();
+          return 1;
+        }
       }
       break;
       default:
@@ -179,114 +288,91 @@ main(int argc, char** argv)
     return 1;
   }
 
-  UDPSocket sock;
-  Address dest(argv[0]);
-  uint16_t port = std::atoi(argv[1]);
+  Replay r;
+  r.speed = speed;
+  r.begin = begin;
+  r.end = end;
+  r.verbose = verbose;
+  r.src = src;
+  r.dst = dst;
+  r.dest = Address(argv[0]);
+  r.port = std::atoi(argv[1]);
 
   argv += 2;
 
   std::cout << std::fixed << std::setprecision(4);
 
-  for (; *argv != 0; argv++)
+  if (merge)
   {
-    Path file(*argv);
-    std::istream* is;
-
-    if (file.isDirectory())
+    // Times are relative to the first message of all logs.
+    IMC::LogMerger merger;
+    for (; *argv != 0; argv++)
     {
-      file = file / "Data.lsf";
-      if (!file.isFile())
-        file += ".gz";
+      Path file = resolve(*argv);
+      if (file.str().empty())
+        return 1;
+      merger.add(file.str());
     }
 
-    if (!file.isFile())
+    double time_origin = merger.getStartTime();
+    if (time_origin < 0)
     {
-      std::cerr << file << " does not exist\n";
+      std::cerr << "files contain no messages\n";
       return 1;
     }
 
-    Compression::Methods method = Compression::Factory::detect(file.c_str());
-    if (method == METHOD_UNKNOWN)
-      is = new std::ifstream(file.c_str(), std::ios::binary);
-    else
-      is = new Compression::FileInput(file.c_str(), method);
-
-    IMC::Message* m;
+    merger.setFilter(filter);
+    merger.setTimeRange(time_origin + begin, end >= 0 ? time_origin + end : -1);
 
-    m = IMC::Packet::deserialize(*is);
+    IMC::Message* m = merger.read();
     if (!m)
     {
-      std::cerr << file << " contains no messages\n";
-      delete is;
-      continue;
+      std::cerr << "no messages for specified time range" << std::endl;
+      return 1;
     }
 
-    DUNE::Utils::ByteBuffer bb;
+    replay(r, merger, time_origin, m);
+    return 0;
+  }
+
+  for (; *argv != 0; argv++)
+  {
+    Path file = resolve(*argv);
+    if (file.str().empty())
+      return 1;
 
-    double time_origin = m->getTimeStamp();
-    if (begin >= 0)
+    // Times are relative to the first message of the log.
+    double time_origin = 0;
     {
-      do
+      IMC::LogReader probe(file.str());
+      IMC::Message* first = probe.read();
+      if (!first)
       {
-        if (m->getTimeStamp() - time_origin >= begin)
-          break;
-        delete m;
-        m = IMC::Packet::deserialize(*is);
+        std::cerr << file << " contains no messages\n";
+        continue;
       }
-      while (m);
 
-      if (!m)
-      {
-        std::cerr << "no messages for specified time range" << std::endl;
-        return 1;
-      }
+      time_origin = first->getTimeStamp();
+      delete first;
     }
-    else
-      begin = 0;
-
-    double start_time = Clock::getSinceEpoch();
-    double now = start_time;
-
-    do
-    {
-      double msg_ts = m->getTimeStamp();
-      double vtime = msg_ts - time_origin;
-
-      m->setTimeStamp(start_time + vtime);
-
-      double future = 0;
-
-      if (speed > 0 && vtime >= begin)
-      {
-        // Delay time to mimic behavior at specified speed
-        future = start_time + vtime / speed - begin;
-        double delay_time = (future - now);
-        if (delay_time > 0)
-          Delay::wait(delay_time);
-      }
-      now = Clock::getSinceEpoch();
 
-      if (vtime >= begin
-          && (src == 0xFFFF || src == m->getSource())
-          && (dst == 0xFFFF || dst == m->getDestination())
-          && (!filtering || filter[m->getName()]))
-      {
-        // Send message
-        IMC::Packet::serialize(m, bb);
-        sock.write(bb.getBuffer(), m->getSerializationSize(), dest, port);
-        if (verbose >= 1)
-          std::cout << (begin + now - start_time) << ' ' << vtime << ' ' << now - future << " : " << m->getName() << '\n';
-        if (verbose >= 2)
-          m->toText(std::cout);
-      }
+    // The reader uses the log index, if any, to skip to the
+    // requested time and messages.
+    IMC::LogReader reader(file.str());
+    reader.setFilter(filter);
+    reader.setTimeRange(time_origin + begin, -1);
 
-      delete m;
+    if (verbose >= 1 && reader.isIndexed())
+      std::cerr << "using index of " << file << '\n';
 
-      if (end >= 0 && vtime >= end)
-        break;
+    IMC::Message* m = reader.read();
+    if (!m)
+    {
+      std::cerr << "no messages for specified time range" << std::endl;
+      return 1;
     }
-    while ((m = IMC::Packet::deserialize(*is)) != 0);
-    delete is;
+
+    replay(r, reader, time_origin, m);
   }
   return 0;
 }
@@ -47,7 +47,9 @@ main(int argc, char** argv)
   .add("-i", "--i2c-address",
        "I2C slave address", "I2C_ADDR")
   .add("-f", "--file",
-       "iHEX file", "IHEX_FILE");
+       "iHEX file", "IHEX_FILE")
+  .add("-F", "--full",
+       "Write all pages, including those that did not change");
 
   // Parse command line arguments.
   if (!options.parse(argc, argv))
@@ -102,6 +104,7 @@ main(int argc, char** argv)
   try
   {
     LUCL::BootLoader boot(proto, true, baud);
+    boot.setSkipUnchanged(options.value("--full") != "true");
     boot.flash(ihex);
   }
   catch (std::exception& e)
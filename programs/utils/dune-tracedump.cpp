@@ -0,0 +1,140 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+// Utility program to decode message trace dumps (see IMC::TraceRing).      *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Retrieve the abbreviation of a message id.
+static std::string
+getAbbrev(uint16_t id)
+{
+  try
+  {
+    return IMC::Factory::getAbbrevFromId(id);
+  }
+  catch (...)
+  {
+    return String::str("%u", id);
+  }
+}
+
+static int
+decode(const char* fname)
+{
+  std::ifstream ifs(fname, std::ios::binary);
+  if (!ifs.is_open())
+  {
+    std::fprintf(stderr, "ERROR: failed to open '%s'\n", fname);
+    return 1;
+  }
+
+  IMC::TraceRing::FileHeader hdr;
+  ifs.read((char*)&hdr, sizeof(hdr));
+  if (!ifs || std::memcmp(hdr.magic, "DTRC", 4) != 0)
+  {
+    std::fprintf(stderr, "ERROR: '%s' is not a message trace\n", fname);
+    return 1;
+  }
+
+  if (hdr.version != IMC::TraceRing::c_version)
+  {
+    std::fprintf(stderr, "ERROR: unsupported trace format %u\n", hdr.version);
+    return 1;
+  }
+
+  std::vector<std::string> channels;
+  for (unsigned i = 0; i < hdr.channels; ++i)
+  {
+    char name[IMC::TraceRing::c_channel_name_size];
+    ifs.read(name, sizeof(name));
+    name[sizeof(name) - 1] = 0;
+    channels.push_back(name);
+  }
+
+  std::printf("# time, channel, direction, message, source, source entity, "
+              "destination, destination entity, timestamp, size\n");
+
+  unsigned skipped = 0;
+  for (uint32_t i = 0; i < hdr.records; ++i)
+  {
+    IMC::TraceRing::Record r;
+    ifs.read((char*)&r, sizeof(r));
+    if (!ifs)
+    {
+      std::fprintf(stderr, "WARNING: trace is truncated\n");
+      break;
+    }
+
+    // Records being written at dump time.
+    if (r.sequence == 0)
+    {
+      ++skipped;
+      continue;
+    }
+
+    std::string channel = r.channel < channels.size() ? channels[r.channel] : "?";
+
+    std::printf("%.6f, %s, %s, %s, 0x%04X, %u, 0x%04X, %u, %.6f, %u\n",
+                r.time, channel.c_str(),
+                r.direction == IMC::TraceRing::DIR_IN ? "in" : "out",
+                getAbbrev(r.id).c_str(),
+                r.src, r.src_ent, r.dst, r.dst_ent, r.msg_time, r.size);
+  }
+
+  if (skipped > 0)
+    std::fprintf(stderr, "WARNING: %u incomplete records were skipped\n", skipped);
+
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    std::fprintf(stderr, "Usage: %s TRACE0 ... TRACEn\n"
+                 "Print the records of message trace dumps as text.\n", argv[0]);
+    return 1;
+  }
+
+  int rv = 0;
+  for (int i = 1; i < argc; ++i)
+    rv |= decode(argv[i]);
+
+  return rv;
+}
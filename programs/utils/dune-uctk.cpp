@@ -49,7 +49,9 @@ main(int argc, char** argv)
   .add("-t", "--dev-type",
        "System device type", "TYPE")
   .add("-f", "--file",
-       "iHEX file", "IHEX_FILE");
+       "iHEX file", "IHEX_FILE")
+  .add("-F", "--full",
+       "Write all pages, including those that did not change");
 
   // Parse command line arguments.
   if (!options.parse(argc, argv))
@@ -92,6 +94,7 @@ main(int argc, char** argv)
 
   UCTK::Interface itf(handle);
   UCTK::Bootloader* boot = new UCTK::Bootloader(&itf, true);
+  boot->setSkipUnchanged(options.value("--full") != "true");
   boot->program(ihex);
   delete boot;
   delete handle;
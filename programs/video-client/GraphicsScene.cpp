@@ -47,7 +47,8 @@ GraphicsScene::GraphicsScene(const char* raddr, unsigned rport, unsigned lport,
   m_raddr(raddr),
   m_rport(rport),
   m_lport(lport),
-  m_rotate(0)
+  m_rotate(0),
+  m_decoder(0)
 {
   m_scene.addItem(&m_item);
   setScene(&m_scene);
@@ -81,6 +82,7 @@ GraphicsScene::GraphicsScene(const char* raddr, unsigned rport, unsigned lport,
 
 GraphicsScene::~GraphicsScene(void)
 {
+  delete m_decoder;
   delete m_sock;
 }
 
@@ -247,6 +249,47 @@ GraphicsScene::wheelEvent(QWheelEvent* event)
   event->accept();
 }
 
+void
+GraphicsScene::showPixmap(QPixmap& pix)
+{
+  QTransform t;
+  pix = pix.transformed(t.rotate(m_rotate));
+
+  m_item.setPixmap(pix);
+
+  setMinimumSize(pix.width() + c_pad, pix.height() + c_pad);
+
+  if (m_grid)
+  {
+    m_vline->setLine(0, pix.height() / 2, pix.width(), pix.height() / 2);
+    m_hline->setLine(pix.width() / 2, 0, pix.width() / 2, pix.height());
+  }
+}
+
+void
+GraphicsScene::decodeVideo(const IMC::CompressedVideo* chunk)
+{
+  if (chunk->codec != IMC::CompressedVideo::CODEC_H264 || !H264Decoder::isSupported())
+    return;
+
+  bool key = (chunk->flags & IMC::CompressedVideo::CVF_KEYFRAME) != 0;
+  if (!m_assembler.add(chunk->frameid, chunk->chunk, chunk->chunks, key,
+                       chunk->data.data(), chunk->data.size()))
+    return;
+
+  if (m_decoder == 0)
+    m_decoder = new H264Decoder;
+
+  const std::vector<char>& frame = m_assembler.getFrame();
+  QImage image;
+  if (!m_decoder->decode(&frame[0], frame.size(), image))
+    return;
+
+  ++m_fps;
+  QPixmap pix = QPixmap::fromImage(image);
+  showPixmap(pix);
+}
+
 void
 GraphicsScene::handleInputData(void)
 {
@@ -267,19 +310,11 @@ GraphicsScene::handleInputData(void)
 
       QPixmap pix;
       pix.loadFromData((uchar*)img->data.data(), img->data.size(), "JPEG");
-
-      QTransform t;
-      pix = pix.transformed(t.rotate(m_rotate));
-
-      m_item.setPixmap(pix);
-
-      setMinimumSize(pix.width() + c_pad, pix.height() + c_pad);
-
-      if (m_grid)
-      {
-        m_vline->setLine(0, pix.height() / 2, pix.width(), pix.height() / 2);
-        m_hline->setLine(pix.width() / 2, 0, pix.width() / 2, pix.height());
-      }
+      showPixmap(pix);
+    }
+    else if (msg->getId() == DUNE_IMC_COMPRESSEDVIDEO)
+    {
+      decodeVideo(static_cast<IMC::CompressedVideo*>(msg));
     }
     else if (msg->getId() == DUNE_IMC_EULERANGLES)
     {
@@ -43,6 +43,13 @@
 #include <vector>
 #include <map>
 
+// DUNE headers.
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/Media/FrameAssembler.hpp>
+
+// Local headers.
+#include "H264Decoder.hpp"
+
 class GraphicsScene: public QGraphicsView
 {
 Q_OBJECT
@@ -107,9 +114,20 @@ private:
 
   unsigned m_rotate;
 
+  //! Reassembly of H.264 frames.
+  DUNE::Media::FrameAssembler m_assembler;
+  //! H.264 decoder (created with the first frame).
+  H264Decoder* m_decoder;
+
   void
   drawGrid(void);
 
+  void
+  showPixmap(QPixmap& pix);
+
+  void
+  decodeVideo(const DUNE::IMC::CompressedVideo* chunk);
+
   void
   sendAction(const std::string& action, const std::string& value);
 };
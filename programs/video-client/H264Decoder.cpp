@@ -0,0 +1,123 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+#if defined(DUNE_USING_FFMPEG)
+extern "C"
+{
+#  include <libavcodec/avcodec.h>
+#  include <libswscale/swscale.h>
+}
+#endif
+
+// Local headers.
+#include "H264Decoder.hpp"
+
+H264Decoder::H264Decoder(void):
+  m_ctx(0),
+  m_frame(0),
+  m_pkt(0),
+  m_sws(0)
+{
+#if defined(DUNE_USING_FFMPEG)
+  const AVCodec* codec = avcodec_find_decoder(AV_CODEC_ID_H264);
+  if (codec == 0)
+    throw std::runtime_error("H.264 decoder is not available");
+
+  m_ctx = avcodec_alloc_context3(codec);
+  m_ctx->flags |= AV_CODEC_FLAG_LOW_DELAY;
+  if (avcodec_open2(m_ctx, codec, 0) < 0)
+  {
+    avcodec_free_context(&m_ctx);
+    throw std::runtime_error("failed to open H.264 decoder");
+  }
+
+  m_frame = av_frame_alloc();
+  m_pkt = av_packet_alloc();
+#else
+  throw std::runtime_error("H.264 decoding is not supported in this build");
+#endif
+}
+
+H264Decoder::~H264Decoder(void)
+{
+#if defined(DUNE_USING_FFMPEG)
+  sws_freeContext(m_sws);
+  av_packet_free(&m_pkt);
+  av_frame_free(&m_frame);
+  avcodec_free_context(&m_ctx);
+#endif
+}
+
+bool
+H264Decoder::isSupported(void)
+{
+#if defined(DUNE_USING_FFMPEG)
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+H264Decoder::decode(const char* data, size_t size, QImage& image)
+{
+#if defined(DUNE_USING_FFMPEG)
+  m_pkt->data = (uint8_t*)data;
+  m_pkt->size = (int)size;
+  if (avcodec_send_packet(m_ctx, m_pkt) < 0)
+    return false;
+
+  bool decoded = false;
+  while (avcodec_receive_frame(m_ctx, m_frame) == 0)
+  {
+    m_sws = sws_getCachedContext(m_sws, m_frame->width, m_frame->height, (AVPixelFormat)m_frame->format,
+                                 m_frame->width, m_frame->height, AV_PIX_FMT_RGB24,
+                                 SWS_BILINEAR, 0, 0, 0);
+    if (m_sws == 0)
+      continue;
+
+    image = QImage(m_frame->width, m_frame->height, QImage::Format_RGB888);
+    uint8_t* dst[1] = {image.bits()};
+    int stride[1] = {image.bytesPerLine()};
+    sws_scale(m_sws, m_frame->data, m_frame->linesize, 0, m_frame->height, dst, stride);
+    decoded = true;
+  }
+
+  return decoded;
+#else
+  (void)data;
+  (void)size;
+  (void)image;
+  return false;
+#endif
+}
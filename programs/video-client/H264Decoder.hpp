@@ -0,0 +1,73 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef VIDEO_CLIENT_H264_DECODER_HPP_INCLUDED_
+#define VIDEO_CLIENT_H264_DECODER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// QT headers.
+#include <QImage>
+
+// Forward declarations.
+struct AVCodecContext;
+struct AVFrame;
+struct AVPacket;
+struct SwsContext;
+
+//! H.264 decoder using FFmpeg. Pictures are returned as soon as
+//! they are decoded.
+class H264Decoder
+{
+public:
+  //! Constructor.
+  H264Decoder(void);
+
+  ~H264Decoder(void);
+
+  //! Test if DUNE was compiled with H.264 decoding support.
+  //! @return true if decoding is supported, false otherwise.
+  static bool
+  isSupported(void);
+
+  //! Decode a frame.
+  //! @param[in] data frame data (Annex B).
+  //! @param[in] size size of frame data in bytes.
+  //! @param[out] image decoded picture.
+  //! @return true if a picture was decoded, false otherwise.
+  bool
+  decode(const char* data, size_t size, QImage& image);
+
+private:
+  AVCodecContext* m_ctx;
+  AVFrame* m_frame;
+  AVPacket* m_pkt;
+  SwsContext* m_sws;
+};
+
+#endif
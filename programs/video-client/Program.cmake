@@ -7,10 +7,11 @@ if(QT_LIBRARIES)
   add_executable(video-client
     programs/video-client/VideoClient.cpp
     programs/video-client/GraphicsScene.cpp
+    programs/video-client/H264Decoder.cpp
     programs/video-client/Main.cpp
     ${MOC_SRCS})
 
-  target_link_libraries(video-client dune-core ${DUNE_SYS_LIBS} ${QT_LIBRARIES})
+  target_link_libraries(video-client dune-core ${DUNE_SYS_LIBS} ${QT_LIBRARIES} ${DUNE_FFMPEG_LIBS})
   set(DUNE_EXTRA_EXE ${DUNE_EXTRA_EXE} video-client)
   set(DUNE_EXTRA_EXE_NAMES ${DUNE_EXTRA_EXE_NAMES} "video-client;Video Client")
 endif(QT_LIBRARIES)
@@ -244,9 +244,7 @@ namespace Actuators
 
         setConfig();
 
-        std::map<std::string, LED*>::iterator itr = m_led_by_name.begin();
-        for (unsigned i = 0; i < c_led_count; ++i)
-          setBrightness(itr->second, 0);
+        setBrightness(0);
 
         if (!m_args.led_patterns.empty())
         {
@@ -379,17 +377,27 @@ namespace Actuators
         return true;
       }
 
+      //! Fill a frame setting the brightness of a LED.
+      //! @param[out] frame frame.
+      //! @param[in] led LED.
+      //! @param[in] value brightness.
       void
-      setBrightness(LED* led, uint8_t value)
+      fillBrightness(UCTK::Frame& frame, const LED* led, uint8_t value)
       {
         uint8_t id = led->id;
         uint16_t ticks = ((value * m_dif_dur) / 255) + m_min_dur;
 
-        UCTK::Frame frame;
         frame.setId(PKT_ID_LED_PW);
         frame.setPayloadSize(3);
         frame.set(id, 0);
         frame.set(ticks, 1);
+      }
+
+      void
+      setBrightness(LED* led, uint8_t value)
+      {
+        UCTK::Frame frame;
+        fillBrightness(frame, led, value);
 
         if (m_ctl->sendFrame(frame))
         {
@@ -398,6 +406,27 @@ namespace Actuators
         }
       }
 
+      //! Set the brightness of all LEDs, without waiting for each
+      //! reply before sending the next request.
+      //! @param[in] value brightness.
+      void
+      setBrightness(uint8_t value)
+      {
+        UCTK::Frame frames[c_led_count];
+        std::map<unsigned, LED*>::iterator itr = m_led_by_id.begin();
+        unsigned count = 0;
+        for (; itr != m_led_by_id.end() && count < c_led_count; ++itr)
+          fillBrightness(frames[count++], itr->second, value);
+
+        if (!m_ctl->sendFrames(frames, count))
+          return;
+
+        for (itr = m_led_by_id.begin(); itr != m_led_by_id.end(); ++itr)
+          itr->second->brightness.value = value;
+
+        m_wdog.reset();
+      }
+
       bool
       getMonitors(void)
       {
@@ -41,6 +41,8 @@ namespace Actuators
 
     //! Number of servos
     static const unsigned c_servo_count = 4;
+    //! Maximum amount of time to wait for replies (s).
+    static const double c_reply_timeout = 0.5;
 
     //! Device commands.
     enum Commands
@@ -116,8 +118,6 @@ namespace Actuators
       LUCL::Protocol m_proto;
       //! Hardware major
       int m_hw_major;
-      //! Last ADC sampling.
-      Counter<double> m_last_adc;
       //! Task arguments.
       Arguments m_args;
       //! Servo's previous set reference (needed for angular rate limitation)
@@ -219,7 +219,7 @@ namespace Actuators
         if (paramChanged(m_args.adc_sper))
         {
           m_args.adc_sper = 1 / m_args.adc_sper;
-          m_last_adc.setTop(m_args.adc_sper);
+          m_proto.subscribe(CMD_STATE, m_args.adc_sper);
         }
 
         // Initialize data structures.
@@ -458,51 +458,16 @@ namespace Actuators
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
-      bool
-      waitForCommand(uint8_t code)
+      void
+      onError(uint8_t code, const uint8_t* data, int data_size)
       {
-        LUCL::Command cmd;
-        unsigned retries = 10;
-
-        while (retries)
-        {
-          LUCL::CommandType type = m_proto.consumeData(cmd);
-
-          switch (type)
-          {
-            case LUCL::CommandTypeNormal:
-              onCommand(cmd.command.code, cmd.command.data, cmd.command.size);
-              if (cmd.command.code == code)
-                return true;
-              break;
-
-            case LUCL::CommandTypeVersion:
-              onVersion(cmd.version.major, cmd.version.minor, cmd.version.patch);
-              break;
-
-            case LUCL::CommandTypeInvalidVersion:
-              err("%s", DTR(Status::getString(Status::CODE_INVALID_CHECKSUM)));
-              break;
-
-            case LUCL::CommandTypeError:
-              err(DTR("device reported: %s"), m_proto.getErrorString(cmd.error.code));
-              break;
-
-            case LUCL::CommandTypeInvalidChecksum:
-              err("%s", DTR(Status::getString(Status::CODE_INVALID_CHECKSUM)));
-              break;
-
-            case LUCL::CommandTypeNone:
-              --retries;
-              Delay::waitMsec(50);
-              break;
-
-            default:
-              break;
-          }
-        }
+        (void)data;
+        (void)data_size;
 
-        return false;
+        if (code == 0xE5)
+          err("%s", DTR(Status::getString(Status::CODE_INVALID_CHECKSUM)));
+        else
+          err(DTR("device reported: %s"), m_proto.getErrorString(code));
       }
 
       void
@@ -543,32 +508,19 @@ namespace Actuators
           data[i + 1] = m_servo_ref[nr] & 0xFF;
         }
 
-        m_proto.sendCommand(CMD_SERVO_SET, data, c_servo_count + 1);
-        if (!waitForCommand(CMD_SERVO_SET))
+        // Servo references and the periodic state request share a
+        // single exchange with the board.
+        m_proto.submit(CMD_SERVO_SET, data, c_servo_count + 1);
+        m_proto.submitDue();
+
+        if (!m_proto.complete(*this, c_reply_timeout))
         {
+          m_proto.clearOutstanding();
           setEntityState(IMC::EntityState::ESTA_ERROR, Status::CODE_COM_ERROR);
           throw RestartNeeded(DTR(Status::getString(Status::CODE_COM_ERROR)), 5);
         }
-        else
-        {
-          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
-        }
-
-        if (!m_last_adc.overflow())
-          return;
 
-        m_last_adc.reset();
-
-        // Request state.
-        m_proto.sendCommand(CMD_STATE);
-        if (!waitForCommand(CMD_STATE))
-        {
-          setEntityState(IMC::EntityState::ESTA_ERROR, Status::CODE_COM_ERROR);
-        }
-        else
-        {
-          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
-        }
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
     };
   }
@@ -25,8 +25,12 @@
 // Author: Jose Pinto                                      *
 //***************************************************************************
 
+
 // ISO C++ 98 headers.
 #include <stdexcept>
+#include <map>
+#include <set>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -38,6 +42,13 @@ namespace Autonomy
   {
     using DUNE_NAMESPACES;
 
+    //! Size of the serialization buffer.
+    static const unsigned c_bfr_size = 65535;
+    //! Interval between vehicle links and plan state checks (s).
+    static const double c_check_period = 1.0;
+    //! Interval between repeated plan requests (s).
+    static const double c_request_period = 2.0;
+
     //! %Task arguments
     struct Arguments
     {
@@ -48,6 +59,25 @@ namespace Autonomy
       //! Threshold (meters) after which the vehicle is considered to have arrived
       //! at destination in the vertical plane.
       uint16_t altitude_interval;
+      //! Messages sent to TREX as timeline observations.
+      std::vector<std::string> observations;
+      //! Interval between batches of observations.
+      double obs_period;
+      //! TREX address.
+      Address trex_addr;
+      //! TREX port.
+      unsigned trex_port;
+      //! Maximum size of datagrams sent to TREX.
+      unsigned dgram_size;
+    };
+
+    //! Latest value of a timeline.
+    struct Observation
+    {
+      //! Last message.
+      IMC::Message* msg;
+      //! True if the message was not sent to TREX yet.
+      bool fresh;
     };
 
     struct Task : public DUNE::Tasks::Task
@@ -56,8 +86,6 @@ namespace Autonomy
       std::map<unsigned int, IMC::Announce> lastAnnounces;
       //! HeartBeat cache.
       std::map<unsigned int, double> lastHeartBeat;
-      //! Mutex for accessing announces map.
-      DUNE::Concurrency::Mutex m_mutex;
       //! Task arguments.
       Arguments m_args;
       //! Last HeartBeat.
@@ -70,10 +98,26 @@ namespace Autonomy
       bool m_trex_connected;
       //! Stores if TREX is currently controlling the vehicle
       bool m_trex_control;
+      //! Identifiers of messages sent as observations.
+      std::set<uint32_t> m_obs_ids;
+      //! Latest observations by message and source entity.
+      std::map<uint32_t, Observation> m_obs;
+      //! Operations waiting to be sent to TREX.
+      std::vector<IMC::Message*> m_ops;
+      //! Socket to TREX.
+      UDPSocket m_sock;
+      //! Serialization buffer.
+      uint8_t* m_bfr;
+      //! Observation batch timer.
+      Time::Counter<double> m_obs_timer;
+      //! Vehicle links and plan state timer.
+      Time::Counter<double> m_check_timer;
+      //! Plan request timer.
+      Time::Counter<double> m_request_timer;
 
       Task(const std::string& name, Tasks::Context& ctx) :
           DUNE::Tasks::Task(name, ctx), m_last_heartbeat(Time::Clock::get()), m_trex_connected(
-              false), m_trex_control(false)
+              false), m_trex_control(false), m_bfr(NULL)
       {
         // Define configuration parameters.
         paramActive(Tasks::Parameter::SCOPE_GLOBAL,
@@ -91,14 +135,59 @@ namespace Autonomy
         .defaultValue("2")
         .minimumValue("0");
 
+        param("Observations", m_args.observations)
+        .defaultValue("")
+        .description("Messages sent to TREX. Only the latest message of each"
+                     " type and entity is sent in each batch");
+
+        param("Observation Period", m_args.obs_period)
+        .defaultValue("0.5")
+        .minimumValue("0.05")
+        .units(Units::Second)
+        .description("Interval between batches of observations");
+
+        param("TREX Address", m_args.trex_addr)
+        .defaultValue("127.0.0.1")
+        .description("Address of TREX's IMC adapter");
+
+        param("TREX Port", m_args.trex_port)
+        .defaultValue("6969")
+        .description("Port of TREX's IMC adapter");
+
+        param("Maximum Datagram Size", m_args.dgram_size)
+        .defaultValue("1400")
+        .minimumValue("256")
+        .maximumValue("65000")
+        .units(Units::Byte)
+        .description("Maximum size of datagrams with batched observations");
+
         // Register consumers.
         bind<IMC::Announce>(this);
         bind<IMC::Heartbeat>(this);
-        bind<IMC::VehicleState>(this);
-        bind<IMC::PlanControlState>(this);
         bind<IMC::TrexOperation>(this);
         bind<IMC::Abort>(this);
+        bind<IMC::PlanControl>(this);
+      }
+
+      ~Task(void)
+      {
+        onResourceRelease();
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_obs_ids.clear();
+        for (unsigned i = 0; i < m_args.observations.size(); ++i)
+          m_obs_ids.insert(IMC::Factory::getIdFromAbbrev(m_args.observations[i]));
 
+        m_obs_timer.setTop(m_args.obs_period);
+
+        // Plan and vehicle state are needed even if they are not
+        // observed, their consumers forward them to observe().
+        bind(this, m_args.observations);
+        bind<IMC::VehicleState>(this);
+        bind<IMC::PlanControlState>(this);
       }
 
       void
@@ -107,6 +196,28 @@ namespace Autonomy
         reserveEntity("TREX (External)");
       }
 
+      void
+      onResourceAcquisition(void)
+      {
+        m_bfr = new uint8_t[c_bfr_size];
+        m_check_timer.setTop(c_check_period);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        std::map<uint32_t, Observation>::iterator itr = m_obs.begin();
+        for (; itr != m_obs.end(); ++itr)
+          delete itr->second.msg;
+        m_obs.clear();
+
+        for (unsigned i = 0; i < m_ops.size(); ++i)
+          delete m_ops[i];
+        m_ops.clear();
+
+        Memory::clear(m_bfr);
+      }
+
       void
       onReportEntityState(void)
       {
@@ -134,6 +245,40 @@ namespace Autonomy
         }
       }
 
+      //! Keep the latest value of a timeline until the next batch.
+      //! @param[in] msg message.
+      void
+      observe(const IMC::Message* msg)
+      {
+        // Only local state is observed by TREX.
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (m_obs_ids.find(msg->getId()) == m_obs_ids.end())
+          return;
+
+        uint32_t key = (msg->getId() << 8) | msg->getSourceEntity();
+        std::map<uint32_t, Observation>::iterator itr = m_obs.find(key);
+        if (itr == m_obs.end())
+        {
+          Observation obs;
+          obs.msg = msg->clone();
+          obs.fresh = true;
+          m_obs[key] = obs;
+          return;
+        }
+
+        delete itr->second.msg;
+        itr->second.msg = msg->clone();
+        itr->second.fresh = true;
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        observe(msg);
+      }
+
       void
       consume(const IMC::Heartbeat* msg)
       {
@@ -157,24 +302,44 @@ namespace Autonomy
         {
           lastHeartBeat[msg->getSource()] = Time::Clock::get();
         }
-        m_mutex.lock();
         lastAnnounces[msg->getSource()] = *msg;
-        m_mutex.unlock();
       }
 
       void
       consume(const IMC::VehicleState * msg)
       {
+        observe(msg);
+
+        if (msg->getSource() != getSystemId())
+          return;
+
         m_last_vehicle_state = *msg;
+        checkState();
       }
 
       void
       consume(const IMC::PlanControlState * msg)
       {
+        observe(msg);
+
+        if (msg->getSource() != getSystemId())
+          return;
+
         m_last_plan_state = *msg;
+        checkState();
+      }
+
+      void
+      consume(const IMC::PlanControl* msg)
+      {
+        if (msg->type == IMC::PlanControl::PC_REQUEST
+            || msg->plan_id != "trex_plan"
+            || msg->getDestination() != getSystemId())
+          return;
 
-        m_trex_control = msg->state == IMC::PlanControlState::PCS_EXECUTING
-            && msg->plan_id == "trex_plan";
+        // The plan engine answered, the next request can be sent
+        // right away if needed.
+        m_request_timer.setTop(0);
       }
 
       void
@@ -190,6 +355,11 @@ namespace Autonomy
       void
       consume(const IMC::TrexOperation * msg)
       {
+        // Operations from other nodes are relayed to TREX with the
+        // next batch of observations.
+        if (msg->getSource() != m_args.trex_id)
+          m_ops.push_back(msg->clone());
+
         switch (msg->op)
         {
           case IMC::TrexOperation::OP_POST_TOKEN:
@@ -230,6 +400,7 @@ namespace Autonomy
         inf("%s", DTR(Status::getString(Status::CODE_ACTIVE)));
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+        checkState();
       }
 
       void
@@ -238,6 +409,7 @@ namespace Autonomy
         inf("%s", DTR(Status::getString(Status::CODE_IDLE)));
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
+        checkState();
       }
 
       // Start a FollowReference maneuver that is controlled by TREX
@@ -282,69 +454,151 @@ namespace Autonomy
         dispatch(stopPlan);
       }
 
+      //! Request the plan engine to start or stop the TREX plan. Requests
+      //! are not repeated while the plan engine has not answered.
       void
       checkState(void)
       {
         m_trex_control = m_last_plan_state.plan_id == "trex_plan"
             && m_last_plan_state.state == IMC::PlanControlState::PCS_EXECUTING;
 
+        if (!m_request_timer.overflow())
+          return;
+
         if (m_trex_control)
         {
           if (!isActive())
+          {
             stopExecution();
+            m_request_timer.setTop(c_request_period);
+          }
         }
         else
         {
           if (isActive() && m_trex_connected
               && m_last_vehicle_state.op_mode == IMC::VehicleState::VS_SERVICE)
-
+          {
             startExecution();
+            m_request_timer.setTop(c_request_period);
+          }
         }
       }
 
+      //! Add a message to the current datagram to TREX, sending the
+      //! datagram first if the message does not fit.
+      //! @param[in] msg message.
+      //! @param[in,out] size size of the current datagram.
       void
-      onMain(void)
+      append(const IMC::Message* msg, unsigned& size)
       {
-        std::map<unsigned int, double>::iterator it;
-        std::map<unsigned int, double> oldMap;
-        double lastTest = Time::Clock::get();
-        while (!stopping())
+        unsigned msg_size = msg->getSerializationSize();
+        if (size > 0 && size + msg_size > m_args.dgram_size)
+          send(size);
+
+        if (msg_size > c_bfr_size - size)
         {
-          consumeMessages();
-          oldMap.clear();
-          oldMap.insert(lastHeartBeat.begin(), lastHeartBeat.end());
-          double now = Clock::get();
+          war(DTR("observation is too large: %s"), msg->getName());
+          return;
+        }
 
-          if (now - lastTest > 10.0)
-          {
-            for (it = oldMap.begin(); it != oldMap.end(); it++)
-            {
-              // disconnected
-              if (now - it->second > 20.0)
-              {
-                lastHeartBeat.erase(it->first);
-                lastAnnounces.erase(it->first);
-              }
-            }
-          }
+        size += IMC::Packet::serialize(msg, m_bfr + size, c_bfr_size - size);
+      }
+
+      //! Send the current datagram to TREX.
+      //! @param[in,out] size size of the current datagram.
+      void
+      send(unsigned& size)
+      {
+        try
+        {
+          m_sock.write(m_bfr, size, m_args.trex_addr, m_args.trex_port);
+        }
+        catch (std::runtime_error& e)
+        {
+          debug("failed to send observations: %s", e.what());
+        }
+
+        size = 0;
+      }
+
+      //! Send fresh observations and pending operations to TREX.
+      void
+      flushObservations(void)
+      {
+        unsigned size = 0;
+
+        std::map<uint32_t, Observation>::iterator itr = m_obs.begin();
+        for (; itr != m_obs.end(); ++itr)
+        {
+          if (!itr->second.fresh)
+            continue;
+
+          append(itr->second.msg, size);
+          itr->second.fresh = false;
+        }
 
-          IMC::VehicleLinks links;
-          links.localname = getSystemName();
+        for (unsigned i = 0; i < m_ops.size(); ++i)
+        {
+          append(m_ops[i], size);
+          delete m_ops[i];
+        }
+        m_ops.clear();
 
-          if (lastAnnounces.size())
+        if (size > 0)
+          send(size);
+      }
+
+      //! Forget disconnected systems and report vehicle links.
+      void
+      updateLinks(void)
+      {
+        double now = Clock::get();
+
+        std::map<unsigned int, double>::iterator it = lastHeartBeat.begin();
+        while (it != lastHeartBeat.end())
+        {
+          // disconnected
+          if (now - it->second > 20.0)
+          {
+            lastAnnounces.erase(it->first);
+            lastHeartBeat.erase(it++);
+          }
+          else
           {
-            m_mutex.lock();
-            std::map<unsigned int, IMC::Announce>::iterator i;
-            for (i = lastAnnounces.begin(); i != lastAnnounces.end(); i++)
-              links.links.push_back(&i->second);
-            m_mutex.unlock();
+            ++it;
           }
+        }
+
+        IMC::VehicleLinks links;
+        links.localname = getSystemName();
 
-          dispatch(links);
+        std::map<unsigned int, IMC::Announce>::iterator i;
+        for (i = lastAnnounces.begin(); i != lastAnnounces.end(); i++)
+          links.links.push_back(&i->second);
+
+        dispatch(links);
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(std::min(m_obs_timer.getRemaining(),
+                                   m_check_timer.getRemaining()));
 
-          checkState();
+          if (m_obs_timer.overflow())
+          {
+            flushObservations();
+            m_obs_timer.reset();
+          }
 
-          Delay::wait(1.0);
+          if (m_check_timer.overflow())
+          {
+            updateLinks();
+            checkState();
+            m_check_timer.reset();
+          }
         }
       }
     };
@@ -41,6 +41,16 @@ namespace Control
 
       //! Number of fins.
       static const int c_fins = 4;
+      //! Number of fin subsets.
+      static const int c_fin_sets = 1 << c_fins;
+      //! Number of allocated torques (K, M and N).
+      static const int c_axes = 3;
+      //! Allocation order, most important torque first.
+      static const int c_order[c_axes] = {2, 1, 0};
+      //! Damping of the pseudo-inverse of rank deficient fin subsets.
+      static const double c_damping = 1e-9;
+      //! Tolerance on torques produced by allocation directions.
+      static const double c_tolerance = 1e-6;
 
       struct Arguments
       {
@@ -54,6 +64,8 @@ namespace Control
         bool pitch_brake;
         //! ServoPosition label
         std::string spos_label;
+        //! Fins excluded from allocation.
+        std::vector<unsigned> disabled_fins;
       };
 
       struct Task: public DUNE::Tasks::Task
@@ -72,11 +84,18 @@ namespace Control
         uint32_t m_scope_ref;
         //! Task arguments.
         Arguments m_args;
+        //! Fins available for allocation, one bit per fin.
+        unsigned m_available;
+        //! Allocation directions of each fin subset: fin rotations
+        //! producing a unit torque in one axis and none in the others,
+        //! or zero if the subset cannot do so.
+        float m_dirs[c_fin_sets][c_axes][c_fins];
 
         Task(const std::string& name, Tasks::Context& ctx):
           Tasks::Task(name, ctx),
           m_braking(false),
-          m_scope_ref(0)
+          m_scope_ref(0),
+          m_available(c_fin_sets - 1)
         {
           param(DTR_RT("Maximum Fin Rotation"), m_args.max_fin_rot)
           .defaultValue("25.0")
@@ -112,6 +131,10 @@ namespace Control
           .defaultValue("")
           .description("Label of the servo position message to compute produced torque");
 
+          param("Disabled Fins", m_args.disabled_fins)
+          .defaultValue("")
+          .description("Fins that have failed and must not be used in allocation");
+
           // Initialize main entity state.
           setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
 
@@ -127,6 +150,67 @@ namespace Control
         {
           if (paramChanged(m_args.max_fin_rot))
             m_args.max_fin_rot = Angles::radians(m_args.max_fin_rot);
+
+          m_available = c_fin_sets - 1;
+          for (unsigned i = 0; i < m_args.disabled_fins.size(); ++i)
+          {
+            if (m_args.disabled_fins[i] >= (unsigned)c_fins)
+              throw std::runtime_error(String::str(DTR("invalid fin: %u"), m_args.disabled_fins[i]));
+
+            m_available &= ~(1u << m_args.disabled_fins[i]);
+          }
+
+          computeDirections();
+        }
+
+        //! Compute the allocation directions of all fin subsets from
+        //! the pseudo-inverse of the fins effectiveness matrix.
+        void
+        computeDirections(void)
+        {
+          // Torque produced by each fin per radian.
+          Math::FixedMatrix<c_axes, c_fins> eff;
+          eff(0, 0) = -m_args.conv[0];
+          eff(0, 1) = m_args.conv[0];
+          eff(0, 2) = -m_args.conv[0];
+          eff(0, 3) = m_args.conv[0];
+          eff(1, 1) = -m_args.conv[1];
+          eff(1, 2) = -m_args.conv[1];
+          eff(2, 0) = -m_args.conv[2];
+          eff(2, 3) = -m_args.conv[2];
+
+          for (int set = 0; set < c_fin_sets; ++set)
+          {
+            Math::FixedMatrix<c_axes, c_fins> b(eff);
+            for (int j = 0; j < c_fins; ++j)
+            {
+              if (!(set & (1 << j)))
+              {
+                for (int i = 0; i < c_axes; ++i)
+                  b(i, j) = 0;
+              }
+            }
+
+            Math::FixedMatrix<c_axes, c_axes> gram = b * transpose(b);
+            for (int i = 0; i < c_axes; ++i)
+              gram(i, i) += c_damping;
+
+            Math::FixedMatrix<c_fins, c_axes> pinv = transpose(b) * Math::inverse(gram);
+            Math::FixedMatrix<c_axes, c_axes> produced = b * pinv;
+
+            for (int a = 0; a < c_axes; ++a)
+            {
+              bool exact = true;
+              for (int i = 0; i < c_axes; ++i)
+              {
+                if (std::fabs(produced(i, a) - (i == a ? 1.0 : 0.0)) > c_tolerance)
+                  exact = false;
+              }
+
+              for (int j = 0; j < c_fins; ++j)
+                m_dirs[set][a][j] = exact ? pinv(j, a) : 0.0f;
+            }
+          }
         }
 
         void
@@ -259,87 +343,81 @@ namespace Control
           allocate(0, 0, 0);
         }
 
-        //! Allocate desired control torques on the fins
+        //! Allocate desired control torques on the fins. Torques are
+        //! allocated in order of importance (N, M and K) along the
+        //! directions of the available fins. When a fin saturates, the
+        //! remaining torque is allocated along the directions of the
+        //! fins left, without changing torques already allocated.
         //! @param[in] k desired control torque in roll
         //! @param[in] m desired control torque in pitch
         //! @param[in] n desired control torque in yaw
         void
         allocate(float k, float m, float n)
         {
-          float ang;
-          float roll_margin_vfins;
-          float roll_margin_hfins;
+          float desired[c_axes] = {k, m, n};
+          float fins[c_fins] = {0.0f};
+          float allocated[c_axes];
 
-          // Allocate N
-          ang = (n / m_args.conv[2]) * 0.5;
-
-          if (trimValueMod(ang, -m_args.max_fin_rot, m_args.max_fin_rot))
-          {
-            roll_margin_vfins = 0;
-          }
-          else
+          for (int o = 0; o < c_axes; ++o)
           {
-            // Calculate the control margins for roll on the N fins
-            roll_margin_vfins = m_args.max_fin_rot - std::abs(ang);
-          }
-
-          m_fins[0].value = -ang;
-          m_fins[3].value = -ang;
-          m_allocated.n = ang * m_args.conv[2] * 2.0;
+            int axis = c_order[o];
+            float left = desired[axis];
+            unsigned set = m_available;
 
-          // Allocate M
-          ang = (m / m_args.conv[1]) * 0.5;
+            for (int step = 0; step < c_fins && left != 0.0f && set != 0; ++step)
+            {
+              const float* dir = m_dirs[set][axis];
+
+              // Largest fraction of the torque left before a fin saturates.
+              float frac = 1.0f;
+              unsigned moving = 0;
+              unsigned blocked = 0;
+              for (int i = 0; i < c_fins; ++i)
+              {
+                float delta = dir[i] * left;
+                if (delta == 0.0f)
+                  continue;
+
+                moving |= 1u << i;
+
+                float room = (delta > 0 ? m_args.max_fin_rot : -m_args.max_fin_rot) - fins[i];
+                float f = std::max(room / delta, 0.0f);
+
+                if (f < frac)
+                {
+                  frac = f;
+                  blocked = 1u << i;
+                }
+                else if (f == frac)
+                {
+                  blocked |= 1u << i;
+                }
+              }
+
+              // This subset of fins cannot produce the torque alone.
+              if (moving == 0)
+                break;
+
+              for (int i = 0; i < c_fins; ++i)
+                fins[i] += frac * dir[i] * left;
+
+              left -= frac * left;
+
+              if (frac >= 1.0f)
+                break;
+
+              set &= ~blocked;
+            }
 
-          if (trimValueMod(ang, -m_args.max_fin_rot, m_args.max_fin_rot))
-          {
-            roll_margin_hfins = 0;
+            allocated[axis] = desired[axis] - left;
           }
-          else
-          {
-            // Calculate the control margins for roll on the N fins
-            roll_margin_hfins = m_args.max_fin_rot - std::abs(ang);
-          }
-
-          m_fins[1].value = -ang;
-          m_fins[2].value = -ang;
-          m_allocated.m = ang * m_args.conv[1] * 2.0;
-
-          // Allocate K
-          // Attempt to distribute evenly by the four fins
-          ang = (k / m_args.conv[0]) / c_fins;
-
-          // Determine the maximum angle for even distribution
-          ang = trimValue(ang, -roll_margin_hfins, roll_margin_hfins);
-          ang = trimValue(ang, -roll_margin_vfins, roll_margin_vfins);
-
-          m_fins[1].value += ang;
-          m_fins[2].value -= ang;
-          m_fins[0].value -= ang;
-          m_fins[3].value += ang;
 
-          // Remove the used up margin from the avaliable margins
-          roll_margin_hfins -= std::abs(ang);
-          roll_margin_vfins -= std::abs(ang);
-          m_allocated.k = ang * m_args.conv[0] * c_fins;
+          for (int i = 0; i < c_fins; ++i)
+            m_fins[i].value = fins[i];
 
-          // Check where to place the remaining roll torque
-          ang = ((k - m_allocated.k) / m_args.conv[0]) * 0.5;
-          if (roll_margin_hfins > 0)
-          {
-            ang = trimValue(ang, -roll_margin_hfins, roll_margin_hfins);
-
-            m_fins[1].value += ang;
-            m_fins[2].value -= ang;
-            m_allocated.k += ang * m_args.conv[0] * 2.0;
-          }
-          else if (roll_margin_vfins > 0)
-          {
-            ang = trimValue(ang, -roll_margin_vfins, roll_margin_vfins);
-
-            m_fins[0].value -= ang;
-            m_fins[3].value += ang;
-            m_allocated.k += ang * m_args.conv[0] * 2.0;
-          }
+          m_allocated.k = allocated[0];
+          m_allocated.m = allocated[1];
+          m_allocated.n = allocated[2];
 
           dispatchAllFins();
 
@@ -111,6 +111,8 @@ namespace Control
         bool error_attitude;
         //! Log PID gain parcels
         bool log_parcels;
+        //! Steps between logged PID parcels
+        unsigned parcel_decimation;
         //! Altitude value below which altitude from DVL will be ignored
         float min_dvl_alt;
         //! Depth value below which altitude from DVL will be ignored
@@ -120,7 +122,7 @@ namespace Control
       struct Task: public DUNE::Control::BasicAutopilot
       {
         //! PID Controllers
-        DiscretePID m_pid[LP_MAX_LOOPS];
+        PIDBank<LP_MAX_LOOPS> m_pid;
         //! Heading controller heading rate reference
         IMC::DesiredHeadingRate m_hrate_ref;
         //! Depth controller pitch reference
@@ -218,6 +220,11 @@ namespace Control
           .defaultValue("false")
           .description("Log the size of each PID parcel");
 
+          param("PID Parcel Decimation", m_args.parcel_decimation)
+          .defaultValue("1")
+          .minimumValue("1")
+          .description("Number of controller steps between logged PID parcels");
+
           param("Minimum DVL Depth", m_args.min_dvl_depth)
           .defaultValue("2.5")
           .description("Depth value below which altitude from DVL will be ignored");
@@ -347,14 +354,14 @@ namespace Control
           // Setting pid gains and integral limits
           for (unsigned i = 0; i < LP_MAX_LOOPS; ++i)
           {
-            m_pid[i].setGains(m_args.gains[i]);
-            m_pid[i].setOutputLimits(-output_limits[i], output_limits[i]);
-            m_pid[i].setIntegralLimits(m_args.max_int[i]);
-
-            // Debug parcels
-            if (m_args.log_parcels)
-              m_pid[i].enableParcels(this, &m_parcels[i]);
+            m_pid.setGains(i, m_args.gains[i]);
+            m_pid.setOutputLimits(i, -output_limits[i], output_limits[i]);
+            m_pid.setIntegralLimits(i, m_args.max_int[i]);
           }
+
+          // Debug parcels
+          if (m_args.log_parcels)
+            m_pid.enableParcels(this, m_parcels, m_args.parcel_decimation);
         }
 
         //! Member variable reset function
@@ -363,8 +370,7 @@ namespace Control
         {
           BasicAutopilot::reset();
 
-          for (unsigned i = 0; i < LP_MAX_LOOPS; ++i)
-            m_pid[i].reset();
+          m_pid.reset();
         }
 
         //! Reserve entities for messages
@@ -494,8 +500,8 @@ namespace Control
             if (!surface)
             {
               // Positive depth implies negative pitch
-              cmd = -m_pid[LP_DEPTH].step(timestep, z_error,
-                                          -(-sin(msg->theta) * msg->u + cos(msg->theta) * (sin(msg->phi) * msg->v + cos(msg->phi) * msg->w)));
+              cmd = -m_pid.step(LP_DEPTH, timestep, z_error,
+                                -(-sin(msg->theta) * msg->u + cos(msg->theta) * (sin(msg->phi) * msg->v + cos(msg->phi) * msg->w)));
             }
             else
             {
@@ -514,7 +520,7 @@ namespace Control
           if (m_args.error_attitude)
             return pitch_err;
 
-          cmd = m_pid[LP_PITCH].step(timestep, pitch_err, -(msg->q * cos(msg->phi) - msg->r * sin(msg->phi)));
+          cmd = m_pid.step(LP_PITCH, timestep, pitch_err, -(msg->q * cos(msg->phi) - msg->r * sin(msg->phi)));
           return cmd;
         }
 
@@ -532,7 +538,7 @@ namespace Control
 
           float cmd;
 
-          cmd = m_pid[LP_ROLL].step(timestep, ref - msg->phi, -(msg->p + tan(msg->theta) * (sin(msg->phi) * msg->q + cos(msg->phi) * msg->r)));
+          cmd = m_pid.step(LP_ROLL, timestep, ref - msg->phi, -(msg->p + tan(msg->theta) * (sin(msg->phi) * msg->q + cos(msg->phi) * msg->r)));
           return cmd;
         }
 
@@ -549,7 +555,7 @@ namespace Control
           {
             case YAW_MODE_HEADING:
               // Outer heading controller
-              cmd = m_pid[LP_HEADING].step(timestep, Angles::normalizeRadian(getYawRef() - msg->psi), -(sin(msg->phi) * msg->q + cos(msg->phi) * msg->r) / cos(msg->theta));
+              cmd = m_pid.step(LP_HEADING, timestep, Angles::normalizeRadian(getYawRef() - msg->psi), -(sin(msg->phi) * msg->q + cos(msg->phi) * msg->r) / cos(msg->theta));
 
               // Log the desired hrate
               m_hrate_ref.value = cmd;
@@ -574,7 +580,7 @@ namespace Control
             return heading_err;
 
           if (!m_args.hrate_oloop)
-            cmd = m_pid[LP_HRATE].step(timestep, heading_err);
+            cmd = m_pid.step(LP_HRATE, timestep, heading_err);
           else
             cmd = m_args.gains[LP_HRATE][0] * cmd;
 
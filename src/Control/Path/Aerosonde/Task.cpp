@@ -108,6 +108,12 @@ namespace Control
           enableControlLoops(IMC::CL_ROLL);
         }
 
+        bool
+        usesLineOfSight(void) const
+        {
+          return false;
+        }
+
         void
         consume(const IMC::IndicatedSpeed* airspeed)
         {
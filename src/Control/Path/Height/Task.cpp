@@ -99,6 +99,12 @@ namespace Control
           m_first_run = true;
         }
 
+        bool
+        usesLineOfSight(void) const
+        {
+          return false;
+        }
+
         void
         consume(const IMC::IndicatedSpeed* airspeed)
         {
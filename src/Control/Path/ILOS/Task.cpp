@@ -144,6 +144,12 @@ namespace Control
           enableControlLoops(IMC::CL_YAW);
         }
 
+        bool
+        usesLineOfSight(void) const
+        {
+          return false;
+        }
+
         void
         onReportEntityState(void)
         {
@@ -119,6 +119,12 @@ namespace Control
           enableControlLoops(IMC::CL_YAW);
         }
 
+        bool
+        usesLineOfSight(void) const
+        {
+          return false;
+        }
+
         //! Execute a path control step
         //! From base class PathController
         void
@@ -148,7 +154,7 @@ namespace Control
             ref = ts.track_bearing
             - std::pow(kcorr, m_args.ext_gain) * m_args.entry_angle
             * (1 +
-               (m_gain * ts.speed * std::sin(ts.course - ts.track_bearing))
+               (m_gain * ts.track_vel.y)
                / (m_args.ext_trgain * ts.track_pos.y));
           }
           else
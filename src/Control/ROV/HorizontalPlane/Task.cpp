@@ -83,12 +83,13 @@ namespace Control
         Matrix tmat;
         bool stabilize_ground;
         bool log_parcels;
+        unsigned parcel_decimation;
       };
 
       struct Task: public DUNE::Control::BasicAutopilot
       {
         //! PID controllers
-        DiscretePID m_pid[LP_MAX_LOOPS];
+        PIDBank<LP_MAX_LOOPS> m_pid;
         //! PID parcels
         IMC::ControlParcel m_parcels[LP_MAX_LOOPS];
         //! Task Arguments
@@ -155,6 +156,11 @@ namespace Control
           param("Log PID Parcels", m_args.log_parcels)
           .defaultValue("true")
           .description("Log the size of each PID parcel");
+
+          param("PID Parcel Decimation", m_args.parcel_decimation)
+          .defaultValue("1")
+          .minimumValue("1")
+          .description("Number of controller steps between logged PID parcels");
         }
 
         void
@@ -162,8 +168,7 @@ namespace Control
         {
           BasicAutopilot::reset();
 
-          for (unsigned i = 0; i < LP_MAX_LOOPS; ++i)
-            m_pid[i].reset();
+          m_pid.reset();
         }
 
         void
@@ -196,19 +201,19 @@ namespace Control
           // Setting pid gains and integral limits
           for (unsigned i = 0; i < LP_MAX_LOOPS; ++i)
           {
-            m_pid[i].setGains(m_args.gains[i]);
-            m_pid[i].setOutputLimits(-output_limits[i], output_limits[i]);
-
-            // Debug parcels
-            if (m_args.log_parcels)
-              m_pid[i].enableParcels(this, &m_parcels[i]);
+            m_pid.setGains(i, m_args.gains[i]);
+            m_pid.setOutputLimits(i, -output_limits[i], output_limits[i]);
           }
 
+          // Debug parcels
+          if (m_args.log_parcels)
+            m_pid.enableParcels(this, m_parcels, m_args.parcel_decimation);
+
           // Heading control parameters.
-          m_pid[LP_HEADING].setIntegralLimits(m_args.int_heading_limit);
+          m_pid.setIntegralLimits(LP_HEADING, m_args.int_heading_limit);
 
           // Heading rate control parameters.
-          m_pid[LP_HRATE].setIntegralLimits(m_args.int_hrate_limit);
+          m_pid.setIntegralLimits(LP_HRATE, m_args.int_hrate_limit);
         }
 
         void
@@ -242,7 +247,7 @@ namespace Control
             return 0.0;
 
           float cmd;
-          cmd = m_pid[LP_SURGE].step(timestep, ref - msg->u, 0);
+          cmd = m_pid.step(LP_SURGE, timestep, ref - msg->u, 0);
           return cmd;
         }
 
@@ -256,7 +261,7 @@ namespace Control
             return 0.0;
 
           float cmd;
-          cmd = m_pid[LP_SWAY].step(timestep, ref - msg->v, 0);
+          cmd = m_pid.step(LP_SWAY, timestep, ref - msg->v, 0);
           return cmd;
         }
 
@@ -279,8 +284,8 @@ namespace Control
           {
             case YAW_MODE_HEADING:
               // Outer heading controller
-              cmd = m_pid[LP_HEADING].step(timestep,
-                                           Angles::normalizeRadian(getYawRef() - msg->psi));
+              cmd = m_pid.step(LP_HEADING, timestep,
+                               Angles::normalizeRadian(getYawRef() - msg->psi));
 
               // Log the desired hrate
               logDesiredHRate(cmd);
@@ -298,7 +303,7 @@ namespace Control
 
           // Inner heading rate controller
           float hrate_err = cmd - msg->r;
-          cmd = m_pid[LP_HRATE].step(timestep, hrate_err, 0);
+          cmd = m_pid.step(LP_HRATE, timestep, hrate_err, 0);
 
           return cmd;
         }
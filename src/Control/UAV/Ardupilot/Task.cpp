@@ -31,6 +31,7 @@
 // ISO C++ 98 headers.
 #include <vector>
 #include <cmath>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -46,6 +47,13 @@ namespace Control
     {
       using DUNE_NAMESPACES;
 
+      //! Extra CRC byte of each MAVLink message.
+      static const uint8_t c_crc_extra[256] = MAVLINK_MESSAGE_CRCS;
+      //! Size of the receive buffer.
+      static const unsigned c_rx_size = 4096;
+      //! Outgoing bytes that force a write before the end of a cycle.
+      static const unsigned c_tx_size = 4096;
+
       //! APM Type specifier
       enum APM_Vehicle {
         //! Unset or unknown vehicle type
@@ -100,6 +108,12 @@ namespace Control
         RadioChannel rc8;
         //! FBWB Mode
         int fbwb_mode;
+        //! Minimum period between republished telemetry messages.
+        double telemetry_period;
+        //! Time without mission transfer progress before retrying.
+        double mission_timeout;
+        //! Maximum number of mission transfer retries.
+        unsigned mission_retries;
       };
 
       struct Task: public DUNE::Tasks::Task
@@ -108,10 +122,35 @@ namespace Control
         Arguments m_args;
         //! Arduino packet handling
         typedef void (Task::* PktHandler)(const mavlink_message_t* msg);
-        typedef std::map<int, PktHandler> PktHandlerMap;
-        PktHandlerMap m_mlh;
+        //! Packet handlers, by message id.
+        PktHandler m_mlh[256];
+        //! Throttled messages, by message id.
+        bool m_throttle[256];
+        //! Time of the last handled message, by message id.
+        double m_handled[256];
         double m_last_pkt_time;
-        uint8_t m_buf[512];
+        //! Receive buffer.
+        uint8_t m_buf[c_rx_size];
+        //! Number of bytes in the receive buffer.
+        unsigned m_buf_len;
+        //! Outgoing packets waiting to be written.
+        std::vector<uint8_t> m_obuf;
+        //! Outgoing message.
+        mavlink_message_t m_msg_out;
+        //! Number of corrupted packets.
+        unsigned m_parse_errors;
+        //! Encoded mission items being transferred.
+        std::vector<uint8_t> m_mission;
+        //! Offset of each encoded mission item.
+        std::vector<size_t> m_mission_items;
+        //! Sequence number of the first mission item.
+        uint16_t m_mission_start;
+        //! Mission transfer in progress.
+        bool m_mission_active;
+        //! Number of retries of the current mission transfer.
+        unsigned m_mission_retry;
+        //! Mission transfer progress timer.
+        Time::Counter<double> m_mission_timer;
         //! Estimated state message.
         IMC::EstimatedState m_estate;
         //! Battery messages
@@ -319,8 +358,35 @@ namespace Control
           .defaultValue("4")
           .description("Mode set up on FBWB");
 
+          param("Telemetry Republish Period", m_args.telemetry_period)
+          .defaultValue("0.0")
+          .minimumValue("0.0")
+          .units(Units::Second)
+          .description("Minimum period between IMC messages republished from"
+                       " high-rate Ardupilot telemetry. Set to zero to republish"
+                       " every packet");
+
+          param("Mission Timeout", m_args.mission_timeout)
+          .defaultValue("3.0")
+          .minimumValue("0.5")
+          .units(Units::Second)
+          .description("Time without progress of a mission transfer before it"
+                       " is restarted");
+
+          param("Mission Retries", m_args.mission_retries)
+          .defaultValue("3")
+          .description("Number of times a mission transfer is restarted before"
+                       " giving up");
+
           // Setup packet handlers
           // IMPORTANT: set up function to handle each type of MAVLINK packet here
+          for (unsigned i = 0; i < 256; ++i)
+          {
+            m_mlh[i] = NULL;
+            m_throttle[i] = false;
+            m_handled[i] = 0.0;
+          }
+
           m_mlh[MAVLINK_MSG_ID_ATTITUDE] = &Task::handleAttitudePacket;
           m_mlh[MAVLINK_MSG_ID_GLOBAL_POSITION_INT] = &Task::handlePositionPacket;
           m_mlh[MAVLINK_MSG_ID_HWSTATUS] = &Task::handleHWStatusPacket;
@@ -337,6 +403,15 @@ namespace Control
           m_mlh[MAVLINK_MSG_ID_SYS_STATUS] = &Task::handleSystemStatusPacket;
           m_mlh[MAVLINK_MSG_ID_VFR_HUD] = &Task::handleHUDPacket;
           m_mlh[MAVLINK_MSG_ID_SYSTEM_TIME] = &Task::handleSystemTimePacket;
+          m_mlh[MAVLINK_MSG_ID_MISSION_REQUEST] = &Task::handleMissionRequestPacket;
+
+          // High-rate telemetry that may be throttled.
+          m_throttle[MAVLINK_MSG_ID_GLOBAL_POSITION_INT] = true;
+          m_throttle[MAVLINK_MSG_ID_VFR_HUD] = true;
+          m_throttle[MAVLINK_MSG_ID_SCALED_PRESSURE] = true;
+          m_throttle[MAVLINK_MSG_ID_SYS_STATUS] = true;
+          m_throttle[MAVLINK_MSG_ID_HWSTATUS] = true;
+          m_throttle[MAVLINK_MSG_ID_WIND] = true;
 
 
           // Setup processing of IMC messages
@@ -352,6 +427,12 @@ namespace Control
 
           // Misc. initialization
           m_last_pkt_time = 0; // time of last packet from Ardupilot
+          m_buf_len = 0;
+          m_parse_errors = 0;
+          m_mission_start = 0;
+          m_mission_active = false;
+          m_mission_retry = 0;
+          m_obuf.reserve(c_tx_size + MAVLINK_MAX_PACKET_LEN);
           m_estate.clear();
         }
 
@@ -376,6 +457,7 @@ namespace Control
           m_args.rc2.val_min = -m_args.rc2.val_max;
           m_args.rc8.val_min = 1;
           m_args.rc8.val_max = 6;
+          m_mission_timer.setTop(m_args.mission_timeout);
         }
 
         void
@@ -399,8 +481,7 @@ namespace Control
         void
         setupRate(uint8_t rate)
         {
-          uint8_t buf[512];
-          mavlink_message_t* msg = new mavlink_message_t;
+          mavlink_message_t* msg = &m_msg_out;
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
                                                m_sysid,
@@ -409,8 +490,7 @@ namespace Control
                                                rate,
                                                1);
 
-          uint16_t n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("ATTITUDE Stream setup to %d Hertz", rate);
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
@@ -420,8 +500,7 @@ namespace Control
                                                rate,
                                                1);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("VFR Stream setup to %d Hertz", rate);
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
@@ -431,8 +510,7 @@ namespace Control
                                                rate,
                                                1);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("POSITION Stream setup to %d Hertz", rate);
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
@@ -442,8 +520,7 @@ namespace Control
                                                (int)(rate/5),
                                                1);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("STATUS Stream setup to %d Hertz", (int)(rate/5));
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
@@ -453,8 +530,7 @@ namespace Control
                                                1,
                                                1);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("AHRS-HWSTATUS-WIND Stream setup to 1 Hertz");
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
@@ -464,8 +540,7 @@ namespace Control
                                                1,
                                                1);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("SENSORS Stream setup to 1 Hertz");
 
           mavlink_msg_request_data_stream_pack(255, 0, msg,
@@ -475,8 +550,7 @@ namespace Control
                                                1,
                                                0);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
           spew("RC Stream disabled");
         }
 
@@ -515,9 +589,7 @@ namespace Control
 
             if ((cloops->mask & IMC::CL_ROLL) && !m_ground)
             {
-              mavlink_message_t* msg = new mavlink_message_t;
-              uint8_t buf[512];
-
+              mavlink_message_t* msg = &m_msg_out;
               //! Disabling RC override
               mavlink_msg_rc_channels_override_pack(255, 0, msg,
                                                     1,
@@ -530,8 +602,7 @@ namespace Control
                                                     0, //! RC Channel 6 (not used)
                                                     0, //! RC Channel 7 (not used)
                                                     0);//! RC Channel 8 (mode)
-              uint16_t n = mavlink_msg_to_send_buffer(buf, msg);
-              sendData(buf, n);
+              sendMessage(msg);
 
               sendCommandPacket(MAV_CMD_NAV_LOITER_UNLIM);
               inf(DTR("Loiter"));
@@ -550,16 +621,14 @@ namespace Control
         void
         activateFBW(void)
         {
-          uint8_t buf[512];
-          mavlink_message_t* msg = new mavlink_message_t;
+          mavlink_message_t* msg = &m_msg_out;
 
           mavlink_msg_set_mode_pack(255, 0, msg,
                                     m_sysid,
                                     1,
                                     6); //!FBWB
 
-          uint16_t n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
         }
 
         void
@@ -597,9 +666,7 @@ namespace Control
 
           activateFBW();
 
-          uint8_t buf[512];
-
-          mavlink_message_t* msg = new mavlink_message_t;
+          mavlink_message_t* msg = &m_msg_out;
           mavlink_msg_rc_channels_override_pack(255, 0, msg,
                                                 1,
                                                 1,
@@ -611,8 +678,7 @@ namespace Control
                                                 0, //! RC Channel 6 (not used)
                                                 0, //! RC Channel 7 (not used)
                                                 pwm_fbwb);//! RC Channel 8 (mode)
-          uint16_t n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
         }
 
         void
@@ -684,9 +750,7 @@ namespace Control
             return;
           }
 
-          uint8_t buf[512];
-
-          mavlink_message_t* msg = new mavlink_message_t;
+          mavlink_message_t* msg = &m_msg_out;
 
           mavlink_msg_param_set_pack(255, 0, msg,
                                      m_sysid, //! target_system System ID
@@ -695,8 +759,7 @@ namespace Control
                                      (int)(path->speed * 100), //! Parameter value
                                      MAV_PARAM_TYPE_INT16); //! Parameter type
 
-          int n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
 
           mavlink_msg_param_set_pack(255, 0, msg,
                                      m_sysid, //! target_system System ID
@@ -705,49 +768,28 @@ namespace Control
                                      path->flags & DesiredPath::FL_CCLOCKW ? (-1 * path->lradius) : (path->lradius), //! Parameter value
                                      MAV_PARAM_TYPE_INT16); //! Parameter type
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
 
           m_desired_radius = (uint16_t) path->lradius;
 
-          mavlink_msg_mission_count_pack(255, 0, msg,
-                                         m_sysid, //! target_system System ID
-                                         0, //! target_component Component ID
-                                         3); //! size of Mission
-
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
-
-          mavlink_msg_mission_write_partial_list_pack(255, 0, msg,
-                                                      m_sysid, //! target_system System ID
-                                                      0, //! target_component Component ID
-                                                      1, //! start_index Start index, 0 by default and smaller / equal to the largest index of the current onboard list
-                                                      1); //! end_index End index, equal or greater than start index
-
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
-
           float alt = (path->end_z_units & IMC::Z_NONE) ? m_args.alt : (float)path->end_z;
 
           //! Destination
-          mavlink_msg_mission_item_pack(255, 0, msg,
-                                        m_sysid, //! target_system System ID
-                                        0, //! target_component Component ID
-                                        1, //! seq Sequence
-                                        MAV_FRAME_GLOBAL, //! frame The coordinate system of the MISSION. see MAV_FRAME in mavlink_types.h
-                                        MAV_CMD_NAV_LOITER_UNLIM, //! command The scheduled action for the MISSION. see MAV_CMD in ardupilotmega.h
-                                        2, //! current false:0, true:1
-                                        0, //! autocontinue to next wp
-                                        0, //! Not used
-                                        0, //! Not used
-                                        path->flags & DesiredPath::FL_CCLOCKW ? -1 : 0, //! If <0, then CCW loiter
-                                        0, //! Not used
-                                        (float)Angles::degrees(path->end_lat), //! x PARAM5 / local: x position, global: latitude
-                                        (float)Angles::degrees(path->end_lon), //! y PARAM6 / y position: global: longitude
-                                        alt);//! z PARAM7 / z position: global: altitude
-
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          beginMission();
+          addMissionItem(1, //! seq Sequence
+                         MAV_CMD_NAV_LOITER_UNLIM, //! command The scheduled action for the MISSION. see MAV_CMD in ardupilotmega.h
+                         2, //! current false:0, true:1
+                         0, //! autocontinue to next wp
+                         0, //! Not used
+                         0, //! Not used
+                         path->flags & DesiredPath::FL_CCLOCKW ? -1 : 0, //! If <0, then CCW loiter
+                         0, //! Not used
+                         (float)Angles::degrees(path->end_lat), //! x PARAM5 / local: x position, global: latitude
+                         (float)Angles::degrees(path->end_lon), //! y PARAM6 / y position: global: longitude
+                         alt);//! z PARAM7 / z position: global: altitude
+
+          // Incremental edit of the loiter item.
+          uploadMission();
 
           m_changing_wp = true;
 
@@ -772,10 +814,9 @@ namespace Control
         void
         takeoff(const IMC::DesiredPath* dpath)
         {
-          uint8_t buf[512];
           int seq = 1;
 
-          mavlink_message_t* msg = new mavlink_message_t;
+          mavlink_message_t* msg = &m_msg_out;
 
           mavlink_msg_param_set_pack(255, 0, msg,
               m_sysid, //! target_system System ID
@@ -784,32 +825,25 @@ namespace Control
               dpath->flags & DesiredPath::FL_CCLOCKW ? (-1 * dpath->lradius) : (dpath->lradius), //! Parameter value
               MAV_PARAM_TYPE_INT16); //! Parameter type
 
-          uint16_t n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
 
-          mavlink_msg_mission_count_pack(255, 0, msg,
-              m_sysid, //! target_system System ID
-              0, //! target_component Component ID
-              4); //! size of Mission
-
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
-
-          mavlink_msg_mission_write_partial_list_pack(255, 0, msg,
-              m_sysid, //! target_system System ID
-              0, //! target_component Component ID
-              seq, //! start_index Start index, 0 by default and smaller / equal to the largest index of the current onboard list
-              seq+2); //! end_index End index, equal or greater than start index
+          beginMission();
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          //! Home
+          addMissionItem(0, //! seq Sequence
+              MAV_CMD_NAV_WAYPOINT, //! command The scheduled action for the MISSION. see MAV_CMD in ardupilotmega.h
+              0, //! current false:0, true:1
+              1, //! autocontinue autocontinue to next wp
+              0, //! Not used
+              0, //! Not used
+              0, //! Not used
+              0, //! Not used
+              (float)m_lat, //! x PARAM5 / local: x position, global: latitude
+              (float)m_lon, //! y PARAM6 / y position: global: longitude
+              m_alt);//! z PARAM7 / z position: global: altitude
 
           //! Current position
-          mavlink_msg_mission_item_pack(255, 0, msg,
-              m_sysid, //! target_system System ID
-              0, //! target_component Component ID
-              seq++, //! seq Sequence
-              MAV_FRAME_GLOBAL, //! frame The coordinate system of the MISSION. see MAV_FRAME in mavlink_types.h
+          addMissionItem(seq++, //! seq Sequence
               MAV_CMD_NAV_TAKEOFF, //! command The scheduled action for the MISSION. see MAV_CMD in ardupilotmega.h
               1, //! current false:0, true:1
               1, //! autocontinue autocontinue to next wp
@@ -821,15 +855,8 @@ namespace Control
               0, //! y PARAM6 / y position: global: longitude
               m_alt + 10);//! z PARAM7 / z position: global: altitude
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
-
           //! Desired speed
-          mavlink_msg_mission_item_pack(255, 0, msg,
-              m_sysid, //! target_system System ID
-              0, //! target_component Component ID
-              seq++, //! seq Sequence
-              MAV_FRAME_GLOBAL, //! frame The coordinate system of the MISSION. see MAV_FRAME in mavlink_types.h
+          addMissionItem(seq++, //! seq Sequence
               MAV_CMD_DO_CHANGE_SPEED, //! command The scheduled action for the MISSION. see MAV_CMD in common.xml MAVLink specs
               0, //! current false:0, true:1
               1, //! autocontinue autocontinue to next wp
@@ -841,15 +868,8 @@ namespace Control
               0, //! Not used
               0);//! Not used
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
-
           //! Destination
-          mavlink_msg_mission_item_pack(255, 0, msg,
-              m_sysid, //! target_system System ID
-              0, //! target_component Component ID
-              seq++, //! seq Sequence
-              MAV_FRAME_GLOBAL, //! frame The coordinate system of the MISSION. see MAV_FRAME in mavlink_types.h
+          addMissionItem(seq++, //! seq Sequence
               (dpath->lradius ? MAV_CMD_NAV_LOITER_UNLIM : MAV_CMD_NAV_WAYPOINT), //! command The scheduled action for the MISSION. see MAV_CMD in ardupilotmega.h
               0, //! current false:0, true:1
               0, //! autocontinue autocontinue to next wp
@@ -861,8 +881,8 @@ namespace Control
               (float)Angles::degrees(dpath->end_lon), //! y PARAM6 / y position: global: longitude
               (float)(dpath->end_z));//! z PARAM7 / z position: global: altitude
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          // Whole mission, home included.
+          uploadMission();
 
           sendCommandPacket(MAV_CMD_DO_SET_MODE, MAV_MODE_AUTO_DISARMED);
 
@@ -871,8 +891,7 @@ namespace Control
               0,
               1);
 
-          n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
 
           m_pcs.start_lat = Angles::radians(m_lat);
           m_pcs.start_lon = Angles::radians(m_lon);
@@ -895,6 +914,108 @@ namespace Control
           debug(DTR("Waypoint packet sent to Ardupilot"));
         }
 
+        //! Discard the encoded mission.
+        void
+        beginMission(void)
+        {
+          m_mission.clear();
+          m_mission_items.clear();
+          m_mission_active = false;
+        }
+
+        //! Encode a mission item. Items must be added in sequence.
+        void
+        addMissionItem(uint16_t seq, uint16_t cmd, uint8_t current, uint8_t autocontinue,
+                       float p1, float p2, float p3, float p4, float x, float y, float z)
+        {
+          if (m_mission_items.empty())
+            m_mission_start = seq;
+
+          mavlink_msg_mission_item_pack(255, 0, &m_msg_out,
+                                        m_sysid, //! target_system System ID
+                                        0, //! target_component Component ID
+                                        seq, MAV_FRAME_GLOBAL, cmd, current, autocontinue,
+                                        p1, p2, p3, p4, x, y, z);
+
+          size_t offset = m_mission.size();
+          m_mission.resize(offset + MAVLINK_MAX_PACKET_LEN);
+          uint16_t n = mavlink_msg_to_send_buffer(&m_mission[offset], &m_msg_out);
+          m_mission.resize(offset + n);
+          m_mission_items.push_back(offset);
+        }
+
+        //! Queue an encoded mission item for writing.
+        //! @param[in] index item index.
+        void
+        sendMissionItem(size_t index)
+        {
+          size_t begin = m_mission_items[index];
+          size_t end = (index + 1 < m_mission_items.size()) ? m_mission_items[index + 1] : m_mission.size();
+          m_obuf.insert(m_obuf.end(), m_mission.begin() + begin, m_mission.begin() + end);
+        }
+
+        //! Start the transfer of the encoded mission. A mission
+        //! starting at the first item replaces the whole mission,
+        //! otherwise only the encoded items are replaced. All items
+        //! are pushed right after the transfer request, so the
+        //! autopilot normally takes them without asking; items it does
+        //! request are answered from the encoded mission.
+        //! @param[in] retry true if restarting a stalled transfer.
+        void
+        uploadMission(bool retry = false)
+        {
+          if (m_mission_items.empty())
+            return;
+
+          uint16_t count = m_mission_items.size();
+
+          if (m_mission_start == 0)
+            mavlink_msg_mission_count_pack(255, 0, &m_msg_out,
+                                           m_sysid, //! target_system System ID
+                                           0, //! target_component Component ID
+                                           count); //! size of Mission
+          else
+            mavlink_msg_mission_write_partial_list_pack(255, 0, &m_msg_out,
+                                                        m_sysid, //! target_system System ID
+                                                        0, //! target_component Component ID
+                                                        m_mission_start, //! start_index
+                                                        m_mission_start + count - 1); //! end_index
+
+          sendMessage(&m_msg_out);
+
+          for (size_t i = 0; i < m_mission_items.size(); ++i)
+            sendMissionItem(i);
+
+          flushMessages();
+
+          if (!retry)
+            m_mission_retry = 0;
+
+          m_mission_active = true;
+          m_mission_timer.reset();
+        }
+
+        //! Restart the mission transfer if the autopilot stopped
+        //! asking for items without acknowledging the mission.
+        void
+        checkMission(void)
+        {
+          if (!m_mission_active || !m_mission_timer.overflow())
+            return;
+
+          if (m_mission_retry >= m_args.mission_retries)
+          {
+            err(DTR("mission transfer timed out"));
+            m_mission_active = false;
+            m_changing_wp = false;
+            return;
+          }
+
+          ++m_mission_retry;
+          war(DTR("mission transfer stalled, retrying (%u)"), m_mission_retry);
+          uploadMission(true);
+        }
+
         void
         loiterHere(void)
         {
@@ -902,9 +1023,7 @@ namespace Control
           if ((getEntityState() != IMC::EntityState::ESTA_NORMAL) || m_external || m_ground)
             return;
 
-          mavlink_message_t* msg = new mavlink_message_t;
-          uint8_t buf[512];
-
+          mavlink_message_t* msg = &m_msg_out;
           mavlink_msg_param_set_pack(255, 0, msg,
                                      m_sysid, //! target_system System ID
                                      0, //! target_component Component ID
@@ -912,8 +1031,7 @@ namespace Control
                                      m_args.lradius, //! Parameter value
                                      MAV_PARAM_TYPE_INT16); //! Parameter type
 
-          uint16_t n = mavlink_msg_to_send_buffer(buf, msg);
-          sendData(buf, n);
+          sendMessage(msg);
 
           sendCommandPacket(MAV_CMD_NAV_LOITER_UNLIM);
           debug("Sent LOITER packet to Ardupilot");
@@ -961,16 +1079,13 @@ namespace Control
         void
         sendCommandPacket(uint16_t cmd, float arg1=0, float arg2=0, float arg3=0, float arg4=0, float arg5=0, float arg6=0, float arg7=0)
         {
-          uint8_t buf[512];
-
           mavlink_message_t msg;
 
           trace("%0.2f %0.2f %0.2f %0.2f %0.2f %0.2f %0.2f", arg1, arg2, arg3, arg4, arg5, arg6, arg7);
 
           mavlink_msg_command_long_pack(255, 0, &msg, m_sysid, 0, cmd, 0, arg1, arg2, arg3, arg4, arg5, arg6, arg7);
 
-          uint16_t n = mavlink_msg_to_send_buffer(buf, &msg);
-          sendData(buf, n);
+          sendMessage(&msg);
         }
 
         void
@@ -1008,6 +1123,12 @@ namespace Control
 
             // Handle IMC messages from bus
             consumeMessages();
+
+            // Restart stalled mission transfers.
+            checkMission();
+
+            // Write the packets queued during this cycle.
+            flushMessages();
           }
         }
 
@@ -1020,6 +1141,31 @@ namespace Control
           return false;
         }
 
+        //! Queue a message to be written at the end of the cycle.
+        //! @param[in] msg message.
+        void
+        sendMessage(const mavlink_message_t* msg)
+        {
+          size_t offset = m_obuf.size();
+          m_obuf.resize(offset + MAVLINK_MAX_PACKET_LEN);
+          uint16_t n = mavlink_msg_to_send_buffer(&m_obuf[offset], msg);
+          m_obuf.resize(offset + n);
+
+          if (m_obuf.size() >= c_tx_size)
+            flushMessages();
+        }
+
+        //! Write all queued messages at once.
+        void
+        flushMessages(void)
+        {
+          if (m_obuf.empty())
+            return;
+
+          sendData(&m_obuf[0], m_obuf.size());
+          m_obuf.clear();
+        }
+
         int
         sendData(uint8_t* bfr, int size)
         {
@@ -1057,155 +1203,18 @@ namespace Control
         void
         handleArdupilotData(void)
         {
-          mavlink_status_t status;
-
           double now = Clock::get();
 
-          while (poll(0.01))
+          if (poll(0.01))
           {
-            int n = receiveData(m_buf, sizeof(m_buf));
+            int n = receiveData(m_buf + m_buf_len, sizeof(m_buf) - m_buf_len);
 
             if (n < 0)
-            {
               debug("Receive error");
-              break;
-            }
-
-
-            for (int i = 0; i < n; i++)
-            {
-              int rv = mavlink_parse_char(MAVLINK_COMM_0, m_buf[i], &m_msg, &status);
-              if (status.packet_rx_drop_count)
-              {
-                switch(status.parse_state)
-                {
-                  case MAVLINK_PARSE_STATE_IDLE:
-                    spew("failed at state IDLE");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_STX:
-                    spew("failed at state GOT_STX");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_LENGTH:
-                    spew("failed at state GOT_LENGTH");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_SYSID:
-                    spew("failed at state GOT_SYSID");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_COMPID:
-                    spew("failed at state GOT_COMPID");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_MSGID:
-                    spew("failed at state GOT_MSGID");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_PAYLOAD:
-                    spew("failed at state GOT_PAYLOAD");
-                    break;
-                  case MAVLINK_PARSE_STATE_GOT_CRC1:
-                    spew("failed at state GOT_CRC1");
-                    break;
-                  default:
-                    spew("failed OTHER");
-                }
-              }
-              if (rv)
-              {
-                switch ((int)m_msg.msgid)
-                {
-                  default:
-                    debug("UNDEF: %u", m_msg.msgid);
-                    break;
-                  case MAVLINK_MSG_ID_HEARTBEAT:
-                    trace("HEARTBEAT");
-                    break;
-                  case MAVLINK_MSG_ID_SYS_STATUS:
-                    trace("SYS_STATUS");
-                    break;
-                  case 22:
-                    trace("PARAM_VALUE");
-                    break;
-                  case MAVLINK_MSG_ID_GPS_RAW_INT:
-                    spew("GPS_RAW");
-                    break;
-                  case 27:
-                    trace("IMU_RAW");
-                    break;
-                  case MAVLINK_MSG_ID_SCALED_PRESSURE:
-                    spew("SCALED_PRESSURE");
-                    break;
-                  case MAVLINK_MSG_ID_ATTITUDE:
-                    spew("ATTITUDE");
-                    break;
-                  case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
-                    spew("GLOBAL_POSITION_INT");
-                    break;
-                  case 34:
-                    trace("RC_CHANNELS_SCALED");
-                    break;
-                  case 35:
-                    trace("RC_CHANNELS_RAW");
-                    break;
-                  case MAVLINK_MSG_ID_MISSION_ITEM:
-                    trace("MISSION_ITEM");
-                    break;
-                  case MAVLINK_MSG_ID_MISSION_CURRENT:
-                    trace("MISSION_CURRENT");
-                    break;
-                  case 44:
-                    trace("MISSION_COUNT");
-                    break;
-                  case MAVLINK_MSG_ID_MISSION_ACK:
-                    spew("MISSION_ACK");
-                    break;
-                  case MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT:
-                    trace("NAV_CONTROLLER_OUTPUT");
-                    break;
-                  case MAVLINK_MSG_ID_VFR_HUD:
-                    trace("VFR_HUD");
-                    break;
-                  case MAVLINK_MSG_ID_COMMAND_ACK:
-                    spew("CMD_ACK");
-                    break;
-                  case MAVLINK_MSG_ID_BATTERY_STATUS:
-                    spew("BATTERY_STAT");
-                    break;
-                  case 150:
-                    trace("SENSOR_OFFSETS");
-                    break;
-                  case 152:
-                    trace("MEMINFO");
-                    break;
-                  case 162:
-                    trace("FENCE_STATUS");
-                    break;
-                  case 163:
-                    trace("AHRS");
-                    break;
-                  case 164:
-                    trace("SIM_STATE");
-                    break;
-                  case MAVLINK_MSG_ID_HWSTATUS:
-                    spew("HW_STATUS");
-                    break;
-                  case MAVLINK_MSG_ID_WIND:
-                    spew("WIND");
-                    break;
-                  case MAVLINK_MSG_ID_STATUSTEXT:
-                    trace("STATUSTEXT");
-                    break;
-                }
-
-                PktHandler h = m_mlh[m_msg.msgid];
-
-                if (!h)
-                  continue;  // Ignore this packet (no handler for it)
-
-                // Call handler
-                (this->*h)(&m_msg);
-                m_sysid = m_msg.sysid;
+            else
+              m_buf_len += n;
 
-                m_last_pkt_time = now;
-              }
-            }
+            parsePackets(now);
           }
 
           if (now - m_last_pkt_time >= m_args.comm_timeout)
@@ -1220,6 +1229,171 @@ namespace Control
             m_error_missing = false;
         }
 
+        //! Handle every complete packet in the receive buffer. Packets
+        //! are validated and decoded in place, and incomplete packets
+        //! are kept for the next read.
+        //! @param[in] now current time.
+        void
+        parsePackets(double now)
+        {
+          unsigned i = 0;
+
+          while (i < m_buf_len)
+          {
+            if (m_buf[i] != MAVLINK_STX)
+            {
+              ++i;
+              continue;
+            }
+
+            if (m_buf_len - i < MAVLINK_NUM_NON_PAYLOAD_BYTES)
+              break;
+
+            uint8_t len = m_buf[i + 1];
+            unsigned size = len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+            if (m_buf_len - i < size)
+              break;
+
+            const uint8_t* pkt = m_buf + i;
+            uint16_t crc = crc_calculate(pkt + 1, MAVLINK_CORE_HEADER_LEN + len);
+            crc_accumulate(c_crc_extra[pkt[5]], &crc);
+
+            if (pkt[6 + len] != (crc & 0xff) || pkt[7 + len] != (crc >> 8))
+            {
+              // Not a packet or a corrupted one: resynchronize on the
+              // next start byte.
+              spew("corrupted packet (%u so far)", ++m_parse_errors);
+              ++i;
+              continue;
+            }
+
+            m_msg.len = len;
+            m_msg.seq = pkt[2];
+            m_msg.sysid = pkt[3];
+            m_msg.compid = pkt[4];
+            m_msg.msgid = pkt[5];
+            std::memcpy(_MAV_PAYLOAD_NON_CONST(&m_msg), pkt + 6, len);
+
+            handleMessage(now);
+            i += size;
+          }
+
+          m_buf_len -= i;
+          std::memmove(m_buf, m_buf + i, m_buf_len);
+        }
+
+        //! Handle a decoded packet.
+        //! @param[in] now current time.
+        void
+        handleMessage(double now)
+        {
+          switch ((int)m_msg.msgid)
+          {
+            default:
+              debug("UNDEF: %u", m_msg.msgid);
+              break;
+            case MAVLINK_MSG_ID_HEARTBEAT:
+              trace("HEARTBEAT");
+              break;
+            case MAVLINK_MSG_ID_SYS_STATUS:
+              trace("SYS_STATUS");
+              break;
+            case 22:
+              trace("PARAM_VALUE");
+              break;
+            case MAVLINK_MSG_ID_GPS_RAW_INT:
+              spew("GPS_RAW");
+              break;
+            case 27:
+              trace("IMU_RAW");
+              break;
+            case MAVLINK_MSG_ID_SCALED_PRESSURE:
+              spew("SCALED_PRESSURE");
+              break;
+            case MAVLINK_MSG_ID_ATTITUDE:
+              spew("ATTITUDE");
+              break;
+            case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+              spew("GLOBAL_POSITION_INT");
+              break;
+            case 34:
+              trace("RC_CHANNELS_SCALED");
+              break;
+            case 35:
+              trace("RC_CHANNELS_RAW");
+              break;
+            case MAVLINK_MSG_ID_MISSION_ITEM:
+              trace("MISSION_ITEM");
+              break;
+            case MAVLINK_MSG_ID_MISSION_CURRENT:
+              trace("MISSION_CURRENT");
+              break;
+            case 44:
+              trace("MISSION_COUNT");
+              break;
+            case MAVLINK_MSG_ID_MISSION_ACK:
+              spew("MISSION_ACK");
+              break;
+            case MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT:
+              trace("NAV_CONTROLLER_OUTPUT");
+              break;
+            case MAVLINK_MSG_ID_VFR_HUD:
+              trace("VFR_HUD");
+              break;
+            case MAVLINK_MSG_ID_COMMAND_ACK:
+              spew("CMD_ACK");
+              break;
+            case MAVLINK_MSG_ID_BATTERY_STATUS:
+              spew("BATTERY_STAT");
+              break;
+            case 150:
+              trace("SENSOR_OFFSETS");
+              break;
+            case 152:
+              trace("MEMINFO");
+              break;
+            case 162:
+              trace("FENCE_STATUS");
+              break;
+            case 163:
+              trace("AHRS");
+              break;
+            case 164:
+              trace("SIM_STATE");
+              break;
+            case MAVLINK_MSG_ID_HWSTATUS:
+              spew("HW_STATUS");
+              break;
+            case MAVLINK_MSG_ID_WIND:
+              spew("WIND");
+              break;
+            case MAVLINK_MSG_ID_STATUSTEXT:
+              trace("STATUSTEXT");
+              break;
+          }
+
+
+          PktHandler h = m_mlh[m_msg.msgid];
+
+          if (!h)
+            return;  // Ignore this packet (no handler for it)
+
+          m_sysid = m_msg.sysid;
+          m_last_pkt_time = now;
+
+          // Throttle republishing of high-rate telemetry.
+          if (m_throttle[m_msg.msgid] && m_args.telemetry_period > 0)
+          {
+            if (now - m_handled[m_msg.msgid] < m_args.telemetry_period)
+              return;
+
+            m_handled[m_msg.msgid] = now;
+          }
+
+          // Call handler
+          (this->*h)(&m_msg);
+        }
+
         void
         handleAttitudePacket(const mavlink_message_t* msg)
         {
@@ -1402,6 +1576,35 @@ namespace Control
           mavlink_msg_mission_ack_decode(msg, &miss_ack);
           debug("Mission was received, result is %d", miss_ack.type);
           m_changing_wp = false;
+
+          if (!m_mission_active)
+            return;
+
+          m_mission_active = false;
+
+          if (miss_ack.type != MAV_MISSION_ACCEPTED)
+            err(DTR("mission rejected by Ardupilot (%d)"), miss_ack.type);
+        }
+
+        void
+        handleMissionRequestPacket(const mavlink_message_t* msg)
+        {
+          mavlink_mission_request_t req;
+          mavlink_msg_mission_request_decode(msg, &req);
+
+          if (!m_mission_active)
+            return;
+
+          if (req.seq < m_mission_start || req.seq >= m_mission_start + m_mission_items.size())
+          {
+            debug("request for unknown mission item %u", req.seq);
+            return;
+          }
+
+          // Answer right away from the encoded mission.
+          sendMissionItem(req.seq - m_mission_start);
+          flushMessages();
+          m_mission_timer.reset();
         }
 
         void
@@ -1413,17 +1616,14 @@ namespace Control
           m_current_wp = miss_curr.seq;
           trace("Current mission item: %d", miss_curr.seq);
 
-          uint8_t buf[512];
-
-          mavlink_message_t* msg_out = new mavlink_message_t;
+          mavlink_message_t* msg_out = &m_msg_out;
 
           mavlink_msg_mission_request_pack(255, 0, msg_out,
                                            m_sysid, //! target_system System ID
                                            0, //! target_component Component ID
                                            m_current_wp); //! Mission item to request
 
-          uint16_t n = mavlink_msg_to_send_buffer(buf, msg_out);
-          sendData(buf, n);
+          sendMessage(msg_out);
         }
 
         void
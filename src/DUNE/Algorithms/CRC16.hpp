@@ -53,6 +53,9 @@ namespace DUNE
       static inline uint16_t
       compute(const uint8_t* buffer, uint16_t len, uint16_t crc = 0)
       {
+        if (len >= c_sliced_length)
+          return computeSliced(buffer, len, crc);
+
         while (len--)
           crc = (crc >> 8) ^ c_crc16_ibm_table[(crc ^ *buffer++) & 0xff];
 
@@ -68,6 +71,19 @@ namespace DUNE
       {
         return (crc >> 8) ^ c_crc16_ibm_table[(crc ^ byte) & 0xff];
       }
+
+    private:
+      //! Minimum buffer length processed eight bytes at a time.
+      static const uint16_t c_sliced_length = 32;
+
+      //! Compute the CRC-16-IBM of a given data buffer, eight bytes
+      //! at a time (slicing-by-8).
+      //! @param buffer data buffer.
+      //! @param len data buffer length.
+      //! @param crc CRC-16-IBM value to update.
+      //! @return computed CRC-16-IBM.
+      static uint16_t
+      computeSliced(const uint8_t* buffer, uint16_t len, uint16_t crc);
     };
   }
 }
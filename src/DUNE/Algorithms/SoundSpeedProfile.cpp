@@ -0,0 +1,223 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Algorithms/SoundSpeedProfile.hpp>
+#include <DUNE/Algorithms/UNESCO1983.hpp>
+
+namespace DUNE
+{
+  namespace Algorithms
+  {
+    //! Depth difference below which a path is considered horizontal.
+    static const double c_min_depth_delta = 1e-3;
+
+    SoundSpeedProfile::SoundSpeedProfile(double resolution, double max_depth,
+                                         double speed, unsigned window):
+      m_resolution(std::max(resolution, 0.01)),
+      m_default(speed),
+      m_window(std::max(window, 1u))
+    {
+      unsigned count = (unsigned)std::ceil(std::max(max_depth, m_resolution) / m_resolution);
+      m_bins.resize(count);
+      m_speed.resize(count);
+      m_slowness.resize(count + 1);
+      clear();
+    }
+
+    void
+    SoundSpeedProfile::clear(void)
+    {
+      for (unsigned i = 0; i < m_bins.size(); ++i)
+      {
+        m_bins[i].speed = 0.0;
+        m_bins[i].count = 0;
+      }
+
+      m_samples = 0;
+      m_dirty = true;
+    }
+
+    void
+    SoundSpeedProfile::setDefault(double speed)
+    {
+      m_default = speed;
+      m_dirty = true;
+    }
+
+    void
+    SoundSpeedProfile::add(double depth, double speed)
+    {
+      if (speed <= 0.0)
+        return;
+
+      Bin& bin = m_bins[getBin(depth)];
+
+      if (bin.count < m_window)
+        ++bin.count;
+
+      bin.speed += (speed - bin.speed) / bin.count;
+      ++m_samples;
+      m_dirty = true;
+    }
+
+    double
+    SoundSpeedProfile::add(double depth, double salinity, double pressure, double temperature)
+    {
+      if (salinity < 0.0)
+        return -1.0;
+
+      double speed = UNESCO1983::computeSoundSpeed(salinity, pressure, temperature);
+      add(depth, speed);
+      return speed;
+    }
+
+    double
+    SoundSpeedProfile::getSpeed(double depth) const
+    {
+      if (m_dirty)
+        rebuild();
+
+      // Interpolate between bin centers.
+      double pos = std::max(depth, 0.0) / m_resolution - 0.5;
+      if (pos <= 0.0)
+        return m_speed.front();
+
+      unsigned i = (unsigned)pos;
+      if (i + 1 >= m_speed.size())
+        return m_speed.back();
+
+      double f = pos - i;
+      return m_speed[i] + (m_speed[i + 1] - m_speed[i]) * f;
+    }
+
+    double
+    SoundSpeedProfile::getMeanSpeed(double z0, double z1) const
+    {
+      if (std::fabs(z1 - z0) < c_min_depth_delta)
+        return getSpeed((z0 + z1) / 2.0);
+
+      double time = std::fabs(getTravelTime(z1) - getTravelTime(z0));
+      if (time <= 0.0)
+        return getSpeed((z0 + z1) / 2.0);
+
+      double top = std::min(std::max(std::min(z0, z1), 0.0), m_resolution * m_bins.size());
+      double bottom = std::min(std::max(std::max(z0, z1), 0.0), m_resolution * m_bins.size());
+
+      // Outside of the profile the path has no vertical extent.
+      if (bottom - top < c_min_depth_delta)
+        return getSpeed((z0 + z1) / 2.0);
+
+      return (bottom - top) / time;
+    }
+
+    double
+    SoundSpeedProfile::getHorizontalRange(double travel, double z0, double z1) const
+    {
+      double range = getRange(travel, z0, z1);
+      double dz = z1 - z0;
+      double h2 = range * range - dz * dz;
+
+      return (h2 > 0.0) ? std::sqrt(h2) : 0.0;
+    }
+
+    unsigned
+    SoundSpeedProfile::getBin(double depth) const
+    {
+      if (depth <= 0.0)
+        return 0;
+
+      unsigned i = (unsigned)(depth / m_resolution);
+      return std::min(i, (unsigned)m_bins.size() - 1);
+    }
+
+    double
+    SoundSpeedProfile::getTravelTime(double depth) const
+    {
+      if (m_dirty)
+        rebuild();
+
+      double max_depth = m_resolution * m_bins.size();
+      double z = std::min(std::max(depth, 0.0), max_depth);
+      unsigned i = getBin(z);
+
+      return m_slowness[i] + (z - i * m_resolution) / m_speed[i];
+    }
+
+    void
+    SoundSpeedProfile::rebuild(void) const
+    {
+      unsigned size = m_bins.size();
+      int last = -1;
+
+      for (unsigned i = 0; i < size; ++i)
+      {
+        if (!m_bins[i].count)
+          continue;
+
+        m_speed[i] = m_bins[i].speed;
+
+        if (last < 0)
+        {
+          // Extend first sample to the surface.
+          for (unsigned j = 0; j < i; ++j)
+            m_speed[j] = m_speed[i];
+        }
+        else
+        {
+          // Interpolate empty bins.
+          double step = (m_speed[i] - m_speed[last]) / (i - last);
+          for (unsigned j = last + 1; j < i; ++j)
+            m_speed[j] = m_speed[last] + step * (j - last);
+        }
+
+        last = i;
+      }
+
+      if (last < 0)
+      {
+        std::fill(m_speed.begin(), m_speed.end(), m_default);
+      }
+      else
+      {
+        // Extend last sample to the bottom.
+        for (unsigned j = last + 1; j < size; ++j)
+          m_speed[j] = m_speed[last];
+      }
+
+      m_slowness[0] = 0.0;
+      for (unsigned i = 0; i < size; ++i)
+        m_slowness[i + 1] = m_slowness[i] + m_resolution / m_speed[i];
+
+      m_dirty = false;
+    }
+  }
+}
@@ -0,0 +1,189 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_ALGORITHMS_SOUND_SPEED_PROFILE_HPP_INCLUDED_
+#define DUNE_ALGORITHMS_SOUND_SPEED_PROFILE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Algorithms
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM SoundSpeedProfile;
+
+    //! Depth-binned profile of the speed of sound in water, built
+    //! incrementally from sound speed or CTD samples.
+    //!
+    //! Each bin keeps a running mean of the samples taken at its
+    //! depth; the running mean saturates after a given number of
+    //! samples so the profile follows slow changes of the water
+    //! column. Empty bins are interpolated from their neighbours.
+    //! The integral of slowness (inverse of speed) over depth is
+    //! cached and only rebuilt after new samples, so the mean speed
+    //! along an acoustic path between two depths costs a couple of
+    //! table lookups.
+    class SoundSpeedProfile
+    {
+    public:
+      //! Constructor.
+      //! @param[in] resolution depth of each bin (m).
+      //! @param[in] max_depth maximum depth of the profile (m).
+      //! @param[in] speed sound speed to use without samples (m/s).
+      //! @param[in] window maximum number of samples averaged per bin.
+      SoundSpeedProfile(double resolution = 1.0, double max_depth = 500.0,
+                        double speed = 1500.0, unsigned window = 32);
+
+      //! Remove all samples.
+      void
+      clear(void);
+
+      //! Set sound speed to use without samples.
+      //! @param[in] speed sound speed (m/s).
+      void
+      setDefault(double speed);
+
+      //! Add a sound speed sample.
+      //! @param[in] depth depth (m).
+      //! @param[in] speed sound speed (m/s).
+      void
+      add(double depth, double speed);
+
+      //! Add a CTD sample. The sound speed is computed with
+      //! UNESCO1983::computeSoundSpeed().
+      //! @param[in] depth depth (m).
+      //! @param[in] salinity salinity (PSU).
+      //! @param[in] pressure pressure (bar).
+      //! @param[in] temperature temperature (ºC).
+      //! @return sound speed (m/s) or a negative number if the
+      //! sample was discarded.
+      double
+      add(double depth, double salinity, double pressure, double temperature);
+
+      //! Check if the profile has samples.
+      //! @return true if there are samples, false otherwise.
+      bool
+      isEmpty(void) const
+      {
+        return m_samples == 0;
+      }
+
+      //! Get number of samples in the profile.
+      //! @return number of samples.
+      unsigned
+      getSamples(void) const
+      {
+        return m_samples;
+      }
+
+      //! Get sound speed at a given depth.
+      //! @param[in] depth depth (m).
+      //! @return sound speed (m/s).
+      double
+      getSpeed(double depth) const;
+
+      //! Get mean sound speed of an acoustic path between two
+      //! depths, i.e., the distance divided by the travel time.
+      //! @param[in] z0 depth of one end (m).
+      //! @param[in] z1 depth of the other end (m).
+      //! @return mean sound speed (m/s).
+      double
+      getMeanSpeed(double z0, double z1) const;
+
+      //! Convert a one-way travel time between two depths to a
+      //! slant range.
+      //! @param[in] travel one-way travel time (s).
+      //! @param[in] z0 depth of one end (m).
+      //! @param[in] z1 depth of the other end (m).
+      //! @return slant range (m).
+      double
+      getRange(double travel, double z0, double z1) const
+      {
+        return travel * getMeanSpeed(z0, z1);
+      }
+
+      //! Convert a one-way travel time between two depths to a
+      //! horizontal distance.
+      //! @param[in] travel one-way travel time (s).
+      //! @param[in] z0 depth of one end (m).
+      //! @param[in] z1 depth of the other end (m).
+      //! @return horizontal distance (m).
+      double
+      getHorizontalRange(double travel, double z0, double z1) const;
+
+    private:
+      //! Profile bin.
+      struct Bin
+      {
+        //! Mean sound speed of the samples.
+        double speed;
+        //! Number of samples.
+        unsigned count;
+      };
+
+      //! Depth of each bin.
+      double m_resolution;
+      //! Sound speed without samples.
+      double m_default;
+      //! Maximum number of samples averaged per bin.
+      unsigned m_window;
+      //! Total number of samples.
+      unsigned m_samples;
+      //! Bins.
+      std::vector<Bin> m_bins;
+      //! Sound speed per bin, with empty bins interpolated.
+      mutable std::vector<double> m_speed;
+      //! Integral of slowness from the surface to the top of each bin.
+      mutable std::vector<double> m_slowness;
+      //! True if the cached tables must be rebuilt.
+      mutable bool m_dirty;
+
+      //! Get index of the bin of a given depth.
+      //! @param[in] depth depth (m).
+      //! @return bin index.
+      unsigned
+      getBin(double depth) const;
+
+      //! Get integral of slowness from the surface to a given depth.
+      //! @param[in] depth depth (m).
+      //! @return travel time (s).
+      double
+      getTravelTime(double depth) const;
+
+      //! Rebuild cached tables.
+      void
+      rebuild(void) const;
+    };
+  }
+}
+
+#endif
@@ -28,6 +28,9 @@
 #ifndef DUNE_ALGORITHMS_XOR_CHECKSUM_HPP_INCLUDED_
 #define DUNE_ALGORITHMS_XOR_CHECKSUM_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <cstring>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -47,6 +50,23 @@ namespace DUNE
       inline static uint8_t
       compute(const uint8_t* buffer, uint16_t length, uint8_t sum = 0)
       {
+        // XOR eight bytes at a time and fold the result.
+        if (length >= 16)
+        {
+          uint64_t word = 0;
+          for (; length >= 8; length -= 8, buffer += 8)
+          {
+            uint64_t value;
+            std::memcpy(&value, buffer, sizeof(value));
+            word ^= value;
+          }
+
+          word ^= word >> 32;
+          word ^= word >> 16;
+          word ^= word >> 8;
+          sum ^= (uint8_t)word;
+        }
+
         while (length--)
           sum ^= *buffer++;
 
@@ -43,8 +43,18 @@ namespace DUNE
 #include <DUNE/Compression/GzipCompressor.hpp>
 #include <DUNE/Compression/Bzip2Compressor.hpp>
 #include <DUNE/Compression/ZlibCompressor.hpp>
+#include <DUNE/Compression/Lz4Compressor.hpp>
+#include <DUNE/Compression/Lz4FrameCompressor.hpp>
+#include <DUNE/Compression/ZstdCompressor.hpp>
+#include <DUNE/Compression/DeflateCompressor.hpp>
 #include <DUNE/Compression/Bzip2Decompressor.hpp>
 #include <DUNE/Compression/ZlibDecompressor.hpp>
+#include <DUNE/Compression/Lz4Decompressor.hpp>
+#include <DUNE/Compression/Lz4FrameDecompressor.hpp>
+#include <DUNE/Compression/ZstdDecompressor.hpp>
+#include <DUNE/Compression/DeflateDecompressor.hpp>
+#include <DUNE/Compression/DictionaryTrainer.hpp>
+#include <DUNE/Compression/TimeSeriesChunk.hpp>
 #include <DUNE/Compression/StreamBuffer.hpp>
 #include <DUNE/Compression/FilterInput.hpp>
 #include <DUNE/Compression/FilterOutput.hpp>
@@ -93,6 +93,16 @@ namespace DUNE
         return m_unprocessed;
       }
 
+      //! Check if decompressed data did not fit the last output
+      //! buffer. That data is returned by the next call to
+      //! decompress(), even without input.
+      //! @return true if there is decompressed data to return.
+      virtual bool
+      pending(void) const
+      {
+        return false;
+      }
+
     protected:
       virtual unsigned long
       decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len) = 0;
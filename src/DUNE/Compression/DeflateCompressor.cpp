@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Utils/String.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Compression/DeflateCompressor.hpp>
+
+// Zlib headers.
+#include <zlib/zlib.h>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    //! Size of the deflate window.
+    static const size_t c_window_size = 32768;
+
+    struct DeflateCompressor::PrivateData
+    {
+      //! Compression stream.
+      z_stream stream;
+      //! Dictionary contents, trimmed to the window size.
+      std::string dictionary;
+    };
+
+    DeflateCompressor::DeflateCompressor(int a_level, const std::string& dictionary):
+      Compressor(a_level)
+    {
+      m_private = new PrivateData;
+
+      if (dictionary.size() > c_window_size)
+        m_private->dictionary = dictionary.substr(dictionary.size() - c_window_size);
+      else
+        m_private->dictionary = dictionary;
+
+      z_stream* stream = &m_private->stream;
+      stream->zalloc = 0;
+      stream->zfree = 0;
+      stream->opaque = 0;
+
+      int lvl = (a_level < 0) ? Z_DEFAULT_COMPRESSION : a_level;
+      if (deflateInit2(stream, lvl, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        delete m_private;
+        throw Error("compressor initialization failed");
+      }
+    }
+
+    DeflateCompressor::~DeflateCompressor(void)
+    {
+      deflateEnd(&m_private->stream);
+      delete m_private;
+    }
+
+    unsigned long
+    DeflateCompressor::compressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len)
+    {
+      if (src_len == 0)
+        return 0;
+
+      z_stream* stream = &m_private->stream;
+      deflateReset(stream);
+
+      const std::string& dict = m_private->dictionary;
+      if (!dict.empty())
+        deflateSetDictionary(stream, (const Bytef*)dict.data(), (uInt)dict.size());
+
+      stream->next_in = (Bytef*)src;
+      stream->avail_in = (uInt)src_len;
+      stream->next_out = (Bytef*)dst;
+      stream->avail_out = (uInt)dst_len;
+
+      int rv = deflate(stream, Z_FINISH);
+      if (rv == Z_STREAM_END)
+        return dst_len - stream->avail_out;
+
+      if (rv == Z_OK || rv == Z_BUF_ERROR)
+        throw BufferTooShort(dst_len);
+
+      throw Error(Utils::String::str("compressor error %d", rv));
+    }
+
+    unsigned long
+    DeflateCompressor::compressBound(unsigned long length) const
+    {
+      return deflateBound(&m_private->stream, length);
+    }
+  }
+}
@@ -0,0 +1,127 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Utils/String.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Compression/DeflateDecompressor.hpp>
+
+// Zlib headers.
+#include <zlib/zlib.h>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    struct DeflateDecompressor::PrivateData
+    {
+      //! Decompression stream.
+      z_stream stream;
+      //! Dictionary contents.
+      std::string dictionary;
+    };
+
+    DeflateDecompressor::DeflateDecompressor(const std::string& dictionary):
+      Decompressor(),
+      m_pending(false)
+    {
+      m_private = new PrivateData;
+      m_private->dictionary = dictionary;
+
+      z_stream* stream = &m_private->stream;
+      stream->next_in = 0;
+      stream->avail_in = 0;
+      stream->zalloc = 0;
+      stream->zfree = 0;
+      stream->opaque = 0;
+
+      if (inflateInit2(stream, -MAX_WBITS) != Z_OK)
+      {
+        delete m_private;
+        throw Error("decompressor initialization failed");
+      }
+
+      reset();
+    }
+
+    DeflateDecompressor::~DeflateDecompressor(void)
+    {
+      inflateEnd(&m_private->stream);
+      delete m_private;
+    }
+
+    void
+    DeflateDecompressor::reset(void)
+    {
+      z_stream* stream = &m_private->stream;
+      inflateReset(stream);
+
+      const std::string& dict = m_private->dictionary;
+      if (!dict.empty())
+        inflateSetDictionary(stream, (const Bytef*)dict.data(), (uInt)dict.size());
+    }
+
+    unsigned long
+    DeflateDecompressor::decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len)
+    {
+      z_stream* stream = &m_private->stream;
+      stream->next_in = (Bytef*)src;
+      stream->avail_in = (uInt)src_len;
+      stream->next_out = (Bytef*)dst;
+      stream->avail_out = (uInt)dst_len;
+
+      m_pending = false;
+
+      // Input may hold several streams, the dictionary is reloaded
+      // at the start of each one.
+      while (true)
+      {
+        int rv = inflate(stream, Z_NO_FLUSH);
+
+        if (rv == Z_STREAM_END)
+        {
+          reset();
+          if (stream->avail_in > 0 && stream->avail_out > 0)
+            continue;
+        }
+        else if (rv == Z_OK)
+        {
+          m_pending = (stream->avail_out == 0);
+        }
+        else if (rv != Z_BUF_ERROR)
+        {
+          throw Error(Utils::String::str("decompressor error %d", rv));
+        }
+
+        break;
+      }
+
+      unprocessed_len = stream->avail_in;
+      return dst_len - stream->avail_out;
+    }
+  }
+}
@@ -0,0 +1,80 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_COMPRESSION_DEFLATE_DECOMPRESSOR_HPP_INCLUDED_
+#define DUNE_COMPRESSION_DEFLATE_DECOMPRESSOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Decompressor.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DeflateDecompressor;
+
+    //! Decompressor of the raw deflate streams produced by
+    //! DeflateCompressor. Consecutive streams are decompressed one
+    //! after the other, each one against the dictionary.
+    class DeflateDecompressor: public Decompressor
+    {
+    public:
+      //! Constructor.
+      //! @param[in] dictionary dictionary contents (empty for none).
+      DeflateDecompressor(const std::string& dictionary = std::string());
+
+      ~DeflateDecompressor(void);
+
+      bool
+      pending(void) const
+      {
+        return m_pending;
+      }
+
+    protected:
+      virtual unsigned long
+      decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len);
+
+    private:
+      // Private implementation.
+      struct PrivateData;
+      PrivateData* m_private;
+      //! True if the last output buffer was filled.
+      bool m_pending;
+
+      void
+      reset(void);
+    };
+  }
+}
+
+#endif
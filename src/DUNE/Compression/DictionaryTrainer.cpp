@@ -0,0 +1,191 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Compression/DictionaryTrainer.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    //! Length of the substrings counted by the trainer.
+    static const size_t c_dmer_size = 6;
+    //! Number of bits of the substring hash table.
+    static const unsigned c_table_bits = 20;
+
+    //! Hash a substring of length c_dmer_size (FNV-1a).
+    static inline uint32_t
+    hashDmer(const char* data)
+    {
+      uint32_t h = 2166136261u;
+      for (size_t i = 0; i < c_dmer_size; ++i)
+      {
+        h ^= (uint8_t)data[i];
+        h *= 16777619u;
+      }
+
+      return h >> (32 - c_table_bits);
+    }
+
+    DictionaryTrainer::DictionaryTrainer(size_t segment_size):
+      m_segment_size(std::max(segment_size, c_dmer_size))
+    {
+      m_offsets.push_back(0);
+    }
+
+    void
+    DictionaryTrainer::addSample(const char* data, size_t size)
+    {
+      m_corpus.append(data, size);
+      m_offsets.push_back(m_corpus.size());
+    }
+
+    std::string
+    DictionaryTrainer::train(size_t capacity) const
+    {
+      size_t samples = getSampleCount();
+      if (samples == 0 || capacity == 0)
+        return std::string();
+
+      // Hash of every substring that fits in its sample.
+      std::vector<uint32_t> hashes(m_corpus.size(), 0);
+      // Number of samples containing each substring.
+      std::vector<uint32_t> freqs(1u << c_table_bits, 0);
+      std::vector<uint32_t> last(1u << c_table_bits, 0);
+
+      for (size_t s = 0; s < samples; ++s)
+      {
+        for (size_t i = m_offsets[s]; i + c_dmer_size <= m_offsets[s + 1]; ++i)
+        {
+          uint32_t h = hashDmer(&m_corpus[i]);
+          hashes[i] = h;
+
+          if (last[h] != s + 1)
+          {
+            last[h] = (uint32_t)(s + 1);
+            ++freqs[h];
+          }
+        }
+      }
+
+      // Substrings found in a single sample are useless.
+      for (size_t i = 0; i < freqs.size(); ++i)
+      {
+        if (freqs[i] < 2)
+          freqs[i] = 0;
+      }
+
+      // Samples are split in epochs and each pass selects the best
+      // segment of every epoch; the score of a segment is the sum of
+      // the frequencies of its distinct substrings, which are cleared
+      // once the segment is selected.
+      size_t segments = (capacity + m_segment_size - 1) / m_segment_size;
+      size_t epochs = std::min(segments, samples);
+      size_t window = m_segment_size - c_dmer_size + 1;
+      std::vector<uint16_t> active(1u << c_table_bits, 0);
+      std::vector<std::string> selected;
+      size_t size = 0;
+
+      while (size < capacity)
+      {
+        bool found = false;
+
+        for (size_t e = 0; e < epochs && size < capacity; ++e)
+        {
+          uint64_t best_score = 0;
+          size_t best_begin = 0;
+          size_t best_end = 0;
+
+          for (size_t s = samples * e / epochs; s < samples * (e + 1) / epochs; ++s)
+          {
+            size_t begin = m_offsets[s];
+            size_t end = m_offsets[s + 1];
+            if (end - begin < c_dmer_size)
+              continue;
+
+            size_t count = end - begin - c_dmer_size + 1;
+            size_t width = std::min(window, count);
+            uint64_t score = 0;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+              uint32_t h = hashes[begin + i];
+              if (active[h]++ == 0)
+                score += freqs[h];
+
+              if (i >= width)
+              {
+                uint32_t o = hashes[begin + i - width];
+                if (--active[o] == 0)
+                  score -= freqs[o];
+              }
+
+              if (i + 1 >= width && score > best_score)
+              {
+                best_score = score;
+                best_begin = begin + i + 1 - width;
+                best_end = begin + i + c_dmer_size;
+              }
+            }
+
+            for (size_t i = count - width; i < count; ++i)
+              --active[hashes[begin + i]];
+          }
+
+          if (best_score == 0)
+            continue;
+
+          for (size_t i = best_begin; i + c_dmer_size <= best_end; ++i)
+            freqs[hashes[i]] = 0;
+
+          selected.push_back(m_corpus.substr(best_begin, best_end - best_begin));
+          size += best_end - best_begin;
+          found = true;
+        }
+
+        if (!found)
+          break;
+      }
+
+      // The first segments selected are the most useful, place them
+      // at the end where matches are cheaper to encode.
+      std::string dictionary;
+      dictionary.reserve(std::min(size, capacity));
+
+      for (size_t i = selected.size(); i > 0; --i)
+        dictionary.append(selected[i - 1]);
+
+      if (dictionary.size() > capacity)
+        dictionary.erase(0, dictionary.size() - capacity);
+
+      return dictionary;
+    }
+  }
+}
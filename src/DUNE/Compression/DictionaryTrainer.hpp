@@ -0,0 +1,99 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_COMPRESSION_DICTIONARY_TRAINER_HPP_INCLUDED_
+#define DUNE_COMPRESSION_DICTIONARY_TRAINER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DictionaryTrainer;
+
+    //! Trainer of compression dictionaries. Given samples of the
+    //! data to be compressed (e.g., serialized IMC packets), the
+    //! trainer selects the segments whose short substrings appear
+    //! in the largest number of samples and concatenates them, most
+    //! useful segments last. The result can be used as the
+    //! dictionary of DeflateCompressor and ZstdCompressor.
+    class DictionaryTrainer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] segment_size size of the dictionary segments.
+      DictionaryTrainer(size_t segment_size = 32);
+
+      //! Add a sample.
+      //! @param[in] data sample data.
+      //! @param[in] size sample size.
+      void
+      addSample(const char* data, size_t size);
+
+      //! Get the number of samples.
+      //! @return number of samples.
+      size_t
+      getSampleCount(void) const
+      {
+        return m_offsets.size() - 1;
+      }
+
+      //! Get the total size of the samples.
+      //! @return size in bytes.
+      size_t
+      getSampleSize(void) const
+      {
+        return m_corpus.size();
+      }
+
+      //! Train a dictionary. The dictionary is smaller than requested
+      //! if the samples have no more content shared between them.
+      //! @param[in] capacity maximum size of the dictionary.
+      //! @return dictionary contents.
+      std::string
+      train(size_t capacity) const;
+
+    private:
+      //! Size of the dictionary segments.
+      size_t m_segment_size;
+      //! Concatenated samples.
+      std::string m_corpus;
+      //! Offsets of the samples in the corpus, plus its end.
+      std::vector<size_t> m_offsets;
+    };
+  }
+}
+
+#endif
@@ -36,6 +36,12 @@
 #include <DUNE/Compression/Bzip2Compressor.hpp>
 #include <DUNE/Compression/ZlibDecompressor.hpp>
 #include <DUNE/Compression/Bzip2Decompressor.hpp>
+#include <DUNE/Compression/Lz4FrameCompressor.hpp>
+#include <DUNE/Compression/Lz4FrameDecompressor.hpp>
+#include <DUNE/Compression/ZstdCompressor.hpp>
+#include <DUNE/Compression/ZstdDecompressor.hpp>
+#include <DUNE/Compression/DeflateCompressor.hpp>
+#include <DUNE/Compression/DeflateDecompressor.hpp>
 #include <DUNE/Compression/Factory.hpp>
 
 namespace DUNE
@@ -54,6 +60,15 @@ namespace DUNE
       if (name == "bzip2")
         return METHOD_BZIP2;
 
+      if (name == "lz4")
+        return METHOD_LZ4;
+
+      if (name == "zstd")
+        return METHOD_ZSTD;
+
+      if (name == "deflate")
+        return METHOD_DEFLATE;
+
       return METHOD_UNKNOWN;
     }
 
@@ -68,6 +83,12 @@ namespace DUNE
           return "gzip";
         case METHOD_BZIP2:
           return "bzip2";
+        case METHOD_LZ4:
+          return "lz4";
+        case METHOD_ZSTD:
+          return "zstd";
+        case METHOD_DEFLATE:
+          return "deflate";
         case METHOD_UNKNOWN:
           break;
       }
@@ -86,6 +107,12 @@ namespace DUNE
           return ".gz";
         case METHOD_BZIP2:
           return ".bz2";
+        case METHOD_LZ4:
+          return ".lz4";
+        case METHOD_ZSTD:
+          return ".zst";
+        case METHOD_DEFLATE:
+          return ".deflate";
         case METHOD_UNKNOWN:
           break;
       }
@@ -103,9 +130,9 @@ namespace DUNE
     Factory::detect(const char* fname)
     {
       std::ifstream ifs(fname, std::ios::binary);
-      uint8_t bfr[2] = {0};
+      uint8_t bfr[4] = {0};
 
-      ifs.read((char*)bfr, 2);
+      ifs.read((char*)bfr, 4);
 
       if (std::memcmp("\x1f\x8b", bfr, 2) == 0)
         return METHOD_GZIP;
@@ -116,11 +143,36 @@ namespace DUNE
       if (std::memcmp("BZ", bfr, 2) == 0)
         return METHOD_BZIP2;
 
+      if (std::memcmp("\x04\x22\x4d\x18", bfr, 4) == 0)
+        return METHOD_LZ4;
+
+      if (std::memcmp("\x28\xb5\x2f\xfd", bfr, 4) == 0)
+        return METHOD_ZSTD;
+
       return METHOD_UNKNOWN;
     }
 
+    std::string
+    Factory::dictionaryPath(const std::string& fname)
+    {
+      return fname + ".dict";
+    }
+
+    std::string
+    Factory::readDictionary(const std::string& fname)
+    {
+      std::ifstream ifs(dictionaryPath(fname).c_str(), std::ios::binary);
+      std::string dictionary;
+      char bfr[4096];
+
+      while (ifs.read(bfr, sizeof(bfr)) || ifs.gcount() > 0)
+        dictionary.append(bfr, (size_t)ifs.gcount());
+
+      return dictionary;
+    }
+
     Compressor*
-    Factory::compressor(Methods method)
+    Factory::compressor(Methods method, const std::string& dictionary)
     {
       switch (method)
       {
@@ -130,6 +182,12 @@ namespace DUNE
           return new GzipCompressor;
         case METHOD_BZIP2:
           return new Bzip2Compressor;
+        case METHOD_LZ4:
+          return new Lz4FrameCompressor;
+        case METHOD_ZSTD:
+          return new ZstdCompressor(-1, dictionary);
+        case METHOD_DEFLATE:
+          return new DeflateCompressor(-1, dictionary);
         default:
           break;
       }
@@ -144,7 +202,7 @@ namespace DUNE
     }
 
     Decompressor*
-    Factory::decompressor(Methods method)
+    Factory::decompressor(Methods method, const std::string& dictionary)
     {
       switch (method)
       {
@@ -154,6 +212,12 @@ namespace DUNE
           return new ZlibDecompressor(true);
         case METHOD_BZIP2:
           return new Bzip2Decompressor;
+        case METHOD_LZ4:
+          return new Lz4FrameDecompressor;
+        case METHOD_ZSTD:
+          return new ZstdDecompressor(dictionary);
+        case METHOD_DEFLATE:
+          return new DeflateDecompressor(dictionary);
         default:
           break;
       }
@@ -64,14 +64,39 @@ namespace DUNE
       static Methods
       detect(const char* fname);
 
+      //! Get the path of the dictionary of a compressed file. Files
+      //! compressed with a dictionary are accompanied by a copy of
+      //! it, which is needed to decompress them.
+      //! @param[in] fname compressed file.
+      //! @return dictionary path.
+      static std::string
+      dictionaryPath(const std::string& fname);
+
+      //! Read the dictionary of a compressed file.
+      //! @param[in] fname compressed file.
+      //! @return dictionary contents or an empty string if the file
+      //! has no dictionary.
+      static std::string
+      readDictionary(const std::string& fname);
+
+      //! Create a compressor.
+      //! @param[in] method compression method.
+      //! @param[in] dictionary dictionary contents, ignored by
+      //! methods without dictionary support.
+      //! @return compressor or NULL if the method is unknown.
       static Compressor*
-      compressor(Methods method);
+      compressor(Methods method, const std::string& dictionary = std::string());
 
       static Compressor*
       compressor(const std::string& method);
 
+      //! Create a decompressor.
+      //! @param[in] method compression method.
+      //! @param[in] dictionary dictionary contents, ignored by
+      //! methods without dictionary support.
+      //! @return decompressor or NULL if the method is unknown.
       static Decompressor*
-      decompressor(Methods method);
+      decompressor(Methods method, const std::string& dictionary = std::string());
 
       static Decompressor*
       decompressor(const std::string& method);
@@ -31,8 +31,10 @@
 // ISO C++ 98 headers.
 #include <istream>
 #include <fstream>
+#include <string>
 
 // DUNE headers.
+#include <DUNE/Compression/Factory.hpp>
 #include <DUNE/Compression/StreamBuffer.hpp>
 #include <DUNE/Compression/Methods.hpp>
 
@@ -43,9 +45,14 @@ namespace DUNE
     class FileInput: public std::istream
     {
     public:
+      //! Constructor. The dictionary of files compressed with one
+      //! is read from Factory::dictionaryPath().
+      //! @param[in] filename file to read.
+      //! @param[in] method compression method.
       FileInput(const char* filename, Methods method):
         std::istream(0),
         m_method(method),
+        m_dictionary((method == METHOD_ZSTD || method == METHOD_DEFLATE) ? Factory::readDictionary(filename) : std::string()),
         m_stream(filename, std::ios::binary | std::ios::in),
         m_buffer(0)
       {
@@ -63,12 +70,25 @@ namespace DUNE
         if (m_buffer)
           delete m_buffer;
 
-        m_buffer = new StreamBuffer(&stream, m_method);
+        m_buffer = new StreamBuffer(&stream, m_method, m_dictionary);
         rdbuf(m_buffer);
       }
 
+      //! Restart decompression at an offset of the file, which must
+      //! be the beginning of a compressed stream.
+      //! @param[in] offset offset in the compressed file.
+      void
+      seek(std::streamoff offset)
+      {
+        m_stream.clear();
+        m_stream.seekg(offset);
+        attach(m_stream);
+        clear();
+      }
+
     protected:
       Methods m_method;
+      std::string m_dictionary;
       std::ifstream m_stream;
       StreamBuffer* m_buffer;
     };
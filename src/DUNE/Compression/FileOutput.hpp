@@ -31,6 +31,7 @@
 // ISO C++ 98 headers.
 #include <ostream>
 #include <fstream>
+#include <string>
 
 // DUNE headers.
 #include <DUNE/Compression/StreamBuffer.hpp>
@@ -43,9 +44,16 @@ namespace DUNE
     class FileOutput: public std::ostream
     {
     public:
-      FileOutput(const char* filename, Methods method):
+      //! Constructor.
+      //! @param[in] filename file to write.
+      //! @param[in] method compression method.
+      //! @param[in] dictionary compression dictionary, used by
+      //! methods that support it. Readers of the file need it too,
+      //! see Factory::dictionaryPath().
+      FileOutput(const char* filename, Methods method, const std::string& dictionary = std::string()):
         std::ostream(0),
         m_method(method),
+        m_dictionary(dictionary),
         m_stream(filename, std::ios::binary | std::ios::out),
         m_buffer(0)
       {
@@ -63,12 +71,13 @@ namespace DUNE
         if (m_buffer)
           delete m_buffer;
 
-        m_buffer = new StreamBuffer(&stream, m_method);
+        m_buffer = new StreamBuffer(&stream, m_method, m_dictionary);
         rdbuf(m_buffer);
       }
 
     protected:
       Methods m_method;
+      std::string m_dictionary;
       std::ofstream m_stream;
       StreamBuffer* m_buffer;
     };
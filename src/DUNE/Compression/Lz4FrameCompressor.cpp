@@ -0,0 +1,108 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Compression/Lz4FrameCompressor.hpp>
+#include <DUNE/Utils/ByteCopy.hpp>
+
+// LZ4 headers.
+#include <lz4/lz4.h>
+#include <lz4/xxhash.h>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    //! Frame magic number.
+    static const uint32_t c_magic = 0x184D2204;
+    //! Frame flags: version 01, independent blocks, content checksum.
+    static const uint8_t c_flags = 0x64;
+    //! Block maximum size descriptor: 256 KiB.
+    static const uint8_t c_block_desc = 0x50;
+    //! Block maximum size.
+    static const unsigned long c_block_max = 256 * 1024;
+    //! Frame header size.
+    static const unsigned long c_header_size = 7;
+    //! Flag of blocks stored uncompressed.
+    static const uint32_t c_raw_block = 0x80000000;
+
+    unsigned long
+    Lz4FrameCompressor::compressBound(unsigned long length) const
+    {
+      // Blocks that do not compress are stored as is.
+      return c_header_size + length + 4 * (length / c_block_max + 1) + 8;
+    }
+
+    unsigned long
+    Lz4FrameCompressor::compressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len)
+    {
+      if (src_len == 0)
+        return 0;
+
+      if (dst_len < compressBound(src_len))
+        throw BufferTooShort(dst_len);
+
+      uint8_t* out = (uint8_t*)dst;
+      Utils::ByteCopy::toLE(c_magic, out);
+      out[4] = c_flags;
+      out[5] = c_block_desc;
+      out[6] = (XXH32(out + 4, 2, 0) >> 8) & 0xff;
+
+      unsigned long pos = c_header_size;
+      for (unsigned long offset = 0; offset < src_len; )
+      {
+        unsigned long size = std::min(c_block_max, src_len - offset);
+        int rv = LZ4_compress_limitedOutput(src + offset, dst + pos + 4, (int)size, (int)size - 1);
+
+        if (rv > 0)
+        {
+          Utils::ByteCopy::toLE((uint32_t)rv, out + pos);
+          pos += 4 + rv;
+        }
+        else
+        {
+          Utils::ByteCopy::toLE((uint32_t)size | c_raw_block, out + pos);
+          std::memcpy(dst + pos + 4, src + offset, size);
+          pos += 4 + size;
+        }
+
+        offset += size;
+      }
+
+      // End mark and content checksum.
+      Utils::ByteCopy::toLE((uint32_t)0, out + pos);
+      Utils::ByteCopy::toLE((uint32_t)XXH32(src, (int)src_len, 0), out + pos + 4);
+
+      return pos + 8;
+    }
+  }
+}
@@ -0,0 +1,297 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Compression/Lz4FrameDecompressor.hpp>
+#include <DUNE/Utils/ByteCopy.hpp>
+
+// LZ4 headers.
+#include <lz4/lz4.h>
+#include <lz4/xxhash.h>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    //! Frame magic number.
+    static const uint32_t c_magic = 0x184D2204;
+    //! Magic number of skippable frames (low nibble is ignored).
+    static const uint32_t c_skippable_magic = 0x184D2A50;
+    //! Flag of blocks stored uncompressed.
+    static const uint32_t c_raw_block = 0x80000000;
+    //! Frame flags.
+    static const uint8_t c_flag_independent = 0x20;
+    static const uint8_t c_flag_block_checksum = 0x10;
+    static const uint8_t c_flag_content_size = 0x08;
+    static const uint8_t c_flag_content_checksum = 0x04;
+    static const uint8_t c_flag_dictionary = 0x01;
+    //! History needed by linked blocks.
+    static const size_t c_history = 64 * 1024;
+
+    struct Lz4FrameDecompressor::PrivateData
+    {
+      //! Content checksum state.
+      XXH32_stateSpace_t hash;
+    };
+
+    //! Read a little endian 32 bit integer.
+    static inline uint32_t
+    readLE(const char* data)
+    {
+      uint32_t value = 0;
+      Utils::ByteCopy::fromLE(value, (const uint8_t*)data);
+      return value;
+    }
+
+    Lz4FrameDecompressor::Lz4FrameDecompressor(void):
+      Decompressor(),
+      m_private(new PrivateData),
+      m_state(ST_MAGIC),
+      m_desc_size(0),
+      m_flags(0),
+      m_block_max(0),
+      m_block_size(0),
+      m_block_raw(false),
+      m_skip(0),
+      m_out_idx(0),
+      m_out_end(0)
+    { }
+
+    Lz4FrameDecompressor::~Lz4FrameDecompressor(void)
+    {
+      delete m_private;
+    }
+
+    const char*
+    Lz4FrameDecompressor::take(size_t size, const char*& src, const char* end)
+    {
+      // Use the input directly when the unit is complete.
+      if (m_in.empty() && (size_t)(end - src) >= size)
+      {
+        const char* data = src;
+        src += size;
+        return data;
+      }
+
+      size_t count = std::min(size - m_in.size(), (size_t)(end - src));
+      m_in.insert(m_in.end(), src, src + count);
+      src += count;
+
+      if (m_in.size() < size)
+        return NULL;
+
+      return &m_in[0];
+    }
+
+    unsigned long
+    Lz4FrameDecompressor::decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len)
+    {
+      const char* ptr = src;
+      const char* end = src + src_len;
+      unsigned long done = 0;
+
+      while (true)
+      {
+        // Return decompressed data first.
+        size_t count = std::min(m_out_end - m_out_idx, (size_t)(dst_len - done));
+        if (count > 0)
+        {
+          std::memcpy(dst + done, &m_out[m_out_idx], count);
+          m_out_idx += count;
+          done += count;
+        }
+
+        if (done == dst_len || ptr == end)
+          break;
+
+        const char* data = NULL;
+
+        switch (m_state)
+        {
+          case ST_MAGIC:
+            if ((data = take(4, ptr, end)) == NULL)
+              break;
+
+            if (readLE(data) == c_magic)
+              m_state = ST_DESCRIPTOR;
+            else if ((readLE(data) & 0xfffffff0) == c_skippable_magic)
+              m_state = ST_SKIP_SIZE;
+            else
+              throw CorruptedData();
+            break;
+
+          case ST_DESCRIPTOR:
+            if ((data = take(2, ptr, end)) == NULL)
+              break;
+
+            m_flags = data[0];
+            if ((m_flags >> 6) != 1)
+              throw Error("unsupported LZ4 frame version");
+
+            if (m_flags & c_flag_dictionary)
+              throw Error("LZ4 frames with dictionaries are not supported");
+
+            if (((data[1] >> 4) & 0x07) < 4)
+              throw CorruptedData();
+
+            m_block_max = 1 << (8 + 2 * ((data[1] >> 4) & 0x07));
+            std::memcpy(m_desc, data, 2);
+            m_desc_size = 2;
+            m_state = ST_DESCRIPTOR_END;
+            break;
+
+          case ST_DESCRIPTOR_END:
+          {
+            size_t size = ((m_flags & c_flag_content_size) ? 8 : 0) + 1;
+            if ((data = take(size, ptr, end)) == NULL)
+              break;
+
+            std::memcpy(m_desc + m_desc_size, data, size - 1);
+            m_desc_size += size - 1;
+
+            if (((XXH32(m_desc, m_desc_size, 0) >> 8) & 0xff) != (uint8_t)data[size - 1])
+              throw CorruptedData();
+
+            XXH32_resetState(&m_private->hash, 0);
+            m_out.resize(c_history + m_block_max);
+            m_out_idx = m_out_end = c_history;
+            m_state = ST_BLOCK_SIZE;
+            break;
+          }
+
+          case ST_BLOCK_SIZE:
+            if ((data = take(4, ptr, end)) == NULL)
+              break;
+
+            if (readLE(data) == 0)
+            {
+              m_state = (m_flags & c_flag_content_checksum) ? ST_CHECKSUM : ST_MAGIC;
+              break;
+            }
+
+            m_block_raw = (readLE(data) & c_raw_block) != 0;
+            m_block_size = readLE(data) & ~c_raw_block;
+            if (m_block_size > m_block_max)
+              throw CorruptedData();
+
+            m_state = ST_BLOCK_DATA;
+            break;
+
+          case ST_BLOCK_DATA:
+            if ((data = take(m_block_size + ((m_flags & c_flag_block_checksum) ? 4 : 0), ptr, end)) == NULL)
+              break;
+
+            decodeBlock(data);
+            m_state = ST_BLOCK_SIZE;
+            break;
+
+          case ST_CHECKSUM:
+            if ((data = take(4, ptr, end)) == NULL)
+              break;
+
+            if (readLE(data) != XXH32_intermediateDigest(&m_private->hash))
+              throw CorruptedData();
+
+            m_state = ST_MAGIC;
+            break;
+
+          case ST_SKIP_SIZE:
+            if ((data = take(4, ptr, end)) == NULL)
+              break;
+
+            m_skip = readLE(data);
+            m_state = (m_skip > 0) ? ST_SKIP : ST_MAGIC;
+            break;
+
+          case ST_SKIP:
+          {
+            size_t size = std::min((size_t)m_skip, (size_t)(end - ptr));
+            ptr += size;
+            m_skip -= size;
+            if (m_skip == 0)
+              m_state = ST_MAGIC;
+            break;
+          }
+        }
+
+        // A complete unit was used.
+        if (data != NULL)
+          m_in.clear();
+      }
+
+      unprocessed_len = end - ptr;
+      return done;
+    }
+
+    void
+    Lz4FrameDecompressor::decodeBlock(const char* data)
+    {
+      if (m_flags & c_flag_block_checksum)
+      {
+        if (readLE(data + m_block_size) != XXH32(data, m_block_size, 0))
+          throw CorruptedData();
+      }
+
+      bool linked = (m_flags & c_flag_independent) == 0;
+      char* out = &m_out[c_history];
+      int rv = 0;
+
+      // Linked blocks refer to the last 64 KiB of decompressed data,
+      // which must precede the output.
+      if (linked)
+        std::memmove(&m_out[0], &m_out[m_out_end - c_history], c_history);
+
+      if (m_block_raw)
+      {
+        std::memcpy(out, data, m_block_size);
+        rv = m_block_size;
+      }
+      else if (linked)
+      {
+        rv = LZ4_decompress_safe_withPrefix64k(data, out, m_block_size, m_block_max);
+      }
+      else
+      {
+        rv = LZ4_decompress_safe(data, out, m_block_size, m_block_max);
+      }
+
+      if (rv < 0)
+        throw CorruptedData();
+
+      if (m_flags & c_flag_content_checksum)
+        XXH32_update(&m_private->hash, out, rv);
+
+      m_out_idx = c_history;
+      m_out_end = c_history + rv;
+    }
+  }
+}
@@ -0,0 +1,126 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_COMPRESSION_LZ4_FRAME_DECOMPRESSOR_HPP_INCLUDED_
+#define DUNE_COMPRESSION_LZ4_FRAME_DECOMPRESSOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Decompressor.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Lz4FrameDecompressor;
+
+    //! LZ4 frame decompressor. Input may be split anywhere and may
+    //! hold several concatenated frames, including skippable frames.
+    //! Block and content checksums are verified when present and
+    //! both independent and linked blocks are supported.
+    class Lz4FrameDecompressor: public Decompressor
+    {
+    public:
+      Lz4FrameDecompressor(void);
+
+      ~Lz4FrameDecompressor(void);
+
+      virtual bool
+      pending(void) const
+      {
+        return m_out_idx < m_out_end;
+      }
+
+    protected:
+      virtual unsigned long
+      decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len);
+
+    private:
+      //! Parser states.
+      enum State
+      {
+        //! Frame magic number.
+        ST_MAGIC,
+        //! Frame flags and block maximum size.
+        ST_DESCRIPTOR,
+        //! Optional descriptor fields and header checksum.
+        ST_DESCRIPTOR_END,
+        //! Block size.
+        ST_BLOCK_SIZE,
+        //! Block data.
+        ST_BLOCK_DATA,
+        //! Content checksum.
+        ST_CHECKSUM,
+        //! Size of a skippable frame.
+        ST_SKIP_SIZE,
+        //! Contents of a skippable frame.
+        ST_SKIP
+      };
+
+      // Private implementation.
+      struct PrivateData;
+      PrivateData* m_private;
+      //! Current state.
+      State m_state;
+      //! Partial unit of input.
+      std::vector<char> m_in;
+      //! Frame descriptor.
+      uint8_t m_desc[16];
+      //! Size of the frame descriptor.
+      unsigned m_desc_size;
+      //! Frame flags.
+      uint8_t m_flags;
+      //! Maximum block size of the frame.
+      unsigned m_block_max;
+      //! Size of the current block and whether it is stored
+      //! uncompressed.
+      uint32_t m_block_size;
+      //! True if the current block is stored uncompressed.
+      bool m_block_raw;
+      //! Bytes left in a skippable frame.
+      uint32_t m_skip;
+      //! Decompressed data, preceded by 64 KiB of history.
+      std::vector<char> m_out;
+      //! Next byte of decompressed data to return.
+      size_t m_out_idx;
+      //! End of decompressed data.
+      size_t m_out_end;
+
+      const char*
+      take(size_t size, const char*& src, const char* end);
+
+      void
+      decodeBlock(const char* data);
+    };
+  }
+}
+
+#endif
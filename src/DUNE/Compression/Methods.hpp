@@ -37,7 +37,11 @@ namespace DUNE
       METHOD_ZLIB,
       METHOD_GZIP,
       METHOD_BZIP2,
-      METHOD_UNKNOWN
+      METHOD_UNKNOWN,
+      // Values are stored in log indexes, new methods are appended.
+      METHOD_LZ4,
+      METHOD_ZSTD,
+      METHOD_DEFLATE
     };
   }
 }
@@ -46,16 +46,16 @@ namespace DUNE
 {
   namespace Compression
   {
-    StreamBuffer::StreamBuffer(std::ostream* stream, Methods method):
+    StreamBuffer::StreamBuffer(std::ostream* stream, Methods method, const std::string& dictionary):
       m_method(method),
       m_ostream(stream),
       m_istream(0),
       m_dec(0)
     {
-      m_com = Factory::compressor(method);
+      m_com = Factory::compressor(method, dictionary);
     }
 
-    StreamBuffer::StreamBuffer(std::istream* stream, Methods method):
+    StreamBuffer::StreamBuffer(std::istream* stream, Methods method, const std::string& dictionary):
       m_method(method),
       m_ostream(0),
       m_istream(stream),
@@ -63,7 +63,7 @@ namespace DUNE
       m_get_bfr_idx(0),
       m_get_bfr_rem(0)
     {
-      m_dec = Factory::decompressor(method);
+      m_dec = Factory::decompressor(method, dictionary);
       m_bfr.setSize(c_get_bfr_size);
     }
 
@@ -126,7 +126,7 @@ namespace DUNE
       {
         if (m_get_bfr_rem == 0)
         {
-          if (m_istream->eof())
+          if (m_istream->eof() && !m_dec->pending())
           {
             if (chunk_idx == 0)
               return EOF;
@@ -134,9 +134,12 @@ namespace DUNE
               break;
           }
 
-          m_istream->read(m_bfr.getBufferSigned(), m_bfr.getSize());
-          m_get_bfr_idx = 0;
-          m_get_bfr_rem = m_istream->gcount();
+          if (!m_istream->eof())
+          {
+            m_istream->read(m_bfr.getBufferSigned(), m_bfr.getSize());
+            m_get_bfr_idx = 0;
+            m_get_bfr_rem = m_istream->gcount();
+          }
         }
 
         m_dec->decompress(bfr + chunk_idx, chunk_rem, m_bfr.getBufferSigned() + m_get_bfr_idx, m_get_bfr_rem);
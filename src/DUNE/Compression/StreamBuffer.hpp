@@ -32,6 +32,7 @@
 #include <streambuf>
 #include <ostream>
 #include <istream>
+#include <string>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -52,9 +53,19 @@ namespace DUNE
     class StreamBuffer: public std::streambuf
     {
     public:
-      StreamBuffer(std::ostream* stream, Methods method);
-
-      StreamBuffer(std::istream* stream, Methods method);
+      //! Create a compressing buffer.
+      //! @param[in] stream output stream.
+      //! @param[in] method compression method.
+      //! @param[in] dictionary compression dictionary (see
+      //! Factory::compressor()).
+      StreamBuffer(std::ostream* stream, Methods method, const std::string& dictionary = std::string());
+
+      //! Create a decompressing buffer.
+      //! @param[in] stream input stream.
+      //! @param[in] method compression method.
+      //! @param[in] dictionary compression dictionary (see
+      //! Factory::decompressor()).
+      StreamBuffer(std::istream* stream, Methods method, const std::string& dictionary = std::string());
 
       virtual
       ~StreamBuffer(void);
@@ -0,0 +1,329 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Compression/TimeSeriesChunk.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    //! Size of the header (sample count).
+    static const size_t c_header_size = 4;
+    //! Maximum number of leading zeros that can be encoded.
+    static const unsigned c_max_lead = 31;
+
+    //! Delta of delta classes: prefix, prefix length, value length.
+    static const struct
+    {
+      unsigned prefix;
+      unsigned prefix_bits;
+      unsigned bits;
+    } c_dod_classes[] =
+    {
+      {0x2, 2, 7},
+      {0x6, 3, 9},
+      {0xe, 4, 12}
+    };
+
+    //! Number of delta of delta classes.
+    static const unsigned c_dod_class_count = sizeof(c_dod_classes) / sizeof(c_dod_classes[0]);
+
+    static inline uint64_t
+    toBits(double value)
+    {
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    static inline double
+    fromBits(uint64_t bits)
+    {
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    static inline unsigned
+    countLeadingZeros(uint64_t x)
+    {
+      unsigned n = 0;
+      while (n < 64 && (x & (((uint64_t)1) << 63)) == 0)
+      {
+        x <<= 1;
+        ++n;
+      }
+      return n;
+    }
+
+    static inline unsigned
+    countTrailingZeros(uint64_t x)
+    {
+      unsigned n = 0;
+      while (n < 64 && (x & 1) == 0)
+      {
+        x >>= 1;
+        ++n;
+      }
+      return n;
+    }
+
+    TimeSeriesChunk::TimeSeriesChunk(void)
+    {
+      clear();
+    }
+
+    void
+    TimeSeriesChunk::clear(void)
+    {
+      m_data.assign(c_header_size, 0);
+      m_bit = 0;
+      m_count = 0;
+      m_first_time = 0;
+      m_last_time = 0;
+      m_last_delta = 0;
+      m_last_value = 0;
+      m_lead = 0;
+      m_trail = 0;
+    }
+
+    void
+    TimeSeriesChunk::shrink(void)
+    {
+      std::vector<uint8_t>(m_data).swap(m_data);
+    }
+
+    void
+    TimeSeriesChunk::write(uint64_t value, unsigned count)
+    {
+      while (count > 0)
+      {
+        if (m_bit == 0)
+          m_data.push_back(0);
+
+        unsigned free = 8 - m_bit;
+        unsigned take = count < free ? count : free;
+        uint8_t bits = (uint8_t)((value >> (count - take)) & ((1u << take) - 1));
+        m_data.back() |= (uint8_t)(bits << (free - take));
+
+        m_bit = (m_bit + take) & 7;
+        count -= take;
+      }
+    }
+
+    void
+    TimeSeriesChunk::append(int64_t time, double value)
+    {
+      uint64_t bits = toBits(value);
+
+      if (m_count == 0)
+      {
+        write((uint64_t)time, 64);
+        write(bits, 64);
+        m_first_time = time;
+      }
+      else
+      {
+        // Time stamp.
+        int64_t delta = time - m_last_time;
+        int64_t dod = delta - m_last_delta;
+        m_last_delta = delta;
+
+        if (dod == 0)
+        {
+          write(0, 1);
+        }
+        else
+        {
+          unsigned i = 0;
+          for (; i < c_dod_class_count; ++i)
+          {
+            int64_t range = ((int64_t)1) << (c_dod_classes[i].bits - 1);
+            if (dod >= 1 - range && dod <= range)
+            {
+              write(c_dod_classes[i].prefix, c_dod_classes[i].prefix_bits);
+              write((uint64_t)(dod + range - 1), c_dod_classes[i].bits);
+              break;
+            }
+          }
+
+          if (i == c_dod_class_count)
+          {
+            write(0xf, 4);
+            write((uint64_t)dod, 64);
+          }
+        }
+
+        // Value.
+        uint64_t x = bits ^ m_last_value;
+        if (x == 0)
+        {
+          write(0, 1);
+        }
+        else
+        {
+          unsigned lead = countLeadingZeros(x);
+          unsigned trail = countTrailingZeros(x);
+          if (lead > c_max_lead)
+            lead = c_max_lead;
+
+          // A window is defined once any XOR was written (a full
+          // 64-bit window is never reused, which is harmless).
+          if ((m_lead | m_trail) != 0 && lead >= m_lead && trail >= m_trail)
+          {
+            // Reuse the previous window.
+            write(0x2, 2);
+            write(x >> m_trail, 64 - m_lead - m_trail);
+          }
+          else
+          {
+            unsigned length = 64 - lead - trail;
+            write(0x3, 2);
+            write(lead, 5);
+            write(length & 63, 6);
+            write(x >> trail, length);
+            m_lead = lead;
+            m_trail = trail;
+          }
+        }
+      }
+
+      m_last_time = time;
+      m_last_value = bits;
+      ++m_count;
+
+      for (unsigned i = 0; i < c_header_size; ++i)
+        m_data[i] = (uint8_t)(m_count >> (8 * i));
+    }
+
+    TimeSeriesChunk::Reader::Reader(const uint8_t* data, size_t size):
+      m_data(data + c_header_size),
+      m_pos(0),
+      m_count(0),
+      m_index(0),
+      m_last_time(0),
+      m_last_delta(0),
+      m_last_value(0),
+      m_lead(0),
+      m_trail(0)
+    {
+      if (size < c_header_size)
+        throw CorruptedData();
+
+      for (unsigned i = 0; i < c_header_size; ++i)
+        m_count |= (unsigned)data[i] << (8 * i);
+
+      m_bits = (size - c_header_size) * 8;
+    }
+
+    uint64_t
+    TimeSeriesChunk::Reader::read(unsigned count)
+    {
+      if (m_pos + count > m_bits)
+        throw CorruptedData();
+
+      uint64_t value = 0;
+      while (count > 0)
+      {
+        unsigned bit = m_pos & 7;
+        unsigned avail = 8 - bit;
+        unsigned take = count < avail ? count : avail;
+        uint8_t bits = (uint8_t)(m_data[m_pos >> 3] >> (avail - take)) & ((1u << take) - 1);
+
+        value = (value << take) | bits;
+        m_pos += take;
+        count -= take;
+      }
+
+      return value;
+    }
+
+    bool
+    TimeSeriesChunk::Reader::next(int64_t& time, double& value)
+    {
+      if (m_index >= m_count)
+        return false;
+
+      if (m_index == 0)
+      {
+        m_last_time = (int64_t)read(64);
+        m_last_value = read(64);
+      }
+      else
+      {
+        // Time stamp.
+        int64_t dod = 0;
+        if (read(1) != 0)
+        {
+          unsigned i = 0;
+          for (; i < c_dod_class_count; ++i)
+          {
+            if (read(1) == 0)
+            {
+              int64_t range = ((int64_t)1) << (c_dod_classes[i].bits - 1);
+              dod = (int64_t)read(c_dod_classes[i].bits) - range + 1;
+              break;
+            }
+          }
+
+          if (i == c_dod_class_count)
+            dod = (int64_t)read(64);
+        }
+
+        m_last_delta += dod;
+        m_last_time += m_last_delta;
+
+        // Value.
+        if (read(1) != 0)
+        {
+          if (read(1) != 0)
+          {
+            m_lead = (unsigned)read(5);
+            unsigned length = (unsigned)read(6);
+            if (length == 0)
+              length = 64;
+            if (m_lead + length > 64)
+              throw CorruptedData();
+            m_trail = 64 - m_lead - length;
+          }
+
+          m_last_value ^= read(64 - m_lead - m_trail) << m_trail;
+        }
+      }
+
+      time = m_last_time;
+      value = fromBits(m_last_value);
+      ++m_index;
+      return true;
+    }
+  }
+}
@@ -0,0 +1,203 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_COMPRESSION_TIME_SERIES_CHUNK_HPP_INCLUDED_
+#define DUNE_COMPRESSION_TIME_SERIES_CHUNK_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM TimeSeriesChunk;
+
+    //! Compressed sequence of (time, value) samples, using the
+    //! encoding of the Gorilla time series database: time stamps
+    //! are stored as variable length deltas of deltas and values as
+    //! the meaningful bits of the XOR with the previous value.
+    //! Regularly sampled, slowly changing signals take one to a few
+    //! bytes per sample.
+    //!
+    //! The encoded data is self-contained (it starts with the number
+    //! of samples) and can be decoded with TimeSeriesChunk::Reader,
+    //! e.g., after being sent to another system.
+    class TimeSeriesChunk
+    {
+    public:
+      class Reader;
+
+      //! Constructor.
+      TimeSeriesChunk(void);
+
+      //! Append a sample.
+      //! @param[in] time time stamp, usually in milliseconds. Time
+      //! stamps should not decrease, although the encoding
+      //! accepts it.
+      //! @param[in] value sample value.
+      void
+      append(int64_t time, double value);
+
+      //! Remove all samples.
+      void
+      clear(void);
+
+      //! Get the number of samples.
+      //! @return number of samples.
+      unsigned
+      getCount(void) const
+      {
+        return m_count;
+      }
+
+      //! Get the time stamp of the first sample.
+      //! @return time stamp (undefined if empty).
+      int64_t
+      getFirstTime(void) const
+      {
+        return m_first_time;
+      }
+
+      //! Get the time stamp of the last sample.
+      //! @return time stamp (undefined if empty).
+      int64_t
+      getLastTime(void) const
+      {
+        return m_last_time;
+      }
+
+      //! Get the encoded data.
+      //! @return pointer to encoded data.
+      const uint8_t*
+      getData(void) const
+      {
+        return &m_data[0];
+      }
+
+      //! Get the size of the encoded data.
+      //! @return size in bytes.
+      size_t
+      getSize(void) const
+      {
+        return m_data.size();
+      }
+
+      //! Release memory reserved for future samples.
+      void
+      shrink(void);
+
+    private:
+      //! Encoded data.
+      std::vector<uint8_t> m_data;
+      //! Number of bits used in the last byte (0 if full).
+      unsigned m_bit;
+      //! Number of samples.
+      unsigned m_count;
+      //! Time stamp of the first sample.
+      int64_t m_first_time;
+      //! Time stamp of the last sample.
+      int64_t m_last_time;
+      //! Last time delta.
+      int64_t m_last_delta;
+      //! Bits of the last value.
+      uint64_t m_last_value;
+      //! Leading zeros of the last XOR window.
+      unsigned m_lead;
+      //! Trailing zeros of the last XOR window.
+      unsigned m_trail;
+
+      //! Append bits, most significant first.
+      //! @param[in] value bits to append (least significant bits).
+      //! @param[in] count number of bits.
+      void
+      write(uint64_t value, unsigned count);
+    };
+
+    //! Decoder of TimeSeriesChunk data.
+    class TimeSeriesChunk::Reader
+    {
+    public:
+      //! Constructor.
+      //! @param[in] data encoded data.
+      //! @param[in] size size of encoded data.
+      //! @throw CorruptedData if the data is too short to be a chunk.
+      Reader(const uint8_t* data, size_t size);
+
+      //! Get the number of samples.
+      //! @return number of samples.
+      unsigned
+      getCount(void) const
+      {
+        return m_count;
+      }
+
+      //! Decode the next sample.
+      //! @param[out] time time stamp.
+      //! @param[out] value sample value.
+      //! @return false if there are no more samples.
+      //! @throw CorruptedData if the data is truncated.
+      bool
+      next(int64_t& time, double& value);
+
+    private:
+      //! Encoded data.
+      const uint8_t* m_data;
+      //! Size of encoded data in bits.
+      size_t m_bits;
+      //! Current bit.
+      size_t m_pos;
+      //! Number of samples.
+      unsigned m_count;
+      //! Number of samples decoded.
+      unsigned m_index;
+      //! Last time stamp.
+      int64_t m_last_time;
+      //! Last time delta.
+      int64_t m_last_delta;
+      //! Bits of the last value.
+      uint64_t m_last_value;
+      //! Leading zeros of the last XOR window.
+      unsigned m_lead;
+      //! Trailing zeros of the last XOR window.
+      unsigned m_trail;
+
+      //! Read bits, most significant first.
+      //! @param[in] count number of bits.
+      //! @return bits read.
+      uint64_t
+      read(unsigned count);
+    };
+  }
+}
+
+#endif
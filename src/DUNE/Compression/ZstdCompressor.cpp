@@ -0,0 +1,137 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Compression/ZstdCompressor.hpp>
+
+#if defined(DUNE_USING_ZSTD)
+// Zstandard headers.
+#  include <zstd.h>
+#endif
+
+namespace DUNE
+{
+  namespace Compression
+  {
+#if defined(DUNE_USING_ZSTD)
+    //! Level used when none is given.
+    static const int c_default_level = 3;
+
+    struct ZstdCompressor::PrivateData
+    {
+      //! Compression context.
+      ZSTD_CCtx* ctx;
+      //! Digested dictionary.
+      ZSTD_CDict* dict;
+    };
+
+    ZstdCompressor::ZstdCompressor(int a_level, const std::string& dictionary):
+      Compressor(a_level)
+    {
+      m_private = new PrivateData;
+      m_private->ctx = ZSTD_createCCtx();
+      m_private->dict = NULL;
+
+      if (!dictionary.empty())
+        m_private->dict = ZSTD_createCDict(dictionary.data(), dictionary.size(),
+                                           level() < 0 ? c_default_level : level());
+
+      if (m_private->ctx == NULL || (!dictionary.empty() && m_private->dict == NULL))
+      {
+        ZSTD_freeCDict(m_private->dict);
+        ZSTD_freeCCtx(m_private->ctx);
+        delete m_private;
+        throw Error("compressor initialization failed");
+      }
+    }
+
+    ZstdCompressor::~ZstdCompressor(void)
+    {
+      ZSTD_freeCDict(m_private->dict);
+      ZSTD_freeCCtx(m_private->ctx);
+      delete m_private;
+    }
+
+    unsigned long
+    ZstdCompressor::compressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len)
+    {
+      if (src_len == 0)
+        return 0;
+
+      if (dst_len < compressBound(src_len))
+        throw BufferTooShort(dst_len);
+
+      size_t rv = 0;
+      if (m_private->dict != NULL)
+        rv = ZSTD_compress_usingCDict(m_private->ctx, dst, dst_len, src, src_len, m_private->dict);
+      else
+        rv = ZSTD_compressCCtx(m_private->ctx, dst, dst_len, src, src_len,
+                               level() < 0 ? c_default_level : level());
+
+      if (ZSTD_isError(rv))
+        throw Error(Utils::String::str("compressor error: %s", ZSTD_getErrorName(rv)));
+
+      return rv;
+    }
+
+    unsigned long
+    ZstdCompressor::compressBound(unsigned long length) const
+    {
+      return ZSTD_compressBound(length);
+    }
+#else
+    ZstdCompressor::ZstdCompressor(int a_level, const std::string& dictionary):
+      Compressor(a_level),
+      m_private(NULL)
+    {
+      (void)dictionary;
+      throw UnknownMethod("zstd (not supported by this build)");
+    }
+
+    ZstdCompressor::~ZstdCompressor(void)
+    { }
+
+    unsigned long
+    ZstdCompressor::compressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len)
+    {
+      (void)dst;
+      (void)dst_len;
+      (void)src;
+      (void)src_len;
+      return 0;
+    }
+
+    unsigned long
+    ZstdCompressor::compressBound(unsigned long length) const
+    {
+      return length;
+    }
+#endif
+  }
+}
@@ -0,0 +1,78 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_COMPRESSION_ZSTD_COMPRESSOR_HPP_INCLUDED_
+#define DUNE_COMPRESSION_ZSTD_COMPRESSOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Compressor.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM ZstdCompressor;
+
+    //! Zstandard compressor. Each call to compress() produces one
+    //! Zstandard frame, so the output of several calls is a valid
+    //! stream. Small blocks of similar data, such as IMC messages,
+    //! compress much better with a dictionary trained on samples of
+    //! that data (e.g., 'zstd --train'); the same dictionary is then
+    //! needed to decompress. Empty input produces no output.
+    //! Available only if DUNE_USING_ZSTD is defined.
+    class ZstdCompressor: public Compressor
+    {
+    public:
+      //! Constructor.
+      //! @param[in] a_level compression level (negative for the
+      //! default level).
+      //! @param[in] dictionary dictionary contents (empty for none).
+      ZstdCompressor(int a_level = -1, const std::string& dictionary = std::string());
+
+      ~ZstdCompressor(void);
+
+    protected:
+      virtual unsigned long
+      compressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len);
+
+      virtual unsigned long
+      compressBound(unsigned long length) const;
+
+    private:
+      // Private implementation.
+      struct PrivateData;
+      PrivateData* m_private;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,111 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Exceptions.hpp>
+#include <DUNE/Compression/ZstdDecompressor.hpp>
+
+#if defined(DUNE_USING_ZSTD)
+// Zstandard headers.
+#  include <zstd.h>
+#endif
+
+namespace DUNE
+{
+  namespace Compression
+  {
+#if defined(DUNE_USING_ZSTD)
+    struct ZstdDecompressor::PrivateData
+    {
+      //! Decompression context.
+      ZSTD_DCtx* ctx;
+    };
+
+    ZstdDecompressor::ZstdDecompressor(const std::string& dictionary):
+      Decompressor(),
+      m_pending(false)
+    {
+      m_private = new PrivateData;
+      m_private->ctx = ZSTD_createDCtx();
+
+      if (m_private->ctx == NULL
+          || (!dictionary.empty()
+              && ZSTD_isError(ZSTD_DCtx_loadDictionary(m_private->ctx, dictionary.data(), dictionary.size()))))
+      {
+        ZSTD_freeDCtx(m_private->ctx);
+        delete m_private;
+        throw Error("decompressor initialization failed");
+      }
+    }
+
+    ZstdDecompressor::~ZstdDecompressor(void)
+    {
+      ZSTD_freeDCtx(m_private->ctx);
+      delete m_private;
+    }
+
+    unsigned long
+    ZstdDecompressor::decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len)
+    {
+      ZSTD_inBuffer input = {src, src_len, 0};
+      ZSTD_outBuffer output = {dst, dst_len, 0};
+
+      size_t rv = ZSTD_decompressStream(m_private->ctx, &output, &input);
+      if (ZSTD_isError(rv))
+        throw Error(Utils::String::str("decompressor error: %s", ZSTD_getErrorName(rv)));
+
+      // A full output buffer may leave data inside the context.
+      m_pending = (output.pos == output.size && output.size > 0);
+      unprocessed_len = input.size - input.pos;
+      return output.pos;
+    }
+#else
+    ZstdDecompressor::ZstdDecompressor(const std::string& dictionary):
+      Decompressor(),
+      m_private(NULL),
+      m_pending(false)
+    {
+      (void)dictionary;
+      throw UnknownMethod("zstd (not supported by this build)");
+    }
+
+    ZstdDecompressor::~ZstdDecompressor(void)
+    { }
+
+    unsigned long
+    ZstdDecompressor::decompressBlock(char* dst, unsigned long dst_len, char* src, unsigned long src_len, unsigned long& unprocessed_len)
+    {
+      (void)dst;
+      (void)dst_len;
+      (void)src;
+      unprocessed_len = src_len;
+      return 0;
+    }
+#endif
+  }
+}
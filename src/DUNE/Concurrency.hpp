@@ -36,8 +36,12 @@ namespace DUNE
 }
 
 #include <DUNE/Concurrency/Exceptions.hpp>
+#include <DUNE/Concurrency/Atomic.hpp>
 #include <DUNE/Concurrency/AtomicInteger.hpp>
 #include <DUNE/Concurrency/AtomicCounter.hpp>
+#include <DUNE/Concurrency/AtomicFlag.hpp>
+#include <DUNE/Concurrency/AtomicPointer.hpp>
+#include <DUNE/Concurrency/Contention.hpp>
 #include <DUNE/Concurrency/Mutex.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Concurrency/RWLock.hpp>
@@ -51,6 +55,8 @@ namespace DUNE
 #include <DUNE/Concurrency/Scheduler.hpp>
 #include <DUNE/Concurrency/Constants.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/Concurrency/MPSCQueue.hpp>
+#include <DUNE/Concurrency/Snapshot.hpp>
 #include <DUNE/Concurrency/Process.hpp>
 #include <DUNE/Concurrency/SharedMemory.hpp>
 #include <DUNE/Concurrency/Semaphore.hpp>
@@ -0,0 +1,483 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_ATOMIC_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_ATOMIC_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+
+// Select the implementation of atomic operations: GCC's __atomic
+// builtins, GCC's legacy __sync builtins (always sequentially
+// consistent), Windows' interlocked functions or, as a last resort,
+// a global lock.
+#if defined(DUNE_SYS_HAS___ATOMIC_FETCH_ADD) && defined(DUNE_SYS_HAS___ATOMIC_COMPARE_EXCHANGE_N)
+#  define DUNE_CONCURRENCY_ATOMIC_GCC
+#elif defined(DUNE_SYS_HAS___SYNC_ADD_AND_FETCH) && defined(DUNE_SYS_HAS___SYNC_BOOL_COMPARE_AND_SWAP) \
+  && defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  define DUNE_CONCURRENCY_ATOMIC_SYNC
+#elif defined(DUNE_OS_WINDOWS)
+#  define DUNE_CONCURRENCY_ATOMIC_WINDOWS
+#else
+#  define DUNE_CONCURRENCY_ATOMIC_LOCKED
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Memory ordering constraints of atomic operations, with the
+    //! semantics of the C++11 memory model. Orders that do not apply
+    //! to an operation are strengthened (e.g., a release load is an
+    //! acquire load).
+    enum MemoryOrder
+    {
+      //! Atomicity only, no ordering.
+      MEMORY_ORDER_RELAXED,
+      //! Later accesses are not moved before this operation.
+      MEMORY_ORDER_ACQUIRE,
+      //! Earlier accesses are not moved after this operation.
+      MEMORY_ORDER_RELEASE,
+      //! Both acquire and release.
+      MEMORY_ORDER_ACQ_REL,
+      //! Single total order of all sequentially consistent operations.
+      MEMORY_ORDER_SEQ_CST
+    };
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Atomic;
+
+    //! Atomic operations on integers and pointers. These are the
+    //! building blocks of AtomicInteger, AtomicCounter, AtomicFlag
+    //! and AtomicPointer, which should be preferred.
+    class Atomic
+    {
+    public:
+      //! Read a value.
+      //! @param[in] ptr address of the value.
+      //! @param[in] order memory order.
+      //! @return value.
+      static int
+      load(const volatile int* ptr, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doLoad(ptr, order);
+      }
+
+      static long
+      load(const volatile long* ptr, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doLoad(ptr, order);
+      }
+
+      static void*
+      load(void* const volatile* ptr, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doLoad(ptr, order);
+      }
+
+      //! Write a value.
+      //! @param[in] ptr address of the value.
+      //! @param[in] value new value.
+      //! @param[in] order memory order.
+      static void
+      store(volatile int* ptr, int value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        doStore(ptr, value, order);
+      }
+
+      static void
+      store(volatile long* ptr, long value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        doStore(ptr, value, order);
+      }
+
+      static void
+      store(void* volatile* ptr, void* value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        doStore(ptr, value, order);
+      }
+
+      //! Replace a value.
+      //! @param[in] ptr address of the value.
+      //! @param[in] value new value.
+      //! @param[in] order memory order.
+      //! @return previous value.
+      static int
+      exchange(volatile int* ptr, int value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doExchange(ptr, value, order);
+      }
+
+      static long
+      exchange(volatile long* ptr, long value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doExchange(ptr, value, order);
+      }
+
+      static void*
+      exchange(void* volatile* ptr, void* value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doExchange(ptr, value, order);
+      }
+
+      //! Replace a value if it is equal to an expected one.
+      //! @param[in] ptr address of the value.
+      //! @param[in,out] expected expected value, replaced by the
+      //! current value if the exchange fails.
+      //! @param[in] value new value.
+      //! @param[in] order memory order.
+      //! @return true if the value was replaced, false otherwise.
+      static bool
+      compareExchange(volatile int* ptr, int& expected, int value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doCompareExchange(ptr, expected, value, order);
+      }
+
+      static bool
+      compareExchange(volatile long* ptr, long& expected, long value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doCompareExchange(ptr, expected, value, order);
+      }
+
+      static bool
+      compareExchange(void* volatile* ptr, void*& expected, void* value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doCompareExchange(ptr, expected, value, order);
+      }
+
+      //! Add to a value.
+      //! @param[in] ptr address of the value.
+      //! @param[in] value number to add.
+      //! @param[in] order memory order.
+      //! @return previous value.
+      static int
+      fetchAdd(volatile int* ptr, int value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doFetchAdd(ptr, value, order);
+      }
+
+      static long
+      fetchAdd(volatile long* ptr, long value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return doFetchAdd(ptr, value, order);
+      }
+
+      //! Memory fence.
+      //! @param[in] order memory order.
+      static void
+      fence(MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+#if defined(DUNE_CONCURRENCY_ATOMIC_GCC)
+        __atomic_thread_fence(toGCC(order));
+#elif defined(DUNE_CONCURRENCY_ATOMIC_SYNC)
+        if (order != MEMORY_ORDER_RELAXED)
+          __sync_synchronize();
+#elif defined(DUNE_CONCURRENCY_ATOMIC_WINDOWS)
+        if (order != MEMORY_ORDER_RELAXED)
+          MemoryBarrier();
+#else
+        if (order != MEMORY_ORDER_RELAXED)
+        {
+          ScopedMutex l(getLock());
+        }
+#endif
+      }
+
+    private:
+#if defined(DUNE_CONCURRENCY_ATOMIC_GCC)
+      static int
+      toGCC(MemoryOrder order)
+      {
+        switch (order)
+        {
+          case MEMORY_ORDER_RELAXED:
+            return __ATOMIC_RELAXED;
+          case MEMORY_ORDER_ACQUIRE:
+            return __ATOMIC_ACQUIRE;
+          case MEMORY_ORDER_RELEASE:
+            return __ATOMIC_RELEASE;
+          case MEMORY_ORDER_ACQ_REL:
+            return __ATOMIC_ACQ_REL;
+          default:
+            return __ATOMIC_SEQ_CST;
+        }
+      }
+
+      static int
+      toGCCLoad(MemoryOrder order)
+      {
+        if (order == MEMORY_ORDER_RELEASE || order == MEMORY_ORDER_ACQ_REL)
+          return __ATOMIC_ACQUIRE;
+        return toGCC(order);
+      }
+
+      static int
+      toGCCStore(MemoryOrder order)
+      {
+        if (order == MEMORY_ORDER_ACQUIRE || order == MEMORY_ORDER_ACQ_REL)
+          return __ATOMIC_RELEASE;
+        return toGCC(order);
+      }
+
+      template <typename T>
+      static T
+      doLoad(const volatile T* ptr, MemoryOrder order)
+      {
+        return __atomic_load_n(ptr, toGCCLoad(order));
+      }
+
+      template <typename T>
+      static void
+      doStore(volatile T* ptr, T value, MemoryOrder order)
+      {
+        __atomic_store_n(ptr, value, toGCCStore(order));
+      }
+
+      template <typename T>
+      static T
+      doExchange(volatile T* ptr, T value, MemoryOrder order)
+      {
+        return __atomic_exchange_n(ptr, value, toGCC(order));
+      }
+
+      template <typename T>
+      static bool
+      doCompareExchange(volatile T* ptr, T& expected, T value, MemoryOrder order)
+      {
+        return __atomic_compare_exchange_n(ptr, &expected, value, false, toGCC(order), toGCCLoad(order));
+      }
+
+      template <typename T>
+      static T
+      doFetchAdd(volatile T* ptr, T value, MemoryOrder order)
+      {
+        return __atomic_fetch_add(ptr, value, toGCC(order));
+      }
+
+#elif defined(DUNE_CONCURRENCY_ATOMIC_SYNC)
+      template <typename T>
+      static T
+      doLoad(const volatile T* ptr, MemoryOrder order)
+      {
+        (void)order;
+        __sync_synchronize();
+        T value = *ptr;
+        __sync_synchronize();
+        return value;
+      }
+
+      template <typename T>
+      static void
+      doStore(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        __sync_synchronize();
+        *ptr = value;
+        __sync_synchronize();
+      }
+
+      template <typename T>
+      static T
+      doExchange(volatile T* ptr, T value, MemoryOrder order)
+      {
+        T current = doLoad(ptr, order);
+        while (!__sync_bool_compare_and_swap(ptr, current, value))
+          current = doLoad(ptr, order);
+        return current;
+      }
+
+      template <typename T>
+      static bool
+      doCompareExchange(volatile T* ptr, T& expected, T value, MemoryOrder order)
+      {
+        T current = __sync_val_compare_and_swap(ptr, expected, value);
+        (void)order;
+
+        if (current == expected)
+          return true;
+
+        expected = current;
+        return false;
+      }
+
+      template <typename T>
+      static T
+      doFetchAdd(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        return __sync_fetch_and_add(ptr, value);
+      }
+
+#elif defined(DUNE_CONCURRENCY_ATOMIC_WINDOWS)
+      // Interlocked functions are full barriers; int and long are
+      // both 32-bit wide.
+      template <typename T>
+      static T
+      doLoad(const volatile T* ptr, MemoryOrder order)
+      {
+        (void)order;
+        return (T)InterlockedCompareExchange((volatile LONG*)ptr, 0, 0);
+      }
+
+      static void*
+      doLoad(void* const volatile* ptr, MemoryOrder order)
+      {
+        (void)order;
+        return InterlockedCompareExchangePointer((PVOID volatile*)ptr, NULL, NULL);
+      }
+
+      template <typename T>
+      static void
+      doStore(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+      }
+
+      static void
+      doStore(void* volatile* ptr, void* value, MemoryOrder order)
+      {
+        (void)order;
+        InterlockedExchangePointer((PVOID volatile*)ptr, value);
+      }
+
+      template <typename T>
+      static T
+      doExchange(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        return (T)InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+      }
+
+      static void*
+      doExchange(void* volatile* ptr, void* value, MemoryOrder order)
+      {
+        (void)order;
+        return InterlockedExchangePointer((PVOID volatile*)ptr, value);
+      }
+
+      template <typename T>
+      static bool
+      doCompareExchange(volatile T* ptr, T& expected, T value, MemoryOrder order)
+      {
+        (void)order;
+        T current = (T)InterlockedCompareExchange((volatile LONG*)ptr, (LONG)value, (LONG)expected);
+        if (current == expected)
+          return true;
+
+        expected = current;
+        return false;
+      }
+
+      static bool
+      doCompareExchange(void* volatile* ptr, void*& expected, void* value, MemoryOrder order)
+      {
+        (void)order;
+        void* current = InterlockedCompareExchangePointer((PVOID volatile*)ptr, value, expected);
+        if (current == expected)
+          return true;
+
+        expected = current;
+        return false;
+      }
+
+      template <typename T>
+      static T
+      doFetchAdd(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        return (T)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+      }
+
+#else
+      //! Get the lock shared by all atomic operations.
+      static Mutex&
+      getLock(void);
+
+      template <typename T>
+      static T
+      doLoad(const volatile T* ptr, MemoryOrder order)
+      {
+        (void)order;
+        ScopedMutex l(getLock());
+        return *ptr;
+      }
+
+      template <typename T>
+      static void
+      doStore(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        ScopedMutex l(getLock());
+        *ptr = value;
+      }
+
+      template <typename T>
+      static T
+      doExchange(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        ScopedMutex l(getLock());
+        T current = *ptr;
+        *ptr = value;
+        return current;
+      }
+
+      template <typename T>
+      static bool
+      doCompareExchange(volatile T* ptr, T& expected, T value, MemoryOrder order)
+      {
+        (void)order;
+        ScopedMutex l(getLock());
+        if (*ptr == expected)
+        {
+          *ptr = value;
+          return true;
+        }
+
+        expected = *ptr;
+        return false;
+      }
+
+      template <typename T>
+      static T
+      doFetchAdd(volatile T* ptr, T value, MemoryOrder order)
+      {
+        (void)order;
+        ScopedMutex l(getLock());
+        T current = *ptr;
+        *ptr = current + value;
+        return current;
+      }
+#endif
+    };
+  }
+}
+
+#endif
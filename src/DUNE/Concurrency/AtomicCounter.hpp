@@ -25,21 +25,13 @@
 // Author: Ricardo Martins                                                  *
 //***************************************************************************
 
+
 #ifndef DUNE_CONCURRENCY_ATOMIC_COUNTER_HPP_INCLUDED_
 #define DUNE_CONCURRENCY_ATOMIC_COUNTER_HPP_INCLUDED_
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
-#include <DUNE/Concurrency/Initializer.hpp>
-#include <DUNE/Concurrency/Mutex.hpp>
-#include <DUNE/Concurrency/ScopedMutex.hpp>
-
-// Check if we can use GCC's atomic functions.
-#if defined(DUNE_SYS_HAS___SYNC_ADD_AND_FETCH) && defined(DUNE_SYS_HAS___SYNC_SUB_AND_FETCH)
-#  ifndef DUNE_CONCURRENCY_ATOMIC_COUNTER_GCC
-#    define DUNE_CONCURRENCY_ATOMIC_COUNTER_GCC
-#  endif
-#endif
+#include <DUNE/Concurrency/Atomic.hpp>
 
 namespace DUNE
 {
@@ -49,7 +41,6 @@ namespace DUNE
     class AtomicCounter
     {
     public:
-      inline
       //! Constructor.
       //! @param value initial counter value.
       AtomicCounter(int value = 0):
@@ -59,49 +50,37 @@ namespace DUNE
       //! Atomically add a number to the current value and return the
       //! result.
       //! @param value number to add.
+      //! @param order memory order.
       //! @return value after addition.
       inline int
-      add(int value)
+      add(int value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        // GCC implementation.
-#if defined(DUNE_CONCURRENCY_ATOMIC_COUNTER_GCC)
-        return __sync_add_and_fetch(&m_value, value);
-
-        // Generic implementation.
-#else
-        ScopedMutex lock(m_lock);
-        m_value += value;
-        return m_value;
-#endif
+        return Atomic::fetchAdd(&m_value, value, order) + value;
       }
 
       //! Atomically subtract a number to the current value and return
       //! the result.
       //! @param value number to subtract.
+      //! @param order memory order.
       //! @return value after subtraction.
       inline int
-      sub(int value)
+      sub(int value, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        // GCC implementation.
-#if defined(DUNE_CONCURRENCY_ATOMIC_COUNTER_GCC)
-        return __sync_sub_and_fetch(&m_value, value);
+        return Atomic::fetchAdd(&m_value, -value, order) - value;
+      }
 
-        // Generic implementation.
-#else
-        ScopedMutex lock(m_lock);
-        m_value -= value;
-        return m_value;
-#endif
+      //! Retrieve the current value.
+      //! @param order memory order.
+      //! @return current value.
+      inline int
+      value(MemoryOrder order = MEMORY_ORDER_SEQ_CST) const
+      {
+        return Atomic::load(&m_value, order);
       }
 
     private:
       //! Internal value.
       volatile int m_value;
-
-#if !defined(DUNE_CONCURRENCY_ATOMIC_COUNTER_GCC)
-      //! Explicit lock for generic implementation.
-      Mutex m_lock;
-#endif
     };
   }
 }
@@ -0,0 +1,83 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_ATOMIC_FLAG_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_ATOMIC_FLAG_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Atomic.hpp>
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Boolean flag with atomic operations, e.g., to signal a
+    //! condition between threads or to build a spin lock.
+    class AtomicFlag
+    {
+    public:
+      //! Constructor.
+      //! @param value initial state.
+      AtomicFlag(bool value = false):
+        m_value(value ? 1 : 0)
+      { }
+
+      //! Set the flag.
+      //! @param order memory order.
+      //! @return previous state.
+      bool
+      testAndSet(MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return Atomic::exchange(&m_value, 1, order) != 0;
+      }
+
+      //! Clear the flag.
+      //! @param order memory order.
+      void
+      clear(MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        Atomic::store(&m_value, 0, order);
+      }
+
+      //! Test the flag.
+      //! @param order memory order.
+      //! @return true if the flag is set, false otherwise.
+      bool
+      test(MemoryOrder order = MEMORY_ORDER_SEQ_CST) const
+      {
+        return Atomic::load(&m_value, order) != 0;
+      }
+
+    private:
+      //! Flag state.
+      volatile int m_value;
+    };
+  }
+}
+
+#endif
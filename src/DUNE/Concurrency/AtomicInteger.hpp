@@ -25,85 +25,104 @@
 // Author: Ricardo Martins                                                  *
 //***************************************************************************
 
+
 #ifndef DUNE_CONCURRENCY_ATOMIC_INTEGER_HPP_INCLUDED_
 #define DUNE_CONCURRENCY_ATOMIC_INTEGER_HPP_INCLUDED_
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
-#include <DUNE/Concurrency/Initializer.hpp>
-#include <DUNE/Concurrency/Mutex.hpp>
-#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Concurrency/Atomic.hpp>
 
 namespace DUNE
 {
   namespace Concurrency
   {
+    //! Integer with atomic operations. Operations are lock-free where
+    //! the platform provides atomic instructions (see Atomic) and
+    //! sequentially consistent unless another memory order is
+    //! requested.
     class AtomicInteger
     {
     public:
       //! Initialize the internal value with 0.
-      AtomicInteger(void)
-      {
-        assign(0);
-      }
+      AtomicInteger(void):
+        m_value(0)
+      { }
 
       //! Initialize the internal value of the object.
       //! @param val initialization value.
-      AtomicInteger(long val)
-      {
-        assign(val);
-      }
+      AtomicInteger(long val):
+        m_value(val)
+      { }
 
-      AtomicInteger(const AtomicInteger& other)
-      {
-        assign(const_cast<AtomicInteger&>(other).value());
-      }
+      AtomicInteger(const AtomicInteger& other):
+        m_value(other.value())
+      { }
 
       AtomicInteger&
       operator=(long val)
       {
-        assign(val);
+        store(val);
         return *this;
       }
 
       AtomicInteger&
       operator=(const AtomicInteger& other)
       {
-        assign(const_cast<AtomicInteger&>(other).value());
+        store(other.value());
         return *this;
       }
 
       //! Retrieve internal value.
+      //! @param order memory order.
       //! @return internal value.
       long
-      value(void)
+      value(MemoryOrder order = MEMORY_ORDER_SEQ_CST) const
+      {
+        return Atomic::load(&m_value, order);
+      }
+
+      //! Replace the internal value.
+      //! @param val new value.
+      //! @param order memory order.
+      void
+      store(long val, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        Atomic::store(&m_value, val, order);
+      }
+
+      //! Add a number to the internal value.
+      //! @param val number to add.
+      //! @param order memory order.
+      //! @return new value of the integer.
+      long
+      add(long val, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        ScopedMutex lock(m_lock);
-        return m_value;
+        return Atomic::fetchAdd(&m_value, val, order) + val;
       }
 
       //! Increment the internal value by 1.
+      //! @param order memory order.
       //! @return new value of the integer.
       long
-      increment(void)
+      increment(MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        ScopedMutex lock(m_lock);
-        return ++m_value;
+        return add(1, order);
       }
 
       //! Decrement the internal value by 1.
+      //! @param order memory order.
       //! @return new value of the integer.
       long
-      decrement(void)
+      decrement(MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        ScopedMutex lock(m_lock);
-        return --m_value;
+        return add(-1, order);
       }
 
       //! Increment the internal value by 1 and compare with a value.
       //! @param val comparison value.
       //! @return true if the result of the incrementation and
-      //! comparison value are equal, false otherwise.
+      //! comparison value are different, false otherwise.
       bool
       incrementAndCompare(long val = 0)
       {
@@ -113,7 +132,7 @@ namespace DUNE
       //! Decrement the internal value by 1 and compare with a value.
       //! @param val comparison value.
       //! @return true if the result of the decrementation and
-      //! comparison value are equal, false otherwise.
+      //! comparison value are different, false otherwise.
       bool
       decrementAndCompare(long val = 0)
       {
@@ -122,49 +141,29 @@ namespace DUNE
 
       //! Exchange the internal value with a new one.
       //! @param val exchange value.
+      //! @param order memory order.
       //! @return internal value before the exchange.
       long
-      swap(long val)
+      swap(long val, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        ScopedMutex lock(m_lock);
-
-        long rv = m_value;
-        m_value = val;
-
-        return rv;
+        return Atomic::exchange(&m_value, val, order);
       }
 
       //! Exchange the internal value with a new one if it matches an
       //! expected value.
       //! @param expected expected value.
       //! @param val exchange value.
+      //! @param order memory order.
       //! @return true if an exchange took place, false otherwise.
       bool
-      compareAndSwap(long expected, long val)
+      compareAndSwap(long expected, long val, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
       {
-        ScopedMutex lock(m_lock);
-
-        if (m_value == expected)
-        {
-          m_value = val;
-          return true;
-        }
-
-        return false;
+        return Atomic::compareExchange(&m_value, expected, val, order);
       }
 
     private:
       //! Internal value.
-      long m_value;
-      //! Internal lock.
-      Mutex m_lock;
-
-      void
-      assign(long val)
-      {
-        ScopedMutex lock(m_lock);
-        m_value = val;
-      }
+      volatile long m_value;
     };
   }
 }
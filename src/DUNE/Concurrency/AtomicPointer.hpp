@@ -0,0 +1,107 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_ATOMIC_POINTER_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_ATOMIC_POINTER_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Atomic.hpp>
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Pointer with atomic operations. The pointed object is not
+    //! managed.
+    template <typename T>
+    class AtomicPointer
+    {
+    public:
+      //! Constructor.
+      //! @param ptr initial pointer.
+      AtomicPointer(T* ptr = NULL):
+        m_ptr(ptr)
+      { }
+
+      //! Retrieve the pointer.
+      //! @param order memory order.
+      //! @return pointer.
+      T*
+      load(MemoryOrder order = MEMORY_ORDER_SEQ_CST) const
+      {
+        return static_cast<T*>(Atomic::load(&m_ptr, order));
+      }
+
+      //! Replace the pointer.
+      //! @param ptr new pointer.
+      //! @param order memory order.
+      void
+      store(T* ptr, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        Atomic::store(&m_ptr, toVoid(ptr), order);
+      }
+
+      //! Replace the pointer and return the previous one.
+      //! @param ptr new pointer.
+      //! @param order memory order.
+      //! @return previous pointer.
+      T*
+      exchange(T* ptr, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        return static_cast<T*>(Atomic::exchange(&m_ptr, toVoid(ptr), order));
+      }
+
+      //! Replace the pointer if it matches an expected one.
+      //! @param expected expected pointer, replaced by the current
+      //! pointer if the exchange fails.
+      //! @param ptr new pointer.
+      //! @param order memory order.
+      //! @return true if an exchange took place, false otherwise.
+      bool
+      compareExchange(T*& expected, T* ptr, MemoryOrder order = MEMORY_ORDER_SEQ_CST)
+      {
+        void* aux = toVoid(expected);
+        bool rv = Atomic::compareExchange(&m_ptr, aux, toVoid(ptr), order);
+        expected = static_cast<T*>(aux);
+        return rv;
+      }
+
+    private:
+      //! Pointer.
+      void* volatile m_ptr;
+
+      static void*
+      toVoid(T* ptr)
+      {
+        return const_cast<void*>(static_cast<const volatile void*>(ptr));
+      }
+    };
+  }
+}
+
+#endif
@@ -27,6 +27,7 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <cerrno>
 
 // DUNE headers.
 #include <DUNE/Concurrency/Exceptions.hpp>
@@ -88,22 +89,50 @@ namespace DUNE
     bool
     Condition::wait(double t)
     {
+      if (t > 0)
+        return waitUntilNsec(Time::Clock::getNsec() + (uint64_t)(t * Time::c_nsec_per_sec_fp));
+
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
-      int rv = 0;
+      int rv = pthread_cond_wait(&m_cond, &m_mutex);
+      if (rv != 0)
+        throw ConditionError(rv);
 
-      if (t > 0)
+      return true;
+#endif
+      return false;
+    }
+
+    bool
+    Condition::waitUntilNsec(uint64_t deadline)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_COND)
+      int rv = ETIMEDOUT;
+      uint64_t now = Time::Clock::getNsec();
+
+      // Deadlines are measured with Time::Clock, which may run at
+      // another speed or be held: block for the equivalent system
+      // time and check again.
+      while (now < deadline)
       {
+        uint64_t abs = 0;
 #  if defined(DUNE_SYS_HAS_PTHREAD_CONDATTR_SETCLOCK) && defined(CLOCK_MONOTONIC)
-        t += Time::Clock::get();
+        if (!Time::Clock::isShifted())
+          abs = deadline;
+        else
+          abs = Time::Clock::getSystemNsec() + Time::Clock::toSystemNsec(deadline - now);
 #  else
-        t += Time::Clock::getSinceEpoch();
+        abs = Time::Clock::getSystemSinceEpochNsec() + Time::Clock::toSystemNsec(deadline - now);
 #  endif
-        timespec ts = DUNE_TIMESPEC_INIT_SEC_FP(t);
+
+        timespec ts;
+        ts.tv_sec = abs / Time::c_nsec_per_sec;
+        ts.tv_nsec = abs - (ts.tv_sec * Time::c_nsec_per_sec);
         rv = pthread_cond_timedwait(&m_cond, &m_mutex, &ts);
-      }
-      else
-      {
-        rv = pthread_cond_wait(&m_cond, &m_mutex);
+
+        if (rv != ETIMEDOUT || !Time::Clock::isShifted())
+          break;
+
+        now = Time::Clock::getNsec();
       }
 
       if (rv == ETIMEDOUT)
@@ -113,15 +142,17 @@ namespace DUNE
         throw ConditionError(rv);
 
       return true;
-#endif
+#else
+      (void)deadline;
       return false;
+#endif
     }
 
     void
     Condition::lock(void)
     {
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
-      pthread_mutex_lock(&m_mutex);
+      m_contention.lock(&m_mutex);
 #endif
     }
 
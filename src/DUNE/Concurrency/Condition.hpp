@@ -31,6 +31,7 @@
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Concurrency/Initializer.hpp>
+#include <DUNE/Concurrency/Contention.hpp>
 
 // POSIX headers.
 #if defined(DUNE_SYS_HAS_PTHREAD_H)
@@ -57,6 +58,15 @@ namespace DUNE
       bool
       wait(double t = -1);
 
+      //! Wait until the condition is signaled or the monotonic clock
+      //! (Time::Clock::getNsec()) reaches a deadline. Deadlines are
+      //! absolute, so repeated waits do not accumulate drift.
+      //! @param[in] deadline deadline in nanoseconds.
+      //! @return true if the condition was signaled, false if the
+      //! deadline was reached.
+      bool
+      waitUntilNsec(uint64_t deadline);
+
       void
       lock(void);
 
@@ -69,12 +79,24 @@ namespace DUNE
       void
       signal(void);
 
+      //! Name the condition's mutex, which includes it in lock
+      //! statistics (see Contention). Must be called before the
+      //! condition is shared.
+      //! @param[in] name condition name.
+      void
+      setName(const std::string& name)
+      {
+        m_contention.setName(name);
+      }
+
     private:
 #if defined(DUNE_SYS_HAS_PTHREAD_COND)
       pthread_cond_t m_cond;
       pthread_condattr_t m_cond_attr;
       pthread_mutex_t m_mutex;
 #endif
+      //! Acquisition strategy and statistics of the mutex.
+      Contention m_contention;
 
       // Non - copyable.
       Condition(Condition const&);
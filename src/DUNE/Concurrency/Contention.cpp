@@ -0,0 +1,231 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <set>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Atomic.hpp>
+#include <DUNE/Concurrency/Contention.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Maximum number of polls of a busy lock.
+    static const int c_max_spin = 100;
+
+    //! Statistics are enabled.
+    static volatile int s_enabled = 0;
+    //! Lock protecting the set of named locks.
+    static pthread_mutex_t s_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+    //! Named locks.
+    static std::set<Contention*>* s_registry = NULL;
+
+    //! Hint the processor that this is a busy wait loop.
+    static inline void
+    relax(void)
+    {
+#if defined(__i386__) || defined(__x86_64__)
+      __asm__ __volatile__("pause" ::: "memory");
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+      __asm__ __volatile__("yield" ::: "memory");
+#elif defined(__GNUC__)
+      __asm__ __volatile__("" ::: "memory");
+#endif
+    }
+
+    //! Get the maximum polling budget, no polling is done on
+    //! single processor systems.
+    static int
+    getMaxSpin(void)
+    {
+#if defined(DUNE_SYS_HAS_UNISTD_H) && defined(_SC_NPROCESSORS_ONLN)
+      static const int max_spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? c_max_spin : 0;
+      return max_spin;
+#else
+      return c_max_spin;
+#endif
+    }
+
+    static bool
+    compareName(const Contention::Sample& a, const Contention::Sample& b)
+    {
+      return a.name < b.name;
+    }
+
+    Contention::Contention(void):
+      m_spin(0),
+      m_acquisitions(0),
+      m_spins(0),
+      m_contentions(0),
+      m_wait(0)
+    { }
+
+    Contention::~Contention(void)
+    {
+      if (m_name.empty())
+        return;
+
+      pthread_mutex_lock(&s_registry_lock);
+      s_registry->erase(this);
+      pthread_mutex_unlock(&s_registry_lock);
+    }
+
+    void
+    Contention::setName(const std::string& name)
+    {
+      pthread_mutex_lock(&s_registry_lock);
+      m_name = name;
+
+      if (s_registry == NULL)
+        s_registry = new std::set<Contention*>;
+
+      if (m_name.empty())
+        s_registry->erase(this);
+      else
+        s_registry->insert(this);
+
+      pthread_mutex_unlock(&s_registry_lock);
+    }
+
+    int
+    Contention::lock(pthread_mutex_t* mutex)
+    {
+      bool account = !m_name.empty() && Atomic::load(&s_enabled, MEMORY_ORDER_RELAXED);
+
+      if (account)
+        Atomic::fetchAdd(&m_acquisitions, 1L, MEMORY_ORDER_RELAXED);
+
+      if (pthread_mutex_trylock(mutex) == 0)
+        return 0;
+
+      int limit = std::min(getMaxSpin(), m_spin * 2 + 10);
+      int count = 0;
+      int rv = 0;
+
+      while (true)
+      {
+        if (count++ >= limit)
+        {
+          if (!account)
+          {
+            rv = pthread_mutex_lock(mutex);
+            break;
+          }
+
+          uint64_t start = Time::Clock::getSystemNsec();
+          rv = pthread_mutex_lock(mutex);
+          long wait = (long)((Time::Clock::getSystemNsec() - start) / 1000);
+          Atomic::fetchAdd(&m_contentions, 1L, MEMORY_ORDER_RELAXED);
+          Atomic::fetchAdd(&m_wait, wait, MEMORY_ORDER_RELAXED);
+          break;
+        }
+
+        relax();
+
+        if (pthread_mutex_trylock(mutex) == 0)
+        {
+          if (account)
+            Atomic::fetchAdd(&m_spins, 1L, MEMORY_ORDER_RELAXED);
+          break;
+        }
+      }
+
+      // Only updated while holding the lock.
+      m_spin += (count - m_spin) / 8;
+      return rv;
+    }
+
+    void
+    Contention::setEnabled(bool enabled)
+    {
+      Atomic::store(&s_enabled, enabled ? 1 : 0);
+    }
+
+    bool
+    Contention::isEnabled(void)
+    {
+      return Atomic::load(&s_enabled) != 0;
+    }
+
+    void
+    Contention::collect(std::vector<Sample>& samples)
+    {
+      samples.clear();
+
+      pthread_mutex_lock(&s_registry_lock);
+
+      if (s_registry != NULL)
+      {
+        std::set<Contention*>::iterator itr = s_registry->begin();
+        for (; itr != s_registry->end(); ++itr)
+        {
+          Contention* c = *itr;
+          Sample sample;
+          sample.name = c->m_name;
+          sample.acquisitions = Atomic::load(&c->m_acquisitions, MEMORY_ORDER_RELAXED);
+          sample.spins = Atomic::load(&c->m_spins, MEMORY_ORDER_RELAXED);
+          sample.contentions = Atomic::load(&c->m_contentions, MEMORY_ORDER_RELAXED);
+          sample.wait = Atomic::load(&c->m_wait, MEMORY_ORDER_RELAXED);
+          samples.push_back(sample);
+        }
+      }
+
+      pthread_mutex_unlock(&s_registry_lock);
+
+      std::sort(samples.begin(), samples.end(), compareName);
+    }
+
+    void
+    Contention::subtract(std::vector<Sample>& samples, const std::vector<Sample>& before)
+    {
+      std::vector<Sample>::const_iterator old = before.begin();
+
+      for (unsigned i = 0; i < samples.size(); ++i)
+      {
+        while (old != before.end() && old->name < samples[i].name)
+          ++old;
+
+        if (old == before.end() || old->name != samples[i].name)
+          continue;
+
+        samples[i].acquisitions -= old->acquisitions;
+        samples[i].spins -= old->spins;
+        samples[i].contentions -= old->contentions;
+        samples[i].wait -= old->wait;
+      }
+    }
+  }
+}
@@ -0,0 +1,139 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_CONTENTION_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_CONTENTION_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_PTHREAD_H)
+#  include <pthread.h>
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Contention;
+
+    //! Acquisition strategy and contention counters of a lock. A
+    //! busy lock is first polled for a while, since critical sections
+    //! are usually short and blocking costs two context switches; the
+    //! polling budget adapts to how long the lock takes to be
+    //! released. Locks given a name are accounted while statistics
+    //! are enabled (see setEnabled() and collect()). Counters are
+    //! cumulative and wrap around, differences between two samples
+    //! remain valid.
+    class Contention
+    {
+    public:
+      //! Contention counters of a named lock.
+      struct Sample
+      {
+        //! Lock name.
+        std::string name;
+        //! Number of acquisitions.
+        unsigned long acquisitions;
+        //! Acquisitions of a busy lock that succeeded while polling.
+        unsigned long spins;
+        //! Acquisitions that had to block.
+        unsigned long contentions;
+        //! Time spent blocked (us).
+        unsigned long wait;
+      };
+
+      Contention(void);
+
+      ~Contention(void);
+
+      //! Name the lock, which includes it in the statistics.
+      //! @param[in] name lock name.
+      void
+      setName(const std::string& name);
+
+#if defined(DUNE_SYS_HAS_PTHREAD_H)
+      //! Acquire a mutex.
+      //! @param[in] mutex mutex.
+      //! @return pthread_mutex_lock() error code.
+      int
+      lock(pthread_mutex_t* mutex);
+#endif
+
+      //! Enable or disable the statistics of named locks.
+      //! @param[in] enabled true to enable, false to disable.
+      static void
+      setEnabled(bool enabled);
+
+      //! Check if statistics are enabled.
+      //! @return true if enabled, false otherwise.
+      static bool
+      isEnabled(void);
+
+      //! Retrieve the counters of named locks.
+      //! @param[out] samples counters, sorted by name.
+      static void
+      collect(std::vector<Sample>& samples);
+
+      //! Compute the counters accumulated between two collections.
+      //! @param[in,out] samples newer counters, replaced by the
+      //! differences.
+      //! @param[in] before older counters.
+      static void
+      subtract(std::vector<Sample>& samples, const std::vector<Sample>& before);
+
+    private:
+      //! Lock name.
+      std::string m_name;
+      //! Polling budget estimate.
+      int m_spin;
+      //! Number of acquisitions.
+      volatile long m_acquisitions;
+      //! Acquisitions after polling.
+      volatile long m_spins;
+      //! Acquisitions after blocking.
+      volatile long m_contentions;
+      //! Time spent blocked (us).
+      volatile long m_wait;
+
+      // Non - copyable.
+      Contention(const Contention&);
+
+      // Non - assignable.
+      Contention&
+      operator=(const Contention&);
+    };
+  }
+}
+
+#endif
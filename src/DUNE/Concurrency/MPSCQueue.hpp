@@ -0,0 +1,356 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef DUNE_CONCURRENCY_MPSC_QUEUE_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_MPSC_QUEUE_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+
+// Check if we can use GCC's atomic functions.
+#if defined(DUNE_SYS_HAS___SYNC_BOOL_COMPARE_AND_SWAP) && defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  ifndef DUNE_CONCURRENCY_MPSC_QUEUE_GCC
+#    define DUNE_CONCURRENCY_MPSC_QUEUE_GCC
+#  endif
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Bounded multiple-producer, single-consumer FIFO queue. Each
+    //! slot of the underlying ring buffer carries a sequence number
+    //! that producers claim with a compare-and-swap, so pushing and
+    //! popping never take a lock. The consumer may block waiting for
+    //! items; producers only touch the wakeup condition when the
+    //! consumer is actually sleeping.
+    //!
+    //! Only one thread may call pop(), empty() and waitForItems().
+    template <typename T>
+    class MPSCQueue
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity maximum number of items (rounded up to
+      //! the next power of two).
+      MPSCQueue(unsigned capacity = c_default_capacity):
+        m_cells(NULL),
+        m_head(0),
+        m_tail(0),
+        m_waiting(0),
+        m_signaled(0)
+      {
+        resize(capacity);
+      }
+
+      //! Destructor.
+      ~MPSCQueue(void)
+      {
+        delete [] m_cells;
+      }
+
+      //! Change the capacity of the queue. This function must not be
+      //! called while the queue is being used and discards all
+      //! queued items.
+      //! @param[in] capacity maximum number of items (rounded up to
+      //! the next power of two).
+      void
+      resize(unsigned capacity)
+      {
+        unsigned size = 2;
+        while (size < capacity)
+          size <<= 1;
+
+        delete [] m_cells;
+        m_cells = new Cell[size];
+        m_mask = size - 1;
+        m_head = 0;
+        m_tail = 0;
+
+        for (unsigned i = 0; i < size; ++i)
+          m_cells[i].sequence = i;
+      }
+
+      //! Retrieve the capacity of the queue.
+      //! @return maximum number of items.
+      unsigned
+      capacity(void) const
+      {
+        return m_mask + 1;
+      }
+
+      //! Add an item to the end of the queue, waking up the consumer
+      //! if it is waiting for items.
+      //! @param[in] v item to insert.
+      //! @return true if the item was inserted, false if the queue is
+      //! full.
+      bool
+      push(const T& v)
+      {
+#if defined(DUNE_CONCURRENCY_MPSC_QUEUE_GCC)
+        Cell* cell = NULL;
+        unsigned long pos = m_head;
+
+        while (true)
+        {
+          cell = &m_cells[pos & m_mask];
+          __sync_synchronize();
+          long diff = (long)cell->sequence - (long)pos;
+
+          if (diff == 0)
+          {
+            if (__sync_bool_compare_and_swap(&m_head, pos, pos + 1))
+              break;
+          }
+          else if (diff < 0)
+          {
+            return false;
+          }
+
+          pos = m_head;
+        }
+
+        cell->value = v;
+        __sync_synchronize();
+        cell->sequence = pos + 1;
+        __sync_synchronize();
+
+#else
+        {
+          ScopedMutex l(m_lock);
+          Cell* cell = &m_cells[m_head & m_mask];
+          if (cell->sequence != m_head)
+            return false;
+
+          cell->value = v;
+          cell->sequence = m_head + 1;
+          ++m_head;
+        }
+#endif
+
+        if (m_waiting)
+        {
+          ScopedCondition l(m_cond);
+          m_cond.signal();
+        }
+
+        return true;
+      }
+
+      //! Retrieve and remove the first item of the queue.
+      //! @param[out] v first item.
+      //! @return true if an item was retrieved, false if the queue
+      //! is empty.
+      bool
+      pop(T& v)
+      {
+#if !defined(DUNE_CONCURRENCY_MPSC_QUEUE_GCC)
+        ScopedMutex l(m_lock);
+#endif
+
+        Cell* cell = &m_cells[m_tail & m_mask];
+        if (!ready(cell))
+          return false;
+
+        v = cell->value;
+        cell->value = T();
+        barrier();
+        cell->sequence = m_tail + m_mask + 1;
+        ++m_tail;
+        return true;
+      }
+
+      //! Retrieve and remove up to a given number of items.
+      //! @param[out] items output array.
+      //! @param[in] count maximum number of items to retrieve.
+      //! @return number of retrieved items.
+      unsigned
+      pop(T* items, unsigned count)
+      {
+        unsigned i = 0;
+        while (i < count && pop(items[i]))
+          ++i;
+        return i;
+      }
+
+      //! Test if the queue has no items.
+      //! @return true if the queue is empty, false otherwise.
+      bool
+      empty(void)
+      {
+#if !defined(DUNE_CONCURRENCY_MPSC_QUEUE_GCC)
+        ScopedMutex l(m_lock);
+#endif
+        return !ready(&m_cells[m_tail & m_mask]);
+      }
+
+      //! Retrieve the approximate number of items in the queue.
+      //! @return number of items.
+      unsigned
+      size(void) const
+      {
+        return (unsigned)(m_head - m_tail);
+      }
+
+      //! Wait for items to be available or for a call to wakeup().
+      //! @param[in] timeout timeout in seconds, use a negative number
+      //! to wait forever.
+      //! @return true if at least one item is available or wakeup()
+      //! was called, false otherwise.
+      bool
+      waitForItems(double timeout = -1.0)
+      {
+        if (pending() || signaled())
+          return true;
+
+        ScopedCondition l(m_cond);
+        m_waiting = 1;
+        barrier();
+
+        // Recheck after announcing that we might sleep, a producer
+        // may have pushed an item in the meantime.
+        if (pending() || signaled())
+        {
+          m_waiting = 0;
+          return true;
+        }
+
+        m_cond.wait(timeout);
+        m_waiting = 0;
+        return signaled() || pending();
+      }
+
+      //! Wake up the consumer, without pushing an item. The current
+      //! or next call to waitForItems() returns true. Used when the
+      //! consumer has work outside of this queue.
+      void
+      wakeup(void)
+      {
+        m_signaled = 1;
+        barrier();
+        if (m_waiting)
+        {
+          ScopedCondition l(m_cond);
+          m_cond.signal();
+        }
+      }
+
+    private:
+      //! Default capacity.
+      static const unsigned c_default_capacity = 1024;
+
+      //! Ring buffer slot.
+      struct Cell
+      {
+        //! Sequence number.
+        volatile unsigned long sequence;
+        //! Item.
+        T value;
+
+        Cell(void):
+          sequence(0),
+          value()
+        { }
+      };
+
+      //! Ring buffer.
+      Cell* m_cells;
+      //! Index mask.
+      unsigned long m_mask;
+      //! Producer position.
+      volatile unsigned long m_head;
+      //! Consumer position.
+      volatile unsigned long m_tail;
+      //! True if the consumer is (about to be) sleeping.
+      volatile int m_waiting;
+      //! True if wakeup() was called since the last wait.
+      volatile int m_signaled;
+      //! Wakeup condition.
+      Condition m_cond;
+#if !defined(DUNE_CONCURRENCY_MPSC_QUEUE_GCC)
+      //! Explicit lock for generic implementation.
+      Mutex m_lock;
+#endif
+
+      //! Test if the slot at the consumer position holds an item.
+      //! @param[in] cell slot.
+      //! @return true if an item is ready, false otherwise.
+      bool
+      ready(const Cell* cell) const
+      {
+        barrier();
+        return cell->sequence == m_tail + 1;
+      }
+
+      //! Test if at least one item was claimed by a producer. The
+      //! item might still be in the process of being published.
+      //! @return true if items are pending, false otherwise.
+      bool
+      pending(void) const
+      {
+        barrier();
+        return m_head != m_tail;
+      }
+
+      //! Test and clear the wakeup flag.
+      //! @return true if wakeup() was called, false otherwise.
+      bool
+      signaled(void)
+      {
+        barrier();
+        if (!m_signaled)
+          return false;
+
+        m_signaled = 0;
+        return true;
+      }
+
+      //! Full memory barrier.
+      static void
+      barrier(void)
+      {
+#if defined(DUNE_CONCURRENCY_MPSC_QUEUE_GCC)
+        __sync_synchronize();
+#endif
+      }
+
+      //! Non - copyable.
+      MPSCQueue(const MPSCQueue&);
+
+      //! Non - assignable.
+      MPSCQueue&
+      operator=(const MPSCQueue&);
+    };
+  }
+}
+
+#endif
@@ -69,7 +69,7 @@ namespace DUNE
     Mutex::lock(void)
     {
 #if defined(DUNE_SYS_HAS_PTHREAD_MUTEX)
-      int rv = pthread_mutex_lock(&m_mutex);
+      int rv = m_contention.lock(&m_mutex);
 
       if (rv != 0)
         throw MutexError("lock", rv);
@@ -31,6 +31,7 @@
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Concurrency/Initializer.hpp>
+#include <DUNE/Concurrency/Contention.hpp>
 
 // POSIX headers.
 #if defined(DUNE_SYS_HAS_PTHREAD_H)
@@ -63,11 +64,22 @@ namespace DUNE
       void
       destroy(void);
 
+      //! Name the mutex, which includes it in lock statistics (see
+      //! Contention). Must be called before the mutex is shared.
+      //! @param[in] name mutex name.
+      void
+      setName(const std::string& name)
+      {
+        m_contention.setName(name);
+      }
+
     private:
 #if defined(DUNE_SYS_HAS_PTHREAD_MUTEX)
       pthread_mutex_t m_mutex;
       pthread_mutexattr_t m_attr;
 #endif
+      //! Acquisition strategy and statistics.
+      Contention m_contention;
 
       // Non - copyable.
       Mutex(const Mutex&);
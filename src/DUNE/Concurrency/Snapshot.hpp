@@ -0,0 +1,255 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONCURRENCY_SNAPSHOT_HPP_INCLUDED_
+#define DUNE_CONCURRENCY_SNAPSHOT_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+
+// Check if we can use GCC's atomic functions.
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  ifndef DUNE_CONCURRENCY_SNAPSHOT_GCC
+#    define DUNE_CONCURRENCY_SNAPSHOT_GCC
+#  endif
+#endif
+
+namespace DUNE
+{
+  namespace Concurrency
+  {
+    //! Versioned, immutable copies of a value published by one
+    //! thread and read by others without locking.
+    //!
+    //! The owner publishes a new copy with publish(). Each reading
+    //! thread owns a Reader and calls Reader::refresh() at points
+    //! where it holds no references into the previous copy (e.g. at
+    //! the top of its main loop); between refreshes it keeps reading
+    //! the same copy, so it never observes a partial update. A copy
+    //! is destroyed only after every registered reader has moved past
+    //! it, which makes readers that never refresh hold on to old
+    //! copies.
+    template <typename T>
+    class Snapshot
+    {
+    private:
+      //! Published copy.
+      struct Version
+      {
+        Version(const T& v, unsigned long n):
+          value(v),
+          number(n)
+        { }
+
+        //! Value.
+        const T value;
+        //! Version number.
+        const unsigned long number;
+      };
+
+    public:
+      //! Per-thread view of a snapshot.
+      class Reader
+      {
+      public:
+        //! Constructor.
+        //! @param[in] snapshot snapshot to read.
+        Reader(Snapshot& snapshot):
+          m_snapshot(snapshot)
+        {
+          ScopedMutex l(m_snapshot.m_lock);
+          m_version = m_snapshot.m_current;
+          m_seen = m_version->number;
+          m_snapshot.m_readers.push_back(this);
+        }
+
+        //! Destructor.
+        ~Reader(void)
+        {
+          ScopedMutex l(m_snapshot.m_lock);
+          m_snapshot.m_readers.erase(std::find(m_snapshot.m_readers.begin(),
+                                               m_snapshot.m_readers.end(), this));
+          m_snapshot.reclaim();
+        }
+
+        //! Pick up the most recently published copy. References to
+        //! the previous copy must not be used after calling this
+        //! function.
+        //! @return true if a newer copy was picked up, false otherwise.
+        bool
+        refresh(void)
+        {
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+          const Version* version = m_snapshot.m_current;
+          __sync_synchronize();
+#else
+          ScopedMutex l(m_snapshot.m_lock);
+          const Version* version = m_snapshot.m_current;
+#endif
+
+          if (version == m_version)
+            return false;
+
+          m_version = version;
+
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+          // Reads of the previous copy must complete before it can
+          // be reclaimed.
+          __sync_synchronize();
+#endif
+          m_seen = version->number;
+          return true;
+        }
+
+        //! Retrieve the current copy.
+        //! @return value.
+        const T&
+        get(void) const
+        {
+          return m_version->value;
+        }
+
+        const T*
+        operator->(void) const
+        {
+          return &m_version->value;
+        }
+
+        //! Retrieve the version number of the current copy.
+        //! @return version number.
+        unsigned long
+        getVersion(void) const
+        {
+          return m_version->number;
+        }
+
+      private:
+        //! Snapshot being read.
+        Snapshot& m_snapshot;
+        //! Copy in use.
+        const Version* m_version;
+        //! Version number of the oldest copy this reader may hold.
+        volatile unsigned long m_seen;
+
+        friend class Snapshot;
+
+        // Non-copyable.
+        Reader(const Reader&);
+        Reader& operator=(const Reader&);
+      };
+
+      //! Constructor.
+      //! @param[in] value initial value.
+      Snapshot(const T& value = T()):
+        m_current(new Version(value, 1))
+      { }
+
+      //! Destructor. All readers must be destroyed beforehand.
+      ~Snapshot(void)
+      {
+        for (size_t i = 0; i < m_retired.size(); ++i)
+          delete m_retired[i];
+
+        delete m_current;
+      }
+
+      //! Publish a new copy of the value.
+      //! @param[in] value new value.
+      void
+      publish(const T& value)
+      {
+        ScopedMutex l(m_lock);
+        Version* version = new Version(value, m_current->number + 1);
+
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+        // The copy must be complete before it becomes visible.
+        __sync_synchronize();
+#endif
+        Version* previous = m_current;
+        m_retired.push_back(previous);
+        m_current = version;
+
+#if defined(DUNE_CONCURRENCY_SNAPSHOT_GCC)
+        __sync_synchronize();
+#endif
+        reclaim();
+      }
+
+      //! Retrieve the version number of the most recent copy.
+      //! @return version number.
+      unsigned long
+      getVersion(void)
+      {
+        ScopedMutex l(m_lock);
+        return m_current->number;
+      }
+
+    private:
+      //! Most recent copy.
+      Version* volatile m_current;
+      //! Copies that may still be in use by readers.
+      std::vector<Version*> m_retired;
+      //! Registered readers.
+      std::vector<Reader*> m_readers;
+      //! Lock serializing publishers and reader registration.
+      Mutex m_lock;
+
+      //! Destroy retired copies that no reader can hold. Must be
+      //! called with the lock held.
+      void
+      reclaim(void)
+      {
+        unsigned long oldest = m_current->number;
+        for (size_t i = 0; i < m_readers.size(); ++i)
+          oldest = std::min(oldest, (unsigned long)m_readers[i]->m_seen);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < m_retired.size(); ++i)
+        {
+          if (m_retired[i]->number < oldest)
+            delete m_retired[i];
+          else
+            m_retired[kept++] = m_retired[i];
+        }
+
+        m_retired.resize(kept);
+      }
+
+      // Non-copyable.
+      Snapshot(const Snapshot&);
+      Snapshot& operator=(const Snapshot&);
+    };
+  }
+}
+
+#endif
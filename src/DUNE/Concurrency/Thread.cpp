@@ -27,6 +27,7 @@
 
 // ISO C++ 98 headers.
 #include <cassert>
+#include <cerrno>
 #include <iostream>
 #include <limits>
 
@@ -38,6 +39,7 @@
 #include <DUNE/Concurrency/Thread.hpp>
 #include <DUNE/Concurrency/Constants.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Time/Constants.hpp>
 
 // System headers.
 #if defined(DUNE_SYS_HAS_PTHREAD_H)
@@ -60,7 +62,15 @@
 #  include <sys/syscall.h>
 #endif
 
-#if defined(DUNE_OS_LINUX)
+#if defined(DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
+#  include <time.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_PTHREAD_SETAFFINITY_NP)
+#  include <sched.h>
+#endif
+
+#if defined(DUNE_OS_LINUX) && !defined(DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
 //! Number of useful fields in /proc/stat.
 static const unsigned c_proc_stat_values = 8;
 //! Number of fields to discard /proc/stat
@@ -81,7 +91,9 @@ dune_concurrency_thread_entry_point(void* data)
 
 #if defined(DUNE_OS_LINUX)
   td->m_id = syscall(SYS_gettid);
+#  if !defined(DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
   td->m_proc_file = DUNE::Utils::String::str("/proc/%u/task/%u/stat", getpid(), td->m_id);
+#  endif
 #endif
 
   td->m_start_barrier.wait();
@@ -107,6 +119,11 @@ namespace DUNE
       m_id = -1;
       m_last_proc_time = 0;
       m_last_global_time= 0;
+#  if defined(DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
+      m_cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+      if (m_cpu_count < 1)
+        m_cpu_count = 1;
+#  endif
 #endif
 
       int rv = pthread_attr_init(&m_attr);
@@ -194,6 +211,41 @@ namespace DUNE
 #endif
     }
 
+    void
+    Thread::setAffinity(const std::vector<unsigned>& cpus)
+    {
+#if defined(DUNE_SYS_HAS_PTHREAD_SETAFFINITY_NP)
+      cpu_set_t set;
+      CPU_ZERO(&set);
+
+      if (cpus.empty())
+      {
+        long count = sysconf(_SC_NPROCESSORS_CONF);
+        for (long i = 0; i < count && i < CPU_SETSIZE; ++i)
+          CPU_SET(i, &set);
+      }
+
+      for (unsigned i = 0; i < cpus.size(); ++i)
+      {
+        if (cpus[i] >= CPU_SETSIZE)
+          throw ThreadError("invalid processor index", EINVAL);
+        CPU_SET(cpus[i], &set);
+      }
+
+      int rv = 0;
+      if (isRunning())
+        rv = pthread_setaffinity_np(m_handle, sizeof(set), &set);
+      else
+        rv = pthread_attr_setaffinity_np(&m_attr, sizeof(set), &set);
+
+      if (rv != 0)
+        throw ThreadError("unable to set thread affinity", rv);
+#else
+      if (!cpus.empty())
+        throw ThreadError("unable to set thread affinity", ENOSYS);
+#endif
+    }
+
     Runnable::State
     Thread::getStateImpl(void)
     {
@@ -220,6 +272,31 @@ namespace DUNE
       uint64_t global_delta = 0;
       uint64_t proc_time = 0;
       uint64_t proc_delta = 0;
+
+#  if defined(DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
+      // Read the thread's CPU clock directly, global time is the
+      // elapsed monotonic time over all online processors.
+      clockid_t cid;
+      if (pthread_getcpuclockid(m_handle, &cid) != 0)
+        return -1;
+
+      timespec ts;
+      if (clock_gettime(cid, &ts) != 0)
+        return -1;
+      proc_time = (uint64_t)ts.tv_sec * Time::c_nsec_per_sec + (uint64_t)ts.tv_nsec;
+
+      if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+        return -1;
+      global_time = ((uint64_t)ts.tv_sec * Time::c_nsec_per_sec + (uint64_t)ts.tv_nsec) * m_cpu_count;
+
+      // First sample only sets the reference.
+      if (m_last_global_time == 0)
+      {
+        m_last_global_time = global_time;
+        m_last_proc_time = proc_time;
+        return -1;
+      }
+#  else
       uint64_t tmp;
 
       // Retrieve global CPU delta.
@@ -247,6 +324,7 @@ namespace DUNE
           proc_time = proc_time + tmp;
         }
       }
+#  endif
 
       // Update global delta.
       global_delta = global_time - m_last_global_time;
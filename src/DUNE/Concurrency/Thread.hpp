@@ -30,6 +30,7 @@
 
 // ISO C++ 98 headers.
 #include <string>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -72,6 +73,15 @@ namespace DUNE
       int
       getProcessorUsage(void);
 
+      //! Restrict the processors where this thread is allowed to
+      //! run. If the thread is not running the affinity is applied
+      //! when it starts.
+      //! @param[in] cpus list of processor indexes, an empty list
+      //! allows the thread to run on any processor.
+      //! @throw ThreadError if the affinity mask cannot be set.
+      void
+      setAffinity(const std::vector<unsigned>& cpus);
+
     protected:
       void
       startImpl(void);
@@ -108,8 +118,13 @@ namespace DUNE
       uint64_t m_last_proc_time;
       //! Last global CPU time.
       uint64_t m_last_global_time;
+#  if defined(DUNE_SYS_HAS_PTHREAD_GETCPUCLOCKID)
+      //! Number of online processors.
+      long m_cpu_count;
+#  else
       //! /proc file.
       std::string m_proc_file;
+#  endif
 #endif
 
       void
@@ -40,6 +40,7 @@ namespace DUNE
 #include <DUNE/Control/BasicAutopilot.hpp>
 #include <DUNE/Control/BottomTracker.hpp>
 #include <DUNE/Control/DiscretePID.hpp>
+#include <DUNE/Control/PIDBank.hpp>
 #include <DUNE/Control/YoYoMotion.hpp>
 #include <DUNE/Control/AUVModel.hpp>
 #include <DUNE/Control/LinearSystem.hpp>
@@ -33,13 +33,43 @@ namespace DUNE
 {
   namespace Control
   {
-    static const unsigned int c_ds = 1000; // Number of discretization steps
+    //! Maximum number of cached discretizations.
+    static const size_t c_max_cache = 32;
+    //! Maximum distance between cached time steps, relative to the
+    //! time step, for interpolation.
+    static const double c_interp_span = 0.05;
+
+    //! Copy a matrix to a row-major array.
+    static void
+    flatten(const Matrix& m, std::vector<double>& v)
+    {
+      v.resize(m.size());
+      for (int i = 0; i < m.rows(); ++i)
+      {
+        for (int j = 0; j < m.columns(); ++j)
+          v[i * m.columns() + j] = m.element(i, j);
+      }
+    }
+
+    //! Build a matrix from a row-major array.
+    static Matrix
+    unflatten(const std::vector<double>& v, size_t r, size_t c)
+    {
+      Matrix m(r, c, 0.0);
+      for (size_t i = 0; i < r; ++i)
+      {
+        for (size_t j = 0; j < c; ++j)
+          m(i, j) = v[i * c + j];
+      }
+      return m;
+    }
 
     // Default Constructor for a null system
     LinearSystem::LinearSystem(void):
       m_n_in(0),
       m_n_out(0),
-      m_n_st(0)
+      m_n_st(0),
+      m_Ts(0)
     { }
 
     // Constructor for continuous system
@@ -64,34 +94,45 @@ namespace DUNE
       m_n_st = a.rows();
       m_X0.resizeAndFill(m_n_st, 1, 0);
       m_Y0.resizeAndFill(m_n_out, 1, 0);
+
+      if (Ts == 0)
+      {
+        m_Ac = a;
+        m_Bc = b;
+      }
+
+      setup();
     }
 
     // Converts a continuous system to it's discrete representation
     LinearSystem&
     LinearSystem::c2d(double Ts)
     {
-      LinearSystem old = *this;
-
-      m_Ts = Ts;
-
-      // Adisc=expmatrix(A*Ts)
-      m_A = (old.m_A * Ts).expmts();
-
-      //int(expmatrix(A*tau)*B,dtau,0,Ts)
-      double dtau = m_Ts / c_ds;
-      m_B = old.m_B * dtau;
+      // Systems built in discrete form are taken as continuous.
+      if (m_Ac.isZeroSized())
+      {
+        m_Ac = m_A;
+        m_Bc = m_B;
+        m_cache.clear();
+      }
 
-      for (unsigned int i = 1; i < c_ds; i++)
-        m_B = m_B + (old.m_A * i * dtau).expmts() * old.m_B * dtau;
+      Cache::iterator itr = m_cache.find(Ts);
+      if (itr == m_cache.end())
+      {
+        Discretization disc;
+        discretize(Ts, disc);
+        if (m_cache.size() < c_max_cache)
+          itr = m_cache.insert(std::make_pair(Ts, disc)).first;
+        m_disc = disc;
+      }
+      else
+      {
+        m_disc = itr->second;
+      }
 
-      // Maintain the rest os the variables
-      m_C = old.m_C;
-      m_D = old.m_D;
-      m_X0 = old.m_X0;
-      m_Y0 = old.m_Y0;
-      m_n_in = old.m_n_in;
-      m_n_out = old.m_n_out;
-      m_n_st = old.m_n_st;
+      m_Ts = Ts;
+      m_A = unflatten(m_disc.a, m_n_st, m_n_st);
+      m_B = unflatten(m_disc.b, m_n_st, m_n_in);
 
       return *this;
     }
@@ -107,9 +148,13 @@ namespace DUNE
       Matrix D_f;
       Matrix X0;
       Matrix Y0;
+      Matrix Ac;
+      Matrix Bc;
 
       for (int i = 0; i < n; i++)
       {
+        Ac.blkDiag(a_sys.m_Ac);
+        Bc.blkDiag(a_sys.m_Bc);
         A_f.blkDiag(a_sys.getA());
         B_f.blkDiag(a_sys.getB());
         C_f.blkDiag(a_sys.getC());
@@ -128,6 +173,10 @@ namespace DUNE
       m_n_out = a_sys.getOut() * n;
       m_n_st = a_sys.getSt() * n;
       m_Ts = a_sys.getTs();
+      m_Ac = Ac;
+      m_Bc = Bc;
+      m_cache.clear();
+      setup();
 
       return (*this);
     }
@@ -141,19 +190,242 @@ namespace DUNE
       if (m_B.columns() != a_u.rows())
         throw Error("The number of rows of a_u and the number of columns of B must be the same");
 
+      for (size_t i = 0; i < m_u.size(); ++i)
+        m_u[i] = a_u(i);
+
+      const double* u = m_u.empty() ? NULL : &m_u[0];
+      bool update = true;
+
       if (threshold != 0 && a_u.rows() == 1)
       {
-        if (std::abs((double)(a_u - m_C * m_X0 + m_D * a_u)(0)) < threshold)
-          m_X0 = m_A * m_X0 + m_B * a_u;
+        if (m_n_out != 1)
+          throw Error("threshold requires a single output");
+
+        double cx = 0;
+        for (short j = 0; j < m_n_st; ++j)
+          cx += m_c[j] * m_x[j];
+
+        update = std::abs(m_u[0] - cx + m_d[0] * m_u[0]) < threshold;
       }
-      else
+
+      if (update)
+        propagate(m_disc, u);
+
+      output(u);
+      sync();
+
+      return m_Y0;
+    }
+
+    const Matrix&
+    LinearSystem::step(const Matrix& a_u, double dt)
+    {
+      if (dt <= 0)
+        throw Error("time step must be positive");
+      if ((size_t)a_u.size() != m_u.size())
+        throw Error("the size of a_u and the number of inputs must be the same");
+
+      for (size_t i = 0; i < m_u.size(); ++i)
+        m_u[i] = a_u(i);
+
+      const double* u = m_u.empty() ? NULL : &m_u[0];
+      propagate(getDiscretization(dt), u);
+      output(u);
+      sync();
+
+      return m_Y0;
+    }
+
+    void
+    LinearSystem::simulate(const Matrix& a_u, double dt, Matrix& a_y)
+    {
+      if (dt <= 0)
+        throw Error("time step must be positive");
+      if ((size_t)a_u.rows() != m_u.size())
+        throw Error("the number of rows of a_u and the number of inputs must be the same");
+
+      int steps = a_u.columns();
+      if (a_y.rows() != m_n_out || a_y.columns() != steps)
+        a_y.resize(m_n_out, steps);
+
+      const Discretization& disc = getDiscretization(dt);
+      const double* u = m_u.empty() ? NULL : &m_u[0];
+
+      for (int k = 0; k < steps; ++k)
       {
-        m_X0 = m_A * m_X0 + m_B * a_u;
+        for (size_t i = 0; i < m_u.size(); ++i)
+          m_u[i] = a_u.element(i, k);
+
+        propagate(disc, u);
+        output(u);
+
+        for (size_t i = 0; i < m_y.size(); ++i)
+          a_y(i, k) = m_y[i];
       }
 
-      m_Y0 = m_C * m_X0 + m_D * a_u;
+      sync();
+    }
 
-      return m_Y0;
+    void
+    LinearSystem::setup(void)
+    {
+      flatten(m_C, m_c);
+      flatten(m_D, m_d);
+
+      if (m_Ts != 0)
+      {
+        flatten(m_A, m_disc.a);
+        flatten(m_B, m_disc.b);
+      }
+
+      m_x.assign(m_n_st, 0.0);
+      m_next.assign(m_n_st, 0.0);
+      m_y.assign(m_n_out, 0.0);
+      m_u.assign(m_n_in, 0.0);
+
+      for (size_t i = 0; i < m_x.size() && i < (size_t)m_X0.size(); ++i)
+        m_x[i] = m_X0.element(i);
+
+      for (size_t i = 0; i < m_y.size() && i < (size_t)m_Y0.size(); ++i)
+        m_y[i] = m_Y0.element(i);
+    }
+
+    void
+    LinearSystem::discretize(double dt, Discretization& disc) const
+    {
+      // exp([A B; 0 0] * dt) = [Ad Bd; 0 I]
+      size_t n = m_n_st;
+      size_t m = m_n_in;
+      Matrix aug(n + m, n + m, 0.0);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = 0; j < n; ++j)
+          aug(i, j) = m_Ac.element(i, j) * dt;
+
+        for (size_t j = 0; j < m; ++j)
+          aug(i, n + j) = m_Bc.element(i, j) * dt;
+      }
+
+      Matrix e = aug.expmts();
+
+      disc.a.resize(n * n);
+      disc.b.resize(n * m);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = 0; j < n; ++j)
+          disc.a[i * n + j] = e.element(i, j);
+
+        for (size_t j = 0; j < m; ++j)
+          disc.b[i * m + j] = e.element(i, n + j);
+      }
+    }
+
+    const LinearSystem::Discretization&
+    LinearSystem::getDiscretization(double dt)
+    {
+      if (m_Ac.isZeroSized())
+      {
+        if (m_Ts != 0 && dt == m_Ts)
+          return m_disc;
+
+        throw Error("no continuous model to discretize");
+      }
+
+      Cache::iterator hi = m_cache.lower_bound(dt);
+      if (hi != m_cache.end() && hi->first == dt)
+        return hi->second;
+
+      bool full = m_cache.size() >= c_max_cache;
+
+      // Interpolate between close cached steps (jitter) or, with a
+      // full cache, between any two that enclose the step.
+      if (hi != m_cache.end() && hi != m_cache.begin())
+      {
+        Cache::iterator lo = hi;
+        --lo;
+
+        double span = hi->first - lo->first;
+        if (full || span <= c_interp_span * dt)
+        {
+          double w = (dt - lo->first) / span;
+          const Discretization& dlo = lo->second;
+          const Discretization& dhi = hi->second;
+
+          m_interp.a.resize(dlo.a.size());
+          m_interp.b.resize(dlo.b.size());
+
+          for (size_t i = 0; i < m_interp.a.size(); ++i)
+            m_interp.a[i] = dlo.a[i] + w * (dhi.a[i] - dlo.a[i]);
+
+          for (size_t i = 0; i < m_interp.b.size(); ++i)
+            m_interp.b[i] = dlo.b[i] + w * (dhi.b[i] - dlo.b[i]);
+
+          return m_interp;
+        }
+      }
+
+      if (full)
+      {
+        discretize(dt, m_interp);
+        return m_interp;
+      }
+
+      Discretization& disc = m_cache[dt];
+      discretize(dt, disc);
+      return disc;
+    }
+
+    void
+    LinearSystem::propagate(const Discretization& disc, const double* u)
+    {
+      size_t n = m_x.size();
+      size_t m = m_u.size();
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        double v = 0;
+        for (size_t j = 0; j < n; ++j)
+          v += disc.a[i * n + j] * m_x[j];
+        for (size_t j = 0; j < m; ++j)
+          v += disc.b[i * m + j] * u[j];
+        m_next[i] = v;
+      }
+
+      m_x.swap(m_next);
+    }
+
+    void
+    LinearSystem::output(const double* u)
+    {
+      size_t n = m_x.size();
+      size_t m = m_u.size();
+
+      for (size_t i = 0; i < m_y.size(); ++i)
+      {
+        double v = 0;
+        for (size_t j = 0; j < n; ++j)
+          v += m_c[i * n + j] * m_x[j];
+        for (size_t j = 0; j < m; ++j)
+          v += m_d[i * m + j] * u[j];
+        m_y[i] = v;
+      }
+    }
+
+    void
+    LinearSystem::sync(void)
+    {
+      if ((size_t)m_X0.size() != m_x.size())
+        m_X0.resizeAndFill(m_x.size(), 1, 0);
+      if ((size_t)m_Y0.size() != m_y.size())
+        m_Y0.resizeAndFill(m_y.size(), 1, 0);
+
+      for (size_t i = 0; i < m_x.size(); ++i)
+        m_X0(i) = m_x[i];
+
+      for (size_t i = 0; i < m_y.size(); ++i)
+        m_Y0(i) = m_y[i];
     }
 
     std::ostream&
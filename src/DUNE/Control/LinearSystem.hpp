@@ -32,6 +32,8 @@
 #include <iostream>
 #include <stdexcept>
 #include <cmath>
+#include <map>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -78,6 +80,39 @@ namespace DUNE
       Math::Matrix
       simLinearSystem(const Math::Matrix& a_u, double threshold);
 
+      //! Propagate the state of the continuous model over a time
+      //! step and update the current state and output. Discretized
+      //! matrices are cached by time step; steps that fall between
+      //! two close cached steps are interpolated.
+      //! @param[in] a_u input vector.
+      //! @param[in] dt time step (s).
+      //! @return current output.
+      const Math::Matrix&
+      step(const Math::Matrix& a_u, double dt);
+
+      //! Simulate the continuous model over several steps of the same
+      //! duration, starting from the current state.
+      //! @param[in] a_u inputs, one column per step.
+      //! @param[in] dt time step (s).
+      //! @param[out] a_y outputs, one column per step. Resized only
+      //! if its dimensions do not match.
+      void
+      simulate(const Math::Matrix& a_u, double dt, Math::Matrix& a_y);
+
+      //! Discard cached discretizations.
+      void
+      clearCache(void)
+      {
+        m_cache.clear();
+      }
+
+      //! Retrieve number of cached discretizations.
+      inline size_t
+      getCacheSize(void) const
+      {
+        return m_cache.size();
+      }
+
       //! Retrive A matrix
       inline const Math::Matrix&
       getA(void) const
@@ -153,6 +188,8 @@ namespace DUNE
       setX0(Math::Matrix& a_x0)
       {
         m_X0 = a_x0;
+        for (size_t i = 0; i < m_x.size(); ++i)
+          m_x[i] = m_X0.element(i);
       }
 
       //! LinearSystem print
@@ -160,6 +197,47 @@ namespace DUNE
       operator<<(std::ostream& os, const LinearSystem& sys);
 
     private:
+      //! Discrete state and input matrices, row-major.
+      struct Discretization
+      {
+        std::vector<double> a;
+        std::vector<double> b;
+      };
+
+      //! Discretizations by time step.
+      typedef std::map<double, Discretization> Cache;
+
+      //! Update flat copies of the model and work buffers.
+      void
+      setup(void);
+
+      //! Discretize the continuous model.
+      //! @param[in] dt time step.
+      //! @param[out] disc discretization.
+      void
+      discretize(double dt, Discretization& disc) const;
+
+      //! Get the discretization for a time step.
+      //! @param[in] dt time step.
+      //! @return discretization.
+      const Discretization&
+      getDiscretization(double dt);
+
+      //! Compute the next state and output.
+      //! @param[in] disc discretization.
+      //! @param[in] u input vector.
+      void
+      propagate(const Discretization& disc, const double* u);
+
+      //! Update the output for the current state.
+      //! @param[in] u input vector.
+      void
+      output(const double* u);
+
+      //! Copy the state and output buffers to X0 and Y0.
+      void
+      sync(void);
+
       Math::Matrix m_A; //!< Linear system matrices
       Math::Matrix m_B; //!< Linear system matrices
       Math::Matrix m_C; //!< Linear system matrices
@@ -172,6 +250,24 @@ namespace DUNE
       short m_n_st; //!< number of inputs, outputs and states
 
       double m_Ts;           //!< sampling time
+
+      //! Continuous state and input matrices.
+      Math::Matrix m_Ac;
+      Math::Matrix m_Bc;
+      //! Discretization for the sampling time.
+      Discretization m_disc;
+      //! Interpolated discretization.
+      Discretization m_interp;
+      //! Output and feedthrough matrices, row-major.
+      std::vector<double> m_c;
+      std::vector<double> m_d;
+      //! State, output and input work buffers.
+      std::vector<double> m_x;
+      std::vector<double> m_y;
+      std::vector<double> m_u;
+      std::vector<double> m_next;
+      //! Cached discretizations.
+      Cache m_cache;
     };
   }
 }
@@ -0,0 +1,411 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONTROL_PID_BANK_HPP_INCLUDED_
+#define DUNE_CONTROL_PID_BANK_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Math/General.hpp>
+#include <DUNE/Tasks/Task.hpp>
+
+namespace DUNE
+{
+  namespace Control
+  {
+    //! Bank of N discrete PID controllers. Each controller behaves
+    //! as a DiscretePID, but the state of all controllers is kept in
+    //! arrays (structure of arrays) so that independent loops can be
+    //! stepped together and share the timing and saturation logic.
+    //! Disabled limits are infinite, so saturation has no branches.
+    //!
+    //! Gains can follow a gain schedule, a table of gains at given
+    //! values of a scheduling variable (e.g., speed) that is linearly
+    //! interpolated. Control parcels can be dispatched at a reduced
+    //! rate.
+    //! @tparam N number of controllers.
+    template <unsigned N>
+    class PIDBank
+    {
+    public:
+      //! Constructor.
+      PIDBank(void):
+        m_task(NULL),
+        m_parcels(NULL),
+        m_decimation(1)
+      {
+        for (unsigned i = 0; i < N; ++i)
+        {
+          m_kp[i] = 0;
+          m_ki[i] = 0;
+          m_kd[i] = 0;
+          m_lower[i] = -c_inf;
+          m_upper[i] = c_inf;
+          m_max_int[i] = c_inf;
+        }
+
+        reset();
+      }
+
+      //! Get the number of controllers.
+      //! @return number of controllers.
+      unsigned
+      size(void) const
+      {
+        return N;
+      }
+
+      //! Set the gains of a controller.
+      //! @param[in] i controller index.
+      //! @param[in] gains gains vector in order p, i, d.
+      void
+      setGains(unsigned i, const std::vector<float>& gains)
+      {
+        m_kp[i] = gains[0];
+        m_ki[i] = gains[1];
+        m_kd[i] = gains[2];
+      }
+
+      //! Get the current proportional gain of a controller.
+      //! @param[in] i controller index.
+      //! @return proportional gain.
+      float
+      getProportionalGain(unsigned i) const
+      {
+        return m_kp[i];
+      }
+
+      //! Get the current integral gain of a controller.
+      //! @param[in] i controller index.
+      //! @return integral gain.
+      float
+      getIntegralGain(unsigned i) const
+      {
+        return m_ki[i];
+      }
+
+      //! Get the current derivative gain of a controller.
+      //! @param[in] i controller index.
+      //! @return derivative gain.
+      float
+      getDerivativeGain(unsigned i) const
+      {
+        return m_kd[i];
+      }
+
+      //! Set output limits of a controller. Limits are disabled if both
+      //! are zero.
+      //! @param[in] i controller index.
+      //! @param[in] lower lower limit.
+      //! @param[in] upper upper limit.
+      void
+      setOutputLimits(unsigned i, float lower, float upper)
+      {
+        if ((lower == 0.0) && (upper == 0.0))
+        {
+          m_lower[i] = -c_inf;
+          m_upper[i] = c_inf;
+          return;
+        }
+
+        m_lower[i] = lower;
+        m_upper[i] = upper;
+      }
+
+      //! Set integral limits of a controller (anti-windup).
+      //! @param[in] i controller index.
+      //! @param[in] value absolute value of the bound, zero or negative
+      //! to disable.
+      void
+      setIntegralLimits(unsigned i, float value)
+      {
+        if (value <= 0.0)
+          m_max_int[i] = c_inf;
+        else
+          m_max_int[i] = value;
+      }
+
+      //! Set the gain schedule of a controller. Gains between points
+      //! are interpolated, gains outside are those of the first or
+      //! last point. Interpolation slopes are computed here, selecting
+      //! gains is cheap.
+      //! @param[in] i controller index.
+      //! @param[in] points increasing values of the scheduling variable.
+      //! @param[in] gains gains p, i and d of each point, in sequence.
+      //! @return true if the schedule is valid, false otherwise.
+      bool
+      setGainSchedule(unsigned i, const std::vector<float>& points,
+                      const std::vector<float>& gains)
+      {
+        m_sched[i].clear();
+
+        if (points.empty() || gains.size() != points.size() * 3)
+          return false;
+
+        for (unsigned j = 1; j < points.size(); ++j)
+        {
+          if (points[j] <= points[j - 1])
+            return false;
+        }
+
+        m_sched[i].resize(points.size());
+        for (unsigned j = 0; j < points.size(); ++j)
+        {
+          SchedulePoint& pt = m_sched[i][j];
+          pt.x = points[j];
+
+          for (unsigned k = 0; k < 3; ++k)
+          {
+            pt.gains[k] = gains[j * 3 + k];
+            pt.slopes[k] = 0;
+
+            if (j + 1 < points.size())
+              pt.slopes[k] = (gains[(j + 1) * 3 + k] - pt.gains[k]) / (points[j + 1] - pt.x);
+          }
+        }
+
+        return true;
+      }
+
+      //! Select the gains of a controller with a gain schedule.
+      //! Controllers without a gain schedule keep their gains.
+      //! @param[in] i controller index.
+      //! @param[in] value scheduling variable.
+      void
+      schedule(unsigned i, float value)
+      {
+        const std::vector<SchedulePoint>& sched = m_sched[i];
+        if (sched.empty())
+          return;
+
+        unsigned j = 0;
+        while (j + 1 < sched.size() && value >= sched[j + 1].x)
+          ++j;
+
+        float dx = value - sched[j].x;
+        if (dx < 0 || j + 1 == sched.size())
+          dx = 0;
+
+        m_kp[i] = sched[j].gains[0] + sched[j].slopes[0] * dx;
+        m_ki[i] = sched[j].gains[1] + sched[j].slopes[1] * dx;
+        m_kd[i] = sched[j].gains[2] + sched[j].slopes[2] * dx;
+      }
+
+      //! Select the gains of all controllers with a gain schedule.
+      //! @param[in] value scheduling variable.
+      void
+      schedule(float value)
+      {
+        for (unsigned i = 0; i < N; ++i)
+          schedule(i, value);
+      }
+
+      //! Dispatch the contribution of each term as control parcels.
+      //! @param[in] task task used to dispatch parcels, NULL to
+      //! disable parcels.
+      //! @param[in] parcels array of N parcels.
+      //! @param[in] decimation dispatch one parcel every this number
+      //! of steps of each controller.
+      void
+      enableParcels(Tasks::Task* task, IMC::ControlParcel* parcels, unsigned decimation = 1)
+      {
+        m_task = task;
+        m_parcels = parcels;
+        m_decimation = (decimation == 0) ? 1 : decimation;
+
+        for (unsigned i = 0; i < N; ++i)
+          m_parcel_steps[i] = 0;
+      }
+
+      //! Step one controller, using an internal error derivative
+      //! estimate.
+      //! @param[in] i controller index.
+      //! @param[in] timestep time since the last step.
+      //! @param[in] error error between reference and measure.
+      //! @return controller output.
+      float
+      step(unsigned i, double timestep, float error)
+      {
+        float deriv_err = (error - m_prev_err[i]) / timestep;
+        return step(i, timestep, error, deriv_err);
+      }
+
+      //! Step one controller, using the supplied error derivative.
+      //! @param[in] i controller index.
+      //! @param[in] timestep time since the last step.
+      //! @param[in] error error between reference and measure.
+      //! @param[in] err_derivative error derivative.
+      //! @return controller output.
+      float
+      step(unsigned i, double timestep, float error, float err_derivative)
+      {
+        dispatchParcel(i, error, err_derivative);
+        return update(i, timestep, error, err_derivative);
+      }
+
+      //! Step all controllers with the same time step. Controllers are
+      //! independent, cascaded loops must be stepped one at a time.
+      //! @param[in] timestep time since the last step.
+      //! @param[in] errors N errors between reference and measure.
+      //! @param[in] err_derivatives N error derivatives, NULL to use
+      //! internal estimates.
+      //! @param[out] outputs N controller outputs.
+      void
+      step(double timestep, const float* errors, const float* err_derivatives, float* outputs)
+      {
+        float derivs[N];
+
+        if (err_derivatives == NULL)
+        {
+          for (unsigned i = 0; i < N; ++i)
+            derivs[i] = (errors[i] - m_prev_err[i]) / timestep;
+        }
+        else
+        {
+          for (unsigned i = 0; i < N; ++i)
+            derivs[i] = err_derivatives[i];
+        }
+
+        if (m_task != NULL)
+        {
+          for (unsigned i = 0; i < N; ++i)
+            dispatchParcel(i, errors[i], derivs[i]);
+        }
+
+        for (unsigned i = 0; i < N; ++i)
+          outputs[i] = update(i, timestep, errors[i], derivs[i]);
+      }
+
+      //! Reset the state of one controller.
+      //! @param[in] i controller index.
+      void
+      reset(unsigned i)
+      {
+        m_int_err[i] = 0;
+        m_prev_err[i] = 0;
+        m_parcel_steps[i] = 0;
+      }
+
+      //! Reset the state of all controllers.
+      void
+      reset(void)
+      {
+        for (unsigned i = 0; i < N; ++i)
+          reset(i);
+      }
+
+    private:
+      //! Point of a gain schedule.
+      struct SchedulePoint
+      {
+        //! Value of the scheduling variable.
+        float x;
+        //! Gains p, i and d.
+        float gains[3];
+        //! Slopes of the gains up to the next point.
+        float slopes[3];
+      };
+
+      //! Infinite limit.
+      static const float c_inf;
+
+      //! Proportional gains.
+      float m_kp[N];
+      //! Integral gains.
+      float m_ki[N];
+      //! Derivative gains.
+      float m_kd[N];
+      //! Integral errors.
+      float m_int_err[N];
+      //! Previous error samples.
+      float m_prev_err[N];
+      //! Output lower limits.
+      float m_lower[N];
+      //! Output upper limits.
+      float m_upper[N];
+      //! Integral limits.
+      float m_max_int[N];
+      //! Gain schedules.
+      std::vector<SchedulePoint> m_sched[N];
+      //! Task used to dispatch parcels.
+      Tasks::Task* m_task;
+      //! Control parcels.
+      IMC::ControlParcel* m_parcels;
+      //! Steps between parcels.
+      unsigned m_decimation;
+      //! Steps since the last parcel of each controller.
+      unsigned m_parcel_steps[N];
+
+      //! Dispatch the parcel of a controller if it is due.
+      //! @param[in] i controller index.
+      //! @param[in] error error between reference and measure.
+      //! @param[in] err_derivative error derivative.
+      void
+      dispatchParcel(unsigned i, float error, float err_derivative)
+      {
+        if (m_task == NULL || m_parcels == NULL)
+          return;
+
+        if (m_parcel_steps[i]++ % m_decimation != 0)
+          return;
+
+        m_parcels[i].p = m_kp[i] * error;
+        m_parcels[i].i = m_int_err[i];
+        m_parcels[i].d = m_kd[i] * err_derivative;
+        m_task->dispatch(m_parcels[i]);
+      }
+
+      //! Compute the output of a controller and update its state.
+      //! @param[in] i controller index.
+      //! @param[in] timestep time since the last step.
+      //! @param[in] error error between reference and measure.
+      //! @param[in] err_derivative error derivative.
+      //! @return controller output.
+      float
+      update(unsigned i, double timestep, float error, float err_derivative)
+      {
+        float cmd = m_kp[i] * error + m_kd[i] * err_derivative + m_int_err[i];
+        cmd = Math::trimValue(cmd, m_lower[i], m_upper[i]);
+
+        m_int_err[i] += m_ki[i] * error * timestep;
+        m_int_err[i] = Math::trimValue(m_int_err[i], -m_max_int[i], m_max_int[i]);
+
+        m_prev_err[i] = error;
+        return cmd;
+      }
+    };
+
+    template <unsigned N>
+    const float PIDBank<N>::c_inf = std::numeric_limits<float>::infinity();
+  }
+}
+
+#endif
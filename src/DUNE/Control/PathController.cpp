@@ -356,8 +356,7 @@ namespace DUNE
                           &m_ts.end.x, &m_ts.end.y);
       m_ts.end.z = m_pcs.end_z;
 
-      Coordinates::getBearingAndRange(m_ts.start, m_ts.end,
-                                      &m_ts.track_bearing, &m_ts.track_length);
+      updateTrackGeometry();
 
       // Re-initializing tracking state values
       m_ts.start_time = now;
@@ -464,8 +463,7 @@ namespace DUNE
           m_ts.nearby = false;
         }
 
-        Coordinates::getBearingAndRange(m_ts.start, m_ts.end,
-                                        &m_ts.track_bearing, &m_ts.track_length);
+        updateTrackGeometry();
       }
       else
       {
@@ -709,7 +707,8 @@ namespace DUNE
     PathController::updateTrackingState(void)
     {
       // Range and LOS angle to destination
-      getBearingAndRange(m_estate, m_ts.end, &m_ts.los_angle, &m_ts.range);
+      if (m_ts.loitering || usesLineOfSight())
+        getBearingAndRange(m_estate, m_ts.end, &m_ts.los_angle, &m_ts.range);
 
       // Ground course and speed
       m_ts.course = m_ts.cc ? std::atan2(m_estate.vy, m_estate.vx) : m_estate.psi;
@@ -765,6 +764,15 @@ namespace DUNE
       m_ts.track_vel.z = std::sin(m_estate.theta) * m_estate.vz; // vertical-track
     }
 
+    void
+    PathController::updateTrackGeometry(void)
+    {
+      Coordinates::getBearingAndRange(m_ts.start, m_ts.end,
+                                      &m_ts.track_bearing, &m_ts.track_length);
+      m_ts.track_cos = std::cos(m_ts.track_bearing);
+      m_ts.track_sin = std::sin(m_ts.track_bearing);
+    }
+
     bool
     PathController::navigationJumped(const IMC::EstimatedState* new_state,
                                      const IMC::EstimatedState* old_state,
@@ -1038,6 +1046,8 @@ namespace DUNE
       Coordinates::setBearingAndRange(lts.start, b, 500, lts.end);
 
       lts.track_bearing = b;
+      lts.track_cos = std::cos(b);
+      lts.track_sin = std::sin(b);
       lts.track_length = 500;
       lts.track_pos.x = 0;
       lts.los_angle = getBearing(state, lts.end);
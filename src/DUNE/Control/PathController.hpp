@@ -169,6 +169,10 @@ namespace DUNE
         double track_bearing;
         //! distance from start to end.
         double track_length;
+        //! cosine of the track bearing.
+        double track_cos;
+        //! sine of the track bearing.
+        double track_sin;
         //! range from current position to end.
         double range;
         //! angle from current position to end (line-of-sight angle).
@@ -213,6 +217,17 @@ namespace DUNE
         bool cc : 1;
       };
 
+      //! Test if the controller uses the range and line-of-sight
+      //! angle to the end point while tracking a straight line (they
+      //! are always computed while loitering). Controllers that do
+      //! not should override this to skip computing them.
+      //! @return true by default.
+      virtual bool
+      usesLineOfSight(void) const
+      {
+        return true;
+      }
+
       //! Handler for the startup of a new path.
       //! The default handler does nothing and can be overriden.
       //! This is called when a new path is started
@@ -333,9 +348,19 @@ namespace DUNE
       inline void
       getTrackPosition(const T& coord, double* x, double* y = 0)
       {
-        Coordinates::getTrackPosition(m_ts.start, m_ts.track_bearing, coord, x, y);
+        double dx = coord.x - m_ts.start.x;
+        double dy = coord.y - m_ts.start.y;
+
+        *x = dx * m_ts.track_cos + dy * m_ts.track_sin;
+        if (y)
+          *y = dy * m_ts.track_cos - dx * m_ts.track_sin;
       }
 
+      //! Compute the track bearing, length and direction from the
+      //! start and end points.
+      void
+      updateTrackGeometry(void);
+
       //! Deactivate bottom tracker
       void
       deactivateBottomTracker(void);
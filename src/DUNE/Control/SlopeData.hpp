@@ -30,6 +30,7 @@
 
 // ISO C++ 98 headers.
 #include <cmath>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Math.hpp>
@@ -37,6 +38,8 @@
 #include <DUNE/IMC.hpp>
 #include <DUNE/Coordinates/General.hpp>
 #include <DUNE/Coordinates/WGS84.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Control/SlopeFit.hpp>
 
 using namespace DUNE::Coordinates;
 using namespace DUNE::Math;
@@ -51,6 +54,10 @@ static const float c_max_range = 15.0f;
 static const float c_decay_factor = 0.6f;
 //! Tolerance for assuming the echoes come from the surface
 static const float c_surface_tol = 5.0f;
+//! Number of bottom points used to fit the slope
+static const unsigned c_fit_points = 24;
+//! Time after which a forward sonar without readings is ignored
+static const double c_sonar_timeout = 2.0;
 
 namespace DUNE
 {
@@ -70,27 +77,37 @@ namespace DUNE
         m_safe_pitch(safe_pitch),
         m_fsamples(fsamples),
         m_slope_hyst(slope_hyst),
+        m_fit(c_fit_points),
         m_too_steep(false),
-        m_sonar_conf(false)
-      { };
+        m_theta(0.0f),
+        m_sin_theta(0.0f),
+        m_cos_theta(1.0f)
+      {
+        reset();
+      };
 
       //! Deconstructor
       ~SlopeData(void)
       {
-        Memory::clear(m_frange);
+        for (unsigned i = 0; i < m_sonars.size(); ++i)
+          delete m_sonars[i];
       };
 
       //! Reset the object
       void
       reset(void)
       {
-        if (m_frange != NULL)
-          m_frange->clear();
+        for (unsigned i = 0; i < m_sonars.size(); ++i)
+          delete m_sonars[i];
+        m_sonars.clear();
+        m_frange = NULL;
 
         m_last_slope = 0.0;
         m_curr_slope = 0.0;
 
-        m_sonar_conf = false;
+        m_fit.clear();
+        m_along = 0.0;
+        m_has_pos = false;
 
         m_slope_top.reset();
       }
@@ -102,27 +119,12 @@ namespace DUNE
       void
       onDistance(const IMC::Distance* msg, const IMC::EstimatedState& state, IMC::ControlParcel& cparcel)
       {
-        if (!m_sonar_conf && msg->location.size())
-        {
-          // check if it is an echo sounder and pointing forward
-          // checking first in the list only
-          if ((std::fabs((*msg->location.begin())->psi) < 0.1) &&
-              (std::fabs((*msg->location.begin())->theta) < 0.1) &&
-              msg->beam_config.size())
-          {
-            m_beam_width = (*msg->beam_config.begin())->beam_width;
-            m_sonar_conf = true;
-            m_sonar_entity = msg->getSourceEntity();
+        Sonar* sonar = getSonar(msg);
+        if (sonar == NULL)
+          return;
 
-            if (msg->validity == IMC::Distance::DV_VALID)
-              update(msg->value, state, cparcel);
-          }
-        }
-        else if ((m_sonar_entity == msg->getSourceEntity()) &&
-                 (msg->validity == IMC::Distance::DV_VALID))
-        {
-          update(msg->value, state, cparcel);
-        }
+        if (msg->validity == IMC::Distance::DV_VALID)
+          update(*sonar, msg->value, state, cparcel);
       }
 
       //! Update slope top
@@ -134,7 +136,7 @@ namespace DUNE
         if (!isRangeValid())
           return -1.0;
 
-        return m_slope_top.update(state, m_frange->mean());
+        return m_slope_top.update(state, m_frange->range.mean());
       }
 
       //! Get forward range
@@ -145,7 +147,7 @@ namespace DUNE
         if (!isRangeValid())
           return c_max_range;
 
-        return m_frange->mean();
+        return m_frange->range.mean();
       }
 
       //! Get current slope angle
@@ -175,7 +177,7 @@ namespace DUNE
         if (!isRangeValid())
           return false;
 
-        return m_frange->mean() < m_min_range;
+        return m_frange->range.mean() < m_min_range;
       }
 
       //! Test if slope is too steep
@@ -217,11 +219,13 @@ namespace DUNE
         if (!isRangeValid())
           return false;
 
-        if (m_frange->mean() >= c_surface_tol)
+        if (m_frange->range.mean() >= c_surface_tol)
           return false; // Could be surface, but we dont care
 
-        float upper_end;
-        upper_end = m_frange->mean() * (float)std::sin(state.theta + m_beam_width / 2.0);
+        // sin(theta + mounting + half beam width).
+        updatePitch(state.theta);
+        float sin_up = m_sin_theta * m_frange->cos_up + m_cos_theta * m_frange->sin_up;
+        float upper_end = m_frange->range.mean() * sin_up;
 
         return (state.depth - upper_end < 0.0);
       }
@@ -245,6 +249,31 @@ namespace DUNE
       }
 
     private:
+      //! Forward looking sonar.
+      struct Sonar
+      {
+        //! Source entity.
+        unsigned entity;
+        //! Forward range moving average.
+        MovingAverage<float> range;
+        //! Cosine and sine of the mounting pitch angle.
+        float cos_mount, sin_mount;
+        //! Cosine and sine of the mounting pitch plus half beam width.
+        float cos_up, sin_up;
+        //! Time of last valid reading.
+        double last;
+
+        Sonar(unsigned eid, unsigned samples, float mount, float beam_width):
+          entity(eid),
+          range(samples),
+          cos_mount((float)std::cos(mount)),
+          sin_mount((float)std::sin(mount)),
+          cos_up((float)std::cos(mount + beam_width / 2.0)),
+          sin_up((float)std::sin(mount + beam_width / 2.0)),
+          last(-1.0)
+        { }
+      };
+
       //! Test if forward range is valid
       //! @return true if range is valid and can be used
       inline bool
@@ -253,31 +282,118 @@ namespace DUNE
         return (m_frange != NULL);
       }
 
+      //! Find the forward sonar that produced a distance reading,
+      //! registering it on its first reading.
+      //! @param[in] msg distance message.
+      //! @return sonar or NULL if the reading is not from a forward
+      //! looking echo sounder.
+      Sonar*
+      getSonar(const IMC::Distance* msg)
+      {
+        for (unsigned i = 0; i < m_sonars.size(); ++i)
+        {
+          if (m_sonars[i]->entity == msg->getSourceEntity())
+            return m_sonars[i];
+        }
+
+        if (!msg->location.size() || !msg->beam_config.size())
+          return NULL;
+
+        // check if it is an echo sounder and pointing forward
+        // checking first in the list only
+        const IMC::DeviceState* loc = *msg->location.begin();
+        if ((std::fabs(loc->psi) >= 0.1) || (std::fabs(loc->theta) >= 0.1))
+          return NULL;
+
+        Sonar* sonar = new Sonar(msg->getSourceEntity(), m_fsamples, loc->theta,
+                                 (*msg->beam_config.begin())->beam_width);
+        m_sonars.push_back(sonar);
+        return sonar;
+      }
+
+      //! Select the sonar reporting the shortest forward range among
+      //! those with recent readings.
+      //! @param[in] now current time.
+      void
+      selectSonar(double now)
+      {
+        for (unsigned i = 0; i < m_sonars.size(); ++i)
+        {
+          Sonar* sonar = m_sonars[i];
+          if (sonar->last < 0 || now - sonar->last > c_sonar_timeout)
+            continue;
+
+          if (m_frange == NULL || now - m_frange->last > c_sonar_timeout
+              || sonar->range.mean() < m_frange->range.mean())
+            m_frange = sonar;
+        }
+      }
+
+      //! Refresh cached trigonometry of the vehicle's pitch.
+      //! @param[in] theta pitch angle.
+      inline void
+      updatePitch(float theta) const
+      {
+        if (theta == m_theta)
+          return;
+
+        m_theta = theta;
+        m_sin_theta = (float)std::sin(theta);
+        m_cos_theta = (float)std::cos(theta);
+      }
+
+      //! Advance the along-track distance to the vehicle's position.
+      //! @param[in] state EstimatedState info
+      void
+      updateAlongTrack(const IMC::EstimatedState& state)
+      {
+        bool same_ref = m_has_pos && state.lat == m_ref_lat && state.lon == m_ref_lon;
+        if (same_ref)
+          m_along += std::sqrt((state.x - m_last_x) * (state.x - m_last_x)
+                               + (state.y - m_last_y) * (state.y - m_last_y));
+        else if (m_has_pos)
+          m_fit.clear();
+
+        m_has_pos = true;
+        m_ref_lat = state.lat;
+        m_ref_lon = state.lon;
+        m_last_x = state.x;
+        m_last_y = state.y;
+      }
+
       //! Update tracking data.
+      //! @param[in] sonar sonar that produced the reading.
       //! @param[in] value new measurement to update filter.
       //! @param[in] state EstimatedState info
       //! @param[out] cparcel control parcel message for debug
       void
-      update(float value, const IMC::EstimatedState& state, IMC::ControlParcel& cparcel)
+      update(Sonar& sonar, float value, const IMC::EstimatedState& state, IMC::ControlParcel& cparcel)
       {
-        if (m_frange == NULL)
-          m_frange = new MovingAverage<float>(m_fsamples);
+        double now = Time::Clock::get();
+        sonar.range.update(value);
+        sonar.last = now;
+        selectSonar(now);
+
+        updatePitch(state.theta);
+        updateAlongTrack(state);
+
+        // Bottom below the vehicle and bottom hit by the beam.
+        float sin_el = m_sin_theta * sonar.cos_mount + m_cos_theta * sonar.sin_mount;
+        float cos_el = m_cos_theta * sonar.cos_mount - m_sin_theta * sonar.sin_mount;
+
+        if (state.alt >= 0)
+          m_fit.add(m_along, state.depth + state.alt);
 
-        double frange = m_frange->update(value);
+        if (value <= c_max_range)
+          m_fit.add(m_along + value * cos_el, state.depth - value * sin_el);
+
+        double frange = m_frange->range.mean();
         m_last_slope = m_curr_slope;
 
-        if (frange > c_max_range)
-        {
+        if (frange > c_max_range || !m_fit.isValid())
           m_curr_slope *= c_decay_factor;
-        }
         else
-        {
-          // bottom range is not exactly the same as altitude due to pitch angle
-          float brange = state.alt / (float)std::cos(state.theta);
-          float z = - (float)frange * (float)std::sin(state.theta) - state.alt;
-          float x = (float)(frange * std::cos(state.theta) - brange * std::sin(state.theta));
-          m_curr_slope = - (float)std::atan2(z, x);
-        }
+          m_curr_slope = (float)m_fit.getAngle();
 
         // debug
         cparcel.p = (float)frange;
@@ -375,8 +491,10 @@ namespace DUNE
         }
       };
 
-      //! Forward range moving average.
-      MovingAverage<float>* m_frange;
+      //! Forward looking sonars.
+      std::vector<Sonar*> m_sonars;
+      //! Sonar providing the forward range.
+      Sonar* m_frange;
       //! Minimum range admissible
       const float m_min_range;
       //! Safe pitch angle considered to track bottom
@@ -385,6 +503,15 @@ namespace DUNE
       const unsigned m_fsamples;
       //! Slope hysteresis value
       const float m_slope_hyst;
+      //! Bottom slope fit.
+      SlopeFit m_fit;
+      //! Along-track distance travelled.
+      double m_along;
+      //! True if a previous position is known.
+      bool m_has_pos;
+      //! Reference and displacement of the previous position.
+      double m_ref_lat, m_ref_lon;
+      float m_last_x, m_last_y;
       //! Coordinate of the top of the slope.
       SlopeTop m_slope_top;
       //! Current slope angle.
@@ -393,12 +520,8 @@ namespace DUNE
       float m_last_slope;
       //! True if last time we checked slope was too steep
       bool m_too_steep;
-      //! True if sonar has been configured
-      bool m_sonar_conf;
-      //! Sonar entity.
-      unsigned m_sonar_entity;
-      //! Echo sounder beam width.
-      float m_beam_width;
+      //! Pitch angle and its cached sine and cosine.
+      mutable float m_theta, m_sin_theta, m_cos_theta;
     };
   }
 }
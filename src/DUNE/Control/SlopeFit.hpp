@@ -0,0 +1,198 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_CONTROL_SLOPE_FIT_HPP_INCLUDED_
+#define DUNE_CONTROL_SLOPE_FIT_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Utils/CircularBuffer.hpp>
+
+namespace DUNE
+{
+  namespace Control
+  {
+    //! Least squares fit of bottom depth against along-track
+    //! distance over a sliding window of bottom points. The sums of
+    //! the normal equations are updated as points enter and leave
+    //! the window, so adding a point costs O(1) regardless of the
+    //! window size.
+    class SlopeFit
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity number of points in the window.
+      SlopeFit(unsigned capacity):
+        m_points(capacity)
+      {
+        clear();
+      }
+
+      //! Discard all points.
+      void
+      clear(void)
+      {
+        m_points.clear();
+        m_x0 = 0.0;
+        m_sx = 0.0;
+        m_sz = 0.0;
+        m_sxx = 0.0;
+        m_sxz = 0.0;
+        m_evicted = 0;
+      }
+
+      //! Add a bottom point, evicting the oldest one if the window
+      //! is full.
+      //! @param[in] x along-track distance (m).
+      //! @param[in] z bottom depth (m).
+      void
+      add(double x, double z)
+      {
+        if (m_points.getSize() == 0)
+          m_x0 = x;
+
+        if (m_points.getSize() == m_points.getCapacity())
+        {
+          const Point& old = m_points(0);
+          accumulate(old.x, old.z, -1.0);
+          ++m_evicted;
+        }
+
+        Point pt = {x, z};
+        m_points.add(pt);
+        accumulate(x, z, 1.0);
+
+        // Running sums drift as points come and go: rebuild them,
+        // relative to the newest point, once per window.
+        if (m_evicted >= m_points.getCapacity())
+          rebuild();
+      }
+
+      //! Get number of points in the window.
+      //! @return number of points.
+      unsigned
+      getSize(void) const
+      {
+        return m_points.getSize();
+      }
+
+      //! Test if the points define a line, i.e., if there are at
+      //! least two of them at distinct along-track distances.
+      //! @return true if the fit is valid, false otherwise.
+      bool
+      isValid(void) const
+      {
+        // Variance of along-track distances of at least 1 mm^2.
+        double n = getSize();
+        return n >= 2 && getDenominator() > 1e-6 * n * n;
+      }
+
+      //! Get the fitted depth gradient.
+      //! @return depth change per meter along-track, zero if the fit
+      //! is not valid.
+      double
+      getGradient(void) const
+      {
+        if (!isValid())
+          return 0.0;
+
+        double n = getSize();
+        return (n * m_sxz - m_sx * m_sz) / getDenominator();
+      }
+
+      //! Get the bottom slope angle.
+      //! @return slope angle (rad), positive when the bottom rises
+      //! ahead of the vehicle.
+      double
+      getAngle(void) const
+      {
+        return std::atan(-getGradient());
+      }
+
+    private:
+      //! Bottom point.
+      struct Point
+      {
+        //! Along-track distance.
+        double x;
+        //! Depth.
+        double z;
+      };
+
+      //! Point window.
+      Utils::CircularBuffer<Point> m_points;
+      //! Along-track distance origin of the sums.
+      double m_x0;
+      //! Sum of distances.
+      double m_sx;
+      //! Sum of depths.
+      double m_sz;
+      //! Sum of squared distances.
+      double m_sxx;
+      //! Sum of distance times depth.
+      double m_sxz;
+      //! Evictions since the sums were rebuilt.
+      unsigned m_evicted;
+
+      void
+      accumulate(double x, double z, double sign)
+      {
+        double dx = x - m_x0;
+        m_sx += sign * dx;
+        m_sz += sign * z;
+        m_sxx += sign * dx * dx;
+        m_sxz += sign * dx * z;
+      }
+
+      void
+      rebuild(void)
+      {
+        m_x0 = m_points(m_points.getSize() - 1).x;
+        m_sx = 0.0;
+        m_sz = 0.0;
+        m_sxx = 0.0;
+        m_sxz = 0.0;
+        m_evicted = 0;
+
+        for (unsigned i = 0; i < m_points.getSize(); ++i)
+          accumulate(m_points(i).x, m_points(i).z, 1.0);
+      }
+
+      double
+      getDenominator(void) const
+      {
+        double n = getSize();
+        return n * m_sxx - m_sx * m_sx;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,103 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Coordinates/WGS84.hpp>
+
+namespace DUNE
+{
+  namespace Coordinates
+  {
+    void
+    WGS84::displacement(double rlat, double rlon, double rhae, size_t count,
+                        const double* lat, const double* lon, const double* hae,
+                        double* n, double* e, double* d)
+    {
+      double rx;
+      double ry;
+      double rz;
+      toECEF(rlat, rlon, rhae, &rx, &ry, &rz);
+
+      double slat = std::sin(rlat);
+      double clat = std::cos(rlat);
+      double slon = std::sin(rlon);
+      double clon = std::cos(rlon);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        double h = (hae != NULL) ? hae[i] : 0.0;
+        double ox;
+        double oy;
+        double oz;
+        toECEF(lat[i], lon[i], h, &ox, &oy, &oz);
+
+        ox -= rx;
+        oy -= ry;
+        oz -= rz;
+
+        n[i] = -slat * clon * ox - slat * slon * oy + clat * oz;
+        e[i] = -slon * ox + clon * oy;
+
+        if (d != NULL)
+          d[i] = -clat * clon * ox - clat * slon * oy - slat * oz;
+      }
+    }
+
+    void
+    WGS84::displace(double rlat, double rlon, double rhae, size_t count,
+                    const double* n, const double* e, const double* d,
+                    double* lat, double* lon, double* hae)
+    {
+      double rx;
+      double ry;
+      double rz;
+      toECEF(rlat, rlon, rhae, &rx, &ry, &rz);
+
+      // Geocentric latitude of the reference.
+      double phi = std::atan2(rz, std::sqrt(rx * rx + ry * ry));
+      double slon = std::sin(rlon);
+      double clon = std::cos(rlon);
+      double sphi = std::sin(phi);
+      double cphi = std::cos(phi);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        double dd = (d != NULL) ? d[i] : 0.0;
+        double x = rx - slon * e[i] - clon * sphi * n[i] - clon * cphi * dd;
+        double y = ry + clon * e[i] - slon * sphi * n[i] - slon * cphi * dd;
+        double z = rz + cphi * n[i] - sphi * dd;
+
+        double h;
+        lon[i] = std::atan2(y, x);
+        fromECEF(std::sqrt(x * x + y * y), z, &lat[i], &h);
+
+        if (hae != NULL)
+          hae[i] = h;
+      }
+    }
+  }
+}
@@ -241,6 +241,45 @@ namespace DUNE
         *range = (Tb)std::sqrt(n * n + e * e);
       }
 
+      //! Compute North-East-Down displacements of many WGS-84
+      //! coordinates relative to a common reference. Equivalent to
+      //! calling displacement() for each coordinate, with the
+      //! reference terms computed once.
+      //!
+      //! @param[in] rlat reference WGS-84 latitude (rad).
+      //! @param[in] rlon reference WGS-84 longitude (rad).
+      //! @param[in] rhae reference WGS-84 coordinate height (m).
+      //! @param[in] count number of coordinates.
+      //! @param[in] lat WGS-84 latitudes (rad).
+      //! @param[in] lon WGS-84 longitudes (rad).
+      //! @param[in] hae heights (m), or NULL for zero height.
+      //! @param[out] n North offsets.
+      //! @param[out] e East offsets.
+      //! @param[out] d Down offsets, or NULL.
+      static void
+      displacement(double rlat, double rlon, double rhae, size_t count,
+                   const double* lat, const double* lon, const double* hae,
+                   double* n, double* e, double* d);
+
+      //! Displace a common WGS-84 reference by many NED offsets.
+      //! Equivalent to calling displace() on a copy of the reference
+      //! for each offset, with the reference terms computed once.
+      //!
+      //! @param[in] rlat reference WGS-84 latitude (rad).
+      //! @param[in] rlon reference WGS-84 longitude (rad).
+      //! @param[in] rhae reference WGS-84 coordinate height (m).
+      //! @param[in] count number of offsets.
+      //! @param[in] n North offsets (m).
+      //! @param[in] e East offsets (m).
+      //! @param[in] d Down offsets (m), or NULL for zero offsets.
+      //! @param[out] lat displaced latitudes (rad).
+      //! @param[out] lon displaced longitudes (rad).
+      //! @param[out] hae displaced heights (m), or NULL.
+      static void
+      displace(double rlat, double rlon, double rhae, size_t count,
+               const double* n, const double* e, const double* d,
+               double* lat, double* lon, double* hae);
+
     private:
       //! Convert WGS-84 coordinates to ECEF (Earch Center Earth Fixed) coordinates.
       //!
@@ -285,22 +324,51 @@ namespace DUNE
         assert(lon != 0);
         assert(hae != 0);
 
-        double p = std::sqrt(x * x + y * y);
+        double rlat;
+        double rhae;
         *lon = std::atan2(y, x);
-        *lat = std::atan2(z / p, 0.01);
-        double n = computeRn(*lat);
-        *hae = p / std::cos(*lat) - n;
-        double old_hae = -1e-9;
-        double num = z / p;
-
-        while (std::fabs(*hae - old_hae) > 1e-4)
-        {
-          old_hae = *hae;
-          double den = 1 - c_wgs84_e2 * n / (n + *hae);
-          *lat = std::atan2(num, den);
-          n = computeRn(*lat);
-          *hae = p / std::cos(*lat) - n;
-        }
+        fromECEF(std::sqrt(x * x + y * y), z, &rlat, &rhae);
+        *lat = rlat;
+        *hae = rhae;
+      }
+
+      //! Closed-form conversion of meridian plane coordinates to
+      //! geodetic latitude and height (Zhu, 1994).
+      //!
+      //! @param[in] p distance to the polar axis (m).
+      //! @param[in] z ECEF z coordinate (m).
+      //! @param[out] lat WGS-84 latitude (rad).
+      //! @param[out] hae height above WGS-84 ellipsoid (m).
+      static inline void
+      fromECEF(double p, double z, double* lat, double* hae)
+      {
+        // Semi-minor axis and second eccentricity are derived from the
+        // first eccentricity so that toECEF() is inverted exactly.
+        const double a2 = c_wgs84_a * c_wgs84_a;
+        const double b2 = a2 * (1.0 - c_wgs84_e2);
+        const double e4 = c_wgs84_e2 * c_wgs84_e2;
+        const double ep2 = c_wgs84_e2 / (1.0 - c_wgs84_e2);
+
+        double p2 = p * p;
+        double z2 = z * z;
+        double f = 54.0 * b2 * z2;
+        double g = p2 + (1.0 - c_wgs84_e2) * z2 - c_wgs84_e2 * (a2 - b2);
+        double c = e4 * f * p2 / (g * g * g);
+        double s = std::pow(1.0 + c + std::sqrt(c * c + 2.0 * c), 1.0 / 3.0);
+        double k = s + 1.0 / s + 1.0;
+        double pp = f / (3.0 * k * k * g * g);
+        double q = std::sqrt(1.0 + 2.0 * e4 * pp);
+        double r0 = -(pp * c_wgs84_e2 * p) / (1.0 + q)
+        + std::sqrt(0.5 * a2 * (1.0 + 1.0 / q)
+                    - pp * (1.0 - c_wgs84_e2) * z2 / (q * (1.0 + q))
+                    - 0.5 * pp * p2);
+        double t = p - c_wgs84_e2 * r0;
+        double u = std::sqrt(t * t + z2);
+        double v = std::sqrt(t * t + (1.0 - c_wgs84_e2) * z2);
+        double z0 = b2 * z / (c_wgs84_a * v);
+
+        *hae = u * (1.0 - b2 / (c_wgs84_a * v));
+        *lat = std::atan2(z + ep2 * z0, p);
       }
 
       //! Compute the radius of curvature in the prime vertical (Rn).
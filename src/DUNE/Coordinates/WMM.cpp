@@ -27,12 +27,14 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
 // DUNE headers.
 #include <DUNE/Coordinates/WMM.hpp>
 #include <DUNE/Math/Angles.hpp>
+#include <DUNE/Math/Constants.hpp>
 #include <DUNE/Time/BrokenDown.hpp>
 
 using namespace DUNE::FileSystem;
@@ -47,12 +49,26 @@ namespace DUNE
   namespace Coordinates
   {
     static const int c_num_terms = ((WMM_MAX_MODEL_DEGREES + 1) * (WMM_MAX_MODEL_DEGREES + 2) / 2);
+    //! Height change (m) that invalidates the grid cache cell.
+    static const double c_cache_height = 1000.0;
 
     struct WMMData
     {
       WMMtype_Geoid geoid;
       WMMtype_Ellipsoid ellip;
       WMMtype_MagneticModel* mm;
+      //! Grid cache cell size (rad), zero if disabled.
+      double cell;
+      //! True if the cached cell is valid.
+      bool cached;
+      //! South-west corner and height of the cached cell.
+      double lat0;
+      double lon0;
+      double height;
+      //! Declination and inclination at the corners of the cached
+      //! cell, ordered SW, SE, NW, NE.
+      double decl[4];
+      double incl[4];
     };
 
     WMM::WMM(void)
@@ -69,6 +85,8 @@ namespace DUNE
     WMM::init(const Path& root)
     {
       m_data = new WMMData;
+      m_data->cell = 0;
+      m_data->cached = false;
       Path egmfile(root / "wmm/egm9615.bin");
       Path wmmfile(root / "wmm/wmm.cof");
 
@@ -121,6 +139,31 @@ namespace DUNE
 
     double
     WMM::declination(double lat, double lon, double h)
+    {
+      double decl;
+      double incl;
+      lookup(lat, lon, h, &decl, &incl);
+      return decl;
+    }
+
+    double
+    WMM::inclination(double lat, double lon, double h)
+    {
+      double decl;
+      double incl;
+      lookup(lat, lon, h, &decl, &incl);
+      return incl;
+    }
+
+    void
+    WMM::setGridCache(double cell)
+    {
+      m_data->cell = cell;
+      m_data->cached = false;
+    }
+
+    void
+    WMM::evaluate(double lat, double lon, double h, double* decl, double* incl)
     {
       WMMtype_CoordGeodetic geo;
       WMMtype_CoordSpherical sph;
@@ -135,7 +178,59 @@ namespace DUNE
       WMM_Geomag(m_data->ellip, sph, geo, m_data->mm, &gme);
       WMM_CalculateGridVariation(geo, &gme);
 
-      return Angles::radians(gme.Decl);
+      *decl = Angles::radians(gme.Decl);
+      *incl = Angles::radians(gme.Incl);
+    }
+
+    void
+    WMM::lookup(double lat, double lon, double h, double* decl, double* incl)
+    {
+      WMMData& d = *m_data;
+
+      if (d.cell <= 0)
+      {
+        evaluate(lat, lon, h, decl, incl);
+        return;
+      }
+
+      lon = Angles::normalizeRadian(lon);
+
+      double u = (lat - d.lat0) / d.cell;
+      double v = Angles::normalizeRadian(lon - d.lon0) / d.cell;
+
+      if (!d.cached || u < 0 || u > 1 || v < 0 || v > 1
+          || std::fabs(h - d.height) > c_cache_height)
+      {
+        d.lat0 = std::floor(lat / d.cell) * d.cell;
+        d.lon0 = std::floor(lon / d.cell) * d.cell;
+        d.height = h;
+
+        for (unsigned i = 0; i < 4; ++i)
+        {
+          double clat = std::min(d.lat0 + (i / 2) * d.cell, c_half_pi);
+          evaluate(clat, d.lon0 + (i % 2) * d.cell, h, &d.decl[i], &d.incl[i]);
+        }
+
+        // Unwrap declinations around the first corner.
+        for (unsigned i = 1; i < 4; ++i)
+          d.decl[i] = d.decl[0] + Angles::normalizeRadian(d.decl[i] - d.decl[0]);
+
+        d.cached = true;
+        u = (lat - d.lat0) / d.cell;
+        v = (lon - d.lon0) / d.cell;
+      }
+
+      double w[4] = {(1 - u) * (1 - v), (1 - u) * v, u * (1 - v), u * v};
+      double dc = 0;
+      double ic = 0;
+      for (unsigned i = 0; i < 4; ++i)
+      {
+        dc += w[i] * d.decl[i];
+        ic += w[i] * d.incl[i];
+      }
+
+      *decl = Angles::normalizeRadian(dc);
+      *incl = ic;
     }
   }
 }
@@ -75,10 +75,45 @@ namespace DUNE
       double
       declination(double lat, double lon, double height = 0);
 
+      //! Get magnetic inclination for given latitude and longitude (in radians).
+      //! @param[in] lat WGS84 latitude
+      //! @param[in] lon WGS84 longitude
+      //! @param[in] height optional height argument (defaults to 0)
+      //! @return magnetic inclination (positive down)
+      double
+      inclination(double lat, double lon, double height = 0);
+
+      //! Answer declination and inclination queries from a local grid
+      //! cell instead of evaluating the model on every call. The
+      //! model is evaluated at the corners of the cell containing the
+      //! query, values inside it are interpolated bilinearly, and the
+      //! cell is rebuilt only when a query falls outside of it.
+      //! @param[in] cell cell size in radians (0 disables the cache).
+      void
+      setGridCache(double cell);
+
     private:
       void
       init(const FileSystem::Path& root);
 
+      //! Evaluate the model.
+      //! @param[in] lat WGS84 latitude (rad).
+      //! @param[in] lon WGS84 longitude (rad).
+      //! @param[in] height height (m).
+      //! @param[out] decl magnetic declination (rad).
+      //! @param[out] incl magnetic inclination (rad).
+      void
+      evaluate(double lat, double lon, double height, double* decl, double* incl);
+
+      //! Evaluate using the grid cache if enabled.
+      //! @param[in] lat WGS84 latitude (rad).
+      //! @param[in] lon WGS84 longitude (rad).
+      //! @param[in] height height (m).
+      //! @param[out] decl magnetic declination (rad).
+      //! @param[out] incl magnetic inclination (rad).
+      void
+      lookup(double lat, double lon, double height, double* decl, double* incl);
+
       WMMData* m_data;
     };
   }
@@ -26,6 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <map>
 #include <sstream>
 #include <cstddef>
@@ -40,6 +41,9 @@
 
 namespace DUNE
 {
+  //! Maximum number of locks reported with each statistics report.
+  static const unsigned c_hot_locks = 5;
+
   Daemon::Daemon(DUNE::Tasks::Context& ctx, const std::string& profiles):
     DUNE::Tasks::Task("Daemon", ctx),
     m_tman(NULL),
@@ -125,12 +129,41 @@ namespace DUNE
       inf(DTR("execution profiles: %s"), profiles.c_str());
     }
 
+    // Pure simulations may run at another speed.
+    if (m_ctx.profiles.isSelected("Simulation"))
+    {
+      double speed = 1.0;
+      m_ctx.config.get("General", "Simulation Clock Speed", "1.0", speed);
+      if (speed > 0 && speed != 1.0)
+      {
+        Time::Clock::setSpeed(speed);
+        war(DTR("clock running at %0.1fx real time"), speed);
+      }
+    }
+
+    {
+      std::vector<std::string> origins;
+      double period = 1.0;
+      m_ctx.config.get("General", "Trace Origins", "", origins);
+      m_ctx.config.get("General", "Trace Period", "1.0", period);
+      m_ctx.tracer.configure(origins, period);
+      if (m_ctx.tracer.isEnabled())
+        war(DTR("tracing %u message types every %0.1f s"), (unsigned)origins.size(), period);
+    }
+
+    {
+      bool lock_stats = false;
+      m_ctx.config.get("General", "Lock Statistics", "false", lock_stats);
+      Concurrency::Contention::setEnabled(lock_stats);
+    }
+
     m_tman = new DUNE::Tasks::Manager(m_ctx);
 
     bind<IMC::RestartSystem>(this);
     bind<IMC::EntityList>(this);
     bind<IMC::SaveEntityParameters>(this);
     bind<IMC::EntityParameters>(this);
+    bind<IMC::TaskControl>(this);
   }
 
   Daemon::~Daemon(void)
@@ -146,6 +179,10 @@ namespace DUNE
     m_ctx.mbus.resume();
     m_tman->start();
     m_periodic_counter.setTop(1.0);
+
+    double stats_period = 0;
+    m_ctx.config.get("General", "Mailbox Statistics Period", "10.0", stats_period);
+    m_stats_counter.setTop(stats_period);
     setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
   }
 
@@ -186,6 +223,72 @@ namespace DUNE
     dispatch(query);
   }
 
+  std::string
+  Daemon::controlTasks(const IMC::TaskControl* msg)
+  {
+    switch (msg->op)
+    {
+      case IMC::TaskControl::TC_START:
+        m_tman->add(msg->name);
+        return DTR("started");
+
+      case IMC::TaskControl::TC_STOP:
+        m_tman->remove(msg->name);
+        return DTR("stopped");
+
+      case IMC::TaskControl::TC_RESTART:
+        m_tman->restart(msg->name);
+        return DTR("restarted");
+
+      case IMC::TaskControl::TC_LOAD:
+        {
+          // Only files below the configuration folder can be loaded.
+          if (msg->name.empty() || msg->name.find("..") != std::string::npos)
+            throw std::runtime_error(DTR("invalid configuration file"));
+
+          FileSystem::Path path = m_ctx.dir_cfg / msg->name;
+          if (!path.isFile())
+            throw std::runtime_error(DTR("configuration file not found"));
+
+          unsigned count = m_tman->reload(path.str());
+          return Utils::String::str(DTR("%u tasks updated"), count);
+        }
+
+      default:
+        throw std::runtime_error(DTR("invalid operation"));
+    }
+  }
+
+  void
+  Daemon::consume(const IMC::TaskControl* msg)
+  {
+    if (msg->getDestination() != getSystemId())
+      return;
+
+    if (msg->op == IMC::TaskControl::TC_SUCCESS || msg->op == IMC::TaskControl::TC_FAILURE)
+      return;
+
+    IMC::TaskControl reply;
+    reply.name = msg->name;
+
+    double start = Time::Clock::get();
+
+    try
+    {
+      reply.info = controlTasks(msg);
+      reply.op = IMC::TaskControl::TC_SUCCESS;
+      inf(DTR("%s: %s in %0.3f s"), msg->name.c_str(), reply.info.c_str(), Time::Clock::get() - start);
+    }
+    catch (std::exception& e)
+    {
+      reply.info = e.what();
+      reply.op = IMC::TaskControl::TC_FAILURE;
+      err(DTR("%s: %s"), msg->name.c_str(), e.what());
+    }
+
+    dispatchReply(*msg, reply);
+  }
+
   void
   Daemon::consume(const IMC::RestartSystem* msg)
   {
@@ -257,6 +360,14 @@ namespace DUNE
       }
     }
 
+    // Dispatch heap usage of tasks with private arenas.
+    IMC::HeapUsage heap_usage;
+    for (itr = m_tman->begin(); itr != m_tman->end(); ++itr)
+    {
+      if (itr->second->getHeapUsage(heap_usage))
+        dispatch(heap_usage);
+    }
+
     // Dispatch available storage.
     if (m_fs_capacity > 0)
     {
@@ -280,6 +391,56 @@ namespace DUNE
     dispatch(qpcs);
   }
 
+  void
+  Daemon::dispatchStatistics(void)
+  {
+    IMC::MailboxStatistics stats;
+
+    getMailboxStatistics(stats);
+    dispatch(stats);
+
+    std::map<std::string, Task*>::iterator itr = m_tman->begin();
+    for ( ; itr != m_tman->end(); ++itr)
+    {
+      itr->second->getMailboxStatistics(stats);
+      stats.setSourceEntity(itr->second->getEntityId());
+      dispatch(stats);
+    }
+
+    if (Concurrency::Contention::isEnabled())
+      reportContention();
+  }
+
+  //! Compare lock counters by decreasing time spent blocked.
+  static bool
+  compareWait(const Concurrency::Contention::Sample& a, const Concurrency::Contention::Sample& b)
+  {
+    return a.wait > b.wait;
+  }
+
+  void
+  Daemon::reportContention(void)
+  {
+    std::vector<Concurrency::Contention::Sample> samples;
+    Concurrency::Contention::collect(samples);
+
+    std::vector<Concurrency::Contention::Sample> delta = samples;
+    Concurrency::Contention::subtract(delta, m_locks);
+    m_locks = samples;
+
+    std::sort(delta.begin(), delta.end(), compareWait);
+
+    for (unsigned i = 0; i < delta.size() && i < c_hot_locks; ++i)
+    {
+      if (delta[i].contentions == 0)
+        break;
+
+      debug("lock '%s': %lu acquisitions, %lu after spinning, %lu blocked for %0.3f ms",
+            delta[i].name.c_str(), delta[i].acquisitions, delta[i].spins,
+            delta[i].contentions, delta[i].wait / 1000.0);
+    }
+  }
+
   void
   Daemon::onMain(void)
   {
@@ -292,6 +453,12 @@ namespace DUNE
         m_periodic_counter.reset();
         dispatchPeriodic();
       }
+
+      if (m_stats_counter.getTop() > 0 && m_stats_counter.overflow())
+      {
+        m_stats_counter.reset();
+        dispatchStatistics();
+      }
     }
   }
 }
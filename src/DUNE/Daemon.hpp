@@ -30,9 +30,11 @@
 
 // ISO C++ 98 headers.
 #include <string>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Contention.hpp>
 #include <DUNE/Tasks/Periodic.hpp>
 #include <DUNE/IMC/Definitions.hpp>
 #include <DUNE/System/Resources.hpp>
@@ -68,6 +70,9 @@ namespace DUNE
     void
     consume(const DUNE::IMC::SaveEntityParameters* msg);
 
+    void
+    consume(const DUNE::IMC::TaskControl* msg);
+
     void
     onMain(void);
 
@@ -83,13 +88,28 @@ namespace DUNE
     uint64_t m_fs_capacity;
     //! Periodic counter.
     Time::Counter<double> m_periodic_counter;
+    Time::Counter<double> m_stats_counter;
     //! Save configuration file name.
     std::string m_scfg_file;
     //! Saved configuration parameters.
     Parsers::Config m_scfg;
+    //! Lock counters of the last statistics report.
+    std::vector<Concurrency::Contention::Sample> m_locks;
 
     void
     dispatchPeriodic(void);
+
+    void
+    dispatchStatistics(void);
+
+    void
+    reportContention(void);
+
+    //! Carry out a task control request.
+    //! @param[in] msg request.
+    //! @return description of the result.
+    std::string
+    controlTasks(const IMC::TaskControl* msg);
   };
 }
 
@@ -38,4 +38,5 @@ namespace DUNE
 #include <DUNE/Database/General.hpp>
 #include <DUNE/Database/Connection.hpp>
 #include <DUNE/Database/Statement.hpp>
+#include <DUNE/Database/Transaction.hpp>
 #endif
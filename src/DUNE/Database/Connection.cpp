@@ -27,11 +27,16 @@
 
 // ISO C++ 98 headers.
 #include <iostream>
+#include <sstream>
 
 // DUNE headers.
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
 #include <DUNE/Database/General.hpp>
 #include <DUNE/Database/Connection.hpp>
 #include <DUNE/Database/Statement.hpp>
+#include <DUNE/Utils/String.hpp>
 
 // SQLITE3 headers.
 #include <sqlite3/sqlite3.h>
@@ -40,11 +45,109 @@ namespace DUNE
 {
   namespace Database
   {
+    //! Thread that periodically checkpoints the write-ahead log of
+    //! a database through a private connection, so that writers do
+    //! not pay for checkpoints when committing.
+    class Checkpointer: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param path database file.
+      //! @param period checkpoint period in seconds.
+      Checkpointer(const char* path, double period):
+        m_handle(0),
+        m_period(period)
+      {
+        int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_PRIVATECACHE;
+        if (sqlite3_open_v2(path, &m_handle, flags, 0) != SQLITE_OK)
+        {
+          Error e(sqlite3_errmsg(m_handle));
+          sqlite3_close(m_handle);
+          throw e;
+        }
+      }
+
+      //! Destructor.
+      ~Checkpointer(void)
+      {
+        sqlite3_close(m_handle);
+      }
+
+      //! Stop the thread and wait for it to finish.
+      void
+      shutdown(void)
+      {
+        stop();
+        {
+          Concurrency::ScopedCondition l(m_cond);
+          m_cond.signal();
+        }
+        join();
+      }
+
+    private:
+      //! Private database connection handle.
+      DB_HANDLE* m_handle;
+      //! Checkpoint period.
+      double m_period;
+      //! Condition used to interrupt waits.
+      Concurrency::Condition m_cond;
+
+      void
+      run(void)
+      {
+        while (!isStopping())
+        {
+          {
+            Concurrency::ScopedCondition l(m_cond);
+            if (isStopping())
+              break;
+            m_cond.wait(m_period);
+          }
+
+          // Busy readers or writers only make the checkpoint partial.
+          sqlite3_wal_checkpoint_v2(m_handle, 0, SQLITE_CHECKPOINT_PASSIVE, 0, 0);
+        }
+      }
+    };
+
     const char*
     Connection::c_memory_db = ":memory:";
 
     Connection::Connection(const char* path, bool create):
-      m_handle(0)
+      m_handle(0),
+      m_checkpointer(0)
+    {
+      open(path, create, Options());
+    }
+
+    Connection::Connection(const char* path, bool create, const Options& options):
+      m_handle(0),
+      m_checkpointer(0)
+    {
+      open(path, create, options);
+    }
+
+    Connection::~Connection(void)
+    {
+      if (m_checkpointer)
+      {
+        m_checkpointer->shutdown();
+        delete m_checkpointer;
+      }
+
+      if (m_handle)
+      {
+        clearStatements();
+        delete m_tbegin_stmt;
+        delete m_tcommit_stmt;
+        delete m_trollback_stmt;
+        sqlite3_close(m_handle);
+      }
+    }
+
+    void
+    Connection::open(const char* path, bool create, const Options& options)
     {
       sqlite3_enable_shared_cache(1);
 
@@ -59,22 +162,47 @@ namespace DUNE
         throw e;
       }
 
-      m_tbegin_stmt = new Statement("begin transaction", *this);
-      m_tcommit_stmt = new Statement("commit", *this);
-      m_trollback_stmt = new Statement("rollback", *this);
-    }
+      m_cache_capacity = options.statement_cache;
 
-    Connection::~Connection(void)
-    {
-      if (m_handle)
+      try
+      {
+        if (!options.journal_mode.empty())
+          execute(("pragma journal_mode=" + options.journal_mode).c_str());
+
+        if (!options.synchronous.empty())
+          execute(("pragma synchronous=" + options.synchronous).c_str());
+
+        if (options.mmap_size >= 0)
+        {
+          std::ostringstream os;
+          os << "pragma mmap_size=" << options.mmap_size;
+          execute(os.str().c_str());
+        }
+      }
+      catch (...)
       {
-        delete m_tbegin_stmt;
-        delete m_tcommit_stmt;
-        delete m_trollback_stmt;
         sqlite3_close(m_handle);
+        m_handle = 0;
+        throw;
       }
-    }
 
+      m_tbegin_stmt = new Statement("begin transaction", *this);
+      m_tcommit_stmt = new Statement("commit", *this);
+      m_trollback_stmt = new Statement("rollback", *this);
+
+      // Background checkpoints need a file in WAL mode.
+      if (options.checkpoint_period <= 0 || std::string(path) == c_memory_db)
+        return;
+
+      std::string mode = options.journal_mode;
+      Utils::String::toLowerCase(mode);
+      if (mode != "wal")
+        return;
+
+      sqlite3_wal_autocheckpoint(m_handle, 0);
+      m_checkpointer = new Checkpointer(path, options.checkpoint_period);
+      m_checkpointer->start();
+    }
     void
     Connection::execute(const char* sql_stmt, int* count)
     {
@@ -114,5 +242,59 @@ namespace DUNE
     {
       m_trollback_stmt->execute();
     }
+
+    bool
+    Connection::inTransaction(void)
+    {
+      return sqlite3_get_autocommit(m_handle) == 0;
+    }
+
+    Statement&
+    Connection::prepare(const char* sql_stmt)
+    {
+      std::string sql(sql_stmt);
+      std::map<std::string, CachedStatement>::iterator itr = m_cache.find(sql);
+
+      if (itr != m_cache.end())
+      {
+        m_cache_uses.splice(m_cache_uses.begin(), m_cache_uses, itr->second.use);
+        itr->second.stmt->reset();
+        return *itr->second.stmt;
+      }
+
+      CachedStatement entry;
+      entry.stmt = new Statement(sql_stmt, *this);
+
+      if (m_cache_capacity > 0 && m_cache.size() >= m_cache_capacity)
+      {
+        std::map<std::string, CachedStatement>::iterator lru = m_cache.find(m_cache_uses.back());
+        delete lru->second.stmt;
+        m_cache.erase(lru);
+        m_cache_uses.pop_back();
+      }
+
+      m_cache_uses.push_front(sql);
+      entry.use = m_cache_uses.begin();
+      m_cache[sql] = entry;
+      return *entry.stmt;
+    }
+
+    void
+    Connection::clearStatements(void)
+    {
+      std::map<std::string, CachedStatement>::iterator itr = m_cache.begin();
+      for (; itr != m_cache.end(); ++itr)
+        delete itr->second.stmt;
+
+      m_cache.clear();
+      m_cache_uses.clear();
+    }
+
+    void
+    Connection::checkpoint(void)
+    {
+      if (sqlite3_wal_checkpoint_v2(m_handle, 0, SQLITE_CHECKPOINT_PASSIVE, 0, 0) != SQLITE_OK)
+        throw Error(lastError());
+    }
   }
 }
@@ -28,6 +28,11 @@
 #ifndef DUNE_DATABASE_CONNECTION_HPP_INCLUDED_
 #define DUNE_DATABASE_CONNECTION_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <list>
+#include <map>
+#include <string>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -42,6 +47,7 @@ namespace DUNE
 
     // Forward declaration.
     class Statement;
+    class Checkpointer;
 
     // Export DLL Symbol.
     class DUNE_DLL_SYM Connection;
@@ -53,11 +59,42 @@ namespace DUNE
       //! Identifier to use for temporary, memory-only based databases.
       static const char* c_memory_db;
 
+      //! Connection options.
+      struct Options
+      {
+        //! Journal mode (e.g., "WAL"), empty to keep the default.
+        std::string journal_mode;
+        //! Synchronous mode (e.g., "NORMAL"), empty to keep the default.
+        std::string synchronous;
+        //! Maximum size of memory-mapped I/O in bytes, negative
+        //! to keep the default.
+        int64_t mmap_size;
+        //! Maximum number of statements kept by prepare(), zero
+        //! for no limit.
+        unsigned statement_cache;
+        //! Period of background checkpoints in WAL mode, in
+        //! seconds. When positive, commits no longer checkpoint the
+        //! log themselves. Zero disables background checkpoints.
+        double checkpoint_period;
+
+        Options(void):
+          mmap_size(-1),
+          statement_cache(32),
+          checkpoint_period(0)
+        { }
+      };
+
       //! Constructor.
       //! @param path database file
       //! @param create create database if it does not exist
       Connection(const char* path, bool create = false);
 
+      //! Constructor.
+      //! @param path database file
+      //! @param create create database if it does not exist
+      //! @param options connection options.
+      Connection(const char* path, bool create, const Options& options);
+
       //! Destructor.
       ~Connection();
 
@@ -81,6 +118,30 @@ namespace DUNE
       void
       rollback(void);
 
+      //! Check if a transaction is open.
+      //! @return true if a transaction is open, false otherwise.
+      bool
+      inTransaction(void);
+
+      //! Retrieve a prepared statement, reset and ready to be
+      //! bound. Statements are cached by SQL text, so preparing the
+      //! same SQL again is a lookup. The statement is owned by the
+      //! connection and remains valid until more than the cache
+      //! capacity of other statements have been prepared.
+      //! @param sql_stmt SQL statement.
+      //! @return prepared statement.
+      Statement&
+      prepare(const char* sql_stmt);
+
+      //! Discard all cached statements.
+      void
+      clearStatements(void);
+
+      //! Copy the write-ahead log into the database, without waiting
+      //! for readers or writers (WAL mode only).
+      void
+      checkpoint(void);
+
       //! Get description of last error.
       //! @return description of last database error.
       const char*
@@ -95,11 +156,32 @@ namespace DUNE
       }
 
     private:
+      //! Cached statement.
+      struct CachedStatement
+      {
+        //! Statement.
+        Statement* stmt;
+        //! Position in the usage list.
+        std::list<std::string>::iterator use;
+      };
+
       //! Database connection handle.
       DB_HANDLE* m_handle;
       Statement* m_tbegin_stmt;
       Statement* m_tcommit_stmt;
       Statement* m_trollback_stmt;
+      //! Maximum number of cached statements.
+      unsigned m_cache_capacity;
+      //! Cached statements by SQL text.
+      std::map<std::string, CachedStatement> m_cache;
+      //! SQL text of cached statements, most recently used first.
+      std::list<std::string> m_cache_uses;
+      //! Background checkpoint thread.
+      Checkpointer* m_checkpointer;
+
+      //! Open the database and apply connection options.
+      void
+      open(const char* path, bool create, const Options& options);
     };
   }
 }
@@ -0,0 +1,98 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Database/Transaction.hpp>
+
+namespace DUNE
+{
+  namespace Database
+  {
+    Transaction::Transaction(Connection& conn, unsigned batch_size):
+      m_conn(conn),
+      m_batch_size(batch_size),
+      m_pending(0),
+      m_open(false)
+    {
+      m_conn.beginTransaction();
+      m_open = true;
+    }
+
+    Transaction::~Transaction(void)
+    {
+      if (!m_open)
+        return;
+
+      try
+      {
+        if (m_conn.inTransaction())
+          m_conn.rollback();
+      }
+      catch (...)
+      { }
+    }
+
+    bool
+    Transaction::step(void)
+    {
+      ++m_pending;
+
+      if (m_batch_size == 0 || m_pending < m_batch_size)
+        return false;
+
+      commit();
+      m_conn.beginTransaction();
+      m_open = true;
+      return true;
+    }
+
+    void
+    Transaction::commit(void)
+    {
+      if (!m_open)
+        return;
+
+      m_conn.commit();
+      m_open = false;
+      m_pending = 0;
+    }
+
+    void
+    Transaction::rollback(void)
+    {
+      if (!m_open)
+        return;
+
+      m_open = false;
+      m_pending = 0;
+
+      // Some errors roll the transaction back by themselves.
+      if (m_conn.inTransaction())
+        m_conn.rollback();
+    }
+  }
+}
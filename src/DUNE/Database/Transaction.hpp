@@ -0,0 +1,108 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_DATABASE_TRANSACTION_HPP_INCLUDED_
+#define DUNE_DATABASE_TRANSACTION_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Database/Connection.hpp>
+
+namespace DUNE
+{
+  namespace Database
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Transaction;
+
+    //! Scoped transaction. The transaction is opened on construction
+    //! and rolled back on destruction unless it was committed, so
+    //! changes are undone when an exception leaves the scope.
+    //!
+    //! Long sequences of changes can be split into batches: with a
+    //! batch size set, every batch size calls to step() commit the
+    //! changes made so far and open a new transaction.
+    class Transaction
+    {
+    public:
+      //! Constructor.
+      //! @param conn database connection.
+      //! @param batch_size number of changes committed together by
+      //! step(), zero to commit only with commit().
+      Transaction(Connection& conn, unsigned batch_size = 0);
+
+      //! Destructor. Rolls back uncommitted changes.
+      ~Transaction(void);
+
+      //! Record a change, committing the open batch if it is full.
+      //! @return true if a batch was committed, false otherwise.
+      bool
+      step(void);
+
+      //! Commit all changes. The transaction is closed afterwards.
+      void
+      commit(void);
+
+      //! Roll back the changes made since the last commit. The
+      //! transaction is closed afterwards.
+      void
+      rollback(void);
+
+      //! Check if the transaction is open.
+      //! @return true if the transaction is open, false otherwise.
+      bool
+      isOpen(void) const
+      {
+        return m_open;
+      }
+
+      //! Get the number of changes not yet committed.
+      //! @return number of changes.
+      unsigned
+      getPending(void) const
+      {
+        return m_pending;
+      }
+
+    private:
+      //! Database connection.
+      Connection& m_conn;
+      //! Number of changes committed together.
+      unsigned m_batch_size;
+      //! Number of changes not yet committed.
+      unsigned m_pending;
+      //! True if the transaction is open.
+      bool m_open;
+
+      // Non-copyable.
+      Transaction(const Transaction&);
+      Transaction& operator=(const Transaction&);
+    };
+  }
+}
+
+#endif
@@ -37,6 +37,7 @@ namespace DUNE
 
 #include <DUNE/FileSystem/Path.hpp>
 #include <DUNE/FileSystem/Directory.hpp>
+#include <DUNE/FileSystem/DirectoryIndex.hpp>
 #include <DUNE/FileSystem/FileLock.hpp>
 #include <DUNE/FileSystem/Exceptions.hpp>
 
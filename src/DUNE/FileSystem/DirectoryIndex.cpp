@@ -0,0 +1,333 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/FileSystem/Directory.hpp>
+#include <DUNE/FileSystem/DirectoryIndex.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SYS_STAT_H)
+#  include <sys/stat.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+// Linux headers.
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+#  include <sys/inotify.h>
+#endif
+
+namespace DUNE
+{
+  namespace FileSystem
+  {
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+    //! Events that change a listing.
+    static const uint32_t c_watch_mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB
+    | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+#endif
+
+    DirectoryIndex::DirectoryIndex(void):
+      m_fd(-1),
+      m_uses(0)
+    {
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+      m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    }
+
+    DirectoryIndex::~DirectoryIndex(void)
+    {
+      clear();
+
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+      if (m_fd >= 0)
+        close(m_fd);
+#endif
+    }
+
+    DirectoryIndex&
+    DirectoryIndex::getShared(void)
+    {
+      static DirectoryIndex s_index;
+      return s_index;
+    }
+
+    bool
+    DirectoryIndex::isCaching(void) const
+    {
+      return m_fd >= 0;
+    }
+
+    bool
+    DirectoryIndex::stat(const Path& path, Entry& entry)
+    {
+      entry.name = path.basename().str();
+      entry.size = 0;
+      entry.mtime = 0;
+
+      // POSIX implementation: one system call per entry.
+#if defined(DUNE_SYS_HAS_LSTAT)
+      struct stat ss;
+      if (lstat(path.c_str(), &ss) != 0)
+        return false;
+
+      if (S_ISDIR(ss.st_mode))
+        entry.type = Path::PT_DIRECTORY;
+      else if (S_ISREG(ss.st_mode))
+        entry.type = Path::PT_FILE;
+      else if (S_ISCHR(ss.st_mode) || S_ISBLK(ss.st_mode))
+        entry.type = Path::PT_DEVICE;
+#  if defined(S_ISLNK)
+      else if (S_ISLNK(ss.st_mode))
+        entry.type = Path::PT_LINK;
+#  endif
+      else
+        entry.type = Path::PT_INVALID;
+
+      if (entry.type == Path::PT_FILE)
+        entry.size = ss.st_size;
+
+      entry.mtime = ss.st_mtime;
+      return true;
+#else
+      try
+      {
+        entry.type = path.type();
+      }
+      catch (...)
+      {
+        return false;
+      }
+
+      if (entry.type == Path::PT_INVALID)
+        return false;
+
+      if (entry.type == Path::PT_FILE)
+        entry.size = path.size();
+
+      entry.mtime = path.getLastModifiedTime();
+      return true;
+#endif
+    }
+
+    bool
+    DirectoryIndex::scan(const Path& dir, Listing& listing)
+    {
+      listing.entries.clear();
+
+      // Throws if the directory cannot be opened.
+      Directory handle(dir);
+
+      const char* name = NULL;
+      while ((name = handle.readEntry(Directory::RD_FULL_NAME)))
+      {
+        Entry entry;
+        if (stat(name, entry))
+          listing.entries[entry.name] = entry;
+      }
+
+      return true;
+    }
+
+    bool
+    DirectoryIndex::list(const Path& dir, std::vector<Entry>& entries)
+    {
+      entries.clear();
+
+      Concurrency::ScopedMutex l(m_lock);
+
+      processEvents();
+
+      std::map<std::string, Listing*>::iterator itr = m_listings.find(dir.str());
+      Listing* listing = NULL;
+
+      if (itr != m_listings.end())
+      {
+        listing = itr->second;
+      }
+      else
+      {
+        Listing scratch;
+
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+        // Watch before scanning so that no change is missed.
+        scratch.watch = (m_fd >= 0) ? inotify_add_watch(m_fd, dir.c_str(), c_watch_mask) : -1;
+#else
+        scratch.watch = -1;
+#endif
+
+        bool ok = false;
+        try
+        {
+          ok = scan(dir, scratch);
+        }
+        catch (...)
+        { }
+
+        if (!ok || scratch.watch < 0)
+        {
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+          if (scratch.watch >= 0 && m_watches.find(scratch.watch) == m_watches.end())
+            inotify_rm_watch(m_fd, scratch.watch);
+#endif
+          if (!ok)
+            return false;
+
+          // Not cached.
+          std::map<std::string, Entry>::const_iterator e = scratch.entries.begin();
+          for (; e != scratch.entries.end(); ++e)
+            entries.push_back(e->second);
+          return true;
+        }
+
+        // The same directory may be reachable through other paths.
+        std::map<int, Listing*>::iterator w = m_watches.find(scratch.watch);
+        if (w != m_watches.end())
+          drop(w->second);
+
+        if (m_listings.size() >= c_max_listings)
+          evict();
+
+        listing = new Listing;
+        listing->path = dir.str();
+        listing->watch = scratch.watch;
+        listing->entries.swap(scratch.entries);
+        m_listings[listing->path] = listing;
+        m_watches[listing->watch] = listing;
+      }
+
+      listing->used = ++m_uses;
+
+      entries.reserve(listing->entries.size());
+      std::map<std::string, Entry>::const_iterator e = listing->entries.begin();
+      for (; e != listing->entries.end(); ++e)
+        entries.push_back(e->second);
+
+      return true;
+    }
+
+    void
+    DirectoryIndex::clear(void)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+
+      while (!m_listings.empty())
+        drop(m_listings.begin()->second);
+    }
+
+    void
+    DirectoryIndex::drop(Listing* listing, bool unwatch)
+    {
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+      if (unwatch && listing->watch >= 0)
+        inotify_rm_watch(m_fd, listing->watch);
+#else
+      (void)unwatch;
+#endif
+
+      m_watches.erase(listing->watch);
+      m_listings.erase(listing->path);
+      delete listing;
+    }
+
+    void
+    DirectoryIndex::evict(void)
+    {
+      Listing* oldest = NULL;
+      std::map<std::string, Listing*>::iterator itr = m_listings.begin();
+      for (; itr != m_listings.end(); ++itr)
+      {
+        if (oldest == NULL || itr->second->used < oldest->used)
+          oldest = itr->second;
+      }
+
+      if (oldest != NULL)
+        drop(oldest);
+    }
+
+    void
+    DirectoryIndex::processEvents(void)
+    {
+#if defined(DUNE_SYS_HAS_SYS_INOTIFY_H)
+      if (m_fd < 0)
+        return;
+
+      char bfr[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+      while (true)
+      {
+        ssize_t rv = read(m_fd, bfr, sizeof(bfr));
+        if (rv <= 0)
+          break;
+
+        for (char* ptr = bfr; ptr < bfr + rv; )
+        {
+          const struct inotify_event* evt = (const struct inotify_event*)ptr;
+          ptr += sizeof(struct inotify_event) + evt->len;
+
+          // Events were lost: nothing cached can be trusted.
+          if (evt->mask & IN_Q_OVERFLOW)
+          {
+            while (!m_listings.empty())
+              drop(m_listings.begin()->second);
+            continue;
+          }
+
+          std::map<int, Listing*>::iterator w = m_watches.find(evt->wd);
+          if (w == m_watches.end())
+            continue;
+
+          Listing* listing = w->second;
+
+          if (evt->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+          {
+            // The kernel already removed the watch if it was ignored.
+            drop(listing, (evt->mask & IN_IGNORED) == 0);
+            continue;
+          }
+
+          if (evt->len == 0)
+            continue;
+
+          // Update the named entry only.
+          std::string name(evt->name);
+          Entry entry;
+          if (stat(Path(listing->path) / name, entry))
+            listing->entries[name] = entry;
+          else
+            listing->entries.erase(name);
+        }
+      }
+#endif
+    }
+  }
+}
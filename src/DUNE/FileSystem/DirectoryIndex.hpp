@@ -0,0 +1,163 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_FILE_SYSTEM_DIRECTORY_INDEX_HPP_INCLUDED_
+#define DUNE_FILE_SYSTEM_DIRECTORY_INDEX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/FileSystem/Path.hpp>
+
+namespace DUNE
+{
+  namespace FileSystem
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DirectoryIndex;
+
+    //! Cache of directory listings with the type, size and
+    //! modification time of every entry. Where the system provides
+    //! change notifications (inotify), cached listings are watched
+    //! and updated entry by entry as files are created, modified or
+    //! removed, so listing a large directory again costs no system
+    //! calls. Elsewhere every listing rescans the directory.
+    class DirectoryIndex
+    {
+    public:
+      //! Directory entry.
+      struct Entry
+      {
+        //! File name.
+        std::string name;
+        //! Entry type.
+        Path::Type type;
+        //! Size of regular files in bytes.
+        int64_t size;
+        //! Last modification time.
+        std::time_t mtime;
+      };
+
+      //! Maximum number of cached listings.
+      static const unsigned c_max_listings = 256;
+
+      //! Constructor.
+      DirectoryIndex(void);
+
+      //! Destructor.
+      ~DirectoryIndex(void);
+
+      //! Retrieve the index shared by all tasks.
+      //! @return shared index.
+      static DirectoryIndex&
+      getShared(void);
+
+      //! List the entries of a directory, sorted by name.
+      //! @param[in] dir directory.
+      //! @param[out] entries entries.
+      //! @return true if the directory was listed, false if it is
+      //! not a readable directory.
+      bool
+      list(const Path& dir, std::vector<Entry>& entries);
+
+      //! Check if listings are cached and kept up to date.
+      //! @return true if listings are cached, false otherwise.
+      bool
+      isCaching(void) const;
+
+      //! Discard all cached listings.
+      void
+      clear(void);
+
+      //! Retrieve information about a single file.
+      //! @param[in] path file path.
+      //! @param[out] entry file information.
+      //! @return true if the file exists, false otherwise.
+      static bool
+      stat(const Path& path, Entry& entry);
+
+    private:
+      //! Cached listing.
+      struct Listing
+      {
+        //! Directory path.
+        std::string path;
+        //! Change notification watch descriptor.
+        int watch;
+        //! Sequence number of the last use.
+        unsigned long used;
+        //! Entries by name.
+        std::map<std::string, Entry> entries;
+      };
+
+      //! Cached listings by directory.
+      std::map<std::string, Listing*> m_listings;
+      //! Cached listings by watch descriptor.
+      std::map<int, Listing*> m_watches;
+      //! Change notification handle (-1 if unavailable).
+      int m_fd;
+      //! Sequence number of listing uses.
+      unsigned long m_uses;
+      //! Lock.
+      Concurrency::Mutex m_lock;
+
+      //! Apply pending change notifications to the cached listings.
+      void
+      processEvents(void);
+
+      //! Scan a directory.
+      //! @param[in] dir directory.
+      //! @param[out] listing listing.
+      //! @return true on success, false otherwise.
+      static bool
+      scan(const Path& dir, Listing& listing);
+
+      //! Stop caching a listing.
+      //! @param[in] listing listing.
+      //! @param[in] unwatch true to remove the change notification
+      //! watch of the listing.
+      void
+      drop(Listing* listing, bool unwatch = true);
+
+      //! Drop the least recently used listing.
+      void
+      evict(void);
+
+      // Non-copyable.
+      DirectoryIndex(const DirectoryIndex&);
+      DirectoryIndex& operator=(const DirectoryIndex&);
+    };
+  }
+}
+
+#endif
@@ -25,6 +25,9 @@
 // Author: Ricardo Martins                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Time/Delay.hpp>
@@ -45,16 +48,19 @@ namespace DUNE
     static std::string c_line_term_in = "\r\n";
     //! Default output line termination.
     static std::string c_line_term_out = "\r\n";
+    //! Capacity of the raw input buffer.
+    static const uint32_t c_raw_capacity = 64 * 1024;
 
     BasicModem::BasicModem(Tasks::Task* task, IO::Handle* handle):
       m_handle(handle),
       m_task(task),
       m_timeout(c_timeout),
+      m_line_scan(0),
+      m_bytes(c_raw_capacity),
       m_read_mode(READ_MODE_LINE),
       m_busy(false),
       m_tx_rate_max(-1.0),
       m_line_term_in(c_line_term_in),
-      m_line_term_idx(0),
       m_line_term_out(c_line_term_out),
       m_line_trim(false)
     {
@@ -80,7 +86,6 @@ namespace DUNE
     {
       Concurrency::ScopedMutex l(m_mutex);
       m_line_term_in = term;
-      m_line_term_idx = 0;
     }
 
     const std::string&
@@ -218,87 +223,91 @@ namespace DUNE
     {
       unsigned bytes_read = 0;
 
-      while (!timer.overflow())
+      while (true)
       {
-        if (m_bytes.waitForItems(timer.getRemaining()))
-          data[bytes_read++] = m_bytes.pop();
-
+        bytes_read += m_bytes.get(data + bytes_read, data_size - bytes_read);
         if (bytes_read == data_size)
           return;
+
+        double remaining = timer.getRemaining();
+        if (remaining <= 0)
+          break;
+
+        m_bytes_cond.lock();
+        if (m_bytes.size() == 0)
+          m_bytes_cond.wait(remaining);
+        m_bytes_cond.unlock();
       }
 
       throw ReadTimeout();
     }
 
-    bool
-    BasicModem::processInput(std::string& str)
+    void
+    BasicModem::pushRaw(const uint8_t* data, size_t data_size)
     {
-      bool got_line = false;
-
-      while (!m_chars.empty())
-      {
-        char c = m_chars.front();
-        m_chars.pop();
-
-          m_line.push_back(c);
+      uint32_t rv = m_bytes.put(data, data_size);
+      if (rv < data_size)
+        m_task->war(DTR("raw input overflow, dropped %u bytes"), (unsigned)(data_size - rv));
 
-        //!@fixme: concurrency hazard.
-        if (c == m_line_term_in[m_line_term_idx])
-        {
-          ++m_line_term_idx;
-          if (m_line_term_idx == m_line_term_in.size())
-          {
-            m_line_term_idx = 0;
-            got_line = true;
-            break;
-          }
-        }
-        else
-        {
+      m_bytes_cond.lock();
+      m_bytes_cond.signal();
+      m_bytes_cond.unlock();
+    }
 
-        }
+    void
+    BasicModem::processInput(void)
+    {
+      std::string term;
+      bool trim;
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+        term = m_line_term_in;
+        trim = m_line_trim;
       }
 
-      if (isFragment(m_line))
+      while (true)
       {
-        getTask()->inf(DTR("fragment: %s"), Streams::sanitize(m_line).c_str());
-        return false;
-      }
+        size_t pos = m_line.find(term, m_line_scan);
+        if (pos == std::string::npos)
+        {
+          // A terminator may start in the last bytes.
+          if (m_line.size() >= term.size())
+            m_line_scan = std::max(m_line_scan, m_line.size() - term.size() + 1);
+          return;
+        }
 
-      // No complete line is available.
-      if (!got_line)
-        return false;
+        size_t end = pos + term.size();
 
-      if (m_line.size() <= m_line_term_in.size())
-      {
-        str = "";
-        return true;
-      }
+        // Terminators inside binary payloads do not end the line.
+        if (isFragment(m_line.substr(0, end)))
+        {
+          getTask()->inf(DTR("fragment: %s"), Streams::sanitize(m_line.substr(0, end)).c_str());
+          m_line_scan = end;
+          continue;
+        }
 
-      // Remove termination characters.
-      str = m_line;
-      str.resize(m_line.size() - m_line_term_in.size());
+        std::string str(m_line, 0, pos);
+        m_line.erase(0, end);
+        m_line_scan = 0;
 
-      if (m_line_trim)
-        str = Utils::String::trim(str);
+        if (trim)
+          str = Utils::String::trim(str);
 
-      // Got a complete line, but it's empty.
-      if (str.empty())
-        return true;
+        // Got a complete line, but it's empty.
+        if (str.empty())
+          continue;
 
-      m_task->spew("recv: %s", Streams::sanitize(str).c_str());
-      m_line.clear();
+        m_task->spew("recv: %s", Streams::sanitize(str).c_str());
 
-      if (!m_skip_line.empty())
-      {
-        if (m_skip_line == str)
+        if (!m_skip_line.empty() && m_skip_line == str)
         {
-          str.clear();
           m_skip_line.clear();
+          continue;
         }
-      }
 
-      return true;
+        if (!handleUnsolicited(str))
+          m_lines.push(str);
+      }
     }
 
     std::string
@@ -326,14 +335,13 @@ namespace DUNE
     BasicModem::run(void)
     {
       char bfr[512];
-      std::string line;
 
       while (!isStopping())
       {
         if (!IO::Poll::poll(*m_handle, 1.0))
           continue;
 
-        size_t rv = m_handle->read(bfr, sizeof(bfr));
+        size_t rv = m_handle->read(bfr, sizeof(bfr) - 1);
         if (rv == 0)
         {
           IMC::IoEvent iov;
@@ -347,30 +355,15 @@ namespace DUNE
 
         if (getReadMode() == READ_MODE_RAW)
         {
-          for (size_t i = 0; i < rv; ++i)
-            m_bytes.push(bfr[i]);
+          pushRaw((uint8_t*)bfr, rv);
         }
         else
         {
           bfr[rv] = 0;
           m_task->spew("%s", Streams::sanitize(bfr).c_str());
 
-          for (size_t i = 0; i < rv; ++i)
-          {
-            m_chars.push(bfr[i]);
-          }
-
-          while (!m_chars.empty())
-          {
-            if (!processInput(line))
-              continue;
-
-            if (line.empty())
-              continue;
-
-            if (!handleUnsolicited(line))
-              m_lines.push(line);
-          }
+          m_line.append(bfr, rv);
+          processInput();
         }
       }
     }
@@ -33,8 +33,10 @@
 
 // DUNE headers.
 #include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/Utils/RawFifo.hpp>
 #include <DUNE/IO/Handle.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Time/Counter.hpp>
@@ -185,14 +187,16 @@ namespace DUNE
       Tasks::Task* m_task;
       //! Read timeout.
       double m_timeout;
-      //! Queue of incoming characters.
-      std::queue<char> m_chars;
-      //! Current line being parsed.
+      //! Input not yet split into lines.
       std::string m_line;
+      //! Offset of m_line where the search for a terminator resumes.
+      size_t m_line_scan;
       //! Queue of input lines.
       Concurrency::TSQueue<std::string> m_lines;
-      //! Queue of raw input bytes.
-      Concurrency::TSQueue<uint8_t> m_bytes;
+      //! Raw input bytes (written by the reader thread only).
+      Utils::RawFifo m_bytes;
+      //! Signaled when raw input bytes are available.
+      Concurrency::Condition m_bytes_cond;
       //! Read mode.
       ReadMode m_read_mode;
       //! Contents of line to skip once.
@@ -205,15 +209,20 @@ namespace DUNE
       Time::Counter<double> m_tx_rate_timer;
       //! Input line termination.
       std::string m_line_term_in;
-      //! Line termination detector index.
-      size_t m_line_term_idx;
       //! Output line termination.
       std::string m_line_term_out;
       //! True to trim white-space.
       bool m_line_trim;
 
-      bool
-      processInput(std::string& str);
+      //! Split buffered input into lines and queue them.
+      void
+      processInput(void);
+
+      //! Queue raw input bytes.
+      //! @param[in] data bytes.
+      //! @param[in] data_size number of bytes.
+      void
+      pushRaw(const uint8_t* data, size_t data_size);
 
       void
       run(void);
@@ -59,7 +59,8 @@ namespace DUNE
   {
     Buttons::Buttons(const std::string& source_dev):
       m_changed(0),
-      m_values(0)
+      m_values(0),
+      m_tstamp(-1)
     {
 #if defined(DUNE_OS_LINUX)
       m_fd = open(source_dev.c_str(), O_RDONLY);
@@ -87,6 +88,7 @@ namespace DUNE
             uint8_t bit = (1 << (ev[i].code - BTN_0));
 
             m_changed |= bit;
+            m_tstamp = ev[i].time.tv_sec + ev[i].time.tv_usec / 1e6;
             if (ev[i].value == 0)
               m_values &= ~bit;
             else
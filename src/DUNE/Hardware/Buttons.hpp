@@ -72,6 +72,15 @@ namespace DUNE
         return ((1 << btn) & m_values) == (1u << btn);
       }
 
+      //! Get the time at which the kernel recorded the last button
+      //! state change.
+      //! @return time in seconds since the UNIX Epoch.
+      double
+      getTimeStamp(void)
+      {
+        return m_tstamp;
+      }
+
     private:
 #if defined(DUNE_OS_LINUX)
       int m_fd;
@@ -79,6 +88,7 @@ namespace DUNE
 
       uint8_t m_changed;
       uint8_t m_values;
+      double m_tstamp;
     };
   }
 }
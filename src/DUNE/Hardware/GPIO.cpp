@@ -32,8 +32,16 @@
 #include <DUNE/System/Error.hpp>
 #include <DUNE/Streams/Terminal.hpp>
 #include <DUNE/Utils/String.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Hardware/GPIO.hpp>
 
+// Linux headers.
+#if defined(DUNE_OS_LINUX)
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
 namespace DUNE
 {
   namespace Hardware
@@ -43,7 +51,9 @@ namespace DUNE
 
     GPIO::GPIO(unsigned int number):
       m_number(number),
-      m_direction(GPIO_DIR_INPUT)
+      m_direction(GPIO_DIR_INPUT),
+      m_edge_value(false),
+      m_edge_tstamp(-1)
     {
       // Linux 2.6 implementation.
 #if defined(DUNE_OS_LINUX)
@@ -53,6 +63,8 @@ namespace DUNE
                            String::str(m_number);
       m_file_val = prefix + std::string("/value");
       m_file_dir = prefix + std::string("/direction");
+      m_file_edge = prefix + std::string("/edge");
+      m_fd_val = -1;
 
       // Lacking implementation.
 #else
@@ -64,6 +76,9 @@ namespace DUNE
     {
       // Linux 2.6 implementation.
 #if defined(DUNE_OS_LINUX)
+      if (m_fd_val != -1)
+        ::close(m_fd_val);
+
       try
       {
         writeToFile("/sys/class/gpio/unexport", m_number);
@@ -136,6 +151,73 @@ namespace DUNE
       return false;
     }
 
+    void
+    GPIO::setEdge(Edge edge)
+    {
+      if (m_direction != GPIO_DIR_INPUT)
+        throw Error("GPIO is not configured as input", String::str(m_number));
+
+#if defined(DUNE_OS_LINUX)
+      static const char* c_edges[] = {"none", "rising", "falling", "both"};
+      writeToFile(m_file_edge, c_edges[edge]);
+
+      if (m_fd_val == -1)
+      {
+        m_fd_val = ::open(m_file_val.c_str(), O_RDONLY);
+        if (m_fd_val == -1)
+          throw Error(errno, "unable to open GPIO value");
+      }
+
+      // Consume the current state so that only new transitions wake
+      // waitForEdge().
+      char value = 0;
+      ::lseek(m_fd_val, 0, SEEK_SET);
+      if (::read(m_fd_val, &value, 1) == 1)
+        m_edge_value = (value == '1');
+#else
+      (void)edge;
+#endif
+    }
+
+    bool
+    GPIO::waitForEdge(double timeout)
+    {
+#if defined(DUNE_OS_LINUX)
+      if (m_fd_val == -1)
+        throw Error("GPIO has no edge configured", String::str(m_number));
+
+      pollfd pfd;
+      pfd.fd = m_fd_val;
+      pfd.events = POLLPRI | POLLERR;
+      pfd.revents = 0;
+
+      int msec = (timeout < 0.0) ? -1 : (int)(timeout * 1000.0);
+      int rv = ::poll(&pfd, 1, msec);
+      if (rv == -1)
+      {
+        if (errno == EINTR)
+          return false;
+        throw Error(errno, "unable to wait for GPIO edge");
+      }
+
+      if (rv == 0)
+        return false;
+
+      m_edge_tstamp = Time::Clock::getSinceEpoch();
+
+      char value = 0;
+      ::lseek(m_fd_val, 0, SEEK_SET);
+      if (::read(m_fd_val, &value, 1) != 1)
+        throw Error(errno, "unable to read GPIO value");
+      m_edge_value = (value == '1');
+
+      return true;
+#else
+      (void)timeout;
+      return false;
+#endif
+    }
+
 #if defined(DUNE_OS_LINUX)
     void
     GPIO::writeToFile(const std::string& file, int value)
@@ -52,6 +52,18 @@ namespace DUNE
         GPIO_DIR_OUTPUT
       };
 
+      enum Edge
+      {
+        //! No edge events.
+        GPIO_EDGE_NONE,
+        //! Events on low to high transitions.
+        GPIO_EDGE_RISING,
+        //! Events on high to low transitions.
+        GPIO_EDGE_FALLING,
+        //! Events on both transitions.
+        GPIO_EDGE_BOTH
+      };
+
       //! Initialize GPIO.
       //! @param[in] number GPIO number.
       GPIO(unsigned int number);
@@ -79,17 +91,54 @@ namespace DUNE
       bool
       getValue(void);
 
+      //! Select which transitions of an input GPIO generate events.
+      //! @param[in] edge transitions that generate events.
+      void
+      setEdge(Edge edge);
+
+      //! Wait for a transition selected with setEdge(). The calling
+      //! thread sleeps until the kernel signals the transition.
+      //! @param[in] timeout maximum amount of time to wait (negative
+      //! to wait forever).
+      //! @return true if a transition occurred, false on timeout.
+      bool
+      waitForEdge(double timeout);
+
+      //! Retrieve the pin value read after the last transition.
+      //! @return pin value (false = off, true = on).
+      bool
+      getEdgeValue(void) const
+      {
+        return m_edge_value;
+      }
+
+      //! Retrieve the time of the last transition.
+      //! @return time in seconds since the UNIX Epoch.
+      double
+      getEdgeTimeStamp(void) const
+      {
+        return m_edge_tstamp;
+      }
+
     private:
       //! GPIO number.
       unsigned int m_number;
       //! GPIO direction.
       Direction m_direction;
+      //! Pin value after the last transition.
+      bool m_edge_value;
+      //! Time of the last transition.
+      double m_edge_tstamp;
 
 #if defined(DUNE_OS_LINUX)
       //! Path to GPIO direction file.
       std::string m_file_dir;
       //! Path to GPIO value file.
       std::string m_file_val;
+      //! Path to GPIO edge file.
+      std::string m_file_edge;
+      //! Value file descriptor used to wait for transitions.
+      int m_fd_val;
 
       static void
       writeToFile(const std::string& file, int value);
@@ -27,10 +27,14 @@
 
 // ISO C++ 98 headers.
 #include <stdexcept>
+#include <algorithm>
+#include <map>
+#include <string>
 
 // DUNE headers.
 #include <DUNE/Exceptions.hpp>
 #include <DUNE/Hardware/I2C.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 
 // POSIX headers.
 #if defined(DUNE_SYS_HAS_SYS_TYPES_H)
@@ -62,11 +66,32 @@
 #  include <linux/i2c-dev.h>
 #endif
 
+#if !defined(I2C_RDWR_IOCTL_MAX_MSGS)
+#  define I2C_RDWR_IOCTL_MAX_MSGS 42
+#endif
+
 namespace DUNE
 {
   namespace Hardware
   {
-    I2C::I2C(const std::string& dev)
+    //! Retrieve the lock shared by all users of a bus.
+    //! @param dev bus device.
+    //! @return bus lock.
+    static Concurrency::Mutex*
+    getBusLock(const std::string& dev)
+    {
+      static Concurrency::Mutex s_mutex;
+      static std::map<std::string, Concurrency::Mutex*> s_locks;
+
+      Concurrency::ScopedMutex l(s_mutex);
+      Concurrency::Mutex*& lock = s_locks[dev];
+      if (lock == NULL)
+        lock = new Concurrency::Mutex;
+      return lock;
+    }
+
+    I2C::I2C(const std::string& dev):
+      m_bus_lock(getBusLock(dev))
     {
 #if defined(DUNE_SYS_HAS_LINUX_I2C_H)
       if ((m_fd = open(dev.c_str(), O_RDWR)) == -1)
@@ -153,6 +178,7 @@ namespace DUNE
         rdwr.nmsgs = 2;
       }
 
+      Concurrency::ScopedMutex l(*m_bus_lock);
       if (ioctl(m_fd, I2C_RDWR, &rdwr) < 0)
       {
         throw Error("I2C write error", strerror(errno));
@@ -208,6 +234,7 @@ namespace DUNE
       rdwr.msgs = &msg;
       rdwr.nmsgs = 1;
 
+      Concurrency::ScopedMutex l(*m_bus_lock);
       if (ioctl(m_fd, I2C_RDWR, &rdwr) < 0)
       {
         throw Error("I2C read error", strerror(errno));
@@ -224,6 +251,36 @@ namespace DUNE
 #endif
     }
 
+    void
+    I2C::submit(Transaction& trans)
+    {
+      // Linux implementation.
+#if defined(DUNE_SYS_HAS_LINUX_I2C_H)
+      std::vector<i2c_msg> msgs(trans.m_msgs.size());
+      for (size_t i = 0; i < msgs.size(); ++i)
+      {
+        const Transaction::Message& src = trans.m_msgs[i];
+        msgs[i].addr = src.adr;
+        msgs[i].flags = src.read ? I2C_M_RD : 0;
+        msgs[i].len = src.length;
+        msgs[i].buf = src.data;
+      }
+
+      Concurrency::ScopedMutex l(*m_bus_lock);
+      for (size_t i = 0; i < msgs.size(); i += I2C_RDWR_IOCTL_MAX_MSGS)
+      {
+        i2c_rdwr_ioctl_data rdwr;
+        rdwr.msgs = &msgs[i];
+        rdwr.nmsgs = std::min(msgs.size() - i, (size_t)I2C_RDWR_IOCTL_MAX_MSGS);
+
+        if (ioctl(m_fd, I2C_RDWR, &rdwr) < 0)
+          throw Error("submitting transaction", System::Error::getLastMessage());
+      }
+#else
+      (void)trans;
+#endif
+    }
+
     void
     I2C::connect(uint8_t addr)
     {
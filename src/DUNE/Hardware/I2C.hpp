@@ -30,11 +30,13 @@
 
 // ISO C++ 98 headers.
 #include <stdexcept>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Utils/String.hpp>
 #include <DUNE/System/Error.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
 
 namespace DUNE
 {
@@ -54,6 +56,81 @@ namespace DUNE
         { }
       };
 
+      //! Sequence of I2C messages submitted to the bus at once.
+      //! Messages are executed in order, separated by repeated start
+      //! conditions, without other masters or tasks interleaving
+      //! their own traffic.
+      class Transaction
+      {
+      public:
+        //! Append a write message.
+        //! @param adr slave address.
+        //! @param data data to write (must remain valid until the
+        //! transaction is submitted).
+        //! @param data_len number of bytes to write.
+        void
+        write(uint8_t adr, const uint8_t* data, unsigned data_len)
+        {
+          add(adr, false, const_cast<uint8_t*>(data), data_len);
+        }
+
+        //! Append a read message.
+        //! @param adr slave address.
+        //! @param bfr place to store data read (must remain valid
+        //! until the transaction is submitted).
+        //! @param bfr_len number of bytes to read.
+        void
+        read(uint8_t adr, uint8_t* bfr, unsigned bfr_len)
+        {
+          add(adr, true, bfr, bfr_len);
+        }
+
+        //! Remove all messages.
+        void
+        clear(void)
+        {
+          m_msgs.clear();
+        }
+
+        //! Retrieve the number of messages.
+        //! @return number of messages.
+        size_t
+        size(void) const
+        {
+          return m_msgs.size();
+        }
+
+      private:
+        friend class I2C;
+
+        //! Single message.
+        struct Message
+        {
+          //! Slave address.
+          uint8_t adr;
+          //! True for reads, false for writes.
+          bool read;
+          //! Data buffer.
+          uint8_t* data;
+          //! Data length.
+          unsigned length;
+        };
+
+        //! Messages.
+        std::vector<Message> m_msgs;
+
+        void
+        add(uint8_t adr, bool read, uint8_t* data, unsigned length)
+        {
+          Message msg;
+          msg.adr = adr;
+          msg.read = read;
+          msg.data = data;
+          msg.length = length;
+          m_msgs.push_back(msg);
+        }
+      };
+
       //! I2C constructor.
       I2C(const std::string& bus_dev);
 
@@ -74,6 +151,14 @@ namespace DUNE
       unsigned
       read(uint8_t adr, uint8_t* bfr, unsigned bfr_len);
 
+      //! Submit a transaction. All messages are passed to the kernel
+      //! in as few I2C_RDWR requests as possible; requests of the
+      //! same transaction are not interleaved with transfers issued
+      //! by other users of the same bus in this process.
+      //! @param trans transaction.
+      void
+      submit(Transaction& trans);
+
       //! Connect to slave address.
       //! @param addr slave address.
       void
@@ -89,6 +174,8 @@ namespace DUNE
       //! Maximum size of an i2c frame.
       static const uint8_t c_max_data_len = 64;
       int m_fd;
+      //! Lock shared by all users of the same bus.
+      Concurrency::Mutex* m_bus_lock;
     };
   }
 }
@@ -32,6 +32,7 @@
 
 // DUNE headers.
 #include <DUNE/Casts.hpp>
+#include <DUNE/Algorithms/CRC16.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/Hardware/LUCL/BootLoader.hpp>
@@ -49,6 +50,8 @@
 #define CMD_PAGE_FILL      0x05
 //! Command: write flash page.
 #define CMD_PAGE_WRITE     0x06
+//! Command: get CRC of flash page.
+#define CMD_PAGE_CRC       0x07
 
 //! Required payload of CMD_UPGRADE_START
 #define CMD_UPGRADE_START_BYTE0 0xa0
@@ -81,6 +84,12 @@
 // Poll delay.
 static const double c_poll_delay = 0.01;
 static const double c_reset_delay = 0.2;
+// Time to wait for the reply to the page CRC probe.
+static const double c_crc_probe_timeout = 0.5;
+// Time to wait for replies to pipelined commands.
+static const double c_reply_timeout = 2.0;
+// Number of times pages are rewritten after failing.
+static const unsigned c_write_retries = 2;
 
 using namespace DUNE::Time;
 using namespace DUNE::Utils;
@@ -95,7 +104,9 @@ namespace DUNE
         m_proto(proto),
         m_baud(baudrate),
         m_page_size(0),
-        m_verbose(verbose)
+        m_verbose(verbose),
+        m_has_crc(false),
+        m_skip(true)
       {
         DO_OR_DIE(enter(), "start bootloader");
       }
@@ -244,30 +255,136 @@ namespace DUNE
         return false;
       }
 
-      bool
-      BootLoader::fillPage(const uint8_t* data, unsigned data_size)
+      void
+      BootLoader::Replies::onCommand(uint8_t code, const uint8_t* data, int data_size)
+      {
+        if (code == CMD_PAGE_WRITE && (data_size < 1 || data[0] != 1))
+          failed = true;
+
+        if (code == CMD_PAGE_CRC && data_size >= 4)
+          crcs[data[0] << 8 | data[1]] = data[2] << 8 | data[3];
+      }
+
+      void
+      BootLoader::Replies::onVersion(unsigned major, unsigned minor, unsigned patch)
+      {
+        (void)major;
+        (void)minor;
+        (void)patch;
+      }
+
+      void
+      BootLoader::Replies::onError(uint8_t code, const uint8_t* data, int data_size)
       {
-        print(".", false);
-        m_proto.sendCommand(CMD_PAGE_FILL, data, data_size);
-        return waitForCommandCode(CMD_PAGE_FILL, m_cmd);
+        (void)code;
+        (void)data;
+        (void)data_size;
+        failed = true;
+      }
+
+      void
+      BootLoader::submit(uint8_t cmd, const uint8_t* data, unsigned data_size, Replies& replies)
+      {
+        while (!m_proto.submit(cmd, data, data_size))
+          complete(replies);
+      }
+
+      void
+      BootLoader::complete(Replies& replies)
+      {
+        if (m_proto.complete(replies, c_reply_timeout))
+          return;
+
+        m_proto.clearOutstanding();
+        throw std::runtime_error("timeout waiting for bootloader replies");
       }
 
       bool
-      BootLoader::writePage(const uint8_t* data, unsigned data_size)
+      BootLoader::writePages(const std::vector<unsigned>& pages)
       {
-        m_proto.sendCommand(CMD_PAGE_WRITE, data, data_size);
-        if (waitForCommandCode(CMD_PAGE_WRITE, m_cmd))
+        unsigned chunks = (m_page_size / c_chunk_size) + ((m_page_size % c_chunk_size) > 0);
+
+        Replies replies;
+        replies.failed = false;
+
+        // Commands of consecutive pages share the same window, so the
+        // next page is filled while the previous one is written.
+        for (unsigned p = 0; p < pages.size(); ++p)
         {
-          if (m_cmd.command.data[0] == 1)
+          const std::vector<uint8_t>& contents = m_page_map[pages[p]];
+          print(String::str("* Updating page %u", pages[p]));
+
+          for (unsigned i = 0; i < chunks; ++i)
           {
-            print(" OK");
-            return true;
+            uint16_t offset = i * c_chunk_size;
+            uint16_t remain = m_page_size - offset;
+            uint16_t length = remain < c_chunk_size ? remain : c_chunk_size;
+            uint8_t data[c_data_size] = {(uint8_t)(offset >> 8), (uint8_t)(offset)};
+            std::memcpy(data + 2, &contents[offset], length);
+            submit(CMD_PAGE_FILL, data, c_data_size, replies);
           }
+
+          uint8_t page[] =
+          {
+            (uint8_t)(pages[p] >> 8),
+            (uint8_t)(pages[p])
+          };
+
+          submit(CMD_PAGE_WRITE, page, sizeof(page), replies);
         }
 
+        complete(replies);
+        return !replies.failed;
+      }
+
+      bool
+      BootLoader::probePageCRC(void)
+      {
+        print("* Probing page CRC support...", false);
+
+        // Older bootloaders reply with an error.
+        uint8_t data[] = {0, 0};
+        m_proto.sendCommand(CMD_PAGE_CRC, data, sizeof(data));
+        if (waitForCommandCode(CMD_PAGE_CRC, m_cmd, c_crc_probe_timeout) && m_cmd.command.size >= 4)
+        {
+          print("OK");
+          return true;
+        }
+
+        print("UNSUPPORTED");
         return false;
       }
 
+      void
+      BootLoader::selectChanged(std::vector<unsigned>& pages)
+      {
+        Replies replies;
+        replies.failed = false;
+
+        std::map<unsigned, std::vector<uint8_t> >::iterator itr = m_page_map.begin();
+        for (; itr != m_page_map.end(); ++itr)
+        {
+          uint8_t data[] =
+          {
+            (uint8_t)(itr->first >> 8),
+            (uint8_t)(itr->first)
+          };
+
+          submit(CMD_PAGE_CRC, data, sizeof(data), replies);
+        }
+
+        complete(replies);
+
+        pages.clear();
+        for (itr = m_page_map.begin(); itr != m_page_map.end(); ++itr)
+        {
+          uint16_t crc = Algorithms::CRC16::compute(&itr->second[0], itr->second.size());
+          std::map<unsigned, uint16_t>::iterator c = replies.crcs.find(itr->first);
+          if (c == replies.crcs.end() || c->second != crc)
+            pages.push_back(itr->first);
+        }
+      }
+
       bool
       BootLoader::startUpgrade(void)
       {
@@ -292,38 +409,49 @@ namespace DUNE
 
         loadIHEX(ihex);
 
-        DO_OR_DIE(startUpgrade(), "start upgrade");
+        m_proto.clearOutstanding();
+        m_has_crc = probePageCRC();
 
-        unsigned chunks = (m_page_size / c_chunk_size) + ((m_page_size % c_chunk_size) > 0);
+        std::vector<unsigned> pages;
+        if (m_has_crc && m_skip)
+        {
+          selectChanged(pages);
+          print(String::str("* %u of %u pages changed", (unsigned)pages.size(), (unsigned)m_page_map.size()));
+        }
+        else
+        {
+          std::map<unsigned, std::vector<uint8_t> >::iterator itr = m_page_map.begin();
+          for (; itr != m_page_map.end(); ++itr)
+            pages.push_back(itr->first);
+        }
 
-        std::map<unsigned, std::vector<uint8_t> >::iterator itr = m_page_map.begin();
-        unsigned page_nr = 0;
-        for (; itr != m_page_map.end(); ++itr)
+        if (pages.empty())
         {
-          print(String::str("* Updating page %d ", page_nr++), false);
+          print("* Firmware is up to date");
+          DO_OR_DIE(leave(), "leave bootloader");
+          return;
+        }
 
-          for (unsigned i = 0; i < chunks; ++i)
-          {
-            uint16_t offset = i * c_chunk_size;
-            uint16_t remain = m_page_size - offset;
-            uint16_t length = remain < c_chunk_size ? remain : c_chunk_size;
-            uint8_t data[c_data_size] = {(uint8_t)(offset >> 8), (uint8_t)(offset)};
-            std::memcpy(data + 2, &itr->second[offset], length);
+        DO_OR_DIE(startUpgrade(), "start upgrade");
 
-            while (1)
-            {
-              if (fillPage(data, c_data_size))
-                break;
-            }
-          }
+        for (unsigned i = 0; ; ++i)
+        {
+          bool ok = writePages(pages);
 
-          uint8_t page[] =
+          // Rewrite only the pages that differ.
+          if (m_has_crc)
           {
-            (uint8_t)(itr->first >> 8),
-            (uint8_t)(itr->first)
-          };
+            selectChanged(pages);
+            ok = pages.empty();
+          }
+
+          if (ok)
+            break;
+
+          if (i == c_write_retries)
+            throw std::runtime_error("write pages");
 
-          DO_OR_DIE(writePage(page, sizeof(page)), "write page");
+          print(String::str("* Rewriting %u pages", (unsigned)pages.size()));
         }
 
         DO_OR_DIE(endUpgrade(), "finish upgrade");
@@ -31,6 +31,7 @@
 // ISO C++ 98 headers.
 #include <string>
 #include <map>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -45,11 +46,25 @@ namespace DUNE
       // Export DLL Symbol.
       class DUNE_DLL_SYM BootLoader;
 
+      //! Firmware upgrade through the LUCL bootloader. Page fill and
+      //! write commands are pipelined over the protocol's window of
+      //! outstanding requests. If the bootloader computes page CRCs,
+      //! pages already holding the new contents are skipped and
+      //! written pages are verified by CRC.
       class BootLoader
       {
       public:
         BootLoader(Protocol& proto, bool verbose = 0, int baudrate = 0);
 
+        //! Define if pages already holding the new contents are
+        //! skipped (default is true).
+        //! @param value true to skip unchanged pages.
+        void
+        setSkipUnchanged(bool value)
+        {
+          m_skip = value;
+        }
+
         void
         flash(const std::string& ihex);
 
@@ -72,6 +87,28 @@ namespace DUNE
         std::map<unsigned, std::vector<uint8_t> > m_page_map;
         //! True to print out messages.
         bool m_verbose;
+        //! True if the bootloader computes page CRCs.
+        bool m_has_crc;
+        //! True to skip unchanged pages.
+        bool m_skip;
+
+        //! Replies to pipelined commands.
+        struct Replies
+        {
+          //! CRC of each page.
+          std::map<unsigned, uint16_t> crcs;
+          //! True if a command failed.
+          bool failed;
+
+          void
+          onCommand(uint8_t code, const uint8_t* data, int data_size);
+
+          void
+          onVersion(unsigned major, unsigned minor, unsigned patch);
+
+          void
+          onError(uint8_t code, const uint8_t* data, int data_size);
+        };
 
         bool
         waitForCommand(CommandType type, Command& cmd, double timeout = 1.0);
@@ -103,11 +140,20 @@ namespace DUNE
         bool
         requestPageSize(void);
 
+        void
+        submit(uint8_t cmd, const uint8_t* data, unsigned data_size, Replies& replies);
+
+        void
+        complete(Replies& replies);
+
         bool
-        fillPage(const uint8_t* data, unsigned data_size);
+        writePages(const std::vector<unsigned>& pages);
 
         bool
-        writePage(const uint8_t* data, unsigned data_size);
+        probePageCRC(void);
+
+        void
+        selectChanged(std::vector<unsigned>& pages);
 
         bool
         startUpgrade(void);
@@ -33,6 +33,7 @@
 // DUNE headers.
 #include <DUNE/Algorithms/XORChecksum.hpp>
 #include <DUNE/Hardware/LUCL/Protocol.hpp>
+#include <DUNE/IO/Poll.hpp>
 #include <DUNE/Streams/Terminal.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/FileSystem/Path.hpp>
@@ -65,7 +66,10 @@ namespace DUNE
         m_uart(0),
         m_i2c(0),
         m_i2c_read_pend(false),
-        m_open(false)
+        m_open(false),
+        m_win_head(0),
+        m_win_count(0),
+        m_subs_count(0)
       {
         reset();
       }
@@ -223,7 +227,7 @@ namespace DUNE
         using Algorithms::XORChecksum;
 
         int size = 3 + data_size + 1;
-        uint8_t msg[32] = {c_sync, (uint8_t)(data_size + 1), cmd};
+        uint8_t msg[3 + c_data_max + 1] = {c_sync, (uint8_t)(data_size + 1), cmd};
 
         std::memcpy(msg + 3, data, data_size);
         msg[size - 1] = XORChecksum::compute(data, data_size, c_sync ^ (data_size + 1) ^ cmd) | c_csum_msk;
@@ -231,6 +235,102 @@ namespace DUNE
         write(msg, size);
       }
 
+      bool
+      Protocol::submit(uint8_t cmd, const uint8_t* data, int data_size)
+      {
+        // Replies over I2C are read one at a time.
+        unsigned window = m_i2c ? 1 : c_window_size;
+        if (m_win_count >= window)
+          return false;
+
+        sendCommand(cmd, data, data_size);
+        m_window[(m_win_head + m_win_count) % c_window_size] = cmd;
+        ++m_win_count;
+        return true;
+      }
+
+      void
+      Protocol::retire(uint8_t cmd)
+      {
+        for (unsigned i = 0; i < m_win_count; ++i)
+        {
+          if (m_window[(m_win_head + i) % c_window_size] != cmd)
+            continue;
+
+          // Close the gap, keeping the order of the remaining requests.
+          for (unsigned j = i; j > 0; --j)
+            m_window[(m_win_head + j) % c_window_size] = m_window[(m_win_head + j - 1) % c_window_size];
+
+          m_win_head = (m_win_head + 1) % c_window_size;
+          --m_win_count;
+          return;
+        }
+      }
+
+      void
+      Protocol::subscribe(uint8_t cmd, double period)
+      {
+        for (unsigned i = 0; i < m_subs_count; ++i)
+        {
+          if (m_subs[i].cmd != cmd)
+            continue;
+
+          if (period > 0)
+          {
+            m_subs[i].timer.setTop(period);
+            return;
+          }
+
+          m_subs[i] = m_subs[--m_subs_count];
+          return;
+        }
+
+        if (period <= 0)
+          return;
+
+        if (m_subs_count == c_max_subscriptions)
+          throw std::runtime_error("too many periodic requests");
+
+        m_subs[m_subs_count].cmd = cmd;
+        m_subs[m_subs_count].timer.setTop(period);
+        ++m_subs_count;
+      }
+
+      unsigned
+      Protocol::submitDue(void)
+      {
+        unsigned count = 0;
+
+        for (unsigned i = 0; i < m_subs_count; ++i)
+        {
+          if (!m_subs[i].timer.overflow())
+            continue;
+
+          if (!submit(m_subs[i].cmd))
+            break;
+
+          m_subs[i].timer.reset();
+          ++count;
+        }
+
+        return count;
+      }
+
+      bool
+      Protocol::poll(double timeout)
+      {
+        if (!m_queue.empty())
+          return true;
+
+        if (m_i2c)
+          return m_i2c_read_pend;
+
+        if (m_uart)
+          return IO::Poll::poll(*m_uart, timeout);
+
+        return false;
+      }
+
       void
       Protocol::requestVersion(void)
       {
@@ -336,6 +436,8 @@ namespace DUNE
                 else
                 {
                   cmd.type = CommandTypeInvalidChecksum;
+                  reset();
+                  return cmd.type;
                 }
               }
               else
@@ -403,7 +505,10 @@ namespace DUNE
               std::memcpy(cmd.command.data, m_sm_data, m_sm_size);
             }
 
+            // Leave the remaining bytes queued for the next call, so
+            // back-to-back replies are not overwritten.
             reset();
+            return cmd.type;
           }
         }
 
@@ -37,6 +37,7 @@
 #include <DUNE/Hardware/I2C.hpp>
 #include <DUNE/Hardware/SerialPort.hpp>
 #include <DUNE/FileSystem/Path.hpp>
+#include <DUNE/Time/Counter.hpp>
 #include <DUNE/Hardware/LUCL/CommandType.hpp>
 #include <DUNE/Hardware/LUCL/Command.hpp>
 
@@ -171,6 +172,103 @@ namespace DUNE
         void
         sendCommand(uint8_t cmd, const uint8_t* data = 0, int data_size = 0);
 
+        //! Send a command without waiting for previous commands to be
+        //! answered. The command is kept in the window of outstanding
+        //! requests until its reply is processed by complete().
+        //! @param cmd command code.
+        //! @param data command arguments.
+        //! @param data_size size of command arguments.
+        //! @return true if the command was sent, false if the window
+        //! of outstanding requests is full.
+        bool
+        submit(uint8_t cmd, const uint8_t* data = 0, int data_size = 0);
+
+        //! Get the number of outstanding requests.
+        //! @return number of requests waiting for a reply.
+        unsigned
+        getOutstanding(void) const
+        {
+          return m_win_count;
+        }
+
+        //! Forget all outstanding requests, e.g., after a timeout.
+        void
+        clearOutstanding(void)
+        {
+          m_win_count = 0;
+        }
+
+        //! Request a command periodically. Due requests are submitted
+        //! by submitDue(), so periodic data is requested in the same
+        //! cycle as other commands instead of in a separate exchange.
+        //! @param cmd command code (without arguments).
+        //! @param period request period in seconds (0 to cancel).
+        void
+        subscribe(uint8_t cmd, double period);
+
+        //! Submit the periodic requests that are due.
+        //! @return number of requests submitted.
+        unsigned
+        submitDue(void);
+
+        //! Process replies until all outstanding requests have been
+        //! answered. Replies are matched to the oldest outstanding
+        //! request with the same command code and passed to the
+        //! handler (see read()), as well as unsolicited commands.
+        //! @param handler command handler.
+        //! @param timeout maximum amount of time to wait in seconds.
+        //! @return true if all requests were answered, false on
+        //! timeout.
+        template <typename H>
+        bool
+        complete(H& handler, double timeout)
+        {
+          Time::Counter<double> timer(timeout);
+          Command cmd;
+
+          while (m_win_count > 0)
+          {
+            switch (consumeData(cmd))
+            {
+              case CommandTypeNone:
+                if (timer.overflow() || !poll(timer.getRemaining()))
+                  return false;
+                break;
+
+              case CommandTypeNormal:
+                handler.onCommand(cmd.command.code, cmd.command.data, cmd.command.size);
+                retire(cmd.command.code);
+                break;
+
+              case CommandTypeVersion:
+                handler.onVersion(cmd.version.major, cmd.version.minor, cmd.version.patch);
+                retire(c_cmd_info);
+                break;
+
+              case CommandTypeError:
+                // Errors do not identify the request: blame the oldest.
+                handler.onError(cmd.error.code, 0, 0);
+                retire(m_window[m_win_head]);
+                break;
+
+              case CommandTypeInvalidChecksum:
+                handler.onError(0xE5, 0, 0);
+                break;
+
+              default:
+                break;
+            }
+          }
+
+          return true;
+        }
+
+        //! Wait for incoming data.
+        //! @param timeout maximum amount of time to wait in seconds.
+        //! @return true if data is available, false otherwise.
+        bool
+        poll(double timeout);
+
         void
         requestVersion(void);
 
@@ -226,6 +324,10 @@ namespace DUNE
         static const uint8_t c_cmd_reset = 0xFF;
         //! Default baud rate.
         static const int c_baud_def = 57600;
+        //! Maximum number of outstanding requests.
+        static const unsigned c_window_size = 8;
+        //! Maximum number of periodic requests.
+        static const unsigned c_max_subscriptions = 8;
         //! Error strings.
         static const char* c_error_strs[];
         //! Index of last error in c_error_strs.
@@ -264,6 +366,32 @@ namespace DUNE
         std::string m_name_lo;
         //! True if device is open.
         bool m_open;
+        //! Command codes of outstanding requests (circular buffer).
+        uint8_t m_window[c_window_size];
+        //! Index of the oldest outstanding request.
+        unsigned m_win_head;
+        //! Number of outstanding requests.
+        unsigned m_win_count;
+
+        //! Periodic request.
+        struct Subscription
+        {
+          //! Command code.
+          uint8_t cmd;
+          //! Time between requests.
+          Time::Counter<double> timer;
+        };
+
+        //! Periodic requests.
+        Subscription m_subs[c_max_subscriptions];
+        //! Number of periodic requests.
+        unsigned m_subs_count;
+
+        //! Remove the oldest outstanding request with a given command
+        //! code from the window.
+        //! @param cmd command code.
+        void
+        retire(uint8_t cmd);
 
         //! Reset internal state machine parser.
         void
@@ -27,6 +27,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -59,6 +60,12 @@
 #  include <sys/select.h>
 #endif
 
+// Linux headers.
+#if defined(DUNE_OS_LINUX)
+#  include <sys/ioctl.h>
+#  include <linux/serial.h>
+#endif
+
 // Microsoft Windows headers.
 #if defined(DUNE_SYS_HAS_WINDOWS_H)
 #  include <windows.h>
@@ -610,6 +617,42 @@ namespace DUNE
 #endif
     }
 
+    void
+    SerialPort::setReadTimeout(int minimum, double timeout)
+    {
+#if defined(DUNE_OS_POSIX)
+      int deciseconds = (int)(timeout * 10.0 + 0.5);
+      m_options.c_cc[VMIN] = std::max(0, std::min(minimum, 255));
+      m_options.c_cc[VTIME] = std::max(0, std::min(deciseconds, 255));
+
+      if (tcsetattr(m_handle, TCSANOW, &(m_options)) == -1)
+        throw Error("setting read timeout", System::Error::getLastMessage());
+#elif defined(DUNE_OS_WINDOWS)
+      (void)minimum;
+      (void)timeout;
+#endif
+    }
+
+    bool
+    SerialPort::setLowLatency(bool enabled)
+    {
+#if defined(DUNE_OS_LINUX) && defined(TIOCGSERIAL)
+      serial_struct info;
+      if (ioctl(m_handle, TIOCGSERIAL, &info) == -1)
+        return false;
+
+      if (enabled)
+        info.flags |= ASYNC_LOW_LATENCY;
+      else
+        info.flags &= ~ASYNC_LOW_LATENCY;
+
+      return ioctl(m_handle, TIOCSSERIAL, &info) != -1;
+#else
+      (void)enabled;
+      return false;
+#endif
+    }
+
     size_t
     SerialPort::doWrite(const uint8_t* bfr, size_t size)
     {
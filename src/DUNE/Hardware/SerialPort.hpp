@@ -180,6 +180,24 @@ namespace DUNE
       void
       setCTSRTS(bool enabled);
 
+      //! Configure non-canonical read completion: a read returns
+      //! after 'minimum' bytes were received or when no byte arrives
+      //! for 'timeout' seconds after the first one (termios VMIN and
+      //! VTIME). The timeout has a resolution of 0.1 s and is capped
+      //! at 25.5 s.
+      //! @param minimum minimum number of bytes per read.
+      //! @param timeout inter-byte timeout (s).
+      void
+      setReadTimeout(int minimum, double timeout);
+
+      //! Ask the driver to push received bytes to the reader without
+      //! buffering delays (ASYNC_LOW_LATENCY). Not every driver
+      //! supports this flag.
+      //! @param enabled true to enable low latency mode.
+      //! @return true if the mode was changed, false otherwise.
+      bool
+      setLowLatency(bool enabled);
+
     private:
       // POSIX implementation.
 #if defined(DUNE_SYS_HAS_STRUCT_TERMIOS)
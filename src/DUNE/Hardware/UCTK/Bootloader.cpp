@@ -26,12 +26,15 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Algorithms/CRC8.hpp>
+#include <DUNE/Algorithms/CRC16.hpp>
 #include <DUNE/Hardware/UCTK/Bootloader.hpp>
 #include <DUNE/Hardware/UCTK/FirmwareInfo.hpp>
 
@@ -49,10 +52,16 @@ namespace DUNE
       static const unsigned c_fill_chunk_size = 32;
       //! Bootloader name.
       static const char* c_boot_name = "BOOT";
+      //! Time to wait for the reply to the page CRC probe.
+      static const double c_crc_probe_timeout = 0.5;
+      //! Number of times a page failing verification is rewritten.
+      static const unsigned c_write_retries = 2;
 
       Bootloader::Bootloader(Interface* itf, bool verbose):
         m_itf(itf),
-        m_verbose(verbose)
+        m_verbose(verbose),
+        m_has_crc(false),
+        m_skip(true)
       {
         FirmwareInfo info = m_itf->getFirmwareInfo();
         printFirmwareInfo(info);
@@ -70,6 +79,9 @@ namespace DUNE
         }
 
         getFlashInfo();
+
+        m_has_crc = probePageCRC();
+        print("%-20s: %s\n", "Page CRC", m_has_crc ? "yes" : "no");
       }
 
       Bootloader::~Bootloader(void)
@@ -115,6 +127,24 @@ namespace DUNE
 
         title("Programming");
 
+        std::vector<unsigned> pages;
+        if (m_has_crc && m_skip)
+        {
+          selectChanged(table, pages);
+          print("%-20s: %u of %u\n", "Changed Pages", (unsigned)pages.size(), (unsigned)table.size());
+        }
+        else
+        {
+          for (itr = table.begin(); itr != table.end(); ++itr)
+            pages.push_back(itr->first);
+        }
+
+        if (pages.empty())
+        {
+          print("Firmware is up to date\n");
+          return;
+        }
+
         // Start upgrade procedure.
         m_frame.setId(PKT_ID_BOOT_UPGRADE_START);
         m_frame.setPayloadSize(5);
@@ -123,10 +153,21 @@ namespace DUNE
         if (!m_itf->sendFrame(m_frame))
           throw std::runtime_error(DTR("failed start upgrade procedure"));
 
-        // Program pages.
-        IntelHEX::PageTable::const_iterator pitr = table.begin();
-        for (; pitr != table.end(); ++pitr)
-          fillPage(pitr->first, pitr->second);
+        writePages(table, pages);
+
+        // Verify written pages, rewriting the ones that differ.
+        for (unsigned i = 0; m_has_crc && !pages.empty(); ++i)
+        {
+          selectChanged(table, pages);
+          if (pages.empty())
+            break;
+
+          if (i == c_write_retries)
+            throw std::runtime_error(DTR("failed to verify flash pages"));
+
+          print("Rewriting %u pages that failed verification\n", (unsigned)pages.size());
+          writePages(table, pages);
+        }
 
         // End upgrade procedure.
         m_frame.setId(PKT_ID_BOOT_UPGRADE_END);
@@ -136,37 +177,119 @@ namespace DUNE
       }
 
       void
-      Bootloader::fillPage(unsigned page, const std::vector<uint8_t>& contents)
+      Bootloader::writePages(const IntelHEX::PageTable& table, const std::vector<unsigned>& pages)
       {
-        uint16_t offset = 0;
-        unsigned chunk_count = contents.size() / c_fill_chunk_size;
+        std::vector<Frame> frames;
+        for (unsigned i = 0; i < pages.size(); ++i)
+          queuePage(pages[i], table.find(pages[i])->second, frames);
 
-        print("Page % 2u: ", page);
+        // Frames of consecutive pages share the same window, so the
+        // next page is filled while the previous one is written.
+        for (unsigned base = 0; base < frames.size(); base += Interface::c_max_batch)
+        {
+          unsigned count = std::min((unsigned)frames.size() - base, Interface::c_max_batch);
+          if (!m_itf->sendFrames(&frames[base], count))
+            throw std::runtime_error(DTR("failed to write flash pages"));
+
+          for (unsigned i = base; i < base + count; ++i)
+          {
+            if (frames[i].getId() != PKT_ID_BOOT_FLASH_WRITE)
+              continue;
+
+            uint32_t addr = 0;
+            frames[i].get(addr, 0);
+            print("Page % 2u: OK\n", addr / m_page_size);
+          }
+        }
+      }
+
+      void
+      Bootloader::queuePage(unsigned page, const std::vector<uint8_t>& contents, std::vector<Frame>& frames)
+      {
+        unsigned chunk_count = contents.size() / c_fill_chunk_size;
 
         // Fill page.
         m_frame.setId(PKT_ID_BOOT_FLASH_FILL);
+        m_frame.setPayloadSize(c_fill_chunk_size + 2);
         for (unsigned i = 0; i < chunk_count; ++i)
         {
-          offset = i * c_fill_chunk_size;
+          uint16_t offset = i * c_fill_chunk_size;
           m_frame.set(offset, 0);
           std::memcpy(m_frame.getPayload() + 2, &contents[offset], c_fill_chunk_size);
-
-          m_frame.setPayloadSize(c_fill_chunk_size + 2);
-          if (!m_itf->sendFrame(m_frame))
-            throw std::runtime_error(DTR("failed to fill page chunk"));
-
-          print(".");
+          frames.push_back(m_frame);
         }
 
         // Write page.
         m_frame.setId(PKT_ID_BOOT_FLASH_WRITE);
         m_frame.setPayloadSize(4);
         m_frame.set<uint32_t>(page * m_page_size, 0);
-        if (!m_itf->sendFrame(m_frame))
-          throw std::runtime_error(DTR("failed to write flash page"));
-        print(" ");
+        frames.push_back(m_frame);
+      }
 
-        printOK();
+      bool
+      Bootloader::probePageCRC(void)
+      {
+        m_frame.setId(PKT_ID_BOOT_FLASH_CRC);
+        m_frame.setPayloadSize(6);
+        m_frame.set<uint32_t>(0, 0);
+        m_frame.set<uint16_t>(m_page_size, 4);
+
+        // Older bootloaders reply with an error or not at all.
+        bool rv = false;
+        try
+        {
+          rv = m_itf->sendFrame(m_frame, c_crc_probe_timeout)
+          && m_frame.getPayloadSize() == 2;
+        }
+        catch (std::runtime_error&)
+        { }
+
+        m_itf->flush();
+        return rv;
+      }
+
+      void
+      Bootloader::getPageCRCs(const std::vector<unsigned>& pages, std::vector<uint16_t>& crcs)
+      {
+        std::vector<Frame> frames(pages.size());
+        for (unsigned i = 0; i < pages.size(); ++i)
+        {
+          frames[i].setId(PKT_ID_BOOT_FLASH_CRC);
+          frames[i].setPayloadSize(6);
+          frames[i].set<uint32_t>(pages[i] * m_page_size, 0);
+          frames[i].set<uint16_t>(m_page_size, 4);
+        }
+
+        if (!frames.empty() && !m_itf->sendFrames(&frames[0], frames.size()))
+          throw std::runtime_error(DTR("failed to read flash page CRCs"));
+
+        crcs.resize(pages.size());
+        for (unsigned i = 0; i < frames.size(); ++i)
+        {
+          if (frames[i].getPayloadSize() != 2)
+            throw std::runtime_error(DTR("invalid flash page CRC"));
+          frames[i].get(crcs[i], 0);
+        }
+      }
+
+      void
+      Bootloader::selectChanged(const IntelHEX::PageTable& table, std::vector<unsigned>& pages)
+      {
+        std::vector<unsigned> all;
+        IntelHEX::PageTable::const_iterator itr = table.begin();
+        for (; itr != table.end(); ++itr)
+          all.push_back(itr->first);
+
+        std::vector<uint16_t> crcs;
+        getPageCRCs(all, crcs);
+
+        pages.clear();
+        for (unsigned i = 0; i < all.size(); ++i)
+        {
+          const std::vector<uint8_t>& contents = table.find(all[i])->second;
+          if (Algorithms::CRC16::compute(&contents[0], contents.size()) != crcs[i])
+            pages.push_back(all[i]);
+        }
       }
 
       void
@@ -41,6 +41,11 @@ namespace DUNE
   {
     namespace UCTK
     {
+      //! Firmware upgrade through the UCTK bootloader. Flash fill
+      //! and write requests are pipelined, several pages at a time.
+      //! If the bootloader computes page CRCs, pages already holding
+      //! the new contents are skipped and written pages are verified
+      //! by CRC.
       class Bootloader
       {
       public:
@@ -48,6 +53,15 @@ namespace DUNE
 
         ~Bootloader(void);
 
+        //! Define if pages already holding the new contents are
+        //! skipped (default is true).
+        //! @param value true to skip unchanged pages.
+        void
+        setSkipUnchanged(bool value)
+        {
+          m_skip = value;
+        }
+
         void
         program(const std::string& file_name);
 
@@ -58,14 +72,27 @@ namespace DUNE
         uint32_t m_flash_size;
         //! Flash page size.
         uint16_t m_page_size;
+        //! True if the bootloader computes page CRCs.
+        bool m_has_crc;
+        //! True to skip unchanged pages.
+        bool m_skip;
         //! Scratch frame.
         UCTK::Frame m_frame;
 
         void
-        fillPage(unsigned page, const std::vector<uint8_t>& contents);
+        writePages(const IntelHEX::PageTable& table, const std::vector<unsigned>& pages);
+
+        void
+        queuePage(unsigned page, const std::vector<uint8_t>& contents, std::vector<Frame>& frames);
+
+        bool
+        probePageCRC(void);
+
+        void
+        getPageCRCs(const std::vector<unsigned>& pages, std::vector<uint16_t>& crcs);
 
         void
-        fillPageChunk(unsigned page);
+        selectChanged(const IntelHEX::PageTable& table, std::vector<unsigned>& pages);
 
         void
         print(const char* format, ...) const;
@@ -48,7 +48,8 @@ namespace DUNE
         PKT_ID_BOOT_UPGRADE_END,
         PKT_ID_BOOT_FLASH_FILL,
         PKT_ID_BOOT_FLASH_WRITE,
-        PKT_ID_BOOT_FLASH_INFO
+        PKT_ID_BOOT_FLASH_INFO,
+        PKT_ID_BOOT_FLASH_CRC
       };
 
       //! Synchronization number.
@@ -25,6 +25,10 @@
 // Author: Ricardo Martins                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
 // DUNE headers.
 #include <DUNE/IO/Poll.hpp>
 #include <DUNE/Algorithms/XORChecksum.hpp>
@@ -39,14 +43,14 @@ namespace DUNE
     {
       Interface::Interface(IO::Handle* handle):
         m_handle(handle)
-      { }
-
-      Interface::~Interface(void)
       {
-        while (!m_queue.empty())
-          delete m_queue.pop();
+        for (unsigned i = 0; i < c_pool_size; ++i)
+          m_free.push(&m_pool[i]);
       }
 
+      Interface::~Interface(void)
+      { }
+
       FirmwareInfo
       Interface::getFirmwareInfo(void)
       {
@@ -80,22 +84,34 @@ namespace DUNE
       }
 
       bool
-      Interface::sendFrame(Frame& frame, double timeout)
+      Interface::sendFrames(Frame* frames, unsigned count, double timeout)
       {
-        frame.computeCRC();
+        for (unsigned base = 0; base < count; base += c_max_batch)
+        {
+          unsigned n = std::min(count - base, c_max_batch);
 
-        m_handle->write(frame.getData(), frame.getSize());
+          size_t size = 0;
+          for (unsigned i = base; i < base + n; ++i)
+          {
+            frames[i].computeCRC();
+            std::memcpy(m_tx + size, frames[i].getData(), frames[i].getSize());
+            size += frames[i].getSize();
+          }
+
+          m_handle->write(m_tx, size);
 
-        if (timeout < 0)
-          return true;
+          if (timeout >= 0 && !readReplies(frames + base, n, timeout))
+            return false;
+        }
 
-        return readReply(frame, timeout);
+        return true;
       }
 
       bool
-      Interface::readReply(Frame& frame, double timeout)
+      Interface::readReplies(Frame* frames, unsigned count, double timeout)
       {
-        unsigned reply_id = frame.getId();
+        bool replied[c_max_batch] = {false};
+        unsigned pending = count;
 
         Time::Counter<double> timer(timeout);
         while (!timer.overflow())
@@ -106,21 +122,36 @@ namespace DUNE
           size_t rv = m_handle->read(m_buffer, sizeof(m_buffer));
           for (size_t i = 0; i < rv; ++i)
           {
-            if (!m_parser.parse(m_buffer[i], frame))
+            if (!m_parser.parse(m_buffer[i], m_frame))
               continue;
 
-            if (frame.getId() == PKT_ID_ERR)
+            if (m_frame.getId() == PKT_ID_ERR)
             {
               uint8_t code = 0;
-              frame.get(code, 0);
+              m_frame.get(code, 0);
               throw std::runtime_error(Errors::translate(code));
             }
 
-            if (frame.getId() == reply_id)
-              return true;
+            // Replies arrive in request order, so the first pending
+            // request with the same id is the one being answered.
+            unsigned j = 0;
+            while (j < count && (replied[j] || frames[j].getId() != m_frame.getId()))
+              ++j;
+
+            if (j == count)
+            {
+              queue(m_frame);
+              continue;
+            }
 
-            m_queue.push(new Frame(frame));
+            frames[j] = m_frame;
+            replied[j] = true;
+            --pending;
           }
+
+          // Frames read after the last reply were queued above.
+          if (pending == 0)
+            return true;
         }
 
         return false;
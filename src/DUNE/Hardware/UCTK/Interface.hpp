@@ -45,6 +45,11 @@ namespace DUNE
       class Interface
       {
       public:
+        //! Maximum number of requests written at once by sendFrames.
+        static const unsigned c_max_batch = 8;
+        //! Number of unsolicited frames that can be queued.
+        static const unsigned c_pool_size = 16;
+
         Interface(IO::Handle* handle);
 
         virtual
@@ -53,8 +58,9 @@ namespace DUNE
         void
         flush(void)
         {
-          while (!m_queue.empty())
-            delete m_queue.pop();
+          Frame frame;
+          while (pop(frame))
+            ;
           m_handle->flush();
         }
 
@@ -64,16 +70,46 @@ namespace DUNE
         void
         resetDevice(void);
 
+        //! Send a request and wait for its reply, which is stored in
+        //! the same frame.
+        //! @param frame request frame.
+        //! @param timeout maximum amount of time to wait for the reply
+        //! (negative to not wait).
+        //! @return true if the reply was received, false otherwise.
+        bool
+        sendFrame(Frame& frame, double timeout = 1.0)
+        {
+          return sendFrames(&frame, 1, timeout);
+        }
+
+        //! Send several requests without waiting for the replies in
+        //! between. Requests are written in groups of c_max_batch and
+        //! replies are matched to requests by packet id, in order, so
+        //! polling N values costs one round trip instead of N.
+        //! @param frames request frames, replaced by the replies.
+        //! @param count number of requests.
+        //! @param timeout maximum amount of time to wait for each
+        //! group of replies (negative to not wait).
+        //! @return true if all replies were received, false otherwise.
         bool
-        sendFrame(Frame& frame, double timeout = 1.0);
+        sendFrames(Frame* frames, unsigned count, double timeout = 1.0);
 
         void
         setBootStop(bool value);
 
-        Frame*
-        pop(void)
+        //! Retrieve the oldest unsolicited frame.
+        //! @param frame frame.
+        //! @return true if a frame was available, false otherwise.
+        bool
+        pop(Frame& frame)
         {
-          return m_queue.pop();
+          Frame* f = m_queue.pop();
+          if (f == NULL)
+            return false;
+
+          frame = *f;
+          m_free.push(f);
+          return true;
         }
 
         unsigned
@@ -85,7 +121,7 @@ namespace DUNE
           {
             if (m_parser.parse(m_buffer[i], m_frame))
             {
-              m_queue.push(new Frame(m_frame));
+              queue(m_frame);
               ++frame_count;
             }
           }
@@ -100,11 +136,31 @@ namespace DUNE
         UCTK::Frame m_frame;
         UCTK::Parser m_parser;
         uint8_t m_buffer[128];
+        //! Transmission buffer of batched requests.
+        uint8_t m_tx[c_max_batch * (c_max_payload + c_frame_overhead)];
+        //! Preallocated unsolicited frames.
+        UCTK::Frame m_pool[c_pool_size];
+        //! Unused frames of the pool.
+        Concurrency::TSQueue<UCTK::Frame*> m_free;
         //! Frame queue.
         Concurrency::TSQueue<UCTK::Frame*> m_queue;
 
+        //! Queue an unsolicited frame. If the pool is exhausted the
+        //! oldest queued frame is discarded.
+        //! @param frame frame.
+        void
+        queue(const Frame& frame)
+        {
+          Frame* f = m_free.pop();
+          if (f == NULL)
+            f = m_queue.pop();
+
+          *f = frame;
+          m_queue.push(f);
+        }
+
         bool
-        readReply(Frame& msg, double timeout);
+        readReplies(Frame* frames, unsigned count, double timeout);
 
         void
         getFirmwareName(FirmwareInfo& info);
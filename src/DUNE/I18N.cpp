@@ -26,45 +26,189 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <clocale>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/I18N.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Utils/MessageCatalog.hpp>
+
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  define DUNE_I18N_MEMO
+#endif
 
 namespace DUNE
 {
+  //! Number of remembered translations.
+  static const size_t c_memo_size = 4096;
+
+  //! Remembered translation of a message.
+  struct Memo
+  {
+    //! Address of the message.
+    const char* site;
+    //! Contents of the message.
+    std::string msgid;
+    //! Catalog of the translation.
+    const Utils::MessageCatalog* catalog;
+    //! Translation (NULL if the message has no translation).
+    const char* text;
+  };
+
+  // Catalogs and memos are never released, since translations
+  // returned by DTR() may be held anywhere.
+
+  //! Catalog of the selected language.
+  static const Utils::MessageCatalog* volatile s_catalog = NULL;
+  //! Remembered translations by message address.
+  static Memo* volatile s_memo[c_memo_size];
+  //! Name of the language of the loaded catalog.
+  static std::string s_language;
+
+  //! Get the lock of remembered translations.
+  static Concurrency::Mutex&
+  getMemoLock(void)
+  {
+    static Concurrency::Mutex lock;
+    return lock;
+  }
+
+  //! Remove the codeset and modifier of a locale name.
+  static std::string
+  stripLocale(const std::string& name)
+  {
+    return name.substr(0, name.find_first_of(".@"));
+  }
+
+  //! Get the language name of the environment.
+  static std::string
+  getEnvironmentLanguage(void)
+  {
+    const char* vars[] = {"LC_ALL", "LC_MESSAGES", "LANG"};
+    for (unsigned i = 0; i < sizeof(vars) / sizeof(vars[0]); ++i)
+    {
+      const char* value = std::getenv(vars[i]);
+      if (value != NULL && *value != 0)
+        return value;
+    }
+
+    return "";
+  }
+
+  //! Load the catalog of a language.
+  static const Utils::MessageCatalog*
+  loadCatalog(const FileSystem::Path& folder, const std::string& name)
+  {
+    FileSystem::Path file = folder / name / "LC_MESSAGES" / "dune.mo";
+    if (!file.isFile())
+      return NULL;
+
+    try
+    {
+      return new Utils::MessageCatalog(file.str());
+    }
+    catch (std::exception&)
+    {
+      return NULL;
+    }
+  }
+
   void
   I18N::setLanguage(const DUNE::FileSystem::Path& folder, const std::string& name)
   {
-    (void)folder;
-    (void)name;
-
 #if defined(DUNE_SYS_HAS_GETTEXT) && defined(LC_MESSAGES)
     setlocale(LC_MESSAGES, name.c_str());
-    bindtextdomain("dune", folder.c_str());
-    bind_textdomain_codeset("dune", "UTF-8");
-    textdomain("dune");
 #endif
+
+    std::string lang = stripLocale(name.empty() ? getEnvironmentLanguage() : name);
+    if (lang.empty() || lang == "C" || lang == "POSIX")
+      return;
+
+    // Try the full name first (e.g., pt_PT), then the language (pt).
+    const Utils::MessageCatalog* catalog = loadCatalog(folder, lang);
+    if (catalog == NULL && lang.find('_') != std::string::npos)
+    {
+      lang = lang.substr(0, lang.find('_'));
+      catalog = loadCatalog(folder, lang);
+    }
+
+    if (catalog == NULL)
+      return;
+
+    s_language = lang;
+
+#if defined(DUNE_I18N_MEMO)
+    __sync_synchronize();
+#endif
+    s_catalog = catalog;
   }
 
   std::string
   I18N::getLanguage(void)
   {
+    if (!s_language.empty())
+      return s_language;
+
 #if defined(DUNE_SYS_HAS_GETTEXT) && defined(LC_MESSAGES)
-    std::string name = setlocale(LC_MESSAGES, NULL);
-    for (unsigned i = 0; i < name.size(); ++i)
+    return stripLocale(setlocale(LC_MESSAGES, NULL));
+#else
+    return "unknown";
+#endif
+  }
+
+  const char*
+  I18N::translate(const char* str)
+  {
+    const Utils::MessageCatalog* catalog = s_catalog;
+    if (catalog == NULL || str == NULL)
+      return str;
+
+#if defined(DUNE_I18N_MEMO)
+    __sync_synchronize();
+
+    size_t slot = (((uintptr_t)str >> 3) ^ ((uintptr_t)str >> 15)) % c_memo_size;
+    Memo* memo = s_memo[slot];
+    __sync_synchronize();
+
+    // Messages may live in reused buffers, so contents are compared.
+    if (memo != NULL && memo->site == str && memo->catalog == catalog
+        && std::strcmp(memo->msgid.c_str(), str) == 0)
+      return (memo->text == NULL) ? str : memo->text;
+#endif
+
+    const char* text = catalog->lookup(str);
+
+#if defined(DUNE_I18N_MEMO)
+    // Slots taken by other messages of the same catalog are kept.
+    if (memo == NULL || memo->catalog != catalog)
     {
-      if (name[i] == '.' || name[i] == '@')
+      Concurrency::ScopedMutex l(getMemoLock());
+      if (s_memo[slot] == memo)
       {
-        name.resize(i);
-        break;
+        Memo* entry = new Memo;
+        entry->site = str;
+        entry->msgid = str;
+        entry->catalog = catalog;
+        entry->text = text;
+        __sync_synchronize();
+        s_memo[slot] = entry;
       }
     }
-
-    return name;
-#else
-    return "unknown";
 #endif
+
+    return (text == NULL) ? str : text;
+  }
+
+  const char*
+  translate(const char* str)
+  {
+    return I18N::translate(str);
   }
 }
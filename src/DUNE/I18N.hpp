@@ -36,14 +36,30 @@
 
 namespace DUNE
 {
+  //! Message translation. Translations are read from the compiled
+  //! catalog of the selected language (LANG/LC_MESSAGES/dune.mo)
+  //! and looked up through DTR().
   class I18N
   {
   public:
+    //! Select the language of translations and load its catalog.
+    //! @param[in] folder folder of the message catalogs.
+    //! @param[in] name language name, empty to use the language of
+    //! the environment.
     static void
     setLanguage(const DUNE::FileSystem::Path& folder, const std::string& name = "");
 
     static std::string
     getLanguage(void);
+
+    //! Translate a message. Translations are remembered by the
+    //! address of the message, so translating the same string
+    //! again costs one string comparison.
+    //! @param[in] str message.
+    //! @return translated message, or the message itself if it has
+    //! no translation.
+    static const char*
+    translate(const char* str);
   };
 }
 
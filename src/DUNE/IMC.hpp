@@ -35,19 +35,35 @@ namespace DUNE
   { }
 }
 
+#include <DUNE/IMC/Blackboard.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/Serialization.hpp>
 #include <DUNE/IMC/InlineMessage.hpp>
 #include <DUNE/IMC/MessageList.hpp>
 #include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/MessagePool.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
+#include <DUNE/IMC/SharedMessagePool.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/PacketFilter.hpp>
+#include <DUNE/IMC/ScatterPacket.hpp>
+#include <DUNE/IMC/SubscriptionFilter.hpp>
 #include <DUNE/IMC/Macros.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
 #include <DUNE/IMC/Parser.hpp>
 #include <DUNE/IMC/Exceptions.hpp>
 #include <DUNE/IMC/Definitions.hpp>
 #include <DUNE/IMC/Blob.hpp>
+#include <DUNE/IMC/BlockLog.hpp>
+#include <DUNE/IMC/PacketScanner.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/IMC/LogCatalog.hpp>
+#include <DUNE/IMC/LogReader.hpp>
+#include <DUNE/IMC/LogMerger.hpp>
+#include <DUNE/IMC/Schema.hpp>
+#include <DUNE/IMC/CompactCodec.hpp>
 #include <DUNE/IMC/IridiumMessageDefinitions.hpp>
+#include <DUNE/IMC/TraceRing.hpp>
 
 #endif
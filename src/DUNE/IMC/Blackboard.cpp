@@ -0,0 +1,224 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/IMC/Blackboard.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Order table updates with reads made by other threads without
+    //! locking.
+    static inline void
+    barrier(void)
+    {
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+      __sync_synchronize();
+#endif
+    }
+
+    Blackboard::Blackboard(AddressResolver& resolver):
+      m_resolver(resolver)
+    {
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+        m_tables[i] = NULL;
+    }
+
+    Blackboard::~Blackboard(void)
+    {
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+      {
+        Table* table = m_tables[i];
+        if (table == NULL)
+          continue;
+
+        for (unsigned e = 0; e < c_keys; ++e)
+        {
+          if (table->entities[e] == NULL)
+            continue;
+
+          for (unsigned s = 0; s < c_keys; ++s)
+          {
+            if (table->entities[e][s].msg != NULL)
+              table->entities[e][s].msg->release();
+          }
+
+          delete [] table->entities[e];
+        }
+
+        delete table;
+      }
+    }
+
+    Blackboard::Table*
+    Blackboard::getTable(uint16_t id) const
+    {
+      if (id > DUNE_IMC_CONST_MAX_ID)
+        return NULL;
+
+#if !defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+      Concurrency::ScopedMutex l(const_cast<Concurrency::Mutex&>(m_lock));
+#endif
+      return m_tables[id];
+    }
+
+    void
+    Blackboard::track(uint16_t id)
+    {
+      if (id > DUNE_IMC_CONST_MAX_ID)
+        return;
+
+      Concurrency::ScopedMutex l(m_lock);
+      if (m_tables[id] != NULL)
+        return;
+
+      Table* table = new Table;
+      table->seq = 0;
+      table->last = NULL;
+      for (unsigned i = 0; i < c_keys; ++i)
+        table->entities[i] = NULL;
+
+      // The table must be complete before it becomes visible.
+      barrier();
+      m_tables[id] = table;
+    }
+
+    void
+    Blackboard::update(SharedMessage* msg)
+    {
+      Table* table = getTable(msg->getId());
+      if (table == NULL)
+        return;
+
+      const Message* m = msg->get();
+      if (m->getSource() != m_resolver.id())
+        return;
+
+      unsigned entity = m->getSourceEntity() & 0xff;
+      unsigned subid = m->getSubId() & 0xff;
+
+      Concurrency::ScopedMutex l(table->lock);
+
+      Slot*& slots = table->entities[entity];
+      if (slots == NULL)
+      {
+        slots = new Slot[c_keys];
+        for (unsigned i = 0; i < c_keys; ++i)
+        {
+          slots[i].msg = NULL;
+          slots[i].seq = 0;
+        }
+      }
+
+      Slot& slot = slots[subid];
+      if (slot.msg != NULL)
+        slot.msg->release();
+
+      slot.msg = msg->acquire();
+      slot.seq = table->seq + 1;
+      table->last = &slot;
+
+      // The slot must be updated before the new sequence number is
+      // seen by pollers.
+      barrier();
+      table->seq = slot.seq;
+    }
+
+    uint32_t
+    Blackboard::getSequence(uint16_t id) const
+    {
+      Table* table = getTable(id);
+      if (table == NULL)
+        return 0;
+
+      uint32_t seq = table->seq;
+      barrier();
+      return seq;
+    }
+
+    SharedMessage*
+    Blackboard::get(uint16_t id, unsigned entity, unsigned subid)
+    {
+      Table* table = getTable(id);
+      if (table == NULL)
+        return NULL;
+
+      Concurrency::ScopedMutex l(table->lock);
+
+      Slot* slots = table->entities[entity & 0xff];
+      if (slots == NULL || slots[subid & 0xff].msg == NULL)
+        return NULL;
+
+      return slots[subid & 0xff].msg->acquire();
+    }
+
+    SharedMessage*
+    Blackboard::getLatest(uint16_t id)
+    {
+      Table* table = getTable(id);
+      if (table == NULL)
+        return NULL;
+
+      Concurrency::ScopedMutex l(table->lock);
+
+      if (table->last == NULL)
+        return NULL;
+
+      return table->last->msg->acquire();
+    }
+
+    uint32_t
+    Blackboard::getChanges(uint16_t id, uint32_t since, std::vector<SharedMessage*>& changes)
+    {
+      Table* table = getTable(id);
+      if (table == NULL)
+        return 0;
+
+      if (getSequence(id) == since)
+        return since;
+
+      Concurrency::ScopedMutex l(table->lock);
+
+      for (unsigned e = 0; e < c_keys; ++e)
+      {
+        Slot* slots = table->entities[e];
+        if (slots == NULL)
+          continue;
+
+        for (unsigned s = 0; s < c_keys; ++s)
+        {
+          if (slots[s].msg != NULL && slots[s].seq > since)
+            changes.push_back(slots[s].msg->acquire());
+        }
+      }
+
+      return table->seq;
+    }
+  }
+}
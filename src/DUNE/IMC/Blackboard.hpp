@@ -0,0 +1,169 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_BLACKBOARD_HPP_INCLUDED_
+#define DUNE_IMC_BLACKBOARD_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/IMC/AddressResolver.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Blackboard;
+
+    //! Store of the latest message of each tracked type dispatched
+    //! by this system, by source entity and sub identifier. The bus
+    //! updates it with the same shared handle it hands out to
+    //! recipients, so messages are not copied again.
+    //!
+    //! Each tracked type has a sequence number that increases with
+    //! every update. Tasks can poll it without locking and only
+    //! fetch messages when it changes, instead of consuming every
+    //! message of that type. Fetching takes a short per-type lock
+    //! and returns an acquired handle that the caller must release.
+    class Blackboard
+    {
+    public:
+      //! Constructor.
+      //! @param[in] resolver address resolver of this system.
+      Blackboard(AddressResolver& resolver);
+
+      //! Destructor.
+      ~Blackboard(void);
+
+      //! Start storing messages of a given type. Calling this
+      //! function for a type that is already tracked has no effect.
+      //! @param[in] id message identification number.
+      void
+      track(uint16_t id);
+
+      //! Test if messages of a given type are stored.
+      //! @param[in] id message identification number.
+      //! @return true if the type is tracked, false otherwise.
+      bool
+      isTracked(uint16_t id) const
+      {
+        return getTable(id) != NULL;
+      }
+
+      //! Store a message if its type is tracked and it was
+      //! dispatched by this system.
+      //! @param[in] msg shared message handle.
+      void
+      update(SharedMessage* msg);
+
+      //! Retrieve the sequence number of a message type. It is zero
+      //! until the first message of the type is stored.
+      //! @param[in] id message identification number.
+      //! @return sequence number.
+      uint32_t
+      getSequence(uint16_t id) const;
+
+      //! Retrieve the latest message of a given type, entity and
+      //! sub identifier.
+      //! @param[in] id message identification number.
+      //! @param[in] entity source entity.
+      //! @param[in] subid sub identifier.
+      //! @return acquired handle or NULL if there is none.
+      SharedMessage*
+      get(uint16_t id, unsigned entity, unsigned subid = 0);
+
+      //! Retrieve the most recent message of a given type, regardless
+      //! of entity and sub identifier.
+      //! @param[in] id message identification number.
+      //! @return acquired handle or NULL if there is none.
+      SharedMessage*
+      getLatest(uint16_t id);
+
+      //! Retrieve the messages of a given type stored after a given
+      //! sequence number.
+      //! @param[in] id message identification number.
+      //! @param[in] since sequence number of the previous call.
+      //! @param[out] changes acquired handles, appended.
+      //! @return current sequence number of the type.
+      uint32_t
+      getChanges(uint16_t id, uint32_t since, std::vector<SharedMessage*>& changes);
+
+    private:
+      //! Number of entities and sub identifiers.
+      static const unsigned c_keys = 256;
+
+      //! Latest message of one entity and sub identifier.
+      struct Slot
+      {
+        //! Message or NULL.
+        SharedMessage* msg;
+        //! Sequence number of the update.
+        uint32_t seq;
+      };
+
+      //! Messages of one type.
+      struct Table
+      {
+        //! Lock guarding the slots.
+        Concurrency::Mutex lock;
+        //! Sequence number of the last update.
+        volatile uint32_t seq;
+        //! Most recently updated slot.
+        Slot* last;
+        //! Slots of each entity, by sub identifier (allocated on use).
+        Slot* entities[c_keys];
+      };
+
+      //! Address resolver.
+      AddressResolver& m_resolver;
+      //! Tables by message identification number.
+      Table* volatile m_tables[DUNE_IMC_CONST_MAX_ID + 1];
+      //! Lock serializing new tables.
+      Concurrency::Mutex m_lock;
+
+      //! Retrieve the table of a message type.
+      //! @param[in] id message identification number.
+      //! @return table or NULL if the type is not tracked.
+      Table*
+      getTable(uint16_t id) const;
+
+      //! Non - copyable.
+      Blackboard(Blackboard const&);
+      //! Non - assignable.
+      Blackboard&
+      operator=(Blackboard const&);
+    };
+  }
+}
+
+#endif
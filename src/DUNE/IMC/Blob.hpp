@@ -47,6 +47,11 @@ namespace DUNE
       //! @return blob's size.
       static unsigned int
       getSize(void);
+
+      //! Retrieve the MD5 digest of the uncompressed XML document.
+      //! @return digest as a lowercase hexadecimal string.
+      static const char*
+      getDigest(void);
     };
   }
 }
@@ -0,0 +1,390 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Utils/ByteCopy.hpp>
+#include <DUNE/Compression/Lz4Compressor.hpp>
+#include <DUNE/Compression/Lz4Decompressor.hpp>
+#include <DUNE/Compression/ZlibCompressor.hpp>
+#include <DUNE/Compression/ZlibDecompressor.hpp>
+#include <DUNE/IMC/BlockLog.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    using Utils::ByteCopy;
+
+    //! Magic number of the file header.
+    static const char c_magic[] = "LSFB";
+    //! Magic number of the trailer.
+    static const char c_index_magic[] = "LSFI";
+    //! Format version.
+    static const uint8_t c_version = 1;
+    //! Size of the file header.
+    static const unsigned c_header_size = 8;
+    //! Size of the trailer.
+    static const unsigned c_trailer_size = 12;
+    //! Size of an index entry, excluding the bitmap.
+    static const unsigned c_entry_size = 36;
+    //! Extra decompression space, to let stream decompressors reach
+    //! the end of each block.
+    static const unsigned c_decompress_slack = 64;
+
+    static uint8_t*
+    put(uint8_t* bfr, uint32_t value)
+    {
+      return bfr + ByteCopy::toLE(value, bfr);
+    }
+
+    static uint8_t*
+    put(uint8_t* bfr, uint64_t value)
+    {
+      bfr = put(bfr, (uint32_t)(value & 0xffffffff));
+      return put(bfr, (uint32_t)(value >> 32));
+    }
+
+    static uint8_t*
+    put(uint8_t* bfr, fp64_t value)
+    {
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return put(bfr, bits);
+    }
+
+    static const uint8_t*
+    get(const uint8_t* bfr, uint32_t& value)
+    {
+      return bfr + ByteCopy::fromLE(value, bfr);
+    }
+
+    static const uint8_t*
+    get(const uint8_t* bfr, uint64_t& value)
+    {
+      uint32_t lo = 0;
+      uint32_t hi = 0;
+      bfr = get(bfr, lo);
+      bfr = get(bfr, hi);
+      value = ((uint64_t)hi << 32) | lo;
+      return bfr;
+    }
+
+    static const uint8_t*
+    get(const uint8_t* bfr, fp64_t& value)
+    {
+      uint64_t bits = 0;
+      bfr = get(bfr, bits);
+      std::memcpy(&value, &bits, sizeof(value));
+      return bfr;
+    }
+
+    void
+    BlockLog::Entry::add(uint32_t pos, uint16_t id, fp64_t time)
+    {
+      if (first == usize)
+      {
+        first = pos;
+        start = time;
+      }
+
+      end = time;
+
+      if ((id / 8U) >= ids.size())
+        ids.resize(id / 8U + 1, 0);
+      ids[id / 8U] |= (1 << (id % 8U));
+    }
+
+    BlockLog::BlockLog(const std::string& path):
+      m_ifs(path.c_str(), std::ios::binary),
+      m_indexed(false),
+      m_dec(NULL)
+    {
+      uint8_t hdr[c_header_size];
+      m_ifs.read((char*)hdr, sizeof(hdr));
+
+      if (!m_ifs || std::memcmp(hdr, c_magic, 4) != 0)
+        throw InvalidBlockLog("bad header in " + path);
+
+      if (hdr[4] != c_version)
+        throw InvalidBlockLog("unsupported version");
+
+      if (hdr[5] > METHOD_ZLIB)
+        throw InvalidBlockLog("unknown compression method");
+
+      m_method = (Method)hdr[5];
+      m_dec = createDecompressor(m_method);
+
+      m_indexed = readIndex();
+      if (!m_indexed)
+        scanBlocks();
+    }
+
+    BlockLog::~BlockLog(void)
+    {
+      delete m_dec;
+    }
+
+    bool
+    BlockLog::readIndex(void)
+    {
+      m_ifs.clear();
+      m_ifs.seekg(0, std::ios::end);
+      uint64_t file_size = m_ifs.tellg();
+      if (file_size < c_header_size + c_trailer_size)
+        return false;
+
+      uint8_t trailer[c_trailer_size];
+      m_ifs.seekg(file_size - c_trailer_size);
+      m_ifs.read((char*)trailer, sizeof(trailer));
+      if (!m_ifs || std::memcmp(trailer + 8, c_index_magic, 4) != 0)
+        return false;
+
+      uint64_t offset = 0;
+      get(trailer, offset);
+      if (offset < c_header_size || offset + 6 > file_size - c_trailer_size)
+        return false;
+
+      Utils::ByteBuffer bfr;
+      bfr.setSize(file_size - c_trailer_size - offset);
+      m_ifs.seekg(offset);
+      m_ifs.read(bfr.getBufferSigned(), bfr.getSize());
+      if (!m_ifs)
+        return false;
+
+      const uint8_t* ptr = bfr.getBuffer();
+      uint32_t count = 0;
+      uint16_t bitmap_size = 0;
+      ptr = get(ptr, count);
+      ptr += ByteCopy::fromLE(bitmap_size, ptr);
+
+      if (6 + count * (uint64_t)(c_entry_size + bitmap_size) != bfr.getSize())
+        return false;
+
+      m_index.resize(count);
+      for (unsigned i = 0; i < count; ++i)
+      {
+        Entry& e = m_index[i];
+        ptr = get(ptr, e.offset);
+        ptr = get(ptr, e.size);
+        ptr = get(ptr, e.usize);
+        ptr = get(ptr, e.first);
+        ptr = get(ptr, e.start);
+        ptr = get(ptr, e.end);
+        e.ids.assign(ptr, ptr + bitmap_size);
+        ptr += bitmap_size;
+      }
+
+      return true;
+    }
+
+    void
+    BlockLog::scanBlocks(void)
+    {
+      m_index.clear();
+      m_ifs.clear();
+      m_ifs.seekg(0, std::ios::end);
+      uint64_t file_size = m_ifs.tellg();
+      uint64_t offset = c_header_size;
+
+      while (offset + c_block_header_size <= file_size)
+      {
+        uint8_t hdr[c_block_header_size];
+        m_ifs.seekg(offset);
+        m_ifs.read((char*)hdr, sizeof(hdr));
+        if (!m_ifs)
+          break;
+
+        Entry e;
+        e.offset = offset;
+        get(get(hdr, e.usize), e.size);
+        e.first = e.usize;
+        e.ids.clear();
+
+        // Stop at a truncated block.
+        if (offset + c_block_header_size + e.size > file_size)
+          break;
+
+        m_index.push_back(e);
+        offset += c_block_header_size + e.size;
+      }
+    }
+
+    unsigned
+    BlockLog::find(fp64_t time) const
+    {
+      for (unsigned i = 0; i < m_index.size(); ++i)
+      {
+        if (m_index[i].end >= time)
+          return i;
+      }
+
+      return m_index.size();
+    }
+
+    void
+    BlockLog::read(unsigned block, Utils::ByteBuffer& data)
+    {
+      const Entry& e = m_index.at(block);
+
+      m_bfr.setSize(e.size);
+      m_ifs.clear();
+      m_ifs.seekg(e.offset + c_block_header_size);
+      m_ifs.read(m_bfr.getBufferSigned(), e.size);
+      if (!m_ifs)
+        throw InvalidBlockLog("truncated block");
+
+      if (m_dec == NULL)
+      {
+        data.write(m_bfr.getBuffer(), e.size);
+        return;
+      }
+
+      data.setSize(e.usize + c_decompress_slack);
+      m_dec->decompress(data.getBufferSigned(), data.getSize(), m_bfr.getBufferSigned(), e.size);
+
+      if (m_dec->decompressed() != e.usize)
+        throw InvalidBlockLog("bad block size");
+
+      data.setSize(e.usize);
+    }
+
+    void
+    BlockLog::writeHeader(std::ostream& os, Method method)
+    {
+      uint8_t hdr[c_header_size] = {0};
+      std::memcpy(hdr, c_magic, 4);
+      hdr[4] = c_version;
+      hdr[5] = (uint8_t)method;
+      os.write((const char*)hdr, sizeof(hdr));
+    }
+
+    void
+    BlockLog::writeBlockHeader(std::ostream& os, const Entry& entry)
+    {
+      uint8_t hdr[c_block_header_size];
+      put(put(hdr, entry.usize), entry.size);
+      os.write((const char*)hdr, sizeof(hdr));
+    }
+
+    void
+    BlockLog::writeIndex(std::ostream& os, const std::vector<Entry>& index)
+    {
+      uint16_t bitmap_size = 0;
+      for (unsigned i = 0; i < index.size(); ++i)
+        bitmap_size = std::max(bitmap_size, (uint16_t)index[i].ids.size());
+
+      uint64_t offset = os.tellp();
+      Utils::ByteBuffer bfr;
+      bfr.setSize(6 + index.size() * (c_entry_size + bitmap_size) + c_trailer_size);
+      uint8_t* ptr = bfr.getBuffer();
+
+      ptr = put(ptr, (uint32_t)index.size());
+      ptr += ByteCopy::toLE(bitmap_size, ptr);
+
+      for (unsigned i = 0; i < index.size(); ++i)
+      {
+        const Entry& e = index[i];
+        ptr = put(ptr, e.offset);
+        ptr = put(ptr, e.size);
+        ptr = put(ptr, e.usize);
+        ptr = put(ptr, e.first);
+        ptr = put(ptr, e.start);
+        ptr = put(ptr, e.end);
+        std::memset(ptr, 0, bitmap_size);
+        if (!e.ids.empty())
+          std::memcpy(ptr, &e.ids[0], e.ids.size());
+        ptr += bitmap_size;
+      }
+
+      ptr = put(ptr, offset);
+      std::memcpy(ptr, c_index_magic, 4);
+
+      os.write(bfr.getBufferSigned(), bfr.getSize());
+    }
+
+    bool
+    BlockLog::detect(const std::string& path)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+      char magic[4];
+      ifs.read(magic, sizeof(magic));
+      return ifs && std::memcmp(magic, c_magic, sizeof(magic)) == 0;
+    }
+
+    bool
+    BlockLog::parseMethod(const std::string& name, Method& method)
+    {
+      if (name == "none")
+        method = METHOD_NONE;
+      else if (name == "lz4")
+        method = METHOD_LZ4;
+      else if (name == "zlib")
+        method = METHOD_ZLIB;
+      else
+        return false;
+
+      return true;
+    }
+
+    Compression::Compressor*
+    BlockLog::createCompressor(Method method)
+    {
+      switch (method)
+      {
+        case METHOD_LZ4:
+          return new Compression::Lz4Compressor;
+        case METHOD_ZLIB:
+          return new Compression::ZlibCompressor;
+        case METHOD_NONE:
+          break;
+      }
+
+      return NULL;
+    }
+
+    Compression::Decompressor*
+    BlockLog::createDecompressor(Method method)
+    {
+      switch (method)
+      {
+        case METHOD_LZ4:
+          return new Compression::Lz4Decompressor;
+        case METHOD_ZLIB:
+          return new Compression::ZlibDecompressor;
+        case METHOD_NONE:
+          break;
+      }
+
+      return NULL;
+    }
+  }
+}
@@ -0,0 +1,252 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_BLOCK_LOG_HPP_INCLUDED_
+#define DUNE_IMC_BLOCK_LOG_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+#include <fstream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+#include <DUNE/IMC/Constants.hpp>
+
+namespace DUNE
+{
+  namespace Compression
+  {
+    // Forward declarations.
+    class Compressor;
+    class Decompressor;
+  }
+
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM BlockLog;
+
+    //! Block logs store an LSF stream split in blocks that are
+    //! compressed independently, so that they can be written in
+    //! parallel and read starting at any block. The file layout is:
+    //!
+    //! - header: magic "LSFB", version (8 bit), compression method
+    //!   (8 bit) and two reserved bytes.
+    //! - blocks: uncompressed size (32 bit), compressed size (32
+    //!   bit) and compressed data.
+    //! - index: number of blocks (32 bit), size of message
+    //!   identifier bitmaps (16 bit) and one entry per block.
+    //! - trailer: offset of the index (64 bit) and magic "LSFI".
+    //!
+    //! The index is only written when the log is closed, the blocks
+    //! of logs without index can still be read. All integers are
+    //! little endian.
+    class BlockLog
+    {
+    public:
+      //! Compression methods.
+      enum Method
+      {
+        //! Uncompressed blocks.
+        METHOD_NONE = 0,
+        //! LZ4 blocks.
+        METHOD_LZ4 = 1,
+        //! Zlib blocks.
+        METHOD_ZLIB = 2
+      };
+
+      //! Index entry of a block.
+      struct Entry
+      {
+        //! Offset of the block in the file.
+        uint64_t offset;
+        //! Compressed size.
+        uint32_t size;
+        //! Uncompressed size.
+        uint32_t usize;
+        //! Offset of the first packet that starts in the block
+        //! (usize if no packet starts in the block).
+        uint32_t first;
+        //! Time stamp of the first packet.
+        fp64_t start;
+        //! Time stamp of the last packet.
+        fp64_t end;
+        //! Bitmap of message identifiers in the block.
+        std::vector<uint8_t> ids;
+
+        Entry(void):
+          offset(0),
+          size(0),
+          usize(0),
+          first(0),
+          start(0),
+          end(0),
+          ids(c_bitmap_size, 0)
+        { }
+
+        //! Record a packet starting in the block. Entries must have
+        //! their uncompressed size and first packet offset set to the
+        //! same value before the first packet is added.
+        //! @param[in] pos offset of the packet in the block.
+        //! @param[in] id message identifier.
+        //! @param[in] time packet time stamp.
+        void
+        add(uint32_t pos, uint16_t id, fp64_t time);
+
+        //! Test if the block holds a message.
+        //! @param[in] id message identifier.
+        //! @return true if at least one packet with the given
+        //! identifier starts in the block.
+        bool
+        contains(uint16_t id) const
+        {
+          return (id / 8U) < ids.size() && (ids[id / 8U] & (1 << (id % 8U)));
+        }
+      };
+
+      //! Size of the block header.
+      static const unsigned c_block_header_size = 8;
+      //! Size of message identifier bitmaps.
+      static const unsigned c_bitmap_size = DUNE_IMC_CONST_MAX_ID / 8U + 1;
+
+      //! Open a block log for reading.
+      //! @param[in] path file path.
+      BlockLog(const std::string& path);
+
+      ~BlockLog(void);
+
+      //! Get the compression method.
+      //! @return compression method.
+      Method
+      getMethod(void) const
+      {
+        return m_method;
+      }
+
+      //! Test if the log has an index. Entries of logs without
+      //! index have no time stamps, message identifiers and packet
+      //! offsets.
+      //! @return true if the log has an index, false otherwise.
+      bool
+      isIndexed(void) const
+      {
+        return m_indexed;
+      }
+
+      //! Get the block index.
+      //! @return block index.
+      const std::vector<Entry>&
+      getIndex(void) const
+      {
+        return m_index;
+      }
+
+      //! Find the first block holding packets at or after a time.
+      //! @param[in] time time stamp.
+      //! @return block number or the number of blocks if none.
+      unsigned
+      find(fp64_t time) const;
+
+      //! Read and decompress a block.
+      //! @param[in] block block number.
+      //! @param[out] data uncompressed data.
+      void
+      read(unsigned block, Utils::ByteBuffer& data);
+
+      //! Write the header of a block log.
+      //! @param[in] os output stream.
+      //! @param[in] method compression method.
+      static void
+      writeHeader(std::ostream& os, Method method);
+
+      //! Write the header of a block.
+      //! @param[in] os output stream.
+      //! @param[in] entry block index entry.
+      static void
+      writeBlockHeader(std::ostream& os, const Entry& entry);
+
+      //! Write the index and trailer of a block log.
+      //! @param[in] os output stream.
+      //! @param[in] index block index.
+      static void
+      writeIndex(std::ostream& os, const std::vector<Entry>& index);
+
+      //! Test if a file is a block log.
+      //! @param[in] path file path.
+      //! @return true if the file starts with a block log header,
+      //! false otherwise.
+      static bool
+      detect(const std::string& path);
+
+      //! Parse a compression method name ("none", "lz4" or "zlib").
+      //! @param[in] name method name.
+      //! @param[out] method compression method.
+      //! @return true if the name is valid, false otherwise.
+      static bool
+      parseMethod(const std::string& name, Method& method);
+
+      //! Create a compressor.
+      //! @param[in] method compression method.
+      //! @return new compressor or NULL for METHOD_NONE.
+      static Compression::Compressor*
+      createCompressor(Method method);
+
+      //! Create a decompressor.
+      //! @param[in] method compression method.
+      //! @return new decompressor or NULL for METHOD_NONE.
+      static Compression::Decompressor*
+      createDecompressor(Method method);
+
+    private:
+      //! Input file.
+      std::ifstream m_ifs;
+      //! Compression method.
+      Method m_method;
+      //! True if the index was read from the file.
+      bool m_indexed;
+      //! Block index.
+      std::vector<Entry> m_index;
+      //! Decompressor.
+      Compression::Decompressor* m_dec;
+      //! Compressed data.
+      Utils::ByteBuffer m_bfr;
+
+      //! Read the index at the end of the file.
+      //! @return true if the index was read, false otherwise.
+      bool
+      readIndex(void);
+
+      //! Rebuild the index from block headers.
+      void
+      scanBlocks(void);
+    };
+  }
+}
+
+#endif
@@ -32,9 +32,14 @@
 #include <DUNE/Streams/Terminal.hpp>
 #include <DUNE/Utils/String.hpp>
 #include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/Blackboard.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/Message.hpp>
 #include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+#include <DUNE/IMC/SubscriptionFilter.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/Delay.hpp>
 
 namespace DUNE
 {
@@ -43,24 +48,153 @@ namespace DUNE
     struct BackLogEntry
     {
       BackLogEntry(const Message* msg, Tasks::AbstractTask* exc):
-        message(msg->clone()),
+        message(SharedMessage::create(msg)),
+        exclude(exc)
+      {  }
+
+      BackLogEntry(SharedMessage* msg, Tasks::AbstractTask* exc):
+        message(msg->acquire()),
         exclude(exc)
       {  }
 
       ~BackLogEntry(void)
       {
-        delete message;
+        message->release();
       }
 
       //! Message.
-      Message* message;
+      SharedMessage* message;
       //! Exclude this task.
       Tasks::AbstractTask* exclude;
     };
 
+    //! Number of slots of the delivery time table of rate limited
+    //! subscriptions.
+    static const unsigned c_rate_slots = 64;
+
+    //! Last delivery time of messages with a given origin.
+    struct RateSlot
+    {
+      //! Source system, source entity and sub identification number.
+      uint64_t key;
+      //! Delivery time.
+      double time;
+    };
+
+    //! Task registered as a recipient of a message, with the filter
+    //! selecting which messages it receives.
+    struct Subscription
+    {
+      Subscription(Tasks::AbstractTask* t, const SubscriptionFilter* f):
+        task(t),
+        filter(NULL),
+        slots(NULL)
+      {
+        if (f == NULL || f->empty())
+          return;
+
+        filter = new SubscriptionFilter(*f);
+        if (filter->getMinimumInterval() > 0)
+        {
+          slots = new RateSlot[c_rate_slots];
+          for (unsigned i = 0; i < c_rate_slots; ++i)
+          {
+            slots[i].key = 0;
+            slots[i].time = -1.0;
+          }
+        }
+      }
+
+      ~Subscription(void)
+      {
+        delete filter;
+        delete [] slots;
+      }
+
+      //! Test if a message should be delivered to the task. Only
+      //! subscriptions with a minimum interval take a lock.
+      //! @param msg message.
+      //! @return true to deliver the message, false otherwise.
+      bool
+      accept(const Message* msg)
+      {
+        if (filter == NULL)
+          return true;
+
+        if (!filter->matches(msg))
+          return false;
+
+        if (slots == NULL)
+          return true;
+
+        // Messages are limited per origin. The table has a fixed size:
+        // when two origins collide the newest takes the slot and its
+        // message is delivered, so collisions never drop messages.
+        uint64_t key = ((uint64_t)msg->getSource() << 24)
+        | ((uint64_t)msg->getSourceEntity() << 16)
+        | msg->getSubId();
+        unsigned idx = (unsigned)((key * 0x9E3779B97F4A7C15ULL) >> 58) & (c_rate_slots - 1);
+        double now = Time::Clock::getCoarse();
+
+        Concurrency::ScopedMutex l(lock);
+        RateSlot& slot = slots[idx];
+        if (slot.key == key && slot.time >= 0
+            && slot.time + filter->getMinimumInterval() > now)
+          return false;
+
+        slot.key = key;
+        slot.time = now;
+        return true;
+      }
+
+      //! Recipient task.
+      Tasks::AbstractTask* task;
+      //! Filter (NULL to deliver all messages).
+      SubscriptionFilter* filter;
+      //! Last delivery times (NULL if not rate limited).
+      RateSlot* slots;
+      //! Lock protecting delivery times.
+      Concurrency::Mutex lock;
+    };
+
+    //! Full memory barrier, used to publish recipient lists to
+    //! dispatching threads without locking.
+    static inline void
+    barrier(void)
+    {
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+      __sync_synchronize();
+#endif
+    }
+
+    //! Marks the end of a dispatch when it goes out of scope.
+    struct ReadSection
+    {
+      ReadSection(Concurrency::AtomicCounter& c):
+        counter(c)
+      { }
+
+      ~ReadSection(void)
+      {
+        counter.sub(1);
+      }
+
+      //! Dispatches in progress in the epoch.
+      Concurrency::AtomicCounter& counter;
+    };
+
     Bus::Bus(void):
-      m_paused(false)
-    { }
+      m_epoch(0),
+      m_quiescent(0),
+      m_paused(false),
+      m_blackboard(NULL)
+    {
+      m_lock.setName("Bus");
+      m_paused_lock.setName("Bus Pause");
+
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+        m_recipients[i] = NULL;
+    }
 
     Bus::~Bus(void)
     {
@@ -73,50 +207,269 @@ namespace DUNE
 
       for (unsigned i = 0; i < m_bind_msgs.size(); ++i)
         delete m_bind_msgs[i];
+
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+      {
+        if (m_recipients[i] == NULL)
+          continue;
+
+        for (unsigned j = 0; j < m_recipients[i]->size(); ++j)
+          delete (*m_recipients[i])[j];
+
+        delete m_recipients[i];
+      }
+
+      for (unsigned i = 0; i < m_retired.size(); ++i)
+        delete m_retired[i];
+
+      for (unsigned i = 0; i < m_retired_subs.size(); ++i)
+        delete m_retired_subs[i];
+
+      for (unsigned i = 0; i < m_waiting.size(); ++i)
+        delete m_waiting[i];
+
+      for (unsigned i = 0; i < m_waiting_subs.size(); ++i)
+        delete m_waiting_subs[i];
+    }
+
+    size_t
+    Bus::find(const RecipientList* lst, const Tasks::AbstractTask* task)
+    {
+      for (size_t i = 0; i < lst->size(); ++i)
+      {
+        if ((*lst)[i]->task == task)
+          return i;
+      }
+
+      return lst->size();
+    }
+
+    Concurrency::AtomicCounter&
+    Bus::enter(void)
+    {
+      // The epoch is read again after announcing the dispatch: a
+      // dispatch is only counted in the epoch that was current when
+      // its counter was incremented.
+      while (true)
+      {
+        unsigned epoch = m_epoch;
+        Concurrency::AtomicCounter& counter = m_readers[epoch & 1];
+        counter.add(1);
+        if (m_epoch == epoch)
+          return counter;
+        counter.sub(1);
+      }
+    }
+
+    void
+    Bus::reclaim(bool force)
+    {
+      // New epochs are started only when the dispatches of the
+      // previous one are finished. Once those of the epoch before the
+      // current one are finished as well, no dispatch can be using
+      // what was retired before the current epoch started.
+      if (m_readers[(m_epoch + 1) & 1].value() != 0)
+        return;
+
+      for (unsigned i = 0; i < m_waiting.size(); ++i)
+        delete m_waiting[i];
+
+      for (unsigned i = 0; i < m_waiting_subs.size(); ++i)
+        delete m_waiting_subs[i];
+
+      m_waiting.clear();
+      m_waiting_subs.clear();
+      m_quiescent = m_epoch;
+
+      if (!force && m_retired.empty() && m_retired_subs.empty())
+        return;
+
+      m_waiting.swap(m_retired);
+      m_waiting_subs.swap(m_retired_subs);
+      barrier();
+      m_epoch = m_epoch + 1;
+      barrier();
     }
 
     void
-    Bus::registerRecipient(Tasks::AbstractTask* task, uint16_t id)
+    Bus::registerRecipient(Tasks::AbstractTask* task, uint16_t id,
+                           const SubscriptionFilter* filter)
     {
+      if (id > DUNE_IMC_CONST_MAX_ID)
+        throw InvalidMessageId(id);
+
       TransportBindings* bind = new TransportBindings;
       bind->setSourceEntity(DUNE_IMC_CONST_SYS_EID);
       bind->setTimeStamp();
       bind->consumer = task->getName();
       bind->message_id = id;
+
+      Concurrency::ScopedMutex l(m_lock);
       m_bind_msgs.push_back(bind);
 
-      Concurrency::ScopedRWLock l(m_lock, true);
-      TransportList::iterator itr = std::find(m_recipients[id].begin(), m_recipients[id].end(), task);
-      if (itr == m_recipients[id].end())
-        m_recipients[id].push_back(task);
+      const RecipientList* old = m_recipients[id];
+      RecipientList* lst = (old == NULL) ? new RecipientList : new RecipientList(*old);
+      Subscription* sub = new Subscription(task, filter);
+
+      size_t idx = find(lst, task);
+      if (idx < lst->size())
+      {
+        m_retired_subs.push_back((*lst)[idx]);
+        (*lst)[idx] = sub;
+      }
+      else
+      {
+        lst->push_back(sub);
+      }
+
+      barrier();
+      m_recipients[id] = lst;
+
+      if (old != NULL)
+        m_retired.push_back(old);
+
+      reclaim(false);
     }
 
     void
     Bus::unregisterRecipient(Tasks::AbstractTask* task, uint16_t id)
     {
-      Concurrency::ScopedRWLock l(m_lock, true);
-      m_recipients[id].remove(task);
+      if (id > DUNE_IMC_CONST_MAX_ID)
+        return;
+
+      Concurrency::ScopedMutex l(m_lock);
+      remove(task, id);
+      reclaim(false);
+    }
+
+    void
+    Bus::unregisterRecipient(Tasks::AbstractTask* task)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+        remove(task, i);
+      reclaim(false);
+    }
+
+    void
+    Bus::remove(Tasks::AbstractTask* task, uint16_t id)
+    {
+      const RecipientList* old = m_recipients[id];
+      if (old == NULL)
+        return;
+
+      size_t idx = find(old, task);
+      if (idx == old->size())
+        return;
+
+      RecipientList* lst = new RecipientList(*old);
+      m_retired_subs.push_back((*lst)[idx]);
+      lst->erase(lst->begin() + idx);
+      barrier();
+      m_recipients[id] = lst;
+      m_retired.push_back(old);
+    }
+
+    void
+    Bus::synchronize(void)
+    {
+      unsigned target = 0;
+
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        target = m_epoch + 1;
+      }
+
+      // Dispatches in progress belong to the current epoch or an
+      // older one: they are all finished when the next epoch is
+      // found quiescent.
+      while (true)
+      {
+        {
+          Concurrency::ScopedMutex l(m_lock);
+          if (m_quiescent - target < (1u << 31))
+            return;
+
+          reclaim(true);
+          if (m_quiescent - target < (1u << 31))
+            return;
+        }
+
+        Time::Delay::waitMsec(1);
+      }
     }
 
     void
     Bus::dispatch(const Message* msg, Tasks::AbstractTask* task)
     {
+      ReadSection section(enter());
+
+      if (m_paused.test(Concurrency::MEMORY_ORDER_ACQUIRE))
       {
         Concurrency::ScopedMutex lock(m_paused_lock);
-        if (m_paused)
+        if (m_paused.test())
         {
           m_back_log.push(new BackLogEntry(msg, task));
           return;
         }
       }
 
-      uint16_t id = msg->getId();
-      Concurrency::ScopedRWLock l(m_lock);
-      TransportList& dlst(m_recipients[id]);
-      for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
+      // The message is copied at most once and shared by all
+      // recipients and the blackboard. Filters are evaluated first,
+      // so a message nobody accepts is never copied.
+      SharedMessage* shared = NULL;
+
+      if (m_blackboard != NULL && m_blackboard->isTracked(msg->getId()))
+      {
+        shared = SharedMessage::create(msg);
+        m_blackboard->update(shared);
+      }
+
+      const RecipientList* lst = getRecipients(msg->getId());
+      if (lst != NULL)
+      {
+        for (RecipientList::const_iterator itr = lst->begin(); itr != lst->end(); ++itr)
+        {
+          if ((*itr)->task == task || !(*itr)->accept(msg))
+            continue;
+
+          if (shared == NULL)
+            shared = SharedMessage::create(msg);
+
+          (*itr)->task->receive(shared);
+        }
+      }
+
+      if (shared != NULL)
+        shared->release();
+    }
+
+    void
+    Bus::dispatch(SharedMessage* msg, Tasks::AbstractTask* task)
+    {
+      ReadSection section(enter());
+
+      if (m_paused.test(Concurrency::MEMORY_ORDER_ACQUIRE))
+      {
+        Concurrency::ScopedMutex lock(m_paused_lock);
+        if (m_paused.test())
+        {
+          m_back_log.push(new BackLogEntry(msg, task));
+          return;
+        }
+      }
+
+      if (m_blackboard != NULL)
+        m_blackboard->update(msg);
+
+      const RecipientList* lst = getRecipients(msg->getId());
+      if (lst == NULL)
+        return;
+
+      for (RecipientList::const_iterator itr = lst->begin(); itr != lst->end(); ++itr)
       {
-        if (*itr != task)
-          (*itr)->receive(msg);
+        if ((*itr)->task != task && (*itr)->accept(msg->get()))
+          (*itr)->task->receive(msg);
       }
     }
 
@@ -124,7 +477,7 @@ namespace DUNE
     Bus::resume(void)
     {
       m_paused_lock.lock();
-      m_paused = false;
+      m_paused.clear();
       m_paused_lock.unlock();
 
       while (!m_back_log.empty())
@@ -141,6 +494,7 @@ namespace DUNE
     const std::vector<TransportBindings*>
     Bus::getBindings(void)
     {
+      Concurrency::ScopedMutex l(m_lock);
       return m_bind_msgs;
     }
   }
@@ -39,9 +39,12 @@
 
 // DUNE headers.
 #include <DUNE/Tasks/AbstractTask.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
-#include <DUNE/Concurrency/ScopedRWLock.hpp>
+#include <DUNE/Concurrency/AtomicFlag.hpp>
+#include <DUNE/Concurrency/AtomicCounter.hpp>
+#include <DUNE/IMC/Constants.hpp>
 
 namespace DUNE
 {
@@ -49,6 +52,9 @@ namespace DUNE
   {
     // Forward declarations.
     struct BackLogEntry;
+    struct Subscription;
+    class Blackboard;
+    class SubscriptionFilter;
     class TransportBindings;
 
     // Export DLL Symbol.
@@ -64,11 +70,17 @@ namespace DUNE
       ~Bus(void);
 
       //! Register a task as a recipient a given message
-      //! identification number.
+      //! identification number. Registering a task again replaces
+      //! its filter.
       //! @param task task object.
       //! @param id message identification number.
+      //! @param filter messages delivered to the task (NULL to
+      //! deliver all). The filter is copied.
+      //! @throw InvalidMessageId if the identification number is out
+      //! of range.
       void
-      registerRecipient(Tasks::AbstractTask* task, uint16_t id);
+      registerRecipient(Tasks::AbstractTask* task, uint16_t id,
+                        const SubscriptionFilter* filter = NULL);
 
       //! Unregister a task as a recipient of a given message
       //! identification number.
@@ -77,17 +89,46 @@ namespace DUNE
       void
       unregisterRecipient(Tasks::AbstractTask* task, uint16_t id);
 
+      //! Unregister a task as a recipient of all messages.
+      //! @param task task object.
+      void
+      unregisterRecipient(Tasks::AbstractTask* task);
+
+      //! Wait until every dispatch in progress when this function was
+      //! called has finished and release the recipient lists retired
+      //! until then. After unregistering a task, this guarantees that
+      //! no thread is still delivering messages to it. Must not be
+      //! called while dispatching.
+      void
+      synchronize(void);
+
       //! Dispatches a message to registered listeners.
       //! @param msg message to dispatch.
       //! @param task do not deliver message to this task.
       void
       dispatch(const Message* msg, Tasks::AbstractTask* task = NULL);
 
+      //! Dispatches a shared message to registered listeners without
+      //! copying it. The caller keeps its reference to the handle.
+      //! @param msg shared message handle.
+      //! @param task do not deliver message to this task.
+      void
+      dispatch(SharedMessage* msg, Tasks::AbstractTask* task = NULL);
+
+      //! Set the store updated with the latest messages dispatched.
+      //! Must be called before tasks start.
+      //! @param blackboard latest-value store.
+      void
+      setBlackboard(Blackboard* blackboard)
+      {
+        m_blackboard = blackboard;
+      }
+
       inline void
       pause(void)
       {
         Concurrency::ScopedMutex lock(m_paused_lock);
-        m_paused = true;
+        m_paused.testAndSet();
       }
 
       void
@@ -97,20 +138,84 @@ namespace DUNE
       getBindings(void);
 
     private:
-      typedef std::list<Tasks::AbstractTask*> TransportList;
-      //! Table of recipients.
-      std::map<uint16_t, TransportList> m_recipients;
-      //! Internal list lock.
-      Concurrency::RWLock m_lock;
-      //! Bus is paused.
-      bool m_paused;
+      typedef std::vector<Subscription*> RecipientList;
+      //! Table of recipients indexed by message identification
+      //! number. Lists are never modified in place: writers publish a
+      //! new copy, so dispatching does not take any lock.
+      const RecipientList* volatile m_recipients[DUNE_IMC_CONST_MAX_ID + 1];
+      //! Lists replaced by writers since the last epoch change.
+      std::vector<const RecipientList*> m_retired;
+      //! Subscriptions replaced or removed by writers since the last
+      //! epoch change.
+      std::vector<Subscription*> m_retired_subs;
+      //! Lists retired before the last epoch change, released once
+      //! the dispatches of the previous epoch have finished.
+      std::vector<const RecipientList*> m_waiting;
+      //! Subscriptions retired before the last epoch change.
+      std::vector<Subscription*> m_waiting_subs;
+      //! Current epoch. Changed by writers with the lock held.
+      volatile unsigned m_epoch;
+      //! Last epoch in which all dispatches of the previous epoch were
+      //! found to be finished.
+      unsigned m_quiescent;
+      //! Number of dispatches in progress, indexed by epoch parity.
+      Concurrency::AtomicCounter m_readers[2];
+      //! Lock serializing changes to the table of recipients.
+      Concurrency::Mutex m_lock;
+      //! Bus is paused. Tested without locking by dispatchers.
+      Concurrency::AtomicFlag m_paused;
       //! Pause lock.
       Concurrency::Mutex m_paused_lock;
       //! List containing all generated TransportBindings for future logging/reference.
       std::vector<TransportBindings*> m_bind_msgs;
+      //! Latest-value store (may be NULL).
+      Blackboard* m_blackboard;
       //! Back log queue. Saves messages when Bus is paused.
       Concurrency::TSQueue<BackLogEntry*> m_back_log;
 
+      //! Retrieve the current list of recipients of a given message.
+      //! @param id message identification number.
+      //! @return list of recipients or NULL if there are none.
+      const RecipientList*
+      getRecipients(uint16_t id)
+      {
+        if (id > DUNE_IMC_CONST_MAX_ID)
+          return NULL;
+
+#if !defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+        Concurrency::ScopedMutex l(m_lock);
+#endif
+        return m_recipients[id];
+      }
+
+      //! Find the subscription of a task in a list of recipients.
+      //! @param lst list of recipients.
+      //! @param task task object.
+      //! @return position of the subscription or lst->size() if the
+      //! task is not subscribed.
+      static size_t
+      find(const RecipientList* lst, const Tasks::AbstractTask* task);
+
+      //! Announce a dispatch in the current epoch.
+      //! @return counter of dispatches of the epoch, to be
+      //! decremented when the dispatch is done.
+      Concurrency::AtomicCounter&
+      enter(void);
+
+      //! Release retired lists no dispatch can be using and, if there
+      //! are lists waiting to be retired or force is true, start a new
+      //! epoch. Does not block. Must be called with the lock held.
+      //! @param force start a new epoch even with nothing retired.
+      void
+      reclaim(bool force);
+
+      //! Remove a task from the list of recipients of a message. Must
+      //! be called with the lock held.
+      //! @param task task object.
+      //! @param id message identification number.
+      void
+      remove(Tasks::AbstractTask* task, uint16_t id);
+
       //! Non - copyable.
       Bus(Bus const&);
 
@@ -0,0 +1,507 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/IMC/CompactCodec.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/Utils/BitBuffer.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Maximum size of an encoded message.
+    static const unsigned c_max_size = 2048;
+
+    //! Quantize a real value.
+    //! @param[in] value value.
+    //! @param[in] precision quantization step.
+    //! @return number of steps.
+    static double
+    quantize(double value, double precision)
+    {
+      return std::floor(value / precision + 0.5);
+    }
+
+    //! Get the largest value that fits in a number of bits.
+    //! @param[in] bits number of bits.
+    //! @return largest value.
+    static uint64_t
+    getMask(unsigned bits)
+    {
+      return (bits >= 64) ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1);
+    }
+
+    class CompactCodec::Writer
+    {
+    public:
+      //! Constructor.
+      Writer(void):
+        m_bfr(c_max_size)
+      { }
+
+      //! Get number of bytes written.
+      //! @return number of bytes.
+      unsigned
+      getSize(void)
+      {
+        return (unsigned)((m_bfr.getBitsize() + 7) / 8);
+      }
+
+      //! Get written data.
+      //! @return written data.
+      const char*
+      getData(void)
+      {
+        return (const char*)m_bfr.getBuffer();
+      }
+
+      //! Write an unsigned integer.
+      //! @param[in] value value.
+      //! @param[in] bits number of bits.
+      void
+      putUnsigned(uint64_t value, unsigned bits)
+      {
+        if (m_bfr.getBitsize() + bits > c_max_size * 8)
+          throw InternalBufferTooShort();
+
+        for (unsigned i = 0; i < bits; i += 8)
+          m_bfr.appendData((uint8_t)(value >> i), std::min(8u, bits - i));
+      }
+
+      //! Write an integer as an offset to the minimum of its range,
+      //! saturating at the range limits.
+      //! @param[in] value value.
+      //! @param[in] min minimum value.
+      //! @param[in] bits number of bits.
+      void
+      putInteger(int64_t value, int64_t min, unsigned bits)
+      {
+        uint64_t steps = 0;
+        if (value > min)
+          steps = std::min((uint64_t)value - (uint64_t)min, getMask(bits));
+        putUnsigned(steps, bits);
+      }
+
+      //! Write a real number quantized to its range, saturating at
+      //! the range limits (NaN is written as the minimum).
+      //! @param[in] value value.
+      //! @param[in] min minimum value.
+      //! @param[in] precision quantization step.
+      //! @param[in] bits number of bits.
+      void
+      putReal(double value, double min, double precision, unsigned bits)
+      {
+        double steps = quantize(value - min, precision);
+        double max = (double)getMask(bits);
+        // Negation also catches NaN.
+        if (!(steps > 0))
+          steps = 0;
+        else if (steps > max)
+          steps = max;
+        putUnsigned((uint64_t)steps, bits);
+      }
+
+      //! Write a real number as a difference to a reference, if it
+      //! fits in the given number of bits, or quantized to its range
+      //! otherwise.
+      //! @param[in] value value.
+      //! @param[in] ref reference value.
+      //! @param[in] has_ref true if there is a reference value.
+      //! @param[in] min minimum value.
+      //! @param[in] precision quantization step.
+      //! @param[in] bits number of bits of the quantized value.
+      //! @param[in] delta_bits number of bits of the difference.
+      void
+      putDelta(double value, double ref, bool has_ref, double min, double precision,
+               unsigned bits, unsigned delta_bits)
+      {
+        if (has_ref)
+        {
+          double steps = quantize(value - ref, precision);
+          double half = (double)((uint64_t)1 << (delta_bits - 1));
+          if (steps > -half && steps < half)
+          {
+            putUnsigned(1, 1);
+            putUnsigned((uint64_t)(steps + half), delta_bits);
+            return;
+          }
+        }
+
+        putUnsigned(0, 1);
+        putReal(value, min, precision, bits);
+      }
+
+      //! Write a single precision real number.
+      //! @param[in] value value.
+      void
+      putFP32(fp32_t value)
+      {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putUnsigned(bits, 32);
+      }
+
+      //! Write a double precision real number.
+      //! @param[in] value value.
+      void
+      putFP64(fp64_t value)
+      {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putUnsigned(bits, 64);
+      }
+
+      //! Write a string of up to 255 characters.
+      //! @param[in] value string.
+      void
+      putText(const std::string& value)
+      {
+        putBytes(value.data(), value.size());
+      }
+
+      //! Write up to 255 bytes of raw data.
+      //! @param[in] value data.
+      void
+      putData(const std::vector<char>& value)
+      {
+        putBytes(value.empty() ? NULL : &value[0], value.size());
+      }
+
+    private:
+      //! Bit buffer.
+      Utils::BitBuffer m_bfr;
+
+      //! Write up to 255 bytes preceded by their count.
+      //! @param[in] data bytes.
+      //! @param[in] size number of bytes.
+      void
+      putBytes(const char* data, size_t size)
+      {
+        if (size > 255)
+          throw InvalidMessageSize(size);
+
+        putUnsigned(size, 8);
+        for (size_t i = 0; i < size; ++i)
+          putUnsigned((uint8_t)data[i], 8);
+      }
+    };
+
+    class CompactCodec::Reader
+    {
+    public:
+      //! Constructor.
+      //! @param[in] id identification number of the message.
+      //! @param[in] data encoded data.
+      //! @param[in] size size of encoded data.
+      Reader(uint16_t id, const char* data, unsigned size):
+        m_bfr(std::max(size, 1u)),
+        m_id(id),
+        m_pos(0)
+      {
+        m_bfr.write((const uint8_t*)data, size);
+      }
+
+      //! Get number of bytes read.
+      //! @return number of bytes.
+      unsigned
+      getSize(void) const
+      {
+        return (unsigned)((m_pos + 7) / 8);
+      }
+
+      //! Read an unsigned integer.
+      //! @param[in] bits number of bits.
+      //! @return value.
+      uint64_t
+      getUnsigned(unsigned bits)
+      {
+        if (m_pos + bits > (uint64_t)m_bfr.getSize() * 8)
+          throw BufferTooShort();
+
+        uint64_t value = 0;
+        for (unsigned i = 0; i < bits; i += 8)
+        {
+          uint8_t n = std::min(8u, bits - i);
+          value |= (uint64_t)m_bfr.getData(m_pos, n) << i;
+          m_pos += n;
+        }
+
+        return value;
+      }
+
+      //! Read an integer written with putInteger().
+      //! @param[in] min minimum value.
+      //! @param[in] bits number of bits.
+      //! @return value.
+      int64_t
+      getInteger(int64_t min, unsigned bits)
+      {
+        return (int64_t)((uint64_t)min + getUnsigned(bits));
+      }
+
+      //! Read a real number written with putReal().
+      //! @param[in] min minimum value.
+      //! @param[in] precision quantization step.
+      //! @param[in] bits number of bits.
+      //! @return value.
+      double
+      getReal(double min, double precision, unsigned bits)
+      {
+        return min + (double)getUnsigned(bits) * precision;
+      }
+
+      //! Read a real number written with putDelta().
+      //! @param[in] ref reference value.
+      //! @param[in] has_ref true if there is a reference value.
+      //! @param[in] min minimum value.
+      //! @param[in] precision quantization step.
+      //! @param[in] bits number of bits of the quantized value.
+      //! @param[in] delta_bits number of bits of the difference.
+      //! @return value.
+      double
+      getDelta(double ref, bool has_ref, double min, double precision,
+               unsigned bits, unsigned delta_bits)
+      {
+        if (getUnsigned(1) == 0)
+          return getReal(min, precision, bits);
+
+        if (!has_ref)
+          throw MissingReference(m_id);
+
+        double half = (double)((uint64_t)1 << (delta_bits - 1));
+        return ref + ((double)getUnsigned(delta_bits) - half) * precision;
+      }
+
+      //! Read a single precision real number.
+      //! @return value.
+      fp32_t
+      getFP32(void)
+      {
+        uint32_t bits = (uint32_t)getUnsigned(32);
+        fp32_t value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      //! Read a double precision real number.
+      //! @return value.
+      fp64_t
+      getFP64(void)
+      {
+        uint64_t bits = getUnsigned(64);
+        fp64_t value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+      }
+
+      //! Read a string written with putText().
+      //! @param[out] value string.
+      void
+      getText(std::string& value)
+      {
+        value.resize(getUnsigned(8));
+        for (size_t i = 0; i < value.size(); ++i)
+          value[i] = (char)getUnsigned(8);
+      }
+
+      //! Read raw data written with putData().
+      //! @param[out] value data.
+      void
+      getData(std::vector<char>& value)
+      {
+        value.resize(getUnsigned(8));
+        for (size_t i = 0; i < value.size(); ++i)
+          value[i] = (char)getUnsigned(8);
+      }
+
+      //! Skip bits.
+      //! @param[in] bits number of bits.
+      void
+      skip(unsigned bits)
+      {
+        m_pos += bits;
+      }
+
+    private:
+      //! Bit buffer.
+      Utils::BitBuffer m_bfr;
+      //! Identification number of the message being decoded.
+      uint16_t m_id;
+      //! Read position in bits.
+      uint64_t m_pos;
+    };
+
+    //! Compact encoding functions of a message.
+    struct CompactEntry
+    {
+      //! Compact identifier.
+      uint8_t compact_id;
+      //! Message identification number.
+      uint16_t id;
+      //! Encoder.
+      void (*encode)(const Message&, const Message*, CompactCodec::Writer&);
+      //! Decoder.
+      void (*decode)(Message&, const Message*, CompactCodec::Reader&);
+    };
+
+#include <DUNE/IMC/CompactCodec.def>
+
+    //! Number of compact encoded messages.
+    static const unsigned c_compact_count = sizeof(c_compact_entries) / sizeof(c_compact_entries[0]);
+
+    //! Find the compact encoding functions of a message.
+    //! @param[in] id message identification number.
+    //! @return encoding functions or NULL.
+    static const CompactEntry*
+    findById(uint16_t id)
+    {
+      for (unsigned i = 0; i < c_compact_count; ++i)
+      {
+        if (c_compact_entries[i].id == id)
+          return &c_compact_entries[i];
+      }
+
+      return NULL;
+    }
+
+    //! Find the compact encoding functions of a message.
+    //! @param[in] compact_id compact identifier.
+    //! @return encoding functions or NULL.
+    static const CompactEntry*
+    findByCompactId(uint8_t compact_id)
+    {
+      for (unsigned i = 0; i < c_compact_count; ++i)
+      {
+        if (c_compact_entries[i].compact_id == compact_id)
+          return &c_compact_entries[i];
+      }
+
+      return NULL;
+    }
+
+    CompactCodec::CompactCodec(void)
+    { }
+
+    CompactCodec::~CompactCodec(void)
+    {
+      clearReferences();
+    }
+
+    bool
+    CompactCodec::isSupported(uint16_t id)
+    {
+      return findById(id) != NULL;
+    }
+
+    bool
+    CompactCodec::getMessageId(uint8_t compact_id, uint16_t& id)
+    {
+      const CompactEntry* entry = findByCompactId(compact_id);
+      if (entry == NULL)
+        return false;
+
+      id = entry->id;
+      return true;
+    }
+
+    void
+    CompactCodec::setReference(const Message& msg)
+    {
+      Message*& ref = m_refs[msg.getId()];
+      delete ref;
+      ref = msg.clone();
+    }
+
+    void
+    CompactCodec::clearReferences(void)
+    {
+      std::map<uint16_t, Message*>::iterator itr = m_refs.begin();
+      for (; itr != m_refs.end(); ++itr)
+        delete itr->second;
+      m_refs.clear();
+    }
+
+    const Message*
+    CompactCodec::getReference(uint16_t id) const
+    {
+      std::map<uint16_t, Message*>::const_iterator itr = m_refs.find(id);
+      if (itr == m_refs.end())
+        return NULL;
+      return itr->second;
+    }
+
+    unsigned
+    CompactCodec::encode(const Message& msg, std::vector<char>& bfr) const
+    {
+      const CompactEntry* entry = findById(msg.getId());
+      if (entry == NULL)
+        throw InvalidMessageId(msg.getId());
+
+      Writer writer;
+      writer.putUnsigned(entry->compact_id, 8);
+      entry->encode(msg, getReference(entry->id), writer);
+
+      bfr.insert(bfr.end(), writer.getData(), writer.getData() + writer.getSize());
+      return writer.getSize();
+    }
+
+    Message*
+    CompactCodec::decode(const char* data, unsigned size, unsigned& used) const
+    {
+      if (size == 0)
+        throw BufferTooShort();
+
+      const CompactEntry* entry = findByCompactId((uint8_t)data[0]);
+      if (entry == NULL)
+        throw InvalidMessageId((uint8_t)data[0]);
+
+      Message* msg = Factory::produce(entry->id);
+      try
+      {
+        Reader reader(entry->id, data, size);
+        reader.skip(8);
+        entry->decode(*msg, getReference(entry->id), reader);
+        used = reader.getSize();
+      }
+      catch (...)
+      {
+        delete msg;
+        throw;
+      }
+
+      return msg;
+    }
+  }
+}
@@ -0,0 +1,142 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_COMPACT_CODEC_HPP_INCLUDED_
+#define DUNE_IMC_COMPACT_CODEC_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM CompactCodec;
+
+    //! Compact encoding of IMC messages for low-bandwidth links
+    //! (acoustic modems, satellite). Messages with a 'compact-id'
+    //! attribute in the IMC XML document are bit-packed field by
+    //! field: real fields with a 'compact-precision' are quantized
+    //! to the range given by 'compact-min'/'compact-max' (or
+    //! 'min'/'max'), integers use the bits needed by their range or
+    //! enumeration, and other fields are stored verbatim. Fields
+    //! with a 'compact-delta' are sent as a difference to a
+    //! reference message whenever it fits within that delta.
+    //!
+    //! An encoded message takes a whole number of bytes, starting
+    //! with its compact identifier, so several messages can be
+    //! concatenated in one frame. The header (addresses, entities
+    //! and timestamp) is not encoded: the transport must convey
+    //! what it needs.
+    //!
+    //! References are not exchanged: both ends must be given the
+    //! same references (e.g., the last message acknowledged by the
+    //! receiver) before delta-encoded messages can be decoded.
+    class CompactCodec
+    {
+    public:
+      //! Bit writer used by the generated encoders.
+      class Writer;
+      //! Bit reader used by the generated decoders.
+      class Reader;
+
+      //! Constructor.
+      CompactCodec(void);
+
+      //! Destructor.
+      ~CompactCodec(void);
+
+      //! Test if a message can be compact encoded.
+      //! @param[in] id message identification number.
+      //! @return true if the message can be encoded, false otherwise.
+      static bool
+      isSupported(uint16_t id);
+
+      //! Get the message identification number of a compact
+      //! identifier (the first byte of an encoded message).
+      //! @param[in] compact_id compact identifier.
+      //! @param[out] id message identification number.
+      //! @return true if the compact identifier is known, false
+      //! otherwise.
+      static bool
+      getMessageId(uint8_t compact_id, uint16_t& id);
+
+      //! Set the reference of delta-encoded fields for messages of
+      //! the same type. The message is copied.
+      //! @param[in] msg reference message.
+      void
+      setReference(const Message& msg);
+
+      //! Remove all references.
+      void
+      clearReferences(void);
+
+      //! Encode a message, appending it to a buffer.
+      //! @param[in] msg message.
+      //! @param[out] bfr destination buffer.
+      //! @return number of bytes appended.
+      //! @throw InvalidMessageId if the message cannot be compact
+      //! encoded.
+      unsigned
+      encode(const Message& msg, std::vector<char>& bfr) const;
+
+      //! Decode a message.
+      //! @param[in] data encoded data.
+      //! @param[in] size size of encoded data.
+      //! @param[out] used number of bytes used by the message.
+      //! @return decoded message, owned by the caller.
+      //! @throw InvalidMessageId if the message is unknown.
+      //! @throw BufferTooShort if the message is truncated.
+      //! @throw MissingReference if the message needs a reference
+      //! that was not set.
+      Message*
+      decode(const char* data, unsigned size, unsigned& used) const;
+
+    private:
+      //! Reference messages by identification number.
+      std::map<uint16_t, Message*> m_refs;
+
+      //! Get the reference of a message.
+      //! @param[in] id message identification number.
+      //! @return reference message or NULL.
+      const Message*
+      getReference(uint16_t id) const;
+
+      // Non-copyable.
+      CompactCodec(const CompactCodec&);
+      CompactCodec& operator=(const CompactCodec&);
+    };
+  }
+}
+
+#endif
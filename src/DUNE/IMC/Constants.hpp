@@ -33,7 +33,7 @@
 //! IMC version string.
 #define DUNE_IMC_CONST_VERSION "5.4.x"
 //! MD5 sum of XML specification file.
-#define DUNE_IMC_CONST_MD5 "ee7587bb3cbc6548b138155ed050234e"
+#define DUNE_IMC_CONST_MD5 "96bf06ac37c30bce40a3962ea43970cd"
 //! Synchronization number.
 #define DUNE_IMC_CONST_SYNC 0xFE54
 //! Reversed synchronization number.
@@ -46,6 +46,8 @@
 #define DUNE_IMC_CONST_NULL_ID 65535
 //! Maximum message data size.
 #define DUNE_IMC_CONST_MAX_SIZE 65535
+//! Largest message identification number.
+#define DUNE_IMC_CONST_MAX_ID 820
 //! Unknown entity identifier.
 #define DUNE_IMC_CONST_UNK_EID 255
 //! System entity identifier.
@@ -90,6 +90,9 @@ namespace DUNE
 
       EntityState(void);
 
+      void
+      swap(EntityState& other__);
+
       Message*
       clone(void) const
       {
@@ -140,6 +143,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Query Entity State.
@@ -218,6 +227,9 @@ namespace DUNE
 
       EntityInfo(void);
 
+      void
+      swap(EntityInfo& other__);
+
       Message*
       clone(void) const
       {
@@ -274,6 +286,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Query Entity Information.
@@ -341,6 +359,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Entity List.
@@ -369,6 +393,9 @@ namespace DUNE
 
       EntityList(void);
 
+      void
+      swap(EntityList& other__);
+
       Message*
       clone(void) const
       {
@@ -419,6 +446,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Entity Control.
@@ -489,6 +522,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! CPU Usage.
@@ -556,6 +595,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Transport Bindings.
@@ -575,6 +620,9 @@ namespace DUNE
 
       TransportBindings(void);
 
+      void
+      swap(TransportBindings& other__);
+
       Message*
       clone(void) const
       {
@@ -625,6 +673,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Restart System.
@@ -699,6 +753,9 @@ namespace DUNE
 
       Parameter(void);
 
+      void
+      swap(Parameter& other__);
+
       Message*
       clone(void) const
       {
@@ -749,6 +806,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Parameters Control.
@@ -783,6 +846,14 @@ namespace DUNE
 
       ParameterControl(void);
 
+      ParameterControl(const ParameterControl& other__);
+
+      void
+      swap(ParameterControl& other__);
+
+      ParameterControl&
+      operator=(const ParameterControl& other__);
+
       Message*
       clone(void) const
       {
@@ -834,6 +905,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -923,6 +1000,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Device Calibration State.
@@ -961,6 +1044,9 @@ namespace DUNE
 
       DevCalibrationState(void);
 
+      void
+      swap(DevCalibrationState& other__);
+
       Message*
       clone(void) const
       {
@@ -1011,6 +1097,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Entity Activation State.
@@ -1051,6 +1143,9 @@ namespace DUNE
 
       EntityActivationState(void);
 
+      void
+      swap(EntityActivationState& other__);
+
       Message*
       clone(void) const
       {
@@ -1101,6 +1196,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Query Entity Activation State.
@@ -1260,61 +1361,44 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Simulated State.
-    class SimulatedState: public Message
+    //! Delivery Statistics.
+    class DeliveryStatistics: public Message
     {
     public:
-      //! Latitude (WGS-84).
-      fp64_t lat;
-      //! Longitude (WGS-84).
-      fp64_t lon;
-      //! Height (WGS-84).
-      fp32_t height;
-      //! Offset north (m).
-      fp32_t x;
-      //! Offset east (m).
-      fp32_t y;
-      //! Offset down (m).
-      fp32_t z;
-      //! Rotation over x axis.
-      fp32_t phi;
-      //! Rotation over y axis.
-      fp32_t theta;
-      //! Rotation over z axis.
-      fp32_t psi;
-      //! Body-Fixed xx Linear Velocity.
-      fp32_t u;
-      //! Body-Fixed yy Linear Velocity.
-      fp32_t v;
-      //! Body-Fixed zz Linear Velocity.
-      fp32_t w;
-      //! Angular Velocity in x.
-      fp32_t p;
-      //! Angular Velocity in y.
-      fp32_t q;
-      //! Angular Velocity in z.
-      fp32_t r;
-      //! Stream Velocity X (North).
-      fp32_t svx;
-      //! Stream Velocity Y (East).
-      fp32_t svy;
-      //! Stream Velocity Z (Down).
-      fp32_t svz;
+      //! Message Identifier.
+      uint16_t message_id;
+      //! Count.
+      uint32_t count;
+      //! Mean Latency.
+      fp32_t lat_mean;
+      //! Maximum Latency.
+      fp32_t lat_max;
+      //! Latency Histogram.
+      std::string histogram;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 50;
+        return 17;
       }
 
-      SimulatedState(void);
+      DeliveryStatistics(void);
+
+      void
+      swap(DeliveryStatistics& other__);
 
       Message*
       clone(void) const
       {
-        return new SimulatedState(*this);
+        return new DeliveryStatistics(*this);
       }
 
       void
@@ -1338,55 +1422,80 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SimulatedState::getIdStatic();
+        return DeliveryStatistics::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SimulatedState";
+        return "DeliveryStatistics";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 80;
+        return 14;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(histogram);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Leak Simulation.
-    class LeakSimulation: public Message
+    //! Mailbox Statistics.
+    class MailboxStatistics: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
-      {
-        //! Leaks Off.
-        LSIM_OFF = 0,
-        //! Leaks On.
-        LSIM_ON = 1
-      };
-
-      //! Operation.
-      uint8_t op;
-      //! Leak Entities.
-      std::string entities;
+      //! Consumer Name.
+      std::string consumer;
+      //! Queue Size.
+      uint32_t size;
+      //! Queue Capacity.
+      uint32_t capacity;
+      //! High-Water Mark.
+      uint32_t high_water;
+      //! Dropped Messages.
+      uint32_t dropped;
+      //! Priority Queue Size.
+      uint32_t priority_size;
+      //! Priority Maximum Latency.
+      fp32_t priority_lat_max;
+      //! Bulk Maximum Latency.
+      fp32_t bulk_lat_max;
+      //! Deliveries.
+      MessageList<DeliveryStatistics> deliveries;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 51;
+        return 18;
       }
 
-      LeakSimulation(void);
+      MailboxStatistics(void);
+
+      MailboxStatistics(const MailboxStatistics& other__);
+
+      void
+      swap(MailboxStatistics& other__);
+
+      MailboxStatistics&
+      operator=(const MailboxStatistics& other__);
 
       Message*
       clone(void) const
       {
-        return new LeakSimulation(*this);
+        return new MailboxStatistics(*this);
       }
 
       void
@@ -1410,65 +1519,91 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LeakSimulation::getIdStatic();
+        return MailboxStatistics::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LeakSimulation";
+        return "MailboxStatistics";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 28;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(entities);
+        return IMC::getSerializationSize(consumer) + deliveries.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Underwater Acoustics Simulation.
-    class UASimulation: public Message
+    //! Trace Hop.
+    class TraceHop: public Message
     {
     public:
-      //! Type.
-      enum TypeEnum
+      //! Event.
+      enum EventEnum
       {
-        //! Data Transmission.
-        UAS_DATA = 0,
-        //! Ping.
-        UAS_PING = 1,
-        //! Ping Reply.
-        UAS_PING_REPLY = 2
+        //! Dispatched.
+        THE_DISPATCHED = 0,
+        //! Consumed.
+        THE_CONSUMED = 1
       };
 
-      //! Type.
-      uint8_t type;
-      //! Transmission Speed.
-      uint16_t speed;
-      //! Data.
-      std::vector<char> data;
+      //! Trace Identifier.
+      uint32_t trace_id;
+      //! Origin.
+      uint16_t origin;
+      //! Message Identifier.
+      uint16_t message_id;
+      //! Cause.
+      uint16_t cause;
+      //! Event.
+      uint8_t event;
+      //! Latency.
+      fp32_t latency;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 52;
+        return 19;
       }
 
-      UASimulation(void);
+      TraceHop(void);
 
       Message*
       clone(void) const
       {
-        return new UASimulation(*this);
+        return new TraceHop(*this);
       }
 
       void
@@ -1492,65 +1627,52 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return UASimulation::getIdStatic();
+        return TraceHop::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "UASimulation";
+        return "TraceHop";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 3;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(data);
+        return 15;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Dynamics Simulation Parameters.
-    class DynamicsSimParam: public Message
+    //! Heap Usage.
+    class HeapUsage: public Message
     {
     public:
-      //! Action on the Vehicle Simulation Parameters.
-      enum ActionontheVehicleSimulationParametersEnum
-      {
-        //! Request.
-        OP_REQUEST = 0,
-        //! Set.
-        OP_SET = 1,
-        //! Report.
-        OP_REPORT = 2
-      };
-
-      //! Action on the Vehicle Simulation Parameters.
-      uint8_t op;
-      //! TAS to Longitudinal Acceleration Gain.
-      fp32_t tas2acc_pgain;
-      //! Bank to Bank Rate Gain.
-      fp32_t bank2p_pgain;
+      //! Used.
+      uint32_t used;
+      //! Quota.
+      uint32_t quota;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 53;
+        return 20;
       }
 
-      DynamicsSimParam(void);
+      HeapUsage(void);
 
       Message*
       clone(void) const
       {
-        return new DynamicsSimParam(*this);
+        return new HeapUsage(*this);
       }
 
       void
@@ -1574,46 +1696,84 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DynamicsSimParam::getIdStatic();
+        return HeapUsage::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DynamicsSimParam";
+        return "HeapUsage";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 9;
+        return 8;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Storage Usage.
-    class StorageUsage: public Message
+    //! Simulated State.
+    class SimulatedState: public Message
     {
     public:
-      //! Available.
-      uint32_t available;
-      //! Usage.
-      uint8_t value;
-
-      static uint16_t
-      getIdStatic(void)
-      {
-        return 100;
+      //! Latitude (WGS-84).
+      fp64_t lat;
+      //! Longitude (WGS-84).
+      fp64_t lon;
+      //! Height (WGS-84).
+      fp32_t height;
+      //! Offset north (m).
+      fp32_t x;
+      //! Offset east (m).
+      fp32_t y;
+      //! Offset down (m).
+      fp32_t z;
+      //! Rotation over x axis.
+      fp32_t phi;
+      //! Rotation over y axis.
+      fp32_t theta;
+      //! Rotation over z axis.
+      fp32_t psi;
+      //! Body-Fixed xx Linear Velocity.
+      fp32_t u;
+      //! Body-Fixed yy Linear Velocity.
+      fp32_t v;
+      //! Body-Fixed zz Linear Velocity.
+      fp32_t w;
+      //! Angular Velocity in x.
+      fp32_t p;
+      //! Angular Velocity in y.
+      fp32_t q;
+      //! Angular Velocity in z.
+      fp32_t r;
+      //! Stream Velocity X (North).
+      fp32_t svx;
+      //! Stream Velocity Y (East).
+      fp32_t svy;
+      //! Stream Velocity Z (Down).
+      fp32_t svz;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 50;
       }
 
-      StorageUsage(void);
+      SimulatedState(void);
 
       Message*
       clone(void) const
       {
-        return new StorageUsage(*this);
+        return new SimulatedState(*this);
       }
 
       void
@@ -1637,69 +1797,64 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return StorageUsage::getIdStatic();
+        return SimulatedState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "StorageUsage";
+        return "SimulatedState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 80;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Cache Control.
-    class CacheControl: public Message
+    //! Leak Simulation.
+    class LeakSimulation: public Message
     {
     public:
-      //! Control Operation.
-      enum ControlOperationEnum
+      //! Operation.
+      enum OperationEnum
       {
-        //! Store.
-        COP_STORE = 0,
-        //! Load.
-        COP_LOAD = 1,
-        //! Clear.
-        COP_CLEAR = 2,
-        //! Copy Snapshot.
-        COP_COPY = 3,
-        //! Snapshot Copy Complete.
-        COP_COPY_COMPLETE = 4
+        //! Leaks Off.
+        LSIM_OFF = 0,
+        //! Leaks On.
+        LSIM_ON = 1
       };
 
-      //! Control Operation.
+      //! Operation.
       uint8_t op;
-      //! Snapshot destination.
-      std::string snapshot;
-      //! Message.
-      InlineMessage<Message> message;
+      //! Leak Entities.
+      std::string entities;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 101;
+        return 51;
       }
 
-      CacheControl(void);
+      LeakSimulation(void);
+
+      void
+      swap(LeakSimulation& other__);
 
       Message*
       clone(void) const
       {
-        return new CacheControl(*this);
+        return new LeakSimulation(*this);
       }
 
       void
@@ -1723,13 +1878,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CacheControl::getIdStatic();
+        return LeakSimulation::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CacheControl";
+        return "LeakSimulation";
       }
 
       unsigned
@@ -1741,67 +1896,56 @@ namespace DUNE
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(snapshot) + message.getSerializationSize();
+        return IMC::getSerializationSize(entities);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
-      void
-      setSourceNested(uint16_t value__);
-
-      void
-      setSourceEntityNested(uint8_t value__);
-
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Logging Control.
-    class LoggingControl: public Message
+    //! Underwater Acoustics Simulation.
+    class UASimulation: public Message
     {
     public:
-      //! Control Operation.
-      enum ControlOperationEnum
+      //! Type.
+      enum TypeEnum
       {
-        //! Request Start of Logging.
-        COP_REQUEST_START = 0,
-        //! Logging Started.
-        COP_STARTED = 1,
-        //! Request Logging Stop.
-        COP_REQUEST_STOP = 2,
-        //! Logging Stopped.
-        COP_STOPPED = 3,
-        //! Request Current Log Name.
-        COP_REQUEST_CURRENT_NAME = 4,
-        //! Current Log Name.
-        COP_CURRENT_NAME = 5
+        //! Data Transmission.
+        UAS_DATA = 0,
+        //! Ping.
+        UAS_PING = 1,
+        //! Ping Reply.
+        UAS_PING_REPLY = 2
       };
 
-      //! Control Operation.
-      uint8_t op;
-      //! Log Label / Path.
-      std::string name;
+      //! Type.
+      uint8_t type;
+      //! Transmission Speed.
+      uint16_t speed;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 102;
+        return 52;
       }
 
-      LoggingControl(void);
+      UASimulation(void);
+
+      void
+      swap(UASimulation& other__);
 
       Message*
       clone(void) const
       {
-        return new LoggingControl(*this);
+        return new UASimulation(*this);
       }
 
       void
@@ -1816,6 +1960,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -1825,71 +1972,71 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LoggingControl::getIdStatic();
+        return UASimulation::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LoggingControl";
+        return "UASimulation";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 3;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(name);
+        return IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Log Book Entry.
-    class LogBookEntry: public Message
+    //! Dynamics Simulation Parameters.
+    class DynamicsSimParam: public Message
     {
     public:
-      //! Type.
-      enum TypeEnum
+      //! Action on the Vehicle Simulation Parameters.
+      enum ActionontheVehicleSimulationParametersEnum
       {
-        //! Information.
-        LBET_INFO = 0,
-        //! Warning.
-        LBET_WARNING = 1,
-        //! Error.
-        LBET_ERROR = 2,
-        //! Critical.
-        LBET_CRITICAL = 3,
-        //! Debug.
-        LBET_DEBUG = 4
+        //! Request.
+        OP_REQUEST = 0,
+        //! Set.
+        OP_SET = 1,
+        //! Report.
+        OP_REPORT = 2
       };
 
-      //! Type.
-      uint8_t type;
-      //! Timestamp.
-      fp64_t htime;
-      //! Context.
-      std::string context;
-      //! Text.
-      std::string text;
+      //! Action on the Vehicle Simulation Parameters.
+      uint8_t op;
+      //! TAS to Longitudinal Acceleration Gain.
+      fp32_t tas2acc_pgain;
+      //! Bank to Bank Rate Gain.
+      fp32_t bank2p_pgain;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 103;
+        return 53;
       }
 
-      LogBookEntry(void);
+      DynamicsSimParam(void);
 
       Message*
       clone(void) const
       {
-        return new LogBookEntry(*this);
+        return new DynamicsSimParam(*this);
       }
 
       void
@@ -1913,13 +2060,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LogBookEntry::getIdStatic();
+        return DynamicsSimParam::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LogBookEntry";
+        return "DynamicsSimParam";
       }
 
       unsigned
@@ -1928,52 +2075,37 @@ namespace DUNE
         return 9;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(context) + IMC::getSerializationSize(text);
-      }
-
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Log Book Control.
-    class LogBookControl: public Message
+    //! Storage Usage.
+    class StorageUsage: public Message
     {
     public:
-      //! Command.
-      enum CommandEnum
-      {
-        //! Get.
-        LBC_GET = 0,
-        //! Clear.
-        LBC_CLEAR = 1,
-        //! Get Errors.
-        LBC_GET_ERR = 2,
-        //! Reply.
-        LBC_REPLY = 3
-      };
-
-      //! Command.
-      uint8_t command;
-      //! Timestamp.
-      fp64_t htime;
-      //! Messages.
-      MessageList<LogBookEntry> msg;
+      //! Available.
+      uint32_t available;
+      //! Usage.
+      uint8_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 104;
+        return 100;
       }
 
-      LogBookControl(void);
+      StorageUsage(void);
 
       Message*
       clone(void) const
       {
-        return new LogBookControl(*this);
+        return new StorageUsage(*this);
       }
 
       void
@@ -1997,81 +2129,83 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LogBookControl::getIdStatic();
+        return StorageUsage::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LogBookControl";
+        return "StorageUsage";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 9;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return msg.getSerializationSize();
+        return 5;
       }
 
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-
-    protected:
-      void
-      setTimeStampNested(double value__);
+      fp64_t
+      getValueFP(void) const;
 
       void
-      setSourceNested(uint16_t value__);
+      setValueFP(fp64_t val);
 
       void
-      setSourceEntityNested(uint8_t value__);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Replay Control.
-    class ReplayControl: public Message
+    //! Cache Control.
+    class CacheControl: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
+      //! Control Operation.
+      enum ControlOperationEnum
       {
-        //! Start.
-        ROP_START = 0,
-        //! Stop.
-        ROP_STOP = 1,
-        //! Pause.
-        ROP_PAUSE = 2,
-        //! Resume.
-        ROP_RESUME = 3
+        //! Store.
+        COP_STORE = 0,
+        //! Load.
+        COP_LOAD = 1,
+        //! Clear.
+        COP_CLEAR = 2,
+        //! Copy Snapshot.
+        COP_COPY = 3,
+        //! Snapshot Copy Complete.
+        COP_COPY_COMPLETE = 4
       };
 
-      //! Operation.
+      //! Control Operation.
       uint8_t op;
-      //! File To Replay.
-      std::string file;
+      //! Snapshot destination.
+      std::string snapshot;
+      //! Message.
+      InlineMessage<Message> message;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 105;
+        return 101;
       }
 
-      ReplayControl(void);
+      CacheControl(void);
+
+      CacheControl(const CacheControl& other__);
+
+      void
+      swap(CacheControl& other__);
+
+      CacheControl&
+      operator=(const CacheControl& other__);
 
       Message*
       clone(void) const
       {
-        return new ReplayControl(*this);
+        return new CacheControl(*this);
       }
 
       void
@@ -2095,13 +2229,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ReplayControl::getIdStatic();
+        return CacheControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ReplayControl";
+        return "CacheControl";
       }
 
       unsigned
@@ -2113,53 +2247,76 @@ namespace DUNE
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(file);
+        return IMC::getSerializationSize(snapshot) + message.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Clock Control.
-    class ClockControl: public Message
+    //! Logging Control.
+    class LoggingControl: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
+      //! Control Operation.
+      enum ControlOperationEnum
       {
-        //! Execute Sync..
-        COP_SYNC_EXEC = 0,
-        //! Request Sync..
-        COP_SYNC_REQUEST = 1,
-        //! Sync. Started.
-        COP_SYNC_STARTED = 2,
-        //! Sync. done.
-        COP_SYNC_DONE = 3,
-        //! Set Timezone .
-        COP_SET_TZ = 4,
-        //! Timezone Setup.
-        COP_SET_TZ_DONE = 5
+        //! Request Start of Logging.
+        COP_REQUEST_START = 0,
+        //! Logging Started.
+        COP_STARTED = 1,
+        //! Request Logging Stop.
+        COP_REQUEST_STOP = 2,
+        //! Logging Stopped.
+        COP_STOPPED = 3,
+        //! Request Current Log Name.
+        COP_REQUEST_CURRENT_NAME = 4,
+        //! Current Log Name.
+        COP_CURRENT_NAME = 5
       };
 
-      //! Operation.
+      //! Control Operation.
       uint8_t op;
-      //! Clock.
-      fp64_t clock;
-      //! Timezone.
-      int8_t tz;
+      //! Log Label / Path.
+      std::string name;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 106;
+        return 102;
       }
 
-      ClockControl(void);
+      LoggingControl(void);
+
+      void
+      swap(LoggingControl& other__);
 
       Message*
       clone(void) const
       {
-        return new ClockControl(*this);
+        return new LoggingControl(*this);
       }
 
       void
@@ -2183,47 +2340,88 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ClockControl::getIdStatic();
+        return LoggingControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ClockControl";
+        return "LoggingControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 10;
+        return 1;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(name);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Heartbeat.
-    class Heartbeat: public Message
+    //! Log Book Entry.
+    class LogBookEntry: public Message
     {
     public:
+      //! Type.
+      enum TypeEnum
+      {
+        //! Information.
+        LBET_INFO = 0,
+        //! Warning.
+        LBET_WARNING = 1,
+        //! Error.
+        LBET_ERROR = 2,
+        //! Critical.
+        LBET_CRITICAL = 3,
+        //! Debug.
+        LBET_DEBUG = 4
+      };
+
+      //! Type.
+      uint8_t type;
+      //! Timestamp.
+      fp64_t htime;
+      //! Context.
+      std::string context;
+      //! Text.
+      std::string text;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 150;
+        return 103;
       }
 
-      Heartbeat(void);
+      LogBookEntry(void);
+
+      void
+      swap(LogBookEntry& other__);
 
       Message*
       clone(void) const
       {
-        return new Heartbeat(*this);
+        return new LogBookEntry(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -2239,62 +2437,90 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Heartbeat::getIdStatic();
+        return LogBookEntry::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Heartbeat";
+        return "LogBookEntry";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 9;
       }
-    };
-
-    //! Announce.
-    class Announce: public Message
-    {
-    public:
-      //! System Name.
-      std::string sys_name;
-      //! System Type.
-      uint8_t sys_type;
-      //! Control Owner.
-      uint16_t owner;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Height WGS-84.
-      fp32_t height;
-      //! Services.
-      std::string services;
 
-      static uint16_t
-      getIdStatic(void)
+      unsigned
+      getVariableSerializationSize(void) const
       {
-        return 151;
+        return IMC::getSerializationSize(context) + IMC::getSerializationSize(text);
       }
 
-      Announce(void);
-
-      Message*
-      clone(void) const
-      {
-        return new Announce(*this);
-      }
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      clear(void);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
       bool
-      fieldsEqual(const Message& msg__) const;
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
 
-      int
+    //! Log Book Control.
+    class LogBookControl: public Message
+    {
+    public:
+      //! Command.
+      enum CommandEnum
+      {
+        //! Get.
+        LBC_GET = 0,
+        //! Clear.
+        LBC_CLEAR = 1,
+        //! Get Errors.
+        LBC_GET_ERR = 2,
+        //! Reply.
+        LBC_REPLY = 3
+      };
+
+      //! Command.
+      uint8_t command;
+      //! Timestamp.
+      fp64_t htime;
+      //! Messages.
+      MessageList<LogBookEntry> msg;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 104;
+      }
+
+      LogBookControl(void);
+
+      LogBookControl(const LogBookControl& other__);
+
+      void
+      swap(LogBookControl& other__);
+
+      LogBookControl&
+      operator=(const LogBookControl& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new LogBookControl(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
       validate(void) const;
 
       uint8_t*
@@ -2309,61 +2535,90 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Announce::getIdStatic();
+        return LogBookControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Announce";
+        return "LogBookControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 23;
+        return 9;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(sys_name) + IMC::getSerializationSize(services);
+        return msg.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Announce Service.
-    class AnnounceService: public Message
+    //! Replay Control.
+    class ReplayControl: public Message
     {
     public:
-      //! ServiceType.
-      enum ServiceTypeBits
+      //! Operation.
+      enum OperationEnum
       {
-        //! External.
-        SRV_TYPE_EXTERNAL = 0x01,
-        //! Local.
-        SRV_TYPE_LOCAL = 0x02
+        //! Start.
+        ROP_START = 0,
+        //! Stop.
+        ROP_STOP = 1,
+        //! Pause.
+        ROP_PAUSE = 2,
+        //! Resume.
+        ROP_RESUME = 3
       };
 
-      //! Service.
-      std::string service;
-      //! ServiceType.
-      uint8_t service_type;
+      //! Operation.
+      uint8_t op;
+      //! File To Replay.
+      std::string file;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 152;
+        return 105;
       }
 
-      AnnounceService(void);
+      ReplayControl(void);
+
+      void
+      swap(ReplayControl& other__);
 
       Message*
       clone(void) const
       {
-        return new AnnounceService(*this);
+        return new ReplayControl(*this);
       }
 
       void
@@ -2387,13 +2642,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AnnounceService::getIdStatic();
+        return ReplayControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AnnounceService";
+        return "ReplayControl";
       }
 
       unsigned
@@ -2405,32 +2660,59 @@ namespace DUNE
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(service);
+        return IMC::getSerializationSize(file);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Receive Signal Strength Information.
-    class RSSI: public Message
+    //! Clock Control.
+    class ClockControl: public Message
     {
     public:
-      //! Value.
-      fp32_t value;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Execute Sync..
+        COP_SYNC_EXEC = 0,
+        //! Request Sync..
+        COP_SYNC_REQUEST = 1,
+        //! Sync. Started.
+        COP_SYNC_STARTED = 2,
+        //! Sync. done.
+        COP_SYNC_DONE = 3,
+        //! Set Timezone .
+        COP_SET_TZ = 4,
+        //! Timezone Setup.
+        COP_SET_TZ_DONE = 5
+      };
+
+      //! Operation.
+      uint8_t op;
+      //! Clock.
+      fp64_t clock;
+      //! Timezone.
+      int8_t tz;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 153;
+        return 106;
       }
 
-      RSSI(void);
+      ClockControl(void);
 
       Message*
       clone(void) const
       {
-        return new RSSI(*this);
+        return new ClockControl(*this);
       }
 
       void
@@ -2454,50 +2736,76 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return RSSI::getIdStatic();
+        return ClockControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "RSSI";
+        return "ClockControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 10;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Voltage Standing Wave Ratio.
-    class VSWR: public Message
+    //! Log Transfer Request.
+    class LogTransferRequest: public Message
     {
     public:
-      //! Value.
-      fp32_t value;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Fetch.
+        LTR_FETCH = 0,
+        //! Cancel.
+        LTR_CANCEL = 1
+      };
+
+      //! Request Identifier.
+      uint16_t req_id;
+      //! Operation.
+      uint8_t op;
+      //! Log.
+      std::string log;
+      //! Start Time.
+      fp64_t start_time;
+      //! End Time.
+      fp64_t end_time;
+      //! Messages.
+      std::string msgs;
+      //! First Chunk.
+      uint32_t first_chunk;
+      //! Rate.
+      uint32_t rate;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 154;
+        return 107;
       }
 
-      VSWR(void);
+      LogTransferRequest(void);
+
+      void
+      swap(LogTransferRequest& other__);
 
       Message*
       clone(void) const
       {
-        return new VSWR(*this);
+        return new LogTransferRequest(*this);
       }
 
       void
@@ -2521,50 +2829,78 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return VSWR::getIdStatic();
+        return LogTransferRequest::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "VSWR";
+        return "LogTransferRequest";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 27;
       }
 
-      fp64_t
-      getValueFP(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(log) + IMC::getSerializationSize(msgs);
+      }
 
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Link Level.
-    class LinkLevel: public Message
+    //! Log Transfer Chunk.
+    class LogTransferChunk: public Message
     {
     public:
-      //! Value.
-      fp32_t value;
+      //! Compression Method.
+      enum CompressionMethodEnum
+      {
+        //! None.
+        LTC_NONE = 0,
+        //! LZ4.
+        LTC_LZ4 = 1,
+        //! Zlib.
+        LTC_ZLIB = 2
+      };
+
+      //! Request Identifier.
+      uint16_t req_id;
+      //! Chunk.
+      uint32_t chunk;
+      //! Compression Method.
+      uint8_t method;
+      //! Uncompressed Size.
+      uint32_t usize;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 155;
+        return 108;
       }
 
-      LinkLevel(void);
+      LogTransferChunk(void);
+
+      void
+      swap(LogTransferChunk& other__);
 
       Message*
       clone(void) const
       {
-        return new LinkLevel(*this);
+        return new LogTransferChunk(*this);
       }
 
       void
@@ -2579,6 +2915,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -2588,54 +2927,78 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LinkLevel::getIdStatic();
+        return LogTransferChunk::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LinkLevel";
+        return "LogTransferChunk";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 11;
       }
 
-      fp64_t
-      getValueFP(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(data);
+      }
 
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! SMS.
-    class Sms: public Message
+    //! Log Transfer State.
+    class LogTransferState: public Message
     {
     public:
-      //! Number.
-      std::string number;
-      //! Timeout.
-      uint16_t timeout;
-      //! Contents.
-      std::string contents;
-
-      static uint16_t
-      getIdStatic(void)
+      //! State.
+      enum StateEnum
       {
-        return 156;
+        //! Accepted.
+        LTS_ACCEPTED = 0,
+        //! Done.
+        LTS_DONE = 1,
+        //! Cancelled.
+        LTS_CANCELLED = 2,
+        //! Error.
+        LTS_ERROR = 3
+      };
+
+      //! Request Identifier.
+      uint16_t req_id;
+      //! State.
+      uint8_t state;
+      //! Chunks.
+      uint32_t chunks;
+      //! Information.
+      std::string info;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 109;
       }
 
-      Sms(void);
+      LogTransferState(void);
+
+      void
+      swap(LogTransferState& other__);
 
       Message*
       clone(void) const
       {
-        return new Sms(*this);
+        return new LogTransferState(*this);
       }
 
       void
@@ -2659,56 +3022,76 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Sms::getIdStatic();
+        return LogTransferState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Sms";
+        return "LogTransferState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 7;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(number) + IMC::getSerializationSize(contents);
+        return IMC::getSerializationSize(info);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! SMS Transmit.
-    class SmsTx: public Message
+    //! Flight Recorder Control.
+    class FlightRecorderControl: public Message
     {
     public:
-      //! Sequence Number.
-      uint32_t seq;
-      //! Destination.
-      std::string destination;
-      //! Timeout.
-      uint16_t timeout;
-      //! Data.
-      std::vector<char> data;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Request Dump.
+        FRC_REQUEST_DUMP = 0,
+        //! Dump Started.
+        FRC_DUMP_STARTED = 1,
+        //! Dump Completed.
+        FRC_DUMP_COMPLETED = 2,
+        //! Dump Failed.
+        FRC_DUMP_FAILED = 3
+      };
+
+      //! Operation.
+      uint8_t op;
+      //! Reason.
+      std::string reason;
+      //! Log.
+      std::string log;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 157;
+        return 110;
       }
 
-      SmsTx(void);
+      FlightRecorderControl(void);
+
+      void
+      swap(FlightRecorderControl& other__);
 
       Message*
       clone(void) const
       {
-        return new SmsTx(*this);
+        return new FlightRecorderControl(*this);
       }
 
       void
@@ -2732,52 +3115,80 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SmsTx::getIdStatic();
+        return FlightRecorderControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SmsTx";
+        return "FlightRecorderControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 6;
+        return 1;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(destination) + IMC::getSerializationSize(data);
+        return IMC::getSerializationSize(reason) + IMC::getSerializationSize(log);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! SMS Receive.
-    class SmsRx: public Message
+    //! Task Control.
+    class TaskControl: public Message
     {
     public:
-      //! Source.
-      std::string source;
-      //! Data.
-      std::vector<char> data;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Start.
+        TC_START = 0,
+        //! Stop.
+        TC_STOP = 1,
+        //! Restart.
+        TC_RESTART = 2,
+        //! Load Configuration.
+        TC_LOAD = 3,
+        //! Success.
+        TC_SUCCESS = 4,
+        //! Failure.
+        TC_FAILURE = 5
+      };
+
+      //! Operation.
+      uint8_t op;
+      //! Name.
+      std::string name;
+      //! Information.
+      std::string info;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 158;
+        return 111;
       }
 
-      SmsRx(void);
+      TaskControl(void);
+
+      void
+      swap(TaskControl& other__);
 
       Message*
       clone(void) const
       {
-        return new SmsRx(*this);
+        return new TaskControl(*this);
       }
 
       void
@@ -2801,73 +3212,82 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SmsRx::getIdStatic();
+        return TaskControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SmsRx";
+        return "TaskControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 1;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(source) + IMC::getSerializationSize(data);
+        return IMC::getSerializationSize(name) + IMC::getSerializationSize(info);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! SMS State.
-    class SmsState: public Message
+    //! Time Series Query.
+    class TimeSeriesQuery: public Message
     {
     public:
-      //! State.
-      enum StateEnum
-      {
-        //! Accepted.
-        SMS_ACCEPTED = 0,
-        //! Rejected.
-        SMS_REJECTED = 1,
-        //! Interrupted.
-        SMS_INTERRUPTED = 2,
-        //! Completed.
-        SMS_COMPLETED = 3,
-        //! Idle.
-        SMS_IDLE = 4,
-        //! Transmitting.
-        SMS_TRANSMITTING = 5,
-        //! Receiving.
-        SMS_RECEIVING = 6
+      //! Aggregate.
+      enum AggregateEnum
+      {
+        //! Mean.
+        TSA_MEAN = 0,
+        //! Minimum.
+        TSA_MIN = 1,
+        //! Maximum.
+        TSA_MAX = 2,
+        //! Last.
+        TSA_LAST = 3
       };
 
-      //! Sequence Number.
-      uint32_t seq;
-      //! State.
-      uint8_t state;
-      //! Error Message.
-      std::string error;
+      //! Request Identifier.
+      uint16_t req_id;
+      //! Series.
+      std::string series;
+      //! Start Time.
+      fp64_t start_time;
+      //! End Time.
+      fp64_t end_time;
+      //! Step.
+      uint32_t step;
+      //! Aggregate.
+      uint8_t aggregate;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 159;
+        return 112;
       }
 
-      SmsState(void);
+      TimeSeriesQuery(void);
+
+      void
+      swap(TimeSeriesQuery& other__);
 
       Message*
       clone(void) const
       {
-        return new SmsState(*this);
+        return new TimeSeriesQuery(*this);
       }
 
       void
@@ -2891,52 +3311,86 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SmsState::getIdStatic();
+        return TimeSeriesQuery::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SmsState";
+        return "TimeSeriesQuery";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 23;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(error);
+        return IMC::getSerializationSize(series);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Text Message.
-    class TextMessage: public Message
+    //! Time Series Reply.
+    class TimeSeriesReply: public Message
     {
     public:
-      //! Origin.
-      std::string origin;
-      //! Text.
-      std::string text;
+      //! Status.
+      enum StatusEnum
+      {
+        //! Success.
+        TSR_SUCCESS = 0,
+        //! Truncated.
+        TSR_TRUNCATED = 1,
+        //! Unknown Series.
+        TSR_UNKNOWN = 2
+      };
+
+      //! Request Identifier.
+      uint16_t req_id;
+      //! Status.
+      uint8_t status;
+      //! Series.
+      std::string series;
+      //! Step.
+      uint32_t step;
+      //! Count.
+      uint32_t count;
+      //! Minimum.
+      fp64_t min;
+      //! Maximum.
+      fp64_t max;
+      //! Mean.
+      fp64_t mean;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 160;
+        return 113;
       }
 
-      TextMessage(void);
+      TimeSeriesReply(void);
+
+      void
+      swap(TimeSeriesReply& other__);
 
       Message*
       clone(void) const
       {
-        return new TextMessage(*this);
+        return new TimeSeriesReply(*this);
       }
 
       void
@@ -2951,6 +3405,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -2960,66 +3417,59 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return TextMessage::getIdStatic();
+        return TimeSeriesReply::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "TextMessage";
+        return "TimeSeriesReply";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 35;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(origin) + IMC::getSerializationSize(text);
+        return IMC::getSerializationSize(series) + IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Received Iridium Message.
-    class IridiumMsgRx: public Message
+    //! Heartbeat.
+    class Heartbeat: public Message
     {
     public:
-      //! Origin Identifier.
-      std::string origin;
-      //! Timestamp.
-      fp64_t htime;
-      //! Latitude Reference.
-      fp64_t lat;
-      //! Longitude Reference.
-      fp64_t lon;
-      //! Data.
-      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 170;
+        return 150;
       }
 
-      IridiumMsgRx(void);
+      Heartbeat(void);
 
       Message*
       clone(void) const
       {
-        return new IridiumMsgRx(*this);
+        return new Heartbeat(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -3035,56 +3485,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return IridiumMsgRx::getIdStatic();
+        return Heartbeat::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "IridiumMsgRx";
+        return "Heartbeat";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 24;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(origin) + IMC::getSerializationSize(data);
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Transmit Iridium Message.
-    class IridiumMsgTx: public Message
+    //! Announce.
+    class Announce: public Message
     {
     public:
-      //! Request Identifier.
-      uint16_t req_id;
-      //! Time to live.
-      uint16_t ttl;
-      //! Destination Identifier.
-      std::string destination;
-      //! Data.
-      std::vector<char> data;
+      //! System Name.
+      std::string sys_name;
+      //! System Type.
+      uint8_t sys_type;
+      //! Control Owner.
+      uint16_t owner;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Height WGS-84.
+      fp32_t height;
+      //! Services.
+      std::string services;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 171;
+        return 151;
       }
 
-      IridiumMsgTx(void);
+      Announce(void);
+
+      void
+      swap(Announce& other__);
 
       Message*
       clone(void) const
       {
-        return new IridiumMsgTx(*this);
+        return new Announce(*this);
       }
 
       void
@@ -3108,69 +3558,70 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return IridiumMsgTx::getIdStatic();
+        return Announce::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "IridiumMsgTx";
+        return "Announce";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 23;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(destination) + IMC::getSerializationSize(data);
+        return IMC::getSerializationSize(sys_name) + IMC::getSerializationSize(services);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-    };
 
-    //! Iridium Transmission Status.
-    class IridiumTxStatus: public Message
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Announce Service.
+    class AnnounceService: public Message
     {
     public:
-      //! Status Code.
-      enum StatusCodeEnum
+      //! ServiceType.
+      enum ServiceTypeBits
       {
-        //! Successfull transmission.
-        TXSTATUS_OK = 1,
-        //! Error while trying to transmit message.
-        TXSTATUS_ERROR = 2,
-        //! Message has been queued for transmission.
-        TXSTATUS_QUEUED = 3,
-        //! Message is currently being transmitted.
-        TXSTATUS_TRANSMIT = 4,
-        //! Message's TTL has expired. Transmition cancelled..
-        TXSTATUS_EXPIRED = 5
+        //! External.
+        SRV_TYPE_EXTERNAL = 0x01,
+        //! Local.
+        SRV_TYPE_LOCAL = 0x02
       };
 
-      //! Request Identifier.
-      uint16_t req_id;
-      //! Status Code.
-      uint8_t status;
-      //! Status Text.
-      std::string text;
+      //! Service.
+      std::string service;
+      //! ServiceType.
+      uint8_t service_type;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 172;
+        return 152;
       }
 
-      IridiumTxStatus(void);
+      AnnounceService(void);
+
+      void
+      swap(AnnounceService& other__);
 
       Message*
       clone(void) const
       {
-        return new IridiumTxStatus(*this);
+        return new AnnounceService(*this);
       }
 
       void
@@ -3194,52 +3645,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return IridiumTxStatus::getIdStatic();
+        return AnnounceService::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "IridiumTxStatus";
+        return "AnnounceService";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 3;
+        return 1;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(text);
+        return IMC::getSerializationSize(service);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Group Membership State.
-    class GroupMembershipState: public Message
+    //! Receive Signal Strength Information.
+    class RSSI: public Message
     {
     public:
-      //! Group Name.
-      std::string group_name;
-      //! Communication Links Assertion.
-      uint32_t links;
+      //! Value.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 180;
+        return 153;
       }
 
-      GroupMembershipState(void);
+      RSSI(void);
 
       Message*
       clone(void) const
       {
-        return new GroupMembershipState(*this);
+        return new RSSI(*this);
       }
 
       void
@@ -3263,13 +3718,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return GroupMembershipState::getIdStatic();
+        return RSSI::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "GroupMembershipState";
+        return "RSSI";
       }
 
       unsigned
@@ -3278,56 +3733,41 @@ namespace DUNE
         return 4;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(group_name);
-      }
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! System Group.
-    class SystemGroup: public Message
+    //! Voltage Standing Wave Ratio.
+    class VSWR: public Message
     {
     public:
-      //! Group List Action.
-      enum GroupListActionEnum
-      {
-        //! Disband.
-        OP_Dis = 0,
-        //! Set.
-        OP_Set = 1,
-        //! Request.
-        OP_Req = 2,
-        //! Change.
-        OP_Chg = 3,
-        //! Report.
-        OP_Rep = 4,
-        //! Force.
-        OP_Frc = 5
-      };
-
-      //! Group Name.
-      std::string groupname;
-      //! Group List Action.
-      uint8_t action;
-      //! Systems Name List.
-      std::string grouplist;
+      //! Value.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 181;
+        return 154;
       }
 
-      SystemGroup(void);
+      VSWR(void);
 
       Message*
       clone(void) const
       {
-        return new SystemGroup(*this);
+        return new VSWR(*this);
       }
 
       void
@@ -3351,52 +3791,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SystemGroup::getIdStatic();
+        return VSWR::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SystemGroup";
+        return "VSWR";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 4;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(groupname) + IMC::getSerializationSize(grouplist);
-      }
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! LBL Range.
-    class LblRange: public Message
+    //! Link Level.
+    class LinkLevel: public Message
     {
     public:
-      //! Beacon Identification Number.
-      uint8_t id;
-      //! Range.
-      fp32_t range;
+      //! Value.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 200;
+        return 155;
       }
 
-      LblRange(void);
+      LinkLevel(void);
 
       Message*
       clone(void) const
       {
-        return new LblRange(*this);
+        return new LinkLevel(*this);
       }
 
       void
@@ -3420,54 +3864,63 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LblRange::getIdStatic();
+        return LinkLevel::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LblRange";
+        return "LinkLevel";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 4;
       }
 
-      uint16_t
-      getSubId(void) const;
+      fp64_t
+      getValueFP(void) const;
 
       void
-      setSubId(uint16_t subid);
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! LBL Detection.
-    class LblDetection: public Message
+    //! SMS.
+    class Sms: public Message
     {
     public:
-      //! Transmission.
-      uint8_t tx;
-      //! Channel.
-      uint8_t channel;
-      //! Timer.
-      uint16_t timer;
+      //! Number.
+      std::string number;
+      //! Timeout.
+      uint16_t timeout;
+      //! Contents.
+      std::string contents;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 201;
+        return 156;
       }
 
-      LblDetection(void);
+      Sms(void);
+
+      void
+      swap(Sms& other__);
 
       Message*
       clone(void) const
       {
-        return new LblDetection(*this);
+        return new Sms(*this);
       }
 
       void
@@ -3491,56 +3944,65 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LblDetection::getIdStatic();
+        return Sms::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LblDetection";
+        return "Sms";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 2;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(number) + IMC::getSerializationSize(contents);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! LBL Beacon Configuration.
-    class LblBeacon: public Message
+    //! SMS Transmit.
+    class SmsTx: public Message
     {
     public:
-      //! Beacon Name.
-      std::string beacon;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Depth.
-      fp32_t depth;
-      //! Interrogation channel.
-      uint8_t query_channel;
-      //! Reply channel.
-      uint8_t reply_channel;
-      //! Transponder delay.
-      uint8_t transponder_delay;
+      //! Sequence Number.
+      uint32_t seq;
+      //! Destination.
+      std::string destination;
+      //! Timeout.
+      uint16_t timeout;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 202;
+        return 157;
       }
 
-      LblBeacon(void);
+      SmsTx(void);
+
+      void
+      swap(SmsTx& other__);
 
       Message*
       clone(void) const
       {
-        return new LblBeacon(*this);
+        return new SmsTx(*this);
       }
 
       void
@@ -3555,6 +4017,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -3564,63 +4029,61 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LblBeacon::getIdStatic();
+        return SmsTx::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LblBeacon";
+        return "SmsTx";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 23;
+        return 6;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(beacon);
+        return IMC::getSerializationSize(destination) + IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! LBL Configuration.
-    class LblConfig: public Message
+    //! SMS Receive.
+    class SmsRx: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
-      {
-        //! Set LBL Configuration.
-        OP_SET_CFG = 0,
-        //! Retrieve LBL Configuration.
-        OP_GET_CFG = 1,
-        //! Reply to a GET command.
-        OP_CUR_CFG = 2
-      };
-
-      //! Operation.
-      uint8_t op;
-      //! Beacons.
-      MessageList<LblBeacon> beacons;
+      //! Source.
+      std::string source;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 203;
+        return 158;
       }
 
-      LblConfig(void);
+      SmsRx(void);
+
+      void
+      swap(SmsRx& other__);
 
       Message*
       clone(void) const
       {
-        return new LblConfig(*this);
+        return new SmsRx(*this);
       }
 
       void
@@ -3635,6 +4098,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -3644,66 +4110,82 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LblConfig::getIdStatic();
+        return SmsRx::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LblConfig";
+        return "SmsRx";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 0;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return beacons.getSerializationSize();
+        return IMC::getSerializationSize(source) + IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
-      void
-      setSourceNested(uint16_t value__);
-
       void
-      setSourceEntityNested(uint8_t value__);
-
-      void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Range.
-    class AcousticRange: public Message
+    //! SMS State.
+    class SmsState: public Message
     {
     public:
-      //! Target Modem Address.
-      uint8_t address;
+      //! State.
+      enum StateEnum
+      {
+        //! Accepted.
+        SMS_ACCEPTED = 0,
+        //! Rejected.
+        SMS_REJECTED = 1,
+        //! Interrupted.
+        SMS_INTERRUPTED = 2,
+        //! Completed.
+        SMS_COMPLETED = 3,
+        //! Idle.
+        SMS_IDLE = 4,
+        //! Transmitting.
+        SMS_TRANSMITTING = 5,
+        //! Receiving.
+        SMS_RECEIVING = 6
+      };
+
+      //! Sequence Number.
+      uint32_t seq;
+      //! State.
+      uint8_t state;
+      //! Error Message.
+      std::string error;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 204;
+        return 159;
       }
 
-      AcousticRange(void);
+      SmsState(void);
+
+      void
+      swap(SmsState& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticRange(*this);
+        return new SmsState(*this);
       }
 
       void
@@ -3727,59 +4209,61 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticRange::getIdStatic();
+        return SmsState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticRange";
+        return "SmsState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 5;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(error);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Range Reply.
-    class AcousticRangeReply: public Message
+    //! Text Message.
+    class TextMessage: public Message
     {
     public:
-      //! Status.
-      enum StatusEnum
-      {
-        //! Range obtained.
-        RNG_OK = 0,
-        //! Range not obtained.
-        RNG_NO_RESPONSE = 1,
-        //! Error occurred in operation.
-        RNG_ERROR = 2
-      };
-
-      //! Target Modem Address.
-      uint8_t address;
-      //! Status.
-      uint8_t status;
-      //! Range.
-      fp32_t range;
+      //! Origin.
+      std::string origin;
+      //! Text.
+      std::string text;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 205;
+        return 160;
       }
 
-      AcousticRangeReply(void);
+      TextMessage(void);
+
+      void
+      swap(TextMessage& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticRangeReply(*this);
+        return new TextMessage(*this);
       }
 
       void
@@ -3803,44 +4287,67 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticRangeReply::getIdStatic();
+        return TextMessage::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticRangeReply";
+        return "TextMessage";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 6;
+        return 0;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(origin) + IMC::getSerializationSize(text);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Message.
-    class AcousticMessage: public Message
+    //! Received Iridium Message.
+    class IridiumMsgRx: public Message
     {
     public:
-      //! Message to send.
-      InlineMessage<Message> message;
+      //! Origin Identifier.
+      std::string origin;
+      //! Timestamp.
+      fp64_t htime;
+      //! Latitude Reference.
+      fp64_t lat;
+      //! Longitude Reference.
+      fp64_t lon;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 206;
+        return 170;
       }
 
-      AcousticMessage(void);
+      IridiumMsgRx(void);
+
+      void
+      swap(IridiumMsgRx& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticMessage(*this);
+        return new IridiumMsgRx(*this);
       }
 
       void
@@ -3855,6 +4362,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -3864,66 +4374,65 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticMessage::getIdStatic();
+        return IridiumMsgRx::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticMessage";
+        return "IridiumMsgRx";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 24;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return message.getSerializationSize();
+        return IMC::getSerializationSize(origin) + IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
-      void
-      setSourceNested(uint16_t value__);
-
       void
-      setSourceEntityNested(uint8_t value__);
-
-      void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Diagnostic.
-    class AcousticDiagnostic: public Message
+    //! Transmit Iridium Message.
+    class IridiumMsgTx: public Message
     {
     public:
-      //! Enable.
-      uint8_t enable;
+      //! Request Identifier.
+      uint16_t req_id;
+      //! Time to live.
+      uint16_t ttl;
+      //! Destination Identifier.
+      std::string destination;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 207;
+        return 171;
       }
 
-      AcousticDiagnostic(void);
+      IridiumMsgTx(void);
+
+      void
+      swap(IridiumMsgTx& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticDiagnostic(*this);
+        return new IridiumMsgTx(*this);
       }
 
       void
@@ -3938,6 +4447,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -3947,59 +4459,78 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticDiagnostic::getIdStatic();
+        return IridiumMsgTx::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticDiagnostic";
+        return "IridiumMsgTx";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 4;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(destination) + IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Noise.
-    class AcousticNoise: public Message
+    //! Iridium Transmission Status.
+    class IridiumTxStatus: public Message
     {
     public:
-      //! Summary.
-      enum SummaryEnum
+      //! Status Code.
+      enum StatusCodeEnum
       {
-        //! Normal Conditions.
-        NOISE_NORMAL = 0,
-        //! Some Background Noise.
-        NOISE_LOW = 1,
-        //! Too Much Background Noise.
-        NOISE_HIGH = 2,
-        //! No Signal.
-        NOISE_NO_SIGNAL = 3
+        //! Successfull transmission.
+        TXSTATUS_OK = 1,
+        //! Error while trying to transmit message.
+        TXSTATUS_ERROR = 2,
+        //! Message has been queued for transmission.
+        TXSTATUS_QUEUED = 3,
+        //! Message is currently being transmitted.
+        TXSTATUS_TRANSMIT = 4,
+        //! Message's TTL has expired. Transmition cancelled..
+        TXSTATUS_EXPIRED = 5
       };
 
-      //! Summary.
-      uint8_t summary;
-      //! Noise Level.
-      uint8_t level;
+      //! Request Identifier.
+      uint16_t req_id;
+      //! Status Code.
+      uint8_t status;
+      //! Status Text.
+      std::string text;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 208;
+        return 172;
       }
 
-      AcousticNoise(void);
+      IridiumTxStatus(void);
+
+      void
+      swap(IridiumTxStatus& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticNoise(*this);
+        return new IridiumTxStatus(*this);
       }
 
       void
@@ -4023,47 +4554,69 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticNoise::getIdStatic();
+        return IridiumTxStatus::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticNoise";
+        return "IridiumTxStatus";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 3;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(text);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Ping.
-    class AcousticPing: public Message
+    //! Group Membership State.
+    class GroupMembershipState: public Message
     {
     public:
+      //! Group Name.
+      std::string group_name;
+      //! Communication Links Assertion.
+      uint32_t links;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 209;
+        return 180;
       }
 
-      AcousticPing(void);
+      GroupMembershipState(void);
+
+      void
+      swap(GroupMembershipState& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticPing(*this);
+        return new GroupMembershipState(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -4079,44 +4632,88 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticPing::getIdStatic();
+        return GroupMembershipState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticPing";
+        return "GroupMembershipState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 4;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(group_name);
       }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Ping Reply.
-    class AcousticPingReply: public Message
+    //! System Group.
+    class SystemGroup: public Message
     {
     public:
+      //! Group List Action.
+      enum GroupListActionEnum
+      {
+        //! Disband.
+        OP_Dis = 0,
+        //! Set.
+        OP_Set = 1,
+        //! Request.
+        OP_Req = 2,
+        //! Change.
+        OP_Chg = 3,
+        //! Report.
+        OP_Rep = 4,
+        //! Force.
+        OP_Frc = 5
+      };
+
+      //! Group Name.
+      std::string groupname;
+      //! Group List Action.
+      uint8_t action;
+      //! Systems Name List.
+      std::string grouplist;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 210;
+        return 181;
       }
 
-      AcousticPingReply(void);
+      SystemGroup(void);
+
+      void
+      swap(SystemGroup& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticPingReply(*this);
+        return new SystemGroup(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -4132,86 +4729,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticPingReply::getIdStatic();
+        return SystemGroup::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticPingReply";
+        return "SystemGroup";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 1;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(groupname) + IMC::getSerializationSize(grouplist);
       }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Operation.
-    class AcousticOperation: public Message
+    //! LBL Range.
+    class LblRange: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
-      {
-        //! Abort.
-        AOP_ABORT = 0,
-        //! Abort in Progress.
-        AOP_ABORT_IP = 1,
-        //! Abort Timeout.
-        AOP_ABORT_TIMEOUT = 2,
-        //! Abort Acknowledged.
-        AOP_ABORT_ACKED = 3,
-        //! Range Request.
-        AOP_RANGE = 4,
-        //! Range in Progress.
-        AOP_RANGE_IP = 5,
-        //! Range Timeout.
-        AOP_RANGE_TIMEOUT = 6,
-        //! Range Received.
-        AOP_RANGE_RECVED = 7,
-        //! Modem is Busy.
-        AOP_BUSY = 8,
-        //! Unsupported operation.
-        AOP_UNSUPPORTED = 9,
-        //! Transducer Not Detected.
-        AOP_NO_TXD = 10,
-        //! Send Message.
-        AOP_MSG = 11,
-        //! Message Send -- Queued.
-        AOP_MSG_QUEUED = 12,
-        //! Message Send -- In progress.
-        AOP_MSG_IP = 13,
-        //! Message Send -- Done.
-        AOP_MSG_DONE = 14,
-        //! Message Send -- Failure.
-        AOP_MSG_FAILURE = 15,
-        //! Send Short Message.
-        AOP_MSG_SHORT = 16
-      };
-
-      //! Operation.
-      uint8_t op;
-      //! System.
-      std::string system;
+      //! Beacon Identification Number.
+      uint8_t id;
       //! Range.
       fp32_t range;
-      //! Message To Send.
-      InlineMessage<Message> msg;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 211;
+        return 200;
       }
 
-      AcousticOperation(void);
+      LblRange(void);
 
       Message*
       clone(void) const
       {
-        return new AcousticOperation(*this);
+        return new LblRange(*this);
       }
 
       void
@@ -4235,13 +4804,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticOperation::getIdStatic();
+        return LblRange::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticOperation";
+        return "LblRange";
       }
 
       unsigned
@@ -4250,54 +4819,53 @@ namespace DUNE
         return 5;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(system) + msg.getSerializationSize();
-      }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-
-    protected:
-      void
-      setTimeStampNested(double value__);
+      uint16_t
+      getSubId(void) const;
 
       void
-      setSourceNested(uint16_t value__);
+      setSubId(uint16_t subid);
 
       void
-      setSourceEntityNested(uint8_t value__);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Systems Query.
-    class AcousticSystemsQuery: public Message
+    //! LBL Detection.
+    class LblDetection: public Message
     {
     public:
+      //! Transmission.
+      uint8_t tx;
+      //! Channel.
+      uint8_t channel;
+      //! Timer.
+      uint16_t timer;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 212;
+        return 201;
       }
 
-      AcousticSystemsQuery(void);
+      LblDetection(void);
 
       Message*
       clone(void) const
       {
-        return new AcousticSystemsQuery(*this);
+        return new LblDetection(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -4313,41 +4881,65 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticSystemsQuery::getIdStatic();
+        return LblDetection::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticSystemsQuery";
+        return "LblDetection";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 4;
       }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acoustic Systems.
-    class AcousticSystems: public Message
+    //! LBL Beacon Configuration.
+    class LblBeacon: public Message
     {
     public:
-      //! System List.
-      std::string list;
+      //! Beacon Name.
+      std::string beacon;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Depth.
+      fp32_t depth;
+      //! Interrogation channel.
+      uint8_t query_channel;
+      //! Reply channel.
+      uint8_t reply_channel;
+      //! Transponder delay.
+      uint8_t transponder_delay;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 213;
+        return 202;
       }
 
-      AcousticSystems(void);
+      LblBeacon(void);
+
+      void
+      swap(LblBeacon& other__);
 
       Message*
       clone(void) const
       {
-        return new AcousticSystems(*this);
+        return new LblBeacon(*this);
       }
 
       void
@@ -4371,50 +4963,77 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AcousticSystems::getIdStatic();
+        return LblBeacon::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AcousticSystems";
+        return "LblBeacon";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 23;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(list);
+        return IMC::getSerializationSize(beacon);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Revolutions Per Minute.
-    class Rpm: public Message
+    //! LBL Configuration.
+    class LblConfig: public Message
     {
     public:
-      //! Value.
-      int16_t value;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Set LBL Configuration.
+        OP_SET_CFG = 0,
+        //! Retrieve LBL Configuration.
+        OP_GET_CFG = 1,
+        //! Reply to a GET command.
+        OP_CUR_CFG = 2
+      };
+
+      //! Operation.
+      uint8_t op;
+      //! Beacons.
+      MessageList<LblBeacon> beacons;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 250;
+        return 203;
       }
 
-      Rpm(void);
+      LblConfig(void);
+
+      LblConfig(const LblConfig& other__);
+
+      void
+      swap(LblConfig& other__);
+
+      LblConfig&
+      operator=(const LblConfig& other__);
 
       Message*
       clone(void) const
       {
-        return new Rpm(*this);
+        return new LblConfig(*this);
       }
 
       void
@@ -4438,50 +5057,72 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Rpm::getIdStatic();
+        return LblConfig::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Rpm";
+        return "LblConfig";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 1;
       }
 
-      fp64_t
-      getValueFP(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return beacons.getSerializationSize();
+      }
 
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Voltage.
-    class Voltage: public Message
+    //! Acoustic Range.
+    class AcousticRange: public Message
     {
     public:
-      //! Measured Voltage Value.
-      fp32_t value;
+      //! Target Modem Address.
+      uint8_t address;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 251;
+        return 204;
       }
 
-      Voltage(void);
+      AcousticRange(void);
 
       Message*
       clone(void) const
       {
-        return new Voltage(*this);
+        return new AcousticRange(*this);
       }
 
       void
@@ -4505,50 +5146,65 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Voltage::getIdStatic();
+        return AcousticRange::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Voltage";
+        return "AcousticRange";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 1;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Current.
-    class Current: public Message
+    //! Acoustic Range Reply.
+    class AcousticRangeReply: public Message
     {
     public:
-      //! Measured Current Value.
-      fp32_t value;
+      //! Status.
+      enum StatusEnum
+      {
+        //! Range obtained.
+        RNG_OK = 0,
+        //! Range not obtained.
+        RNG_NO_RESPONSE = 1,
+        //! Error occurred in operation.
+        RNG_ERROR = 2
+      };
+
+      //! Target Modem Address.
+      uint8_t address;
+      //! Status.
+      uint8_t status;
+      //! Range.
+      fp32_t range;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 252;
+        return 205;
       }
 
-      Current(void);
+      AcousticRangeReply(void);
 
       Message*
       clone(void) const
       {
-        return new Current(*this);
+        return new AcousticRangeReply(*this);
       }
 
       void
@@ -4572,119 +5228,59 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Current::getIdStatic();
+        return AcousticRangeReply::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Current";
+        return "AcousticRangeReply";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 6;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! GPS Fix.
-    class GpsFix: public Message
+    //! Acoustic Message.
+    class AcousticMessage: public Message
     {
     public:
-      //! Type.
-      enum TypeEnum
+      //! Message to send.
+      InlineMessage<Message> message;
+
+      static uint16_t
+      getIdStatic(void)
       {
-        //! Stand Alone.
-        GFT_STANDALONE = 0x00,
-        //! Differential.
-        GFT_DIFFERENTIAL = 0x01,
-        //! Dead Reckoning.
-        GFT_DEAD_RECKONING = 0x02,
-        //! Manual Input.
-        GFT_MANUAL_INPUT = 0x03,
-        //! Simulation.
-        GFT_SIMULATION = 0x04
-      };
+        return 206;
+      }
 
-      //! Validity.
-      enum ValidityBits
+      AcousticMessage(void);
+
+      AcousticMessage(const AcousticMessage& other__);
+
+      void
+      swap(AcousticMessage& other__);
+
+      AcousticMessage&
+      operator=(const AcousticMessage& other__);
+
+      Message*
+      clone(void) const
       {
-        //! Valid Date.
-        GFV_VALID_DATE = 0x0001,
-        //! Valid Time.
-        GFV_VALID_TIME = 0x0002,
-        //! Valid Position.
-        GFV_VALID_POS = 0x0004,
-        //! Valid Course Over Ground.
-        GFV_VALID_COG = 0x0008,
-        //! Valid Speed Over Ground.
-        GFV_VALID_SOG = 0x0010,
-        //! Valid Horizontal Accuracy Estimate.
-        GFV_VALID_HACC = 0x0020,
-        //! Valid Vertical Accuracy Estimate.
-        GFV_VALID_VACC = 0x0040,
-        //! Valid Horizontal Dilution of Precision.
-        GFV_VALID_HDOP = 0x0080,
-        //! Valid Vertical Dilution of Precision.
-        GFV_VALID_VDOP = 0x0100
-      };
-
-      //! Validity.
-      uint16_t validity;
-      //! Type.
-      uint8_t type;
-      //! UTC Year.
-      uint16_t utc_year;
-      //! UTC Month.
-      uint8_t utc_month;
-      //! UTC Day.
-      uint8_t utc_day;
-      //! UTC Time of Fix.
-      fp32_t utc_time;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Height above WGS-84 ellipsoid.
-      fp32_t height;
-      //! Number of Satellites.
-      uint8_t satellites;
-      //! Course Over Ground.
-      fp32_t cog;
-      //! Speed Over Ground.
-      fp32_t sog;
-      //! Horizontal Dilution of Precision.
-      fp32_t hdop;
-      //! Vertical Dilution of Precision.
-      fp32_t vdop;
-      //! Horizontal Accuracy Estimate.
-      fp32_t hacc;
-      //! Vertical Accuracy Estimate.
-      fp32_t vacc;
-
-      static uint16_t
-      getIdStatic(void)
-      {
-        return 253;
-      }
-
-      GpsFix(void);
-
-      Message*
-      clone(void) const
-      {
-        return new GpsFix(*this);
-      }
+        return new AcousticMessage(*this);
+      }
 
       void
       clear(void);
@@ -4707,121 +5303,72 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return GpsFix::getIdStatic();
+        return AcousticMessage::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "GpsFix";
+        return "AcousticMessage";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 56;
+        return 0;
       }
 
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-    };
-
-    //! Euler Angles.
-    class EulerAngles: public Message
-    {
-    public:
-      //! Device Time.
-      fp64_t time;
-      //! Roll Angle.
-      fp64_t phi;
-      //! Pitch Angle.
-      fp64_t theta;
-      //! Yaw Angle (True).
-      fp64_t psi;
-      //! Yaw Angle (Magnetic).
-      fp64_t psi_magnetic;
-
-      static uint16_t
-      getIdStatic(void)
+      unsigned
+      getVariableSerializationSize(void) const
       {
-        return 254;
+        return message.getSerializationSize();
       }
 
-      EulerAngles(void);
-
-      Message*
-      clone(void) const
-      {
-        return new EulerAngles(*this);
-      }
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      clear(void);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
       bool
-      fieldsEqual(const Message& msg__) const;
-
-      int
-      validate(void) const;
+      fieldFromJSON(const char* label__, JSONReader& reader__);
 
-      uint8_t*
-      serializeFields(uint8_t* bfr__) const;
-
-      uint16_t
-      deserializeFields(const uint8_t* bfr__, uint16_t size__);
-
-      uint16_t
-      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+    protected:
+      void
+      setTimeStampNested(double value__);
 
-      uint16_t
-      getId(void) const
-      {
-        return EulerAngles::getIdStatic();
-      }
+      void
+      setSourceNested(uint16_t value__);
 
-      const char*
-      getName(void) const
-      {
-        return "EulerAngles";
-      }
+      void
+      setSourceEntityNested(uint8_t value__);
 
-      unsigned
-      getFixedSerializationSize(void) const
-      {
-        return 40;
-      }
+      void
+      setDestinationNested(uint16_t value__);
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Euler Angles Delta.
-    class EulerAnglesDelta: public Message
+    //! Acoustic Diagnostic.
+    class AcousticDiagnostic: public Message
     {
     public:
-      //! Device Time.
-      fp64_t time;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
-      //! Timestep.
-      fp32_t timestep;
+      //! Enable.
+      uint8_t enable;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 255;
+        return 207;
       }
 
-      EulerAnglesDelta(void);
+      AcousticDiagnostic(void);
 
       Message*
       clone(void) const
       {
-        return new EulerAnglesDelta(*this);
+        return new AcousticDiagnostic(*this);
       }
 
       void
@@ -4845,50 +5392,65 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return EulerAnglesDelta::getIdStatic();
+        return AcousticDiagnostic::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "EulerAnglesDelta";
+        return "AcousticDiagnostic";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 36;
+        return 1;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Angular Velocity.
-    class AngularVelocity: public Message
+    //! Acoustic Noise.
+    class AcousticNoise: public Message
     {
     public:
-      //! Device Time.
-      fp64_t time;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
+      //! Summary.
+      enum SummaryEnum
+      {
+        //! Normal Conditions.
+        NOISE_NORMAL = 0,
+        //! Some Background Noise.
+        NOISE_LOW = 1,
+        //! Too Much Background Noise.
+        NOISE_HIGH = 2,
+        //! No Signal.
+        NOISE_NO_SIGNAL = 3
+      };
+
+      //! Summary.
+      uint8_t summary;
+      //! Noise Level.
+      uint8_t level;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 256;
+        return 208;
       }
 
-      AngularVelocity(void);
+      AcousticNoise(void);
 
       Message*
       clone(void) const
       {
-        return new AngularVelocity(*this);
+        return new AcousticNoise(*this);
       }
 
       void
@@ -4912,58 +5474,53 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AngularVelocity::getIdStatic();
+        return AcousticNoise::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AngularVelocity";
+        return "AcousticNoise";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 32;
+        return 2;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Acceleration.
-    class Acceleration: public Message
+    //! Acoustic Ping.
+    class AcousticPing: public Message
     {
     public:
-      //! Device Time.
-      fp64_t time;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 257;
+        return 209;
       }
 
-      Acceleration(void);
+      AcousticPing(void);
 
       Message*
       clone(void) const
       {
-        return new Acceleration(*this);
+        return new AcousticPing(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -4979,58 +5536,44 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Acceleration::getIdStatic();
+        return AcousticPing::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Acceleration";
+        return "AcousticPing";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 32;
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Magnetic Field.
-    class MagneticField: public Message
+    //! Acoustic Ping Reply.
+    class AcousticPingReply: public Message
     {
     public:
-      //! Device Time.
-      fp64_t time;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 258;
+        return 210;
       }
 
-      MagneticField(void);
+      AcousticPingReply(void);
 
       Message*
       clone(void) const
       {
-        return new MagneticField(*this);
+        return new AcousticPingReply(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -5046,61 +5589,94 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return MagneticField::getIdStatic();
+        return AcousticPingReply::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "MagneticField";
+        return "AcousticPingReply";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 32;
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Ground Velocity.
-    class GroundVelocity: public Message
+    //! Acoustic Operation.
+    class AcousticOperation: public Message
     {
     public:
-      //! Validity.
-      enum ValidityBits
+      //! Operation.
+      enum OperationEnum
       {
-        //! X component is valid.
-        VAL_VEL_X = 0x01,
-        //! Y component is valid.
-        VAL_VEL_Y = 0x02,
-        //! Z component is valid.
-        VAL_VEL_Z = 0x04
+        //! Abort.
+        AOP_ABORT = 0,
+        //! Abort in Progress.
+        AOP_ABORT_IP = 1,
+        //! Abort Timeout.
+        AOP_ABORT_TIMEOUT = 2,
+        //! Abort Acknowledged.
+        AOP_ABORT_ACKED = 3,
+        //! Range Request.
+        AOP_RANGE = 4,
+        //! Range in Progress.
+        AOP_RANGE_IP = 5,
+        //! Range Timeout.
+        AOP_RANGE_TIMEOUT = 6,
+        //! Range Received.
+        AOP_RANGE_RECVED = 7,
+        //! Modem is Busy.
+        AOP_BUSY = 8,
+        //! Unsupported operation.
+        AOP_UNSUPPORTED = 9,
+        //! Transducer Not Detected.
+        AOP_NO_TXD = 10,
+        //! Send Message.
+        AOP_MSG = 11,
+        //! Message Send -- Queued.
+        AOP_MSG_QUEUED = 12,
+        //! Message Send -- In progress.
+        AOP_MSG_IP = 13,
+        //! Message Send -- Done.
+        AOP_MSG_DONE = 14,
+        //! Message Send -- Failure.
+        AOP_MSG_FAILURE = 15,
+        //! Send Short Message.
+        AOP_MSG_SHORT = 16
       };
 
-      //! Validity.
-      uint8_t validity;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
+      //! Operation.
+      uint8_t op;
+      //! System.
+      std::string system;
+      //! Range.
+      fp32_t range;
+      //! Message To Send.
+      InlineMessage<Message> msg;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 259;
+        return 211;
       }
 
-      GroundVelocity(void);
+      AcousticOperation(void);
+
+      AcousticOperation(const AcousticOperation& other__);
+
+      void
+      swap(AcousticOperation& other__);
+
+      AcousticOperation&
+      operator=(const AcousticOperation& other__);
 
       Message*
       clone(void) const
       {
-        return new GroundVelocity(*this);
+        return new AcousticOperation(*this);
       }
 
       void
@@ -5124,69 +5700,75 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return GroundVelocity::getIdStatic();
+        return AcousticOperation::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "GroundVelocity";
+        return "AcousticOperation";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 25;
+        return 5;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(system) + msg.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Water Velocity.
-    class WaterVelocity: public Message
+    //! Acoustic Systems Query.
+    class AcousticSystemsQuery: public Message
     {
     public:
-      //! Validity.
-      enum ValidityBits
-      {
-        //! X component is valid.
-        VAL_VEL_X = 0x01,
-        //! Y component is valid.
-        VAL_VEL_Y = 0x02,
-        //! Z component is valid.
-        VAL_VEL_Z = 0x04
-      };
-
-      //! Validity.
-      uint8_t validity;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 260;
+        return 212;
       }
 
-      WaterVelocity(void);
+      AcousticSystemsQuery(void);
 
       Message*
       clone(void) const
       {
-        return new WaterVelocity(*this);
+        return new AcousticSystemsQuery(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -5202,50 +5784,44 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return WaterVelocity::getIdStatic();
+        return AcousticSystemsQuery::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "WaterVelocity";
+        return "AcousticSystemsQuery";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 25;
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Velocity Delta.
-    class VelocityDelta: public Message
+    //! Acoustic Systems.
+    class AcousticSystems: public Message
     {
     public:
-      //! Device Time.
-      fp64_t time;
-      //! X.
-      fp64_t x;
-      //! Y.
-      fp64_t y;
-      //! Z.
-      fp64_t z;
+      //! System List.
+      std::string list;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 261;
+        return 213;
       }
 
-      VelocityDelta(void);
+      AcousticSystems(void);
+
+      void
+      swap(AcousticSystems& other__);
 
       Message*
       clone(void) const
       {
-        return new VelocityDelta(*this);
+        return new AcousticSystems(*this);
       }
 
       void
@@ -5269,54 +5845,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return VelocityDelta::getIdStatic();
+        return AcousticSystems::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "VelocityDelta";
+        return "AcousticSystems";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 32;
+        return 0;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(list);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Device State.
-    class DeviceState: public Message
+    //! Revolutions Per Minute.
+    class Rpm: public Message
     {
     public:
-      //! Device Position - X.
-      fp32_t x;
-      //! Device Position - Y.
-      fp32_t y;
-      //! Device Position - Z.
-      fp32_t z;
-      //! Device Rotation - X.
-      fp32_t phi;
-      //! Device Rotation - Y.
-      fp32_t theta;
-      //! Device Rotation - Z.
-      fp32_t psi;
+      //! Value.
+      int16_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 282;
+        return 250;
       }
 
-      DeviceState(void);
+      Rpm(void);
 
       Message*
       clone(void) const
       {
-        return new DeviceState(*this);
+        return new Rpm(*this);
       }
 
       void
@@ -5340,46 +5918,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DeviceState::getIdStatic();
+        return Rpm::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DeviceState";
+        return "Rpm";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 24;
+        return 2;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Beam Configuration.
-    class BeamConfig: public Message
+    //! Voltage.
+    class Voltage: public Message
     {
     public:
-      //! Beam Width.
-      fp32_t beam_width;
-      //! Beam Height.
-      fp32_t beam_height;
+      //! Measured Voltage Value.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 283;
+        return 251;
       }
 
-      BeamConfig(void);
+      Voltage(void);
 
       Message*
       clone(void) const
       {
-        return new BeamConfig(*this);
+        return new Voltage(*this);
       }
 
       void
@@ -5403,59 +5991,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return BeamConfig::getIdStatic();
+        return Voltage::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "BeamConfig";
+        return "Voltage";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 4;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Distance.
-    class Distance: public Message
+    //! Current.
+    class Current: public Message
     {
     public:
-      //! Validity.
-      enum ValidityEnum
-      {
-        //! Invalid.
-        DV_INVALID = 0,
-        //! Valid.
-        DV_VALID = 1
-      };
-
-      //! Validity.
-      uint8_t validity;
-      //! Location.
-      MessageList<DeviceState> location;
-      //! Beam Configuration.
-      MessageList<BeamConfig> beam_config;
-      //! Measured Distance.
+      //! Measured Current Value.
       fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 262;
+        return 252;
       }
 
-      Distance(void);
+      Current(void);
 
       Message*
       clone(void) const
       {
-        return new Distance(*this);
+        return new Current(*this);
       }
 
       void
@@ -5479,25 +6064,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Distance::getIdStatic();
+        return Current::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Distance";
+        return "Current";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return location.getSerializationSize() + beam_config.getSerializationSize();
+        return 4;
       }
 
       fp64_t
@@ -5509,42 +6088,100 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
-      void
-      setSourceNested(uint16_t value__);
-
-      void
-      setSourceEntityNested(uint8_t value__);
-
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Temperature.
-    class Temperature: public Message
+    //! GPS Fix.
+    class GpsFix: public Message
     {
     public:
-      //! Measured Temperature.
-      fp32_t value;
+      //! Type.
+      enum TypeEnum
+      {
+        //! Stand Alone.
+        GFT_STANDALONE = 0x00,
+        //! Differential.
+        GFT_DIFFERENTIAL = 0x01,
+        //! Dead Reckoning.
+        GFT_DEAD_RECKONING = 0x02,
+        //! Manual Input.
+        GFT_MANUAL_INPUT = 0x03,
+        //! Simulation.
+        GFT_SIMULATION = 0x04
+      };
+
+      //! Validity.
+      enum ValidityBits
+      {
+        //! Valid Date.
+        GFV_VALID_DATE = 0x0001,
+        //! Valid Time.
+        GFV_VALID_TIME = 0x0002,
+        //! Valid Position.
+        GFV_VALID_POS = 0x0004,
+        //! Valid Course Over Ground.
+        GFV_VALID_COG = 0x0008,
+        //! Valid Speed Over Ground.
+        GFV_VALID_SOG = 0x0010,
+        //! Valid Horizontal Accuracy Estimate.
+        GFV_VALID_HACC = 0x0020,
+        //! Valid Vertical Accuracy Estimate.
+        GFV_VALID_VACC = 0x0040,
+        //! Valid Horizontal Dilution of Precision.
+        GFV_VALID_HDOP = 0x0080,
+        //! Valid Vertical Dilution of Precision.
+        GFV_VALID_VDOP = 0x0100
+      };
+
+      //! Validity.
+      uint16_t validity;
+      //! Type.
+      uint8_t type;
+      //! UTC Year.
+      uint16_t utc_year;
+      //! UTC Month.
+      uint8_t utc_month;
+      //! UTC Day.
+      uint8_t utc_day;
+      //! UTC Time of Fix.
+      fp32_t utc_time;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Height above WGS-84 ellipsoid.
+      fp32_t height;
+      //! Number of Satellites.
+      uint8_t satellites;
+      //! Course Over Ground.
+      fp32_t cog;
+      //! Speed Over Ground.
+      fp32_t sog;
+      //! Horizontal Dilution of Precision.
+      fp32_t hdop;
+      //! Vertical Dilution of Precision.
+      fp32_t vdop;
+      //! Horizontal Accuracy Estimate.
+      fp32_t hacc;
+      //! Vertical Accuracy Estimate.
+      fp32_t vacc;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 263;
+        return 253;
       }
 
-      Temperature(void);
+      GpsFix(void);
 
       Message*
       clone(void) const
       {
-        return new Temperature(*this);
+        return new GpsFix(*this);
       }
 
       void
@@ -5568,50 +6205,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Temperature::getIdStatic();
+        return GpsFix::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Temperature";
+        return "GpsFix";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 56;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Pressure.
-    class Pressure: public Message
+    //! Euler Angles.
+    class EulerAngles: public Message
     {
     public:
-      //! Measured Pressure.
-      fp64_t value;
+      //! Device Time.
+      fp64_t time;
+      //! Roll Angle.
+      fp64_t phi;
+      //! Pitch Angle.
+      fp64_t theta;
+      //! Yaw Angle (True).
+      fp64_t psi;
+      //! Yaw Angle (Magnetic).
+      fp64_t psi_magnetic;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 264;
+        return 254;
       }
 
-      Pressure(void);
+      EulerAngles(void);
 
       Message*
       clone(void) const
       {
-        return new Pressure(*this);
+        return new EulerAngles(*this);
       }
 
       void
@@ -5635,50 +6280,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Pressure::getIdStatic();
+        return EulerAngles::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Pressure";
+        return "EulerAngles";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 40;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Depth.
-    class Depth: public Message
+    //! Euler Angles Delta.
+    class EulerAnglesDelta: public Message
     {
     public:
-      //! Measured Depth.
-      fp32_t value;
+      //! Device Time.
+      fp64_t time;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
+      //! Timestep.
+      fp32_t timestep;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 265;
+        return 255;
       }
 
-      Depth(void);
+      EulerAnglesDelta(void);
 
       Message*
       clone(void) const
       {
-        return new Depth(*this);
+        return new EulerAnglesDelta(*this);
       }
 
       void
@@ -5702,50 +6355,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Depth::getIdStatic();
+        return EulerAnglesDelta::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Depth";
+        return "EulerAnglesDelta";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 36;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Depth Offset.
-    class DepthOffset: public Message
+    //! Angular Velocity.
+    class AngularVelocity: public Message
     {
     public:
-      //! Measured Offset.
-      fp32_t value;
+      //! Device Time.
+      fp64_t time;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 266;
+        return 256;
       }
 
-      DepthOffset(void);
+      AngularVelocity(void);
 
       Message*
       clone(void) const
       {
-        return new DepthOffset(*this);
+        return new AngularVelocity(*this);
       }
 
       void
@@ -5769,50 +6428,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DepthOffset::getIdStatic();
+        return AngularVelocity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DepthOffset";
+        return "AngularVelocity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 32;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Sound Speed.
-    class SoundSpeed: public Message
+    //! Acceleration.
+    class Acceleration: public Message
     {
     public:
-      //! Computed Sound Speed.
-      fp32_t value;
+      //! Device Time.
+      fp64_t time;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 267;
+        return 257;
       }
 
-      SoundSpeed(void);
+      Acceleration(void);
 
       Message*
       clone(void) const
       {
-        return new SoundSpeed(*this);
+        return new Acceleration(*this);
       }
 
       void
@@ -5836,50 +6501,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SoundSpeed::getIdStatic();
+        return Acceleration::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SoundSpeed";
+        return "Acceleration";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 32;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Water Density.
-    class WaterDensity: public Message
+    //! Magnetic Field.
+    class MagneticField: public Message
     {
     public:
-      //! Computed Water Density.
-      fp32_t value;
+      //! Device Time.
+      fp64_t time;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 268;
+        return 258;
       }
 
-      WaterDensity(void);
+      MagneticField(void);
 
       Message*
       clone(void) const
       {
-        return new WaterDensity(*this);
+        return new MagneticField(*this);
       }
 
       void
@@ -5903,50 +6574,67 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return WaterDensity::getIdStatic();
+        return MagneticField::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "WaterDensity";
+        return "MagneticField";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 32;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Conductivity.
-    class Conductivity: public Message
+    //! Ground Velocity.
+    class GroundVelocity: public Message
     {
     public:
-      //! Measured Conductivity.
-      fp32_t value;
+      //! Validity.
+      enum ValidityBits
+      {
+        //! X component is valid.
+        VAL_VEL_X = 0x01,
+        //! Y component is valid.
+        VAL_VEL_Y = 0x02,
+        //! Z component is valid.
+        VAL_VEL_Z = 0x04
+      };
+
+      //! Validity.
+      uint8_t validity;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 269;
+        return 259;
       }
 
-      Conductivity(void);
+      GroundVelocity(void);
 
       Message*
       clone(void) const
       {
-        return new Conductivity(*this);
+        return new GroundVelocity(*this);
       }
 
       void
@@ -5970,50 +6658,67 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Conductivity::getIdStatic();
+        return GroundVelocity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Conductivity";
+        return "GroundVelocity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 25;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Salinity.
-    class Salinity: public Message
+    //! Water Velocity.
+    class WaterVelocity: public Message
     {
     public:
-      //! Measured Salinity.
-      fp32_t value;
+      //! Validity.
+      enum ValidityBits
+      {
+        //! X component is valid.
+        VAL_VEL_X = 0x01,
+        //! Y component is valid.
+        VAL_VEL_Y = 0x02,
+        //! Z component is valid.
+        VAL_VEL_Z = 0x04
+      };
+
+      //! Validity.
+      uint8_t validity;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 270;
+        return 260;
       }
 
-      Salinity(void);
+      WaterVelocity(void);
 
       Message*
       clone(void) const
       {
-        return new Salinity(*this);
+        return new WaterVelocity(*this);
       }
 
       void
@@ -6037,54 +6742,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Salinity::getIdStatic();
+        return WaterVelocity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Salinity";
+        return "WaterVelocity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 25;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Wind Speed.
-    class WindSpeed: public Message
+    //! Velocity Delta.
+    class VelocityDelta: public Message
     {
     public:
-      //! Direction.
-      fp32_t direction;
-      //! Speed.
-      fp32_t speed;
-      //! Turbulence.
-      fp32_t turbulence;
+      //! Device Time.
+      fp64_t time;
+      //! X.
+      fp64_t x;
+      //! Y.
+      fp64_t y;
+      //! Z.
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 271;
+        return 261;
       }
 
-      WindSpeed(void);
+      VelocityDelta(void);
 
       Message*
       clone(void) const
       {
-        return new WindSpeed(*this);
+        return new VelocityDelta(*this);
       }
 
       void
@@ -6108,44 +6815,60 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return WindSpeed::getIdStatic();
+        return VelocityDelta::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "WindSpeed";
+        return "VelocityDelta";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 12;
+        return 32;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Relative Humidity.
-    class RelativeHumidity: public Message
+    //! Device State.
+    class DeviceState: public Message
     {
     public:
-      //! Relative Humidity Value.
-      fp32_t value;
+      //! Device Position - X.
+      fp32_t x;
+      //! Device Position - Y.
+      fp32_t y;
+      //! Device Position - Z.
+      fp32_t z;
+      //! Device Rotation - X.
+      fp32_t phi;
+      //! Device Rotation - Y.
+      fp32_t theta;
+      //! Device Rotation - Z.
+      fp32_t psi;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 272;
+        return 282;
       }
 
-      RelativeHumidity(void);
+      DeviceState(void);
 
       Message*
       clone(void) const
       {
-        return new RelativeHumidity(*this);
+        return new DeviceState(*this);
       }
 
       void
@@ -6169,50 +6892,52 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return RelativeHumidity::getIdStatic();
+        return DeviceState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "RelativeHumidity";
+        return "DeviceState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 24;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Device Data (Text).
-    class DevDataText: public Message
+    //! Beam Configuration.
+    class BeamConfig: public Message
     {
     public:
-      //! Value.
-      std::string value;
+      //! Beam Width.
+      fp32_t beam_width;
+      //! Beam Height.
+      fp32_t beam_height;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 273;
+        return 283;
       }
 
-      DevDataText(void);
+      BeamConfig(void);
 
       Message*
       clone(void) const
       {
-        return new DevDataText(*this);
+        return new BeamConfig(*this);
       }
 
       void
@@ -6236,50 +6961,73 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DevDataText::getIdStatic();
+        return BeamConfig::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DevDataText";
+        return "BeamConfig";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(value);
+        return 8;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-    };
 
-    //! Device Data (Binary).
-    class DevDataBinary: public Message
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Distance.
+    class Distance: public Message
     {
     public:
-      //! Value.
-      std::vector<char> value;
+      //! Validity.
+      enum ValidityEnum
+      {
+        //! Invalid.
+        DV_INVALID = 0,
+        //! Valid.
+        DV_VALID = 1
+      };
+
+      //! Validity.
+      uint8_t validity;
+      //! Location.
+      MessageList<DeviceState> location;
+      //! Beam Configuration.
+      MessageList<BeamConfig> beam_config;
+      //! Measured Distance.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 274;
+        return 262;
       }
 
-      DevDataBinary(void);
+      Distance(void);
+
+      Distance(const Distance& other__);
+
+      void
+      swap(Distance& other__);
+
+      Distance&
+      operator=(const Distance& other__);
 
       Message*
       clone(void) const
       {
-        return new DevDataBinary(*this);
+        return new Distance(*this);
       }
 
       void
@@ -6303,54 +7051,78 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DevDataBinary::getIdStatic();
+        return Distance::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DevDataBinary";
+        return "Distance";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 5;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(value);
+        return location.getSerializationSize() + beam_config.getSerializationSize();
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Sonar Configuration.
-    class SonarConfig: public Payload
+    //! Temperature.
+    class Temperature: public Message
     {
     public:
-      //! Frequency.
-      uint32_t frequency;
-      //! Minimum Range.
-      uint16_t min_range;
-      //! Maximum Range.
-      uint16_t max_range;
+      //! Measured Temperature.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 275;
+        return 263;
       }
 
-      SonarConfig(void);
+      Temperature(void);
 
       Message*
       clone(void) const
       {
-        return new SonarConfig(*this);
+        return new Temperature(*this);
       }
 
       void
@@ -6374,69 +7146,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SonarConfig::getIdStatic();
+        return Temperature::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SonarConfig";
+        return "Temperature";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 4;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Sonar Data.
-    class SonarData: public Message
+    //! Pressure.
+    class Pressure: public Message
     {
     public:
-      //! Type.
-      enum TypeEnum
-      {
-        //! Sidescan.
-        ST_SIDESCAN = 0,
-        //! Echo Sounder.
-        ST_ECHOSOUNDER = 1,
-        //! Multibeam.
-        ST_MULTIBEAM = 2
-      };
-
-      //! Type.
-      uint8_t type;
-      //! Frequency.
-      uint32_t frequency;
-      //! Minimum Range.
-      uint16_t min_range;
-      //! Maximum Range.
-      uint16_t max_range;
-      //! Bits Per Data Point.
-      uint8_t bits_per_point;
-      //! Scaling Factor.
-      fp32_t scale_factor;
-      //! Beam Configuration.
-      MessageList<BeamConfig> beam_config;
-      //! Data.
-      std::vector<char> data;
+      //! Measured Pressure.
+      fp64_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 276;
+        return 264;
       }
 
-      SonarData(void);
+      Pressure(void);
 
       Message*
       clone(void) const
       {
-        return new SonarData(*this);
+        return new Pressure(*this);
       }
 
       void
@@ -6460,69 +7219,64 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SonarData::getIdStatic();
+        return Pressure::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SonarData";
+        return "Pressure";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 14;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return beam_config.getSerializationSize() + IMC::getSerializationSize(data);
+        return 8;
       }
 
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-
-    protected:
-      void
-      setTimeStampNested(double value__);
+      fp64_t
+      getValueFP(void) const;
 
       void
-      setSourceNested(uint16_t value__);
+      setValueFP(fp64_t val);
 
       void
-      setSourceEntityNested(uint8_t value__);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Pulse.
-    class Pulse: public Message
+    //! Depth.
+    class Depth: public Message
     {
     public:
+      //! Measured Depth.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 277;
+        return 265;
       }
 
-      Pulse(void);
+      Depth(void);
 
       Message*
       clone(void) const
       {
-        return new Pulse(*this);
+        return new Depth(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -6538,50 +7292,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Pulse::getIdStatic();
+        return Depth::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Pulse";
+        return "Depth";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 4;
       }
+
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Pulse Detection Control.
-    class PulseDetectionControl: public Message
+    //! Depth Offset.
+    class DepthOffset: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
-      {
-        //! Pulse Detection OFF.
-        POP_OFF = 0,
-        //! Pulse Detection ON.
-        POP_ON = 1
-      };
-
-      //! Operation.
-      uint8_t op;
+      //! Measured Offset.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 278;
+        return 266;
       }
 
-      PulseDetectionControl(void);
+      DepthOffset(void);
 
       Message*
       clone(void) const
       {
-        return new PulseDetectionControl(*this);
+        return new DepthOffset(*this);
       }
 
       void
@@ -6605,48 +7365,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PulseDetectionControl::getIdStatic();
+        return DepthOffset::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PulseDetectionControl";
+        return "DepthOffset";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 4;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Fuel Level.
-    class FuelLevel: public Message
+    //! Sound Speed.
+    class SoundSpeed: public Message
     {
     public:
-      //! Value.
+      //! Computed Sound Speed.
       fp32_t value;
-      //! Confidence Level.
-      fp32_t confidence;
-      //! Operation Modes.
-      std::string opmodes;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 279;
+        return 267;
       }
 
-      FuelLevel(void);
+      SoundSpeed(void);
 
       Message*
       clone(void) const
       {
-        return new FuelLevel(*this);
+        return new SoundSpeed(*this);
       }
 
       void
@@ -6670,25 +7438,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FuelLevel::getIdStatic();
+        return SoundSpeed::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FuelLevel";
+        return "SoundSpeed";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(opmodes);
+        return 4;
       }
 
       fp64_t
@@ -6699,55 +7461,33 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! GPS Navigation Data.
-    class GpsNavData: public Message
+    //! Water Density.
+    class WaterDensity: public Message
     {
     public:
-      //! GPS Millisecond Time of Week.
-      uint32_t itow;
-      //! Latitude.
-      fp64_t lat;
-      //! Longitude.
-      fp64_t lon;
-      //! Height above ellipsoid.
-      fp32_t height_ell;
-      //! Height above sea level.
-      fp32_t height_sea;
-      //! Horizontal Accuracy Estimate.
-      fp32_t hacc;
-      //! Vertical Accuracy Estimate.
-      fp32_t vacc;
-      //! NED North Velocity.
-      fp32_t vel_n;
-      //! NED East Velocity.
-      fp32_t vel_e;
-      //! NED Down Velocity.
-      fp32_t vel_d;
-      //! Speed (3D).
-      fp32_t speed;
-      //! Ground Speed (2D).
-      fp32_t gspeed;
-      //! Heading (2D).
-      fp32_t heading;
-      //! Speed Accuracy Estimate.
-      fp32_t sacc;
-      //! Course / Heading Accuracy Estimate.
-      fp32_t cacc;
+      //! Computed Water Density.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 280;
+        return 268;
       }
 
-      GpsNavData(void);
+      WaterDensity(void);
 
       Message*
       clone(void) const
       {
-        return new GpsNavData(*this);
+        return new WaterDensity(*this);
       }
 
       void
@@ -6771,46 +7511,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return GpsNavData::getIdStatic();
+        return WaterDensity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "GpsNavData";
+        return "WaterDensity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 68;
+        return 4;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Servo Position.
-    class ServoPosition: public Message
+    //! Conductivity.
+    class Conductivity: public Message
     {
     public:
-      //! Identifier.
-      uint8_t id;
-      //! Position.
+      //! Measured Conductivity.
       fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 281;
+        return 269;
       }
 
-      ServoPosition(void);
+      Conductivity(void);
 
       Message*
       clone(void) const
       {
-        return new ServoPosition(*this);
+        return new Conductivity(*this);
       }
 
       void
@@ -6834,27 +7584,21 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ServoPosition::getIdStatic();
+        return Conductivity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ServoPosition";
+        return "Conductivity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 4;
       }
 
-      uint16_t
-      getSubId(void) const;
-
-      void
-      setSubId(uint16_t subid);
-
       fp64_t
       getValueFP(void) const;
 
@@ -6863,36 +7607,33 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Data Sanity.
-    class DataSanity: public Message
+    //! Salinity.
+    class Salinity: public Message
     {
     public:
-      //! Sanity.
-      enum SanityEnum
-      {
-        //! Sane.
-        DS_SANE = 0,
-        //! Not Sane.
-        DS_NOT_SANE = 1
-      };
-
-      //! Sanity.
-      uint8_t sane;
+      //! Measured Salinity.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 284;
+        return 270;
       }
 
-      DataSanity(void);
+      Salinity(void);
 
       Message*
       clone(void) const
       {
-        return new DataSanity(*this);
+        return new Salinity(*this);
       }
 
       void
@@ -6916,61 +7657,60 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DataSanity::getIdStatic();
+        return Salinity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DataSanity";
+        return "Salinity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 4;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Camera Zoom.
-    class CameraZoom: public Message
+    //! Wind Speed.
+    class WindSpeed: public Message
     {
     public:
-      //! Action.
-      enum ActionEnum
-      {
-        //! Reset Zoom.
-        ACTION_ZOOM_RESET = 0,
-        //! Zoom In.
-        ACTION_ZOOM_IN = 1,
-        //! Zoom Out.
-        ACTION_ZOOM_OUT = 2,
-        //! Stop Zooming.
-        ACTION_ZOOM_STOP = 3
-      };
-
-      //! Camera Number.
-      uint8_t id;
-      //! Absolute Zoom Level.
-      uint8_t zoom;
-      //! Action.
-      uint8_t action;
+      //! Direction.
+      fp32_t direction;
+      //! Speed.
+      fp32_t speed;
+      //! Turbulence.
+      fp32_t turbulence;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 300;
+        return 271;
       }
 
-      CameraZoom(void);
+      WindSpeed(void);
 
       Message*
       clone(void) const
       {
-        return new CameraZoom(*this);
+        return new WindSpeed(*this);
       }
 
       void
@@ -6994,52 +7734,50 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CameraZoom::getIdStatic();
+        return WindSpeed::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CameraZoom";
+        return "WindSpeed";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 3;
+        return 12;
       }
 
-      uint16_t
-      getSubId(void) const;
-
       void
-      setSubId(uint16_t subid);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Set Thruster Actuation.
-    class SetThrusterActuation: public Message
+    //! Relative Humidity.
+    class RelativeHumidity: public Message
     {
     public:
-      //! Thruster Number.
-      uint8_t id;
-      //! Actuation Value.
+      //! Relative Humidity Value.
       fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 301;
+        return 272;
       }
 
-      SetThrusterActuation(void);
+      RelativeHumidity(void);
 
       Message*
       clone(void) const
       {
-        return new SetThrusterActuation(*this);
+        return new RelativeHumidity(*this);
       }
 
       void
@@ -7063,27 +7801,21 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SetThrusterActuation::getIdStatic();
+        return RelativeHumidity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SetThrusterActuation";
+        return "RelativeHumidity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 4;
       }
 
-      uint16_t
-      getSubId(void) const;
-
-      void
-      setSubId(uint16_t subid);
-
       fp64_t
       getValueFP(void) const;
 
@@ -7092,29 +7824,36 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Set Servo Position.
-    class SetServoPosition: public Message
+    //! Device Data (Text).
+    class DevDataText: public Message
     {
     public:
-      //! Identifier.
-      uint8_t id;
-      //! Position.
-      fp32_t value;
+      //! Value.
+      std::string value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 302;
+        return 273;
       }
 
-      SetServoPosition(void);
+      DevDataText(void);
+
+      void
+      swap(DevDataText& other__);
 
       Message*
       clone(void) const
       {
-        return new SetServoPosition(*this);
+        return new DevDataText(*this);
       }
 
       void
@@ -7138,58 +7877,59 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SetServoPosition::getIdStatic();
+        return DevDataText::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SetServoPosition";
+        return "DevDataText";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 0;
       }
 
-      uint16_t
-      getSubId(void) const;
-
-      void
-      setSubId(uint16_t subid);
-
-      fp64_t
-      getValueFP(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(value);
+      }
 
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Set Control Surface Deflection.
-    class SetControlSurfaceDeflection: public Message
+    //! Device Data (Binary).
+    class DevDataBinary: public Message
     {
     public:
-      //! Identifier.
-      uint8_t id;
-      //! Angle.
-      fp32_t angle;
+      //! Value.
+      std::vector<char> value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 303;
+        return 274;
       }
 
-      SetControlSurfaceDeflection(void);
+      DevDataBinary(void);
+
+      void
+      swap(DevDataBinary& other__);
 
       Message*
       clone(void) const
       {
-        return new SetControlSurfaceDeflection(*this);
+        return new DevDataBinary(*this);
       }
 
       void
@@ -7204,6 +7944,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -7213,61 +7956,60 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SetControlSurfaceDeflection::getIdStatic();
+        return DevDataBinary::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SetControlSurfaceDeflection";
+        return "DevDataBinary";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 0;
       }
 
-      uint16_t
-      getSubId(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(value);
+      }
 
       void
-      setSubId(uint16_t subid);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Remote Actions Request.
-    class RemoteActionsRequest: public Message
+    //! Sonar Configuration.
+    class SonarConfig: public Payload
     {
     public:
-      //! operation.
-      enum operationEnum
-      {
-        //! Report.
-        OP_REPORT = 0,
-        //! Query.
-        OP_QUERY = 1
-      };
-
-      //! operation.
-      uint8_t op;
-      //! Actions.
-      std::string actions;
+      //! Frequency.
+      uint32_t frequency;
+      //! Minimum Range.
+      uint16_t min_range;
+      //! Maximum Range.
+      uint16_t max_range;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 304;
+        return 275;
       }
 
-      RemoteActionsRequest(void);
+      SonarConfig(void);
 
       Message*
       clone(void) const
       {
-        return new RemoteActionsRequest(*this);
+        return new SonarConfig(*this);
       }
 
       void
@@ -7291,50 +8033,83 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return RemoteActionsRequest::getIdStatic();
+        return SonarConfig::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "RemoteActionsRequest";
+        return "SonarConfig";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(actions);
+        return 8;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Remote Actions.
-    class RemoteActions: public Message
+    //! Sonar Data.
+    class SonarData: public Message
     {
     public:
-      //! Actions.
-      std::string actions;
+      //! Type.
+      enum TypeEnum
+      {
+        //! Sidescan.
+        ST_SIDESCAN = 0,
+        //! Echo Sounder.
+        ST_ECHOSOUNDER = 1,
+        //! Multibeam.
+        ST_MULTIBEAM = 2
+      };
+
+      //! Type.
+      uint8_t type;
+      //! Frequency.
+      uint32_t frequency;
+      //! Minimum Range.
+      uint16_t min_range;
+      //! Maximum Range.
+      uint16_t max_range;
+      //! Bits Per Data Point.
+      uint8_t bits_per_point;
+      //! Scaling Factor.
+      fp32_t scale_factor;
+      //! Beam Configuration.
+      MessageList<BeamConfig> beam_config;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 305;
+        return 276;
       }
 
-      RemoteActions(void);
+      SonarData(void);
+
+      SonarData(const SonarData& other__);
+
+      void
+      swap(SonarData& other__);
+
+      SonarData&
+      operator=(const SonarData& other__);
 
       Message*
       clone(void) const
       {
-        return new RemoteActions(*this);
+        return new SonarData(*this);
       }
 
       void
@@ -7349,6 +8124,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -7358,60 +8136,75 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return RemoteActions::getIdStatic();
+        return SonarData::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "RemoteActions";
+        return "SonarData";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 14;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(actions);
+        return beam_config.getSerializationSize() + IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Button Event.
-    class ButtonEvent: public Message
+    //! Pulse.
+    class Pulse: public Message
     {
     public:
-      //! Button.
-      uint8_t button;
-      //! Value.
-      uint8_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 306;
+        return 277;
       }
 
-      ButtonEvent(void);
+      Pulse(void);
 
       Message*
       clone(void) const
       {
-        return new ButtonEvent(*this);
+        return new Pulse(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -7427,67 +8220,50 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ButtonEvent::getIdStatic();
+        return Pulse::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ButtonEvent";
+        return "Pulse";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 0;
       }
-
-      fp64_t
-      getValueFP(void) const;
-
-      void
-      setValueFP(fp64_t val);
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! LCD Control.
-    class LcdControl: public Message
+    //! Pulse Detection Control.
+    class PulseDetectionControl: public Message
     {
     public:
       //! Operation.
       enum OperationEnum
       {
-        //! Turn off display.
-        OP_TURN_OFF = 0,
-        //! Turn on display.
-        OP_TURN_ON = 1,
-        //! Clear display.
-        OP_CLEAR = 2,
-        //! Write Line #0.
-        OP_WRITE0 = 3,
-        //! Write Line #1.
-        OP_WRITE1 = 4
+        //! Pulse Detection OFF.
+        POP_OFF = 0,
+        //! Pulse Detection ON.
+        POP_ON = 1
       };
 
       //! Operation.
       uint8_t op;
-      //! Text.
-      std::string text;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 307;
+        return 278;
       }
 
-      LcdControl(void);
+      PulseDetectionControl(void);
 
       Message*
       clone(void) const
       {
-        return new LcdControl(*this);
+        return new PulseDetectionControl(*this);
       }
 
       void
@@ -7511,13 +8287,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LcdControl::getIdStatic();
+        return PulseDetectionControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LcdControl";
+        return "PulseDetectionControl";
       }
 
       unsigned
@@ -7526,58 +8302,42 @@ namespace DUNE
         return 1;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(text);
-      }
-
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Power Operation.
-    class PowerOperation: public Message
+    //! Fuel Level.
+    class FuelLevel: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
+      //! Value.
+      fp32_t value;
+      //! Confidence Level.
+      fp32_t confidence;
+      //! Operation Modes.
+      std::string opmodes;
+
+      static uint16_t
+      getIdStatic(void)
       {
-        //! Power Down.
-        POP_PWR_DOWN = 0,
-        //! Power Down in Progress.
-        POP_PWR_DOWN_IP = 1,
-        //! Power Down Aborted.
-        POP_PWR_DOWN_ABORTED = 2,
-        //! Schedule Power Down.
-        POP_SCHED_PWR_DOWN = 3,
-        //! Power Up.
-        POP_PWR_UP = 4,
-        //! Power Up in Progress.
-        POP_PWR_UP_IP = 5,
-        //! Schedule Power Up.
-        POP_SCHED_PWR_UP = 6
-      };
-
-      //! Operation.
-      uint8_t op;
-      //! Time Remaining.
-      fp32_t time_remain;
-      //! Scheduled Time.
-      fp64_t sched_time;
-
-      static uint16_t
-      getIdStatic(void)
-      {
-        return 308;
+        return 279;
       }
 
-      PowerOperation(void);
+      FuelLevel(void);
+
+      void
+      swap(FuelLevel& other__);
 
       Message*
       clone(void) const
       {
-        return new PowerOperation(*this);
+        return new FuelLevel(*this);
       }
 
       void
@@ -7601,67 +8361,90 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PowerOperation::getIdStatic();
+        return FuelLevel::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PowerOperation";
+        return "FuelLevel";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 13;
+        return 8;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(opmodes);
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Power Channel Control.
-    class PowerChannelControl: public Message
+    //! GPS Navigation Data.
+    class GpsNavData: public Message
     {
     public:
-      //! Operation.
-      enum OperationEnum
-      {
-        //! Turn Off.
-        PCC_OP_TURN_OFF = 0,
-        //! Turn On.
-        PCC_OP_TURN_ON = 1,
-        //! Toggle.
-        PCC_OP_TOGGLE = 2,
-        //! Schedule Turn On.
-        PCC_OP_SCHED_ON = 3,
-        //! Schedule Turn Off.
-        PCC_OP_SCHED_OFF = 4,
-        //! Reset Schedules.
-        PCC_OP_SCHED_RESET = 5,
-        //! Save Current State.
-        PCC_OP_SAVE = 6
-      };
-
-      //! Channel Name.
-      std::string name;
-      //! Operation.
-      uint8_t op;
-      //! Scheduled Time.
-      fp64_t sched_time;
+      //! GPS Millisecond Time of Week.
+      uint32_t itow;
+      //! Latitude.
+      fp64_t lat;
+      //! Longitude.
+      fp64_t lon;
+      //! Height above ellipsoid.
+      fp32_t height_ell;
+      //! Height above sea level.
+      fp32_t height_sea;
+      //! Horizontal Accuracy Estimate.
+      fp32_t hacc;
+      //! Vertical Accuracy Estimate.
+      fp32_t vacc;
+      //! NED North Velocity.
+      fp32_t vel_n;
+      //! NED East Velocity.
+      fp32_t vel_e;
+      //! NED Down Velocity.
+      fp32_t vel_d;
+      //! Speed (3D).
+      fp32_t speed;
+      //! Ground Speed (2D).
+      fp32_t gspeed;
+      //! Heading (2D).
+      fp32_t heading;
+      //! Speed Accuracy Estimate.
+      fp32_t sacc;
+      //! Course / Heading Accuracy Estimate.
+      fp32_t cacc;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 309;
+        return 280;
       }
 
-      PowerChannelControl(void);
+      GpsNavData(void);
 
       Message*
       clone(void) const
       {
-        return new PowerChannelControl(*this);
+        return new GpsNavData(*this);
       }
 
       void
@@ -7685,53 +8468,60 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PowerChannelControl::getIdStatic();
+        return GpsNavData::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PowerChannelControl";
+        return "GpsNavData";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 9;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(name);
+        return 68;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Query Power Channel State.
-    class QueryPowerChannelState: public Message
+    //! Servo Position.
+    class ServoPosition: public Message
     {
     public:
+      //! Identifier.
+      uint8_t id;
+      //! Position.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 310;
+        return 281;
       }
 
-      QueryPowerChannelState(void);
+      ServoPosition(void);
 
       Message*
       clone(void) const
       {
-        return new QueryPowerChannelState(*this);
+        return new ServoPosition(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -7747,52 +8537,71 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return QueryPowerChannelState::getIdStatic();
+        return ServoPosition::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "QueryPowerChannelState";
+        return "ServoPosition";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 5;
       }
+
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
+
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Power Channel State.
-    class PowerChannelState: public Message
+    //! Data Sanity.
+    class DataSanity: public Message
     {
     public:
-      //! State.
-      enum StateEnum
+      //! Sanity.
+      enum SanityEnum
       {
-        //! Off.
-        PCS_OFF = 0,
-        //! On.
-        PCS_ON = 1
+        //! Sane.
+        DS_SANE = 0,
+        //! Not Sane.
+        DS_NOT_SANE = 1
       };
 
-      //! Name.
-      std::string name;
-      //! State.
-      uint8_t state;
+      //! Sanity.
+      uint8_t sane;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 311;
+        return 284;
       }
 
-      PowerChannelState(void);
+      DataSanity(void);
 
       Message*
       clone(void) const
       {
-        return new PowerChannelState(*this);
+        return new DataSanity(*this);
       }
 
       void
@@ -7816,13 +8625,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PowerChannelState::getIdStatic();
+        return DataSanity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PowerChannelState";
+        return "DataSanity";
       }
 
       unsigned
@@ -7831,37 +8640,44 @@ namespace DUNE
         return 1;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(name);
-      }
-
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! LED Brightness.
-    class LedBrightness: public Message
+    //! Point Cloud.
+    class PointCloud: public Message
     {
     public:
-      //! Name.
-      std::string name;
-      //! Value.
-      uint8_t value;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Voxel Size.
+      fp32_t voxel;
+      //! Points.
+      std::vector<char> points;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 312;
+        return 285;
       }
 
-      LedBrightness(void);
+      PointCloud(void);
+
+      void
+      swap(PointCloud& other__);
 
       Message*
       clone(void) const
       {
-        return new LedBrightness(*this);
+        return new PointCloud(*this);
       }
 
       void
@@ -7876,6 +8692,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -7885,56 +8704,73 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LedBrightness::getIdStatic();
+        return PointCloud::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LedBrightness";
+        return "PointCloud";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 20;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(name);
+        return IMC::getSerializationSize(points);
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Query LED Brightness.
-    class QueryLedBrightness: public Message
+    //! Camera Zoom.
+    class CameraZoom: public Message
     {
     public:
-      //! Name.
-      std::string name;
+      //! Action.
+      enum ActionEnum
+      {
+        //! Reset Zoom.
+        ACTION_ZOOM_RESET = 0,
+        //! Zoom In.
+        ACTION_ZOOM_IN = 1,
+        //! Zoom Out.
+        ACTION_ZOOM_OUT = 2,
+        //! Stop Zooming.
+        ACTION_ZOOM_STOP = 3
+      };
+
+      //! Camera Number.
+      uint8_t id;
+      //! Absolute Zoom Level.
+      uint8_t zoom;
+      //! Action.
+      uint8_t action;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 313;
+        return 300;
       }
 
-      QueryLedBrightness(void);
+      CameraZoom(void);
 
       Message*
       clone(void) const
       {
-        return new QueryLedBrightness(*this);
+        return new CameraZoom(*this);
       }
 
       void
@@ -7958,52 +8794,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return QueryLedBrightness::getIdStatic();
+        return CameraZoom::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "QueryLedBrightness";
+        return "CameraZoom";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 3;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(name);
-      }
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Set LED Brightness.
-    class SetLedBrightness: public Message
+    //! Set Thruster Actuation.
+    class SetThrusterActuation: public Message
     {
     public:
-      //! Name.
-      std::string name;
-      //! Value.
-      uint8_t value;
+      //! Thruster Number.
+      uint8_t id;
+      //! Actuation Value.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 314;
+        return 301;
       }
 
-      SetLedBrightness(void);
+      SetThrusterActuation(void);
 
       Message*
       clone(void) const
       {
-        return new SetLedBrightness(*this);
+        return new SetThrusterActuation(*this);
       }
 
       void
@@ -8027,26 +8869,26 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SetLedBrightness::getIdStatic();
+        return SetThrusterActuation::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SetLedBrightness";
+        return "SetThrusterActuation";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 5;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(name);
-      }
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
 
       fp64_t
       getValueFP(void) const;
@@ -8056,31 +8898,35 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Set PWM.
-    class SetPWM: public Message
+    //! Set Servo Position.
+    class SetServoPosition: public Message
     {
     public:
-      //! Channel Identifier.
+      //! Identifier.
       uint8_t id;
-      //! Period.
-      uint32_t period;
-      //! Duty Cycle.
-      uint32_t duty_cycle;
+      //! Position.
+      fp32_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 315;
+        return 302;
       }
 
-      SetPWM(void);
+      SetServoPosition(void);
 
       Message*
       clone(void) const
       {
-        return new SetPWM(*this);
+        return new SetServoPosition(*this);
       }
 
       void
@@ -8104,19 +8950,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return SetPWM::getIdStatic();
+        return SetServoPosition::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "SetPWM";
+        return "SetServoPosition";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 9;
+        return 5;
       }
 
       uint16_t
@@ -8125,33 +8971,43 @@ namespace DUNE
       void
       setSubId(uint16_t subid);
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! PWM.
-    class PWM: public Message
+    //! Set Control Surface Deflection.
+    class SetControlSurfaceDeflection: public Message
     {
     public:
-      //! Channel Identifier.
+      //! Identifier.
       uint8_t id;
-      //! Period.
-      uint32_t period;
-      //! Duty Cycle.
-      uint32_t duty_cycle;
+      //! Angle.
+      fp32_t angle;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 316;
+        return 303;
       }
 
-      PWM(void);
+      SetControlSurfaceDeflection(void);
 
       Message*
       clone(void) const
       {
-        return new PWM(*this);
+        return new SetControlSurfaceDeflection(*this);
       }
 
       void
@@ -8175,19 +9031,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PWM::getIdStatic();
+        return SetControlSurfaceDeflection::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PWM";
+        return "SetControlSurfaceDeflection";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 9;
+        return 5;
       }
 
       uint16_t
@@ -8198,65 +9054,47 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Estimated State.
-    class EstimatedState: public Message
+    //! Remote Actions Request.
+    class RemoteActionsRequest: public Message
     {
     public:
-      //! Latitude (WGS-84).
-      fp64_t lat;
-      //! Longitude (WGS-84).
-      fp64_t lon;
-      //! Height (WGS-84).
-      fp32_t height;
-      //! Offset north.
-      fp32_t x;
-      //! Offset east.
-      fp32_t y;
-      //! Offset down.
-      fp32_t z;
-      //! Rotation over x axis.
-      fp32_t phi;
-      //! Rotation over y axis.
-      fp32_t theta;
-      //! Rotation over z axis.
-      fp32_t psi;
-      //! Body-Fixed xx Velocity.
-      fp32_t u;
-      //! Body-Fixed yy Velocity.
-      fp32_t v;
-      //! Body-Fixed zz Velocity.
-      fp32_t w;
-      //! Ground Velocity X (North).
-      fp32_t vx;
-      //! Ground Velocity Y (East).
-      fp32_t vy;
-      //! Ground Velocity Z (Down).
-      fp32_t vz;
-      //! Angular Velocity in x.
-      fp32_t p;
-      //! Angular Velocity in y.
-      fp32_t q;
-      //! Angular Velocity in z.
-      fp32_t r;
-      //! Depth.
-      fp32_t depth;
-      //! Altitude.
-      fp32_t alt;
+      //! operation.
+      enum operationEnum
+      {
+        //! Report.
+        OP_REPORT = 0,
+        //! Query.
+        OP_QUERY = 1
+      };
+
+      //! operation.
+      uint8_t op;
+      //! Actions.
+      std::string actions;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 350;
+        return 304;
       }
 
-      EstimatedState(void);
+      RemoteActionsRequest(void);
+
+      void
+      swap(RemoteActionsRequest& other__);
 
       Message*
       clone(void) const
       {
-        return new EstimatedState(*this);
+        return new RemoteActionsRequest(*this);
       }
 
       void
@@ -8280,48 +9118,59 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return EstimatedState::getIdStatic();
+        return RemoteActionsRequest::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "EstimatedState";
+        return "RemoteActionsRequest";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 88;
+        return 1;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(actions);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Estimated Stream Velocity.
-    class EstimatedStreamVelocity: public Message
+    //! Remote Actions.
+    class RemoteActions: public Message
     {
     public:
-      //! X component (North).
-      fp64_t x;
-      //! Y component (East).
-      fp64_t y;
-      //! Z component (Down).
-      fp64_t z;
+      //! Actions.
+      std::string actions;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 351;
+        return 305;
       }
 
-      EstimatedStreamVelocity(void);
+      RemoteActions(void);
+
+      void
+      swap(RemoteActions& other__);
 
       Message*
       clone(void) const
       {
-        return new EstimatedStreamVelocity(*this);
+        return new RemoteActions(*this);
       }
 
       void
@@ -8345,44 +9194,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return EstimatedStreamVelocity::getIdStatic();
+        return RemoteActions::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "EstimatedStreamVelocity";
+        return "RemoteActions";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 24;
+        return 0;
       }
 
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-    };
-
-    //! Indicated Speed.
-    class IndicatedSpeed: public Message
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(actions);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Button Event.
+    class ButtonEvent: public Message
     {
     public:
-      //! Measured speed.
-      fp64_t value;
+      //! Button.
+      uint8_t button;
+      //! Value.
+      uint8_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 352;
+        return 306;
       }
 
-      IndicatedSpeed(void);
+      ButtonEvent(void);
 
       Message*
       clone(void) const
       {
-        return new IndicatedSpeed(*this);
+        return new ButtonEvent(*this);
       }
 
       void
@@ -8406,19 +9269,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return IndicatedSpeed::getIdStatic();
+        return ButtonEvent::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "IndicatedSpeed";
+        return "ButtonEvent";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 2;
       }
 
       fp64_t
@@ -8429,27 +9292,53 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! True Speed.
-    class TrueSpeed: public Message
+    //! LCD Control.
+    class LcdControl: public Message
     {
     public:
-      //! Estimated value.
-      fp64_t value;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Turn off display.
+        OP_TURN_OFF = 0,
+        //! Turn on display.
+        OP_TURN_ON = 1,
+        //! Clear display.
+        OP_CLEAR = 2,
+        //! Write Line #0.
+        OP_WRITE0 = 3,
+        //! Write Line #1.
+        OP_WRITE1 = 4
+      };
+
+      //! Operation.
+      uint8_t op;
+      //! Text.
+      std::string text;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 353;
+        return 307;
       }
 
-      TrueSpeed(void);
+      LcdControl(void);
+
+      void
+      swap(LcdControl& other__);
 
       Message*
       clone(void) const
       {
-        return new TrueSpeed(*this);
+        return new LcdControl(*this);
       }
 
       void
@@ -8473,76 +9362,79 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return TrueSpeed::getIdStatic();
+        return LcdControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "TrueSpeed";
+        return "LcdControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 1;
       }
 
-      fp64_t
-      getValueFP(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(text);
+      }
 
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Navigation Uncertainty.
-    class NavigationUncertainty: public Message
+    //! Power Operation.
+    class PowerOperation: public Message
     {
     public:
-      //! Variance - x Position.
-      fp32_t x;
-      //! Variance - y Position.
-      fp32_t y;
-      //! Variance - z Position.
-      fp32_t z;
-      //! Variance - Roll.
-      fp32_t phi;
-      //! Variance - Pitch.
-      fp32_t theta;
-      //! Variance - Yaw.
-      fp32_t psi;
-      //! Variance - Gyro. Roll Rate.
-      fp32_t p;
-      //! Variance - Gyro. Pitch Rate.
-      fp32_t q;
-      //! Variance - Gyro. Yaw Rate.
-      fp32_t r;
-      //! Variance - Body-Fixed xx Velocity.
-      fp32_t u;
-      //! Variance - Body-Fixed yy Velocity.
-      fp32_t v;
-      //! Variance - Body-Fixed ww Velocity.
-      fp32_t w;
-      //! Variance - Yaw Bias.
-      fp32_t bias_psi;
-      //! Variance - Gyro. Yaw Rate Bias.
-      fp32_t bias_r;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Power Down.
+        POP_PWR_DOWN = 0,
+        //! Power Down in Progress.
+        POP_PWR_DOWN_IP = 1,
+        //! Power Down Aborted.
+        POP_PWR_DOWN_ABORTED = 2,
+        //! Schedule Power Down.
+        POP_SCHED_PWR_DOWN = 3,
+        //! Power Up.
+        POP_PWR_UP = 4,
+        //! Power Up in Progress.
+        POP_PWR_UP_IP = 5,
+        //! Schedule Power Up.
+        POP_SCHED_PWR_UP = 6
+      };
+
+      //! Operation.
+      uint8_t op;
+      //! Time Remaining.
+      fp32_t time_remain;
+      //! Scheduled Time.
+      fp64_t sched_time;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 354;
+        return 308;
       }
 
-      NavigationUncertainty(void);
+      PowerOperation(void);
 
       Message*
       clone(void) const
       {
-        return new NavigationUncertainty(*this);
+        return new PowerOperation(*this);
       }
 
       void
@@ -8566,60 +9458,76 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return NavigationUncertainty::getIdStatic();
+        return PowerOperation::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "NavigationUncertainty";
+        return "PowerOperation";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 56;
+        return 13;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Navigation Data.
-    class NavigationData: public Message
+    //! Power Channel Control.
+    class PowerChannelControl: public Message
     {
     public:
-      //! Yaw Bias.
-      fp32_t bias_psi;
-      //! Gyro. Yaw Rate Bias.
-      fp32_t bias_r;
-      //! Course Over Ground.
-      fp32_t cog;
-      //! Continuous Yaw.
-      fp32_t cyaw;
-      //! GPS Rejection Filter Level.
-      fp32_t lbl_rej_level;
-      //! LBL Rejection Filter Level.
-      fp32_t gps_rej_level;
-      //! Variance - Custom Variable X.
-      fp32_t custom_x;
-      //! Variance - Custom Variable Y.
-      fp32_t custom_y;
-      //! Variance - Custom Variable Z.
-      fp32_t custom_z;
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Turn Off.
+        PCC_OP_TURN_OFF = 0,
+        //! Turn On.
+        PCC_OP_TURN_ON = 1,
+        //! Toggle.
+        PCC_OP_TOGGLE = 2,
+        //! Schedule Turn On.
+        PCC_OP_SCHED_ON = 3,
+        //! Schedule Turn Off.
+        PCC_OP_SCHED_OFF = 4,
+        //! Reset Schedules.
+        PCC_OP_SCHED_RESET = 5,
+        //! Save Current State.
+        PCC_OP_SAVE = 6
+      };
+
+      //! Channel Name.
+      std::string name;
+      //! Operation.
+      uint8_t op;
+      //! Scheduled Time.
+      fp64_t sched_time;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 355;
+        return 309;
       }
 
-      NavigationData(void);
+      PowerChannelControl(void);
+
+      void
+      swap(PowerChannelControl& other__);
 
       Message*
       clone(void) const
       {
-        return new NavigationData(*this);
+        return new PowerChannelControl(*this);
       }
 
       void
@@ -8643,69 +9551,59 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return NavigationData::getIdStatic();
+        return PowerChannelControl::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "NavigationData";
+        return "PowerChannelControl";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 36;
+        return 9;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(name);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! GPS Fix Rejection.
-    class GpsFixRejection: public Message
+    //! Query Power Channel State.
+    class QueryPowerChannelState: public Message
     {
     public:
-      //! Reason.
-      enum ReasonEnum
-      {
-        //! Above Threshold.
-        RR_ABOVE_THRESHOLD = 0,
-        //! Invalid Fix.
-        RR_INVALID = 1,
-        //! Above Maximum HDOP.
-        RR_ABOVE_MAX_HDOP = 2,
-        //! Above Maximum HACC.
-        RR_ABOVE_MAX_HACC = 3,
-        //! Lost Validity Bit.
-        RR_LOST_VAL_BIT = 4
-      };
-
-      //! UTC Time of Fix.
-      fp32_t utc_time;
-      //! Reason.
-      uint8_t reason;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 356;
+        return 310;
       }
 
-      GpsFixRejection(void);
+      QueryPowerChannelState(void);
 
       Message*
       clone(void) const
       {
-        return new GpsFixRejection(*this);
+        return new QueryPowerChannelState(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -8721,63 +9619,55 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return GpsFixRejection::getIdStatic();
+        return QueryPowerChannelState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "GpsFixRejection";
+        return "QueryPowerChannelState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! LBL Range Acceptance.
-    class LblRangeAcceptance: public Message
+    //! Power Channel State.
+    class PowerChannelState: public Message
     {
     public:
-      //! Acceptance.
-      enum AcceptanceEnum
+      //! State.
+      enum StateEnum
       {
-        //! Accepted.
-        RR_ACCEPTED = 0,
-        //! Rejected - Above Threshold.
-        RR_ABOVE_THRESHOLD = 1,
-        //! Rejected - Singular Point.
-        RR_SINGULAR = 2,
-        //! Rejected - Not Enough Information.
-        RR_NO_INFO = 3,
-        //! Rejected - Vehicle At Surface.
-        RR_AT_SURFACE = 4
+        //! Off.
+        PCS_OFF = 0,
+        //! On.
+        PCS_ON = 1
       };
 
-      //! Beacon Identification Number.
-      uint8_t id;
-      //! Range.
-      fp32_t range;
-      //! Acceptance.
-      uint8_t acceptance;
+      //! Name.
+      std::string name;
+      //! State.
+      uint8_t state;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 357;
+        return 311;
       }
 
-      LblRangeAcceptance(void);
+      PowerChannelState(void);
+
+      void
+      swap(PowerChannelState& other__);
 
       Message*
       clone(void) const
       {
-        return new LblRangeAcceptance(*this);
+        return new PowerChannelState(*this);
       }
 
       void
@@ -8801,78 +9691,61 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LblRangeAcceptance::getIdStatic();
+        return PowerChannelState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LblRangeAcceptance";
+        return "PowerChannelState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 6;
+        return 1;
       }
 
-      uint16_t
-      getSubId(void) const;
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(name);
+      }
 
       void
-      setSubId(uint16_t subid);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! DVL Rejection.
-    class DvlRejection: public Message
+    //! LED Brightness.
+    class LedBrightness: public Message
     {
     public:
-      //! Reason.
-      enum ReasonEnum
-      {
-        //! Innovation Threshold - X.
-        RR_INNOV_THRESHOLD_X = 0,
-        //! Innovation Threshold - Y.
-        RR_INNOV_THRESHOLD_Y = 1,
-        //! Absolute Threshold - X.
-        RR_ABS_THRESHOLD_X = 2,
-        //! Absolute Threshold - Y.
-        RR_ABS_THRESHOLD_Y = 3
-      };
-
-      //! Type of velocity.
-      enum TypeofvelocityBits
-      {
-        //! Ground velocity.
-        TYPE_GV = 0x01,
-        //! Water velocity.
-        TYPE_WV = 0x02
-      };
-
-      //! Type of velocity.
-      uint8_t type;
-      //! Reason.
-      uint8_t reason;
+      //! Name.
+      std::string name;
       //! Value.
-      fp32_t value;
-      //! Timestep.
-      fp32_t timestep;
+      uint8_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 358;
+        return 312;
       }
 
-      DvlRejection(void);
+      LedBrightness(void);
+
+      void
+      swap(LedBrightness& other__);
 
       Message*
       clone(void) const
       {
-        return new DvlRejection(*this);
+        return new LedBrightness(*this);
       }
 
       void
@@ -8896,19 +9769,25 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DvlRejection::getIdStatic();
+        return LedBrightness::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DvlRejection";
+        return "LedBrightness";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 10;
+        return 1;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(name);
       }
 
       fp64_t
@@ -8919,30 +9798,44 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Navigation Reset.
-    class NavigationReset: public Message
+    //! Query LED Brightness.
+    class QueryLedBrightness: public Message
     {
     public:
+      //! Name.
+      std::string name;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 359;
+        return 313;
       }
 
-      NavigationReset(void);
+      QueryLedBrightness(void);
+
+      void
+      swap(QueryLedBrightness& other__);
 
       Message*
       clone(void) const
       {
-        return new NavigationReset(*this);
+        return new QueryLedBrightness(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -8958,13 +9851,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return NavigationReset::getIdStatic();
+        return QueryLedBrightness::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "NavigationReset";
+        return "QueryLedBrightness";
       }
 
       unsigned
@@ -8972,37 +9865,47 @@ namespace DUNE
       {
         return 0;
       }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(name);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! LBL Beacon Position Estimate.
-    class LblEstimate: public Message
+    //! Set LED Brightness.
+    class SetLedBrightness: public Message
     {
     public:
-      //! LBL Beacon Configuration.
-      InlineMessage<LblBeacon> beacon;
-      //! North position.
-      fp32_t x;
-      //! East position.
-      fp32_t y;
-      //! North position variance.
-      fp32_t var_x;
-      //! East position variance.
-      fp32_t var_y;
-      //! Distance.
-      fp32_t distance;
+      //! Name.
+      std::string name;
+      //! Value.
+      uint8_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 360;
+        return 314;
       }
 
-      LblEstimate(void);
+      SetLedBrightness(void);
+
+      void
+      swap(SetLedBrightness& other__);
 
       Message*
       clone(void) const
       {
-        return new LblEstimate(*this);
+        return new SetLedBrightness(*this);
       }
 
       void
@@ -9026,77 +9929,66 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LblEstimate::getIdStatic();
+        return SetLedBrightness::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LblEstimate";
+        return "SetLedBrightness";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 20;
+        return 1;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return beacon.getSerializationSize();
+        return IMC::getSerializationSize(name);
       }
 
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
-
-    protected:
-      void
-      setTimeStampNested(double value__);
+      fp64_t
+      getValueFP(void) const;
 
       void
-      setSourceNested(uint16_t value__);
+      setValueFP(fp64_t val);
 
       void
-      setSourceEntityNested(uint8_t value__);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Alignment State.
-    class AlignmentState: public Message
+    //! Set PWM.
+    class SetPWM: public Message
     {
     public:
-      //! State.
-      enum StateEnum
-      {
-        //! Not Aligned.
-        AS_NOT_ALIGNED = 0,
-        //! Aligned.
-        AS_ALIGNED = 1,
-        //! Not Supported.
-        AS_NOT_SUPPORTED = 2
-      };
-
-      //! State.
-      uint8_t state;
+      //! Channel Identifier.
+      uint8_t id;
+      //! Period.
+      uint32_t period;
+      //! Duty Cycle.
+      uint32_t duty_cycle;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 361;
+        return 315;
       }
 
-      AlignmentState(void);
+      SetPWM(void);
 
       Message*
       clone(void) const
       {
-        return new AlignmentState(*this);
+        return new SetPWM(*this);
       }
 
       void
@@ -9120,48 +10012,60 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AlignmentState::getIdStatic();
+        return SetPWM::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AlignmentState";
+        return "SetPWM";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 9;
       }
 
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! GroupStreamVelocity.
-    class GroupStreamVelocity: public Message
+    //! PWM.
+    class PWM: public Message
     {
     public:
-      //! X component (North).
-      fp64_t x;
-      //! Y component (East).
-      fp64_t y;
-      //! Z component (Down).
-      fp64_t z;
+      //! Channel Identifier.
+      uint8_t id;
+      //! Period.
+      uint32_t period;
+      //! Duty Cycle.
+      uint32_t duty_cycle;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 362;
+        return 316;
       }
 
-      GroupStreamVelocity(void);
+      PWM(void);
 
       Message*
       clone(void) const
       {
-        return new GroupStreamVelocity(*this);
+        return new PWM(*this);
       }
 
       void
@@ -9185,44 +10089,94 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return GroupStreamVelocity::getIdStatic();
+        return PWM::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "GroupStreamVelocity";
+        return "PWM";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 24;
+        return 9;
       }
 
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Heading.
-    class DesiredHeading: public ControlCommand
+    //! Estimated State.
+    class EstimatedState: public Message
     {
     public:
-      //! Value.
-      fp64_t value;
+      //! Latitude (WGS-84).
+      fp64_t lat;
+      //! Longitude (WGS-84).
+      fp64_t lon;
+      //! Height (WGS-84).
+      fp32_t height;
+      //! Offset north.
+      fp32_t x;
+      //! Offset east.
+      fp32_t y;
+      //! Offset down.
+      fp32_t z;
+      //! Rotation over x axis.
+      fp32_t phi;
+      //! Rotation over y axis.
+      fp32_t theta;
+      //! Rotation over z axis.
+      fp32_t psi;
+      //! Body-Fixed xx Velocity.
+      fp32_t u;
+      //! Body-Fixed yy Velocity.
+      fp32_t v;
+      //! Body-Fixed zz Velocity.
+      fp32_t w;
+      //! Ground Velocity X (North).
+      fp32_t vx;
+      //! Ground Velocity Y (East).
+      fp32_t vy;
+      //! Ground Velocity Z (Down).
+      fp32_t vz;
+      //! Angular Velocity in x.
+      fp32_t p;
+      //! Angular Velocity in y.
+      fp32_t q;
+      //! Angular Velocity in z.
+      fp32_t r;
+      //! Depth.
+      fp32_t depth;
+      //! Altitude.
+      fp32_t alt;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 400;
+        return 350;
       }
 
-      DesiredHeading(void);
+      EstimatedState(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredHeading(*this);
+        return new EstimatedState(*this);
       }
 
       void
@@ -9246,52 +10200,54 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredHeading::getIdStatic();
+        return EstimatedState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredHeading";
+        return "EstimatedState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 88;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Z.
-    class DesiredZ: public ControlCommand
+    //! Estimated Stream Velocity.
+    class EstimatedStreamVelocity: public Message
     {
     public:
-      //! Value.
-      fp32_t value;
-      //! Z Units.
-      uint8_t z_units;
+      //! X component (North).
+      fp64_t x;
+      //! Y component (East).
+      fp64_t y;
+      //! Z component (Down).
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 401;
+        return 351;
       }
 
-      DesiredZ(void);
+      EstimatedStreamVelocity(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredZ(*this);
+        return new EstimatedStreamVelocity(*this);
       }
 
       void
@@ -9315,52 +10271,50 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredZ::getIdStatic();
+        return EstimatedStreamVelocity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredZ";
+        return "EstimatedStreamVelocity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
+        return 24;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Speed.
-    class DesiredSpeed: public ControlCommand
+    //! Indicated Speed.
+    class IndicatedSpeed: public Message
     {
     public:
-      //! Value.
+      //! Measured speed.
       fp64_t value;
-      //! Speed Units.
-      uint8_t speed_units;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 402;
+        return 352;
       }
 
-      DesiredSpeed(void);
+      IndicatedSpeed(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredSpeed(*this);
+        return new IndicatedSpeed(*this);
       }
 
       void
@@ -9384,19 +10338,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredSpeed::getIdStatic();
+        return IndicatedSpeed::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredSpeed";
+        return "IndicatedSpeed";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 9;
+        return 8;
       }
 
       fp64_t
@@ -9407,27 +10361,33 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Roll.
-    class DesiredRoll: public ControlCommand
+    //! True Speed.
+    class TrueSpeed: public Message
     {
     public:
-      //! Value.
+      //! Estimated value.
       fp64_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 403;
+        return 353;
       }
 
-      DesiredRoll(void);
+      TrueSpeed(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredRoll(*this);
+        return new TrueSpeed(*this);
       }
 
       void
@@ -9451,13 +10411,13 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredRoll::getIdStatic();
+        return TrueSpeed::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredRoll";
+        return "TrueSpeed";
       }
 
       unsigned
@@ -9474,27 +10434,59 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Pitch.
-    class DesiredPitch: public ControlCommand
+    //! Navigation Uncertainty.
+    class NavigationUncertainty: public Message
     {
     public:
-      //! Value.
-      fp64_t value;
+      //! Variance - x Position.
+      fp32_t x;
+      //! Variance - y Position.
+      fp32_t y;
+      //! Variance - z Position.
+      fp32_t z;
+      //! Variance - Roll.
+      fp32_t phi;
+      //! Variance - Pitch.
+      fp32_t theta;
+      //! Variance - Yaw.
+      fp32_t psi;
+      //! Variance - Gyro. Roll Rate.
+      fp32_t p;
+      //! Variance - Gyro. Pitch Rate.
+      fp32_t q;
+      //! Variance - Gyro. Yaw Rate.
+      fp32_t r;
+      //! Variance - Body-Fixed xx Velocity.
+      fp32_t u;
+      //! Variance - Body-Fixed yy Velocity.
+      fp32_t v;
+      //! Variance - Body-Fixed ww Velocity.
+      fp32_t w;
+      //! Variance - Yaw Bias.
+      fp32_t bias_psi;
+      //! Variance - Gyro. Yaw Rate Bias.
+      fp32_t bias_r;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 404;
+        return 354;
       }
 
-      DesiredPitch(void);
+      NavigationUncertainty(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredPitch(*this);
+        return new NavigationUncertainty(*this);
       }
 
       void
@@ -9518,50 +10510,66 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredPitch::getIdStatic();
+        return NavigationUncertainty::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredPitch";
+        return "NavigationUncertainty";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 56;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Vertical Rate.
-    class DesiredVerticalRate: public Message
+    //! Navigation Data.
+    class NavigationData: public Message
     {
     public:
-      //! Value.
-      fp64_t value;
-
+      //! Yaw Bias.
+      fp32_t bias_psi;
+      //! Gyro. Yaw Rate Bias.
+      fp32_t bias_r;
+      //! Course Over Ground.
+      fp32_t cog;
+      //! Continuous Yaw.
+      fp32_t cyaw;
+      //! GPS Rejection Filter Level.
+      fp32_t lbl_rej_level;
+      //! LBL Rejection Filter Level.
+      fp32_t gps_rej_level;
+      //! Variance - Custom Variable X.
+      fp32_t custom_x;
+      //! Variance - Custom Variable Y.
+      fp32_t custom_y;
+      //! Variance - Custom Variable Z.
+      fp32_t custom_z;
+
       static uint16_t
       getIdStatic(void)
       {
-        return 405;
+        return 355;
       }
 
-      DesiredVerticalRate(void);
+      NavigationData(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredVerticalRate(*this);
+        return new NavigationData(*this);
       }
 
       void
@@ -9585,89 +10593,67 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredVerticalRate::getIdStatic();
+        return NavigationData::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredVerticalRate";
+        return "NavigationData";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 36;
       }
 
-      fp64_t
-      getValueFP(void) const;
-
       void
-      setValueFP(fp64_t val);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Path.
-    class DesiredPath: public ControlCommand
+    //! GPS Fix Rejection.
+    class GpsFixRejection: public Message
     {
     public:
-      //! Flags.
-      enum FlagsBits
+      //! Reason.
+      enum ReasonEnum
       {
-        //! Start Point.
-        FL_START = 0x01,
-        //! Direct.
-        FL_DIRECT = 0x02,
-        //! No Altitude/Depth control.
-        FL_NO_Z = 0x04,
-        //! 3D Tracking.
-        FL_3DTRACK = 0x08,
-        //! Counter-Clockwise loiter.
-        FL_CCLOCKW = 0x10,
-        //! Loiter from current position.
-        FL_LOITER_CURR = 0x20
+        //! Above Threshold.
+        RR_ABOVE_THRESHOLD = 0,
+        //! Invalid Fix.
+        RR_INVALID = 1,
+        //! Above Maximum HDOP.
+        RR_ABOVE_MAX_HDOP = 2,
+        //! Above Maximum HACC.
+        RR_ABOVE_MAX_HACC = 3,
+        //! Lost Validity Bit.
+        RR_LOST_VAL_BIT = 4
       };
 
-      //! Start Point -- Latitude WGS-84.
-      fp64_t start_lat;
-      //! Start Point -- WGS-84 Longitude.
-      fp64_t start_lon;
-      //! Start Point -- Z Reference.
-      fp32_t start_z;
-      //! Start Point -- Z Units.
-      uint8_t start_z_units;
-      //! End Point -- WGS84 Latitude.
-      fp64_t end_lat;
-      //! End Point -- WGS-84 Longitude.
-      fp64_t end_lon;
-      //! End Point -- Z Reference.
-      fp32_t end_z;
-      //! End Point -- Z Units.
-      uint8_t end_z_units;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
-      //! Loiter -- Radius.
-      fp32_t lradius;
-      //! Flags.
-      uint8_t flags;
+      //! UTC Time of Fix.
+      fp32_t utc_time;
+      //! Reason.
+      uint8_t reason;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 406;
+        return 356;
       }
 
-      DesiredPath(void);
+      GpsFixRejection(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredPath(*this);
+        return new GpsFixRejection(*this);
       }
 
       void
@@ -9691,73 +10677,69 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredPath::getIdStatic();
+        return GpsFixRejection::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredPath";
+        return "GpsFixRejection";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 52;
+        return 5;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Control.
-    class DesiredControl: public Message
+    //! LBL Range Acceptance.
+    class LblRangeAcceptance: public Message
     {
     public:
-      //! Flags.
-      enum FlagsBits
+      //! Acceptance.
+      enum AcceptanceEnum
       {
-        //! Value of X is meaningful.
-        FL_X = 0x01,
-        //! Value of Y is meaningful.
-        FL_Y = 0x02,
-        //! Value of Z is meaningful.
-        FL_Z = 0x04,
-        //! Value of K is meaningful.
-        FL_K = 0x08,
-        //! Value of M is meaningful.
-        FL_M = 0x10,
-        //! Value of N is meaningful.
-        FL_N = 0x20
+        //! Accepted.
+        RR_ACCEPTED = 0,
+        //! Rejected - Above Threshold.
+        RR_ABOVE_THRESHOLD = 1,
+        //! Rejected - Singular Point.
+        RR_SINGULAR = 2,
+        //! Rejected - Not Enough Information.
+        RR_NO_INFO = 3,
+        //! Rejected - Vehicle At Surface.
+        RR_AT_SURFACE = 4
       };
 
-      //! Force along the x axis.
-      fp64_t x;
-      //! Force along the y axis.
-      fp64_t y;
-      //! Force along the z axis.
-      fp64_t z;
-      //! Torque about the x axis.
-      fp64_t k;
-      //! Torque about the y axis.
-      fp64_t m;
-      //! Torque about the z axis.
-      fp64_t n;
-      //! Flags.
-      uint8_t flags;
+      //! Beacon Identification Number.
+      uint8_t id;
+      //! Range.
+      fp32_t range;
+      //! Acceptance.
+      uint8_t acceptance;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 407;
+        return 357;
       }
 
-      DesiredControl(void);
+      LblRangeAcceptance(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredControl(*this);
+        return new LblRangeAcceptance(*this);
       }
 
       void
@@ -9781,44 +10763,84 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredControl::getIdStatic();
+        return LblRangeAcceptance::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredControl";
+        return "LblRangeAcceptance";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 49;
+        return 6;
       }
 
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Heading Rate.
-    class DesiredHeadingRate: public Message
+    //! DVL Rejection.
+    class DvlRejection: public Message
     {
     public:
+      //! Reason.
+      enum ReasonEnum
+      {
+        //! Innovation Threshold - X.
+        RR_INNOV_THRESHOLD_X = 0,
+        //! Innovation Threshold - Y.
+        RR_INNOV_THRESHOLD_Y = 1,
+        //! Absolute Threshold - X.
+        RR_ABS_THRESHOLD_X = 2,
+        //! Absolute Threshold - Y.
+        RR_ABS_THRESHOLD_Y = 3
+      };
+
+      //! Type of velocity.
+      enum TypeofvelocityBits
+      {
+        //! Ground velocity.
+        TYPE_GV = 0x01,
+        //! Water velocity.
+        TYPE_WV = 0x02
+      };
+
+      //! Type of velocity.
+      uint8_t type;
+      //! Reason.
+      uint8_t reason;
       //! Value.
-      fp64_t value;
+      fp32_t value;
+      //! Timestep.
+      fp32_t timestep;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 408;
+        return 358;
       }
 
-      DesiredHeadingRate(void);
+      DvlRejection(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredHeadingRate(*this);
+        return new DvlRejection(*this);
       }
 
       void
@@ -9842,19 +10864,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredHeadingRate::getIdStatic();
+        return DvlRejection::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredHeadingRate";
+        return "DvlRejection";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 8;
+        return 10;
       }
 
       fp64_t
@@ -9865,64 +10887,36 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Desired Velocity.
-    class DesiredVelocity: public Message
+    //! Navigation Reset.
+    class NavigationReset: public Message
     {
     public:
-      //! Flags.
-      enum FlagsBits
-      {
-        //! Value of u is meaningful.
-        FL_SURGE = 0x01,
-        //! Value of v is meaningful.
-        FL_SWAY = 0x02,
-        //! Value of w is meaningful.
-        FL_HEAVE = 0x04,
-        //! Value of p is meaningful.
-        FL_ROLL = 0x08,
-        //! Value of q is meaningful.
-        FL_PITCH = 0x10,
-        //! Value of r is meaningful.
-        FL_YAW = 0x20
-      };
-
-      //! Desired Linear Speed in xx.
-      fp64_t u;
-      //! Desired Linear Speed in yy.
-      fp64_t v;
-      //! Desired Linear Speed in zz.
-      fp64_t w;
-      //! Desired Angular Speed in xx.
-      fp64_t p;
-      //! Desired Angular Speed in yy.
-      fp64_t q;
-      //! Desired Angular Speed in zz.
-      fp64_t r;
-      //! Flags.
-      uint8_t flags;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 409;
+        return 359;
       }
 
-      DesiredVelocity(void);
+      NavigationReset(void);
 
       Message*
       clone(void) const
       {
-        return new DesiredVelocity(*this);
+        return new NavigationReset(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -9938,93 +10932,59 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return DesiredVelocity::getIdStatic();
+        return NavigationReset::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "DesiredVelocity";
+        return "NavigationReset";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 49;
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Path Control State.
-    class PathControlState: public Message
+    //! LBL Beacon Position Estimate.
+    class LblEstimate: public Message
     {
     public:
-      //! Flags.
-      enum FlagsBits
-      {
-        //! Near Endpoint.
-        FL_NEAR = 0x01,
-        //! Loitering.
-        FL_LOITERING = 0x02,
-        //! No Altitude/Depth control.
-        FL_NO_Z = 0x04,
-        //! 3D Tracking.
-        FL_3DTRACK = 0x08,
-        //! Counter-Clockwise loiter.
-        FL_CCLOCKW = 0x10
-      };
-
-      //! Start Point -- Latitude WGS-84.
-      fp64_t start_lat;
-      //! Start Point -- WGS-84 Longitude.
-      fp64_t start_lon;
-      //! Start Point -- Z Reference.
-      fp32_t start_z;
-      //! Start Point -- Z Units.
-      uint8_t start_z_units;
-      //! End Point -- Latitude WGS-84.
-      fp64_t end_lat;
-      //! End Point -- WGS-84 Longitude.
-      fp64_t end_lon;
-      //! End Point -- Z Reference.
-      fp32_t end_z;
-      //! End Point -- Z Units.
-      uint8_t end_z_units;
-      //! Loiter -- Radius.
-      fp32_t lradius;
-      //! Flags.
-      uint8_t flags;
-      //! Along Track Position.
+      //! LBL Beacon Configuration.
+      InlineMessage<LblBeacon> beacon;
+      //! North position.
       fp32_t x;
-      //! Cross Track Position.
+      //! East position.
       fp32_t y;
-      //! Vertical Track Position.
-      fp32_t z;
-      //! Along Track Velocity.
-      fp32_t vx;
-      //! Cross Track Velocity.
-      fp32_t vy;
-      //! Vertical Track Velocity.
-      fp32_t vz;
-      //! Course Error.
-      fp32_t course_error;
-      //! Estimated Time to Arrival (ETA).
-      uint16_t eta;
+      //! North position variance.
+      fp32_t var_x;
+      //! East position variance.
+      fp32_t var_y;
+      //! Distance.
+      fp32_t distance;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 410;
+        return 360;
       }
 
-      PathControlState(void);
+      LblEstimate(void);
+
+      LblEstimate(const LblEstimate& other__);
+
+      void
+      swap(LblEstimate& other__);
+
+      LblEstimate&
+      operator=(const LblEstimate& other__);
 
       Message*
       clone(void) const
       {
-        return new PathControlState(*this);
+        return new LblEstimate(*this);
       }
 
       void
@@ -10048,48 +11008,83 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PathControlState::getIdStatic();
+        return LblEstimate::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PathControlState";
+        return "LblEstimate";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 77;
+        return 20;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return beacon.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Allocated Control Torques.
-    class AllocatedControlTorques: public Message
+    //! Alignment State.
+    class AlignmentState: public Message
     {
     public:
-      //! Torque about the x axis.
-      fp64_t k;
-      //! Torque about the y axis.
-      fp64_t m;
-      //! Torque about the x axis.
-      fp64_t n;
+      //! State.
+      enum StateEnum
+      {
+        //! Not Aligned.
+        AS_NOT_ALIGNED = 0,
+        //! Aligned.
+        AS_ALIGNED = 1,
+        //! Not Supported.
+        AS_NOT_SUPPORTED = 2
+      };
+
+      //! State.
+      uint8_t state;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 411;
+        return 361;
       }
 
-      AllocatedControlTorques(void);
+      AlignmentState(void);
 
       Message*
       clone(void) const
       {
-        return new AllocatedControlTorques(*this);
+        return new AlignmentState(*this);
       }
 
       void
@@ -10113,50 +11108,54 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return AllocatedControlTorques::getIdStatic();
+        return AlignmentState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "AllocatedControlTorques";
+        return "AlignmentState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 24;
+        return 1;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Control Parcel.
-    class ControlParcel: public Message
+    //! GroupStreamVelocity.
+    class GroupStreamVelocity: public Message
     {
     public:
-      //! Proportional Parcel.
-      fp32_t p;
-      //! Integrative Parcel.
-      fp32_t i;
-      //! Derivative Parcel.
-      fp32_t d;
-      //! Anti-Windup Parcel.
-      fp32_t a;
+      //! X component (North).
+      fp64_t x;
+      //! Y component (East).
+      fp64_t y;
+      //! Z component (Down).
+      fp64_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 412;
+        return 362;
       }
 
-      ControlParcel(void);
+      GroupStreamVelocity(void);
 
       Message*
       clone(void) const
       {
-        return new ControlParcel(*this);
+        return new GroupStreamVelocity(*this);
       }
 
       void
@@ -10180,53 +11179,50 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ControlParcel::getIdStatic();
+        return GroupStreamVelocity::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ControlParcel";
+        return "GroupStreamVelocity";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 16;
+        return 24;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Brake.
-    class Brake: public Message
+    //! Desired Heading.
+    class DesiredHeading: public ControlCommand
     {
     public:
-      //! Operation.
-      enum OperationEnum
-      {
-        //! Stop Braking.
-        OP_STOP = 0,
-        //! Start Braking.
-        OP_START = 1
-      };
-
-      //! Operation.
-      uint8_t op;
+      //! Value.
+      fp64_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 413;
+        return 400;
       }
 
-      Brake(void);
+      DesiredHeading(void);
 
       Message*
       clone(void) const
       {
-        return new Brake(*this);
+        return new DesiredHeading(*this);
       }
 
       void
@@ -10250,64 +11246,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Brake::getIdStatic();
+        return DesiredHeading::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Brake";
+        return "DesiredHeading";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 8;
       }
 
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Goto Maneuver.
-    class Goto: public Maneuver
+    //! Desired Z.
+    class DesiredZ: public ControlCommand
     {
     public:
-      //! Timeout.
-      uint16_t timeout;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
+      //! Value.
+      fp32_t value;
       //! Z Units.
       uint8_t z_units;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
-      //! Roll.
-      fp64_t roll;
-      //! Pitch.
-      fp64_t pitch;
-      //! Yaw.
-      fp64_t yaw;
-      //! Custom settings for maneuver.
-      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 450;
+        return 401;
       }
 
-      Goto(void);
+      DesiredZ(void);
 
       Message*
       clone(void) const
       {
-        return new Goto(*this);
+        return new DesiredZ(*this);
       }
 
       void
@@ -10331,81 +11321,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Goto::getIdStatic();
+        return DesiredZ::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Goto";
+        return "DesiredZ";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 52;
+        return 5;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(custom);
-      }
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! PopUp Maneuver.
-    class PopUp: public Maneuver
+    //! Desired Speed.
+    class DesiredSpeed: public ControlCommand
     {
     public:
-      //! Flags.
-      enum FlagsBits
-      {
-        //! Start from current position.
-        FLG_CURR_POS = 0x01,
-        //! Wait at surface.
-        FLG_WAIT_AT_SURFACE = 0x02,
-        //! Station keeping.
-        FLG_STATION_KEEP = 0x04
-      };
-
-      //! Timeout.
-      uint16_t timeout;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
-      //! Speed.
-      fp32_t speed;
+      //! Value.
+      fp64_t value;
       //! Speed Units.
       uint8_t speed_units;
-      //! Duration.
-      uint16_t duration;
-      //! Radius.
-      fp32_t radius;
-      //! Flags.
-      uint8_t flags;
-      //! Custom settings for maneuver.
-      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 451;
+        return 402;
       }
 
-      PopUp(void);
+      DesiredSpeed(void);
 
       Message*
       clone(void) const
       {
-        return new PopUp(*this);
+        return new DesiredSpeed(*this);
       }
 
       void
@@ -10429,50 +11396,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PopUp::getIdStatic();
+        return DesiredSpeed::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PopUp";
+        return "DesiredSpeed";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 35;
+        return 9;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(custom);
-      }
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Teleoperation Maneuver.
-    class Teleoperation: public Maneuver
+    //! Desired Roll.
+    class DesiredRoll: public ControlCommand
     {
     public:
-      //! Custom settings for maneuver.
-      std::string custom;
+      //! Value.
+      fp64_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 452;
+        return 403;
       }
 
-      Teleoperation(void);
+      DesiredRoll(void);
 
       Message*
       clone(void) const
       {
-        return new Teleoperation(*this);
+        return new DesiredRoll(*this);
       }
 
       void
@@ -10496,104 +11469,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Teleoperation::getIdStatic();
+        return DesiredRoll::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Teleoperation";
+        return "DesiredRoll";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 8;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(custom);
-      }
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Loiter Maneuver.
-    class Loiter: public Maneuver
+    //! Desired Pitch.
+    class DesiredPitch: public ControlCommand
     {
     public:
-      //! Loiter Type.
-      enum LoiterTypeEnum
-      {
-        //! Default.
-        LT_DEFAULT = 0,
-        //! Circular.
-        LT_CIRCULAR = 1,
-        //! Race track.
-        LT_RACETRACK = 2,
-        //! Figure 8.
-        LT_EIGHT = 3,
-        //! Hover.
-        LT_HOVER = 4
-      };
-
-      //! Direction.
-      enum DirectionEnum
-      {
-        //! Vehicle Dependent.
-        LD_VDEP = 0,
-        //! Clockwise.
-        LD_CLOCKW = 1,
-        //! Counter Clockwise.
-        LD_CCLOCKW = 2,
-        //! Into the wind/current.
-        LD_IWINDCURR = 3
-      };
-
-      //! Timeout.
-      uint16_t timeout;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
-      //! Duration.
-      uint16_t duration;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
-      //! Loiter Type.
-      uint8_t type;
-      //! Radius.
-      fp32_t radius;
-      //! Length.
-      fp32_t length;
-      //! Bearing.
-      fp64_t bearing;
-      //! Direction.
-      uint8_t direction;
-      //! Custom settings for maneuver.
-      std::string custom;
+      //! Value.
+      fp64_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 453;
+        return 404;
       }
 
-      Loiter(void);
+      DesiredPitch(void);
 
       Message*
       clone(void) const
       {
-        return new Loiter(*this);
+        return new DesiredPitch(*this);
       }
 
       void
@@ -10617,52 +11542,56 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Loiter::getIdStatic();
+        return DesiredPitch::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Loiter";
+        return "DesiredPitch";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 48;
+        return 8;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(custom);
-      }
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Idle Maneuver.
-    class IdleManeuver: public Maneuver
+    //! Desired Vertical Rate.
+    class DesiredVerticalRate: public Message
     {
     public:
-      //! Duration.
-      uint16_t duration;
-      //! Custom settings for maneuver.
-      std::string custom;
+      //! Value.
+      fp64_t value;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 454;
+        return 405;
       }
 
-      IdleManeuver(void);
+      DesiredVerticalRate(void);
 
       Message*
       clone(void) const
       {
-        return new IdleManeuver(*this);
+        return new DesiredVerticalRate(*this);
       }
 
       void
@@ -10686,54 +11615,1561 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return IdleManeuver::getIdStatic();
+        return DesiredVerticalRate::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "IdleManeuver";
+        return "DesiredVerticalRate";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 8;
       }
 
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(custom);
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Desired Path.
+    class DesiredPath: public ControlCommand
+    {
+    public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Start Point.
+        FL_START = 0x01,
+        //! Direct.
+        FL_DIRECT = 0x02,
+        //! No Altitude/Depth control.
+        FL_NO_Z = 0x04,
+        //! 3D Tracking.
+        FL_3DTRACK = 0x08,
+        //! Counter-Clockwise loiter.
+        FL_CCLOCKW = 0x10,
+        //! Loiter from current position.
+        FL_LOITER_CURR = 0x20
+      };
+
+      //! Start Point -- Latitude WGS-84.
+      fp64_t start_lat;
+      //! Start Point -- WGS-84 Longitude.
+      fp64_t start_lon;
+      //! Start Point -- Z Reference.
+      fp32_t start_z;
+      //! Start Point -- Z Units.
+      uint8_t start_z_units;
+      //! End Point -- WGS84 Latitude.
+      fp64_t end_lat;
+      //! End Point -- WGS-84 Longitude.
+      fp64_t end_lon;
+      //! End Point -- Z Reference.
+      fp32_t end_z;
+      //! End Point -- Z Units.
+      uint8_t end_z_units;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Loiter -- Radius.
+      fp32_t lradius;
+      //! Flags.
+      uint8_t flags;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 406;
+      }
+
+      DesiredPath(void);
+
+      Message*
+      clone(void) const
+      {
+        return new DesiredPath(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return DesiredPath::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "DesiredPath";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 52;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Desired Control.
+    class DesiredControl: public Message
+    {
+    public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Value of X is meaningful.
+        FL_X = 0x01,
+        //! Value of Y is meaningful.
+        FL_Y = 0x02,
+        //! Value of Z is meaningful.
+        FL_Z = 0x04,
+        //! Value of K is meaningful.
+        FL_K = 0x08,
+        //! Value of M is meaningful.
+        FL_M = 0x10,
+        //! Value of N is meaningful.
+        FL_N = 0x20
+      };
+
+      //! Force along the x axis.
+      fp64_t x;
+      //! Force along the y axis.
+      fp64_t y;
+      //! Force along the z axis.
+      fp64_t z;
+      //! Torque about the x axis.
+      fp64_t k;
+      //! Torque about the y axis.
+      fp64_t m;
+      //! Torque about the z axis.
+      fp64_t n;
+      //! Flags.
+      uint8_t flags;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 407;
+      }
+
+      DesiredControl(void);
+
+      Message*
+      clone(void) const
+      {
+        return new DesiredControl(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return DesiredControl::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "DesiredControl";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 49;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Desired Heading Rate.
+    class DesiredHeadingRate: public Message
+    {
+    public:
+      //! Value.
+      fp64_t value;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 408;
+      }
+
+      DesiredHeadingRate(void);
+
+      Message*
+      clone(void) const
+      {
+        return new DesiredHeadingRate(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return DesiredHeadingRate::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "DesiredHeadingRate";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 8;
+      }
+
+      fp64_t
+      getValueFP(void) const;
+
+      void
+      setValueFP(fp64_t val);
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Desired Velocity.
+    class DesiredVelocity: public Message
+    {
+    public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Value of u is meaningful.
+        FL_SURGE = 0x01,
+        //! Value of v is meaningful.
+        FL_SWAY = 0x02,
+        //! Value of w is meaningful.
+        FL_HEAVE = 0x04,
+        //! Value of p is meaningful.
+        FL_ROLL = 0x08,
+        //! Value of q is meaningful.
+        FL_PITCH = 0x10,
+        //! Value of r is meaningful.
+        FL_YAW = 0x20
+      };
+
+      //! Desired Linear Speed in xx.
+      fp64_t u;
+      //! Desired Linear Speed in yy.
+      fp64_t v;
+      //! Desired Linear Speed in zz.
+      fp64_t w;
+      //! Desired Angular Speed in xx.
+      fp64_t p;
+      //! Desired Angular Speed in yy.
+      fp64_t q;
+      //! Desired Angular Speed in zz.
+      fp64_t r;
+      //! Flags.
+      uint8_t flags;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 409;
+      }
+
+      DesiredVelocity(void);
+
+      Message*
+      clone(void) const
+      {
+        return new DesiredVelocity(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return DesiredVelocity::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "DesiredVelocity";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 49;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Path Control State.
+    class PathControlState: public Message
+    {
+    public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Near Endpoint.
+        FL_NEAR = 0x01,
+        //! Loitering.
+        FL_LOITERING = 0x02,
+        //! No Altitude/Depth control.
+        FL_NO_Z = 0x04,
+        //! 3D Tracking.
+        FL_3DTRACK = 0x08,
+        //! Counter-Clockwise loiter.
+        FL_CCLOCKW = 0x10
+      };
+
+      //! Start Point -- Latitude WGS-84.
+      fp64_t start_lat;
+      //! Start Point -- WGS-84 Longitude.
+      fp64_t start_lon;
+      //! Start Point -- Z Reference.
+      fp32_t start_z;
+      //! Start Point -- Z Units.
+      uint8_t start_z_units;
+      //! End Point -- Latitude WGS-84.
+      fp64_t end_lat;
+      //! End Point -- WGS-84 Longitude.
+      fp64_t end_lon;
+      //! End Point -- Z Reference.
+      fp32_t end_z;
+      //! End Point -- Z Units.
+      uint8_t end_z_units;
+      //! Loiter -- Radius.
+      fp32_t lradius;
+      //! Flags.
+      uint8_t flags;
+      //! Along Track Position.
+      fp32_t x;
+      //! Cross Track Position.
+      fp32_t y;
+      //! Vertical Track Position.
+      fp32_t z;
+      //! Along Track Velocity.
+      fp32_t vx;
+      //! Cross Track Velocity.
+      fp32_t vy;
+      //! Vertical Track Velocity.
+      fp32_t vz;
+      //! Course Error.
+      fp32_t course_error;
+      //! Estimated Time to Arrival (ETA).
+      uint16_t eta;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 410;
+      }
+
+      PathControlState(void);
+
+      Message*
+      clone(void) const
+      {
+        return new PathControlState(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return PathControlState::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "PathControlState";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 77;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Allocated Control Torques.
+    class AllocatedControlTorques: public Message
+    {
+    public:
+      //! Torque about the x axis.
+      fp64_t k;
+      //! Torque about the y axis.
+      fp64_t m;
+      //! Torque about the x axis.
+      fp64_t n;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 411;
+      }
+
+      AllocatedControlTorques(void);
+
+      Message*
+      clone(void) const
+      {
+        return new AllocatedControlTorques(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return AllocatedControlTorques::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "AllocatedControlTorques";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 24;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Control Parcel.
+    class ControlParcel: public Message
+    {
+    public:
+      //! Proportional Parcel.
+      fp32_t p;
+      //! Integrative Parcel.
+      fp32_t i;
+      //! Derivative Parcel.
+      fp32_t d;
+      //! Anti-Windup Parcel.
+      fp32_t a;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 412;
+      }
+
+      ControlParcel(void);
+
+      Message*
+      clone(void) const
+      {
+        return new ControlParcel(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return ControlParcel::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "ControlParcel";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 16;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Brake.
+    class Brake: public Message
+    {
+    public:
+      //! Operation.
+      enum OperationEnum
+      {
+        //! Stop Braking.
+        OP_STOP = 0,
+        //! Start Braking.
+        OP_START = 1
+      };
+
+      //! Operation.
+      uint8_t op;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 413;
+      }
+
+      Brake(void);
+
+      Message*
+      clone(void) const
+      {
+        return new Brake(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return Brake::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "Brake";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 1;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Goto Maneuver.
+    class Goto: public Maneuver
+    {
+    public:
+      //! Timeout.
+      uint16_t timeout;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Roll.
+      fp64_t roll;
+      //! Pitch.
+      fp64_t pitch;
+      //! Yaw.
+      fp64_t yaw;
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 450;
+      }
+
+      Goto(void);
+
+      void
+      swap(Goto& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new Goto(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return Goto::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "Goto";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 52;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! PopUp Maneuver.
+    class PopUp: public Maneuver
+    {
+    public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Start from current position.
+        FLG_CURR_POS = 0x01,
+        //! Wait at surface.
+        FLG_WAIT_AT_SURFACE = 0x02,
+        //! Station keeping.
+        FLG_STATION_KEEP = 0x04
+      };
+
+      //! Timeout.
+      uint16_t timeout;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Duration.
+      uint16_t duration;
+      //! Radius.
+      fp32_t radius;
+      //! Flags.
+      uint8_t flags;
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 451;
+      }
+
+      PopUp(void);
+
+      void
+      swap(PopUp& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new PopUp(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return PopUp::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "PopUp";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 35;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Teleoperation Maneuver.
+    class Teleoperation: public Maneuver
+    {
+    public:
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 452;
+      }
+
+      Teleoperation(void);
+
+      void
+      swap(Teleoperation& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new Teleoperation(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return Teleoperation::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "Teleoperation";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 0;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Loiter Maneuver.
+    class Loiter: public Maneuver
+    {
+    public:
+      //! Loiter Type.
+      enum LoiterTypeEnum
+      {
+        //! Default.
+        LT_DEFAULT = 0,
+        //! Circular.
+        LT_CIRCULAR = 1,
+        //! Race track.
+        LT_RACETRACK = 2,
+        //! Figure 8.
+        LT_EIGHT = 3,
+        //! Hover.
+        LT_HOVER = 4
+      };
+
+      //! Direction.
+      enum DirectionEnum
+      {
+        //! Vehicle Dependent.
+        LD_VDEP = 0,
+        //! Clockwise.
+        LD_CLOCKW = 1,
+        //! Counter Clockwise.
+        LD_CCLOCKW = 2,
+        //! Into the wind/current.
+        LD_IWINDCURR = 3
+      };
+
+      //! Timeout.
+      uint16_t timeout;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Duration.
+      uint16_t duration;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Loiter Type.
+      uint8_t type;
+      //! Radius.
+      fp32_t radius;
+      //! Length.
+      fp32_t length;
+      //! Bearing.
+      fp64_t bearing;
+      //! Direction.
+      uint8_t direction;
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 453;
+      }
+
+      Loiter(void);
+
+      void
+      swap(Loiter& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new Loiter(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return Loiter::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "Loiter";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 48;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Idle Maneuver.
+    class IdleManeuver: public Maneuver
+    {
+    public:
+      //! Duration.
+      uint16_t duration;
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 454;
+      }
+
+      IdleManeuver(void);
+
+      void
+      swap(IdleManeuver& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new IdleManeuver(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return IdleManeuver::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "IdleManeuver";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 2;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Low Level Control Maneuver.
+    class LowLevelControl: public Maneuver
+    {
+    public:
+      //! Control.
+      InlineMessage<ControlCommand> control;
+      //! Duration.
+      uint16_t duration;
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 455;
+      }
+
+      LowLevelControl(void);
+
+      LowLevelControl(const LowLevelControl& other__);
+
+      void
+      swap(LowLevelControl& other__);
+
+      LowLevelControl&
+      operator=(const LowLevelControl& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new LowLevelControl(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return LowLevelControl::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "LowLevelControl";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 2;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return control.getSerializationSize() + IMC::getSerializationSize(custom);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
+    };
+
+    //! Rows Maneuver.
+    class Rows: public Maneuver
+    {
+    public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Square Curve.
+        FLG_SQUARE_CURVE = 0x0001,
+        //! First Curve Right.
+        FLG_CURVE_RIGHT = 0x0002
+      };
+
+      //! Timeout.
+      uint16_t timeout;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Bearing.
+      fp64_t bearing;
+      //! Cross Angle.
+      fp64_t cross_angle;
+      //! Width.
+      fp32_t width;
+      //! Length.
+      fp32_t length;
+      //! Horizontal Step.
+      fp32_t hstep;
+      //! Curve Offset.
+      uint8_t coff;
+      //! Alternation Parameter.
+      uint8_t alternation;
+      //! Flags.
+      uint8_t flags;
+      //! Custom settings for maneuver.
+      std::string custom;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 456;
+      }
+
+      Rows(void);
+
+      void
+      swap(Rows& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new Rows(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return Rows::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "Rows";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 59;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Low Level Control Maneuver.
-    class LowLevelControl: public Maneuver
+    //! Path Point.
+    class PathPoint: public Message
     {
     public:
-      //! Control.
-      InlineMessage<ControlCommand> control;
-      //! Duration.
-      uint16_t duration;
+      //! North Offset (m).
+      fp32_t x;
+      //! East Offset (m).
+      fp32_t y;
+      //! Down Offset (m).
+      fp32_t z;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 458;
+      }
+
+      PathPoint(void);
+
+      Message*
+      clone(void) const
+      {
+        return new PathPoint(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return PathPoint::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "PathPoint";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 12;
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Follow Path Maneuver.
+    class FollowPath: public Maneuver
+    {
+    public:
+      //! Timeout.
+      uint16_t timeout;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Path Points.
+      MessageList<PathPoint> points;
       //! Custom settings for maneuver.
       std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 455;
+        return 457;
       }
 
-      LowLevelControl(void);
+      FollowPath(void);
+
+      FollowPath(const FollowPath& other__);
+
+      void
+      swap(FollowPath& other__);
+
+      FollowPath&
+      operator=(const FollowPath& other__);
 
       Message*
       clone(void) const
       {
-        return new LowLevelControl(*this);
+        return new FollowPath(*this);
       }
 
       void
@@ -10757,30 +13193,36 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return LowLevelControl::getIdStatic();
+        return FollowPath::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "LowLevelControl";
+        return "FollowPath";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 28;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return control.getSerializationSize() + IMC::getSerializationSize(custom);
+        return points.getSerializationSize() + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -10798,19 +13240,10 @@ namespace DUNE
       setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Rows Maneuver.
-    class Rows: public Maneuver
+    //! Yo-Yo Maneuver.
+    class YoYo: public Maneuver
     {
     public:
-      //! Flags.
-      enum FlagsBits
-      {
-        //! Square Curve.
-        FLG_SQUARE_CURVE = 0x0001,
-        //! First Curve Right.
-        FLG_CURVE_RIGHT = 0x0002
-      };
-
       //! Timeout.
       uint16_t timeout;
       //! Latitude WGS-84.
@@ -10821,41 +13254,32 @@ namespace DUNE
       fp32_t z;
       //! Z Units.
       uint8_t z_units;
+      //! Amplitude.
+      fp32_t amplitude;
+      //! Pitch Angle.
+      fp32_t pitch;
       //! Speed.
       fp32_t speed;
       //! Speed Units.
       uint8_t speed_units;
-      //! Bearing.
-      fp64_t bearing;
-      //! Cross Angle.
-      fp64_t cross_angle;
-      //! Width.
-      fp32_t width;
-      //! Length.
-      fp32_t length;
-      //! Horizontal Step.
-      fp32_t hstep;
-      //! Curve Offset.
-      uint8_t coff;
-      //! Alternation Parameter.
-      uint8_t alternation;
-      //! Flags.
-      uint8_t flags;
       //! Custom settings for maneuver.
       std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 456;
+        return 459;
       }
 
-      Rows(void);
+      YoYo(void);
+
+      void
+      swap(YoYo& other__);
 
       Message*
       clone(void) const
       {
-        return new Rows(*this);
+        return new YoYo(*this);
       }
 
       void
@@ -10879,19 +13303,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Rows::getIdStatic();
+        return YoYo::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Rows";
+        return "YoYo";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 59;
+        return 36;
       }
 
       unsigned
@@ -10902,38 +13326,35 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Path Point.
-    class PathPoint: public Message
+    //! Teleoperation Done.
+    class TeleoperationDone: public Message
     {
     public:
-      //! North Offset (m).
-      fp32_t x;
-      //! East Offset (m).
-      fp32_t y;
-      //! Down Offset (m).
-      fp32_t z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 458;
+        return 460;
       }
 
-      PathPoint(void);
+      TeleoperationDone(void);
 
       Message*
       clone(void) const
       {
-        return new PathPoint(*this);
+        return new TeleoperationDone(*this);
       }
 
-      void
-      clear(void);
-
-      bool
-      fieldsEqual(const Message& msg__) const;
+      void
+      clear(void);
 
       int
       validate(void) const;
@@ -10950,31 +13371,26 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PathPoint::getIdStatic();
+        return TeleoperationDone::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PathPoint";
+        return "TeleoperationDone";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 12;
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Follow Path Maneuver.
-    class FollowPath: public Maneuver
+    //! Station Keeping.
+    class StationKeeping: public Maneuver
     {
     public:
-      //! Timeout.
-      uint16_t timeout;
       //! Latitude WGS-84.
       fp64_t lat;
       //! Longitude WGS-84.
@@ -10983,27 +13399,32 @@ namespace DUNE
       fp32_t z;
       //! Z Units.
       uint8_t z_units;
+      //! Radius.
+      fp32_t radius;
+      //! Duration.
+      uint16_t duration;
       //! Speed.
       fp32_t speed;
       //! Speed Units.
       uint8_t speed_units;
-      //! Path Points.
-      MessageList<PathPoint> points;
       //! Custom settings for maneuver.
       std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 457;
+        return 461;
       }
 
-      FollowPath(void);
+      StationKeeping(void);
+
+      void
+      swap(StationKeeping& other__);
 
       Message*
       clone(void) const
       {
-        return new FollowPath(*this);
+        return new StationKeeping(*this);
       }
 
       void
@@ -11027,65 +13448,66 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FollowPath::getIdStatic();
+        return StationKeeping::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FollowPath";
+        return "StationKeeping";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 28;
+        return 32;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return points.getSerializationSize() + IMC::getSerializationSize(custom);
+        return IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
-      void
-      setSourceNested(uint16_t value__);
-
-      void
-      setSourceEntityNested(uint8_t value__);
-
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Yo-Yo Maneuver.
-    class YoYo: public Maneuver
+    //! Elevator Maneuver.
+    class Elevator: public Maneuver
     {
     public:
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Start from current position.
+        FLG_CURR_POS = 0x01
+      };
+
       //! Timeout.
       uint16_t timeout;
+      //! Flags.
+      uint8_t flags;
       //! Latitude WGS-84.
       fp64_t lat;
       //! Longitude WGS-84.
       fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
-      //! Amplitude.
-      fp32_t amplitude;
-      //! Pitch Angle.
-      fp32_t pitch;
+      //! Start Point -- Z Reference.
+      fp32_t start_z;
+      //! Start Point -- Z Units.
+      uint8_t start_z_units;
+      //! End Point -- Z Reference.
+      fp32_t end_z;
+      //! End Point -- Z Units.
+      uint8_t end_z_units;
+      //! Radius.
+      fp32_t radius;
       //! Speed.
       fp32_t speed;
       //! Speed Units.
@@ -11096,15 +13518,18 @@ namespace DUNE
       static uint16_t
       getIdStatic(void)
       {
-        return 459;
+        return 462;
       }
 
-      YoYo(void);
+      Elevator(void);
+
+      void
+      swap(Elevator& other__);
 
       Message*
       clone(void) const
       {
-        return new YoYo(*this);
+        return new Elevator(*this);
       }
 
       void
@@ -11128,19 +13553,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return YoYo::getIdStatic();
+        return Elevator::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "YoYo";
+        return "Elevator";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 36;
+        return 38;
       }
 
       unsigned
@@ -11151,30 +13576,47 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Teleoperation Done.
-    class TeleoperationDone: public Message
+    //! Trajectory Point.
+    class TrajectoryPoint: public Message
     {
     public:
+      //! North Offset (m).
+      fp32_t x;
+      //! East Offset (m).
+      fp32_t y;
+      //! Down Offset (m).
+      fp32_t z;
+      //! Time Offset (s).
+      fp32_t t;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 460;
+        return 464;
       }
 
-      TeleoperationDone(void);
+      TrajectoryPoint(void);
 
       Message*
       clone(void) const
       {
-        return new TeleoperationDone(*this);
+        return new TrajectoryPoint(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -11190,26 +13632,37 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return TeleoperationDone::getIdStatic();
+        return TrajectoryPoint::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "TeleoperationDone";
+        return "TrajectoryPoint";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 16;
       }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Station Keeping.
-    class StationKeeping: public Maneuver
+    //! Follow Trajectory.
+    class FollowTrajectory: public Maneuver
     {
     public:
+      //! Timeout.
+      uint16_t timeout;
       //! Latitude WGS-84.
       fp64_t lat;
       //! Longitude WGS-84.
@@ -11218,29 +13671,35 @@ namespace DUNE
       fp32_t z;
       //! Z Units.
       uint8_t z_units;
-      //! Radius.
-      fp32_t radius;
-      //! Duration.
-      uint16_t duration;
       //! Speed.
       fp32_t speed;
       //! Speed Units.
       uint8_t speed_units;
+      //! Trajectory Points.
+      MessageList<TrajectoryPoint> points;
       //! Custom settings for maneuver.
       std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 461;
+        return 463;
       }
 
-      StationKeeping(void);
+      FollowTrajectory(void);
+
+      FollowTrajectory(const FollowTrajectory& other__);
+
+      void
+      swap(FollowTrajectory& other__);
+
+      FollowTrajectory&
+      operator=(const FollowTrajectory& other__);
 
       Message*
       clone(void) const
       {
-        return new StationKeeping(*this);
+        return new FollowTrajectory(*this);
       }
 
       void
@@ -11264,79 +13723,79 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return StationKeeping::getIdStatic();
+        return FollowTrajectory::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "StationKeeping";
+        return "FollowTrajectory";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 32;
+        return 28;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(custom);
+        return points.getSerializationSize() + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Elevator Maneuver.
-    class Elevator: public Maneuver
+    //! Custom Maneuver.
+    class CustomManeuver: public Maneuver
     {
     public:
-      //! Flags.
-      enum FlagsBits
-      {
-        //! Start from current position.
-        FLG_CURR_POS = 0x01
-      };
-
       //! Timeout.
       uint16_t timeout;
-      //! Flags.
-      uint8_t flags;
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Start Point -- Z Reference.
-      fp32_t start_z;
-      //! Start Point -- Z Units.
-      uint8_t start_z_units;
-      //! End Point -- Z Reference.
-      fp32_t end_z;
-      //! End Point -- Z Units.
-      uint8_t end_z_units;
-      //! Radius.
-      fp32_t radius;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
+      //! Maneuver Name.
+      std::string name;
       //! Custom settings for maneuver.
       std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 462;
+        return 465;
       }
 
-      Elevator(void);
+      CustomManeuver(void);
+
+      void
+      swap(CustomManeuver& other__);
 
       Message*
       clone(void) const
       {
-        return new Elevator(*this);
+        return new CustomManeuver(*this);
       }
 
       void
@@ -11360,56 +13819,62 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Elevator::getIdStatic();
+        return CustomManeuver::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Elevator";
+        return "CustomManeuver";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 38;
+        return 2;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(custom);
+        return IMC::getSerializationSize(name) + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Trajectory Point.
-    class TrajectoryPoint: public Message
+    //! Vehicle Formation Participant.
+    class VehicleFormationParticipant: public Message
     {
     public:
-      //! North Offset (m).
-      fp32_t x;
-      //! East Offset (m).
-      fp32_t y;
-      //! Down Offset (m).
-      fp32_t z;
-      //! Time Offset (s).
-      fp32_t t;
+      //! ID (IMC address).
+      uint16_t vid;
+      //! Formation offset -- Along-track.
+      fp32_t off_x;
+      //! Formation offset -- Cross-track.
+      fp32_t off_y;
+      //! Formation offset -- Depth/Altitude.
+      fp32_t off_z;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 464;
+        return 467;
       }
 
-      TrajectoryPoint(void);
+      VehicleFormationParticipant(void);
 
       Message*
       clone(void) const
       {
-        return new TrajectoryPoint(*this);
+        return new VehicleFormationParticipant(*this);
       }
 
       void
@@ -11433,31 +13898,35 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return TrajectoryPoint::getIdStatic();
+        return VehicleFormationParticipant::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "TrajectoryPoint";
+        return "VehicleFormationParticipant";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 16;
+        return 14;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Follow Trajectory.
-    class FollowTrajectory: public Maneuver
+    //! Vehicle Formation.
+    class VehicleFormation: public Maneuver
     {
     public:
-      //! Timeout.
-      uint16_t timeout;
       //! Latitude WGS-84.
       fp64_t lat;
       //! Longitude WGS-84.
@@ -11472,21 +13941,33 @@ namespace DUNE
       uint8_t speed_units;
       //! Trajectory Points.
       MessageList<TrajectoryPoint> points;
+      //! Formation Participants.
+      MessageList<VehicleFormationParticipant> participants;
+      //! Start Time.
+      fp64_t start_time;
       //! Custom settings for maneuver.
       std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 463;
+        return 466;
       }
 
-      FollowTrajectory(void);
+      VehicleFormation(void);
+
+      VehicleFormation(const VehicleFormation& other__);
+
+      void
+      swap(VehicleFormation& other__);
+
+      VehicleFormation&
+      operator=(const VehicleFormation& other__);
 
       Message*
       clone(void) const
       {
-        return new FollowTrajectory(*this);
+        return new VehicleFormation(*this);
       }
 
       void
@@ -11510,30 +13991,36 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FollowTrajectory::getIdStatic();
+        return VehicleFormation::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FollowTrajectory";
+        return "VehicleFormation";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 28;
+        return 34;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return points.getSerializationSize() + IMC::getSerializationSize(custom);
+        return points.getSerializationSize() + participants.getSerializationSize() + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -11551,37 +14038,28 @@ namespace DUNE
       setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Custom Maneuver.
-    class CustomManeuver: public Maneuver
+    //! Stop Maneuver.
+    class StopManeuver: public Message
     {
     public:
-      //! Timeout.
-      uint16_t timeout;
-      //! Maneuver Name.
-      std::string name;
-      //! Custom settings for maneuver.
-      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 465;
+        return 468;
       }
 
-      CustomManeuver(void);
+      StopManeuver(void);
 
       Message*
       clone(void) const
       {
-        return new CustomManeuver(*this);
+        return new StopManeuver(*this);
       }
 
       void
       clear(void);
 
-      bool
-      fieldsEqual(const Message& msg__) const;
-
       int
       validate(void) const;
 
@@ -11597,56 +14075,41 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CustomManeuver::getIdStatic();
+        return StopManeuver::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CustomManeuver";
+        return "StopManeuver";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(name) + IMC::getSerializationSize(custom);
+        return 0;
       }
-
-      void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
     };
 
-    //! Vehicle Formation Participant.
-    class VehicleFormationParticipant: public Message
+    //! Register Maneuver.
+    class RegisterManeuver: public Message
     {
     public:
-      //! ID (IMC address).
-      uint16_t vid;
-      //! Formation offset -- Along-track.
-      fp32_t off_x;
-      //! Formation offset -- Cross-track.
-      fp32_t off_y;
-      //! Formation offset -- Depth/Altitude.
-      fp32_t off_z;
+      //! Maneuver ID.
+      uint16_t mid;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 467;
+        return 469;
       }
 
-      VehicleFormationParticipant(void);
+      RegisterManeuver(void);
 
       Message*
       clone(void) const
       {
-        return new VehicleFormationParticipant(*this);
+        return new RegisterManeuver(*this);
       }
 
       void
@@ -11670,62 +14133,68 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return VehicleFormationParticipant::getIdStatic();
+        return RegisterManeuver::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "VehicleFormationParticipant";
+        return "RegisterManeuver";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 14;
+        return 2;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Vehicle Formation.
-    class VehicleFormation: public Maneuver
+    //! Maneuver Control State.
+    class ManeuverControlState: public Message
     {
     public:
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
-      //! Trajectory Points.
-      MessageList<TrajectoryPoint> points;
-      //! Formation Participants.
-      MessageList<VehicleFormationParticipant> participants;
-      //! Start Time.
-      fp64_t start_time;
-      //! Custom settings for maneuver.
-      std::string custom;
+      //! State.
+      enum StateEnum
+      {
+        //! Maneuver in progress.
+        MCS_EXECUTING = 0,
+        //! Maneuver completed.
+        MCS_DONE = 1,
+        //! Maneuver error.
+        MCS_ERROR = 2
+      };
+
+      //! State.
+      uint8_t state;
+      //! Completion Time.
+      uint16_t eta;
+      //! Info.
+      std::string info;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 466;
+        return 470;
       }
 
-      VehicleFormation(void);
+      ManeuverControlState(void);
+
+      void
+      swap(ManeuverControlState& other__);
 
       Message*
       clone(void) const
       {
-        return new VehicleFormation(*this);
+        return new ManeuverControlState(*this);
       }
 
       void
@@ -11749,69 +14218,159 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return VehicleFormation::getIdStatic();
+        return ManeuverControlState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "VehicleFormation";
+        return "ManeuverControlState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 34;
+        return 3;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return points.getSerializationSize() + participants.getSerializationSize() + IMC::getSerializationSize(custom);
+        return IMC::getSerializationSize(info);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
       void
-      setTimeStampNested(double value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setSourceNested(uint16_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Follow System.
+    class FollowSystem: public Message
+    {
+    public:
+      //! System To Follow.
+      uint16_t system;
+      //! Duration.
+      uint16_t duration;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Offset -- X.
+      fp32_t x;
+      //! Offset -- Y.
+      fp32_t y;
+      //! Coordinate -- Z.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 471;
+      }
+
+      FollowSystem(void);
+
+      Message*
+      clone(void) const
+      {
+        return new FollowSystem(*this);
+      }
 
       void
-      setSourceEntityNested(uint8_t value__);
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return FollowSystem::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "FollowSystem";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 22;
+      }
 
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      setDestinationEntityNested(uint8_t value__);
-    };
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-    //! Stop Maneuver.
-    class StopManeuver: public Message
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Communications Relay.
+    class CommsRelay: public Maneuver
     {
     public:
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Duration.
+      uint16_t duration;
+      //! System A.
+      uint16_t sys_a;
+      //! System B.
+      uint16_t sys_b;
+      //! Move threshold.
+      fp32_t move_threshold;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 468;
+        return 472;
       }
 
-      StopManeuver(void);
+      CommsRelay(void);
 
       Message*
       clone(void) const
       {
-        return new StopManeuver(*this);
+        return new CommsRelay(*this);
       }
 
       void
       clear(void);
 
+      bool
+      fieldsEqual(const Message& msg__) const;
+
       int
       validate(void) const;
 
@@ -11827,41 +14386,52 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return StopManeuver::getIdStatic();
+        return CommsRelay::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "StopManeuver";
+        return "CommsRelay";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 0;
+        return 31;
       }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Register Maneuver.
-    class RegisterManeuver: public Message
+    //! Polygon Vertex.
+    class PolygonVertex: public Message
     {
     public:
-      //! Maneuver ID.
-      uint16_t mid;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 469;
+        return 474;
       }
 
-      RegisterManeuver(void);
+      PolygonVertex(void);
 
       Message*
       clone(void) const
       {
-        return new RegisterManeuver(*this);
+        return new PolygonVertex(*this);
       }
 
       void
@@ -11885,59 +14455,72 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return RegisterManeuver::getIdStatic();
+        return PolygonVertex::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "RegisterManeuver";
+        return "PolygonVertex";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 2;
+        return 16;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Maneuver Control State.
-    class ManeuverControlState: public Message
+    //! Cover Area.
+    class CoverArea: public Maneuver
     {
     public:
-      //! State.
-      enum StateEnum
-      {
-        //! Maneuver in progress.
-        MCS_EXECUTING = 0,
-        //! Maneuver completed.
-        MCS_DONE = 1,
-        //! Maneuver error.
-        MCS_ERROR = 2
-      };
-
-      //! State.
-      uint8_t state;
-      //! Completion Time.
-      uint16_t eta;
-      //! Info.
-      std::string info;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Speed.
+      fp32_t speed;
+      //! Speed Units.
+      uint8_t speed_units;
+      //! Polygon.
+      MessageList<PolygonVertex> polygon;
+      //! CustomParameters.
+      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 470;
+        return 473;
       }
 
-      ManeuverControlState(void);
+      CoverArea(void);
+
+      CoverArea(const CoverArea& other__);
+
+      void
+      swap(CoverArea& other__);
+
+      CoverArea&
+      operator=(const CoverArea& other__);
 
       Message*
       clone(void) const
       {
-        return new ManeuverControlState(*this);
+        return new CoverArea(*this);
       }
 
       void
@@ -11961,64 +14544,112 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ManeuverControlState::getIdStatic();
+        return CoverArea::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ManeuverControlState";
+        return "CoverArea";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 3;
+        return 26;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(info);
+        return polygon.getSerializationSize() + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Follow System.
-    class FollowSystem: public Message
+    //! Compass Calibration Maneuver.
+    class CompassCalibration: public Maneuver
     {
     public:
-      //! System To Follow.
-      uint16_t system;
+      //! Direction.
+      enum DirectionEnum
+      {
+        //! Vehicle Dependent.
+        LD_VDEP = 0,
+        //! Clockwise.
+        LD_CLOCKW = 1,
+        //! Counter Clockwise.
+        LD_CCLOCKW = 2,
+        //! Into the wind/current.
+        LD_IWINDCURR = 3
+      };
+
+      //! Timeout.
+      uint16_t timeout;
+      //! Latitude WGS-84.
+      fp64_t lat;
+      //! Longitude WGS-84.
+      fp64_t lon;
+      //! Z Reference.
+      fp32_t z;
+      //! Z Units.
+      uint8_t z_units;
+      //! Pitch.
+      fp32_t pitch;
+      //! Amplitude.
+      fp32_t amplitude;
       //! Duration.
       uint16_t duration;
       //! Speed.
       fp32_t speed;
       //! Speed Units.
       uint8_t speed_units;
-      //! Offset -- X.
-      fp32_t x;
-      //! Offset -- Y.
-      fp32_t y;
-      //! Coordinate -- Z.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
+      //! Radius.
+      fp32_t radius;
+      //! Direction.
+      uint8_t direction;
+      //! Custom settings for maneuver.
+      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 471;
+        return 475;
       }
 
-      FollowSystem(void);
+      CompassCalibration(void);
+
+      void
+      swap(CompassCalibration& other__);
 
       Message*
       clone(void) const
       {
-        return new FollowSystem(*this);
+        return new CompassCalibration(*this);
       }
 
       void
@@ -12042,58 +14673,81 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FollowSystem::getIdStatic();
+        return CompassCalibration::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FollowSystem";
+        return "CompassCalibration";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 22;
+        return 43;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Communications Relay.
-    class CommsRelay: public Maneuver
+    //! Formation Parameters.
+    class FormationParameters: public Maneuver
     {
     public:
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
-      //! Duration.
-      uint16_t duration;
-      //! System A.
-      uint16_t sys_a;
-      //! System B.
-      uint16_t sys_b;
-      //! Move threshold.
-      fp32_t move_threshold;
+      //! Formation Reference Frame.
+      enum FormationReferenceFrameEnum
+      {
+        //! Earth Fixed.
+        OP_EARTH_FIXED = 0,
+        //! Path Fixed.
+        OP_PATH_FIXED = 1,
+        //! Path Curved.
+        OP_PATH_CURVED = 2
+      };
+
+      //! Formation Name.
+      std::string formation_name;
+      //! Formation Reference Frame.
+      uint8_t reference_frame;
+      //! Formation Participants.
+      MessageList<VehicleFormationParticipant> participants;
+      //! Custom settings for formation.
+      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 472;
+        return 476;
       }
 
-      CommsRelay(void);
+      FormationParameters(void);
+
+      FormationParameters(const FormationParameters& other__);
+
+      void
+      swap(FormationParameters& other__);
+
+      FormationParameters&
+      operator=(const FormationParameters& other__);
 
       Message*
       clone(void) const
       {
-        return new CommsRelay(*this);
+        return new FormationParameters(*this);
       }
 
       void
@@ -12117,46 +14771,101 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CommsRelay::getIdStatic();
+        return FormationParameters::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CommsRelay";
+        return "FormationParameters";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 31;
+        return 1;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(formation_name) + participants.getSerializationSize() + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Polygon Vertex.
-    class PolygonVertex: public Message
+    //! Formation Plan Execution.
+    class FormationPlanExecution: public Maneuver
     {
     public:
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
+      //! Target Group Name.
+      std::string group_name;
+      //! Formation Name.
+      std::string formation_name;
+      //! Formation Plan ID.
+      std::string plan_id;
+      //! Plan Description.
+      std::string description;
+      //! Formation Leader Flight Airspeed.
+      fp32_t leader_speed;
+      //! Formation leader flight bank limit.
+      fp32_t leader_bank_lim;
+      //! Position mismatch limit.
+      fp32_t pos_sim_err_lim;
+      //! Position mismatch threshold.
+      fp32_t pos_sim_err_wrn;
+      //! Position mismatch time-out.
+      uint16_t pos_sim_err_timeout;
+      //! Convergence threshold.
+      fp32_t converg_max;
+      //! Convergence time-out.
+      uint16_t converg_timeout;
+      //! Communications time-out.
+      uint16_t comms_timeout;
+      //! Turbulence limit.
+      fp32_t turb_lim;
+      //! Custom settings for maneuver.
+      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 474;
+        return 477;
       }
 
-      PolygonVertex(void);
+      FormationPlanExecution(void);
+
+      void
+      swap(FormationPlanExecution& other__);
 
       Message*
       clone(void) const
       {
-        return new PolygonVertex(*this);
+        return new FormationPlanExecution(*this);
       }
 
       void
@@ -12180,58 +14889,64 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return PolygonVertex::getIdStatic();
+        return FormationPlanExecution::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "PolygonVertex";
+        return "FormationPlanExecution";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 16;
+        return 30;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(group_name) + IMC::getSerializationSize(formation_name) + IMC::getSerializationSize(plan_id) + IMC::getSerializationSize(description) + IMC::getSerializationSize(custom);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Cover Area.
-    class CoverArea: public Maneuver
+    //! Follow Reference Maneuver.
+    class FollowReference: public Maneuver
     {
     public:
-      //! Latitude WGS-84.
-      fp64_t lat;
-      //! Longitude WGS-84.
-      fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
-      //! Polygon.
-      MessageList<PolygonVertex> polygon;
-      //! CustomParameters.
-      std::string custom;
+      //! Controlling Source.
+      uint16_t control_src;
+      //! Controlling Entity.
+      uint8_t control_ent;
+      //! Reference Update Timeout.
+      fp32_t timeout;
+      //! Loiter Radius.
+      fp32_t loiter_radius;
+      //! Altitude Interval.
+      fp32_t altitude_interval;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 473;
+        return 478;
       }
 
-      CoverArea(void);
+      FollowReference(void);
 
       Message*
       clone(void) const
       {
-        return new CoverArea(*this);
+        return new FollowReference(*this);
       }
 
       void
@@ -12255,103 +14970,83 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CoverArea::getIdStatic();
+        return FollowReference::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CoverArea";
+        return "FollowReference";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 26;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return polygon.getSerializationSize() + IMC::getSerializationSize(custom);
+        return 15;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
-      void
-      setSourceNested(uint16_t value__);
-
-      void
-      setSourceEntityNested(uint8_t value__);
-
       void
-      setDestinationNested(uint16_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Compass Calibration Maneuver.
-    class CompassCalibration: public Maneuver
+    //! Reference To Follow.
+    class Reference: public Message
     {
     public:
-      //! Direction.
-      enum DirectionEnum
+      //! Flags.
+      enum FlagsBits
       {
-        //! Vehicle Dependent.
-        LD_VDEP = 0,
-        //! Clockwise.
-        LD_CLOCKW = 1,
-        //! Counter Clockwise.
-        LD_CCLOCKW = 2,
-        //! Into the wind/current.
-        LD_IWINDCURR = 3
+        //! Use Location Reference.
+        FLAG_LOCATION = 0x01,
+        //! Use Speed Reference.
+        FLAG_SPEED = 0x02,
+        //! Use Z Reference.
+        FLAG_Z = 0x04,
+        //! Use Radius Reference.
+        FLAG_RADIUS = 0x08,
+        //! Flag Maneuver Completion.
+        FLAG_MANDONE = 0x80
       };
 
-      //! Timeout.
-      uint16_t timeout;
-      //! Latitude WGS-84.
+      //! Flags.
+      uint8_t flags;
+      //! Speed Reference.
+      InlineMessage<DesiredSpeed> speed;
+      //! Z Reference.
+      InlineMessage<DesiredZ> z;
+      //! Latitude Reference.
       fp64_t lat;
-      //! Longitude WGS-84.
+      //! Longitude Reference.
       fp64_t lon;
-      //! Z Reference.
-      fp32_t z;
-      //! Z Units.
-      uint8_t z_units;
-      //! Pitch.
-      fp32_t pitch;
-      //! Amplitude.
-      fp32_t amplitude;
-      //! Duration.
-      uint16_t duration;
-      //! Speed.
-      fp32_t speed;
-      //! Speed Units.
-      uint8_t speed_units;
       //! Radius.
       fp32_t radius;
-      //! Direction.
-      uint8_t direction;
-      //! Custom settings for maneuver.
-      std::string custom;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 475;
+        return 479;
       }
 
-      CompassCalibration(void);
+      Reference(void);
+
+      Reference(const Reference& other__);
+
+      void
+      swap(Reference& other__);
+
+      Reference&
+      operator=(const Reference& other__);
 
       Message*
       clone(void) const
       {
-        return new CompassCalibration(*this);
+        return new Reference(*this);
       }
 
       void
@@ -12375,67 +15070,116 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CompassCalibration::getIdStatic();
+        return Reference::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CompassCalibration";
+        return "Reference";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 43;
+        return 21;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(custom);
+        return speed.getSerializationSize() + z.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Formation Parameters.
-    class FormationParameters: public Maneuver
+    //! Follow Reference State.
+    class FollowRefState: public Message
     {
     public:
-      //! Formation Reference Frame.
-      enum FormationReferenceFrameEnum
+      //! State.
+      enum StateEnum
       {
-        //! Earth Fixed.
-        OP_EARTH_FIXED = 0,
-        //! Path Fixed.
-        OP_PATH_FIXED = 1,
-        //! Path Curved.
-        OP_PATH_CURVED = 2
+        //! Waiting for first reference.
+        FR_WAIT = 1,
+        //! Going towards received reference.
+        FR_GOTO = 2,
+        //! Loitering after arriving at the reference.
+        FR_LOITER = 3,
+        //! Hovering after arriving at the reference.
+        FR_HOVER = 4,
+        //! Moving in z after arriving at the target cylinder.
+        FR_ELEVATOR = 5,
+        //! Controlling system timed out.
+        FR_TIMEOUT = 6
       };
 
-      //! Formation Name.
-      std::string formation_name;
-      //! Formation Reference Frame.
-      uint8_t reference_frame;
-      //! Formation Participants.
-      MessageList<VehicleFormationParticipant> participants;
-      //! Custom settings for formation.
-      std::string custom;
+      //! Proximity.
+      enum ProximityBits
+      {
+        //! Far from the destination.
+        PROX_FAR = 0x01,
+        //! Near in the horizontal plane.
+        PROX_XY_NEAR = 0x02,
+        //! Near in the vertical plane.
+        PROX_Z_NEAR = 0x04
+      };
+
+      //! Controlling Source.
+      uint16_t control_src;
+      //! Controlling Entity.
+      uint8_t control_ent;
+      //! Reference.
+      InlineMessage<Reference> reference;
+      //! State.
+      uint8_t state;
+      //! Proximity.
+      uint8_t proximity;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 476;
+        return 480;
       }
 
-      FormationParameters(void);
+      FollowRefState(void);
+
+      FollowRefState(const FollowRefState& other__);
+
+      void
+      swap(FollowRefState& other__);
+
+      FollowRefState&
+      operator=(const FollowRefState& other__);
 
       Message*
       clone(void) const
       {
-        return new FormationParameters(*this);
+        return new FollowRefState(*this);
       }
 
       void
@@ -12459,30 +15203,36 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FormationParameters::getIdStatic();
+        return FollowRefState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FormationParameters";
+        return "FollowRefState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
+        return 5;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(formation_name) + participants.getSerializationSize() + IMC::getSerializationSize(custom);
+        return reference.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -12500,51 +15250,70 @@ namespace DUNE
       setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Formation Plan Execution.
-    class FormationPlanExecution: public Maneuver
+    //! Relative State.
+    class RelativeState: public Message
     {
     public:
-      //! Target Group Name.
-      std::string group_name;
-      //! Formation Name.
-      std::string formation_name;
-      //! Formation Plan ID.
-      std::string plan_id;
-      //! Plan Description.
-      std::string description;
-      //! Formation Leader Flight Airspeed.
-      fp32_t leader_speed;
-      //! Formation leader flight bank limit.
-      fp32_t leader_bank_lim;
-      //! Position mismatch limit.
-      fp32_t pos_sim_err_lim;
-      //! Position mismatch threshold.
-      fp32_t pos_sim_err_wrn;
-      //! Position mismatch time-out.
-      uint16_t pos_sim_err_timeout;
-      //! Convergence threshold.
-      fp32_t converg_max;
-      //! Convergence time-out.
-      uint16_t converg_timeout;
-      //! Communications time-out.
-      uint16_t comms_timeout;
-      //! Turbulence limit.
-      fp32_t turb_lim;
-      //! Custom settings for maneuver.
-      std::string custom;
+      //! System Identifier.
+      std::string sid;
+      //! Distance.
+      fp32_t dist;
+      //! Position Error.
+      fp32_t err;
+      //! Control Importance.
+      fp32_t ctrlimp;
+      //! Relative Direction X (North).
+      fp32_t reldirx;
+      //! Relative Direction Y (East).
+      fp32_t reldiry;
+      //! Relative Direction Z (Down).
+      fp32_t reldirz;
+      //! X Position Error (North).
+      fp32_t errx;
+      //! Y Position Error (East).
+      fp32_t erry;
+      //! Z Position Error (Down).
+      fp32_t errz;
+      //! X Position Error In Relative Frame (North).
+      fp32_t rferrx;
+      //! Y Position Error In Relative Frame (East).
+      fp32_t rferry;
+      //! Z Position Error In Relative Frame (Down).
+      fp32_t rferrz;
+      //! X Velocity Error In Relative Frame (North).
+      fp32_t rferrvx;
+      //! Y Velocity Error In Relative Frame (East).
+      fp32_t rferrvy;
+      //! Z Velocity Error In Relative Frame (Down).
+      fp32_t rferrvz;
+      //! X Convergence Deviation (North).
+      fp32_t ssx;
+      //! Y Convergence Deviation (East).
+      fp32_t ssy;
+      //! Z Convergence Deviation (Down).
+      fp32_t ssz;
+      //! X Virtual Error (North).
+      fp32_t virterrx;
+      //! Y Virtual Error (East).
+      fp32_t virterry;
+      //! Z Virtual Error (Down).
+      fp32_t virterrz;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 477;
+        return 482;
       }
 
-      FormationPlanExecution(void);
+      RelativeState(void);
+
+      void
+      swap(RelativeState& other__);
 
       Message*
       clone(void) const
       {
-        return new FormationPlanExecution(*this);
+        return new RelativeState(*this);
       }
 
       void
@@ -12568,58 +15337,94 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FormationPlanExecution::getIdStatic();
+        return RelativeState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FormationPlanExecution";
+        return "RelativeState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 30;
+        return 84;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return IMC::getSerializationSize(group_name) + IMC::getSerializationSize(formation_name) + IMC::getSerializationSize(plan_id) + IMC::getSerializationSize(description) + IMC::getSerializationSize(custom);
+        return IMC::getSerializationSize(sid);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Follow Reference Maneuver.
-    class FollowReference: public Maneuver
+    //! Formation Evaluation Data.
+    class FormationEval: public Message
     {
     public:
-      //! Controlling Source.
-      uint16_t control_src;
-      //! Controlling Entity.
-      uint8_t control_ent;
-      //! Reference Update Timeout.
-      fp32_t timeout;
-      //! Loiter Radius.
-      fp32_t loiter_radius;
-      //! Altitude Interval.
-      fp32_t altitude_interval;
+      //! Desired X Acceleration (North).
+      fp32_t ax;
+      //! Desired Y Acceleration (East).
+      fp32_t ay;
+      //! Desired Z Acceleration (Down).
+      fp32_t az;
+      //! X Virtual Error (North).
+      fp32_t virterrx;
+      //! Y Virtual Error (East).
+      fp32_t virterry;
+      //! Z Virtual Error (Down).
+      fp32_t virterrz;
+      //! X Sliding Surface Feedback (North).
+      fp32_t surffdbkx;
+      //! Y Sliding Surface Feedback (East).
+      fp32_t surffdbky;
+      //! Z Sliding Surface Feedback (Down).
+      fp32_t surffdbkz;
+      //! X Uncertainty Compensation (North).
+      fp32_t surfunknx;
+      //! Y Uncertainty Compensation (East).
+      fp32_t surfunkny;
+      //! Z Uncertainty Compensation (Down).
+      fp32_t surfunknz;
+      //! X Convergence Deviation (North).
+      fp32_t ssx;
+      //! Y Convergence Deviation (East).
+      fp32_t ssy;
+      //! Z Convergence Deviation (Down).
+      fp32_t ssz;
+      //! Relative State.
+      MessageList<RelativeState> relstate;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 478;
+        return 481;
       }
 
-      FollowReference(void);
+      FormationEval(void);
+
+      FormationEval(const FormationEval& other__);
+
+      void
+      swap(FormationEval& other__);
+
+      FormationEval&
+      operator=(const FormationEval& other__);
 
       Message*
       clone(void) const
       {
-        return new FollowReference(*this);
+        return new FormationEval(*this);
       }
 
       void
@@ -12643,69 +15448,91 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FollowReference::getIdStatic();
+        return FormationEval::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FollowReference";
+        return "FormationEval";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 15;
+        return 60;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return relstate.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
     };
 
-    //! Reference To Follow.
-    class Reference: public Message
+    //! Trajectory Segment.
+    class TrajectorySegment: public Message
     {
     public:
       //! Flags.
       enum FlagsBits
       {
-        //! Use Location Reference.
-        FLAG_LOCATION = 0x01,
-        //! Use Speed Reference.
-        FLAG_SPEED = 0x02,
-        //! Use Z Reference.
-        FLAG_Z = 0x04,
-        //! Use Radius Reference.
-        FLAG_RADIUS = 0x08,
-        //! Flag Maneuver Completion.
-        FLAG_MANDONE = 0x80
+        //! Last Segment.
+        FL_LAST = 0x01
       };
 
+      //! Index.
+      uint32_t index;
       //! Flags.
       uint8_t flags;
-      //! Speed Reference.
-      InlineMessage<DesiredSpeed> speed;
-      //! Z Reference.
-      InlineMessage<DesiredZ> z;
-      //! Latitude Reference.
-      fp64_t lat;
-      //! Longitude Reference.
-      fp64_t lon;
-      //! Radius.
-      fp32_t radius;
+      //! Trajectory Points.
+      MessageList<TrajectoryPoint> points;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 479;
+        return 483;
       }
 
-      Reference(void);
+      TrajectorySegment(void);
+
+      TrajectorySegment(const TrajectorySegment& other__);
+
+      void
+      swap(TrajectorySegment& other__);
+
+      TrajectorySegment&
+      operator=(const TrajectorySegment& other__);
 
       Message*
       clone(void) const
       {
-        return new Reference(*this);
+        return new TrajectorySegment(*this);
       }
 
       void
@@ -12729,30 +15556,36 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return Reference::getIdStatic();
+        return TrajectorySegment::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "Reference";
+        return "TrajectorySegment";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 21;
+        return 5;
       }
 
       unsigned
       getVariableSerializationSize(void) const
       {
-        return speed.getSerializationSize() + z.getSerializationSize();
+        return points.getSerializationSize();
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -12766,65 +15599,31 @@ namespace DUNE
       void
       setDestinationNested(uint16_t value__);
 
-      void
-      setDestinationEntityNested(uint8_t value__);
-    };
-
-    //! Follow Reference State.
-    class FollowRefState: public Message
-    {
-    public:
-      //! State.
-      enum StateEnum
-      {
-        //! Waiting for first reference.
-        FR_WAIT = 1,
-        //! Going towards received reference.
-        FR_GOTO = 2,
-        //! Loitering after arriving at the reference.
-        FR_LOITER = 3,
-        //! Hovering after arriving at the reference.
-        FR_HOVER = 4,
-        //! Moving in z after arriving at the target cylinder.
-        FR_ELEVATOR = 5,
-        //! Controlling system timed out.
-        FR_TIMEOUT = 6
-      };
-
-      //! Proximity.
-      enum ProximityBits
-      {
-        //! Far from the destination.
-        PROX_FAR = 0x01,
-        //! Near in the horizontal plane.
-        PROX_XY_NEAR = 0x02,
-        //! Near in the vertical plane.
-        PROX_Z_NEAR = 0x04
-      };
-
-      //! Controlling Source.
-      uint16_t control_src;
-      //! Controlling Entity.
-      uint8_t control_ent;
-      //! Reference.
-      InlineMessage<Reference> reference;
-      //! State.
-      uint8_t state;
-      //! Proximity.
-      uint8_t proximity;
-
+      void
+      setDestinationEntityNested(uint8_t value__);
+    };
+
+    //! Trajectory Buffer State.
+    class TrajectoryBufferState: public Message
+    {
+    public:
+      //! Next Index.
+      uint32_t next;
+      //! Free Points.
+      uint16_t free;
+
       static uint16_t
       getIdStatic(void)
       {
-        return 480;
+        return 484;
       }
 
-      FollowRefState(void);
+      TrajectoryBufferState(void);
 
       Message*
       clone(void) const
       {
-        return new FollowRefState(*this);
+        return new TrajectoryBufferState(*this);
       }
 
       void
@@ -12848,45 +15647,29 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return FollowRefState::getIdStatic();
+        return TrajectoryBufferState::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "FollowRefState";
+        return "TrajectoryBufferState";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 5;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return reference.getSerializationSize();
+        return 6;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
-    protected:
-      void
-      setTimeStampNested(double value__);
-
       void
-      setSourceNested(uint16_t value__);
-
-      void
-      setSourceEntityNested(uint8_t value__);
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
 
-      void
-      setDestinationNested(uint16_t value__);
-
-      void
-      setDestinationEntityNested(uint8_t value__);
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Vehicle State.
@@ -12946,6 +15729,9 @@ namespace DUNE
 
       VehicleState(void);
 
+      void
+      swap(VehicleState& other__);
+
       Message*
       clone(void) const
       {
@@ -12996,6 +15782,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Vehicle Command.
@@ -13049,6 +15841,14 @@ namespace DUNE
 
       VehicleCommand(void);
 
+      VehicleCommand(const VehicleCommand& other__);
+
+      void
+      swap(VehicleCommand& other__);
+
+      VehicleCommand&
+      operator=(const VehicleCommand& other__);
+
       Message*
       clone(void) const
       {
@@ -13100,6 +15900,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -13149,6 +15955,9 @@ namespace DUNE
 
       MonitorEntityState(void);
 
+      void
+      swap(MonitorEntityState& other__);
+
       Message*
       clone(void) const
       {
@@ -13199,6 +16008,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Entity Monitoring State.
@@ -13230,6 +16045,9 @@ namespace DUNE
 
       EntityMonitoringState(void);
 
+      void
+      swap(EntityMonitoringState& other__);
+
       Message*
       clone(void) const
       {
@@ -13280,6 +16098,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Operational Limits.
@@ -13363,6 +16187,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Get Operational Limits.
@@ -13477,6 +16307,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Control Loops.
@@ -13551,6 +16387,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Vehicle Medium.
@@ -13627,6 +16469,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Collision.
@@ -13709,6 +16557,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Formation Tracking State.
@@ -13809,6 +16663,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Abort.
@@ -13909,6 +16769,9 @@ namespace DUNE
 
       PlanVariable(void);
 
+      void
+      swap(PlanVariable& other__);
+
       Message*
       clone(void) const
       {
@@ -13959,6 +16822,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Plan Maneuver.
@@ -13982,6 +16851,14 @@ namespace DUNE
 
       PlanManeuver(void);
 
+      PlanManeuver(const PlanManeuver& other__);
+
+      void
+      swap(PlanManeuver& other__);
+
+      PlanManeuver&
+      operator=(const PlanManeuver& other__);
+
       Message*
       clone(void) const
       {
@@ -14033,6 +16910,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14071,6 +16954,14 @@ namespace DUNE
 
       PlanTransition(void);
 
+      PlanTransition(const PlanTransition& other__);
+
+      void
+      swap(PlanTransition& other__);
+
+      PlanTransition&
+      operator=(const PlanTransition& other__);
+
       Message*
       clone(void) const
       {
@@ -14122,6 +17013,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14170,6 +17067,14 @@ namespace DUNE
 
       PlanSpecification(void);
 
+      PlanSpecification(const PlanSpecification& other__);
+
+      void
+      swap(PlanSpecification& other__);
+
+      PlanSpecification&
+      operator=(const PlanSpecification& other__);
+
       Message*
       clone(void) const
       {
@@ -14221,6 +17126,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14272,6 +17183,14 @@ namespace DUNE
 
       EmergencyControl(void);
 
+      EmergencyControl(const EmergencyControl& other__);
+
+      void
+      swap(EmergencyControl& other__);
+
+      EmergencyControl&
+      operator=(const EmergencyControl& other__);
+
       Message*
       clone(void) const
       {
@@ -14323,6 +17242,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14376,6 +17301,9 @@ namespace DUNE
 
       EmergencyControlState(void);
 
+      void
+      swap(EmergencyControlState& other__);
+
       Message*
       clone(void) const
       {
@@ -14426,6 +17354,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Plan DB.
@@ -14463,7 +17397,11 @@ namespace DUNE
         //! Get Database State (Detailed).
         DBOP_GET_DSTATE = 6,
         //! Boot Notification.
-        DBOP_BOOT = 7
+        DBOP_BOOT = 7,
+        //! Set Plans.
+        DBOP_SET_BULK = 8,
+        //! Get Plans.
+        DBOP_GET_BULK = 9
       };
 
       //! Type.
@@ -14487,6 +17425,14 @@ namespace DUNE
 
       PlanDB(void);
 
+      PlanDB(const PlanDB& other__);
+
+      void
+      swap(PlanDB& other__);
+
+      PlanDB&
+      operator=(const PlanDB& other__);
+
       Message*
       clone(void) const
       {
@@ -14538,6 +17484,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14580,6 +17532,9 @@ namespace DUNE
 
       PlanDBInformation(void);
 
+      void
+      swap(PlanDBInformation& other__);
+
       Message*
       clone(void) const
       {
@@ -14598,6 +17553,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -14630,6 +17588,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Plan DB State.
@@ -14659,6 +17623,14 @@ namespace DUNE
 
       PlanDBState(void);
 
+      PlanDBState(const PlanDBState& other__);
+
+      void
+      swap(PlanDBState& other__);
+
+      PlanDBState&
+      operator=(const PlanDBState& other__);
+
       Message*
       clone(void) const
       {
@@ -14677,6 +17649,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -14710,6 +17685,109 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
+    protected:
+      void
+      setTimeStampNested(double value__);
+
+      void
+      setSourceNested(uint16_t value__);
+
+      void
+      setSourceEntityNested(uint8_t value__);
+
+      void
+      setDestinationNested(uint16_t value__);
+
+      void
+      setDestinationEntityNested(uint8_t value__);
+    };
+
+    //! Plan DB Bulk.
+    class PlanDBBulk: public Message
+    {
+    public:
+      //! Plans.
+      MessageList<PlanSpecification> plans;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 564;
+      }
+
+      PlanDBBulk(void);
+
+      PlanDBBulk(const PlanDBBulk& other__);
+
+      void
+      swap(PlanDBBulk& other__);
+
+      PlanDBBulk&
+      operator=(const PlanDBBulk& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new PlanDBBulk(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return PlanDBBulk::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "PlanDBBulk";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 0;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return plans.getSerializationSize();
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14789,6 +17867,14 @@ namespace DUNE
 
       PlanControl(void);
 
+      PlanControl(const PlanControl& other__);
+
+      void
+      swap(PlanControl& other__);
+
+      PlanControl&
+      operator=(const PlanControl& other__);
+
       Message*
       clone(void) const
       {
@@ -14840,6 +17926,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -14910,6 +18002,9 @@ namespace DUNE
 
       PlanControlState(void);
 
+      void
+      swap(PlanControlState& other__);
+
       Message*
       clone(void) const
       {
@@ -14960,6 +18055,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Plan Generation.
@@ -15003,6 +18104,9 @@ namespace DUNE
 
       PlanGeneration(void);
 
+      void
+      swap(PlanGeneration& other__);
+
       Message*
       clone(void) const
       {
@@ -15053,6 +18157,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Leader State.
@@ -15119,6 +18229,9 @@ namespace DUNE
 
       LeaderState(void);
 
+      void
+      swap(LeaderState& other__);
+
       Message*
       clone(void) const
       {
@@ -15169,6 +18282,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Reported State.
@@ -15217,6 +18336,9 @@ namespace DUNE
 
       ReportedState(void);
 
+      void
+      swap(ReportedState& other__);
+
       Message*
       clone(void) const
       {
@@ -15267,6 +18389,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Remote Sensor Info.
@@ -15296,6 +18424,9 @@ namespace DUNE
 
       RemoteSensorInfo(void);
 
+      void
+      swap(RemoteSensorInfo& other__);
+
       Message*
       clone(void) const
       {
@@ -15346,6 +18477,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! MapPoint.
@@ -15411,6 +18548,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Map Feature.
@@ -15457,6 +18600,14 @@ namespace DUNE
 
       MapFeature(void);
 
+      MapFeature(const MapFeature& other__);
+
+      void
+      swap(MapFeature& other__);
+
+      MapFeature&
+      operator=(const MapFeature& other__);
+
       Message*
       clone(void) const
       {
@@ -15508,6 +18659,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -15542,6 +18699,14 @@ namespace DUNE
 
       Map(void);
 
+      Map(const Map& other__);
+
+      void
+      swap(Map& other__);
+
+      Map&
+      operator=(const Map& other__);
+
       Message*
       clone(void) const
       {
@@ -15593,6 +18758,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -15652,6 +18823,14 @@ namespace DUNE
 
       CcuEvent(void);
 
+      CcuEvent(const CcuEvent& other__);
+
+      void
+      swap(CcuEvent& other__);
+
+      CcuEvent&
+      operator=(const CcuEvent& other__);
+
       Message*
       clone(void) const
       {
@@ -15703,6 +18882,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -15737,6 +18922,14 @@ namespace DUNE
 
       VehicleLinks(void);
 
+      VehicleLinks(const VehicleLinks& other__);
+
+      void
+      swap(VehicleLinks& other__);
+
+      VehicleLinks&
+      operator=(const VehicleLinks& other__);
+
       Message*
       clone(void) const
       {
@@ -15788,6 +18981,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -15824,6 +19023,9 @@ namespace DUNE
 
       TrexObservation(void);
 
+      void
+      swap(TrexObservation& other__);
+
       Message*
       clone(void) const
       {
@@ -15874,6 +19076,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! TREX Command.
@@ -15912,6 +19120,9 @@ namespace DUNE
 
       TrexCommand(void);
 
+      void
+      swap(TrexCommand& other__);
+
       Message*
       clone(void) const
       {
@@ -15962,6 +19173,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! TREX Attribute.
@@ -16000,6 +19217,9 @@ namespace DUNE
 
       TrexAttribute(void);
 
+      void
+      swap(TrexAttribute& other__);
+
       Message*
       clone(void) const
       {
@@ -16050,6 +19270,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! TREX Token.
@@ -16071,6 +19297,14 @@ namespace DUNE
 
       TrexToken(void);
 
+      TrexToken(const TrexToken& other__);
+
+      void
+      swap(TrexToken& other__);
+
+      TrexToken&
+      operator=(const TrexToken& other__);
+
       Message*
       clone(void) const
       {
@@ -16122,6 +19356,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -16173,6 +19413,14 @@ namespace DUNE
 
       TrexOperation(void);
 
+      TrexOperation(const TrexOperation& other__);
+
+      void
+      swap(TrexOperation& other__);
+
+      TrexOperation&
+      operator=(const TrexOperation& other__);
+
       Message*
       clone(void) const
       {
@@ -16224,6 +19472,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -16258,6 +19512,14 @@ namespace DUNE
 
       TrexPlan(void);
 
+      TrexPlan(const TrexPlan& other__);
+
+      void
+      swap(TrexPlan& other__);
+
+      TrexPlan&
+      operator=(const TrexPlan& other__);
+
       Message*
       clone(void) const
       {
@@ -16309,6 +19571,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -16350,15 +19618,192 @@ namespace DUNE
       static uint16_t
       getIdStatic(void)
       {
-        return 700;
+        return 700;
+      }
+
+      VideoData(void);
+
+      void
+      swap(VideoData& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new VideoData(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return VideoData::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "VideoData";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 10;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(data);
+      }
+
+      uint16_t
+      getSubId(void) const;
+
+      void
+      setSubId(uint16_t subid);
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Raw Image.
+    class RawImage: public Message
+    {
+    public:
+      //! Width.
+      uint16_t width;
+      //! Height.
+      uint16_t height;
+      //! Channels.
+      uint8_t channels;
+      //! Pixel Depth.
+      uint8_t depth;
+      //! Data.
+      std::vector<char> data;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 701;
+      }
+
+      RawImage(void);
+
+      void
+      swap(RawImage& other__);
+
+      Message*
+      clone(void) const
+      {
+        return new RawImage(*this);
+      }
+
+      void
+      clear(void);
+
+      bool
+      fieldsEqual(const Message& msg__) const;
+
+      int
+      validate(void) const;
+
+      uint8_t*
+      serializeFields(uint8_t* bfr__) const;
+
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
+      uint16_t
+      deserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      reverseDeserializeFields(const uint8_t* bfr__, uint16_t size__);
+
+      uint16_t
+      getId(void) const
+      {
+        return RawImage::getIdStatic();
+      }
+
+      const char*
+      getName(void) const
+      {
+        return "RawImage";
+      }
+
+      unsigned
+      getFixedSerializationSize(void) const
+      {
+        return 6;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(data);
+      }
+
+      void
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+    };
+
+    //! Compressed Image.
+    class CompressedImage: public Message
+    {
+    public:
+      //! Frame Id.
+      uint8_t frameid;
+      //! Data.
+      std::vector<char> data;
+
+      static uint16_t
+      getIdStatic(void)
+      {
+        return 702;
       }
 
-      VideoData(void);
+      CompressedImage(void);
+
+      void
+      swap(CompressedImage& other__);
 
       Message*
       clone(void) const
       {
-        return new VideoData(*this);
+        return new CompressedImage(*this);
       }
 
       void
@@ -16373,6 +19818,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -16382,19 +19830,19 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return VideoData::getIdStatic();
+        return CompressedImage::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "VideoData";
+        return "CompressedImage";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 10;
+        return 1;
       }
 
       unsigned
@@ -16403,43 +19851,41 @@ namespace DUNE
         return IMC::getSerializationSize(data);
       }
 
-      uint16_t
-      getSubId(void) const;
-
       void
-      setSubId(uint16_t subid);
+      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
       void
-      fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Raw Image.
-    class RawImage: public Message
+    //! Image Transmission Settings.
+    class ImageTxSettings: public Message
     {
     public:
-      //! Width.
-      uint16_t width;
-      //! Height.
-      uint16_t height;
-      //! Channels.
-      uint8_t channels;
-      //! Pixel Depth.
-      uint8_t depth;
-      //! Data.
-      std::vector<char> data;
+      //! Frames Per Second.
+      uint8_t fps;
+      //! Quality.
+      uint8_t quality;
+      //! Repetitions.
+      uint8_t reps;
+      //! Target Size.
+      uint8_t tsize;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 701;
+        return 703;
       }
 
-      RawImage(void);
+      ImageTxSettings(void);
 
       Message*
       clone(void) const
       {
-        return new RawImage(*this);
+        return new ImageTxSettings(*this);
       }
 
       void
@@ -16463,52 +19909,58 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return RawImage::getIdStatic();
+        return ImageTxSettings::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "RawImage";
+        return "ImageTxSettings";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 6;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(data);
+        return 4;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Compressed Image.
-    class CompressedImage: public Message
+    //! Image Pipeline Statistics.
+    class ImagePipelineStatistics: public Message
     {
     public:
-      //! Frame Id.
-      uint8_t frameid;
-      //! Data.
-      std::vector<char> data;
+      //! Captured Frames.
+      uint32_t captured;
+      //! Dropped Frames.
+      uint32_t dropped;
+      //! Output Frames.
+      uint32_t output;
+      //! Mean Latency.
+      fp32_t lat_mean;
+      //! Maximum Latency.
+      fp32_t lat_max;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 702;
+        return 704;
       }
 
-      CompressedImage(void);
+      ImagePipelineStatistics(void);
 
       Message*
       clone(void) const
       {
-        return new CompressedImage(*this);
+        return new ImagePipelineStatistics(*this);
       }
 
       void
@@ -16532,56 +19984,77 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return CompressedImage::getIdStatic();
+        return ImagePipelineStatistics::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "CompressedImage";
+        return "ImagePipelineStatistics";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 1;
-      }
-
-      unsigned
-      getVariableSerializationSize(void) const
-      {
-        return IMC::getSerializationSize(data);
+        return 20;
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
-    //! Image Transmission Settings.
-    class ImageTxSettings: public Message
+    //! Compressed Video.
+    class CompressedVideo: public Message
     {
     public:
-      //! Frames Per Second.
-      uint8_t fps;
-      //! Quality.
-      uint8_t quality;
-      //! Repetitions.
-      uint8_t reps;
-      //! Target Size.
-      uint8_t tsize;
+      //! Codec.
+      enum CodecEnum
+      {
+        //! H.264 Annex B.
+        CODEC_H264 = 0
+      };
+
+      //! Flags.
+      enum FlagsBits
+      {
+        //! Key Frame.
+        CVF_KEYFRAME = 0x01
+      };
+
+      //! Codec.
+      uint8_t codec;
+      //! Flags.
+      uint8_t flags;
+      //! Frame Id.
+      uint16_t frameid;
+      //! Chunk.
+      uint8_t chunk;
+      //! Chunk Count.
+      uint8_t chunks;
+      //! Data.
+      std::vector<char> data;
 
       static uint16_t
       getIdStatic(void)
       {
-        return 703;
+        return 705;
       }
 
-      ImageTxSettings(void);
+      CompressedVideo(void);
+
+      void
+      swap(CompressedVideo& other__);
 
       Message*
       clone(void) const
       {
-        return new ImageTxSettings(*this);
+        return new CompressedVideo(*this);
       }
 
       void
@@ -16596,6 +20069,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -16605,23 +20081,35 @@ namespace DUNE
       uint16_t
       getId(void) const
       {
-        return ImageTxSettings::getIdStatic();
+        return CompressedVideo::getIdStatic();
       }
 
       const char*
       getName(void) const
       {
-        return "ImageTxSettings";
+        return "CompressedVideo";
       }
 
       unsigned
       getFixedSerializationSize(void) const
       {
-        return 4;
+        return 6;
+      }
+
+      unsigned
+      getVariableSerializationSize(void) const
+      {
+        return IMC::getSerializationSize(data);
       }
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Remote State.
@@ -16691,6 +20179,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Target.
@@ -16720,6 +20214,9 @@ namespace DUNE
 
       Target(void);
 
+      void
+      swap(Target& other__);
+
       Message*
       clone(void) const
       {
@@ -16770,6 +20267,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! EntityParameter.
@@ -16789,6 +20292,9 @@ namespace DUNE
 
       EntityParameter(void);
 
+      void
+      swap(EntityParameter& other__);
+
       Message*
       clone(void) const
       {
@@ -16839,6 +20345,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! EntityParameters.
@@ -16858,6 +20370,14 @@ namespace DUNE
 
       EntityParameters(void);
 
+      EntityParameters(const EntityParameters& other__);
+
+      void
+      swap(EntityParameters& other__);
+
+      EntityParameters&
+      operator=(const EntityParameters& other__);
+
       Message*
       clone(void) const
       {
@@ -16909,6 +20429,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -16945,6 +20471,9 @@ namespace DUNE
 
       QueryEntityParameters(void);
 
+      void
+      swap(QueryEntityParameters& other__);
+
       Message*
       clone(void) const
       {
@@ -16995,6 +20524,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! SetEntityParameters.
@@ -17014,6 +20549,14 @@ namespace DUNE
 
       SetEntityParameters(void);
 
+      SetEntityParameters(const SetEntityParameters& other__);
+
+      void
+      swap(SetEntityParameters& other__);
+
+      SetEntityParameters&
+      operator=(const SetEntityParameters& other__);
+
       Message*
       clone(void) const
       {
@@ -17065,6 +20608,12 @@ namespace DUNE
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
 
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
+
     protected:
       void
       setTimeStampNested(double value__);
@@ -17097,6 +20646,9 @@ namespace DUNE
 
       SaveEntityParameters(void);
 
+      void
+      swap(SaveEntityParameters& other__);
+
       Message*
       clone(void) const
       {
@@ -17147,6 +20699,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Create Session.
@@ -17208,6 +20766,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Close Session.
@@ -17269,6 +20833,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Session Subscription.
@@ -17288,6 +20858,9 @@ namespace DUNE
 
       SessionSubscription(void);
 
+      void
+      swap(SessionSubscription& other__);
+
       Message*
       clone(void) const
       {
@@ -17338,6 +20911,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Session Keep-Alive.
@@ -17399,6 +20978,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Session Status.
@@ -17471,6 +21056,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Push Entity Parameters.
@@ -17488,6 +21079,9 @@ namespace DUNE
 
       PushEntityParameters(void);
 
+      void
+      swap(PushEntityParameters& other__);
+
       Message*
       clone(void) const
       {
@@ -17538,6 +21132,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Pop Entity Parameters.
@@ -17555,6 +21155,9 @@ namespace DUNE
 
       PopEntityParameters(void);
 
+      void
+      swap(PopEntityParameters& other__);
+
       Message*
       clone(void) const
       {
@@ -17605,6 +21208,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! I/O Event.
@@ -17633,6 +21242,9 @@ namespace DUNE
 
       IoEvent(void);
 
+      void
+      swap(IoEvent& other__);
+
       Message*
       clone(void) const
       {
@@ -17683,6 +21295,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! UamTxFrame.
@@ -17713,6 +21331,9 @@ namespace DUNE
 
       UamTxFrame(void);
 
+      void
+      swap(UamTxFrame& other__);
+
       Message*
       clone(void) const
       {
@@ -17731,6 +21352,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -17763,6 +21387,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! UamRxFrame.
@@ -17793,6 +21423,9 @@ namespace DUNE
 
       UamRxFrame(void);
 
+      void
+      swap(UamRxFrame& other__);
+
       Message*
       clone(void) const
       {
@@ -17811,6 +21444,9 @@ namespace DUNE
       uint8_t*
       serializeFields(uint8_t* bfr__) const;
 
+      void
+      scatterFields(ScatterPacket& packet__) const;
+
       uint16_t
       deserializeFields(const uint8_t* bfr__, uint16_t size__);
 
@@ -17843,6 +21479,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! UamTxStatus.
@@ -17881,6 +21523,9 @@ namespace DUNE
 
       UamTxStatus(void);
 
+      void
+      swap(UamTxStatus& other__);
+
       Message*
       clone(void) const
       {
@@ -17937,6 +21582,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! UamRxRange.
@@ -17958,6 +21609,9 @@ namespace DUNE
 
       UamRxRange(void);
 
+      void
+      swap(UamRxRange& other__);
+
       Message*
       clone(void) const
       {
@@ -18014,6 +21668,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
 
     //! Abort Acknowledged.
@@ -18149,6 +21809,12 @@ namespace DUNE
 
       void
       fieldsToJSON(std::ostream& os__, unsigned nindent__) const;
+
+      void
+      fieldsToJSON(Utils::ByteBuffer& bfr__) const;
+
+      bool
+      fieldFromJSON(const char* label__, JSONReader& reader__);
     };
   }
 }
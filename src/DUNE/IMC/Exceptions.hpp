@@ -91,6 +91,42 @@ namespace DUNE
       { }
     };
 
+    //! Malformed JSON document exception.
+    class InvalidJSON: public std::runtime_error
+    {
+    public:
+      InvalidJSON(const std::string& what):
+        std::runtime_error("invalid JSON: " + what)
+      { }
+    };
+
+    //! Malformed block log exception.
+    class InvalidBlockLog: public std::runtime_error
+    {
+    public:
+      InvalidBlockLog(const std::string& what):
+        std::runtime_error("invalid block log: " + what)
+      { }
+    };
+
+    //! Malformed log index exception.
+    class InvalidLogIndex: public std::runtime_error
+    {
+    public:
+      InvalidLogIndex(const std::string& what):
+        std::runtime_error("invalid log index: " + what)
+      { }
+    };
+
+    //! Malformed IMC definition exception.
+    class InvalidSchema: public std::runtime_error
+    {
+    public:
+      InvalidSchema(const std::string& what):
+        std::runtime_error("invalid IMC definition: " + what)
+      { }
+    };
+
     //! Buffer too short to be unpacked exception.
     class BufferTooShort: public std::runtime_error
     {
@@ -100,6 +136,15 @@ namespace DUNE
       { }
     };
 
+    //! Missing reference of a delta-encoded message exception.
+    class MissingReference: public std::runtime_error
+    {
+    public:
+      MissingReference(uint16_t id):
+        std::runtime_error("missing reference to decode message: " + DUNE::Utils::String::str(id))
+      { }
+    };
+
     //! Internal buffer is too short exception.
     class InternalBufferTooShort: public std::runtime_error
     {
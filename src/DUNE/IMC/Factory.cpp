@@ -30,7 +30,7 @@
 #include <iomanip>
 #include <string>
 #include <cstdio>
-#include <map>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/Streams/Terminal.hpp>
@@ -53,36 +53,83 @@ namespace DUNE
       return new Type();
     }
 
-    static std::pair<uint32_t, std::string> pairs_id_abbrev[] =
+    //! Message type.
+    struct Entry
     {
-#define MESSAGE(id, abbrev)                             \
-      std::pair<uint32_t, std::string>(id, #abbrev),
-#include <DUNE/IMC/Factory.def>
+      //! Message abbreviation.
+      const char* abbrev;
+      //! Creator function.
+      Creator creator;
     };
 
-    static std::pair<std::string, uint32_t> pairs_abbrev_id[] =
+    //! Message types indexed by identification number.
+    static const Entry c_entries[] =
     {
-#define MESSAGE(id, abbrev)                             \
-      std::pair<std::string, uint32_t>(#abbrev, id),
-#include <DUNE/IMC/Factory.def>
+#define MESSAGE(id, abbrev)                     \
+      {#abbrev, &create<abbrev>},
+#define NO_MESSAGE(id)                          \
+      {NULL, NULL},
+#include <DUNE/IMC/FactoryIndex.def>
     };
 
-    static std::pair<int, Creator> creator_pairs_id[] =
+    //! Number of message types.
+    static const uint32_t c_entries_size = sizeof(c_entries) / sizeof(c_entries[0]);
+
+    //! Seeds of the abbreviation hash, by bucket.
+    static const uint16_t c_hash_seeds[] =
     {
-#define MESSAGE(id, abbrev)                                     \
-      std::pair<int, Creator>(id, &create<abbrev>),
-#include <DUNE/IMC/Factory.def>
+#define HASH_SEED(seed) seed,
+#define HASH_SLOT(id)
+#include <DUNE/IMC/FactoryHash.def>
     };
 
-    DUNE_DECLARE_STATIC_MAP(creators_by_id, int, Creator, creator_pairs_id);
-    DUNE_DECLARE_STATIC_MAP(map_id_abbrev, uint32_t, std::string, pairs_id_abbrev);
-    DUNE_DECLARE_STATIC_MAP(map_abbrev_id, std::string, uint32_t, pairs_abbrev_id);
+    //! Identification numbers by abbreviation hash.
+    static const uint16_t c_hash_slots[] =
+    {
+#define HASH_SEED(seed)
+#define HASH_SLOT(id) id,
+#include <DUNE/IMC/FactoryHash.def>
+    };
+
+    //! Seeded 32-bit FNV-1a hash (must match imc_code.py).
+    //! @param seed seed.
+    //! @param str string.
+    //! @return hash value.
+    static inline uint32_t
+    hashAbbrev(uint32_t seed, const char* str)
+    {
+      uint32_t h = 2166136261u ^ seed;
+      for (; *str != 0; ++str)
+        h = (h ^ (uint8_t)*str) * 16777619u;
+      return h;
+    }
+
+    //! Find the identification number of a message abbreviation.
+    //! @param name abbreviation.
+    //! @return identification number or c_entries_size if not found.
+    static uint32_t
+    findAbbrev(const char* name)
+    {
+      const uint32_t buckets = sizeof(c_hash_seeds) / sizeof(c_hash_seeds[0]);
+      const uint32_t slots = sizeof(c_hash_slots) / sizeof(c_hash_slots[0]);
+
+      uint32_t seed = c_hash_seeds[hashAbbrev(0, name) % buckets];
+      uint32_t id = c_hash_slots[hashAbbrev(seed, name) % slots];
+
+      if (id >= c_entries_size || c_entries[id].abbrev == NULL)
+        return c_entries_size;
+
+      if (std::strcmp(c_entries[id].abbrev, name) != 0)
+        return c_entries_size;
+
+      return id;
+    }
 
     Message*
     Factory::produce(uint32_t id)
     {
-      if (creators_by_id[id])
-        return creators_by_id[id]();
+      if (id < c_entries_size && c_entries[id].creator != NULL)
+        return c_entries[id].creator();
 
       DUNE_DBG("IMC Message Factory", "unknown message " << id);
       return 0;
@@ -99,44 +146,43 @@ namespace DUNE
     std::string
     Factory::getAbbrevFromId(uint32_t id)
     {
-      std::map<uint32_t, std::string>::iterator itr = map_id_abbrev.find(id);
-
-      if (itr == map_id_abbrev.end())
+      if (id >= c_entries_size || c_entries[id].abbrev == NULL)
         throw InvalidMessageId(id);
 
-      return itr->second;
+      return c_entries[id].abbrev;
     }
 
     uint32_t
     Factory::getIdFromAbbrev(const std::string& name)
     {
-      std::map<std::string, uint32_t>::iterator itr = map_abbrev_id.find(name);
+      uint32_t id = findAbbrev(name.c_str());
 
-      if (itr == map_abbrev_id.end())
+      if (id == c_entries_size)
         throw InvalidMessageAbbrev(name);
 
-      return itr->second;
+      return id;
     }
 
     void
     Factory::getAbbrevs(std::vector<std::string>& v)
     {
-      for(std::map<std::string, uint32_t>::iterator itr = map_abbrev_id.begin();
-          itr != map_abbrev_id.end(); itr++)
+      for (uint32_t i = 0; i < c_entries_size; ++i)
       {
-        v.push_back(itr->first);
+        if (c_entries[i].abbrev != NULL)
+          v.push_back(c_entries[i].abbrev);
       }
-
     }
+
     void
     Factory::getIds(std::vector<uint32_t>& v)
     {
-      for(std::map<std::string, uint32_t>::iterator itr = map_abbrev_id.begin();
-          itr != map_abbrev_id.end(); itr++)
+      for (uint32_t i = 0; i < c_entries_size; ++i)
       {
-        v.push_back(itr->second);
+        if (c_entries[i].abbrev != NULL)
+          v.push_back(i);
       }
     }
+
     void
     Factory::getIds(std::string list, std::vector<uint32_t>& v)
     {
@@ -29,7 +29,9 @@
 #define DUNE_IMC_INLINE_MESSAGE_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <stdexcept>
 
 // DUNE headers.
@@ -54,9 +56,10 @@ namespace DUNE
         m_msg(NULL)
       { }
 
-      //! Copy constructor.
+      //! Copy constructor. The parent is not copied: it must be set
+      //! by the message that owns the new instance.
       InlineMessage(const InlineMessage& other):
-        m_parent(other.m_parent),
+        m_parent(NULL),
         m_msg(NULL)
       {
         *this = other;
@@ -96,6 +99,19 @@ namespace DUNE
         }
       }
 
+      //! Exchange the inlined message with the one of another
+      //! instance without copying it. Each instance keeps its parent
+      //! and the header of the exchanged message is synchronized
+      //! with it.
+      //! @param[in] other inline message.
+      void
+      swap(InlineMessage& other)
+      {
+        std::swap(m_msg, other.m_msg);
+        synchronizeHeader();
+        other.synchronizeHeader();
+      }
+
       const Type*
       get(void) const
       {
@@ -168,6 +184,9 @@ namespace DUNE
       InlineMessage&
       operator=(const InlineMessage& other)
       {
+        if (&other == this)
+          return *this;
+
         clear();
 
         if (other.m_msg != NULL)
@@ -273,6 +292,45 @@ namespace DUNE
         }
       }
 
+      void
+      toJSON(Utils::ByteBuffer& bfr, const char* label) const
+      {
+        writeJSONLabel(bfr, label);
+
+        if (m_msg == NULL)
+        {
+          bfr.appendSigned("\"null\"", 6);
+          return;
+        }
+
+        const char* name = m_msg->getName();
+        bfr.appendSigned("{\"abbrev\":", 10);
+        writeJSONString(bfr, name, std::strlen(name));
+        m_msg->fieldsToJSON(bfr);
+        bfr.appendSigned("}", 1);
+      }
+
+      void
+      fromJSON(JSONReader& reader)
+      {
+        Message* msg = IMC::fromJSON(reader);
+        if (msg == NULL)
+        {
+          clear();
+          return;
+        }
+
+        Type* tmsg = dynamic_cast<Type*>(msg);
+        if (tmsg == NULL)
+        {
+          std::string name = msg->getName();
+          delete msg;
+          throw InvalidMessageAbbrev(name);
+        }
+
+        replace(tmsg);
+      }
+
     private:
       //! Parent message.
       const Message* m_parent;
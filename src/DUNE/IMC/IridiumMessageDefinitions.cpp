@@ -41,48 +41,66 @@ namespace DUNE
     {
       //msg->toText(std::cerr);
 
-      uint8_t* ptr = (uint8_t*)&msg->data[0];
+      if (msg->data.empty())
+        return NULL;
+
+      return parse((const uint8_t*)&msg->data[0], msg->data.size());
+    }
+
+    IridiumMessage *
+    IridiumMessage::parse(const uint8_t* data, uint16_t len)
+    {
+      uint8_t* ptr = (uint8_t*)data;
       IridiumMessage * ret = NULL;
       uint16_t msg_id;
+      if (len < 6)
+        return NULL;
       std::memcpy(&msg_id, ptr+4, sizeof(msg_id));
 
       switch(msg_id) {
         case (ID_ACTIVATESUB):
             ret = (IridiumMessage *) new ActivateSpotSubscription();
-            ret->deserialize(ptr, msg->data.size());
+            ret->deserialize(ptr, len);
             return ret;
 
         case (ID_DEACTIVATESUB):
             ret = (IridiumMessage *) new DeactivateSpotSubscription();
-            ret->deserialize(ptr, msg->data.size());
+            ret->deserialize(ptr, len);
             return ret;
 
         case (ID_DEVICEUPDATE):
             ret = (IridiumMessage *) new DeviceUpdate();
-            ret->deserialize(ptr, msg->data.size());
+            ret->deserialize(ptr, len);
             return ret;
 
         case (ID_IRIDIUMCMD):
             ret = (IridiumMessage *) new IridiumCommand();
-            ret->deserialize(ptr, msg->data.size());
+            ret->deserialize(ptr, len);
+            return ret;
+
+        case (ID_BUNDLE):
+            ret = (IridiumMessage *) new IridiumBundle();
+            ret->deserialize(ptr, len);
             return ret;
         default:
             ret = (IridiumMessage *) new GenericIridiumMessage();
-            ret->deserialize(ptr, msg->data.size());
+            ret->deserialize(ptr, len);
             return ret;
       }
     }
 
-    GenericIridiumMessage::GenericIridiumMessage(DUNE::IMC::Message * m)
+    GenericIridiumMessage::GenericIridiumMessage(DUNE::IMC::Message * m, bool c)
     {
       msg = m;
       msg_id = m->getId();
+      compact = c;
     }
 
     GenericIridiumMessage::GenericIridiumMessage()
     {
       msg = NULL;
       msg_id = 0;
+      compact = false;
     }
 
     GenericIridiumMessage::~GenericIridiumMessage()
@@ -99,6 +117,19 @@ namespace DUNE
       uint8_t * start;
       start = buffer;
 
+      if (compact && CompactCodec::isSupported(msg_id))
+      {
+        std::vector<char> data;
+        CompactCodec().encode(*msg, data);
+
+        buffer += DUNE::IMC::serialize(source, buffer);
+        buffer += DUNE::IMC::serialize(destination, buffer);
+        buffer += DUNE::IMC::serialize(ID_COMPACT, buffer);
+        std::memcpy(buffer, &data[0], data.size());
+
+        return buffer + data.size() - start;
+      }
+
       buffer += DUNE::IMC::serialize(source, buffer);
       buffer += DUNE::IMC::serialize(destination, buffer);
       buffer += DUNE::IMC::serialize(msg_id, buffer);
@@ -118,6 +149,14 @@ namespace DUNE
 
       //std::cerr << "parsing Iridium message... msg id: " << msg_id << "size: " << length << std::endl;
 
+      if (msg_id == ID_COMPACT)
+      {
+        unsigned used = 0;
+        msg = CompactCodec().decode((const char*)buffer, length, used);
+        msg_id = msg->getId();
+        compact = true;
+        return buffer + used - start;
+      }
 
       msg = DUNE::IMC::Factory::produce(msg_id);
       if (msg == NULL)
@@ -277,5 +316,53 @@ namespace DUNE
 
       return buffer - start;
     }
+
+    IridiumBundle::IridiumBundle()
+    {
+      msg_id = ID_BUNDLE;
+    }
+
+    int
+    IridiumBundle::serialize(uint8_t * buffer)
+    {
+      uint8_t* start = buffer;
+      buffer += DUNE::IMC::serialize(source, buffer);
+      buffer += DUNE::IMC::serialize(destination, buffer);
+      buffer += DUNE::IMC::serialize(msg_id, buffer);
+
+      for (size_t i = 0; i < parts.size(); ++i)
+      {
+        uint16_t size = parts[i].size();
+        buffer += DUNE::IMC::serialize(size, buffer);
+        if (size > 0)
+          std::memcpy(buffer, &parts[i][0], size);
+        buffer += size;
+      }
+
+      return buffer - start;
+    }
+
+    int
+    IridiumBundle::deserialize(uint8_t * buffer, uint16_t length)
+    {
+      uint8_t* start = buffer;
+      buffer += DUNE::IMC::deserialize(source, buffer, length);
+      buffer += DUNE::IMC::deserialize(destination, buffer, length);
+      buffer += DUNE::IMC::deserialize(msg_id, buffer, length);
+
+      while (length >= 2)
+      {
+        uint16_t size = 0;
+        buffer += DUNE::IMC::deserialize(size, buffer, length);
+        if (size > length)
+          break;
+
+        parts.push_back(std::vector<uint8_t>(buffer, buffer + size));
+        buffer += size;
+        length -= size;
+      }
+
+      return buffer - start;
+    }
   } /* namespace IMC */
 } /* namespace DUNE */
@@ -34,6 +34,7 @@
 # include <DUNE/IMC/Definitions.hpp>
 # include <DUNE/IMC/Message.hpp>
 # include <DUNE/IMC/Factory.hpp>
+# include <DUNE/IMC/CompactCodec.hpp>
 # include <DUNE/Math.hpp>
 # include <DUNE/Math/Angles.hpp>
 
@@ -46,6 +47,8 @@ namespace DUNE
     static const uint16_t ID_ACTIVATESUB = 2003;
     static const uint16_t ID_DEACTIVATESUB = 2004;
     static const uint16_t ID_IRIDIUMCMD = 2005;
+    static const uint16_t ID_COMPACT = 2006;
+    static const uint16_t ID_BUNDLE = 2007;
 
     typedef struct {
       uint16_t id;
@@ -67,6 +70,9 @@ namespace DUNE
       //! Parse a received message received into an Iridium message
       static IridiumMessage * deserialize(const DUNE::IMC::IridiumMsgRx * msg);
 
+      //! Parse an Iridium message
+      static IridiumMessage * parse(const uint8_t* data, uint16_t len);
+
       //! Serialize this message into a data buffer (to be sent via Iridium)
       virtual int serialize(uint8_t * buffer) = 0;
 
@@ -81,11 +87,16 @@ namespace DUNE
     {
     public:
       GenericIridiumMessage();
-      GenericIridiumMessage(DUNE::IMC::Message * msg);
+      //! @param msg message to send.
+      //! @param compact use the compact encoding (see CompactCodec)
+      //! if the message supports it.
+      GenericIridiumMessage(DUNE::IMC::Message * msg, bool compact = false);
       int serialize(uint8_t * buffer);
       int deserialize(uint8_t* data, uint16_t len);
       ~GenericIridiumMessage();
       DUNE::IMC::Message * msg;
+      //! True to send the message in compact encoding.
+      bool compact;
     };
 
     //! Extension to the IMC protocol used to report a set of device positions
@@ -130,6 +141,19 @@ namespace DUNE
       ~IridiumCommand(){};
     };
 
+    //! Extension to the IMC protocol used to send several Iridium
+    //! messages in one SBD (each one preceded by its size)
+    class IridiumBundle : public IridiumMessage
+    {
+    public:
+      IridiumBundle();
+      int serialize(uint8_t * buffer);
+      int deserialize(uint8_t* data, uint16_t len);
+      ~IridiumBundle(){};
+      //! Serialized Iridium messages
+      std::vector<std::vector<uint8_t> > parts;
+    };
+
   } /* namespace IMC */
 } /* namespace DUNE */
 #endif /* IRIDIUMMESSAGEDEFINITIONS_HPP_ */
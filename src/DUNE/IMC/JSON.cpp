@@ -25,8 +25,17 @@
 // Author: Ricardo Martins                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 // DUNE headers.
 #include <DUNE/IMC/JSON.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
 
 namespace DUNE
 {
@@ -61,5 +70,551 @@ namespace DUNE
 
       return c_levels[count];
     }
+
+    //! Hexadecimal digits.
+    static const char c_hex[] = "0123456789ABCDEF";
+
+    void
+    writeJSONLabel(Utils::ByteBuffer& bfr, const char* label)
+    {
+      size_t size = std::strlen(label);
+      bfr.grow(bfr.getSize() + size + 4);
+
+      char* ptr = bfr.getBufferSigned() + bfr.getSize();
+      *ptr++ = ',';
+      *ptr++ = '"';
+      std::memcpy(ptr, label, size);
+      ptr += size;
+      *ptr++ = '"';
+      *ptr++ = ':';
+      bfr.setSize(bfr.getSize() + size + 4);
+    }
+
+    void
+    writeJSONString(Utils::ByteBuffer& bfr, const char* str, size_t size)
+    {
+      // Worst case is every character escaped as \u00XX.
+      bfr.grow(bfr.getSize() + size * 6 + 2);
+
+      char* beg = bfr.getBufferSigned() + bfr.getSize();
+      char* ptr = beg;
+      *ptr++ = '"';
+
+      for (size_t i = 0; i < size; ++i)
+      {
+        unsigned char c = (unsigned char)str[i];
+
+        if (c == '"' || c == '\\')
+        {
+          *ptr++ = '\\';
+          *ptr++ = (char)c;
+        }
+        else if (c < 0x20)
+        {
+          *ptr++ = '\\';
+          switch (c)
+          {
+            case '\n':
+              *ptr++ = 'n';
+              break;
+            case '\r':
+              *ptr++ = 'r';
+              break;
+            case '\t':
+              *ptr++ = 't';
+              break;
+            default:
+              *ptr++ = 'u';
+              *ptr++ = '0';
+              *ptr++ = '0';
+              *ptr++ = c_hex[c >> 4];
+              *ptr++ = c_hex[c & 0x0f];
+              break;
+          }
+        }
+        else
+        {
+          *ptr++ = (char)c;
+        }
+      }
+
+      *ptr++ = '"';
+      bfr.setSize(bfr.getSize() + (ptr - beg));
+    }
+
+    //! Format an unsigned integer.
+    //! @param[in] end one past the end of the output buffer.
+    //! @param[in] value value.
+    //! @return first character.
+    static char*
+    formatUnsigned(char* end, uint64_t value)
+    {
+      char* ptr = end;
+
+      do
+      {
+        *--ptr = (char)('0' + (value % 10));
+        value /= 10;
+      }
+      while (value != 0);
+
+      return ptr;
+    }
+
+    void
+    writeJSONInteger(Utils::ByteBuffer& bfr, int64_t value)
+    {
+      char tmp[24];
+      char* end = tmp + sizeof(tmp);
+      *--end = '"';
+
+      uint64_t mag = (value < 0) ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+      char* ptr = formatUnsigned(end, mag);
+      if (value < 0)
+        *--ptr = '-';
+      *--ptr = '"';
+
+      bfr.appendSigned(ptr, tmp + sizeof(tmp) - ptr);
+    }
+
+    void
+    writeJSONUnsigned(Utils::ByteBuffer& bfr, uint64_t value)
+    {
+      char tmp[24];
+      char* end = tmp + sizeof(tmp);
+      *--end = '"';
+
+      char* ptr = formatUnsigned(end, value);
+      *--ptr = '"';
+
+      bfr.appendSigned(ptr, tmp + sizeof(tmp) - ptr);
+    }
+
+    void
+    writeJSONFloat(Utils::ByteBuffer& bfr, double value, unsigned digits)
+    {
+      // Integral values are common (zero in particular).
+      if (value > -1e15 && value < 1e15 && value == (double)(int64_t)value)
+      {
+        writeJSONInteger(bfr, (int64_t)value);
+        return;
+      }
+
+      char tmp[40];
+      int size = std::sprintf(tmp, "\"%.*g\"", (int)digits, value);
+
+      // Use a dot as decimal separator regardless of locale.
+      for (int i = 1; i < size - 1; ++i)
+      {
+        if (tmp[i] == ',')
+          tmp[i] = '.';
+      }
+
+      bfr.appendSigned(tmp, size);
+    }
+
+    void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, const std::vector<char>& value)
+    {
+      writeJSONLabel(bfr, label);
+      bfr.grow(bfr.getSize() + value.size() * 2 + 2);
+
+      char* beg = bfr.getBufferSigned() + bfr.getSize();
+      char* ptr = beg;
+      *ptr++ = '"';
+      for (size_t i = 0; i < value.size(); ++i)
+      {
+        unsigned char c = (unsigned char)value[i];
+        *ptr++ = c_hex[c >> 4];
+        *ptr++ = c_hex[c & 0x0f];
+      }
+      *ptr++ = '"';
+      bfr.setSize(bfr.getSize() + (ptr - beg));
+    }
+
+    //! Convert an hexadecimal digit.
+    static int
+    hexValue(char c)
+    {
+      if (c >= '0' && c <= '9')
+        return c - '0';
+      if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+      return -1;
+    }
+
+    void
+    JSONReader::fail(const char* what)
+    {
+      throw InvalidJSON(what);
+    }
+
+    void
+    JSONReader::skipSpace(void)
+    {
+      while (m_ptr < m_end && (*m_ptr == ' ' || *m_ptr == '\n' || *m_ptr == '\r' || *m_ptr == '\t'))
+        ++m_ptr;
+    }
+
+    bool
+    JSONReader::consume(char c)
+    {
+      skipSpace();
+      if (m_ptr < m_end && *m_ptr == c)
+      {
+        ++m_ptr;
+        return true;
+      }
+
+      return false;
+    }
+
+    void
+    JSONReader::expect(char c)
+    {
+      if (!consume(c))
+        fail("unexpected character");
+    }
+
+    bool
+    JSONReader::token(const char*& beg, const char*& end)
+    {
+      skipSpace();
+      if (m_ptr >= m_end)
+        fail("unexpected end of document");
+
+      if (*m_ptr == '"')
+      {
+        beg = ++m_ptr;
+        while (m_ptr < m_end && *m_ptr != '"')
+        {
+          if (*m_ptr == '\\')
+            ++m_ptr;
+          ++m_ptr;
+        }
+
+        if (m_ptr >= m_end)
+          fail("unterminated string");
+
+        end = m_ptr++;
+        return true;
+      }
+
+      beg = m_ptr;
+      while (m_ptr < m_end && std::strchr(",}] \n\r\t", *m_ptr) == NULL)
+        ++m_ptr;
+      end = m_ptr;
+
+      if (beg == end)
+        fail("missing value");
+
+      return false;
+    }
+
+    bool
+    JSONReader::beginObject(void)
+    {
+      skipSpace();
+      if (m_ptr < m_end && *m_ptr != '{')
+      {
+        // The writer represents empty inline messages as "null".
+        const char* beg = NULL;
+        const char* end = NULL;
+        token(beg, end);
+        if (end - beg == 4 && std::strncmp(beg, "null", 4) == 0)
+          return false;
+
+        fail("expected object");
+      }
+
+      expect('{');
+      return true;
+    }
+
+    bool
+    JSONReader::nextKey(std::string& key)
+    {
+      if (consume('}'))
+        return false;
+
+      consume(',');
+
+      const char* beg = NULL;
+      const char* end = NULL;
+      if (!token(beg, end))
+        fail("expected key");
+
+      key.assign(beg, end - beg);
+      expect(':');
+      return true;
+    }
+
+    void
+    JSONReader::beginArray(void)
+    {
+      expect('[');
+    }
+
+    bool
+    JSONReader::nextElement(void)
+    {
+      if (consume(']'))
+        return false;
+
+      consume(',');
+      return true;
+    }
+
+    void
+    JSONReader::skip(void)
+    {
+      skipSpace();
+      if (m_ptr >= m_end)
+        fail("unexpected end of document");
+
+      if (*m_ptr == '{')
+      {
+        std::string key;
+        beginObject();
+        while (nextKey(key))
+          skip();
+      }
+      else if (*m_ptr == '[')
+      {
+        beginArray();
+        while (nextElement())
+          skip();
+      }
+      else
+      {
+        const char* beg = NULL;
+        const char* end = NULL;
+        token(beg, end);
+      }
+    }
+
+    void
+    JSONReader::read(std::string& value)
+    {
+      const char* beg = NULL;
+      const char* end = NULL;
+      token(beg, end);
+
+      value.clear();
+      value.reserve(end - beg);
+
+      for (const char* ptr = beg; ptr < end; ++ptr)
+      {
+        if (*ptr != '\\' || ptr + 1 == end)
+        {
+          value.push_back(*ptr);
+          continue;
+        }
+
+        switch (*++ptr)
+        {
+          case 'n':
+            value.push_back('\n');
+            break;
+          case 'r':
+            value.push_back('\r');
+            break;
+          case 't':
+            value.push_back('\t');
+            break;
+          case 'b':
+            value.push_back('\b');
+            break;
+          case 'f':
+            value.push_back('\f');
+            break;
+          case 'u':
+            // Only code points below 256 are produced by the writer.
+            if (end - ptr < 5)
+              fail("invalid escape sequence");
+            {
+              int code = 0;
+              for (int i = 1; i <= 4; ++i)
+              {
+                int digit = hexValue(ptr[i]);
+                if (digit < 0)
+                  fail("invalid escape sequence");
+                code = (code << 4) | digit;
+              }
+              value.push_back((char)code);
+              ptr += 4;
+            }
+            break;
+          default:
+            value.push_back(*ptr);
+            break;
+        }
+      }
+    }
+
+    void
+    JSONReader::read(std::vector<char>& value)
+    {
+      const char* beg = NULL;
+      const char* end = NULL;
+      token(beg, end);
+
+      if ((end - beg) % 2 != 0)
+        fail("invalid hexadecimal string");
+
+      value.resize((end - beg) / 2);
+      for (size_t i = 0; i < value.size(); ++i)
+      {
+        int hi = hexValue(beg[i * 2]);
+        int lo = hexValue(beg[i * 2 + 1]);
+        if (hi < 0 || lo < 0)
+          fail("invalid hexadecimal string");
+        value[i] = (char)((hi << 4) | lo);
+      }
+    }
+
+    void
+    JSONReader::read(int64_t& value)
+    {
+      const char* beg = NULL;
+      const char* end = NULL;
+      token(beg, end);
+
+      bool negative = (*beg == '-');
+      if (negative)
+        ++beg;
+
+      uint64_t mag = 0;
+      const char* ptr = beg;
+      for (; ptr < end && *ptr >= '0' && *ptr <= '9'; ++ptr)
+        mag = mag * 10 + (*ptr - '0');
+
+      if (ptr == beg)
+        fail("invalid integer");
+
+      value = negative ? -(int64_t)mag : (int64_t)mag;
+    }
+
+    void
+    JSONReader::read(uint64_t& value)
+    {
+      const char* beg = NULL;
+      const char* end = NULL;
+      token(beg, end);
+
+      value = 0;
+      const char* ptr = beg;
+      for (; ptr < end && *ptr >= '0' && *ptr <= '9'; ++ptr)
+        value = value * 10 + (*ptr - '0');
+
+      if (ptr == beg)
+        fail("invalid integer");
+    }
+
+    void
+    JSONReader::read(fp64_t& value)
+    {
+      const char* beg = NULL;
+      const char* end = NULL;
+      token(beg, end);
+
+      char tmp[64];
+      size_t size = std::min((size_t)(end - beg), sizeof(tmp) - 1);
+      std::memcpy(tmp, beg, size);
+      tmp[size] = 0;
+
+      char* eptr = NULL;
+      value = std::strtod(tmp, &eptr);
+      if (eptr == tmp)
+        fail("invalid number");
+    }
+
+    Message*
+    fromJSON(JSONReader& reader)
+    {
+      const char* start = reader.getPosition();
+      std::string key;
+
+      if (!reader.beginObject())
+        return NULL;
+
+      // Find message type, which may appear anywhere in the object.
+      std::string abbrev;
+      while (reader.nextKey(key))
+      {
+        if (key == "abbrev")
+          reader.read(abbrev);
+        else
+          reader.skip();
+      }
+
+      Message* msg = Factory::produce(abbrev);
+      if (msg == NULL)
+        throw InvalidMessageAbbrev(abbrev);
+
+      try
+      {
+        reader.setPosition(start);
+        reader.beginObject();
+
+        while (reader.nextKey(key))
+        {
+          if (key == "timestamp")
+          {
+            fp64_t v = 0;
+            reader.read(v);
+            msg->setTimeStamp(v);
+          }
+          else if (key == "src")
+          {
+            uint16_t v = 0;
+            reader.read(v);
+            msg->setSource(v);
+          }
+          else if (key == "src_ent")
+          {
+            uint8_t v = 0;
+            reader.read(v);
+            msg->setSourceEntity(v);
+          }
+          else if (key == "dst")
+          {
+            uint16_t v = 0;
+            reader.read(v);
+            msg->setDestination(v);
+          }
+          else if (key == "dst_ent")
+          {
+            uint8_t v = 0;
+            reader.read(v);
+            msg->setDestinationEntity(v);
+          }
+          else if (key == "abbrev" || !msg->fieldFromJSON(key.c_str(), reader))
+          {
+            reader.skip();
+          }
+        }
+      }
+      catch (...)
+      {
+        delete msg;
+        throw;
+      }
+
+      return msg;
+    }
+
+    Message*
+    fromJSON(const char* data, size_t size)
+    {
+      JSONReader reader(data, size);
+      Message* msg = fromJSON(reader);
+      if (msg == NULL)
+        throw InvalidJSON("null message");
+
+      return msg;
+    }
   }
 }
@@ -36,6 +36,7 @@
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Utils/String.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
 
 namespace DUNE
 {
@@ -116,6 +117,309 @@ namespace DUNE
       const char* indent = indentJSON(nindent);
       os << prefix << '\n' << indent << '"' << label << "\": \"" << Utils::String::toHex(value) << '"';
     }
+
+    //! Append a JSON label, preceded by a comma, to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] label label.
+    void
+    writeJSONLabel(Utils::ByteBuffer& bfr, const char* label);
+
+    //! Append a quoted and escaped JSON string to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] str string.
+    //! @param[in] size length of string.
+    void
+    writeJSONString(Utils::ByteBuffer& bfr, const char* str, size_t size);
+
+    //! Append a quoted signed integer to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] value value.
+    void
+    writeJSONInteger(Utils::ByteBuffer& bfr, int64_t value);
+
+    //! Append a quoted unsigned integer to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] value value.
+    void
+    writeJSONUnsigned(Utils::ByteBuffer& bfr, uint64_t value);
+
+    //! Append a quoted floating point number, independent of locale,
+    //! to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] value value.
+    //! @param[in] digits number of significant digits.
+    void
+    writeJSONFloat(Utils::ByteBuffer& bfr, double value, unsigned digits);
+
+    //! Append a labeled signed integer to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] label label.
+    //! @param[in] value value.
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, int64_t value)
+    {
+      writeJSONLabel(bfr, label);
+      writeJSONInteger(bfr, value);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, int8_t value)
+    {
+      toJSON(bfr, label, (int64_t)value);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, int16_t value)
+    {
+      toJSON(bfr, label, (int64_t)value);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, int32_t value)
+    {
+      toJSON(bfr, label, (int64_t)value);
+    }
+
+    //! Append a labeled unsigned integer to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] label label.
+    //! @param[in] value value.
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, uint64_t value)
+    {
+      writeJSONLabel(bfr, label);
+      writeJSONUnsigned(bfr, value);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, uint8_t value)
+    {
+      toJSON(bfr, label, (uint64_t)value);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, uint16_t value)
+    {
+      toJSON(bfr, label, (uint64_t)value);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, uint32_t value)
+    {
+      toJSON(bfr, label, (uint64_t)value);
+    }
+
+    //! Append a labeled floating point number, with enough digits to
+    //! be read back exactly, to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] label label.
+    //! @param[in] value value.
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, fp64_t value)
+    {
+      writeJSONLabel(bfr, label);
+      writeJSONFloat(bfr, value, 17);
+    }
+
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, fp32_t value)
+    {
+      writeJSONLabel(bfr, label);
+      writeJSONFloat(bfr, value, 9);
+    }
+
+    //! Append a labeled string to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] label label.
+    //! @param[in] value value.
+    inline void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, const std::string& value)
+    {
+      writeJSONLabel(bfr, label);
+      writeJSONString(bfr, value.data(), value.size());
+    }
+
+    //! Append a labeled character vector, in hexadecimal, to a buffer.
+    //! @param[in] bfr buffer.
+    //! @param[in] label label.
+    //! @param[in] value value.
+    void
+    toJSON(Utils::ByteBuffer& bfr, const char* label, const std::vector<char>& value);
+
+    // Forward declaration.
+    class Message;
+
+    //! Pull parser of the JSON documents produced by the buffer
+    //! writer. Values may be quoted or bare and the parser does not
+    //! allocate except for strings.
+    class JSONReader
+    {
+    public:
+      //! Constructor.
+      //! @param[in] data JSON document.
+      //! @param[in] size size of the document.
+      JSONReader(const char* data, size_t size):
+        m_ptr(data),
+        m_end(data + size)
+      { }
+
+      //! Get current position.
+      //! @return current position.
+      const char*
+      getPosition(void) const
+      {
+        return m_ptr;
+      }
+
+      //! Set current position.
+      //! @param[in] ptr position previously retrieved with
+      //! getPosition().
+      void
+      setPosition(const char* ptr)
+      {
+        m_ptr = ptr;
+      }
+
+      //! Start reading an object.
+      //! @return false if the value is null, true otherwise.
+      bool
+      beginObject(void);
+
+      //! Read the next key of the current object.
+      //! @param[out] key key.
+      //! @return false at the end of the object, true otherwise.
+      bool
+      nextKey(std::string& key);
+
+      //! Start reading an array.
+      void
+      beginArray(void);
+
+      //! Check if the current array has more elements.
+      //! @return false at the end of the array, true otherwise.
+      bool
+      nextElement(void);
+
+      //! Skip the next value.
+      void
+      skip(void);
+
+      void
+      read(std::string& value);
+
+      void
+      read(std::vector<char>& value);
+
+      void
+      read(int64_t& value);
+
+      void
+      read(uint64_t& value);
+
+      void
+      read(fp64_t& value);
+
+      void
+      read(fp32_t& value)
+      {
+        fp64_t v = 0;
+        read(v);
+        value = (fp32_t)v;
+      }
+
+      void
+      read(int8_t& value)
+      {
+        readSigned(value);
+      }
+
+      void
+      read(int16_t& value)
+      {
+        readSigned(value);
+      }
+
+      void
+      read(int32_t& value)
+      {
+        readSigned(value);
+      }
+
+      void
+      read(uint8_t& value)
+      {
+        readUnsigned(value);
+      }
+
+      void
+      read(uint16_t& value)
+      {
+        readUnsigned(value);
+      }
+
+      void
+      read(uint32_t& value)
+      {
+        readUnsigned(value);
+      }
+
+    private:
+      //! Current position.
+      const char* m_ptr;
+      //! End of document.
+      const char* m_end;
+
+      template <typename Type>
+      void
+      readSigned(Type& value)
+      {
+        int64_t v = 0;
+        read(v);
+        value = (Type)v;
+      }
+
+      template <typename Type>
+      void
+      readUnsigned(Type& value)
+      {
+        uint64_t v = 0;
+        read(v);
+        value = (Type)v;
+      }
+
+      void
+      skipSpace(void);
+
+      void
+      expect(char c);
+
+      bool
+      consume(char c);
+
+      //! Find the extent of the next scalar value.
+      //! @param[out] beg first character.
+      //! @param[out] end one past the last character.
+      //! @return true if the value was quoted.
+      bool
+      token(const char*& beg, const char*& end);
+
+      void
+      fail(const char* what);
+    };
+
+    //! Decode a message object, created with the factory from its
+    //! "abbrev" key.
+    //! @param[in] reader JSON reader.
+    //! @return new message or NULL if the value is null.
+    Message*
+    fromJSON(JSONReader& reader);
+
+    //! Decode a message from a JSON document.
+    //! @param[in] data JSON document.
+    //! @param[in] size size of the document.
+    //! @return new message.
+    Message*
+    fromJSON(const char* data, size_t size);
   }
 }
 
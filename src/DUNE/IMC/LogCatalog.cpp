@@ -0,0 +1,228 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <set>
+
+// DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/IMC/LogCatalog.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    using FileSystem::DirectoryIndex;
+    using FileSystem::Path;
+
+    //! Names of log files, in order of preference.
+    static const char* c_log_files[] =
+    {
+      "Data.lsf.blk",
+      "Data.lsf",
+      "Data.lsf.gz",
+      "Data.lsf.bz2"
+    };
+
+    //! Number of log file names.
+    static const unsigned c_log_files_count = sizeof(c_log_files) / sizeof(c_log_files[0]);
+
+    LogCatalog::LogCatalog(const Path& root, DirectoryIndex& dirs):
+      m_root(root),
+      m_dirs(dirs)
+    { }
+
+    bool
+    LogCatalog::isLogFile(const std::string& name)
+    {
+      for (unsigned i = 0; i < c_log_files_count; ++i)
+      {
+        if (name == c_log_files[i])
+          return true;
+      }
+
+      return false;
+    }
+
+    void
+    LogCatalog::get(std::vector<Summary>& logs)
+    {
+      logs.clear();
+
+      Concurrency::ScopedMutex l(m_lock);
+
+      std::set<std::string> seen;
+      std::vector<DirectoryIndex::Entry> days;
+      m_dirs.list(m_root, days);
+
+      for (size_t i = 0; i < days.size(); ++i)
+      {
+        if (days[i].type != Path::PT_DIRECTORY)
+          continue;
+
+        std::vector<DirectoryIndex::Entry> dirs;
+        m_dirs.list(m_root / days[i].name, dirs);
+
+        for (size_t j = 0; j < dirs.size(); ++j)
+        {
+          if (dirs[j].type != Path::PT_DIRECTORY)
+            continue;
+
+          Summary log;
+          if (summarize(days[i].name + "/" + dirs[j].name, log))
+          {
+            seen.insert(log.name);
+            logs.push_back(log);
+          }
+        }
+      }
+
+      // Forget logs that were removed.
+      std::map<std::string, Cached>::iterator itr = m_cache.begin();
+      while (itr != m_cache.end())
+      {
+        if (seen.find(itr->first) == seen.end())
+          m_cache.erase(itr++);
+        else
+          ++itr;
+      }
+    }
+
+    bool
+    LogCatalog::get(const std::string& name, Summary& log)
+    {
+      // Only logs below the log directory are summarized.
+      if (name.empty() || name.find("..") != std::string::npos)
+        return false;
+
+      Concurrency::ScopedMutex l(m_lock);
+      return summarize(name, log);
+    }
+
+    bool
+    LogCatalog::summarize(const std::string& name, Summary& log)
+    {
+      std::vector<DirectoryIndex::Entry> entries;
+      if (!m_dirs.list(m_root / name, entries))
+      {
+        m_cache.erase(name);
+        return false;
+      }
+
+      log.name = name;
+      log.file.clear();
+      log.size = 0;
+
+      unsigned best = c_log_files_count;
+      const DirectoryIndex::Entry* idx = NULL;
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+        if (entries[i].type != Path::PT_FILE)
+          continue;
+
+        log.size += entries[i].size;
+
+        if (entries[i].name == "Data.lsf.idx")
+          idx = &entries[i];
+
+        for (unsigned j = 0; j < best; ++j)
+        {
+          if (entries[i].name == c_log_files[j])
+          {
+            best = j;
+            log.file = entries[i].name;
+            break;
+          }
+        }
+      }
+
+      if (log.file.empty())
+      {
+        m_cache.erase(name);
+        return false;
+      }
+
+      Cached& cached = m_cache[name];
+      if (idx == NULL)
+      {
+        cached.idx_size = -1;
+        cached.idx_mtime = 0;
+        cached.summary.indexed = false;
+        cached.summary.start = 0;
+        cached.summary.end = 0;
+        cached.summary.counts.clear();
+      }
+      else if (cached.idx_size != idx->size || cached.idx_mtime != idx->mtime)
+      {
+        cached.idx_size = idx->size;
+        cached.idx_mtime = idx->mtime;
+        cached.summary.indexed = false;
+        cached.summary.start = 0;
+        cached.summary.end = 0;
+        cached.summary.counts.clear();
+
+        try
+        {
+          LogIndex index((m_root / name / idx->name).str());
+          const std::vector<LogIndex::Entry>& blocks = index.getEntries();
+
+          for (size_t i = 0; i < blocks.size(); ++i)
+          {
+            if (blocks[i].counts.empty())
+              continue;
+
+            if (!cached.summary.indexed || blocks[i].start < cached.summary.start)
+              cached.summary.start = blocks[i].start;
+
+            if (!cached.summary.indexed || blocks[i].end > cached.summary.end)
+              cached.summary.end = blocks[i].end;
+
+            cached.summary.indexed = true;
+
+            std::map<uint16_t, uint32_t>::const_iterator c = blocks[i].counts.begin();
+            for (; c != blocks[i].counts.end(); ++c)
+              cached.summary.counts[c->first] += c->second;
+          }
+        }
+        catch (std::exception&)
+        {
+          // Unreadable indexes leave the log unindexed.
+          cached.summary.indexed = false;
+          cached.summary.counts.clear();
+        }
+      }
+
+      log.indexed = cached.summary.indexed;
+      log.start = cached.summary.start;
+      log.end = cached.summary.end;
+      log.counts = cached.summary.counts;
+      return true;
+    }
+  }
+}
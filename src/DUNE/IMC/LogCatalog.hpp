@@ -0,0 +1,144 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_CATALOG_HPP_INCLUDED_
+#define DUNE_IMC_LOG_CATALOG_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/FileSystem/DirectoryIndex.hpp>
+#include <DUNE/FileSystem/Path.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogCatalog;
+
+    //! Summaries of the logs stored below a log directory, laid out
+    //! as DAY/LOG (e.g., 20140721/103015_plan). Logs are summarized
+    //! from their directory listing and their index (see LogIndex),
+    //! and summaries are kept until the index of the log changes,
+    //! so only logs that are being written are summarized again.
+    class LogCatalog
+    {
+    public:
+      //! Log summary.
+      struct Summary
+      {
+        //! Log name, relative to the log directory.
+        std::string name;
+        //! Name of the log file.
+        std::string file;
+        //! Total size of the files of the log in bytes.
+        int64_t size;
+        //! True if the log has an index.
+        bool indexed;
+        //! Time stamp of the first message (indexed logs only).
+        fp64_t start;
+        //! Time stamp of the last message (indexed logs only).
+        fp64_t end;
+        //! Number of messages per identifier (indexed logs only).
+        std::map<uint16_t, uint32_t> counts;
+
+        Summary(void):
+          size(0),
+          indexed(false),
+          start(0),
+          end(0)
+        { }
+      };
+
+      //! Constructor.
+      //! @param[in] root log directory.
+      //! @param[in] dirs directory index used to list directories.
+      LogCatalog(const FileSystem::Path& root,
+                 FileSystem::DirectoryIndex& dirs = FileSystem::DirectoryIndex::getShared());
+
+      //! Retrieve the summaries of all logs, sorted by name.
+      //! @param[out] logs log summaries.
+      void
+      get(std::vector<Summary>& logs);
+
+      //! Retrieve the summary of one log.
+      //! @param[in] name log name, relative to the log directory.
+      //! @param[out] log log summary.
+      //! @return true if the log exists, false otherwise.
+      bool
+      get(const std::string& name, Summary& log);
+
+      //! Check if a directory entry is a log file.
+      //! @param[in] name file name.
+      //! @return true if it is a log file, false otherwise.
+      static bool
+      isLogFile(const std::string& name);
+
+    private:
+      //! Cached summary.
+      struct Cached
+      {
+        //! Summary.
+        Summary summary;
+        //! Size of the index when it was read (-1 if never read).
+        int64_t idx_size;
+        //! Modification time of the index when it was read.
+        std::time_t idx_mtime;
+
+        Cached(void):
+          idx_size(-1),
+          idx_mtime(0)
+        { }
+      };
+
+      //! Log directory.
+      FileSystem::Path m_root;
+      //! Directory index.
+      FileSystem::DirectoryIndex& m_dirs;
+      //! Cached summaries by log name.
+      std::map<std::string, Cached> m_cache;
+      //! Lock.
+      Concurrency::Mutex m_lock;
+
+      //! Summarize a log directory.
+      //! @param[in] name log name.
+      //! @param[out] log log summary.
+      //! @return true if the directory holds a log, false otherwise.
+      bool
+      summarize(const std::string& name, Summary& log);
+    };
+  }
+}
+
+#endif
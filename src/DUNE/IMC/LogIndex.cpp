@@ -0,0 +1,196 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <fstream>
+
+// DUNE headers.
+#include <DUNE/Utils/ByteBuffer.hpp>
+#include <DUNE/Utils/ByteCopy.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    using Utils::ByteCopy;
+
+    //! Magic number of the index header.
+    static const char c_magic[] = "LSFX";
+    //! Format version.
+    static const uint8_t c_version = 1;
+    //! Size of the index header.
+    static const unsigned c_header_size = 8;
+    //! Size of an entry, excluding message counts.
+    static const unsigned c_entry_size = 34;
+    //! Size of a message count.
+    static const unsigned c_count_size = 6;
+
+    static uint8_t*
+    put(uint8_t* bfr, uint64_t value)
+    {
+      bfr += ByteCopy::toLE((uint32_t)(value & 0xffffffff), bfr);
+      return bfr + ByteCopy::toLE((uint32_t)(value >> 32), bfr);
+    }
+
+    static const uint8_t*
+    get(const uint8_t* bfr, uint64_t& value)
+    {
+      uint32_t lo = 0;
+      uint32_t hi = 0;
+      bfr += ByteCopy::fromLE(lo, bfr);
+      bfr += ByteCopy::fromLE(hi, bfr);
+      value = ((uint64_t)hi << 32) | lo;
+      return bfr;
+    }
+
+    static uint8_t*
+    put(uint8_t* bfr, fp64_t value)
+    {
+      uint64_t bits = 0;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return put(bfr, bits);
+    }
+
+    static const uint8_t*
+    get(const uint8_t* bfr, fp64_t& value)
+    {
+      uint64_t bits = 0;
+      bfr = get(bfr, bits);
+      std::memcpy(&value, &bits, sizeof(value));
+      return bfr;
+    }
+
+    void
+    LogIndex::Entry::add(uint32_t pos, uint16_t id, fp64_t time)
+    {
+      if (first == usize)
+      {
+        first = pos;
+        start = time;
+      }
+
+      end = time;
+      ++counts[id];
+    }
+
+    LogIndex::LogIndex(const std::string& path)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+
+      uint8_t hdr[c_header_size];
+      ifs.read((char*)hdr, sizeof(hdr));
+      if (!ifs || std::memcmp(hdr, c_magic, 4) != 0)
+        throw InvalidLogIndex("bad header in " + path);
+
+      if (hdr[4] != c_version)
+        throw InvalidLogIndex("unsupported version");
+
+      if (hdr[5] > Compression::METHOD_DEFLATE)
+        throw InvalidLogIndex("unknown compression method");
+
+      m_method = (Compression::Methods)hdr[5];
+
+      uint8_t bfr[c_entry_size];
+      std::vector<uint8_t> counts;
+
+      // Stop at the first incomplete entry.
+      while (ifs.read((char*)bfr, sizeof(bfr)))
+      {
+        Entry e;
+        const uint8_t* ptr = get(bfr, e.offset);
+        ptr += ByteCopy::fromLE(e.first, ptr);
+        ptr += ByteCopy::fromLE(e.usize, ptr);
+        ptr = get(ptr, e.start);
+        ptr = get(ptr, e.end);
+
+        uint16_t n = 0;
+        ByteCopy::fromLE(n, ptr);
+
+        counts.resize(n * c_count_size);
+        if (n > 0 && !ifs.read((char*)&counts[0], counts.size()))
+          break;
+
+        for (unsigned i = 0; i < n; ++i)
+        {
+          uint16_t id = 0;
+          uint32_t count = 0;
+          ByteCopy::fromLE(id, &counts[i * c_count_size]);
+          ByteCopy::fromLE(count, &counts[i * c_count_size + 2]);
+          e.counts[id] = count;
+        }
+
+        m_entries.push_back(e);
+      }
+    }
+
+    std::string
+    LogIndex::getPath(const std::string& log)
+    {
+      size_t pos = log.rfind(".lsf");
+      if (pos == std::string::npos)
+        return log + ".idx";
+
+      return log.substr(0, pos + 4) + ".idx";
+    }
+
+    void
+    LogIndex::writeHeader(std::ostream& os, Compression::Methods method)
+    {
+      uint8_t hdr[c_header_size] = {0};
+      std::memcpy(hdr, c_magic, 4);
+      hdr[4] = c_version;
+      hdr[5] = (uint8_t)method;
+      os.write((const char*)hdr, sizeof(hdr));
+    }
+
+    void
+    LogIndex::writeEntry(std::ostream& os, const Entry& entry)
+    {
+      Utils::ByteBuffer bfr;
+      bfr.setSize(c_entry_size + entry.counts.size() * c_count_size);
+
+      uint8_t* ptr = put(bfr.getBuffer(), entry.offset);
+      ptr += ByteCopy::toLE(entry.first, ptr);
+      ptr += ByteCopy::toLE(entry.usize, ptr);
+      ptr = put(ptr, entry.start);
+      ptr = put(ptr, entry.end);
+      ptr += ByteCopy::toLE((uint16_t)entry.counts.size(), ptr);
+
+      std::map<uint16_t, uint32_t>::const_iterator itr = entry.counts.begin();
+      for (; itr != entry.counts.end(); ++itr)
+      {
+        ptr += ByteCopy::toLE(itr->first, ptr);
+        ptr += ByteCopy::toLE(itr->second, ptr);
+      }
+
+      os.write(bfr.getBufferSigned(), bfr.getSize());
+    }
+  }
+}
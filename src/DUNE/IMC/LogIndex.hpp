@@ -0,0 +1,162 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_INDEX_HPP_INCLUDED_
+#define DUNE_IMC_LOG_INDEX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <string>
+#include <vector>
+#include <ostream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Compression/Methods.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogIndex;
+
+    //! Index of an LSF log, stored in a sidecar file next to the log
+    //! (Data.lsf.idx for Data.lsf and Data.lsf.gz). The log is
+    //! divided in blocks that start at offsets where reading can
+    //! begin: plain offsets of uncompressed logs or the start of a
+    //! compressed stream of compressed logs. The file layout is:
+    //!
+    //! - header: magic "LSFX", version (8 bit), compression method
+    //!   of the log (8 bit, Compression::Methods) and two reserved
+    //!   bytes.
+    //! - one entry per block: offset in the log (64 bit), offset of
+    //!   the first packet in the uncompressed block (32 bit), size of
+    //!   the uncompressed block (32 bit), time stamps of the first
+    //!   and last packets (64 bit floating point), number of message
+    //!   identifiers (16 bit) and pairs of message identifier (16
+    //!   bit) and packet count (32 bit).
+    //!
+    //! Entries are appended while the log is written, so the index
+    //! of an interrupted log covers the blocks written until then.
+    //! All integers are little endian.
+    class LogIndex
+    {
+    public:
+      //! Index entry of a block.
+      struct Entry
+      {
+        //! Offset of the block in the log.
+        uint64_t offset;
+        //! Offset of the first packet that starts in the block
+        //! (usize if no packet starts in the block).
+        uint32_t first;
+        //! Uncompressed size.
+        uint32_t usize;
+        //! Time stamp of the first packet.
+        fp64_t start;
+        //! Time stamp of the last packet.
+        fp64_t end;
+        //! Number of packets per message identifier.
+        std::map<uint16_t, uint32_t> counts;
+
+        Entry(void):
+          offset(0),
+          first(0),
+          usize(0),
+          start(0),
+          end(0)
+        { }
+
+        //! Record a packet starting in the block. Entries must have
+        //! their uncompressed size and first packet offset set to the
+        //! same value before the first packet is added.
+        //! @param[in] pos offset of the packet in the block.
+        //! @param[in] id message identifier.
+        //! @param[in] time packet time stamp.
+        void
+        add(uint32_t pos, uint16_t id, fp64_t time);
+
+        //! Count the packets of a message in the block.
+        //! @param[in] id message identifier.
+        //! @return number of packets.
+        uint32_t
+        count(uint16_t id) const
+        {
+          std::map<uint16_t, uint32_t>::const_iterator itr = counts.find(id);
+          return (itr == counts.end()) ? 0 : itr->second;
+        }
+      };
+
+      //! Load the index of a log.
+      //! @param[in] path path of the index file.
+      LogIndex(const std::string& path);
+
+      //! Get the compression method of the indexed log.
+      //! @return compression method.
+      Compression::Methods
+      getMethod(void) const
+      {
+        return m_method;
+      }
+
+      //! Get the index entries.
+      //! @return index entries.
+      const std::vector<Entry>&
+      getEntries(void) const
+      {
+        return m_entries;
+      }
+
+      //! Get the path of the index of a log.
+      //! @param[in] log path of the log.
+      //! @return path of the index.
+      static std::string
+      getPath(const std::string& log);
+
+      //! Write the header of an index.
+      //! @param[in] os output stream.
+      //! @param[in] method compression method of the log.
+      static void
+      writeHeader(std::ostream& os, Compression::Methods method);
+
+      //! Write an index entry.
+      //! @param[in] os output stream.
+      //! @param[in] entry index entry.
+      static void
+      writeEntry(std::ostream& os, const Entry& entry);
+
+    private:
+      //! Compression method of the indexed log.
+      Compression::Methods m_method;
+      //! Index entries.
+      std::vector<Entry> m_entries;
+    };
+  }
+}
+
+#endif
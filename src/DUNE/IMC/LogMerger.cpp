@@ -0,0 +1,268 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/IMC/LogMerger.hpp>
+#include <DUNE/IMC/LogReader.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    using Concurrency::ScopedCondition;
+
+    //! Thread reading one log ahead of the merge.
+    class LogMerger::Reader: public Concurrency::Thread
+    {
+    public:
+      Reader(const std::string& path, unsigned capacity):
+        m_path(path),
+        m_reader(path),
+        m_capacity(capacity),
+        m_done(false)
+      { }
+
+      ~Reader(void)
+      {
+        if (isCreated())
+          stopAndJoin();
+
+        for (unsigned i = 0; i < m_queue.size(); ++i)
+          delete m_queue[i];
+      }
+
+      //! Get the log reader, to be configured before starting.
+      LogReader&
+      get(void)
+      {
+        return m_reader;
+      }
+
+      //! Wait for the next message of the log.
+      //! @return message or NULL at the end of the log.
+      Message*
+      pop(void)
+      {
+        ScopedCondition l(m_cond);
+        while (m_queue.empty() && !m_done)
+          m_cond.wait();
+
+        if (m_queue.empty())
+        {
+          if (!m_error.empty())
+            throw std::runtime_error(m_path + ": " + m_error);
+          return NULL;
+        }
+
+        Message* msg = m_queue.front();
+        m_queue.pop_front();
+        m_cond.signal();
+        return msg;
+      }
+
+    private:
+      //! Path of the log.
+      std::string m_path;
+      //! Log reader.
+      LogReader m_reader;
+      //! Maximum number of messages read ahead.
+      unsigned m_capacity;
+      //! Messages read ahead.
+      std::deque<Message*> m_queue;
+      //! True if the end of the log was reached.
+      bool m_done;
+      //! Read error, if any.
+      std::string m_error;
+      //! Condition protecting the queue.
+      Concurrency::Condition m_cond;
+
+      void
+      run(void)
+      {
+        try
+        {
+          while (!isStopping())
+          {
+            Message* msg = m_reader.read();
+            if (msg == NULL)
+              break;
+
+            ScopedCondition l(m_cond);
+            // Timed waits notice requests to stop.
+            while (m_queue.size() >= m_capacity && !isStopping())
+              m_cond.wait(0.1);
+
+            m_queue.push_back(msg);
+            m_cond.signal();
+          }
+        }
+        catch (std::exception& e)
+        {
+          ScopedCondition l(m_cond);
+          m_error = e.what();
+        }
+
+        ScopedCondition l(m_cond);
+        m_done = true;
+        m_cond.signal();
+      }
+    };
+
+    //! Order of logs in the heap: earliest next message first, ties
+    //! broken by order of addition.
+    struct LaterHead
+    {
+      const std::vector<Message*>& heads;
+
+      LaterHead(const std::vector<Message*>& h):
+        heads(h)
+      { }
+
+      bool
+      operator()(unsigned a, unsigned b) const
+      {
+        double ta = heads[a]->getTimeStamp();
+        double tb = heads[b]->getTimeStamp();
+        return ta > tb || (ta == tb && a > b);
+      }
+    };
+
+    LogMerger::LogMerger(unsigned capacity):
+      m_capacity(std::max(capacity, 1u)),
+      m_begin(-1),
+      m_end(-1),
+      m_started(false),
+      m_last(0)
+    { }
+
+    LogMerger::~LogMerger(void)
+    {
+      for (unsigned i = 0; i < m_readers.size(); ++i)
+        delete m_readers[i];
+
+      for (unsigned i = 0; i < m_heads.size(); ++i)
+        delete m_heads[i];
+    }
+
+    void
+    LogMerger::add(const std::string& path)
+    {
+      if (m_started)
+        throw std::runtime_error("log added after reading started");
+
+      m_readers.push_back(new Reader(path, m_capacity));
+      m_paths.push_back(path);
+      m_heads.push_back(NULL);
+    }
+
+    void
+    LogMerger::setFilter(const std::set<uint16_t>& ids)
+    {
+      m_filter = ids;
+    }
+
+    void
+    LogMerger::setTimeRange(fp64_t begin, fp64_t end)
+    {
+      m_begin = begin;
+      m_end = end;
+    }
+
+    fp64_t
+    LogMerger::getStartTime(void) const
+    {
+      fp64_t start = -1;
+      for (unsigned i = 0; i < m_paths.size(); ++i)
+      {
+        LogReader probe(m_paths[i]);
+        Message* msg = probe.read();
+        if (msg == NULL)
+          continue;
+
+        if (start < 0 || msg->getTimeStamp() < start)
+          start = msg->getTimeStamp();
+        delete msg;
+      }
+
+      return start;
+    }
+
+    void
+    LogMerger::start(void)
+    {
+      m_started = true;
+
+      for (unsigned i = 0; i < m_readers.size(); ++i)
+      {
+        m_readers[i]->get().setFilter(m_filter);
+        m_readers[i]->get().setTimeRange(m_begin, m_end);
+        m_readers[i]->start();
+      }
+
+      for (unsigned i = 0; i < m_readers.size(); ++i)
+        fetch(i);
+    }
+
+    void
+    LogMerger::fetch(unsigned log)
+    {
+      m_heads[log] = m_readers[log]->pop();
+      if (m_heads[log] == NULL)
+        return;
+
+      m_heap.push_back(log);
+      std::push_heap(m_heap.begin(), m_heap.end(), LaterHead(m_heads));
+    }
+
+    Message*
+    LogMerger::read(void)
+    {
+      if (!m_started)
+        start();
+
+      if (m_heap.empty())
+        return NULL;
+
+      std::pop_heap(m_heap.begin(), m_heap.end(), LaterHead(m_heads));
+      m_last = m_heap.back();
+      m_heap.pop_back();
+
+      Message* msg = m_heads[m_last];
+      m_heads[m_last] = NULL;
+      fetch(m_last);
+      return msg;
+    }
+  }
+}
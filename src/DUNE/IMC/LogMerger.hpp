@@ -0,0 +1,138 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_MERGER_HPP_INCLUDED_
+#define DUNE_IMC_LOG_MERGER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogMerger;
+
+    //! Reads several logs at once, e.g., of vehicles operating
+    //! together, as one stream of messages ordered by time stamp.
+    //! Each log is read and decompressed by its own thread, a bounded
+    //! number of messages ahead of the merge, and filters are applied
+    //! by the log readers, so indexed logs are sought directly to the
+    //! requested time range (see LogReader).
+    class LogMerger
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity maximum number of messages read ahead
+      //! of the merge per log.
+      LogMerger(unsigned capacity = 1024);
+
+      //! Destructor.
+      ~LogMerger(void);
+
+      //! Add a log. Must be called before reading.
+      //! @param[in] path path of the log.
+      void
+      add(const std::string& path);
+
+      //! Only read messages with the given identifiers. Must be called
+      //! before reading.
+      //! @param[in] ids message identifiers (empty for all messages).
+      void
+      setFilter(const std::set<uint16_t>& ids);
+
+      //! Only read messages in a time range. Must be called before
+      //! reading.
+      //! @param[in] begin first time stamp (negative for no limit).
+      //! @param[in] end last time stamp (negative for no limit).
+      void
+      setTimeRange(fp64_t begin, fp64_t end);
+
+      //! Get the earliest time stamp of all logs, ignoring filters.
+      //! @return time stamp or -1 if all logs are empty.
+      fp64_t
+      getStartTime(void) const;
+
+      //! Read the next message. Messages with the same time stamp are
+      //! returned in the order the logs were added. Reading starts the
+      //! reader threads.
+      //! @return message (to be deleted by the caller) or NULL at
+      //! the end of all logs.
+      Message*
+      read(void);
+
+      //! Get the index of the log of the last message read.
+      //! @return index, by order of addition.
+      unsigned
+      getLog(void) const
+      {
+        return m_last;
+      }
+
+    private:
+      class Reader;
+
+      //! Paths of the logs.
+      std::vector<std::string> m_paths;
+      //! Log readers.
+      std::vector<Reader*> m_readers;
+      //! Next message of each log.
+      std::vector<Message*> m_heads;
+      //! Logs ordered by time stamp of their next message.
+      std::vector<unsigned> m_heap;
+      //! Maximum number of messages read ahead per log.
+      unsigned m_capacity;
+      //! Message filter.
+      std::set<uint16_t> m_filter;
+      //! Time range.
+      fp64_t m_begin;
+      fp64_t m_end;
+      //! True if reading started.
+      bool m_started;
+      //! Log of the last message read.
+      unsigned m_last;
+
+      //! Start the reader threads and fill the heap.
+      void
+      start(void);
+
+      //! Fetch the next message of a log into the heap.
+      //! @param[in] log log index.
+      void
+      fetch(unsigned log);
+    };
+  }
+}
+
+#endif
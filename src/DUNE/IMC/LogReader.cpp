@@ -0,0 +1,523 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Memory.hpp>
+#include <DUNE/FileSystem/Path.hpp>
+#include <DUNE/Compression/Factory.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/LogReader.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+#  include <sys/mman.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    Message*
+    LogReader::Record::decode(void) const
+    {
+      return Packet::deserializePayload(m_hdr, m_data, m_size, NULL);
+    }
+
+    void
+    LogReader::Record::decode(Message& msg) const
+    {
+      Packet::deserializePayload(m_hdr, m_data, m_size, &msg);
+    }
+
+    LogReader::LogReader(const std::string& path):
+      m_fin(NULL),
+      m_ifs(NULL),
+      m_is(NULL),
+      m_map(NULL),
+      m_map_size(0),
+      m_map_pos(0),
+      m_blog(NULL),
+      m_block_pos(0),
+      m_block_next(0),
+      m_index(NULL),
+      m_started(false),
+      m_tail(false),
+      m_finished(false),
+      m_range_begin(0),
+      m_range_end(UINT_MAX),
+      m_entry(0),
+      m_pos(0)
+    {
+      // Block logs carry their own index.
+      if (BlockLog::detect(path))
+      {
+        m_blog = new BlockLog(path);
+        return;
+      }
+
+      Compression::Methods method = Compression::Factory::detect(path.c_str());
+      if (method == Compression::METHOD_UNKNOWN)
+      {
+        if (!map(path))
+          m_is = m_ifs = new std::ifstream(path.c_str(), std::ios::binary);
+      }
+      else
+      {
+        m_is = m_fin = new Compression::FileInput(path.c_str(), method);
+      }
+
+      std::string idx = LogIndex::getPath(path);
+      if (!FileSystem::Path(idx).isFile())
+        return;
+
+      try
+      {
+        // Indexes of logs with the same name and another compression
+        // method share the index path.
+        m_index = new LogIndex(idx);
+        if (m_index->getEntries().empty() || m_index->getMethod() != method)
+          Memory::clear(m_index);
+      }
+      catch (std::exception& e)
+      {
+        (void)e;
+        Memory::clear(m_index);
+      }
+    }
+
+    LogReader::~LogReader(void)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (m_map != NULL)
+        munmap((void*)m_map, m_map_size);
+#endif
+
+      delete m_index;
+      delete m_blog;
+      delete m_fin;
+      delete m_ifs;
+    }
+
+    bool
+    LogReader::map(const std::string& path)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      uint64_t size = FileSystem::Path(path).size();
+      if (size == 0 || size != (uint64_t)(size_t)size)
+        return false;
+
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+
+      void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+
+      if (ptr == MAP_FAILED)
+        return false;
+
+#  if defined(MADV_SEQUENTIAL)
+      madvise(ptr, size, MADV_SEQUENTIAL);
+#  endif
+
+      m_map = (const uint8_t*)ptr;
+      m_map_size = size;
+      return true;
+#else
+      (void)path;
+      return false;
+#endif
+    }
+
+    unsigned
+    LogReader::getBlockCount(void) const
+    {
+      if (m_index != NULL)
+        return m_index->getEntries().size();
+
+      if (m_blog != NULL && m_blog->isIndexed())
+        return m_blog->getIndex().size();
+
+      return 0;
+    }
+
+    void
+    LogReader::select(void)
+    {
+      const std::set<uint16_t>& ids = m_filter.getIds();
+
+      if (m_index != NULL)
+      {
+        const std::vector<LogIndex::Entry>& entries = m_index->getEntries();
+        m_spans.resize(entries.size());
+
+        for (unsigned i = 0; i < entries.size(); ++i)
+        {
+          const LogIndex::Entry& e = entries[i];
+          Span& s = m_spans[i];
+          s.offset = e.offset;
+          s.first = e.first;
+          s.usize = e.usize;
+          s.selected = (e.first != e.usize) && m_filter.overlaps(e.start, e.end);
+
+          if (s.selected && !ids.empty())
+          {
+            s.selected = false;
+            std::set<uint16_t>::const_iterator itr = ids.begin();
+            for (; itr != ids.end() && !s.selected; ++itr)
+              s.selected = e.count(*itr) > 0;
+          }
+        }
+      }
+      else if (m_blog != NULL && m_blog->isIndexed())
+      {
+        const std::vector<BlockLog::Entry>& entries = m_blog->getIndex();
+        m_spans.resize(entries.size());
+
+        for (unsigned i = 0; i < entries.size(); ++i)
+        {
+          const BlockLog::Entry& e = entries[i];
+          Span& s = m_spans[i];
+          s.offset = i;
+          s.first = e.first;
+          s.usize = e.usize;
+          s.selected = (e.first != e.usize) && m_filter.overlaps(e.start, e.end);
+
+          if (s.selected && !ids.empty())
+          {
+            s.selected = false;
+            std::set<uint16_t>::const_iterator itr = ids.begin();
+            for (; itr != ids.end() && !s.selected; ++itr)
+              s.selected = e.contains(*itr);
+          }
+        }
+      }
+
+      for (unsigned i = 0; i < m_spans.size(); ++i)
+      {
+        if (i < m_range_begin || i >= m_range_end)
+          m_spans[i].selected = false;
+      }
+    }
+
+    bool
+    LogReader::loadBlock(void)
+    {
+      if (m_block_next >= m_blog->getIndex().size())
+        return false;
+
+      m_blog->read(m_block_next++, m_block);
+      m_block_pos = 0;
+      return true;
+    }
+
+    const uint8_t*
+    LogReader::view(uint32_t size)
+    {
+      if (m_map != NULL)
+      {
+        if (m_map_size - m_map_pos < size)
+          return NULL;
+        return m_map + m_map_pos;
+      }
+
+      if (m_blog != NULL)
+      {
+        if (m_block_pos == m_block.getSize())
+          loadBlock();
+        if (m_block.getSize() - m_block_pos < size)
+          return NULL;
+        return m_block.getBuffer() + m_block_pos;
+      }
+
+      return NULL;
+    }
+
+    uint32_t
+    LogReader::pull(uint8_t* data, uint32_t size)
+    {
+      if (m_map != NULL)
+      {
+        uint32_t len = (uint32_t)std::min((uint64_t)size, m_map_size - m_map_pos);
+        std::memcpy(data, m_map + m_map_pos, len);
+        m_map_pos += len;
+        return len;
+      }
+
+      if (m_blog != NULL)
+      {
+        uint32_t done = 0;
+        while (done < size)
+        {
+          if (m_block_pos == m_block.getSize() && !loadBlock())
+            break;
+
+          uint32_t len = std::min(size - done, m_block.getSize() - m_block_pos);
+          std::memcpy(data + done, m_block.getBuffer() + m_block_pos, len);
+          m_block_pos += len;
+          done += len;
+        }
+
+        return done;
+      }
+
+      m_is->read((char*)data, size);
+      // Compressed streams report a negative count at the end.
+      std::streamsize rv = m_is->gcount();
+      return (rv <= 0) ? 0 : (uint32_t)rv;
+    }
+
+    bool
+    LogReader::skip(uint64_t size)
+    {
+      if (m_map != NULL)
+      {
+        if (m_map_size - m_map_pos < size)
+        {
+          m_map_pos = m_map_size;
+          return false;
+        }
+
+        m_map_pos += size;
+        return true;
+      }
+
+      if (m_blog != NULL)
+      {
+        while (size > 0)
+        {
+          if (m_block_pos == m_block.getSize() && !loadBlock())
+            return false;
+
+          uint32_t len = (uint32_t)std::min(size, (uint64_t)(m_block.getSize() - m_block_pos));
+          m_block_pos += len;
+          size -= len;
+        }
+
+        return true;
+      }
+
+      if (m_ifs != NULL)
+      {
+        m_ifs->seekg(size, std::ios::cur);
+        return m_ifs->good();
+      }
+
+      while (size > 0)
+      {
+        uint32_t len = (uint32_t)std::min(size, (uint64_t)(64 * 1024));
+        m_bfr.setSize(len);
+        m_is->read(m_bfr.getBufferSigned(), len);
+        if ((uint32_t)m_is->gcount() != len)
+          return false;
+        size -= len;
+      }
+
+      return true;
+    }
+
+    bool
+    LogReader::position(const Span& span, uint64_t pos)
+    {
+      if (m_map != NULL)
+      {
+        m_map_pos = std::min(span.offset + pos, m_map_size);
+        return span.offset + pos <= m_map_size;
+      }
+
+      if (m_blog != NULL)
+      {
+        m_block_next = (unsigned)span.offset;
+
+        // Nothing to decompress past the end of the block.
+        if (pos >= span.usize)
+        {
+          ++m_block_next;
+          m_block.setSize(0);
+          m_block_pos = 0;
+          return true;
+        }
+
+        if (!loadBlock() || pos > m_block.getSize())
+          return false;
+
+        m_block_pos = (uint32_t)pos;
+        return true;
+      }
+
+      if (m_ifs != NULL)
+      {
+        m_ifs->clear();
+        m_ifs->seekg(span.offset + pos);
+        return m_ifs->good();
+      }
+
+      m_fin->seek(span.offset);
+      return skip(pos);
+    }
+
+    void
+    LogReader::seek(unsigned from)
+    {
+      unsigned i = from;
+      while (i < m_spans.size() && !m_spans[i].selected)
+        ++i;
+
+      // Past the last entry, read the rest of the log (not yet
+      // indexed when the log was interrupted).
+      bool tail = (i == m_spans.size());
+      if (tail)
+      {
+        // The tail belongs to the last block range.
+        if (m_range_end < m_spans.size())
+        {
+          m_finished = true;
+          return;
+        }
+
+        i = m_spans.size() - 1;
+      }
+
+      const Span& s = m_spans[i];
+      m_entry = i;
+      m_tail = tail;
+      m_pos = tail ? s.usize : s.first;
+
+      if (!position(s, m_pos))
+        m_tail = true;
+    }
+
+    const LogReader::Record*
+    LogReader::next(void)
+    {
+      if (!m_started)
+      {
+        m_started = true;
+        select();
+        if (!m_spans.empty())
+          seek(0);
+      }
+
+      if (m_finished)
+        return NULL;
+
+      while (true)
+      {
+        while (!m_spans.empty() && !m_tail && m_pos >= m_spans[m_entry].usize)
+        {
+          unsigned next = m_entry + 1;
+          if (next < m_spans.size() && m_spans[next].selected)
+          {
+            m_pos -= m_spans[m_entry].usize;
+            m_entry = next;
+          }
+          else
+          {
+            seek(next);
+            if (m_finished)
+              return NULL;
+          }
+        }
+
+        // Packets are used in place when the whole packet is
+        // available, otherwise they are copied to the packet buffer.
+        const uint8_t* data = view(DUNE_IMC_CONST_HEADER_SIZE);
+        bool copied = (data == NULL);
+        if (copied)
+        {
+          m_bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE);
+          uint32_t rv = pull(m_bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE);
+          if (rv == 0)
+            return NULL;
+
+          if (rv < DUNE_IMC_CONST_HEADER_SIZE)
+            throw BufferTooShort();
+
+          data = m_bfr.getBuffer();
+        }
+
+        Header& hdr = m_record.m_hdr;
+        Packet::deserializeHeader(hdr, data, DUNE_IMC_CONST_HEADER_SIZE);
+
+        uint32_t size = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+        uint32_t remaining = copied ? size - DUNE_IMC_CONST_HEADER_SIZE : size;
+        m_pos += size;
+
+        if (!m_filter.matches(hdr))
+        {
+          if (!skip(remaining))
+            return NULL;
+          continue;
+        }
+
+        if (!copied)
+        {
+          data = view(size);
+          if (data != NULL)
+          {
+            skip(size);
+            m_record.m_data = data;
+            m_record.m_size = size;
+            return &m_record;
+          }
+        }
+
+        m_bfr.setSize(size);
+        if (pull(m_bfr.getBuffer() + size - remaining, remaining) < remaining)
+          throw BufferTooShort();
+
+        m_record.m_data = m_bfr.getBuffer();
+        m_record.m_size = size;
+        return &m_record;
+      }
+    }
+
+    Message*
+    LogReader::read(void)
+    {
+      const Record* record = next();
+      if (record == NULL)
+        return NULL;
+
+      return record->decode();
+    }
+  }
+}
@@ -0,0 +1,376 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_LOG_READER_HPP_INCLUDED_
+#define DUNE_IMC_LOG_READER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <set>
+#include <vector>
+#include <string>
+#include <istream>
+#include <fstream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+#include <DUNE/Compression/FileInput.hpp>
+#include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/PacketFilter.hpp>
+#include <DUNE/IMC/LogIndex.hpp>
+#include <DUNE/IMC/BlockLog.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM LogReader;
+
+    //! Reader of plain, compressed and block LSF logs. Plain logs
+    //! are memory mapped when the platform allows it. Packets are
+    //! iterated by header: messages can be filtered by identifier,
+    //! source, destination and time (see PacketFilter), packets
+    //! that do not match are skipped without
+    //! deserializing their payload, and payloads of matching packets
+    //! are only deserialized on demand. When the log has an index
+    //! (see LogIndex and BlockLog), blocks without matching packets
+    //! are not read at all.
+    class LogReader
+    {
+    public:
+      //! Packet of a log.
+      class Record
+      {
+      public:
+        Record(void):
+          m_data(NULL),
+          m_size(0)
+        { }
+
+        //! Get the packet header.
+        //! @return packet header.
+        const Header&
+        getHeader(void) const
+        {
+          return m_hdr;
+        }
+
+        //! Get the message identifier.
+        //! @return message identifier.
+        uint16_t
+        getId(void) const
+        {
+          return m_hdr.mgid;
+        }
+
+        //! Get the time stamp.
+        //! @return time stamp.
+        fp64_t
+        getTimeStamp(void) const
+        {
+          return m_hdr.timestamp;
+        }
+
+        //! Get the source address.
+        //! @return source address.
+        uint16_t
+        getSource(void) const
+        {
+          return m_hdr.src;
+        }
+
+        //! Get the source entity.
+        //! @return source entity.
+        uint8_t
+        getSourceEntity(void) const
+        {
+          return m_hdr.src_ent;
+        }
+
+        //! Get the destination address.
+        //! @return destination address.
+        uint16_t
+        getDestination(void) const
+        {
+          return m_hdr.dst;
+        }
+
+        //! Get the destination entity.
+        //! @return destination entity.
+        uint8_t
+        getDestinationEntity(void) const
+        {
+          return m_hdr.dst_ent;
+        }
+
+        //! Get the serialized packet, including header and footer.
+        //! @return packet data.
+        const uint8_t*
+        getData(void) const
+        {
+          return m_data;
+        }
+
+        //! Get the size of the serialized packet.
+        //! @return packet size.
+        uint32_t
+        getSize(void) const
+        {
+          return m_size;
+        }
+
+        //! Deserialize the message.
+        //! @return message (to be deleted by the caller).
+        Message*
+        decode(void) const;
+
+        //! Deserialize the message into an existing object.
+        //! @param[out] msg message of the same type as the packet.
+        void
+        decode(Message& msg) const;
+
+      private:
+        //! Packet header.
+        Header m_hdr;
+        //! Packet data.
+        const uint8_t* m_data;
+        //! Packet size.
+        uint32_t m_size;
+
+        friend class LogReader;
+      };
+
+      //! Open a log.
+      //! @param[in] path path of the log.
+      LogReader(const std::string& path);
+
+      ~LogReader(void);
+
+      //! Test if the log is memory mapped.
+      //! @return true if the log is memory mapped, false otherwise.
+      bool
+      isMapped(void) const
+      {
+        return m_map != NULL;
+      }
+
+      //! Test if a log index is used.
+      //! @return true if a log index is used, false otherwise.
+      bool
+      isIndexed(void) const
+      {
+        return m_index != NULL || (m_blog != NULL && m_blog->isIndexed());
+      }
+
+      //! Get the log index.
+      //! @return log index or NULL if the log has no separate index.
+      const LogIndex*
+      getIndex(void) const
+      {
+        return m_index;
+      }
+
+      //! Only read packets that match a filter. Must be called
+      //! before reading.
+      //! @param[in] filter packet filter.
+      void
+      setFilter(const PacketFilter& filter)
+      {
+        m_filter = filter;
+      }
+
+      //! Only read some messages. Must be called before reading.
+      //! @param[in] ids message identifiers (empty to read all).
+      void
+      setFilter(const std::set<uint16_t>& ids)
+      {
+        m_filter.setIds(ids);
+      }
+
+      //! Only read messages from some systems. Must be called before
+      //! reading.
+      //! @param[in] sources source addresses (empty to read all).
+      void
+      setSourceFilter(const std::set<uint16_t>& sources)
+      {
+        m_filter.setSources(sources);
+      }
+
+      //! Only read messages within a time range. Must be called
+      //! before reading.
+      //! @param[in] begin first time stamp.
+      //! @param[in] end last time stamp (negative for no limit).
+      void
+      setTimeRange(fp64_t begin, fp64_t end)
+      {
+        m_filter.setTimeRange(begin, end);
+      }
+
+      //! Get the number of indexed blocks. Blocks can be read
+      //! separately, for example by several readers of the same log.
+      //! @return number of indexed blocks, 0 if the log has no index.
+      unsigned
+      getBlockCount(void) const;
+
+      //! Only read packets that start in a range of indexed blocks.
+      //! The last range (ending at getBlockCount()) also holds the
+      //! packets past the last indexed block. Must be called before
+      //! reading.
+      //! @param[in] begin first block.
+      //! @param[in] end block past the last block.
+      void
+      setBlockRange(unsigned begin, unsigned end)
+      {
+        m_range_begin = begin;
+        m_range_end = end;
+      }
+
+      //! Read the next packet that matches the filters.
+      //! @return packet or NULL at the end of the log. The packet is
+      //! only valid until the next call.
+      const Record*
+      next(void);
+
+      //! Read and deserialize the next message that matches the
+      //! filters.
+      //! @return message (to be deleted by the caller) or NULL at
+      //! the end of the log.
+      Message*
+      read(void);
+
+    private:
+      //! Span of packet data described by an index entry.
+      struct Span
+      {
+        //! Offset of the data in the log, or block number.
+        uint64_t offset;
+        //! Offset of the first packet.
+        uint32_t first;
+        //! Size of the data.
+        uint32_t usize;
+        //! True if the span has packets that must be read.
+        bool selected;
+      };
+
+      //! Compressed log.
+      Compression::FileInput* m_fin;
+      //! Uncompressed log.
+      std::ifstream* m_ifs;
+      //! Log stream.
+      std::istream* m_is;
+      //! Memory mapped log.
+      const uint8_t* m_map;
+      //! Size of the memory mapped log.
+      uint64_t m_map_size;
+      //! Offset in the memory mapped log.
+      uint64_t m_map_pos;
+      //! Block log.
+      BlockLog* m_blog;
+      //! Data of the current block.
+      Utils::ByteBuffer m_block;
+      //! Offset in the current block.
+      uint32_t m_block_pos;
+      //! Next block to read.
+      unsigned m_block_next;
+      //! Log index.
+      LogIndex* m_index;
+      //! Index entries.
+      std::vector<Span> m_spans;
+      //! True if reading started.
+      bool m_started;
+      //! True if reading past the last index entry.
+      bool m_tail;
+      //! True if the end of the block range was reached.
+      bool m_finished;
+      //! First index entry to read.
+      unsigned m_range_begin;
+      //! Index entry past the last entry to read.
+      unsigned m_range_end;
+      //! Current index entry.
+      unsigned m_entry;
+      //! Offset in the uncompressed data of the current entry.
+      uint64_t m_pos;
+      //! Packets to read.
+      PacketFilter m_filter;
+      //! Current packet.
+      Record m_record;
+      //! Packet buffer.
+      Utils::ByteBuffer m_bfr;
+
+      //! Map a plain log to memory.
+      //! @param[in] path path of the log.
+      //! @return true if the log was mapped, false otherwise.
+      bool
+      map(const std::string& path);
+
+      //! Build the list of index entries.
+      void
+      select(void);
+
+      //! Move to the next index entry that must be read, or to the
+      //! data past the last entry.
+      //! @param[in] from first candidate entry.
+      void
+      seek(unsigned from);
+
+      //! Move to a position in the data of an index entry.
+      //! @param[in] span index entry.
+      //! @param[in] pos offset in the data of the entry.
+      //! @return true if the position exists, false otherwise.
+      bool
+      position(const Span& span, uint64_t pos);
+
+      //! Read the next block of a block log.
+      //! @return true if a block was read, false at the end of the log.
+      bool
+      loadBlock(void);
+
+      //! Get data at the current position without copying it.
+      //! @param[in] size amount of data.
+      //! @return data or NULL if not available in place.
+      const uint8_t*
+      view(uint32_t size);
+
+      //! Copy data at the current position.
+      //! @param[out] data destination.
+      //! @param[in] size amount of data.
+      //! @return amount of data copied.
+      uint32_t
+      pull(uint8_t* data, uint32_t size);
+
+      //! Read and discard data.
+      //! @param[in] size amount of data.
+      //! @return true if the data was read, false otherwise.
+      bool
+      skip(uint64_t size);
+    };
+  }
+}
+
+#endif
@@ -62,6 +62,14 @@
 #define DUNE_IMC_QUERYENTITYACTIVATIONSTATE 15
 //! VehicleOperationalLimits identification number.
 #define DUNE_IMC_VEHICLEOPERATIONALLIMITS 16
+//! DeliveryStatistics identification number.
+#define DUNE_IMC_DELIVERYSTATISTICS 17
+//! MailboxStatistics identification number.
+#define DUNE_IMC_MAILBOXSTATISTICS 18
+//! TraceHop identification number.
+#define DUNE_IMC_TRACEHOP 19
+//! HeapUsage identification number.
+#define DUNE_IMC_HEAPUSAGE 20
 //! SimulatedState identification number.
 #define DUNE_IMC_SIMULATEDSTATE 50
 //! LeakSimulation identification number.
@@ -84,6 +92,20 @@
 #define DUNE_IMC_REPLAYCONTROL 105
 //! ClockControl identification number.
 #define DUNE_IMC_CLOCKCONTROL 106
+//! LogTransferRequest identification number.
+#define DUNE_IMC_LOGTRANSFERREQUEST 107
+//! LogTransferChunk identification number.
+#define DUNE_IMC_LOGTRANSFERCHUNK 108
+//! LogTransferState identification number.
+#define DUNE_IMC_LOGTRANSFERSTATE 109
+//! FlightRecorderControl identification number.
+#define DUNE_IMC_FLIGHTRECORDERCONTROL 110
+//! TaskControl identification number.
+#define DUNE_IMC_TASKCONTROL 111
+//! TimeSeriesQuery identification number.
+#define DUNE_IMC_TIMESERIESQUERY 112
+//! TimeSeriesReply identification number.
+#define DUNE_IMC_TIMESERIESREPLY 113
 //! Heartbeat identification number.
 #define DUNE_IMC_HEARTBEAT 150
 //! Announce identification number.
@@ -214,6 +236,8 @@
 #define DUNE_IMC_BEAMCONFIG 283
 //! DataSanity identification number.
 #define DUNE_IMC_DATASANITY 284
+//! PointCloud identification number.
+#define DUNE_IMC_POINTCLOUD 285
 //! CameraZoom identification number.
 #define DUNE_IMC_CAMERAZOOM 300
 //! SetThrusterActuation identification number.
@@ -364,6 +388,14 @@
 #define DUNE_IMC_REFERENCE 479
 //! FollowRefState identification number.
 #define DUNE_IMC_FOLLOWREFSTATE 480
+//! FormationEval identification number.
+#define DUNE_IMC_FORMATIONEVAL 481
+//! RelativeState identification number.
+#define DUNE_IMC_RELATIVESTATE 482
+//! TrajectorySegment identification number.
+#define DUNE_IMC_TRAJECTORYSEGMENT 483
+//! TrajectoryBufferState identification number.
+#define DUNE_IMC_TRAJECTORYBUFFERSTATE 484
 //! VehicleState identification number.
 #define DUNE_IMC_VEHICLESTATE 500
 //! VehicleCommand identification number.
@@ -404,6 +436,8 @@
 #define DUNE_IMC_PLANDBSTATE 557
 //! PlanDBInformation identification number.
 #define DUNE_IMC_PLANDBINFORMATION 558
+//! PlanDBBulk identification number.
+#define DUNE_IMC_PLANDBBULK 564
 //! PlanControl identification number.
 #define DUNE_IMC_PLANCONTROL 559
 //! PlanControlState identification number.
@@ -448,6 +482,10 @@
 #define DUNE_IMC_COMPRESSEDIMAGE 702
 //! ImageTxSettings identification number.
 #define DUNE_IMC_IMAGETXSETTINGS 703
+//! ImagePipelineStatistics identification number.
+#define DUNE_IMC_IMAGEPIPELINESTATISTICS 704
+//! CompressedVideo identification number.
+#define DUNE_IMC_COMPRESSEDVIDEO 705
 //! RemoteState identification number.
 #define DUNE_IMC_REMOTESTATE 750
 //! Target identification number.
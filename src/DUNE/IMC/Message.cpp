@@ -79,5 +79,20 @@ namespace DUNE
       fieldsToJSON(os, c_nindent);
       os << "\n}\n";
     }
+
+    void
+    Message::toJSON(Utils::ByteBuffer& bfr) const
+    {
+      const char* name = getName();
+      bfr.appendSigned("{\"abbrev\":", 10);
+      writeJSONString(bfr, name, std::strlen(name));
+      IMC::toJSON(bfr, "timestamp", getTimeStamp());
+      IMC::toJSON(bfr, "src", getSource());
+      IMC::toJSON(bfr, "src_ent", getSourceEntity());
+      IMC::toJSON(bfr, "dst", getDestination());
+      IMC::toJSON(bfr, "dst_ent", getDestinationEntity());
+      fieldsToJSON(bfr);
+      bfr.appendSigned("}", 1);
+    }
   }
 }
@@ -28,13 +28,19 @@
 #ifndef DUNE_IMC_MESSAGE_HPP_INCLUDED_
 #define DUNE_IMC_MESSAGE_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/IMC/Constants.hpp>
 #include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/MessagePool.hpp>
 #include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/ScatterPacket.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
+#include <DUNE/IMC/JSON.hpp>
 
 namespace DUNE
 {
@@ -48,20 +54,78 @@ namespace DUNE
     class Message
     {
     public:
+      //! Causal trace of a message. Traces are kept in memory only,
+      //! they are not serialized.
+      struct Trace
+      {
+        //! Trace identifier, zero if the message is not traced.
+        uint32_t id;
+        //! Identification number of the message that started the trace.
+        uint16_t origin;
+        //! Time at which the origin message was dispatched (monotonic
+        //! clock).
+        double time;
+      };
+
       //! Default constructor.
-      Message(void)
+      Message(void):
+        m_wire(NULL),
+        m_wire_cache(false)
       {
         m_header.src = AddressResolver::invalid();
         m_header.src_ent = DUNE_IMC_CONST_UNK_EID;
         m_header.dst = AddressResolver::invalid();
         m_header.dst_ent = DUNE_IMC_CONST_UNK_EID;
         m_header.timestamp = -1.0;
+        clearTrace();
       }
 
+      //! Copy constructor. The serialized form is not copied.
+      //! @param[in] other message to copy.
+      Message(const Message& other):
+        m_header(other.m_header),
+        m_trace(other.m_trace),
+        m_wire(NULL),
+        m_wire_cache(false)
+      { }
+
       //! Default destructor.
       virtual
       ~Message(void)
-      { }
+      {
+        delete [] m_wire;
+      }
+
+      //! Assignment operator. The serialized form of this message
+      //! is discarded and caching is kept as it was.
+      //! @param[in] other message to copy.
+      //! @return this message.
+      Message&
+      operator=(const Message& other)
+      {
+        m_header = other.m_header;
+        m_trace = other.m_trace;
+        clearSerializationCache();
+        return *this;
+      }
+
+      //! Allocate storage for a message from the message pool.
+      //! @param size size of the message in bytes.
+      //! @return pointer to storage.
+      static void*
+      operator new(std::size_t size)
+      {
+        return MessagePool::allocate(size);
+      }
+
+      //! Return the storage of a message to the message pool.
+      //! @param ptr pointer to storage.
+      //! @param size size of the message in bytes.
+      static void
+      operator delete(void* ptr, std::size_t size)
+      {
+        MessagePool::release(ptr, size);
+      }
 
       //! Retrieve a copy of the message.
       //! @return message copy.
@@ -184,6 +248,31 @@ namespace DUNE
         setDestinationEntityNested(dst_ent);
       }
 
+      //! Get the message's trace.
+      //! @return trace.
+      const Trace&
+      getTrace(void) const
+      {
+        return m_trace;
+      }
+
+      //! Set the message's trace.
+      //! @param trace trace.
+      void
+      setTrace(const Trace& trace)
+      {
+        m_trace = trace;
+      }
+
+      //! Mark the message as not traced.
+      void
+      clearTrace(void)
+      {
+        m_trace.id = 0;
+        m_trace.origin = 0;
+        m_trace.time = 0;
+      }
+
       //! Retrieve message's sub identification number (id field).
       //! @return message's sub identification number.
       virtual uint16_t
@@ -261,6 +350,11 @@ namespace DUNE
       void
       toJSON(std::ostream& os) const;
 
+      //! Append the message in compact JSON format to a buffer.
+      //! @param bfr buffer.
+      void
+      toJSON(Utils::ByteBuffer& bfr) const;
+
       //! Output the message in human readable text.
       //! @param os output stream.
       void
@@ -272,6 +366,15 @@ namespace DUNE
       virtual uint8_t*
       serializeFields(uint8_t* bfr) const = 0;
 
+      //! Serialize message fields as segments of a packet. Messages
+      //! with large data fields reference them instead of copying.
+      //! @param packet destination packet.
+      virtual void
+      scatterFields(ScatterPacket& packet) const
+      {
+        serializeFields(packet.grow(getPayloadSerializationSize()));
+      }
+
       //! Deserialize message fields from a packet.
       //! @param bfr stream of bytes (packet)
       //! @param len length of the byte stream.
@@ -296,6 +399,46 @@ namespace DUNE
         (void)indent_level;
       }
 
+      //! Append the message fields (excluding header) in compact JSON
+      //! format to a buffer.
+      //! @param bfr buffer.
+      virtual void
+      fieldsToJSON(Utils::ByteBuffer& bfr) const
+      {
+        (void)bfr;
+      }
+
+      //! Decode one message field from JSON.
+      //! @param label field name.
+      //! @param reader JSON reader positioned at the field value.
+      //! @return true if the field exists, false otherwise.
+      virtual bool
+      fieldFromJSON(const char* label, JSONReader& reader)
+      {
+        (void)label;
+        (void)reader;
+        return false;
+      }
+
+      //! Allow the serialized form of the message to be computed by
+      //! the first serialization and copied by the following ones.
+      //! Only messages that are no longer modified may be cached,
+      //! such as the messages shared by the message bus.
+      void
+      enableSerializationCache(void)
+      {
+        m_wire_cache = true;
+      }
+
+      //! Discard the cached serialized form. Must be called before
+      //! serializing a cached message that was modified.
+      void
+      clearSerializationCache(void)
+      {
+        delete [] m_wire;
+        m_wire = NULL;
+      }
+
       //! Compare messages for equality.
       //! @param[in] other message to compare.
       //! @return true if messages are equal, false otherwise.
@@ -314,6 +457,26 @@ namespace DUNE
     protected:
       //! Message header.
       Header m_header;
+      //! Message trace.
+      Trace m_trace;
+      //! Exchange the header and trace with another message of the
+      //! same type, discarding the cached serialized forms of both.
+      //! @param[in] other message.
+      void
+      swapHeader(Message& other)
+      {
+        std::swap(m_header, other.m_header);
+        std::swap(m_trace, other.m_trace);
+        clearSerializationCache();
+        other.clearSerializationCache();
+      }
+
+      //! Cached serialized form (size followed by the packet).
+      mutable uint8_t* m_wire;
+      //! True if the serialized form may be cached.
+      bool m_wire_cache;
+
+      friend class Packet;
 
       //! Set the timestamp of nested messages.
       //! @param[in] value timestamp.
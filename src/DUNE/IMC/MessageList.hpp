@@ -30,12 +30,14 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <cstring>
 #include <stdexcept>
 #include <vector>
 
 // DUNE headers.
 #include <DUNE/IMC/Message.hpp>
 #include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
 #include <DUNE/IMC/Serialization.hpp>
 #include <DUNE/IMC/JSON.hpp>
 
@@ -56,7 +58,8 @@ namespace DUNE
       { }
 
       //! Copy constructor. Copy the contents of other to this
-      //! instance.
+      //! instance. The parent is not copied: it must be set by the
+      //! message that owns the new list.
       //! @param[in] other message.
       MessageList(const MessageList& other):
         m_parent(NULL)
@@ -98,6 +101,28 @@ namespace DUNE
         m_list.clear();
       }
 
+      //! Exchange the elements of this list with the elements of
+      //! another list without copying them. Each list keeps its
+      //! parent and the headers of the exchanged elements are
+      //! synchronized with it.
+      //! @param[in] other message list.
+      void
+      swap(MessageList& other)
+      {
+        m_list.swap(other.m_list);
+        synchronizeHeaders();
+        other.synchronizeHeaders();
+      }
+
+      //! Request room for at least a given number of elements,
+      //! avoiding reallocations while the list grows.
+      //! @param[in] n number of elements.
+      void
+      reserve(size_t n)
+      {
+        m_list.reserve(n);
+      }
+
       //! Retrieve the number of elements in this list.
       //! @return number of elements in the list.
       size_t
@@ -262,6 +287,7 @@ namespace DUNE
         uint16_t message_count = 0;
         std::memcpy(&message_count, ptr, 2);
         ptr += 2;
+        m_list.reserve(m_list.size() + message_count);
 
         // Deserialize messages.
         for (uint16_t i = 0; i < message_count; ++i)
@@ -299,6 +325,7 @@ namespace DUNE
         uint16_t message_count = 0;
         Utils::reverseCopy(message_count, (char*)ptr);
         ptr += 2;
+        m_list.reserve(m_list.size() + message_count);
 
         // Deserialize messages.
         for (uint16_t i = 0; i < message_count; ++i)
@@ -355,6 +382,63 @@ namespace DUNE
         os << "]";
       }
 
+      void
+      toJSON(Utils::ByteBuffer& bfr, const char* label) const
+      {
+        writeJSONLabel(bfr, label);
+        bfr.appendSigned("[", 1);
+
+        for (unsigned i = 0; i < m_list.size(); ++i)
+        {
+          if (i != 0)
+            bfr.appendSigned(",", 1);
+
+          if (m_list[i] == NULL)
+          {
+            bfr.appendSigned("\"null\"", 6);
+            continue;
+          }
+
+          const char* name = m_list[i]->getName();
+          bfr.appendSigned("{\"abbrev\":", 10);
+          writeJSONString(bfr, name, std::strlen(name));
+          m_list[i]->fieldsToJSON(bfr);
+          bfr.appendSigned("}", 1);
+        }
+
+        bfr.appendSigned("]", 1);
+      }
+
+      void
+      fromJSON(JSONReader& reader)
+      {
+        clear();
+        reader.beginArray();
+
+        while (reader.nextElement())
+        {
+          Message* msg = IMC::fromJSON(reader);
+          if (msg == NULL)
+          {
+            m_list.push_back(NULL);
+            continue;
+          }
+
+          Type* tmsg = dynamic_cast<Type*>(msg);
+          if (tmsg == NULL)
+          {
+            std::string name = msg->getName();
+            delete msg;
+            throw InvalidMessageAbbrev(name);
+          }
+
+          if (m_parent != NULL)
+            synchronizeHeader(tmsg);
+
+          m_list.push_back(tmsg);
+        }
+      }
+
       void
       setTimeStamp(double value)
       {
@@ -439,12 +523,24 @@ namespace DUNE
         msg->setDestinationEntity(m_parent->getDestinationEntity());
       }
 
+      void
+      synchronizeHeaders(void)
+      {
+        if (m_parent == NULL)
+          return;
+
+        for (unsigned i = 0; i < m_list.size(); ++i)
+          synchronizeHeader(m_list[i]);
+      }
+
       void
       copy(const MessageList& other)
       {
-        m_parent = other.m_parent;
+        if (&other == this)
+          return;
 
         clear();
+        m_list.reserve(other.m_list.size());
 
         for (unsigned i = 0; i < other.m_list.size(); ++i)
         {
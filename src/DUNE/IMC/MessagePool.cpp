@@ -0,0 +1,188 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <new>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Scheduler.hpp>
+#include <DUNE/IMC/MessagePool.hpp>
+
+#if defined(DUNE_SYS_HAS___SYNC_BOOL_COMPARE_AND_SWAP) && defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  define DUNE_IMC_MESSAGE_POOL_ENABLED
+#endif
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Granularity of size classes.
+    static const std::size_t c_granularity = 16;
+    //! Number of size classes.
+    static const std::size_t c_classes = 32;
+    //! Largest pooled block.
+    static const std::size_t c_max_size = c_granularity * c_classes;
+    //! Maximum number of cached blocks per size class.
+    static const unsigned c_max_blocks = 64;
+
+    //! Free block.
+    struct Block
+    {
+      Block* next;
+    };
+
+    //! Free list of one size class. Zero initialized, so that it
+    //! can be used before static constructors run.
+    struct SizeClass
+    {
+      //! Spin lock.
+      volatile int lock;
+      //! First free block.
+      Block* head;
+      //! Number of free blocks.
+      unsigned count;
+    };
+
+    static SizeClass s_classes[c_classes];
+
+#if defined(DUNE_IMC_MESSAGE_POOL_ENABLED)
+    static inline void
+    lock(SizeClass& sc)
+    {
+      while (!__sync_bool_compare_and_swap(&sc.lock, 0, 1))
+        Concurrency::Scheduler::yield();
+    }
+
+    static inline void
+    unlock(SizeClass& sc)
+    {
+      __sync_synchronize();
+      sc.lock = 0;
+    }
+#endif
+
+    void*
+    MessagePool::allocate(std::size_t size)
+    {
+#if defined(DUNE_IMC_MESSAGE_POOL_ENABLED)
+      if (size > 0 && size <= c_max_size)
+      {
+        SizeClass& sc = s_classes[(size - 1) / c_granularity];
+        Block* block = NULL;
+
+        lock(sc);
+        if (sc.head != NULL)
+        {
+          block = sc.head;
+          sc.head = block->next;
+          --sc.count;
+        }
+        unlock(sc);
+
+        if (block != NULL)
+          return block;
+
+        // Allocate the whole size class so that the block can be
+        // reused by any message of the same class.
+        size = ((size - 1) / c_granularity + 1) * c_granularity;
+      }
+#endif
+
+      return ::operator new(size);
+    }
+
+    void
+    MessagePool::release(void* ptr, std::size_t size)
+    {
+      if (ptr == NULL)
+        return;
+
+#if defined(DUNE_IMC_MESSAGE_POOL_ENABLED)
+      if (size > 0 && size <= c_max_size)
+      {
+        SizeClass& sc = s_classes[(size - 1) / c_granularity];
+        Block* block = static_cast<Block*>(ptr);
+
+        lock(sc);
+        if (sc.count < c_max_blocks)
+        {
+          block->next = sc.head;
+          sc.head = block;
+          ++sc.count;
+          block = NULL;
+        }
+        unlock(sc);
+
+        if (block == NULL)
+          return;
+      }
+#else
+      (void)size;
+#endif
+
+      ::operator delete(ptr);
+    }
+
+    void
+    MessagePool::trim(void)
+    {
+#if defined(DUNE_IMC_MESSAGE_POOL_ENABLED)
+      for (std::size_t i = 0; i < c_classes; ++i)
+      {
+        SizeClass& sc = s_classes[i];
+
+        lock(sc);
+        Block* block = sc.head;
+        sc.head = NULL;
+        sc.count = 0;
+        unlock(sc);
+
+        while (block != NULL)
+        {
+          Block* next = block->next;
+          ::operator delete(block);
+          block = next;
+        }
+      }
+#endif
+    }
+
+    std::size_t
+    MessagePool::getCachedSize(void)
+    {
+      std::size_t total = 0;
+
+      for (std::size_t i = 0; i < c_classes; ++i)
+        total += s_classes[i].count * (i + 1) * c_granularity;
+
+      return total;
+    }
+  }
+}
@@ -0,0 +1,77 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef DUNE_IMC_MESSAGE_POOL_HPP_INCLUDED_
+#define DUNE_IMC_MESSAGE_POOL_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export symbol.
+    class DUNE_DLL_SYM MessagePool;
+
+    //! Process-wide cache of memory blocks used to store IMC
+    //! messages. Freed blocks are kept in free lists segregated by
+    //! size and reused by subsequent allocations of messages of
+    //! similar size, so that tasks that decode, dispatch and delete
+    //! messages do not reach the heap in steady state.
+    class MessagePool
+    {
+    public:
+      //! Allocate a block.
+      //! @param[in] size size of the block in bytes.
+      //! @return pointer to block.
+      static void*
+      allocate(std::size_t size);
+
+      //! Return a block to the pool.
+      //! @param[in] ptr pointer to block.
+      //! @param[in] size size of the block in bytes.
+      static void
+      release(void* ptr, std::size_t size);
+
+      //! Return all cached blocks to the heap.
+      static void
+      trim(void);
+
+      //! Retrieve the number of cached bytes.
+      //! @return number of bytes.
+      static std::size_t
+      getCachedSize(void);
+    };
+  }
+}
+
+#endif
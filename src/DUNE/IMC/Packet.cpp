@@ -27,6 +27,7 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/Utils/ByteCopy.hpp>
@@ -35,6 +36,8 @@
 #include <DUNE/IMC/Serialization.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/PacketFilter.hpp>
+#include <DUNE/IMC/ScatterPacket.hpp>
 #include <DUNE/IMC/Constants.hpp>
 
 namespace DUNE
@@ -44,47 +47,133 @@ namespace DUNE
     uint16_t
     Packet::serialize(const Message* msg, uint8_t* bfr, uint16_t size)
     {
-      unsigned total = msg->getSerializationSize();
-      if (total > DUNE_IMC_CONST_MAX_SIZE)
-        throw InvalidMessageSize(total);
-
-      uint16_t n = total;
-      uint8_t* ptr = bfr;
-
+      uint16_t n = 0;
+      const uint8_t* packet = getCachedPacket(msg, n);
       if (size < n)
         throw BufferTooShort();
 
-      ptr += serializeHeader(msg, bfr, size);
-      msg->serializeFields(ptr);
-
-      uint16_t crc = Algorithms::CRC16::compute(bfr, n - DUNE_IMC_CONST_FOOTER_SIZE);
-      IMC::serialize(crc, (bfr + (n - DUNE_IMC_CONST_FOOTER_SIZE)));
+      if (packet != NULL)
+      {
+        std::memcpy(bfr, packet, n);
+        return n;
+      }
 
-      return n;
+      return serializePacket(msg, bfr, n);
     }
 
     uint16_t
     Packet::serialize(const Message* msg, Utils::ByteBuffer& bfr)
     {
-      unsigned size = msg->getSerializationSize();
-      if (size > 65535)
-        throw InvalidMessageSize(size);
+      uint16_t n = 0;
+      const uint8_t* packet = getCachedPacket(msg, n);
+      bfr.setSize(n);
+
+      if (packet != NULL)
+      {
+        std::memcpy(bfr.getBuffer(), packet, n);
+        return n;
+      }
 
-      bfr.setSize(size);
-      return serialize(msg, bfr.getBuffer(), size);
+      return serializePacket(msg, bfr.getBuffer(), n);
     }
 
     uint16_t
     Packet::serialize(const Message* msg, std::ostream& ofs)
     {
+      uint16_t n = 0;
+      const uint8_t* packet = getCachedPacket(msg, n);
+
+      if (packet != NULL)
+      {
+        ofs.write((const char*)packet, n);
+        return n;
+      }
+
+      std::vector<char> data(n);
+      serializePacket(msg, (uint8_t*)&data[0], n);
+      ofs.write(&data[0], n);
+      return n;
+    }
+
+    uint16_t
+    Packet::serialize(const Message* msg, ScatterPacket& packet)
+    {
+      packet.clear();
+
+      uint16_t n = 0;
+      const uint8_t* cached = getCachedPacket(msg, n);
+      if (cached != NULL)
+      {
+        packet.reference(cached, n);
+        packet.resolve();
+        return n;
+      }
+
+      serializeHeader(msg, packet.grow(DUNE_IMC_CONST_HEADER_SIZE), DUNE_IMC_CONST_HEADER_SIZE);
+      msg->scatterFields(packet);
+      packet.resolve();
+
+      uint16_t crc = 0;
+      for (unsigned i = 0; i < packet.getCount(); ++i)
+        crc = Algorithms::CRC16::compute(packet.getBuffers()[i], packet.getSizes()[i], crc);
+
+      IMC::serialize(crc, packet.grow(DUNE_IMC_CONST_FOOTER_SIZE));
+      packet.resolve();
+
+      return n;
+    }
+
+    const uint8_t*
+    Packet::getCachedPacket(const Message* msg, uint16_t& n)
+    {
+      const uint8_t* wire = msg->m_wire;
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+      __sync_synchronize();
+#endif
+
+      if (wire != NULL)
+      {
+        std::memcpy(&n, wire, sizeof(uint16_t));
+        return wire + sizeof(uint16_t);
+      }
+
       unsigned total = msg->getSerializationSize();
       if (total > DUNE_IMC_CONST_MAX_SIZE)
         throw InvalidMessageSize(total);
 
-      uint16_t n = total;
-      std::vector<char> data(n);
-      serialize(msg, (uint8_t*)&data[0], n);
-      ofs.write(&data[0], n);
+      n = total;
+      if (!msg->m_wire_cache)
+        return NULL;
+
+      uint8_t* cache = new uint8_t[n + sizeof(uint16_t)];
+      std::memcpy(cache, &n, sizeof(uint16_t));
+      serializePacket(msg, cache + sizeof(uint16_t), n);
+
+#if defined(DUNE_SYS_HAS___SYNC_BOOL_COMPARE_AND_SWAP)
+      // Concurrent serializations produce the same packet: the first
+      // one published is kept.
+      if (!__sync_bool_compare_and_swap(&msg->m_wire, (uint8_t*)NULL, cache))
+      {
+        delete [] cache;
+        cache = msg->m_wire;
+      }
+#else
+      msg->m_wire = cache;
+#endif
+
+      return cache + sizeof(uint16_t);
+    }
+
+    uint16_t
+    Packet::serializePacket(const Message* msg, uint8_t* bfr, uint16_t n)
+    {
+      uint8_t* ptr = bfr;
+      ptr += serializeHeader(msg, bfr, n);
+      msg->serializeFields(ptr);
+
+      uint16_t crc = Algorithms::CRC16::compute(bfr, n - DUNE_IMC_CONST_FOOTER_SIZE);
+      IMC::serialize(crc, (bfr + (n - DUNE_IMC_CONST_FOOTER_SIZE)));
+
       return n;
     }
 
@@ -161,6 +250,52 @@ namespace DUNE
       return deserializePayload(hdr, bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE + remaining, 0);
     }
 
+    Message*
+    Packet::deserialize(const uint8_t* bfr, uint16_t bfr_len, const PacketFilter& filter, Message* msg)
+    {
+      Header hdr;
+      deserializeHeader(hdr, bfr, bfr_len);
+
+      if (!filter.matches(hdr))
+        return NULL;
+
+      if (hdr.size > bfr_len - (DUNE_IMC_CONST_HEADER_SIZE + DUNE_IMC_CONST_FOOTER_SIZE))
+        throw BufferTooShort();
+
+      return deserializePayload(hdr, bfr, bfr_len, msg);
+    }
+
+    Message*
+    Packet::deserialize(std::istream& ifs, Utils::ByteBuffer& bfr, const PacketFilter& filter)
+    {
+      while (true)
+      {
+        bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE);
+        ifs.read(bfr.getBufferSigned(), DUNE_IMC_CONST_HEADER_SIZE);
+
+        if (ifs.eof())
+          return 0;
+
+        if (ifs.gcount() < DUNE_IMC_CONST_HEADER_SIZE)
+          throw BufferTooShort();
+
+        Header hdr;
+        deserializeHeader(hdr, bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE);
+
+        // Packets that do not match are read without being
+        // deserialized: compressed streams cannot seek.
+        uint16_t remaining = hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+        bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE + remaining);
+        ifs.read(bfr.getBufferSigned() + DUNE_IMC_CONST_HEADER_SIZE, remaining);
+
+        if (ifs.gcount() < remaining)
+          throw BufferTooShort();
+
+        if (filter.matches(hdr))
+          return deserializePayload(hdr, bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE + remaining, 0);
+      }
+    }
+
     uint16_t
     Packet::serializeHeader(const Message* msg, uint8_t* bfr, uint16_t bfr_len)
     {
@@ -47,6 +47,8 @@ namespace DUNE
 
     // Forward declarations.
     class Message;
+    class PacketFilter;
+    class ScatterPacket;
 
     class Packet
     {
@@ -74,6 +76,15 @@ namespace DUNE
       static uint16_t
       serialize(const Message* msg, std::ostream& ofs);
 
+      //! Serialize a message as a list of segments for gathered
+      //! writes. Cached packets and large data fields are referenced
+      //! in place and must outlive the use of the segments.
+      //! @param[in] msg message.
+      //! @param[out] packet destination packet.
+      //! @return packet size.
+      static uint16_t
+      serialize(const Message* msg, ScatterPacket& packet);
+
       static Message*
       deserialize(const uint8_t* bfr, uint16_t bfr_len, Message* msg = NULL);
 
@@ -83,6 +94,27 @@ namespace DUNE
       static Message*
       deserialize(std::istream& ifs, Utils::ByteBuffer& bfr);
 
+      //! Deserialize a packet if its header matches a filter. The
+      //! payload of packets that do not match is not deserialized.
+      //! @param[in] bfr source buffer.
+      //! @param[in] bfr_len source buffer size.
+      //! @param[in] filter packet filter.
+      //! @param[in] msg message object to fill or NULL to create one.
+      //! @return message object or NULL if the packet does not match
+      //! the filter.
+      static Message*
+      deserialize(const uint8_t* bfr, uint16_t bfr_len, const PacketFilter& filter, Message* msg = NULL);
+
+      //! Deserialize the next packet of a stream that matches a
+      //! filter. Packets that do not match are skipped without
+      //! deserializing their payload.
+      //! @param[in] ifs source input stream.
+      //! @param[in] bfr packet buffer.
+      //! @param[in] filter packet filter.
+      //! @return message object or NULL at the end of the stream.
+      static Message*
+      deserialize(std::istream& ifs, Utils::ByteBuffer& bfr, const PacketFilter& filter);
+
       static uint16_t
       serializeHeader(const Message* msg, uint8_t* bfr, uint16_t bfr_len);
 
@@ -91,6 +123,24 @@ namespace DUNE
 
       static Message*
       deserializePayload(const Header& hdr, const uint8_t* bfr, uint16_t bfr_len, Message* msg);
+
+    private:
+      //! Retrieve the cached packet of a message, serializing it
+      //! first if the message allows caching.
+      //! @param[in] msg message.
+      //! @param[out] n packet size.
+      //! @return cached packet or NULL if the message is not cached.
+      static const uint8_t*
+      getCachedPacket(const Message* msg, uint16_t& n);
+
+      //! Serialize a message whose size was already validated,
+      //! ignoring its cached serialized form.
+      //! @param[in] msg message.
+      //! @param[out] bfr destination buffer.
+      //! @param[in] n serialization size of the message.
+      //! @return number of bytes written.
+      static uint16_t
+      serializePacket(const Message* msg, uint8_t* bfr, uint16_t n);
     };
   }
 }
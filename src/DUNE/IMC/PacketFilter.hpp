@@ -0,0 +1,167 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_PACKET_FILTER_HPP_INCLUDED_
+#define DUNE_IMC_PACKET_FILTER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <set>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Header.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM PacketFilter;
+
+    //! Selects packets by their header: message identifier, source,
+    //! destination and time stamp. Packets can be discarded before
+    //! their payload is deserialized (see Packet::deserialize). An
+    //! empty filter matches all packets.
+    class PacketFilter
+    {
+    public:
+      PacketFilter(void):
+        m_begin(0),
+        m_end(-1)
+      { }
+
+      //! Select message identifiers.
+      //! @param[in] ids message identifiers (empty to match all).
+      void
+      setIds(const std::set<uint16_t>& ids)
+      {
+        m_ids = ids;
+      }
+
+      //! Select a message identifier.
+      //! @param[in] id message identifier.
+      void
+      addId(uint16_t id)
+      {
+        m_ids.insert(id);
+      }
+
+      //! Get the selected message identifiers.
+      //! @return message identifiers (empty if all are matched).
+      const std::set<uint16_t>&
+      getIds(void) const
+      {
+        return m_ids;
+      }
+
+      //! Select source addresses.
+      //! @param[in] sources source addresses (empty to match all).
+      void
+      setSources(const std::set<uint16_t>& sources)
+      {
+        m_sources = sources;
+      }
+
+      //! Select a source address.
+      //! @param[in] src source address.
+      void
+      addSource(uint16_t src)
+      {
+        m_sources.insert(src);
+      }
+
+      //! Select destination addresses.
+      //! @param[in] destinations destination addresses (empty to
+      //! match all).
+      void
+      setDestinations(const std::set<uint16_t>& destinations)
+      {
+        m_destinations = destinations;
+      }
+
+      //! Select a destination address.
+      //! @param[in] dst destination address.
+      void
+      addDestination(uint16_t dst)
+      {
+        m_destinations.insert(dst);
+      }
+
+      //! Select a time range.
+      //! @param[in] begin first time stamp.
+      //! @param[in] end last time stamp (negative for no limit).
+      void
+      setTimeRange(fp64_t begin, fp64_t end)
+      {
+        m_begin = begin;
+        m_end = end;
+      }
+
+      //! Test if a time range overlaps the selected one.
+      //! @param[in] start first time stamp.
+      //! @param[in] end last time stamp.
+      //! @return true if the ranges overlap, false otherwise.
+      bool
+      overlaps(fp64_t start, fp64_t end) const
+      {
+        return end >= m_begin && (m_end < 0 || start <= m_end);
+      }
+
+      //! Test if a packet matches the filter.
+      //! @param[in] hdr packet header.
+      //! @return true if the packet matches, false otherwise.
+      bool
+      matches(const Header& hdr) const
+      {
+        if (hdr.timestamp < m_begin || (m_end >= 0 && hdr.timestamp > m_end))
+          return false;
+
+        if (!m_ids.empty() && m_ids.find(hdr.mgid) == m_ids.end())
+          return false;
+
+        if (!m_sources.empty() && m_sources.find(hdr.src) == m_sources.end())
+          return false;
+
+        return m_destinations.empty() || m_destinations.find(hdr.dst) != m_destinations.end();
+      }
+
+    private:
+      //! Message identifiers.
+      std::set<uint16_t> m_ids;
+      //! Source addresses.
+      std::set<uint16_t> m_sources;
+      //! Destination addresses.
+      std::set<uint16_t> m_destinations;
+      //! First time stamp.
+      fp64_t m_begin;
+      //! Last time stamp.
+      fp64_t m_end;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,134 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/Header.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/PacketScanner.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Size of packet headers.
+    static const uint32_t c_header_size = DUNE_IMC_CONST_HEADER_SIZE;
+
+    void
+    PacketScanner::reset(void)
+    {
+      m_skip = 0;
+      m_head.clear();
+      m_valid = true;
+    }
+
+    bool
+    PacketScanner::parse(const uint8_t* data, Location& loc, uint32_t& size)
+    {
+      try
+      {
+        Header hdr;
+        Packet::deserializeHeader(hdr, data, c_header_size);
+        loc.id = hdr.mgid;
+        loc.time = hdr.timestamp;
+        size = c_header_size + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+        return true;
+      }
+      catch (std::exception& e)
+      {
+        (void)e;
+        m_valid = false;
+        m_head.clear();
+        return false;
+      }
+    }
+
+    bool
+    PacketScanner::scan(const uint8_t* data, uint32_t size, std::vector<Location>& packets)
+    {
+      packets.clear();
+
+      if (!m_valid)
+        return false;
+
+      Location loc;
+      uint32_t len = 0;
+
+      if (!m_head.empty())
+      {
+        uint32_t have = m_head.size();
+        uint32_t n = std::min(c_header_size - have, size);
+        m_head.insert(m_head.end(), data, data + n);
+        if (m_head.size() < c_header_size)
+          return true;
+
+        if (!parse(&m_head[0], loc, len))
+          return false;
+
+        m_head.clear();
+        m_skip = len - have;
+      }
+
+      if (m_skip >= size)
+      {
+        m_skip -= size;
+        return true;
+      }
+
+      uint32_t pos = m_skip;
+      m_skip = 0;
+
+      while (pos < size)
+      {
+        if (size - pos < c_header_size)
+        {
+          m_head.assign(data + pos, data + size);
+          break;
+        }
+
+        if (!parse(data + pos, loc, len))
+          return false;
+
+        loc.pos = pos;
+        packets.push_back(loc);
+
+        if (len > size - pos)
+        {
+          m_skip = len - (size - pos);
+          break;
+        }
+
+        pos += len;
+      }
+
+      return true;
+    }
+  }
+}
@@ -0,0 +1,100 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_PACKET_SCANNER_HPP_INCLUDED_
+#define DUNE_IMC_PACKET_SCANNER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM PacketScanner;
+
+    //! Locates packets in consecutive chunks of an LSF stream by
+    //! hopping over packet headers, without deserializing payloads.
+    //! Packets may span several chunks.
+    class PacketScanner
+    {
+    public:
+      //! Packet location.
+      struct Location
+      {
+        //! Offset of the packet in the chunk.
+        uint32_t pos;
+        //! Message identifier.
+        uint16_t id;
+        //! Time stamp.
+        fp64_t time;
+      };
+
+      PacketScanner(void)
+      {
+        reset();
+      }
+
+      //! Restart scanning at the beginning of a stream.
+      void
+      reset(void);
+
+      //! Scan the next chunk of the stream. Packets whose header is
+      //! split between two chunks are not reported.
+      //! @param[in] data chunk data.
+      //! @param[in] size chunk size.
+      //! @param[out] packets packets that start in the chunk.
+      //! @return false if the stream stopped looking like an LSF
+      //! stream (nothing else is reported until reset), true
+      //! otherwise.
+      bool
+      scan(const uint8_t* data, uint32_t size, std::vector<Location>& packets);
+
+    private:
+      //! Bytes of a packet that started in a previous chunk.
+      uint32_t m_skip;
+      //! Bytes of a packet header split between chunks.
+      std::vector<uint8_t> m_head;
+      //! False if the stream is not an LSF stream.
+      bool m_valid;
+
+      //! Parse a packet header.
+      //! @param[in] data header data.
+      //! @param[out] loc packet location (position is not set).
+      //! @param[out] size packet size.
+      //! @return true if the header is valid, false otherwise.
+      bool
+      parse(const uint8_t* data, Location& loc, uint32_t& size);
+    };
+  }
+}
+
+#endif
@@ -25,110 +25,296 @@
 // Author: Eduardo Marques                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/IMC/Parser.hpp>
 #include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/Factory.hpp>
 
 namespace DUNE
 {
   namespace IMC
   {
-    Parser::Parser(void)
+    //! Size of an empty frame.
+    static const unsigned c_frame_size = DUNE_IMC_CONST_HEADER_SIZE + DUNE_IMC_CONST_FOOTER_SIZE;
+
+    //! Test if a byte can start a synchronization number.
+    //! @param[in] byte data byte.
+    //! @return true if the byte can start a frame, false otherwise.
+    static inline bool
+    isSyncStart(uint8_t byte)
+    {
+      return byte == (DUNE_IMC_CONST_SYNC >> 8) || byte == (DUNE_IMC_CONST_SYNC_REV >> 8);
+    }
+
+    Parser::Parser(void):
+      m_reuse(false)
     {
       reset();
     }
 
+    Parser::Parser(const Parser& other)
+    {
+      copy(other);
+    }
+
     Parser::~Parser(void)
-    { }
+    {
+      clearInstances();
+    }
+
+    Parser&
+    Parser::operator=(const Parser& other)
+    {
+      if (this != &other)
+      {
+        clearInstances();
+        copy(other);
+      }
+
+      return *this;
+    }
+
+    void
+    Parser::copy(const Parser& other)
+    {
+      m_buf = other.m_buf;
+      m_pos = other.m_pos;
+      m_reuse = other.m_reuse;
+      m_instances.clear();
+
+      std::map<uint16_t, Instance>::const_iterator itr = other.m_instances.begin();
+      for (; itr != other.m_instances.end(); ++itr)
+      {
+        if (!itr->second.owned)
+          m_instances.insert(*itr);
+      }
+    }
 
     void
     Parser::reset(void)
     {
-      m_stage = c_sync;
       m_pos = 0;
       m_buf.clear();
     }
 
-    Message*
-    Parser::parse(uint8_t byte)
+    void
+    Parser::setReuse(bool enabled)
     {
-      Message* m = 0;
-      m_buf.push_back(byte);
+      m_reuse = enabled;
 
-      while (true)
-      {
-        int n = m_buf.size() - m_pos;
+      if (!m_reuse)
+        clearInstances();
+    }
 
-        if (!n)
-        {
-          reset(); // discard unneeded data
-          break;
-        }
+    void
+    Parser::bind(Message* msg)
+    {
+      unbind(msg->getId());
+
+      Instance instance;
+      instance.msg = msg;
+      instance.owned = false;
+      m_instances[msg->getId()] = instance;
+    }
 
-        if (m_stage == c_sync)
+    void
+    Parser::unbind(uint16_t id)
+    {
+      std::map<uint16_t, Instance>::iterator itr = m_instances.find(id);
+      if (itr == m_instances.end())
+        return;
+
+      if (itr->second.owned)
+        delete itr->second.msg;
+
+      m_instances.erase(itr);
+    }
+
+    void
+    Parser::release(Message* msg)
+    {
+      std::map<uint16_t, Instance>::iterator itr = m_instances.find(msg->getId());
+      if (itr != m_instances.end() && itr->second.msg == msg)
+        return;
+
+      delete msg;
+    }
+
+    void
+    Parser::clearInstances(void)
+    {
+      std::map<uint16_t, Instance>::iterator itr = m_instances.begin();
+      while (itr != m_instances.end())
+      {
+        if (itr->second.owned)
         {
-          // This would not be stricly necessary but is more efficient
-          // than  handling recurrent exceptions from Packet::deserializeHeader
-          if (n == 1)
-          {
-            break; // need more data
-          }
-
-          uint16_t sync = (m_buf[m_pos] << 8) | m_buf[m_pos + 1];
-
-          if (sync != DUNE_IMC_CONST_SYNC && sync != DUNE_IMC_CONST_SYNC_REV)
-          {
-            m_pos++; // invalid sync, advance
-            continue;
-          }
-          m_stage = c_header; // sync is ok, get rest of header
+          delete itr->second.msg;
+          m_instances.erase(itr++);
         }
-
-        if (m_stage == c_header)
+        else
         {
-          if (n < DUNE_IMC_CONST_HEADER_SIZE)
-            break;  // need more data
-
-          try
-          {
-            Packet::deserializeHeader(m_header, &m_buf[m_pos], n);
-          }
-          catch (...)
-          {
-            m_stage = c_sync;
-            ++m_pos; // try to find sync again from current position
-            continue;
-          }
-          m_stage = c_payload; // done with header
+          ++itr;
         }
+      }
+    }
 
-        // on to c_payload stage
+    Message*
+    Parser::getInstance(uint16_t id)
+    {
+      std::map<uint16_t, Instance>::iterator itr = m_instances.find(id);
+      if (itr != m_instances.end())
+        return itr->second.msg;
 
-        if (n < (int)(m_header.size + DUNE_IMC_CONST_HEADER_SIZE + DUNE_IMC_CONST_FOOTER_SIZE))
-          break;  // need more data
+      if (!m_reuse)
+        return 0;
 
-        // all payload data available
-        m_stage = c_sync; // the next stage in any case
+      Message* msg = Factory::produce(id);
+      if (msg == 0)
+        return 0;
 
-        try
-        {
-          m = Packet::deserializePayload(m_header, &m_buf[m_pos], n, 0);
-        }
-        catch (...)
+      Instance instance;
+      instance.msg = msg;
+      instance.owned = true;
+      m_instances[id] = instance;
+
+      return msg;
+    }
+
+    Message*
+    Parser::extract(const uint8_t* bfr, unsigned size, unsigned& advance, unsigned& required)
+    {
+      advance = 0;
+      required = 2;
+
+      if (size < 2)
+      {
+        if (size == 1 && !isSyncStart(bfr[0]))
+          advance = 1;
+        return 0;
+      }
+
+      uint16_t sync = (bfr[0] << 8) | bfr[1];
+
+      if (sync != DUNE_IMC_CONST_SYNC && sync != DUNE_IMC_CONST_SYNC_REV)
+      {
+        // Invalid sync, skip to the next candidate.
+        advance = 1;
+        while (advance < size && !isSyncStart(bfr[advance]))
+          ++advance;
+        return 0;
+      }
+
+      required = DUNE_IMC_CONST_HEADER_SIZE;
+      if (size < required)
+        return 0;
+
+      Header hdr;
+
+      try
+      {
+        Packet::deserializeHeader(hdr, bfr, DUNE_IMC_CONST_HEADER_SIZE);
+      }
+      catch (...)
+      {
+        advance = 1;
+        return 0;
+      }
+
+      required = hdr.size + c_frame_size;
+      if (size < required)
+        return 0;
+
+      Message* msg = getInstance(hdr.mgid);
+
+      try
+      {
+        if (msg != 0)
+          msg->clear();
+
+        msg = Packet::deserializePayload(hdr, bfr, required, msg);
+      }
+      catch (...)
+      {
+        // Try to find sync again from the next position.
+        advance = 1;
+        return 0;
+      }
+
+      advance = required;
+      return msg;
+    }
+
+    Message*
+    Parser::parse(uint8_t byte)
+    {
+      unsigned consumed = 0;
+      Message* msg = parse(&byte, 1, consumed);
+
+      // A buffered frame was completed before the byte was used.
+      if (consumed == 0)
+        m_buf.push_back(byte);
+
+      return msg;
+    }
+
+    Message*
+    Parser::parse(const uint8_t* data, unsigned size, unsigned& consumed)
+    {
+      unsigned advance = 0;
+      unsigned required = 0;
+
+      consumed = 0;
+
+      // Complete frames started in previous calls.
+      while (m_pos < m_buf.size())
+      {
+        unsigned buffered = m_buf.size() - m_pos;
+        Message* msg = extract(&m_buf[m_pos], buffered, advance, required);
+
+        if (advance == 0)
         {
-          ++m_pos; // try to find sync again from current position
+          if (consumed == size)
+            return 0;
+
+          unsigned n = std::min(required - buffered, size - consumed);
+          m_buf.insert(m_buf.end(), data + consumed, data + consumed + n);
+          consumed += n;
           continue;
         }
 
-        m_pos += n;
+        m_pos += advance;
 
         if (m_pos == m_buf.size())
-          reset();  // discard unneeded data
+          reset(); // discard unneeded data
+
+        if (msg)
+          return msg;
+      }
+
+      // Decode frames directly from the given bytes.
+      while (consumed < size)
+      {
+        Message* msg = extract(data + consumed, size - consumed, advance, required);
+
+        if (advance == 0)
+        {
+          // Keep incomplete frame.
+          m_buf.assign(data + consumed, data + size);
+          m_pos = 0;
+          consumed = size;
+          return 0;
+        }
+
+        consumed += advance;
 
-        break;
+        if (msg)
+          return msg;
       }
 
-      return m;
+      return 0;
     }
   }
 }
@@ -30,6 +30,7 @@
 
 // ISO C++ 98 headers.
 #include <vector>
+#include <map>
 
 // DUNE headers.
 #include <DUNE/IMC/Message.hpp>
@@ -42,15 +43,34 @@ namespace DUNE
     class DUNE_DLL_SYM Parser;
 
     //! Parser class.
+    //!
+    //! By default every decoded message is a new object owned by the
+    //! caller. When reuse is enabled, or when an instance is bound to
+    //! a message identifier, frames are decoded into objects kept by
+    //! the parser: these remain valid until the next frame with the
+    //! same identifier is decoded and must be returned with release()
+    //! instead of being deleted.
     class Parser
     {
     public:
       //! Default constructor.
       Parser(void);
 
+      //! Copy constructor. Buffered data and bound messages are
+      //! copied, parser owned objects are not.
+      //! @param[in] other parser.
+      Parser(const Parser& other);
+
       //! Destructor.
       ~Parser(void);
 
+      //! Assignment operator. Buffered data and bound messages are
+      //! copied, parser owned objects are not.
+      //! @param[in] other parser.
+      //! @return reference to this parser.
+      Parser&
+      operator=(const Parser& other);
+
       //! Reset parser.
       void
       reset(void);
@@ -61,19 +81,84 @@ namespace DUNE
       Message*
       parse(uint8_t byte);
 
+      //! Parse a sequence of bytes, stopping after the first complete
+      //! message. Frames entirely contained in the sequence are
+      //! decoded in place, only incomplete frames are buffered.
+      //! @param[in] data data bytes.
+      //! @param[in] size number of data bytes.
+      //! @param[out] consumed number of bytes consumed, the remaining
+      //! bytes must be passed in the next call.
+      //! @return defined message or 0 if all bytes were consumed
+      //! without completing a message.
+      Message*
+      parse(const uint8_t* data, unsigned size, unsigned& consumed);
+
+      //! Enable or disable decoding into one parser owned object per
+      //! message identifier.
+      //! @param[in] enabled true to reuse objects, false otherwise.
+      void
+      setReuse(bool enabled);
+
+      //! Decode frames with the identifier of a given message into
+      //! that message. The message remains owned by the caller and
+      //! must outlive the parser or be unbound.
+      //! @param[in] msg message object.
+      void
+      bind(Message* msg);
+
+      //! Stop decoding frames into a previously bound message.
+      //! @param[in] id message identifier.
+      void
+      unbind(uint16_t id);
+
+      //! Dispose of a message returned by parse().
+      //! @param[in] msg message.
+      void
+      release(Message* msg);
+
     private:
-      //! Parser stage constants.
-      enum ParserStage
+      //! Message object kept by the parser.
+      struct Instance
       {
-        c_sync,
-        c_header,
-        c_payload
+        //! Message object.
+        Message* msg;
+        //! True if the object is owned by the parser.
+        bool owned;
       };
 
-      ParserStage m_stage; //!< Parser stage.
-      std::vector<uint8_t> m_buf; //!< Internal buffer.
-      unsigned int m_pos; //!< Buffer position.
-      Header m_header; //!< Holds parsed header (c_payload stage).
+      //! Internal buffer holding incomplete frames.
+      std::vector<uint8_t> m_buf;
+      //! Buffer position.
+      unsigned int m_pos;
+      //! Objects used to decode frames, by message identifier.
+      std::map<uint16_t, Instance> m_instances;
+      //! True if parser owned objects are reused.
+      bool m_reuse;
+
+      //! Try to extract a frame from the start of a sequence of bytes.
+      //! @param[in] bfr data bytes.
+      //! @param[in] size number of data bytes.
+      //! @param[out] advance number of bytes to discard, 0 if more
+      //! data is needed.
+      //! @param[out] required number of bytes needed to progress.
+      //! @return decoded message or 0.
+      Message*
+      extract(const uint8_t* bfr, unsigned size, unsigned& advance, unsigned& required);
+
+      //! Retrieve the object used to decode a given message.
+      //! @param[in] id message identifier.
+      //! @return message object or 0 if a new one must be produced.
+      Message*
+      getInstance(uint16_t id);
+
+      //! Delete parser owned objects.
+      void
+      clearInstances(void);
+
+      //! Copy state of another parser.
+      //! @param[in] other parser.
+      void
+      copy(const Parser& other);
     };
   }
 }
@@ -0,0 +1,123 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/IMC/ScatterPacket.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    const size_t ScatterPacket::c_threshold;
+
+    ScatterPacket::ScatterPacket(size_t threshold):
+      m_threshold(threshold),
+      m_used(0),
+      m_size(0)
+    { }
+
+    void
+    ScatterPacket::clear(void)
+    {
+      m_used = 0;
+      m_size = 0;
+      m_segments.clear();
+      m_bfrs.clear();
+      m_sizes.clear();
+    }
+
+    uint8_t*
+    ScatterPacket::grow(size_t size)
+    {
+      if (m_used + size > m_bfr.size())
+        m_bfr.resize(std::max(m_used + size, m_bfr.size() * 2));
+
+      if (m_segments.empty() || m_segments.back().data != NULL)
+      {
+        Segment seg;
+        seg.data = NULL;
+        seg.offset = m_used;
+        seg.size = 0;
+        m_segments.push_back(seg);
+      }
+
+      uint8_t* ptr = &m_bfr[m_used];
+      m_segments.back().size += size;
+      m_used += size;
+      m_size += size;
+      return ptr;
+    }
+
+    void
+    ScatterPacket::append(const uint8_t* data, size_t size)
+    {
+      if (size > m_threshold)
+        reference(data, size);
+      else if (size > 0)
+        std::memcpy(grow(size), data, size);
+    }
+
+    void
+    ScatterPacket::reference(const uint8_t* data, size_t size)
+    {
+      Segment seg;
+      seg.data = data;
+      seg.offset = 0;
+      seg.size = size;
+      m_segments.push_back(seg);
+      m_size += size;
+    }
+
+    void
+    ScatterPacket::copy(uint8_t* bfr) const
+    {
+      for (unsigned i = 0; i < m_bfrs.size(); ++i)
+      {
+        std::memcpy(bfr, m_bfrs[i], m_sizes[i]);
+        bfr += m_sizes[i];
+      }
+    }
+
+    void
+    ScatterPacket::resolve(void)
+    {
+      m_bfrs.resize(m_segments.size());
+      m_sizes.resize(m_segments.size());
+
+      for (unsigned i = 0; i < m_segments.size(); ++i)
+      {
+        const Segment& seg = m_segments[i];
+        m_bfrs[i] = (seg.data == NULL) ? &m_bfr[seg.offset] : seg.data;
+        m_sizes[i] = seg.size;
+      }
+    }
+  }
+}
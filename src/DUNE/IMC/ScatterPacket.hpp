@@ -0,0 +1,169 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_SCATTER_PACKET_HPP_INCLUDED_
+#define DUNE_IMC_SCATTER_PACKET_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM ScatterPacket;
+
+    //! Packet serialized as a list of segments suitable for gathered
+    //! writes. Header, fixed size fields and checksum are copied to an
+    //! internal buffer, while large data fields are referenced in
+    //! place. Referenced data must outlive the use of the segments.
+    class ScatterPacket
+    {
+    public:
+      //! Default size above which data fields are referenced.
+      static const size_t c_threshold = 256;
+
+      //! Constructor.
+      //! @param[in] threshold size above which data fields are
+      //! referenced instead of copied.
+      ScatterPacket(size_t threshold = c_threshold);
+
+      //! Remove all segments.
+      void
+      clear(void);
+
+      //! Reserve room for a given number of bytes in the internal
+      //! buffer, after the existing segments.
+      //! @param[in] size number of bytes.
+      //! @return pointer to the reserved bytes, valid until the next
+      //! call to grow() or append().
+      uint8_t*
+      grow(size_t size);
+
+      //! Append data, copying it if it is smaller than the threshold
+      //! and referencing it otherwise.
+      //! @param[in] data data.
+      //! @param[in] size data size.
+      void
+      append(const uint8_t* data, size_t size);
+
+      //! Append the contents of a data field.
+      //! @param[in] data data field.
+      void
+      append(const std::vector<char>& data)
+      {
+        if (!data.empty())
+          append((const uint8_t*)&data[0], data.size());
+      }
+
+      //! Append a reference to data regardless of its size.
+      //! @param[in] data data.
+      //! @param[in] size data size.
+      void
+      reference(const uint8_t* data, size_t size);
+
+      //! Retrieve the number of segments.
+      //! @return number of segments.
+      unsigned
+      getCount(void) const
+      {
+        return m_bfrs.size();
+      }
+
+      //! Retrieve the segment buffers.
+      //! @return array of segment buffers.
+      const uint8_t* const*
+      getBuffers(void) const
+      {
+        return m_bfrs.empty() ? NULL : &m_bfrs[0];
+      }
+
+      //! Retrieve the segment sizes.
+      //! @return array of segment sizes.
+      const size_t*
+      getSizes(void) const
+      {
+        return m_sizes.empty() ? NULL : &m_sizes[0];
+      }
+
+      //! Retrieve the total size of the packet.
+      //! @return packet size.
+      size_t
+      getSize(void) const
+      {
+        return m_size;
+      }
+
+      //! Copy the packet to a contiguous buffer.
+      //! @param[out] bfr destination buffer, with room for at least
+      //! getSize() bytes.
+      void
+      copy(uint8_t* bfr) const;
+
+    private:
+      //! Segment of the packet.
+      struct Segment
+      {
+        //! Referenced data or NULL for the internal buffer.
+        const uint8_t* data;
+        //! Offset in the internal buffer.
+        size_t offset;
+        //! Size.
+        size_t size;
+      };
+
+      //! Size above which data is referenced.
+      size_t m_threshold;
+      //! Internal buffer.
+      std::vector<uint8_t> m_bfr;
+      //! Number of bytes used in the internal buffer.
+      size_t m_used;
+      //! Segments.
+      std::vector<Segment> m_segments;
+      //! Resolved segment buffers.
+      std::vector<const uint8_t*> m_bfrs;
+      //! Resolved segment sizes.
+      std::vector<size_t> m_sizes;
+      //! Total size.
+      size_t m_size;
+
+      //! Resolve the segments to buffers once the packet is complete.
+      void
+      resolve(void);
+
+      friend class Packet;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,271 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// DUNE headers.
+#include <DUNE/Compression/Factory.hpp>
+#include <DUNE/Compression/FileInput.hpp>
+#include <DUNE/Compression/StreamBuffer.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/IMC/Blob.hpp>
+#include <DUNE/IMC/Schema.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+#include <DUNE/Utils/Exceptions.hpp>
+#include <DUNE/Utils/XMLReader.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Field type names.
+    static const char* c_type_names[] =
+    {
+      "int8_t",
+      "uint8_t",
+      "int16_t",
+      "uint16_t",
+      "int32_t",
+      "uint32_t",
+      "int64_t",
+      "fp32_t",
+      "fp64_t",
+      "rawdata",
+      "plaintext",
+      "message",
+      "message-list"
+    };
+
+    //! Serialized sizes of field types.
+    static const unsigned c_type_sizes[] = {1, 1, 2, 2, 4, 4, 8, 4, 8, 0, 0, 0, 0};
+
+    //! Number of field types.
+    static const unsigned c_type_count = sizeof(c_type_names) / sizeof(c_type_names[0]);
+
+    //! Read a whole stream.
+    //! @param[in] is input stream.
+    //! @return stream contents.
+    static std::string
+    readAll(std::istream& is)
+    {
+      std::string data;
+      char bfr[4096];
+
+      while (true)
+      {
+        is.read(bfr, sizeof(bfr));
+        // Compressed streams report a negative count at the end.
+        std::streamsize rv = is.gcount();
+        if (rv <= 0)
+          break;
+        data.append(bfr, (size_t)rv);
+      }
+
+      return data;
+    }
+
+    //! Builds message definitions from the events of an XML reader.
+    class Loader: public Utils::XMLReader::Handler
+    {
+    public:
+      Loader(std::string& version, std::vector<Schema::Definition>& defs):
+        m_version(version),
+        m_defs(defs),
+        m_in_message(false)
+      { }
+
+      void
+      onStartElement(const std::string& name, const Utils::XMLReader::Attributes& attrs)
+      {
+        if (name == "messages")
+        {
+          m_version = Utils::XMLReader::getAttribute(attrs, "version");
+        }
+        else if (name == "message")
+        {
+          Schema::Definition def;
+          def.id = (uint16_t)std::strtoul(Utils::XMLReader::getAttribute(attrs, "id").c_str(), NULL, 10);
+          def.name = Utils::XMLReader::getAttribute(attrs, "name");
+          def.abbrev = Utils::XMLReader::getAttribute(attrs, "abbrev");
+
+          if (def.abbrev.empty())
+            throw InvalidSchema("message without abbreviation");
+
+          m_defs.push_back(def);
+          m_in_message = true;
+        }
+        // Fields outside messages (header and footer) are ignored.
+        else if (name == "field" && m_in_message)
+        {
+          Schema::Field field;
+          field.name = Utils::XMLReader::getAttribute(attrs, "name");
+          field.abbrev = Utils::XMLReader::getAttribute(attrs, "abbrev");
+          field.unit = Utils::XMLReader::getAttribute(attrs, "unit");
+
+          std::string type = Utils::XMLReader::getAttribute(attrs, "type");
+          unsigned i = 0;
+          while (i < c_type_count && type != c_type_names[i])
+            ++i;
+
+          if (i == c_type_count)
+            throw InvalidSchema("unknown type '" + type + "' of field " + m_defs.back().abbrev + "." + field.abbrev);
+
+          field.type = (Schema::Type)i;
+          m_defs.back().fields.push_back(field);
+        }
+      }
+
+      void
+      onEndElement(const std::string& name)
+      {
+        if (name == "message")
+          m_in_message = false;
+      }
+
+    private:
+      //! IMC version.
+      std::string& m_version;
+      //! Message definitions.
+      std::vector<Schema::Definition>& m_defs;
+      //! True while inside a message element.
+      bool m_in_message;
+    };
+
+    //! Order message definitions by identifier.
+    static bool
+    lessById(const Schema::Definition& a, const Schema::Definition& b)
+    {
+      return a.id < b.id;
+    }
+
+    //! Built-in document, decompressed on first use.
+    static std::string* s_document = NULL;
+    //! Lock guarding the built-in document.
+    static Concurrency::Mutex s_document_lock;
+
+    Schema::Schema(void)
+    {
+      const std::string& xml = getDocument();
+      Loader loader(m_version, m_defs);
+      Utils::XMLReader reader(loader);
+
+      try
+      {
+        reader.feed(xml.data(), xml.size());
+        reader.finish();
+      }
+      catch (Utils::ParseError& e)
+      {
+        throw InvalidSchema(e.what());
+      }
+
+      index();
+    }
+
+    Schema::Schema(const std::string& path)
+    {
+      Compression::Methods method = Compression::Factory::detect(path.c_str());
+
+      if (method == Compression::METHOD_UNKNOWN)
+      {
+        std::ifstream ifs(path.c_str(), std::ios::binary);
+        if (!ifs.is_open())
+          throw InvalidSchema("unable to open " + path);
+        parse(ifs);
+      }
+      else
+      {
+        Compression::FileInput ifs(path.c_str(), method);
+        parse(ifs);
+      }
+    }
+
+    const std::string&
+    Schema::getDocument(void)
+    {
+      Concurrency::ScopedMutex l(s_document_lock);
+
+      if (s_document == NULL)
+      {
+        std::istringstream iss(std::string((const char*)Blob::getData(), Blob::getSize()));
+        Compression::StreamBuffer sbuf(&iss, Compression::METHOD_GZIP);
+        std::istream is(&sbuf);
+        s_document = new std::string(readAll(is));
+      }
+
+      return *s_document;
+    }
+
+    const Schema::Definition*
+    Schema::find(uint16_t id) const
+    {
+      std::map<uint16_t, unsigned>::const_iterator itr = m_ids.find(id);
+      return (itr == m_ids.end()) ? NULL : &m_defs[itr->second];
+    }
+
+    unsigned
+    Schema::getSize(Type type)
+    {
+      return c_type_sizes[type];
+    }
+
+    void
+    Schema::parse(std::istream& is)
+    {
+      Loader loader(m_version, m_defs);
+      Utils::XMLReader reader(loader);
+
+      try
+      {
+        reader.read(is);
+      }
+      catch (Utils::ParseError& e)
+      {
+        throw InvalidSchema(e.what());
+      }
+
+      index();
+    }
+
+    void
+    Schema::index(void)
+    {
+      if (m_defs.empty())
+        throw InvalidSchema("no messages");
+
+      std::sort(m_defs.begin(), m_defs.end(), lessById);
+
+      for (unsigned i = 0; i < m_defs.size(); ++i)
+        m_ids[m_defs[i].id] = i;
+    }
+  }
+}
@@ -0,0 +1,162 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_SCHEMA_HPP_INCLUDED_
+#define DUNE_IMC_SCHEMA_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Schema;
+
+    //! Message definitions read from the IMC XML document: names,
+    //! types and units of the payload fields of every message, in
+    //! serialization order. The document is usually the one built
+    //! into DUNE (see Blob) or the IMC.xml.gz copy stored with each
+    //! log.
+    class Schema
+    {
+    public:
+      //! Field types.
+      enum Type
+      {
+        TYPE_INT8,
+        TYPE_UINT8,
+        TYPE_INT16,
+        TYPE_UINT16,
+        TYPE_INT32,
+        TYPE_UINT32,
+        TYPE_INT64,
+        TYPE_FP32,
+        TYPE_FP64,
+        TYPE_RAWDATA,
+        TYPE_PLAINTEXT,
+        TYPE_MESSAGE,
+        TYPE_MESSAGE_LIST
+      };
+
+      //! Payload field.
+      struct Field
+      {
+        //! Field name.
+        std::string name;
+        //! Field abbreviation.
+        std::string abbrev;
+        //! Field type.
+        Type type;
+        //! Unit (empty if none).
+        std::string unit;
+      };
+
+      //! Message definition.
+      struct Definition
+      {
+        //! Message identifier.
+        uint16_t id;
+        //! Message name.
+        std::string name;
+        //! Message abbreviation.
+        std::string abbrev;
+        //! Payload fields, in serialization order.
+        std::vector<Field> fields;
+      };
+
+      //! Read the definitions built into DUNE.
+      Schema(void);
+
+      //! Read the definitions of an IMC XML document.
+      //! @param[in] path path of the document (IMC.xml or
+      //! IMC.xml.gz).
+      Schema(const std::string& path);
+
+      //! Get the IMC XML document built into DUNE. The document is
+      //! decompressed on the first call and kept in memory.
+      //! @return XML document.
+      static const std::string&
+      getDocument(void);
+
+      //! Get the IMC version.
+      //! @return version string.
+      const std::string&
+      getVersion(void) const
+      {
+        return m_version;
+      }
+
+      //! Get all message definitions.
+      //! @return message definitions, sorted by identifier.
+      const std::vector<Definition>&
+      getDefinitions(void) const
+      {
+        return m_defs;
+      }
+
+      //! Find the definition of a message.
+      //! @param[in] id message identifier.
+      //! @return message definition or NULL if the message is not
+      //! defined.
+      const Definition*
+      find(uint16_t id) const;
+
+      //! Get the serialized size of a field type.
+      //! @param[in] type field type.
+      //! @return size in bytes, or 0 for variable size types.
+      static unsigned
+      getSize(Type type);
+
+    private:
+      //! IMC version.
+      std::string m_version;
+      //! Message definitions.
+      std::vector<Definition> m_defs;
+      //! Definition index by message identifier.
+      std::map<uint16_t, unsigned> m_ids;
+
+      //! Parse an IMC XML document as it is read.
+      //! @param[in] is input stream.
+      void
+      parse(std::istream& is);
+
+      //! Sort the definitions and build the identifier index.
+      void
+      index(void);
+    };
+  }
+}
+
+#endif
@@ -127,5 +127,47 @@ namespace DUNE
 
       return s + 2;
     }
+
+    //! Reverse the byte order of 'count' words of type Word. Words
+    //! are accessed through memcpy() and swapped with shifts and
+    //! masks, which compilers turn into byte swap instructions and
+    //! vectorize where possible.
+    template <typename Word>
+    static void
+    reverseWords(uint8_t* data, unsigned count)
+    {
+      for (unsigned i = 0; i < count; ++i, data += sizeof(Word))
+      {
+        Word w;
+        std::memcpy(&w, data, sizeof(Word));
+
+        Word r = 0;
+        for (unsigned b = 0; b < sizeof(Word); ++b)
+          r |= ((w >> (b * 8)) & 0xff) << ((sizeof(Word) - 1 - b) * 8);
+
+        std::memcpy(data, &r, sizeof(Word));
+      }
+    }
+
+    void
+    reverseBlock(void* data, unsigned size, unsigned count)
+    {
+      uint8_t* ptr = static_cast<uint8_t*>(data);
+
+      switch (size)
+      {
+        case 2:
+          reverseWords<uint16_t>(ptr, count);
+          break;
+        case 4:
+          reverseWords<uint32_t>(ptr, count);
+          break;
+        case 8:
+          reverseWords<uint64_t>(ptr, count);
+          break;
+        default:
+          break;
+      }
+    }
   }
 }
@@ -39,6 +39,12 @@
 #include <DUNE/IMC/Message.hpp>
 #include <DUNE/IMC/Factory.hpp>
 
+//! Packed sequences of scalar fields can be (de)serialized with a
+//! single copy unless double precision values need to be rearranged.
+#if !defined(DUNE_CPU_MIXED_ENDIAN_DOUBLES)
+#  define DUNE_IMC_BULK_SERIALIZATION
+#endif
+
 namespace DUNE
 {
   namespace IMC
@@ -167,6 +173,60 @@ namespace DUNE
       return size;
     }
 
+    //! Test if a sequence of consecutive fields, starting at 'first'
+    //! and ending at 'last', occupies exactly 'size' bytes of memory,
+    //! i.e., the fields are laid out without padding in the same way
+    //! as they are serialized.
+    //! @param first address of the first field.
+    //! @param last address of the last field.
+    //! @param last_size size of the last field.
+    //! @param size serialized size of the sequence of fields.
+    //! @return true if the fields are packed, false otherwise.
+    inline bool
+    isPacked(const void* first, const void* last, unsigned last_size, unsigned size)
+    {
+      return ((const uint8_t*)last + last_size) - (const uint8_t*)first == (long)size;
+    }
+
+    //! Serialize a sequence of packed fields with a single copy.
+    //! @param data address of the first field.
+    //! @param size serialized size of the sequence of fields.
+    //! @param bfr buffer where to place the serialized bytes.
+    //! @return number of serialized bytes.
+    inline uint16_t
+    serializeBlock(const void* data, uint16_t size, uint8_t* bfr)
+    {
+      std::memcpy(bfr, data, size);
+      return size;
+    }
+
+    //! Deserialize a sequence of packed fields with a single copy.
+    //! @param data address of the first field.
+    //! @param size serialized size of the sequence of fields.
+    //! @param bfr buffer where to read the serialized bytes.
+    //! @param length amount of bytes available to deserialize.
+    //! @return number of deserialized bytes.
+    //! @throw BufferTooShort
+    inline uint16_t
+    deserializeBlock(void* data, uint16_t size, const uint8_t* bfr, uint16_t& length)
+    {
+      if (length < size)
+        throw BufferTooShort();
+
+      std::memcpy(data, bfr, size);
+      length -= size;
+
+      return size;
+    }
+
+    //! Reverse, in place, the byte order of consecutive fields with
+    //! the same size.
+    //! @param data address of the first field.
+    //! @param size size of each field (2, 4 or 8 bytes).
+    //! @param count number of fields.
+    void
+    reverseBlock(void* data, unsigned size, unsigned count);
+
     uint16_t
     reverseDeserialize(std::string& t, const uint8_t* bfr, uint16_t& length);
 
@@ -0,0 +1,172 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef DUNE_IMC_SHARED_MESSAGE_HPP_INCLUDED_
+#define DUNE_IMC_SHARED_MESSAGE_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/AtomicCounter.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM SharedMessage;
+
+    //! Immutable, reference-counted message handle. The message bus
+    //! creates one handle per dispatched message and hands it out to
+    //! every recipient, which avoids cloning the message once per
+    //! subscriber. Consumers that need a mutable copy must explicitly
+    //! call clone().
+    class SharedMessage
+    {
+    public:
+      //! Create a new handle holding a private copy of a message.
+      //! The reference count of the new handle is 1.
+      //! @param[in] msg message to copy.
+      //! @return new message handle.
+      static SharedMessage*
+      create(const Message* msg)
+      {
+        return new SharedMessage(msg->clone());
+      }
+
+      //! Create a new handle that takes ownership of a message.
+      //! The reference count of the new handle is 1.
+      //! @param[in] msg message whose ownership is transferred.
+      //! @return new message handle.
+      static SharedMessage*
+      adopt(Message* msg)
+      {
+        return new SharedMessage(msg);
+      }
+
+      //! Increment the reference count.
+      //! @return this handle.
+      SharedMessage*
+      acquire(void)
+      {
+        m_refs.add(1);
+        return this;
+      }
+
+      //! Decrement the reference count, destroying the handle and
+      //! the message when the last reference is released.
+      void
+      release(void)
+      {
+        if (m_refs.sub(1) == 0)
+          delete this;
+      }
+
+      //! Test if the handle is referenced by someone else, e.g., by
+      //! recipients that did not consume the message yet.
+      //! @return true if there are other references, false otherwise.
+      bool
+      isShared(void)
+      {
+        return m_refs.add(0) > 1;
+      }
+
+      //! Retrieve the shared message.
+      //! @return pointer to immutable message.
+      const Message*
+      get(void) const
+      {
+        return m_msg;
+      }
+
+      //! Retrieve the message identification number.
+      //! @return message identification number.
+      uint16_t
+      getId(void) const
+      {
+        return m_msg->getId();
+      }
+
+      //! Retrieve a mutable copy of the shared message.
+      //! @return message copy (owned by the caller).
+      Message*
+      clone(void) const
+      {
+        return m_msg->clone();
+      }
+
+      //! Retrieve the monotonic time at which the handle was created,
+      //! i.e., when the message was dispatched.
+      //! @return creation time (s).
+      double
+      getCreationTime(void) const
+      {
+        return m_time;
+      }
+
+      //! Set the creation time to the current time. Used when a
+      //! recycled handle is dispatched again.
+      void
+      resetCreationTime(void)
+      {
+        m_time = Time::Clock::get();
+      }
+
+    private:
+      //! Shared message.
+      Message* m_msg;
+      //! Reference count.
+      Concurrency::AtomicCounter m_refs;
+      //! Creation time.
+      double m_time;
+
+      SharedMessage(Message* msg):
+        m_msg(msg),
+        m_refs(1),
+        m_time(Time::Clock::get())
+      {
+        m_msg->enableSerializationCache();
+      }
+
+      ~SharedMessage(void)
+      {
+        delete m_msg;
+      }
+
+      //! Non - copyable.
+      SharedMessage(SharedMessage const&);
+
+      //! Non - assignable.
+      SharedMessage&
+      operator=(SharedMessage const&);
+    };
+  }
+}
+
+#endif
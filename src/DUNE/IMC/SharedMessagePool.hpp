@@ -0,0 +1,149 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_SHARED_MESSAGE_POOL_HPP_INCLUDED_
+#define DUNE_IMC_SHARED_MESSAGE_POOL_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Small pool of shared message handles of one type, meant for
+    //! producers of large messages (sonar pings, images). A handle is
+    //! reused once every recipient released it, so the message and
+    //! its payload buffers are allocated once and dispatched without
+    //! being cloned by the bus. The pool is not thread-safe; it is
+    //! meant to be owned by a single producer.
+    template <typename T>
+    class SharedMessagePool
+    {
+    public:
+      //! Constructor.
+      //! @param[in] size maximum number of handles kept by the pool.
+      SharedMessagePool(size_t size = 4):
+        m_size(size),
+        m_next(0)
+      { }
+
+      //! Destructor. Handles still referenced by recipients are freed
+      //! by the last of them.
+      ~SharedMessagePool(void)
+      {
+        for (size_t i = 0; i < m_handles.size(); ++i)
+          m_handles[i]->release();
+      }
+
+      //! Retrieve a handle whose message is referenced only by this
+      //! pool and may therefore be modified. When every handle is
+      //! still in use and the pool is full, the oldest handle is
+      //! left to its recipients and replaced by a new one.
+      //! @return message handle owned by the pool.
+      SharedMessage*
+      take(void)
+      {
+        for (size_t i = 0; i < m_handles.size(); ++i)
+        {
+          if (!m_handles[i]->isShared())
+          {
+            get(m_handles[i])->clearSerializationCache();
+            return m_handles[i];
+          }
+        }
+
+        SharedMessage* handle = SharedMessage::adopt(new T);
+        if (m_handles.size() < m_size)
+        {
+          m_handles.push_back(handle);
+          return handle;
+        }
+
+        m_handles[m_next]->release();
+        m_handles[m_next] = handle;
+        m_next = (m_next + 1) % m_size;
+        return handle;
+      }
+
+      //! Retrieve a handle holding a copy of a message whose payload
+      //! is moved, not copied, from the source message. On return the
+      //! source payload holds a recycled buffer of the same size and
+      //! unspecified contents that the producer can refill.
+      //! @param[in,out] source message to copy.
+      //! @param[in] payload payload field of the message.
+      //! @return message handle owned by the pool.
+      SharedMessage*
+      take(T& source, std::vector<char> T::* payload)
+      {
+        SharedMessage* handle = take();
+        T* msg = get(handle);
+
+        std::vector<char> data;
+        data.swap(source.*payload);
+        size_t size = data.size();
+        *msg = source;
+        (msg->*payload).swap(data);
+        (source.*payload).swap(data);
+        (source.*payload).resize(size);
+
+        return handle;
+      }
+
+      //! Retrieve the mutable message of a handle returned by take().
+      //! @param[in] handle message handle.
+      //! @return message.
+      static T*
+      get(SharedMessage* handle)
+      {
+        return static_cast<T*>(const_cast<Message*>(handle->get()));
+      }
+
+    private:
+      //! Maximum number of handles.
+      size_t m_size;
+      //! Next handle to replace when the pool is exhausted.
+      size_t m_next;
+      //! Handles.
+      std::vector<SharedMessage*> m_handles;
+
+      //! Non-copyable.
+      SharedMessagePool(const SharedMessagePool&);
+
+      //! Non-assignable.
+      SharedMessagePool&
+      operator=(const SharedMessagePool&);
+    };
+  }
+}
+
+#endif
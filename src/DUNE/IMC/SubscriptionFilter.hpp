@@ -0,0 +1,181 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_SUBSCRIPTION_FILTER_HPP_INCLUDED_
+#define DUNE_IMC_SUBSCRIPTION_FILTER_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM SubscriptionFilter;
+
+    //! Selects which messages of a given type are delivered to a
+    //! subscriber. Filters are evaluated by the message bus before
+    //! a message is queued, so rejected messages are never copied.
+    //! An empty filter matches all messages. Setters return the
+    //! filter itself so they can be chained in a bind call.
+    class SubscriptionFilter
+    {
+    public:
+      SubscriptionFilter(void):
+        m_mask(0),
+        m_src(0),
+        m_src_ent(0),
+        m_dst(0),
+        m_sub_id(0),
+        m_interval(0)
+      { }
+
+      //! Match only messages originating from a given system.
+      //! @param[in] src source system address.
+      //! @return this filter.
+      SubscriptionFilter&
+      setSource(uint16_t src)
+      {
+        m_src = src;
+        m_mask |= FLT_SOURCE;
+        return *this;
+      }
+
+      //! Match only messages originating from a given entity.
+      //! @param[in] ent source entity identifier.
+      //! @return this filter.
+      SubscriptionFilter&
+      setSourceEntity(uint8_t ent)
+      {
+        m_src_ent = ent;
+        m_mask |= FLT_SOURCE_ENTITY;
+        return *this;
+      }
+
+      //! Match only messages addressed to a given system.
+      //! @param[in] dst destination system address.
+      //! @return this filter.
+      SubscriptionFilter&
+      setDestination(uint16_t dst)
+      {
+        m_dst = dst;
+        m_mask |= FLT_DESTINATION;
+        return *this;
+      }
+
+      //! Match only messages with a given sub identification number
+      //! (see Message::getSubId).
+      //! @param[in] sub_id sub identification number.
+      //! @return this filter.
+      SubscriptionFilter&
+      setSubId(uint16_t sub_id)
+      {
+        m_sub_id = sub_id;
+        m_mask |= FLT_SUB_ID;
+        return *this;
+      }
+
+      //! Deliver at most one message per origin (source system,
+      //! source entity and sub-ID) in a given interval. Messages
+      //! arriving earlier are dropped by the bus before being copied.
+      //! @param[in] interval minimum interval in seconds (0 to
+      //! disable).
+      //! @return this filter.
+      SubscriptionFilter&
+      setMinimumInterval(double interval)
+      {
+        m_interval = interval;
+        return *this;
+      }
+
+      //! Get the minimum interval between delivered messages.
+      //! @return minimum interval in seconds.
+      double
+      getMinimumInterval(void) const
+      {
+        return m_interval;
+      }
+
+      //! Test if the filter matches all messages.
+      //! @return true if no criteria were set, false otherwise.
+      bool
+      empty(void) const
+      {
+        return m_mask == 0 && m_interval <= 0;
+      }
+
+      //! Test a message against the header criteria. The minimum
+      //! interval is enforced by the message bus.
+      //! @param[in] msg message.
+      //! @return true if the message matches, false otherwise.
+      bool
+      matches(const Message* msg) const
+      {
+        if ((m_mask & FLT_SOURCE_ENTITY) && msg->getSourceEntity() != m_src_ent)
+          return false;
+
+        if ((m_mask & FLT_SOURCE) && msg->getSource() != m_src)
+          return false;
+
+        if ((m_mask & FLT_DESTINATION) && msg->getDestination() != m_dst)
+          return false;
+
+        if ((m_mask & FLT_SUB_ID) && msg->getSubId() != m_sub_id)
+          return false;
+
+        return true;
+      }
+
+    private:
+      //! Criteria flags.
+      enum Flags
+      {
+        FLT_SOURCE = 0x01,
+        FLT_SOURCE_ENTITY = 0x02,
+        FLT_DESTINATION = 0x04,
+        FLT_SUB_ID = 0x08
+      };
+
+      //! Criteria in use.
+      unsigned m_mask;
+      //! Source system.
+      uint16_t m_src;
+      //! Source entity.
+      uint8_t m_src_ent;
+      //! Destination system.
+      uint16_t m_dst;
+      //! Sub identification number.
+      uint16_t m_sub_id;
+      //! Minimum interval between delivered messages.
+      double m_interval;
+    };
+  }
+}
+
+#endif
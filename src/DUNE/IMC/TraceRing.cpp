@@ -0,0 +1,270 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/IMC/TraceRing.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+// POSIX headers.
+#if defined(DUNE_OS_POSIX)
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+// Check if we can use GCC's atomic functions.
+#if defined(DUNE_SYS_HAS___SYNC_ADD_AND_FETCH) && defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  define DUNE_IMC_TRACE_RING_GCC
+#endif
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    TraceRing dune_trace;
+
+    //! Number of records written at once when dumping.
+    static const unsigned c_dump_batch = 64;
+
+    //! Full memory barrier.
+    static inline void
+    barrier(void)
+    {
+#if defined(DUNE_IMC_TRACE_RING_GCC)
+      __sync_synchronize();
+#endif
+    }
+
+    //! Output file written with async-signal-safe functions where
+    //! available.
+    class DumpFile
+    {
+    public:
+      DumpFile(const char* fname):
+        m_ok(true)
+      {
+#if defined(DUNE_OS_POSIX)
+        m_fd = ::open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        m_ok = (m_fd >= 0);
+#else
+        m_file = std::fopen(fname, "wb");
+        m_ok = (m_file != NULL);
+#endif
+      }
+
+      ~DumpFile(void)
+      {
+#if defined(DUNE_OS_POSIX)
+        if (m_fd >= 0)
+          ::close(m_fd);
+#else
+        if (m_file != NULL)
+          std::fclose(m_file);
+#endif
+      }
+
+      bool
+      write(const void* data, size_t size)
+      {
+        if (!m_ok)
+          return false;
+
+#if defined(DUNE_OS_POSIX)
+        const char* ptr = static_cast<const char*>(data);
+        while (size > 0)
+        {
+          ssize_t rv = ::write(m_fd, ptr, size);
+          if (rv <= 0)
+          {
+            m_ok = false;
+            break;
+          }
+
+          ptr += rv;
+          size -= rv;
+        }
+#else
+        m_ok = (std::fwrite(data, 1, size, m_file) == size);
+#endif
+
+        return m_ok;
+      }
+
+    private:
+      bool m_ok;
+#if defined(DUNE_OS_POSIX)
+      int m_fd;
+#else
+      std::FILE* m_file;
+#endif
+    };
+
+    TraceRing::TraceRing(unsigned capacity):
+      m_head(0),
+      m_channels(0)
+    {
+      unsigned size = 2;
+      while (size < capacity)
+        size <<= 1;
+
+      m_records = new Record[size];
+      std::memset(m_records, 0, size * sizeof(Record));
+      std::memset(m_names, 0, sizeof(m_names));
+      m_mask = size - 1;
+    }
+
+    TraceRing::~TraceRing(void)
+    {
+      delete [] m_records;
+    }
+
+    uint8_t
+    TraceRing::getChannel(const std::string& name)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+
+      for (unsigned i = 0; i < m_channels; ++i)
+      {
+        if (std::strncmp(m_names[i], name.c_str(), c_channel_name_size - 1) == 0)
+          return i;
+      }
+
+      if (m_channels >= c_max_channels)
+        return c_unknown_channel;
+
+      std::strncpy(m_names[m_channels], name.c_str(), c_channel_name_size - 1);
+      barrier();
+      return m_channels++;
+    }
+
+    void
+    TraceRing::record(const Message* msg, uint8_t channel, Direction direction, unsigned size)
+    {
+#if defined(DUNE_IMC_TRACE_RING_GCC)
+      uint32_t ticket = __sync_add_and_fetch(&m_head, 1) - 1;
+#else
+      Concurrency::ScopedMutex l(m_lock);
+      uint32_t ticket = m_head++;
+#endif
+
+      Record& r = m_records[ticket & m_mask];
+      r.sequence = 0;
+      barrier();
+
+      r.time = Time::Clock::getSinceEpoch();
+      r.msg_time = msg->getTimeStamp();
+      r.id = msg->getId();
+      r.src = msg->getSource();
+      r.dst = msg->getDestination();
+      r.size = (size > 0xffff) ? 0xffff : size;
+      r.src_ent = msg->getSourceEntity();
+      r.dst_ent = msg->getDestinationEntity();
+      r.channel = channel;
+      r.direction = direction;
+
+      barrier();
+      r.sequence = ticket + 1;
+    }
+
+    bool
+    TraceRing::read(uint32_t ticket, Record& record) const
+    {
+      const Record& r = m_records[ticket & m_mask];
+      const volatile uint32_t* sequence = &r.sequence;
+
+      barrier();
+      if (*sequence != ticket + 1)
+        return false;
+
+      std::memcpy(&record, &r, sizeof(Record));
+
+      barrier();
+      return *sequence == ticket + 1;
+    }
+
+    unsigned
+    TraceRing::copy(Record* records) const
+    {
+      uint32_t head = m_head;
+      uint32_t first = (head > capacity()) ? head - capacity() : 0;
+      unsigned count = 0;
+
+      for (uint32_t ticket = first; ticket != head; ++ticket)
+      {
+        if (read(ticket, records[count]))
+          ++count;
+      }
+
+      return count;
+    }
+
+    bool
+    TraceRing::dump(const char* fname) const
+    {
+      DumpFile file(fname);
+
+      uint32_t head = m_head;
+      uint32_t first = (head > capacity()) ? head - capacity() : 0;
+
+      FileHeader hdr;
+      std::memcpy(hdr.magic, "DTRC", 4);
+      hdr.version = c_version;
+      hdr.channels = m_channels;
+      hdr.records = head - first;
+
+      if (!file.write(&hdr, sizeof(hdr)))
+        return false;
+
+      if (!file.write(m_names, hdr.channels * c_channel_name_size))
+        return false;
+
+      // Records being written are dumped zeroed.
+      Record batch[c_dump_batch];
+      unsigned count = 0;
+
+      for (uint32_t ticket = first; ticket != head; ++ticket)
+      {
+        if (!read(ticket, batch[count]))
+          std::memset(&batch[count], 0, sizeof(Record));
+
+        if (++count == c_dump_batch)
+        {
+          if (!file.write(batch, count * sizeof(Record)))
+            return false;
+          count = 0;
+        }
+      }
+
+      return file.write(batch, count * sizeof(Record));
+    }
+  }
+}
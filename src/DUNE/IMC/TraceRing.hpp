@@ -0,0 +1,207 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IMC_TRACE_RING_HPP_INCLUDED_
+#define DUNE_IMC_TRACE_RING_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM TraceRing;
+
+    //! In-memory flight recorder of message traffic. Each traced
+    //! message is stored as a compact record of its header, the
+    //! channel (usually a task) and the direction. Records are kept
+    //! in a fixed ring that overwrites the oldest records, can be
+    //! written concurrently without locks and can be dumped at any
+    //! time, including from a signal handler.
+    //!
+    //! Dump files start with a header (magic 'DTRC', format version,
+    //! number of channels, number of records), followed by the
+    //! channel names and the records, oldest first, all in host byte
+    //! order. Use dune-tracedump to decode them.
+    class TraceRing
+    {
+    public:
+      //! Direction of a traced message.
+      enum Direction
+      {
+        //! Incoming message.
+        DIR_IN = 0,
+        //! Outgoing message.
+        DIR_OUT = 1
+      };
+
+      //! Trace record.
+      struct Record
+      {
+        //! Time at which the record was written (s since epoch).
+        double time;
+        //! Message timestamp.
+        double msg_time;
+        //! Ticket of the record plus one, zero while being written.
+        uint32_t sequence;
+        //! Message identification number.
+        uint16_t id;
+        //! Source address.
+        uint16_t src;
+        //! Destination address.
+        uint16_t dst;
+        //! Serialized size (zero if unknown).
+        uint16_t size;
+        //! Source entity.
+        uint8_t src_ent;
+        //! Destination entity.
+        uint8_t dst_ent;
+        //! Channel.
+        uint8_t channel;
+        //! Direction.
+        uint8_t direction;
+      };
+
+      //! File header of a dump.
+      struct FileHeader
+      {
+        //! Magic ('DTRC').
+        char magic[4];
+        //! Format version.
+        uint16_t version;
+        //! Number of channel names.
+        uint16_t channels;
+        //! Number of records.
+        uint32_t records;
+      };
+
+      //! Maximum number of channels.
+      static const unsigned c_max_channels = 64;
+      //! Size of a channel name in dump files.
+      static const unsigned c_channel_name_size = 48;
+      //! Channel of records whose channel could not be registered.
+      static const uint8_t c_unknown_channel = 0xff;
+      //! Dump format version.
+      static const uint16_t c_version = 1;
+
+      //! Constructor.
+      //! @param[in] capacity number of records kept (rounded up to
+      //! the next power of two).
+      TraceRing(unsigned capacity = 4096);
+
+      //! Destructor.
+      ~TraceRing(void);
+
+      //! Retrieve the channel of a given name, registering it if
+      //! needed.
+      //! @param[in] name channel name (e.g. task name).
+      //! @return channel or c_unknown_channel if there are too many
+      //! channels.
+      uint8_t
+      getChannel(const std::string& name);
+
+      //! Record a message.
+      //! @param[in] msg message.
+      //! @param[in] channel channel returned by getChannel().
+      //! @param[in] direction direction.
+      //! @param[in] size serialized size, if known.
+      void
+      record(const Message* msg, uint8_t channel, Direction direction, unsigned size = 0);
+
+      //! Retrieve the number of records written so far.
+      //! @return number of records.
+      uint32_t
+      getCount(void) const
+      {
+        return m_head;
+      }
+
+      //! Copy the current records, oldest first.
+      //! @param[out] records output array with room for capacity()
+      //! records.
+      //! @return number of records copied.
+      unsigned
+      copy(Record* records) const;
+
+      //! Retrieve the number of records kept.
+      //! @return capacity.
+      unsigned
+      capacity(void) const
+      {
+        return m_mask + 1;
+      }
+
+      //! Write the current records to a file. Only async-signal-safe
+      //! functions are used, so this can be called from a signal
+      //! handler.
+      //! @param[in] fname file name.
+      //! @return true on success, false otherwise.
+      bool
+      dump(const char* fname) const;
+
+    private:
+      //! Ring of records.
+      Record* m_records;
+      //! Index mask.
+      uint32_t m_mask;
+      //! Number of records written.
+      volatile uint32_t m_head;
+      //! Channel names.
+      char m_names[c_max_channels][c_channel_name_size];
+      //! Number of channels.
+      volatile unsigned m_channels;
+      //! Lock for channel registration and for systems without
+      //! atomic builtins.
+      Concurrency::Mutex m_lock;
+
+      //! Copy a record if it is complete.
+      //! @param[in] ticket record ticket.
+      //! @param[out] record copy.
+      //! @return true if the record was copied, false otherwise.
+      bool
+      read(uint32_t ticket, Record& record) const;
+
+      // Non-copyable.
+      TraceRing(const TraceRing&);
+
+      TraceRing&
+      operator=(const TraceRing&);
+    };
+
+    //! Process-wide message trace.
+    DUNE_DLL_SYM extern TraceRing dune_trace;
+  }
+}
+
+#endif
@@ -37,5 +37,7 @@ namespace DUNE
 
 #include <DUNE/IO/Handle.hpp>
 #include <DUNE/IO/Poll.hpp>
+#include <DUNE/IO/Reactor.hpp>
+#include <DUNE/IO/Timer.hpp>
 
 #endif
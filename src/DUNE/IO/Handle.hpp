@@ -34,6 +34,7 @@
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Time/Clock.hpp>
 
 namespace DUNE
 {
@@ -48,6 +49,11 @@ namespace DUNE
     class Handle
     {
     public:
+      //! Constructor.
+      Handle(void):
+        m_read_tstamp(-1)
+      { }
+
       //! Destructor.
       virtual
       ~Handle(void)
@@ -89,7 +95,11 @@ namespace DUNE
       size_t
       read(uint8_t* data, size_t length)
       {
-        return doRead(data, length);
+        m_read_tstamp = -1;
+        size_t rv = doRead(data, length);
+        if (rv > 0 && m_read_tstamp < 0)
+          m_read_tstamp = Time::Clock::getSinceEpoch();
+        return rv;
       }
 
       //! Read binary data from I/O handle.
@@ -143,7 +153,28 @@ namespace DUNE
         return doGetNative();
       }
 
+      //! Retrieve the reception time of the data returned by the last
+      //! successful read. Implementations that can query the kernel
+      //! for the time of arrival report that time, otherwise the time
+      //! at which the read returned is used.
+      //! @return reception time in seconds since the UNIX Epoch, or
+      //! a negative number if no data was read yet.
+      double
+      getReadTimeStamp(void) const
+      {
+        return m_read_tstamp;
+      }
+
     protected:
+      //! Set the reception time of the data being read.
+      //! @param[in] tstamp reception time in seconds since the UNIX
+      //! Epoch.
+      void
+      setReadTimeStamp(double tstamp)
+      {
+        m_read_tstamp = tstamp;
+      }
+
       virtual NativeHandle
       doGetNative(void) const = 0;
 
@@ -167,6 +198,10 @@ namespace DUNE
         doFlushOutput();
         doFlushInput();
       }
+
+    private:
+      //! Reception time of the last read data.
+      double m_read_tstamp;
     };
   }
 }
@@ -28,6 +28,8 @@
 // ISO C++ 98 headers.
 #include <algorithm>
 #include <cstring>
+#include <cerrno>
+#include <cmath>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -36,6 +38,23 @@
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/IO/Poll.hpp>
 
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_POLL_H)
+#  include <poll.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+#if defined(DUNE_IO_POLL_EPOLL)
+#  include <sys/epoll.h>
+#elif defined(DUNE_IO_POLL_KQUEUE)
+#  include <sys/types.h>
+#  include <sys/event.h>
+#  include <sys/time.h>
+#endif
+
 namespace DUNE
 {
   namespace IO
@@ -43,9 +62,47 @@ namespace DUNE
     using std::memset;
     using System::Error;
 
+    //! Pending events retrieved per system call.
+    static const int c_max_events = 64;
+
+    Poll::Poll(void)
+    {
+#if defined(DUNE_IO_POLL_EPOLL)
+      m_queue = epoll_create(c_max_events);
+#elif defined(DUNE_IO_POLL_KQUEUE)
+      m_queue = kqueue();
+#endif
+
+#if defined(DUNE_IO_POLL_EPOLL) || defined(DUNE_IO_POLL_KQUEUE)
+      if (m_queue == -1)
+        throw Error("creating event queue", Error::getLastMessage());
+#endif
+    }
+
+    Poll::~Poll(void)
+    {
+#if defined(DUNE_IO_POLL_EPOLL) || defined(DUNE_IO_POLL_KQUEUE)
+      close(m_queue);
+#endif
+    }
+
     void
     Poll::add(const NativeHandle& handle)
     {
+#if defined(DUNE_IO_POLL_EPOLL)
+      epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = EPOLLIN;
+      ev.data.fd = handle;
+      if (epoll_ctl(m_queue, EPOLL_CTL_ADD, handle, &ev) == -1 && errno != EEXIST)
+        throw Error("adding handle to event queue", Error::getLastMessage());
+#elif defined(DUNE_IO_POLL_KQUEUE)
+      struct kevent ev;
+      EV_SET(&ev, handle, EVFILT_READ, EV_ADD, 0, 0, NULL);
+      if (kevent(m_queue, &ev, 1, NULL, 0, NULL) == -1)
+        throw Error("adding handle to event queue", Error::getLastMessage());
+#endif
+
       m_handles.push_back(handle);
     }
 
@@ -54,14 +111,39 @@ namespace DUNE
     {
       std::vector<NativeHandle>::iterator itr;
       itr = std::find(m_handles.begin(), m_handles.end(), handle);
-      if (itr != m_handles.end())
-        m_handles.erase(itr);
+      if (itr == m_handles.end())
+        return;
+
+      m_handles.erase(itr);
+
+#if defined(DUNE_IO_POLL_EPOLL) || defined(DUNE_IO_POLL_KQUEUE)
+      // Handles may have been added more than once.
+      if (std::find(m_handles.begin(), m_handles.end(), handle) != m_handles.end())
+        return;
+
+      // Closed handles are removed by the kernel, ignore errors.
+#  if defined(DUNE_IO_POLL_EPOLL)
+      epoll_event ev;
+      epoll_ctl(m_queue, EPOLL_CTL_DEL, handle, &ev);
+#  else
+      struct kevent ev;
+      EV_SET(&ev, handle, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+      kevent(m_queue, &ev, 1, NULL, 0, NULL);
+#  endif
+
+      itr = std::lower_bound(m_triggered.begin(), m_triggered.end(), handle);
+      if (itr != m_triggered.end() && *itr == handle)
+        m_triggered.erase(itr);
+#endif
     }
 
     bool
     Poll::wasTriggered(const NativeHandle& handle)
     {
-#if defined(DUNE_OS_POSIX)
+#if defined(DUNE_IO_POLL_EPOLL) || defined(DUNE_IO_POLL_KQUEUE)
+      return std::binary_search(m_triggered.begin(), m_triggered.end(), handle);
+
+#elif defined(DUNE_OS_POSIX)
       // Only the triggered fd's remain in the set after select() exits.
       return FD_ISSET(handle, &m_rfd) != 0;
 
@@ -99,6 +181,40 @@ namespace DUNE
 
       return false;
 
+#elif defined(DUNE_IO_POLL_EPOLL) || defined(DUNE_IO_POLL_KQUEUE)
+      m_triggered.clear();
+
+#  if defined(DUNE_IO_POLL_EPOLL)
+      epoll_event events[c_max_events];
+      int msec = (timeout < 0.0) ? -1 : (int)std::ceil(timeout * 1000.0);
+      int rv = epoll_wait(m_queue, events, c_max_events, msec);
+#  else
+      struct kevent events[c_max_events];
+      timespec ts = DUNE_TIMESPEC_INIT_SEC_FP(timeout);
+      int rv = kevent(m_queue, NULL, 0, events, c_max_events, (timeout < 0.0) ? NULL : &ts);
+#  endif
+
+      if (rv == -1)
+      {
+        //! Workaround for when we are interrupted by a signal.
+        if (errno == EINTR)
+          return false;
+        else
+          throw Error("polling handle", Error::getLastMessage());
+      }
+
+      for (int i = 0; i < rv; ++i)
+      {
+#  if defined(DUNE_IO_POLL_EPOLL)
+        m_triggered.push_back(events[i].data.fd);
+#  else
+        m_triggered.push_back(events[i].ident);
+#  endif
+      }
+
+      std::sort(m_triggered.begin(), m_triggered.end());
+      return rv > 0;
+
 #elif defined(DUNE_OS_POSIX)
       int rv = 0;
       NativeHandle max = 0;
@@ -141,6 +257,26 @@ namespace DUNE
       DWORD rv = WaitForSingleObjectEx(handle, timeout * 1000, FALSE);
       return rv == WAIT_OBJECT_0;
 
+#elif defined(DUNE_SYS_HAS_POLL_H)
+      pollfd pfd;
+      pfd.fd = handle;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+
+      int msec = (timeout < 0.0) ? -1 : (int)std::ceil(timeout * 1000.0);
+      int rv = ::poll(&pfd, 1, msec);
+
+      if (rv == -1)
+      {
+        //! Workaround for when we are interrupted by a signal.
+        if (errno == EINTR)
+          return false;
+        else
+          throw Error("polling handle", Error::getLastMessage());
+      }
+
+      return rv > 0;
+
 #elif defined(DUNE_OS_POSIX)
       fd_set rfd;
       FD_ZERO(&rfd);
@@ -35,6 +35,13 @@
 #include <DUNE/Config.hpp>
 #include <DUNE/IO/Handle.hpp>
 
+// Select the backend of pools of handles.
+#if defined(DUNE_SYS_HAS_SYS_EPOLL_H)
+#  define DUNE_IO_POLL_EPOLL
+#elif defined(DUNE_SYS_HAS_SYS_EVENT_H)
+#  define DUNE_IO_POLL_KQUEUE
+#endif
+
 // POSIX headers.
 #if defined(DUNE_OS_POSIX)
 #  include <sys/select.h>
@@ -47,9 +54,18 @@ namespace DUNE
     // Export symbol.
     class DUNE_DLL_SYM Poll;
 
+    //! Readiness notification of I/O handles. On Linux pools of
+    //! handles are backed by epoll and on BSD/macOS by kqueue, with
+    //! select() as fallback. Notification is level-triggered.
     class Poll
     {
     public:
+      //! Constructor.
+      Poll(void);
+
+      //! Destructor.
+      ~Poll(void);
+
       static bool
       poll(const NativeHandle& handle, double timeout);
 
@@ -85,12 +101,20 @@ namespace DUNE
         remove(handle.getNative());
       }
 
+      //! Wait for any handle of the polling pool to become readable.
+      //! @param[in] timeout maximum amount of time to wait (negative
+      //! to wait forever).
+      //! @return true if at least one handle is readable.
       bool
       poll(double timeout);
-      
+
+      //! Check if a handle was found readable by the last call to
+      //! poll().
+      //! @param[in] handle native I/O handle.
+      //! @return true if the handle is readable.
       bool
       wasTriggered(const NativeHandle& handle);
-      
+
       bool
       wasTriggered(const Handle& handle)
       {
@@ -100,11 +124,23 @@ namespace DUNE
     private:
       //! List of native I/O handles.
       std::vector<NativeHandle> m_handles;
-#if defined(DUNE_OS_POSIX)
+#if defined(DUNE_IO_POLL_EPOLL) || defined(DUNE_IO_POLL_KQUEUE)
+      //! Kernel event queue.
+      int m_queue;
+      //! Handles found readable by the last poll (sorted).
+      std::vector<NativeHandle> m_triggered;
+#elif defined(DUNE_OS_POSIX)
       fd_set m_rfd;
 #elif defined(DUNE_OS_WINDOWS)
       DWORD m_rv;
 #endif
+
+      //! Non-copyable.
+      Poll(const Poll&);
+
+      //! Non-assignable.
+      Poll&
+      operator=(const Poll&);
     };
   }
 }
@@ -0,0 +1,185 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/IO/Reactor.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+namespace DUNE
+{
+  namespace IO
+  {
+    //! Size of the read buffer.
+    static const size_t c_buffer_size = 4096;
+    //! Maximum time between registry updates (s).
+    static const double c_poll_period = 0.1;
+
+    Reactor::Reactor(void):
+      m_buffer(c_buffer_size),
+      m_started(false)
+    { }
+
+    Reactor::~Reactor(void)
+    {
+      if (m_started)
+        stopAndJoin();
+    }
+
+    Reactor&
+    Reactor::getShared(void)
+    {
+      static Reactor s_reactor;
+      return s_reactor;
+    }
+
+    void
+    Reactor::add(Handle& handle, Listener* listener)
+    {
+      Concurrency::ScopedMutex l(m_mutex);
+
+      Entry entry;
+      entry.handle = &handle;
+      entry.listener = listener;
+      entry.polled = false;
+      m_entries[handle.getNative()] = entry;
+
+      if (!m_started)
+      {
+        m_started = true;
+        start();
+      }
+    }
+
+    void
+    Reactor::remove(Handle& handle)
+    {
+      Concurrency::ScopedMutex l(m_mutex);
+
+      std::map<NativeHandle, Entry>::iterator itr = m_entries.find(handle.getNative());
+      if (itr == m_entries.end())
+        return;
+
+      if (itr->second.polled)
+        m_removed.push_back(itr->first);
+      m_entries.erase(itr);
+    }
+
+    void
+    Reactor::updatePool(void)
+    {
+      Concurrency::ScopedMutex l(m_mutex);
+
+      for (size_t i = 0; i < m_removed.size(); ++i)
+        m_poll.remove(m_removed[i]);
+      m_removed.clear();
+
+      std::map<NativeHandle, Entry>::iterator itr = m_entries.begin();
+      while (itr != m_entries.end())
+      {
+        if (itr->second.polled)
+        {
+          ++itr;
+          continue;
+        }
+
+        try
+        {
+          m_poll.add(itr->first);
+          itr->second.polled = true;
+          ++itr;
+        }
+        catch (std::runtime_error& e)
+        {
+          Listener* listener = itr->second.listener;
+          m_entries.erase(itr++);
+          listener->onError(e.what());
+        }
+      }
+    }
+
+    void
+    Reactor::dispatchInput(double tstamp)
+    {
+      Concurrency::ScopedMutex l(m_mutex);
+
+      std::map<NativeHandle, Entry>::iterator itr = m_entries.begin();
+      while (itr != m_entries.end())
+      {
+        Entry& entry = itr->second;
+        if (!entry.polled || !m_poll.wasTriggered(itr->first))
+        {
+          ++itr;
+          continue;
+        }
+
+        std::string error;
+        try
+        {
+          size_t rv = entry.handle->read(&m_buffer[0], m_buffer.size());
+          if (rv > 0)
+          {
+            // Kernel timestamps predate the poll, read times do not.
+            double rx = std::min(tstamp, entry.handle->getReadTimeStamp());
+            entry.listener->onData(&m_buffer[0], rv, rx);
+            ++itr;
+            continue;
+          }
+
+          error = "end of stream";
+        }
+        catch (std::runtime_error& e)
+        {
+          error = e.what();
+        }
+
+        Listener* listener = entry.listener;
+        m_removed.push_back(itr->first);
+        m_entries.erase(itr++);
+        listener->onError(error);
+      }
+    }
+
+    void
+    Reactor::run(void)
+    {
+      while (!isStopping())
+      {
+        updatePool();
+
+        if (!m_poll.poll(c_poll_period))
+          continue;
+
+        dispatchInput(Time::Clock::getSinceEpoch());
+      }
+    }
+  }
+}
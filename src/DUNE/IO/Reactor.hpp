@@ -0,0 +1,149 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IO_REACTOR_HPP_INCLUDED_
+#define DUNE_IO_REACTOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IO/Handle.hpp>
+#include <DUNE/IO/Poll.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+
+namespace DUNE
+{
+  namespace IO
+  {
+    // Export symbol.
+    class DUNE_DLL_SYM Reactor;
+
+    //! Shared input reactor. A single thread waits for any of the
+    //! registered handles to become readable, reads whatever is
+    //! available and hands the chunk, together with its reception
+    //! time, to the handle's listener. The reception time is the
+    //! handle's kernel timestamp when available and the time at which
+    //! the handle was found readable otherwise. This replaces the
+    //! poll/read thread otherwise owned by each driver.
+    //!
+    //! Listeners are called from the reactor thread and must not
+    //! block nor call add() or remove() from within a callback.
+    class Reactor: public Concurrency::Thread
+    {
+    public:
+      //! Receiver of input chunks.
+      class Listener
+      {
+      public:
+        virtual
+        ~Listener(void)
+        { }
+
+        //! Called when data was read from the handle.
+        //! @param[in] data data buffer.
+        //! @param[in] size number of bytes in data buffer.
+        //! @param[in] tstamp reception time (s).
+        virtual void
+        onData(const uint8_t* data, size_t size, double tstamp) = 0;
+
+        //! Called when reading from the handle failed. The handle is
+        //! unregistered before this method is called.
+        //! @param[in] error error description.
+        virtual void
+        onError(const std::string& error) = 0;
+      };
+
+      //! Constructor.
+      Reactor(void);
+
+      //! Destructor.
+      ~Reactor(void);
+
+      //! Retrieve the process-wide reactor instance.
+      //! @return reactor instance.
+      static Reactor&
+      getShared(void);
+
+      //! Register an I/O handle. The reactor thread is started on the
+      //! first registration.
+      //! @param[in] handle I/O handle.
+      //! @param[in] listener receiver of input from handle.
+      void
+      add(Handle& handle, Listener* listener);
+
+      //! Unregister an I/O handle. After this method returns the
+      //! handle's listener will not be called again.
+      //! @param[in] handle I/O handle.
+      void
+      remove(Handle& handle);
+
+    private:
+      //! Registered handle.
+      struct Entry
+      {
+        //! I/O handle.
+        Handle* handle;
+        //! Input listener.
+        Listener* listener;
+        //! True if the handle is in the polling pool.
+        bool polled;
+      };
+
+      //! Registered handles indexed by native handle.
+      std::map<NativeHandle, Entry> m_entries;
+      //! Native handles to drop from the polling pool.
+      std::vector<NativeHandle> m_removed;
+      //! Polling pool (reactor thread only).
+      Poll m_poll;
+      //! Read buffer (reactor thread only).
+      std::vector<uint8_t> m_buffer;
+      //! Lock protecting the registry.
+      Concurrency::Mutex m_mutex;
+      //! True if the reactor thread was started.
+      bool m_started;
+
+      //! Bring the polling pool in line with the registry.
+      void
+      updatePool(void);
+
+      //! Read from readable handles and notify listeners.
+      //! @param[in] tstamp time at which handles were found readable.
+      void
+      dispatchInput(double tstamp);
+
+      void
+      run(void);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,193 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <cerrno>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Exceptions.hpp>
+#include <DUNE/System/Error.hpp>
+#include <DUNE/Time/Constants.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/IO/Timer.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SYS_TIMERFD_H)
+#  include <sys/timerfd.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace IO
+  {
+    using System::Error;
+
+    Timer::Timer(void):
+      m_period(0),
+      m_deadline(0)
+    {
+      resetStatistics();
+
+#if defined(DUNE_SYS_HAS_SYS_TIMERFD_H)
+      m_handle = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      if (m_handle == -1)
+        throw Error("creating timer", Error::getLastMessage());
+#else
+      throw NotImplemented("IO::Timer");
+#endif
+    }
+
+    Timer::~Timer(void)
+    {
+#if defined(DUNE_SYS_HAS_SYS_TIMERFD_H)
+      close(m_handle);
+#endif
+    }
+
+    void
+    Timer::start(double period, double delay)
+    {
+      m_period = (uint64_t)(period * Time::c_nsec_per_sec_fp);
+      if (m_period == 0)
+        m_period = 1;
+
+      if (delay > 0)
+        m_deadline = Time::Clock::getSystemNsec() + (uint64_t)(delay * Time::c_nsec_per_sec_fp);
+      else
+        m_deadline = Time::Clock::getSystemNsec() + m_period;
+
+#if defined(DUNE_SYS_HAS_SYS_TIMERFD_H)
+      itimerspec spec;
+      spec.it_value.tv_sec = m_deadline / Time::c_nsec_per_sec;
+      spec.it_value.tv_nsec = m_deadline - (spec.it_value.tv_sec * Time::c_nsec_per_sec);
+      spec.it_interval.tv_sec = m_period / Time::c_nsec_per_sec;
+      spec.it_interval.tv_nsec = m_period - (spec.it_interval.tv_sec * Time::c_nsec_per_sec);
+
+      if (timerfd_settime(m_handle, TFD_TIMER_ABSTIME, &spec, NULL) == -1)
+        throw Error("starting timer", Error::getLastMessage());
+#endif
+    }
+
+    void
+    Timer::stop(void)
+    {
+      m_period = 0;
+
+#if defined(DUNE_SYS_HAS_SYS_TIMERFD_H)
+      itimerspec spec;
+      std::memset(&spec, 0, sizeof(spec));
+      if (timerfd_settime(m_handle, 0, &spec, NULL) == -1)
+        throw Error("stopping timer", Error::getLastMessage());
+#endif
+    }
+
+    unsigned
+    Timer::acknowledge(void)
+    {
+      uint64_t count = 0;
+
+#if defined(DUNE_SYS_HAS_SYS_TIMERFD_H)
+      ssize_t rv = ::read(m_handle, &count, sizeof(count));
+      if (rv == -1)
+      {
+        if (errno == EAGAIN || errno == EINTR)
+          return 0;
+
+        throw Error("reading timer", Error::getLastMessage());
+      }
+#endif
+
+      if (count == 0 || m_period == 0)
+        return 0;
+
+      // Latency is measured against the most recent expiration.
+      uint64_t last = m_deadline + (count - 1) * m_period;
+      uint64_t now = Time::Clock::getSystemNsec();
+      uint64_t latency = (now > last) ? now - last : 0;
+
+      m_deadline = last + m_period;
+      m_expirations += count;
+      m_overruns += count - 1;
+      m_latency_sum += latency;
+      if (latency > m_latency_max)
+        m_latency_max = latency;
+      ++m_samples;
+
+      return (unsigned)count;
+    }
+
+    double
+    Timer::getAverageLatency(void) const
+    {
+      if (m_samples == 0)
+        return 0;
+
+      return (m_latency_sum / Time::c_nsec_per_sec_fp) / m_samples;
+    }
+
+    double
+    Timer::getMaximumLatency(void) const
+    {
+      return m_latency_max / Time::c_nsec_per_sec_fp;
+    }
+
+    void
+    Timer::resetStatistics(void)
+    {
+      m_expirations = 0;
+      m_overruns = 0;
+      m_samples = 0;
+      m_latency_sum = 0;
+      m_latency_max = 0;
+    }
+
+    size_t
+    Timer::doRead(uint8_t* data, size_t size)
+    {
+      uint64_t count = acknowledge();
+      if (count == 0 || size < sizeof(count))
+        return 0;
+
+      std::memcpy(data, &count, sizeof(count));
+      return sizeof(count);
+    }
+
+    size_t
+    Timer::doWrite(const uint8_t* data, size_t size)
+    {
+      (void)data;
+      (void)size;
+      throw NotImplemented("IO::Timer::write");
+    }
+  }
+}
@@ -0,0 +1,167 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_IO_TIMER_HPP_INCLUDED_
+#define DUNE_IO_TIMER_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IO/Handle.hpp>
+
+namespace DUNE
+{
+  namespace IO
+  {
+    // Export symbol.
+    class DUNE_DLL_SYM Timer;
+
+    //! Periodic timer that can be waited on like any other I/O
+    //! handle, i.e., added to a Poll or Reactor together with
+    //! devices and sockets. Expirations are programmed as absolute
+    //! deadlines of the system monotonic clock, so the period does
+    //! not drift with the time taken to service the timer. Periods
+    //! are measured in system time and are not affected by the speed
+    //! or state of Time::Clock. On Linux timers are backed by
+    //! timerfd.
+    //!
+    //! The timer becomes readable when it expires. Each call to
+    //! acknowledge() (or read()) consumes the pending expirations and
+    //! updates overrun and latency statistics: an overrun is an
+    //! expiration that was not acknowledged before the next one and
+    //! latency is the delay between an expiration and its
+    //! acknowledgment.
+    class Timer: public Handle
+    {
+    public:
+      //! Constructor.
+      //! @throw NotImplemented if timers are not supported.
+      Timer(void);
+
+      //! Destructor.
+      ~Timer(void);
+
+      //! Start the timer.
+      //! @param[in] period timer period in seconds.
+      //! @param[in] delay time until the first expiration in
+      //! seconds, zero to expire one period from now.
+      void
+      start(double period, double delay = 0);
+
+      //! Stop the timer. Pending expirations are discarded.
+      void
+      stop(void);
+
+      //! Check if the timer is running.
+      //! @return true if the timer is running, false otherwise.
+      bool
+      isRunning(void) const
+      {
+        return m_period > 0;
+      }
+
+      //! Consume pending expirations without blocking.
+      //! @return number of expirations since the last call.
+      unsigned
+      acknowledge(void);
+
+      //! Retrieve the number of expirations since the timer was
+      //! started.
+      //! @return number of expirations.
+      uint64_t
+      getExpirations(void) const
+      {
+        return m_expirations;
+      }
+
+      //! Retrieve the number of expirations that were not
+      //! acknowledged in time.
+      //! @return number of overruns.
+      uint64_t
+      getOverruns(void) const
+      {
+        return m_overruns;
+      }
+
+      //! Retrieve the average delay between expirations and their
+      //! acknowledgment.
+      //! @return average latency in seconds.
+      double
+      getAverageLatency(void) const;
+
+      //! Retrieve the maximum delay between an expiration and its
+      //! acknowledgment.
+      //! @return maximum latency in seconds.
+      double
+      getMaximumLatency(void) const;
+
+      //! Reset expiration, overrun and latency statistics.
+      void
+      resetStatistics(void);
+
+    private:
+      //! Native handle.
+      NativeHandle m_handle;
+      //! Timer period (ns), zero if stopped.
+      uint64_t m_period;
+      //! Deadline of the next expiration (ns).
+      uint64_t m_deadline;
+      //! Number of expirations.
+      uint64_t m_expirations;
+      //! Number of overruns.
+      uint64_t m_overruns;
+      //! Number of latency samples.
+      uint64_t m_samples;
+      //! Sum of latencies (ns).
+      uint64_t m_latency_sum;
+      //! Maximum latency (ns).
+      uint64_t m_latency_max;
+
+      NativeHandle
+      doGetNative(void) const
+      {
+        return m_handle;
+      }
+
+      //! Acknowledge pending expirations and store their number as a
+      //! 64-bit unsigned integer in native byte order.
+      size_t
+      doRead(uint8_t* data, size_t size);
+
+      size_t
+      doWrite(const uint8_t* data, size_t size);
+
+      //! Non-copyable.
+      Timer(const Timer&);
+
+      //! Non-assignable.
+      Timer&
+      operator=(const Timer&);
+    };
+  }
+}
+
+#endif
@@ -36,10 +36,13 @@ namespace DUNE
 }
 
 #include <DUNE/Maneuvers/Maneuver.hpp>
+#include <DUNE/Maneuvers/TrajectoryBuffer.hpp>
 #include <DUNE/Maneuvers/FollowTrajectory.hpp>
 #include <DUNE/Maneuvers/VehicleFormation.hpp>
 #include <DUNE/Maneuvers/RowsStages.hpp>
 #include <DUNE/Maneuvers/StationKeep.hpp>
 #include <DUNE/Maneuvers/Elevate.hpp>
+#include <DUNE/Maneuvers/CoveragePlanner.hpp>
+#include <DUNE/Maneuvers/Dubins.hpp>
 
 #endif
@@ -0,0 +1,285 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Maneuvers/CoveragePlanner.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Math/Constants.hpp>
+#include <DUNE/Math/General.hpp>
+
+namespace DUNE
+{
+  namespace Maneuvers
+  {
+    //! Directions closer than this are considered the same.
+    static const double c_direction_tolerance = 1e-06;
+
+    //! Thread evaluating a subset of the candidate directions.
+    class CoverageWorker: public Concurrency::Thread
+    {
+    public:
+      CoverageWorker(const std::vector<CoveragePlanner::Point>& polygon,
+                     const std::vector<double>& directions, double width,
+                     std::vector<double>& lengths, unsigned first, unsigned stride):
+        m_polygon(polygon),
+        m_directions(directions),
+        m_width(width),
+        m_lengths(lengths),
+        m_first(first),
+        m_stride(stride)
+      { }
+
+    private:
+      const std::vector<CoveragePlanner::Point>& m_polygon;
+      const std::vector<double>& m_directions;
+      double m_width;
+      std::vector<double>& m_lengths;
+      unsigned m_first;
+      unsigned m_stride;
+
+      void
+      run(void)
+      {
+        std::vector<CoveragePlanner::Row> rows;
+
+        for (unsigned i = m_first; i < m_directions.size(); i += m_stride)
+          m_lengths[i] = CoveragePlanner::computeRows(m_polygon, m_directions[i], m_width, rows);
+      }
+    };
+
+    //! Cross product of the vectors from o to a and from o to b.
+    static double
+    cross(const CoveragePlanner::Point& o, const CoveragePlanner::Point& a,
+          const CoveragePlanner::Point& b)
+    {
+      return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    }
+
+    //! Lexicographic order of points.
+    static bool
+    lessThan(const CoveragePlanner::Point& a, const CoveragePlanner::Point& b)
+    {
+      return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    CoveragePlanner::CoveragePlanner(const std::vector<Point>& polygon):
+      m_polygon(polygon),
+      m_direction(0),
+      m_length(0)
+    { }
+
+    bool
+    CoveragePlanner::plan(double width, unsigned threads)
+    {
+      m_rows.clear();
+      m_length = 0;
+
+      if (m_polygon.size() < 3 || width <= 0)
+        return false;
+
+      std::vector<double> directions;
+      getCandidates(directions);
+
+      std::vector<double> lengths(directions.size(), 0.0);
+      threads = std::max(1u, std::min(threads, (unsigned)directions.size()));
+
+      if (threads == 1)
+      {
+        for (unsigned i = 0; i < directions.size(); ++i)
+          lengths[i] = computeRows(m_polygon, directions[i], width, m_rows);
+      }
+      else
+      {
+        std::vector<CoverageWorker*> workers;
+
+        for (unsigned i = 0; i < threads; ++i)
+        {
+          workers.push_back(new CoverageWorker(m_polygon, directions, width,
+                                               lengths, i, threads));
+          workers.back()->start();
+        }
+
+        for (unsigned i = 0; i < workers.size(); ++i)
+        {
+          workers[i]->join();
+          delete workers[i];
+        }
+      }
+
+      unsigned best = 0;
+      for (unsigned i = 1; i < directions.size(); ++i)
+      {
+        if (lengths[i] < lengths[best])
+          best = i;
+      }
+
+      m_direction = directions[best];
+      m_length = computeRows(m_polygon, m_direction, width, m_rows);
+
+      return !m_rows.empty();
+    }
+
+    void
+    CoveragePlanner::getCandidates(std::vector<double>& directions) const
+    {
+      // Convex hull (monotone chain).
+      std::vector<Point> points(m_polygon);
+      std::sort(points.begin(), points.end(), lessThan);
+
+      std::vector<Point> hull(2 * points.size());
+      size_t k = 0;
+
+      for (size_t i = 0; i < points.size(); ++i)
+      {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0)
+          --k;
+        hull[k++] = points[i];
+      }
+
+      for (size_t i = points.size() - 1, t = k + 1; i > 0; --i)
+      {
+        while (k >= t && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0)
+          --k;
+        hull[k++] = points[i - 1];
+      }
+
+      hull.resize(k > 1 ? k - 1 : k);
+
+      for (size_t i = 0; i < hull.size(); ++i)
+      {
+        const Point& a = hull[i];
+        const Point& b = hull[(i + 1) % hull.size()];
+
+        if (a.x == b.x && a.y == b.y)
+          continue;
+
+        // Rows in both senses are equivalent.
+        double angle = std::atan2(b.y - a.y, b.x - a.x);
+        if (angle < 0)
+          angle += Math::c_pi;
+        if (angle >= Math::c_pi)
+          angle -= Math::c_pi;
+
+        bool found = false;
+        for (size_t j = 0; j < directions.size(); ++j)
+        {
+          if (std::fabs(directions[j] - angle) < c_direction_tolerance)
+          {
+            found = true;
+            break;
+          }
+        }
+
+        if (!found)
+          directions.push_back(angle);
+      }
+
+      if (directions.empty())
+        directions.push_back(0.0);
+    }
+
+    double
+    CoveragePlanner::computeRows(const std::vector<Point>& polygon, double direction,
+                                 double width, std::vector<Row>& rows)
+    {
+      rows.clear();
+
+      size_t n = polygon.size();
+      if (n < 3 || width <= 0)
+        return std::numeric_limits<double>::max();
+
+      double c = std::cos(direction);
+      double s = std::sin(direction);
+
+      // Coordinates along (u) and across (v) the rows.
+      std::vector<double> us(n);
+      std::vector<double> vs(n);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        us[i] = polygon[i].x * c + polygon[i].y * s;
+        vs[i] = -polygon[i].x * s + polygon[i].y * c;
+      }
+
+      double v_min = *std::min_element(vs.begin(), vs.end());
+      double v_max = *std::max_element(vs.begin(), vs.end());
+
+      int n_rows = std::max(1, (int)std::ceil((v_max - v_min) / width));
+      double row_width = (v_max - v_min) / n_rows;
+
+      double length = 0;
+      Point last;
+
+      for (int k = 0; k < n_rows; ++k)
+      {
+        double v = v_min + (k + 0.5) * row_width;
+        double u_min = std::numeric_limits<double>::max();
+        double u_max = -std::numeric_limits<double>::max();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          size_t j = (i + 1) % n;
+
+          if ((vs[i] <= v && vs[j] > v) || (vs[j] <= v && vs[i] > v))
+          {
+            double u = us[i] + (v - vs[i]) * (us[j] - us[i]) / (vs[j] - vs[i]);
+            u_min = std::min(u_min, u);
+            u_max = std::max(u_max, u);
+          }
+        }
+
+        if (u_min > u_max)
+          continue;
+
+        // Alternate the sense of the rows.
+        if (rows.size() % 2)
+          std::swap(u_min, u_max);
+
+        Row row;
+        row.start = Point(u_min * c - v * s, u_min * s + v * c);
+        row.end = Point(u_max * c - v * s, u_max * s + v * c);
+
+        if (!rows.empty())
+          length += Math::norm(row.start.x - last.x, row.start.y - last.y);
+
+        length += std::fabs(u_max - u_min);
+        last = row.end;
+        rows.push_back(row);
+      }
+
+      if (rows.empty())
+        return std::numeric_limits<double>::max();
+
+      return length;
+    }
+  }
+}
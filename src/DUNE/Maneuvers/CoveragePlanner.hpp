@@ -0,0 +1,144 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MANEUVERS_COVERAGE_PLANNER_HPP_INCLUDED_
+#define DUNE_MANEUVERS_COVERAGE_PLANNER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Maneuvers
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM CoveragePlanner;
+
+    //! Boustrophedon (lawn mower) coverage of a polygonal area.
+    //!
+    //! Rows are parallel to one of the edges of the convex hull of
+    //! the polygon, since the narrowest extent of the area, and hence
+    //! the smallest number of rows, is always found along one of
+    //! those directions. Each candidate direction is evaluated by the
+    //! length of the resulting path, optionally in several threads.
+    class CoveragePlanner
+    {
+    public:
+      //! Point in a local North/East frame.
+      struct Point
+      {
+        //! North offset.
+        double x;
+        //! East offset.
+        double y;
+
+        Point(void):
+          x(0), y(0)
+        { }
+
+        Point(double x_, double y_):
+          x(x_), y(y_)
+        { }
+      };
+
+      //! Row of the coverage pattern.
+      struct Row
+      {
+        //! First end of the row.
+        Point start;
+        //! Second end of the row.
+        Point end;
+      };
+
+      //! Constructor.
+      //! @param[in] polygon vertices of the area.
+      CoveragePlanner(const std::vector<Point>& polygon);
+
+      //! Compute the rows that cover the area.
+      //! @param[in] width maximum distance between rows.
+      //! @param[in] threads number of threads evaluating directions.
+      //! @return true if the area could be covered, false otherwise.
+      bool
+      plan(double width, unsigned threads = 1);
+
+      //! Get the direction of the rows.
+      //! @return angle of the rows to North.
+      double
+      getDirection(void) const
+      {
+        return m_direction;
+      }
+
+      //! Get the length of the path that covers the area,
+      //! including transitions between rows.
+      //! @return path length.
+      double
+      getLength(void) const
+      {
+        return m_length;
+      }
+
+      //! Get the rows, ordered across the area.
+      //! @return rows.
+      const std::vector<Row>&
+      getRows(void) const
+      {
+        return m_rows;
+      }
+
+      //! Compute the rows of the area in a given direction.
+      //! @param[in] polygon vertices of the area.
+      //! @param[in] direction angle of the rows to North.
+      //! @param[in] width maximum distance between rows.
+      //! @param[out] rows rows ordered across the area.
+      //! @return length of the path covering the rows.
+      static double
+      computeRows(const std::vector<Point>& polygon, double direction,
+                  double width, std::vector<Row>& rows);
+
+    private:
+      //! Vertices of the area.
+      std::vector<Point> m_polygon;
+      //! Rows.
+      std::vector<Row> m_rows;
+      //! Direction of the rows.
+      double m_direction;
+      //! Length of the path.
+      double m_length;
+
+      //! Compute the candidate directions of the rows.
+      //! @param[out] directions angles to North.
+      void
+      getCandidates(std::vector<double>& directions) const;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,342 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Maneuvers/Dubins.hpp>
+#include <DUNE/Math/Constants.hpp>
+
+namespace DUNE
+{
+  namespace Maneuvers
+  {
+    //! Turn direction of each segment of each family
+    //! (1: left, -1: right, 0: straight).
+    static const int c_turns[Dubins::TYPE_COUNT][3] =
+    {
+      { 1, 0, 1},
+      { 1, 0, -1},
+      {-1, 0, 1},
+      {-1, 0, -1},
+      {-1, 1, -1},
+      { 1, -1, 1}
+    };
+
+    //! Terms shared by all path families, for a problem normalized to
+    //! unit turning radius in a frame where the start and goal poses
+    //! lie on the X axis (X east, Y north, counter-clockwise angles).
+    struct Terms
+    {
+      //! Normalized distance.
+      double d;
+      //! Start heading.
+      double a;
+      //! Goal heading.
+      double b;
+      double sa, ca, sb, cb, cab;
+    };
+
+    //! Wrap an angle to [0, 2 pi[.
+    static double
+    mod2pi(double angle)
+    {
+      angle = std::fmod(angle, Math::c_two_pi);
+      return angle < 0 ? angle + Math::c_two_pi : angle;
+    }
+
+    //! Convert a pose to the X east, Y north, counter-clockwise frame.
+    static void
+    toStandard(const Dubins::Pose& p, double& x, double& y, double& theta)
+    {
+      x = p.y;
+      y = p.x;
+      theta = Math::c_half_pi - p.psi;
+    }
+
+    //! Compute the shared terms of a problem.
+    static void
+    computeTerms(const Dubins::Pose& start, const Dubins::Pose& goal,
+                 double radius, Terms& t)
+    {
+      double x0, y0, th0, x1, y1, th1;
+      toStandard(start, x0, y0, th0);
+      toStandard(goal, x1, y1, th1);
+
+      double dx = x1 - x0;
+      double dy = y1 - y0;
+      double dist = std::sqrt(dx * dx + dy * dy);
+      double th = dist > 0 ? std::atan2(dy, dx) : 0.0;
+
+      t.d = dist / radius;
+      t.a = mod2pi(th0 - th);
+      t.b = mod2pi(th1 - th);
+      t.sa = std::sin(t.a);
+      t.ca = std::cos(t.a);
+      t.sb = std::sin(t.b);
+      t.cb = std::cos(t.b);
+      t.cab = std::cos(t.a - t.b);
+    }
+
+    //! Compute the normalized segment lengths of a path family.
+    //! Segments are zero if the family has no solution.
+    //! @return true if the family has a solution.
+    static bool
+    evaluate(Dubins::Type type, const Terms& t, double out[3])
+    {
+      double d = t.d;
+      double tmp, p, atn;
+
+      out[0] = out[1] = out[2] = 0;
+
+      switch (type)
+      {
+        case Dubins::TYPE_LSL:
+          tmp = 2 + d * d - 2 * t.cab + 2 * d * (t.sa - t.sb);
+          if (tmp < 0)
+            return false;
+          atn = std::atan2(t.cb - t.ca, d + t.sa - t.sb);
+          out[0] = mod2pi(-t.a + atn);
+          out[1] = std::sqrt(tmp);
+          out[2] = mod2pi(t.b - atn);
+          return true;
+
+        case Dubins::TYPE_RSR:
+          tmp = 2 + d * d - 2 * t.cab + 2 * d * (t.sb - t.sa);
+          if (tmp < 0)
+            return false;
+          atn = std::atan2(t.ca - t.cb, d - t.sa + t.sb);
+          out[0] = mod2pi(t.a - atn);
+          out[1] = std::sqrt(tmp);
+          out[2] = mod2pi(-t.b + atn);
+          return true;
+
+        case Dubins::TYPE_LSR:
+          tmp = -2 + d * d + 2 * t.cab + 2 * d * (t.sa + t.sb);
+          if (tmp < 0)
+            return false;
+          p = std::sqrt(tmp);
+          atn = std::atan2(-t.ca - t.cb, d + t.sa + t.sb) - std::atan2(-2.0, p);
+          out[0] = mod2pi(-t.a + atn);
+          out[1] = p;
+          out[2] = mod2pi(-t.b + atn);
+          return true;
+
+        case Dubins::TYPE_RSL:
+          tmp = -2 + d * d + 2 * t.cab - 2 * d * (t.sa + t.sb);
+          if (tmp < 0)
+            return false;
+          p = std::sqrt(tmp);
+          atn = std::atan2(t.ca + t.cb, d - t.sa - t.sb) - std::atan2(2.0, p);
+          out[0] = mod2pi(t.a - atn);
+          out[1] = p;
+          out[2] = mod2pi(t.b - atn);
+          return true;
+
+        case Dubins::TYPE_RLR:
+          tmp = (6 - d * d + 2 * t.cab + 2 * d * (t.sa - t.sb)) / 8;
+          if (std::fabs(tmp) > 1)
+            return false;
+          p = mod2pi(Math::c_two_pi - std::acos(tmp));
+          out[0] = mod2pi(t.a - std::atan2(t.ca - t.cb, d - t.sa + t.sb) + p / 2);
+          out[1] = p;
+          out[2] = mod2pi(t.a - t.b - out[0] + p);
+          return true;
+
+        case Dubins::TYPE_LRL:
+          tmp = (6 - d * d + 2 * t.cab + 2 * d * (t.sb - t.sa)) / 8;
+          if (std::fabs(tmp) > 1)
+            return false;
+          p = mod2pi(Math::c_two_pi - std::acos(tmp));
+          out[0] = mod2pi(-t.a - std::atan2(t.ca - t.cb, d + t.sa - t.sb) + p / 2);
+          out[1] = p;
+          out[2] = mod2pi(t.b - t.a - out[0] + p);
+          return true;
+
+        default:
+          return false;
+      }
+    }
+
+    //! Find the shortest path family.
+    //! @return true if any family has a solution.
+    static bool
+    evaluateAll(const Terms& t, Dubins::Type& best, double out[3])
+    {
+      double best_length = std::numeric_limits<double>::max();
+      double seg[3] = {0, 0, 0};
+
+      for (int i = 0; i < Dubins::TYPE_COUNT; ++i)
+      {
+        Dubins::Type type = (Dubins::Type)i;
+
+        if (!evaluate(type, t, seg))
+          continue;
+
+        double length = seg[0] + seg[1] + seg[2];
+        if (length < best_length)
+        {
+          best_length = length;
+          best = type;
+          out[0] = seg[0];
+          out[1] = seg[1];
+          out[2] = seg[2];
+        }
+      }
+
+      return best_length < std::numeric_limits<double>::max();
+    }
+
+    //! Fill a path from normalized segment lengths.
+    static void
+    fillPath(const Dubins::Pose& start, double radius, Dubins::Type type,
+             const double seg[3], Dubins::Path& path)
+    {
+      path.start = start;
+      path.radius = radius;
+      path.type = type;
+
+      for (unsigned i = 0; i < 3; ++i)
+        path.segments[i] = seg[i] * radius;
+    }
+
+    Dubins::Dubins(double radius, double quantum, size_t capacity):
+      m_radius(radius),
+      m_quantum(quantum),
+      m_capacity(capacity),
+      m_hits(0)
+    { }
+
+    bool
+    Dubins::compute(const Pose& start, const Pose& goal, double radius, Path& path)
+    {
+      Terms t;
+      computeTerms(start, goal, radius, t);
+
+      Type type = TYPE_LSL;
+      double seg[3] = {0, 0, 0};
+
+      if (!evaluateAll(t, type, seg))
+        return false;
+
+      fillPath(start, radius, type, seg, path);
+      return true;
+    }
+
+    bool
+    Dubins::solve(const Pose& start, const Pose& goal, Path& path)
+    {
+      // Goal relative to the start pose.
+      double dx = goal.x - start.x;
+      double dy = goal.y - start.y;
+      double c = std::cos(start.psi);
+      double s = std::sin(start.psi);
+
+      Key key;
+      key.x = (long)std::floor((dx * c + dy * s) / m_quantum + 0.5);
+      key.y = (long)std::floor((-dx * s + dy * c) / m_quantum + 0.5);
+      key.psi = (long)std::floor(mod2pi(goal.psi - start.psi) * m_radius / m_quantum + 0.5);
+
+      Terms t;
+      computeTerms(start, goal, m_radius, t);
+
+      double seg[3] = {0, 0, 0};
+      std::map<Key, Type>::const_iterator itr = m_cache.find(key);
+
+      if (itr != m_cache.end() && evaluate(itr->second, t, seg))
+      {
+        ++m_hits;
+        fillPath(start, m_radius, itr->second, seg, path);
+        return true;
+      }
+
+      Type type = TYPE_LSL;
+      if (!evaluateAll(t, type, seg))
+        return false;
+
+      if (m_cache.size() >= m_capacity)
+        m_cache.clear();
+
+      m_cache[key] = type;
+      fillPath(start, m_radius, type, seg, path);
+      return true;
+    }
+
+    size_t
+    Dubins::solve(const std::vector<Query>& queries, std::vector<Path>& paths)
+    {
+      size_t count = 0;
+      paths.resize(queries.size());
+
+      for (size_t i = 0; i < queries.size(); ++i)
+      {
+        if (solve(queries[i].first, queries[i].second, paths[i]))
+          ++count;
+        else
+          paths[i].segments[0] = paths[i].segments[1] = paths[i].segments[2] = -1;
+      }
+
+      return count;
+    }
+
+    Dubins::Pose
+    Dubins::sample(const Path& path, double s)
+    {
+      double x, y, th;
+      toStandard(path.start, x, y, th);
+
+      double r = path.radius;
+      s = std::max(0.0, s);
+
+      for (unsigned i = 0; i < 3 && s > 0; ++i)
+      {
+        double len = std::min(s, path.segments[i]);
+        int turn = c_turns[path.type][i];
+
+        if (turn == 0)
+        {
+          x += len * std::cos(th);
+          y += len * std::sin(th);
+        }
+        else
+        {
+          double phi = turn * len / r;
+          x += turn * r * (std::sin(th + phi) - std::sin(th));
+          y -= turn * r * (std::cos(th + phi) - std::cos(th));
+          th += phi;
+        }
+
+        s -= len;
+      }
+
+      return Pose(y, x, Math::c_half_pi - th);
+    }
+  }
+}
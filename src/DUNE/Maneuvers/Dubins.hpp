@@ -0,0 +1,207 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MANEUVERS_DUBINS_HPP_INCLUDED_
+#define DUNE_MANEUVERS_DUBINS_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Maneuvers
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Dubins;
+
+    //! Shortest paths between two poses for a vehicle with a minimum
+    //! turning radius (Dubins paths).
+    //!
+    //! All six path families are evaluated from one set of
+    //! trigonometric terms. Since paths do not depend on the absolute
+    //! position and heading of the start pose, the best family is
+    //! cached by the goal pose relative to the start pose, quantized.
+    //! A cache hit only evaluates that family.
+    class Dubins
+    {
+    public:
+      //! Path families (L: turn left, R: turn right, S: straight).
+      enum Type
+      {
+        TYPE_LSL,
+        TYPE_LSR,
+        TYPE_RSL,
+        TYPE_RSR,
+        TYPE_RLR,
+        TYPE_LRL,
+        TYPE_COUNT
+      };
+
+      //! Pose in a local North/East frame.
+      struct Pose
+      {
+        //! North offset.
+        double x;
+        //! East offset.
+        double y;
+        //! Heading (clockwise from North).
+        double psi;
+
+        Pose(void):
+          x(0), y(0), psi(0)
+        { }
+
+        Pose(double x_, double y_, double psi_):
+          x(x_), y(y_), psi(psi_)
+        { }
+      };
+
+      //! Path between two poses.
+      struct Path
+      {
+        //! Start pose.
+        Pose start;
+        //! Turning radius.
+        double radius;
+        //! Path family.
+        Type type;
+        //! Length of each segment.
+        double segments[3];
+
+        //! Get the total length of the path.
+        //! @return path length.
+        double
+        length(void) const
+        {
+          return segments[0] + segments[1] + segments[2];
+        }
+      };
+
+      //! Start and goal poses of a query.
+      typedef std::pair<Pose, Pose> Query;
+
+      //! Constructor.
+      //! @param[in] radius minimum turning radius.
+      //! @param[in] quantum resolution of the cache keys, in meters
+      //! (headings are quantized to quantum / radius).
+      //! @param[in] capacity maximum number of cached entries.
+      Dubins(double radius, double quantum = 0.01, size_t capacity = 16384);
+
+      //! Compute the shortest path between two poses.
+      //! @param[in] start start pose.
+      //! @param[in] goal goal pose.
+      //! @param[out] path shortest path.
+      //! @return true if a path was found, false otherwise.
+      bool
+      solve(const Pose& start, const Pose& goal, Path& path);
+
+      //! Compute the shortest paths for many queries.
+      //! @param[in] queries start and goal poses.
+      //! @param[out] paths shortest paths, one per query.
+      //! @return number of queries for which a path was found.
+      size_t
+      solve(const std::vector<Query>& queries, std::vector<Path>& paths);
+
+      //! Get the number of cached entries.
+      //! @return number of entries.
+      size_t
+      getCacheSize(void) const
+      {
+        return m_cache.size();
+      }
+
+      //! Get the number of queries answered from the cache.
+      //! @return number of cache hits.
+      size_t
+      getCacheHits(void) const
+      {
+        return m_hits;
+      }
+
+      //! Remove all cached entries.
+      void
+      clearCache(void)
+      {
+        m_cache.clear();
+      }
+
+      //! Compute the shortest path between two poses, without cache.
+      //! @param[in] start start pose.
+      //! @param[in] goal goal pose.
+      //! @param[in] radius minimum turning radius.
+      //! @param[out] path shortest path.
+      //! @return true if a path was found, false otherwise.
+      static bool
+      compute(const Pose& start, const Pose& goal, double radius, Path& path);
+
+      //! Get the pose at a given distance along a path.
+      //! @param[in] path path.
+      //! @param[in] s distance along the path (clamped to its length).
+      //! @return pose.
+      static Pose
+      sample(const Path& path, double s);
+
+    private:
+      //! Cache key (quantized relative goal pose).
+      struct Key
+      {
+        long x;
+        long y;
+        long psi;
+
+        bool
+        operator<(const Key& other) const
+        {
+          if (x != other.x)
+            return x < other.x;
+          if (y != other.y)
+            return y < other.y;
+          return psi < other.psi;
+        }
+      };
+
+      //! Turning radius.
+      double m_radius;
+      //! Resolution of the cache keys.
+      double m_quantum;
+      //! Maximum number of cached entries.
+      size_t m_capacity;
+      //! Best path family by key.
+      std::map<Key, Type> m_cache;
+      //! Number of cache hits.
+      size_t m_hits;
+    };
+  }
+}
+
+#endif
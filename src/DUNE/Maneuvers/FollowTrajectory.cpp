@@ -26,6 +26,7 @@
 //***************************************************************************
 
 #include <DUNE/Coordinates.hpp>
+#include <DUNE/Utils/TupleList.hpp>
 #include <DUNE/Maneuvers/FollowTrajectory.hpp>
 
 namespace DUNE
@@ -35,15 +36,22 @@ namespace DUNE
     using namespace DUNE::IMC;
 
     FollowTrajectory::FollowTrajectory(const std::string& name, Tasks::Context& ctx):
-      Maneuver(name, ctx)
+      Maneuver(name, ctx),
+      m_stream(false)
     {
       param("Control Step Frequency", m_cstep_period)
       .units(Units::Hertz)
       .defaultValue("1.0");
 
+      param("Trajectory Buffer Size", m_traj_capacity)
+      .defaultValue("4096")
+      .minimumValue("2")
+      .description("Maximum number of trajectory points held at once");
+
       bindToManeuver<FollowTrajectory, IMC::FollowTrajectory>();
       bind<IMC::EstimatedState>(this);
       bind<IMC::PathControlState>(this);
+      bind<IMC::TrajectorySegment>(this);
     }
 
     FollowTrajectory::~FollowTrajectory(void)
@@ -54,28 +62,34 @@ namespace DUNE
     {
       if (paramChanged(m_cstep_period))
         m_cstep_period = 1.0 / m_cstep_period;
+
+      if (paramChanged(m_traj_capacity))
+        m_traj.setCapacity(m_traj_capacity);
     }
 
     bool
     FollowTrajectory::initTrajectory(const IMC::FollowTrajectory* maneuver)
     {
-      const IMC::MessageList<IMC::TrajectoryPoint>* list = &maneuver->points;
+      m_traj.clear();
 
-      IMC::MessageList<IMC::TrajectoryPoint>::const_iterator itr;
+      Utils::TupleList tuples(maneuver->custom, "=", ";", true);
+      m_stream = tuples.get("stream") == "true";
 
-      for (itr = list->begin(); itr != list->end(); itr++)
-      {
-        TPoint p;
-        p.x = (*itr)->x;
-        p.y = (*itr)->y;
-        p.z = maneuver->z + (*itr)->z;
-        p.z_units = maneuver->z_units;
-        p.t = (*itr)->t;
+      m_z = maneuver->z;
+      m_z_units = maneuver->z_units;
 
-        m_traj.push_back(p);
+      if (maneuver->points.size() > m_traj.getCapacity())
+      {
+        signalError(DTR("too many trajectory points"));
+        return false;
       }
 
-      if (m_traj.size() < 2)
+      addPoints(maneuver->points);
+
+      if (!m_stream)
+        m_traj.setComplete();
+
+      if (m_traj.getEnd() < (m_stream ? 1 : 2))
       {
         signalError(DTR("too few trajectory points"));
         return false;
@@ -84,6 +98,25 @@ namespace DUNE
       return true;
     }
 
+    void
+    FollowTrajectory::addPoints(const IMC::MessageList<IMC::TrajectoryPoint>& list)
+    {
+      IMC::MessageList<IMC::TrajectoryPoint>::const_iterator itr;
+
+      for (itr = list.begin(); itr != list.end(); itr++)
+      {
+        TPoint p;
+        p.x = (*itr)->x;
+        p.y = (*itr)->y;
+        p.z = m_z + (*itr)->z;
+        p.z_units = m_z_units;
+        p.t = (*itr)->t;
+
+        if (!m_traj.push(p))
+          break;
+      }
+    }
+
     void
     FollowTrajectory::consume(const IMC::FollowTrajectory* msg)
     {
@@ -109,6 +142,57 @@ namespace DUNE
       dispatch(m_path);
 
       m_approach = true; // signal approach stage
+
+      if (m_stream)
+        reportBuffer();
+    }
+
+    void
+    FollowTrajectory::consume(const IMC::TrajectorySegment* msg)
+    {
+      if (!m_stream || m_traj.isComplete())
+        return;
+
+      // Out of order segments are dropped: the buffer state tells
+      // the source where to resume.
+      if (msg->index != m_traj.getEnd())
+      {
+        reportBuffer();
+        return;
+      }
+
+      size_t first = m_traj.getEnd();
+
+      addPoints(msg->points);
+
+      if ((msg->flags & IMC::TrajectorySegment::FL_LAST) &&
+          m_traj.getEnd() - first == msg->points.size())
+        m_traj.setComplete();
+
+      if (m_traj.getEnd() > first && !onTrajectoryExtended(first))
+        return;
+
+      reportBuffer();
+    }
+
+    void
+    FollowTrajectory::releasePoints(size_t t_index)
+    {
+      uint32_t free = m_traj.getFree();
+
+      m_traj.release(t_index);
+
+      if (m_stream && !m_traj.isComplete() && m_traj.getFree() != free)
+        reportBuffer();
+    }
+
+    void
+    FollowTrajectory::reportBuffer(void)
+    {
+      IMC::TrajectoryBufferState state;
+      state.next = m_traj.getEnd();
+      state.free = std::min(m_traj.getFree(), (uint32_t)UINT16_MAX);
+      dispatch(state);
     }
 
     void
@@ -147,6 +231,7 @@ namespace DUNE
       onReset();
 
       m_approach = false;
+      m_stream = false;
       m_traj.clear();
     }
 
@@ -36,6 +36,7 @@
 #include <DUNE/Config.hpp>
 #include <DUNE/IMC.hpp>
 #include <DUNE/Maneuvers/Maneuver.hpp>
+#include <DUNE/Maneuvers/TrajectoryBuffer.hpp>
 
 namespace DUNE
 {
@@ -90,6 +91,23 @@ namespace DUNE
       void
       consume(const IMC::PathControlState* msg);
 
+      //! Consumer for IMC::TrajectorySegment message.
+      //! @param msg trajectory segment message
+      void
+      consume(const IMC::TrajectorySegment* msg);
+
+      //! Method invoked when streamed points are added to the
+      //! trajectory. By default the base class implementation
+      //! accepts all points.
+      //! @param first index of the first added point
+      //! @return true if we can proceed with the maneuver, false otherwise
+      virtual bool
+      onTrajectoryExtended(size_t first)
+      {
+        (void)first;
+        return true;
+      }
+
       //! Abstract method called upon path completion.
       //! This will not be called in approach stage (see isApproaching()).
       virtual void
@@ -106,36 +124,38 @@ namespace DUNE
       { }
 
       //! Trajectory point.
-      struct TPoint
-      {
-        //! X coordinate offset (North).
-        double x;
-        //! Y coordinate offset (East).
-        double y;
-        //! Z coordinate offset (Down).
-        double z;
-        //! Z units for the Z offset (Down).
-        uint8_t z_units;
-        //! time coordinate offset.
-        double t;
-      };
+      typedef TrajectoryBuffer::Point TPoint;
 
       //! Get a point in the trajectory.
-      //! @param t_index index of point
+      //! @param t_index index of point (must not have been released)
       //! @return corresponding traj. point
       inline const TPoint&
       point(int t_index) const
       {
-        return m_traj[t_index];
+        return m_traj.at(t_index);
       }
 
-      //! Get number of points in the trajetory.
+      //! Get number of points in the trajetory received so far.
       inline size_t
       trajectory_points(void) const
       {
-        return m_traj.size();
+        return m_traj.getEnd();
       }
 
+      //! Check if all points of the trajectory have been received.
+      //! @return true if no more points will be received.
+      inline bool
+      isTrajectoryComplete(void) const
+      {
+        return m_traj.isComplete();
+      }
+
+      //! Release the points before a given point, making room for
+      //! more streamed points.
+      //! @param t_index index of the oldest point still needed.
+      void
+      releasePoints(size_t t_index);
+
       //! Get control step period.
       //! @return control step period.
       inline double
@@ -162,7 +182,15 @@ namespace DUNE
 
     private:
       //! Trajectory points.
-      std::vector<TPoint> m_traj;
+      TrajectoryBuffer m_traj;
+      //! Maximum number of buffered trajectory points.
+      unsigned m_traj_capacity;
+      //! True if the trajectory is being streamed.
+      bool m_stream;
+      //! Z reference of the trajectory.
+      double m_z;
+      //! Z units of the trajectory.
+      uint8_t m_z_units;
       //! Approach stage flag.
       bool m_approach;
       //! Reference latitude set.
@@ -179,6 +207,15 @@ namespace DUNE
       //! Routine to initiate trajectory by displacing tpoints
       bool
       initTrajectory(const IMC::FollowTrajectory*);
+
+      //! Add trajectory points to the buffer.
+      //! @param list trajectory points.
+      void
+      addPoints(const IMC::MessageList<IMC::TrajectoryPoint>& list);
+
+      //! Report the state of the trajectory buffer.
+      void
+      reportBuffer(void);
     };
   }
 }
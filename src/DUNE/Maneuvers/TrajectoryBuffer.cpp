@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Maneuvers/TrajectoryBuffer.hpp>
+
+namespace DUNE
+{
+  namespace Maneuvers
+  {
+    TrajectoryBuffer::TrajectoryBuffer(uint32_t capacity):
+      m_points(capacity),
+      m_first(0),
+      m_complete(false)
+    { }
+
+    void
+    TrajectoryBuffer::setCapacity(uint32_t capacity)
+    {
+      m_points.setCapacity(capacity);
+    }
+
+    void
+    TrajectoryBuffer::clear(void)
+    {
+      m_points.clear();
+      m_first = 0;
+      m_complete = false;
+    }
+
+    bool
+    TrajectoryBuffer::push(const Point& point)
+    {
+      if (getFree() == 0)
+        return false;
+
+      m_points.add(point);
+      return true;
+    }
+
+    void
+    TrajectoryBuffer::release(uint32_t index)
+    {
+      while (m_first < index && m_points.getSize() > 0)
+      {
+        m_points.pop();
+        ++m_first;
+      }
+    }
+
+    bool
+    TrajectoryBuffer::sample(double t, Point& point) const
+    {
+      uint32_t size = m_points.getSize();
+
+      if (size == 0 || t < m_points(0).t || t > m_points(size - 1).t)
+        return false;
+
+      // Points are ordered in time: find the segment by bisection.
+      uint32_t lo = 0;
+      uint32_t hi = size - 1;
+
+      while (hi - lo > 1)
+      {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (m_points(mid).t <= t)
+          lo = mid;
+        else
+          hi = mid;
+      }
+
+      const Point& a = m_points(lo);
+      const Point& b = m_points(hi);
+
+      point = a;
+
+      if (b.t <= a.t)
+        return true;
+
+      double f = (t - a.t) / (b.t - a.t);
+
+      point.x = a.x + f * (b.x - a.x);
+      point.y = a.y + f * (b.y - a.y);
+      point.z = a.z + f * (b.z - a.z);
+      point.t = t;
+      return true;
+    }
+  }
+}
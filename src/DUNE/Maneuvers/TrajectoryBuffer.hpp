@@ -0,0 +1,177 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MANEUVERS_TRAJECTORY_BUFFER_HPP_INCLUDED_
+#define DUNE_MANEUVERS_TRAJECTORY_BUFFER_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Utils/CircularBuffer.hpp>
+
+namespace DUNE
+{
+  namespace Maneuvers
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM TrajectoryBuffer;
+
+    //! Bounded buffer of time-stamped trajectory points. Points are
+    //! addressed by their index in the whole trajectory, so that a
+    //! trajectory longer than the buffer can be streamed in while it
+    //! is followed: consumed points are released and new points are
+    //! added as space becomes available.
+    class TrajectoryBuffer
+    {
+    public:
+      //! Trajectory point.
+      struct Point
+      {
+        //! X coordinate offset (North).
+        double x;
+        //! Y coordinate offset (East).
+        double y;
+        //! Z coordinate offset (Down).
+        double z;
+        //! Z units for the Z offset (Down).
+        uint8_t z_units;
+        //! time coordinate offset.
+        double t;
+      };
+
+      //! Constructor.
+      //! @param[in] capacity maximum number of points.
+      TrajectoryBuffer(uint32_t capacity = 1024);
+
+      //! Change the maximum number of points. Points that do not fit
+      //! in the new capacity are discarded, newest first.
+      //! @param[in] capacity maximum number of points.
+      void
+      setCapacity(uint32_t capacity);
+
+      //! Get the maximum number of points.
+      //! @return maximum number of points.
+      uint32_t
+      getCapacity(void) const
+      {
+        return m_points.getCapacity();
+      }
+
+      //! Get the number of points that can be added.
+      //! @return number of free points.
+      uint32_t
+      getFree(void) const
+      {
+        return m_points.getCapacity() - m_points.getSize();
+      }
+
+      //! Remove all points and restart the trajectory.
+      void
+      clear(void);
+
+      //! Add a point to the end of the trajectory.
+      //! @param[in] point trajectory point.
+      //! @return true if the point was added, false if the buffer is full.
+      bool
+      push(const Point& point);
+
+      //! Get the index of the oldest point in the buffer.
+      //! @return index of the oldest point.
+      uint32_t
+      getFirst(void) const
+      {
+        return m_first;
+      }
+
+      //! Get the index following the newest point in the buffer,
+      //! i.e., the number of points added since the trajectory
+      //! started.
+      //! @return index following the newest point.
+      uint32_t
+      getEnd(void) const
+      {
+        return m_first + m_points.getSize();
+      }
+
+      //! Check if a point is in the buffer.
+      //! @param[in] index index of the point.
+      //! @return true if the point is in the buffer, false otherwise.
+      bool
+      contains(uint32_t index) const
+      {
+        return index >= getFirst() && index < getEnd();
+      }
+
+      //! Get a point.
+      //! @param[in] index index of the point (see contains()).
+      //! @return trajectory point.
+      const Point&
+      at(uint32_t index) const
+      {
+        return m_points(index - m_first);
+      }
+
+      //! Discard all points before a given point.
+      //! @param[in] index index of the oldest point to keep.
+      void
+      release(uint32_t index);
+
+      //! Mark the trajectory as complete, i.e., no more points
+      //! will be added.
+      void
+      setComplete(void)
+      {
+        m_complete = true;
+      }
+
+      //! Check if the trajectory is complete.
+      //! @return true if no more points will be added, false otherwise.
+      bool
+      isComplete(void) const
+      {
+        return m_complete;
+      }
+
+      //! Interpolate the trajectory at a given time.
+      //! @param[in] t time offset.
+      //! @param[out] point interpolated point.
+      //! @return true if time is covered by the points in the buffer,
+      //! false otherwise.
+      bool
+      sample(double t, Point& point) const;
+
+    private:
+      //! Points.
+      Utils::CircularBuffer<Point> m_points;
+      //! Index of the oldest point.
+      uint32_t m_first;
+      //! True if no more points will be added.
+      bool m_complete;
+    };
+  }
+}
+
+#endif
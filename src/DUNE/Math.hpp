@@ -38,12 +38,15 @@ namespace DUNE
 #include <DUNE/Math/Constants.hpp>
 #include <DUNE/Math/Derivative.hpp>
 #include <DUNE/Math/General.hpp>
+#include <DUNE/Math/Kernels.hpp>
 #include <DUNE/Math/Matrix.hpp>
+#include <DUNE/Math/FixedMatrix.hpp>
 #include <DUNE/Math/Angles.hpp>
 #include <DUNE/Math/Random.hpp>
 #include <DUNE/Math/Optimization.hpp>
 #include <DUNE/Math/QPSolver.hpp>
 #include <DUNE/Math/MovingAverage.hpp>
 #include <DUNE/Math/MultiMovingAverage.hpp>
+#include <DUNE/Math/WindowedStatistics.hpp>
 
 #endif
@@ -0,0 +1,610 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_FIXED_MATRIX_HPP_INCLUDED_
+#define DUNE_MATH_FIXED_MATRIX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Matrix.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Base of matrix expressions with dimensions known at compile
+    //! time. Sums, differences, scalings and transpositions of fixed
+    //! matrices are expressions, evaluated element by element when
+    //! assigned, without temporary matrices.
+    //! @tparam E expression type.
+    //! @tparam R number of rows.
+    //! @tparam C number of columns.
+    template <typename E, unsigned R, unsigned C>
+    class FixedExpression
+    {
+    public:
+      //! Get an element of the expression.
+      //! @param[in] i row index.
+      //! @param[in] j column index.
+      //! @return element value.
+      double
+      operator()(unsigned i, unsigned j) const
+      {
+        return static_cast<const E&>(*this)(i, j);
+      }
+
+      //! Get the expression.
+      //! @return expression.
+      const E&
+      self(void) const
+      {
+        return static_cast<const E&>(*this);
+      }
+    };
+
+    //! Element-wise sum of two expressions.
+    template <typename A, typename B, unsigned R, unsigned C>
+    class FixedSum: public FixedExpression<FixedSum<A, B, R, C>, R, C>
+    {
+    public:
+      FixedSum(const A& a, const B& b):
+        m_a(a),
+        m_b(b)
+      { }
+
+      double
+      operator()(unsigned i, unsigned j) const
+      {
+        return m_a(i, j) + m_b(i, j);
+      }
+
+    private:
+      const A& m_a;
+      const B& m_b;
+    };
+
+    //! Element-wise difference of two expressions.
+    template <typename A, typename B, unsigned R, unsigned C>
+    class FixedDifference: public FixedExpression<FixedDifference<A, B, R, C>, R, C>
+    {
+    public:
+      FixedDifference(const A& a, const B& b):
+        m_a(a),
+        m_b(b)
+      { }
+
+      double
+      operator()(unsigned i, unsigned j) const
+      {
+        return m_a(i, j) - m_b(i, j);
+      }
+
+    private:
+      const A& m_a;
+      const B& m_b;
+    };
+
+    //! Expression multiplied by a scalar.
+    template <typename A, unsigned R, unsigned C>
+    class FixedScale: public FixedExpression<FixedScale<A, R, C>, R, C>
+    {
+    public:
+      FixedScale(const A& a, double x):
+        m_a(a),
+        m_x(x)
+      { }
+
+      double
+      operator()(unsigned i, unsigned j) const
+      {
+        return m_a(i, j) * m_x;
+      }
+
+    private:
+      const A& m_a;
+      double m_x;
+    };
+
+    //! Transpose of an expression.
+    template <typename A, unsigned R, unsigned C>
+    class FixedTranspose: public FixedExpression<FixedTranspose<A, R, C>, R, C>
+    {
+    public:
+      FixedTranspose(const A& a):
+        m_a(a)
+      { }
+
+      double
+      operator()(unsigned i, unsigned j) const
+      {
+        return m_a(j, i);
+      }
+
+    private:
+      const A& m_a;
+    };
+
+    //! Matrix with dimensions known at compile time. Elements are
+    //! stored by row inside the object, so fixed matrices never
+    //! allocate memory and loops over their elements have constant
+    //! bounds that compilers unroll. Fixed matrices are meant for the
+    //! small matrices (3x3, 6x6, ...) of filters and control laws
+    //! and can be converted to and from Matrix.
+    //!
+    //! Since expressions keep references to their operands, they
+    //! must be assigned to a matrix within the statement that
+    //! creates them.
+    //! @tparam R number of rows.
+    //! @tparam C number of columns.
+    template <unsigned R, unsigned C>
+    class FixedMatrix: public FixedExpression<FixedMatrix<R, C>, R, C>
+    {
+    public:
+      //! Construct a matrix filled with zeros.
+      FixedMatrix(void)
+      {
+        fill(0.0);
+      }
+
+      //! Construct a matrix filled with a value.
+      //! @param[in] value value.
+      explicit FixedMatrix(double value)
+      {
+        fill(value);
+      }
+
+      //! Construct a matrix from an array of elements, by row.
+      //! @param[in] data R * C elements.
+      explicit FixedMatrix(const double* data)
+      {
+        for (unsigned i = 0; i < R * C; ++i)
+          m_data[i] = data[i];
+      }
+
+      //! Construct a matrix from a dynamic matrix.
+      //! @param[in] m matrix with R rows and C columns.
+      explicit FixedMatrix(const Matrix& m)
+      {
+        *this = m;
+      }
+
+      //! Evaluate an expression.
+      //! @param[in] e expression.
+      template <typename E>
+      FixedMatrix(const FixedExpression<E, R, C>& e)
+      {
+        assign(e.self());
+      }
+
+      //! Evaluate an expression.
+      //! @param[in] e expression.
+      //! @return this matrix.
+      template <typename E>
+      FixedMatrix&
+      operator=(const FixedExpression<E, R, C>& e)
+      {
+        // Expressions may refer to this matrix (e.g. a = transpose(a)).
+        FixedMatrix tmp;
+        tmp.assign(e.self());
+        return *this = tmp;
+      }
+
+      //! Copy the elements of a dynamic matrix.
+      //! @param[in] m matrix with R rows and C columns.
+      //! @return this matrix.
+      FixedMatrix&
+      operator=(const Matrix& m)
+      {
+        if (m.rows() != R || m.columns() != C)
+          throw Matrix::Error("invalid dimension");
+
+        for (unsigned i = 0; i < R; ++i)
+          for (unsigned j = 0; j < C; ++j)
+            m_data[i * C + j] = m(i, j);
+
+        return *this;
+      }
+
+      //! Convert to a dynamic matrix.
+      //! @return matrix.
+      Matrix
+      toMatrix(void) const
+      {
+        return Matrix(const_cast<double*>(m_data), R, C);
+      }
+
+      //! Get the number of rows.
+      //! @return number of rows.
+      static unsigned
+      rows(void)
+      {
+        return R;
+      }
+
+      //! Get the number of columns.
+      //! @return number of columns.
+      static unsigned
+      columns(void)
+      {
+        return C;
+      }
+
+      //! Get the number of elements.
+      //! @return number of elements.
+      static unsigned
+      size(void)
+      {
+        return R * C;
+      }
+
+      //! Get the elements, by row.
+      //! @return elements.
+      const double*
+      data(void) const
+      {
+        return m_data;
+      }
+
+      //! Get the elements, by row.
+      //! @return elements.
+      double*
+      data(void)
+      {
+        return m_data;
+      }
+
+      double&
+      operator()(unsigned i, unsigned j)
+      {
+        return m_data[i * C + j];
+      }
+
+      double
+      operator()(unsigned i, unsigned j) const
+      {
+        return m_data[i * C + j];
+      }
+
+      //! Access an element by its index in row order (for vectors).
+      double&
+      operator()(unsigned i)
+      {
+        return m_data[i];
+      }
+
+      double
+      operator()(unsigned i) const
+      {
+        return m_data[i];
+      }
+
+      //! Fill the matrix with a value.
+      //! @param[in] value value.
+      void
+      fill(double value)
+      {
+        for (unsigned i = 0; i < R * C; ++i)
+          m_data[i] = value;
+      }
+
+      //! Make this matrix an identity matrix.
+      void
+      identity(void)
+      {
+        for (unsigned i = 0; i < R; ++i)
+          for (unsigned j = 0; j < C; ++j)
+            m_data[i * C + j] = (i == j) ? 1.0 : 0.0;
+      }
+
+      //! Get a block of the matrix.
+      //! @tparam BR number of rows of the block.
+      //! @tparam BC number of columns of the block.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @return block.
+      template <unsigned BR, unsigned BC>
+      FixedMatrix<BR, BC>
+      get(unsigned i, unsigned j) const
+      {
+        FixedMatrix<BR, BC> m;
+        for (unsigned k = 0; k < BR; ++k)
+          for (unsigned l = 0; l < BC; ++l)
+            m(k, l) = m_data[(i + k) * C + j + l];
+        return m;
+      }
+
+      //! Replace a block of the matrix.
+      //! @param[in] i first row.
+      //! @param[in] j first column.
+      //! @param[in] m block.
+      template <unsigned BR, unsigned BC>
+      void
+      set(unsigned i, unsigned j, const FixedMatrix<BR, BC>& m)
+      {
+        for (unsigned k = 0; k < BR; ++k)
+          for (unsigned l = 0; l < BC; ++l)
+            m_data[(i + k) * C + j + l] = m(k, l);
+      }
+
+      template <typename E>
+      FixedMatrix&
+      operator+=(const FixedExpression<E, R, C>& e)
+      {
+        FixedMatrix tmp(e);
+        for (unsigned i = 0; i < R * C; ++i)
+          m_data[i] += tmp.m_data[i];
+        return *this;
+      }
+
+      template <typename E>
+      FixedMatrix&
+      operator-=(const FixedExpression<E, R, C>& e)
+      {
+        FixedMatrix tmp(e);
+        for (unsigned i = 0; i < R * C; ++i)
+          m_data[i] -= tmp.m_data[i];
+        return *this;
+      }
+
+      FixedMatrix&
+      operator*=(double x)
+      {
+        for (unsigned i = 0; i < R * C; ++i)
+          m_data[i] *= x;
+        return *this;
+      }
+
+      FixedMatrix&
+      operator/=(double x)
+      {
+        for (unsigned i = 0; i < R * C; ++i)
+          m_data[i] /= x;
+        return *this;
+      }
+
+      bool
+      operator==(const FixedMatrix& m) const
+      {
+        for (unsigned i = 0; i < R * C; ++i)
+        {
+          if (m_data[i] != m.m_data[i])
+            return false;
+        }
+
+        return true;
+      }
+
+      bool
+      operator!=(const FixedMatrix& m) const
+      {
+        return !(*this == m);
+      }
+
+      //! Compute the sum of the diagonal elements.
+      //! @return trace.
+      double
+      trace(void) const
+      {
+        double sum = 0;
+        for (unsigned i = 0; i < R && i < C; ++i)
+          sum += m_data[i * C + i];
+        return sum;
+      }
+
+      //! Compute the Euclidean (Frobenius) norm.
+      //! @return norm.
+      double
+      norm_2(void) const
+      {
+        double sum = 0;
+        for (unsigned i = 0; i < R * C; ++i)
+          sum += m_data[i] * m_data[i];
+        return std::sqrt(sum);
+      }
+
+    private:
+      //! Elements, by row.
+      double m_data[R * C];
+
+      template <typename E>
+      void
+      assign(const E& e)
+      {
+        for (unsigned i = 0; i < R; ++i)
+          for (unsigned j = 0; j < C; ++j)
+            m_data[i * C + j] = e(i, j);
+      }
+    };
+
+    template <typename A, typename B, unsigned R, unsigned C>
+    inline FixedSum<A, B, R, C>
+    operator+(const FixedExpression<A, R, C>& a, const FixedExpression<B, R, C>& b)
+    {
+      return FixedSum<A, B, R, C>(a.self(), b.self());
+    }
+
+    template <typename A, typename B, unsigned R, unsigned C>
+    inline FixedDifference<A, B, R, C>
+    operator-(const FixedExpression<A, R, C>& a, const FixedExpression<B, R, C>& b)
+    {
+      return FixedDifference<A, B, R, C>(a.self(), b.self());
+    }
+
+    template <typename A, unsigned R, unsigned C>
+    inline FixedScale<A, R, C>
+    operator*(const FixedExpression<A, R, C>& a, double x)
+    {
+      return FixedScale<A, R, C>(a.self(), x);
+    }
+
+    template <typename A, unsigned R, unsigned C>
+    inline FixedScale<A, R, C>
+    operator*(double x, const FixedExpression<A, R, C>& a)
+    {
+      return FixedScale<A, R, C>(a.self(), x);
+    }
+
+    template <typename A, unsigned R, unsigned C>
+    inline FixedScale<A, R, C>
+    operator/(const FixedExpression<A, R, C>& a, double x)
+    {
+      return FixedScale<A, R, C>(a.self(), 1.0 / x);
+    }
+
+    template <typename A, unsigned R, unsigned C>
+    inline FixedScale<A, R, C>
+    operator-(const FixedExpression<A, R, C>& a)
+    {
+      return FixedScale<A, R, C>(a.self(), -1.0);
+    }
+
+    //! Transpose an expression.
+    template <typename A, unsigned R, unsigned C>
+    inline FixedTranspose<A, C, R>
+    transpose(const FixedExpression<A, R, C>& a)
+    {
+      return FixedTranspose<A, C, R>(a.self());
+    }
+
+    //! Multiply two matrices. Products are evaluated immediately,
+    //! since evaluating them per element of an enclosing expression
+    //! would repeat work.
+    //! @param[in] a left operand.
+    //! @param[in] b right operand.
+    //! @return product.
+    template <unsigned R, unsigned K, unsigned C>
+    inline FixedMatrix<R, C>
+    operator*(const FixedMatrix<R, K>& a, const FixedMatrix<K, C>& b)
+    {
+      FixedMatrix<R, C> m;
+
+      // Row-major loop order for unit stride access.
+      for (unsigned i = 0; i < R; ++i)
+      {
+        for (unsigned k = 0; k < K; ++k)
+        {
+          double aik = a(i, k);
+          for (unsigned j = 0; j < C; ++j)
+            m(i, j) += aik * b(k, j);
+        }
+      }
+
+      return m;
+    }
+
+    //! Multiply two expressions.
+    template <typename A, typename B, unsigned R, unsigned K, unsigned C>
+    inline FixedMatrix<R, C>
+    operator*(const FixedExpression<A, R, K>& a, const FixedExpression<B, K, C>& b)
+    {
+      return FixedMatrix<R, K>(a) * FixedMatrix<K, C>(b);
+    }
+
+    //! Invert a square matrix, using Gauss-Jordan elimination with
+    //! partial pivoting.
+    //! @param[in] a matrix.
+    //! @return inverse.
+    //! @throw Matrix::Error if the matrix is singular.
+    template <unsigned N>
+    inline FixedMatrix<N, N>
+    inverse(const FixedMatrix<N, N>& a)
+    {
+      FixedMatrix<N, N> m(a);
+      FixedMatrix<N, N> inv;
+      inv.identity();
+
+      for (unsigned c = 0; c < N; ++c)
+      {
+        unsigned p = c;
+        for (unsigned i = c + 1; i < N; ++i)
+        {
+          if (std::fabs(m(i, c)) > std::fabs(m(p, c)))
+            p = i;
+        }
+
+        if (std::fabs(m(p, c)) <= Matrix::get_precision())
+          throw Matrix::Error("inversion error");
+
+        if (p != c)
+        {
+          for (unsigned j = 0; j < N; ++j)
+          {
+            std::swap(m(p, j), m(c, j));
+            std::swap(inv(p, j), inv(c, j));
+          }
+        }
+
+        double d = 1.0 / m(c, c);
+        for (unsigned j = 0; j < N; ++j)
+        {
+          m(c, j) *= d;
+          inv(c, j) *= d;
+        }
+
+        for (unsigned i = 0; i < N; ++i)
+        {
+          if (i == c)
+            continue;
+
+          double f = m(i, c);
+          if (f == 0)
+            continue;
+
+          for (unsigned j = 0; j < N; ++j)
+          {
+            m(i, j) -= f * m(c, j);
+            inv(i, j) -= f * inv(c, j);
+          }
+        }
+      }
+
+      return inv;
+    }
+
+    template <unsigned R, unsigned C>
+    std::ostream&
+    operator<<(std::ostream& os, const FixedMatrix<R, C>& m)
+    {
+      for (unsigned i = 0; i < R; ++i)
+      {
+        for (unsigned j = 0; j < C; ++j)
+          os << m(i, j) << ' ';
+        os << std::endl;
+      }
+
+      return os;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,329 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Math/Kernels.hpp>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define DUNE_KERNELS_SSE2
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#  include <arm_neon.h>
+#  define DUNE_KERNELS_NEON
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__))                          \
+  && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#  include <immintrin.h>
+#  define DUNE_KERNELS_AVX
+#endif
+
+namespace DUNE
+{
+  namespace Math
+  {
+    namespace Kernels
+    {
+      //! Rows of b kept in cache by gemm().
+      static const size_t c_block_rows = 64;
+      //! Columns of b kept in cache by gemm().
+      static const size_t c_block_columns = 256;
+      //! Minimum row length worth vector instructions.
+      static const size_t c_min_vector = 8;
+      //! Side of the tiles of transpose().
+      static const size_t c_tile = 32;
+
+      //! Signature of axpy implementations.
+      typedef void (*AxpyFunction)(size_t, double, const double*, double*);
+      //! Signature of dot implementations.
+      typedef double (*DotFunction)(size_t, const double*, const double*);
+
+      static void
+      axpyScalar(size_t n, double a, const double* x, double* y)
+      {
+        for (size_t i = 0; i < n; ++i)
+          y[i] += a * x[i];
+      }
+
+      static double
+      dotScalar(size_t n, const double* x, const double* y)
+      {
+        double s = 0;
+        for (size_t i = 0; i < n; ++i)
+          s += x[i] * y[i];
+        return s;
+      }
+
+#if defined(DUNE_KERNELS_SSE2)
+      static void
+      axpySSE2(size_t n, double a, const double* x, double* y)
+      {
+        __m128d va = _mm_set1_pd(a);
+        size_t i = 0;
+
+        for (; i + 2 <= n; i += 2)
+          _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+
+        for (; i < n; ++i)
+          y[i] += a * x[i];
+      }
+
+      static double
+      dotSSE2(size_t n, const double* x, const double* y)
+      {
+        __m128d vs = _mm_setzero_pd();
+        size_t i = 0;
+
+        for (; i + 2 <= n; i += 2)
+          vs = _mm_add_pd(vs, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+
+        double s[2];
+        _mm_storeu_pd(s, vs);
+        s[0] += s[1];
+
+        for (; i < n; ++i)
+          s[0] += x[i] * y[i];
+
+        return s[0];
+      }
+#endif
+
+#if defined(DUNE_KERNELS_AVX)
+      __attribute__((target("avx"))) static void
+      axpyAVX(size_t n, double a, const double* x, double* y)
+      {
+        __m256d va = _mm256_set1_pd(a);
+        size_t i = 0;
+
+        for (; i + 4 <= n; i += 4)
+          _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(va, _mm256_loadu_pd(x + i))));
+
+        for (; i < n; ++i)
+          y[i] += a * x[i];
+      }
+
+      __attribute__((target("avx"))) static double
+      dotAVX(size_t n, const double* x, const double* y)
+      {
+        __m256d vs = _mm256_setzero_pd();
+        size_t i = 0;
+
+        for (; i + 4 <= n; i += 4)
+          vs = _mm256_add_pd(vs, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+
+        double s[4];
+        _mm256_storeu_pd(s, vs);
+        s[0] += s[1] + s[2] + s[3];
+
+        for (; i < n; ++i)
+          s[0] += x[i] * y[i];
+
+        return s[0];
+      }
+#endif
+
+#if defined(DUNE_KERNELS_NEON)
+      static void
+      axpyNEON(size_t n, double a, const double* x, double* y)
+      {
+        float64x2_t va = vdupq_n_f64(a);
+        size_t i = 0;
+
+        for (; i + 2 <= n; i += 2)
+          vst1q_f64(y + i, vaddq_f64(vld1q_f64(y + i), vmulq_f64(va, vld1q_f64(x + i))));
+
+        for (; i < n; ++i)
+          y[i] += a * x[i];
+      }
+
+      static double
+      dotNEON(size_t n, const double* x, const double* y)
+      {
+        float64x2_t vs = vdupq_n_f64(0);
+        size_t i = 0;
+
+        for (; i + 2 <= n; i += 2)
+          vs = vaddq_f64(vs, vmulq_f64(vld1q_f64(x + i), vld1q_f64(y + i)));
+
+        double s = vgetq_lane_f64(vs, 0) + vgetq_lane_f64(vs, 1);
+
+        for (; i < n; ++i)
+          s += x[i] * y[i];
+
+        return s;
+      }
+#endif
+
+      //! Kernel implementations selected for this CPU.
+      struct Implementation
+      {
+        const char* name;
+        AxpyFunction axpy;
+        DotFunction dot;
+
+        Implementation(void):
+          name("scalar"),
+          axpy(axpyScalar),
+          dot(dotScalar)
+        {
+#if defined(DUNE_KERNELS_SSE2)
+          name = "sse2";
+          axpy = axpySSE2;
+          dot = dotSSE2;
+#endif
+
+#if defined(DUNE_KERNELS_NEON)
+          name = "neon";
+          axpy = axpyNEON;
+          dot = dotNEON;
+#endif
+
+#if defined(DUNE_KERNELS_AVX)
+          __builtin_cpu_init();
+          if (__builtin_cpu_supports("avx"))
+          {
+            name = "avx";
+            axpy = axpyAVX;
+            dot = dotAVX;
+          }
+#endif
+        }
+      };
+
+      static const Implementation&
+      getImplementation(void)
+      {
+        static const Implementation impl;
+        return impl;
+      }
+
+      const char*
+      getInstructionSet(void)
+      {
+        return getImplementation().name;
+      }
+
+      void
+      axpy(size_t n, double a, const double* x, double* y)
+      {
+        if (n < c_min_vector)
+          axpyScalar(n, a, x, y);
+        else
+          getImplementation().axpy(n, a, x, y);
+      }
+
+      double
+      dot(size_t n, const double* x, const double* y)
+      {
+        if (n < c_min_vector)
+          return dotScalar(n, x, y);
+
+        return getImplementation().dot(n, x, y);
+      }
+
+      void
+      gemm(size_t n, size_t m, size_t r, const double* a, const double* b, double* c)
+      {
+        std::fill(c, c + n * r, 0.0);
+
+        AxpyFunction f = (r < c_min_vector) ? axpyScalar : getImplementation().axpy;
+
+        // Blocks of b are reused by all rows of a while in cache.
+        // Each element of c accumulates its terms in order of k.
+        for (size_t kk = 0; kk < m; kk += c_block_rows)
+        {
+          size_t ke = std::min(kk + c_block_rows, m);
+
+          for (size_t jj = 0; jj < r; jj += c_block_columns)
+          {
+            size_t jn = std::min(c_block_columns, r - jj);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+              const double* ai = a + i * m;
+              double* ci = c + i * r + jj;
+
+              for (size_t k = kk; k < ke; ++k)
+                f(jn, ai[k], b + k * r + jj, ci);
+            }
+          }
+        }
+      }
+
+      void
+      transpose(size_t n, size_t m, const double* a, double* t)
+      {
+        for (size_t ii = 0; ii < n; ii += c_tile)
+        {
+          size_t ie = std::min(ii + c_tile, n);
+
+          for (size_t jj = 0; jj < m; jj += c_tile)
+          {
+            size_t je = std::min(jj + c_tile, m);
+
+            for (size_t i = ii; i < ie; ++i)
+              for (size_t j = jj; j < je; ++j)
+                t[j * n + i] = a[i * m + j];
+          }
+        }
+      }
+
+      bool
+      cholesky(size_t n, double* a)
+      {
+        for (size_t j = 0; j < n; ++j)
+        {
+          double* lj = a + j * n;
+          double d = lj[j] - dot(j, lj, lj);
+
+          if (!(d > 0))
+            return false;
+
+          d = std::sqrt(d);
+          lj[j] = d;
+
+          for (size_t i = j + 1; i < n; ++i)
+          {
+            double* li = a + i * n;
+            li[j] = (li[j] - dot(j, li, lj)) / d;
+          }
+
+          std::fill(lj + j + 1, lj + n, 0.0);
+        }
+
+        return true;
+      }
+    }
+  }
+}
@@ -0,0 +1,102 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_KERNELS_HPP_INCLUDED_
+#define DUNE_MATH_KERNELS_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Dense linear algebra kernels over row-major arrays of doubles,
+    //! used by Matrix. Kernels use the widest vector instructions
+    //! available: SSE2 or NEON when the target has them, and AVX when
+    //! the CPU supports it at run time (GCC and Clang on x86).
+    //! Products accumulate in the same order as the scalar code and
+    //! do not use fused multiply-add, so results do not depend on the
+    //! instruction set.
+    namespace Kernels
+    {
+      //! Get the name of the instruction set in use.
+      //! @return instruction set name.
+      DUNE_DLL_SYM const char*
+      getInstructionSet(void);
+
+      //! Compute y = y + a * x.
+      //! @param[in] n number of elements.
+      //! @param[in] a scalar.
+      //! @param[in] x vector.
+      //! @param[in,out] y vector.
+      DUNE_DLL_SYM void
+      axpy(size_t n, double a, const double* x, double* y);
+
+      //! Compute the dot product of two vectors.
+      //! @param[in] n number of elements.
+      //! @param[in] x vector.
+      //! @param[in] y vector.
+      //! @return dot product.
+      DUNE_DLL_SYM double
+      dot(size_t n, const double* x, const double* y);
+
+      //! Compute c = a * b.
+      //! @param[in] n number of rows of a.
+      //! @param[in] m number of columns of a (rows of b).
+      //! @param[in] r number of columns of b.
+      //! @param[in] a n x m matrix.
+      //! @param[in] b m x r matrix.
+      //! @param[out] c n x r matrix (must not overlap a or b).
+      DUNE_DLL_SYM void
+      gemm(size_t n, size_t m, size_t r, const double* a, const double* b, double* c);
+
+      //! Transpose a matrix.
+      //! @param[in] n number of rows.
+      //! @param[in] m number of columns.
+      //! @param[in] a n x m matrix.
+      //! @param[out] t m x n matrix (must not overlap a).
+      DUNE_DLL_SYM void
+      transpose(size_t n, size_t m, const double* a, double* t);
+
+      //! Compute, in place, the Cholesky factor L of a symmetric
+      //! positive definite matrix A = L * L'. Only the lower triangle
+      //! of the matrix is read; the upper triangle is zeroed.
+      //! @param[in] n matrix order.
+      //! @param[in,out] a n x n matrix.
+      //! @return true on success, false if the matrix is not
+      //! positive definite.
+      DUNE_DLL_SYM bool
+      cholesky(size_t n, double* a);
+    }
+  }
+}
+
+#endif
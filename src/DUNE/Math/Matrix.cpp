@@ -46,6 +46,7 @@
 #include <DUNE/Utils/String.hpp>
 #include <DUNE/Math/Matrix.hpp>
 #include <DUNE/Math/General.hpp>
+#include <DUNE/Math/Kernels.hpp>
 #include <DUNE/Parsers/Config.hpp>
 
 #define ALLOCD(count) (double*)std::malloc(sizeof(double) * (count))
@@ -923,17 +924,21 @@ namespace DUNE
         throw Error(" matrix is not square ");
 
       unsigned int permutations = 0;
+      size_t n = m_nrows;
       Matrix A = *this;
-      Matrix Lf(m_nrows), dI(m_nrows), Per(m_nrows);
-      dI = dI + dI;
+      Matrix Lf(n), Per(n);
 
-      for (size_t i = 0; i < m_nrows - 1; i++)
+      // Copy-on-write happens here, not in the loops below.
+      A.split();
+      Lf.split();
+
+      for (size_t i = 0; i + 1 < n; i++)
       {
         if (Matrix::precision >= std::fabs(A(i, i)))
         {
           bool p = 0;
-          for (size_t k = i + 1; k < m_nrows; k++)
-            if (Matrix::precision >= std::fabs(A(k, i)))
+          for (size_t k = i + 1; k < n; k++)
+            if (Matrix::precision < std::fabs(A(k, i)))
             {
               A.swapRows(i, k);
               Per.swapRows(i, k);
@@ -946,16 +951,18 @@ namespace DUNE
             permutations++;
         }
 
-        Matrix Lt(m_nrows); // gaussian matrix
-        for (size_t j = i + 1; j < m_nrows; j++)
-          Lt(j, i) = -A(j, i) / A(i, i);
+        // Eliminate column i below the diagonal: rows of A are
+        // updated in place instead of multiplying by a gaussian
+        // matrix, and Lf accumulates the multipliers.
+        double* ai = A.m_data + i * n;
+        for (size_t j = i + 1; j < n; j++)
+        {
+          double f = A.m_data[j * n + i] / ai[i];
+          Lf.m_data[j * n + i] = f;
 
-        /*
-          A = Lt * A;
-          Lf = Lf * (dI - Lt);
-        */
-        A = Lt.multiply(A);
-        Lf = Lf.multiply((dI - Lt)); // dI-Lt is the inverse of Lt (gaussian matrix)
+          if (std::fabs(f) > precision)
+            Kernels::axpy(n, -f, ai, A.m_data + j * n);
+        }
       }
 
       P = Per;
@@ -1265,41 +1272,22 @@ namespace DUNE
 
       Matrix s(m_nrows, m2.m_ncols);
 
-      int n = m_nrows;
-      int m = m_ncols;
-      int r = m2.m_ncols;
+      size_t n = m_nrows;
+      size_t m = m_ncols;
+      size_t r = m2.m_ncols;
 
       double* m1_p = m_data;
+      std::fill(s.m_data, s.m_data + s.m_size, 0.0);
 
-      for (int i = 0; i < n; i++)
+      for (size_t i = 0; i < n; i++)
       {
-        for (int k = 0; k < m; k++)
+        for (size_t k = 0; k < m; k++)
         {
           double v = *m1_p++; // <-> v = m1(i,k)
-          double* m2_p = m2.m_data + k * r;
-          double* s_p = s.m_data + i * r;
 
-          // not pretty, but hopefully faster
-          if (std::fabs(v) <= precision)
-          {
-            if (!k)
-            {
-              for (int j = 0; j < r; j++)
-              {
-                *s_p = 0;
-                s_p++;
-              }
-            }
-          }
-          else
-            for (int j = 0; j < r; j++)
-            {
-              if (!k)
-                *s_p = 0;
-              *s_p += v * (*m2_p); // <-> s(i,j) += m1(i,k) * m2(k,j)
-              s_p++;
-              m2_p++;
-            }
+          // Skip negligible terms.
+          if (std::fabs(v) > precision)
+            Kernels::axpy(r, v, m2.m_data + k * r, s.m_data + i * r);
         }
       }
       return s;
@@ -1350,31 +1338,7 @@ namespace DUNE
         throw Matrix::Error("incompatible dimensions");
 
       Matrix s(m1.m_nrows, m2.m_ncols);
-
-      int n = m1.m_nrows;
-      int m = m1.m_ncols;
-      int r = m2.m_ncols;
-
-      double* m1_p = m1.m_data;
-
-      for (int i = 0; i < n; i++)
-      {
-        for (int k = 0; k < m; k++)
-        {
-          double v = *m1_p++; // <-> v = m1(i,k)
-          double* m2_p = m2.m_data + k * r;
-          double* s_p = s.m_data + i * r;
-
-          for (int j = 0; j < r; j++)
-          {
-            if (!k)
-              *s_p = 0;
-            *s_p += v * (*m2_p); // <-> s(i,j) += m1(i,k) * m2(k,j)
-            s_p++;
-            m2_p++;
-          }
-        }
-      }
+      Kernels::gemm(m1.m_nrows, m1.m_ncols, m2.m_ncols, m1.m_data, m2.m_data, s.m_data);
       return s;
     }
 
@@ -1510,15 +1474,8 @@ namespace DUNE
     Matrix
     transpose(const Matrix& a)
     {
-      int n = a.m_nrows;
-      int m = a.m_ncols;
-
-      Matrix t(m, n);
-
-      for (int i = 0; i < n; i++)
-        for (int j = 0; j < m; j++)
-          (t.m_data + j * n)[i] = (a.m_data + i * m)[j];
-
+      Matrix t(a.m_ncols, a.m_nrows);
+      Kernels::transpose(a.m_nrows, a.m_ncols, a.m_data, t.m_data);
       return t;
     }
 
@@ -1846,6 +1803,21 @@ namespace DUNE
       return Minv;
     }
 
+    Matrix
+    cholesky(const Matrix& a)
+    {
+      if (a.m_nrows != a.m_ncols)
+        throw Matrix::Error("Cholesky decomposition of a nonsquare Matrix");
+
+      Matrix L = a;
+      L.split();
+
+      if (!Kernels::cholesky(L.m_nrows, L.m_data))
+        throw Matrix::Error("matrix is not positive definite");
+
+      return L;
+    }
+
     Matrix
     abs(const Matrix& a)
     {
@@ -1954,8 +1926,7 @@ namespace DUNE
         for (ii = i + 1; ii < n; ii++)
         {
           double f = M[ii * m + i] / M[i * m + i];
-          for (int j = i + 1; j < m; j++)
-            M[ii * m + j] -= f * M[i * m + j];
+          Kernels::axpy(m - i - 1, -f, M + i * m + i + 1, M + ii * m + i + 1);
         }
       }
 
@@ -2011,8 +1982,7 @@ namespace DUNE
         for (ii = i + 1; ii < n; ii++)
         {
           double f = M[ii * m + i] / M[i * m + i];
-          for (int j = i + 1; j < m; j++)
-            M[ii * m + j] -= f * M[i * m + j];
+          Kernels::axpy(m - i - 1, -f, M + i * m + i + 1, M + ii * m + i + 1);
         }
       }
 
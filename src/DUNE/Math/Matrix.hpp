@@ -759,6 +759,14 @@ namespace DUNE
       friend Matrix
       inverse_lup(const Matrix& a);
 
+      //! This function computes the Cholesky factor of a symmetric
+      //! positive definite Matrix, the lower triangular Matrix L such
+      //! that L * transpose(L) equals the Matrix.
+      //! @param[in] a symmetric positive definite matrix.
+      //! @return lower triangular matrix.
+      friend DUNE_DLL_SYM Matrix
+      cholesky(const Matrix& a);
+
       //! This function returns a Matrix with the absolute
       //! values of the entries of a given Matrix.
       //! @param[in] a matrix
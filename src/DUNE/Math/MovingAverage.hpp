@@ -28,31 +28,28 @@
 #ifndef DUNE_MATH_MOVING_AVERAGE_HPP_INCLUDED_
 #define DUNE_MATH_MOVING_AVERAGE_HPP_INCLUDED_
 
-// ISO C++ 98 headers.
-#include <vector>
-#include <cmath>
+// DUNE headers.
+#include <DUNE/Math/WindowedStatistics.hpp>
 
 namespace DUNE
 {
   namespace Math
   {
+    //! Moving average over the last N samples. Updates and queries
+    //! are O(1); see WindowedStatistics for minimum and maximum.
     template <typename T>
     class MovingAverage
     {
     public:
       MovingAverage(unsigned window_size):
-        m_window_size(window_size)
-      {
-        clear();
-      }
+        m_stats(window_size, false)
+      { }
 
       //! Clear sample.
       void
       clear(void)
       {
-        m_accum = 0;
-        m_oldest = 0;
-        m_window.clear();
+        m_stats.clear();
       }
 
       //! Update sample with new value.
@@ -60,17 +57,7 @@ namespace DUNE
       T
       update(const T& value)
       {
-        if (sampleSize() < m_window_size)
-        {
-          m_window.push_back(value);
-          m_accum += value;
-          return m_accum / sampleSize();
-        }
-
-        m_accum += value - m_window[m_oldest];
-        m_window[m_oldest] = value;
-        m_oldest = (m_oldest + 1) % m_window_size;
-        return m_accum / m_window_size;
+        return m_stats.update(value);
       }
 
       //! Extract mean value of the sample.
@@ -78,10 +65,7 @@ namespace DUNE
       T
       mean(void)
       {
-        if (sampleSize())
-          return m_accum / sampleSize();
-        else
-          return 0;
+        return m_stats.mean();
       }
 
       //! Extract standard deviation of the sample.
@@ -89,18 +73,7 @@ namespace DUNE
       T
       stdev(void)
       {
-        unsigned size = sampleSize();
-
-        if (!size)
-          return 0;
-
-        T sdev = 0;
-        T u = mean();
-
-        for (unsigned i = 0; i < size; i++)
-          sdev += (m_window[i] - u) * (m_window[i] - u);
-
-        return std::sqrt(sdev / size);
+        return m_stats.stdev();
       }
 
       //! Know size of sample.
@@ -108,18 +81,12 @@ namespace DUNE
       unsigned
       sampleSize(void)
       {
-        return (unsigned)m_window.size();
+        return m_stats.sampleSize();
       }
 
     private:
-      //! Accumulator.
-      T m_accum;
-      //! Window size.
-      unsigned m_window_size;
-      //! Window.
-      std::vector<T> m_window;
-      //! Index of oldest value.
-      unsigned m_oldest;
+      //! Window statistics.
+      WindowedStatistics<T> m_stats;
     };
   }
 }
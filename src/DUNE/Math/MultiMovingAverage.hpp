@@ -33,6 +33,9 @@
 #include <vector>
 #include <cmath>
 
+// DUNE headers.
+#include <DUNE/Utils/CircularBuffer.hpp>
+
 namespace DUNE
 {
   namespace Math
@@ -48,11 +51,13 @@ namespace DUNE
       {
         m_accum.resize(m_wsizes.size());
 
-        m_max_size = 0;
+        unsigned max_size = 1;
 
         for (unsigned i = 0; i < m_wsizes.size(); ++i)
-          if (m_wsizes[i] > m_max_size)
-            m_max_size = m_wsizes[i];
+          if (m_wsizes[i] > max_size)
+            max_size = m_wsizes[i];
+
+        m_window.setCapacity(max_size);
 
         clear();
       }
@@ -65,31 +70,22 @@ namespace DUNE
         m_window.clear();
       }
 
-      //! Insert new sample
-      //! @param[in] value new sample
-      void
-      insertSample(const T& value)
-      {
-        if (m_window.size() >= m_max_size)
-          m_window.pop_back();
-
-        m_window.insert(m_window.begin(), value);
-      }
-
       //! Update sample with new value.
       //! @param[in] value new value.
       void
       update(const T& value)
       {
+        uint32_t size = m_window.getSize();
+
         for (unsigned j = 0; j < m_wsizes.size(); ++j)
         {
           m_accum[j] += value;
 
-          if (m_wsizes[j] <= m_window.size())
-            m_accum[j] -= m_window[m_wsizes[j] - 1];
+          if (m_wsizes[j] <= size)
+            m_accum[j] -= m_window(size - m_wsizes[j]);
         }
 
-        insertSample(value);
+        m_window.add(value);
       }
 
       //! Extract mean value of a moving average.
@@ -99,13 +95,13 @@ namespace DUNE
       mean(unsigned j)
       {
         if (j >= m_wsizes.size())
-          std::runtime_error("multi moving average: invalid index");
+          throw std::runtime_error("multi moving average: invalid index");
 
-        if (!m_window.size())
+        if (!m_window.getSize())
           return 0.0;
 
-        if (m_wsizes[j] > m_window.size())
-          return m_accum[j] / m_window.size();
+        if (m_wsizes[j] > m_window.getSize())
+          return m_accum[j] / m_window.getSize();
         else
           return m_accum[j] / m_wsizes[j];
       }
@@ -113,12 +109,10 @@ namespace DUNE
     private:
       //! Accumulator for each moving average.
       std::vector<T> m_accum;
-      //! Window.
-      std::vector<T> m_window;
+      //! Window, sized to the largest moving average.
+      Utils::CircularBuffer<T> m_window;
       //! Window sizes for each moving average
       std::vector<unsigned> m_wsizes;
-      //! Maximum size of window
-      unsigned m_max_size;
     };
   }
 }
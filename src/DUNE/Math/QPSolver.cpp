@@ -48,35 +48,13 @@
 #include <sstream>
 #include <stdexcept>
 
+#include <DUNE/Time/Clock.hpp>
+
 //#define __QPDBG__
 namespace DUNE
 {
   namespace Math
   {
-    // Template class just to encapsulate operator() in access to a std::vector
-    // (for pedantic syntactic sugar in consistencty with DUNE::Math::Matrix
-    //  and DUNE::Math::Matrix)
-    template <typename T>
-    class tvector: public std::vector<T>
-    {
-    public:
-      tvector(size_t n):
-        std::vector<T>(n)
-      { }
-
-      inline T&
-      operator()(size_t index)
-      {
-        return std::vector<T>::operator[](index);
-      }
-
-      inline const T&
-      operator()(size_t index) const
-      {
-        return std::vector<T>::operator[](index);
-      }
-    };
-
     // Utility functions
     static void
     compute_d(Matrix& d, const Matrix& J, const Matrix& np);
@@ -91,13 +69,13 @@ namespace DUNE
     add_constraint(Matrix& R, Matrix& J, Matrix& d, int& iq, double& rnorm);
 
     static void
-    delete_constraint(Matrix& R, Matrix& J, tvector<int>& A, Matrix& u, int n, int p, int& iq, int l);
+    delete_constraint(Matrix& R, Matrix& J, std::vector<int>& A, Matrix& u, int n, int p, int& iq, int l);
 
     static void
     cholesky_decomposition(Matrix& A);
 
     static void
-    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b);
+    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b, Matrix& y);
 
     static void
     forward_elimination(const Matrix& L, Matrix& y, const Matrix& b);
@@ -115,7 +93,7 @@ namespace DUNE
 
     template <typename T>
     static void
-    print_vector(const char* name, const tvector<T>& v, int n = -1);
+    print_vector(const char* name, const std::vector<T>& v, int n = -1);
 
     static void
     print_vector(const char* name, const Matrix& v, int n = -1)
@@ -125,17 +103,161 @@ namespace DUNE
 
 #endif
 
-    double
-    QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
+    //! Resize a matrix unless it already has the given dimensions.
+    //! @return true if the matrix was resized.
+    static bool
+    ensure(Matrix& a, int r, int c)
+    {
+      if (a.rows() == r && a.columns() == c)
+        return false;
+
+      a.resize(r, c);
+      return true;
+    }
+
+    //! Copy a matrix into storage of the same dimensions.
+    static void
+    copy(Matrix& dst, const Matrix& src)
+    {
+      for (int i = 0; i < src.rows(); i++)
+        for (int j = 0; j < src.columns(); j++)
+          dst(i, j) = src(i, j);
+    }
+
+    QPSolver::QPSolver(void):
+      m_max_iterations(0),
+      m_time_budget(0.0),
+      m_warm_start(true),
+      m_objective(0.0),
+      m_iterations(0),
+      m_cond(0.0),
+      m_factorized(false)
+    { }
+
+    QPSolver::QPSolver(unsigned n, unsigned p, unsigned m):
+      m_max_iterations(0),
+      m_time_budget(0.0),
+      m_warm_start(true),
+      m_objective(0.0),
+      m_iterations(0),
+      m_cond(0.0),
+      m_factorized(false)
+    {
+      reserve(n, p, m);
+    }
+
+    void
+    QPSolver::reserve(unsigned n, unsigned p, unsigned m)
+    {
+      int nn = n;
+      int k = std::max(1u, m + p);
+
+      bool resized = false;
+      resized |= ensure(m_h, nn, nn);
+      resized |= ensure(m_l, nn, nn);
+      resized |= ensure(m_j0, nn, nn);
+      if (resized)
+        m_factorized = false;
+
+      ensure(m_r, nn, nn);
+      ensure(m_j, nn, nn);
+      ensure(m_z, nn, 1);
+      ensure(m_d, nn, 1);
+      ensure(m_np, nn, 1);
+      ensure(m_x_old, nn, 1);
+      ensure(m_s, k, 1);
+      ensure(m_rv, k, 1);
+      ensure(m_u, k, 1);
+      ensure(m_u_old, k, 1);
+
+      m_aset.resize(k);
+      m_aset_old.resize(k);
+      m_iai.resize(k);
+      m_iaexcl.resize(k);
+      m_preferred.resize(k);
+    }
+
+    void
+    QPSolver::factorize(const Matrix& H)
+    {
+      int i, j, n = H.rows();
+
+      if (m_factorized)
+      {
+        bool same = true;
+        for (i = 0; i < n && same; i++)
+          for (j = 0; j < n && same; j++)
+            same = (m_h(i, j) == H(i, j));
+
+        if (same)
+          return;
+      }
+
+      m_factorized = false;
+      copy(m_h, H);
+      copy(m_l, H);
+
+      /* compute the trace of the original matrix G */
+      double c1 = 0.0;
+      for (i = 0; i < n; i++)
+        c1 += m_l(i, i);
+
+      /* decompose the matrix H0 in the form L^T L */
+      cholesky_decomposition(m_l);
+#ifdef __QPDBG__
+      print_matrix("H0", m_l);
+#endif
+
+      /* compute the inverse of the factorized matrix G^-1, this is the initial value for H */
+      double c2 = 0.0;
+      m_d.fill(0);
+      for (i = 0; i < n; i++)
+      {
+        m_d(i) = 1.0;
+        forward_elimination(m_l, m_z, m_d);
+        for (j = 0; j < n; j++)
+          m_j0(i, j) = m_z(j);
+        c2 += m_z(i);
+        m_d(i) = 0.0;
+      }
+#ifdef __QPDBG__
+      print_matrix("J", m_j0);
+#endif
+
+      /* c1 * c2 is an estimate for cond(H0) */
+      m_cond = c1 * c2;
+      m_factorized = true;
+    }
+
+    bool
+    QPSolver::overBudget(double start, Result& result) const
+    {
+      if (m_max_iterations > 0 && m_iterations > m_max_iterations)
+      {
+        result = QP_MAX_ITERATIONS;
+        return true;
+      }
+
+      if (m_time_budget > 0 && Time::Clock::get() - start > m_time_budget)
+      {
+        result = QP_MAX_TIME;
+        return true;
+      }
+
+      return false;
+    }
+
+    QPSolver::Result
+    QPSolver::minimize(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
     {
       // Zero-size matrix and vector
       Matrix Aeq;
       Matrix beq;
-      return solve(H, f, Aeq, beq, A, b, x);
+      return minimize(H, f, Aeq, beq, A, b, x);
     }
 
-    double
-    QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
+    QPSolver::Result
+    QPSolver::minimize(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
     {
       // Validate parameter dimensions
       // n: number of vars
@@ -162,24 +284,40 @@ namespace DUNE
           throw Error("'beq' has an invalid size");
       }
 
+      double start = Time::Clock::get();
+      Result result = QP_OPTIMAL;
+      m_iterations = 0;
+
+      reserve(n, p, m);
+      factorize(H);
+
       // Resize output vector
-      x.resize(n, 1);
+      ensure(x, n, 1);
 
       // Working variables
+      Matrix& R = m_r;
+      Matrix& J = m_j;
+      Matrix& s = m_s;
+      Matrix& z = m_z;
+      Matrix& r = m_rv;
+      Matrix& d = m_d;
+      Matrix& np = m_np;
+      Matrix& u = m_u;
+      Matrix& x_old = m_x_old;
+      Matrix& u_old = m_u_old;
+      std::vector<int>& Aset = m_aset;
+      std::vector<int>& Aset_old = m_aset_old;
+      std::vector<int>& iai = m_iai;
+      std::vector<uint8_t>& iaexcl = m_iaexcl;
       int i, j, k, l, ip;
-      Matrix R(n, n), J(n, n);
-      Matrix s(m + p, 1), z(n, 1), r(m + p, 1), d(n, 1), np(n, 1), u(m + p, 1), x_old(n, 1), u_old(m + p, 1);
-      double f_value, psi, c1, c2, sum, ss, R_norm;
+      double f_value, psi, sum, ss, R_norm;
       double inf = std::numeric_limits<double>::has_infinity ?
                    std::numeric_limits<double>::infinity() : 1.0E300;
 
       double t, t1, t2; /* t is the step lenght, which is the minimum of the partial step length t1
       * and the full step length t2 */
 
-      tvector<int> Aset(m + p), Aset_old(m + p), iai(m + p);
       int iq;
-      int iter = 0;
-      tvector<uint8_t> iaexcl(m + p);
 
 #ifdef __QPDBG__
       std::cout << std::endl << "Starting solve_quadprog" << std::endl;
@@ -191,48 +329,31 @@ namespace DUNE
       print_vector("b", b);
 #endif
 
-      /*
-       * Preprocessing phase
-       */
-
-      /* compute the trace of the original matrix G */
-      Matrix H0(H);
-      c1 = 0.0;
-      for (i = 0; i < n; i++)
-        c1 += H0(i, i);
-
-      /* decompose the matrix H0 in the form L^T L */
-      cholesky_decomposition(H0);
-#ifdef __QPDBG__
-      print_matrix("H0", H0);
-#endif
-      /* initialize the matrix R */
+      /* initialize the matrices R and J */
+      copy(J, m_j0);
       d.fill(0);
       R.fill(0);
       R_norm = 1.0; /* this variable will hold the norm of the matrix R */
-      /* compute the inverse of the factorized matrix G^-1, this is the initial value for H */
-      c2 = 0.0;
-      for (i = 0; i < n; i++)
+
+      /* constraints of the previous active set are tried first */
+      for (i = 0; i < m; i++)
+        m_preferred[i] = false;
+
+      if (m_warm_start)
       {
-        d(i) = 1.0;
-        forward_elimination(H0, z, d);
-        for (j = 0; j < n; j++)
-          J(i, j) = z(j);
-        c2 += z(i);
-        d(i) = 0.0;
+        for (i = 0; i < (int)m_active.size(); i++)
+        {
+          if (m_active[i] >= 0 && m_active[i] < m)
+            m_preferred[m_active[i]] = true;
+        }
       }
-#ifdef __QPDBG__
-      print_matrix("J", J);
-#endif
-
-      /* c1 * c2 is an estimate for cond(H0) */
 
       /*
-        * Find the unconstrained minimizer of the quadratic form 0.5 * x G x + f x
+       * Find the unconstrained minimizer of the quadratic form 0.5 * x G x + f x
        * this is a feasible point in the dual space
        * x = G^-1 * f
        */
-      cholesky_solve(H0, x, f);
+      cholesky_solve(m_l, x, f, z);
       for (i = 0; i < n; i++)
         x(i) = -x(i);
       /* and compute the current solution value */
@@ -275,7 +396,7 @@ namespace DUNE
 
         /* compute the new solution value */
         f_value += 0.5 * (t2 * t2) * Matrix::dot(z, np);
-        Aset(i) = -i - 1;
+        Aset[i] = -i - 1;
 
         if (!add_constraint(R, J, d, iq, R_norm))
           // Equality constraints are linearly dependent
@@ -284,17 +405,19 @@ namespace DUNE
 
       /* set iai = K \ A */
       for (i = 0; i < m; i++)
-        iai(i) = i;
+        iai[i] = i;
 
-l1:  iter++;
+l1:  m_iterations++;
+      if (overBudget(start, result))
+        goto done;
     #ifdef __QPDBG__
       print_vector("x", x);
     #endif
       /* step 1: choose a violated constraint */
       for (i = p; i < iq; i++)
       {
-        ip = Aset(i);
-        iai(ip) = -1;
+        ip = Aset[i];
+        iai[ip] = -1;
       }
 
       /* compute s(x) = A^T * x + b for all elements of K \ A */
@@ -303,7 +426,7 @@ l1:  iter++;
       ip = 0; /* ip will be the index of the chosen violated constraint */
       for (i = 0; i < m; i++)
       {
-        iaexcl(i) = true;
+        iaexcl[i] = true;
         sum = 0.0;
         for (j = 0; j < n; j++)
           sum += A(i, j) * x(j);
@@ -315,33 +438,49 @@ l1:  iter++;
       print_vector("s", s, m);
     #endif
 
-      if (std::fabs(psi) <= m * std::numeric_limits<double>::epsilon() * c1 * c2 * 100.0)
+      if (std::fabs(psi) <= m * std::numeric_limits<double>::epsilon() * m_cond * 100.0)
       {
         /* numerically there are not infeasibilities anymore */
-        return f_value;
+        goto done;
       }
 
       /* save old values for u and A */
       for (i = 0; i < iq; i++)
       {
         u_old(i) = u(i);
-        Aset_old(i) = Aset(i);
+        Aset_old[i] = Aset[i];
       }
       /* and for x */
-      x_old = x;
+      copy(x_old, x);
 
 l2:     /* Step 2: check for feasibility and determine a new S-pair */
-      for (i = 0; i < m; i++)
+      /* violated constraints of the previous active set come first */
+      for (i = 0, k = -1; i < m; i++)
       {
-        if (s(i) < ss && iai(i) != -1 && iaexcl(i))
+        if (m_preferred[i] && s(i) < ss && iai[i] != -1 && iaexcl[i])
         {
           ss = s(i);
-          ip = i;
+          k = i;
         }
       }
+
+      if (k >= 0)
+        ip = k;
+      else
+      {
+        for (i = 0; i < m; i++)
+        {
+          if (s(i) < ss && iai[i] != -1 && iaexcl[i])
+          {
+            ss = s(i);
+            ip = i;
+          }
+        }
+      }
+
       if (ss >= 0.0)
       {
-        return f_value;
+        goto done;
       }
 
       /* set np = n(ip) */
@@ -350,7 +489,7 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
       /* set u = (u 0)^T */
       u(iq) = 0.0;
       /* add ip to the active set A */
-      Aset(iq) = ip;
+      Aset[iq] = ip;
 
     #ifdef __QPDBG__
       std::cout << "Trying with constraint " << ip << std::endl;
@@ -358,6 +497,9 @@ l2:     /* Step 2: check for feasibility and determine a new S-pair */
     #endif
 
 l2a:    /* Step 2a: determine step direction */
+      m_iterations++;
+      if (overBudget(start, result))
+        goto done;
         /* compute z = H np: the step direction in the primal space (through J, see the paper) */
       compute_d(d, J, np);
       update_z(z, J, d, iq);
@@ -381,7 +523,7 @@ l2a:    /* Step 2a: determine step direction */
           if (u(k) / r(k) < t1)
           {
             t1 = u(k) / r(k);
-            l = Aset(k);
+            l = Aset[k];
           }
         }
       }
@@ -414,7 +556,7 @@ l2a:    /* Step 2a: determine step direction */
         for (k = 0; k < iq; k++)
           u(k) -= t * r(k);
         u(iq) += t;
-        iai(l) = l;
+        iai[l] = l;
         delete_constraint(R, J, Aset, u, n, p, iq, l);
     #ifdef __QPDBG__
         std::cout << " in dual space: "
@@ -456,8 +598,10 @@ l2a:    /* Step 2a: determine step direction */
         /* add constraint ip to the active set*/
         if (!add_constraint(R, J, d, iq, R_norm))
         {
+    #ifdef __QPDBG__
           std::cout << "not iaexcl " << ip << std::endl;
-          iaexcl(ip) = false;
+    #endif
+          iaexcl[ip] = false;
           delete_constraint(R, J, Aset, u, n, p, iq, ip);
     #ifdef __QPDBG__
           print_matrix("R", R);
@@ -465,18 +609,18 @@ l2a:    /* Step 2a: determine step direction */
           print_vector("iai", iai);
     #endif
           for (i = 0; i < m; i++)
-            iai(i) = i;
+            iai[i] = i;
           for (i = p; i < iq; i++)
           {
-            Aset(i) = Aset_old(i);
+            Aset[i] = Aset_old[i];
             u(i) = u_old(i);
-            iai(Aset(i)) = -1;
+            iai[Aset[i]] = -1;
           }
-          x = x_old;
+          copy(x, x_old);
           goto l2; /* go to step 2 */
         }
         else
-          iai(ip) = -1;
+          iai[ip] = -1;
     #ifdef __QPDBG__
         print_matrix("R", R);
         print_vector("Aset", Aset, iq);
@@ -491,7 +635,7 @@ l2a:    /* Step 2a: determine step direction */
       print_vector("x", x);
     #endif
       /* drop constraint l */
-      iai(l) = l;
+      iai[l] = l;
       delete_constraint(R, J, Aset, u, n, p, iq, l);
     #ifdef __QPDBG__
       print_matrix("R", R);
@@ -508,6 +652,29 @@ l2a:    /* Step 2a: determine step direction */
       print_vector("s", s, m);
     #endif
       goto l2a;
+
+done:
+      m_active.assign(Aset.begin() + p, Aset.begin() + iq);
+      m_objective = f_value;
+      return result;
+    }
+
+    double
+    QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x)
+    {
+      // Zero-size matrix and vector
+      Matrix Aeq;
+      Matrix beq;
+      return solve(H, f, Aeq, beq, A, b, x);
+    }
+
+    double
+    QPSolver::solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x)
+    {
+      QPSolver solver;
+      solver.setWarmStart(false);
+      solver.minimize(H, f, Aeq, beq, A, b, x);
+      return solver.getObjective();
     }
 
     static void
@@ -629,7 +796,7 @@ l2a:    /* Step 2a: determine step direction */
     }
 
     static void
-    delete_constraint(Matrix& R, Matrix& J, tvector<int>& Aset, Matrix& u, int n, int p, int& iq, int l)
+    delete_constraint(Matrix& R, Matrix& J, std::vector<int>& Aset, Matrix& u, int n, int p, int& iq, int l)
     {
     #ifdef __QPDBG__
       std::cout << "Delete constraint " << l << ' ' << iq;
@@ -639,7 +806,7 @@ l2a:    /* Step 2a: determine step direction */
 
       /* Find the index qq for active constraint l to be removed */
       for (i = p; i < iq; i++)
-        if (Aset(i) == l)
+        if (Aset[i] == l)
         {
           qq = i;
           break;
@@ -648,15 +815,15 @@ l2a:    /* Step 2a: determine step direction */
       /* remove the constraint from the active set and the duals */
       for (i = qq; i < iq - 1; i++)
       {
-        Aset(i) = Aset(i + 1);
+        Aset[i] = Aset[i + 1];
         u(i) = u(i + 1);
         for (j = 0; j < n; j++)
           R(j, i) = R(j, i + 1);
       }
 
-      Aset(iq - 1) = Aset(iq);
+      Aset[iq - 1] = Aset[iq];
       u(iq - 1) = u(iq);
-      Aset(iq) = 0;
+      Aset[iq] = 0;
       u(iq) = 0.0;
       for (j = 0; j < iq; j++)
         R(j, iq - 1) = 0.0;
@@ -755,10 +922,8 @@ l2a:    /* Step 2a: determine step direction */
     }
 
     static void
-    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b)
+    cholesky_solve(const Matrix& L, Matrix& x, const Matrix& b, Matrix& y)
     {
-      Matrix y(L.rows(), 1);
-
       /* Solve L * y = b */
       forward_elimination(L, y, b);
       /* Solve L^T * x = y */
@@ -822,7 +987,7 @@ l2a:    /* Step 2a: determine step direction */
 
     template <typename T>
     static void
-    print_vector(const char* name, const tvector<T>& v, int n)
+    print_vector(const char* name, const std::vector<T>& v, int n)
     {
       std::ostringstream s;
       std::string t;
@@ -832,7 +997,7 @@ l2a:    /* Step 2a: determine step direction */
       s << name << ": " << std::endl << " ";
       for (int i = 0; i < n; i++)
       {
-        s << v(i) << ", ";
+        s << v[i] << ", ";
       }
       t = s.str();
       t = t.substr(0, t.size() - 2); // To remove the trailing space and comma
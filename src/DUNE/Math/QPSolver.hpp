@@ -28,6 +28,9 @@
 #ifndef DUNE_MATH_QPSOLVER_HPP_INCLUDED_
 #define DUNE_MATH_QPSOLVER_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Math/Matrix.hpp>
@@ -40,6 +43,14 @@ namespace DUNE
     class DUNE_DLL_SYM QPSolver;
 
     //! Quadratic programming solver.
+    //!
+    //! Besides the one-shot static solve() functions, a QPSolver
+    //! object keeps its working storage between calls to minimize()
+    //! and can be warm started: the active set of the previous
+    //! solution is tried first when searching for violated
+    //! constraints, and the factorization of H is reused while H does
+    //! not change. Iteration and time budgets bound the latency of
+    //! each call.
     class QPSolver
     {
     public:
@@ -52,6 +63,110 @@ namespace DUNE
         { }
       };
 
+      //! Outcome of minimize().
+      enum Result
+      {
+        //! Optimal solution found.
+        QP_OPTIMAL,
+        //! Iteration budget exhausted.
+        QP_MAX_ITERATIONS,
+        //! Time budget exhausted.
+        QP_MAX_TIME
+      };
+
+      //! Constructor.
+      QPSolver(void);
+
+      //! Constructor.
+      //! @param[in] n number of variables.
+      //! @param[in] p number of equality constraints.
+      //! @param[in] m number of inequality constraints.
+      QPSolver(unsigned n, unsigned p, unsigned m);
+
+      //! Preallocate working storage for a given problem size.
+      //! @param[in] n number of variables.
+      //! @param[in] p number of equality constraints.
+      //! @param[in] m number of inequality constraints.
+      void
+      reserve(unsigned n, unsigned p, unsigned m);
+
+      //! Set the maximum number of iterations of minimize().
+      //! @param[in] iterations maximum iterations (0 for no limit).
+      void
+      setMaxIterations(unsigned iterations)
+      {
+        m_max_iterations = iterations;
+      }
+
+      //! Set the maximum time spent in minimize().
+      //! @param[in] budget maximum time in seconds (0 for no limit).
+      void
+      setTimeBudget(double budget)
+      {
+        m_time_budget = budget;
+      }
+
+      //! Enable or disable warm starts from the previous active set.
+      //! @param[in] enable true to warm start.
+      void
+      setWarmStart(bool enable)
+      {
+        m_warm_start = enable;
+      }
+
+      //! Set the inequality constraints to try first in the next call
+      //! to minimize(), typically the active set of a previous
+      //! solution of a similar problem.
+      //! @param[in] active indices of inequality constraints.
+      void
+      setActiveSet(const std::vector<int>& active)
+      {
+        m_active = active;
+      }
+
+      //! Get the inequality constraints active at the last solution.
+      //! @return indices of inequality constraints.
+      const std::vector<int>&
+      getActiveSet(void) const
+      {
+        return m_active;
+      }
+
+      //! Get the objective value of the last solution.
+      //! @return objective value.
+      double
+      getObjective(void) const
+      {
+        return m_objective;
+      }
+
+      //! Get the number of iterations of the last call to minimize().
+      //! @return number of iterations.
+      unsigned
+      getIterations(void) const
+      {
+        return m_iterations;
+      }
+
+      //! Minimize
+      //!   0.5 x' H x + f' x
+      //! subject to:
+      //!   A x <= b  and Aeq x = beq
+      //! If a budget runs out, x holds the current iterate, which
+      //! satisfies the equality constraints and the active inequality
+      //! constraints but possibly not the remaining ones.
+      //! @return QP_OPTIMAL or the budget that ran out.
+      Result
+      minimize(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x);
+
+      //! Minimize
+      //!   0.5 x' H x + f' x
+      //! subject to:
+      //!   A x <= b
+      //! @return QP_OPTIMAL or the budget that ran out.
+      Result
+      minimize(const Matrix& H, const Matrix& f, const Matrix& A, const Matrix& b, Matrix& x);
+
       //! Minimize
       //!   0.5 x' H x + f' x
       //! subject to:
@@ -65,6 +180,58 @@ namespace DUNE
       //!   A x <= b  and Aeq x = beq
       static double
       solve(const Matrix& H, const Matrix& f, const Matrix& Aeq, const Matrix& beq, const Matrix& A, const Matrix& b, Matrix& x);
+
+    private:
+      //! Factorize H and compute the initial J, unless H is unchanged.
+      //! @param[in] H quadratic term.
+      void
+      factorize(const Matrix& H);
+
+      //! Check the iteration and time budgets.
+      //! @param[in] start time at which minimize() started.
+      //! @param[out] result budget that ran out.
+      //! @return true if a budget ran out.
+      bool
+      overBudget(double start, Result& result) const;
+
+      //! Maximum number of iterations.
+      unsigned m_max_iterations;
+      //! Time budget in seconds.
+      double m_time_budget;
+      //! Warm start from the previous active set.
+      bool m_warm_start;
+      //! Inequality constraints active at the last solution.
+      std::vector<int> m_active;
+      //! Objective value of the last solution.
+      double m_objective;
+      //! Iterations of the last call.
+      unsigned m_iterations;
+      //! Quadratic term of the cached factorization.
+      Matrix m_h;
+      //! Cholesky factor of H.
+      Matrix m_l;
+      //! Initial value of J (inverse of the Cholesky factor).
+      Matrix m_j0;
+      //! Trace of H times trace of its inverse factor.
+      double m_cond;
+      //! True if the cached factorization is valid.
+      bool m_factorized;
+      //! Working storage.
+      Matrix m_r;
+      Matrix m_j;
+      Matrix m_s;
+      Matrix m_z;
+      Matrix m_rv;
+      Matrix m_d;
+      Matrix m_np;
+      Matrix m_u;
+      Matrix m_x_old;
+      Matrix m_u_old;
+      std::vector<int> m_aset;
+      std::vector<int> m_aset_old;
+      std::vector<int> m_iai;
+      std::vector<uint8_t> m_iaexcl;
+      std::vector<uint8_t> m_preferred;
     };
   }
 }
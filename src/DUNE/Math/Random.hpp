@@ -35,5 +35,6 @@
 #include <DUNE/Math/Random/FSR256.hpp>
 #include <DUNE/Math/Random/MT19937.hpp>
 #include <DUNE/Math/Random/KernelDevice.hpp>
+#include <DUNE/Math/Random/Philox.hpp>
 
 #endif
@@ -35,6 +35,7 @@
 #include <DUNE/Math/Random/FSR256.hpp>
 #include <DUNE/Math/Random/MT19937.hpp>
 #include <DUNE/Math/Random/KernelDevice.hpp>
+#include <DUNE/Math/Random/Philox.hpp>
 
 namespace DUNE
 {
@@ -47,13 +48,15 @@ namespace DUNE
       const char* Factory::c_default = c_fsr256;
       const char* Factory::c_mt19937 = "mt19937";
       const char* Factory::c_krng = "krng";
+      const char* Factory::c_philox = "philox";
 
       enum GType
       {
         G_DRAND48,
         G_FSR256,
         G_MT19937,
-        G_KRNG
+        G_KRNG,
+        G_PHILOX
       };
 
       typedef std::pair<std::string, GType> GEntry;
@@ -65,6 +68,7 @@ namespace DUNE
         GEntry(Factory::c_fsr256, G_FSR256),
         GEntry(Factory::c_mt19937, G_MT19937),
         GEntry(Factory::c_krng, G_KRNG),
+        GEntry(Factory::c_philox, G_PHILOX),
       };
 
       DUNE_DECLARE_STATIC_MAP(id2type, std::string, GType, entries);
@@ -72,7 +76,7 @@ namespace DUNE
       typedef std::map<std::string, GType> Id2TypeMap;
 
       Generator*
-      Factory::create(const std::string& id, int32_t seed_value)
+      Factory::create(const std::string& id, int32_t seed_value, uint32_t stream)
       {
         Id2TypeMap::iterator it = id2type.find(id);
 
@@ -93,6 +97,8 @@ namespace DUNE
             return new MT19937(seed_value);
           case G_KRNG:
             return new KernelDevice(); // can not seed
+          case G_PHILOX:
+            return new Philox(seed_value, stream);
           default:
             throw Generator::Error("internal factory error");
         }
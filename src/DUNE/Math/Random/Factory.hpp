@@ -50,12 +50,14 @@ namespace DUNE
         static const char* c_default;   //!< "fsr256"
         static const char* c_mt19937;   //!< "mt19337"
         static const char* c_krng;      //!< "krng"
+        static const char* c_philox;    //!< "philox"
 
         //! Create generator with given seed. If seed is negative and
         //! the generator is not "krng" a random seed will be
-        //! generated.
+        //! generated. The stream number selects an independent sequence
+        //! for the same seed and is only honoured by "philox".
         static Generator*
-        create(const std::string& id, int32_t seed = -1);
+        create(const std::string& id, int32_t seed = -1, uint32_t stream = 0);
       };
     }
   }
@@ -93,6 +93,36 @@ namespace DUNE
         return y * std::sqrt(-2.0 * std::log(r2) / r2);
       }
 
+      void
+      Generator::fillUniform(double* values, size_t count)
+      {
+        for (size_t i = 0; i < count; ++i)
+          values[i] = uniform();
+      }
+
+      void
+      Generator::fillGaussian(double* values, size_t count)
+      {
+        size_t i = 0;
+
+        while (i < count)
+        {
+          double x, y, r2;
+          do
+          {
+            x = -1 + 2 * uniform();
+            y = -1 + 2 * uniform();
+            r2 = x * x + y * y;
+          }
+          while (r2 > 1.0 || r2 == 0);
+
+          double f = std::sqrt(-2.0 * std::log(r2) / r2);
+          values[i++] = y * f;
+          if (i < count)
+            values[i++] = x * f;
+        }
+      }
+
       void
       Generator::ballU(double radius, double* x, double* y)
       {
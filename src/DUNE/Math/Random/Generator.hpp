@@ -29,6 +29,7 @@
 #define DUNE_MATH_RANDOM_GENERATOR_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
@@ -118,6 +119,21 @@ namespace DUNE
                  gaussian();
         }
 
+        //! Fill an array with numbers uniformly distributed in [0,1].
+        //! Default implementation calls uniform() once per element.
+        //! @param values output array.
+        //! @param count number of elements to generate.
+        virtual void
+        fillUniform(double* values, size_t count);
+
+        //! Fill an array with gaussian numbers of mean 0 and std. dev 1.
+        //! Default implementation uses both outputs of each polar
+        //! Box-Muller draw, halving the number of uniform() calls.
+        //! @param values output array.
+        //! @param count number of elements to generate.
+        virtual void
+        fillGaussian(double* values, size_t count);
+
         // Generate coordinates (x,y) in relation to (0,0), such
         // that:
         // - Distance to (0,0) is uniformly distributed in [0,radius].
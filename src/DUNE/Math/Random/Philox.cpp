@@ -0,0 +1,168 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/Random/Philox.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    namespace Random
+    {
+      //! Round multipliers.
+      static const uint32_t c_mul0 = 0xD2511F53UL;
+      static const uint32_t c_mul1 = 0xCD9E8D57UL;
+      //! Key schedule increments.
+      static const uint32_t c_weyl0 = 0x9E3779B9UL;
+      static const uint32_t c_weyl1 = 0xBB67AE85UL;
+      //! Number of rounds.
+      static const unsigned c_rounds = 10;
+
+      Philox::Philox(void)
+      {
+        m_key[1] = 0;
+        seed(arbitrarySeed());
+      }
+
+      Philox::Philox(int32_t seed_value, uint32_t stream)
+      {
+        m_key[1] = stream;
+        seed(seed_value);
+      }
+
+      Philox::~Philox(void)
+      { }
+
+      void
+      Philox::seed(int32_t value)
+      {
+        m_key[0] = (uint32_t)value;
+        seek(0);
+      }
+
+      void
+      Philox::setStream(uint32_t stream)
+      {
+        m_key[1] = stream;
+        seek(0);
+      }
+
+      void
+      Philox::seek(uint64_t position)
+      {
+        m_counter = position / 4;
+        generate();
+        m_pos = (unsigned)(position % 4);
+      }
+
+      void
+      Philox::generate(void)
+      {
+        uint32_t c0 = (uint32_t)m_counter;
+        uint32_t c1 = (uint32_t)(m_counter >> 32);
+        uint32_t c2 = 0;
+        uint32_t c3 = 0;
+        uint32_t k0 = m_key[0];
+        uint32_t k1 = m_key[1];
+
+        for (unsigned i = 0; i < c_rounds; ++i)
+        {
+          uint64_t p0 = (uint64_t)c_mul0 * c0;
+          uint64_t p1 = (uint64_t)c_mul1 * c2;
+
+          c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+          c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+          c1 = (uint32_t)p1;
+          c3 = (uint32_t)p0;
+
+          k0 += c_weyl0;
+          k1 += c_weyl1;
+        }
+
+        m_block[0] = c0;
+        m_block[1] = c1;
+        m_block[2] = c2;
+        m_block[3] = c3;
+        m_pos = 0;
+        ++m_counter;
+      }
+
+      int32_t
+      Philox::random(void)
+      {
+        return random32() >> 1;
+      }
+
+      double
+      Philox::uniform(void)
+      {
+        // 53-bit precision
+        uint32_t a = random32() >> 5;
+        uint32_t b = random32() >> 6;
+        return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+      }
+
+      void
+      Philox::fillUniform(double* values, size_t count)
+      {
+        for (size_t i = 0; i < count; ++i)
+        {
+          uint32_t a = random32() >> 5;
+          uint32_t b = random32() >> 6;
+          values[i] = (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+        }
+      }
+
+      void
+      Philox::fillGaussian(double* values, size_t count)
+      {
+        size_t i = 0;
+
+        while (i < count)
+        {
+          double x, y, r2;
+          do
+          {
+            x = -1 + 2 * Philox::uniform();
+            y = -1 + 2 * Philox::uniform();
+            r2 = x * x + y * y;
+          }
+          while (r2 > 1.0 || r2 == 0);
+
+          double f = std::sqrt(-2.0 * std::log(r2) / r2);
+          values[i++] = y * f;
+          if (i < count)
+            values[i++] = x * f;
+        }
+      }
+    }
+  }
+}
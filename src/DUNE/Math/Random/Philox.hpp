@@ -0,0 +1,116 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_RANDOM_PHILOX_HPP_INCLUDED_
+#define DUNE_MATH_RANDOM_PHILOX_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Math/Random/Generator.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    namespace Random
+    {
+      // Export DLL Symbol.
+      class DUNE_DLL_SYM Philox;
+
+      //! Counter-based Philox4x32-10 generator (Salmon et al., SC'11).
+      //!
+      //! Each output block is a pure function of (key, counter), so
+      //! the generator carries no table and can jump to any position
+      //! in constant time. The key is formed by the seed and a stream
+      //! number: generators sharing a seed but with different streams
+      //! produce independent sequences, which gives every entity (or
+      //! Monte-Carlo run) its own reproducible noise source. An
+      //! instance is not thread-safe, but one instance per thread needs
+      //! no locking at all.
+      class Philox: public Generator
+      {
+      public:
+        Philox(void);
+
+        Philox(int32_t seed, uint32_t stream = 0);
+
+        ~Philox(void);
+
+        void
+        seed(int32_t value);
+
+        //! Select stream and restart it from position zero.
+        //! @param stream stream number.
+        void
+        setStream(uint32_t stream);
+
+        //! Jump to a given position of the current stream.
+        //! @param position index of the next 32-bit word to output.
+        void
+        seek(uint64_t position);
+
+        int32_t
+        random(void);
+
+        //! Generate 32-bit unsigned integer.
+        //! @return generated number.
+        uint32_t
+        random32(void)
+        {
+          if (m_pos == 4)
+            generate();
+
+          return m_block[m_pos++];
+        }
+
+        double
+        uniform(void);
+
+        void
+        fillUniform(double* values, size_t count);
+
+        void
+        fillGaussian(double* values, size_t count);
+
+      private:
+        //! Encrypt current counter and advance it.
+        void
+        generate(void);
+
+        //! Key words (seed, stream).
+        uint32_t m_key[2];
+        //! Block counter.
+        uint64_t m_counter;
+        //! Last generated block.
+        uint32_t m_block[4];
+        //! Next word of m_block to output.
+        unsigned m_pos;
+      };
+    }
+  }
+}
+
+#endif
@@ -73,6 +73,22 @@ namespace DUNE
           return m_rng.uniform();
         }
 
+        //! The lock is taken once for the whole array.
+        void
+        fillUniform(double* values, size_t count)
+        {
+          Concurrency::ScopedMutex lock(m_mtx);
+          m_rng.fillUniform(values, count);
+        }
+
+        //! The lock is taken once for the whole array.
+        void
+        fillGaussian(double* values, size_t count)
+        {
+          Concurrency::ScopedMutex lock(m_mtx);
+          m_rng.fillGaussian(values, count);
+        }
+
       private:
         G m_rng;
         DUNE::Concurrency::Mutex m_mtx;
@@ -0,0 +1,268 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MATH_WINDOWED_STATISTICS_HPP_INCLUDED_
+#define DUNE_MATH_WINDOWED_STATISTICS_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Utils/CircularBuffer.hpp>
+
+namespace DUNE
+{
+  namespace Math
+  {
+    //! Statistics over a sliding window of the last N samples.
+    //!
+    //! Mean and variance are maintained incrementally with Welford's
+    //! update (adding the new sample and removing the evicted one), so
+    //! every query is O(1). Minimum and maximum are tracked with
+    //! monotonic queues of sample sequence numbers, giving amortized
+    //! O(1) updates. All storage is allocated at construction.
+    template <typename T>
+    class WindowedStatistics
+    {
+    public:
+      //! Constructor.
+      //! @param[in] window_size number of samples in the window.
+      //! @param[in] extrema true to track minimum and maximum.
+      WindowedStatistics(unsigned window_size, bool extrema = true):
+        m_window(window_size),
+        m_extrema(extrema)
+      {
+        if (m_extrema)
+        {
+          m_min.queue.resize(window_size);
+          m_max.queue.resize(window_size);
+        }
+
+        clear();
+      }
+
+      //! Clear sample.
+      void
+      clear(void)
+      {
+        m_window.clear();
+        m_mean = 0;
+        m_m2 = 0;
+        m_count = 0;
+        m_min.head = 0;
+        m_min.size = 0;
+        m_max.head = 0;
+        m_max.size = 0;
+      }
+
+      //! Update sample with new value.
+      //! @param[in] value new value.
+      //! @return mean value.
+      T
+      update(const T& value)
+      {
+        uint32_t n = m_window.getSize();
+
+        if (n < m_window.getCapacity())
+        {
+          T d = value - m_mean;
+          m_mean += d / (n + 1);
+          m_m2 += d * (value - m_mean);
+        }
+        else
+        {
+          const T& old = m_window(0);
+          T mean = m_mean + (value - old) / n;
+          m_m2 += (value - old) * (value - mean + old - m_mean);
+          m_mean = mean;
+        }
+
+        // Guard against round-off.
+        if (m_m2 < 0)
+          m_m2 = 0;
+
+        m_window.add(value);
+        ++m_count;
+
+        if (m_extrema)
+        {
+          push(m_min, value, false);
+          push(m_max, value, true);
+        }
+
+        return m_mean;
+      }
+
+      //! Extract mean value of the sample.
+      //! @return mean value.
+      T
+      mean(void) const
+      {
+        return m_mean;
+      }
+
+      //! Extract (population) variance of the sample.
+      //! @return variance value.
+      T
+      variance(void) const
+      {
+        uint32_t n = m_window.getSize();
+
+        if (!n)
+          return 0;
+
+        return m_m2 / n;
+      }
+
+      //! Extract standard deviation of the sample.
+      //! @return standard deviation value.
+      T
+      stdev(void) const
+      {
+        return std::sqrt(variance());
+      }
+
+      //! Extract minimum value of the sample.
+      //! @return minimum value.
+      T
+      minimum(void) const
+      {
+        return extremum(m_min);
+      }
+
+      //! Extract maximum value of the sample.
+      //! @return maximum value.
+      T
+      maximum(void) const
+      {
+        return extremum(m_max);
+      }
+
+      //! Know size of sample.
+      //! @return size of the sample.
+      unsigned
+      sampleSize(void) const
+      {
+        return m_window.getSize();
+      }
+
+      //! Know size of window.
+      //! @return size of the window.
+      unsigned
+      windowSize(void) const
+      {
+        return m_window.getCapacity();
+      }
+
+    private:
+      //! Monotonic queue of sample sequence numbers.
+      struct Queue
+      {
+        //! Ring storage.
+        std::vector<uint32_t> queue;
+        //! Index of oldest entry.
+        uint32_t head;
+        //! Number of entries.
+        uint32_t size;
+      };
+
+      //! Samples in the window.
+      Utils::CircularBuffer<T> m_window;
+      //! True to track minimum and maximum.
+      bool m_extrema;
+      //! Running mean.
+      T m_mean;
+      //! Running sum of squared deviations.
+      T m_m2;
+      //! Number of samples ever added (sequence number of the next).
+      uint32_t m_count;
+      //! Minimum tracking queue.
+      Queue m_min;
+      //! Maximum tracking queue.
+      Queue m_max;
+
+      //! Get sample value from sequence number.
+      //! @param[in] seq sequence number.
+      //! @return sample value.
+      const T&
+      at(uint32_t seq) const
+      {
+        return m_window(seq - (m_count - m_window.getSize()));
+      }
+
+      //! Add newest sample to a monotonic queue.
+      //! @param[in] q queue.
+      //! @param[in] value newest sample value.
+      //! @param[in] greater true for maximum, false for minimum.
+      void
+      push(Queue& q, const T& value, bool greater)
+      {
+        uint32_t cap = (uint32_t)q.queue.size();
+        uint32_t oldest = m_count - m_window.getSize();
+
+        // Expire entries that left the window.
+        while (q.size && (q.queue[q.head] - oldest) > (m_count - 1 - oldest))
+        {
+          q.head = (q.head + 1) % cap;
+          --q.size;
+        }
+
+        // Drop entries dominated by the new sample.
+        while (q.size)
+        {
+          const T& back = at(q.queue[(q.head + q.size - 1) % cap]);
+          if (greater ? (back > value) : (back < value))
+            break;
+          --q.size;
+        }
+
+        q.queue[(q.head + q.size) % cap] = m_count - 1;
+        ++q.size;
+      }
+
+      //! Get extremum tracked by a monotonic queue.
+      //! @param[in] q queue.
+      //! @return extremum value.
+      T
+      extremum(const Queue& q) const
+      {
+        if (!m_extrema)
+          throw std::runtime_error("windowed statistics: extrema are not tracked");
+
+        if (!q.size)
+          return 0;
+
+        return at(q.queue[q.head]);
+      }
+    };
+  }
+}
+
+#endif
@@ -35,6 +35,8 @@ namespace DUNE
 }
 
 #include <DUNE/Media/JPEGCompressor.hpp>
+#include <DUNE/Media/H264Encoder.hpp>
+#include <DUNE/Media/FrameAssembler.hpp>
 #include <DUNE/Media/VideoCapture.hpp>
 #include <DUNE/Media/VideoIIDC1394.hpp>
 #include <DUNE/Media/BayerDecoder.hpp>
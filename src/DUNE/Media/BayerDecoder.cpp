@@ -27,19 +27,109 @@
 // Based on libdc1394.                                                      *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Media/BayerDecoder.hpp>
 
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define DUNE_BAYER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define DUNE_BAYER_NEON
+#endif
+
 namespace DUNE
 {
   namespace Media
   {
+    //! Colors of the sensor pixels.
+    enum Site
+    {
+      SITE_R,
+      SITE_G,
+      SITE_B
+    };
+
+    //! Colors of each tile format (row by row).
+    static const Site c_sites[4][4] =
+    {
+      {SITE_G, SITE_B, SITE_R, SITE_G},
+      {SITE_G, SITE_R, SITE_B, SITE_G},
+      {SITE_R, SITE_G, SITE_G, SITE_B},
+      {SITE_B, SITE_G, SITE_G, SITE_R}
+    };
+
+    //! Weights (out of 256) of red, green and blue in luma.
+    static const uint8_t c_luma_r = 77;
+    static const uint8_t c_luma_g = 150;
+    static const uint8_t c_luma_b = 29;
+
+    //! Rounded average of two values, as computed by SIMD instructions.
+    static inline int
+    average(int a, int b)
+    {
+      return (a + b + 1) >> 1;
+    }
+
+    //! Mirror an index outside [0, n[ preserving its parity.
+    static inline int
+    mirror(int i, int n)
+    {
+      if (i < 0)
+        return -i;
+      if (i >= n)
+        return 2 * n - 2 - i;
+      return i;
+    }
+
+    //! Compute chroma from the colors of a tile (weights out of 128).
+    static inline void
+    computeChroma(int r, int g, int b, uint8_t& cb, uint8_t& cr)
+    {
+      cb = (uint8_t)std::min(128 + ((-22 * r - 42 * g + 64 * b + 64) >> 7), 255);
+      cr = (uint8_t)std::min(128 + ((64 * r - 54 * g - 10 * b + 64) >> 7), 255);
+    }
+
     BayerDecoder::BayerDecoder(Tile tile, Method method)
     {
       m_blue_line = (tile == TILE_BGGR || tile == TILE_GBRG) ? -1 : 1;
       m_start_with_green = (tile == TILE_GBRG || tile == TILE_GRBG);
       setMethod(method);
+
+      // Green pixels interpolate the color of their horizontal
+      // neighbours from those and the other one from vertical ones.
+      for (int i = 0; i < 4; ++i)
+      {
+        LumaWeights& w = m_luma[i / 2][i % 2];
+        Site next = c_sites[tile][i ^ 1];
+        w.c = w.h = w.v = w.x = w.d = 0;
+
+        switch (c_sites[tile][i])
+        {
+          case SITE_R:
+            m_red = i;
+            w.c = c_luma_r;
+            w.x = c_luma_g;
+            w.d = c_luma_b;
+            break;
+
+          case SITE_B:
+            w.c = c_luma_b;
+            w.x = c_luma_g;
+            w.d = c_luma_r;
+            break;
+
+          case SITE_G:
+            w.c = c_luma_g;
+            w.h = (next == SITE_R) ? c_luma_r : c_luma_b;
+            w.v = (next == SITE_R) ? c_luma_b : c_luma_r;
+            break;
+        }
+      }
     }
 
     void
@@ -456,5 +546,241 @@ namespace DUNE
         i -= (sx - 2 * w) * 3;
       }
     }
+
+    void
+    BayerDecoder::decodeToYCbCr420(const uint8_t* bayer, uint8_t* y, uint8_t* cb, uint8_t* cr,
+                                   int width, int height) const
+    {
+      for (int j = 0; j < height; ++j)
+      {
+        uint8_t* out = y + j * width;
+        int x = 0;
+
+        if (j > 0 && j < height - 1)
+        {
+          out[0] = computeLuma(bayer, width, height, 0, j);
+          x = decodeLumaRow(bayer + j * width, out, width, j);
+        }
+
+        for (; x < width; ++x)
+          out[x] = computeLuma(bayer, width, height, x, j);
+      }
+
+      int cwidth = width / 2;
+      for (int j = 0; j < height / 2; ++j)
+      {
+        const uint8_t* row0 = bayer + 2 * j * width;
+        const uint8_t* row1 = row0 + width;
+        uint8_t* cb_row = cb + j * cwidth;
+        uint8_t* cr_row = cr + j * cwidth;
+
+        for (int i = decodeChromaRow(row0, cb_row, cr_row, width); i < cwidth; ++i)
+        {
+          int p[4] = {row0[2 * i], row0[2 * i + 1], row1[2 * i], row1[2 * i + 1]};
+          computeChroma(p[m_red], average(p[m_red ^ 1], p[m_red ^ 2]), p[3 - m_red],
+                        cb_row[i], cr_row[i]);
+        }
+      }
+    }
+
+    uint8_t
+    BayerDecoder::computeLuma(const uint8_t* bayer, int width, int height, int x, int y) const
+    {
+      const uint8_t* up = bayer + mirror(y - 1, height) * width;
+      const uint8_t* cur = bayer + y * width;
+      const uint8_t* dn = bayer + mirror(y + 1, height) * width;
+      int xw = mirror(x - 1, width);
+      int xe = mirror(x + 1, width);
+
+      int h = average(cur[xw], cur[xe]);
+      int v = average(up[x], dn[x]);
+      int d = average(average(up[xw], up[xe]), average(dn[xw], dn[xe]));
+
+      const LumaWeights& w = m_luma[y & 1][x & 1];
+      return (uint8_t)((w.c * cur[x] + w.h * h + w.v * v + w.x * average(h, v) + w.d * d + 128) >> 8);
+    }
+
+#if defined(DUNE_BAYER_SSE2)
+    //! Weigh 16-bit neighbourhood averages into luma.
+    static inline __m128i
+    weighLuma(__m128i c, __m128i h, __m128i v, __m128i x, __m128i d, const __m128i* w)
+    {
+      __m128i acc = _mm_set1_epi16(128);
+      acc = _mm_add_epi16(acc, _mm_mullo_epi16(c, w[0]));
+      acc = _mm_add_epi16(acc, _mm_mullo_epi16(h, w[1]));
+      acc = _mm_add_epi16(acc, _mm_mullo_epi16(v, w[2]));
+      acc = _mm_add_epi16(acc, _mm_mullo_epi16(x, w[3]));
+      acc = _mm_add_epi16(acc, _mm_mullo_epi16(d, w[4]));
+      return _mm_srli_epi16(acc, 8);
+    }
+
+    static inline __m128i
+    load(const uint8_t* p)
+    {
+      return _mm_loadu_si128((const __m128i*)p);
+    }
+#endif
+
+    int
+    BayerDecoder::decodeLumaRow(const uint8_t* bayer, uint8_t* y, int width, int row) const
+    {
+      int x = 1;
+
+#if defined(DUNE_BAYER_SSE2) || defined(DUNE_BAYER_NEON)
+      const uint8_t* up = bayer - width;
+      const uint8_t* dn = bayer + width;
+
+      // Vectors start at odd columns.
+      uint16_t weights[5][8];
+      for (int i = 0; i < 8; ++i)
+      {
+        const LumaWeights& lw = m_luma[row & 1][(i + 1) & 1];
+        weights[0][i] = lw.c;
+        weights[1][i] = lw.h;
+        weights[2][i] = lw.v;
+        weights[3][i] = lw.x;
+        weights[4][i] = lw.d;
+      }
+#endif
+
+#if defined(DUNE_BAYER_SSE2)
+      __m128i w[5];
+      for (int i = 0; i < 5; ++i)
+        w[i] = _mm_loadu_si128((const __m128i*)weights[i]);
+
+      __m128i zero = _mm_setzero_si128();
+
+      for (; x + 17 <= width; x += 16)
+      {
+        __m128i c = load(bayer + x);
+        __m128i h = _mm_avg_epu8(load(bayer + x - 1), load(bayer + x + 1));
+        __m128i v = _mm_avg_epu8(load(up + x), load(dn + x));
+        __m128i xx = _mm_avg_epu8(h, v);
+        __m128i d = _mm_avg_epu8(_mm_avg_epu8(load(up + x - 1), load(up + x + 1)),
+                                 _mm_avg_epu8(load(dn + x - 1), load(dn + x + 1)));
+
+        __m128i lo = weighLuma(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(h, zero),
+                               _mm_unpacklo_epi8(v, zero), _mm_unpacklo_epi8(xx, zero),
+                               _mm_unpacklo_epi8(d, zero), w);
+        __m128i hi = weighLuma(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(h, zero),
+                               _mm_unpackhi_epi8(v, zero), _mm_unpackhi_epi8(xx, zero),
+                               _mm_unpackhi_epi8(d, zero), w);
+
+        _mm_storeu_si128((__m128i*)(y + x), _mm_packus_epi16(lo, hi));
+      }
+#endif
+
+#if defined(DUNE_BAYER_NEON)
+      uint8x8_t w[5];
+      for (int i = 0; i < 5; ++i)
+        w[i] = vmovn_u16(vld1q_u16(weights[i]));
+
+      for (; x + 17 <= width; x += 16)
+      {
+        uint8x16_t c = vld1q_u8(bayer + x);
+        uint8x16_t h = vrhaddq_u8(vld1q_u8(bayer + x - 1), vld1q_u8(bayer + x + 1));
+        uint8x16_t v = vrhaddq_u8(vld1q_u8(up + x), vld1q_u8(dn + x));
+        uint8x16_t xx = vrhaddq_u8(h, v);
+        uint8x16_t d = vrhaddq_u8(vrhaddq_u8(vld1q_u8(up + x - 1), vld1q_u8(up + x + 1)),
+                                  vrhaddq_u8(vld1q_u8(dn + x - 1), vld1q_u8(dn + x + 1)));
+
+        uint16x8_t lo = vmull_u8(vget_low_u8(c), w[0]);
+        lo = vmlal_u8(lo, vget_low_u8(h), w[1]);
+        lo = vmlal_u8(lo, vget_low_u8(v), w[2]);
+        lo = vmlal_u8(lo, vget_low_u8(xx), w[3]);
+        lo = vmlal_u8(lo, vget_low_u8(d), w[4]);
+
+        uint16x8_t hi = vmull_u8(vget_high_u8(c), w[0]);
+        hi = vmlal_u8(hi, vget_high_u8(h), w[1]);
+        hi = vmlal_u8(hi, vget_high_u8(v), w[2]);
+        hi = vmlal_u8(hi, vget_high_u8(xx), w[3]);
+        hi = vmlal_u8(hi, vget_high_u8(d), w[4]);
+
+        vst1q_u8(y + x, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+      }
+#endif
+
+      (void)bayer;
+      (void)y;
+      (void)width;
+      (void)row;
+      return x;
+    }
+
+    int
+    BayerDecoder::decodeChromaRow(const uint8_t* bayer, uint8_t* cb, uint8_t* cr, int width) const
+    {
+      int i = 0;
+
+#if defined(DUNE_BAYER_SSE2)
+      const uint8_t* row1 = bayer + width;
+      __m128i mask = _mm_set1_epi16(0x00ff);
+      __m128i bias = _mm_set1_epi16(128);
+      __m128i round = _mm_set1_epi16(64);
+
+      for (; 2 * i + 16 <= width; i += 8)
+      {
+        __m128i r0 = load(bayer + 2 * i);
+        __m128i r1 = load(row1 + 2 * i);
+        __m128i p[4] =
+        {
+          _mm_and_si128(r0, mask), _mm_srli_epi16(r0, 8),
+          _mm_and_si128(r1, mask), _mm_srli_epi16(r1, 8)
+        };
+
+        __m128i r = p[m_red];
+        __m128i g = _mm_avg_epu16(p[m_red ^ 1], p[m_red ^ 2]);
+        __m128i b = p[3 - m_red];
+
+        __m128i u = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(-22)),
+                                  _mm_mullo_epi16(g, _mm_set1_epi16(-42)));
+        u = _mm_add_epi16(u, _mm_slli_epi16(b, 6));
+        u = _mm_add_epi16(_mm_srai_epi16(_mm_add_epi16(u, round), 7), bias);
+
+        __m128i v = _mm_add_epi16(_mm_slli_epi16(r, 6),
+                                  _mm_mullo_epi16(g, _mm_set1_epi16(-54)));
+        v = _mm_add_epi16(v, _mm_mullo_epi16(b, _mm_set1_epi16(-10)));
+        v = _mm_add_epi16(_mm_srai_epi16(_mm_add_epi16(v, round), 7), bias);
+
+        _mm_storel_epi64((__m128i*)(cb + i), _mm_packus_epi16(u, u));
+        _mm_storel_epi64((__m128i*)(cr + i), _mm_packus_epi16(v, v));
+      }
+#endif
+
+#if defined(DUNE_BAYER_NEON)
+      const uint8_t* row1 = bayer + width;
+      int16x8_t bias = vdupq_n_s16(128);
+
+      for (; 2 * i + 16 <= width; i += 8)
+      {
+        uint8x8x2_t r0 = vld2_u8(bayer + 2 * i);
+        uint8x8x2_t r1 = vld2_u8(row1 + 2 * i);
+        uint8x8_t p[4] = {r0.val[0], r0.val[1], r1.val[0], r1.val[1]};
+
+        int16x8_t r = vreinterpretq_s16_u16(vmovl_u8(p[m_red]));
+        int16x8_t g = vreinterpretq_s16_u16(vmovl_u8(vrhadd_u8(p[m_red ^ 1], p[m_red ^ 2])));
+        int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(p[3 - m_red]));
+
+        int16x8_t u = vmulq_n_s16(r, -22);
+        u = vmlaq_n_s16(u, g, -42);
+        u = vmlaq_n_s16(u, b, 64);
+        u = vaddq_s16(vrshrq_n_s16(u, 7), bias);
+
+        int16x8_t v = vmulq_n_s16(r, 64);
+        v = vmlaq_n_s16(v, g, -54);
+        v = vmlaq_n_s16(v, b, -10);
+        v = vaddq_s16(vrshrq_n_s16(v, 7), bias);
+
+        vst1_u8(cb + i, vqmovun_s16(u));
+        vst1_u8(cr + i, vqmovun_s16(v));
+      }
+#endif
+
+      (void)bayer;
+      (void)cb;
+      (void)cr;
+      (void)width;
+      return i;
+    }
   }
 }
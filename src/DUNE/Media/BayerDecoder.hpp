@@ -84,7 +84,33 @@ namespace DUNE
         ((*this).*(m_decoder))(bayer, rgb, width, height);
       }
 
+      //! Convert Bayer mosaic to planar YCbCr 4:2:0 (JFIF ranges), the
+      //! layout compressed by JPEG, without an RGB intermediate. Luma
+      //! is interpolated bilinearly at every pixel, regardless of the
+      //! decoding method, and chroma is computed once per 2x2 tile.
+      //! SSE2 or NEON instructions are used when available.
+      //! @param[in] bayer bayer mosaic.
+      //! @param[out] y luma plane (width x height).
+      //! @param[out] cb blue-difference plane (width / 2 x height / 2).
+      //! @param[out] cr red-difference plane (width / 2 x height / 2).
+      //! @param[in] width width of bayer mosaic (even).
+      //! @param[in] height height of bayer mosaic (even).
+      void
+      decodeToYCbCr420(const uint8_t* bayer, uint8_t* y, uint8_t* cb, uint8_t* cr,
+                       int width, int height) const;
+
     private:
+      //! Weights (out of 256) of a pixel and of the averages of its
+      //! horizontal, vertical, cross and diagonal neighbours in luma.
+      struct LumaWeights
+      {
+        uint8_t c;
+        uint8_t h;
+        uint8_t v;
+        uint8_t x;
+        uint8_t d;
+      };
+
       //! Type of decoder functions.
       typedef void (BayerDecoder::*Decoder)(const uint8_t*, uint8_t*, int, int) const;
       //! Pointer to decoder.
@@ -92,6 +118,41 @@ namespace DUNE
       //! True if tile starts with a green pixel.
       bool m_start_with_green;
       int m_blue_line;
+      //! Luma weights by row and column parity.
+      LumaWeights m_luma[2][2];
+      //! Position of the red pixel in a tile (row * 2 + column).
+      int m_red;
+
+      //! Compute the luma of one pixel, mirroring neighbours outside
+      //! the mosaic.
+      //! @param[in] bayer bayer mosaic.
+      //! @param[in] width width of bayer mosaic.
+      //! @param[in] height height of bayer mosaic.
+      //! @param[in] x column.
+      //! @param[in] y row.
+      //! @return luma.
+      uint8_t
+      computeLuma(const uint8_t* bayer, int width, int height, int x, int y) const;
+
+      //! Compute the luma of the interior of a row with vector
+      //! instructions.
+      //! @param[in] bayer first pixel of the row.
+      //! @param[out] y first luma value of the row.
+      //! @param[in] width width of bayer mosaic.
+      //! @param[in] row row index.
+      //! @return first column left to compute.
+      int
+      decodeLumaRow(const uint8_t* bayer, uint8_t* y, int width, int row) const;
+
+      //! Compute the chroma of a row of tiles with vector
+      //! instructions.
+      //! @param[in] bayer first pixel of the first row of tiles.
+      //! @param[out] cb first blue-difference value.
+      //! @param[out] cr first red-difference value.
+      //! @param[in] width width of bayer mosaic.
+      //! @return first tile left to compute.
+      int
+      decodeChromaRow(const uint8_t* bayer, uint8_t* cb, uint8_t* cr, int width) const;
 
       //! Convert Bayer mosaic to RGB24 using the nearest neighbor method.
       //! @param[in] bayer bayer mosaic.
@@ -0,0 +1,120 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Media/FrameAssembler.hpp>
+
+namespace DUNE
+{
+  namespace Media
+  {
+    FrameAssembler::FrameAssembler(void):
+      m_count(0),
+      m_id(0),
+      m_active(false),
+      m_key(false),
+      m_last(0),
+      m_synced(false),
+      m_lost(0)
+    { }
+
+    void
+    FrameAssembler::reset(void)
+    {
+      m_active = false;
+      m_synced = false;
+    }
+
+    void
+    FrameAssembler::start(unsigned frame, unsigned chunks, bool key)
+    {
+      // Frames skipped since the last completed one were lost.
+      if (m_synced && ((frame - m_last - 1) & 0xffff) != 0)
+      {
+        m_lost += (frame - m_last - 1) & 0xffff;
+        m_synced = false;
+      }
+
+      m_id = frame;
+      m_key = key;
+      m_active = true;
+      m_count = 0;
+      m_chunks.resize(chunks);
+      m_received.assign(chunks, false);
+    }
+
+    bool
+    FrameAssembler::add(unsigned frame, unsigned chunk, unsigned chunks, bool key, const char* data, size_t size)
+    {
+      frame &= 0xffff;
+      if (chunks == 0 || chunk >= chunks)
+        return false;
+
+      if (!m_active || frame != m_id)
+      {
+        // A chunk of the last completed frame arrived late.
+        if (!m_active && m_synced && frame == m_last)
+          return false;
+
+        if (m_active)
+        {
+          ++m_lost;
+          m_synced = false;
+          m_last = m_id;
+        }
+
+        start(frame, chunks, key);
+      }
+
+      if (chunks != m_chunks.size() || m_received[chunk])
+        return false;
+
+      m_chunks[chunk].assign(data, data + size);
+      m_received[chunk] = true;
+      if (++m_count < chunks)
+        return false;
+
+      m_active = false;
+      m_last = m_id;
+
+      if (m_key)
+        m_synced = true;
+
+      if (!m_synced)
+      {
+        ++m_lost;
+        return false;
+      }
+
+      m_frame.clear();
+      for (unsigned i = 0; i < m_chunks.size(); ++i)
+        m_frame.insert(m_frame.end(), m_chunks[i].begin(), m_chunks[i].end());
+
+      return true;
+    }
+  }
+}
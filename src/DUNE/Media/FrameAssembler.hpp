@@ -0,0 +1,124 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MEDIA_FRAME_ASSEMBLER_HPP_INCLUDED_
+#define DUNE_MEDIA_FRAME_ASSEMBLER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Media
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM FrameAssembler;
+
+    //! Reassembly of encoded video frames sent in chunks over lossy
+    //! links. Chunks of a frame may arrive in any order, but a frame
+    //! is given up once a chunk of another frame arrives. Predicted
+    //! frames reference earlier ones, so after a loss frames are
+    //! discarded until the next key frame.
+    class FrameAssembler
+    {
+    public:
+      //! Constructor.
+      FrameAssembler(void);
+
+      //! Add a chunk.
+      //! @param[in] frame frame sequence number (16 bits).
+      //! @param[in] chunk index of the chunk in the frame.
+      //! @param[in] chunks number of chunks of the frame.
+      //! @param[in] key true if the frame is a key frame.
+      //! @param[in] data chunk data.
+      //! @param[in] size size of chunk data in bytes.
+      //! @return true if a frame that can be decoded was completed
+      //! (see getFrame()), false otherwise.
+      bool
+      add(unsigned frame, unsigned chunk, unsigned chunks, bool key, const char* data, size_t size);
+
+      //! Get the last completed frame.
+      //! @return frame data.
+      const std::vector<char>&
+      getFrame(void) const
+      {
+        return m_frame;
+      }
+
+      //! Test if the decoder is waiting for a key frame.
+      //! @return true if waiting for a key frame, false otherwise.
+      bool
+      isWaitingKeyFrame(void) const
+      {
+        return !m_synced;
+      }
+
+      //! Get the number of frames lost or discarded.
+      //! @return number of frames.
+      unsigned
+      getLost(void) const
+      {
+        return m_lost;
+      }
+
+      //! Discard the frame being assembled and wait for a key frame.
+      void
+      reset(void);
+
+    private:
+      //! Chunks of the frame being assembled.
+      std::vector<std::vector<char> > m_chunks;
+      //! Chunks received of the frame being assembled.
+      std::vector<bool> m_received;
+      //! Number of chunks received of the frame being assembled.
+      unsigned m_count;
+      //! Sequence number of the frame being assembled.
+      unsigned m_id;
+      //! True if a frame is being assembled.
+      bool m_active;
+      //! True if the frame being assembled is a key frame.
+      bool m_key;
+      //! Sequence number of the last completed frame.
+      unsigned m_last;
+      //! True if all frames since the last key frame were completed.
+      bool m_synced;
+      //! Number of frames lost or discarded.
+      unsigned m_lost;
+      //! Last completed frame.
+      std::vector<char> m_frame;
+
+      void
+      start(unsigned frame, unsigned chunks, bool key);
+    };
+  }
+}
+
+#endif
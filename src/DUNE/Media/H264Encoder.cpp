@@ -0,0 +1,480 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Media/H264Encoder.hpp>
+#include <DUNE/System/Error.hpp>
+#include <DUNE/Utils/String.hpp>
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_IOCTL_H)
+#  include <sys/ioctl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_TIME_H)
+#  include <sys/time.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+#  include <sys/mman.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_LINUX_VIDEODEV2_H)
+#  include <linux/videodev2.h>
+#endif
+
+// Memory-to-memory codecs are driven with plain ioctls: libv4l2
+// plugins only apply to capture devices.
+#if defined(DUNE_SYS_HAS_LINUX_VIDEODEV2_H) && defined(DUNE_SYS_HAS_SYS_MMAN_H) \
+  && defined(V4L2_PIX_FMT_H264) && defined(V4L2_CAP_VIDEO_M2M_MPLANE)
+#  define H264_ENCODER_V4L2
+#endif
+
+namespace DUNE
+{
+  using System::Error;
+  using Utils::String;
+
+  namespace Media
+  {
+#if defined(H264_ENCODER_V4L2)
+    static int
+    testIoctl(int fd, unsigned long request, void* arg)
+    {
+      int rv = 0;
+
+      do
+      {
+        rv = ioctl(fd, request, arg);
+      }
+      while (rv == -1 && errno == EINTR);
+
+      return rv;
+    }
+
+    static void
+    doIoctl(int fd, unsigned long request, void* arg)
+    {
+      if (testIoctl(fd, request, arg) == -1)
+        throw Error(errno, "I/O control error");
+    }
+
+    //! Prepare a single-plane buffer descriptor.
+    static void
+    initBuffer(v4l2_buffer& bfr, v4l2_plane& plane, unsigned type, unsigned index)
+    {
+      std::memset(&bfr, 0, sizeof(v4l2_buffer));
+      std::memset(&plane, 0, sizeof(v4l2_plane));
+      bfr.type = type;
+      bfr.memory = V4L2_MEMORY_MMAP;
+      bfr.index = index;
+      bfr.m.planes = &plane;
+      bfr.length = 1;
+    }
+#endif
+
+    H264Encoder::H264Encoder(const std::string& dev, unsigned width, unsigned height,
+                             unsigned bitrate, unsigned gop, unsigned buffers):
+      m_fd(-1),
+      m_width(width),
+      m_height(height),
+      m_stride(width),
+      m_rows(height),
+      m_frame_size(0)
+    {
+#if defined(H264_ENCODER_V4L2)
+      m_fd = open(dev.c_str(), O_RDWR | O_NONBLOCK);
+      if (m_fd < 0)
+        throw Error(errno, String::str("failed to open device '%s'", dev.c_str()));
+
+      try
+      {
+        v4l2_capability cap;
+        std::memset(&cap, 0, sizeof(v4l2_capability));
+        doIoctl(m_fd, VIDIOC_QUERYCAP, &cap);
+
+        uint32_t caps = cap.capabilities;
+        if (caps & V4L2_CAP_DEVICE_CAPS)
+          caps = cap.device_caps;
+
+        if (!(caps & V4L2_CAP_VIDEO_M2M_MPLANE))
+          throw std::runtime_error("device is not a memory-to-memory codec");
+
+        // Coded format first: encoders derive input constraints from it.
+        v4l2_format fmt;
+        std::memset(&fmt, 0, sizeof(v4l2_format));
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+        fmt.fmt.pix_mp.width = width;
+        fmt.fmt.pix_mp.height = height;
+        fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_H264;
+        fmt.fmt.pix_mp.field = V4L2_FIELD_NONE;
+        fmt.fmt.pix_mp.num_planes = 1;
+        fmt.fmt.pix_mp.plane_fmt[0].sizeimage = width * height * 3 / 2;
+        doIoctl(m_fd, VIDIOC_S_FMT, &fmt);
+
+        if (fmt.fmt.pix_mp.pixelformat != V4L2_PIX_FMT_H264)
+          throw std::runtime_error("H.264 is not supported by device");
+
+        std::memset(&fmt, 0, sizeof(v4l2_format));
+        fmt.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+        fmt.fmt.pix_mp.width = width;
+        fmt.fmt.pix_mp.height = height;
+        fmt.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_YUV420;
+        fmt.fmt.pix_mp.field = V4L2_FIELD_NONE;
+        fmt.fmt.pix_mp.num_planes = 1;
+        doIoctl(m_fd, VIDIOC_S_FMT, &fmt);
+
+        if (fmt.fmt.pix_mp.pixelformat != V4L2_PIX_FMT_YUV420 || fmt.fmt.pix_mp.num_planes != 1)
+          throw std::runtime_error("planar YUV 4:2:0 input is not supported by device");
+
+        // Drivers may pad rows and align the height of the planes.
+        if (fmt.fmt.pix_mp.plane_fmt[0].bytesperline > 0)
+          m_stride = fmt.fmt.pix_mp.plane_fmt[0].bytesperline;
+        m_rows = std::max(height, (unsigned)fmt.fmt.pix_mp.height);
+        m_frame_size = fmt.fmt.pix_mp.plane_fmt[0].sizeimage;
+        if (m_frame_size < m_stride * m_rows * 3 / 2)
+          throw std::runtime_error("input buffers are too small");
+
+        setBitRate(bitrate);
+        setControl(V4L2_CID_MPEG_VIDEO_GOP_SIZE, gop);
+        setControl(V4L2_CID_MPEG_VIDEO_H264_I_PERIOD, gop);
+        setControl(V4L2_CID_MPEG_VIDEO_B_FRAMES, 0);
+        setControl(V4L2_CID_MPEG_VIDEO_REPEAT_SEQ_HEADER, 1);
+        setControl(V4L2_CID_MPEG_VIDEO_H264_PROFILE, V4L2_MPEG_VIDEO_H264_PROFILE_CONSTRAINED_BASELINE);
+
+        mapBuffers(V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, buffers, m_in);
+        for (unsigned i = 0; i < m_in.size(); ++i)
+          m_in_free.push_back(i);
+
+        mapBuffers(V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, buffers, m_out);
+        for (unsigned i = 0; i < m_out.size(); ++i)
+          queueOutput(i);
+
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+        doIoctl(m_fd, VIDIOC_STREAMON, &type);
+        type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+        doIoctl(m_fd, VIDIOC_STREAMON, &type);
+      }
+      catch (...)
+      {
+        release();
+        throw;
+      }
+#else
+      (void)dev;
+      (void)bitrate;
+      (void)gop;
+      (void)buffers;
+
+      throw std::runtime_error("H264Encoder is not yet implemented in this system.");
+#endif
+    }
+
+    H264Encoder::~H264Encoder(void)
+    {
+#if defined(H264_ENCODER_V4L2)
+      v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+      testIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+      type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+      testIoctl(m_fd, VIDIOC_STREAMOFF, &type);
+#endif
+
+      release();
+    }
+
+    void
+    H264Encoder::release(void)
+    {
+#if defined(H264_ENCODER_V4L2)
+      for (unsigned i = 0; i < m_in.size(); ++i)
+        munmap(m_in[i].start, m_in[i].length);
+      m_in.clear();
+      m_in_free.clear();
+
+      for (unsigned i = 0; i < m_out.size(); ++i)
+        munmap(m_out[i].start, m_out[i].length);
+      m_out.clear();
+
+      if (m_fd >= 0)
+        close(m_fd);
+      m_fd = -1;
+#endif
+    }
+
+    void
+    H264Encoder::mapBuffers(unsigned type, unsigned count, std::vector<Buffer>& bfrs)
+    {
+#if defined(H264_ENCODER_V4L2)
+      v4l2_requestbuffers req;
+      std::memset(&req, 0, sizeof(v4l2_requestbuffers));
+      req.count = count;
+      req.type = type;
+      req.memory = V4L2_MEMORY_MMAP;
+      doIoctl(m_fd, VIDIOC_REQBUFS, &req);
+
+      for (unsigned i = 0; i < req.count; ++i)
+      {
+        v4l2_buffer bfr;
+        v4l2_plane plane;
+        initBuffer(bfr, plane, type, i);
+        doIoctl(m_fd, VIDIOC_QUERYBUF, &bfr);
+
+        Buffer b;
+        b.length = plane.length;
+        b.start = mmap(0, plane.length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       m_fd, plane.m.mem_offset);
+        if (b.start == MAP_FAILED)
+          throw Error(errno, "failed to map encoder buffer");
+
+        bfrs.push_back(b);
+      }
+#else
+      (void)type;
+      (void)count;
+      (void)bfrs;
+#endif
+    }
+
+    void
+    H264Encoder::setControl(unsigned id, int value)
+    {
+#if defined(H264_ENCODER_V4L2)
+      // Controls are hints: not every driver implements all of them.
+      v4l2_control ctrl;
+      std::memset(&ctrl, 0, sizeof(v4l2_control));
+      ctrl.id = id;
+      ctrl.value = value;
+      testIoctl(m_fd, VIDIOC_S_CTRL, &ctrl);
+#else
+      (void)id;
+      (void)value;
+#endif
+    }
+
+    void
+    H264Encoder::setBitRate(unsigned bitrate)
+    {
+#if defined(H264_ENCODER_V4L2)
+      setControl(V4L2_CID_MPEG_VIDEO_BITRATE, (int)bitrate);
+#else
+      (void)bitrate;
+#endif
+    }
+
+    void
+    H264Encoder::requestKeyFrame(void)
+    {
+#if defined(H264_ENCODER_V4L2) && defined(V4L2_CID_MPEG_VIDEO_FORCE_KEY_FRAME)
+      setControl(V4L2_CID_MPEG_VIDEO_FORCE_KEY_FRAME, 1);
+#endif
+    }
+
+    void
+    H264Encoder::reclaimInput(void)
+    {
+#if defined(H264_ENCODER_V4L2)
+      while (true)
+      {
+        v4l2_buffer bfr;
+        v4l2_plane plane;
+        initBuffer(bfr, plane, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, 0);
+        if (testIoctl(m_fd, VIDIOC_DQBUF, &bfr) == -1)
+        {
+          if (errno == EAGAIN)
+            return;
+          throw Error(errno, "I/O control error");
+        }
+
+        m_in_free.push_back(bfr.index);
+      }
+#endif
+    }
+
+    void
+    H264Encoder::queueOutput(unsigned index)
+    {
+#if defined(H264_ENCODER_V4L2)
+      v4l2_buffer bfr;
+      v4l2_plane plane;
+      initBuffer(bfr, plane, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, index);
+      plane.length = m_out[index].length;
+      doIoctl(m_fd, VIDIOC_QBUF, &bfr);
+#else
+      (void)index;
+#endif
+    }
+
+    bool
+    H264Encoder::submit(const uint8_t* rgb, double tstamp)
+    {
+#if defined(H264_ENCODER_V4L2)
+      reclaimInput();
+      if (m_in_free.empty())
+        return false;
+
+      unsigned index = m_in_free.back();
+      m_in_free.pop_back();
+
+      uint8_t* y = (uint8_t*)m_in[index].start;
+      uint8_t* u = y + m_stride * m_rows;
+      uint8_t* v = u + (m_stride / 2) * (m_rows / 2);
+      convertRGB24(rgb, m_width, m_height, y, m_stride, u, v, m_stride / 2);
+
+      v4l2_buffer bfr;
+      v4l2_plane plane;
+      initBuffer(bfr, plane, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, index);
+      plane.bytesused = m_frame_size;
+      plane.length = m_in[index].length;
+      // Encoders copy timestamps to the matching encoded frames.
+      bfr.timestamp.tv_sec = (long)tstamp;
+      bfr.timestamp.tv_usec = (long)((tstamp - bfr.timestamp.tv_sec) * 1e6);
+      doIoctl(m_fd, VIDIOC_QBUF, &bfr);
+      return true;
+#else
+      (void)rgb;
+      (void)tstamp;
+      return false;
+#endif
+    }
+
+    bool
+    H264Encoder::receive(std::vector<char>& data, bool& key, double& tstamp, double timeout)
+    {
+#if defined(H264_ENCODER_V4L2)
+      fd_set fds;
+      timeval tv;
+      int rv = 0;
+
+      do
+      {
+        FD_ZERO(&fds);
+        FD_SET(m_fd, &fds);
+        tv.tv_sec = (long)timeout;
+        tv.tv_usec = (long)((timeout - tv.tv_sec) * 1e6);
+        rv = select(m_fd + 1, &fds, NULL, NULL, &tv);
+      }
+      while (rv == -1 && errno == EINTR);
+
+      if (rv <= 0)
+        return false;
+
+      v4l2_buffer bfr;
+      v4l2_plane plane;
+      initBuffer(bfr, plane, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, 0);
+      if (testIoctl(m_fd, VIDIOC_DQBUF, &bfr) == -1)
+      {
+        if (errno == EAGAIN)
+          return false;
+        throw Error(errno, "I/O control error");
+      }
+
+      const char* start = (const char*)m_out[bfr.index].start + plane.data_offset;
+      size_t size = (plane.bytesused > plane.data_offset) ? plane.bytesused - plane.data_offset : 0;
+      data.assign(start, start + size);
+      queueOutput(bfr.index);
+
+      key = (bfr.flags & V4L2_BUF_FLAG_KEYFRAME) || isKeyFrame((const uint8_t*)&data[0], size);
+      tstamp = bfr.timestamp.tv_sec + bfr.timestamp.tv_usec / 1e6;
+      return size > 0;
+#else
+      (void)data;
+      (void)key;
+      (void)tstamp;
+      (void)timeout;
+      return false;
+#endif
+    }
+
+    void
+    H264Encoder::convertRGB24(const uint8_t* rgb, unsigned width, unsigned height,
+                              uint8_t* y, unsigned y_stride, uint8_t* u, uint8_t* v, unsigned uv_stride)
+    {
+      for (unsigned row = 0; row < height; row += 2)
+      {
+        const uint8_t* p0 = rgb + row * width * 3;
+        const uint8_t* p1 = p0 + width * 3;
+        uint8_t* y0 = y + row * y_stride;
+        uint8_t* y1 = y0 + y_stride;
+        uint8_t* ur = u + (row / 2) * uv_stride;
+        uint8_t* vr = v + (row / 2) * uv_stride;
+
+        for (unsigned col = 0; col < width; col += 2)
+        {
+          int r = 0;
+          int g = 0;
+          int b = 0;
+
+          for (unsigned i = 0; i < 2; ++i)
+          {
+            const uint8_t* q0 = p0 + (col + i) * 3;
+            const uint8_t* q1 = p1 + (col + i) * 3;
+            y0[col + i] = (uint8_t)(((66 * q0[0] + 129 * q0[1] + 25 * q0[2] + 128) >> 8) + 16);
+            y1[col + i] = (uint8_t)(((66 * q1[0] + 129 * q1[1] + 25 * q1[2] + 128) >> 8) + 16);
+            r += q0[0] + q1[0];
+            g += q0[1] + q1[1];
+            b += q0[2] + q1[2];
+          }
+
+          // Offsets keep the sums positive before shifting.
+          ur[col / 2] = (uint8_t)((-38 * r - 74 * g + 112 * b + (128 << 10) + 512) >> 10);
+          vr[col / 2] = (uint8_t)((112 * r - 94 * g - 18 * b + (128 << 10) + 512) >> 10);
+        }
+      }
+    }
+
+    bool
+    H264Encoder::isKeyFrame(const uint8_t* data, size_t size)
+    {
+      for (size_t i = 0; i + 3 < size; ++i)
+      {
+        if (data[i] != 0 || data[i + 1] != 0 || data[i + 2] != 1)
+          continue;
+
+        // Instantaneous decoding refresh picture.
+        if ((data[i + 3] & 0x1f) == 5)
+          return true;
+
+        i += 2;
+      }
+
+      return false;
+    }
+  }
+}
@@ -0,0 +1,164 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_MEDIA_H264_ENCODER_HPP_INCLUDED_
+#define DUNE_MEDIA_H264_ENCODER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Media
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM H264Encoder;
+
+    //! H.264 encoder using a Video4Linux2 memory-to-memory hardware
+    //! codec (e.g., /dev/video11 on the Raspberry Pi). RGB24 frames
+    //! are converted to planar YUV 4:2:0 straight into the encoder's
+    //! memory-mapped input buffers and encoded frames are returned in
+    //! Annex B format, with sequence headers repeated before every
+    //! key frame so that receivers can join the stream at any key
+    //! frame. Input and output are decoupled: the encoder may hold a
+    //! few frames before producing output.
+    class H264Encoder
+    {
+    public:
+      //! Constructor.
+      //! @param[in] dev encoder device.
+      //! @param[in] width frame width (even).
+      //! @param[in] height frame height (even).
+      //! @param[in] bitrate target bit rate in bits per second.
+      //! @param[in] gop number of frames between key frames.
+      //! @param[in] buffers number of input and output buffers.
+      H264Encoder(const std::string& dev, unsigned width, unsigned height,
+                  unsigned bitrate, unsigned gop, unsigned buffers = 4);
+
+      //! Destructor.
+      ~H264Encoder(void);
+
+      //! Submit a frame for encoding.
+      //! @param[in] rgb RGB24 frame.
+      //! @param[in] tstamp capture time, returned with the encoded
+      //! frame.
+      //! @return true if the frame was queued, false if all input
+      //! buffers are held by the encoder (the frame is dropped).
+      bool
+      submit(const uint8_t* rgb, double tstamp);
+
+      //! Wait for an encoded frame.
+      //! @param[out] data encoded frame (Annex B).
+      //! @param[out] key true if the frame is a key frame.
+      //! @param[out] tstamp capture time of the frame.
+      //! @param[in] timeout maximum amount of time to wait in seconds.
+      //! @return true if a frame was retrieved, false otherwise.
+      bool
+      receive(std::vector<char>& data, bool& key, double& tstamp, double timeout);
+
+      //! Set the target bit rate.
+      //! @param[in] bitrate bit rate in bits per second.
+      void
+      setBitRate(unsigned bitrate);
+
+      //! Make the next encoded frame a key frame, e.g., when a new
+      //! receiver joins the stream.
+      void
+      requestKeyFrame(void);
+
+      //! Convert an RGB24 image to planar YUV 4:2:0 with BT.601
+      //! limited range, as expected by H.264 encoders. Chroma is the
+      //! average of each 2x2 block.
+      //! @param[in] rgb RGB24 image.
+      //! @param[in] width image width (even).
+      //! @param[in] height image height (even).
+      //! @param[out] y luma plane.
+      //! @param[in] y_stride distance between luma rows in bytes.
+      //! @param[out] u blue-difference plane.
+      //! @param[out] v red-difference plane.
+      //! @param[in] uv_stride distance between chroma rows in bytes.
+      static void
+      convertRGB24(const uint8_t* rgb, unsigned width, unsigned height,
+                   uint8_t* y, unsigned y_stride, uint8_t* u, uint8_t* v, unsigned uv_stride);
+
+      //! Test if an Annex B access unit holds an IDR picture.
+      //! @param[in] data access unit.
+      //! @param[in] size size of access unit in bytes.
+      //! @return true if a key frame, false otherwise.
+      static bool
+      isKeyFrame(const uint8_t* data, size_t size);
+
+    private:
+      struct Buffer
+      {
+        void* start;
+        size_t length;
+      };
+
+      //! Device file descriptor.
+      int m_fd;
+      //! Frame width.
+      unsigned m_width;
+      //! Frame height.
+      unsigned m_height;
+      //! Distance between luma rows of input buffers.
+      unsigned m_stride;
+      //! Number of luma rows of input buffers.
+      unsigned m_rows;
+      //! Size of input frames.
+      unsigned m_frame_size;
+      //! Input (raw frame) buffers.
+      std::vector<Buffer> m_in;
+      //! Input buffers not held by the encoder.
+      std::vector<unsigned> m_in_free;
+      //! Output (encoded frame) buffers.
+      std::vector<Buffer> m_out;
+
+      void
+      release(void);
+
+      void
+      setControl(unsigned id, int value);
+
+      void
+      mapBuffers(unsigned type, unsigned count, std::vector<Buffer>& bfrs);
+
+      void
+      reclaimInput(void);
+
+      void
+      queueOutput(unsigned index);
+    };
+  }
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include <DUNE/Media/JPEGCompressor.hpp>
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
@@ -201,6 +202,88 @@ namespace DUNE
       return true;
     }
 
+    bool
+    JPEGCompressor::compressYCbCr420(const uint8_t* y, const uint8_t* cb, const uint8_t* cr, uint8_t quality)
+    {
+      J_COLOR_SPACE in_cspace = m_jcinfo->in_color_space;
+      int in_components = m_jcinfo->input_components;
+      J_COLOR_SPACE out_cspace = m_jcinfo->jpeg_color_space;
+
+      m_jcinfo->in_color_space = JCS_YCbCr;
+      m_jcinfo->input_components = 3;
+      jpeg_set_colorspace(m_jcinfo, JCS_YCbCr);
+      m_jcinfo->comp_info[0].h_samp_factor = 2;
+      m_jcinfo->comp_info[0].v_samp_factor = 2;
+      for (int i = 1; i < 3; ++i)
+      {
+        m_jcinfo->comp_info[i].h_samp_factor = 1;
+        m_jcinfo->comp_info[i].v_samp_factor = 1;
+      }
+      m_jcinfo->raw_data_in = TRUE;
+#if JPEG_LIB_VERSION >= 70
+      // Otherwise libjpeg 7+ downsamples chroma with scaled DCTs,
+      // expecting full resolution chroma rows.
+      boolean fancy = m_jcinfo->do_fancy_downsampling;
+      m_jcinfo->do_fancy_downsampling = FALSE;
+#endif
+
+      jpeg_set_quality(m_jcinfo, quality, TRUE);
+      jpeg_start_compress(m_jcinfo, TRUE);
+
+      // The encoder reads whole 8x8 blocks, 16 luma and 8 chroma rows
+      // at a time: rows that are not a multiple of 8 samples wide are
+      // padded and rows past the bottom repeat the last one.
+      const uint8_t* planes[3] = {y, cb, cr};
+      unsigned width = m_jcinfo->image_width;
+      unsigned height = m_jcinfo->image_height;
+      unsigned widths[3] = {width, width / 2, width / 2};
+      unsigned heights[3] = {height, height / 2, height / 2};
+      unsigned lines[3] = {2 * DCTSIZE, DCTSIZE, DCTSIZE};
+      unsigned padded = (width + DCTSIZE - 1) / DCTSIZE * DCTSIZE;
+      m_padded.resize(4 * DCTSIZE * padded);
+
+      JSAMPROW rows[4 * DCTSIZE];
+      JSAMPARRAY arrays[3] = {rows, rows + 2 * DCTSIZE, rows + 3 * DCTSIZE};
+
+      while (m_jcinfo->next_scanline < height)
+      {
+        for (unsigned c = 0; c < 3; ++c)
+        {
+          unsigned first = m_jcinfo->next_scanline * lines[c] / (2 * DCTSIZE);
+          unsigned w = widths[c];
+          unsigned pw = (w + DCTSIZE - 1) / DCTSIZE * DCTSIZE;
+
+          for (unsigned r = 0; r < lines[c]; ++r)
+          {
+            const uint8_t* src = planes[c] + std::min(first + r, heights[c] - 1) * w;
+            if (pw == w)
+            {
+              arrays[c][r] = (JSAMPROW)src;
+              continue;
+            }
+
+            uint8_t* dst = &m_padded[(arrays[c] - rows + r) * padded];
+            std::memcpy(dst, src, w);
+            std::memset(dst + w, src[w - 1], pw - w);
+            arrays[c][r] = dst;
+          }
+        }
+
+        jpeg_write_raw_data(m_jcinfo, arrays, 2 * DCTSIZE);
+      }
+
+      jpeg_finish_compress(m_jcinfo);
+
+      m_jcinfo->raw_data_in = FALSE;
+#if JPEG_LIB_VERSION >= 70
+      m_jcinfo->do_fancy_downsampling = fancy;
+#endif
+      m_jcinfo->in_color_space = in_cspace;
+      m_jcinfo->input_components = in_components;
+      jpeg_set_colorspace(m_jcinfo, out_cspace);
+      return true;
+    }
+
     const uint8_t*
     JPEGCompressor::imageData(void) const
     {
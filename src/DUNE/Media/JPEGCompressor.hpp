@@ -28,6 +28,9 @@
 #ifndef DUNE_MEDIA_JPEG_COMPRESSOR_HPP_INCLUDED_
 #define DUNE_MEDIA_JPEG_COMPRESSOR_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -97,6 +100,18 @@ namespace DUNE
       bool
       compress(uint8_t* raw, uint8_t quality = 90);
 
+      //! Compress a planar YCbCr 4:2:0 image (see
+      //! BayerDecoder::decodeToYCbCr420) in JPEG. Planes are handed
+      //! directly to the encoder, skipping color conversion and
+      //! downsampling. Color space settings are not changed.
+      //! @param y luma plane.
+      //! @param cb blue-difference plane (half width and height).
+      //! @param cr red-difference plane (half width and height).
+      //! @param quality JPEG image quality.
+      //! @return true on success, false otherwise.
+      bool
+      compressYCbCr420(const uint8_t* y, const uint8_t* cb, const uint8_t* cr, uint8_t quality = 90);
+
       //! Retrieve the compressed image.
       //! @return compressed image.
       const uint8_t*
@@ -114,6 +129,8 @@ namespace DUNE
       jpeg_compress_struct* m_jcinfo;
       //! JPEG compression error.
       jpeg_error_mgr* m_jerror;
+      //! Rows padded to whole blocks for compressYCbCr420().
+      std::vector<uint8_t> m_padded;
       //! Default buffer size.
       const static uint32_t c_default_bfr_size = 102400;
       //! Default image width.
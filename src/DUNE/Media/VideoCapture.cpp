@@ -97,9 +97,19 @@ namespace DUNE
         throw Error(errno, "I/O control error");
     }
 
+    //! Prepare a buffer descriptor for the ioctls of memory-mapped
+    //! capture buffers.
+    static void
+    initBuffer(v4l2_buffer& bfr)
+    {
+      std::memset(&bfr, 0, sizeof(v4l2_buffer));
+      bfr.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      bfr.memory = V4L2_MEMORY_MMAP;
+    }
 #endif
 
-    VideoCapture::VideoCapture(const std::string& dev, uint32_t w, uint32_t h)
+    VideoCapture::VideoCapture(const std::string& dev, uint32_t w, uint32_t h, unsigned buffers):
+      m_current(-1)
     {
       // Video 4 Linux library implementation.
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
@@ -123,26 +133,24 @@ namespace DUNE
       // Initialize V4L2 request buffers.
       m_bfr_req = new v4l2_requestbuffers;
       std::memset(m_bfr_req, 0, sizeof(v4l2_requestbuffers));
-      m_bfr_req->count = 2;
+      m_bfr_req->count = buffers;
       m_bfr_req->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
       m_bfr_req->memory = V4L2_MEMORY_MMAP;
       doIoctl(m_fd, VIDIOC_REQBUFS, m_bfr_req);
 
-      m_bfr = new v4l2_buffer;
       m_bfrs = (Buffer*)calloc(m_bfr_req->count, sizeof(Buffer));
 
       for (unsigned i = 0; i < m_bfr_req->count; ++i)
       {
-        std::memset(m_bfr, 0, sizeof(v4l2_buffer));
-        m_bfr->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        m_bfr->memory = V4L2_MEMORY_MMAP;
-        m_bfr->index = i;
-        doIoctl(m_fd, VIDIOC_QUERYBUF, m_bfr);
-
-        m_bfrs[i].length = m_bfr->length;
-        m_bfrs[i].start = v4l2_mmap(0, m_bfr->length,
+        v4l2_buffer bfr;
+        initBuffer(bfr);
+        bfr.index = i;
+        doIoctl(m_fd, VIDIOC_QUERYBUF, &bfr);
+
+        m_bfrs[i].length = bfr.length;
+        m_bfrs[i].start = v4l2_mmap(0, bfr.length,
                                     PROT_READ | PROT_WRITE, MAP_SHARED,
-                                    m_fd, m_bfr->m.offset);
+                                    m_fd, bfr.m.offset);
 
         if (MAP_FAILED == m_bfrs[i].start)
         {
@@ -150,17 +158,14 @@ namespace DUNE
           exit(EXIT_FAILURE);
         }
 
-        std::memset(m_bfr, 0, sizeof(v4l2_buffer));
-        m_bfr->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-        m_bfr->memory = V4L2_MEMORY_MMAP;
-        m_bfr->index = i;
-        doIoctl(m_fd, VIDIOC_QBUF, m_bfr);
+        releaseFrame(i);
       }
 
 #else
       (void)dev;
       (void)h;
       (void)w;
+      (void)buffers;
 
       throw std::runtime_error("VideoCapture is not yet implemented in this system.");
 #endif
@@ -178,7 +183,6 @@ namespace DUNE
 
       free(m_bfrs);
       delete m_bfr_req;
-      delete m_bfr;
       delete m_fmt;
 #endif
     }
@@ -189,13 +193,6 @@ namespace DUNE
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
       v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
       doIoctl(m_fd, VIDIOC_STREAMON, &type);
-
-      // Read one frame to allow for captureFrame() to enqueue/deque
-      // buffers in one run.
-      std::memset(m_bfr, 0, sizeof(v4l2_buffer));
-      m_bfr->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-      m_bfr->memory = V4L2_MEMORY_MMAP;
-      doIoctl(m_fd, VIDIOC_DQBUF, m_bfr);
 #endif
     }
 
@@ -241,6 +238,16 @@ namespace DUNE
     bool
     VideoCapture::frameCapture(void)
     {
+      if (m_current >= 0)
+        releaseFrame(m_current);
+
+      m_current = acquireFrame(1.0);
+      return m_current >= 0;
+    }
+
+    int
+    VideoCapture::acquireFrame(double timeout)
+    {
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
       fd_set fds;
       timeval tv;
@@ -250,20 +257,104 @@ namespace DUNE
       {
         FD_ZERO(&fds);
         FD_SET(m_fd, &fds);
-        tv.tv_sec = 1;
-        tv.tv_usec = 0;
+        tv.tv_sec = (long)timeout;
+        tv.tv_usec = (long)((timeout - tv.tv_sec) * 1e6);
         rv = select(m_fd + 1, &fds, NULL, NULL, &tv);
       }
-      while ((rv == -1 && (errno = EINTR)));
-
-      doIoctl(m_fd, VIDIOC_QBUF, m_bfr);
-      std::memset(m_bfr, 0, sizeof(v4l2_buffer));
-      m_bfr->type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-      m_bfr->memory = V4L2_MEMORY_MMAP;
-      doIoctl(m_fd, VIDIOC_DQBUF, m_bfr);
-      return true;
+      while (rv == -1 && errno == EINTR);
+
+      if (rv <= 0)
+        return -1;
+
+      v4l2_buffer bfr;
+      initBuffer(bfr);
+      if (testIoctl(m_fd, VIDIOC_DQBUF, &bfr) == -1)
+      {
+        if (errno == EAGAIN)
+          return -1;
+        throw Error(errno, "I/O control error");
+      }
+
+      m_bfrs[bfr.index].used = bfr.bytesused;
+      m_bfrs[bfr.index].sequence = bfr.sequence;
+      return bfr.index;
+#else
+      (void)timeout;
+      return -1;
+#endif
+    }
+
+    void
+    VideoCapture::releaseFrame(int index)
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      v4l2_buffer bfr;
+      initBuffer(bfr);
+      bfr.index = index;
+      doIoctl(m_fd, VIDIOC_QBUF, &bfr);
+#else
+      (void)index;
+#endif
+    }
+
+    unsigned
+    VideoCapture::getBufferCount(void) const
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      return m_bfr_req->count;
+#else
+      return 0;
+#endif
+    }
+
+    const uint8_t*
+    VideoCapture::getBufferData(int index) const
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      return (const uint8_t*)m_bfrs[index].start;
+#else
+      (void)index;
+      return 0;
+#endif
+    }
+
+    uint32_t
+    VideoCapture::getBufferSize(int index) const
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      return m_bfrs[index].used;
+#else
+      (void)index;
+      return 0;
+#endif
+    }
+
+    uint32_t
+    VideoCapture::getBufferSequence(int index) const
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H)
+      return m_bfrs[index].sequence;
+#else
+      (void)index;
+      return 0;
+#endif
+    }
+
+    int
+    VideoCapture::exportBuffer(int index) const
+    {
+#if defined(DUNE_SYS_HAS_LIBV4L2_H) && defined(VIDIOC_EXPBUF)
+      v4l2_exportbuffer exp;
+      std::memset(&exp, 0, sizeof(v4l2_exportbuffer));
+      exp.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      exp.index = index;
+      exp.flags = O_RDONLY | O_CLOEXEC;
+      if (testIoctl(m_fd, VIDIOC_EXPBUF, &exp) == -1)
+        return -1;
+      return exp.fd;
 #else
-      return false;
+      (void)index;
+      return -1;
 #endif
     }
 
@@ -291,7 +382,9 @@ namespace DUNE
     VideoCapture::frameData(void) const
     {
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
-      return (uint8_t*)m_bfrs[m_bfr->index].start;
+      if (m_current < 0)
+        return 0;
+      return (uint8_t*)m_bfrs[m_current].start;
 #else
       return 0;
 #endif
@@ -301,7 +394,9 @@ namespace DUNE
     VideoCapture::frameSize(void) const
     {
 #if defined(DUNE_SYS_HAS_LIBV4L2_H)
-      return m_bfr->bytesused;
+      if (m_current < 0)
+        return 0;
+      return m_bfrs[m_current].used;
 #else
       return 0;
 #endif
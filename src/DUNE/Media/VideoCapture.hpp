@@ -36,7 +36,6 @@
 
 // Forward declarations.
 struct v4l2_format;
-struct v4l2_buffer;
 struct v4l2_requestbuffers;
 
 namespace DUNE
@@ -46,6 +45,13 @@ namespace DUNE
     // Export DLL Symbol.
     class DUNE_DLL_SYM VideoCapture;
 
+    //! Video capture from Video4Linux2 devices. Frames are captured
+    //! into memory-mapped driver buffers that can be held by the
+    //! application while it processes them, avoiding copies:
+    //! acquireFrame() dequeues a buffer and releaseFrame() hands it
+    //! back to the driver. While buffers are held the driver has
+    //! fewer buffers to capture into, and frames arriving when none
+    //! is left are dropped by the driver (see getBufferSequence()).
     class VideoCapture
     {
     public:
@@ -58,7 +64,13 @@ namespace DUNE
         STANDARD_NTSC
       };
 
-      VideoCapture(const std::string& dev, uint32_t width, uint32_t height);
+      //! Constructor.
+      //! @param[in] dev video device.
+      //! @param[in] width frame width.
+      //! @param[in] height frame height.
+      //! @param[in] buffers number of driver buffers to request (the
+      //! driver may allocate more).
+      VideoCapture(const std::string& dev, uint32_t width, uint32_t height, unsigned buffers = 2);
 
       ~VideoCapture(void);
 
@@ -71,6 +83,9 @@ namespace DUNE
       void
       setStandard(Standard standard);
 
+      //! Release the current frame, if any, and wait for the next
+      //! one, accessible with frameData().
+      //! @return true if a frame was captured, false otherwise.
       bool
       frameCapture(void);
 
@@ -86,18 +101,69 @@ namespace DUNE
       uint32_t
       frameSize(void) const;
 
+      //! Wait for a captured frame and take its buffer from the
+      //! driver. The buffer must be returned with releaseFrame().
+      //! @param[in] timeout maximum amount of time to wait in seconds.
+      //! @return buffer index or -1 if no frame was captured.
+      int
+      acquireFrame(double timeout = 1.0);
+
+      //! Return a buffer to the driver. This function may be called
+      //! from any thread.
+      //! @param[in] index buffer index returned by acquireFrame().
+      void
+      releaseFrame(int index);
+
+      //! Get the number of driver buffers.
+      //! @return number of buffers.
+      unsigned
+      getBufferCount(void) const;
+
+      //! Get the data of an acquired buffer.
+      //! @param[in] index buffer index.
+      //! @return frame data.
+      const uint8_t*
+      getBufferData(int index) const;
+
+      //! Get the amount of data of an acquired buffer.
+      //! @param[in] index buffer index.
+      //! @return size of frame data in bytes.
+      uint32_t
+      getBufferSize(int index) const;
+
+      //! Get the driver sequence number of the frame of an acquired
+      //! buffer. Gaps in the sequence are frames dropped by the
+      //! driver.
+      //! @param[in] index buffer index.
+      //! @return sequence number.
+      uint32_t
+      getBufferSequence(int index) const;
+
+      //! Export a buffer as a DMA buffer file descriptor
+      //! (VIDIOC_EXPBUF), to share frames with hardware encoders
+      //! without copies. The caller must close the descriptor.
+      //! @param[in] index buffer index.
+      //! @return file descriptor or -1 if exporting is not supported.
+      int
+      exportBuffer(int index) const;
+
     private:
       struct Buffer
       {
         void* start;
         size_t length;
+        //! Amount of data of the last frame.
+        uint32_t used;
+        //! Sequence number of the last frame.
+        uint32_t sequence;
       };
 
       int m_fd;
       struct v4l2_format* m_fmt;
-      struct v4l2_buffer* m_bfr;
       struct v4l2_requestbuffers* m_bfr_req;
       struct Buffer* m_bfrs;
+      //! Buffer of the current frame of frameCapture().
+      int m_current;
     };
   }
 }
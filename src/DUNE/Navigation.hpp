@@ -39,7 +39,14 @@ namespace DUNE
 #include <DUNE/Navigation/BasicNavigation.hpp>
 #include <DUNE/Navigation/BeamFilter.hpp>
 #include <DUNE/Navigation/CompassCalibration.hpp>
+#include <DUNE/Navigation/InertialIntegrator.hpp>
+#include <DUNE/Navigation/InertialOutput.hpp>
+#include <DUNE/Navigation/InertialStream.hpp>
 #include <DUNE/Navigation/KalmanFilter.hpp>
+#include <DUNE/Navigation/MultiBeamFilter.hpp>
 #include <DUNE/Navigation/Ranging.hpp>
+#include <DUNE/Navigation/Trilateration.hpp>
+#include <DUNE/Navigation/TerrainFilter.hpp>
+#include <DUNE/Navigation/VoxelGrid.hpp>
 
 #endif
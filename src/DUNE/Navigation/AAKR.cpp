@@ -26,6 +26,9 @@
 // Author: José Braga                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/Navigation/AAKR.hpp>
 
@@ -33,6 +36,33 @@ namespace DUNE
 {
   namespace Navigation
   {
+    //! Squared kernel radius, in units of the squared bandwidth, beyond
+    //! which weights (below 2e-22 of the peak) are ignored.
+    static const double c_radius = 50.0;
+    //! Minimum total weight within the radius for the truncated sum to
+    //! be trusted; below it every sample is weighed.
+    static const double c_min_weight = 1e-6;
+    //! Minimum number of rows added between k-d tree rebuilds.
+    static const unsigned c_min_pending = 32;
+
+    //! Compare data rows along one axis.
+    struct AxisLess
+    {
+      AxisLess(const Math::Matrix& data, unsigned axis):
+        m_data(data),
+        m_axis(axis)
+      { }
+
+      bool
+      operator()(unsigned a, unsigned b) const
+      {
+        return m_data(a, m_axis) < m_data(b, m_axis);
+      }
+
+      const Math::Matrix& m_data;
+      unsigned m_axis;
+    };
+
     AAKR::AAKR(void)
     {
       m_index = 0;
@@ -53,6 +83,7 @@ namespace DUNE
     {
       m_index = 0;
       m_num_values = 0;
+      resetIndex();
 
       if (r == dataSize())
         return;
@@ -68,6 +99,7 @@ namespace DUNE
     {
       m_index = 0;
       m_num_values = 0;
+      resetIndex();
 
       if (r == dataSize() && c == sampleSize())
         return;
@@ -88,16 +120,169 @@ namespace DUNE
         throw std::runtime_error("unable to add: new sample is not a row vector.");
 
       if (sampleSize() == 0)
-        m_data.resize(dataSize(), v.columns());
+      {
+        m_data.resizeAndFill(dataSize(), v.columns(), 0.0);
+        m_norm = m_data;
+      }
 
       if ((unsigned)v.columns() != sampleSize())
         throw std::runtime_error("unable to add: sample size does not match.");
 
+      if (m_indexed.size() != dataSize() || m_sum.size() != sampleSize())
+        resetIndex();
+
+      // Forget the sample being overwritten.
+      if (m_num_values == dataSize())
+      {
+        accumulate(m_index, -1.0);
+        m_indexed[m_index] = false;
+      }
+
       // Write to the data set.
       m_data.set(m_index, m_index, 0, sampleSize() - 1, v);
 
+      if (m_num_values == 0)
+      {
+        for (unsigned j = 0; j < sampleSize(); j++)
+          m_ref[j] = v(j);
+      }
+
+      accumulate(m_index, 1.0);
+      m_pending.push_back(m_index);
+
       // Increment data set index.
       increment();
+
+      // Rows waiting to be indexed are scanned linearly, so rebuild
+      // once they are a sizable fraction of the data set. A row
+      // cannot be overwritten while it is still pending.
+      unsigned limit = std::min(std::max(c_min_pending, m_num_values / 8), dataSize() / 2);
+      if (m_pending.size() > limit)
+        rebuild();
+    }
+
+    void
+    AAKR::resetIndex(void)
+    {
+      m_sum.assign(sampleSize(), 0.0);
+      m_sum2.assign(sampleSize(), 0.0);
+      m_ref.assign(sampleSize(), 0.0);
+      m_mean.assign(sampleSize(), 0.0);
+      m_scale.assign(sampleSize(), 0.0);
+      m_acc.assign(sampleSize(), 0.0);
+      m_tree.clear();
+      m_indexed.assign(dataSize(), false);
+      m_pending.clear();
+    }
+
+    void
+    AAKR::accumulate(unsigned row, double sign)
+    {
+      for (unsigned j = 0; j < sampleSize(); j++)
+      {
+        double d = m_data(row, j) - m_ref[j];
+        m_sum[j] += sign * d;
+        m_sum2[j] += sign * d * d;
+      }
+    }
+
+    void
+    AAKR::rebuild(void)
+    {
+      // Recompute the running sums to discard accumulated round-off.
+      std::fill(m_sum.begin(), m_sum.end(), 0.0);
+      std::fill(m_sum2.begin(), m_sum2.end(), 0.0);
+
+      std::vector<unsigned> rows(m_num_values);
+      for (unsigned i = 0; i < m_num_values; i++)
+      {
+        rows[i] = i;
+        accumulate(i, 1.0);
+        m_indexed[i] = true;
+      }
+
+      m_tree.clear();
+      m_tree.reserve(m_num_values);
+      build(rows.begin(), rows.end());
+      m_pending.clear();
+    }
+
+    int
+    AAKR::build(std::vector<unsigned>::iterator begin, std::vector<unsigned>::iterator end)
+    {
+      if (begin == end)
+        return -1;
+
+      // Split along the axis with the largest normalized spread.
+      unsigned axis = 0;
+      double best = -1.0;
+      for (unsigned j = 0; j < sampleSize(); j++)
+      {
+        double lo = m_data(*begin, j);
+        double hi = lo;
+        for (std::vector<unsigned>::iterator itr = begin + 1; itr != end; ++itr)
+        {
+          lo = std::min(lo, m_data(*itr, j));
+          hi = std::max(hi, m_data(*itr, j));
+        }
+
+        double spread = hi - lo;
+        if (m_num_values > 1)
+        {
+          double n = m_num_values;
+          double var = m_sum2[j] / n - (m_sum[j] / n) * (m_sum[j] / n);
+          if (var > 0)
+            spread /= std::sqrt(var);
+        }
+
+        if (spread > best)
+        {
+          best = spread;
+          axis = j;
+        }
+      }
+
+      std::vector<unsigned>::iterator median = begin + (end - begin) / 2;
+      std::nth_element(begin, median, end, AxisLess(m_data, axis));
+
+      int index = m_tree.size();
+      Node node;
+      node.row = *median;
+      node.axis = axis;
+      node.split = m_data(*median, axis);
+      m_tree.push_back(node);
+
+      int left = build(begin, median);
+      int right = build(median + 1, end);
+      m_tree[index].left = left;
+      m_tree[index].right = right;
+      return index;
+    }
+
+    double
+    AAKR::distance(const Math::Matrix& query, unsigned row) const
+    {
+      double d = 0;
+      for (unsigned j = 0; j < sampleSize(); j++)
+      {
+        double x = (query(j) - m_data(row, j)) * m_scale[j];
+        d += x * x;
+      }
+
+      return d;
+    }
+
+    void
+    AAKR::visit(unsigned row, const Math::Matrix& query, double radius, double svar)
+    {
+      double d = distance(query, row);
+      if (d > radius)
+        return;
+
+      double w = std::exp(- d / svar);
+      m_acc_weight += w;
+      for (unsigned j = 0; j < sampleSize(); j++)
+        m_acc[j] += w * m_data(row, j);
     }
 
     void
@@ -171,6 +356,73 @@ namespace DUNE
     Math::Matrix
     AAKR::estimate(Math::Matrix query, double variance)
     {
+      if (query.rows() != 1)
+        throw std::runtime_error("unable to compute distance: reference is not row vector.");
+
+      if ((unsigned)query.columns() != sampleSize())
+        throw std::runtime_error("unable to compute distance: sample size does not match.");
+
+      if (m_num_values == 0)
+        return query;
+
+      // Current normalization.
+      double n = m_num_values;
+      for (unsigned j = 0; j < sampleSize(); j++)
+      {
+        double mean = m_sum[j] / n;
+        double var = m_sum2[j] / n - mean * mean;
+        m_mean[j] = m_ref[j] + mean;
+        m_scale[j] = (var > 0) ? 1.0 / std::sqrt(var) : 0.0;
+
+        // A constant feature only matches itself.
+        if (m_scale[j] == 0 && query(j) != m_mean[j])
+          return query;
+      }
+
+      double svar = variance * variance;
+      double radius = c_radius * svar;
+      std::fill(m_acc.begin(), m_acc.end(), 0.0);
+      m_acc_weight = 0;
+
+      // Search the k-d tree.
+      m_stack.clear();
+      if (!m_tree.empty())
+        m_stack.push_back(0);
+
+      while (!m_stack.empty())
+      {
+        const Node& node = m_tree[m_stack.back()];
+        m_stack.pop_back();
+
+        if (m_indexed[node.row])
+          visit(node.row, query, radius, svar);
+
+        double diff = (query(node.axis) - node.split) * m_scale[node.axis];
+        int near = (diff < 0) ? node.left : node.right;
+        int far = (diff < 0) ? node.right : node.left;
+
+        if (far >= 0 && diff * diff <= radius)
+          m_stack.push_back(far);
+
+        if (near >= 0)
+          m_stack.push_back(near);
+      }
+
+      // Rows not yet in the tree.
+      for (unsigned i = 0; i < m_pending.size(); i++)
+        visit(m_pending[i], query, radius, svar);
+
+      if (m_acc_weight > c_min_weight)
+      {
+        Math::Matrix result(1, sampleSize());
+        for (unsigned j = 0; j < sampleSize(); j++)
+          result(j) = m_acc[j] / m_acc_weight;
+
+        return result;
+      }
+
+      // Little or nothing within the kernel radius: weigh the whole
+      // data set.
       Math::Matrix mean;
       Math::Matrix std;
 
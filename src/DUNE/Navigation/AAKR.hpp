@@ -48,6 +48,11 @@ namespace DUNE
     //! This class implements Autoassociative Kernel
     //! Regression (AAKR) algorithm.
     //!
+    //! Samples are kept in a k-d tree, updated as they are added, and
+    //! estimates only visit samples within the effective radius of
+    //! the kernel. Normalization statistics are maintained
+    //! incrementally.
+    //!
     //! @author José Braga
     class AAKR
     {
@@ -101,6 +106,56 @@ namespace DUNE
       estimate(Math::Matrix query, double variance);
 
     private:
+      //! Node of the k-d tree.
+      struct Node
+      {
+        //! Data row.
+        unsigned row;
+        //! Split axis.
+        unsigned axis;
+        //! Split value.
+        double split;
+        //! Children (negative if absent).
+        int left;
+        int right;
+      };
+
+      //! Reset running statistics and the k-d tree.
+      void
+      resetIndex(void);
+
+      //! Update running statistics with a data row.
+      //! @param[in] row data row.
+      //! @param[in] sign 1 to add the row, -1 to remove it.
+      void
+      accumulate(unsigned row, double sign);
+
+      //! Rebuild the k-d tree over all current samples.
+      void
+      rebuild(void);
+
+      //! Build a balanced subtree.
+      //! @param[in] begin first row of the subtree.
+      //! @param[in] end one past the last row of the subtree.
+      //! @return node index.
+      int
+      build(std::vector<unsigned>::iterator begin, std::vector<unsigned>::iterator end);
+
+      //! Add a sample's kernel contribution to the estimate.
+      //! @param[in] row data row.
+      //! @param[in] query query vector.
+      //! @param[in] radius squared search radius.
+      //! @param[in] svar squared kernel bandwidth.
+      void
+      visit(unsigned row, const Math::Matrix& query, double radius, double svar);
+
+      //! Squared normalized distance between a query and a data row.
+      //! @param[in] query query vector.
+      //! @param[in] row data row.
+      //! @return squared distance.
+      double
+      distance(const Math::Matrix& query, unsigned row) const;
+
       //! Increment current data index.
       void
       increment(void);
@@ -127,6 +182,25 @@ namespace DUNE
       Math::Matrix m_distances;
       //! Weights set.
       Math::Matrix m_weights;
+      //! Running sums of (sample - reference) and its square.
+      std::vector<double> m_sum;
+      std::vector<double> m_sum2;
+      //! Reference sample for the running sums.
+      std::vector<double> m_ref;
+      //! Current mean and inverse standard deviation.
+      std::vector<double> m_mean;
+      std::vector<double> m_scale;
+      //! K-d tree nodes.
+      std::vector<Node> m_tree;
+      //! True if a row is reachable through the k-d tree.
+      std::vector<bool> m_indexed;
+      //! Rows added since the last rebuild.
+      std::vector<unsigned> m_pending;
+      //! Search stack.
+      std::vector<int> m_stack;
+      //! Estimate accumulators.
+      std::vector<double> m_acc;
+      double m_acc_weight;
     };
   }
 }
@@ -26,6 +26,10 @@
 // Author: Pedro Calado (Altitude filter)                                   *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <vector>
+
 // Local headers.
 #include <DUNE/Navigation/BasicNavigation.hpp>
 
@@ -35,6 +39,9 @@ namespace DUNE
   {
     using Tasks::DF_KEEP_TIME;
 
+    //! Maximum number of seabed points kept between terrain fixes.
+    static const unsigned c_terrain_max_beams = 64;
+
     static std::string
     getUncertaintyMessage(double hpos_var)
     {
@@ -45,10 +52,12 @@ namespace DUNE
 
     BasicNavigation::BasicNavigation(const std::string& name, Tasks::Context& ctx):
       Tasks::Periodic(name, ctx),
+      m_imu_stream(NULL),
       m_active(false),
       m_origin(NULL),
       m_avg_heave(NULL),
-      m_avg_gps(NULL)
+      m_avg_gps(NULL),
+      m_terrain(NULL)
     {
       // Declare configuration parameters.
       param("Maximum Distance to Reference", m_max_dis2ref)
@@ -210,11 +219,68 @@ namespace DUNE
       .defaultValue("1.0")
       .description("Exponential moving average filter gain used in altitude");
 
+      param("Profiling Report Period", m_profile_period)
+      .defaultValue("0.0")
+      .minimumValue("0.0")
+      .units(Units::Second)
+      .description("Period between reports of the time spent in each navigation"
+                   " stage. Set to zero to disable profiling");
+
+      param("Delayed Measurement Window", m_history_window)
+      .defaultValue("0.0")
+      .minimumValue("0.0")
+      .units(Units::Second)
+      .description("Maximum age of GPS fixes and LBL ranges that are compared"
+                   " against the past position estimate instead of the current"
+                   " one. Set to zero to disable");
+
+      param("Terrain Map", m_terrain_map)
+      .defaultValue("")
+      .description("Path of the bathymetry map used for terrain-aided"
+                   " navigation. Leave empty to disable");
+
+      param("Terrain Particles", m_terrain_particles)
+      .defaultValue("1000")
+      .minimumValue("10")
+      .description("Number of particles of the terrain-aided navigation filter");
+
+      param("Terrain Threads", m_terrain_threads)
+      .defaultValue("1")
+      .minimumValue("1")
+      .description("Number of threads weighting terrain particles");
+
+      param("Terrain Update Period", m_terrain_period)
+      .defaultValue("1.0")
+      .minimumValue("0.1")
+      .units(Units::Second)
+      .description("Period between terrain-aided position fixes");
+
+      param("Terrain Measurement Noise", m_terrain_noise)
+      .defaultValue("1.0")
+      .minimumValue("0.01")
+      .units(Units::Meter)
+      .description("Standard deviation of the seabed depth error, including"
+                   " map error");
+
+      param("Terrain Process Noise", m_terrain_process_noise)
+      .defaultValue("0.5")
+      .minimumValue("0.0")
+      .units(Units::Meter)
+      .description("Standard deviation of the dead-reckoning error between"
+                   " terrain-aided position fixes");
+
+      param("Entity Label - Terrain Beams", m_elabel_terrain)
+      .defaultValue("")
+      .description("Entity labels of the 'Distance' messages of beams hitting"
+                   " the seabed, in addition to the altimeter");
+
       // Do not use the declination offset when simulating.
       m_use_declination = !m_ctx.profiles.isSelected("Simulation");
       m_declination_defined = false;
       m_dead_reckoning = false;
       m_sum_euler_inc = false;
+      m_history_head = 0;
+      m_history_count = 0;
       m_alt_sanity = true;
       m_aligned = false;
       m_edelta_ts = 0.1;
@@ -246,7 +312,9 @@ namespace DUNE
     }
 
     BasicNavigation::~BasicNavigation(void)
-    { }
+    {
+      Memory::clear(m_imu_stream);
+    }
 
     void
     BasicNavigation::onUpdateParameters(void)
@@ -259,6 +327,16 @@ namespace DUNE
       m_time_without_depth.setTop(m_without_depth_timeout);
       m_time_without_euler.setTop(m_without_euler_timeout);
       m_dvl_sanity_timer.setTop(m_dvl_sanity_timeout);
+      m_profile_timer.setTop(m_profile_period);
+      m_terrain_timer.setTop(m_terrain_period);
+
+      for (unsigned i = 0; i < PROFILE_COUNT; ++i)
+      {
+        m_profile_start[i] = 0.0;
+        m_profile_time[i] = 0.0;
+        m_profile_max[i] = 0.0;
+        m_profile_runs[i] = 0;
+      }
 
       // Distance DVL to vehicle Center of Gravity is 0 in Simulation.
       if (m_ctx.profiles.isSelected("Simulation"))
@@ -273,6 +351,19 @@ namespace DUNE
     {
       m_avg_heave = new Math::MovingAverage<double>(m_avg_heave_samples);
       m_avg_gps = new Math::MovingAverage<double>(m_avg_gps_samples);
+
+      if (!m_terrain_map.empty())
+      {
+        try
+        {
+          m_terrain = new TerrainFilter(m_terrain_map, m_terrain_particles, m_terrain_threads);
+        }
+        catch (std::exception& e)
+        {
+          err(DTR("terrain-aided navigation disabled: %s"), e.what());
+        }
+      }
+
       reset();
     }
 
@@ -301,6 +392,9 @@ namespace DUNE
       m_agvel_eid = m_ahrs_eid;
       m_accel_eid = m_ahrs_eid;
 
+      Memory::clear(m_imu_stream);
+      m_imu_stream = new InertialStream::Reader(m_ctx.state.imu.get(m_ahrs_eid));
+
       try
       {
         m_alignment_eid = resolveEntity(m_elabel_alignment);
@@ -330,6 +424,19 @@ namespace DUNE
       {
         m_alt_eid = 0;
       }
+
+      m_terrain_eids.clear();
+      for (unsigned i = 0; i < m_elabel_terrain.size(); ++i)
+      {
+        try
+        {
+          m_terrain_eids.push_back(resolveEntity(m_elabel_terrain[i]));
+        }
+        catch (...)
+        {
+          war(DTR("unknown terrain beam entity: %s"), m_elabel_terrain[i].c_str());
+        }
+      }
     }
 
     void
@@ -338,6 +445,7 @@ namespace DUNE
       Memory::clear(m_origin);
       Memory::clear(m_avg_heave);
       Memory::clear(m_avg_gps);
+      Memory::clear(m_terrain);
     }
 
     void
@@ -346,6 +454,9 @@ namespace DUNE
       if (msg->getSourceEntity() != m_accel_eid)
         return;
 
+      if (readInertialStream())
+        return;
+
       m_accel_bfr[AXIS_X] += msg->x;
       m_accel_bfr[AXIS_Y] += msg->y;
       m_accel_bfr[AXIS_Z] += msg->z;
@@ -358,12 +469,43 @@ namespace DUNE
       if (msg->getSourceEntity() != m_agvel_eid)
         return;
 
+      if (readInertialStream())
+        return;
+
       m_agvel_bfr[AXIS_X] += msg->x;
       m_agvel_bfr[AXIS_Y] += msg->y;
       m_agvel_bfr[AXIS_Z] += msg->z;
       ++m_angular_readings;
     }
 
+    bool
+    BasicNavigation::readInertialStream(void)
+    {
+      // Drivers that feed the inertial stream dispatch decimated
+      // messages, so the full-rate samples are used instead.
+      if (m_imu_stream == NULL || m_imu_stream->getStream().getCount() == 0)
+        return false;
+
+      InertialSample samples[32];
+      unsigned n = 0;
+      while ((n = m_imu_stream->read(samples, 32)) > 0)
+      {
+        for (unsigned i = 0; i < n; ++i)
+        {
+          for (unsigned j = 0; j < 3; ++j)
+          {
+            m_agvel_bfr[j] += samples[i].angvel[j];
+            m_accel_bfr[j] += samples[i].accel[j];
+          }
+        }
+
+        m_angular_readings += n;
+        m_accel_readings += n;
+      }
+
+      return true;
+    }
+
     void
     BasicNavigation::consume(const IMC::Depth* msg)
     {
@@ -407,10 +549,13 @@ namespace DUNE
     void
     BasicNavigation::consume(const IMC::Distance* msg)
     {
-      if (msg->getSourceEntity() != m_alt_eid)
+      if (msg->validity == IMC::Distance::DV_INVALID)
         return;
 
-      if (msg->validity == IMC::Distance::DV_INVALID)
+      if (m_terrain != NULL)
+        addTerrainBeam(msg);
+
+      if (msg->getSourceEntity() != m_alt_eid)
         return;
 
       // Reset altitude timer.
@@ -577,13 +722,26 @@ namespace DUNE
         // Set position estimate at the origin.
         m_kal.setState(STATE_X, 0);
         m_kal.setState(STATE_Y, 0);
+        clearHistory();
 
         spew("defined new navigation reference");
         return;
       }
 
+      // Bring a delayed fix to the current time.
+      double sx = 0.0;
+      double sy = 0.0;
+      getDelayedShift(msg->getTimeStamp(), &sx, &sy);
+
+      double px = m_kal.getState(STATE_X);
+      double py = m_kal.getState(STATE_Y);
+
       // Call GPS EKF functions to assign output values.
-      runKalmanGPS(x, y);
+      profileBegin(PROFILE_GPS);
+      runKalmanGPS(x + sx, y + sy);
+      profileEnd(PROFILE_GPS);
+
+      correctHistory(m_kal.getState(STATE_X) - px, m_kal.getState(STATE_Y) - py);
     }
 
     void
@@ -705,13 +863,25 @@ namespace DUNE
 
       m_ranging.getLocation(beacon, &x, &y, &z);
 
+      // Position estimate when the range was measured.
+      double sx = 0.0;
+      double sy = 0.0;
+      getDelayedShift(msg->getTimeStamp(), &sx, &sy);
+
+      double px = m_kal.getState(STATE_X);
+      double py = m_kal.getState(STATE_Y);
+
       // Compute expected range.
-      double dx = m_kal.getState(STATE_X) + m_dist_lbl_gps * std::cos(getEuler(AXIS_Z)) - x;
-      double dy = m_kal.getState(STATE_Y) + m_dist_lbl_gps * std::sin(getEuler(AXIS_Z)) - y;
+      double dx = px - sx + m_dist_lbl_gps * std::cos(getEuler(AXIS_Z)) - x;
+      double dy = py - sy + m_dist_lbl_gps * std::sin(getEuler(AXIS_Z)) - y;
       double dz = getDepth() - z;
       double exp_range = std::sqrt(dx * dx + dy * dy + dz * dz);
 
+      profileBegin(PROFILE_LBL);
       runKalmanLBL((int)beacon, range, dx, dy, exp_range);
+      profileEnd(PROFILE_LBL);
+
+      correctHistory(m_kal.getState(STATE_X) - px, m_kal.getState(STATE_Y) - py);
     }
 
     void
@@ -823,6 +993,9 @@ namespace DUNE
       m_valid_gv = false;
       m_valid_wv = false;
 
+      clearHistory();
+      m_terrain_beams.clear();
+      m_terrain_init = false;
       resetBuffers();
     }
 
@@ -874,17 +1047,17 @@ namespace DUNE
     {
       // "Outlier Rejection for Autonomous Acoustic Navigation"
       // Jerome Vaganay, John J. Leonard and James G. Bellingham. MIT
-      Math::Matrix H(1, 2, 0.0);
-      H(0, 0) = dx / exp_range;
-      H(0, 1) = dy / exp_range;
-      Math::Matrix P(2, 2, 0.0);
-      P = m_kal.getCovariance(STATE_X, STATE_Y, STATE_X, STATE_Y);
+      double hx = dx / exp_range;
+      double hy = dy / exp_range;
+      double hph = hx * hx * m_kal.getCovariance(STATE_X, STATE_X)
+      + 2.0 * hx * hy * m_kal.getCovariance(STATE_X, STATE_Y)
+      + hy * hy * m_kal.getCovariance(STATE_Y, STATE_Y);
 
       double k = getLblRejectionValue(exp_range);
-      double R = std::max(k, (H * P * transpose (H))(0));
+      double R = std::max(k, hph);
 
       double d = range - exp_range;
-      m_navdata.lbl_rej_level = (d * (1 / ((H * P * transpose (H))(0) + R)) * d);
+      m_navdata.lbl_rej_level = (d * (1 / (hph + R)) * d);
 
       // Is rejection level above maximum threshold?
       if (m_navdata.lbl_rej_level >= m_lbl_threshold)
@@ -997,6 +1170,50 @@ namespace DUNE
       return false;
     }
 
+    bool
+    BasicNavigation::getDelayedShift(double tstamp, double* dx, double* dy) const
+    {
+      *dx = 0.0;
+      *dy = 0.0;
+
+      if (m_history_window <= 0 || m_history_count == 0)
+        return false;
+
+      unsigned last = (m_history_head + c_history_size - 1) % c_history_size;
+      const HistoryEntry& newest = m_history[last];
+      double age = newest.tstamp - tstamp;
+      if (age <= 0 || age > m_history_window)
+        return false;
+
+      // Walk back to the entries around the measurement time.
+      for (unsigned i = 1; i < m_history_count; ++i)
+      {
+        const HistoryEntry& next = m_history[(last + c_history_size - i + 1) % c_history_size];
+        const HistoryEntry& prev = m_history[(last + c_history_size - i) % c_history_size];
+        if (prev.tstamp > tstamp)
+          continue;
+
+        double span = next.tstamp - prev.tstamp;
+        double t = (span > 0) ? (tstamp - prev.tstamp) / span : 0.0;
+        *dx = m_kal.getState(STATE_X) - (prev.x + t * (next.x - prev.x));
+        *dy = m_kal.getState(STATE_Y) - (prev.y + t * (next.y - prev.y));
+        return true;
+      }
+
+      return false;
+    }
+
+    void
+    BasicNavigation::correctHistory(double dx, double dy)
+    {
+      for (unsigned i = 0; i < m_history_count; ++i)
+      {
+        HistoryEntry& entry = m_history[(m_history_head + c_history_size - 1 - i) % c_history_size];
+        entry.x += dx;
+        entry.y += dy;
+      }
+    }
+
     void
     BasicNavigation::reportToBus(void)
     {
@@ -1006,10 +1223,222 @@ namespace DUNE
       m_navdata.setTimeStamp(tstamp);
       m_ewvel.setTimeStamp(tstamp);
 
+      if (m_history_window > 0)
+      {
+        HistoryEntry& entry = m_history[m_history_head];
+        entry.tstamp = tstamp;
+        entry.x = m_kal.getState(STATE_X);
+        entry.y = m_kal.getState(STATE_Y);
+        m_history_head = (m_history_head + 1) % c_history_size;
+        m_history_count = std::min(m_history_count + 1, c_history_size);
+      }
+
+      if (m_terrain != NULL && m_terrain_timer.overflow())
+      {
+        profileBegin(PROFILE_TERRAIN);
+        runTerrainAiding();
+        profileEnd(PROFILE_TERRAIN);
+      }
+
+      profileBegin(PROFILE_DISPATCH);
       dispatch(m_estate, DF_KEEP_TIME);
       dispatch(m_uncertainty, DF_KEEP_TIME);
       dispatch(m_navdata, DF_KEEP_TIME);
       dispatch(m_ewvel, DF_KEEP_TIME);
+      profileEnd(PROFILE_DISPATCH);
+
+      if (m_profile_period > 0 && m_profile_timer.overflow())
+        reportProfile();
+    }
+
+    void
+    BasicNavigation::addTerrainBeam(const IMC::Distance* msg)
+    {
+      unsigned eid = msg->getSourceEntity();
+      if (eid != m_alt_eid
+          && std::find(m_terrain_eids.begin(), m_terrain_eids.end(), eid) == m_terrain_eids.end())
+        return;
+
+      // Beam axis in the vehicle frame, pointing down by default.
+      double bx = 0.0;
+      double by = 0.0;
+      double bz = msg->value;
+
+      if (msg->location.size() > 0)
+      {
+        const IMC::DeviceState* dev = *msg->location.begin();
+        Coordinates::BodyFixedFrame::toInertialFrame(dev->phi, dev->theta, dev->psi,
+                                                     0.0, 0.0, (double)msg->value,
+                                                     &bx, &by, &bz);
+        bx += dev->x;
+        by += dev->y;
+        bz += dev->z;
+      }
+
+      TerrainFilter::Beam beam;
+      Coordinates::BodyFixedFrame::toInertialFrame(getEuler(AXIS_X), getEuler(AXIS_Y), (double)m_estate.psi,
+                                                   bx, by, bz,
+                                                   &beam.x, &beam.y, &beam.z);
+
+      if (m_terrain_beams.size() >= c_terrain_max_beams)
+        m_terrain_beams.erase(m_terrain_beams.begin());
+
+      m_terrain_beams.push_back(beam);
+    }
+
+    void
+    BasicNavigation::runTerrainAiding(void)
+    {
+      m_terrain_timer.reset();
+
+      if (m_origin == NULL)
+        return;
+
+      // Navigation origin in the map frame.
+      const Simulation::GriddedField::Layout& map = m_terrain->getLayout();
+      double ox = 0.0;
+      double oy = 0.0;
+      double oz = 0.0;
+      Coordinates::WGS84::displacement(map.lat, map.lon, 0.0,
+                                       m_origin->lat, m_origin->lon, m_origin->height,
+                                       &ox, &oy, &oz);
+
+      double x = m_kal.getState(STATE_X) + ox;
+      double y = m_kal.getState(STATE_Y) + oy;
+
+      // Particles follow the navigation estimate while GPS is
+      // available.
+      if (!m_terrain_init || !m_time_without_gps.overflow())
+      {
+        double var = std::max(m_kal.getCovariance(STATE_X, STATE_X),
+                              m_kal.getCovariance(STATE_Y, STATE_Y));
+        m_terrain->initialize(x, y, std::sqrt(var) + m_terrain_noise);
+        m_terrain_beams.clear();
+        m_terrain_init = true;
+        m_terrain_x = x;
+        m_terrain_y = y;
+        return;
+      }
+
+      m_terrain->predict(x - m_terrain_x, y - m_terrain_y, m_terrain_process_noise);
+      m_terrain_x = x;
+      m_terrain_y = y;
+
+      if (m_terrain_beams.empty())
+        return;
+
+      bool updated = m_terrain->update(&m_terrain_beams[0], m_terrain_beams.size(),
+                                       getDepth(), m_terrain_noise);
+      m_terrain_beams.clear();
+
+      if (!updated)
+        return;
+
+      double tx = 0.0;
+      double ty = 0.0;
+      double var_x = 0.0;
+      double var_y = 0.0;
+      m_terrain->getEstimate(tx, ty, var_x, var_y);
+
+      double px = m_kal.getState(STATE_X);
+      double py = m_kal.getState(STATE_Y);
+      applyPositionFix(tx - ox, ty - oy, var_x, var_y);
+
+      double dx = m_kal.getState(STATE_X) - px;
+      double dy = m_kal.getState(STATE_Y) - py;
+      m_terrain_x += dx;
+      m_terrain_y += dy;
+      correctHistory(dx, dy);
+
+      spew("terrain fix: %0.2f %0.2f (%0.2f %0.2f m), %0.0f effective particles",
+           tx - ox, ty - oy, std::sqrt(var_x), std::sqrt(var_y),
+           m_terrain->getEffectiveSize());
+    }
+
+    void
+    BasicNavigation::applyPositionFix(double x, double y, double var_x, double var_y)
+    {
+      unsigned n = m_kal.getState().rows();
+      std::vector<double> gain(n);
+      std::vector<double> row(n);
+
+      const unsigned axes[2] = {STATE_X, STATE_Y};
+      const double values[2] = {x, y};
+      const double vars[2] = {var_x, var_y};
+
+      for (unsigned a = 0; a < 2; ++a)
+      {
+        unsigned s = axes[a];
+        double innov = values[a] - m_kal.getState(s);
+        double cov = m_kal.getCovariance(s, s) + vars[a];
+
+        if (!(cov > 0.0))
+          continue;
+
+        for (unsigned i = 0; i < n; ++i)
+        {
+          gain[i] = m_kal.getCovariance(i, s) / cov;
+          row[i] = m_kal.getCovariance(s, i);
+        }
+
+        for (unsigned i = 0; i < n; ++i)
+        {
+          m_kal.setState(i, m_kal.getState(i) + gain[i] * innov);
+
+          for (unsigned j = 0; j < n; ++j)
+            m_kal.setCovariance(i, j, m_kal.getCovariance(i, j) - gain[i] * row[j]);
+        }
+      }
+    }
+
+    void
+    BasicNavigation::profileBegin(ProfileStage stage)
+    {
+      if (m_profile_period <= 0)
+        return;
+
+      m_profile_start[stage] = Time::Clock::get();
+    }
+
+    void
+    BasicNavigation::profileEnd(ProfileStage stage)
+    {
+      if (m_profile_period <= 0)
+        return;
+
+      double elapsed = Time::Clock::get() - m_profile_start[stage];
+      m_profile_time[stage] += elapsed;
+      m_profile_max[stage] = std::max(m_profile_max[stage], elapsed);
+      ++m_profile_runs[stage];
+    }
+
+    void
+    BasicNavigation::reportProfile(void)
+    {
+      static const char* c_names[PROFILE_COUNT] =
+      {
+        "predict", "lbl", "dvl", "gps", "terrain", "dispatch"
+      };
+
+      std::string report;
+
+      for (unsigned i = 0; i < PROFILE_COUNT; ++i)
+      {
+        double mean = 0.0;
+        if (m_profile_runs[i] > 0)
+          mean = m_profile_time[i] / m_profile_runs[i];
+
+        report += Utils::String::str(" %s: %u x %.1f us (max %.1f us)",
+                                     c_names[i], m_profile_runs[i],
+                                     mean * 1e6, m_profile_max[i] * 1e6);
+
+        m_profile_time[i] = 0.0;
+        m_profile_max[i] = 0.0;
+        m_profile_runs[i] = 0;
+      }
+
+      inf("stage timing over %.0f s:%s", m_profile_period, report.c_str());
+      m_profile_timer.reset();
     }
 
     void
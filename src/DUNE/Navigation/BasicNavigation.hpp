@@ -40,8 +40,10 @@
 #include <DUNE/Math/Angles.hpp>
 #include <DUNE/Math/Derivative.hpp>
 #include <DUNE/Math/MovingAverage.hpp>
+#include <DUNE/Navigation/InertialStream.hpp>
 #include <DUNE/Navigation/KalmanFilter.hpp>
 #include <DUNE/Navigation/Ranging.hpp>
+#include <DUNE/Navigation/TerrainFilter.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Counter.hpp>
 #include <DUNE/Time/Delta.hpp>
@@ -60,6 +62,8 @@ namespace DUNE
     static const float c_wma_filter = 0.1f;
     //! Maximum artificial angular velocity value.
     static const float c_max_av = 0.5f;
+    //! Number of past position estimates kept for delayed measurements.
+    static const unsigned c_history_size = 256;
 
     //! Navigation task states.
     enum SMStates
@@ -470,11 +474,85 @@ namespace DUNE
       void
       reportToBus(void);
 
+      //! Navigation step stages with timing statistics.
+      enum ProfileStage
+      {
+        //! Filter prediction.
+        PROFILE_PREDICT,
+        //! LBL range processing.
+        PROFILE_LBL,
+        //! DVL measurement processing.
+        PROFILE_DVL,
+        //! GPS fix processing.
+        PROFILE_GPS,
+        //! Terrain-aided position fix.
+        PROFILE_TERRAIN,
+        //! Navigation messages dispatch.
+        PROFILE_DISPATCH,
+        //! Number of stages.
+        PROFILE_COUNT
+      };
+
+      //! Mark the beginning of a profiled stage.
+      //! @param[in] stage navigation step stage.
+      void
+      profileBegin(ProfileStage stage);
+
+      //! Mark the end of a profiled stage and accumulate its duration.
+      //! @param[in] stage navigation step stage.
+      void
+      profileEnd(ProfileStage stage);
+
       //! Routine to update sensor buffers.
       //! @param[in] filter sensor filters gain.
       void
       updateBuffers(float filter);
 
+      //! Compute how much the position estimate moved since a past
+      //! instant, using the history of dispatched estimates. Adding
+      //! this displacement to a delayed position measurement brings
+      //! it to the current time.
+      //! @param[in] tstamp measurement time (s since the UNIX Epoch).
+      //! @param[out] dx North displacement (m).
+      //! @param[out] dy East displacement (m).
+      //! @return true if the history covers the given instant.
+      bool
+      getDelayedShift(double tstamp, double* dx, double* dy) const;
+
+      //! Apply a correction of the position estimate to its history,
+      //! so that later shifts only account for motion.
+      //! @param[in] dx North correction (m).
+      //! @param[in] dy East correction (m).
+      void
+      correctHistory(double dx, double dy);
+
+      //! Discard the history of position estimates.
+      void
+      clearHistory(void)
+      {
+        m_history_count = 0;
+      }
+
+      //! Store the seabed point hit by a range measurement for the
+      //! next terrain-aided fix.
+      //! @param[in] msg range measurement.
+      void
+      addTerrainBeam(const IMC::Distance* msg);
+
+      //! Run the terrain-aided navigation filter and correct the
+      //! position estimate with its fix.
+      void
+      runTerrainAiding(void);
+
+      //! Correct the position estimate with an absolute position fix,
+      //! one coordinate at a time.
+      //! @param[in] x North position (m).
+      //! @param[in] y East position (m).
+      //! @param[in] var_x North variance (m^2).
+      //! @param[in] var_y East variance (m^2).
+      void
+      applyPositionFix(double x, double y, double var_x, double var_y);
+
       //! Routine to reset acceleration buffers.
       void
       resetAcceleration(void);
@@ -564,6 +642,8 @@ namespace DUNE
       unsigned m_agvel_eid;
       //! Accelaration message entity id.
       unsigned m_accel_eid;
+      //! Reader of the AHRS inertial stream.
+      InertialStream::Reader* m_imu_stream;
       //! IMU entity id.
       unsigned m_imu_eid;
       //! Orientation alignment entity id.
@@ -591,11 +671,22 @@ namespace DUNE
       void
       resetBuffers(void);
 
+      //! Add the pending samples of the AHRS inertial stream to the
+      //! angular velocity and acceleration buffers.
+      //! @return true if the AHRS feeds the inertial stream, false
+      //! if it only dispatches messages.
+      bool
+      readInertialStream(void);
+
       //! Routine to start navigation
       //! @param[in] msg GpsFix IMC message
       void
       startNavigation(const IMC::GpsFix* msg);
 
+      //! Report and reset the timing statistics of each stage.
+      void
+      reportProfile(void);
+
       //! Routine to correct LBL positions. This method must be invoked whenever
       //! a new navigation reference is created to correct transducers positions.
       void
@@ -717,6 +808,63 @@ namespace DUNE
       //! Euler Angles offset.
       double m_phi_offset;
       double m_theta_offset;
+      //! Stage timing report period (zero to disable).
+      double m_profile_period;
+      //! Stage timing report timer.
+      Time::Counter<double> m_profile_timer;
+      //! Start time of each stage.
+      double m_profile_start[PROFILE_COUNT];
+      //! Accumulated duration of each stage.
+      double m_profile_time[PROFILE_COUNT];
+      //! Worst duration of each stage.
+      double m_profile_max[PROFILE_COUNT];
+      //! Number of runs of each stage.
+      unsigned m_profile_runs[PROFILE_COUNT];
+      //! Past position estimate.
+      struct HistoryEntry
+      {
+        //! Time of the estimate (s since the UNIX Epoch).
+        double tstamp;
+        //! North position (m).
+        double x;
+        //! East position (m).
+        double y;
+      };
+      //! History of position estimates (circular buffer).
+      HistoryEntry m_history[c_history_size];
+      //! Index of the next history entry.
+      unsigned m_history_head;
+      //! Number of valid history entries.
+      unsigned m_history_count;
+      //! Maximum age of delayed measurements to compensate (s).
+      double m_history_window;
+      //! Path of the bathymetry map for terrain-aided navigation.
+      std::string m_terrain_map;
+      //! Number of terrain particles.
+      unsigned m_terrain_particles;
+      //! Number of threads weighting terrain particles.
+      unsigned m_terrain_threads;
+      //! Period of terrain-aided fixes (s).
+      double m_terrain_period;
+      //! Seabed depth error, including map error (m).
+      double m_terrain_noise;
+      //! Dead-reckoning error per terrain fix (m).
+      double m_terrain_process_noise;
+      //! Entity labels of the range measurements hitting the seabed.
+      std::vector<std::string> m_elabel_terrain;
+      //! Entity ids of the range measurements hitting the seabed.
+      std::vector<unsigned> m_terrain_eids;
+      //! Terrain-aided navigation filter.
+      TerrainFilter* m_terrain;
+      //! Seabed points gathered since the last terrain fix.
+      std::vector<TerrainFilter::Beam> m_terrain_beams;
+      //! Terrain particles follow the navigation estimate.
+      bool m_terrain_init;
+      //! Position of the last terrain fix in the map frame (m).
+      double m_terrain_x;
+      double m_terrain_y;
+      //! Terrain fix timer.
+      Time::Counter<double> m_terrain_timer;
     };
   }
 }
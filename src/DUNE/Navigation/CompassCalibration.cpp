@@ -0,0 +1,377 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Navigation/CompassCalibration.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Initial variance of the quadric parameters.
+    static const double c_initial_variance = 1e3;
+    //! Number of samples between convergence checks.
+    static const unsigned c_window = 50;
+    //! Maximum number of Jacobi sweeps.
+    static const unsigned c_max_sweeps = 32;
+
+    //! Compute the square root of a symmetric positive definite 3x3
+    //! matrix by Jacobi eigenvalue decomposition.
+    //! @param[in] a row-major matrix.
+    //! @param[out] r row-major square root.
+    static void
+    sqrtSymmetric(const double* a, double* r)
+    {
+      double d[9];
+      double v[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+
+      for (unsigned i = 0; i < 9; ++i)
+        d[i] = a[i];
+
+      for (unsigned sweep = 0; sweep < c_max_sweeps; ++sweep)
+      {
+        double off = d[1] * d[1] + d[2] * d[2] + d[5] * d[5];
+        double diag = d[0] * d[0] + d[4] * d[4] + d[8] * d[8];
+
+        if (off <= diag * 1e-24)
+          break;
+
+        for (unsigned p = 0; p < 2; ++p)
+        {
+          for (unsigned q = p + 1; q < 3; ++q)
+          {
+            double apq = d[p * 3 + q];
+
+            if (apq == 0.0)
+              continue;
+
+            double theta = (d[q * 3 + q] - d[p * 3 + p]) / (2.0 * apq);
+            double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+            double c = 1.0 / std::sqrt(t * t + 1.0);
+            double s = t * c;
+
+            // Rotate columns p and q.
+            for (unsigned k = 0; k < 3; ++k)
+            {
+              double dkp = d[k * 3 + p];
+              double dkq = d[k * 3 + q];
+              d[k * 3 + p] = c * dkp - s * dkq;
+              d[k * 3 + q] = s * dkp + c * dkq;
+            }
+
+            // Rotate rows p and q.
+            for (unsigned k = 0; k < 3; ++k)
+            {
+              double dpk = d[p * 3 + k];
+              double dqk = d[q * 3 + k];
+              d[p * 3 + k] = c * dpk - s * dqk;
+              d[q * 3 + k] = s * dpk + c * dqk;
+            }
+
+            // Accumulate eigenvectors.
+            for (unsigned k = 0; k < 3; ++k)
+            {
+              double vkp = v[k * 3 + p];
+              double vkq = v[k * 3 + q];
+              v[k * 3 + p] = c * vkp - s * vkq;
+              v[k * 3 + q] = s * vkp + c * vkq;
+            }
+          }
+        }
+      }
+
+      double e[3];
+      for (unsigned i = 0; i < 3; ++i)
+        e[i] = std::sqrt(std::max(d[i * 3 + i], 0.0));
+
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        for (unsigned j = 0; j < 3; ++j)
+        {
+          r[i * 3 + j] = 0.0;
+          for (unsigned k = 0; k < 3; ++k)
+            r[i * 3 + j] += v[i * 3 + k] * e[k] * v[j * 3 + k];
+        }
+      }
+    }
+
+    CompassCalibration::CompassCalibration(void):
+      m_tolerance(0.01),
+      m_min_samples(200)
+    {
+      clear();
+    }
+
+    void
+    CompassCalibration::clear(void)
+    {
+      m_dcm.resizeAndFill(3, 1, 0.0);
+      m_max.resizeAndFill(1, 3, -std::numeric_limits<double>::max());
+      m_min.resizeAndFill(1, 3, std::numeric_limits<double>::max());
+
+      for (unsigned i = 0; i < c_params; ++i)
+      {
+        m_theta[i] = 0.0;
+        for (unsigned j = 0; j < c_params; ++j)
+          m_cov[i * c_params + j] = (i == j) ? c_initial_variance : 0.0;
+      }
+
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m_center[i] = 0.0;
+        m_ref[i] = 0.0;
+      }
+
+      for (unsigned i = 0; i < 9; ++i)
+        m_shape[i] = (i % 4 == 0) ? 1.0 : 0.0;
+
+      m_scale = 0.0;
+      m_valid = false;
+      m_samples = 0;
+      m_change = 1.0;
+    }
+
+    void
+    CompassCalibration::setConvergence(double tolerance, unsigned min_samples)
+    {
+      m_tolerance = tolerance;
+      m_min_samples = min_samples;
+    }
+
+    void
+    CompassCalibration::updateField(const IMC::MagneticField& msg)
+    {
+      // Insert magnetic field into row matrix.
+      Math::Matrix mf(1,3);
+      mf(0) = msg.x;
+      mf(1) = msg.y;
+      mf(2) = msg.z;
+
+      // Get stabilized magnetic field.
+      Math::Matrix mf_stab = mf * transpose(m_dcm.toDCM());
+
+      // Store maximum and minimum values.
+      for (unsigned i = 0; i < 3; i++)
+      {
+        if (mf_stab(i) > m_max(i))
+          m_max(i) = mf_stab(i);
+        if (mf_stab(i) < m_min(i))
+          m_min(i) = mf_stab(i);
+      }
+
+      // Samples are normalized by the magnitude of the first one.
+      if (m_scale <= 0.0)
+      {
+        m_scale = std::sqrt(msg.x * msg.x + msg.y * msg.y + msg.z * msg.z);
+        if (m_scale <= 0.0)
+          return;
+      }
+
+      double x = msg.x / m_scale;
+      double y = msg.y / m_scale;
+      double z = msg.z / m_scale;
+
+      // Quadric: a x^2 + b y^2 + c z^2 + 2 d xy + 2 e xz + 2 f yz
+      //          + 2 g x + 2 h y + 2 i z = 1.
+      double phi[c_params] = {x * x, y * y, z * z,
+                              2.0 * x * y, 2.0 * x * z, 2.0 * y * z,
+                              2.0 * x, 2.0 * y, 2.0 * z};
+
+      // Recursive least squares update.
+      double pphi[c_params];
+      double denom = 1.0;
+      double err = 1.0;
+
+      for (unsigned i = 0; i < c_params; ++i)
+      {
+        pphi[i] = 0.0;
+        for (unsigned j = 0; j < c_params; ++j)
+          pphi[i] += m_cov[i * c_params + j] * phi[j];
+
+        denom += phi[i] * pphi[i];
+        err -= phi[i] * m_theta[i];
+      }
+
+      for (unsigned i = 0; i < c_params; ++i)
+        m_theta[i] += pphi[i] * err / denom;
+
+      for (unsigned i = 0; i < c_params; ++i)
+      {
+        for (unsigned j = i; j < c_params; ++j)
+        {
+          double v = m_cov[i * c_params + j] - pphi[i] * pphi[j] / denom;
+          m_cov[i * c_params + j] = v;
+          m_cov[j * c_params + i] = v;
+        }
+      }
+
+      ++m_samples;
+      updateEllipsoid();
+
+      if (m_samples % c_window != 0)
+        return;
+
+      if (m_valid)
+      {
+        double dist = 0.0;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+          dist += (m_center[i] - m_ref[i]) * (m_center[i] - m_ref[i]);
+          m_ref[i] = m_center[i];
+        }
+
+        m_change = std::sqrt(dist) * m_scale / getFieldStrength();
+      }
+      else
+      {
+        m_change = 1.0;
+      }
+    }
+
+    void
+    CompassCalibration::updateEllipsoid(void)
+    {
+      const double* t = m_theta;
+      double m[9] = {t[0], t[3], t[4],
+                     t[3], t[1], t[5],
+                     t[4], t[5], t[2]};
+
+      // Cofactors of the symmetric quadratic form.
+      double c00 = m[4] * m[8] - m[5] * m[5];
+      double c01 = m[2] * m[5] - m[1] * m[8];
+      double c02 = m[1] * m[5] - m[2] * m[4];
+      double c11 = m[0] * m[8] - m[2] * m[2];
+      double c12 = m[1] * m[2] - m[0] * m[5];
+      double c22 = m[0] * m[4] - m[1] * m[1];
+      double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+
+      m_valid = false;
+
+      if (std::fabs(det) < std::numeric_limits<double>::epsilon())
+        return;
+
+      // Center: c = -M^-1 g.
+      double c[3];
+      c[0] = -(c00 * t[6] + c01 * t[7] + c02 * t[8]) / det;
+      c[1] = -(c01 * t[6] + c11 * t[7] + c12 * t[8]) / det;
+      c[2] = -(c02 * t[6] + c12 * t[7] + c22 * t[8]) / det;
+
+      // (x - c)' M (x - c) = 1 + c' M c.
+      double r = 1.0;
+      for (unsigned i = 0; i < 3; ++i)
+        for (unsigned j = 0; j < 3; ++j)
+          r += c[i] * m[i * 3 + j] * c[j];
+
+      if (std::fabs(r) < std::numeric_limits<double>::epsilon())
+        return;
+
+      double a[9];
+      for (unsigned i = 0; i < 9; ++i)
+        a[i] = m[i] / r;
+
+      // Shape must be positive definite.
+      if (a[0] <= 0.0 || c22 / r / r <= 0.0 || det / (r * r * r) <= 0.0)
+        return;
+
+      for (unsigned i = 0; i < 3; ++i)
+        m_center[i] = c[i];
+
+      for (unsigned i = 0; i < 9; ++i)
+        m_shape[i] = a[i];
+
+      m_valid = true;
+    }
+
+    Math::Matrix
+    CompassCalibration::getHardIron(void) const
+    {
+      if (!m_valid)
+        return (m_max + m_min) / 2;
+
+      Math::Matrix offset(1, 3);
+      for (unsigned i = 0; i < 3; ++i)
+        offset(i) = m_center[i] * m_scale;
+
+      return offset;
+    }
+
+    Math::Matrix
+    CompassCalibration::getSoftIron(void) const
+    {
+      Math::Matrix w(3, 3);
+      w.identity();
+
+      if (!m_valid)
+        return w;
+
+      double r[9];
+      sqrtSymmetric(m_shape, r);
+
+      // Normalize to unit determinant.
+      double det = r[0] * (r[4] * r[8] - r[5] * r[7])
+        - r[1] * (r[3] * r[8] - r[5] * r[6])
+        + r[2] * (r[3] * r[7] - r[4] * r[6]);
+      double k = std::pow(det, -1.0 / 3.0);
+
+      for (unsigned i = 0; i < 3; ++i)
+        for (unsigned j = 0; j < 3; ++j)
+          w(i, j) = r[i * 3 + j] * k;
+
+      return w;
+    }
+
+    double
+    CompassCalibration::getFieldStrength(void) const
+    {
+      if (!m_valid)
+        return m_scale;
+
+      const double* a = m_shape;
+      double det = a[0] * (a[4] * a[8] - a[5] * a[7])
+        - a[1] * (a[3] * a[8] - a[5] * a[6])
+        + a[2] * (a[3] * a[7] - a[4] * a[6]);
+
+      return std::pow(det, -1.0 / 6.0) * m_scale;
+    }
+
+    Math::Matrix
+    CompassCalibration::getCalibrationParams(void)
+    {
+      // Compute calibration parameters.
+      Math::Matrix params = getHardIron();
+
+      // Clear all data and return.
+      clear();
+      return params;
+    }
+  }
+}
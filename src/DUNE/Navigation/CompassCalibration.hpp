@@ -28,12 +28,8 @@
 #ifndef DUNE_NAVIGATION_COMPASS_CALIBRATION_HPP_INCLUDED_
 #define DUNE_NAVIGATION_COMPASS_CALIBRATION_HPP_INCLUDED_
 
-// ISO C++ 98 headers.
-#include <vector>
-#include <cmath>
-#include <limits>
-
 // DUNE headers.
+#include <DUNE/Config.hpp>
 #include <DUNE/Math/Matrix.hpp>
 #include <DUNE/IMC/Definitions.hpp>
 
@@ -41,28 +37,43 @@ namespace DUNE
 {
   namespace Navigation
   {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM CompassCalibration;
+
     //! %CompassCalibration is responsible
     //! to gather data from compass in order
-    //! to compute hard-iron calibration parameters.
+    //! to compute hard-iron and soft-iron calibration parameters.
+    //!
+    //! Raw magnetometer samples lie on an ellipsoid centred at the
+    //! hard-iron offset and shaped by the soft-iron distortion. The
+    //! general quadric through the samples is fitted by recursive
+    //! least squares, which costs a fixed amount of work and memory
+    //! per sample. The hard-iron offset estimate is compared at the
+    //! end of every window of samples and the fit is considered
+    //! converged once its relative change stays below a tolerance.
+    //! While the fit is not valid the offsets fall back to the mid
+    //! point of the extremes of the stabilized magnetic field.
     //!
     //! @author José Braga
     class CompassCalibration
     {
     public:
+      //! Number of parameters of the quadric.
+      static const unsigned c_params = 9;
+
       //! Constructor.
-      CompassCalibration(void)
-      {
-        clear();
-      }
+      CompassCalibration(void);
 
       //! Clear calibration.
       void
-      clear(void)
-      {
-        m_dcm.resizeAndFill(3, 1, 0.0);
-        m_max.resizeAndFill(1, 3, -std::numeric_limits<double>::max());
-        m_min.resizeAndFill(1, 3, std::numeric_limits<double>::max());
-      }
+      clear(void);
+
+      //! Set convergence criteria.
+      //! @param[in] tolerance maximum relative change of the
+      //! hard-iron offset between windows of samples.
+      //! @param[in] min_samples minimum number of samples.
+      void
+      setConvergence(double tolerance, unsigned min_samples);
 
       //! Update Direct Cosine Matrix.
       //! @param[in] msg euler angles message.
@@ -73,43 +84,66 @@ namespace DUNE
         m_dcm(1) = msg.theta;
       }
 
-      //! Get stabilized magnetic field.
+      //! Add a magnetic field sample.
       //! @param[in] msg magnetic field message.
       void
-      updateField(const IMC::MagneticField& msg)
+      updateField(const IMC::MagneticField& msg);
+
+      //! Check if the ellipsoid fit is valid, i.e., if the
+      //! fitted quadric is an ellipsoid.
+      //! @return true if fit is valid, false otherwise.
+      bool
+      isValid(void) const
       {
-        // Insert magnetic field into row matrix.
-        Math::Matrix mf(1,3);
-        mf(0) = msg.x;
-        mf(1) = msg.y;
-        mf(2) = msg.z;
-
-        // Get stabilized magnetic field.
-        Math::Matrix mf_stab = mf * transpose(m_dcm.toDCM());
-
-        // Store maximum and minimum values.
-        for (unsigned i = 0; i < 3; i++)
-        {
-          if (mf_stab(i) > m_max(i))
-            m_max(i) = mf_stab(i);
-          if (mf_stab(i) < m_min(i))
-            m_min(i) = mf_stab(i);
-        }
+        return m_valid;
       }
 
-      //! Get calibration parameters.
-      //! @return calibration parameters.
-      Math::Matrix
-      getCalibrationParams(void)
+      //! Check if the ellipsoid fit has converged.
+      //! @return true if converged, false otherwise.
+      bool
+      isConverged(void) const
+      {
+        return m_valid && m_samples >= m_min_samples && m_change < m_tolerance;
+      }
+
+      //! Get relative change of the hard-iron offset over the
+      //! last complete window of samples.
+      //! @return relative change.
+      double
+      getConvergence(void) const
       {
-        // Compute calibration parameters.
-        Math::Matrix params = (m_max + m_min) / 2;
+        return m_change;
+      }
 
-        // Clear all data and return.
-        clear();
-        return params;
+      //! Get number of samples in the fit.
+      //! @return number of samples.
+      unsigned
+      getSamples(void) const
+      {
+        return m_samples;
       }
 
+      //! Get estimated hard-iron offset.
+      //! @return hard-iron offset (1x3).
+      Math::Matrix
+      getHardIron(void) const;
+
+      //! Get estimated soft-iron correction. The corrected field is
+      //! W * (m - offset), with W symmetric and of unit determinant.
+      //! @return soft-iron correction matrix W (3x3).
+      Math::Matrix
+      getSoftIron(void) const;
+
+      //! Get estimated magnitude of the magnetic field.
+      //! @return magnitude of the field.
+      double
+      getFieldStrength(void) const;
+
+      //! Get calibration parameters.
+      //! @return hard-iron calibration parameters (1x3).
+      Math::Matrix
+      getCalibrationParams(void);
+
     private:
       //! Direct cosine matrix.
       Math::Matrix m_dcm;
@@ -117,6 +151,32 @@ namespace DUNE
       Math::Matrix m_max;
       //! Minimum values of stabilized magnetic field.
       Math::Matrix m_min;
+      //! Quadric parameters.
+      double m_theta[c_params];
+      //! Covariance of the quadric parameters.
+      double m_cov[c_params * c_params];
+      //! Scale of the samples.
+      double m_scale;
+      //! Ellipsoid center (normalized units).
+      double m_center[3];
+      //! Ellipsoid center at the start of the window.
+      double m_ref[3];
+      //! Shape matrix of the ellipsoid (normalized units).
+      double m_shape[9];
+      //! True if the quadric is an ellipsoid.
+      bool m_valid;
+      //! Number of samples.
+      unsigned m_samples;
+      //! Relative change of the center over the last window.
+      double m_change;
+      //! Convergence tolerance.
+      double m_tolerance;
+      //! Minimum number of samples.
+      unsigned m_min_samples;
+
+      //! Update ellipsoid from quadric parameters.
+      void
+      updateEllipsoid(void);
     };
   }
 }
@@ -0,0 +1,155 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Navigation/InertialIntegrator.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Accumulate the cross product of two vectors.
+    //! @param[in] a first vector.
+    //! @param[in] b second vector.
+    //! @param[in] k scale factor.
+    //! @param[in,out] r accumulator.
+    static void
+    addCross(const double a[3], const double b[3], double k, double r[3])
+    {
+      r[0] += k * (a[1] * b[2] - a[2] * b[1]);
+      r[1] += k * (a[2] * b[0] - a[0] * b[2]);
+      r[2] += k * (a[0] * b[1] - a[1] * b[0]);
+    }
+
+    InertialIntegrator::InertialIntegrator(void):
+      m_compensate(false),
+      m_time(0)
+    {
+      reset();
+    }
+
+    void
+    InertialIntegrator::reset(void)
+    {
+      m_count = 0;
+      m_interval = 0;
+
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m_agvel[i] = 0;
+        m_accel[i] = 0;
+        m_alpha[i] = 0;
+        m_coning[i] = 0;
+        m_vel[i] = 0;
+        m_sculling[i] = 0;
+        m_prev_dtheta[i] = 0;
+        m_prev_dvel[i] = 0;
+      }
+    }
+
+    void
+    InertialIntegrator::add(const InertialSample& sample, double dt)
+    {
+      double dtheta[3];
+      double dvel[3];
+
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m_agvel[i] += sample.angvel[i];
+        m_accel[i] += sample.accel[i];
+        dtheta[i] = sample.angvel[i] * dt;
+        dvel[i] = sample.accel[i] * dt;
+      }
+
+      if (m_compensate)
+      {
+        // Two-sample coning and sculling updates, using the
+        // increments accumulated up to the previous sample.
+        double alpha[3];
+        double vel[3];
+        for (unsigned i = 0; i < 3; ++i)
+        {
+          alpha[i] = m_alpha[i] + m_prev_dtheta[i] / 6.0;
+          vel[i] = m_vel[i] + m_prev_dvel[i] / 6.0;
+        }
+
+        addCross(alpha, dtheta, 0.5, m_coning);
+        addCross(alpha, dvel, 0.5, m_sculling);
+        addCross(vel, dtheta, 0.5, m_sculling);
+      }
+
+      for (unsigned i = 0; i < 3; ++i)
+      {
+        m_alpha[i] += dtheta[i];
+        m_vel[i] += dvel[i];
+        m_prev_dtheta[i] = dtheta[i];
+        m_prev_dvel[i] = dvel[i];
+      }
+
+      m_interval += dt;
+      m_time = sample.time;
+      ++m_count;
+    }
+
+    void
+    InertialIntegrator::getAngularVelocity(double value[3]) const
+    {
+      for (unsigned i = 0; i < 3; ++i)
+        value[i] = (m_count == 0) ? 0 : m_agvel[i] / m_count;
+    }
+
+    void
+    InertialIntegrator::getAcceleration(double value[3]) const
+    {
+      for (unsigned i = 0; i < 3; ++i)
+        value[i] = (m_count == 0) ? 0 : m_accel[i] / m_count;
+    }
+
+    void
+    InertialIntegrator::getDeltaAngle(double value[3]) const
+    {
+      for (unsigned i = 0; i < 3; ++i)
+        value[i] = m_alpha[i] + (m_compensate ? m_coning[i] : 0);
+    }
+
+    void
+    InertialIntegrator::getDeltaVelocity(double value[3]) const
+    {
+      for (unsigned i = 0; i < 3; ++i)
+        value[i] = m_vel[i];
+
+      if (!m_compensate)
+        return;
+
+      // Rotation of the velocity increment during the block.
+      addCross(m_alpha, m_vel, 0.5, value);
+
+      for (unsigned i = 0; i < 3; ++i)
+        value[i] += m_sculling[i];
+    }
+  }
+}
@@ -0,0 +1,144 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_INERTIAL_INTEGRATOR_HPP_INCLUDED_
+#define DUNE_NAVIGATION_INERTIAL_INTEGRATOR_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Navigation/InertialStream.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM InertialIntegrator;
+
+    //! Accumulates a block of inertial samples into mean rates and
+    //! into angle and velocity increments. When compensation is
+    //! enabled the increments include the two-sample coning and
+    //! sculling corrections, which recover the rotation and velocity
+    //! change lost by summing samples of a rotating body frame.
+    class InertialIntegrator
+    {
+    public:
+      //! Constructor.
+      InertialIntegrator(void);
+
+      //! Enable or disable coning and sculling compensation.
+      //! @param[in] enabled true to enable compensation.
+      void
+      setCompensation(bool enabled)
+      {
+        m_compensate = enabled;
+      }
+
+      //! Start a new block.
+      void
+      reset(void);
+
+      //! Add a sample to the current block.
+      //! @param[in] sample inertial sample.
+      //! @param[in] dt time elapsed since the previous sample (s).
+      void
+      add(const InertialSample& sample, double dt);
+
+      //! Retrieve the number of samples in the current block.
+      //! @return number of samples.
+      unsigned
+      getCount(void) const
+      {
+        return m_count;
+      }
+
+      //! Retrieve the time spanned by the current block.
+      //! @return block interval (s).
+      double
+      getInterval(void) const
+      {
+        return m_interval;
+      }
+
+      //! Retrieve the time of the most recent sample.
+      //! @return sample time (s).
+      double
+      getTime(void) const
+      {
+        return m_time;
+      }
+
+      //! Retrieve the mean angular velocity of the block.
+      //! @param[out] value angular velocity (rad/s).
+      void
+      getAngularVelocity(double value[3]) const;
+
+      //! Retrieve the mean acceleration of the block.
+      //! @param[out] value acceleration (m/s^2).
+      void
+      getAcceleration(double value[3]) const;
+
+      //! Retrieve the rotation vector of the block.
+      //! @param[out] value angle increment (rad).
+      void
+      getDeltaAngle(double value[3]) const;
+
+      //! Retrieve the velocity increment of the block.
+      //! @param[out] value velocity increment (m/s).
+      void
+      getDeltaVelocity(double value[3]) const;
+
+    private:
+      //! True to apply coning and sculling compensation.
+      bool m_compensate;
+      //! Number of samples.
+      unsigned m_count;
+      //! Block interval.
+      double m_interval;
+      //! Time of the last sample.
+      double m_time;
+      //! Sum of angular velocities.
+      double m_agvel[3];
+      //! Sum of accelerations.
+      double m_accel[3];
+      //! Summed angle increments.
+      double m_alpha[3];
+      //! Coning correction.
+      double m_coning[3];
+      //! Summed velocity increments.
+      double m_vel[3];
+      //! Sculling correction.
+      double m_sculling[3];
+      //! Angle increment of the previous sample.
+      double m_prev_dtheta[3];
+      //! Velocity increment of the previous sample.
+      double m_prev_dvel[3];
+    };
+  }
+}
+
+#endif
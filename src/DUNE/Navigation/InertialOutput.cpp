@@ -0,0 +1,142 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Navigation/InertialOutput.hpp>
+#include <DUNE/Tasks/Task.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    const double InertialOutput::c_max_gap = 1.0;
+
+    InertialOutput::InertialOutput(Tasks::Task* task, InertialStreams& streams):
+      m_task(task),
+      m_streams(streams),
+      m_stream(NULL),
+      m_decimation(1),
+      m_increments(false),
+      m_last(-1)
+    { }
+
+    void
+    InertialOutput::setDecimation(unsigned decimation)
+    {
+      m_decimation = std::max(decimation, 1u);
+    }
+
+    void
+    InertialOutput::setIncrements(bool enabled, bool compensation)
+    {
+      m_increments = enabled;
+      m_integ.setCompensation(compensation);
+    }
+
+    void
+    InertialOutput::push(const IMC::AngularVelocity& agvel, const IMC::Acceleration& accel)
+    {
+      // The entity is only known after the task is started.
+      if (m_stream == NULL)
+        m_stream = &m_streams.get(m_task->getEntityId());
+
+      InertialSample sample;
+      sample.time = agvel.getTimeStamp();
+      sample.angvel[0] = agvel.x;
+      sample.angvel[1] = agvel.y;
+      sample.angvel[2] = agvel.z;
+      sample.accel[0] = accel.x;
+      sample.accel[1] = accel.y;
+      sample.accel[2] = accel.z;
+      m_stream->push(sample);
+
+      double dt = sample.time - m_last;
+      if (m_last < 0 || dt <= 0 || dt > c_max_gap)
+        dt = 0;
+      m_last = sample.time;
+
+      m_integ.add(sample, dt);
+      m_agvel.time = agvel.time;
+      m_accel.time = accel.time;
+
+      if (m_integ.getCount() >= m_decimation)
+        flush();
+    }
+
+    void
+    InertialOutput::reset(void)
+    {
+      m_integ.reset();
+      m_last = -1;
+    }
+
+    void
+    InertialOutput::flush(void)
+    {
+      double v[3];
+
+      m_integ.getAngularVelocity(v);
+      m_agvel.x = v[0];
+      m_agvel.y = v[1];
+      m_agvel.z = v[2];
+      m_agvel.setTimeStamp(m_integ.getTime());
+      m_task->dispatch(m_agvel, Tasks::DF_KEEP_TIME);
+
+      m_integ.getAcceleration(v);
+      m_accel.x = v[0];
+      m_accel.y = v[1];
+      m_accel.z = v[2];
+      m_accel.setTimeStamp(m_integ.getTime());
+      m_task->dispatch(m_accel, Tasks::DF_KEEP_TIME);
+
+      if (m_increments)
+      {
+        m_integ.getDeltaAngle(v);
+        m_dtheta.x = v[0];
+        m_dtheta.y = v[1];
+        m_dtheta.z = v[2];
+        m_dtheta.time = m_agvel.time;
+        m_dtheta.timestep = m_integ.getInterval();
+        m_dtheta.setTimeStamp(m_integ.getTime());
+        m_task->dispatch(m_dtheta, Tasks::DF_KEEP_TIME);
+
+        m_integ.getDeltaVelocity(v);
+        m_dvel.x = v[0];
+        m_dvel.y = v[1];
+        m_dvel.z = v[2];
+        m_dvel.time = m_accel.time;
+        m_dvel.setTimeStamp(m_integ.getTime());
+        m_task->dispatch(m_dvel, Tasks::DF_KEEP_TIME);
+      }
+
+      m_integ.reset();
+    }
+  }
+}
@@ -0,0 +1,122 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_INERTIAL_OUTPUT_HPP_INCLUDED_
+#define DUNE_NAVIGATION_INERTIAL_OUTPUT_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/Navigation/InertialStream.hpp>
+#include <DUNE/Navigation/InertialIntegrator.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    class Task;
+  }
+
+  namespace Navigation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM InertialOutput;
+
+    //! Common output stage of inertial sensor drivers. Every sample
+    //! is pushed to the inertial stream of the driver's entity, where
+    //! navigation reads it at full rate, while angular velocity and
+    //! acceleration are dispatched as the mean of every block of
+    //! samples, and optionally as compensated angle and velocity
+    //! increments.
+    class InertialOutput
+    {
+    public:
+      //! Maximum gap between consecutive samples that is still
+      //! integrated (s).
+      static const double c_max_gap;
+
+      //! Constructor.
+      //! @param[in] task owner task.
+      //! @param[in] streams inertial streams of the system.
+      InertialOutput(Tasks::Task* task, InertialStreams& streams);
+
+      //! Set the number of samples in each dispatched block.
+      //! @param[in] decimation number of samples.
+      void
+      setDecimation(unsigned decimation);
+
+      //! Enable or disable dispatching of angle and velocity
+      //! increments.
+      //! @param[in] enabled true to dispatch increments.
+      //! @param[in] compensation true to apply coning and sculling
+      //! compensation to the increments.
+      void
+      setIncrements(bool enabled, bool compensation);
+
+      //! Add a sample.
+      //! @param[in] agvel angular velocity, with device time and
+      //! acquisition timestamp.
+      //! @param[in] accel acceleration measured at the same instant.
+      void
+      push(const IMC::AngularVelocity& agvel, const IMC::Acceleration& accel);
+
+      //! Discard the current block.
+      void
+      reset(void);
+
+    private:
+      //! Owner task.
+      Tasks::Task* m_task;
+      //! Inertial streams.
+      InertialStreams& m_streams;
+      //! Stream of the owner's entity.
+      InertialStream* m_stream;
+      //! Block integrator.
+      InertialIntegrator m_integ;
+      //! Number of samples per block.
+      unsigned m_decimation;
+      //! True to dispatch increments.
+      bool m_increments;
+      //! Timestamp of the previous sample.
+      double m_last;
+      //! Block angular velocity.
+      IMC::AngularVelocity m_agvel;
+      //! Block acceleration.
+      IMC::Acceleration m_accel;
+      //! Block angle increment.
+      IMC::EulerAnglesDelta m_dtheta;
+      //! Block velocity increment.
+      IMC::VelocityDelta m_dvel;
+
+      //! Dispatch the current block.
+      void
+      flush(void);
+    };
+  }
+}
+
+#endif
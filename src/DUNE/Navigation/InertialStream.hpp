@@ -0,0 +1,256 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_INERTIAL_STREAM_HPP_INCLUDED_
+#define DUNE_NAVIGATION_INERTIAL_STREAM_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+
+// Check if we can use GCC's atomic functions.
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  ifndef DUNE_NAVIGATION_INERTIAL_STREAM_GCC
+#    define DUNE_NAVIGATION_INERTIAL_STREAM_GCC
+#  endif
+#endif
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Single inertial measurement.
+    struct InertialSample
+    {
+      //! Time of the measurement (s).
+      double time;
+      //! Angular velocity (rad/s).
+      double angvel[3];
+      //! Acceleration (m/s^2).
+      double accel[3];
+    };
+
+    //! Fixed-capacity ring of inertial samples written by a single
+    //! driver thread and read by any number of consumers without
+    //! locking. Every consumer owns a Reader with its own cursor;
+    //! consumers that fall more than a ring behind lose the oldest
+    //! samples, which is reported by Reader::getLost().
+    class InertialStream
+    {
+    public:
+      //! Number of samples held by the ring.
+      static const unsigned c_capacity = 256;
+
+      //! Per-consumer cursor into a stream.
+      class Reader
+      {
+      public:
+        //! Constructor. Only samples pushed after the reader is
+        //! created are returned.
+        //! @param[in] stream stream to read.
+        Reader(const InertialStream& stream):
+          m_stream(stream),
+          m_next(stream.getCount()),
+          m_lost(0)
+        { }
+
+        //! Copy pending samples, oldest first.
+        //! @param[out] samples destination array.
+        //! @param[in] count capacity of the destination array.
+        //! @return number of samples copied.
+        unsigned
+        read(InertialSample* samples, unsigned count)
+        {
+          unsigned long head = m_stream.getCount();
+
+          // A slot that is one ring behind the writer may be
+          // overwritten at any time.
+          if (head - m_next >= c_capacity)
+          {
+            m_lost += head - m_next - (c_capacity - 1);
+            m_next = head - (c_capacity - 1);
+          }
+
+          unsigned n = 0;
+          while (n < count && m_next != head)
+          {
+#if defined(DUNE_NAVIGATION_INERTIAL_STREAM_GCC)
+            samples[n] = m_stream.m_ring[m_next % c_capacity];
+#else
+            {
+              Concurrency::ScopedMutex l(m_stream.m_lock);
+              samples[n] = m_stream.m_ring[m_next % c_capacity];
+            }
+#endif
+
+            // Discard the copy if the writer reached the slot while it
+            // was being taken.
+            if (m_stream.getCount() - m_next >= c_capacity)
+              ++m_lost;
+            else
+              ++n;
+
+            ++m_next;
+          }
+
+          return n;
+        }
+
+        //! Retrieve the stream being read.
+        //! @return inertial stream.
+        const InertialStream&
+        getStream(void) const
+        {
+          return m_stream;
+        }
+
+        //! Retrieve the number of samples lost because this reader
+        //! fell behind.
+        //! @return number of samples lost.
+        unsigned long
+        getLost(void) const
+        {
+          return m_lost;
+        }
+
+      private:
+        //! Stream being read.
+        const InertialStream& m_stream;
+        //! Sequence number of the next sample to read.
+        unsigned long m_next;
+        //! Number of samples lost.
+        unsigned long m_lost;
+      };
+
+      //! Constructor.
+      InertialStream(void):
+        m_count(0)
+      { }
+
+      //! Append a sample. Must only be called by the owning driver.
+      //! @param[in] sample inertial sample.
+      void
+      push(const InertialSample& sample)
+      {
+#if defined(DUNE_NAVIGATION_INERTIAL_STREAM_GCC)
+        m_ring[m_count % c_capacity] = sample;
+        // The sample must be complete before it becomes visible.
+        __sync_synchronize();
+        m_count = m_count + 1;
+        __sync_synchronize();
+#else
+        Concurrency::ScopedMutex l(m_lock);
+        m_ring[m_count % c_capacity] = sample;
+        m_count = m_count + 1;
+#endif
+      }
+
+      //! Retrieve the number of samples pushed so far.
+      //! @return number of samples.
+      unsigned long
+      getCount(void) const
+      {
+#if defined(DUNE_NAVIGATION_INERTIAL_STREAM_GCC)
+        __sync_synchronize();
+        unsigned long count = m_count;
+        __sync_synchronize();
+        return count;
+#else
+        Concurrency::ScopedMutex l(m_lock);
+        return m_count;
+#endif
+      }
+
+    private:
+      //! Sample ring.
+      InertialSample m_ring[c_capacity];
+      //! Number of samples pushed.
+      volatile unsigned long m_count;
+#if !defined(DUNE_NAVIGATION_INERTIAL_STREAM_GCC)
+      //! Lock used when atomic operations are unavailable.
+      mutable Concurrency::Mutex m_lock;
+#endif
+
+      // Non-copyable.
+      InertialStream(const InertialStream&);
+      InertialStream& operator=(const InertialStream&);
+    };
+
+    //! Inertial streams of a system, one per entity. Streams are
+    //! created on first use and live as long as the registry.
+    class InertialStreams
+    {
+    public:
+      //! Maximum number of entities.
+      static const unsigned c_entities = 256;
+
+      //! Constructor.
+      InertialStreams(void)
+      {
+        for (unsigned i = 0; i < c_entities; ++i)
+          m_streams[i] = NULL;
+      }
+
+      //! Destructor. All readers must be destroyed beforehand.
+      ~InertialStreams(void)
+      {
+        for (unsigned i = 0; i < c_entities; ++i)
+          delete m_streams[i];
+      }
+
+      //! Retrieve the stream of an entity, creating it if needed.
+      //! @param[in] eid entity identifier.
+      //! @return inertial stream.
+      InertialStream&
+      get(unsigned eid)
+      {
+        Concurrency::ScopedMutex l(m_lock);
+        InertialStream*& stream = m_streams[eid % c_entities];
+        if (stream == NULL)
+          stream = new InertialStream;
+
+        return *stream;
+      }
+
+    private:
+      //! Streams indexed by entity identifier.
+      InertialStream* m_streams[c_entities];
+      //! Lock serializing stream creation.
+      Concurrency::Mutex m_lock;
+
+      // Non-copyable.
+      InertialStreams(const InertialStreams&);
+      InertialStreams& operator=(const InertialStreams&);
+    };
+  }
+}
+
+#endif
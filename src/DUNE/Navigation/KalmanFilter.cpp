@@ -26,6 +26,9 @@
 // Author: José Braga                                                       *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+
 // DUNE headers.
 #include <DUNE/Navigation/KalmanFilter.hpp>
 
@@ -33,7 +36,8 @@ namespace DUNE
 {
   namespace Navigation
   {
-    KalmanFilter::KalmanFilter(void)
+    KalmanFilter::KalmanFilter(void):
+      m_mode(UPDATE_STANDARD)
     {
       m_state_count = 1;
       Math::Matrix I(1);
@@ -41,7 +45,8 @@ namespace DUNE
       m_x = m_y = m_ax = m_ap = m_c = m_p = m_q = m_r = m_innov = I;
     }
 
-    KalmanFilter::KalmanFilter(Math::Matrix& A, Math::Matrix& C, Math::Matrix& P, Math::Matrix& Q)
+    KalmanFilter::KalmanFilter(Math::Matrix& A, Math::Matrix& C, Math::Matrix& P, Math::Matrix& Q):
+      m_mode(UPDATE_STANDARD)
     {
       m_ax = A;
       m_ap = A;
@@ -118,8 +123,64 @@ namespace DUNE
     void
     KalmanFilter::predict(void)
     {
-      m_x = m_ax * m_x;
-      m_p = m_ap * m_p * transpose(m_ap) + m_q;
+      const size_t n = m_state_count;
+      const Math::Matrix& ax = m_ax;
+      const Math::Matrix& ap = m_ap;
+      const Math::Matrix& q = m_q;
+      const Math::Matrix& p = m_p;
+
+      m_work.resize(n * n + n);
+      double* w = &m_work[0];
+      double* x = w + n * n;
+
+      // x = A * x.
+      for (size_t i = 0; i < n; ++i)
+      {
+        double v = 0.0;
+        for (size_t k = 0; k < n; ++k)
+        {
+          double a = ax(i, k);
+          if (a != 0.0)
+            v += a * m_x(k);
+        }
+        x[i] = v;
+      }
+
+      for (size_t i = 0; i < n; ++i)
+        m_x(i) = x[i];
+
+      // W = A * P.
+      std::fill(w, w + n * n, 0.0);
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t k = 0; k < n; ++k)
+        {
+          double a = ap(i, k);
+          if (a == 0.0)
+            continue;
+
+          for (size_t j = 0; j < n; ++j)
+            w[i * n + j] += a * p(k, j);
+        }
+      }
+
+      // P = W * A' + Q, computed on the upper triangle.
+      for (size_t i = 0; i < n; ++i)
+      {
+        for (size_t j = i; j < n; ++j)
+        {
+          double v = q(i, j);
+          for (size_t k = 0; k < n; ++k)
+          {
+            double a = ap(j, k);
+            if (a != 0.0)
+              v += w[i * n + k] * a;
+          }
+
+          m_p(i, j) = v;
+          m_p(j, i) = v;
+        }
+      }
     }
 
     int
@@ -137,6 +198,9 @@ namespace DUNE
       if (m_r.rows() != m_r.columns() || m_r.rows() != m_innov.rows())
         throw std::runtime_error(DTR("invalid dimensions"));
 
+      if (m_mode == UPDATE_SEQUENTIAL)
+        return updateSequential(threshold);
+
       // Measurement prediction covariance.
       Math::Matrix S = (m_c * m_p * transpose(m_c)) + m_r;
       Math::Matrix S_1;
@@ -173,6 +237,193 @@ namespace DUNE
       return 0;
     }
 
+    double
+    KalmanFilter::getInnovationLevel(void) const
+    {
+      Math::Matrix L;
+
+      try
+      {
+        L = cholesky((m_c * m_p * transpose(m_c)) + m_r);
+      }
+      catch (...)
+      {
+        throw std::runtime_error(DTR("matrix inversion error"));
+      }
+
+      // Solve L * z = innovation; the level is z' * z.
+      size_t m = m_innov.rows();
+      std::vector<double> z(m);
+      double level = 0.0;
+
+      for (size_t i = 0; i < m; ++i)
+      {
+        double v = m_innov(i);
+        for (size_t j = 0; j < i; ++j)
+          v -= L(i, j) * z[j];
+
+        z[i] = v / L(i, i);
+        level += z[i] * z[i];
+      }
+
+      return level;
+    }
+
+    int
+    KalmanFilter::updateSequential(float threshold)
+    {
+      // Check if innovation is above a threshold value.
+      // Set threshold to 0 to accept everything.
+      if (threshold != 0 && getInnovationLevel() >= threshold)
+        return -1;
+
+      size_t n = m_state_count;
+      size_t m = m_innov.rows();
+
+      Math::Matrix c = m_c;
+      Math::Matrix innov = m_innov;
+      std::vector<double> r(m);
+
+      bool diagonal = true;
+      for (size_t i = 0; i < m && diagonal; ++i)
+      {
+        for (size_t j = 0; j < m; ++j)
+        {
+          if (i != j && m_r(i, j) != 0.0)
+          {
+            diagonal = false;
+            break;
+          }
+        }
+      }
+
+      if (diagonal)
+      {
+        for (size_t i = 0; i < m; ++i)
+          r[i] = m_r(i, i);
+      }
+      else
+      {
+        // Decorrelate outputs: with R = L * L', use L^-1 * C and
+        // L^-1 * innovation, whose noise covariance is the identity.
+        Math::Matrix L;
+
+        try
+        {
+          L = cholesky(m_r);
+        }
+        catch (...)
+        {
+          throw std::runtime_error(DTR("matrix inversion error"));
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+          for (size_t j = 0; j < i; ++j)
+          {
+            innov(i) -= L(i, j) * innov(j);
+            for (size_t k = 0; k < n; ++k)
+              c(i, k) -= L(i, j) * c(j, k);
+          }
+
+          innov(i) /= L(i, i);
+          for (size_t k = 0; k < n; ++k)
+            c(i, k) /= L(i, i);
+
+          r[i] = 1.0;
+        }
+      }
+
+      std::vector<size_t> nz;
+      nz.reserve(n);
+      std::vector<double> pc(n);
+      std::vector<double> ac(n);
+      std::vector<double> dx(n, 0.0);
+
+      if (m_work.size() < n * n)
+        m_work.resize(n * n);
+      double* a = &m_work[0];
+
+      for (size_t i = 0; i < m; ++i)
+      {
+        nz.clear();
+        for (size_t k = 0; k < n; ++k)
+        {
+          if (c(i, k) != 0.0)
+            nz.push_back(k);
+        }
+
+        if (nz.empty())
+          continue;
+
+        // P * c' and c * P * c' + r over the non-zero entries of c.
+        for (size_t j = 0; j < n; ++j)
+        {
+          double v = 0.0;
+          for (size_t k = 0; k < nz.size(); ++k)
+            v += m_p(j, nz[k]) * c(i, nz[k]);
+          pc[j] = v;
+        }
+
+        double s = r[i];
+        // Innovations were computed against the prior state.
+        double e = innov(i);
+        for (size_t k = 0; k < nz.size(); ++k)
+        {
+          s += c(i, nz[k]) * pc[nz[k]];
+          e -= c(i, nz[k]) * dx[nz[k]];
+        }
+
+        if (!(s > 0.0))
+          throw std::runtime_error(DTR("matrix inversion error"));
+
+        // State update with gain k = P * c' / s.
+        for (size_t j = 0; j < n; ++j)
+        {
+          double dk = pc[j] / s * e;
+          m_x(j) += dk;
+          dx[j] += dk;
+        }
+
+        // Joseph form: P = (I - k c) P (I - k c)' + k r k'. The first
+        // product A = (I - k c) P is stored and the second one is
+        // computed from it, so that rounding errors are propagated as
+        // a congruence and P stays positive semidefinite. Since P is
+        // symmetric, row c * P is pc'.
+        for (size_t j = 0; j < n; ++j)
+        {
+          double kj = pc[j] / s;
+          for (size_t l = 0; l < n; ++l)
+            a[j * n + l] = m_p(j, l) - kj * pc[l];
+        }
+
+        // A * c' over the non-zero entries of c.
+        for (size_t j = 0; j < n; ++j)
+        {
+          double v = 0.0;
+          for (size_t k = 0; k < nz.size(); ++k)
+            v += a[j * n + nz[k]] * c(i, nz[k]);
+          ac[j] = v;
+        }
+
+        // A (I - k c)' + k r k'. Only the upper triangle is computed
+        // so P stays exactly symmetric.
+        for (size_t j = 0; j < n; ++j)
+        {
+          double kj = pc[j] / s;
+          for (size_t l = j; l < n; ++l)
+          {
+            double kl = pc[l] / s;
+            double v = a[j * n + l] - ac[j] * kl + r[i] * kj * kl;
+            m_p(j, l) = v;
+            m_p(l, j) = v;
+          }
+        }
+      }
+
+      return 0;
+    }
+
     void
     KalmanFilter::setState(short pos, double value)
     {
@@ -197,14 +448,14 @@ namespace DUNE
     }
 
     void
-    KalmanFilter::setTransitions(Math::Matrix a)
+    KalmanFilter::setTransitions(const Math::Matrix& a)
     {
       setStateTransition(a);
       setCovarianceTransition(a);
     }
 
     void
-    KalmanFilter::setStateTransition(Math::Matrix a)
+    KalmanFilter::setStateTransition(const Math::Matrix& a)
     {
       if (a.rows() != a.columns())
         throw std::runtime_error(DTR("invalid dimensions"));
@@ -216,7 +467,7 @@ namespace DUNE
     }
 
     void
-    KalmanFilter::setCovarianceTransition(Math::Matrix a)
+    KalmanFilter::setCovarianceTransition(const Math::Matrix& a)
     {
       if (a.rows() != a.columns())
         throw std::runtime_error(DTR("invalid dimensions"));
@@ -43,6 +43,7 @@
 // ISO C++ 98 headers.
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <cmath>
 
 // DUNE headers.
@@ -59,6 +60,19 @@ namespace DUNE
     class KalmanFilter
     {
     public:
+      //! Measurement update strategies.
+      enum UpdateMode
+      {
+        //! Batch update using the inverse of the innovation covariance.
+        UPDATE_STANDARD,
+        //! Sequential scalar updates in Joseph form. Outputs are
+        //! processed one at a time and only the non-zero entries of
+        //! each observation row are visited, so no matrix inversion
+        //! takes place. Correlated measurement noise is decorrelated
+        //! first using the Cholesky factor of R.
+        UPDATE_SEQUENTIAL
+      };
+
       //! Constructor.
       KalmanFilter(void);
 
@@ -98,6 +112,8 @@ namespace DUNE
       predict(Math::Matrix& b, Math::Matrix& u);
 
       //! Predict the state at the next timestep assuming no input.
+      //! Products are computed in a preallocated workspace, skipping
+      //! the zero entries of the transition matrices.
       void
       predict(void);
 
@@ -107,6 +123,22 @@ namespace DUNE
       int
       update(float threshold);
 
+      //! Select the measurement update strategy.
+      //! @param mode update mode.
+      void
+      setUpdateMode(UpdateMode mode)
+      {
+        m_mode = mode;
+      }
+
+      //! Get the measurement update strategy.
+      //! @return update mode.
+      UpdateMode
+      getUpdateMode(void) const
+      {
+        return m_mode;
+      }
+
       //! Get filter state value.
       //! @param pos matrix index.
       //! @return state matrix value.
@@ -148,7 +180,7 @@ namespace DUNE
       //! Set state transition matrix.
       //! @param a state transition matrix.
       void
-      setStateTransition(Math::Matrix a);
+      setStateTransition(const Math::Matrix& a);
 
       //! Get state covariance transition matrix.
       //! @return state covariance transition matrix.
@@ -161,12 +193,12 @@ namespace DUNE
       //! Set state covariance transition matrix.
       //! @param a state covariance transition matrix.
       void
-      setCovarianceTransition(Math::Matrix a);
+      setCovarianceTransition(const Math::Matrix& a);
 
       //! Set transition matrices.
       //! @param a state transition matrix.
       void
-      setTransitions(Math::Matrix a);
+      setTransitions(const Math::Matrix& a);
 
       //! Reset output matrices.
       void
@@ -339,6 +371,20 @@ namespace DUNE
       setMeasurementNoise(double value);
 
     private:
+      //! Sequential scalar update in Joseph form.
+      //! @param threshold threshold to reject large state innovations.
+      //! @return 0 if update is successful, -1 otherwise.
+      int
+      updateSequential(float threshold);
+
+      //! Compute the normalized innovation squared using the Cholesky
+      //! factor of the innovation covariance.
+      //! @return innovation level.
+      double
+      getInnovationLevel(void) const;
+
+      //! Measurement update strategy.
+      UpdateMode m_mode;
       //! Kalman filter state count.
       size_t m_state_count;
       //! State vector.
@@ -359,6 +405,8 @@ namespace DUNE
       Math::Matrix m_r;
       //! Innovation vector.
       Math::Matrix m_innov;
+      //! Prediction workspace.
+      std::vector<double> m_work;
     };
   }
 }
@@ -0,0 +1,213 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Navigation/MultiBeamFilter.hpp>
+#include <DUNE/Math/Kernels.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Scale of the median absolute deviation of a normal distribution.
+    static const double c_mad_scale = 1.4826;
+    //! Minimum spread of vertical distances considered by the outlier
+    //! rejection (m).
+    static const double c_min_spread = 0.05;
+
+    MultiBeamFilter::MultiBeamFilter(size_t beams):
+      m_range(beams, -1.0),
+      m_cos(beams, 1.0),
+      m_sin(beams, 0.0),
+      m_z(beams, 0.0),
+      m_y(beams, 0.0),
+      m_weight(beams, 0.0),
+      m_wy(beams, 0.0),
+      m_scratch(beams, 0.0),
+      m_min_range(0.3),
+      m_max_range(std::numeric_limits<double>::max()),
+      m_threshold(3.0),
+      m_min_beams(1)
+    {
+      m_estimate.valid = false;
+      m_estimate.beams = 0;
+      m_estimate.altitude = 0.0;
+      m_estimate.median = 0.0;
+      m_estimate.minimum = 0.0;
+      m_estimate.slope = 0.0;
+    }
+
+    void
+    MultiBeamFilter::setAngle(size_t index, double angle)
+    {
+      if (index >= m_range.size())
+        return;
+
+      m_cos[index] = std::cos(angle);
+      m_sin[index] = std::sin(angle);
+    }
+
+    void
+    MultiBeamFilter::setSector(double first, double last)
+    {
+      size_t n = m_range.size();
+      if (n == 1)
+      {
+        setAngle(0, (first + last) / 2.0);
+        return;
+      }
+
+      for (size_t i = 0; i < n; ++i)
+        setAngle(i, first + (last - first) * i / (n - 1));
+    }
+
+    void
+    MultiBeamFilter::clear(void)
+    {
+      std::fill(m_range.begin(), m_range.end(), -1.0);
+      m_estimate.valid = false;
+      m_estimate.beams = 0;
+    }
+
+    void
+    MultiBeamFilter::setRanges(const double* ranges)
+    {
+      std::copy(ranges, ranges + m_range.size(), m_range.begin());
+    }
+
+    double
+    MultiBeamFilter::median(size_t count)
+    {
+      std::vector<double>::iterator mid = m_scratch.begin() + count / 2;
+      std::nth_element(m_scratch.begin(), mid, m_scratch.begin() + count);
+      double value = *mid;
+
+      if (count % 2 == 0)
+        value = (value + *std::max_element(m_scratch.begin(), mid)) / 2.0;
+
+      return value;
+    }
+
+    const MultiBeamFilter::Estimate&
+    MultiBeamFilter::process(void)
+    {
+      size_t n = m_range.size();
+      const double* r = &m_range[0];
+      const double* c = &m_cos[0];
+      const double* s = &m_sin[0];
+      double* z = &m_z[0];
+      double* y = &m_y[0];
+      double* w = &m_weight[0];
+
+      m_estimate.valid = false;
+      m_estimate.beams = 0;
+
+      if (n == 0)
+        return m_estimate;
+
+      // Project ranges and gate by range interval.
+      for (size_t i = 0; i < n; ++i)
+      {
+        z[i] = r[i] * c[i];
+        y[i] = r[i] * s[i];
+        w[i] = (r[i] >= m_min_range && r[i] <= m_max_range) ? 1.0 : 0.0;
+      }
+
+      // Median of vertical distances.
+      size_t count = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (w[i] > 0.0)
+          m_scratch[count++] = z[i];
+      }
+
+      if (count < m_min_beams || count == 0)
+        return m_estimate;
+
+      double med = median(count);
+
+      // Median absolute deviation.
+      count = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        if (w[i] > 0.0)
+          m_scratch[count++] = std::fabs(z[i] - med);
+      }
+
+      double spread = std::max(c_mad_scale * median(count), c_min_spread);
+      double limit = m_threshold * spread;
+
+      // Reject outliers.
+      for (size_t i = 0; i < n; ++i)
+        w[i] = (std::fabs(z[i] - med) <= limit) ? w[i] : 0.0;
+
+      // Weighted sums for the across track line fit.
+      double* wy = &m_wy[0];
+      double sw = 0.0;
+      double minimum = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < n; ++i)
+      {
+        wy[i] = w[i] * y[i];
+        sw += w[i];
+        minimum = (w[i] > 0.0 && z[i] < minimum) ? z[i] : minimum;
+      }
+
+      unsigned beams = (unsigned)sw;
+      if (beams < m_min_beams || beams == 0)
+        return m_estimate;
+
+      double swy = Math::Kernels::dot(n, w, y);
+      double swz = Math::Kernels::dot(n, w, z);
+      double swyy = Math::Kernels::dot(n, wy, y);
+      double swyz = Math::Kernels::dot(n, wy, z);
+
+      double det = sw * swyy - swy * swy;
+      double altitude = swz / sw;
+      double gradient = 0.0;
+
+      // Fit z = a + b * y when beams span across track.
+      if (det > 1e-9 * sw * sw)
+      {
+        gradient = (sw * swyz - swy * swz) / det;
+        altitude = (swz - gradient * swy) / sw;
+      }
+
+      m_estimate.valid = true;
+      m_estimate.beams = beams;
+      m_estimate.altitude = altitude;
+      m_estimate.median = med;
+      m_estimate.minimum = minimum;
+      m_estimate.slope = std::atan(-gradient);
+      return m_estimate;
+    }
+  }
+}
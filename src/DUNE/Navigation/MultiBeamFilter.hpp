@@ -0,0 +1,217 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_MULTI_BEAM_FILTER_HPP_INCLUDED_
+#define DUNE_NAVIGATION_MULTI_BEAM_FILTER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM MultiBeamFilter;
+
+    //! %MultiBeamFilter fuses the ranges of an array of beams
+    //! (multibeam echosounder, set of altimeters, DVL beams) into
+    //! one seafloor estimate per ping.
+    //!
+    //! Ranges, beam angles and intermediate values are kept in
+    //! separate contiguous arrays, so every stage is a plain loop
+    //! over doubles. Per ping, beams outside the valid range
+    //! interval are discarded, outliers are rejected by their
+    //! distance to the median vertical distance in units of the
+    //! median absolute deviation, and a line is fitted across track
+    //! to the remaining seafloor points.
+    class MultiBeamFilter
+    {
+    public:
+      //! Seafloor estimate.
+      struct Estimate
+      {
+        //! True if enough beams were accepted.
+        bool valid;
+        //! Number of accepted beams.
+        unsigned beams;
+        //! Distance to the seafloor below the sensor, from the fitted
+        //! line (m).
+        double altitude;
+        //! Median vertical distance of accepted beams (m).
+        double median;
+        //! Minimum vertical distance of accepted beams (m).
+        double minimum;
+        //! Across track slope of the seafloor (rad), positive when
+        //! the seafloor rises to starboard.
+        double slope;
+      };
+
+      //! Constructor.
+      //! @param[in] beams number of beams.
+      MultiBeamFilter(size_t beams);
+
+      //! Set beam angle. Angles are measured across track from the
+      //! vertical, positive to starboard.
+      //! @param[in] index beam index.
+      //! @param[in] angle beam angle (rad).
+      void
+      setAngle(size_t index, double angle);
+
+      //! Set beam angles evenly spread over a sector.
+      //! @param[in] first angle of the first beam (rad).
+      //! @param[in] last angle of the last beam (rad).
+      void
+      setSector(double first, double last);
+
+      //! Set interval of valid ranges.
+      //! @param[in] min minimum valid range (m).
+      //! @param[in] max maximum valid range (m).
+      void
+      setLimits(double min, double max)
+      {
+        m_min_range = min;
+        m_max_range = max;
+      }
+
+      //! Set outlier rejection threshold.
+      //! @param[in] k maximum distance to the median in units of
+      //! the (normal-consistent) median absolute deviation.
+      void
+      setThreshold(double k)
+      {
+        m_threshold = k;
+      }
+
+      //! Set minimum number of accepted beams for a valid estimate.
+      //! @param[in] beams minimum number of beams.
+      void
+      setMinimumBeams(unsigned beams)
+      {
+        m_min_beams = beams;
+      }
+
+      //! Get number of beams.
+      //! @return number of beams.
+      size_t
+      getSize(void) const
+      {
+        return m_range.size();
+      }
+
+      //! Invalidate all ranges.
+      void
+      clear(void);
+
+      //! Update the range of one beam.
+      //! @param[in] index beam index.
+      //! @param[in] range range (m).
+      void
+      updateBeam(size_t index, double range)
+      {
+        if (index < m_range.size())
+          m_range[index] = range;
+      }
+
+      //! Update the range of one beam.
+      //! @param[in] index beam index.
+      //! @param[in] msg distance measurement.
+      void
+      updateBeam(size_t index, const IMC::Distance& msg)
+      {
+        updateBeam(index, msg.validity == IMC::Distance::DV_VALID ? (double)msg.value : -1.0);
+      }
+
+      //! Update the ranges of all beams.
+      //! @param[in] ranges ranges (m), one per beam.
+      void
+      setRanges(const double* ranges);
+
+      //! Compute the seafloor estimate from the current ranges.
+      //! @return seafloor estimate.
+      const Estimate&
+      process(void);
+
+      //! Get last seafloor estimate.
+      //! @return seafloor estimate.
+      const Estimate&
+      getEstimate(void) const
+      {
+        return m_estimate;
+      }
+
+      //! Check if a beam was accepted in the last estimate.
+      //! @param[in] index beam index.
+      //! @return true if beam was accepted, false otherwise.
+      bool
+      isAccepted(size_t index) const
+      {
+        return index < m_weight.size() && m_weight[index] > 0.0;
+      }
+
+    private:
+      //! Ranges.
+      std::vector<double> m_range;
+      //! Cosine of beam angles.
+      std::vector<double> m_cos;
+      //! Sine of beam angles.
+      std::vector<double> m_sin;
+      //! Vertical distances.
+      std::vector<double> m_z;
+      //! Across track distances.
+      std::vector<double> m_y;
+      //! Beam weights (one if accepted, zero otherwise).
+      std::vector<double> m_weight;
+      //! Weighted across track distances.
+      std::vector<double> m_wy;
+      //! Scratch buffer for order statistics.
+      std::vector<double> m_scratch;
+      //! Minimum valid range.
+      double m_min_range;
+      //! Maximum valid range.
+      double m_max_range;
+      //! Outlier rejection threshold.
+      double m_threshold;
+      //! Minimum number of accepted beams.
+      unsigned m_min_beams;
+      //! Last estimate.
+      Estimate m_estimate;
+
+      //! Compute median of the first elements of the scratch buffer.
+      //! @param[in] count number of elements.
+      //! @return median.
+      double
+      median(size_t count);
+    };
+  }
+}
+
+#endif
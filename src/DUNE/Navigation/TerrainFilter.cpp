@@ -0,0 +1,340 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Math/Random/Factory.hpp>
+#include <DUNE/Navigation/TerrainFilter.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Number of particles evaluated at once.
+    static const unsigned c_block = 256;
+    //! Tiles kept resident by each map view.
+    static const unsigned c_cache_tiles = 16;
+    //! Squared normalized error charged for beams outside the map.
+    static const double c_missing_penalty = 9.0;
+
+    //! Helper thread computing the likelihood of a slice of the
+    //! particles.
+    class TerrainFilter::Worker: public Concurrency::Thread
+    {
+    public:
+      Worker(TerrainFilter& filter, const std::string& map):
+        m_filter(filter),
+        m_map(map, c_cache_tiles),
+        m_begin(0),
+        m_end(0)
+      { }
+
+      void
+      setRange(unsigned begin, unsigned end)
+      {
+        m_begin = begin;
+        m_end = end;
+      }
+
+    private:
+      TerrainFilter& m_filter;
+      Simulation::GriddedField m_map;
+      unsigned m_begin;
+      unsigned m_end;
+
+      void
+      run(void)
+      {
+        while (true)
+        {
+          m_filter.m_start->wait();
+          if (isStopping())
+            break;
+
+          m_filter.evaluate(m_map, m_begin, m_end);
+          m_filter.m_done->wait();
+        }
+      }
+    };
+
+    TerrainFilter::TerrainFilter(const std::string& map, unsigned particles, unsigned threads, int seed):
+      m_x(particles, 0.0),
+      m_y(particles, 0.0),
+      m_w(particles, 1.0 / particles),
+      m_ll(particles, 0.0),
+      m_tx(particles),
+      m_ty(particles),
+      m_start(NULL),
+      m_done(NULL),
+      m_beams(NULL),
+      m_beam_count(0),
+      m_depth(0.0),
+      m_sigma(1.0),
+      m_ess(particles),
+      m_resamplings(0)
+    {
+      m_map = new Simulation::GriddedField(map, c_cache_tiles);
+      m_prng = Math::Random::Factory::create(Math::Random::Factory::c_default, seed);
+
+      if (threads > particles)
+        threads = particles;
+
+      if (threads <= 1)
+        return;
+
+      m_start = new Concurrency::Barrier(threads);
+      m_done = new Concurrency::Barrier(threads);
+
+      unsigned slice = particles / threads;
+      for (unsigned i = 1; i < threads; ++i)
+      {
+        Worker* worker = new Worker(*this, map);
+        worker->setRange(i * slice, (i == threads - 1) ? particles : (i + 1) * slice);
+        worker->start();
+        m_workers.push_back(worker);
+      }
+    }
+
+    TerrainFilter::~TerrainFilter(void)
+    {
+      if (!m_workers.empty())
+      {
+        for (unsigned i = 0; i < m_workers.size(); ++i)
+          m_workers[i]->stop();
+
+        m_start->wait();
+
+        for (unsigned i = 0; i < m_workers.size(); ++i)
+        {
+          m_workers[i]->join();
+          delete m_workers[i];
+        }
+
+        delete m_start;
+        delete m_done;
+      }
+
+      delete m_prng;
+      delete m_map;
+    }
+
+    const Simulation::GriddedField::Layout&
+    TerrainFilter::getLayout(void) const
+    {
+      return m_map->getLayout();
+    }
+
+    void
+    TerrainFilter::initialize(double x, double y, double sigma)
+    {
+      unsigned n = m_x.size();
+      for (unsigned i = 0; i < n; ++i)
+      {
+        m_x[i] = x + sigma * m_prng->gaussian();
+        m_y[i] = y + sigma * m_prng->gaussian();
+        m_w[i] = 1.0 / n;
+      }
+
+      m_ess = n;
+    }
+
+    void
+    TerrainFilter::predict(double dx, double dy, double sigma)
+    {
+      unsigned n = m_x.size();
+      for (unsigned i = 0; i < n; ++i)
+      {
+        m_x[i] += dx + sigma * m_prng->gaussian();
+        m_y[i] += dy + sigma * m_prng->gaussian();
+      }
+    }
+
+    bool
+    TerrainFilter::update(const Beam* beams, unsigned count, double depth, double sigma)
+    {
+      if (count == 0)
+        return false;
+
+      m_beams = beams;
+      m_beam_count = count;
+      m_depth = depth;
+      m_sigma = sigma;
+
+      unsigned n = m_x.size();
+
+      if (m_workers.empty())
+      {
+        evaluate(*m_map, 0, n);
+      }
+      else
+      {
+        m_start->wait();
+        evaluate(*m_map, 0, n / (m_workers.size() + 1));
+        m_done->wait();
+      }
+
+      // Particles whose beams all fall outside the map carry no
+      // information: the update is void if no particle has data.
+      double max_ll = -std::numeric_limits<double>::infinity();
+      for (unsigned i = 0; i < n; ++i)
+      {
+        if (m_ll[i] > max_ll)
+          max_ll = m_ll[i];
+      }
+
+      if (max_ll <= -0.5 * c_missing_penalty * count)
+        return false;
+
+      double sum = 0.0;
+      for (unsigned i = 0; i < n; ++i)
+      {
+        m_w[i] *= std::exp(m_ll[i] - max_ll);
+        sum += m_w[i];
+      }
+
+      if (!(sum > 0.0))
+      {
+        // Weights underflowed: fall back to the likelihood alone.
+        sum = 0.0;
+        for (unsigned i = 0; i < n; ++i)
+        {
+          m_w[i] = std::exp(m_ll[i] - max_ll);
+          sum += m_w[i];
+        }
+      }
+
+      double sum_sq = 0.0;
+      for (unsigned i = 0; i < n; ++i)
+      {
+        m_w[i] /= sum;
+        sum_sq += m_w[i] * m_w[i];
+      }
+
+      m_ess = 1.0 / sum_sq;
+
+      if (m_ess < 0.5 * n)
+        resample();
+
+      return true;
+    }
+
+    void
+    TerrainFilter::getEstimate(double& x, double& y, double& var_x, double& var_y) const
+    {
+      x = 0.0;
+      y = 0.0;
+      for (unsigned i = 0; i < m_x.size(); ++i)
+      {
+        x += m_w[i] * m_x[i];
+        y += m_w[i] * m_y[i];
+      }
+
+      var_x = 0.0;
+      var_y = 0.0;
+      for (unsigned i = 0; i < m_x.size(); ++i)
+      {
+        var_x += m_w[i] * (m_x[i] - x) * (m_x[i] - x);
+        var_y += m_w[i] * (m_y[i] - y) * (m_y[i] - y);
+      }
+    }
+
+    void
+    TerrainFilter::evaluate(Simulation::GriddedField& map, unsigned begin, unsigned end)
+    {
+      double xs[c_block];
+      double ys[c_block];
+      double values[c_block];
+      bool valid[c_block];
+      double k = 0.5 / (m_sigma * m_sigma);
+
+      for (unsigned i = begin; i < end; i += c_block)
+      {
+        unsigned count = std::min(c_block, end - i);
+
+        for (unsigned j = 0; j < count; ++j)
+          m_ll[i + j] = 0.0;
+
+        for (unsigned b = 0; b < m_beam_count; ++b)
+        {
+          const Beam& beam = m_beams[b];
+          double seabed = m_depth + beam.z;
+
+          for (unsigned j = 0; j < count; ++j)
+          {
+            xs[j] = m_x[i + j] + beam.x;
+            ys[j] = m_y[i + j] + beam.y;
+          }
+
+          map.sample(xs, ys, NULL, count, values, valid);
+
+          for (unsigned j = 0; j < count; ++j)
+          {
+            if (valid[j])
+            {
+              double e = values[j] - seabed;
+              m_ll[i + j] -= std::min(k * e * e, 0.5 * c_missing_penalty);
+            }
+            else
+            {
+              m_ll[i + j] -= 0.5 * c_missing_penalty;
+            }
+          }
+        }
+      }
+    }
+
+    void
+    TerrainFilter::resample(void)
+    {
+      unsigned n = m_x.size();
+      double step = 1.0 / n;
+      double u = m_prng->uniform() * step;
+      double c = m_w[0];
+      unsigned j = 0;
+
+      for (unsigned i = 0; i < n; ++i)
+      {
+        while (u > c && j < n - 1)
+          c += m_w[++j];
+
+        m_tx[i] = m_x[j];
+        m_ty[i] = m_y[j];
+        u += step;
+      }
+
+      m_x.swap(m_tx);
+      m_y.swap(m_ty);
+      std::fill(m_w.begin(), m_w.end(), step);
+      ++m_resamplings;
+    }
+  }
+}
@@ -0,0 +1,201 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_TERRAIN_FILTER_HPP_INCLUDED_
+#define DUNE_NAVIGATION_TERRAIN_FILTER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Barrier.hpp>
+#include <DUNE/Math/Random/Generator.hpp>
+#include <DUNE/Simulation/GriddedField.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM TerrainFilter;
+
+    //! Terrain-aided navigation particle filter. Particles are
+    //! horizontal positions in the frame of a bathymetry map
+    //! (Simulation::GriddedField, depth positive down) and are
+    //! weighted by how well the map explains the seabed points hit by
+    //! acoustic beams (DVL beams, altimeter).
+    //!
+    //! Particles are stored as separate arrays of coordinates and
+    //! weights, and each beam is evaluated for a whole block of
+    //! particles at once. The likelihood can be split among several
+    //! threads: each one owns a view of the map with its own tile
+    //! cache, so threads never contend on the map while the memory
+    //! mapped tiles are shared by the operating system. Particles are
+    //! resampled systematically when the effective sample size drops
+    //! below half the number of particles.
+    class TerrainFilter
+    {
+    public:
+      //! Seabed point hit by a beam, relative to the vehicle.
+      struct Beam
+      {
+        //! North offset (m).
+        double x;
+        //! East offset (m).
+        double y;
+        //! Down offset (m).
+        double z;
+      };
+
+      //! Constructor.
+      //! @param[in] map path of the bathymetry map.
+      //! @param[in] particles number of particles.
+      //! @param[in] threads number of threads computing likelihoods.
+      //! @param[in] seed random number generator seed (-1 for a
+      //! time-based seed).
+      TerrainFilter(const std::string& map, unsigned particles, unsigned threads = 1, int seed = -1);
+
+      //! Destructor.
+      ~TerrainFilter(void);
+
+      //! Retrieve the geometry of the bathymetry map.
+      //! @return map geometry.
+      const Simulation::GriddedField::Layout&
+      getLayout(void) const;
+
+      //! Spread the particles around a position.
+      //! @param[in] x North position in the map frame (m).
+      //! @param[in] y East position in the map frame (m).
+      //! @param[in] sigma standard deviation of the spread (m).
+      void
+      initialize(double x, double y, double sigma);
+
+      //! Move the particles.
+      //! @param[in] dx North displacement (m).
+      //! @param[in] dy East displacement (m).
+      //! @param[in] sigma standard deviation of the displacement
+      //! error (m).
+      void
+      predict(double dx, double dy, double sigma);
+
+      //! Weight the particles with seabed measurements.
+      //! @param[in] beams seabed points relative to the vehicle.
+      //! @param[in] count number of beams.
+      //! @param[in] depth vehicle depth (m).
+      //! @param[in] sigma standard deviation of the seabed depth
+      //! error, including map error (m).
+      //! @return true if the particles were weighted, false if no
+      //! particle has map data under its beams.
+      bool
+      update(const Beam* beams, unsigned count, double depth, double sigma);
+
+      //! Compute the weighted mean and variance of the particles.
+      //! @param[out] x North position (m).
+      //! @param[out] y East position (m).
+      //! @param[out] var_x North variance (m^2).
+      //! @param[out] var_y East variance (m^2).
+      void
+      getEstimate(double& x, double& y, double& var_x, double& var_y) const;
+
+      //! Retrieve the effective sample size after the last update.
+      //! @return effective number of particles.
+      double
+      getEffectiveSize(void) const
+      {
+        return m_ess;
+      }
+
+      //! Retrieve the number of particles.
+      //! @return number of particles.
+      unsigned
+      getSize(void) const
+      {
+        return m_x.size();
+      }
+
+      //! Retrieve the number of resampling steps.
+      //! @return number of resampling steps.
+      unsigned
+      getResamplings(void) const
+      {
+        return m_resamplings;
+      }
+
+    private:
+      class Worker;
+
+      //! Particle coordinates (m).
+      std::vector<double> m_x, m_y;
+      //! Normalized particle weights.
+      std::vector<double> m_w;
+      //! Log-likelihood of each particle.
+      std::vector<double> m_ll;
+      //! Resampling workspace.
+      std::vector<double> m_tx, m_ty;
+      //! Map view of the calling thread.
+      Simulation::GriddedField* m_map;
+      //! Helper threads.
+      std::vector<Worker*> m_workers;
+      //! Barriers delimiting parallel likelihood evaluations.
+      Concurrency::Barrier* m_start;
+      Concurrency::Barrier* m_done;
+      //! Current update job.
+      const Beam* m_beams;
+      unsigned m_beam_count;
+      double m_depth;
+      double m_sigma;
+      //! Random number generator.
+      Math::Random::Generator* m_prng;
+      //! Effective sample size.
+      double m_ess;
+      //! Number of resampling steps.
+      unsigned m_resamplings;
+
+      //! Compute the log-likelihood of a range of particles.
+      //! @param[in] map map view.
+      //! @param[in] begin first particle.
+      //! @param[in] end one past the last particle.
+      void
+      evaluate(Simulation::GriddedField& map, unsigned begin, unsigned end);
+
+      //! Resample particles in proportion to their weights.
+      void
+      resample(void);
+
+      //! Non-copyable.
+      TerrainFilter(const TerrainFilter&);
+
+      //! Non-assignable.
+      TerrainFilter&
+      operator=(const TerrainFilter&);
+    };
+  }
+}
+
+#endif
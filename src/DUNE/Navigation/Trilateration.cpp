@@ -0,0 +1,191 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Navigation/Trilateration.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Maximum number of Gauss-Newton iterations per range.
+    static const unsigned c_max_iterations = 8;
+    //! Distance from the linearization point that triggers a new
+    //! linearization of the window (m).
+    static const double c_relinearize = 0.05;
+    //! Minimum number of ranges for a solution.
+    static const unsigned c_min_ranges = 3;
+    //! Smallest expected range used in the Jacobian (m).
+    static const double c_min_range = 1e-3;
+
+    Trilateration::Trilateration(unsigned window):
+      m_window(window),
+      m_scale(5.0),
+      m_depth(0)
+    {
+      reset(0, 0);
+    }
+
+    void
+    Trilateration::setWindow(unsigned window)
+    {
+      m_window = window;
+      while (m_entries.size() > m_window)
+        m_entries.pop_front();
+    }
+
+    void
+    Trilateration::reset(double x, double y)
+    {
+      m_entries.clear();
+      m_x = m_lin_x = x;
+      m_y = m_lin_y = y;
+      m_var_x = m_var_y = std::numeric_limits<double>::max();
+      m_relinearizations = 0;
+      m_solved = false;
+    }
+
+    double
+    Trilateration::getExpectedRange(double x, double y, double z) const
+    {
+      double dx = m_x - x;
+      double dy = m_y - y;
+      double dz = m_depth - z;
+      return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    bool
+    Trilateration::add(double x, double y, double z, double range)
+    {
+      Entry entry;
+      entry.x = x;
+      entry.y = y;
+      entry.z = z;
+      entry.range = range;
+      linearize(entry);
+
+      m_entries.push_back(entry);
+      if (m_entries.size() > m_window)
+        m_entries.pop_front();
+
+      if (m_entries.size() < c_min_ranges)
+        return false;
+
+      solve();
+      return m_solved;
+    }
+
+    void
+    Trilateration::linearize(Entry& entry) const
+    {
+      double dx = m_lin_x - entry.x;
+      double dy = m_lin_y - entry.y;
+      double dz = m_depth - entry.z;
+      entry.expected = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+      double r = std::max(entry.expected, c_min_range);
+      entry.jx = dx / r;
+      entry.jy = dy / r;
+    }
+
+    void
+    Trilateration::solve(void)
+    {
+      double dx = m_x - m_lin_x;
+      double dy = m_y - m_lin_y;
+
+      for (unsigned i = 0; i < c_max_iterations; ++i)
+      {
+        // Normal equations of the linearized problem, with Huber
+        // weights evaluated at the current offset.
+        double a00 = 0, a01 = 0, a11 = 0;
+        double b0 = 0, b1 = 0;
+        double sum = 0;
+        double weights = 0;
+
+        for (std::deque<Entry>::const_iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+        {
+          double res = itr->range - itr->expected;
+          double cur = res - itr->jx * dx - itr->jy * dy;
+          double w = (std::fabs(cur) <= m_scale) ? 1.0 : m_scale / std::fabs(cur);
+
+          a00 += w * itr->jx * itr->jx;
+          a01 += w * itr->jx * itr->jy;
+          a11 += w * itr->jy * itr->jy;
+          b0 += w * itr->jx * res;
+          b1 += w * itr->jy * res;
+          sum += w * cur * cur;
+          weights += w;
+        }
+
+        double det = a00 * a11 - a01 * a01;
+        if (std::fabs(det) < std::numeric_limits<double>::epsilon() * (a00 + a11) * (a00 + a11))
+          return;
+
+        double ndx = (a11 * b0 - a01 * b1) / det;
+        double ndy = (a00 * b1 - a01 * b0) / det;
+        double step = std::fabs(ndx - dx) + std::fabs(ndy - dy);
+        dx = ndx;
+        dy = ndy;
+
+        m_x = m_lin_x + dx;
+        m_y = m_lin_y + dy;
+
+        // Residual variance scales the inverse of the information.
+        double dof = m_entries.size() > 2 ? m_entries.size() - 2 : 1;
+        double sigma = sum / dof * (m_entries.size() / weights);
+        m_var_x = sigma * a11 / det;
+        m_var_y = sigma * a00 / det;
+        m_solved = true;
+
+        // Move the linearization point if the solution left its
+        // neighbourhood, otherwise reuse the cached Jacobian.
+        if (std::fabs(dx) > c_relinearize || std::fabs(dy) > c_relinearize)
+        {
+          m_lin_x = m_x;
+          m_lin_y = m_y;
+          dx = 0;
+          dy = 0;
+
+          for (std::deque<Entry>::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+            linearize(*itr);
+
+          ++m_relinearizations;
+          continue;
+        }
+
+        if (step < c_relinearize * 0.1)
+          break;
+      }
+    }
+  }
+}
@@ -0,0 +1,213 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_TRILATERATION_HPP_INCLUDED_
+#define DUNE_NAVIGATION_TRILATERATION_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Trilateration;
+
+    //! Sliding-window batch estimator of the horizontal position of
+    //! a point from ranges measured at known locations (anchors),
+    //! e.g., the position of an acoustic beacon from ranges measured
+    //! by a vehicle with GPS. The position is the nonlinear least
+    //! squares solution over the last ranges, with a Huber loss that
+    //! bounds the influence of outliers.
+    //!
+    //! Each range keeps its row of the geometry Jacobian, computed at
+    //! a linearization point that is only moved when the solution
+    //! drifts away from it, so adding a range usually costs a single
+    //! pass over the window without square roots.
+    class Trilateration
+    {
+    public:
+      //! Constructor.
+      //! @param[in] window maximum number of ranges in the window.
+      Trilateration(unsigned window = 32);
+
+      //! Set the maximum number of ranges in the window. Older
+      //! ranges are discarded.
+      //! @param[in] window maximum number of ranges.
+      void
+      setWindow(unsigned window);
+
+      //! Set the residual above which the loss grows linearly
+      //! instead of quadratically.
+      //! @param[in] scale Huber loss threshold (m).
+      void
+      setLossScale(double scale)
+      {
+        m_scale = scale;
+      }
+
+      //! Set the depth of the point being estimated.
+      //! @param[in] depth depth (m).
+      void
+      setDepth(double depth)
+      {
+        m_depth = depth;
+      }
+
+      //! Discard all ranges and restart from a given position.
+      //! @param[in] x initial North position (m).
+      //! @param[in] y initial East position (m).
+      void
+      reset(double x, double y);
+
+      //! Add a range to the window and update the solution.
+      //! @param[in] x North position of the anchor (m).
+      //! @param[in] y East position of the anchor (m).
+      //! @param[in] z depth of the anchor (m).
+      //! @param[in] range measured range (m).
+      //! @return true if enough ranges are available for a solution.
+      bool
+      add(double x, double y, double z, double range);
+
+      //! Compute the range expected from an anchor to the current
+      //! solution.
+      //! @param[in] x North position of the anchor (m).
+      //! @param[in] y East position of the anchor (m).
+      //! @param[in] z depth of the anchor (m).
+      //! @return expected range (m).
+      double
+      getExpectedRange(double x, double y, double z) const;
+
+      //! Retrieve the number of ranges in the window.
+      //! @return number of ranges.
+      unsigned
+      getSize(void) const
+      {
+        return m_entries.size();
+      }
+
+      //! Check if a solution was computed since the last reset.
+      //! @return true if a solution is available, false otherwise.
+      bool
+      hasSolution(void) const
+      {
+        return m_solved;
+      }
+
+      //! Retrieve the North position of the solution.
+      //! @return North position (m).
+      double
+      getX(void) const
+      {
+        return m_x;
+      }
+
+      //! Retrieve the East position of the solution.
+      //! @return East position (m).
+      double
+      getY(void) const
+      {
+        return m_y;
+      }
+
+      //! Retrieve the variance of the North position.
+      //! @return variance (m^2).
+      double
+      getVarianceX(void) const
+      {
+        return m_var_x;
+      }
+
+      //! Retrieve the variance of the East position.
+      //! @return variance (m^2).
+      double
+      getVarianceY(void) const
+      {
+        return m_var_y;
+      }
+
+      //! Retrieve the number of times the Jacobian was recomputed
+      //! for the whole window.
+      //! @return number of relinearizations.
+      unsigned
+      getRelinearizations(void) const
+      {
+        return m_relinearizations;
+      }
+
+    private:
+      //! Range measurement and its linearization.
+      struct Entry
+      {
+        //! Anchor position (m).
+        double x, y, z;
+        //! Measured range (m).
+        double range;
+        //! Range expected at the linearization point (m).
+        double expected;
+        //! Jacobian row at the linearization point.
+        double jx, jy;
+      };
+
+      //! Ranges in the window.
+      std::deque<Entry> m_entries;
+      //! Maximum number of ranges.
+      unsigned m_window;
+      //! Huber loss threshold (m).
+      double m_scale;
+      //! Depth of the estimated point (m).
+      double m_depth;
+      //! Solution (m).
+      double m_x, m_y;
+      //! Linearization point (m).
+      double m_lin_x, m_lin_y;
+      //! Solution variances (m^2).
+      double m_var_x, m_var_y;
+      //! Number of relinearizations.
+      unsigned m_relinearizations;
+      //! True if a solution is available.
+      bool m_solved;
+
+      //! Compute expected range and Jacobian row of an entry at the
+      //! linearization point.
+      //! @param[in,out] entry range entry.
+      void
+      linearize(Entry& entry) const;
+
+      //! Run Gauss-Newton iterations with iteratively reweighted
+      //! residuals.
+      void
+      solve(void);
+    };
+  }
+}
+
+#endif
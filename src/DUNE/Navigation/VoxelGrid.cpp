@@ -0,0 +1,224 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Navigation/VoxelGrid.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    //! Bits per packed cell index.
+    static const unsigned c_index_bits = 21;
+    //! Offset of packed cell indices.
+    static const int64_t c_index_offset = 1 << (c_index_bits - 1);
+    //! Mask of packed cell indices.
+    static const uint64_t c_index_mask = (1 << c_index_bits) - 1;
+    //! Depth index marking a horizontal cell.
+    static const int64_t c_column = c_index_offset - 1;
+    //! Initial number of hash table slots.
+    static const unsigned c_initial_slots = 1024;
+
+    VoxelGrid::VoxelGrid(double size, unsigned max_voxels):
+      m_size(size),
+      m_max_voxels(max_voxels)
+    {
+      clear();
+    }
+
+    void
+    VoxelGrid::clear(void)
+    {
+      Slot empty;
+      empty.key = 0;
+      empty.count = 0;
+      empty.changed = false;
+      empty.sx = empty.sy = empty.sz = 0.0;
+
+      m_slots.assign(c_initial_slots, empty);
+      m_voxels = 0;
+      m_changed = 0;
+      m_used = 0;
+      m_cursor = 0;
+    }
+
+    uint64_t
+    VoxelGrid::pack(int64_t i, int64_t j, int64_t k)
+    {
+      uint64_t key = (uint64_t)((i + c_index_offset) & c_index_mask);
+      key = (key << c_index_bits) | (uint64_t)((j + c_index_offset) & c_index_mask);
+      key = (key << c_index_bits) | (uint64_t)((k + c_index_offset) & c_index_mask);
+      return key + 1;
+    }
+
+    unsigned
+    VoxelGrid::find(uint64_t key) const
+    {
+      // Fibonacci hashing and linear probing.
+      unsigned mask = m_slots.size() - 1;
+      unsigned idx = (unsigned)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+
+      while (m_slots[idx].key != 0 && m_slots[idx].key != key)
+        idx = (idx + 1) & mask;
+
+      return idx;
+    }
+
+    void
+    VoxelGrid::grow(void)
+    {
+      std::vector<Slot> old;
+      old.swap(m_slots);
+
+      Slot empty = old[0];
+      empty.key = 0;
+      m_slots.assign(old.size() * 2, empty);
+
+      for (size_t i = 0; i < old.size(); ++i)
+      {
+        if (old[i].key != 0)
+          m_slots[find(old[i].key)] = old[i];
+      }
+
+      m_cursor = 0;
+    }
+
+    bool
+    VoxelGrid::add(double x, double y, double z)
+    {
+      int64_t i = (int64_t)std::floor(x / m_size);
+      int64_t j = (int64_t)std::floor(y / m_size);
+      int64_t k = (int64_t)std::floor(z / m_size);
+
+      // Keep load factor at or below one half.
+      if ((m_used + 2) * 2 > m_slots.size())
+        grow();
+
+      uint64_t key = pack(i, j, k);
+      unsigned idx = find(key);
+      Slot& voxel = m_slots[idx];
+
+      if (voxel.key == 0)
+      {
+        if (m_voxels >= m_max_voxels)
+          return false;
+
+        voxel.key = key;
+        ++m_voxels;
+        ++m_used;
+      }
+
+      voxel.count++;
+      voxel.sx += x;
+      voxel.sy += y;
+      voxel.sz += z;
+
+      if (!voxel.changed)
+      {
+        voxel.changed = true;
+        ++m_changed;
+      }
+
+      Slot& column = m_slots[find(pack(i, j, c_column))];
+      if (column.key == 0)
+      {
+        column.key = pack(i, j, c_column);
+        ++m_used;
+      }
+
+      column.count++;
+      column.sz += z;
+      return true;
+    }
+
+    bool
+    VoxelGrid::getDepth(double x, double y, double& depth) const
+    {
+      int64_t i = (int64_t)std::floor(x / m_size);
+      int64_t j = (int64_t)std::floor(y / m_size);
+
+      const Slot& column = m_slots[find(pack(i, j, c_column))];
+      if (column.key == 0)
+        return false;
+
+      depth = column.sz / column.count;
+      return true;
+    }
+
+    unsigned
+    VoxelGrid::takeChanged(std::vector<Point>& points, unsigned max)
+    {
+      unsigned taken = 0;
+      unsigned size = m_slots.size();
+
+      // Resume where the last search stopped, so that all voxels are
+      // eventually retrieved even if max is small.
+      for (unsigned n = 0; n < size && taken < max && m_changed > 0; ++n)
+      {
+        Slot& s = m_slots[m_cursor];
+        m_cursor = (m_cursor + 1) & (size - 1);
+
+        if (!s.changed)
+          continue;
+
+        Point p;
+        p.x = s.sx / s.count;
+        p.y = s.sy / s.count;
+        p.z = s.sz / s.count;
+        p.count = s.count;
+        points.push_back(p);
+
+        s.changed = false;
+        --m_changed;
+        ++taken;
+      }
+
+      return taken;
+    }
+
+    void
+    VoxelGrid::getPoints(std::vector<Point>& points) const
+    {
+      for (size_t n = 0; n < m_slots.size(); ++n)
+      {
+        const Slot& s = m_slots[n];
+        if (s.key == 0 || (((s.key - 1) & c_index_mask) == (uint64_t)(c_column + c_index_offset)))
+          continue;
+
+        Point p;
+        p.x = s.sx / s.count;
+        p.y = s.sy / s.count;
+        p.z = s.sz / s.count;
+        p.count = s.count;
+        points.push_back(p);
+      }
+    }
+  }
+}
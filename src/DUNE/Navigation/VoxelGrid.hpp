@@ -0,0 +1,186 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NAVIGATION_VOXEL_GRID_HPP_INCLUDED_
+#define DUNE_NAVIGATION_VOXEL_GRID_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Navigation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM VoxelGrid;
+
+    //! Sparse voxel grid of seafloor points in a local North-East-
+    //! Depth frame. Only voxels holding points are stored, in an
+    //! open addressing hash table, and each keeps the running sums
+    //! of its points, so adding a point costs one hash lookup and
+    //! memory grows with the surveyed area, not with the number of
+    //! points.
+    //!
+    //! The grid also keeps, per horizontal cell, the running mean of
+    //! the depth of all points in the cell, which answers bathymetry
+    //! queries with a single lookup. Voxels changed since they were
+    //! last retrieved are flagged, so decimated clouds can be sent
+    //! incrementally.
+    class VoxelGrid
+    {
+    public:
+      //! Centroid of the points of one voxel.
+      struct Point
+      {
+        //! North offset (m).
+        double x;
+        //! East offset (m).
+        double y;
+        //! Depth (m).
+        double z;
+        //! Number of points.
+        unsigned count;
+      };
+
+      //! Constructor.
+      //! @param[in] size voxel edge length (m).
+      //! @param[in] max_voxels maximum number of voxels; points
+      //! falling in new voxels beyond this limit are discarded.
+      VoxelGrid(double size, unsigned max_voxels = 1 << 20);
+
+      //! Remove all points.
+      void
+      clear(void);
+
+      //! Get voxel edge length.
+      //! @return voxel edge length (m).
+      double
+      getVoxelSize(void) const
+      {
+        return m_size;
+      }
+
+      //! Add a point.
+      //! @param[in] x North offset (m).
+      //! @param[in] y East offset (m).
+      //! @param[in] z depth (m).
+      //! @return true if point was added, false if the grid is full.
+      bool
+      add(double x, double y, double z);
+
+      //! Get number of voxels holding points.
+      //! @return number of voxels.
+      unsigned
+      getVoxels(void) const
+      {
+        return m_voxels;
+      }
+
+      //! Get number of changed voxels.
+      //! @return number of changed voxels.
+      unsigned
+      getChanged(void) const
+      {
+        return m_changed;
+      }
+
+      //! Get mean depth of the points in the horizontal cell of a
+      //! position.
+      //! @param[in] x North offset (m).
+      //! @param[in] y East offset (m).
+      //! @param[out] depth mean depth (m).
+      //! @return true if the cell has points, false otherwise.
+      bool
+      getDepth(double x, double y, double& depth) const;
+
+      //! Retrieve the centroids of changed voxels and clear their
+      //! change flags.
+      //! @param[out] points centroids (appended).
+      //! @param[in] max maximum number of centroids to retrieve.
+      //! @return number of centroids retrieved.
+      unsigned
+      takeChanged(std::vector<Point>& points, unsigned max);
+
+      //! Retrieve the centroids of all voxels.
+      //! @param[out] points centroids (appended).
+      void
+      getPoints(std::vector<Point>& points) const;
+
+    private:
+      //! Hash table slot.
+      struct Slot
+      {
+        //! Packed cell indices plus one (zero when empty).
+        uint64_t key;
+        //! Number of points.
+        uint32_t count;
+        //! True if changed since last retrieved.
+        bool changed;
+        //! Sums of point coordinates.
+        double sx, sy, sz;
+      };
+
+      //! Voxel edge length.
+      double m_size;
+      //! Maximum number of voxels.
+      unsigned m_max_voxels;
+      //! Number of voxels.
+      unsigned m_voxels;
+      //! Number of changed voxels.
+      unsigned m_changed;
+      //! Number of used slots (voxels and columns).
+      unsigned m_used;
+      //! Hash table (size is a power of two).
+      std::vector<Slot> m_slots;
+      //! Position of the next changed voxel search.
+      unsigned m_cursor;
+
+      //! Pack cell indices into a key.
+      //! @param[in] i north index.
+      //! @param[in] j east index.
+      //! @param[in] k depth index, or the column marker.
+      //! @return key.
+      static uint64_t
+      pack(int64_t i, int64_t j, int64_t k);
+
+      //! Find slot of a key.
+      //! @param[in] key key.
+      //! @return slot index, holding the key or empty.
+      unsigned
+      find(uint64_t key) const;
+
+      //! Double the capacity of the hash table.
+      void
+      grow(void);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,155 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Network/Interface.hpp>
+#include <DUNE/Network/InterfaceMonitor.hpp>
+
+#if defined(DUNE_SYS_HAS_LINUX_NETLINK_H) && defined(DUNE_SYS_HAS_LINUX_RTNETLINK_H)
+#  include <unistd.h>
+#  include <sys/socket.h>
+#  include <linux/netlink.h>
+#  include <linux/rtnetlink.h>
+#  define DUNE_NETWORK_USE_NETLINK
+#endif
+
+namespace DUNE
+{
+  namespace Network
+  {
+    InterfaceMonitor::InterfaceMonitor(void):
+      m_handle(-1),
+      m_first(true)
+    {
+#if defined(DUNE_NETWORK_USE_NETLINK)
+      m_handle = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+      if (m_handle == -1)
+        return;
+
+      sockaddr_nl sa;
+      std::memset(&sa, 0, sizeof(sa));
+      sa.nl_family = AF_NETLINK;
+      sa.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR;
+
+      if (bind(m_handle, (sockaddr*)&sa, sizeof(sa)) == -1)
+      {
+        close(m_handle);
+        m_handle = -1;
+      }
+#endif
+    }
+
+    InterfaceMonitor::~InterfaceMonitor(void)
+    {
+#if defined(DUNE_NETWORK_USE_NETLINK)
+      if (m_handle != -1)
+        close(m_handle);
+#endif
+    }
+
+    bool
+    InterfaceMonitor::changed(void)
+    {
+      if (m_handle != -1)
+      {
+        bool events = drain();
+        if (m_first)
+        {
+          m_first = false;
+          return true;
+        }
+
+        return events;
+      }
+
+      std::string current = snapshot();
+      if (!m_first && current == m_snapshot)
+        return false;
+
+      m_first = false;
+      m_snapshot = current;
+      return true;
+    }
+
+    bool
+    InterfaceMonitor::drain(void)
+    {
+      bool events = false;
+
+#if defined(DUNE_NETWORK_USE_NETLINK)
+      char bfr[4096];
+
+      while (true)
+      {
+        ssize_t rv = recv(m_handle, bfr, sizeof(bfr), MSG_DONTWAIT);
+        if (rv > 0)
+        {
+          events = true;
+          continue;
+        }
+
+        // Notifications were dropped: assume something changed.
+        if (rv == -1 && errno == ENOBUFS)
+        {
+          events = true;
+          continue;
+        }
+
+        if (rv == -1 && errno == EINTR)
+          continue;
+
+        break;
+      }
+#endif
+
+      return events;
+    }
+
+    std::string
+    InterfaceMonitor::snapshot(void)
+    {
+      std::string rv;
+      std::vector<Interface> itfs = Interface::get();
+      for (size_t i = 0; i < itfs.size(); ++i)
+      {
+        rv.append(itfs[i].name());
+        rv.append(" ");
+        rv.append(itfs[i].address().str());
+        rv.append(" ");
+        rv.append(itfs[i].broadcast().str());
+        rv.append(";");
+      }
+
+      return rv;
+    }
+  }
+}
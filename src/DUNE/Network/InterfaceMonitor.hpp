@@ -0,0 +1,98 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_NETWORK_INTERFACE_MONITOR_HPP_INCLUDED_
+#define DUNE_NETWORK_INTERFACE_MONITOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Network
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM InterfaceMonitor;
+
+    //! Detects changes to the set of network interfaces and their
+    //! addresses. On Linux the kernel notifies address and link
+    //! changes through a netlink socket, so testing for changes is a
+    //! non-blocking read; elsewhere the interface list is compared
+    //! against the one seen by the previous test.
+    class InterfaceMonitor
+    {
+    public:
+      //! Constructor.
+      InterfaceMonitor(void);
+
+      //! Destructor.
+      ~InterfaceMonitor(void);
+
+      //! Test if interfaces changed since the previous call. The
+      //! first call always returns true.
+      //! @return true if interfaces may have changed, false otherwise.
+      bool
+      changed(void);
+
+      //! Test if changes are reported by the operating system.
+      //! @return true if change events are used, false if the
+      //! interface list is polled.
+      bool
+      isEventDriven(void) const
+      {
+        return m_handle != -1;
+      }
+
+    private:
+      //! Netlink socket or -1.
+      int m_handle;
+      //! True until the first call to changed().
+      bool m_first;
+      //! Summary of the interface list, when polling.
+      std::string m_snapshot;
+
+      //! Drain pending netlink notifications.
+      //! @return true if there was at least one notification.
+      bool
+      drain(void);
+
+      //! Build a summary of the current interface list.
+      //! @return interface list summary.
+      static std::string
+      snapshot(void);
+
+      // Non-copyable.
+      InterfaceMonitor(const InterfaceMonitor&);
+      InterfaceMonitor& operator=(const InterfaceMonitor&);
+    };
+  }
+}
+
+#endif
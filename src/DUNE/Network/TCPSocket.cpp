@@ -26,6 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 #include <iostream>
@@ -100,6 +101,10 @@
 #  define ECONNRESET WSAECONNRESET
 #endif
 
+#if !defined(EWOULDBLOCK)
+#  define EWOULDBLOCK EAGAIN
+#endif
+
 static const unsigned c_block_size = 128 * 1024;
 
 static inline std::string
@@ -119,7 +124,8 @@ namespace DUNE
   namespace Network
   {
     TCPSocket::TCPSocket(bool create):
-      m_handle(INVALID_SOCKET)
+      m_handle(INVALID_SOCKET),
+      m_non_blocking(false)
     {
       if (create)
       {
@@ -194,7 +200,7 @@ namespace DUNE
       socklen_t size = sizeof(addr);
       int rv = ::accept(m_handle, (sockaddr*)&addr, &size);
 
-      if (rv == 0)
+      if (rv < 0)
         throw NetworkError(DTR("failed to accept connection"), getLastErrorMessage());
 
       if (a)
@@ -222,6 +228,8 @@ namespace DUNE
       {
         if (errno == ECONNRESET)
           throw ConnectionClosed();
+        if (m_non_blocking && (errno == EAGAIN || errno == EWOULDBLOCK))
+          return 0;
         throw NetworkError(DTR("error receiving data"), getLastErrorMessage());
       }
 
@@ -241,8 +249,10 @@ namespace DUNE
 
       if (rv < 0)
       {
-        if (errno == EPIPE)
+        if (errno == EPIPE || errno == ECONNRESET)
           throw ConnectionClosed();
+        if (m_non_blocking && (errno == EAGAIN || errno == EWOULDBLOCK))
+          return 0;
         throw NetworkError(DTR("error sending data"), getLastErrorMessage());
       }
 
@@ -352,6 +362,100 @@ namespace DUNE
         throw NetworkError(DTR("unable to set send timeout"), getLastErrorMessage());
     }
 
+    void
+    TCPSocket::setNonBlocking(bool enabled)
+    {
+#if defined(DUNE_OS_WINDOWS)
+      u_long mode = enabled ? 1 : 0;
+      if (ioctlsocket(m_handle, FIONBIO, &mode) != 0)
+        throw NetworkError(DTR("unable to set non-blocking mode"), getLastErrorMessage());
+#else
+      int flags = fcntl(m_handle, F_GETFL, 0);
+      if (flags == -1)
+        throw NetworkError(DTR("unable to set non-blocking mode"), getLastErrorMessage());
+
+      if (enabled)
+        flags |= O_NONBLOCK;
+      else
+        flags &= ~O_NONBLOCK;
+
+      if (fcntl(m_handle, F_SETFL, flags) == -1)
+        throw NetworkError(DTR("unable to set non-blocking mode"), getLastErrorMessage());
+#endif
+
+      m_non_blocking = enabled;
+    }
+
+    void
+    TCPSocket::setCork(bool enabled)
+    {
+#if defined(TCP_CORK)
+      int set = enabled ? 1 : 0;
+      setsockopt(m_handle, IPPROTO_TCP, TCP_CORK, (char*)&set, sizeof(set));
+#else
+      (void)enabled;
+#endif
+    }
+
+    size_t
+    TCPSocket::writeVector(const uint8_t* const* bfrs, const size_t* sizes, unsigned count)
+    {
+#if defined(DUNE_OS_POSIX)
+      static const unsigned c_max_iov = 64;
+      iovec iov[c_max_iov];
+      size_t total = 0;
+
+      for (unsigned i = 0; i < count; i += c_max_iov)
+      {
+        unsigned n = std::min(c_max_iov, count - i);
+        size_t size = 0;
+        for (unsigned j = 0; j < n; ++j)
+        {
+          iov[j].iov_base = (void*)bfrs[i + j];
+          iov[j].iov_len = sizes[i + j];
+          size += sizes[i + j];
+        }
+
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = n;
+
+        int flags = 0;
+#if defined(MSG_NOSIGNAL)
+        flags = MSG_NOSIGNAL;
+#endif
+
+        ssize_t rv = ::sendmsg(m_handle, &msg, flags);
+        if (rv < 0)
+        {
+          if (errno == EPIPE || errno == ECONNRESET)
+            throw ConnectionClosed();
+          if (m_non_blocking && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return total;
+          throw NetworkError(DTR("error sending data"), getLastErrorMessage());
+        }
+
+        total += rv;
+        if ((size_t)rv < size)
+          break;
+      }
+
+      return total;
+#else
+      size_t total = 0;
+      for (unsigned i = 0; i < count; ++i)
+      {
+        size_t rv = doWrite(bfrs[i], sizes[i]);
+        total += rv;
+        if (rv < sizes[i])
+          break;
+      }
+
+      return total;
+#endif
+    }
+
     Address
     TCPSocket::getBoundAddress(void)
     {
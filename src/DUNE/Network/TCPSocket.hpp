@@ -101,6 +101,32 @@ namespace DUNE
       void
       setSendTimeout(double timeout);
 
+      //! Enable/disable non-blocking mode. When enabled, read and
+      //! write operations that would block return zero instead.
+      //! @param[in] enabled true to enable non-blocking mode, false
+      //! to disable.
+      void
+      setNonBlocking(bool enabled);
+
+      //! Enable/disable corking. While enabled, partial segments are
+      //! held until the option is disabled (or a full segment is
+      //! available), so that several writes leave as few segments.
+      //! This is only supported on Linux and is ignored elsewhere.
+      //! @param[in] enabled true to cork, false to uncork.
+      void
+      setCork(bool enabled);
+
+      //! Write several buffers with a single system call (gathered
+      //! write).
+      //! @param[in] bfrs buffers.
+      //! @param[in] sizes size of each buffer.
+      //! @param[in] count number of buffers.
+      //! @return number of bytes written; in non-blocking mode this
+      //! may be less than the total, or zero if the write would
+      //! block.
+      size_t
+      writeVector(const uint8_t* const* bfrs, const size_t* sizes, unsigned count);
+
       Address
       getBoundAddress(void);
 
@@ -115,6 +141,8 @@ namespace DUNE
 #else
       int m_handle;
 #endif
+      //! True if operations must not block.
+      bool m_non_blocking;
 
       IO::NativeHandle
       doGetNative(void) const;
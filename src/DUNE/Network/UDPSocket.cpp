@@ -27,6 +27,8 @@
 
 // ISO C++ 98 headers.
 #include <cerrno>
+#include <cstring>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
@@ -91,8 +93,31 @@ namespace DUNE
 {
   namespace Network
   {
+#if defined(SO_TIMESTAMPNS)
+    //! Extract the kernel receive timestamp of a datagram.
+    //! @param[in] msg received message header.
+    //! @return reception time in seconds since the UNIX Epoch or -1
+    //! if the message carries no timestamp.
+    static double
+    getTimeStamp(msghdr* msg)
+    {
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+      {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPNS)
+          continue;
+
+        timespec ts;
+        std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+      }
+
+      return -1;
+    }
+#endif
+
     UDPSocket::UDPSocket(void):
-      m_con_port(0)
+      m_con_port(0),
+      m_tstamps(false)
     {
       //  POSIX / Win32
 #if defined(DUNE_SYS_HAS_SOCKET)
@@ -141,6 +166,19 @@ namespace DUNE
       setsockopt(m_handle, SOL_SOCKET, SO_BROADCAST, (char*)&on, sizeof(int));
     }
 
+    bool
+    UDPSocket::enableTimeStamps(bool value)
+    {
+#if defined(SO_TIMESTAMPNS)
+      int on = value ? 1 : 0;
+      int rv = setsockopt(m_handle, SOL_SOCKET, SO_TIMESTAMPNS, (char*)&on, sizeof(int));
+      m_tstamps = value && (rv == 0);
+#else
+      (void)value;
+#endif
+      return m_tstamps;
+    }
+
     void
     UDPSocket::setMulticastTTL(uint8_t value)
     {
@@ -191,7 +229,35 @@ namespace DUNE
       socklen_t sock_len = sizeof(host);
       std::memset((char*)&host, 0, sock_len);
 
-      int rv = recvfrom(m_handle, (char*)buffer, size, 0, (::sockaddr*)&host, (::socklen_t*)&sock_len);
+      int rv = 0;
+      double tstamp = -1;
+
+#if defined(SO_TIMESTAMPNS)
+      if (m_tstamps)
+      {
+        char control[CMSG_SPACE(sizeof(timespec))];
+        iovec iov;
+        iov.iov_base = buffer;
+        iov.iov_len = size;
+
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &host;
+        msg.msg_namelen = sock_len;
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        rv = recvmsg(m_handle, &msg, 0);
+        if (rv > 0)
+          tstamp = getTimeStamp(&msg);
+      }
+      else
+#endif
+      {
+        rv = recvfrom(m_handle, (char*)buffer, size, 0, (::sockaddr*)&host, (::socklen_t*)&sock_len);
+      }
 
       if (rv <= 0)
         throw NetworkError(DTR("error receiving data"), DUNE_SOCKET_ERROR);
@@ -199,9 +265,70 @@ namespace DUNE
       if (addr != NULL)
         *addr = (::sockaddr*)&host;
 
+      setReadTimeStamp(tstamp < 0 ? Time::Clock::getSinceEpoch() : tstamp);
       return rv;
     }
 
+    unsigned
+    UDPSocket::read(uint8_t* buffers, size_t size, unsigned count, size_t* sizes, Address* addrs)
+    {
+#if defined(DUNE_SYS_HAS_RECVMMSG)
+      static const unsigned c_max_dgrams = 64;
+      sockaddr_in sais[c_max_dgrams];
+      iovec iovs[c_max_dgrams];
+      mmsghdr msgs[c_max_dgrams];
+
+      count = std::min(count, c_max_dgrams);
+      std::memset(msgs, 0, sizeof(msgs));
+
+#  if defined(SO_TIMESTAMPNS)
+      // Only the arrival time of the first datagram is reported.
+      char control[CMSG_SPACE(sizeof(timespec))];
+      if (m_tstamps)
+      {
+        msgs[0].msg_hdr.msg_control = control;
+        msgs[0].msg_hdr.msg_controllen = sizeof(control);
+      }
+#  endif
+
+      for (unsigned i = 0; i < count; ++i)
+      {
+        iovs[i].iov_base = buffers + i * size;
+        iovs[i].iov_len = size;
+        msgs[i].msg_hdr.msg_name = &sais[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(sais[i]);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      int rv = recvmmsg(m_handle, msgs, count, MSG_WAITFORONE, NULL);
+
+      if (rv <= 0)
+        throw NetworkError(DTR("error receiving data"), DUNE_SOCKET_ERROR);
+
+      for (int i = 0; i < rv; ++i)
+      {
+        sizes[i] = msgs[i].msg_len;
+        addrs[i] = (::sockaddr*)&sais[i];
+      }
+
+      double tstamp = -1;
+#  if defined(SO_TIMESTAMPNS)
+      if (m_tstamps)
+        tstamp = getTimeStamp(&msgs[0].msg_hdr);
+#  endif
+      setReadTimeStamp(tstamp < 0 ? Time::Clock::getSinceEpoch() : tstamp);
+
+      return rv;
+#else
+      if (count == 0)
+        return 0;
+
+      sizes[0] = read(buffers, size, &addrs[0]);
+      return 1;
+#endif
+    }
+
     size_t
     UDPSocket::write(const uint8_t* buffer, size_t size, const Address& host, uint16_t port)
     {
@@ -227,6 +354,96 @@ namespace DUNE
       return rv;
     }
 
+    unsigned
+    UDPSocket::write(const uint8_t* buffer, size_t size, const std::vector<Destination>& dsts)
+    {
+      return writeVector(&buffer, &size, 1, dsts);
+    }
+
+    unsigned
+    UDPSocket::writeVector(const uint8_t* const* bfrs, const size_t* sizes, unsigned count,
+                           const std::vector<Destination>& dsts)
+    {
+      unsigned sent = 0;
+      if (count == 0)
+        return sent;
+
+#if defined(DUNE_SYS_HAS_SENDMMSG)
+      static const unsigned c_max_dsts = 64;
+      static const unsigned c_max_iov = 64;
+      sockaddr_in sais[c_max_dsts];
+      mmsghdr msgs[c_max_dsts];
+      iovec iov[c_max_iov];
+
+      if (count > c_max_iov)
+        throw NetworkError(DTR("error sending data"), DTR("too many buffers"));
+
+      for (unsigned i = 0; i < count; ++i)
+      {
+        iov[i].iov_base = (void*)bfrs[i];
+        iov[i].iov_len = sizes[i];
+      }
+
+      for (unsigned i = 0; i < dsts.size(); i += c_max_dsts)
+      {
+        unsigned n = std::min(c_max_dsts, (unsigned)dsts.size() - i);
+        std::memset(msgs, 0, sizeof(msgs));
+
+        for (unsigned j = 0; j < n; ++j)
+        {
+          sais[j].sin_family = AF_INET;
+          sais[j].sin_port = Utils::ByteCopy::toBE(dsts[i + j].port);
+          sais[j].sin_addr.s_addr = dsts[i + j].addr.toInteger();
+          msgs[j].msg_hdr.msg_name = &sais[j];
+          msgs[j].msg_hdr.msg_namelen = sizeof(sais[j]);
+          msgs[j].msg_hdr.msg_iov = iov;
+          msgs[j].msg_hdr.msg_iovlen = count;
+        }
+
+        // sendmmsg() stops at the first failed destination.
+        unsigned done = 0;
+        while (done < n)
+        {
+          int rv = sendmmsg(m_handle, msgs + done, n - done, 0);
+          if (rv <= 0)
+          {
+            ++done;
+            continue;
+          }
+
+          sent += rv;
+          done += rv;
+        }
+      }
+#else
+      const uint8_t* buffer = bfrs[0];
+      size_t size = sizes[0];
+      std::vector<uint8_t> data;
+
+      if (count > 1)
+      {
+        for (unsigned i = 0; i < count; ++i)
+          data.insert(data.end(), bfrs[i], bfrs[i] + sizes[i]);
+
+        buffer = data.empty() ? NULL : &data[0];
+        size = data.size();
+      }
+
+      for (unsigned i = 0; i < dsts.size(); ++i)
+      {
+        try
+        {
+          write(buffer, size, dsts[i].addr, dsts[i].port);
+          ++sent;
+        }
+        catch (...)
+        { }
+      }
+#endif
+
+      return sent;
+    }
+
     void
     UDPSocket::createEventHandle(void)
     {
@@ -28,6 +28,9 @@
 #ifndef DUNE_NETWORK_UDP_SOCKET_HPP_INCLUDED_
 #define DUNE_NETWORK_UDP_SOCKET_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/IO/Handle.hpp>
@@ -58,6 +61,15 @@ namespace DUNE
       void
       enableBroadcast(bool value);
 
+      //! Ask the kernel to record the arrival time of each datagram
+      //! (SO_TIMESTAMPNS). When enabled, getReadTimeStamp() reports
+      //! the arrival time of the last datagram read instead of the
+      //! time at which the read returned.
+      //! @param value true to enable kernel timestamps.
+      //! @return true if kernel timestamps are enabled.
+      bool
+      enableTimeStamps(bool value);
+
       void
       setMulticastTTL(uint8_t ttl = 1);
 
@@ -86,6 +98,41 @@ namespace DUNE
       size_t
       write(const uint8_t* buffer, size_t size, const Address& addr, uint16_t port);
 
+      //! Datagram destination.
+      struct Destination
+      {
+        //! Address.
+        Address addr;
+        //! Port.
+        uint16_t port;
+
+        Destination(const Address& a, uint16_t p):
+          addr(a),
+          port(p)
+        { }
+      };
+
+      //! Send one datagram to several destinations. Destinations
+      //! that cannot be reached are skipped.
+      //! @param[in] buffer datagram.
+      //! @param[in] size datagram size.
+      //! @param[in] dsts list of destinations.
+      //! @return number of destinations to which the datagram was sent.
+      unsigned
+      write(const uint8_t* buffer, size_t size, const std::vector<Destination>& dsts);
+
+      //! Send one datagram, gathered from several buffers, to several
+      //! destinations. Destinations that cannot be reached are
+      //! skipped.
+      //! @param[in] bfrs buffers.
+      //! @param[in] sizes size of each buffer.
+      //! @param[in] count number of buffers (at most 64).
+      //! @param[in] dsts list of destinations.
+      //! @return number of destinations to which the datagram was sent.
+      unsigned
+      writeVector(const uint8_t* const* bfrs, const size_t* sizes, unsigned count,
+                  const std::vector<Destination>& dsts);
+
       //! Receive an UDP datagram, retrieving the address
       //! of the source host.
       //! @param buffer destination buffer.
@@ -94,6 +141,19 @@ namespace DUNE
       size_t
       read(uint8_t* buffer, size_t size, Address* addr = NULL);
 
+      //! Read several datagrams. This function blocks until at least
+      //! one datagram is available and then returns the datagrams
+      //! that are already queued, up to a given count.
+      //! @param[out] buffers array of count buffers, each with size
+      //! bytes.
+      //! @param[in] size size of each buffer.
+      //! @param[in] count number of buffers.
+      //! @param[out] sizes size of each datagram.
+      //! @param[out] addrs source address of each datagram.
+      //! @return number of datagrams read.
+      unsigned
+      read(uint8_t* buffers, size_t size, unsigned count, size_t* sizes, Address* addrs);
+
     private:
       //! Platform specific handle.
 #if defined(DUNE_OS_WINDOWS)
@@ -107,6 +167,8 @@ namespace DUNE
       Address m_con_addr;
       //! Connected port.
       unsigned m_con_port;
+      //! True if kernel receive timestamps are enabled.
+      bool m_tstamps;
 
       IO::NativeHandle
       doGetNative(void) const
@@ -36,7 +36,9 @@ namespace DUNE
 }
 
 #include <DUNE/Parsers/Config.hpp>
+#include <DUNE/Parsers/ConfigCache.hpp>
 #include <DUNE/Parsers/PD4.hpp>
+#include <DUNE/Parsers/UBX.hpp>
 #include <DUNE/Parsers/NMEAReader.hpp>
 #include <DUNE/Parsers/NMEAWriter.hpp>
 #include <DUNE/Parsers/AbstractStringReader.hpp>
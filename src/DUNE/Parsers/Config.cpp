@@ -98,6 +98,7 @@ namespace DUNE
             }
             catch (FileOpenError& e)
             {
+              m_missing.push_back(path.str());
               DUNE_WRN("Config", e.what());
             }
           }
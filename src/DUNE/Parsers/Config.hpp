@@ -189,6 +189,10 @@ namespace DUNE
       Sections m_data;
       //! List of parsed files.
       std::vector<std::string> m_files;
+      //! List of included files that could not be opened.
+      std::vector<std::string> m_missing;
+
+      friend class ConfigCache;
 
       // Non - copyable.
       Config(const Config&);
@@ -0,0 +1,370 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Algorithms/MD5.hpp>
+#include <DUNE/FileSystem/Path.hpp>
+#include <DUNE/Parsers/ConfigCache.hpp>
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+#  include <sys/mman.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    using FileSystem::Path;
+
+    //! Cache file signature.
+    static const char c_magic[4] = {'D', 'C', 'F', 'G'};
+    //! Cache format version.
+    static const uint32_t c_format = 1;
+    //! Size of the header (signature and format version).
+    static const size_t c_header_size = 8;
+    //! Size of the MD5 digest.
+    static const size_t c_digest_size = 16;
+
+    //! Bounds checked reader of cache contents.
+    class CacheReader
+    {
+    public:
+      CacheReader(const uint8_t* data, size_t size):
+        m_ptr(data),
+        m_end(data + size)
+      { }
+
+      bool
+      get(uint32_t& value)
+      {
+        return copy(&value, sizeof(value));
+      }
+
+      bool
+      get(int64_t& value)
+      {
+        return copy(&value, sizeof(value));
+      }
+
+      bool
+      get(std::string& value)
+      {
+        uint32_t size = 0;
+        if (!get(size) || size > (size_t)(m_end - m_ptr))
+          return false;
+
+        value.assign((const char*)m_ptr, size);
+        m_ptr += size;
+        return true;
+      }
+
+      bool
+      done(void) const
+      {
+        return m_ptr == m_end;
+      }
+
+    private:
+      const uint8_t* m_ptr;
+      const uint8_t* m_end;
+
+      bool
+      copy(void* dst, size_t size)
+      {
+        if (size > (size_t)(m_end - m_ptr))
+          return false;
+
+        std::memcpy(dst, m_ptr, size);
+        m_ptr += size;
+        return true;
+      }
+    };
+
+    static void
+    put(std::string& bfr, uint32_t value)
+    {
+      bfr.append((const char*)&value, sizeof(value));
+    }
+
+    static void
+    put(std::string& bfr, int64_t value)
+    {
+      bfr.append((const char*)&value, sizeof(value));
+    }
+
+    static void
+    put(std::string& bfr, const std::string& value)
+    {
+      put(bfr, (uint32_t)value.size());
+      bfr.append(value);
+    }
+
+    //! Check if a file still has the recorded modification time and
+    //! size.
+    static bool
+    isUnchanged(const std::string& fname, int64_t mtime, int64_t size)
+    {
+      Path path(fname);
+      return (int64_t)path.size() == size
+        && (int64_t)path.getLastModifiedTime() == mtime;
+    }
+
+    //! Decode and validate the contents of a cache file.
+    static bool
+    decode(const uint8_t* data, size_t size, const std::string& fname, Config& cfg,
+           std::vector<std::string>& files, std::vector<std::string>& missing)
+    {
+      if (size < c_header_size + c_digest_size)
+        return false;
+
+      uint32_t format = 0;
+      std::memcpy(&format, data + sizeof(c_magic), sizeof(format));
+      if (std::memcmp(data, c_magic, sizeof(c_magic)) != 0 || format != c_format)
+        return false;
+
+      const uint8_t* body = data + c_header_size;
+      size_t body_size = size - c_header_size - c_digest_size;
+
+      uint8_t digest[c_digest_size];
+      Algorithms::MD5::compute(body, body_size, digest);
+      if (std::memcmp(digest, body + body_size, c_digest_size) != 0)
+        return false;
+
+      CacheReader rd(body, body_size);
+
+      // Configuration file.
+      std::string main;
+      if (!rd.get(main) || main != fname)
+        return false;
+
+      // Source files.
+      uint32_t count = 0;
+      if (!rd.get(count))
+        return false;
+
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        std::string file;
+        int64_t mtime = 0;
+        int64_t fsize = 0;
+        if (!rd.get(file) || !rd.get(mtime) || !rd.get(fsize))
+          return false;
+
+        if (!isUnchanged(file, mtime, fsize))
+          return false;
+
+        files.push_back(file);
+      }
+
+      // Included files that were missing.
+      if (!rd.get(count))
+        return false;
+
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        std::string file;
+        if (!rd.get(file) || Path(file).exists())
+          return false;
+
+        missing.push_back(file);
+      }
+
+      // Sections.
+      if (!rd.get(count))
+        return false;
+
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        std::string section;
+        uint32_t options = 0;
+        if (!rd.get(section) || !rd.get(options))
+          return false;
+
+        for (uint32_t j = 0; j < options; ++j)
+        {
+          std::string option;
+          std::string value;
+          if (!rd.get(option) || !rd.get(value))
+            return false;
+
+          cfg.set(section, option, value);
+        }
+      }
+
+      return rd.done();
+    }
+
+    bool
+    ConfigCache::load(const std::string& fname, const std::string& cache, Config& cfg)
+    {
+      if (read(fname, cache, cfg))
+        return true;
+
+      cfg.parseFile(fname.c_str());
+      write(cfg, cache);
+      return false;
+    }
+
+    bool
+    ConfigCache::read(const std::string& fname, const std::string& cache, Config& cfg)
+    {
+      Path path(cache);
+      int64_t size = path.size();
+      if (size <= 0 || size != (int64_t)(size_t)size)
+        return false;
+
+      Config tmp;
+      std::vector<std::string> files;
+      std::vector<std::string> missing;
+      bool valid = false;
+
+#if defined(DUNE_SYS_HAS_MMAP)
+      int fd = open(cache.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+
+      void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+
+      if (ptr == MAP_FAILED)
+        return false;
+
+      valid = decode((const uint8_t*)ptr, size, fname, tmp, files, missing);
+      munmap(ptr, size);
+#else
+      std::ifstream ifs(cache.c_str(), std::ios::binary);
+      std::vector<char> data(size);
+      if (!ifs.read(&data[0], size))
+        return false;
+
+      valid = decode((const uint8_t*)&data[0], size, fname, tmp, files, missing);
+#endif
+
+      if (!valid)
+        return false;
+
+      Config::Sections::const_iterator sitr = tmp.m_data.begin();
+      for (; sitr != tmp.m_data.end(); ++sitr)
+      {
+        Config::Section::const_iterator oitr = sitr->second.begin();
+        for (; oitr != sitr->second.end(); ++oitr)
+          cfg.set(sitr->first, oitr->first, oitr->second);
+      }
+
+      cfg.m_files.insert(cfg.m_files.end(), files.begin(), files.end());
+      cfg.m_missing.insert(cfg.m_missing.end(), missing.begin(), missing.end());
+      return true;
+    }
+
+    bool
+    ConfigCache::write(const Config& cfg, const std::string& cache)
+    {
+      if (cfg.m_files.empty())
+        return false;
+
+      std::string bfr;
+
+      // The configuration file is the last one to be completely parsed.
+      put(bfr, cfg.m_files.back());
+
+      put(bfr, (uint32_t)cfg.m_files.size());
+      for (size_t i = 0; i < cfg.m_files.size(); ++i)
+      {
+        Path path(cfg.m_files[i]);
+        put(bfr, cfg.m_files[i]);
+        put(bfr, (int64_t)path.getLastModifiedTime());
+        put(bfr, (int64_t)path.size());
+      }
+
+      put(bfr, (uint32_t)cfg.m_missing.size());
+      for (size_t i = 0; i < cfg.m_missing.size(); ++i)
+        put(bfr, cfg.m_missing[i]);
+
+      put(bfr, (uint32_t)cfg.m_data.size());
+      Config::Sections::const_iterator sitr = cfg.m_data.begin();
+      for (; sitr != cfg.m_data.end(); ++sitr)
+      {
+        put(bfr, sitr->first);
+        put(bfr, (uint32_t)sitr->second.size());
+
+        Config::Section::const_iterator oitr = sitr->second.begin();
+        for (; oitr != sitr->second.end(); ++oitr)
+        {
+          put(bfr, oitr->first);
+          put(bfr, oitr->second);
+        }
+      }
+
+      uint8_t digest[c_digest_size];
+      Algorithms::MD5::compute((const uint8_t*)bfr.data(), bfr.size(), digest);
+
+      // Write to a temporary file and rename it, so that readers
+      // never see a partial cache.
+      std::string tmp = cache + ".tmp";
+      {
+        std::ofstream ofs(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open())
+          return false;
+
+        ofs.write(c_magic, sizeof(c_magic));
+        ofs.write((const char*)&c_format, sizeof(c_format));
+        ofs.write(bfr.data(), bfr.size());
+        ofs.write((const char*)digest, sizeof(digest));
+
+        if (!ofs.good())
+        {
+          ofs.close();
+          std::remove(tmp.c_str());
+          return false;
+        }
+      }
+
+      if (std::rename(tmp.c_str(), cache.c_str()) != 0)
+      {
+        std::remove(tmp.c_str());
+        return false;
+      }
+
+      return true;
+    }
+  }
+}
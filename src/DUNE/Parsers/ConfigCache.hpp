@@ -0,0 +1,85 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_PARSERS_CONFIG_CACHE_HPP_INCLUDED_
+#define DUNE_PARSERS_CONFIG_CACHE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Parsers/Config.hpp>
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM ConfigCache;
+
+    //! Binary cache of parsed configuration files. The cache holds
+    //! all sections and options of a configuration, after requires,
+    //! includes and references were resolved, together with the
+    //! modification time and size of every file that was read (and
+    //! of every missing included file). A cache is only loaded if
+    //! none of those files changed and its MD5 digest matches, so
+    //! parsing the text files always remains the fallback.
+    class ConfigCache
+    {
+    public:
+      //! Load a configuration, using the cache if it is up to date
+      //! and refreshing it otherwise. Failures to read or write the
+      //! cache are not errors.
+      //! @param[in] fname configuration file.
+      //! @param[in] cache cache file.
+      //! @param[out] cfg configuration.
+      //! @return true if the configuration was loaded from the
+      //! cache, false if it was parsed.
+      static bool
+      load(const std::string& fname, const std::string& cache, Config& cfg);
+
+      //! Load a configuration from a cache file.
+      //! @param[in] fname configuration file the cache must refer to.
+      //! @param[in] cache cache file.
+      //! @param[out] cfg configuration (unchanged on failure).
+      //! @return true if the cache is valid and up to date, false
+      //! otherwise.
+      static bool
+      read(const std::string& fname, const std::string& cache, Config& cfg);
+
+      //! Write a parsed configuration to a cache file.
+      //! @param[in] cfg configuration.
+      //! @param[in] cache cache file.
+      //! @return true on success, false otherwise.
+      static bool
+      write(const Config& cfg, const std::string& cache);
+    };
+  }
+}
+
+#endif
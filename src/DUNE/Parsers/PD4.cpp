@@ -26,6 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstring>
 
 // DUNE headers.
@@ -37,8 +38,11 @@ namespace DUNE
   {
     //! Invalid velocity.
     static const int16_t c_invalid_vel = -32768;
+    //! Minimum size of ensemble data holding all decoded fields.
+    static const unsigned c_min_data = 24;
 
     PD4::PD4(bool use_checksum, bool use_size):
+      m_raw_data(m_frame + c_header_size),
       m_use_checksum(use_checksum),
       m_use_size(use_size)
     {
@@ -54,6 +58,7 @@ namespace DUNE
           if (byte == 0x7d)
           {
             clear();
+            m_frame[0] = byte;
             m_ccsum += byte;
             m_state = ST_STRUCT;
           }
@@ -62,6 +67,7 @@ namespace DUNE
         case ST_STRUCT:
           if (byte == 0x00)
           {
+            m_frame[1] = byte;
             m_ccsum += byte;
             m_state = ST_SIZE0;
           }
@@ -74,6 +80,7 @@ namespace DUNE
         case ST_SIZE0:
           if (!m_use_size)
             byte = 46;
+          m_frame[2] = byte;
           m_size = byte;
           m_ccsum += byte;
           m_state = ST_SIZE1;
@@ -82,9 +89,20 @@ namespace DUNE
         case ST_SIZE1:
           if (!m_use_size)
             byte = 0;
+          m_frame[3] = byte;
           m_size += byte * 256;
-          m_size -= 4;
           m_ccsum += byte;
+
+          // Reject sizes that cannot hold the decoded fields or do
+          // not fit in the ensemble buffer.
+          if (m_size < c_header_size + c_min_data
+              || m_size > c_max_size - c_footer_size)
+          {
+            clear();
+            return false;
+          }
+
+          m_size -= c_header_size;
           m_state = ST_DATA;
           return false;
 
@@ -97,11 +115,13 @@ namespace DUNE
           return false;
 
         case ST_CSUM0:
+          m_raw_data[m_size] = byte;
           m_rcsum = byte;
           m_state = ST_CSUM1;
           return false;
 
         case ST_CSUM1:
+          m_raw_data[m_size + 1] = byte;
           m_rcsum += byte * 256;
           if (m_rcsum != m_ccsum && m_use_checksum)
           {
@@ -112,6 +132,56 @@ namespace DUNE
           break;
       }
 
+      decode();
+      return true;
+    }
+
+    bool
+    PD4::parse(const uint8_t* bfr, size_t size, size_t& consumed)
+    {
+      size_t i = 0;
+
+      while (i < size)
+      {
+        if (m_state == ST_NONE)
+        {
+          const uint8_t* sync = static_cast<const uint8_t*>(std::memchr(bfr + i, 0x7d, size - i));
+          if (sync == NULL)
+          {
+            i = size;
+            break;
+          }
+
+          i = sync - bfr;
+        }
+        else if (m_state == ST_DATA)
+        {
+          size_t n = std::min(size - i, (size_t)(m_size - m_idx));
+          std::memcpy(m_raw_data + m_idx, bfr + i, n);
+          for (size_t j = 0; j < n; ++j)
+            m_ccsum += bfr[i + j];
+
+          m_idx += n;
+          i += n;
+          if (m_idx == m_size)
+            m_state = ST_CSUM0;
+          continue;
+        }
+
+        if (parse(bfr[i++]))
+        {
+          consumed = i;
+          return true;
+        }
+      }
+
+      consumed = i;
+      return false;
+    }
+
+    void
+    PD4::decode(void)
+    {
       // Clear data.
       std::memset(&m_data, 0, sizeof(m_data));
 
@@ -140,18 +210,14 @@ namespace DUNE
       stmp = m_raw_data[8] * 256 + m_raw_data[7];
       m_data.e_vel_btm = 0.001 * stmp;
 
-      // Bottom ranges.
-      uint16_t utmp = m_raw_data[10] * 256 + m_raw_data[9];
-      m_data.bm1_rng_btm = 0.01 * utmp;
-
-      utmp = m_raw_data[12] * 256 + m_raw_data[11];
-      m_data.bm2_rng_btm = 0.01 * utmp;
-
-      utmp = m_raw_data[14] * 256 + m_raw_data[13];
-      m_data.bm3_rng_btm = 0.01 * utmp;
-
-      utmp = m_raw_data[16] * 256 + m_raw_data[15];
-      m_data.bm4_rng_btm = 0.01 * utmp;
+      // Bottom ranges (zero when the beam has no bottom detection).
+      for (unsigned i = 0; i < c_beams; ++i)
+      {
+        uint16_t utmp = m_raw_data[10 + i * 2] * 256 + m_raw_data[9 + i * 2];
+        m_data.rng_btm[i] = 0.01 * utmp;
+        if (utmp != 0)
+          m_data.rng_btm_validity |= (1 << i);
+      }
 
       // Water velocity.
       stmp = m_raw_data[19] * 256 + m_raw_data[18];
@@ -174,8 +240,6 @@ namespace DUNE
         m_data.z_vel_wtr = 0.001 * stmp;
         m_data.vel_wtr_validity |= COMP_Z;
       }
-
-      return true;
     }
 
     void
@@ -28,6 +28,9 @@
 #ifndef DUNE_PARSERS_PD4_HPP_INCLUDED_
 #define DUNE_PARSERS_PD4_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <cstddef>
+
 // DUNE headers.
 #include <DUNE/Config.hpp>
 
@@ -48,6 +51,11 @@ namespace DUNE
         COMP_Z = 0x04
       };
 
+      //! Number of beams.
+      static const unsigned c_beams = 4;
+      //! Maximum size of an ensemble (header, data and checksum).
+      static const unsigned c_max_size = 128;
+
       struct Data
       {
         //! Validity of bottom velocity measures (one bit per component).
@@ -68,14 +76,10 @@ namespace DUNE
         double y_vel_wtr;
         //! Z or Up velocity in relation to the water in m/s.
         double z_vel_wtr;
-        //! Beam #1 range to the bottom in m.
-        double bm1_rng_btm;
-        //! Beam #2 range to the bottom in m.
-        double bm2_rng_btm;
-        //! Beam #3 range to the bottom in m.
-        double bm3_rng_btm;
-        //! Beam #4 range to the bottom in m.
-        double bm4_rng_btm;
+        //! Validity of beam ranges (one bit per beam).
+        uint8_t rng_btm_validity;
+        //! Beam ranges to the bottom in m.
+        double rng_btm[c_beams];
       };
 
       //! Default constructor.
@@ -87,8 +91,18 @@ namespace DUNE
       bool
       parse(uint8_t byte);
 
+      //! Parse a block of data, stopping after the first complete
+      //! ensemble. Headers are searched and ensemble bodies copied in
+      //! bulk rather than byte by byte.
+      //! @param bfr data.
+      //! @param size size of data.
+      //! @param[out] consumed number of bytes consumed.
+      //! @return true if data is available, false otherwise.
+      bool
+      parse(const uint8_t* bfr, size_t size, size_t& consumed);
+
       //! Retrieve data. This function should be called when parse()
-      //! Parsed datareturns true.
+      //! returns true.
       //! @return data.
       const Data*
       data(void)
@@ -96,6 +110,24 @@ namespace DUNE
         return &m_data;
       }
 
+      //! Retrieve the last complete ensemble, as received from the
+      //! device. This function should be called when parse() returns
+      //! true.
+      //! @return ensemble.
+      const uint8_t*
+      getEnsemble(void) const
+      {
+        return m_frame;
+      }
+
+      //! Retrieve the size of the last complete ensemble.
+      //! @return size in bytes.
+      unsigned
+      getEnsembleSize(void) const
+      {
+        return c_header_size + m_size + c_footer_size;
+      }
+
     private:
       enum States
       {
@@ -108,8 +140,15 @@ namespace DUNE
         ST_CSUM1
       };
 
+      //! Header size.
+      static const unsigned c_header_size = 4;
+      //! Footer (checksum) size.
+      static const unsigned c_footer_size = 2;
+
+      //! Ensemble, as received from the device.
+      uint8_t m_frame[c_max_size];
       //! Raw data (without header and checksum).
-      uint8_t m_raw_data[128];
+      uint8_t* m_raw_data;
       //! Raw data index.
       unsigned m_idx;
       //! Received checksum.
@@ -130,6 +169,10 @@ namespace DUNE
       //! Clear current state.
       void
       clear(void);
+
+      //! Decode a complete ensemble.
+      void
+      decode(void);
     };
   }
 }
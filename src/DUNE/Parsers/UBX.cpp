@@ -0,0 +1,210 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Parsers/UBX.hpp>
+#include <DUNE/Math/Angles.hpp>
+#include <DUNE/Utils/ByteCopy.hpp>
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    //! Size of the NAV-PVT payload.
+    static const unsigned c_pvt_size = 92;
+    //! Size of the NAV-DOP payload.
+    static const unsigned c_dop_size = 18;
+    //! Size of the time of week field present in all NAV messages.
+    static const unsigned c_itow_size = 4;
+
+    //! Read a little-endian field of a payload.
+    template <typename T>
+    static T
+    field(const uint8_t* payload, unsigned offset)
+    {
+      T value;
+      Utils::ByteCopy::fromLE(value, payload + offset);
+      return value;
+    }
+
+    const uint8_t UBX::c_sync0;
+    const uint8_t UBX::c_sync1;
+    const unsigned UBX::c_header_size;
+    const unsigned UBX::c_footer_size;
+
+    UBX::UBX(void):
+      m_pending(false)
+    {
+      std::memset(&m_current, 0, sizeof(m_current));
+      std::memset(&m_ready, 0, sizeof(m_ready));
+    }
+
+    size_t
+    UBX::getFrameSize(const uint8_t* bfr, size_t size)
+    {
+      if (size < c_header_size || bfr[0] != c_sync0 || bfr[1] != c_sync1)
+        return 0;
+
+      return c_header_size + field<uint16_t>(bfr, 4) + c_footer_size;
+    }
+
+    bool
+    UBX::decode(const uint8_t* bfr, size_t size, Frame& frame)
+    {
+      if (getFrameSize(bfr, size) != size)
+        return false;
+
+      // 8-bit Fletcher checksum over class, identifier, length and
+      // payload.
+      uint8_t ck_a = 0;
+      uint8_t ck_b = 0;
+      for (size_t i = 2; i < size - c_footer_size; ++i)
+      {
+        ck_a += bfr[i];
+        ck_b += ck_a;
+      }
+
+      if (ck_a != bfr[size - 2] || ck_b != bfr[size - 1])
+        return false;
+
+      frame.cls = bfr[2];
+      frame.id = bfr[3];
+      frame.payload = bfr + c_header_size;
+      frame.size = (uint16_t)(size - c_header_size - c_footer_size);
+      return true;
+    }
+
+    bool
+    UBX::add(const Frame& frame)
+    {
+      if (frame.cls != CLS_NAV || frame.size < c_itow_size)
+        return false;
+
+      bool done = false;
+      uint32_t itow = field<uint32_t>(frame.payload, 0);
+
+      // A new epoch implicitly terminates the previous one, for
+      // receivers that do not output NAV-EOE.
+      if (m_pending && itow != m_current.itow)
+      {
+        m_ready = m_current;
+        m_pending = false;
+        done = true;
+      }
+
+      // Late frames of an epoch that was already terminated.
+      if (!m_pending && m_ready.itow == itow && (m_ready.has_pvt || m_ready.has_dop))
+        return done;
+
+      switch (frame.id)
+      {
+        case NAV_EOE:
+          if (m_pending)
+          {
+            m_ready = m_current;
+            m_pending = false;
+            done = true;
+          }
+          break;
+
+        case NAV_PVT:
+          if (frame.size >= c_pvt_size)
+          {
+            begin(itow);
+            decodePVT(frame);
+          }
+          break;
+
+        case NAV_DOP:
+          if (frame.size >= c_dop_size)
+          {
+            begin(itow);
+            decodeDOP(frame);
+          }
+          break;
+
+        default:
+          break;
+      }
+
+      return done;
+    }
+
+    void
+    UBX::begin(uint32_t itow)
+    {
+      if (m_pending)
+        return;
+
+      std::memset(&m_current, 0, sizeof(m_current));
+      m_current.itow = itow;
+      m_pending = true;
+    }
+
+    void
+    UBX::decodePVT(const Frame& frame)
+    {
+      const uint8_t* p = frame.payload;
+      Solution& s = m_current;
+
+      uint8_t valid = p[11];
+      s.has_pvt = true;
+      s.valid_date = (valid & 0x01) != 0;
+      s.valid_time = (valid & 0x02) != 0;
+      s.year = field<uint16_t>(p, 4);
+      s.month = p[6];
+      s.day = p[7];
+      s.utc_time = p[8] * 3600.0 + p[9] * 60.0 + p[10] + field<int32_t>(p, 16) * 1e-9;
+
+      uint8_t flags = p[21];
+      s.fix_type = p[20];
+      s.fix_ok = (flags & 0x01) != 0;
+      s.differential = (flags & 0x02) != 0;
+      s.satellites = p[23];
+
+      s.lon = Math::Angles::radians(field<int32_t>(p, 24) * 1e-7);
+      s.lat = Math::Angles::radians(field<int32_t>(p, 28) * 1e-7);
+      s.height = field<int32_t>(p, 32) * 1e-3;
+      s.hacc = field<uint32_t>(p, 40) * 1e-3;
+      s.vacc = field<uint32_t>(p, 44) * 1e-3;
+      s.sog = field<int32_t>(p, 60) * 1e-3;
+      s.cog = Math::Angles::normalizeRadian(Math::Angles::radians(field<int32_t>(p, 64) * 1e-5));
+    }
+
+    void
+    UBX::decodeDOP(const Frame& frame)
+    {
+      const uint8_t* p = frame.payload;
+      m_current.has_dop = true;
+      m_current.vdop = field<uint16_t>(p, 10) * 0.01;
+      m_current.hdop = field<uint16_t>(p, 12) * 0.01;
+    }
+  }
+}
@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_PARSERS_UBX_HPP_INCLUDED_
+#define DUNE_PARSERS_UBX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Parsers
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM UBX;
+
+    //! Decoder of u-blox binary (UBX) navigation messages. Frames are
+    //! decoded in place, and the navigation messages of one
+    //! solution (NAV-PVT and NAV-DOP, terminated by NAV-EOE) are
+    //! aggregated into a single Solution.
+    class UBX
+    {
+    public:
+      //! First synchronization character.
+      static const uint8_t c_sync0 = 0xb5;
+      //! Second synchronization character.
+      static const uint8_t c_sync1 = 0x62;
+      //! Header size (synchronization, class, identifier and length).
+      static const unsigned c_header_size = 6;
+      //! Footer (checksum) size.
+      static const unsigned c_footer_size = 2;
+
+      //! Message classes.
+      enum Classes
+      {
+        CLS_NAV = 0x01
+      };
+
+      //! Navigation message identifiers.
+      enum NavigationIds
+      {
+        NAV_DOP = 0x04,
+        NAV_PVT = 0x07,
+        NAV_EOE = 0x61
+      };
+
+      //! Fix types reported by NAV-PVT.
+      enum FixTypes
+      {
+        FIX_NONE = 0,
+        FIX_DEAD_RECKONING = 1,
+        FIX_2D = 2,
+        FIX_3D = 3,
+        FIX_GNSS_DEAD_RECKONING = 4,
+        FIX_TIME_ONLY = 5
+      };
+
+      //! View of a frame held in a caller's buffer.
+      struct Frame
+      {
+        //! Message class.
+        uint8_t cls;
+        //! Message identifier.
+        uint8_t id;
+        //! Payload.
+        const uint8_t* payload;
+        //! Payload size.
+        uint16_t size;
+      };
+
+      //! Navigation solution of one epoch.
+      struct Solution
+      {
+        //! GPS time of week of the epoch (ms).
+        uint32_t itow;
+        //! True if NAV-PVT was received.
+        bool has_pvt;
+        //! True if NAV-DOP was received.
+        bool has_dop;
+        //! True if the UTC date is valid.
+        bool valid_date;
+        //! True if the UTC time is valid.
+        bool valid_time;
+        //! UTC year.
+        uint16_t year;
+        //! UTC month.
+        uint8_t month;
+        //! UTC day.
+        uint8_t day;
+        //! UTC time of day (s).
+        double utc_time;
+        //! Fix type.
+        uint8_t fix_type;
+        //! True if the fix is within the receiver's accuracy masks.
+        bool fix_ok;
+        //! True if differential corrections were applied.
+        bool differential;
+        //! Number of satellites used in the solution.
+        uint8_t satellites;
+        //! Latitude (rad).
+        double lat;
+        //! Longitude (rad).
+        double lon;
+        //! Height above the ellipsoid (m).
+        double height;
+        //! Horizontal accuracy estimate (m).
+        double hacc;
+        //! Vertical accuracy estimate (m).
+        double vacc;
+        //! Ground speed (m/s).
+        double sog;
+        //! Course over ground (rad).
+        double cog;
+        //! Horizontal dilution of precision.
+        double hdop;
+        //! Vertical dilution of precision.
+        double vdop;
+      };
+
+      //! Constructor.
+      UBX(void);
+
+      //! Retrieve the size of a frame from its header.
+      //! @param[in] bfr start of the frame.
+      //! @param[in] size number of bytes available.
+      //! @return frame size in bytes, or 0 if the header is incomplete
+      //! or not a UBX header.
+      static size_t
+      getFrameSize(const uint8_t* bfr, size_t size);
+
+      //! Validate a frame and take a view of its payload.
+      //! @param[in] bfr complete frame.
+      //! @param[in] size frame size.
+      //! @param[out] frame frame view into bfr.
+      //! @return true if the frame is valid, false otherwise.
+      static bool
+      decode(const uint8_t* bfr, size_t size, Frame& frame);
+
+      //! Add a frame to the current epoch. Frames of other classes
+      //! are ignored.
+      //! @param[in] frame decoded frame.
+      //! @return true if an epoch was completed, false otherwise.
+      bool
+      add(const Frame& frame);
+
+      //! Retrieve the last completed epoch. This function should be
+      //! called when add() returns true.
+      //! @return solution.
+      const Solution&
+      getSolution(void) const
+      {
+        return m_ready;
+      }
+
+    private:
+      //! Epoch being aggregated.
+      Solution m_current;
+      //! Last completed epoch.
+      Solution m_ready;
+      //! True if an epoch is being aggregated.
+      bool m_pending;
+
+      //! Start a new epoch.
+      //! @param[in] itow time of week of the epoch.
+      void
+      begin(uint32_t itow);
+
+      //! Decode NAV-PVT into the current epoch.
+      //! @param[in] frame frame.
+      void
+      decodePVT(const Frame& frame);
+
+      //! Decode NAV-DOP into the current epoch.
+      //! @param[in] frame frame.
+      void
+      decodeDOP(const Frame& frame);
+    };
+  }
+}
+
+#endif
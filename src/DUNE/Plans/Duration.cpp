@@ -207,19 +207,37 @@ namespace DUNE
 
       if (!maneuver->points.size())
       {
-        durations.push_back(0.0);
+        durations.push_back(last_dur);
       }
       else
       {
-        // Iterate point list
+        // Convert all points at once.
+        std::vector<double> xs;
+        std::vector<double> ys;
+        xs.reserve(maneuver->points.size());
+        ys.reserve(maneuver->points.size());
+
         for (; itr != maneuver->points.end(); itr++)
         {
           if ((*itr) == NULL)
             continue;
 
-          pos.lat = maneuver->lat;
-          pos.lon = maneuver->lon;
-          Coordinates::WGS84::displace((*itr)->x, (*itr)->y, &pos.lat, &pos.lon);
+          xs.push_back((*itr)->x);
+          ys.push_back((*itr)->y);
+        }
+
+        std::vector<double> lats(xs.size());
+        std::vector<double> lons(xs.size());
+
+        if (!xs.empty())
+          Coordinates::WGS84::displace(maneuver->lat, maneuver->lon, 0.0, xs.size(),
+                                       &xs[0], &ys[0], NULL, &lats[0], &lons[0], NULL);
+
+        // Iterate point list
+        for (size_t i = 0; i < lats.size(); i++)
+        {
+          pos.lat = lats[i];
+          pos.lon = lons[i];
 
           float travelled = distance3D(pos, last_pos);
 
@@ -257,7 +275,8 @@ namespace DUNE
 
       last_pos = pos;
 
-      distance += rstages.getDistance(&last_pos.lat, &last_pos.lon);
+      // Move to the last point.
+      rstages.getDistance(&last_pos.lat, &last_pos.lon);
 
       std::vector<float>::const_iterator itr = rstages.getDistancesBegin();
 
@@ -268,7 +287,7 @@ namespace DUNE
         durations.push_back(travelled / speed + durations.back());
       }
 
-      return distance / speed;
+      return durations.back();
     }
 #endif
 #ifdef DUNE_IMC_YOYO
@@ -374,9 +393,154 @@ namespace DUNE
     }
 #endif
 
+    float
+    Duration::parseManeuver(const IMC::Message* msg, Position& last_pos, float last_dur,
+                            std::vector<float>& durations, const SpeedConversion& speed_conv)
+    {
+      switch (msg->getId())
+      {
+#ifdef DUNE_IMC_GOTO
+        case DUNE_IMC_GOTO:
+          return parse(static_cast<const IMC::Goto*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_STATIONKEEPING
+        case DUNE_IMC_STATIONKEEPING:
+          return parse(static_cast<const IMC::StationKeeping*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_LOITER
+        case DUNE_IMC_LOITER:
+          return parse(static_cast<const IMC::Loiter*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_FOLLOWPATH
+        case DUNE_IMC_FOLLOWPATH:
+          return parse(static_cast<const IMC::FollowPath*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_ROWS
+        case DUNE_IMC_ROWS:
+          return parse(static_cast<const IMC::Rows*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_YOYO
+        case DUNE_IMC_YOYO:
+          return parse(static_cast<const IMC::YoYo*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_ELEVATOR
+        case DUNE_IMC_ELEVATOR:
+          return parse(static_cast<const IMC::Elevator*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+#ifdef DUNE_IMC_POPUP
+        case DUNE_IMC_POPUP:
+          return parse(static_cast<const IMC::PopUp*>(msg), last_pos,
+                       last_dur, durations, speed_conv);
+#endif
+        default:
+          return -1.0;
+      }
+    }
+
+    bool
+    Duration::definesPosition(const IMC::Message* msg)
+    {
+      switch (msg->getId())
+      {
+#ifdef DUNE_IMC_FOLLOWPATH
+        case DUNE_IMC_FOLLOWPATH:
+          {
+            const IMC::FollowPath* path = static_cast<const IMC::FollowPath*>(msg);
+            IMC::MessageList<IMC::PathPoint>::const_iterator itr = path->points.begin();
+            for (; itr != path->points.end(); ++itr)
+            {
+              if (*itr != NULL)
+                return true;
+            }
+          }
+          return false;
+#endif
+#ifdef DUNE_IMC_POPUP
+        case DUNE_IMC_POPUP:
+          return (static_cast<const IMC::PopUp*>(msg)->flags & IMC::PopUp::FLG_CURR_POS) != 0;
+#endif
+#ifdef DUNE_IMC_ELEVATOR
+        case DUNE_IMC_ELEVATOR:
+          return false;
+#endif
+        default:
+          return true;
+      }
+    }
+
+    void
+    Duration::computeProfile(const std::vector<IMC::PlanManeuver*>& nodes, Profile& profile,
+                             const SpeedConversion& speed_conv)
+    {
+      profile.first = nodes.size();
+      profile.last = nodes.size();
+      profile.durations.clear();
+
+      Position pos;
+      pos.lat = 0.0;
+      pos.lon = 0.0;
+      pos.z = 0.0;
+      pos.z_units = IMC::Z_DEPTH;
+
+      // Find the first maneuver that defines the position.
+      for (size_t i = 0; i < nodes.size(); ++i)
+      {
+        if (nodes[i]->data.isNull())
+          return;
+
+        const IMC::Message* msg = nodes[i]->data.get();
+
+        if (!definesPosition(msg))
+          continue;
+
+        std::vector<float> durations;
+        if (parseManeuver(msg, pos, 0.0, durations, speed_conv) < 0.0)
+          return;
+
+        profile.first = i + 1;
+        break;
+      }
+
+      // Following maneuvers do not depend on the initial position.
+      for (size_t i = profile.first; i < nodes.size(); ++i)
+      {
+        std::vector<float> durations;
+
+        if (nodes[i]->data.isNull() ||
+            parseManeuver(nodes[i]->data.get(), pos, 0.0, durations, speed_conv) < 0.0)
+        {
+          profile.last = i;
+          return;
+        }
+
+        profile.durations.push_back(durations);
+      }
+    }
+
+    Duration::ManeuverDuration::const_iterator
+    Duration::parse(const std::vector<IMC::PlanManeuver*>& nodes,
+                    const IMC::EstimatedState* state,
+                    ManeuverDuration& man_durations,
+                    const SpeedConversion& speed_conv)
+    {
+      Profile profile;
+      profile.first = nodes.size();
+      profile.last = nodes.size();
+
+      return parse(nodes, state, profile, man_durations, speed_conv);
+    }
+
     Duration::ManeuverDuration::const_iterator
     Duration::parse(const std::vector<IMC::PlanManeuver*>& nodes,
                     const IMC::EstimatedState* state,
+                    const Profile& profile,
                     ManeuverDuration& man_durations,
                     const SpeedConversion& speed_conv)
     {
@@ -387,68 +551,29 @@ namespace DUNE
 
       std::vector<IMC::PlanManeuver*>::const_iterator itr = nodes.begin();
 
-      for (; itr != nodes.end(); ++itr)
+      for (size_t i = 0; itr != nodes.end(); ++itr, ++i)
       {
         if ((*itr)->data.isNull())
           return man_durations.end();
 
-        IMC::Message* msg = (*itr)->data.get();
-
         std::vector<float> durations;
 
-        switch (msg->getId())
+        if (i < profile.first)
         {
-#ifdef DUNE_IMC_GOTO
-          case DUNE_IMC_GOTO:
-            last_duration = parse(dynamic_cast<IMC::Goto*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_STATIONKEEPING
-          case DUNE_IMC_STATIONKEEPING:
-            last_duration = parse(dynamic_cast<IMC::StationKeeping*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_LOITER
-          case DUNE_IMC_LOITER:
-            last_duration = parse(dynamic_cast<IMC::Loiter*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_FOLLOWPATH
-          case DUNE_IMC_FOLLOWPATH:
-            last_duration = parse(dynamic_cast<IMC::FollowPath*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_ROWS
-          case DUNE_IMC_ROWS:
-            last_duration = parse(dynamic_cast<IMC::Rows*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_YOYO
-          case DUNE_IMC_YOYO:
-            last_duration = parse(dynamic_cast<IMC::YoYo*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_ELEVATOR
-          case DUNE_IMC_ELEVATOR:
-            last_duration = parse(dynamic_cast<IMC::Elevator*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-#ifdef DUNE_IMC_POPUP
-          case DUNE_IMC_POPUP:
-            last_duration = parse(dynamic_cast<IMC::PopUp*>(msg), pos,
-                                  last_duration, durations, speed_conv);
-            break;
-#endif
-          default:
-            last_duration = -1.0;
-            break;
+          last_duration = parseManeuver((*itr)->data.get(), pos,
+                                        last_duration, durations, speed_conv);
+        }
+        else if (i < profile.last)
+        {
+          durations = profile.durations[i - profile.first];
+          for (size_t j = 0; j < durations.size(); ++j)
+            durations[j] += last_duration;
+
+          last_duration = durations.back();
+        }
+        else
+        {
+          last_duration = -1.0;
         }
 
         if (last_duration < 0.0)
@@ -65,6 +65,45 @@ namespace DUNE
         float act_factor;
       };
 
+      //! Durations of the maneuvers of a plan that do not depend on
+      //! the vehicle's position when the plan starts. Maneuvers up to
+      //! the first one that defines the vehicle's position (a Goto,
+      //! for instance) are always computed from the vehicle's state.
+      struct Profile
+      {
+        //! Index of the first profiled maneuver.
+        size_t first;
+        //! Index of the first maneuver whose duration cannot be computed.
+        size_t last;
+        //! Durations of each profiled maneuver, relative to its start.
+        std::vector< std::vector<float> > durations;
+
+        Profile(void):
+          first(0), last(0)
+        { }
+      };
+
+      //! Compute the durations of a plan that do not depend on the
+      //! vehicle's state.
+      //! @param[in] nodes vector of plan maneuver nodes
+      //! @param[out] profile plan profile
+      //! @param[in] speed_conv speed conversion factors
+      static void
+      computeProfile(const std::vector<IMC::PlanManeuver*>& nodes, Profile& profile,
+                     const SpeedConversion& speed_conv);
+
+      //! Parse plan duration from plan specification and its profile
+      //! @param[in] nodes vector of plan maneuver nodes
+      //! @param[in] state current estimated state
+      //! @param[in] profile profile of the plan (see computeProfile)
+      //! @param[out] man_durations map of maneuver ids to point durations
+      //! @param[in] speed_conv speed conversion factors
+      //! @return iterator to last computed maneuver, returns end() if unable to compute
+      static ManeuverDuration::const_iterator
+      parse(const std::vector<IMC::PlanManeuver*>& nodes, const IMC::EstimatedState* state,
+            const Profile& profile, ManeuverDuration& man_durations,
+            const SpeedConversion& speed_conv);
+
       //! Parse plan duration from plan specification
       //! @param[in] nodes vector of plan maneuver nodes
       //! @param[in] state current estimated state
@@ -124,6 +163,24 @@ namespace DUNE
         BathymetricInfo binfo;
       };
 
+      //! Parse a maneuver
+      //! @param[in] msg pointer to maneuver message
+      //! @param[in,out] last_pos last position to consider when computing duration
+      //! @param[in] last_dur last computed accumulated plan duration
+      //! @param[out] durations vector of accumulated durations for this maneuver
+      //! @param[in] speed_conv speed conversion factors
+      //! @return accumulated plan duration in seconds, -1 if unable to compute
+      static float
+      parseManeuver(const IMC::Message* msg, Position& last_pos, float last_dur,
+                    std::vector<float>& durations, const SpeedConversion& speed_conv);
+
+      //! Check if the position after a maneuver does not depend on
+      //! the position before it
+      //! @param[in] msg pointer to maneuver message
+      //! @return true if the maneuver defines the position
+      static bool
+      definesPosition(const IMC::Message* msg);
+
       //! Find 2D distance between two positions
       //! @param[in] new_pos object where the new position info will be stored
       //! @param[in] last_pos last position to consider when computing duration
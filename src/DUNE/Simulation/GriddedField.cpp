@@ -0,0 +1,380 @@
+//***************************************************************************
+// Copyright 2007-2013 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/FileSystem/Path.hpp>
+#include <DUNE/Simulation/GriddedField.hpp>
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+#  include <sys/mman.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    //! File magic.
+    static const char c_magic[4] = {'D', 'G', 'R', 'F'};
+    //! Byte order marker.
+    static const uint32_t c_order = 0x01020304;
+    //! File format version.
+    static const uint32_t c_version = 1;
+    //! Minimum number of resident tiles (one interpolation stencil).
+    static const unsigned c_min_tiles = 4;
+
+    //! On-disk header.
+    struct FileHeader
+    {
+      char magic[4];
+      uint32_t order;
+      uint32_t version;
+      uint32_t tile;
+      uint32_t nx, ny, nz;
+      uint32_t reserved;
+      fp64_t lat, lon;
+      fp64_t x0, y0, z0;
+      fp64_t dx, dy, dz;
+    };
+
+    //! Size of the on-disk header.
+    static const size_t c_header_size = 96;
+
+    GriddedField::GriddedField(const std::string& path, unsigned cache_tiles):
+      m_cache_tiles(std::max(cache_tiles, c_min_tiles)),
+      m_map(NULL),
+      m_map_size(0)
+    {
+      FileHeader hdr;
+      uint64_t size = FileSystem::Path(path).size();
+
+      if (size < c_header_size)
+        throw Error("invalid file: " + path);
+
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (size == (uint64_t)(size_t)size)
+      {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+          void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+          close(fd);
+
+          if (ptr != MAP_FAILED)
+          {
+#  if defined(MADV_RANDOM)
+            madvise(ptr, size, MADV_RANDOM);
+#  endif
+            m_map = (const uint8_t*)ptr;
+            m_map_size = size;
+          }
+        }
+      }
+#endif
+
+      if (m_map != NULL)
+      {
+        std::memcpy(&hdr, m_map, c_header_size);
+      }
+      else
+      {
+        m_ifs.open(path.c_str(), std::ios::binary);
+        if (!m_ifs.read((char*)&hdr, c_header_size))
+          throw Error("failed to read: " + path);
+      }
+
+      if (std::memcmp(hdr.magic, c_magic, sizeof(c_magic)) != 0)
+        throw Error("invalid file: " + path);
+
+      if (hdr.order != c_order)
+        throw Error("byte order mismatch: " + path);
+
+      if (hdr.version != c_version)
+        throw Error("unsupported version: " + path);
+
+      if (!hdr.nx || !hdr.ny || !hdr.nz || !hdr.tile
+          || !(hdr.dx > 0) || !(hdr.dy > 0) || !(hdr.dz > 0))
+        throw Error("invalid geometry: " + path);
+
+      m_layout.nx = hdr.nx;
+      m_layout.ny = hdr.ny;
+      m_layout.nz = hdr.nz;
+      m_layout.tile = hdr.tile;
+      m_layout.lat = hdr.lat;
+      m_layout.lon = hdr.lon;
+      m_layout.x0 = hdr.x0;
+      m_layout.y0 = hdr.y0;
+      m_layout.z0 = hdr.z0;
+      m_layout.dx = hdr.dx;
+      m_layout.dy = hdr.dy;
+      m_layout.dz = hdr.dz;
+
+      m_tiles_x = (hdr.nx + hdr.tile - 1) / hdr.tile;
+      m_tiles_y = (hdr.ny + hdr.tile - 1) / hdr.tile;
+      m_tile_size = hdr.tile * hdr.tile * hdr.nz;
+
+      uint64_t expected = c_header_size + (uint64_t)m_tiles_x * m_tiles_y * m_tile_size * sizeof(float);
+      if (size < expected)
+        throw Error("truncated file: " + path);
+    }
+
+    GriddedField::~GriddedField(void)
+    {
+#if defined(DUNE_SYS_HAS_MMAP)
+      if (m_map != NULL)
+        munmap((void*)m_map, m_map_size);
+#endif
+    }
+
+    void
+    GriddedField::write(const std::string& path, const Layout& layout, const float* values)
+    {
+      if (!layout.nx || !layout.ny || !layout.nz || !layout.tile)
+        throw Error("invalid geometry");
+
+      FileHeader hdr;
+      std::memset(&hdr, 0, sizeof(hdr));
+      std::memcpy(hdr.magic, c_magic, sizeof(c_magic));
+      hdr.order = c_order;
+      hdr.version = c_version;
+      hdr.tile = layout.tile;
+      hdr.nx = layout.nx;
+      hdr.ny = layout.ny;
+      hdr.nz = layout.nz;
+      hdr.lat = layout.lat;
+      hdr.lon = layout.lon;
+      hdr.x0 = layout.x0;
+      hdr.y0 = layout.y0;
+      hdr.z0 = layout.z0;
+      hdr.dx = layout.dx;
+      hdr.dy = layout.dy;
+      hdr.dz = layout.dz;
+
+      std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+      ofs.write((const char*)&hdr, c_header_size);
+
+      unsigned t = layout.tile;
+      unsigned tiles_x = (layout.nx + t - 1) / t;
+      unsigned tiles_y = (layout.ny + t - 1) / t;
+      std::vector<float> buffer(t * t);
+      const float nan = std::numeric_limits<float>::quiet_NaN();
+
+      for (unsigned ty = 0; ty < tiles_y; ++ty)
+      {
+        for (unsigned tx = 0; tx < tiles_x; ++tx)
+        {
+          for (unsigned k = 0; k < layout.nz; ++k)
+          {
+            for (unsigned jj = 0; jj < t; ++jj)
+            {
+              for (unsigned ii = 0; ii < t; ++ii)
+              {
+                unsigned i = tx * t + ii;
+                unsigned j = ty * t + jj;
+
+                if (i < layout.nx && j < layout.ny)
+                  buffer[jj * t + ii] = values[((size_t)k * layout.ny + j) * layout.nx + i];
+                else
+                  buffer[jj * t + ii] = nan;
+              }
+            }
+
+            ofs.write((const char*)&buffer[0], buffer.size() * sizeof(float));
+          }
+        }
+      }
+
+      if (!ofs)
+        throw Error("failed to write: " + path);
+    }
+
+    const float*
+    GriddedField::tile(unsigned index)
+    {
+      if (!m_lru.empty() && m_lru.front().index == index)
+        return m_lru.front().data;
+
+      std::map<unsigned, std::list<Slot>::iterator>::iterator itr = m_slots.find(index);
+      if (itr != m_slots.end())
+      {
+        m_lru.splice(m_lru.begin(), m_lru, itr->second);
+        return m_lru.front().data;
+      }
+
+      size_t bytes = (size_t)m_tile_size * sizeof(float);
+      size_t offset = c_header_size + (size_t)index * bytes;
+
+      // Evict least recently used tile.
+      if (m_lru.size() >= m_cache_tiles)
+      {
+        Slot& old = m_lru.back();
+
+#if defined(DUNE_SYS_HAS_MMAP) && defined(MADV_DONTNEED)
+        if (m_map != NULL)
+        {
+          // Release the whole pages covered by the tile.
+          size_t page = (size_t)sysconf(_SC_PAGESIZE);
+          size_t begin = c_header_size + (size_t)old.index * bytes;
+          size_t first = (begin + page - 1) / page * page;
+          size_t last = (begin + bytes) / page * page;
+          if (last > first)
+            madvise((void*)(m_map + first), last - first, MADV_DONTNEED);
+        }
+#endif
+
+        m_slots.erase(old.index);
+        m_lru.pop_back();
+      }
+
+      m_lru.push_front(Slot());
+      Slot& slot = m_lru.front();
+      slot.index = index;
+
+      if (m_map != NULL)
+      {
+        slot.data = (const float*)(m_map + offset);
+      }
+      else
+      {
+        slot.buffer.resize(m_tile_size);
+        m_ifs.clear();
+        m_ifs.seekg(offset);
+        if (!m_ifs.read((char*)&slot.buffer[0], bytes))
+          throw Error("failed to read tile");
+        slot.data = &slot.buffer[0];
+      }
+
+      m_slots[index] = m_lru.begin();
+      return slot.data;
+    }
+
+    float
+    GriddedField::cell(unsigned i, unsigned j, unsigned k)
+    {
+      unsigned t = m_layout.tile;
+      const float* data = tile((j / t) * m_tiles_x + (i / t));
+      return data[(k * t + (j % t)) * t + (i % t)];
+    }
+
+    bool
+    GriddedField::locate(double v, double v0, double dv, unsigned n, unsigned& i, double& f)
+    {
+      if (n == 1)
+      {
+        i = 0;
+        f = 0;
+        return true;
+      }
+
+      double p = (v - v0) / dv;
+      if (!(p >= 0 && p <= n - 1))
+        return false;
+
+      i = (unsigned)p;
+      if (i > n - 2)
+        i = n - 2;
+
+      f = p - i;
+      return true;
+    }
+
+    bool
+    GriddedField::sample(double x, double y, double z, double& value)
+    {
+      const Layout& l = m_layout;
+      unsigned i, j, k;
+      double fx, fy, fz;
+
+      if (!locate(x, l.x0, l.dx, l.nx, i, fx)
+          || !locate(y, l.y0, l.dy, l.ny, j, fy)
+          || !locate(z, l.z0, l.dz, l.nz, k, fz))
+        return false;
+
+      double acc = 0;
+
+      for (unsigned dk = 0; dk < 2; ++dk)
+      {
+        double wz = dk ? fz : 1 - fz;
+        if (wz == 0)
+          continue;
+
+        for (unsigned dj = 0; dj < 2; ++dj)
+        {
+          double wy = dj ? fy : 1 - fy;
+          if (wy == 0)
+            continue;
+
+          for (unsigned di = 0; di < 2; ++di)
+          {
+            double w = (di ? fx : 1 - fx) * wy * wz;
+            if (w == 0)
+              continue;
+
+            float c = cell(i + di, j + dj, k + dk);
+            if (c != c)
+              return false;
+
+            acc += w * c;
+          }
+        }
+      }
+
+      value = acc;
+      return true;
+    }
+
+    unsigned
+    GriddedField::sample(const double* x, const double* y, const double* z, unsigned count,
+                         double* values, bool* valid)
+    {
+      unsigned n = 0;
+
+      for (unsigned p = 0; p < count; ++p)
+      {
+        valid[p] = sample(x[p], y[p], z ? z[p] : m_layout.z0, values[p]);
+        if (valid[p])
+          ++n;
+      }
+
+      return n;
+    }
+  }
+}
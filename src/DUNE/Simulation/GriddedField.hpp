@@ -0,0 +1,203 @@
+//***************************************************************************
+// Copyright 2007-2013 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_SIMULATION_GRIDDED_FIELD_HPP_INCLUDED_
+#define DUNE_SIMULATION_GRIDDED_FIELD_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <list>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM GriddedField;
+
+    //! Scalar field sampled on a regular grid (bathymetry, temperature,
+    //! current components, ...), read from a file of square tiles.
+    //!
+    //! The file is memory mapped when the platform allows it and read
+    //! tile by tile otherwise. Only a bounded number of tiles is kept
+    //! resident: tiles are tracked in least-recently-used order and
+    //! evicted tiles are released back to the operating system, so
+    //! grids much larger than memory can be queried. Values are
+    //! interpolated trilinearly (bilinearly for single-layer grids).
+    //!
+    //! File layout: a 96-byte header followed by the tiles in
+    //! row-major tile order. Each tile holds nz layers of tile x tile
+    //! 32-bit floats in host byte order, x varying fastest; cells
+    //! outside the grid and missing data are NaN.
+    class GriddedField
+    {
+    public:
+      //! Error class for gridded field errors.
+      class Error: public std::runtime_error
+      {
+      public:
+        Error(const std::string& msg):
+          std::runtime_error("gridded field error: " + msg)
+        { }
+      };
+
+      //! Grid geometry.
+      struct Layout
+      {
+        //! Number of cells along x (north), y (east) and z (down).
+        unsigned nx, ny, nz;
+        //! Tile edge, in cells.
+        unsigned tile;
+        //! WGS-84 reference of the local frame (rad).
+        double lat, lon;
+        //! Coordinates of the first cell (m).
+        double x0, y0, z0;
+        //! Cell spacing (m).
+        double dx, dy, dz;
+      };
+
+      //! Open a field.
+      //! @param[in] path file path.
+      //! @param[in] cache_tiles maximum number of resident tiles.
+      GriddedField(const std::string& path, unsigned cache_tiles = 64);
+
+      //! Destructor.
+      ~GriddedField(void);
+
+      //! Write a field.
+      //! @param[in] path file path.
+      //! @param[in] layout grid geometry.
+      //! @param[in] values nx * ny * nz values, x varying fastest and
+      //! z slowest.
+      static void
+      write(const std::string& path, const Layout& layout, const float* values);
+
+      //! Get grid geometry.
+      //! @return grid geometry.
+      const Layout&
+      getLayout(void) const
+      {
+        return m_layout;
+      }
+
+      //! Interpolate the field at a point.
+      //! @param[in] x north coordinate (m).
+      //! @param[in] y east coordinate (m).
+      //! @param[in] z down coordinate (m), ignored for single-layer grids.
+      //! @param[out] value interpolated value.
+      //! @return true if the point is inside the grid and all the
+      //! surrounding cells have data, false otherwise.
+      bool
+      sample(double x, double y, double z, double& value);
+
+      //! Interpolate the field at several points.
+      //! @param[in] x north coordinates (m).
+      //! @param[in] y east coordinates (m).
+      //! @param[in] z down coordinates (m), may be NULL for
+      //! single-layer grids.
+      //! @param[in] count number of points.
+      //! @param[out] values interpolated values.
+      //! @param[out] valid validity of each value.
+      //! @return number of valid values.
+      unsigned
+      sample(const double* x, const double* y, const double* z, unsigned count,
+             double* values, bool* valid);
+
+    private:
+      //! Resident tile.
+      struct Slot
+      {
+        //! Tile index.
+        unsigned index;
+        //! Tile values.
+        const float* data;
+        //! Tile values, when read from the file.
+        std::vector<float> buffer;
+      };
+
+      //! Grid geometry.
+      Layout m_layout;
+      //! Number of tiles along x and y.
+      unsigned m_tiles_x, m_tiles_y;
+      //! Number of values per tile.
+      unsigned m_tile_size;
+      //! Maximum number of resident tiles.
+      unsigned m_cache_tiles;
+      //! Memory mapped file, if any.
+      const uint8_t* m_map;
+      //! Size of the memory mapped file.
+      size_t m_map_size;
+      //! File stream, when not memory mapped.
+      std::ifstream m_ifs;
+      //! Resident tiles, most recently used first.
+      std::list<Slot> m_lru;
+      //! Resident tiles by index.
+      std::map<unsigned, std::list<Slot>::iterator> m_slots;
+
+      //! Get value of a cell.
+      //! @param[in] i x index.
+      //! @param[in] j y index.
+      //! @param[in] k z index.
+      //! @return cell value.
+      float
+      cell(unsigned i, unsigned j, unsigned k);
+
+      //! Get values of a tile, loading it if needed.
+      //! @param[in] index tile index.
+      //! @return tile values.
+      const float*
+      tile(unsigned index);
+
+      //! Locate a coordinate in the grid.
+      //! @param[in] v coordinate.
+      //! @param[in] v0 first cell coordinate.
+      //! @param[in] dv cell spacing.
+      //! @param[in] n number of cells.
+      //! @param[out] i index of the lower cell.
+      //! @param[out] f interpolation weight of the upper cell.
+      //! @return true if inside, false otherwise.
+      static bool
+      locate(double v, double v0, double dv, unsigned n, unsigned& i, double& f);
+
+      //! Non-copyable.
+      GriddedField(const GriddedField&);
+
+      //! Non-assignable.
+      GriddedField&
+      operator=(const GriddedField&);
+    };
+  }
+}
+
+#endif
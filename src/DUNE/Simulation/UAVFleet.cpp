@@ -0,0 +1,336 @@
+//***************************************************************************
+// Copyright 2007-2013 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Math/Angles.hpp>
+#include <DUNE/Math/Constants.hpp>
+#include <DUNE/Math/General.hpp>
+#include <DUNE/Simulation/UAVFleet.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    //! Apply a symmetric limit, if any.
+    static inline double
+    limit(double value, double lim)
+    {
+      if (lim <= 0)
+        return value;
+
+      return Math::trimValue(value, -lim, lim);
+    }
+
+    UAVFleet::UAVFleet(unsigned count):
+      m_integrator(INT_RK4),
+      m_time(0)
+    {
+      setWind(0, 0, 0);
+      resize(count);
+    }
+
+    void
+    UAVFleet::resize(unsigned count)
+    {
+      m_x.resize(count, 0.0);
+      m_y.resize(count, 0.0);
+      m_z.resize(count, 0.0);
+      m_bank.resize(count, 0.0);
+      m_yaw.resize(count, 0.0);
+      m_va.resize(count, 0.0);
+      m_bank_cmd.resize(count, 0.0);
+      m_va_cmd.resize(count, 0.0);
+      m_alt_cmd.resize(count, 0.0);
+      m_tau_bank.resize(count, 0.0);
+      m_tau_speed.resize(count, 0.0);
+      m_tau_alt.resize(count, 0.0);
+      m_bank_rate_lim.resize(count, 0.0);
+      m_accel_lim.resize(count, 0.0);
+      m_slope_lim.resize(count, 0.0);
+    }
+
+    void
+    UAVFleet::setWind(double north, double east, double down)
+    {
+      m_wind[0] = north;
+      m_wind[1] = east;
+      m_wind[2] = down;
+    }
+
+    void
+    UAVFleet::setTimeConstants(unsigned index, double bank, double speed, double altitude)
+    {
+      m_tau_bank[index] = bank;
+      m_tau_speed[index] = speed;
+      m_tau_alt[index] = altitude;
+    }
+
+    void
+    UAVFleet::setLimits(unsigned index, double bank_rate, double lon_accel, double vert_slope)
+    {
+      m_bank_rate_lim[index] = bank_rate;
+      m_accel_lim[index] = lon_accel;
+      m_slope_lim[index] = vert_slope;
+    }
+
+    void
+    UAVFleet::setState(unsigned index, double x, double y, double z,
+                       double bank, double yaw, double airspeed)
+    {
+      m_x[index] = x;
+      m_y[index] = y;
+      m_z[index] = z;
+      m_bank[index] = bank;
+      m_yaw[index] = yaw;
+      m_va[index] = airspeed;
+    }
+
+    void
+    UAVFleet::command(unsigned index, double bank, double airspeed, double altitude)
+    {
+      m_bank_cmd[index] = bank;
+      m_va_cmd[index] = airspeed;
+      m_alt_cmd[index] = altitude;
+    }
+
+    double
+    UAVFleet::verticalRate(unsigned index, double z, double va, double timestep) const
+    {
+      if (m_tau_alt[index] <= 0)
+        return 0;
+
+      double vz = (-m_alt_cmd[index] - z) / (m_tau_alt[index] + timestep);
+      // The vertical speed never exceeds the airspeed.
+      double lim = m_slope_lim[index] > 0 ? m_slope_lim[index] * va : va;
+      return Math::trimValue(vz, -lim, lim);
+    }
+
+    void
+    UAVFleet::derivative(unsigned index, const double* s, double* ds, double* vz) const
+    {
+      double va = s[5];
+      *vz = verticalRate(index, s[2], va, 0);
+
+      double sin_pitch = va > 0 ? -*vz / va : 0;
+      double cos_pitch = std::sqrt(1 - sin_pitch * sin_pitch);
+
+      ds[0] = va * std::cos(s[4]) * cos_pitch + m_wind[0];
+      ds[1] = va * std::sin(s[4]) * cos_pitch + m_wind[1];
+      ds[2] = *vz + m_wind[2];
+
+      if (m_tau_bank[index] > 0)
+        ds[3] = limit((m_bank_cmd[index] - s[3]) / m_tau_bank[index], m_bank_rate_lim[index]);
+      else
+        ds[3] = 0;
+
+      ds[4] = va > 0 ? Math::c_gravity * std::tan(s[3]) / va : 0;
+
+      if (m_tau_speed[index] > 0)
+        ds[5] = limit((m_va_cmd[index] - va) / m_tau_speed[index], m_accel_lim[index]);
+      else
+        ds[5] = 0;
+    }
+
+    void
+    UAVFleet::step(double timestep)
+    {
+      if (timestep <= 0)
+        return;
+
+      // States without dynamics follow their commands.
+      for (unsigned i = 0; i < size(); ++i)
+      {
+        if (m_tau_bank[i] <= 0)
+          m_bank[i] = m_bank_cmd[i];
+        if (m_tau_speed[i] <= 0)
+          m_va[i] = m_va_cmd[i];
+      }
+
+      switch (m_integrator)
+      {
+        case INT_EULER:
+          stepEuler(timestep);
+          break;
+        case INT_SEMI_IMPLICIT:
+          stepSemiImplicit(timestep);
+          break;
+        case INT_RK4:
+          stepRK4(timestep);
+          break;
+      }
+
+      for (unsigned i = 0; i < size(); ++i)
+        m_yaw[i] = Math::Angles::normalizeRadian(m_yaw[i]);
+
+      m_time += timestep;
+    }
+
+    void
+    UAVFleet::run(double timestep, unsigned count)
+    {
+      for (unsigned k = 0; k < count; ++k)
+        step(timestep);
+    }
+
+    void
+    UAVFleet::stepEuler(double timestep)
+    {
+      double s[c_states];
+      double ds[c_states];
+      double vz;
+
+      for (unsigned i = 0; i < size(); ++i)
+      {
+        s[0] = m_x[i];
+        s[1] = m_y[i];
+        s[2] = m_z[i];
+        s[3] = m_bank[i];
+        s[4] = m_yaw[i];
+        s[5] = m_va[i];
+
+        derivative(i, s, ds, &vz);
+
+        m_x[i] += ds[0] * timestep;
+        m_y[i] += ds[1] * timestep;
+        m_z[i] += ds[2] * timestep;
+        m_bank[i] += ds[3] * timestep;
+        m_yaw[i] += ds[4] * timestep;
+        m_va[i] += ds[5] * timestep;
+      }
+    }
+
+    void
+    UAVFleet::stepSemiImplicit(double timestep)
+    {
+      for (unsigned i = 0; i < size(); ++i)
+      {
+        // Backward Euler on the first-order responses.
+        if (m_tau_bank[i] > 0)
+          m_bank[i] += timestep * limit((m_bank_cmd[i] - m_bank[i]) / (m_tau_bank[i] + timestep),
+                                        m_bank_rate_lim[i]);
+
+        if (m_tau_speed[i] > 0)
+          m_va[i] += timestep * limit((m_va_cmd[i] - m_va[i]) / (m_tau_speed[i] + timestep),
+                                      m_accel_lim[i]);
+
+        double va = m_va[i];
+        double vz = verticalRate(i, m_z[i], va, timestep);
+        double sin_pitch = va > 0 ? -vz / va : 0;
+        double cos_pitch = std::sqrt(1 - sin_pitch * sin_pitch);
+
+        // Kinematics with the updated velocities.
+        if (va > 0)
+          m_yaw[i] += timestep * Math::c_gravity * std::tan(m_bank[i]) / va;
+
+        m_x[i] += timestep * (va * std::cos(m_yaw[i]) * cos_pitch + m_wind[0]);
+        m_y[i] += timestep * (va * std::sin(m_yaw[i]) * cos_pitch + m_wind[1]);
+        m_z[i] += timestep * (vz + m_wind[2]);
+      }
+    }
+
+    void
+    UAVFleet::stepRK4(double timestep)
+    {
+      double s[c_states];
+      double t[c_states];
+      double k1[c_states];
+      double k2[c_states];
+      double k3[c_states];
+      double k4[c_states];
+      double vz;
+      double h = timestep / 2;
+
+      for (unsigned i = 0; i < size(); ++i)
+      {
+        s[0] = m_x[i];
+        s[1] = m_y[i];
+        s[2] = m_z[i];
+        s[3] = m_bank[i];
+        s[4] = m_yaw[i];
+        s[5] = m_va[i];
+
+        derivative(i, s, k1, &vz);
+        for (unsigned j = 0; j < c_states; ++j)
+          t[j] = s[j] + h * k1[j];
+
+        derivative(i, t, k2, &vz);
+        for (unsigned j = 0; j < c_states; ++j)
+          t[j] = s[j] + h * k2[j];
+
+        derivative(i, t, k3, &vz);
+        for (unsigned j = 0; j < c_states; ++j)
+          t[j] = s[j] + timestep * k3[j];
+
+        derivative(i, t, k4, &vz);
+        for (unsigned j = 0; j < c_states; ++j)
+          s[j] += timestep / 6 * (k1[j] + 2 * (k2[j] + k3[j]) + k4[j]);
+
+        m_x[i] = s[0];
+        m_y[i] = s[1];
+        m_z[i] = s[2];
+        m_bank[i] = s[3];
+        m_yaw[i] = s[4];
+        m_va[i] = s[5];
+      }
+    }
+
+    void
+    UAVFleet::getPosition(unsigned index, double* position) const
+    {
+      double va = m_va[index];
+      double vz = verticalRate(index, m_z[index], va, 0);
+
+      position[0] = m_x[index];
+      position[1] = m_y[index];
+      position[2] = m_z[index];
+      position[3] = m_bank[index];
+      position[4] = va > 0 ? std::asin(-vz / va) : 0;
+      position[5] = m_yaw[index];
+    }
+
+    void
+    UAVFleet::getVelocity(unsigned index, double* velocity) const
+    {
+      double s[c_states] = {m_x[index], m_y[index], m_z[index],
+                            m_bank[index], m_yaw[index], m_va[index]};
+      double ds[c_states];
+      double vz;
+
+      derivative(index, s, ds, &vz);
+
+      velocity[0] = ds[0];
+      velocity[1] = ds[1];
+      velocity[2] = ds[2];
+      velocity[3] = ds[3];
+      velocity[4] = 0;
+      velocity[5] = ds[4];
+    }
+  }
+}
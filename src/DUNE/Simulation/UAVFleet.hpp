@@ -0,0 +1,244 @@
+//***************************************************************************
+// Copyright 2007-2013 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_SIMULATION_UAV_FLEET_HPP_INCLUDED_
+#define DUNE_SIMULATION_UAV_FLEET_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Simulation
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM UAVFleet;
+
+    //! Headless, fixed-step kinematic simulation of many UAVs.
+    //!
+    //! Uses the same kinematic model as UAVSimulation: coordinated
+    //! turns, first-order bank, airspeed and altitude responses to
+    //! the commands, optional rate limits and a constant wind. State
+    //! is kept in structure-of-arrays form and every step is one
+    //! tight loop over all vehicles, so a fleet can be advanced much
+    //! faster than real time. A time constant of zero makes the
+    //! corresponding state follow its command instantaneously (and,
+    //! for altitude, keeps it constant), as in the 3DOF model.
+    //!
+    //! Nothing here depends on the clock or on the message bus;
+    //! callers decide when to read the state back.
+    class UAVFleet
+    {
+    public:
+      //! Integration schemes.
+      enum Integrator
+      {
+        //! Explicit (forward) Euler.
+        INT_EULER,
+        //! Backward Euler for the first-order responses, followed by
+        //! position integration with the updated velocities.
+        INT_SEMI_IMPLICIT,
+        //! Classic fourth-order Runge-Kutta.
+        INT_RK4
+      };
+
+      //! Constructor.
+      //! @param[in] count number of vehicles.
+      UAVFleet(unsigned count = 0);
+
+      //! Change number of vehicles. New vehicles start at rest at
+      //! the origin, with null commands and instantaneous responses.
+      //! @param[in] count number of vehicles.
+      void
+      resize(unsigned count);
+
+      //! Retrieve number of vehicles.
+      //! @return number of vehicles.
+      unsigned
+      size(void) const
+      {
+        return m_x.size();
+      }
+
+      //! Select integration scheme.
+      //! @param[in] integrator integration scheme.
+      void
+      setIntegrator(Integrator integrator)
+      {
+        m_integrator = integrator;
+      }
+
+      //! Define constant wind, in the ground frame.
+      //! @param[in] north north component (m/s).
+      //! @param[in] east east component (m/s).
+      //! @param[in] down down component (m/s).
+      void
+      setWind(double north, double east, double down);
+
+      //! Define model time constants of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] bank bank angle time constant (s).
+      //! @param[in] speed airspeed time constant (s).
+      //! @param[in] altitude altitude time constant (s).
+      void
+      setTimeConstants(unsigned index, double bank, double speed, double altitude);
+
+      //! Define operation limits of a vehicle. Non-positive values
+      //! disable the corresponding limit.
+      //! @param[in] index vehicle index.
+      //! @param[in] bank_rate bank rate limit (rad/s).
+      //! @param[in] lon_accel longitudinal acceleration limit (m/s^2).
+      //! @param[in] vert_slope vertical slope limit.
+      void
+      setLimits(unsigned index, double bank_rate, double lon_accel, double vert_slope);
+
+      //! Define state of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] x north position (m).
+      //! @param[in] y east position (m).
+      //! @param[in] z down position (m).
+      //! @param[in] bank bank angle (rad).
+      //! @param[in] yaw yaw angle (rad).
+      //! @param[in] airspeed airspeed (m/s).
+      void
+      setState(unsigned index, double x, double y, double z,
+               double bank, double yaw, double airspeed);
+
+      //! Command a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] bank bank angle command (rad).
+      //! @param[in] airspeed airspeed command (m/s).
+      //! @param[in] altitude altitude command (m).
+      void
+      command(unsigned index, double bank, double airspeed, double altitude);
+
+      //! Advance all vehicles by one step.
+      //! @param[in] timestep step (s).
+      void
+      step(double timestep);
+
+      //! Advance all vehicles by a number of steps.
+      //! @param[in] timestep step (s).
+      //! @param[in] count number of steps.
+      void
+      run(double timestep, unsigned count);
+
+      //! Retrieve simulated time.
+      //! @return time since construction (s).
+      double
+      getTime(void) const
+      {
+        return m_time;
+      }
+
+      //! Retrieve position of a vehicle, using the UAVSimulation
+      //! layout (x, y, z, bank, pitch, yaw).
+      //! @param[in] index vehicle index.
+      //! @param[out] position array of 6 elements.
+      void
+      getPosition(unsigned index, double* position) const;
+
+      //! Retrieve velocity of a vehicle, relative to the ground in
+      //! the ground frame, using the UAVSimulation layout.
+      //! @param[in] index vehicle index.
+      //! @param[out] velocity array of 6 elements.
+      void
+      getVelocity(unsigned index, double* velocity) const;
+
+      //! Retrieve airspeed of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @return airspeed (m/s).
+      double
+      getAirspeed(unsigned index) const
+      {
+        return m_va[index];
+      }
+
+    private:
+      //! Number of integrated states per vehicle
+      //! (x, y, z, bank, yaw, airspeed).
+      static const unsigned c_states = 6;
+
+      //! Integration scheme.
+      Integrator m_integrator;
+      //! Simulated time.
+      double m_time;
+      //! Wind.
+      double m_wind[3];
+      //! Integrated states.
+      std::vector<double> m_x;
+      std::vector<double> m_y;
+      std::vector<double> m_z;
+      std::vector<double> m_bank;
+      std::vector<double> m_yaw;
+      std::vector<double> m_va;
+      //! Commands.
+      std::vector<double> m_bank_cmd;
+      std::vector<double> m_va_cmd;
+      std::vector<double> m_alt_cmd;
+      //! Time constants.
+      std::vector<double> m_tau_bank;
+      std::vector<double> m_tau_speed;
+      std::vector<double> m_tau_alt;
+      //! Limits.
+      std::vector<double> m_bank_rate_lim;
+      std::vector<double> m_accel_lim;
+      std::vector<double> m_slope_lim;
+
+      //! Compute state derivative of a vehicle.
+      //! @param[in] index vehicle index.
+      //! @param[in] s state.
+      //! @param[out] ds state derivative.
+      //! @param[out] vz vertical rate relative to the air.
+      void
+      derivative(unsigned index, const double* s, double* ds, double* vz) const;
+
+      //! Vertical rate relative to the air for a given state.
+      //! @param[in] index vehicle index.
+      //! @param[in] z down position.
+      //! @param[in] va airspeed.
+      //! @param[in] timestep extra damping for backward Euler (s).
+      //! @return vertical rate (m/s).
+      double
+      verticalRate(unsigned index, double z, double va, double timestep) const;
+
+      void
+      stepEuler(double timestep);
+
+      void
+      stepSemiImplicit(double timestep);
+
+      void
+      stepRK4(double timestep);
+    };
+  }
+}
+
+#endif
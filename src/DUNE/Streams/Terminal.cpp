@@ -29,10 +29,15 @@
 #include <ostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/Streams/Terminal.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Concurrency/AtomicCounter.hpp>
+#include <DUNE/Concurrency/MPSCQueue.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Time/Clock.hpp>
 
 namespace DUNE
 {
@@ -41,6 +46,101 @@ namespace DUNE
     Terminal dune_term;
     Terminal::Flusher dune_term_flush;
 
+    //! Maximum size of a module name, including terminator.
+    static const unsigned c_module_size = 64;
+    //! Maximum size of a message, including terminator.
+    static const unsigned c_text_size = 1024;
+    //! Time to wait for messages before checking if the writer
+    //! should stop (s).
+    static const double c_flush_period = 0.5;
+
+    //! Message waiting to be written.
+    struct Record
+    {
+      //! Time of the message.
+      double tstamp;
+      //! Severity.
+      Terminal::Level level;
+      //! Module name.
+      char module[c_module_size];
+      //! Message text.
+      char text[c_text_size];
+
+      Record(void):
+        tstamp(0),
+        level(Terminal::LEVEL_MSG)
+      {
+        module[0] = 0;
+        text[0] = 0;
+      }
+    };
+
+    //! Thread writing queued messages to a terminal.
+    class AsyncWriter: public Concurrency::Thread
+    {
+    public:
+      AsyncWriter(Concurrency::MPSCQueue<Record>& queue, Concurrency::AtomicCounter& dropped):
+        m_queue(queue),
+        m_dropped(dropped),
+        m_term(NULL)
+      { }
+
+      void
+      setTerminal(Terminal* term)
+      {
+        m_term = term;
+      }
+
+      //! Write all pending messages.
+      void
+      flush(void)
+      {
+        Record record;
+        while (m_queue.pop(record))
+          m_term->output(record.level, record.tstamp, record.module, record.text);
+
+        int dropped = m_dropped.add(0);
+        if (dropped != 0)
+        {
+          m_dropped.sub(dropped);
+          std::string text = Utils::String::str(DTR("%d messages were discarded"), dropped);
+          m_term->output(Terminal::LEVEL_WRN, Time::Clock::getSinceEpoch(), "Terminal", text.c_str());
+        }
+      }
+
+    private:
+      Concurrency::MPSCQueue<Record>& m_queue;
+      Concurrency::AtomicCounter& m_dropped;
+      Terminal* m_term;
+
+      void
+      run(void)
+      {
+        while (!isStopping())
+        {
+          if (m_queue.waitForItems(c_flush_period))
+            flush();
+        }
+
+        flush();
+      }
+    };
+
+    struct Terminal::Async
+    {
+      //! Pending messages.
+      Concurrency::MPSCQueue<Record> queue;
+      //! Number of messages discarded since the last flush.
+      Concurrency::AtomicCounter dropped;
+      //! Background writer.
+      AsyncWriter writer;
+
+      Async(unsigned capacity):
+        queue(capacity),
+        writer(queue, dropped)
+      { }
+    };
+
     void
     Terminal::open(const std::string& fname)
     {
@@ -69,6 +169,85 @@ namespace DUNE
       }
     }
 
+    void
+    Terminal::write(Level level, const std::string& module, const char* text)
+    {
+      double now = Time::Clock::getSinceEpoch();
+
+      if (m_async == NULL)
+      {
+        output(level, now, module.c_str(), text);
+        return;
+      }
+
+      Record record;
+      record.tstamp = now;
+      record.level = level;
+      std::strncpy(record.module, module.c_str(), c_module_size - 1);
+      record.module[c_module_size - 1] = 0;
+      std::strncpy(record.text, text, c_text_size - 1);
+      record.text[c_text_size - 1] = 0;
+
+      if (!m_async->queue.push(record))
+        m_async->dropped.add(1);
+    }
+
+    void
+    Terminal::startAsync(unsigned capacity)
+    {
+      if (m_async != NULL)
+        return;
+
+      m_async = new Async(capacity);
+      m_async->writer.setTerminal(this);
+      m_async->writer.start();
+    }
+
+    void
+    Terminal::stopAsync(void)
+    {
+      if (m_async == NULL)
+        return;
+
+      m_async->writer.stop();
+      m_async->queue.wakeup();
+      m_async->writer.join();
+      delete m_async;
+      m_async = NULL;
+    }
+
+    unsigned
+    Terminal::getDropped(void) const
+    {
+      if (m_async == NULL)
+        return 0;
+
+      return m_async->dropped.add(0);
+    }
+
+    void
+    Terminal::output(Level level, double tstamp, const char* module, const char* text)
+    {
+      const char* color = "";
+      const char* label = DTR("MSG");
+
+      if (level == LEVEL_WRN)
+      {
+        color = "\033[1;33m";
+        label = DTR("WRN");
+      }
+      else if (level == LEVEL_ERR)
+      {
+        color = "\033[1;31m";
+        label = DTR("ERR");
+      }
+
+      lock(color)
+        << "[" << Time::Format::getTimeDate(tstamp) << "] - " << label
+        << " [" << module << "] >> " << text << "\n"
+        << dune_term_flush;
+    }
+
     Terminal&
     Terminal::lock(const char* str)
     {
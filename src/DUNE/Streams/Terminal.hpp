@@ -96,12 +96,25 @@ namespace DUNE
       class Flusher
       { };
 
+      //! Severity of a message written with write().
+      enum Level
+      {
+        //! Normal message.
+        LEVEL_MSG,
+        //! Warning message.
+        LEVEL_WRN,
+        //! Error message.
+        LEVEL_ERR
+      };
+
       Terminal(void):
-        m_out(NULL)
+        m_out(NULL),
+        m_async(NULL)
       { }
 
       ~Terminal(void)
       {
+        stopAsync();
         close();
       }
 
@@ -114,6 +127,34 @@ namespace DUNE
       Terminal&
       lock(const char* str = "");
 
+      //! Write a formatted message. In asynchronous mode the message
+      //! is copied to a lock-free ring and written by a background
+      //! thread, otherwise it is written immediately.
+      //! @param[in] level message severity.
+      //! @param[in] module name of the module writing the message.
+      //! @param[in] text message text.
+      void
+      write(Level level, const std::string& module, const char* text);
+
+      //! Start writing messages passed to write() from a background
+      //! thread. Must not be called while other threads are writing
+      //! messages.
+      //! @param[in] capacity maximum number of pending messages.
+      void
+      startAsync(unsigned capacity = 256);
+
+      //! Write all pending messages and go back to synchronous mode.
+      //! Must not be called while other threads are writing
+      //! messages.
+      void
+      stopAsync(void);
+
+      //! Retrieve the number of messages discarded because the ring
+      //! was full.
+      //! @return number of discarded messages.
+      unsigned
+      getDropped(void) const;
+
       template <typename T>
       inline Terminal&
       operator<<(T o)
@@ -140,8 +181,17 @@ namespace DUNE
       }
 
     private:
+      friend class AsyncWriter;
+      struct Async;
+
       std::ofstream* m_out;
       Concurrency::Mutex m_mutex;
+      //! Asynchronous writer state.
+      Async* m_async;
+
+      //! Write a message to the outputs.
+      void
+      output(Level level, double tstamp, const char* module, const char* text);
     };
 
     DUNE_DLL_SYM extern Terminal dune_term;
@@ -39,5 +39,6 @@ namespace DUNE
 #include <DUNE/System/Error.hpp>
 #include <DUNE/System/DynamicLoader.hpp>
 #include <DUNE/System/Environment.hpp>
+#include <DUNE/System/HeapArena.hpp>
 
 #endif
@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_SYSTEM_HEAP_ARENA_HPP_INCLUDED_
+#define DUNE_SYSTEM_HEAP_ARENA_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace System
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM HeapArena;
+
+    //! Private heap regions selected per thread. The allocator of
+    //! the executable installs a back end. Without one, arenas cannot
+    //! be created and every thread uses the shared heap.
+    class HeapArena
+    {
+    public:
+      //! Allocator back end.
+      class Backend
+      {
+      public:
+        virtual
+        ~Backend(void)
+        { }
+
+        //! Create an arena.
+        //! @param[in] size arena size in bytes.
+        //! @return arena handle or NULL if it cannot be created.
+        virtual void*
+        create(size_t size) = 0;
+
+        //! Destroy an arena. Blocks still allocated in it remain
+        //! valid and are released to it.
+        //! @param[in] arena arena handle.
+        virtual void
+        destroy(void* arena) = 0;
+
+        //! Select the arena used by allocations of the calling thread.
+        //! @param[in] arena arena handle or NULL for the shared heap.
+        virtual void
+        select(void* arena) = 0;
+
+        //! Retrieve the number of bytes allocated in an arena.
+        //! @param[in] arena arena handle.
+        //! @return allocated bytes.
+        virtual size_t
+        getUsed(void* arena) = 0;
+      };
+
+      //! Install the allocator back end.
+      //! @param[in] backend back end or NULL to disable arenas.
+      static void
+      setBackend(Backend* backend);
+
+      //! Create an arena.
+      //! @param[in] size arena size in bytes.
+      //! @return arena handle or NULL if arenas are not available.
+      static void*
+      create(size_t size);
+
+      //! Destroy an arena. No thread may allocate from it afterwards,
+      //! but blocks still allocated in it can be freed by any thread.
+      //! @param[in] arena arena handle (may be NULL).
+      static void
+      destroy(void* arena);
+
+      //! Select the arena used by allocations of the calling thread.
+      //! Memory is always released to the arena it came from.
+      //! @param[in] arena arena handle or NULL for the shared heap.
+      static void
+      select(void* arena);
+
+      //! Retrieve the number of bytes allocated in an arena.
+      //! @param[in] arena arena handle.
+      //! @return allocated bytes.
+      static size_t
+      getUsed(void* arena);
+    };
+  }
+}
+
+#endif
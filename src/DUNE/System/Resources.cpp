@@ -182,7 +182,8 @@ namespace DUNE
     Resources::lockMemory(void)
     {
 #if defined(DUNE_SYS_HAS_SYS_MMAN_H)
-      mlockall(MCL_CURRENT | MCL_FUTURE);
+      if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        throw Error(errno, "failed to lock memory");
 #endif
     }
 
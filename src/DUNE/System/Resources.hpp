@@ -58,6 +58,7 @@ namespace DUNE
       //! Make all memory pages mapped by the address space of the
       //! current process to be memory-resident until unlocked or until
       //! the process exits.
+      //! @throw System::Error if memory cannot be locked.
       static void
       lockMemory(void);
 
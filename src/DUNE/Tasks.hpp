@@ -39,10 +39,16 @@ namespace DUNE
 #include <DUNE/Tasks/Exceptions.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/Periodic.hpp>
+#include <DUNE/Tasks/Cooperative.hpp>
+#include <DUNE/Tasks/Coroutine.hpp>
 #include <DUNE/Tasks/Profiles.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Manager.hpp>
+#include <DUNE/Tasks/Executor.hpp>
+#include <DUNE/Tasks/DeadlineScheduler.hpp>
+#include <DUNE/Tasks/SharedState.hpp>
+#include <DUNE/Tasks/Tracer.hpp>
 #include <DUNE/Tasks/AbstractConsumer.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
 #include <DUNE/Tasks/AbstractCreator.hpp>
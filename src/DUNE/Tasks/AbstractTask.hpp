@@ -35,6 +35,7 @@
 // DUNE headers.
 #include <DUNE/Concurrency/Thread.hpp>
 #include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
 
 namespace DUNE
 {
@@ -59,10 +60,32 @@ namespace DUNE
       virtual void
       receive(const IMC::Message* msg) = 0;
 
+      //! Queue a shared message for later consumption. Implementations
+      //! must acquire their own reference to the message handle.
+      //! @param msg shared message handle.
+      virtual void
+      receive(IMC::SharedMessage* msg) = 0;
+
       //! Retrieve task name.
       //! @return task name.
       virtual const char*
       getName(void) const = 0;
+
+      //! Called before a traced message is consumed.
+      //! @param msg message.
+      virtual void
+      beginTrace(const IMC::Message* msg)
+      {
+        (void)msg;
+      }
+
+      //! Called after a traced message is consumed.
+      //! @param msg message.
+      virtual void
+      endTrace(const IMC::Message* msg)
+      {
+        (void)msg;
+      }
     };
   }
 }
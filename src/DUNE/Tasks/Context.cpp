@@ -35,10 +35,13 @@ namespace DUNE
 {
   namespace Tasks
   {
-    Context::Context(void)
+    Context::Context(void):
+      blackboard(resolver)
     {
       using FileSystem::Path;
 
+      mbus.setBlackboard(&blackboard);
+
       // Get the base directory of the application.
       dir_app = Path(Path::applicationFile()).dirname();
       dir_lib = dir_app / ".." / Path("lib");
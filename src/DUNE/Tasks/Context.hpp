@@ -38,8 +38,12 @@
 #include <DUNE/Tasks/EntityDataBase.hpp>
 #include <DUNE/Utils/ByteBuffer.hpp>
 #include <DUNE/Tasks/Profiles.hpp>
+#include <DUNE/Tasks/DeadlineScheduler.hpp>
+#include <DUNE/Tasks/SharedState.hpp>
+#include <DUNE/Tasks/Tracer.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
+#include <DUNE/IMC/Blackboard.hpp>
 
 namespace DUNE
 {
@@ -60,10 +64,18 @@ namespace DUNE
       IMC::Bus mbus;
       //! IMC address resolver.
       IMC::AddressResolver resolver;
+      //! Latest messages dispatched by this system.
+      IMC::Blackboard blackboard;
       //! Label data base.
       EntityDataBase entities;
       //! Execution profiles.
       Profiles profiles;
+      //! Scheduler of periodic tasks.
+      DeadlineScheduler scheduler;
+      //! Message tracer.
+      Tracer tracer;
+      //! Latest vehicle state.
+      SharedState state;
       //! DUNE's directory.
       FileSystem::Path dir_app;
       //! Path to configuration directory.
@@ -0,0 +1,202 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Tasks/Context.hpp>
+#include <DUNE/Tasks/Cooperative.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    const double Cooperative::c_idle_period = 1.0;
+
+    Cooperative::Cooperative(const std::string& name, Context& ctx):
+      Task(name, ctx),
+      m_poll_period(0.01),
+      m_listener(*this),
+      m_handle(NULL)
+    { }
+
+    Cooperative::~Cooperative(void)
+    {
+      detachInput();
+    }
+
+    void
+    Cooperative::Input::onData(const uint8_t* data, size_t size, double tstamp)
+    {
+      (void)tstamp;
+      Concurrency::ScopedMutex l(m_task.m_input_lock);
+      m_task.m_input.append((const char*)data, size);
+    }
+
+    void
+    Cooperative::Input::onError(const std::string& error)
+    {
+      Concurrency::ScopedMutex l(m_task.m_input_lock);
+      m_task.m_input_error = error;
+    }
+
+    void
+    Cooperative::attachInput(IO::Handle& handle)
+    {
+      detachInput();
+      m_handle = &handle;
+      IO::Reactor::getShared().add(handle, &m_listener);
+    }
+
+    void
+    Cooperative::detachInput(void)
+    {
+      if (m_handle != NULL)
+      {
+        IO::Reactor::getShared().remove(*m_handle);
+        m_handle = NULL;
+      }
+
+      clearInput();
+    }
+
+    bool
+    Cooperative::readUntil(std::string& data, const std::string& terminator)
+    {
+      Concurrency::ScopedMutex l(m_input_lock);
+
+      size_t pos = m_input.find(terminator);
+      if (pos == std::string::npos)
+        return false;
+
+      data.assign(m_input, 0, pos);
+      m_input.erase(0, pos + terminator.size());
+      return true;
+    }
+
+    bool
+    Cooperative::readLine(std::string& line)
+    {
+      Concurrency::ScopedMutex l(m_input_lock);
+
+      while (true)
+      {
+        size_t pos = m_input.find_first_of("\r\n");
+        if (pos == std::string::npos)
+          return false;
+
+        line.assign(m_input, 0, pos);
+        size_t end = m_input.find_first_not_of("\r\n", pos);
+        m_input.erase(0, end == std::string::npos ? m_input.size() : end);
+
+        if (!line.empty())
+          return true;
+      }
+    }
+
+    bool
+    Cooperative::readBytes(std::string& data, size_t size)
+    {
+      Concurrency::ScopedMutex l(m_input_lock);
+
+      if (m_input.size() < size)
+        return false;
+
+      data.assign(m_input, 0, size);
+      m_input.erase(0, size);
+      return true;
+    }
+
+    void
+    Cooperative::clearInput(void)
+    {
+      Concurrency::ScopedMutex l(m_input_lock);
+      m_input.clear();
+      m_input_error.clear();
+    }
+
+    bool
+    Cooperative::takeInputError(std::string& error)
+    {
+      Concurrency::ScopedMutex l(m_input_lock);
+
+      if (m_input_error.empty())
+        return false;
+
+      error = m_input_error;
+      m_input_error.clear();
+      return true;
+    }
+
+    double
+    Cooperative::getDelay(void) const
+    {
+      double now = Time::Clock::get();
+      double delay = c_idle_period;
+
+      for (size_t i = 0; i < m_coroutines.size(); ++i)
+      {
+        const Coroutine* co = m_coroutines[i];
+        if (!co->isWaiting())
+          continue;
+
+        if (co->isPolled())
+          delay = std::min(delay, m_poll_period);
+
+        if (co->getDeadline() >= 0)
+          delay = std::min(delay, co->getDeadline() - now);
+      }
+
+      return std::max(delay, 0.0);
+    }
+
+    void
+    Cooperative::onMain(void)
+    {
+      while (!stopping())
+      {
+        consumeMessages();
+        if (stopping())
+          break;
+
+        onResume();
+        waitForMessages(getDelay());
+      }
+    }
+
+    double
+    Cooperative::onStep(void)
+    {
+      consumeMessages();
+      onResume();
+      return getDelay();
+    }
+  }
+}
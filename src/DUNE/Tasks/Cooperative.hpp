@@ -0,0 +1,205 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_COOPERATIVE_HPP_INCLUDED_
+#define DUNE_TASKS_COOPERATIVE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/IO/Handle.hpp>
+#include <DUNE/IO/Reactor.hpp>
+#include <DUNE/Tasks/Coroutine.hpp>
+#include <DUNE/Tasks/Task.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Cooperative;
+
+    // Forward declarations
+    struct Context;
+
+    //! Task whose work is written as coroutines (see Coroutine)
+    //! that wait for bus messages, timers and device replies without
+    //! blocking. Cooperative tasks can be executed by the thread pool
+    //! ('Execution Mode' set to 'Pool'), so many of them share a few
+    //! threads, or by their own thread.
+    //!
+    //! Derived classes implement onResume(), which calls their
+    //! coroutines, and register them with watch() so that they are
+    //! resumed when their deadlines expire. Bus messages are consumed
+    //! before each resumption and input from a device attached with
+    //! attachInput() is buffered by the shared I/O reactor, so
+    //! coroutines await conditions on state updated by consumers and
+    //! on buffered input.
+    class Cooperative: public Task
+    {
+    public:
+      //! Constructor.
+      Cooperative(const std::string& name, Context& ctx);
+
+      //! Destructor.
+      virtual
+      ~Cooperative(void);
+
+    protected:
+      //! Resume the coroutines of the task. Implementations must not
+      //! block.
+      virtual void
+      onResume(void) = 0;
+
+      //! Resume a coroutine when its deadline expires.
+      //! @param[in] co coroutine.
+      void
+      watch(Coroutine& co)
+      {
+        m_coroutines.push_back(&co);
+      }
+
+      //! Set the maximum amount of time between resumptions while a
+      //! coroutine waits for a condition. Conditions on bus messages
+      //! are also checked as soon as messages arrive when the task
+      //! has its own thread.
+      //! @param[in] period period in seconds.
+      void
+      setPollPeriod(double period)
+      {
+        m_poll_period = period;
+      }
+
+      //! Buffer input from a device. The device is read by the
+      //! shared I/O reactor.
+      //! @param[in] handle I/O handle, which must outlive the
+      //! attachment.
+      void
+      attachInput(IO::Handle& handle);
+
+      //! Stop buffering input from the attached device and discard
+      //! buffered input.
+      void
+      detachInput(void);
+
+      //! Take buffered input up to and including a terminator.
+      //! @param[out] data input without the terminator.
+      //! @param[in] terminator terminator.
+      //! @return true if the terminator was received, false
+      //! otherwise.
+      bool
+      readUntil(std::string& data, const std::string& terminator);
+
+      //! Take a line of buffered input, skipping empty lines.
+      //! @param[out] line line without line terminators.
+      //! @return true if a line was received, false otherwise.
+      bool
+      readLine(std::string& line);
+
+      //! Take an amount of buffered input.
+      //! @param[out] data input.
+      //! @param[in] size amount of input.
+      //! @return true if enough input was received, false otherwise.
+      bool
+      readBytes(std::string& data, size_t size);
+
+      //! Discard buffered input.
+      void
+      clearInput(void);
+
+      //! Take the error reported by the attached device, after which
+      //! it is no longer read.
+      //! @param[out] error error description.
+      //! @return true if an error was reported, false otherwise.
+      bool
+      takeInputError(std::string& error);
+
+    private:
+      //! Receives input from the shared I/O reactor.
+      class Input: public IO::Reactor::Listener
+      {
+      public:
+        Input(Cooperative& task):
+          m_task(task)
+        { }
+
+        void
+        onData(const uint8_t* data, size_t size, double tstamp);
+
+        void
+        onError(const std::string& error);
+
+      private:
+        Cooperative& m_task;
+      };
+
+      //! Idle period when no coroutine is waiting.
+      static const double c_idle_period;
+      //! Watched coroutines.
+      std::vector<Coroutine*> m_coroutines;
+      //! Maximum period between resumptions of waiting coroutines.
+      double m_poll_period;
+      //! Input listener.
+      Input m_listener;
+      //! Attached device.
+      IO::Handle* m_handle;
+      //! Buffered input.
+      std::string m_input;
+      //! Input error.
+      std::string m_input_error;
+      //! Lock protecting input.
+      Concurrency::Mutex m_input_lock;
+
+      //! Retrieve the amount of time until coroutines must be
+      //! resumed.
+      //! @return time in seconds.
+      double
+      getDelay(void) const;
+
+      //! Task entry point.
+      void
+      onMain(void);
+
+      //! Cooperative tasks can be executed by the thread pool.
+      bool
+      canStep(void) const
+      {
+        return true;
+      }
+
+      //! Consume messages and resume coroutines.
+      //! @return amount of time until the next resumption.
+      double
+      onStep(void);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,293 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_COROUTINE_HPP_INCLUDED_
+#define DUNE_TASKS_COROUTINE_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Time/Clock.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! State of a stackless coroutine. A coroutine is a member
+    //! function returning void whose body is enclosed in
+    //! DUNE_CO_BEGIN() and DUNE_CO_END(). The await macros suspend it
+    //! by returning and the next call resumes it after the point
+    //! where it was suspended:
+    //!
+    //! @code
+    //! void
+    //! configure(void)
+    //! {
+    //!   DUNE_CO_BEGIN(m_co);
+    //!   sendCommand("AT");
+    //!   DUNE_CO_AWAIT_FOR(m_co, readLine(m_reply), 1.0);
+    //!   if (m_co.timedOut())
+    //!     throw std::runtime_error("no reply");
+    //!   DUNE_CO_SLEEP(m_co, 0.5);
+    //!   DUNE_CO_END(m_co);
+    //! }
+    //! @endcode
+    //!
+    //! Coroutines have no stack of their own: local variables do not
+    //! survive a suspension and must be members instead. Await
+    //! macros cannot be used inside switch statements of the body
+    //! and at most one of them can appear on each line.
+    class Coroutine
+    {
+    public:
+      //! Constructor.
+      Coroutine(void):
+        m_line(0),
+        m_deadline(-1),
+        m_polled(false),
+        m_timed_out(false)
+      { }
+
+      //! Restart the coroutine from the beginning on its next call.
+      void
+      reset(void)
+      {
+        m_line = 0;
+        m_deadline = -1;
+        m_polled = false;
+        m_timed_out = false;
+      }
+
+      //! Check if the coroutine reached its end.
+      //! @return true if the coroutine finished, false otherwise.
+      bool
+      isDone(void) const
+      {
+        return m_line < 0;
+      }
+
+      //! Check if the coroutine is suspended.
+      //! @return true if the coroutine is waiting, false otherwise.
+      bool
+      isWaiting(void) const
+      {
+        return m_line > 0;
+      }
+
+      //! Check if the last DUNE_CO_AWAIT_FOR() timed out.
+      //! @return true if the condition was not met in time.
+      bool
+      timedOut(void) const
+      {
+        return m_timed_out;
+      }
+
+      //! Check if the coroutine waits for a condition, which must be
+      //! checked periodically.
+      //! @return true if the coroutine must be polled.
+      bool
+      isPolled(void) const
+      {
+        return m_line > 0 && m_polled;
+      }
+
+      //! Retrieve the time at which the coroutine must be resumed.
+      //! @return deadline (monotonic clock) or negative if the
+      //! coroutine has no deadline.
+      double
+      getDeadline(void) const
+      {
+        return m_deadline;
+      }
+
+      //! @name Implementation of the coroutine macros.
+      //! @{
+
+      //! Retrieve the resumption point.
+      //! @return line of the resumption point, 0 at the beginning.
+      int
+      getLine(void) const
+      {
+        return m_line;
+      }
+
+      //! Record the resumption point.
+      //! @param[in] line line of the resumption point.
+      //! @param[in] polled true if the coroutine waits for a
+      //! condition.
+      void
+      suspend(int line, bool polled)
+      {
+        m_line = line;
+        m_polled = polled;
+      }
+
+      //! Record the end of the coroutine.
+      void
+      finish(void)
+      {
+        m_line = -1;
+        m_deadline = -1;
+        m_polled = false;
+      }
+
+      //! Set the deadline of the next wait.
+      //! @param[in] timeout amount of time from now.
+      void
+      setTimeout(double timeout)
+      {
+        m_deadline = Time::Clock::get() + timeout;
+        m_timed_out = false;
+      }
+
+      //! Check if the deadline passed.
+      //! @return true if the deadline passed.
+      bool
+      expired(void) const
+      {
+        return m_deadline >= 0 && Time::Clock::get() >= m_deadline;
+      }
+
+      //! Record the end of a wait.
+      //! @param[in] timed_out true if the wait timed out.
+      void
+      resumed(bool timed_out = false)
+      {
+        m_deadline = -1;
+        m_polled = false;
+        m_timed_out = timed_out;
+      }
+
+      //! @}
+
+    private:
+      //! Resumption point, 0 at the beginning, negative at the end.
+      int m_line;
+      //! Deadline of the current wait (monotonic clock).
+      double m_deadline;
+      //! True if the current wait is for a condition.
+      bool m_polled;
+      //! True if the last wait timed out.
+      bool m_timed_out;
+    };
+  }
+}
+
+//! Start the body of a coroutine.
+//! @param co coroutine state (DUNE::Tasks::Coroutine).
+#define DUNE_CO_BEGIN(co)                       \
+  switch ((co).getLine())                       \
+  {                                             \
+    case 0:
+
+//! End the body of a coroutine. Finished coroutines return
+//! immediately until they are reset.
+//! @param co coroutine state.
+#define DUNE_CO_END(co)                         \
+    (co).finish();                              \
+    break;                                      \
+    default:                                    \
+      break;                                    \
+  }                                             \
+  return
+
+//! Suspend the coroutine until its next call.
+//! @param co coroutine state.
+#define DUNE_CO_YIELD(co)                       \
+  do                                            \
+  {                                             \
+    (co).suspend(__LINE__, true);               \
+    return;                                     \
+    case __LINE__:                              \
+      (co).resumed();                           \
+  }                                             \
+  while (0)
+
+//! Suspend the coroutine until a condition holds. The condition is
+//! evaluated once on every call.
+//! @param co coroutine state.
+//! @param cond condition.
+#define DUNE_CO_AWAIT(co, cond)                 \
+  do                                            \
+  {                                             \
+    if (!(cond))                                \
+    {                                           \
+      (co).suspend(__LINE__, true);             \
+      return;                                   \
+      case __LINE__:                            \
+        if (!(cond))                            \
+          return;                               \
+        (co).resumed();                         \
+    }                                           \
+  }                                             \
+  while (0)
+
+//! Suspend the coroutine until a condition holds or a timeout
+//! expires, in which case Coroutine::timedOut() is true. The
+//! condition is evaluated once on every call.
+//! @param co coroutine state.
+//! @param cond condition.
+//! @param timeout timeout in seconds.
+#define DUNE_CO_AWAIT_FOR(co, cond, timeout)    \
+  do                                            \
+  {                                             \
+    (co).setTimeout(timeout);                   \
+    if (cond)                                   \
+    {                                           \
+      (co).resumed();                           \
+    }                                           \
+    else                                        \
+    {                                           \
+      (co).suspend(__LINE__, true);             \
+      return;                                   \
+      case __LINE__:                            \
+        if (cond)                               \
+          (co).resumed();                       \
+        else if ((co).expired())                \
+          (co).resumed(true);                   \
+        else                                    \
+          return;                               \
+    }                                           \
+  }                                             \
+  while (0)
+
+//! Suspend the coroutine for an amount of time.
+//! @param co coroutine state.
+//! @param duration amount of time in seconds.
+#define DUNE_CO_SLEEP(co, duration)             \
+  do                                            \
+  {                                             \
+    (co).setTimeout(duration);                  \
+    (co).suspend(__LINE__, false);              \
+    return;                                     \
+    case __LINE__:                              \
+      if (!(co).expired())                      \
+        return;                                 \
+      (co).resumed();                           \
+  }                                             \
+  while (0)
+
+#endif
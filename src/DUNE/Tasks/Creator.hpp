@@ -47,25 +47,22 @@ namespace DUNE
     struct Creator
     {
       Creator(void):
-        m_creator(0)
+        m_creator(0),
+        m_users(0)
       { }
 
       Creator(const task_creator_t& c):
-        m_creator(c)
+        m_creator(c),
+        m_users(0)
       { }
 
+      //! Associate this creator with a task plugin. The plugin is
+      //! only loaded when the first task instance is produced.
+      //! @param[in] file plugin file.
       void
       fromDDT(const char* file)
       {
-        try
-        {
-          m_loader.load(file);
-          m_creator = castUnsafe<task_creator_t, void*>(m_loader.getSymbol("dune_task_create"));
-        }
-        catch (System::Error& e)
-        {
-          DUNE_ERR("Task Creator", e.what());
-        }
+        m_file = file;
       }
 
       void
@@ -74,15 +71,74 @@ namespace DUNE
         m_creator = ptr;
       }
 
+      //! Get the creator function, loading the plugin if needed.
+      //! @return creator function or NULL if the plugin could not
+      //! be loaded.
       task_creator_t
       getCreatorPointer(void)
       {
+        if (m_creator == NULL && !m_file.empty())
+        {
+          try
+          {
+            m_loader.load(m_file.c_str());
+            m_creator = castUnsafe<task_creator_t, void*>(m_loader.getSymbol("dune_task_create"));
+          }
+          catch (System::Error& e)
+          {
+            DUNE_ERR("Task Creator", e.what());
+          }
+        }
+
         return m_creator;
       }
 
+      //! Register a new user of the creator.
+      void
+      acquire(void)
+      {
+        ++m_users;
+      }
+
+      //! Unregister a user of the creator. The plugin is unloaded
+      //! when the last user goes away; all task instances it
+      //! produced must have been destroyed by then.
+      void
+      release(void)
+      {
+        if (m_users == 0 || --m_users > 0)
+          return;
+
+        if (m_file.empty() || m_creator == NULL)
+          return;
+
+        m_creator = NULL;
+
+        try
+        {
+          m_loader.unload();
+        }
+        catch (System::Error& e)
+        {
+          DUNE_ERR("Task Creator", e.what());
+        }
+      }
+
+      //! Test if the task code is currently resident.
+      //! @return true if the task is static or its plugin is loaded.
+      bool
+      isLoaded(void) const
+      {
+        return m_creator != NULL;
+      }
+
       private:
         task_creator_t m_creator;
         DUNE::System::DynamicLoader m_loader;
+        //! Plugin file, empty for static tasks.
+        std::string m_file;
+        //! Number of live task instances.
+        unsigned m_users;
     };
   }
 }
@@ -0,0 +1,153 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Concurrency/Scheduler.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Tasks/DeadlineScheduler.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! Maximum amount of time the scheduler sleeps.
+    static const double c_idle_timeout = 1.0;
+
+    DeadlineScheduler::DeadlineScheduler(void)
+    { }
+
+    DeadlineScheduler::~DeadlineScheduler(void)
+    {
+      if (isCreated())
+      {
+        stop();
+        {
+          Concurrency::ScopedCondition l(m_cond);
+          m_cond.signal();
+        }
+        join();
+      }
+
+      // Do not leave tasks blocked forever.
+      while (!m_entries.empty())
+      {
+        release(m_entries.top().slot);
+        m_entries.pop();
+      }
+    }
+
+    double
+    DeadlineScheduler::getNextDeadline(double time, double period, double phase)
+    {
+      double offset = phase * period;
+      return (std::floor((time - offset) / period) + 1.0) * period + offset;
+    }
+
+    void
+    DeadlineScheduler::wait(Slot& slot, double deadline, unsigned priority)
+    {
+      {
+        Concurrency::ScopedMutex l(m_start_lock);
+        if (!isCreated())
+          start();
+      }
+
+      {
+        Concurrency::ScopedCondition l(slot.m_cond);
+        slot.m_released = false;
+      }
+
+      {
+        Concurrency::ScopedCondition l(m_cond);
+
+        Entry entry;
+        entry.deadline = deadline;
+        entry.priority = priority;
+        entry.slot = &slot;
+        m_entries.push(entry);
+
+        if (m_entries.top().slot == &slot)
+          m_cond.signal();
+      }
+
+      Concurrency::ScopedCondition l(slot.m_cond);
+      while (!slot.m_released)
+        slot.m_cond.wait();
+    }
+
+    void
+    DeadlineScheduler::release(Slot* slot)
+    {
+      Concurrency::ScopedCondition l(slot->m_cond);
+      slot->m_released = true;
+      slot->m_cond.signal();
+    }
+
+    void
+    DeadlineScheduler::run(void)
+    {
+      try
+      {
+        setPriority(Concurrency::Scheduler::POLICY_RR, Concurrency::Scheduler::maximumPriority());
+      }
+      catch (...)
+      { }
+
+      while (!isStopping())
+      {
+        Concurrency::ScopedCondition l(m_cond);
+
+        if (m_entries.empty())
+        {
+          m_cond.wait(c_idle_timeout);
+          continue;
+        }
+
+        double delta = m_entries.top().deadline - Time::Clock::get();
+        if (delta > 0)
+        {
+          m_cond.wait(std::min(delta, c_idle_timeout));
+          continue;
+        }
+
+        double now = Time::Clock::get();
+        while (!m_entries.empty() && m_entries.top().deadline <= now)
+        {
+          release(m_entries.top().slot);
+          m_entries.pop();
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,137 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef DUNE_TASKS_DEADLINE_SCHEDULER_HPP_INCLUDED_
+#define DUNE_TASKS_DEADLINE_SCHEDULER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+#include <queue>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DeadlineScheduler;
+
+    //! Central timer shared by periodic tasks. Tasks block until
+    //! their deadline and are woken up in deadline order; tasks with
+    //! the same deadline are woken up by decreasing priority.
+    class DeadlineScheduler: public Concurrency::Thread
+    {
+    public:
+      //! Wake-up slot of one task.
+      class Slot
+      {
+      public:
+        Slot(void):
+          m_released(false)
+        { }
+
+      private:
+        //! Condition signaled on release.
+        Concurrency::Condition m_cond;
+        //! True if the slot was released.
+        bool m_released;
+
+        friend class DeadlineScheduler;
+      };
+
+      //! Constructor.
+      DeadlineScheduler(void);
+
+      //! Destructor. Releases all pending slots.
+      ~DeadlineScheduler(void);
+
+      //! Block the calling thread until a given deadline.
+      //! @param[in] slot wake-up slot of the calling task.
+      //! @param[in] deadline absolute time (monotonic clock).
+      //! @param[in] priority task priority.
+      void
+      wait(Slot& slot, double deadline, unsigned priority);
+
+      //! Compute the first deadline after a given time on the grid
+      //! defined by a period and a phase. Tasks sharing the same
+      //! period and phase are therefore woken up together.
+      //! @param[in] time absolute time (monotonic clock).
+      //! @param[in] period period in seconds.
+      //! @param[in] phase phase as a fraction of the period.
+      //! @return next deadline.
+      static double
+      getNextDeadline(double time, double period, double phase);
+
+    private:
+      //! Pending wake-up.
+      struct Entry
+      {
+        //! Absolute time (monotonic clock).
+        double deadline;
+        //! Task priority.
+        unsigned priority;
+        //! Slot to release.
+        Slot* slot;
+      };
+
+      //! Order entries by deadline and then by priority.
+      struct EntryOrder
+      {
+        bool
+        operator()(const Entry& a, const Entry& b) const
+        {
+          if (a.deadline != b.deadline)
+            return a.deadline > b.deadline;
+          return a.priority < b.priority;
+        }
+      };
+
+      //! Pending wake-ups.
+      std::priority_queue<Entry, std::vector<Entry>, EntryOrder> m_entries;
+      //! Condition protecting pending wake-ups.
+      Concurrency::Condition m_cond;
+      //! Lock protecting thread creation.
+      Concurrency::Mutex m_start_lock;
+
+      //! Release a slot.
+      //! @param[in] slot slot.
+      static void
+      release(Slot* slot);
+
+      void
+      run(void);
+    };
+  }
+}
+
+#endif
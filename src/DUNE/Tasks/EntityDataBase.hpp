@@ -31,18 +31,39 @@
 // ISO C++ 98 headers.
 #include <stdexcept>
 #include <map>
+#include <vector>
 
 // DUNE headers.
+#include <DUNE/Config.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Utils/String.hpp>
 
+// Check if we can use GCC's atomic functions.
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  ifndef DUNE_TASKS_ENTITY_DATA_BASE_GCC
+#    define DUNE_TASKS_ENTITY_DATA_BASE_GCC
+#  endif
+#endif
+
 namespace DUNE
 {
   namespace Tasks
   {
+    //! Entities of all tasks. Entity identifiers are assigned in
+    //! sequence and index a fixed table, so looking up an entity by
+    //! identifier never takes a lock: entries are never modified
+    //! once reserved and only the number of entries is published
+    //! after each reservation. Label lookups use a map guarded by a
+    //! lock and are meant to be done once, when tasks resolve their
+    //! entities; resolve() also accepts a list of labels to resolve
+    //! them under a single lock.
     class EntityDataBase
     {
     public:
+      //! Maximum number of entities (identifiers are 8-bit and the
+      //! last value means 'unknown entity').
+      static const unsigned c_max_entities = 255;
+
       //! Data base entry.
       struct Entity
       {
@@ -90,18 +111,24 @@ namespace DUNE
         { }
       };
 
+      struct TooManyEntities: public std::runtime_error
+      {
+        TooManyEntities(const std::string& label):
+          std::runtime_error(DTR("no entity id left for entity label: ") + label)
+        { }
+      };
+
       EntityDataBase(void):
-        m_next_id(0)
+        m_count(0)
       {
+        for (unsigned i = 0; i < c_max_entities; ++i)
+          m_by_id[i] = NULL;
       }
 
       ~EntityDataBase(void)
       {
-        Concurrency::ScopedMutex l(m_lock);
-
-        EntitiesById::iterator itr = m_by_id.begin();
-        for (; itr != m_by_id.end(); ++itr)
-          delete itr->second;
+        for (unsigned i = 0; i < m_count; ++i)
+          delete m_by_id[i];
       }
 
       bool
@@ -115,9 +142,7 @@ namespace DUNE
       bool
       idExists(unsigned int id)
       {
-        Concurrency::ScopedMutex l(m_lock);
-        EntitiesById::iterator itr = m_by_id.find(id);
-        return (itr != m_by_id.end());
+        return id < getCount();
       }
 
       unsigned int
@@ -131,9 +156,18 @@ namespace DUNE
         EntitiesByLabel::iterator itr = m_by_label.find(label);
 
         if (itr != m_by_label.end())
+        {
+          // Tasks restarted at run time keep their identifiers.
+          if (itr->second->task_name == task_name)
+            return itr->second->id;
+
           throw ReservedUnique(label);
+        }
+
+        if (m_count >= c_max_entities)
+          throw TooManyEntities(label);
 
-        unsigned int id = m_next_id++;
+        unsigned int id = m_count;
         Entity* entry = new Entity;
         entry->label = label;
         entry->id = id;
@@ -143,6 +177,12 @@ namespace DUNE
         m_by_id[id] = entry;
         m_by_label[label] = entry;
 
+        // Publish the entry only once it is complete.
+#if defined(DUNE_TASKS_ENTITY_DATA_BASE_GCC)
+        __sync_synchronize();
+#endif
+        m_count = id + 1;
+
         return id;
       }
 
@@ -159,6 +199,28 @@ namespace DUNE
         return itr->second->id;
       }
 
+      //! Resolve several entity labels at once.
+      //! @param[in] labels entity labels.
+      //! @param[out] ids entity ids, in the same order.
+      //! @throw NonexistentLabel if a label has no associated id.
+      void
+      resolve(const std::vector<std::string>& labels, std::vector<unsigned>& ids)
+      {
+        ids.resize(labels.size());
+
+        Concurrency::ScopedMutex l(m_lock);
+
+        for (unsigned i = 0; i < labels.size(); ++i)
+        {
+          EntitiesByLabel::iterator itr = m_by_label.find(labels[i]);
+
+          if (itr == m_by_label.end())
+            throw NonexistentLabel(labels[i]);
+
+          ids[i] = itr->second->id;
+        }
+      }
+
       std::string
       resolveTaskName(const std::string& label)
       {
@@ -175,45 +237,68 @@ namespace DUNE
       const std::string&
       resolve(unsigned int id)
       {
-        Concurrency::ScopedMutex l(m_lock);
+        if (id >= getCount())
+          throw InvalidId(id);
 
-        EntitiesById::iterator itr = m_by_id.find(id);
+        return m_by_id[id]->label;
+      }
 
-        if (itr == m_by_id.end())
-          throw InvalidId(id);
+      //! Find an entity by id without throwing.
+      //! @param[in] id entity id.
+      //! @return entity or NULL if the id is not reserved.
+      const Entity*
+      find(unsigned int id)
+      {
+        if (id >= getCount())
+          return NULL;
 
-        return itr->second->label;
+        return m_by_id[id];
       }
 
       void
       contents(std::vector<Entity*>& devs)
       {
-        Concurrency::ScopedMutex l(m_lock);
+        unsigned count = getCount();
 
-        for (EntitiesById::iterator itr = m_by_id.begin(); itr != m_by_id.end(); ++itr)
-          devs.push_back(itr->second);
+        for (unsigned i = 0; i < count; ++i)
+          devs.push_back(m_by_id[i]);
       }
 
       std::map<unsigned, std::string>
       entries(void)
       {
         std::map<unsigned, std::string> ent;
+        unsigned count = getCount();
 
-        Concurrency::ScopedMutex l(m_lock);
-
-        for (EntitiesById::iterator itr = m_by_id.begin(); itr != m_by_id.end(); ++itr)
-          ent[itr->first] = itr->second->label;
+        for (unsigned i = 0; i < count; ++i)
+          ent[i] = m_by_id[i]->label;
 
         return ent;
       }
 
     private:
       Concurrency::Mutex m_lock;
-      unsigned int m_next_id;
-      typedef std::map<unsigned, Entity*> EntitiesById;
-      EntitiesById m_by_id;
+      //! Number of published entries.
+      volatile unsigned m_count;
+      //! Entries by id.
+      Entity* m_by_id[c_max_entities];
       typedef std::map<std::string, Entity*> EntitiesByLabel;
       EntitiesByLabel m_by_label;
+
+      //! Get the number of published entries. Entries below this
+      //! number are complete and never change.
+      unsigned
+      getCount(void) const
+      {
+        unsigned count = m_count;
+#if defined(DUNE_TASKS_ENTITY_DATA_BASE_GCC)
+        __sync_synchronize();
+#else
+        Concurrency::ScopedMutex l(const_cast<Concurrency::Mutex&>(m_lock));
+        count = m_count;
+#endif
+        return count;
+      }
     };
   }
 }
@@ -91,6 +91,28 @@ namespace DUNE
       { }
     };
 
+    //! Thrown when starting a task that is already running.
+    class TaskAlreadyRunning: public std::runtime_error
+    {
+    public:
+      //! Constructor.
+      //! @param[in] name task name.
+      TaskAlreadyRunning(const std::string& name):
+        std::runtime_error(Utils::String::str(DTR("task '%s' is already running"), name.c_str()))
+      { }
+    };
+
+    //! Thrown when stopping a task that is not running.
+    class TaskNotRunning: public std::runtime_error
+    {
+    public:
+      //! Constructor.
+      //! @param[in] name task name.
+      TaskNotRunning(const std::string& name):
+        std::runtime_error(Utils::String::str(DTR("task '%s' is not running"), name.c_str()))
+      { }
+    };
+
     //! Value is invalid for a given parameter.
     class InvalidValue: public std::invalid_argument
     {
@@ -0,0 +1,326 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <algorithm>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Thread.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/Concurrency/ScopedCondition.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/System/HeapArena.hpp>
+#include <DUNE/Tasks/Task.hpp>
+#include <DUNE/Tasks/Executor.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    //! Maximum amount of time an idle worker sleeps.
+    static const double c_idle_timeout = 1.0;
+
+    class Executor::Worker: public Concurrency::Thread
+    {
+    public:
+      //! Ready steps.
+      std::deque<Entry> ready;
+      //! Lock protecting ready steps.
+      Concurrency::Mutex lock;
+
+      Worker(Executor& executor, unsigned index):
+        m_executor(executor),
+        m_index(index)
+      { }
+
+    private:
+      //! Parent executor.
+      Executor& m_executor;
+      //! Worker index.
+      unsigned m_index;
+
+      void
+      run(void)
+      {
+        Entry entry;
+
+        while (!isStopping() && !m_executor.m_stopping)
+        {
+          if (m_executor.take(m_index, entry))
+            m_executor.execute(entry);
+          else
+            m_executor.wait(m_index);
+        }
+      }
+    };
+
+    Executor::Executor(unsigned workers):
+      m_started(false),
+      m_stopping(false)
+    {
+      workers = std::max(1u, workers);
+      for (unsigned i = 0; i < workers; ++i)
+        m_workers.push_back(new Worker(*this, i));
+    }
+
+    Executor::~Executor(void)
+    {
+      stop();
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+        delete m_workers[i];
+    }
+
+    void
+    Executor::add(Task* task)
+    {
+      m_tasks.push_back(task);
+
+      Entry entry;
+      entry.task = task;
+      entry.deadline = Time::Clock::get();
+      entry.priority = task->getPriority();
+      schedule(entry);
+    }
+
+    void
+    Executor::remove(Task* task)
+    {
+      std::vector<Task*>::iterator titr = std::find(m_tasks.begin(), m_tasks.end(), task);
+      if (titr == m_tasks.end())
+        return;
+
+      m_tasks.erase(titr);
+
+      {
+        Concurrency::ScopedCondition l(m_cond);
+
+        // Look for the step among the timers.
+        std::vector<Entry> entries;
+        bool found = false;
+        while (!m_timers.empty())
+        {
+          if (m_timers.top().task == task)
+            found = true;
+          else
+            entries.push_back(m_timers.top());
+          m_timers.pop();
+        }
+
+        for (size_t i = 0; i < entries.size(); ++i)
+          m_timers.push(entries[i]);
+
+        if (found)
+          return;
+
+        m_removed.insert(task);
+      }
+
+      // Look for the step among ready steps.
+      for (size_t i = 0; i < m_workers.size(); ++i)
+      {
+        bool found = false;
+
+        {
+          Concurrency::ScopedMutex l(m_workers[i]->lock);
+          std::deque<Entry>& ready = m_workers[i]->ready;
+          for (std::deque<Entry>::iterator itr = ready.begin(); itr != ready.end(); ++itr)
+          {
+            if (itr->task == task)
+            {
+              ready.erase(itr);
+              found = true;
+              break;
+            }
+          }
+        }
+
+        if (found)
+        {
+          Concurrency::ScopedCondition l(m_cond);
+          m_removed.erase(task);
+          return;
+        }
+      }
+
+      // The step is being executed.
+      Concurrency::ScopedCondition l(m_cond);
+      while (!m_stopping && m_removed.find(task) != m_removed.end())
+        m_cond.wait(c_idle_timeout);
+
+      m_removed.erase(task);
+    }
+
+    void
+    Executor::start(void)
+    {
+      if (m_started)
+        return;
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->start();
+
+      m_started = true;
+    }
+
+    void
+    Executor::stop(void)
+    {
+      if (!m_started)
+        return;
+
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        m_stopping = true;
+        m_cond.broadcast();
+      }
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->stop();
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->join();
+
+      for (unsigned i = 0; i < m_tasks.size(); ++i)
+        m_tasks[i]->finishSteps();
+
+      m_started = false;
+    }
+
+    bool
+    Executor::drop(Task* task)
+    {
+      std::set<Task*>::iterator itr = m_removed.find(task);
+      if (itr == m_removed.end())
+        return false;
+
+      m_removed.erase(itr);
+      m_cond.broadcast();
+      return true;
+    }
+
+    void
+    Executor::schedule(const Entry& entry)
+    {
+      Concurrency::ScopedCondition l(m_cond);
+      if (drop(entry.task))
+        return;
+
+      m_timers.push(entry);
+
+      // Only wake up a worker if the new step is the next one.
+      if (m_timers.top().task == entry.task)
+        m_cond.signal();
+    }
+
+    bool
+    Executor::take(unsigned index, Entry& entry)
+    {
+      Worker* self = m_workers[index];
+
+      {
+        Concurrency::ScopedMutex l(self->lock);
+        if (!self->ready.empty())
+        {
+          entry = self->ready.front();
+          self->ready.pop_front();
+          return true;
+        }
+      }
+
+      for (unsigned i = 1; i < m_workers.size(); ++i)
+      {
+        Worker* peer = m_workers[(index + i) % m_workers.size()];
+        Concurrency::ScopedMutex l(peer->lock);
+        if (!peer->ready.empty())
+        {
+          entry = peer->ready.back();
+          peer->ready.pop_back();
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void
+    Executor::wait(unsigned index)
+    {
+      Concurrency::ScopedCondition l(m_cond);
+
+      if (m_stopping)
+        return;
+
+      if (m_timers.empty())
+      {
+        m_cond.wait(c_idle_timeout);
+        return;
+      }
+
+      double delta = m_timers.top().deadline - Time::Clock::get();
+      if (delta > 0)
+      {
+        m_cond.wait(std::min(delta, c_idle_timeout));
+        return;
+      }
+
+      double now = Time::Clock::get();
+      Worker* self = m_workers[index];
+      Concurrency::ScopedMutex ml(self->lock);
+      while (!m_timers.empty() && m_timers.top().deadline <= now)
+      {
+        self->ready.push_back(m_timers.top());
+        m_timers.pop();
+      }
+
+      // Let idle peers steal the remaining steps.
+      if (self->ready.size() > 1)
+        m_cond.broadcast();
+    }
+
+    void
+    Executor::execute(Entry& entry)
+    {
+      {
+        Concurrency::ScopedCondition l(m_cond);
+        if (drop(entry.task))
+          return;
+      }
+
+      double delay = entry.task->step();
+      // The arena of the task may be destroyed once it is removed.
+      System::HeapArena::select(NULL);
+      entry.deadline = Time::Clock::get() + delay;
+      entry.priority = entry.task->getPriority();
+      schedule(entry);
+    }
+  }
+}
@@ -0,0 +1,178 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_EXECUTOR_HPP_INCLUDED_
+#define DUNE_TASKS_EXECUTOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+#include <queue>
+#include <set>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Condition.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Forward declarations.
+    class Task;
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Executor;
+
+    //! Fixed pool of worker threads executing the steps of
+    //! lightweight tasks. Steps become ready at their deadline and
+    //! are released to the worker that notices it; idle workers steal
+    //! ready steps from the other workers.
+    class Executor
+    {
+    public:
+      //! Constructor.
+      //! @param[in] workers number of worker threads.
+      Executor(unsigned workers);
+
+      //! Destructor. Stops all workers.
+      ~Executor(void);
+
+      //! Schedule a task for execution. The first step is executed
+      //! as soon as possible.
+      //! @param[in] task task.
+      void
+      add(Task* task);
+
+      //! Stop executing a task. When this function returns no step
+      //! of the task is running nor scheduled, and its resources can
+      //! be released with Task::finishSteps().
+      //! @param[in] task task.
+      void
+      remove(Task* task);
+
+      //! Start worker threads.
+      void
+      start(void);
+
+      //! Stop and join worker threads, releasing the resources of all
+      //! tasks.
+      void
+      stop(void);
+
+      //! Retrieve the number of worker threads.
+      //! @return number of worker threads.
+      unsigned
+      getWorkerCount(void) const
+      {
+        return m_workers.size();
+      }
+
+    private:
+      // Forward declarations.
+      class Worker;
+
+      //! Scheduled step.
+      struct Entry
+      {
+        //! Task.
+        Task* task;
+        //! Absolute time of execution (monotonic clock).
+        double deadline;
+        //! Task priority.
+        unsigned priority;
+      };
+
+      //! Order entries by deadline and then by priority.
+      struct EntryOrder
+      {
+        bool
+        operator()(const Entry& a, const Entry& b) const
+        {
+          if (a.deadline != b.deadline)
+            return a.deadline > b.deadline;
+          return a.priority < b.priority;
+        }
+      };
+
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Tasks.
+      std::vector<Task*> m_tasks;
+      //! Removed tasks whose step was not found yet. Each task has
+      //! exactly one step in flight, which is dropped when its worker
+      //! notices the removal.
+      std::set<Task*> m_removed;
+      //! Steps waiting for their deadline.
+      std::priority_queue<Entry, std::vector<Entry>, EntryOrder> m_timers;
+      //! Condition protecting timers.
+      Concurrency::Condition m_cond;
+      //! True if workers were started.
+      bool m_started;
+      //! True if workers must stop.
+      volatile bool m_stopping;
+
+      //! Schedule a step, unless its task was removed.
+      //! @param[in] entry step.
+      void
+      schedule(const Entry& entry);
+
+      //! Drop the step of a removed task. Must be called with the
+      //! timer condition locked.
+      //! @param[in] task task.
+      //! @return true if the task was removed, false otherwise.
+      bool
+      drop(Task* task);
+
+      //! Retrieve a ready step from a worker or from its peers.
+      //! @param[in] index worker index.
+      //! @param[out] entry step.
+      //! @return true if a step was retrieved, false otherwise.
+      bool
+      take(unsigned index, Entry& entry);
+
+      //! Wait for the next deadline and release all due steps to a
+      //! worker.
+      //! @param[in] index worker index.
+      void
+      wait(unsigned index);
+
+      //! Execute a step and schedule the next one.
+      //! @param[in] entry step.
+      void
+      execute(Entry& entry);
+
+      //! Non-copyable.
+      Executor(const Executor&);
+
+      //! Non-assignable.
+      Executor&
+      operator=(const Executor&);
+    };
+  }
+}
+
+#endif
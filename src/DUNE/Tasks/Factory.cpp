@@ -45,15 +45,32 @@ namespace DUNE
     DUNE::Tasks::Task*
     Factory::produce(const std::string& name, const std::string& label, Context& ctx)
     {
-      if (!exists(name))
+      Table::iterator itr = c_table.find(name);
+      if (itr == c_table.end())
         return 0;
 
-      task_creator_t creator = c_table[name].getCreatorPointer();
-
+      task_creator_t creator = itr->second.getCreatorPointer();
       if (creator == NULL)
         return 0;
 
-      return creator(label, ctx);
+      // Count the instance; failed constructions give it back.
+      itr->second.acquire();
+
+      Task* task = 0;
+      try
+      {
+        task = creator(label, ctx);
+      }
+      catch (...)
+      {
+        itr->second.release();
+        throw;
+      }
+
+      if (task == 0)
+        itr->second.release();
+
+      return task;
     }
 
     bool
@@ -62,6 +79,32 @@ namespace DUNE
       return c_table.find(name) != c_table.end();
     }
 
+    void
+    Factory::acquire(const std::string& name)
+    {
+      Table::iterator itr = c_table.find(name);
+      if (itr != c_table.end())
+        itr->second.acquire();
+    }
+
+    void
+    Factory::release(const std::string& name)
+    {
+      Table::iterator itr = c_table.find(name);
+      if (itr != c_table.end())
+        itr->second.release();
+    }
+
+    bool
+    Factory::isLoaded(const std::string& name)
+    {
+      Table::iterator itr = c_table.find(name);
+      if (itr == c_table.end())
+        return false;
+
+      return itr->second.isLoaded();
+    }
+
     void
     Factory::registerStaticTask(const std::string& name, task_creator_t creator)
     {
@@ -54,6 +54,25 @@ namespace DUNE
       static bool
       exists(const std::string& name);
 
+      //! Keep the code of a task resident, even if it has no live
+      //! instances.
+      //! @param[in] name task name.
+      static void
+      acquire(const std::string& name);
+
+      //! Release a task instance produced by produce() (after it has
+      //! been destroyed) or a reference taken with acquire(). Task
+      //! plugins are unloaded when their last reference is released.
+      //! @param[in] name task name.
+      static void
+      release(const std::string& name);
+
+      //! Test if the code of a task is currently resident.
+      //! @param[in] name task name.
+      //! @return true if the task is static or its plugin is loaded.
+      static bool
+      isLoaded(const std::string& name);
+
       static void
       registerStaticTask(const std::string& name, task_creator_t creator);
 
@@ -30,14 +30,17 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <set>
 #include <cstddef>
 
 // DUNE headers.
 #include <DUNE/Time/Delay.hpp>
+#include <DUNE/System/Resources.hpp>
 #include <DUNE/Tasks/Task.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Factory.hpp>
 #include <DUNE/Tasks/Exceptions.hpp>
+#include <DUNE/Tasks/Executor.hpp>
 #include <DUNE/Tasks/Manager.hpp>
 
 namespace DUNE
@@ -45,25 +48,47 @@ namespace DUNE
   namespace Tasks
   {
     Manager::Manager(Context& ctx):
-      m_ctx(ctx)
+      m_ctx(ctx),
+      m_executor(NULL)
     {
       // Get all sections.
       std::vector<std::string> vec = m_ctx.config.sections();
 
       for (unsigned int i = 0; i < vec.size(); ++i)
       {
-        // If this section is not a task continue.
-        if (!Factory::exists(getTaskName(vec[i])))
-          continue;
+        if (isEnabled(vec[i]))
+          createTask(vec[i]);
+      }
+
+      resolveDependencies();
+      lockMemory();
+    }
 
-        // Check if the task is enabled acording to the currently
-        // selected profiles.
-        std::string profiles;
-        m_ctx.config.get(vec[i], "Enabled", "Never", profiles);
+    bool
+    Manager::isEnabled(const std::string& section) const
+    {
+      // If this section is not a task continue.
+      if (!Factory::exists(getTaskName(section)))
+        return false;
 
-        if (ctx.profiles.isSelected(profiles))
-          createTask(vec[i]);
+      // Check if the task is enabled acording to the currently
+      // selected profiles.
+      std::string profiles;
+      m_ctx.config.get(section, "Enabled", "Never", profiles);
+      return m_ctx.profiles.isSelected(profiles);
+    }
+
+    Executor&
+    Manager::getExecutor(void)
+    {
+      if (m_executor == NULL)
+      {
+        unsigned workers = 0;
+        m_ctx.config.get("General", "Thread Pool Size", "2", workers);
+        m_executor = new Executor(workers);
       }
+
+      return *m_executor;
     }
 
     void
@@ -95,8 +120,78 @@ namespace DUNE
       }
     }
 
+    void
+    Manager::lockMemory(void)
+    {
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        if (!itr->second->requiresLockedMemory())
+          continue;
+
+        try
+        {
+          System::Resources::lockMemory();
+        }
+        catch (std::exception& e)
+        {
+          itr->second->err("%s", e.what());
+        }
+
+        break;
+      }
+    }
+
+    void
+    Manager::resolveDependencies(void)
+    {
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+      {
+        Task* task = itr->second;
+        std::set<std::string> visited;
+
+        if (dependsOn(itr->first, itr->first, visited))
+        {
+          task->err(DTR("circular startup dependency, starting without dependencies"));
+          continue;
+        }
+
+        const std::vector<std::string>& deps = task->getStartAfter();
+        for (size_t i = 0; i < deps.size(); ++i)
+        {
+          std::map<std::string, Task*>::iterator ditr = m_tasks.find(deps[i]);
+          if (ditr == m_tasks.end())
+            task->war(DTR("ignoring startup dependency on inactive task %s"), deps[i].c_str());
+          else
+            task->addDependency(ditr->second);
+        }
+      }
+    }
+
+    bool
+    Manager::dependsOn(const std::string& section, const std::string& target,
+                       std::set<std::string>& visited)
+    {
+      std::map<std::string, Task*>::iterator itr = m_tasks.find(section);
+      if (itr == m_tasks.end() || !visited.insert(section).second)
+        return false;
+
+      const std::vector<std::string>& deps = itr->second->getStartAfter();
+      for (size_t i = 0; i < deps.size(); ++i)
+      {
+        if (deps[i] == target || dependsOn(deps[i], target, visited))
+          return true;
+      }
+
+      return false;
+    }
+
     Manager::~Manager(void)
     {
+      // Stop pooled tasks.
+      delete m_executor;
+
       // Request all tasks to stop.
       for (unsigned int i = 0; i < m_list.size(); ++i)
       {
@@ -115,6 +210,7 @@ namespace DUNE
           join(m_list[i]);
         delete m_tasks[m_list[i]];
         m_tasks[m_list[i]] = NULL;
+        Factory::release(getTaskName(m_list[i]));
       }
     }
 
@@ -161,7 +257,19 @@ namespace DUNE
       try
       {
         task->inf(DTR("starting"));
-        task->start();
+
+        if (task->isPooled())
+        {
+          if (task->hasSchedulingOptions())
+            task->war(DTR("execution policy and processor affinity are ignored in the thread pool"));
+
+          getExecutor().add(task);
+          m_executor->start();
+        }
+        else
+        {
+          task->start();
+        }
       }
       catch (std::exception& e)
       {
@@ -173,6 +281,168 @@ namespace DUNE
       }
     }
 
+    void
+    Manager::add(const std::string& section)
+    {
+      std::string task_name = getTaskName(section);
+
+      if (isRunning(section))
+        throw TaskAlreadyRunning(section);
+
+      if (!Factory::exists(task_name))
+        throw InvalidTaskName(section);
+
+      Task* task = Factory::produce(task_name, section, m_ctx);
+      if (task == NULL)
+        throw InvalidTaskName(section);
+
+      // The task is already subscribed: loading its configuration
+      // resizes the mailbox, which must not happen while messages
+      // are being delivered to it.
+      m_ctx.mbus.pause();
+      m_ctx.mbus.synchronize();
+
+      try
+      {
+        task->loadConfig();
+        task->reserveEntities();
+      }
+      catch (...)
+      {
+        m_ctx.mbus.resume();
+        destroy(task, task_name);
+        throw;
+      }
+
+      m_ctx.mbus.resume();
+
+      m_tasks[section] = task;
+      m_list.push_back(section);
+
+      std::set<std::string> visited;
+      if (!dependsOn(section, section, visited))
+      {
+        const std::vector<std::string>& deps = task->getStartAfter();
+        for (size_t i = 0; i < deps.size(); ++i)
+        {
+          std::map<std::string, Task*>::iterator ditr = m_tasks.find(deps[i]);
+          if (ditr != m_tasks.end())
+            task->addDependency(ditr->second);
+        }
+      }
+
+      start(section);
+    }
+
+    void
+    Manager::remove(const std::string& section)
+    {
+      std::map<std::string, Task*>::iterator itr = m_tasks.find(section);
+      if (itr == m_tasks.end())
+        throw TaskNotRunning(section);
+
+      Task* task = itr->second;
+
+      if (task->isPooled())
+      {
+        if (m_executor != NULL)
+          m_executor->remove(task);
+        task->finishSteps();
+      }
+      else
+      {
+        stop(section);
+        if (task->isCreated())
+          join(section);
+      }
+
+      m_tasks.erase(itr);
+      m_list.erase(std::remove(m_list.begin(), m_list.end(), section), m_list.end());
+
+      for (itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        itr->second->removeDependency(task);
+
+      destroy(task, getTaskName(section));
+    }
+
+    void
+    Manager::destroy(Task* task, const std::string& task_name)
+    {
+      // Messages might still be in the middle of being delivered to
+      // the task.
+      m_ctx.mbus.unregisterRecipient(task);
+      m_ctx.mbus.synchronize();
+
+      delete task;
+      Factory::release(task_name);
+    }
+
+    void
+    Manager::restart(const std::string& section)
+    {
+      // Keep the task plugin loaded in between.
+      std::string task_name = getTaskName(section);
+      Factory::acquire(task_name);
+
+      try
+      {
+        remove(section);
+        add(section);
+      }
+      catch (...)
+      {
+        Factory::release(task_name);
+        throw;
+      }
+
+      Factory::release(task_name);
+    }
+
+    unsigned
+    Manager::reload(const std::string& path)
+    {
+      // Configuration of running tasks before loading the file.
+      std::map<std::string, std::map<std::string, std::string> > before;
+      std::map<std::string, Task*>::iterator itr = m_tasks.begin();
+      for (; itr != m_tasks.end(); ++itr)
+        before[itr->first] = m_ctx.config.getSection(itr->first);
+
+      m_ctx.config.parseFile(path.c_str());
+
+      unsigned count = 0;
+      std::string errors;
+      std::vector<std::string> sections = m_ctx.config.sections();
+      for (size_t i = 0; i < sections.size(); ++i)
+      {
+        const std::string& section = sections[i];
+        bool enabled = isEnabled(section);
+        bool running = isRunning(section);
+
+        try
+        {
+          if (running && !enabled)
+            remove(section);
+          else if (!running && enabled)
+            add(section);
+          else if (running && before[section] != m_ctx.config.getSection(section))
+            restart(section);
+          else
+            continue;
+
+          ++count;
+        }
+        catch (std::exception& e)
+        {
+          errors += (errors.empty() ? "" : "; ") + section + ": " + e.what();
+        }
+      }
+
+      if (!errors.empty())
+        throw std::runtime_error(errors);
+
+      return count;
+    }
+
     std::string
     Manager::getTaskName(const std::string& str)
     {
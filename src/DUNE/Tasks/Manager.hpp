@@ -31,6 +31,7 @@
 // ISO C++ 98 headers.
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 
 // DUNE headers.
@@ -46,6 +47,7 @@ namespace DUNE
     // Forward declarations
     struct Context;
     class Task;
+    class Executor;
 
     class Manager
     {
@@ -75,6 +77,48 @@ namespace DUNE
       void
       join(const std::string& name);
 
+      //! Create and start a task at run time, from its configuration
+      //! section.
+      //! @param[in] section task configuration section.
+      //! @throw InvalidTaskName if the section is not a task.
+      //! @throw TaskAlreadyRunning if the task is already running.
+      void
+      add(const std::string& section);
+
+      //! Stop and destroy a task at run time. Its bus subscriptions
+      //! are removed and its entities stay reserved, so they keep
+      //! their identifiers if the task is added again.
+      //! @param[in] section task configuration section.
+      //! @throw TaskNotRunning if the task is not running.
+      void
+      remove(const std::string& section);
+
+      //! Stop a task and start it again with the current
+      //! configuration.
+      //! @param[in] section task configuration section.
+      void
+      restart(const std::string& section);
+
+      //! Load a configuration file and reconcile the running tasks
+      //! with it: tasks that are no longer enabled are stopped, newly
+      //! enabled tasks are started and tasks whose configuration
+      //! changed are restarted.
+      //! @param[in] path configuration file.
+      //! @return number of tasks stopped, started or restarted.
+      //! @throw std::runtime_error if the file cannot be parsed or
+      //! some tasks failed, after all other tasks were handled.
+      unsigned
+      reload(const std::string& path);
+
+      //! Check if a task is running.
+      //! @param[in] section task configuration section.
+      //! @return true if the task exists, false otherwise.
+      bool
+      isRunning(const std::string& section) const
+      {
+        return m_tasks.find(section) != m_tasks.end();
+      }
+
       //! Retrieve the task name from a configuration section.
       //! @param str configuration section string.
       //! @return task name.
@@ -103,9 +147,50 @@ namespace DUNE
       std::map<std::string, Task*> m_tasks;
       //! Task context.
       Context& m_ctx;
+      //! Thread pool executing pooled tasks.
+      Executor* m_executor;
 
       void
       createTask(const std::string& section);
+
+      //! Destroy a task created at run time once the bus no longer
+      //! delivers messages to it, and release its plugin.
+      //! @param[in] task task.
+      //! @param[in] task_name task name.
+      void
+      destroy(Task* task, const std::string& task_name);
+
+      //! Retrieve the thread pool, creating it if needed.
+      //! @return thread pool.
+      Executor&
+      getExecutor(void);
+
+      //! Check if a configuration section is an enabled task.
+      //! @param[in] section configuration section.
+      //! @return true if the section is a task enabled by the
+      //! selected profiles.
+      bool
+      isEnabled(const std::string& section) const;
+
+      //! Bind each task to the tasks named by its 'Start After'
+      //! parameter. Tasks in dependency cycles start without
+      //! dependencies.
+      void
+      resolveDependencies(void);
+
+      //! Lock the memory of the process in RAM if any task has the
+      //! 'Lock Memory' parameter enabled.
+      void
+      lockMemory(void);
+
+      //! Test if a task depends, directly or not, on another.
+      //! @param[in] section task configuration section.
+      //! @param[in] target configuration section of the other task.
+      //! @param[in,out] visited sections already searched.
+      //! @return true if section depends on target, false otherwise.
+      bool
+      dependsOn(const std::string& section, const std::string& target,
+                std::set<std::string>& visited);
     };
   }
 }
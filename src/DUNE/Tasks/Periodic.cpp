@@ -28,47 +28,100 @@
 // ISO C++ 98 headers.
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Periodic.hpp>
 #include <DUNE/Time/Clock.hpp>
-#include <DUNE/Time/Delay.hpp>
 
 namespace DUNE
 {
   namespace Tasks
   {
+    //! Minimum amount of time between overrun reports.
+    static const double c_overrun_report_period = 10.0;
+
     Periodic::Periodic(const std::string& name, Context& ctx):
       Task(name, ctx),
       m_run_count(0),
-      m_run_time(0)
+      m_run_time(0),
+      m_overrun_count(0),
+      m_overrun_report(0),
+      m_overrun_time(0),
+      m_deadline(0),
+      m_latency_count(0),
+      m_latency_sum(0),
+      m_latency_max(0)
     {
       param(DTR_RT("Execution Frequency"), m_frequency)
       .units(Units::Hertz)
       .defaultValue("1.0")
       .description(DTR("Frequency at which task is executed"));
+
+      param(DTR_RT("Execution Phase"), m_phase)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("0.0")
+      .minimumValue("0.0")
+      .maximumValue("1.0")
+      .description(DTR("Offset of the execution instants as a fraction of the"
+                       " period. Tasks with the same frequency and phase are"
+                       " executed in order of priority"));
+    }
+
+    double
+    Periodic::getNextDeadline(double deadline)
+    {
+      double period = 1.0 / m_frequency;
+      double now = Time::Clock::get();
+      if (m_overrun_time == 0)
+        m_overrun_time = now;
+
+      double next = DeadlineScheduler::getNextDeadline(std::max(deadline, now), period, m_phase);
+
+      // Cycles skipped because the last one ended too late.
+      if (now > deadline + period)
+      {
+        unsigned missed = (unsigned)((now - deadline) / period);
+        m_overrun_count += missed;
+        m_overrun_report += missed;
+      }
+
+      if (m_overrun_report > 0 && now - m_overrun_time >= c_overrun_report_period)
+      {
+        war(DTR("missed %u cycles in the last %0.1f seconds"),
+            m_overrun_report, now - m_overrun_time);
+        m_overrun_report = 0;
+        m_overrun_time = now;
+      }
+
+      return next;
+    }
+
+    void
+    Periodic::updateLatency(double now)
+    {
+      double latency = std::max(0.0, now - m_deadline);
+      m_latency_sum += latency;
+      m_latency_max = std::max(m_latency_max, latency);
+      ++m_latency_count;
     }
 
     void
     Periodic::onMain(void)
     {
       double now = Time::Clock::get();
-      double delay = (1 / m_frequency);
-      double next_inv = now + delay;
+      m_deadline = getNextDeadline(now);
       m_run_time = now;
 
       while (!stopping())
       {
-        delay = (1.0 / m_frequency);
-
-        if (next_inv > now)
-          Time::Delay::wait(next_inv - now);
+        m_ctx.scheduler.wait(m_slot, m_deadline, getPriority());
 
-        next_inv += delay;
         now = Time::Clock::get();
         m_run_time = now;
+        updateLatency(now);
 
         // Perform job.
         consumeMessages();
@@ -78,8 +131,23 @@ namespace DUNE
           ++m_run_count;
         }
 
-        now = Time::Clock::get();
+        m_deadline = getNextDeadline(m_deadline);
       }
     }
+
+    double
+    Periodic::onStep(void)
+    {
+      m_run_time = Time::Clock::get();
+      if (m_deadline > 0)
+        updateLatency(m_run_time);
+
+      consumeMessages();
+      task();
+      ++m_run_count;
+
+      m_deadline = getNextDeadline(m_run_time);
+      return m_deadline - Time::Clock::get();
+    }
   }
 }
@@ -36,6 +36,7 @@
 
 // Local headers.
 #include <DUNE/Tasks/Task.hpp>
+#include <DUNE/Tasks/DeadlineScheduler.hpp>
 
 namespace DUNE
 {
@@ -93,6 +94,36 @@ namespace DUNE
         return m_run_count;
       }
 
+      //! Retrieve the number of cycles that were not executed
+      //! because a previous cycle exceeded the task period.
+      //! @return overrun count.
+      inline unsigned
+      getOverrunCount(void) const
+      {
+        return m_overrun_count;
+      }
+
+      //! Retrieve the average delay between the deadline of a cycle
+      //! and the instant the task was woken up to run it.
+      //! @return average wake-up latency in seconds.
+      inline double
+      getAverageLatency(void) const
+      {
+        if (m_latency_count == 0)
+          return 0;
+
+        return m_latency_sum / m_latency_count;
+      }
+
+      //! Retrieve the maximum delay between the deadline of a cycle
+      //! and the instant the task was woken up to run it.
+      //! @return maximum wake-up latency in seconds.
+      inline double
+      getMaximumLatency(void) const
+      {
+        return m_latency_max;
+      }
+
       //! The task to be executed on each cycle.
       virtual void
       task(void) = 0;
@@ -104,10 +135,52 @@ namespace DUNE
       double m_run_time;
       //! Task frequency (Hz).
       double m_frequency;
+      //! Task phase (fraction of period).
+      double m_phase;
+      //! Number of missed cycles.
+      unsigned m_overrun_count;
+      //! Number of missed cycles since the last report.
+      unsigned m_overrun_report;
+      //! Time of the last overrun report.
+      double m_overrun_time;
+      //! Deadline of the next cycle.
+      double m_deadline;
+      //! Number of wake-up latency samples.
+      unsigned m_latency_count;
+      //! Sum of wake-up latencies (s).
+      double m_latency_sum;
+      //! Maximum wake-up latency (s).
+      double m_latency_max;
+      //! Wake-up slot.
+      DeadlineScheduler::Slot m_slot;
+
+      //! Compute the deadline of the next cycle, accounting for
+      //! overruns.
+      //! @param[in] deadline deadline of the last cycle.
+      //! @return deadline of the next cycle.
+      double
+      getNextDeadline(double deadline);
+
+      //! Account the wake-up latency of a cycle.
+      //! @param[in] now current time.
+      void
+      updateLatency(double now);
 
       //! Task entry point.
       void
       onMain(void);
+
+      //! Periodic tasks can be executed by the thread pool.
+      bool
+      canStep(void) const
+      {
+        return true;
+      }
+
+      //! Execute one cycle.
+      //! @return task period.
+      double
+      onStep(void);
     };
   }
 }
@@ -52,6 +52,20 @@ namespace DUNE
       bool
       filter(const IMC::Message* msg);
 
+      //! Get the minimum interval between messages of a given type.
+      //! Tasks can pass it to the message bus in a subscription
+      //! filter instead of filtering messages themselves.
+      //! @param id message identification number.
+      //! @return minimum interval in seconds (0 if not limited).
+      double
+      getInterval(uint32_t id) const
+      {
+        RateMap::const_iterator itr = m_rates.find(id);
+        if (itr == m_rates.end())
+          return 0;
+        return itr->second;
+      }
+
     private:
       // Rate limiters.
       typedef std::map<uint32_t, double> RateMap;
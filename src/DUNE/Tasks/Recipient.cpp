@@ -27,10 +27,16 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <algorithm>
+#include <sstream>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/Exceptions.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
 
@@ -38,21 +44,158 @@ namespace DUNE
 {
   namespace Tasks
   {
+    //! Upper bound of the first latency histogram bin.
+    static const double c_first_bin = 10e-6;
+
+    void
+    Recipient::DeliveryCounters::reset(void)
+    {
+      count = 0;
+      lat_sum = 0;
+      lat_max = 0;
+
+      for (unsigned i = 0; i < c_bins; ++i)
+        bins[i] = 0;
+    }
+
+    void
+    Recipient::DeliveryCounters::add(double latency)
+    {
+      ++count;
+      lat_sum += latency;
+      if (latency > lat_max)
+        lat_max = latency;
+
+      unsigned bin = 0;
+      double bound = c_first_bin;
+      while (latency >= bound && bin < c_bins - 1)
+      {
+        bound *= 2.0;
+        ++bin;
+      }
+
+      ++bins[bin];
+    }
+
     Recipient::Recipient(AbstractTask* task, Context& ctx):
       m_task(task),
-      m_ctx(ctx)
-    { }
+      m_ctx(ctx),
+      m_pqueue(c_priority_capacity),
+      m_bulk_batch(c_batch_size),
+      m_high_water(0),
+      m_coalesced_count(0)
+    {
+      m_capacity = m_mqueue.capacity() / 2;
+      m_overflow_lock.setName(std::string(task->getName()) + " Overflow");
+      m_counters_lock.setName(std::string(task->getName()) + " Delivery Counters");
+
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+      {
+        m_policies[i] = OP_DROP_NEWEST;
+        m_priorities[i] = false;
+      }
+
+      m_priorities[IMC::Abort::getIdStatic()] = true;
+    }
 
     Recipient::~Recipient(void)
     {
       unbindAll();
 
-      while (!m_mqueue.empty())
+      IMC::SharedMessage* msg = NULL;
+      while (m_mqueue.pop(msg))
+        msg->release();
+
+      while (m_pqueue.pop(msg))
+        msg->release();
+
+      std::map<uint64_t, IMC::SharedMessage*>::iterator itr = m_coalesced.begin();
+      for (; itr != m_coalesced.end(); ++itr)
+        itr->second->release();
+    }
+
+    void
+    Recipient::setCapacity(unsigned capacity)
+    {
+      // Half of the queue is kept as headroom for the overflow
+      // policies that must accept the incoming message.
+      m_capacity = std::max(1u, std::min(capacity, m_mqueue.capacity() / 2));
+    }
+
+    void
+    Recipient::reserve(unsigned capacity)
+    {
+      if (capacity * 2 <= m_mqueue.capacity())
+        return;
+
+      std::vector<IMC::SharedMessage*> queued;
+      IMC::SharedMessage* msg = NULL;
+      while (m_mqueue.pop(msg))
+        queued.push_back(msg);
+
+      m_mqueue.resize(capacity * 2);
+
+      for (unsigned i = 0; i < queued.size(); ++i)
+        m_mqueue.push(queued[i]);
+    }
+
+    void
+    Recipient::setOverflowPolicy(uint32_t id, OverflowPolicy policy)
+    {
+      if (id > DUNE_IMC_CONST_MAX_ID)
+        throw IMC::InvalidMessageId(id);
+
+      m_policies[id] = policy;
+    }
+
+    void
+    Recipient::setPriority(uint32_t id, bool priority)
+    {
+      if (id > DUNE_IMC_CONST_MAX_ID)
+        throw IMC::InvalidMessageId(id);
+
+      m_priorities[id] = priority || (id == IMC::Abort::getIdStatic());
+      updateBulkBatch();
+    }
+
+    void
+    Recipient::clearPriorities(void)
+    {
+      for (unsigned i = 0; i <= DUNE_IMC_CONST_MAX_ID; ++i)
+        m_priorities[i] = false;
+
+      m_priorities[IMC::Abort::getIdStatic()] = true;
+      updateBulkBatch();
+    }
+
+    void
+    Recipient::updateBulkBatch(void)
+    {
+      unsigned size = c_batch_size;
+
+      std::map<uint32_t, AbstractConsumer*>::iterator itr = m_cbacks.begin();
+      for (; itr != m_cbacks.end(); ++itr)
       {
-        IMC::Message* msg = m_mqueue.pop();
-        if (msg)
-          delete msg;
+        if (itr->first <= DUNE_IMC_CONST_MAX_ID && m_priorities[itr->first])
+          size = c_priority_batch_size;
       }
+
+      m_bulk_batch = size;
+    }
+
+    bool
+    Recipient::parseOverflowPolicy(const std::string& name, OverflowPolicy& policy)
+    {
+      if (name == "DropNewest")
+        policy = OP_DROP_NEWEST;
+      else if (name == "DropOldest")
+        policy = OP_DROP_OLDEST;
+      else if (name == "Coalesce")
+        policy = OP_COALESCE;
+      else
+        return false;
+
+      return true;
     }
 
     void
@@ -72,7 +215,8 @@ namespace DUNE
     }
 
     void
-    Recipient::bind(uint32_t id, AbstractConsumer* consumer)
+    Recipient::bind(uint32_t id, AbstractConsumer* consumer,
+                    const IMC::SubscriptionFilter* filter)
     {
       std::map<uint32_t, AbstractConsumer*>::iterator itr = m_cbacks.find(id);
 
@@ -83,36 +227,292 @@ namespace DUNE
       }
 
       m_cbacks[id] = consumer;
-      m_ctx.mbus.registerRecipient(m_task, id);
+      updateBulkBatch();
+
+      {
+        Concurrency::ScopedMutex l(m_counters_lock);
+        m_counters[id];
+      }
+
+      m_ctx.mbus.registerRecipient(m_task, id, filter);
     }
 
     void
     Recipient::waitForMessages(double timeout)
     {
-      if (m_mqueue.waitForItems(timeout))
+      if (m_coalesced_count > 0 || m_pqueue.size() > 0 || m_mqueue.waitForItems(timeout)
+          || m_coalesced_count > 0)
         runCallBacks();
     }
 
     void
     Recipient::put(const IMC::Message* msg)
     {
-      m_mqueue.push(msg->clone());
+      enqueue(IMC::SharedMessage::create(msg));
+    }
+
+    void
+    Recipient::put(IMC::SharedMessage* msg)
+    {
+      enqueue(msg->acquire());
+    }
+
+    void
+    Recipient::enqueue(IMC::SharedMessage* msg)
+    {
+      if (m_priorities[msg->getId()])
+      {
+        if (!m_pqueue.push(msg))
+        {
+          drop(msg);
+          return;
+        }
+
+        // The consumer only waits on the bulk lane.
+        m_mqueue.wakeup();
+        return;
+      }
+
+      // A newer message must not overtake a coalesced one.
+      if (m_coalesced_count > 0
+          && m_policies[msg->getId()] == OP_COALESCE
+          && coalesce(msg, false))
+        return;
+
+      if (m_mqueue.size() >= m_capacity)
+      {
+        overflow(msg);
+        return;
+      }
+
+      if (!m_mqueue.push(msg))
+      {
+        drop(msg);
+        return;
+      }
+
+      unsigned size = m_mqueue.size();
+      if (size > m_high_water)
+        m_high_water = size;
+    }
+
+    void
+    Recipient::overflow(IMC::SharedMessage* msg)
+    {
+      switch (m_policies[msg->getId()])
+      {
+        case OP_DROP_OLDEST:
+          // The message goes to the headroom and the consumer
+          // discards the same number of messages from the front.
+          if (m_mqueue.push(msg))
+            m_discard.add(1);
+          else
+            drop(msg);
+          break;
+
+        case OP_COALESCE:
+          coalesce(msg, true);
+          m_mqueue.wakeup();
+          break;
+
+        default:
+          drop(msg);
+          break;
+      }
+    }
+
+    bool
+    Recipient::coalesce(IMC::SharedMessage* msg, bool insert)
+    {
+      const IMC::Message* m = msg->get();
+      uint64_t key = ((uint64_t)m->getId() << 24) | ((uint64_t)m->getSource() << 8) | m->getSourceEntity();
+
+      Concurrency::ScopedMutex l(m_overflow_lock);
+      std::map<uint64_t, IMC::SharedMessage*>::iterator itr = m_coalesced.find(key);
+
+      if (itr != m_coalesced.end())
+      {
+        drop(itr->second);
+        itr->second = msg;
+        return true;
+      }
+
+      if (!insert)
+        return false;
+
+      m_coalesced[key] = msg;
+      m_coalesced_count = m_coalesced.size();
+      return true;
     }
 
     void
     Recipient::runCallBacks(void)
     {
+      IMC::SharedMessage* batch[c_batch_size];
+      consumePriority(batch);
+
+      IMC::SharedMessage* msg = NULL;
+      for (unsigned int n = m_discard.add(0); n > 0;)
+      {
+        if (!m_mqueue.pop(msg))
+          break;
+
+        m_discard.sub(1);
+        drop(msg);
+        --n;
+      }
+
+      // Only consume messages queued before this call, so that
+      // fast producers cannot starve the task.
       unsigned int size = m_mqueue.size();
 
-      for (unsigned int i = 0; i < size; ++i)
+      while (size > 0)
+      {
+        unsigned int count = m_mqueue.pop(batch, std::min(size, m_bulk_batch));
+        if (count == 0)
+          break;
+
+        size -= count;
+        consume(batch, count, false);
+
+        consumePriority(batch);
+      }
+
+      if (m_coalesced_count == 0)
+        return;
+
+      std::map<uint64_t, IMC::SharedMessage*> coalesced;
+      {
+        Concurrency::ScopedMutex l(m_overflow_lock);
+        coalesced.swap(m_coalesced);
+        m_coalesced_count = 0;
+      }
+
+      std::map<uint64_t, IMC::SharedMessage*>::iterator itr = coalesced.begin();
+      while (itr != coalesced.end())
+      {
+        unsigned int count = 0;
+        for (; itr != coalesced.end() && count < c_batch_size; ++itr)
+          batch[count++] = itr->second;
+
+        try
+        {
+          consume(batch, count, false);
+        }
+        catch (...)
+        {
+          for (; itr != coalesced.end(); ++itr)
+            itr->second->release();
+          throw;
+        }
+      }
+    }
+
+    void
+    Recipient::consumePriority(IMC::SharedMessage** batch)
+    {
+      // Only consume messages queued before this call.
+      unsigned int size = m_pqueue.size();
+
+      while (size > 0)
       {
-        const IMC::Message* msg = m_mqueue.pop();
-        if (msg)
+        unsigned int count = m_pqueue.pop(batch, std::min(size, (unsigned int)c_batch_size));
+        if (count == 0)
+          break;
+
+        consume(batch, count, true);
+        size -= count;
+      }
+    }
+
+    void
+    Recipient::consume(IMC::SharedMessage** batch, unsigned count, bool priority)
+    {
+      double latencies[c_batch_size];
+
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        try
         {
-          uint32_t id = msg->getId();
-          m_cbacks[id]->consume(msg);
-          delete msg;
+          uint32_t id = batch[i]->getId();
+          const IMC::Message* msg = batch[i]->get();
+          latencies[i] = Time::Clock::get() - batch[i]->getCreationTime();
+
+          if (msg->getTrace().id == 0)
+          {
+            m_cbacks[id]->consume(msg);
+          }
+          else
+          {
+            m_task->beginTrace(msg);
+            m_cbacks[id]->consume(msg);
+            m_task->endTrace(msg);
+          }
         }
+        catch (...)
+        {
+          for (unsigned int j = i; j < count; ++j)
+            batch[j]->release();
+          throw;
+        }
+      }
+
+      {
+        // Update counters once per batch.
+        Concurrency::ScopedMutex l(m_counters_lock);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+          std::map<uint32_t, DeliveryCounters>::iterator itr = m_counters.find(batch[i]->getId());
+          if (itr != m_counters.end())
+            itr->second.add(latencies[i]);
+
+          m_lanes[priority ? 0 : 1].add(latencies[i]);
+        }
+      }
+
+      for (unsigned int i = 0; i < count; ++i)
+        batch[i]->release();
+    }
+
+    void
+    Recipient::getStatistics(IMC::MailboxStatistics& stats)
+    {
+      stats.size = m_mqueue.size() + m_coalesced_count;
+      stats.capacity = m_capacity;
+      stats.high_water = m_high_water;
+      m_high_water = stats.size;
+      stats.dropped = m_dropped.add(0);
+      m_dropped.sub(stats.dropped);
+      stats.deliveries.clear();
+      stats.priority_size = m_pqueue.size();
+
+      Concurrency::ScopedMutex l(m_counters_lock);
+      stats.priority_lat_max = m_lanes[0].lat_max;
+      stats.bulk_lat_max = m_lanes[1].lat_max;
+      m_lanes[0].reset();
+      m_lanes[1].reset();
+
+      std::map<uint32_t, DeliveryCounters>::iterator itr = m_counters.begin();
+      for (; itr != m_counters.end(); ++itr)
+      {
+        DeliveryCounters& ctr = itr->second;
+        if (ctr.count == 0)
+          continue;
+
+        std::ostringstream os;
+        os << ctr.bins[0];
+        for (unsigned i = 1; i < DeliveryCounters::c_bins; ++i)
+          os << "," << ctr.bins[i];
+
+        IMC::DeliveryStatistics ds;
+        ds.message_id = itr->first;
+        ds.count = ctr.count;
+        ds.lat_mean = ctr.lat_sum / ctr.count;
+        ds.lat_max = ctr.lat_max;
+        ds.histogram = os.str();
+        stats.deliveries.push_back(ds);
+
+        ctr.reset();
       }
     }
   }
@@ -30,14 +30,26 @@
 
 // ISO C++ 98 headers.
 #include <map>
+#include <string>
 
 // DUNE headers.
-#include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/Concurrency/MPSCQueue.hpp>
+#include <DUNE/Concurrency/AtomicCounter.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/IMC/SharedMessage.hpp>
+#include <DUNE/IMC/SubscriptionFilter.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
 
 namespace DUNE
 {
+  namespace IMC
+  {
+    // Forward declarations.
+    class MailboxStatistics;
+  }
+
   namespace Tasks
   {
     // Forward declarations.
@@ -49,6 +61,17 @@ namespace DUNE
     class Recipient
     {
     public:
+      //! Action taken when a message arrives and the mailbox is full.
+      enum OverflowPolicy
+      {
+        //! Discard the incoming message.
+        OP_DROP_NEWEST,
+        //! Discard the oldest queued message.
+        OP_DROP_OLDEST,
+        //! Keep only the latest message of each type and source.
+        OP_COALESCE
+      };
+
       //! Constructor.
       Recipient(AbstractTask* task, Context& ctx);
 
@@ -58,11 +81,24 @@ namespace DUNE
       void
       unbindAll(void);
 
+      //! Queue a private copy of a message.
+      //! @param msg message.
       void
-      put(const IMC::Message*);
+      put(const IMC::Message* msg);
 
+      //! Queue a shared message. A new reference to the handle is
+      //! acquired and released after consumption.
+      //! @param msg shared message handle.
       void
-      bind(uint32_t id, AbstractConsumer* c);
+      put(IMC::SharedMessage* msg);
+
+      //! Register a consumer for a given message identifier.
+      //! @param id message identifier.
+      //! @param c consumer object.
+      //! @param filter subscription filter (NULL to receive all
+      //! messages).
+      void
+      bind(uint32_t id, AbstractConsumer* c, const IMC::SubscriptionFilter* filter = NULL);
 
       void
       waitForMessages(double timeout);
@@ -70,6 +106,62 @@ namespace DUNE
       void
       runCallBacks(void);
 
+      //! Set the maximum number of queued messages. Above this limit
+      //! the overflow policy of each message type is applied.
+      //! @param capacity maximum number of queued messages.
+      void
+      setCapacity(unsigned capacity);
+
+      //! Allocate storage for a given mailbox capacity, preserving
+      //! queued messages. This function must not be called after
+      //! the task has started.
+      //! @param capacity maximum number of queued messages.
+      void
+      reserve(unsigned capacity);
+
+      //! Set the overflow policy of a message type.
+      //! @param id message identification number.
+      //! @param policy overflow policy.
+      void
+      setOverflowPolicy(uint32_t id, OverflowPolicy policy);
+
+      //! Deliver messages of a given type from the priority lane,
+      //! ahead of the other queued messages. Priority messages are
+      //! not subject to the mailbox capacity and overflow policies.
+      //! Abort messages always use the priority lane.
+      //! @param id message identification number.
+      //! @param priority true to use the priority lane, false to use
+      //! the bulk lane.
+      void
+      setPriority(uint32_t id, bool priority);
+
+      //! Deliver all messages from the bulk lane, except Abort
+      //! messages.
+      void
+      clearPriorities(void);
+
+      //! Convert an overflow policy name to its value.
+      //! @param name policy name (DropNewest, DropOldest or Coalesce).
+      //! @param[out] policy overflow policy.
+      //! @return true if the name is valid, false otherwise.
+      static bool
+      parseOverflowPolicy(const std::string& name, OverflowPolicy& policy);
+
+      //! Retrieve the number of messages discarded because the
+      //! message queue was full.
+      //! @return number of discarded messages.
+      unsigned
+      getDropCount(void)
+      {
+        return m_dropped.add(0);
+      }
+
+      //! Retrieve the statistics accumulated since the last call and
+      //! reset them.
+      //! @param[out] stats statistics message.
+      void
+      getStatistics(IMC::MailboxStatistics& stats);
+
     private:
       //! Task.
       AbstractTask* m_task;
@@ -77,8 +169,118 @@ namespace DUNE
       Context& m_ctx;
       //! Callbacks.
       std::map<uint32_t, AbstractConsumer*> m_cbacks;
+      //! Delivery counters of one message type.
+      struct DeliveryCounters
+      {
+        //! Number of latency histogram bins.
+        static const unsigned c_bins = 16;
+        //! Number of consumed messages.
+        unsigned count;
+        //! Sum of latencies.
+        double lat_sum;
+        //! Maximum latency.
+        double lat_max;
+        //! Latency histogram.
+        unsigned bins[c_bins];
+
+        DeliveryCounters(void)
+        {
+          reset();
+        }
+
+        void
+        reset(void);
+
+        void
+        add(double latency);
+      };
+
+      //! Maximum number of messages consumed in one drain step.
+      static const unsigned c_batch_size = 32;
+      //! Maximum number of bulk messages consumed between checks of
+      //! the priority lane when priority messages are bound.
+      static const unsigned c_priority_batch_size = 4;
+      //! Capacity of the priority lane.
+      static const unsigned c_priority_capacity = 256;
       //! Message queue.
-      Concurrency::TSQueue<IMC::Message*> m_mqueue;
+      Concurrency::MPSCQueue<IMC::SharedMessage*> m_mqueue;
+      //! Priority message queue.
+      Concurrency::MPSCQueue<IMC::SharedMessage*> m_pqueue;
+      //! True by message identifier if the priority lane is used.
+      bool m_priorities[DUNE_IMC_CONST_MAX_ID + 1];
+      //! Number of bulk messages consumed between checks of the
+      //! priority lane.
+      unsigned m_bulk_batch;
+      //! Number of messages dropped because the queue was full.
+      Concurrency::AtomicCounter m_dropped;
+      //! Maximum number of queued messages (approximate).
+      volatile unsigned m_high_water;
+      //! Maximum number of queued messages before applying the
+      //! overflow policies.
+      volatile unsigned m_capacity;
+      //! Overflow policy by message identifier.
+      uint8_t m_policies[DUNE_IMC_CONST_MAX_ID + 1];
+      //! Number of oldest messages to discard.
+      Concurrency::AtomicCounter m_discard;
+      //! Coalesced messages by type and source.
+      std::map<uint64_t, IMC::SharedMessage*> m_coalesced;
+      //! Number of coalesced messages.
+      volatile unsigned m_coalesced_count;
+      //! Lock protecting coalesced messages.
+      Concurrency::Mutex m_overflow_lock;
+      //! Delivery counters by message identifier.
+      std::map<uint32_t, DeliveryCounters> m_counters;
+      //! Delivery counters of the priority and bulk lanes.
+      DeliveryCounters m_lanes[2];
+      //! Lock protecting delivery counters.
+      Concurrency::Mutex m_counters_lock;
+
+      //! Insert a message handle in the queue, releasing it if the
+      //! queue is full.
+      //! @param msg message handle (reference is transferred).
+      void
+      enqueue(IMC::SharedMessage* msg);
+
+      //! Apply the overflow policy to a message that does not fit in
+      //! the mailbox.
+      //! @param msg message handle (reference is transferred).
+      void
+      overflow(IMC::SharedMessage* msg);
+
+      //! Replace a coalesced message of the same type and source.
+      //! @param msg message handle (reference is transferred on
+      //! success).
+      //! @param insert true to insert the message if no match exists.
+      //! @return true if the message was stored, false otherwise.
+      bool
+      coalesce(IMC::SharedMessage* msg, bool insert);
+
+      //! Release a message handle counting it as dropped.
+      //! @param msg message handle.
+      void
+      drop(IMC::SharedMessage* msg)
+      {
+        m_dropped.add(1);
+        msg->release();
+      }
+
+      //! Update the number of bulk messages consumed between checks
+      //! of the priority lane.
+      void
+      updateBulkBatch(void);
+
+      //! Deliver all queued priority messages.
+      //! @param batch storage for message handles.
+      void
+      consumePriority(IMC::SharedMessage** batch);
+
+      //! Deliver a batch of messages to consumers and release them.
+      //! @param batch message handles.
+      //! @param count number of message handles.
+      //! @param priority true if the messages came from the priority
+      //! lane.
+      void
+      consume(IMC::SharedMessage** batch, unsigned count, bool priority);
     };
   }
 }
@@ -0,0 +1,92 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_SHARED_STATE_HPP_INCLUDED_
+#define DUNE_TASKS_SHARED_STATE_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Snapshot.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/Macros.hpp>
+#include <DUNE/Navigation/InertialStream.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM SharedState;
+
+    //! Latest values of the vehicle state messages dispatched by the
+    //! tasks of this system. Tasks that only need the most recent
+    //! value of these messages read them through a per-task
+    //! Concurrency::Snapshot reader instead of consuming every
+    //! message:
+    //!
+    //! @code
+    //! Concurrency::Snapshot<IMC::EstimatedState>::Reader m_estate(ctx.state.estate);
+    //! ...
+    //! if (m_estate.refresh())
+    //!   depth = m_estate->depth;
+    //! @endcode
+    //!
+    //! Readers must refresh regularly, since the copies they hold are
+    //! only reclaimed after they move past them.
+    class SharedState
+    {
+    public:
+      //! Latest estimated state.
+      Concurrency::Snapshot<IMC::EstimatedState> estate;
+      //! Latest GPS fix.
+      Concurrency::Snapshot<IMC::GpsFix> gps_fix;
+      //! Full-rate samples of the inertial sensors, by entity.
+      Navigation::InertialStreams imu;
+
+      //! Publish a message dispatched by a task of this system if it
+      //! is one of the shared messages.
+      //! @param[in] msg message.
+      void
+      update(const IMC::Message* msg)
+      {
+        switch (msg->getId())
+        {
+          case DUNE_IMC_ESTIMATEDSTATE:
+            estate.publish(*static_cast<const IMC::EstimatedState*>(msg));
+            break;
+          case DUNE_IMC_GPSFIX:
+            gps_fix.publish(*static_cast<const IMC::GpsFix*>(msg));
+            break;
+          default:
+            break;
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -27,6 +27,7 @@
 
 // DUNE headers.
 #include <DUNE/Tasks/SimpleTransport.hpp>
+#include <DUNE/IMC/TraceRing.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/Utils/String.hpp>
 
@@ -36,7 +37,8 @@ namespace DUNE
   {
     SimpleTransport::SimpleTransport(const std::string& name, Tasks::Context& ctx):
       Tasks::Task(name, ctx),
-      m_buf(2048)
+      m_buf(2048),
+      m_trace_channel(IMC::dune_trace.getChannel(name))
     {
       param("Transports", m_gargs.transports)
       .defaultValue("")
@@ -48,11 +50,11 @@ namespace DUNE
 
       param("Trace - Incoming Messages", m_gargs.trace_in)
       .defaultValue("false")
-      .description("Enable verbose output regarding incoming messages");
+      .description("Record incoming messages in the message trace");
 
       param("Trace - Outgoing Messages", m_gargs.trace_out)
       .defaultValue("false")
-      .description("Enable verbose output regarding outgoing messages");
+      .description("Record outgoing messages in the message trace");
     }
 
     SimpleTransport::~SimpleTransport(void)
@@ -61,9 +63,6 @@ namespace DUNE
     void
     SimpleTransport::consume(const IMC::Message* msg)
     {
-      if (m_rl.filter(msg))
-        return;
-
       unsigned int n = msg->getSerializationSize();
 
       m_buf.grow(n);
@@ -73,7 +72,7 @@ namespace DUNE
       IMC::Packet::serialize(msg, p, n);
 
       if (m_gargs.trace_out)
-        inf(DTR("outgoing: %s"), msg->getName());
+        IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_OUT, n);
 
       onDataTransmission(p, n);
     }
@@ -82,7 +81,7 @@ namespace DUNE
     SimpleTransport::onMain(void)
     {
       m_rl.setup(m_gargs.rlim);
-      bind(this, m_gargs.transports);
+      bind(this, m_gargs.transports, m_rl);
 
       while (!stopping())
       {
@@ -95,18 +94,25 @@ namespace DUNE
     void
     SimpleTransport::handleData(IMC::Parser& parser, const uint8_t* p, unsigned int n)
     {
-      for (const uint8_t* e = p + n; p != e; ++p)
+      unsigned consumed = 0;
+
+      while (n > 0)
       {
-        IMC::Message* m = parser.parse(*p);
+        IMC::Message* m = parser.parse(p, n, consumed);
+        p += consumed;
+        n -= consumed;
 
         if (m)
         {
-          dispatch(m, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+          if (onMessageReception(m))
+          {
+            dispatch(m, DF_KEEP_TIME | DF_KEEP_SRC_EID);
 
-          if (m_gargs.trace_in)
-            inf(DTR("incoming: %s"), m->getName());
+            if (m_gargs.trace_in)
+              IMC::dune_trace.record(m, m_trace_channel, IMC::TraceRing::DIR_IN);
+          }
 
-          delete m;
+          parser.release(m);
         }
       }
     }
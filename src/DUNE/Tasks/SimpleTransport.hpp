@@ -68,6 +68,15 @@ namespace DUNE
       void
       handleData(IMC::Parser& parser, const uint8_t* p, unsigned int n);
 
+      //! Called for each received message before it is dispatched.
+      //! @param[in] msg received message.
+      //! @return true to dispatch the message, false to discard it.
+      virtual bool
+      onMessageReception(const IMC::Message*)
+      {
+        return true;
+      }
+
     private:
       struct GArguments
       {
@@ -79,6 +88,8 @@ namespace DUNE
       GArguments m_gargs;
       Utils::ByteBuffer m_buf;
       RateLimiters m_rl;
+      //! Message trace channel.
+      uint8_t m_trace_channel;
     };
   }
 }
@@ -26,20 +26,25 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <sstream>
 #include <cstddef>
 
 // DUNE headers.
 #include <DUNE/IMC/Constants.hpp>
 #include <DUNE/IMC/Bus.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/PeriodicDelay.hpp>
 #include <DUNE/Time/Counter.hpp>
 #include <DUNE/Status/Messages.hpp>
+#include <DUNE/Streams/Terminal.hpp>
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Exceptions.hpp>
 #include <DUNE/Tasks/Task.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Utils/XML.hpp>
+#include <DUNE/System/HeapArena.hpp>
 
 #if defined(DUNE_OS_LINUX)
 #  include <sys/prctl.h>
@@ -51,6 +56,13 @@ namespace DUNE
   {
     //! Maximum size of a log book entry message.
     const static size_t c_log_message_max_size = 1024;
+    //! Cause of trace hops without one.
+    const static uint16_t c_no_cause = 0xFFFF;
+    //! Period to check if startup dependencies are ready.
+    const static double c_dependency_period = 0.1;
+    //! Period during which repetitions of the same log message are
+    //! suppressed (s).
+    const static double c_log_repeat_period = 1.0;
 
     Task::Task(const std::string& n, Context& ctx):
       m_ctx(ctx),
@@ -59,14 +71,35 @@ namespace DUNE
       m_eid(DUNE_IMC_CONST_UNK_EID),
       m_debug_level(DEBUG_LEVEL_NONE),
       m_entity_state_code(-1),
+      m_entity_state_desc_code(-1),
+      m_entity_state_sent(IMC::EntityState::ESTA_BOOT),
+      m_entity_state_time(-1),
+      m_entity_state_pending(false),
       m_honours_active(false),
-      m_next_act_state(NAS_SAME)
+      m_next_act_state(NAS_SAME),
+      m_stepping(false),
+      m_step_restart(false),
+      m_trace_cause(0),
+      m_heap_arena(NULL),
+      m_heap_arena_tried(false),
+      m_ready(false),
+      m_startup_time(-1.0),
+      m_log_last_type(IMC::LogBookEntry::LBET_INFO),
+      m_log_last_time(-1.0),
+      m_log_repeats(0)
     {
+      m_trace.id = 0;
+      m_trace.origin = 0;
+      m_trace.time = 0;
+
       m_args.priority = 10;
       m_args.act_time = 0;
       m_args.deact_time = 0;
       m_args.active = false;
+      m_args.lock_memory = false;
       m_act_state.state = IMC::EntityActivationState::EAS_INACTIVE;
+      m_act_state_sent.state = IMC::EntityActivationState::EAS_INACTIVE;
+      m_args.entity_state_holdoff = 0;
 
       param(DTR_RT("Entity Label"), m_elabel)
       .defaultValue("")
@@ -86,6 +119,78 @@ namespace DUNE
       .defaultValue("None")
       .values("None, Debug, Trace, Spew");
 
+      param(DTR_RT("Mailbox Capacity"), m_args.mailbox_capacity)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .scope(Parameter::SCOPE_GLOBAL)
+      .defaultValue("512")
+      .minimumValue("1")
+      .description(DTR("Maximum number of queued messages"));
+
+      param(DTR_RT("Mailbox Overflow Policies"), m_args.mailbox_policies)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .scope(Parameter::SCOPE_GLOBAL)
+      .defaultValue("")
+      .description(DTR("List of 'Abbrev:Policy' pairs applied when the mailbox is full,"
+                       " where policy is one of DropNewest, DropOldest or Coalesce"));
+
+      param(DTR_RT("Mailbox Priority Messages"), m_args.mailbox_priorities)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .scope(Parameter::SCOPE_GLOBAL)
+      .defaultValue("Abort, DesiredZ, DesiredHeading, DesiredHeadingRate, DesiredSpeed,"
+                    " DesiredPitch, DesiredRoll, DesiredVelocity, DesiredPath,"
+                    " SetServoPosition, SetThrusterActuation, SetControlSurfaceDeflection")
+      .description(DTR("List of messages delivered ahead of other queued messages."
+                       " Abort messages are always delivered first"));
+
+      param(DTR_RT("Execution Mode"), m_args.exec_mode)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .scope(Parameter::SCOPE_GLOBAL)
+      .defaultValue("Thread")
+      .values("Thread, Pool")
+      .description(DTR("Run task in its own thread or in the thread pool"));
+
+      param(DTR_RT("Execution Policy"), m_args.exec_policy)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("Default")
+      .values("Default, RoundRobin, FIFO, Other")
+      .description(DTR("Scheduling policy of the task's thread. 'Default' tries"
+                       " round-robin and keeps the inherited policy if not allowed"));
+
+      param(DTR_RT("Processor Affinity"), m_args.affinity)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("")
+      .description(DTR("List of processors where the task's thread is allowed"
+                       " to run, empty to run on any processor"));
+
+      param(DTR_RT("Lock Memory"), m_args.lock_memory)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("false")
+      .description(DTR("Lock the memory of the process in RAM to avoid"
+                       " page faults during execution"));
+
+      param(DTR_RT("Heap Quota"), m_args.heap_quota)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .units(Units::Byte)
+      .defaultValue("0")
+      .description(DTR("Size of the private heap arena of the task,"
+                       " 0 to allocate from the shared heap"));
+
+      param(DTR_RT("Start After"), m_args.start_after)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .defaultValue("")
+      .description(DTR("Configuration sections of the tasks that must initialize"
+                       " their resources before this task acquires its own"));
+
+      param(DTR_RT("Entity State Holdoff"), m_args.entity_state_holdoff)
+      .visibility(Parameter::VISIBILITY_DEVELOPER)
+      .scope(Parameter::SCOPE_GLOBAL)
+      .units(Units::Second)
+      .defaultValue("0.5")
+      .minimumValue("0.0")
+      .description(DTR("Minimum time between a report of an entity state and"
+                       " the report of a recovery from it. Recoveries within this"
+                       " time are reported together, once it expires"));
+
       m_recipient = new Recipient(this, ctx);
 
       // Initialize main entity state.
@@ -100,6 +205,12 @@ namespace DUNE
       bind<IMC::PopEntityParameters>(this);
     }
 
+    Task::~Task(void)
+    {
+      delete m_recipient;
+      System::HeapArena::destroy(m_heap_arena);
+    }
+
     unsigned int
     Task::reserveEntity(const std::string& label)
     {
@@ -112,6 +223,12 @@ namespace DUNE
       return m_ctx.entities.resolve(label);
     }
 
+    void
+    Task::resolveEntities(const std::vector<std::string>& labels, std::vector<unsigned>& ids) const
+    {
+      m_ctx.entities.resolve(labels, ids);
+    }
+
     std::string
     Task::resolveEntity(unsigned int id) const
     {
@@ -138,38 +255,89 @@ namespace DUNE
     Task::setEntityState(IMC::EntityState::StateEnum state,
                          Status::Code code)
     {
-      bool new_state = (state != m_entity_state.state);
-
       m_entity_state.state = state;
-      if (code != m_entity_state_code)
-        m_entity_state.description = DTR(Status::getString(code));
       m_entity_state_code = code;
-
-      if (new_state && (m_eid != DUNE_IMC_CONST_UNK_EID))
-        dispatch(m_entity_state);
+      changeEntityState();
     }
 
     void
     Task::setEntityState(IMC::EntityState::StateEnum state,
                          const std::string& message)
     {
-      bool new_state = (state != m_entity_state.state);
-
       m_entity_state.state = state;
       m_entity_state.description = message;
       m_entity_state_code = -1;
+      m_entity_state_desc_code = -1;
+      changeEntityState();
+    }
 
-      if (new_state && (m_eid != DUNE_IMC_CONST_UNK_EID))
-        dispatch(m_entity_state);
+    void
+    Task::changeEntityState(void)
+    {
+      if (m_eid == DUNE_IMC_CONST_UNK_EID)
+        return;
+
+      m_entity_state_pending = true;
+      flushEntityState();
     }
 
     void
-    Task::reportEntityState(void)
+    Task::flushEntityState(void)
+    {
+      if (m_entity_state.state == m_entity_state_sent)
+      {
+        m_entity_state_pending = false;
+        return;
+      }
+
+      // Escalations are reported at once, recoveries only after the
+      // holdoff, so a flapping entity reports its worst state.
+      if (m_entity_state.state < m_entity_state_sent)
+      {
+        double elapsed = Time::Clock::get() - m_entity_state_time;
+        if (m_entity_state_time >= 0 && elapsed < m_args.entity_state_holdoff)
+          return;
+      }
+
+      dispatchEntityState();
+    }
+
+    void
+    Task::dispatchEntityState(void)
     {
+      updateEntityStateDescription();
       dispatch(m_entity_state);
+      m_entity_state_sent = m_entity_state.state;
+      m_entity_state_time = Time::Clock::get();
+      m_entity_state_pending = false;
+    }
+
+    void
+    Task::dispatchActivationState(void)
+    {
+      dispatch(m_act_state);
+      m_act_state_sent.state = m_act_state.state;
+      m_act_state_sent.error = m_act_state.error;
+    }
+
+    void
+    Task::reportEntityState(void)
+    {
+      dispatchEntityState();
       onReportEntityState();
     }
 
+    void
+    Task::updateEntityStateDescription(void)
+    {
+      if (m_entity_state_code < 0 || m_entity_state_code == m_entity_state_desc_code)
+        return;
+
+      Status::Code code = static_cast<Status::Code>(m_entity_state_code);
+      m_entity_state.description = DTR(Status::getString(code));
+      m_entity_state_desc_code = m_entity_state_code;
+    }
+
     void
     Task::acquireResources(void)
     {
@@ -190,6 +358,7 @@ namespace DUNE
     void
     Task::releaseResources(void)
     {
+      setReady(false);
       onResourceRelease();
     }
 
@@ -255,6 +424,17 @@ namespace DUNE
       else
         m_debug_level = DEBUG_LEVEL_NONE;
 
+      if (m_debug_level > DUNE_MAX_DEBUG_LEVEL)
+        m_debug_level = static_cast<DebugLevel>(DUNE_MAX_DEBUG_LEVEL);
+
+      m_recipient->setCapacity(m_args.mailbox_capacity);
+
+      if (paramChanged(m_args.mailbox_policies))
+        updateMailboxPolicies();
+
+      if (paramChanged(m_args.mailbox_priorities))
+        updateMailboxPriorities();
+
       onUpdateParameters();
 
       if (m_honours_active)
@@ -276,9 +456,10 @@ namespace DUNE
             else
               requestDeactivation();
           }
-          else
+          else if (m_act_state.state != m_act_state_sent.state
+                   || m_act_state.error != m_act_state_sent.error)
           {
-            dispatch(m_act_state);
+            dispatchActivationState();
           }
         }
       }
@@ -309,13 +490,13 @@ namespace DUNE
           m_next_act_state = NAS_ACTIVE;
         }
 
-        dispatch(m_act_state);
+        dispatchActivationState();
         return;
       }
 
       m_next_act_state = NAS_SAME;
       m_act_state.state = IMC::EntityActivationState::EAS_ACT_IP;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       spew("calling on request activation");
       onRequestActivation();
@@ -336,10 +517,10 @@ namespace DUNE
       onActivation();
 
       m_act_state.state = IMC::EntityActivationState::EAS_ACT_DONE;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       m_act_state.state = IMC::EntityActivationState::EAS_ACTIVE;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       if (m_next_act_state == NAS_INACTIVE)
         requestDeactivation();
@@ -351,11 +532,11 @@ namespace DUNE
       spew("activation failed");
       m_act_state.state = IMC::EntityActivationState::EAS_ACT_FAIL;
       m_act_state.error = reason;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       m_act_state.state = IMC::EntityActivationState::EAS_INACTIVE;
       m_act_state.error.clear();
-      dispatch(m_act_state);
+      dispatchActivationState();
     }
 
     void
@@ -381,13 +562,13 @@ namespace DUNE
           m_next_act_state = NAS_INACTIVE;
         }
 
-        dispatch(m_act_state);
+        dispatchActivationState();
         return;
       }
 
       m_next_act_state = NAS_SAME;
       m_act_state.state = IMC::EntityActivationState::EAS_DEACT_IP;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       spew("calling on request deactivation");
       onRequestDeactivation();
@@ -408,9 +589,9 @@ namespace DUNE
       onDeactivation();
 
       m_act_state.state = IMC::EntityActivationState::EAS_DEACT_DONE;
-      dispatch(m_act_state);
+      dispatchActivationState();
       m_act_state.state = IMC::EntityActivationState::EAS_INACTIVE;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       if (m_next_act_state == NAS_ACTIVE)
         requestActivation();
@@ -423,11 +604,11 @@ namespace DUNE
 
       m_act_state.state = IMC::EntityActivationState::EAS_DEACT_FAIL;
       m_act_state.error = reason;
-      dispatch(m_act_state);
+      dispatchActivationState();
 
       m_act_state.state = IMC::EntityActivationState::EAS_ACTIVE;
       m_act_state.error.clear();
-      dispatch(m_act_state);
+      dispatchActivationState();
     }
 
     void
@@ -437,12 +618,8 @@ namespace DUNE
       prctl(PR_SET_NAME, getName(), 0, 0, 0);
 #endif
 
-      try
-      {
-        Thread::setPriority(Concurrency::Scheduler::POLICY_RR, m_args.priority);
-      }
-      catch (...)
-      { }
+      applySchedulingPolicy();
+      selectHeapArena();
 
       while (!stopping())
       {
@@ -450,8 +627,14 @@ namespace DUNE
         {
           resolveEntities();
           releaseResources();
+
+          m_startup_time = Time::Clock::get();
+          while (!stopping() && !dependenciesReady())
+            Time::Delay::wait(c_dependency_period);
+
           acquireResources();
           initializeResources();
+          setReady(true);
           onMain();
           releaseResources();
         }
@@ -483,8 +666,215 @@ namespace DUNE
       }
     }
 
+    double
+    Task::step(void)
+    {
+      // Pool workers run many tasks, so the arena is selected per step.
+      selectHeapArena();
+
+      try
+      {
+        if (m_step_restart)
+        {
+          m_step_restart = false;
+
+          try
+          {
+            updateParameters();
+          }
+          catch (std::runtime_error& pe)
+          {
+            err(DTR("failed to update parameters: %s"), pe.what());
+          }
+        }
+
+        if (!m_stepping)
+        {
+          if (m_startup_time < 0)
+            m_startup_time = Time::Clock::get();
+
+          if (!dependenciesReady())
+            return c_dependency_period;
+
+          resolveEntities();
+          releaseResources();
+          acquireResources();
+          initializeResources();
+          setReady(true);
+          m_stepping = true;
+        }
+
+        return onStep();
+      }
+      catch (RestartNeeded& e)
+      {
+        m_stepping = false;
+        m_step_restart = true;
+        setEntityState(IMC::EntityState::ESTA_FAILURE, DTR("restarting"));
+        err(DTR("restarting in %u seconds due to error: %s"),
+            e.getDelay(), e.getError());
+        return e.getDelay();
+      }
+      catch (std::exception& e)
+      {
+        m_stepping = false;
+        setEntityState(IMC::EntityState::ESTA_FAILURE, e.what());
+        err(DTR("task died with uncaught exception: %s: restarting"), e.what());
+        return 0;
+      }
+    }
+
+    void
+    Task::finishSteps(void)
+    {
+      m_stepping = false;
+      releaseResources();
+    }
+
+    bool
+    Task::isReady(void)
+    {
+      Concurrency::ScopedMutex l(m_ready_mx);
+      return m_ready;
+    }
+
+    bool
+    Task::dependenciesReady(void)
+    {
+      Concurrency::ScopedMutex l(m_deps_mx);
+
+      for (size_t i = 0; i < m_deps.size(); ++i)
+      {
+        if (!m_deps[i]->isReady())
+          return false;
+      }
+
+      return true;
+    }
+
+    void
+    Task::setReady(bool ready)
+    {
+      if (ready && stopping())
+        return;
+
+      {
+        Concurrency::ScopedMutex l(m_ready_mx);
+        m_ready = ready;
+      }
+
+      if (ready && m_startup_time >= 0)
+      {
+        inf(DTR("ready in %0.2f s"), Time::Clock::get() - m_startup_time);
+        m_startup_time = -1.0;
+      }
+    }
+
+    void
+    Task::applySchedulingPolicy(void)
+    {
+      if (!m_args.affinity.empty())
+      {
+        try
+        {
+          Thread::setAffinity(m_args.affinity);
+        }
+        catch (std::exception& e)
+        {
+          err(DTR("failed to set processor affinity: %s"), e.what());
+        }
+      }
+
+      if (m_args.exec_policy == "Default")
+      {
+        try
+        {
+          Thread::setPriority(Concurrency::Scheduler::POLICY_RR, m_args.priority);
+        }
+        catch (...)
+        { }
+
+        return;
+      }
+
+      Concurrency::Scheduler::Policy policy = Concurrency::Scheduler::POLICY_OTHER;
+      unsigned priority = 0;
+
+      if (m_args.exec_policy == "RoundRobin")
+      {
+        policy = Concurrency::Scheduler::POLICY_RR;
+        priority = m_args.priority;
+      }
+      else if (m_args.exec_policy == "FIFO")
+      {
+        policy = Concurrency::Scheduler::POLICY_FIFO;
+        priority = m_args.priority;
+      }
+
+      try
+      {
+        Thread::setPriority(policy, priority);
+      }
+      catch (std::exception& e)
+      {
+        err(DTR("failed to set scheduling policy %s with priority %u: %s"),
+            m_args.exec_policy.c_str(), priority, e.what());
+      }
+    }
+
+    void
+    Task::selectHeapArena(void)
+    {
+      if (!m_heap_arena_tried && m_args.heap_quota > 0)
+      {
+        m_heap_arena_tried = true;
+        m_heap_arena = System::HeapArena::create(m_args.heap_quota);
+        if (m_heap_arena == NULL)
+          war(DTR("unable to create heap arena, using shared heap"));
+      }
+
+      System::HeapArena::select(m_heap_arena);
+    }
+
+    bool
+    Task::getHeapUsage(IMC::HeapUsage& usage)
+    {
+      if (m_heap_arena == NULL)
+        return false;
+
+      usage.used = System::HeapArena::getUsed(m_heap_arena);
+      usage.quota = m_args.heap_quota;
+      usage.setSourceEntity(getEntityId());
+      return true;
+    }
+
     void
     Task::dispatch(IMC::Message* msg, unsigned int flags)
+    {
+      prepareDispatch(msg, flags);
+
+      if ((flags & DF_LOOP_BACK) == 0)
+        m_ctx.mbus.dispatch(msg, this);
+      else
+        m_ctx.mbus.dispatch(msg);
+    }
+
+    void
+    Task::dispatch(IMC::SharedMessage* msg, unsigned int flags)
+    {
+      IMC::Message* m = const_cast<IMC::Message*>(msg->get());
+      m->clearSerializationCache();
+      prepareDispatch(m, flags);
+      msg->resetCreationTime();
+
+      if ((flags & DF_LOOP_BACK) == 0)
+        m_ctx.mbus.dispatch(msg, this);
+      else
+        m_ctx.mbus.dispatch(msg);
+    }
+
+    void
+    Task::prepareDispatch(IMC::Message* msg, unsigned int flags)
     {
       if (!IMC::AddressResolver::isValid(msg->getSource()))
         msg->setSource(getSystemId());
@@ -498,10 +888,72 @@ namespace DUNE
           msg->setSourceEntity(getEntityId());
       }
 
-      if ((flags & DF_LOOP_BACK) == 0)
-        m_ctx.mbus.dispatch(msg, this);
-      else
-        m_ctx.mbus.dispatch(msg);
+      if (m_ctx.tracer.isEnabled())
+        traceDispatch(msg);
+
+      if (msg->getSource() == getSystemId())
+        m_ctx.state.update(msg);
+    }
+
+    void
+    Task::beginTrace(const IMC::Message* msg)
+    {
+      if (msg->getTrace().id != m_trace.id)
+        m_trace_hops.clear();
+
+      m_trace = msg->getTrace();
+      m_trace_cause = msg->getId();
+    }
+
+    void
+    Task::endTrace(const IMC::Message* msg)
+    {
+      dispatchHop(msg->getTrace(), msg->getId(), c_no_cause, IMC::TraceHop::THE_CONSUMED);
+    }
+
+    void
+    Task::traceDispatch(IMC::Message* msg)
+    {
+      uint16_t id = msg->getId();
+      if (id == IMC::TraceHop::getIdStatic())
+      {
+        msg->clearTrace();
+        return;
+      }
+
+      double now = Time::Clock::get();
+
+      if (m_trace.id != 0 && now - m_trace.time <= m_ctx.tracer.getPeriod())
+      {
+        if (std::find(m_trace_hops.begin(), m_trace_hops.end(), id) == m_trace_hops.end())
+        {
+          m_trace_hops.push_back(id);
+          msg->setTrace(m_trace);
+          dispatchHop(m_trace, id, m_trace_cause, IMC::TraceHop::THE_DISPATCHED);
+          return;
+        }
+      }
+      else if (m_ctx.tracer.start(msg, now))
+      {
+        dispatchHop(msg->getTrace(), id, c_no_cause, IMC::TraceHop::THE_DISPATCHED);
+        return;
+      }
+
+      msg->clearTrace();
+    }
+
+    void
+    Task::dispatchHop(const IMC::Message::Trace& trace, uint16_t id, uint16_t cause,
+                      IMC::TraceHop::EventEnum event)
+    {
+      IMC::TraceHop hop;
+      hop.trace_id = trace.id;
+      hop.origin = trace.origin;
+      hop.message_id = id;
+      hop.cause = cause;
+      hop.event = event;
+      hop.latency = Time::Clock::get() - trace.time;
+      dispatch(hop);
     }
 
     void
@@ -523,7 +975,7 @@ namespace DUNE
       if (msg->getDestinationEntity() != getEntityId())
         return;
 
-      dispatch(m_act_state);
+      dispatchActivationState();
     }
 
     void
@@ -658,7 +1110,7 @@ namespace DUNE
     void
     Task::debug(const char* format, ...)
     {
-      if (m_debug_level < DEBUG_LEVEL_DEBUG)
+      if (DUNE_MAX_DEBUG_LEVEL < DEBUG_LEVEL_DEBUG || m_debug_level < DEBUG_LEVEL_DEBUG)
         return;
 
       std::va_list ap;
@@ -670,7 +1122,7 @@ namespace DUNE
     void
     Task::trace(const char* format, ...)
     {
-      if (m_debug_level < DEBUG_LEVEL_TRACE)
+      if (DUNE_MAX_DEBUG_LEVEL < DEBUG_LEVEL_TRACE || m_debug_level < DEBUG_LEVEL_TRACE)
         return;
 
       std::va_list ap;
@@ -682,7 +1134,7 @@ namespace DUNE
     void
     Task::spew(const char* format, ...)
     {
-      if (m_debug_level < DEBUG_LEVEL_SPEW)
+      if (DUNE_MAX_DEBUG_LEVEL < DEBUG_LEVEL_SPEW || m_debug_level < DEBUG_LEVEL_SPEW)
         return;
 
       std::va_list ap;
@@ -706,10 +1158,42 @@ namespace DUNE
       std::vsprintf(bfr, format, arg_list);
 #endif
 
+      // Suppress repetitions of the same message, reporting how many
+      // there were once the message changes or the period elapses.
+      unsigned repeats = 0;
+      IMC::LogBookEntry::TypeEnum repeats_type = type;
+      {
+        Concurrency::ScopedMutex l(m_log_mx);
+        double now = Time::Clock::get();
+
+        if (type == m_log_last_type && m_log_last == bfr
+            && now - m_log_last_time < c_log_repeat_period)
+        {
+          ++m_log_repeats;
+          return;
+        }
+
+        repeats = m_log_repeats;
+        repeats_type = m_log_last_type;
+        m_log_repeats = 0;
+        m_log_last = bfr;
+        m_log_last_type = type;
+        m_log_last_time = now;
+      }
+
+      if (repeats > 0)
+        output(repeats_type, Utils::String::str(DTR("last message repeated %u times"), repeats).c_str());
+
+      output(type, bfr);
+    }
+
+    void
+    Task::output(IMC::LogBookEntry::TypeEnum type, const char* text)
+    {
       IMC::LogBookEntry log_entry;
       log_entry.setSourceEntity(getEntityId());
       log_entry.type = type;
-      log_entry.text = bfr;
+      log_entry.text = text;
       log_entry.context = getName();
       log_entry.htime = Time::Clock::getSinceEpoch();
 
@@ -717,24 +1201,17 @@ namespace DUNE
 
       switch (type)
       {
-        case IMC::LogBookEntry::LBET_INFO:
-          DUNE_MSG(getName(), bfr);
-          break;
-
         case IMC::LogBookEntry::LBET_WARNING:
-          DUNE_WRN(getName(), bfr);
+          Streams::dune_term.write(Streams::Terminal::LEVEL_WRN, getName(), text);
           break;
 
         case IMC::LogBookEntry::LBET_ERROR:
-          DUNE_ERR(getName(), bfr);
-          break;
-
         case IMC::LogBookEntry::LBET_CRITICAL:
-          DUNE_ERR(getName(), bfr);
+          Streams::dune_term.write(Streams::Terminal::LEVEL_ERR, getName(), text);
           break;
 
-        case IMC::LogBookEntry::LBET_DEBUG:
-          DUNE_MSG(getName(), bfr);
+        default:
+          Streams::dune_term.write(Streams::Terminal::LEVEL_MSG, getName(), text);
           break;
       }
     }
@@ -761,7 +1238,52 @@ namespace DUNE
           err(DTR("invalid parameter '%s'"), pitr->first.c_str());
       }
 
+      m_recipient->reserve(m_args.mailbox_capacity);
       updateParameters(false);
     }
+
+    void
+    Task::updateMailboxPolicies(void)
+    {
+      for (unsigned i = 0; i < m_args.mailbox_policies.size(); ++i)
+      {
+        const std::string& entry = m_args.mailbox_policies[i];
+        std::vector<std::string> parts;
+        Utils::String::split(entry, ":", parts);
+
+        Recipient::OverflowPolicy policy;
+        if (parts.size() != 2 || !Recipient::parseOverflowPolicy(parts[1], policy))
+          throw InvalidValue(DTR("Mailbox Overflow Policies"), entry, DTR("invalid policy"));
+
+        try
+        {
+          m_recipient->setOverflowPolicy(IMC::Factory::getIdFromAbbrev(parts[0]), policy);
+        }
+        catch (std::runtime_error&)
+        {
+          throw InvalidValue(DTR("Mailbox Overflow Policies"), entry, DTR("invalid message"));
+        }
+      }
+    }
+
+    void
+    Task::updateMailboxPriorities(void)
+    {
+      m_recipient->clearPriorities();
+
+      for (unsigned i = 0; i < m_args.mailbox_priorities.size(); ++i)
+      {
+        const std::string& abbrev = m_args.mailbox_priorities[i];
+
+        try
+        {
+          m_recipient->setPriority(IMC::Factory::getIdFromAbbrev(abbrev), true);
+        }
+        catch (std::runtime_error&)
+        {
+          throw InvalidValue(DTR("Mailbox Priority Messages"), abbrev, DTR("invalid message"));
+        }
+      }
+    }
   }
 }
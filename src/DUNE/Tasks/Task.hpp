@@ -29,9 +29,11 @@
 #define DUNE_TASKS_TASK_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <string>
 #include <map>
 #include <stack>
+#include <vector>
 #include <cstdarg>
 
 // DUNE headers.
@@ -39,10 +41,12 @@
 #include <DUNE/Concurrency/Thread.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
+#include <DUNE/Tasks/RateLimiters.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/IMC/Constants.hpp>
 #include <DUNE/IMC/Definitions.hpp>
 #include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/SubscriptionFilter.hpp>
 #include <DUNE/Status/Codes.hpp>
 #include <DUNE/Concurrency/TLS.hpp>
 #include <DUNE/Parsers/BasicStringReader.hpp>
@@ -112,10 +116,7 @@ namespace DUNE
 
       //! Destructor.
       virtual
-      ~Task(void)
-      {
-        delete m_recipient;
-      }
+      ~Task(void);
 
       //! Retrieve the task's name.
       //! @return name of the task.
@@ -186,6 +187,45 @@ namespace DUNE
       void
       loadConfig(void);
 
+      //! Check if the task is executed by the thread pool instead of
+      //! its own thread. This is the case for tasks that support
+      //! step-wise execution and have 'Execution Mode' set to 'Pool'.
+      //! @return true if the task is pooled, false otherwise.
+      bool
+      isPooled(void) const
+      {
+        return canStep() && m_args.exec_mode == "Pool";
+      }
+
+      //! Check if the task requested the memory of the process to be
+      //! locked in RAM ('Lock Memory' parameter).
+      //! @return true if memory must be locked, false otherwise.
+      bool
+      requiresLockedMemory(void) const
+      {
+        return m_args.lock_memory;
+      }
+
+      //! Check if the task requested an explicit scheduling policy or
+      //! processor affinity for its thread.
+      //! @return true if explicit scheduling was requested, false
+      //! otherwise.
+      bool
+      hasSchedulingOptions(void) const
+      {
+        return m_args.exec_policy != "Default" || !m_args.affinity.empty();
+      }
+
+      //! Execute one step of a pooled task, initializing resources
+      //! first if needed.
+      //! @return amount of seconds until the next step.
+      double
+      step(void);
+
+      //! Release the resources of a pooled task after its last step.
+      void
+      finishSteps(void);
+
       //! Set scheduling priority programatically. The priority of a
       //! task might change when configuration parameters are updated.
       //! @param[in] value desired scheduling priority.
@@ -274,6 +314,15 @@ namespace DUNE
         dispatch(&msg, flags);
       }
 
+      //! Dispatch a shared message to the message bus without copying
+      //! it. The caller must hold the only reference to the handle
+      //! (see IMC::SharedMessagePool) since its header is updated
+      //! before dispatching; the caller keeps its reference.
+      //! @param[in] msg shared message handle.
+      //! @param[in] flags bitfield with flags (see DispatchFlags).
+      void
+      dispatch(IMC::SharedMessage* msg, unsigned int flags = 0);
+
       //! Dispatch message to the message bus in reply to another
       //! message.
       //! @param[in] original original message.
@@ -295,6 +344,75 @@ namespace DUNE
         m_recipient->put(msg);
       }
 
+      //! Queue a shared message for later consumption.
+      //! @param msg shared message handle.
+      void
+      receive(IMC::SharedMessage* msg)
+      {
+        m_recipient->put(msg);
+      }
+
+      //! Make a traced message the cause of the messages dispatched
+      //! from now on.
+      //! @param msg message.
+      void
+      beginTrace(const IMC::Message* msg);
+
+      //! Report the consumption of a traced message.
+      //! @param msg message.
+      void
+      endTrace(const IMC::Message* msg);
+
+      //! Retrieve the message queue statistics accumulated since the
+      //! last call and reset them.
+      //! @param[out] stats statistics message.
+      void
+      getMailboxStatistics(IMC::MailboxStatistics& stats)
+      {
+        m_recipient->getStatistics(stats);
+        stats.consumer = m_name;
+      }
+
+      //! Retrieve the configuration sections of the tasks that must
+      //! initialize their resources before this one acquires its own.
+      //! @return list of configuration sections.
+      const std::vector<std::string>&
+      getStartAfter(void) const
+      {
+        return m_args.start_after;
+      }
+
+      //! Make the task acquire its resources only after another task
+      //! initialized its own.
+      //! @param[in] task task this task depends on.
+      void
+      addDependency(Task* task)
+      {
+        Concurrency::ScopedMutex l(m_deps_mx);
+        m_deps.push_back(task);
+      }
+
+      //! Forget a dependency, before the other task is destroyed.
+      //! @param[in] task task this task depends on.
+      void
+      removeDependency(Task* task)
+      {
+        Concurrency::ScopedMutex l(m_deps_mx);
+        m_deps.erase(std::remove(m_deps.begin(), m_deps.end(), task), m_deps.end());
+      }
+
+      //! Test if the task initialized its resources.
+      //! @return true if the task initialized its resources, false
+      //! otherwise.
+      bool
+      isReady(void);
+
+      //! Retrieve the usage of the task's heap arena.
+      //! @param[out] usage heap usage message.
+      //! @return true if the task has a heap arena, false otherwise.
+      bool
+      getHeapUsage(IMC::HeapUsage& usage);
+
       //! Instruct task to reserve all entity identifiers that it
       //! needs for normal execution.
       void
@@ -389,6 +507,14 @@ namespace DUNE
       unsigned int
       resolveEntity(const std::string& label) const;
 
+      //! Retrieve the entity ids of several entity labels.
+      //! @param[in] labels entity labels.
+      //! @param[out] ids entity ids, in the same order.
+      //! @throw NonexistentLabel if a label doesn't have an
+      //! associated id.
+      void
+      resolveEntities(const std::vector<std::string>& labels, std::vector<unsigned>& ids) const;
+
       //! Retrieve the entity label of a given entity id.
       //! @param[in] id entity id.
       //! @throw NonexistentId if the id doesn't have an
@@ -421,6 +547,9 @@ namespace DUNE
       waitForMessages(double timeout)
       {
         m_recipient->waitForMessages(timeout);
+
+        if (m_entity_state_pending)
+          flushEntityState();
       }
 
       //! Call the consumers of all messages currently in the
@@ -429,6 +558,9 @@ namespace DUNE
       consumeMessages(void)
       {
         m_recipient->runCallBacks();
+
+        if (m_entity_state_pending)
+          flushEntityState();
       }
 
       //! Declare a configuration parameter that can be parsed using
@@ -497,6 +629,20 @@ namespace DUNE
         bind(M::getIdStatic(), new Consumer<T, M>(*task_obj, consumer));
       }
 
+      //! Bind a message to a consumer method, receiving only the
+      //! messages selected by a filter. Messages are filtered by the
+      //! message bus before being queued.
+      //! @param task_obj consumer task.
+      //! @param filter subscription filter.
+      //! @param consumer consumer method.
+      template <typename M, typename T>
+      void
+      bind(T* task_obj, const IMC::SubscriptionFilter& filter,
+           void (T::* consumer)(const M*) = &T::consume)
+      {
+        bind(M::getIdStatic(), new Consumer<T, M>(*task_obj, consumer), &filter);
+      }
+
       //! Bind multiple messages to a default consumer method.
       //! @param task_obj consumer object.
       //! @param list list of message identifiers.
@@ -522,6 +668,25 @@ namespace DUNE
                new Consumer<T, IMC::Message>(*task_obj, func));
       }
 
+      //! Bind multiple messages to a default consumer method, with
+      //! rates limited by the message bus.
+      //! @param task_obj consumer task.
+      //! @param list list of message abbreviations.
+      //! @param limits rate limiters.
+      template <typename T>
+      void
+      bind(T* task_obj, const std::vector<std::string>& list, const RateLimiters& limits)
+      {
+        void (T::* func)(const IMC::Message*) = &T::consume;
+        for (unsigned int i = 0; i < list.size(); ++i)
+        {
+          uint32_t id = IMC::Factory::getIdFromAbbrev(list[i]);
+          IMC::SubscriptionFilter filter;
+          filter.setMinimumInterval(limits.getInterval(id));
+          bind(id, new Consumer<T, IMC::Message>(*task_obj, func), &filter);
+        }
+      }
+
       //! Request task to start/resume normal execution.
       void
       requestActivation(void);
@@ -652,6 +817,25 @@ namespace DUNE
       virtual void
       onMain(void) = 0;
 
+      //! Check if the task supports step-wise execution. Derived
+      //! classes that implement onStep() should override this
+      //! function.
+      //! @return true if the task can be pooled, false otherwise.
+      virtual bool
+      canStep(void) const
+      {
+        return false;
+      }
+
+      //! Called by the thread pool to execute one step of the task.
+      //! Implementations must not block.
+      //! @return amount of seconds until the next step.
+      virtual double
+      onStep(void)
+      {
+        return 1.0;
+      }
+
     private:
       struct BasicArguments
       {
@@ -667,6 +851,26 @@ namespace DUNE
         std::string active_scope;
         //! Visibility of 'Active' parameter.
         std::string active_visibility;
+        //! Maximum number of queued messages.
+        unsigned mailbox_capacity;
+        //! Overflow policies by message abbreviation.
+        std::vector<std::string> mailbox_policies;
+        //! Abbreviations of messages delivered from the priority lane.
+        std::vector<std::string> mailbox_priorities;
+        //! Execution mode.
+        std::string exec_mode;
+        //! Scheduling policy of the task's thread.
+        std::string exec_policy;
+        //! Processors where the task's thread is allowed to run.
+        std::vector<unsigned> affinity;
+        //! True to lock the memory of the process in RAM.
+        bool lock_memory;
+        //! Heap arena size (0 to use the shared heap).
+        unsigned heap_quota;
+        //! Tasks that must be ready before resource acquisition.
+        std::vector<std::string> start_after;
+        //! Minimum time between entity state reports.
+        double entity_state_holdoff;
       };
 
       enum NextActivationState
@@ -697,6 +901,17 @@ namespace DUNE
       IMC::EntityState m_entity_state;
       //! Last entity state description code (-1 means none).
       int m_entity_state_code;
+      //! Code of the current entity state description (-1 means
+      //! none). Descriptions are built when the state is dispatched.
+      int m_entity_state_desc_code;
+      //! Last dispatched entity state.
+      uint8_t m_entity_state_sent;
+      //! Time of the last entity state dispatch.
+      double m_entity_state_time;
+      //! True if a state change is waiting for the holdoff to expire.
+      bool m_entity_state_pending;
+      //! Last dispatched entity activation state.
+      IMC::EntityActivationState m_act_state_sent;
       //! Entity information message.
       IMC::EntityInfo m_ent_info;
       //! Arguments.
@@ -711,6 +926,41 @@ namespace DUNE
       std::string m_param_editor;
       //! Next activation state.
       NextActivationState m_next_act_state;
+      //! True if resources of a pooled task are initialized.
+      bool m_stepping;
+      //! True if a pooled task must update parameters before its
+      //! next step.
+      bool m_step_restart;
+      //! Trace of the last traced message consumed.
+      IMC::Message::Trace m_trace;
+      //! Identifier of the last traced message consumed.
+      uint16_t m_trace_cause;
+      //! Messages already dispatched in the current trace.
+      std::vector<uint16_t> m_trace_hops;
+      //! Heap arena (NULL if the task uses the shared heap).
+      void* m_heap_arena;
+      //! True if creation of the heap arena was already attempted.
+      bool m_heap_arena_tried;
+      //! Tasks that must be ready before resource acquisition.
+      std::vector<Task*> m_deps;
+      //! Mutex to protect m_deps.
+      Concurrency::Mutex m_deps_mx;
+      //! True if resources are initialized.
+      bool m_ready;
+      //! Mutex to protect m_ready.
+      Concurrency::Mutex m_ready_mx;
+      //! Time at which resource startup began (negative if idle).
+      double m_startup_time;
+      //! Text of the last human-readable message.
+      std::string m_log_last;
+      //! Type of the last human-readable message.
+      IMC::LogBookEntry::TypeEnum m_log_last_type;
+      //! Time at which the last message was output.
+      double m_log_last_time;
+      //! Number of times the last message was suppressed.
+      unsigned m_log_repeats;
+      //! Mutex to protect the last message state.
+      Concurrency::Mutex m_log_mx;
 
       //! Report current entity states by dispatching EntityState
       //! messages. This function will at least report the state of
@@ -718,21 +968,110 @@ namespace DUNE
       void
       reportEntityState(void);
 
+      //! Build the description of the entity state from its code,
+      //! if it changed since it was last built.
+      void
+      updateEntityStateDescription(void);
+
+      //! Report a change of entity state. Changes to a less severe
+      //! state closer than the entity state holdoff to the previous
+      //! report are coalesced and reported later by
+      //! flushEntityState().
+      void
+      changeEntityState(void);
+
+      //! Report a coalesced entity state change if the holdoff has
+      //! expired. Changes back to the last reported state are
+      //! dropped.
+      void
+      flushEntityState(void);
+
+      //! Dispatch the current entity state.
+      void
+      dispatchEntityState(void);
+
+      //! Dispatch the current entity activation state.
+      void
+      dispatchActivationState(void);
+
+      //! Apply the mailbox overflow policies given by the
+      //! 'Mailbox Overflow Policies' parameter.
+      void
+      updateMailboxPolicies(void);
+
+      //! Apply the message priorities given by the 'Mailbox Priority
+      //! Messages' parameter.
+      void
+      updateMailboxPriorities(void);
+
+      //! Test if all tasks this task depends on are ready.
+      //! @return true if all dependencies are ready, false otherwise.
+      bool
+      dependenciesReady(void);
+
+      //! Set the readiness flag and, on readiness, log the time taken
+      //! to bring up the task's resources.
+      //! @param[in] ready true if resources are initialized.
+      void
+      setReady(bool ready);
+
+      //! Select the heap arena of the task for the calling thread,
+      //! creating it on first use if 'Heap Quota' is set.
+      void
+      selectHeapArena(void);
+
+      //! Apply the configured processor affinity and scheduling
+      //! policy to the calling thread, reporting any failure.
+      void
+      applySchedulingPolicy(void);
+
       void
       log(IMC::LogBookEntry::TypeEnum type, const char* format, std::va_list arg_list);
 
+      //! Output a human-readable message to the message bus and the
+      //! terminal.
+      //! @param[in] type message type.
+      //! @param[in] text message text.
+      void
+      output(IMC::LogBookEntry::TypeEnum type, const char* text);
+
+      //! Propagate or start the trace of a message being dispatched.
+      //! Only the first message of each type dispatched while a trace
+      //! is current is traced.
+      //! @param msg message.
+      void
+      traceDispatch(IMC::Message* msg);
+
+      //! Fill the header of a message about to be dispatched.
+      //! @param[in] msg message.
+      //! @param[in] flags bitfield with flags (see DispatchFlags).
+      void
+      prepareDispatch(IMC::Message* msg, unsigned int flags);
+
+      //! Report a step of a trace.
+      //! @param trace trace.
+      //! @param id message identification number.
+      //! @param cause identification number of the cause.
+      //! @param event trace event.
+      void
+      dispatchHop(const IMC::Message::Trace& trace, uint16_t id, uint16_t cause,
+                  IMC::TraceHop::EventEnum event);
+
       void
       run(void);
 
       //! Register a consumer for a given message identifier.
       //! @param[in] message_id message identifier.
       //! @param[in] consumer consumer object.
+      //! @param[in] filter subscription filter (NULL to receive all
+      //! messages).
       void
-      bind(unsigned int message_id, AbstractConsumer* consumer)
+      bind(unsigned int message_id, AbstractConsumer* consumer,
+           const IMC::SubscriptionFilter* filter = NULL)
       {
         spew("registering consumer for '%s'",
              IMC::Factory::getAbbrevFromId(message_id).c_str());
-        m_recipient->bind(message_id, consumer);
+        m_recipient->bind(message_id, consumer, filter);
       }
 
       void
@@ -0,0 +1,80 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/IMC/Factory.hpp>
+#include <DUNE/Tasks/Tracer.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    Tracer::Tracer(void):
+      m_period(1.0),
+      m_id(0)
+    { }
+
+    void
+    Tracer::configure(const std::vector<std::string>& origins, double period)
+    {
+      m_origins.clear();
+      for (unsigned i = 0; i < origins.size(); ++i)
+        m_origins.push_back(IMC::Factory::getIdFromAbbrev(origins[i]));
+
+      m_last.assign(m_origins.size(), -period);
+      m_period = period;
+    }
+
+    bool
+    Tracer::start(IMC::Message* msg, double now)
+    {
+      uint16_t id = msg->getId();
+
+      for (unsigned i = 0; i < m_origins.size(); ++i)
+      {
+        if (m_origins[i] != id)
+          continue;
+
+        Concurrency::ScopedMutex l(m_mutex);
+        if (now - m_last[i] < m_period)
+          return false;
+
+        m_last[i] = now;
+
+        IMC::Message::Trace trace;
+        trace.id = ++m_id;
+        trace.origin = id;
+        trace.time = now;
+        msg->setTrace(trace);
+        return true;
+      }
+
+      return false;
+    }
+  }
+}
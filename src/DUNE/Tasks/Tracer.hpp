@@ -0,0 +1,106 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_TASKS_TRACER_HPP_INCLUDED_
+#define DUNE_TASKS_TRACER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace Tasks
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Tracer;
+
+    //! Starts causal traces of messages. A trace starts when a task
+    //! dispatches an origin message, at most once per period for
+    //! each type of origin message. Tasks propagate the trace to the
+    //! messages they dispatch while handling a traced message and
+    //! report each step with a TraceHop message.
+    class Tracer
+    {
+    public:
+      //! Constructor. Tracing is disabled until origins are set.
+      Tracer(void);
+
+      //! Configure tracing. This function must not be called after
+      //! tasks have started.
+      //! @param[in] origins abbreviations of the origin messages.
+      //! @param[in] period minimum time between traces of the same
+      //! origin message.
+      void
+      configure(const std::vector<std::string>& origins, double period);
+
+      //! Test if tracing is enabled.
+      //! @return true if there are origin messages, false otherwise.
+      bool
+      isEnabled(void) const
+      {
+        return !m_origins.empty();
+      }
+
+      //! Get the maximum time a trace is propagated, which is also
+      //! the minimum time between traces of the same origin.
+      //! @return period in seconds.
+      double
+      getPeriod(void) const
+      {
+        return m_period;
+      }
+
+      //! Start a trace if a message is an origin message and the
+      //! period elapsed since its last trace.
+      //! @param[in,out] msg message being dispatched.
+      //! @param[in] now current time (monotonic clock).
+      //! @return true if a trace was started, false otherwise.
+      bool
+      start(IMC::Message* msg, double now);
+
+    private:
+      //! Origin message identifiers.
+      std::vector<uint16_t> m_origins;
+      //! Time of the last trace of each origin.
+      std::vector<double> m_last;
+      //! Minimum time between traces of the same origin.
+      double m_period;
+      //! Last trace identifier.
+      uint32_t m_id;
+      //! Mutex guarding trace start.
+      Concurrency::Mutex m_mutex;
+    };
+  }
+}
+
+#endif
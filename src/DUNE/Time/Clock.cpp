@@ -26,6 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <ctime>
 #include <cstring>
 #include <cerrno>
@@ -35,6 +36,8 @@
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/System/Error.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 
 // Platform headers.
 #if defined(DUNE_SYS_HAS_SYS_TIME_H)
@@ -53,8 +56,31 @@ namespace DUNE
 {
   namespace Time
   {
+    //! True if the clock no longer follows the system clock.
+    static volatile bool s_shifted = false;
+    //! True if the clock is held.
+    static bool s_held = false;
+    //! Held time since the Epoch (ns).
+    static uint64_t s_held_nsec = 0;
+    //! Clock time since the Epoch when the speed was last set or the
+    //! clock was released (ns).
+    static uint64_t s_base_nsec = 0;
+    //! System monotonic time at the same instant (ns). The shifted
+    //! clock advances with the monotonic clock, so steps of the
+    //! system time (e.g., NTP or GPS corrections) do not affect it.
+    static uint64_t s_base_system_nsec = 0;
+    //! Clock speed.
+    static double s_speed = 1.0;
+    //! Difference between the monotonic time and the time since the
+    //! Epoch when the clock was first shifted (ns).
+    static int64_t s_mono_base = 0;
+    //! Polling interval of waits while the clock is held (ns).
+    static const uint64_t c_hold_poll_nsec = 1000000;
+    //! Lock serializing access to the clock state.
+    static Concurrency::Mutex s_lock;
+
     uint64_t
-    Clock::getNsec(void)
+    Clock::getSystemNsec(void)
     {
       // POSIX RT.
 #if defined(DUNE_SYS_HAS_CLOCK_GETTIME)
@@ -71,14 +97,14 @@ namespace DUNE
         QueryPerformanceCounter(&li);
         return (uint64_t)(li.QuadPart * (1000000000L / (double)frequency.QuadPart));
       }
-      return getSinceEpochNsec();
+      return getSystemSinceEpochNsec();
 #else
-      return getSinceEpochNsec();
+      return getSystemSinceEpochNsec();
 #endif
     }
 
     uint64_t
-    Clock::getSinceEpochNsec(void)
+    Clock::getSystemSinceEpochNsec(void)
     {
       // POSIX RT.
 #if defined(DUNE_SYS_HAS_CLOCK_GETTIME)
@@ -112,6 +138,70 @@ namespace DUNE
 #endif
     }
 
+    //! Get the time since the Epoch, with the clock state locked.
+    //! @return time in nanoseconds.
+    static uint64_t
+    getShiftedSinceEpochNsec(void)
+    {
+      if (s_held)
+        return s_held_nsec;
+
+      uint64_t elapsed = Clock::getSystemNsec() - s_base_system_nsec;
+      return s_base_nsec + (uint64_t)(elapsed * s_speed);
+    }
+
+    //! Start shifting the clock, with the clock state locked.
+    static void
+    shift(void)
+    {
+      if (s_shifted)
+        return;
+
+      uint64_t now = Clock::getSystemSinceEpochNsec();
+      uint64_t mono = Clock::getSystemNsec();
+      s_mono_base = (int64_t)mono - (int64_t)now;
+      s_base_nsec = now;
+      s_base_system_nsec = mono;
+      s_shifted = true;
+    }
+
+    uint64_t
+    Clock::getNsec(void)
+    {
+      if (!s_shifted)
+        return getSystemNsec();
+
+      Concurrency::ScopedMutex l(s_lock);
+      return (uint64_t)((int64_t)getShiftedSinceEpochNsec() + s_mono_base);
+    }
+
+    double
+    Clock::getCoarse(void)
+    {
+#if defined(DUNE_SYS_HAS_CLOCK_GETTIME) && defined(CLOCK_MONOTONIC_COARSE)
+      if (!s_shifted)
+      {
+        timespec ts;
+        if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+        {
+          // Same point of reference as getSystemNsec().
+          return ((uint64_t)ts.tv_sec * c_nsec_per_sec + (uint64_t)ts.tv_nsec) / c_nsec_per_sec_fp;
+        }
+      }
+#endif
+      return get();
+    }
+
+    uint64_t
+    Clock::getSinceEpochNsec(void)
+    {
+      if (!s_shifted)
+        return getSystemSinceEpochNsec();
+
+      Concurrency::ScopedMutex l(s_lock);
+      return getShiftedSinceEpochNsec();
+    }
+
     void
     Clock::set(double value)
     {
@@ -125,5 +215,85 @@ namespace DUNE
       (void)value;
 #endif
     }
+
+    void
+    Clock::hold(double value)
+    {
+      uint64_t nsec = (uint64_t)(value * c_nsec_per_sec_fp);
+
+      Concurrency::ScopedMutex l(s_lock);
+      shift();
+
+      if (!s_held)
+      {
+        s_held_nsec = getShiftedSinceEpochNsec();
+        s_held = true;
+      }
+
+      if (nsec > s_held_nsec)
+        s_held_nsec = nsec;
+    }
+
+    void
+    Clock::release(void)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+
+      if (!s_held)
+        return;
+
+      s_base_nsec = s_held_nsec;
+      s_base_system_nsec = getSystemNsec();
+      s_held = false;
+    }
+
+    bool
+    Clock::isHeld(void)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      return s_held;
+    }
+
+    void
+    Clock::setSpeed(double factor)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      shift();
+
+      if (!s_held)
+      {
+        s_base_nsec = getShiftedSinceEpochNsec();
+        s_base_system_nsec = getSystemNsec();
+      }
+
+      s_speed = factor;
+    }
+
+    double
+    Clock::getSpeed(void)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      return s_speed;
+    }
+
+    bool
+    Clock::isShifted(void)
+    {
+      return s_shifted;
+    }
+
+    uint64_t
+    Clock::toSystemNsec(uint64_t nsec)
+    {
+      if (!s_shifted)
+        return nsec;
+
+      Concurrency::ScopedMutex l(s_lock);
+
+      if (s_held)
+        return std::min(nsec, c_hold_poll_nsec);
+
+      return (uint64_t)(nsec / s_speed);
+    }
   }
 }
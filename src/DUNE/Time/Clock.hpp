@@ -39,7 +39,12 @@ namespace DUNE
     // Export DLL Symbol.
     class DUNE_DLL_SYM Clock;
 
-    //! %System clock routines.
+    //! %System clock routines. The clock normally follows the
+    //! operating system clock but can run at another speed, e.g., to
+    //! simulate faster than real time, or be held at a given time and
+    //! moved forward explicitly, e.g., to replay recorded data. All
+    //! users of the clock observe the same time, and timed waits
+    //! (Delay, PeriodicDelay, Concurrency::Condition) follow it.
     class Clock
     {
     public:
@@ -80,6 +85,13 @@ namespace DUNE
         return getNsec() / c_nsec_per_sec_fp;
       }
 
+      //! Same as get(), but may return a time a few milliseconds old
+      //! if the system provides a cheaper coarse clock. Suitable for
+      //! rate limiting frequent events.
+      //! @return time in seconds.
+      static double
+      getCoarse(void);
+
       //! Get the amount of time (in nanoseconds) elapsed since the
       //! UNIX Epoch (Midnight UTC of January 1, 1970).
       //! @return time in nanoseconds.
@@ -118,6 +130,64 @@ namespace DUNE
       //! @param value time in seconds.
       static void
       set(double value);
+
+      //! Stop following the system clock and move the time since the
+      //! UNIX Epoch to a given value. While held, the clock only
+      //! changes with calls to this function and never goes
+      //! backwards. The monotonic clock (get()) moves by the same
+      //! amount.
+      //! @param value time in seconds since the UNIX Epoch.
+      static void
+      hold(double value);
+
+      //! Resume running at the rate of the system clock, starting at
+      //! the current (held) time.
+      static void
+      release(void);
+
+      //! Test if the clock is held.
+      //! @return true if the clock is held, false otherwise.
+      static bool
+      isHeld(void);
+
+      //! Set the speed of the clock relative to the system clock,
+      //! starting at the current time. Takes effect when the clock
+      //! is released if it is held.
+      //! @param factor clock speed (1 for real time).
+      static void
+      setSpeed(double factor);
+
+      //! Get the speed of the clock relative to the system clock.
+      //! @return clock speed.
+      static double
+      getSpeed(void);
+
+      //! Test if the clock no longer follows the system clock,
+      //! i.e., it was held or its speed was changed.
+      //! @return true if the clock differs from the system clock,
+      //! false otherwise.
+      static bool
+      isShifted(void);
+
+      //! Convert a clock interval to the amount of system time to
+      //! block for. While the clock is held, this is a short polling
+      //! interval.
+      //! @param nsec clock interval in nanoseconds.
+      //! @return system interval in nanoseconds.
+      static uint64_t
+      toSystemNsec(uint64_t nsec);
+
+      //! Get the time (in nanoseconds) of the system monotonic
+      //! clock, ignoring holds and speed changes.
+      //! @return time in nanoseconds.
+      static uint64_t
+      getSystemNsec(void);
+
+      //! Get the amount of system time (in nanoseconds) elapsed since
+      //! the UNIX Epoch, ignoring holds and speed changes.
+      //! @return time in nanoseconds.
+      static uint64_t
+      getSystemSinceEpochNsec(void);
     };
   }
 }
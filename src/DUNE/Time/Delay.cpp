@@ -29,6 +29,7 @@
 #include <DUNE/Config.hpp>
 #include <DUNE/Time/Delay.hpp>
 #include <DUNE/Time/Constants.hpp>
+#include <DUNE/Time/Clock.hpp>
 
 // Platform headers.
 #if defined(DUNE_SYS_HAS_TIME_H)
@@ -45,6 +46,43 @@ namespace DUNE
   {
     void
     Delay::waitNsec(uint64_t nsec)
+    {
+      if (!Clock::isShifted())
+        waitSystemNsec(nsec);
+      else
+        waitUntilNsec(Clock::getNsec() + nsec);
+    }
+
+    void
+    Delay::waitUntilNsec(uint64_t deadline)
+    {
+      while (true)
+      {
+        uint64_t now = Clock::getNsec();
+        if (now >= deadline)
+          return;
+
+        if (!Clock::isShifted())
+        {
+#if defined(DUNE_SYS_HAS_CLOCK_NANOSLEEP) && defined(DUNE_SYS_HAS_CLOCK_GETTIME)
+          // Same clock as Clock::getNsec().
+          timespec ts;
+          ts.tv_sec = deadline / c_nsec_per_sec;
+          ts.tv_nsec = deadline - (ts.tv_sec * c_nsec_per_sec);
+          clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0);
+#else
+          waitSystemNsec(deadline - now);
+#endif
+        }
+        else
+        {
+          waitSystemNsec(Clock::toSystemNsec(deadline - now));
+        }
+      }
+    }
+
+    void
+    Delay::waitSystemNsec(uint64_t nsec)
     {
       // POSIX.
 #if defined(DUNE_SYS_HAS_CLOCK_NANOSLEEP) || defined(DUNE_SYS_HAS_NANOSLEEP)
@@ -71,7 +109,7 @@ namespace DUNE
 
       // Unsupported system.
 #else
-#  error Delay::waitNsec() is not yet implemented in this system
+#  error Delay::waitSystemNsec() is not yet implemented in this system
 #endif
     }
   }
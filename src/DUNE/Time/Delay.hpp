@@ -39,7 +39,9 @@ namespace DUNE
     // Export DLL Symbol.
     class DUNE_DLL_SYM Delay;
 
-    //! Routines to control timed delays.
+    //! Routines to control timed delays. Delays are measured with
+    //! Clock, so they are shorter when the clock runs faster than
+    //! real time and only end when a held clock is moved past them.
     class Delay
     {
     public:
@@ -49,6 +51,29 @@ namespace DUNE
       static void
       waitNsec(uint64_t nsec);
 
+      //! Suspends the execution of the calling thread until the
+      //! monotonic clock (Clock::getNsec()) reaches a deadline.
+      //! @param deadline deadline in nanoseconds.
+      static void
+      waitUntilNsec(uint64_t deadline);
+
+      //! Suspends the execution of the calling thread for the
+      //! specified amount of system time (in nanosecond), regardless
+      //! of the speed or state of Clock.
+      //! @param nsec the amount of nanoseconds to suspend.
+      static void
+      waitSystemNsec(uint64_t nsec);
+
+      //! Suspends the execution of the calling thread for the
+      //! specified amount of system time (in seconds), regardless of
+      //! the speed or state of Clock.
+      //! @param s the amount of time to suspend.
+      static void
+      waitSystem(double s)
+      {
+        waitSystemNsec(toNsec(s));
+      }
+
       //! Suspends the execution of the calling thread for the
       //! specified amount of time (in microsecond).
       //! @param usec the amount of microseconds to suspend.
@@ -73,10 +98,18 @@ namespace DUNE
       static void
       wait(double s)
       {
-        uint64_t secs = (uint64_t)s;
-        uint64_t nsecs = secs * c_nsec_per_sec + (uint64_t)((s - secs) * c_nsec_per_sec_fp);
+        waitNsec(toNsec(s));
+      }
 
-        waitNsec(nsecs);
+    private:
+      //! Convert seconds to nanoseconds.
+      //! @param s time in seconds.
+      //! @return time in nanoseconds.
+      static uint64_t
+      toNsec(double s)
+      {
+        uint64_t secs = (uint64_t)s;
+        return secs * c_nsec_per_sec + (uint64_t)((s - secs) * c_nsec_per_sec_fp);
       }
     };
   }
@@ -39,13 +39,17 @@ namespace DUNE
 #include <DUNE/Utils/ByteCopy.hpp>
 #include <DUNE/Utils/CircularBuffer.hpp>
 #include <DUNE/Utils/Exceptions.hpp>
+#include <DUNE/Utils/MessageCatalog.hpp>
 #include <DUNE/Utils/NMEAParser.hpp>
 #include <DUNE/Utils/OptionParser.hpp>
 #include <DUNE/Utils/RawFifo.hpp>
 #include <DUNE/Utils/StateMachine.hpp>
 #include <DUNE/Utils/String.hpp>
+#include <DUNE/Utils/StringView.hpp>
+#include <DUNE/Utils/TransitionTable.hpp>
 #include <DUNE/Utils/TupleList.hpp>
 #include <DUNE/Utils/Utils.hpp>
 #include <DUNE/Utils/XML.hpp>
+#include <DUNE/Utils/XMLReader.hpp>
 
 #endif
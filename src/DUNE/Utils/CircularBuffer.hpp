@@ -76,13 +76,38 @@ namespace DUNE
         m_capacity(other.m_capacity),
         m_size(other.m_size),
         m_head(0),
-        m_tail(m_size - 1)
+        m_tail(m_size % m_capacity)
       {
         m_buffer = new T[m_capacity];
         for (uint32_t i = 0; i < m_size; ++i)
           m_buffer[i] = other(i);
       }
 
+      //! Assignment operator.
+      //! @param other instance of CircularBuffer<T> to copy.
+      //! @return reference to this object.
+      CircularBuffer<T>&
+      operator=(const CircularBuffer<T>& other)
+      {
+        if (this == &other)
+          return *this;
+
+        if (m_capacity != other.m_capacity)
+        {
+          delete [] m_buffer;
+          m_capacity = other.m_capacity;
+          m_buffer = new T[m_capacity];
+        }
+
+        for (uint32_t i = 0; i < other.m_size; ++i)
+          m_buffer[i] = other(i);
+
+        m_size = other.m_size;
+        m_head = 0;
+        m_tail = m_size % m_capacity;
+        return *this;
+      }
+
       //! Destructor.
       inline
       ~CircularBuffer(void)
@@ -121,7 +146,7 @@ namespace DUNE
         delete [] m_buffer;
         m_buffer = b;
         m_head = 0;
-        m_tail = newsize - 1;
+        m_tail = newsize % n;
         m_size = newsize;
         m_capacity = n;
       }
@@ -142,6 +167,17 @@ namespace DUNE
         m_tail = (m_tail + 1) % m_capacity;
       }
 
+      //! Remove the oldest data from the buffer.
+      inline void
+      pop(void)
+      {
+        if (!m_size)
+          throw Error("buffer is empty");
+
+        m_head = (m_head + 1) % m_capacity;
+        --m_size;
+      }
+
       //! Access buffer position.
       //! @param index position.
       //! @return data at index-th position.
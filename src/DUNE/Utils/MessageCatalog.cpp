@@ -0,0 +1,243 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Utils/MessageCatalog.hpp>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    //! Magic number of compiled catalogs.
+    static const uint32_t c_magic = 0x950412de;
+    //! Magic number of compiled catalogs with swapped byte order.
+    static const uint32_t c_magic_swapped = 0xde120495;
+    //! Size of the header of compiled catalogs.
+    static const size_t c_header_size = 20;
+    //! Average number of messages per bucket.
+    static const size_t c_bucket_load = 4;
+    //! Maximum number of displacements tried per bucket.
+    static const uint32_t c_max_displacements = 1 << 16;
+
+    //! Read a 32-bit integer from a catalog.
+    static uint32_t
+    read32(const std::vector<char>& data, size_t offset, bool swap)
+    {
+      if (offset + 4 > data.size())
+        throw std::runtime_error(DTR("truncated message catalog"));
+
+      const uint8_t* ptr = (const uint8_t*)&data[offset];
+      if (swap)
+        return (ptr[0] << 24) | (ptr[1] << 16) | (ptr[2] << 8) | ptr[3];
+      return (ptr[3] << 24) | (ptr[2] << 16) | (ptr[1] << 8) | ptr[0];
+    }
+
+    //! Validate a catalog string and get a pointer to it.
+    static const char*
+    getString(const std::vector<char>& data, uint32_t length, uint32_t offset)
+    {
+      // Strings are null terminated, the terminator is not counted.
+      if ((size_t)offset + length >= data.size() || data[offset + length] != 0)
+        throw std::runtime_error(DTR("invalid string in message catalog"));
+
+      return &data[offset];
+    }
+
+    //! Bucket of messages sharing the same first hash.
+    struct Bucket
+    {
+      //! Bucket index.
+      size_t index;
+      //! Messages in the bucket.
+      std::vector<size_t> keys;
+
+      bool
+      operator<(const Bucket& other) const
+      {
+        return keys.size() > other.keys.size();
+      }
+    };
+
+    MessageCatalog::MessageCatalog(const std::string& path)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+      if (!ifs)
+        throw std::runtime_error(DTR("unable to open message catalog: ") + path);
+
+      ifs.seekg(0, std::ios::end);
+      m_data.resize((size_t)ifs.tellg());
+      ifs.seekg(0, std::ios::beg);
+      if (!m_data.empty())
+        ifs.read(&m_data[0], m_data.size());
+
+      if (!ifs || m_data.size() < c_header_size)
+        throw std::runtime_error(DTR("truncated message catalog"));
+
+      bool swap = false;
+      uint32_t magic = read32(m_data, 0, false);
+      if (magic == c_magic_swapped)
+        swap = true;
+      else if (magic != c_magic)
+        throw std::runtime_error(DTR("invalid message catalog"));
+
+      uint32_t count = read32(m_data, 8, swap);
+      uint32_t originals = read32(m_data, 12, swap);
+      uint32_t translations = read32(m_data, 16, swap);
+
+      std::set<std::string> seen;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        uint32_t klen = read32(m_data, originals + i * 8, swap);
+        uint32_t koff = read32(m_data, originals + i * 8 + 4, swap);
+        uint32_t vlen = read32(m_data, translations + i * 8, swap);
+        uint32_t voff = read32(m_data, translations + i * 8 + 4, swap);
+
+        const char* key = getString(m_data, klen, koff);
+        const char* value = getString(m_data, vlen, voff);
+
+        // Skip the catalog header and untranslated messages.
+        if (*key == 0 || *value == 0)
+          continue;
+
+        if (!seen.insert(key).second)
+          continue;
+
+        m_keys.push_back(key);
+        m_values.push_back(value);
+      }
+
+      // Tables that fail to build are retried with more slots.
+      size_t slots = m_keys.size() + m_keys.size() / 8 + 1;
+      do
+      {
+        m_slots.assign(slots, -1);
+        slots += slots / 4 + 1;
+      }
+      while (!build());
+    }
+
+    uint32_t
+    MessageCatalog::hash(uint32_t seed, const char* str)
+    {
+      // FNV-1a, seeded.
+      uint32_t h = 2166136261u ^ (seed * 16777619u);
+      for (; *str != 0; ++str)
+      {
+        h ^= (uint8_t)*str;
+        h *= 16777619u;
+      }
+
+      h ^= h >> 15;
+      h *= 0x2c1b3c6du;
+      h ^= h >> 12;
+      return h;
+    }
+
+    bool
+    MessageCatalog::build(void)
+    {
+      size_t bucket_count = m_keys.size() / c_bucket_load + 1;
+      std::vector<Bucket> buckets(bucket_count);
+      for (size_t i = 0; i < bucket_count; ++i)
+        buckets[i].index = i;
+
+      for (size_t i = 0; i < m_keys.size(); ++i)
+        buckets[hash(0, m_keys[i]) % bucket_count].keys.push_back(i);
+
+      // Place the largest buckets first, while most slots are free.
+      std::sort(buckets.begin(), buckets.end());
+      m_displacements.assign(bucket_count, 0);
+
+      std::vector<size_t> placed;
+      for (size_t i = 0; i < bucket_count; ++i)
+      {
+        const Bucket& bucket = buckets[i];
+        if (bucket.keys.empty())
+          break;
+
+        bool found = false;
+        for (uint32_t d = 1; d < c_max_displacements && !found; ++d)
+        {
+          placed.clear();
+          found = true;
+
+          for (size_t j = 0; j < bucket.keys.size(); ++j)
+          {
+            size_t slot = hash(d, m_keys[bucket.keys[j]]) % m_slots.size();
+            if (m_slots[slot] >= 0)
+            {
+              found = false;
+              break;
+            }
+
+            m_slots[slot] = (int32_t)bucket.keys[j];
+            placed.push_back(slot);
+          }
+
+          if (found)
+          {
+            m_displacements[bucket.index] = d;
+          }
+          else
+          {
+            for (size_t j = 0; j < placed.size(); ++j)
+              m_slots[placed[j]] = -1;
+          }
+        }
+
+        if (!found)
+          return false;
+      }
+
+      return true;
+    }
+
+    const char*
+    MessageCatalog::lookup(const char* msgid) const
+    {
+      if (m_keys.empty())
+        return NULL;
+
+      uint32_t d = m_displacements[hash(0, msgid) % m_displacements.size()];
+      if (d == 0)
+        return NULL;
+
+      int32_t index = m_slots[hash(d, msgid) % m_slots.size()];
+      if (index < 0 || std::strcmp(m_keys[index], msgid) != 0)
+        return NULL;
+
+      return m_values[index];
+    }
+  }
+}
@@ -0,0 +1,104 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_UTILS_MESSAGE_CATALOG_HPP_INCLUDED_
+#define DUNE_UTILS_MESSAGE_CATALOG_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM MessageCatalog;
+
+    //! Translation catalog loaded from a compiled GNU gettext
+    //! message catalog (.mo file). Messages are placed in a
+    //! minimal perfect hash table (hash and displace) when the
+    //! catalog is loaded, so a lookup costs two string hashes, one
+    //! table access and one string comparison, regardless of the
+    //! number of messages. Translations remain valid for the
+    //! lifetime of the catalog.
+    class MessageCatalog
+    {
+    public:
+      //! Load a compiled message catalog.
+      //! @param[in] path path to the catalog.
+      //! @throw std::runtime_error if the catalog cannot be read
+      //! or is malformed.
+      MessageCatalog(const std::string& path);
+
+      //! Retrieve the translation of a message.
+      //! @param[in] msgid original message.
+      //! @return translated message, or NULL if the message has
+      //! no translation.
+      const char*
+      lookup(const char* msgid) const;
+
+      //! Get the number of translated messages.
+      //! @return number of messages.
+      size_t
+      size(void) const
+      {
+        return m_keys.size();
+      }
+
+    private:
+      //! Catalog contents.
+      std::vector<char> m_data;
+      //! Original messages.
+      std::vector<const char*> m_keys;
+      //! Translated messages.
+      std::vector<const char*> m_values;
+      //! Displacement (hash seed) of each bucket.
+      std::vector<uint32_t> m_displacements;
+      //! Message index of each slot (-1 if empty).
+      std::vector<int32_t> m_slots;
+
+      //! Build the perfect hash table of the loaded messages.
+      //! @return true on success, false if no displacements were
+      //! found for the current table size.
+      bool
+      build(void);
+
+      //! Hash a message.
+      //! @param[in] seed hash seed.
+      //! @param[in] str message.
+      //! @return hash value.
+      static uint32_t
+      hash(uint32_t seed, const char* str);
+    };
+  }
+}
+
+#endif
@@ -220,29 +220,58 @@ namespace DUNE
       return false;
     }
 
+    //! Convert a field in the format [d]ddmm.mmmm to decimal degrees.
+    static void
+    parseCoordinateField(const StringView& field, double& var, double def)
+    {
+      size_t dot = field.find('.');
+      double minutes = 0;
+      uint8_t degrees = 0;
+
+      if (dot == StringView::npos || dot < 2
+          || !field.substr(0, dot - 2).toNumber(degrees)
+          || !field.substr(dot - 2).toNumber(minutes))
+      {
+        var = def;
+        return;
+      }
+
+      var = DUNE::Math::Angles::convertDMSToDecimal(degrees, minutes);
+    }
+
     bool
     NMEAParser::parseGGA(NMEASentence& sentence)
     {
-      std::vector<std::string> tokens;
-      String::split(m_data, ",", tokens);
+      StringView parts[14];
+      Tokenizer tokenizer(m_data, ',');
 
-      if (tokens.size() != 14)
+      if (tokenizer.split(parts, 14) != 14)
         return false;
 
+      NMEASentence::SentenceData::GGA& gga = sentence.data.gga;
       sentence.type = GGA;
-      parseUTCTime(tokens[0].c_str(), sentence.data.gga.utc_time, -1.0);
-      parseCoordinate(tokens[1].c_str(), sentence.data.gga.latitude, 0.0);
-      if (tokens[2] == "S")
-        sentence.data.gga.latitude *= -1.0;
-      parseCoordinate(tokens[3].c_str(), sentence.data.gga.longitude, 0.0);
-      if (tokens[4] == "W")
-        sentence.data.gga.longitude *= -1.0;
-      parseInteger(tokens[5].c_str(), sentence.data.gga.fix_quality);
-      parseInteger(tokens[6].c_str(), sentence.data.gga.satellites);
-      parseDouble(tokens[7].c_str(), sentence.data.gga.hdop);
-      parseDouble(tokens[8].c_str(), sentence.data.gga.altitude);
-      parseDouble(tokens[10].c_str(), sentence.data.gga.geoid_height);
-      parseInteger(tokens[13].c_str(), sentence.data.gga.diff_station);
+      if (parts[0].size() < 6)
+        gga.utc_time = -1.0;
+      else
+        parseUTCTime(parts[0].data(), gga.utc_time, -1.0);
+      parseCoordinateField(parts[1], gga.latitude, 0.0);
+      if (parts[2] == "S")
+        gga.latitude *= -1.0;
+      parseCoordinateField(parts[3], gga.longitude, 0.0);
+      if (parts[4] == "W")
+        gga.longitude *= -1.0;
+      if (!parts[5].toNumber(gga.fix_quality))
+        gga.fix_quality = -1;
+      if (!parts[6].toNumber(gga.satellites))
+        gga.satellites = -1;
+      if (!parts[7].toNumber(gga.hdop))
+        gga.hdop = -1;
+      if (!parts[8].toNumber(gga.altitude))
+        gga.altitude = -1;
+      if (!parts[10].toNumber(gga.geoid_height))
+        gga.geoid_height = -1;
+      if (!parts[13].toNumber(gga.diff_station))
+        gga.diff_station = -1;
 
       return true;
     }
@@ -257,5 +286,44 @@ namespace DUNE
       std::sscanf(bfr + bfr_len - 2, "%02X", &received);
       return received == Algorithms::XORChecksum::compute((const uint8_t*)bfr + 1, bfr_len - 4);
     }
+
+    bool
+    NMEAParser::validate(const StringView& line, StringView& body)
+    {
+      size_t start = line.find('$');
+      if (start == StringView::npos)
+        return false;
+
+      uint8_t csum = 0;
+      size_t i = start + 1;
+      for (; i < line.size() && line[i] != '*'; ++i)
+        csum ^= (uint8_t)line[i];
+
+      // Need '*' followed by two hexadecimal digits.
+      if (i + 2 >= line.size())
+        return false;
+
+      unsigned received = 0;
+      for (size_t j = i + 1; j <= i + 2; ++j)
+      {
+        char c = line[j];
+        received <<= 4;
+
+        if (c >= '0' && c <= '9')
+          received |= c - '0';
+        else if (c >= 'A' && c <= 'F')
+          received |= c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f')
+          received |= c - 'a' + 10;
+        else
+          return false;
+      }
+
+      if (received != csum)
+        return false;
+
+      body = line.substr(start + 1, i - start - 1);
+      return true;
+    }
   }
 }
@@ -30,6 +30,7 @@
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
+#include <DUNE/Utils/StringView.hpp>
 #include <string>
 
 namespace DUNE
@@ -156,6 +157,15 @@ namespace DUNE
       static bool
       validateChecksum(const char* bfr, int bfr_len);
 
+      //! Validate an NMEA sentence in a single pass. Characters
+      //! before the '$' and after the checksum are ignored.
+      //! @param[in] line sentence.
+      //! @param[out] body characters between '$' and '*'.
+      //! @return true if the sentence is complete and the checksum
+      //! matches, false otherwise.
+      static bool
+      validate(const StringView& line, StringView& body);
+
     private:
       enum State
       {
@@ -36,6 +36,14 @@
 #include <DUNE/Math/General.hpp>
 #include <DUNE/Utils/RawFifo.hpp>
 
+//! Order accesses to the data with accesses to the indexes, so that
+//! one writer and one reader can share the FIFO without locks.
+#if defined(DUNE_SYS_HAS___SYNC_SYNCHRONIZE)
+#  define DUNE_RAW_FIFO_BARRIER() __sync_synchronize()
+#else
+#  define DUNE_RAW_FIFO_BARRIER()
+#endif
+
 namespace DUNE
 {
   namespace Utils
@@ -66,6 +74,8 @@ namespace DUNE
     {
       uint32_t l = 0;
 
+      // Make sure the reader released the space before reusing it.
+      DUNE_RAW_FIFO_BARRIER();
       len = std::min(len, m_size - m_in + m_out);
 
       // Put the data into "m_data", starting from "m_in" to the end.
@@ -75,6 +85,8 @@ namespace DUNE
       // Put the rest (if any) at the beginning of "m_data".
       std::memcpy(m_data, buffer + l, len - l);
 
+      // Publish the data before the new index.
+      DUNE_RAW_FIFO_BARRIER();
       m_in += len;
 
       return len;
@@ -86,6 +98,8 @@ namespace DUNE
       uint32_t l = 0;
 
       len = std::min(len, m_in - m_out);
+      // Read the data only after the index that published it.
+      DUNE_RAW_FIFO_BARRIER();
 
       // Get the data from "m_data", starting from "m_out" until the end.
       l = std::min(len, m_size - (m_out & (m_size - 1)));
@@ -94,6 +108,8 @@ namespace DUNE
       // Get the rest (if any) from the beginning of "m_data"
       std::memcpy(buffer + l, m_data, len - l);
 
+      // Finish reading before the writer may reuse the space.
+      DUNE_RAW_FIFO_BARRIER();
       return len;
     }
 
@@ -116,9 +116,9 @@ namespace DUNE
       //! Size of the internal buffer.
       uint32_t m_size;
       //! Data is inserted at offset (m_in % m_size).
-      uint32_t m_in;
+      volatile uint32_t m_in;
       //! Data is retrieved from offset (m_out % m_size).
-      uint32_t m_out;
+      volatile uint32_t m_out;
     };
   }
 }
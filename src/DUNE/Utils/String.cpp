@@ -32,6 +32,7 @@
 
 // Local headers.
 #include <DUNE/Utils/String.hpp>
+#include <DUNE/Utils/StringView.hpp>
 
 namespace DUNE
 {
@@ -100,20 +101,17 @@ namespace DUNE
     std::string
     String::trim(const std::string& s)
     {
-      std::string n = ltrim(s);
-
-      return rtrim(n);
+      return StringView(s).trim().str();
     }
 
-    // FIXME: quick hack to preserve white spaces when converting to std::string
     void
     String::split(const std::string& s, const std::string& sep, std::vector<std::string>& lst)
     {
       size_t new_i = 0; // new index
       size_t old_i = 0; // old index
-      std::string d;
+      StringView view(s);
 
-      if (trim(s) == "")
+      if (view.trim().empty())
         return;
 
       while (1)
@@ -121,11 +119,7 @@ namespace DUNE
         // Find next separator character
         new_i = s.find(sep, old_i);
 
-        std::stringstream sin(trim(s.substr(old_i, new_i - old_i)));
-
-        d = sin.str();
-
-        lst.push_back(d);
+        lst.push_back(view.substr(old_i, new_i - old_i).trim().str());
 
         if (new_i == std::string::npos)
           break;
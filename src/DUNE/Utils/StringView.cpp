@@ -0,0 +1,278 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Utils/StringView.hpp>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    //! Exact powers of ten.
+    static const double c_pow10[] =
+    {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+      1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18
+    };
+    //! Maximum number of significant digits converted without strtod().
+    static const int c_max_digits = 15;
+    //! Maximum size of numbers handed to strtod().
+    static const size_t c_max_number_size = 64;
+
+    static inline bool
+    isDigit(char c)
+    {
+      return c >= '0' && c <= '9';
+    }
+
+    //! Parse a floating point number with strtod().
+    static const char*
+    parseSlow(const char* first, const char* last, double& value)
+    {
+      char bfr[c_max_number_size];
+      size_t size = last - first;
+      if (size > sizeof(bfr) - 1)
+        size = sizeof(bfr) - 1;
+
+      std::memcpy(bfr, first, size);
+      bfr[size] = 0;
+
+      char* end = NULL;
+      double tmp = std::strtod(bfr, &end);
+      if (end == bfr)
+        return NULL;
+
+      value = tmp;
+      return first + (end - bfr);
+    }
+
+    const char*
+    StringView::parse(const char* first, const char* last, long& value)
+    {
+      const char* ptr = first;
+      bool negative = false;
+
+      if (ptr < last && (*ptr == '-' || *ptr == '+'))
+      {
+        negative = (*ptr == '-');
+        ++ptr;
+      }
+
+      unsigned long limit = negative ? (unsigned long)LONG_MAX + 1 : (unsigned long)LONG_MAX;
+      unsigned long result = 0;
+      const char* digits = ptr;
+
+      for (; ptr < last && isDigit(*ptr); ++ptr)
+      {
+        unsigned digit = *ptr - '0';
+        if (result > (limit - digit) / 10)
+          return NULL;
+
+        result = result * 10 + digit;
+      }
+
+      if (ptr == digits)
+        return NULL;
+
+      value = negative ? (long)(0 - result) : (long)result;
+      return ptr;
+    }
+
+    const char*
+    StringView::parse(const char* first, const char* last, unsigned long& value)
+    {
+      const char* ptr = first;
+
+      if (ptr < last && *ptr == '+')
+        ++ptr;
+
+      unsigned long result = 0;
+      const char* digits = ptr;
+
+      for (; ptr < last && isDigit(*ptr); ++ptr)
+      {
+        unsigned digit = *ptr - '0';
+        if (result > (ULONG_MAX - digit) / 10)
+          return NULL;
+
+        result = result * 10 + digit;
+      }
+
+      if (ptr == digits)
+        return NULL;
+
+      value = result;
+      return ptr;
+    }
+
+    const char*
+    StringView::parse(const char* first, const char* last, double& value)
+    {
+      const char* ptr = first;
+      bool negative = false;
+
+      if (ptr < last && (*ptr == '-' || *ptr == '+'))
+      {
+        negative = (*ptr == '-');
+        ++ptr;
+      }
+
+      // Accumulate the digits as an integer mantissa. Both the
+      // mantissa and the power of ten are exact, so the division
+      // below is correctly rounded.
+      uint64_t mantissa = 0;
+      int significant = 0;
+      int scale = 0;
+      bool any = false;
+
+      for (; ptr < last && isDigit(*ptr); ++ptr)
+      {
+        mantissa = mantissa * 10 + (*ptr - '0');
+        if (mantissa != 0 && ++significant > c_max_digits)
+          return parseSlow(first, last, value);
+        any = true;
+      }
+
+      if (ptr < last && *ptr == '.')
+      {
+        for (++ptr; ptr < last && isDigit(*ptr); ++ptr)
+        {
+          mantissa = mantissa * 10 + (*ptr - '0');
+          if (mantissa != 0 && ++significant > c_max_digits)
+            return parseSlow(first, last, value);
+          ++scale;
+          any = true;
+        }
+      }
+
+      // Exponents, infinities and other forms.
+      if (!any || (ptr < last && (*ptr == 'e' || *ptr == 'E'))
+          || scale >= (int)(sizeof(c_pow10) / sizeof(c_pow10[0])))
+        return parseSlow(first, last, value);
+
+      double result = (double)mantissa / c_pow10[scale];
+      value = negative ? -result : result;
+      return ptr;
+    }
+
+    template <typename T>
+    bool
+    StringView::toSigned(T& value, long min, long max) const
+    {
+      StringView view = trim();
+      const char* last = view.m_data + view.m_size;
+      long tmp = 0;
+
+      if (parse(view.m_data, last, tmp) != last || tmp < min || tmp > max)
+        return false;
+
+      value = static_cast<T>(tmp);
+      return true;
+    }
+
+    template <typename T>
+    bool
+    StringView::toUnsigned(T& value, unsigned long max) const
+    {
+      StringView view = trim();
+      const char* last = view.m_data + view.m_size;
+      unsigned long tmp = 0;
+
+      if (parse(view.m_data, last, tmp) != last || tmp > max)
+        return false;
+
+      value = static_cast<T>(tmp);
+      return true;
+    }
+
+    bool
+    StringView::toNumber(int8_t& value) const
+    {
+      return toSigned(value, INT8_MIN, INT8_MAX);
+    }
+
+    bool
+    StringView::toNumber(uint8_t& value) const
+    {
+      return toUnsigned(value, UINT8_MAX);
+    }
+
+    bool
+    StringView::toNumber(int16_t& value) const
+    {
+      return toSigned(value, INT16_MIN, INT16_MAX);
+    }
+
+    bool
+    StringView::toNumber(uint16_t& value) const
+    {
+      return toUnsigned(value, UINT16_MAX);
+    }
+
+    bool
+    StringView::toNumber(int32_t& value) const
+    {
+      return toSigned(value, INT32_MIN, INT32_MAX);
+    }
+
+    bool
+    StringView::toNumber(uint32_t& value) const
+    {
+      return toUnsigned(value, UINT32_MAX);
+    }
+
+    bool
+    StringView::toNumber(float& value) const
+    {
+      double tmp = 0;
+      if (!toNumber(tmp))
+        return false;
+
+      value = static_cast<float>(tmp);
+      return true;
+    }
+
+    bool
+    StringView::toNumber(double& value) const
+    {
+      StringView view = trim();
+      const char* last = view.m_data + view.m_size;
+      double tmp = 0;
+
+      if (parse(view.m_data, last, tmp) != last)
+        return false;
+
+      value = tmp;
+      return true;
+    }
+  }
+}
@@ -0,0 +1,358 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_UTILS_STRING_VIEW_HPP_INCLUDED_
+#define DUNE_UTILS_STRING_VIEW_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM StringView;
+
+    //! Non-owning reference to a sequence of characters. Views are
+    //! only valid while the referenced characters exist and are not
+    //! modified. They are meant for parsing without copying, e.g.,
+    //! splitting a sentence into fields with Tokenizer and converting
+    //! the fields with toNumber().
+    class StringView
+    {
+    public:
+      //! Value returned by find() when a character is not found.
+      static const size_t npos = static_cast<size_t>(-1);
+
+      //! Construct an empty view.
+      StringView(void):
+        m_data(""),
+        m_size(0)
+      { }
+
+      //! Construct a view of a null-terminated string.
+      //! @param[in] str string.
+      StringView(const char* str):
+        m_data(str),
+        m_size(std::strlen(str))
+      { }
+
+      //! Construct a view of a sequence of characters.
+      //! @param[in] data first character.
+      //! @param[in] size number of characters.
+      StringView(const char* data, size_t size):
+        m_data(data),
+        m_size(size)
+      { }
+
+      //! Construct a view of a string.
+      //! @param[in] str string.
+      StringView(const std::string& str):
+        m_data(str.data()),
+        m_size(str.size())
+      { }
+
+      const char*
+      data(void) const
+      {
+        return m_data;
+      }
+
+      size_t
+      size(void) const
+      {
+        return m_size;
+      }
+
+      bool
+      empty(void) const
+      {
+        return m_size == 0;
+      }
+
+      char
+      operator[](size_t index) const
+      {
+        return m_data[index];
+      }
+
+      bool
+      operator==(const StringView& other) const
+      {
+        return m_size == other.m_size && std::memcmp(m_data, other.m_data, m_size) == 0;
+      }
+
+      bool
+      operator!=(const StringView& other) const
+      {
+        return !(*this == other);
+      }
+
+      bool
+      operator==(const char* str) const
+      {
+        return *this == StringView(str);
+      }
+
+      bool
+      operator!=(const char* str) const
+      {
+        return !(*this == StringView(str));
+      }
+
+      bool
+      operator==(const std::string& str) const
+      {
+        return *this == StringView(str);
+      }
+
+      bool
+      operator!=(const std::string& str) const
+      {
+        return !(*this == StringView(str));
+      }
+
+      //! Find the first occurrence of a character.
+      //! @param[in] c character.
+      //! @param[in] pos index of the first character to search.
+      //! @return index of the character or npos.
+      size_t
+      find(char c, size_t pos = 0) const
+      {
+        for (size_t i = pos; i < m_size; ++i)
+        {
+          if (m_data[i] == c)
+            return i;
+        }
+
+        return npos;
+      }
+
+      //! Retrieve part of the view.
+      //! @param[in] pos index of the first character.
+      //! @param[in] count maximum number of characters.
+      //! @return view of the characters.
+      StringView
+      substr(size_t pos, size_t count = npos) const
+      {
+        if (pos > m_size)
+          pos = m_size;
+
+        if (count > m_size - pos)
+          count = m_size - pos;
+
+        return StringView(m_data + pos, count);
+      }
+
+      //! Retrieve the view without leading and trailing blanks.
+      //! @return trimmed view.
+      StringView
+      trim(void) const
+      {
+        size_t first = 0;
+        size_t last = m_size;
+
+        while (first < last && isBlank(m_data[first]))
+          ++first;
+
+        while (last > first && isBlank(m_data[last - 1]))
+          --last;
+
+        return StringView(m_data + first, last - first);
+      }
+
+      //! Copy the characters to a string.
+      //! @return string.
+      std::string
+      str(void) const
+      {
+        return std::string(m_data, m_size);
+      }
+
+      //! Convert the whole view to a number. Leading and trailing
+      //! blanks are ignored.
+      //! @param[out] value converted value, unchanged on failure.
+      //! @return true if the view holds a number that fits the type,
+      //! false otherwise.
+      bool
+      toNumber(int8_t& value) const;
+
+      bool
+      toNumber(uint8_t& value) const;
+
+      bool
+      toNumber(int16_t& value) const;
+
+      bool
+      toNumber(uint16_t& value) const;
+
+      bool
+      toNumber(int32_t& value) const;
+
+      bool
+      toNumber(uint32_t& value) const;
+
+      bool
+      toNumber(float& value) const;
+
+      bool
+      toNumber(double& value) const;
+
+      //! Parse an integer from the start of a sequence of characters
+      //! (similar to C++17 std::from_chars).
+      //! @param[in] first first character.
+      //! @param[in] last one past the last character.
+      //! @param[out] value parsed value.
+      //! @return one past the last character parsed or NULL if there
+      //! is no number or it overflows.
+      static const char*
+      parse(const char* first, const char* last, long& value);
+
+      //! Parse an unsigned integer from the start of a sequence of
+      //! characters. A minus sign is not accepted.
+      //! @param[in] first first character.
+      //! @param[in] last one past the last character.
+      //! @param[out] value parsed value.
+      //! @return one past the last character parsed or NULL if there
+      //! is no number or it overflows.
+      static const char*
+      parse(const char* first, const char* last, unsigned long& value);
+
+      //! Parse a floating point number from the start of a sequence of
+      //! characters. Plain decimal numbers are converted without
+      //! calling the C library, other forms fall back to strtod().
+      //! @param[in] first first character.
+      //! @param[in] last one past the last character.
+      //! @param[out] value parsed value.
+      //! @return one past the last character parsed or NULL if there
+      //! is no number.
+      static const char*
+      parse(const char* first, const char* last, double& value);
+
+    private:
+      //! First character.
+      const char* m_data;
+      //! Number of characters.
+      size_t m_size;
+
+      static bool
+      isBlank(char c)
+      {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+      }
+
+      template <typename T>
+      bool
+      toSigned(T& value, long min, long max) const;
+
+      template <typename T>
+      bool
+      toUnsigned(T& value, unsigned long max) const;
+    };
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM Tokenizer;
+
+    //! Split a string into fields separated by a character without
+    //! allocating memory. Empty fields are returned, so "a,,b" has
+    //! three fields.
+    class Tokenizer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] str string to split.
+      //! @param[in] separator field separator.
+      Tokenizer(const StringView& str, char separator):
+        m_str(str),
+        m_separator(separator),
+        m_pos(0),
+        m_done(false)
+      { }
+
+      //! Retrieve the next field.
+      //! @param[out] field next field.
+      //! @return true if a field was retrieved, false if there are
+      //! no more fields.
+      bool
+      next(StringView& field)
+      {
+        if (m_done)
+          return false;
+
+        size_t end = m_str.find(m_separator, m_pos);
+        if (end == StringView::npos)
+        {
+          end = m_str.size();
+          m_done = true;
+        }
+
+        field = m_str.substr(m_pos, end - m_pos);
+        m_pos = end + 1;
+        return true;
+      }
+
+      //! Retrieve all remaining fields.
+      //! @param[out] fields output array.
+      //! @param[in] max maximum number of fields to store.
+      //! @return number of remaining fields, which may be larger
+      //! than max (extra fields are not stored).
+      unsigned
+      split(StringView* fields, unsigned max)
+      {
+        unsigned count = 0;
+        StringView field;
+
+        while (next(field))
+        {
+          if (count < max)
+            fields[count] = field;
+          ++count;
+        }
+
+        return count;
+      }
+
+    private:
+      //! String to split.
+      StringView m_str;
+      //! Field separator.
+      char m_separator;
+      //! Start of the next field.
+      size_t m_pos;
+      //! True if the last field was retrieved.
+      bool m_done;
+    };
+  }
+}
+
+#endif
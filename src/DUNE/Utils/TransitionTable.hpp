@@ -0,0 +1,172 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_UTILS_TRANSITION_TABLE_HPP_INCLUDED_
+#define DUNE_UTILS_TRANSITION_TABLE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    //! Table-driven state machine. States are small integers and
+    //! transitions are rows of a static table, each with a guard and
+    //! an optional action, both instance methods of the owner object:
+    //!
+    //! @code
+    //! static const Table::Transition c_table[] =
+    //! {
+    //!   {STATE_IDLE, &Task::canStart, &Task::onStart, STATE_RUNNING},
+    //!   {STATE_RUNNING, &Task::isDone, NULL, STATE_IDLE}
+    //! };
+    //! @endcode
+    //!
+    //! The table is indexed by source state once at construction,
+    //! so each step only evaluates the guards of the current state,
+    //! in table order. The first guard that holds fires its
+    //! transition.
+    //!
+    //! @tparam Class owner of the guards and actions.
+    //! @tparam c_states number of states.
+    template <typename Class, unsigned c_states>
+    class TransitionTable
+    {
+    public:
+      //! Transition guard.
+      typedef bool (Class::* Guard)(void);
+      //! Transition action.
+      typedef void (Class::* Action)(void);
+
+      //! Transition row.
+      struct Transition
+      {
+        //! Source state.
+        unsigned from;
+        //! Guard, NULL to always fire.
+        Guard guard;
+        //! Action to run when firing, may be NULL.
+        Action action;
+        //! Destination state.
+        unsigned to;
+      };
+
+      //! Constructor.
+      //! @param[in] table transition table.
+      //! @param[in] size number of rows of the table.
+      //! @param[in] initial initial state.
+      TransitionTable(const Transition* table, size_t size, unsigned initial):
+        m_table(table),
+        m_size(size),
+        m_state(initial)
+      {
+        // Count the rows of each state, then turn the counts into
+        // offsets of a table of row indices sorted by state.
+        for (unsigned i = 0; i <= c_states; ++i)
+          m_first[i] = 0;
+
+        for (size_t i = 0; i < m_size && i < c_max_rows; ++i)
+        {
+          if (m_table[i].from < c_states)
+            ++m_first[m_table[i].from + 1];
+        }
+
+        for (unsigned i = 0; i < c_states; ++i)
+          m_first[i + 1] += m_first[i];
+
+        unsigned fill[c_states];
+        for (unsigned i = 0; i < c_states; ++i)
+          fill[i] = m_first[i];
+
+        for (size_t i = 0; i < m_size && i < c_max_rows; ++i)
+        {
+          if (m_table[i].from < c_states)
+            m_rows[fill[m_table[i].from]++] = (unsigned)i;
+        }
+      }
+
+      //! Evaluate the transitions of the current state and fire the
+      //! first whose guard holds.
+      //! @param[in] obj owner object.
+      //! @return true if a transition fired, false otherwise.
+      bool
+      step(Class& obj)
+      {
+        for (unsigned i = m_first[m_state]; i < m_first[m_state + 1]; ++i)
+        {
+          const Transition& t = m_table[m_rows[i]];
+
+          if (t.guard && !(obj.*t.guard)())
+            continue;
+
+          m_state = t.to;
+
+          if (t.action)
+            (obj.*t.action)();
+
+          return true;
+        }
+
+        return false;
+      }
+
+      //! Get current state.
+      //! @return current state.
+      unsigned
+      current(void) const
+      {
+        return m_state;
+      }
+
+      //! Reset to given state.
+      //! @param[in] state state to set.
+      void
+      reset(unsigned state)
+      {
+        m_state = state;
+      }
+
+    private:
+      //! Maximum number of rows of a table.
+      static const unsigned c_max_rows = 32;
+
+      //! Transition table.
+      const Transition* m_table;
+      //! Number of rows.
+      size_t m_size;
+      //! Current state.
+      unsigned m_state;
+      //! Offset of the first row index of each state.
+      unsigned m_first[c_states + 1];
+      //! Row indices sorted by state.
+      unsigned m_rows[c_max_rows];
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,362 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdlib>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Utils/Exceptions.hpp>
+#include <DUNE/Utils/XMLReader.hpp>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    //! Blank characters.
+    static const char* c_blanks = " \t\r\n";
+    //! Size of the chunks read from streams.
+    static const size_t c_chunk_size = 4096;
+
+    //! Replace the predefined and numeric entities of a string.
+    //! @param[in] str string.
+    //! @return string without entities.
+    static std::string
+    unescape(const std::string& str)
+    {
+      static const char* c_entities[][2] =
+      {
+        {"&amp;", "&"},
+        {"&lt;", "<"},
+        {"&gt;", ">"},
+        {"&quot;", "\""},
+        {"&apos;", "'"}
+      };
+
+      size_t amp = str.find('&');
+      if (amp == std::string::npos)
+        return str;
+
+      std::string rv;
+      size_t pos = 0;
+
+      while (true)
+      {
+        rv.append(str, pos, amp - pos);
+        if (amp == std::string::npos)
+          break;
+
+        pos = amp + 1;
+        rv.push_back('&');
+
+        if (str.compare(amp, 2, "&#") == 0)
+        {
+          size_t semi = str.find(';', amp);
+          if (semi != std::string::npos)
+          {
+            bool hex = (amp + 2 < semi && (str[amp + 2] == 'x' || str[amp + 2] == 'X'));
+            const char* first = str.c_str() + amp + (hex ? 3 : 2);
+            char* end = NULL;
+            unsigned long code = std::strtoul(first, &end, hex ? 16 : 10);
+
+            // Only ASCII characters are replaced.
+            if (end == str.c_str() + semi && end != first && code > 0 && code < 0x80)
+            {
+              rv[rv.size() - 1] = (char)code;
+              pos = semi + 1;
+            }
+          }
+        }
+        else
+        {
+          for (unsigned i = 0; i < sizeof(c_entities) / sizeof(c_entities[0]); ++i)
+          {
+            if (str.compare(amp, std::strlen(c_entities[i][0]), c_entities[i][0]) == 0)
+            {
+              rv[rv.size() - 1] = c_entities[i][1][0];
+              pos = amp + std::strlen(c_entities[i][0]);
+              break;
+            }
+          }
+        }
+
+        amp = str.find('&', pos);
+      }
+
+      return rv;
+    }
+
+    //! Check if a character is blank.
+    static inline bool
+    isBlank(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    XMLReader::XMLReader(Handler& handler):
+      m_handler(handler),
+      m_state(ST_TEXT),
+      m_quote(0),
+      m_done(false)
+    { }
+
+    void
+    XMLReader::feed(const char* data, size_t size)
+    {
+      const char* last = data + size;
+
+      for (const char* ptr = data; ptr < last; ++ptr)
+      {
+        switch (m_state)
+        {
+          case ST_TEXT:
+          {
+            const char* lt = (const char*)std::memchr(ptr, '<', last - ptr);
+            if (lt == NULL)
+            {
+              m_text.append(ptr, last - ptr);
+              return;
+            }
+
+            m_text.append(ptr, lt - ptr);
+            ptr = lt;
+            m_tag.clear();
+            m_quote = 0;
+            m_state = ST_TAG;
+            break;
+          }
+
+          case ST_TAG:
+            if (m_quote != 0)
+            {
+              if (*ptr == m_quote)
+                m_quote = 0;
+              m_tag.push_back(*ptr);
+            }
+            else if (*ptr == '>')
+            {
+              m_state = ST_TEXT;
+              onTag();
+            }
+            else
+            {
+              m_tag.push_back(*ptr);
+
+              if (m_tag.size() == 3 && m_tag == "!--")
+              {
+                m_tag.clear();
+                m_state = ST_COMMENT;
+              }
+              else if (m_tag.size() == 8 && m_tag == "![CDATA[")
+              {
+                flushText();
+                m_state = ST_CDATA;
+              }
+              else if (*ptr == '"' || *ptr == '\'')
+              {
+                m_quote = *ptr;
+              }
+            }
+            break;
+
+          case ST_COMMENT:
+            // Only the last two characters are needed to find "-->".
+            if (*ptr == '>' && m_tag == "--")
+            {
+              m_state = ST_TEXT;
+              break;
+            }
+
+            if (m_tag.size() == 2)
+              m_tag.erase(0, 1);
+            m_tag.push_back(*ptr);
+            break;
+
+          case ST_CDATA:
+            if (*ptr == '>' && m_text.size() >= 2 && m_text.compare(m_text.size() - 2, 2, "]]") == 0)
+            {
+              m_text.resize(m_text.size() - 2);
+              if (!m_open.empty())
+                m_handler.onText(m_text);
+              m_text.clear();
+              m_state = ST_TEXT;
+              break;
+            }
+
+            m_text.push_back(*ptr);
+            break;
+        }
+      }
+    }
+
+    void
+    XMLReader::finish(void)
+    {
+      if (m_state != ST_TEXT)
+        throw ParseError("XML", "unexpected end of document");
+
+      if (!m_open.empty())
+        throw ParseError("XML", "element '" + m_open.back() + "' is not closed");
+
+      if (!m_done)
+        throw ParseError("XML", "no root element");
+    }
+
+    void
+    XMLReader::read(std::istream& is)
+    {
+      char bfr[c_chunk_size];
+
+      while (true)
+      {
+        is.read(bfr, sizeof(bfr));
+        // Compressed streams report a negative count at the end.
+        std::streamsize rv = is.gcount();
+        if (rv <= 0)
+          break;
+        feed(bfr, (size_t)rv);
+      }
+
+      finish();
+    }
+
+    std::string
+    XMLReader::getAttribute(const Attributes& attrs, const char* name)
+    {
+      for (size_t i = 0; i < attrs.size(); ++i)
+      {
+        if (attrs[i].first == name)
+          return attrs[i].second;
+      }
+
+      return std::string();
+    }
+
+    void
+    XMLReader::onTag(void)
+    {
+      if (m_tag.empty())
+        throw ParseError("XML", "empty tag");
+
+      // Processing instructions and declarations.
+      if (m_tag[0] == '?' || m_tag[0] == '!')
+        return;
+
+      flushText();
+
+      if (m_tag[0] == '/')
+      {
+        size_t end = m_tag.find_last_not_of(c_blanks);
+        std::string name = m_tag.substr(1, end);
+
+        if (m_open.empty() || m_open.back() != name)
+          throw ParseError("XML", "unexpected closing tag '" + name + "'");
+
+        m_open.pop_back();
+        m_done = m_open.empty();
+        m_handler.onEndElement(name);
+        return;
+      }
+
+      if (m_done)
+        throw ParseError("XML", "more than one root element");
+
+      bool empty = (m_tag[m_tag.size() - 1] == '/');
+      size_t end = m_tag.size() - (empty ? 1 : 0);
+      size_t name_end = m_tag.find_first_of(" \t\r\n/");
+      if (name_end == std::string::npos || name_end > end)
+        name_end = end;
+
+      std::string name = m_tag.substr(0, name_end);
+      if (name.empty())
+        throw ParseError("XML", "element without name");
+
+      parseAttributes(name_end, end);
+      m_handler.onStartElement(name, m_attrs);
+
+      if (empty)
+      {
+        m_done = m_open.empty();
+        m_handler.onEndElement(name);
+      }
+      else
+      {
+        m_open.push_back(name);
+      }
+    }
+
+    void
+    XMLReader::flushText(void)
+    {
+      if (m_text.empty())
+        return;
+
+      if (!m_open.empty())
+        m_handler.onText(unescape(m_text));
+
+      m_text.clear();
+    }
+
+    void
+    XMLReader::parseAttributes(size_t pos, size_t end)
+    {
+      m_attrs.clear();
+
+      while (true)
+      {
+        while (pos < end && isBlank(m_tag[pos]))
+          ++pos;
+
+        if (pos >= end)
+          break;
+
+        size_t eq = m_tag.find('=', pos);
+        if (eq == std::string::npos || eq >= end)
+          throw ParseError("XML", "malformed attribute in '" + m_tag + "'");
+
+        size_t name_end = eq;
+        while (name_end > pos && isBlank(m_tag[name_end - 1]))
+          --name_end;
+
+        size_t quote = eq + 1;
+        while (quote < end && isBlank(m_tag[quote]))
+          ++quote;
+
+        if (name_end == pos || quote >= end || (m_tag[quote] != '"' && m_tag[quote] != '\''))
+          throw ParseError("XML", "malformed attribute in '" + m_tag + "'");
+
+        size_t close = m_tag.find(m_tag[quote], quote + 1);
+        if (close == std::string::npos || close >= end)
+          throw ParseError("XML", "unterminated attribute in '" + m_tag + "'");
+
+        m_attrs.push_back(std::make_pair(m_tag.substr(pos, name_end - pos),
+                                         unescape(m_tag.substr(quote + 1, close - quote - 1))));
+        pos = close + 1;
+      }
+    }
+  }
+}
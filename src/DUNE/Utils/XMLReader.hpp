@@ -0,0 +1,158 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_UTILS_XML_READER_HPP_INCLUDED_
+#define DUNE_UTILS_XML_READER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Utils
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM XMLReader;
+
+    //! Event driven (SAX style) XML parser. The document is fed in
+    //! chunks of any size and the handler is called as elements
+    //! start and end, so only the tag being parsed is kept in
+    //! memory. Comments, processing instructions and DOCTYPE
+    //! declarations are skipped; the predefined entities are
+    //! replaced in attribute values and text. Malformed documents
+    //! raise Utils::ParseError.
+    class XMLReader
+    {
+    public:
+      //! Element attributes, in document order.
+      typedef std::vector<std::pair<std::string, std::string> > Attributes;
+
+      //! Receiver of parsing events.
+      class Handler
+      {
+      public:
+        virtual
+        ~Handler(void)
+        { }
+
+        //! Called at the start of an element.
+        //! @param[in] name element name.
+        //! @param[in] attrs element attributes.
+        virtual void
+        onStartElement(const std::string& name, const Attributes& attrs) = 0;
+
+        //! Called at the end of an element, including empty elements.
+        //! @param[in] name element name.
+        virtual void
+        onEndElement(const std::string& name) = 0;
+
+        //! Called with the character data between two tags.
+        //! @param[in] text character data.
+        virtual void
+        onText(const std::string& text)
+        {
+          (void)text;
+        }
+      };
+
+      //! Constructor.
+      //! @param[in] handler event handler.
+      XMLReader(Handler& handler);
+
+      //! Parse part of a document.
+      //! @param[in] data characters.
+      //! @param[in] size number of characters.
+      void
+      feed(const char* data, size_t size);
+
+      //! Signal the end of the document.
+      void
+      finish(void);
+
+      //! Parse a whole document read from a stream.
+      //! @param[in] is input stream.
+      void
+      read(std::istream& is);
+
+      //! Get an attribute value.
+      //! @param[in] attrs attributes.
+      //! @param[in] name attribute name.
+      //! @return attribute value (empty if missing).
+      static std::string
+      getAttribute(const Attributes& attrs, const char* name);
+
+    private:
+      //! Parser states.
+      enum State
+      {
+        //! Character data.
+        ST_TEXT,
+        //! Inside a tag.
+        ST_TAG,
+        //! Inside a comment.
+        ST_COMMENT,
+        //! Inside a CDATA section.
+        ST_CDATA
+      };
+
+      //! Event handler.
+      Handler& m_handler;
+      //! Current state.
+      State m_state;
+      //! Pending character data.
+      std::string m_text;
+      //! Contents of the current tag.
+      std::string m_tag;
+      //! Quote character of the current attribute value (0 if none).
+      char m_quote;
+      //! Names of the open elements.
+      std::vector<std::string> m_open;
+      //! Attributes of the current tag (reused).
+      Attributes m_attrs;
+      //! True after the root element was closed.
+      bool m_done;
+
+      void
+      onTag(void);
+
+      void
+      flushText(void);
+
+      void
+      parseAttributes(size_t pos, size_t end);
+    };
+  }
+}
+
+#endif
@@ -26,11 +26,13 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <stack>
 
 // DUNE headers.
@@ -69,6 +71,10 @@ using DUNE_NAMESPACES;
 static bool s_stop = false;
 static const unsigned c_max_restarts = 5;
 static const double c_restart_period = 30.0;
+//! True if the message trace should be dumped.
+static volatile bool s_dump_trace = false;
+//! File where the message trace is dumped on crash.
+static char s_trace_crash_file[512] = {0};
 
 // POSIX implementation.
 #if defined(DUNE_OS_POSIX)
@@ -81,9 +87,22 @@ handleTerminate(int signo)
     case SIGTERM:
       s_stop = true;
       break;
+    case SIGUSR1:
+      s_dump_trace = true;
+      break;
   }
 }
 
+extern "C" void
+handleCrash(int signo)
+{
+  if (s_trace_crash_file[0] != 0)
+    IMC::dune_trace.dump(s_trace_crash_file);
+
+  // The default action was restored when the signal was delivered.
+  raise(signo);
+}
+
 // Microsoft Windows implementation.
 #elif defined(DUNE_OS_WINDOWS)
 BOOL
@@ -125,6 +144,16 @@ setDaemonSignalHandlers(void)
   sigaction(SIGCHLD, &actions, 0);
   sigaction(SIGCONT, &actions, 0);
   sigaction(SIGPIPE, &actions, 0);
+  sigaction(SIGUSR1, &actions, 0);
+
+  // Dump the message trace on crash.
+  actions.sa_handler = handleCrash;
+  actions.sa_flags = SA_RESETHAND;
+  sigaction(SIGSEGV, &actions, 0);
+  sigaction(SIGBUS, &actions, 0);
+  sigaction(SIGFPE, &actions, 0);
+  sigaction(SIGILL, &actions, 0);
+  sigaction(SIGABRT, &actions, 0);
 
   // Enable core dumps.
   struct rlimit rlim;
@@ -140,13 +169,42 @@ setDaemonSignalHandlers(void)
 #endif
 }
 
+//! Dump the message trace to a new file.
+//! @param[in] dir directory.
+static void
+dumpTrace(const Path& dir)
+{
+  try
+  {
+    dir.create();
+  }
+  catch (std::runtime_error& e)
+  {
+    (void)e;
+  }
+
+  Path file = dir / String::str("trace_%s_%s.dtrc", Format::getDateSafe().c_str(),
+                                Format::getTimeSafe().c_str());
+
+  if (IMC::dune_trace.dump(file.c_str()))
+    DUNE_MSG("Daemon", DTR("message trace written to ") << file);
+  else
+    DUNE_ERR("Daemon", DTR("failed to write message trace to ") << file);
+}
+
 int
-runDaemon(DUNE::Daemon& daemon)
+runDaemon(DUNE::Daemon& daemon, const Path& trace_dir)
 {
+  std::string crash_file = (trace_dir / "trace_crash.dtrc").str();
+  std::strncpy(s_trace_crash_file, crash_file.c_str(), sizeof(s_trace_crash_file) - 1);
+
   setDaemonSignalHandlers();
 
   bool call_abort = false;
 
+  // Task messages are written from a background thread from now on.
+  DUNE::Streams::dune_term.startAsync();
+
   try
   {
     daemon.start();
@@ -159,19 +217,28 @@ runDaemon(DUNE::Daemon& daemon)
         break;
       }
 
+      if (s_dump_trace)
+      {
+        s_dump_trace = false;
+        dumpTrace(trace_dir);
+      }
+
       Delay::wait(1.0);
     }
 
     DUNE_WRN("Daemon", DTR("stopping tasks"));
     daemon.stopAndJoin();
+    DUNE::Streams::dune_term.stopAsync();
   }
   catch (std::exception& e)
   {
+    DUNE::Streams::dune_term.stopAsync();
     DUNE_ERR("Daemon", e.what());
     return 1;
   }
   catch (...)
   {
+    DUNE::Streams::dune_term.stopAsync();
     DUNE_ERR("Daemon", DTR("unhandled exception"));
     return 1;
   }
@@ -210,7 +277,9 @@ main(int argc, char** argv)
   .add("-V", "--vehicle",
        "Vehicle name override", "VEHICLE")
   .add("-X", "--dump-params-xml",
-       "Dump parameters XML to folder DIR", "DIR");
+       "Dump parameters XML to folder DIR", "DIR")
+  .add("-n", "--no-config-cache",
+       "Always parse configuration files instead of using the cache");
 
   // Parse command line arguments.
   if (!options.parse(argc, argv))
@@ -221,6 +290,12 @@ main(int argc, char** argv)
     return 1;
   }
 
+#if defined(DUNE_USING_TLSF) && defined(DUNE_CLIB_GNU)
+  // Allow tasks to allocate from private heap arenas.
+  static TlsfArenaBackend arena_backend;
+  HeapArena::setBackend(&arena_backend);
+#endif
+
   // If requested, lock memory.
   if (!options.value("--lock-memory").empty())
   {
@@ -258,7 +333,27 @@ main(int argc, char** argv)
   Path cfg_file = context.dir_cfg / options.value("--config-file") + ".ini";
   try
   {
-    context.config.parseFile(cfg_file.c_str());
+    if (options.value("--no-config-cache").empty())
+    {
+      std::string name = options.value("--config-file");
+      std::replace(name.begin(), name.end(), '/', '_');
+
+      Path cache_dir = context.dir_db / "config";
+      try
+      {
+        cache_dir.create();
+      }
+      catch (std::runtime_error& e)
+      {
+        (void)e;
+      }
+
+      ConfigCache::load(cfg_file.str(), (cache_dir / name + ".cache").str(), context.config);
+    }
+    else
+    {
+      context.config.parseFile(cfg_file.c_str());
+    }
   }
   catch (std::runtime_error& e)
   {
@@ -290,7 +385,7 @@ main(int argc, char** argv)
       return 0;
     }
 
-    return runDaemon(daemon);
+    return runDaemon(daemon, context.dir_log);
   }
   catch (std::exception& e)
   {
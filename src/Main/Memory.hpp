@@ -30,31 +30,85 @@
 
 #if defined(DUNE_USING_TLSF) && defined(DUNE_CLIB_GNU)
 #  include <malloc.h>
+#  include <pthread.h>
 #  include <tlsf/tlsf.h>
+#  include <DUNE/System/HeapArena.hpp>
 
 #  if !defined(DUNE_MEMORY_SIZE)
 #    define DUNE_MEMORY_SIZE (16 * 1024 * 1024)
 #  endif
 
+#  if !defined(DUNE_MEMORY_ARENAS)
+#    define DUNE_MEMORY_ARENAS 64
+#  endif
+
 static const unsigned c_memory_size = DUNE_MEMORY_SIZE;
 static char c_memory[c_memory_size];
 
+//! Maximum number of task heap arenas.
+static const unsigned c_arena_max = DUNE_MEMORY_ARENAS;
+
+//! Task heap arena carved from the shared pool.
+struct TlsfArena
+{
+  //! First byte (also the TLSF pool handle, NULL if the slot is free).
+  char* volatile begin;
+  //! One past the last byte.
+  char* volatile end;
+  //! Bytes used by the empty pool.
+  size_t base;
+  //! True if the owner destroyed the arena.
+  bool released;
+};
+
+//! Task heap arenas. Entries are only appended, slots of arenas that
+//! were freed are reused.
+static TlsfArena c_arenas[c_arena_max];
+//! Number of valid entries in c_arenas.
+static volatile unsigned c_arena_count = 0;
+//! Serializes arena creation and destruction.
+static pthread_mutex_t c_arena_lock = PTHREAD_MUTEX_INITIALIZER;
+//! Pool used by allocations of the calling thread.
+static __thread void* t_pool = NULL;
+
+//! Find the pool that owns a block. Blocks are released to the pool
+//! they came from, whichever thread frees them.
+static void*
+tlsf_owner(void* p)
+{
+  char* b = static_cast<char*>(p);
+  unsigned count = c_arena_count;
+  __sync_synchronize();
+
+  for (unsigned i = 0; i < count; ++i)
+  {
+    if (b >= c_arenas[i].begin && b < c_arenas[i].end)
+      return c_arenas[i].begin;
+  }
+
+  return c_memory;
+}
+
 static void*
 tlsf_malloc_hook(size_t s, const void* c)
 {
-  return tlsf_malloc(s);
+  return malloc_ex(s, t_pool != NULL ? t_pool : c_memory);
 }
 
 static void
 tlsf_free_hook(void* p, const void* c)
 {
-  tlsf_free(p);
+  if (p != NULL)
+    free_ex(p, tlsf_owner(p));
 }
 
 static void*
 tlsf_realloc_hook(void* p, size_t s, const void* c)
 {
-  return tlsf_realloc(p, s);
+  if (p == NULL)
+    return tlsf_malloc_hook(s, c);
+
+  return realloc_ex(p, s, tlsf_owner(p));
 }
 
 static void
@@ -66,6 +120,115 @@ tlsf_init_hook(void)
   __realloc_hook = tlsf_realloc_hook;
 }
 
+//! Heap arena back end of DUNE::System::HeapArena.
+class TlsfArenaBackend: public DUNE::System::HeapArena::Backend
+{
+public:
+  void*
+  create(size_t size)
+  {
+    void* arena = NULL;
+    pthread_mutex_lock(&c_arena_lock);
+    reclaim();
+
+    // A destroyed arena of the same size still holding blocks is
+    // handed out again, so restarting a task does not need a new one.
+    for (unsigned i = 0; i < c_arena_count && arena == NULL; ++i)
+    {
+      TlsfArena& a = c_arenas[i];
+      if (a.released && (size_t)(a.end - a.begin) == size)
+      {
+        a.released = false;
+        arena = a.begin;
+      }
+    }
+
+    unsigned slot = 0;
+    while (slot < c_arena_count && c_arenas[slot].begin != NULL)
+      ++slot;
+
+    if (arena == NULL && slot < c_arena_max)
+    {
+      char* mem = static_cast<char*>(malloc_ex(size, c_memory));
+      if (mem != NULL && init_memory_pool(size, mem) == 0)
+      {
+        free_ex(mem, c_memory);
+        mem = NULL;
+      }
+
+      if (mem != NULL)
+      {
+        TlsfArena& a = c_arenas[slot];
+        a.base = get_used_size(mem);
+        a.released = false;
+        a.begin = mem;
+        __sync_synchronize();
+        a.end = mem + size;
+        __sync_synchronize();
+        if (slot == c_arena_count)
+          ++c_arena_count;
+        arena = mem;
+      }
+    }
+
+    pthread_mutex_unlock(&c_arena_lock);
+    return arena;
+  }
+
+  void
+  destroy(void* arena)
+  {
+    pthread_mutex_lock(&c_arena_lock);
+
+    for (unsigned i = 0; i < c_arena_count; ++i)
+    {
+      if (c_arenas[i].begin == arena)
+        c_arenas[i].released = true;
+    }
+
+    reclaim();
+    pthread_mutex_unlock(&c_arena_lock);
+  }
+
+  void
+  select(void* arena)
+  {
+    t_pool = arena;
+  }
+
+  size_t
+  getUsed(void* arena)
+  {
+    return get_used_size(arena);
+  }
+
+private:
+  //! Return destroyed arenas without blocks in use to the shared
+  //! pool. Blocks of a destroyed arena may outlive its owner (e.g.
+  //! queued messages), so its memory is released only once they are
+  //! all freed. Must be called with c_arena_lock held.
+  void
+  reclaim(void)
+  {
+    for (unsigned i = 0; i < c_arena_count; ++i)
+    {
+      TlsfArena& a = c_arenas[i];
+      if (a.begin == NULL || !a.released || get_used_size(a.begin) != a.base)
+        continue;
+
+      // Empty the range before the slot changes, so that concurrent
+      // lookups of the owner never match a partially updated range.
+      char* mem = a.begin;
+      a.end = NULL;
+      __sync_synchronize();
+      a.begin = NULL;
+      __sync_synchronize();
+      destroy_memory_pool(mem);
+      free_ex(mem, c_memory);
+    }
+  }
+};
+
 // Override initializing hook from the C library.
 #  if (__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 15)
 void(*volatile __malloc_initialize_hook) (void) = tlsf_init_hook;
@@ -0,0 +1,679 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+void
+registerStaticTasks(void);
+
+using DUNE_NAMESPACES;
+
+//! Configuration section of the harness.
+static const char* c_section = "Monte Carlo";
+//! Prefix of configuration sections holding parameter perturbations.
+static const std::string c_perturb_prefix = "Perturb ";
+//! Period of run completion checks (clock time).
+static const double c_poll_period = 0.5;
+
+//! Perturbation of a single task parameter.
+struct Perturbation
+{
+  //! Task configuration section.
+  std::string section;
+  //! Parameter name.
+  std::string option;
+  //! True for a gaussian distribution, false for uniform.
+  bool gaussian;
+  //! Lower bound or mean.
+  double a;
+  //! Upper bound or standard deviation.
+  double b;
+};
+
+//! Outcome and metrics of one run.
+struct RunResult
+{
+  RunResult(void):
+    seed(0),
+    outcome("none"),
+    plan_time(-1.0),
+    distance(0.0),
+    max_depth(0.0),
+    min_altitude(-1.0),
+    errors(0),
+    criticals(0),
+    wall_time(0.0)
+  { }
+
+  //! Seed of the simulators.
+  int32_t seed;
+  //! Plan outcome.
+  std::string outcome;
+  //! Plan execution time (clock time).
+  double plan_time;
+  //! Distance travelled during the plan.
+  double distance;
+  //! Maximum depth during the plan.
+  double max_depth;
+  //! Minimum valid altitude during the plan, negative if none.
+  double min_altitude;
+  //! Number of errors logged.
+  unsigned errors;
+  //! Number of critical errors logged.
+  unsigned criticals;
+  //! Run time (system time).
+  double wall_time;
+};
+
+//! Harness settings.
+struct Settings
+{
+  //! Base system configuration file.
+  Path config;
+  //! Configuration folder.
+  Path dir_cfg;
+  //! Output folder.
+  Path dir_out;
+  //! Execution profiles.
+  std::string profiles;
+  //! Number of runs.
+  unsigned runs;
+  //! Number of runs executing at the same time.
+  unsigned parallel;
+  //! Base seed.
+  int32_t seed;
+  //! Clock speed.
+  double speed;
+  //! Delay before starting the plan (clock time).
+  double start_delay;
+  //! Maximum run duration (clock time).
+  double duration;
+  //! Calibrate before executing the plan.
+  bool calibrate;
+  //! Tasks to disable.
+  std::vector<std::string> disabled;
+  //! Tasks to seed.
+  std::vector<std::string> seeded;
+  //! Parameter perturbations.
+  std::vector<Perturbation> perturbations;
+  //! Plan to execute.
+  IMC::PlanSpecification plan;
+};
+
+//! Task collecting the metrics of a run from the message bus and
+//! starting the plan.
+class Recorder: public Tasks::Task
+{
+public:
+  Recorder(Tasks::Context& ctx, const Settings& settings, RunResult& result):
+    Tasks::Task("Monte Carlo", ctx),
+    m_settings(settings),
+    m_result(result),
+    m_started(false),
+    m_executing(false),
+    m_finished(false),
+    m_plan_start(0),
+    m_last_valid(false),
+    m_last_lat(0),
+    m_last_lon(0)
+  {
+    setEntityLabel("Monte Carlo");
+    reserveEntities();
+
+    bind<IMC::EstimatedState>(this);
+    bind<IMC::LogBookEntry>(this);
+    bind<IMC::PlanControl>(this);
+    bind<IMC::PlanControlState>(this);
+  }
+
+  //! Test if the run is over.
+  //! @return true if the plan ended or failed to start.
+  bool
+  isFinished(void)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    return m_finished;
+  }
+
+  void
+  consume(const IMC::EstimatedState* msg)
+  {
+    if (!m_executing)
+      return;
+
+    double lat, lon;
+    Coordinates::toWGS84(*msg, lat, lon);
+
+    if (m_last_valid)
+      m_result.distance += Coordinates::WGS84::distance(m_last_lat, m_last_lon, 0.0,
+                                                        lat, lon, 0.0);
+
+    m_last_lat = lat;
+    m_last_lon = lon;
+    m_last_valid = true;
+
+    m_result.max_depth = std::max(m_result.max_depth, (double)msg->depth);
+
+    if (msg->alt >= 0 && (m_result.min_altitude < 0 || msg->alt < m_result.min_altitude))
+      m_result.min_altitude = msg->alt;
+  }
+
+  void
+  consume(const IMC::LogBookEntry* msg)
+  {
+    if (msg->type == IMC::LogBookEntry::LBET_ERROR)
+      ++m_result.errors;
+    else if (msg->type == IMC::LogBookEntry::LBET_CRITICAL)
+      ++m_result.criticals;
+  }
+
+  void
+  consume(const IMC::PlanControl* msg)
+  {
+    if (msg->getDestinationEntity() != getEntityId())
+      return;
+
+    if (msg->op == IMC::PlanControl::PC_START && msg->type == IMC::PlanControl::PC_FAILURE)
+    {
+      war("plan failed to start: %s", msg->info.c_str());
+      finish("start-failure");
+    }
+  }
+
+  void
+  consume(const IMC::PlanControlState* msg)
+  {
+    if (msg->state == IMC::PlanControlState::PCS_EXECUTING)
+    {
+      if (!m_executing)
+      {
+        m_executing = true;
+        m_plan_start = Clock::get();
+      }
+
+      return;
+    }
+
+    if (!m_executing)
+      return;
+
+    m_executing = false;
+    m_result.plan_time = Clock::get() - m_plan_start;
+
+    if (msg->last_outcome == IMC::PlanControlState::LPO_SUCCESS)
+      finish("success");
+    else
+      finish("failure");
+  }
+
+  void
+  onMain(void)
+  {
+    double start = Clock::get();
+
+    while (!stopping())
+    {
+      waitForMessages(c_poll_period);
+
+      double elapsed = Clock::get() - start;
+
+      if (!m_started && elapsed >= m_settings.start_delay)
+      {
+        startPlan();
+        m_started = true;
+      }
+
+      if (elapsed >= m_settings.duration && !isFinished())
+      {
+        if (m_executing)
+          m_result.plan_time = Clock::get() - m_plan_start;
+        finish("timeout");
+      }
+    }
+  }
+
+private:
+  //! Harness settings.
+  const Settings& m_settings;
+  //! Metrics of this run.
+  RunResult& m_result;
+  //! Plan start was requested.
+  bool m_started;
+  //! Plan is executing.
+  bool m_executing;
+  //! Run is over.
+  bool m_finished;
+  //! Time of plan start.
+  double m_plan_start;
+  //! Last position is valid.
+  bool m_last_valid;
+  //! Last position.
+  double m_last_lat, m_last_lon;
+  //! Mutex guarding the run state.
+  Concurrency::Mutex m_mutex;
+
+  void
+  startPlan(void)
+  {
+    IMC::PlanControl pc;
+    pc.type = IMC::PlanControl::PC_REQUEST;
+    pc.op = IMC::PlanControl::PC_START;
+    pc.flags = m_settings.calibrate ? IMC::PlanControl::FLG_CALIBRATE : 0;
+    pc.request_id = 0;
+    pc.plan_id = m_settings.plan.plan_id;
+    pc.arg.set(m_settings.plan);
+    pc.setDestination(getSystemId());
+    dispatch(pc);
+  }
+
+  void
+  finish(const std::string& outcome)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    if (m_finished)
+      return;
+
+    m_result.outcome = outcome;
+    m_finished = true;
+  }
+};
+
+//! Executes runs until none is left.
+class Harness
+{
+public:
+  Harness(const Settings& settings):
+    m_settings(settings),
+    m_results(settings.runs),
+    m_next(0)
+  { }
+
+  //! Execute all runs.
+  void
+  execute(void)
+  {
+    std::vector<Worker*> workers;
+    for (unsigned i = 0; i < m_settings.parallel; ++i)
+    {
+      workers.push_back(new Worker(*this));
+      workers.back()->start();
+    }
+
+    for (unsigned i = 0; i < workers.size(); ++i)
+    {
+      workers[i]->join();
+      delete workers[i];
+    }
+  }
+
+  //! Write per-run metrics in CSV format.
+  //! @param[in] os output stream.
+  void
+  writeResults(std::ostream& os) const
+  {
+    os << "run,seed,outcome,plan_time,distance,max_depth,min_altitude,"
+       << "errors,criticals,wall_time" << std::endl;
+
+    for (unsigned i = 0; i < m_results.size(); ++i)
+    {
+      const RunResult& r = m_results[i];
+      os << String::str("%u,%d,%s,%0.3f,%0.3f,%0.3f,%0.3f,%u,%u,%0.3f",
+                        i, r.seed, r.outcome.c_str(), r.plan_time,
+                        r.distance, r.max_depth, r.min_altitude,
+                        r.errors, r.criticals, r.wall_time)
+         << std::endl;
+    }
+  }
+
+  //! Write a summary of all runs.
+  //! @param[in] os output stream.
+  void
+  writeSummary(std::ostream& os) const
+  {
+    unsigned successes = 0;
+    double sum = 0;
+    double sum_sq = 0;
+
+    for (unsigned i = 0; i < m_results.size(); ++i)
+    {
+      if (m_results[i].outcome != "success")
+        continue;
+
+      ++successes;
+      sum += m_results[i].plan_time;
+      sum_sq += m_results[i].plan_time * m_results[i].plan_time;
+    }
+
+    os << String::str("runs: %u | successes: %u (%0.1f%%)",
+                      (unsigned)m_results.size(), successes,
+                      100.0 * successes / m_results.size())
+       << std::endl;
+
+    if (successes == 0)
+      return;
+
+    double mean = sum / successes;
+    double var = std::max(0.0, sum_sq / successes - mean * mean);
+    os << String::str("plan time: %0.1f s (stdev %0.1f s)", mean, std::sqrt(var))
+       << std::endl;
+  }
+
+private:
+  //! Worker thread executing runs.
+  class Worker: public Concurrency::Thread
+  {
+  public:
+    Worker(Harness& harness):
+      m_harness(harness)
+    { }
+
+  private:
+    //! Parent harness.
+    Harness& m_harness;
+
+    void
+    run(void)
+    {
+      unsigned run;
+      while (m_harness.next(run))
+        m_harness.executeRun(run);
+    }
+  };
+
+  //! Harness settings.
+  const Settings& m_settings;
+  //! Results of all runs.
+  std::vector<RunResult> m_results;
+  //! Next run to execute.
+  unsigned m_next;
+  //! Mutex guarding the run counter and output.
+  Concurrency::Mutex m_mutex;
+
+  //! Get the next run to execute.
+  //! @param[out] run run index.
+  //! @return true if there is a run left, false otherwise.
+  bool
+  next(unsigned& run)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    if (m_next >= m_settings.runs)
+      return false;
+
+    run = m_next++;
+    return true;
+  }
+
+  //! Apply the overrides of one run to its configuration.
+  //! @param[in] run run index.
+  //! @param[in,out] config run configuration.
+  void
+  configure(unsigned run, Parsers::Config& config)
+  {
+    // The harness controls the clock of all runs.
+    config.set("General", "Simulation Clock Speed", "1.0");
+
+    std::vector<std::string> sections = config.sections();
+    for (unsigned i = 0; i < sections.size(); ++i)
+    {
+      std::string task = Tasks::Manager::getTaskName(sections[i]);
+
+      if (std::find(m_settings.disabled.begin(), m_settings.disabled.end(), task)
+          != m_settings.disabled.end())
+      {
+        config.set(sections[i], "Enabled", "Never");
+        continue;
+      }
+
+      std::vector<std::string> options = config.options(sections[i]);
+      bool seeded = std::find(options.begin(), options.end(), "PRNG Seed") != options.end();
+
+      if (seeded || std::find(m_settings.seeded.begin(), m_settings.seeded.end(), task)
+          != m_settings.seeded.end())
+        config.set(sections[i], "PRNG Seed", String::str(m_results[run].seed));
+    }
+
+    Random::Philox prng(m_settings.seed, run);
+    for (unsigned i = 0; i < m_settings.perturbations.size(); ++i)
+    {
+      const Perturbation& p = m_settings.perturbations[i];
+      double value;
+      if (p.gaussian)
+        value = p.a + p.b * prng.gaussian();
+      else
+        value = p.a + (p.b - p.a) * prng.uniform();
+
+      config.set(p.section, p.option, String::str("%0.9g", value));
+    }
+  }
+
+  //! Execute one run.
+  //! @param[in] run run index.
+  void
+  executeRun(unsigned run)
+  {
+    RunResult& result = m_results[run];
+    result.seed = m_settings.seed + (int32_t)run;
+
+    Path dir = m_settings.dir_out / String::str("run-%04u", run);
+    uint64_t wall_start = Clock::getSystemNsec();
+
+    try
+    {
+      dir.create();
+
+      Tasks::Context ctx;
+      ctx.dir_cfg = m_settings.dir_cfg;
+      ctx.dir_log = dir / "log";
+      ctx.dir_db = dir / "db";
+      ctx.config.parseFile(m_settings.config.c_str());
+      configure(run, ctx.config);
+
+      std::ofstream ofs((dir / "config.ini").c_str());
+      ofs << ctx.config;
+      ofs.close();
+
+      Daemon daemon(ctx, m_settings.profiles);
+      Recorder recorder(ctx, m_settings, result);
+
+      daemon.start();
+      recorder.start();
+
+      while (!recorder.isFinished() && daemon.isRunning())
+        Delay::wait(c_poll_period);
+
+      recorder.stopAndJoin();
+      daemon.stopAndJoin();
+
+      if (!recorder.isFinished())
+        result.outcome = "aborted";
+    }
+    catch (std::exception& e)
+    {
+      result.outcome = "error";
+      DUNE_ERR("Monte Carlo", String::str("run %u: %s", run, e.what()));
+    }
+
+    result.wall_time = (Clock::getSystemNsec() - wall_start) / c_nsec_per_sec_fp;
+
+    Concurrency::ScopedMutex l(m_mutex);
+    std::cerr << String::str("run %u: %s in %0.1f s", run,
+                             result.outcome.c_str(), result.wall_time)
+              << std::endl;
+  }
+};
+
+//! Parse a perturbation of the form 'uniform MIN MAX' or
+//! 'gaussian MEAN STDEV'.
+static Perturbation
+parsePerturbation(const std::string& section, const std::string& option,
+                  const std::string& spec)
+{
+  Perturbation p;
+  p.section = section;
+  p.option = option;
+
+  std::istringstream is(spec);
+  std::string kind;
+  if (!(is >> kind >> p.a >> p.b))
+    throw std::runtime_error(String::str("invalid perturbation of '%s': %s",
+                                         option.c_str(), spec.c_str()));
+
+  if (kind == "uniform")
+    p.gaussian = false;
+  else if (kind == "gaussian")
+    p.gaussian = true;
+  else
+    throw std::runtime_error(String::str("invalid distribution: %s", kind.c_str()));
+
+  return p;
+}
+
+//! Load harness settings.
+static void
+loadSettings(Parsers::Config& cfg, Settings& s)
+{
+  cfg.get(c_section, "Runs", "10", s.runs);
+  cfg.get(c_section, "Parallel Runs", "1", s.parallel);
+  cfg.get(c_section, "Seed", "1", s.seed);
+  cfg.get(c_section, "Clock Speed", "1.0", s.speed);
+  cfg.get(c_section, "Start Delay", "10.0", s.start_delay);
+  cfg.get(c_section, "Duration", "3600.0", s.duration);
+  cfg.get(c_section, "Calibrate", "true", s.calibrate);
+  cfg.get(c_section, "Profiles", "Simulation", s.profiles);
+  cfg.get(c_section, "Disabled Tasks",
+          "Transports.Announce, Transports.Discovery, Transports.FTP, "
+          "Transports.HTTP, Transports.TCP.Server, Transports.UDP",
+          s.disabled);
+  cfg.get(c_section, "Seeded Tasks",
+          "Simulators.DVL, Simulators.DepthSensor, Simulators.Environment, "
+          "Simulators.IMU, Simulators.LBL, Simulators.SVS, Simulators.Servos, "
+          "Simulators.USBL",
+          s.seeded);
+
+  if (s.runs == 0 || s.parallel == 0 || s.speed <= 0)
+    throw std::runtime_error("invalid number of runs or clock speed");
+
+  std::vector<std::string> sections = cfg.sections();
+  for (unsigned i = 0; i < sections.size(); ++i)
+  {
+    if (sections[i].compare(0, c_perturb_prefix.size(), c_perturb_prefix) != 0)
+      continue;
+
+    std::string task = sections[i].substr(c_perturb_prefix.size());
+    std::vector<std::string> options = cfg.options(sections[i]);
+    for (unsigned j = 0; j < options.size(); ++j)
+      s.perturbations.push_back(parsePerturbation(task, options[j],
+                                                  cfg.get(sections[i], options[j])));
+  }
+
+  PlanConfigParser::parse(cfg, s.plan);
+}
+
+int
+main(int argc, char** argv)
+{
+  Tasks::Context context;
+  I18N::setLanguage(context.dir_i18n);
+
+  OptionParser options;
+  options.executable("dune-montecarlo")
+  .program(DUNE_SHORT_NAME)
+  .copyright(DUNE_COPYRIGHT)
+  .email(DUNE_CONTACT)
+  .version(getFullVersion())
+  .date(getCompileDate())
+  .arch(DUNE_SYSTEM_NAME)
+  .description("Execute a plan many times in simulation, each run with its"
+               " own seed and parameter perturbations, and report metrics"
+               " of every run.")
+  .add("-d", "--config-dir",
+       "Configuration directory", "DIR")
+  .add("-c", "--config-file",
+       "Load system configuration file CONFIG", "CONFIG")
+  .add("-m", "--monte-carlo",
+       "Load harness settings and plan from configuration file FILE", "FILE")
+  .add("-o", "--output-dir",
+       "Write run logs and results to DIR", "DIR");
+
+  if (!options.parse(argc, argv))
+  {
+    if (options.bad())
+      std::cerr << "ERROR: " << options.error() << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  if (options.value("--config-file").empty() || options.value("--monte-carlo").empty())
+  {
+    options.usage();
+    return 1;
+  }
+
+  if (!options.value("--config-dir").empty())
+    context.dir_cfg = options.value("--config-dir");
+
+  DUNE::Tasks::Factory::registerDynamicTasks(context.dir_lib.c_str());
+  registerStaticTasks();
+
+  Settings settings;
+  settings.dir_cfg = context.dir_cfg;
+  settings.config = context.dir_cfg / options.value("--config-file") + ".ini";
+  settings.dir_out = options.value("--output-dir").empty() ? "montecarlo" : options.value("--output-dir");
+
+  try
+  {
+    Path mc_file = context.dir_cfg / options.value("--monte-carlo") + ".ini";
+    Parsers::Config cfg(mc_file.c_str());
+    loadSettings(cfg, settings);
+    settings.dir_out.create();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  Clock::setSpeed(settings.speed);
+
+  Harness harness(settings);
+  harness.execute();
+
+  Path csv = settings.dir_out / "results.csv";
+  std::ofstream ofs(csv.c_str());
+  harness.writeResults(ofs);
+  harness.writeSummary(std::cout);
+
+  return 0;
+}
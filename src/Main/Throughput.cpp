@@ -0,0 +1,761 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+void
+registerStaticTasks(void);
+
+using DUNE_NAMESPACES;
+
+//! Configuration section of the benchmark.
+static const char* c_section = "Throughput";
+//! Period of completion checks (clock time).
+static const double c_poll_period = 0.5;
+//! Suffix of execution frequency parameters.
+static const std::string c_frequency = "Execution Frequency";
+//! Number of latency histogram bins.
+static const unsigned c_bins = 16;
+//! Upper bound of the first latency histogram bin.
+static const double c_first_bin = 10e-6;
+
+//! Benchmark settings.
+struct Settings
+{
+  //! Base system configuration file.
+  Path config;
+  //! Configuration folder.
+  Path dir_cfg;
+  //! Output folder.
+  Path dir_out;
+  //! Execution profiles.
+  std::string profiles;
+  //! Clock speed.
+  double speed;
+  //! Factor applied to the execution frequency of all tasks.
+  double rate_scale;
+  //! Delay before starting the plan (clock time).
+  double start_delay;
+  //! Time before measurements begin (clock time).
+  double warm_up;
+  //! Benchmark duration (clock time).
+  double duration;
+  //! Statistics sampling period (clock time).
+  double sample_period;
+  //! Tasks to disable.
+  std::vector<std::string> disabled;
+  //! Plan to execute.
+  IMC::PlanSpecification plan;
+};
+
+//! Measurements of one consumer task.
+struct TaskMetrics
+{
+  TaskMetrics(void):
+    deliveries(0),
+    lat_sum(0),
+    lat_max(0),
+    priority_lat_max(0),
+    bulk_lat_max(0),
+    high_water(0),
+    dropped(0),
+    cpu_sum(0),
+    cpu_max(0),
+    cpu_samples(0),
+    heap_first(-1),
+    heap_last(-1)
+  {
+    std::fill(bins, bins + c_bins, 0);
+  }
+
+  //! Number of consumed messages.
+  uint64_t deliveries;
+  //! Sum of delivery latencies (clock time).
+  double lat_sum;
+  //! Maximum delivery latency (clock time).
+  double lat_max;
+  //! Maximum delivery latency of the priority lane.
+  double priority_lat_max;
+  //! Maximum delivery latency of the bulk lane.
+  double bulk_lat_max;
+  //! Delivery latency histogram.
+  uint64_t bins[c_bins];
+  //! Maximum number of queued messages.
+  unsigned high_water;
+  //! Number of discarded messages.
+  uint64_t dropped;
+  //! Sum of CPU usage samples.
+  double cpu_sum;
+  //! Maximum CPU usage.
+  unsigned cpu_max;
+  //! Number of CPU usage samples.
+  unsigned cpu_samples;
+  //! First and last heap usage, negative if unknown.
+  int64_t heap_first, heap_last;
+};
+
+//! Memory usage sample.
+struct MemorySample
+{
+  //! Time since the start of measurements (clock time).
+  double time;
+  //! Resident set size in bytes.
+  uint64_t rss;
+};
+
+//! Get the resident set size of this process.
+//! @return resident set size in bytes, zero if unknown.
+static uint64_t
+getResidentSize(void)
+{
+#if defined(DUNE_OS_LINUX)
+  std::FILE* fd = std::fopen("/proc/self/statm", "r");
+  if (fd == NULL)
+    return 0;
+
+  unsigned long size = 0;
+  unsigned long resident = 0;
+  int rv = std::fscanf(fd, "%lu %lu", &size, &resident);
+  std::fclose(fd);
+
+  if (rv != 2)
+    return 0;
+
+  return (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+//! Task sampling bus, CPU and memory statistics and starting the
+//! plan that keeps the control loops busy.
+class Recorder: public Tasks::Task
+{
+public:
+  Recorder(Tasks::Context& ctx, const Settings& settings, unsigned daemon_eid):
+    Tasks::Task("Throughput", ctx),
+    m_settings(settings),
+    m_daemon_eid(daemon_eid),
+    m_started(false),
+    m_measuring(false),
+    m_finished(false),
+    m_measure_start(0),
+    m_measure_time(0),
+    m_wall_start(0),
+    m_wall_time(0),
+    m_cpu_sum(0),
+    m_cpu_samples(0),
+    m_outcome("none")
+  {
+    setEntityLabel("Throughput");
+    reserveEntities();
+
+    bind<IMC::CpuUsage>(this);
+    bind<IMC::HeapUsage>(this);
+    bind<IMC::MailboxStatistics>(this);
+    bind<IMC::PlanControlState>(this);
+  }
+
+  //! Test if the benchmark is over.
+  //! @return true if the benchmark duration elapsed.
+  bool
+  isFinished(void)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    return m_finished;
+  }
+
+  void
+  consume(const IMC::CpuUsage* msg)
+  {
+    if (!m_measuring)
+      return;
+
+    if (msg->getSourceEntity() == m_daemon_eid)
+    {
+      m_cpu_sum += msg->value;
+      ++m_cpu_samples;
+      return;
+    }
+
+    TaskMetrics& m = m_tasks[getTaskName(msg->getSourceEntity())];
+    m.cpu_sum += msg->value;
+    m.cpu_max = std::max(m.cpu_max, (unsigned)msg->value);
+    ++m.cpu_samples;
+  }
+
+  void
+  consume(const IMC::HeapUsage* msg)
+  {
+    if (!m_measuring)
+      return;
+
+    TaskMetrics& m = m_tasks[getTaskName(msg->getSourceEntity())];
+    if (m.heap_first < 0)
+      m.heap_first = msg->used;
+    m.heap_last = msg->used;
+  }
+
+  void
+  consume(const IMC::MailboxStatistics* msg)
+  {
+    m_names[msg->getSourceEntity()] = msg->consumer;
+
+    // Statistics are reset on every report, so the first report after
+    // the warm up still covers part of it.
+    if (!m_measuring || msg->consumer == getName())
+      return;
+
+    TaskMetrics& m = m_tasks[msg->consumer];
+    m.high_water = std::max(m.high_water, (unsigned)msg->high_water);
+    m.dropped += msg->dropped;
+    m.priority_lat_max = std::max(m.priority_lat_max, (double)msg->priority_lat_max);
+    m.bulk_lat_max = std::max(m.bulk_lat_max, (double)msg->bulk_lat_max);
+
+    IMC::MessageList<IMC::DeliveryStatistics>::const_iterator itr = msg->deliveries.begin();
+    for (; itr != msg->deliveries.end(); ++itr)
+    {
+      m.deliveries += (*itr)->count;
+      m.lat_sum += (*itr)->lat_mean * (*itr)->count;
+      m.lat_max = std::max(m.lat_max, (double)(*itr)->lat_max);
+
+      std::vector<unsigned> bins;
+      String::split((*itr)->histogram, ",", bins);
+      for (unsigned i = 0; i < bins.size() && i < c_bins; ++i)
+        m.bins[i] += bins[i];
+    }
+  }
+
+  void
+  consume(const IMC::PlanControlState* msg)
+  {
+    if (m_started && msg->state != IMC::PlanControlState::PCS_EXECUTING
+        && msg->last_outcome != IMC::PlanControlState::LPO_NONE)
+      m_outcome = (msg->last_outcome == IMC::PlanControlState::LPO_SUCCESS) ? "success" : "failure";
+  }
+
+  void
+  onMain(void)
+  {
+    double start = Clock::get();
+    double next_sample = 0;
+
+    while (!stopping())
+    {
+      waitForMessages(c_poll_period);
+
+      double elapsed = Clock::get() - start;
+
+      if (!m_started && elapsed >= m_settings.start_delay)
+      {
+        startPlan();
+        m_started = true;
+      }
+
+      if (!m_measuring && elapsed >= m_settings.warm_up)
+      {
+        m_measuring = true;
+        m_measure_start = Clock::get();
+        m_wall_start = Clock::getSystemNsec();
+        Concurrency::Contention::collect(m_locks_start);
+      }
+
+      if (!m_measuring)
+        continue;
+
+      double now = Clock::get() - m_measure_start;
+      if (now >= next_sample)
+      {
+        MemorySample s;
+        s.time = now;
+        s.rss = getResidentSize();
+        m_memory.push_back(s);
+        next_sample += m_settings.sample_period;
+      }
+
+      if (elapsed >= m_settings.duration && !isFinished())
+      {
+        m_measure_time = now;
+        m_wall_time = (Clock::getSystemNsec() - m_wall_start) / c_nsec_per_sec_fp;
+        Concurrency::Contention::collect(m_locks);
+        Concurrency::Contention::subtract(m_locks, m_locks_start);
+
+        Concurrency::ScopedMutex l(m_mutex);
+        m_finished = true;
+      }
+    }
+  }
+
+  //! Write the benchmark report in JSON format.
+  //! @param[in] os output stream.
+  void
+  writeReport(std::ostream& os) const
+  {
+    uint64_t deliveries = 0;
+    std::map<std::string, TaskMetrics>::const_iterator itr = m_tasks.begin();
+    for (; itr != m_tasks.end(); ++itr)
+      deliveries += itr->second.deliveries;
+
+    double measure_time = std::max(m_measure_time, 1e-9);
+    double wall_time = std::max(m_wall_time, 1e-9);
+
+    os << "{\n"
+       << String::str("  \"version\": \"%s\",\n", getFullVersion())
+       << String::str("  \"clock_speed\": %0.3f,\n", m_settings.speed)
+       << String::str("  \"rate_scale\": %0.3f,\n", m_settings.rate_scale)
+       << String::str("  \"duration\": %0.3f,\n", m_measure_time)
+       << String::str("  \"wall_time\": %0.3f,\n", m_wall_time)
+       << String::str("  \"plan_outcome\": \"%s\",\n", m_outcome.c_str())
+       << "  \"bus\": {\n"
+       << String::str("    \"deliveries\": %llu,\n", (unsigned long long)deliveries)
+       << String::str("    \"per_clock_second\": %0.1f,\n", deliveries / measure_time)
+       << String::str("    \"per_wall_second\": %0.1f\n", deliveries / wall_time)
+       << "  },\n"
+       << "  \"cpu\": {\n"
+       << String::str("    \"process_mean\": %0.1f\n",
+                      m_cpu_samples ? m_cpu_sum / m_cpu_samples : 0.0)
+       << "  },\n";
+
+    writeMemory(os);
+    writeLocks(os);
+
+    os << "  \"tasks\": [";
+    for (itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+    {
+      const TaskMetrics& m = itr->second;
+      os << (itr == m_tasks.begin() ? "\n" : ",\n")
+         << String::str("    {\"name\": \"%s\", \"deliveries\": %llu, ",
+                        itr->first.c_str(), (unsigned long long)m.deliveries)
+         << String::str("\"lat_mean_us\": %0.1f, \"lat_p50_us\": %0.1f, "
+                        "\"lat_p99_us\": %0.1f, \"lat_p999_us\": %0.1f, \"lat_max_us\": %0.1f, ",
+                        toMicroseconds(m.deliveries ? m.lat_sum / m.deliveries : 0.0),
+                        toMicroseconds(percentile(m, 0.5)),
+                        toMicroseconds(percentile(m, 0.99)),
+                        toMicroseconds(percentile(m, 0.999)),
+                        toMicroseconds(m.lat_max))
+         << String::str("\"priority_lat_max_us\": %0.1f, \"bulk_lat_max_us\": %0.1f, ",
+                        toMicroseconds(m.priority_lat_max),
+                        toMicroseconds(m.bulk_lat_max))
+         << String::str("\"high_water\": %u, \"dropped\": %llu, ",
+                        m.high_water, (unsigned long long)m.dropped)
+         << String::str("\"cpu_mean\": %0.1f, \"cpu_max\": %u",
+                        m.cpu_samples ? m.cpu_sum / m.cpu_samples : 0.0, m.cpu_max);
+
+      if (m.heap_first >= 0)
+        os << String::str(", \"heap_first\": %lld, \"heap_last\": %lld",
+                          (long long)m.heap_first, (long long)m.heap_last);
+
+      os << "}";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  //! Write a short summary of the benchmark.
+  //! @param[in] os output stream.
+  void
+  writeSummary(std::ostream& os) const
+  {
+    uint64_t deliveries = 0;
+    double p99 = 0;
+    std::string worst;
+
+    std::map<std::string, TaskMetrics>::const_iterator itr = m_tasks.begin();
+    for (; itr != m_tasks.end(); ++itr)
+    {
+      deliveries += itr->second.deliveries;
+      double value = percentile(itr->second, 0.99);
+      if (value > p99)
+      {
+        p99 = value;
+        worst = itr->first;
+      }
+    }
+
+    os << String::str("bus: %0.1f msg/s (%0.1f msg/s of clock time)",
+                      deliveries / std::max(m_wall_time, 1e-9),
+                      deliveries / std::max(m_measure_time, 1e-9))
+       << std::endl;
+
+    if (!worst.empty())
+      os << String::str("worst p99 latency: %0.1f us (%s)", toMicroseconds(p99), worst.c_str())
+         << std::endl;
+
+    if (m_memory.size() > 1)
+      os << String::str("memory: %0.1f MiB -> %0.1f MiB (%0.1f KiB/min)",
+                        m_memory.front().rss / 1048576.0, m_memory.back().rss / 1048576.0,
+                        getMemoryGrowth() * 60.0 / 1024.0)
+         << std::endl;
+  }
+
+private:
+  //! Benchmark settings.
+  const Settings& m_settings;
+  //! Entity of the daemon, reporting process CPU usage.
+  unsigned m_daemon_eid;
+  //! Plan start was requested.
+  bool m_started;
+  //! Measurements are being taken.
+  bool m_measuring;
+  //! Benchmark is over.
+  bool m_finished;
+  //! Time of measurement start (clock time).
+  double m_measure_start;
+  //! Measurement duration (clock time).
+  double m_measure_time;
+  //! Time of measurement start (system time).
+  uint64_t m_wall_start;
+  //! Measurement duration (system time).
+  double m_wall_time;
+  //! Sum of process CPU usage samples.
+  double m_cpu_sum;
+  //! Number of process CPU usage samples.
+  unsigned m_cpu_samples;
+  //! Plan outcome.
+  std::string m_outcome;
+  //! Task names by main entity.
+  std::map<unsigned, std::string> m_names;
+  //! Measurements by task name.
+  std::map<std::string, TaskMetrics> m_tasks;
+  //! Memory usage samples.
+  std::vector<MemorySample> m_memory;
+  //! Lock counters at the start of measurements.
+  std::vector<Concurrency::Contention::Sample> m_locks_start;
+  //! Lock counters accumulated during measurements.
+  std::vector<Concurrency::Contention::Sample> m_locks;
+  //! Mutex guarding the benchmark state.
+  Concurrency::Mutex m_mutex;
+
+  //! Get the name of the task owning an entity.
+  //! @param[in] eid entity identifier.
+  //! @return task name.
+  std::string
+  getTaskName(unsigned eid)
+  {
+    std::map<unsigned, std::string>::const_iterator itr = m_names.find(eid);
+    if (itr != m_names.end())
+      return itr->second;
+
+    return String::str("entity-%u", eid);
+  }
+
+  //! Convert a clock time latency to system time microseconds.
+  //! @param[in] latency latency in clock time.
+  //! @return latency in microseconds.
+  double
+  toMicroseconds(double latency) const
+  {
+    return latency * 1e6 / m_settings.speed;
+  }
+
+  //! Compute a latency percentile from the histogram of a task.
+  //! @param[in] m task measurements.
+  //! @param[in] fraction percentile in the range [0, 1].
+  //! @return upper bound of the bin holding the percentile.
+  static double
+  percentile(const TaskMetrics& m, double fraction)
+  {
+    uint64_t total = 0;
+    for (unsigned i = 0; i < c_bins; ++i)
+      total += m.bins[i];
+
+    if (total == 0)
+      return 0;
+
+    uint64_t target = (uint64_t)std::ceil(fraction * total);
+    uint64_t count = 0;
+    double bound = c_first_bin;
+    for (unsigned i = 0; i < c_bins - 1; ++i, bound *= 2)
+    {
+      count += m.bins[i];
+      if (count >= target)
+        return std::min(bound, m.lat_max);
+    }
+
+    return m.lat_max;
+  }
+
+  //! Compute the memory growth rate by least squares.
+  //! @return growth rate in bytes per second of clock time.
+  double
+  getMemoryGrowth(void) const
+  {
+    double n = m_memory.size();
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (unsigned i = 0; i < m_memory.size(); ++i)
+    {
+      double x = m_memory[i].time;
+      double y = (double)m_memory[i].rss;
+      sx += x;
+      sy += y;
+      sxx += x * x;
+      sxy += x * y;
+    }
+
+    double den = n * sxx - sx * sx;
+    if (den <= 0)
+      return 0;
+
+    return (n * sxy - sx * sy) / den;
+  }
+
+  //! Write memory samples in JSON format.
+  //! @param[in] os output stream.
+  void
+  writeMemory(std::ostream& os) const
+  {
+    os << "  \"memory\": {\n"
+       << String::str("    \"growth_bytes_per_s\": %0.1f,\n", getMemoryGrowth())
+       << "    \"samples\": [";
+
+    for (unsigned i = 0; i < m_memory.size(); ++i)
+      os << (i ? ", " : "")
+         << String::str("[%0.1f, %llu]", m_memory[i].time, (unsigned long long)m_memory[i].rss);
+
+    os << "]\n  },\n";
+  }
+
+  //! Write counters of locks that blocked in JSON format.
+  //! @param[in] os output stream.
+  void
+  writeLocks(std::ostream& os) const
+  {
+    os << "  \"locks\": [";
+
+    bool first = true;
+    for (unsigned i = 0; i < m_locks.size(); ++i)
+    {
+      const Concurrency::Contention::Sample& s = m_locks[i];
+      if (s.contentions == 0)
+        continue;
+
+      os << (first ? "\n" : ",\n")
+         << String::str("    {\"name\": \"%s\", \"acquisitions\": %lu, \"spins\": %lu, "
+                        "\"contentions\": %lu, \"wait_ms\": %0.3f}",
+                        s.name.c_str(), s.acquisitions, s.spins, s.contentions, s.wait / 1000.0);
+      first = false;
+    }
+
+    os << "\n  ],\n";
+  }
+
+  void
+  startPlan(void)
+  {
+    IMC::PlanControl pc;
+    pc.type = IMC::PlanControl::PC_REQUEST;
+    pc.op = IMC::PlanControl::PC_START;
+    pc.flags = 0;
+    pc.request_id = 0;
+    pc.plan_id = m_settings.plan.plan_id;
+    pc.arg.set(m_settings.plan);
+    pc.setDestination(getSystemId());
+    dispatch(pc);
+  }
+};
+
+//! Apply the benchmark overrides to a configuration.
+//! @param[in] s benchmark settings.
+//! @param[in,out] config system configuration.
+static void
+configure(const Settings& s, Parsers::Config& config)
+{
+  // The benchmark controls the clock.
+  config.set("General", "Simulation Clock Speed", "1.0");
+  config.set("General", "Mailbox Statistics Period", String::str("%0.3f", s.sample_period));
+  config.set("General", "Lock Statistics", "true");
+
+  std::vector<std::string> sections = config.sections();
+  for (unsigned i = 0; i < sections.size(); ++i)
+  {
+    std::string task = Tasks::Manager::getTaskName(sections[i]);
+
+    if (std::find(s.disabled.begin(), s.disabled.end(), task) != s.disabled.end())
+    {
+      config.set(sections[i], "Enabled", "Never");
+      continue;
+    }
+
+    if (s.rate_scale == 1.0)
+      continue;
+
+    // Scale every execution frequency, including those of task modes
+    // (e.g. 'Bottom Track -- Execution Frequency').
+    std::vector<std::string> options = config.options(sections[i]);
+    for (unsigned j = 0; j < options.size(); ++j)
+    {
+      const std::string& opt = options[j];
+      if (opt.size() < c_frequency.size()
+          || opt.compare(opt.size() - c_frequency.size(), c_frequency.size(), c_frequency) != 0)
+        continue;
+
+      double freq = 0;
+      config.get(sections[i], options[j], "0", freq);
+      config.set(sections[i], options[j], String::str("%0.9g", freq * s.rate_scale));
+    }
+  }
+}
+
+//! Load benchmark settings.
+static void
+loadSettings(Parsers::Config& cfg, Settings& s)
+{
+  cfg.get(c_section, "Clock Speed", "1.0", s.speed);
+  cfg.get(c_section, "Rate Scale", "1.0", s.rate_scale);
+  cfg.get(c_section, "Start Delay", "20.0", s.start_delay);
+  cfg.get(c_section, "Warm Up", "60.0", s.warm_up);
+  cfg.get(c_section, "Duration", "600.0", s.duration);
+  cfg.get(c_section, "Sample Period", "5.0", s.sample_period);
+  cfg.get(c_section, "Profiles", "Simulation", s.profiles);
+  cfg.get(c_section, "Disabled Tasks",
+          "Transports.Announce, Transports.Discovery, Transports.FTP, "
+          "Transports.HTTP, Transports.TCP.Server",
+          s.disabled);
+
+  if (s.speed <= 0 || s.rate_scale <= 0 || s.sample_period <= 0)
+    throw std::runtime_error("invalid clock speed, rate scale or sample period");
+
+  if (s.warm_up >= s.duration)
+    throw std::runtime_error("warm up must be shorter than the duration");
+
+  PlanConfigParser::parse(cfg, s.plan);
+}
+
+int
+main(int argc, char** argv)
+{
+  Tasks::Context context;
+  I18N::setLanguage(context.dir_i18n);
+
+  OptionParser options;
+  options.executable("dune-throughput")
+  .program(DUNE_SHORT_NAME)
+  .copyright(DUNE_COPYRIGHT)
+  .email(DUNE_CONTACT)
+  .version(getFullVersion())
+  .date(getCompileDate())
+  .arch(DUNE_SYSTEM_NAME)
+  .description("Run a system configuration in simulation at scaled message"
+               " rates and report bus throughput, delivery latency, CPU"
+               " usage per task and memory growth.")
+  .add("-d", "--config-dir",
+       "Configuration directory", "DIR")
+  .add("-c", "--config-file",
+       "Load system configuration file CONFIG", "CONFIG")
+  .add("-t", "--throughput",
+       "Load benchmark settings and plan from configuration file FILE", "FILE")
+  .add("-o", "--output-dir",
+       "Write logs and report to DIR", "DIR");
+
+  if (!options.parse(argc, argv))
+  {
+    if (options.bad())
+      std::cerr << "ERROR: " << options.error() << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  if (options.value("--config-file").empty() || options.value("--throughput").empty())
+  {
+    options.usage();
+    return 1;
+  }
+
+  if (!options.value("--config-dir").empty())
+    context.dir_cfg = options.value("--config-dir");
+
+  DUNE::Tasks::Factory::registerDynamicTasks(context.dir_lib.c_str());
+  registerStaticTasks();
+
+  Settings settings;
+  settings.dir_cfg = context.dir_cfg;
+  settings.config = context.dir_cfg / options.value("--config-file") + ".ini";
+  settings.dir_out = options.value("--output-dir").empty() ? "throughput" : options.value("--output-dir");
+
+  try
+  {
+    Path file = context.dir_cfg / options.value("--throughput") + ".ini";
+    Parsers::Config cfg(file.c_str());
+    loadSettings(cfg, settings);
+    settings.dir_out.create();
+
+    context.dir_log = settings.dir_out / "log";
+    context.dir_db = settings.dir_out / "db";
+    context.config.parseFile(settings.config.c_str());
+    configure(settings, context.config);
+
+    std::ofstream ofs((settings.dir_out / "config.ini").c_str());
+    ofs << context.config;
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  Clock::setSpeed(settings.speed);
+
+  Daemon daemon(context, settings.profiles);
+  Recorder recorder(context, settings, daemon.getEntityId());
+
+  daemon.start();
+  recorder.start();
+
+  while (!recorder.isFinished() && daemon.isRunning())
+    Delay::wait(c_poll_period);
+
+  recorder.stopAndJoin();
+  daemon.stopAndJoin();
+
+  if (!recorder.isFinished())
+  {
+    std::cerr << "ERROR: system stopped before the end of the benchmark" << std::endl;
+    return 1;
+  }
+
+  Path report = settings.dir_out / "report.json";
+  std::ofstream ofs(report.c_str());
+  recorder.writeReport(ofs);
+  recorder.writeSummary(std::cout);
+
+  return 0;
+}
@@ -49,6 +49,12 @@ namespace Maneuver
       float cross_tol;
       //! Number of 360 degree turns until calibration
       float turns;
+      //! Complete the maneuver once the calibration converges.
+      bool stop_converged;
+      //! Tolerance in hard-iron offset change to consider converged.
+      double conv_tol;
+      //! Minimum number of samples to consider converged.
+      unsigned conv_samples;
     };
 
     struct Task: public DUNE::Maneuvers::Maneuver
@@ -110,6 +116,22 @@ namespace Maneuver
         .defaultValue("1.0")
         .description("Number of 360 degree turns until calibration");
 
+        param("Stop On Convergence", m_args.stop_converged)
+        .defaultValue("true")
+        .description("Complete the maneuver as soon as the calibration converges");
+
+        param("Convergence Tolerance", m_args.conv_tol)
+        .defaultValue("0.01")
+        .minimumValue("0.0")
+        .description("Maximum change of the hard-iron offset between windows "
+                     "of samples, relative to the field magnitude, to consider "
+                     "the calibration converged");
+
+        param("Convergence Minimum Samples", m_args.conv_samples)
+        .defaultValue("300")
+        .description("Minimum number of magnetic field samples to consider "
+                     "the calibration converged");
+
         bindToManeuver<Task, IMC::CompassCalibration>();
         bind<IMC::PathControlState>(this);
         bind<IMC::EstimatedState>(this);
@@ -122,6 +144,8 @@ namespace Maneuver
       {
         if (paramChanged(m_args.variation))
           m_args.variation = Angles::radians(m_args.variation);
+
+        m_ccal.setConvergence(m_args.conv_tol, m_args.conv_samples);
       }
 
       void
@@ -186,6 +210,7 @@ namespace Maneuver
 
         m_end_time = -1;
         m_calibrating = false;
+        m_ccal.clear();
         m_yoyo_ing = false;
 
         double zref;
@@ -273,6 +298,20 @@ namespace Maneuver
         }
         else if ((pcs->flags & IMC::PathControlState::FL_LOITERING) && m_calibrating)
         {
+          if (m_args.stop_converged && m_ccal.isConverged())
+          {
+            debug("calibration converged after %u samples", m_ccal.getSamples());
+
+            calibrate();
+
+            signalCompletion();
+            return;
+          }
+
+          std::string info = String::str("fit change %.2f%% (%u samples)",
+                                          m_ccal.getConvergence() * 100.0,
+                                          m_ccal.getSamples());
+
           if (m_duration)
           {
             double now = Clock::get();
@@ -291,9 +330,13 @@ namespace Maneuver
             }
             else
             {
-              signalProgress((uint16_t)Math::round(m_end_time - now));
+              signalProgress((uint16_t)Math::round(m_end_time - now), info);
             }
           }
+          else
+          {
+            signalProgress(info);
+          }
 
           m_accum_psi += Angles::normalizeRadian(m_estate.psi - m_last_psi);
           m_last_psi = m_estate.psi;
@@ -322,6 +365,16 @@ namespace Maneuver
       void
       calibrate(void)
       {
+        if (m_ccal.isValid())
+        {
+          Math::Matrix w = m_ccal.getSoftIron();
+          debug("field strength %.3f, soft-iron [%.3f %.3f %.3f; %.3f %.3f %.3f; %.3f %.3f %.3f]",
+                m_ccal.getFieldStrength(),
+                w(0, 0), w(0, 1), w(0, 2),
+                w(1, 0), w(1, 1), w(1, 2),
+                w(2, 0), w(2, 1), w(2, 2));
+        }
+
         Math::Matrix params = m_ccal.getCalibrationParams();
 
         // Fill message and send to bus.
@@ -41,10 +41,11 @@ namespace Maneuver
     {
       IMC::CoverArea m_maneuver;
       IMC::EstimatedState m_estate;
-      Math::Matrix m_rows;
+      std::vector<Maneuvers::CoveragePlanner::Row> m_rows;
       IMC::DesiredPath m_path;
       bool m_moving, m_increase_row, m_arrived, m_last_on_row;
       int m_current_row, m_times, m_param_times;
+      unsigned m_param_threads;
       double m_lat, m_lon, m_z, m_next_lat, m_next_lon, m_param_width;
 
       Task(const std::string& name, Tasks::Context& ctx):
@@ -62,6 +63,12 @@ namespace Maneuver
         param("Row Width", m_param_width)
         .description("Width in meters of the rows")
         .defaultValue("300.0");
+
+        param("Planning Threads", m_param_threads)
+        .description("Number of threads used to search for the direction of the rows")
+        .defaultValue("2")
+        .minimumValue("1")
+        .maximumValue("8");
       }
 
       void
@@ -73,7 +80,7 @@ namespace Maneuver
       void
       resetVar(void)
       {
-        m_rows = Matrix();
+        m_rows.clear();
         m_current_row = -1;
         m_increase_row = false;
         m_moving = false;
@@ -82,152 +89,16 @@ namespace Maneuver
         m_times = m_param_times;
       }
 
-      Math::Matrix
-      intersectSegments(const Math::Matrix& seg1, const Math::Matrix& seg2, bool* isInSegment)
-      {
-        double m1 = (seg1(1, 1) - seg1(1, 0)) / (seg1(0, 1) - seg1(0, 0));
-        double m2 = (seg2(1, 1) - seg2(1, 0)) / (seg2(0, 1) - seg2(0, 0));
-
-        double b1 = seg1(1, 0) - m1 * seg1(0, 0);
-        double b2 = seg2(1, 0) - m2 * seg2(0, 0);
-        double xi = (b2 - b1) / (m1 - m2);
-        double yi = m1 * xi + b1;
-
-        if((std::abs(b1 - b2) < 0.5) && (std::abs(m1 - m2) < 0.5))
-            *isInSegment = false;
-        else
-            *isInSegment = (std::abs(xi-seg1(0, 0)) <= std::abs(seg1(0, 0) - seg1(0, 1)))
-            && (std::abs(xi - seg1(0, 1)) <= std::abs(seg1(0, 0) - seg1(0, 1)))
-            && (std::abs(xi - seg2(0, 0)) <= std::abs(seg2(0, 0) - seg2(0, 1)))
-            && (std::abs(xi - seg2(0, 1)) <= std::abs(seg2(0, 0) - seg2(0, 1)));
-        //checking if the intersection happens inside the segments
-
-        Math::Matrix intersection;
-        double data[] = {xi, yi};
-        intersection = Matrix(data, 2, 1);
-        return intersection;
-      }
-
-      Math::Matrix
-      intersectSegmentPolygon(const Math::Matrix& poly, double height)
-      {
-        Math::Matrix segment, easting_row, intersection, intersected;
-        easting_row = poly.row(0);
-        int sides = poly.columns();
-        double data[] = {min(easting_row) - 10, max(easting_row) + 10, height, height};
-        segment = Matrix(data, 2, 2);
-        bool in_poly = false;
-        int intersect_found = 0;
-
-        for(int i = 0; i < sides; i++)
-        {
-          if(i < sides - 1)
-            intersection = intersectSegments(poly.get(0, 1, i, i + 1), segment, &in_poly);
-          else
-          {
-            double coords[] = {poly(0, sides - 1), poly(0, 0), poly(1, sides - 1), poly(1, 0)};
-            Math::Matrix wrap_side = Matrix(coords, 2, 2);
-            intersection = intersectSegments(wrap_side, segment, &in_poly);
-          }
-
-          if(in_poly)
-          {
-            if(intersect_found)
-              intersected = intersected.horzCat(intersection);
-            else
-              intersected = Matrix(intersection);
-
-            intersect_found++;
-          }
-
-          if(intersect_found == 2)
-            break;
-        }
-
-        return intersected;
-      }
-
-      Math::Matrix
-      getRows(const Math::Matrix& poly, double direction, double width, double diam)
-      {
-        int n_rows = (int)std::ceil(diam / width);
-        double row_width = diam / n_rows;
-        double offset = row_width / 2;
-        double lower_north;
-        Math::Matrix rows, rotation, rotated_poly, northing_row;
-        double data[] = {std::cos(-direction), -std::sin(-direction), std::sin(-direction), std::cos(-direction)};
-        rotation = Matrix(data, 2, 2);
-        rotated_poly = rotation.multiply(poly);
-        northing_row = rotated_poly.row(1);
-        lower_north = min(northing_row);
-
-        rows = intersectSegmentPolygon(rotated_poly, lower_north + offset);
-
-        for(int i = 1; i < n_rows; i++)
-          rows = rows.horzCat(intersectSegmentPolygon(rotated_poly, i * row_width + lower_north + offset));
-
-        double data2[] = {std::cos(direction), -std::sin(direction), std::sin(direction), std::cos(direction)};
-        rotation = Matrix(data2, 2, 2);
-        rows = rotation.multiply(rows);
-
-        return rows;
-      }
-
-      //returns the direction in which the rows can be longer (which means less rows)
-      //diameter stores the length of the polygon in the perpendicular of that direction
-      double
-      longRowsDirection(const Math::Matrix& poly, double* diameter)
-      {
-        Math::Matrix rot_mtx, rotated_poly, northing_row, diams, curr_diam;
-        double angle_min = 0.0;
-        double diam = 100000000.00;
-        double step = Math::c_pi / 1800;
-
-        for(double angle = 0.0; angle < (Math::c_pi * 1.1); angle += step)
-        {
-          double data[] = {std::cos(-angle), -std::sin(-angle), std::sin(-angle), std::cos(-angle)};
-          rot_mtx = Matrix(data, 2, 2);
-
-          rotated_poly = rot_mtx.multiply(poly);
-          northing_row = rotated_poly.row(1);
-
-          double d[1] = {(max(northing_row) - min(northing_row))};
-          curr_diam = Math::Matrix(d, 1, 1);
-
-          if(angle == 0)
-            diams = Math::Matrix(curr_diam);
-          else
-            diams = diams.horzCat(curr_diam);
-
-          if((max(northing_row) - min(northing_row)) < diam)
-          {
-            diam = (max(northing_row) - min(northing_row));
-            angle_min = angle;
-          }
-        }
-
-        if(angle_min >= Math::c_pi)
-          angle_min -= Math::c_pi;
-
-        double data[] = {std::cos(-angle_min), -std::sin(-angle_min), std::sin(-angle_min), std::cos(-angle_min)};
-        rot_mtx = Matrix(data, 2, 2);
-        rotated_poly = rot_mtx.multiply(poly);
-        northing_row = rotated_poly.row(1);
-
-        *diameter = (max(northing_row) - min(northing_row));
-
-        return angle_min;
-      }
-
       //returns distance of point to the closest point in segment defined by the 2 points in row
       //closest stores the number of the closest point (0 or 1)
       double
-      getClosestDistance(const Math::Matrix& row,const Math::Matrix& point, int* closest)
+      getClosestDistance(const Maneuvers::CoveragePlanner::Row& row,
+                         const Maneuvers::CoveragePlanner::Point& point, int* closest)
       {
         double dist_first, dist_last, dist;
-        dist_first = UTM::distance(point(1, 0), point(0, 0), 0, 0, row(1, 0), row(0, 0), 0, 0);
+        dist_first = Math::norm(point.x - row.start.x, point.y - row.start.y);
         trace("Distance to first is %f", dist_first);
-        dist_last = UTM::distance(point(1, 0), point(0, 0), 0, 0, row(1, 1), row(0, 1), 0, 0);
+        dist_last = Math::norm(point.x - row.end.x, point.y - row.end.y);
         trace("Distance to last is %f", dist_last);
 
         if(dist_first > dist_last)
@@ -246,31 +117,29 @@ namespace Maneuver
       }
 
       void
-      doRows(const Math::Matrix& rows, int* times)
+      doRows(const std::vector<Maneuvers::CoveragePlanner::Row>& rows, int* times)
       {
-        Math::Matrix e_state;
         double n, e, dist_first_row, dist_last_row, lat, lon, e_lat, e_lon;
         e_lat = m_estate.lat;
         e_lon = m_estate.lon;
         WGS84::displace(m_estate.x, m_estate.y, &e_lat, &e_lon);
         WGS84::displacement(m_lat, m_lon, 0, e_lat, e_lon, 0, &n, &e);
-        double coords[] = {e, n};
-        e_state = Matrix(coords, 2, 1);
+        Maneuvers::CoveragePlanner::Point e_state(n, e);
         int closest_point, n_rows;
 
-        n_rows = rows.columns() / 2;
+        n_rows = rows.size();
 
         if(m_current_row==-1)
         {
-          dist_first_row = getClosestDistance(rows.get(0, 1, 0, 1), e_state, &closest_point);
-          dist_last_row = getClosestDistance(rows.get(0, 1, rows.columns() - 2, rows.columns() - 1), e_state, &closest_point);
+          dist_first_row = getClosestDistance(rows.front(), e_state, &closest_point);
+          dist_last_row = getClosestDistance(rows.back(), e_state, &closest_point);
 
           m_increase_row = (dist_first_row < dist_last_row);
 
           if(m_increase_row)
             m_current_row = -1;
           else
-            m_current_row = (rows.columns() / 2);
+            m_current_row = n_rows;
         }
 
         if(*times && m_arrived && m_last_on_row)
@@ -300,12 +169,16 @@ namespace Maneuver
 
           if(!m_last_on_row)
           {
-            getClosestDistance(rows.get(0, 1, 2 * m_current_row, 2 * m_current_row + 1), e_state, &closest_point);
+            const Maneuvers::CoveragePlanner::Row& row = rows[m_current_row];
+            getClosestDistance(row, e_state, &closest_point);
+
+            const Maneuvers::CoveragePlanner::Point& first = closest_point ? row.end : row.start;
+            const Maneuvers::CoveragePlanner::Point& last = closest_point ? row.start : row.end;
 
             lat = m_lat;
             lon = m_lon;
 
-            WGS84::displace(rows(1, 2 * m_current_row + closest_point), rows(0, 2 * m_current_row + closest_point), &lat, &lon);
+            WGS84::displace(first.x, first.y, &lat, &lon);
 
             m_path.end_lat = lat;
             m_path.end_lon = lon;
@@ -316,9 +189,7 @@ namespace Maneuver
             m_next_lat = m_lat;
             m_next_lon = m_lon;
 
-            WGS84::displace(rows(1, 2 * m_current_row + 1 - closest_point),
-                            rows(0, 2 * m_current_row + 1 - closest_point),
-                            &m_next_lat, &m_next_lon);
+            WGS84::displace(last.x, last.y, &m_next_lat, &m_next_lon);
           }
           else
           {
@@ -340,9 +211,6 @@ namespace Maneuver
       {
         m_maneuver = *maneuver;
 
-        double n, e, op_dir, diameter;
-        Math::Matrix polygon, new_vtx;
-
         IMC::MessageList<IMC::PolygonVertex>::const_iterator it = maneuver->polygon.begin();
 
         m_path.speed = m_maneuver.speed;
@@ -351,27 +219,41 @@ namespace Maneuver
         m_lon = m_maneuver.lon;
         m_lat = m_maneuver.lat;
 
-        e = 0;
-        n = 0;
-        double coords[]= {e, n};
-        polygon = Math::Matrix(coords, 2, 1);
-
+        std::vector<double> lats;
+        std::vector<double> lons;
         for (; it != maneuver->polygon.end(); it++ )
         {
-          WGS84::displacement(m_lat, m_lon, 0, (*it)->lat, (*it)->lon, 0, &n, &e);
-          coords[0] = e;
-          coords[1] = n;
-          new_vtx = Math::Matrix(coords, 2, 1);
-          polygon = polygon.horzCat(new_vtx);
+          lats.push_back((*it)->lat);
+          lons.push_back((*it)->lon);
         }
 
-        op_dir = longRowsDirection(polygon, &diameter);
+        std::vector<double> ns(lats.size());
+        std::vector<double> es(lats.size());
+        if (!lats.empty())
+          WGS84::displacement(m_lat, m_lon, 0, lats.size(), &lats[0], &lons[0], NULL,
+                              &ns[0], &es[0], NULL);
+
+        // The start point is part of the area.
+        std::vector<Maneuvers::CoveragePlanner::Point> polygon;
+        polygon.push_back(Maneuvers::CoveragePlanner::Point(0, 0));
+
+        for (size_t i = 0; i < lats.size(); i++)
+          polygon.push_back(Maneuvers::CoveragePlanner::Point(ns[i], es[i]));
+
+        Maneuvers::CoveragePlanner planner(polygon);
+
+        if (!planner.plan(m_param_width, m_param_threads))
+        {
+          signalError(DTR("unable to cover the given area"));
+          return;
+        }
 
-        trace("Direction is %.2f degrees. Diameter is %.2f", 90 - op_dir * (180 / Math::c_pi), diameter);
+        m_rows = planner.getRows();
 
-        m_rows = getRows(polygon, op_dir, m_param_width, diameter);
+        trace("Direction is %.2f degrees. Path length is %.2f",
+              Angles::degrees(planner.getDirection()), planner.getLength());
 
-        trace("%d rows found", m_rows.columns() / 2);
+        trace("%d rows found", (int)m_rows.size());
 
         m_moving = true;
         enableMovement(true);
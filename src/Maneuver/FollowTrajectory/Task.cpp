@@ -115,7 +115,7 @@ namespace Maneuver
         }
 
         // first waypoint in trajectory should have the time 0 (zero)
-        if (!isFeasible())
+        if (!isFeasible(0))
         {
           signalError(DTR("provided trajectory is not feasible by the current vehicle!"));
           return false;
@@ -136,6 +136,18 @@ namespace Maneuver
         m_done = true;
       }
 
+      bool
+      onTrajectoryExtended(size_t first)
+      {
+        if (!isFeasible(first))
+        {
+          signalError(DTR("provided trajectory is not feasible by the current vehicle!"));
+          return false;
+        }
+
+        return true;
+      }
+
       void
       step(const IMC::EstimatedState& estate)
       {
@@ -144,17 +156,20 @@ namespace Maneuver
         if (m_curr != 0 && !m_done)
           return;
 
+        if ((size_t)m_curr + 1 >= trajectory_points())
+        {
+          if (isTrajectoryComplete())
+            signalCompletion();
+
+          // otherwise wait for more streamed points
+          return;
+        }
+
         m_done = false;
 
         if (m_curr == 0)
           m_zero_time = Clock::get();
 
-        if ((size_t)m_curr + 1 == trajectory_points())
-        {
-          signalCompletion();
-          return;
-        }
-
         // throw new ground speed
         // the chosen ground speed is simply the distance between the points
         // divided by the time difference between them
@@ -224,25 +239,28 @@ namespace Maneuver
         desiredPath(point(m_curr), point(m_curr + 1));
 
         ++m_curr;
+
+        releasePoints(m_curr);
       }
 
       //! Function for testing the trajectory's feasibility
+      //! @param[in] first index of the first point to test
       bool
-      isFeasible(void)
+      isFeasible(size_t first)
       {
         size_t n = trajectory_points();
 
         if (m_args.mps_control) // test feasibility and possible anomalies in trajectory
         {
           // testing if the first waypoint is timed at zero
-          if (point(0).t != 0.0)
+          if (first == 0 && point(0).t != 0.0)
           {
             err(DTR("first point must be timed at 0.0"));
             return false;
           }
 
           // testing for two dimensional trajectories
-          for (size_t i = 1; i < n; i++)
+          for (size_t i = std::max(first, (size_t)1); i < n; i++)
           {
             double required_speed = speed(i - 1);
 
@@ -46,6 +46,17 @@ namespace Maneuver
       using DUNE_NAMESPACES;
 
 
+      //! Horizontal kinematic state of one formation vehicle.
+      struct Kinematics
+      {
+        //! Position (North, East).
+        double x, y;
+        //! Ground velocity (North, East).
+        double vx, vy;
+        //! Acceleration (North, East).
+        double ax, ay;
+      };
+
       struct Arguments
       {
         //! Simulation and control frequencies
@@ -105,6 +116,8 @@ namespace Maneuver
         std::vector<UAVSimulation*> m_models;
         //! Leader vehicle model
         UAVSimulation* m_model;
+        //! Team kinematics used by the formation control pair sweep.
+        std::vector<Kinematics> m_team;
         //! Vehicls's referencial position (Latitude, Longitude, and height).
         double m_llh_ref_pos[3];
         //! Leader's simulated position (X,Y,Z,phi,theta,psi).
@@ -1299,6 +1312,33 @@ namespace Maneuver
           }
         }
 
+        //! Copy the horizontal team state into fixed-size records, so the
+        //! pair sweep does not allocate matrices for every vehicle pair.
+        //! Acceleration columns missing from md_uav_accel are taken as null.
+        void
+        loadTeamKinematics(const Matrix& md_uav_state, const Matrix& md_uav_accel)
+        {
+          m_team.resize(m_uav_n + 1);
+          for (int ind_uav = 0; ind_uav <= m_uav_n; ++ind_uav)
+          {
+            Kinematics& kin = m_team[ind_uav];
+            kin.x = md_uav_state(0, ind_uav);
+            kin.y = md_uav_state(1, ind_uav);
+            kin.vx = md_uav_state(3, ind_uav);
+            kin.vy = md_uav_state(4, ind_uav);
+            if (ind_uav < md_uav_accel.columns())
+            {
+              kin.ax = md_uav_accel(0, ind_uav);
+              kin.ay = md_uav_accel(1, ind_uav);
+            }
+            else
+            {
+              kin.ax = 0;
+              kin.ay = 0;
+            }
+          }
+        }
+
         void
         formationControl(const Matrix& md_uav_state, const Matrix& md_uav_accel,
             const int& ind_uav, const double& d_time_step, Matrix* vd_cmd, const bool b_debug)
@@ -1379,20 +1419,16 @@ namespace Maneuver
           Matrix vd_inter_uav_x = Matrix(2, 1);
           Matrix vd_inter_uav_y = Matrix(2, 1);
 
-          double vt_form_pos2[2] = {0, 0};
-          Matrix vd_form_pos2 = Matrix(2, 1, 0.0);
           Matrix vd_inter_uav_des_pos = Matrix(2, 1, 0.0);
           Matrix vd_inter_uav_des_vel = Matrix(2, 1, 0.0);
           Matrix vd_inter_uav_des_acc = Matrix(2, 1, 0.0);
 
           Matrix vd_err = Matrix(2, 1);
-          Matrix vd_orig_err = Matrix(2, 1);
           double t_err_y;
           double d_err_x;
           double d_err_y;
           double d_err_x_s_conv;
           // double d_err_y_s_conv;
-          int int_Max;
           Matrix vd_deriv_err = Matrix(2, 1);
           double d_deriv_err_x;
           double d_deriv_err_y;
@@ -1417,7 +1453,6 @@ namespace Maneuver
           double t_surf_y;
 
           double d_inter_uav_angle_dot;
-          Matrix vt_surf_deriv =  Matrix(2, 1, 0.0);
 
           Matrix vd_surf_uav = Matrix(2, m_uav_n+1, 0.0);
           Matrix vt_virt_err_uav = Matrix(2, m_uav_n+1, 0.0);
@@ -1518,128 +1553,109 @@ namespace Maneuver
 
           // ToDo - check - verificar inclusão do líder como elemento 0 dos vectores e matrizes
           // da formação, em vez de elemento m_uav_n em apenas algumas
+          loadTeamKinematics(md_uav_state, md_uav_accel);
+          double d_form_pos1_x = vd_form_pos1(0);
+          double d_form_pos1_y = vd_form_pos1(1);
+          double d_accel_lim_x_n = vd_body_accel_lim_x(0);
+          double d_accel_lim_x_e = vd_body_accel_lim_x(1);
+          double d_accel_lim_y_n = vd_body_accel_lim_y(0);
+          double d_accel_lim_y_e = vd_body_accel_lim_y(1);
+
+          //! Pairs whose control weight is null do not contribute to the
+          //! merged sliding surface, so their surface terms are skipped.
           for (int ind_uav2 = 1; ind_uav2 <= m_uav_n; ind_uav2++)
           {
             // Skeeping the current UAV index
             if (ind_uav == ind_uav2)
               continue;
 
+            const Kinematics& own = m_team[ind_uav];
+            const Kinematics& other = m_team[ind_uav2];
+
             //! Computing relative state, from current UAV to "ind_uav2" UAV
-            vd_inter_uav_state = md_uav_state.get(0, 5, ind_uav2, ind_uav2) -
-                md_uav_state.get(0, 5, ind_uav, ind_uav);
-            vd_inter_uav_pos = vd_inter_uav_state.get(0, 1, 0, 0);
-            d_inter_uav_dist = vd_inter_uav_pos.norm_2();
+            double d_rel_x = other.x - own.x;
+            double d_rel_y = other.y - own.y;
+            double d_rel_vx = other.vx - own.vx;
+            double d_rel_vy = other.vy - own.vy;
+            d_inter_uav_dist = std::sqrt(d_rel_x * d_rel_x + d_rel_y * d_rel_y);
             //! Computing the rotation matrix - From inter-UAV frame to ground frame
-            d_inter_uav_angle = std::atan2(vd_inter_uav_pos(1),
-                vd_inter_uav_pos(0));
+            d_inter_uav_angle = std::atan2(d_rel_y, d_rel_x);
             d_cos_inter_uav_angle = std::cos(d_inter_uav_angle);
             d_sin_inter_uav_angle = std::sin(d_inter_uav_angle);
-            mt_rot[0] = d_cos_inter_uav_angle;
-            mt_rot[1] = -d_sin_inter_uav_angle;
-            mt_rot[2] = d_sin_inter_uav_angle;
-            mt_rot[3] = d_cos_inter_uav_angle;
-            md_rot = Matrix(mt_rot, 2, 2);
-            vd_inter_uav_x = md_rot.column(0);
-            vd_inter_uav_y = md_rot.column(1);
 
             //! Computation of the desired formation state:
             //! - Position vector
             //! - Velocity vector
             //! - Acceleration vector
+            double d_des_pos_x;
+            double d_des_pos_y;
+            double d_des_vel_x = 0;
+            double d_des_vel_y = 0;
+            double d_des_acc_x = 0;
+            double d_des_acc_y = 0;
             if (i_formation_frame == 0)
             {
               //! Ground reference frame
-              //! - Position
-              vd_inter_uav_des_pos = md_form_pos.get(0, 1, ind_uav-1, ind_uav-1) -
-                  md_form_pos.get(0, 1, ind_uav2-1, ind_uav2-1);
-              //! - Velocity
-              vd_inter_uav_des_vel = Matrix(2, 1, 0.0);
-              //! - Acceleration
-              vd_inter_uav_des_acc = Matrix(2, 1, 0.0);
-              /* Alternative computation
-            vd_err = -vd_inter_uav_state.get(0, 1, 0, 0) - vd_inter_uav_des_pos;
-            //! - Velocity
-            vd_inter_uav_des_vel = [-vd_err(1); vd_err(0)] * d_form_turnrate;
-            //! - Acceleration
-            vd_inter_uav_des_acc = -vd_err * d_form_turnrate*d_form_turnrate;
-               */
+              d_des_pos_x = md_form_pos(0, ind_uav-1) - md_form_pos(0, ind_uav2-1);
+              d_des_pos_y = md_form_pos(1, ind_uav-1) - md_form_pos(1, ind_uav2-1);
             }
             else
             {
               //! Path reference frame
+              double d_form_pos2_x;
+              double d_form_pos2_y;
               if ((i_formation_frame == 2) && (md_uav_state(6, 0) != 0))
               {
                 //! Curved shape - Formation shape adjustment to path curvature
                 t_uav_turnrad = d_form_turnrad - md_form_pos(1, ind_uav2-1);
                 t_cos_gamma = std::cos(md_form_pos(0, ind_uav2-1)/d_form_turnrad);
                 t_sin_gamma = std::sin(md_form_pos(0, ind_uav2-1)/d_form_turnrad);
-                // - Position
-                vt_form_dir[0] = t_sin_gamma;
-                vt_form_dir[1] = 1 - t_cos_gamma;
-                vt_form_pos2[0] = 0;
-                vt_form_pos2[1] = md_form_pos(1, ind_uav-1);
-                vd_form_pos2 = t_uav_turnrad * Matrix(vt_form_dir, 2, 1) +
-                    Matrix(vt_form_pos2, 2, 1);
-                /*
-              //! - Velocity
-              vd_form_vel2 = [-vd_form_pos2(2); vd_form_pos2(1)] * d_form_turnrate;
-              //! - Acceleration
-              vd_form_acc2 = -vd_form_pos2 * d_form_turnrate*d_form_turnrate;
-                 */
+                d_form_pos2_x = t_uav_turnrad * t_sin_gamma;
+                d_form_pos2_y = t_uav_turnrad * (1 - t_cos_gamma) + md_form_pos(1, ind_uav-1);
               }
               else
               {
                 //! Original shape - Simpler formation shape rotation (below)
-                vd_form_pos2 = md_form_pos.get(0, 1, ind_uav2-1, ind_uav2-1);
-                /*
-              vd_form_vel2 = [-vd_form_pos2(2); vd_form_pos2(1)] * d_form_turnrate;
-              vd_form_acc2 = -vd_form_pos2 * d_form_turnrate*d_form_turnrate;
-                 */
+                d_form_pos2_x = md_form_pos(0, ind_uav2-1);
+                d_form_pos2_y = md_form_pos(1, ind_uav2-1);
               }
 
-              vd_inter_uav_des_pos = md_rot_formation * (vd_form_pos1 - vd_form_pos2);
-              //vd_err = -vd_inter_uav_state.get(0, 1, 0, 0) - vd_inter_uav_des_pos;
+              double d_form_dx = d_form_pos1_x - d_form_pos2_x;
+              double d_form_dy = d_form_pos1_y - d_form_pos2_y;
+              d_des_pos_x = d_cos_form_course * d_form_dx - d_sin_form_course * d_form_dy;
+              d_des_pos_y = d_sin_form_course * d_form_dx + d_cos_form_course * d_form_dy;
               //! - Velocity
-              vd_inter_uav_des_vel(0) = vd_inter_uav_state(1) * d_form_turnrate;
-              vd_inter_uav_des_vel(1) = -vd_inter_uav_state(0) * d_form_turnrate;
-              //vd_inter_uav_des_vel = md_rot_formation * (vd_form_vel1 - vd_form_vel2);
+              d_des_vel_x = d_rel_y * d_form_turnrate;
+              d_des_vel_y = -d_rel_x * d_form_turnrate;
               //! - Acceleration
-              vd_inter_uav_des_acc = vd_inter_uav_state.get(0, 1, 0, 0)  * d_form_turnrate*d_form_turnrate;
-              //vd_inter_uav_des_acc = md_rot_formation * (vd_form_acc1 - vd_form_acc2);
+              d_des_acc_x = d_rel_x * d_form_turnrate*d_form_turnrate;
+              d_des_acc_y = d_rel_y * d_form_turnrate*d_form_turnrate;
             }
 
             //! Relative position error vector
-            vd_err = -vd_inter_uav_state.get(0, 1, 0, 0) - vd_inter_uav_des_pos;
-            d_err_y = Matrix::dot(vd_err, vd_inter_uav_y);
-            d_err_x = Matrix::dot(vd_err, vd_inter_uav_x);
-            // verificar uso de "Booleano" como alternativa a "int_Max",
-            // para optimização do código e da facilidade de interpretação deste
-            if (d_err_x < d_deconfliction_dist - d_inter_uav_dist)
-            {
-              int_Max = 2;
+            double d_pos_err_n = -d_rel_x - d_des_pos_x;
+            double d_pos_err_e = -d_rel_y - d_des_pos_y;
+            d_err_x = d_pos_err_n * d_cos_inter_uav_angle + d_pos_err_e * d_sin_inter_uav_angle;
+            d_err_y = -d_pos_err_n * d_sin_inter_uav_angle + d_pos_err_e * d_cos_inter_uav_angle;
+            bool b_beyond = (d_err_x < d_deconfliction_dist - d_inter_uav_dist);
+            if (b_beyond)
               d_err_x = d_deconfliction_dist - d_inter_uav_dist;
-            }
-            else
-            {
-              int_Max = 1;
-            }
-            // Original positional error vector, only used for controller performance evaluation
-            vd_orig_err = vd_err;
 
             //! Relative velocity error vector
-            vd_deriv_err = -vd_inter_uav_state.get(3, 4, 0, 0) - vd_inter_uav_des_vel;
-            d_deriv_err_x = Matrix::dot(vd_deriv_err, vd_inter_uav_x);
-            d_deriv_err_y = Matrix::dot(vd_deriv_err, vd_inter_uav_y);
+            double d_vel_err_n = -d_rel_vx - d_des_vel_x;
+            double d_vel_err_e = -d_rel_vy - d_des_vel_y;
+            d_deriv_err_x = d_vel_err_n * d_cos_inter_uav_angle + d_vel_err_e * d_sin_inter_uav_angle;
+            d_deriv_err_y = -d_vel_err_n * d_sin_inter_uav_angle + d_vel_err_e * d_cos_inter_uav_angle;
 
             //! Maneuvering constrains - Projection onto the inter-UAV reference frame
-            d_vel_proj_x = Matrix::dot((md_uav_state.get(3, 4, ind_uav2, ind_uav2) - m_wind),
-                vd_inter_uav_x);
-            d_accel_max_proj_x = std::abs(Matrix::dot(vd_body_accel_lim_x, vd_inter_uav_x)) +
-                std::abs(Matrix::dot(vd_body_accel_lim_y, vd_inter_uav_x));
-            d_vel_proj_y = Matrix::dot((md_uav_state.get(3, 4, ind_uav2, ind_uav2) - m_wind),
-                vd_inter_uav_y);
-            d_accel_max_proj_y = std::abs(Matrix::dot(vd_body_accel_lim_x, vd_inter_uav_y)) +
-                std::abs(Matrix::dot(vd_body_accel_lim_y, vd_inter_uav_y));
+            double d_air_vel_n = other.vx - m_wind(0);
+            double d_air_vel_e = other.vy - m_wind(1);
+            d_vel_proj_x = d_air_vel_n * d_cos_inter_uav_angle + d_air_vel_e * d_sin_inter_uav_angle;
+            d_accel_max_proj_x = std::abs(d_accel_lim_x_n * d_cos_inter_uav_angle + d_accel_lim_x_e * d_sin_inter_uav_angle) +
+                std::abs(d_accel_lim_y_n * d_cos_inter_uav_angle + d_accel_lim_y_e * d_sin_inter_uav_angle);
+            d_vel_proj_y = -d_air_vel_n * d_sin_inter_uav_angle + d_air_vel_e * d_cos_inter_uav_angle;
+            d_accel_max_proj_y = std::abs(-d_accel_lim_x_n * d_sin_inter_uav_angle + d_accel_lim_x_e * d_cos_inter_uav_angle) +
+                std::abs(-d_accel_lim_y_n * d_sin_inter_uav_angle + d_accel_lim_y_e * d_cos_inter_uav_angle);
 
             //! Sliding Surface parameters - Inter-UAV X axis
             //! Avoid negative maximum relative velocities - Minimum is hard-coded with "vel_lim"
@@ -1647,44 +1663,21 @@ namespace Maneuver
             t_ctrl_marg_mult = 2 * d_airspeed_max/(d_airspeed_max + d_vel_proj_x);
             d_c2 = d_control_margin * t_ctrl_marg_mult;
             if (d_err_x < 0)
-            {
               d_c2 = std::max(4 * (1+d_acc_saf_marg) * d_c1*d_c1/(27 * d_accel_max_proj_x), d_c2);
-              /*
-            t_CtrlMarg = d_c2/t_ctrl_marg_mult;
-            d_deconfliction_dist = m_args.safe_dist + t_CtrlMarg;
-            if (t_CtrlMarg > d_control_margin*1.1)
-              spew('Control margin: %1.1f m; UAV%d & UAV%d\n', t_CtrlMarg, ind_uav, ind_uav2);
-               */
-            }
 
             //! Limitation of the sliding surface (before reaching negative infinite)
-            if (d_inter_uav_dist < d_deconfliction_dist)
-            {
-              d_err_x = std::min(d_err_x, d_c2*0.5);
-              if (d_deriv_err_x > 0)
-                d_err_x_s_conv = d_err_x;
-              else
-                d_err_x_s_conv = std::min(d_err_x, 0.0);
-            }
+            d_err_x = std::min(d_err_x, d_c2*0.5);
+            if (d_inter_uav_dist < d_deconfliction_dist && d_deriv_err_x <= 0)
+              d_err_x_s_conv = std::min(d_err_x, 0.0);
             else
-            {
-              d_err_x = std::min(d_err_x, d_c2*0.5);
               d_err_x_s_conv = d_err_x;
-            }
-            // d_err_x = std::min(d_err_x, d_c2*0.5);
 
             //! Y projection adjustment, if target is beyond the other UAV
-            if (int_Max == 2)
+            if (b_beyond)
             {
               //! Target point across another UAV position - Define a point
               //! on the safety rim of the other UAV to follow
               t_err_y = 2 * d_deconfliction_dist;
-              /*
-            if (d_err_x > 0)
-              t_err_y = 2 * d_deconfliction_dist;
-            else
-              t_err_y = 0.5 * d_deconfliction_dist;
-               */
               if (t_err_y > std::abs(d_err_y))
               {
                 if (d_err_y < 0)
@@ -1693,12 +1686,9 @@ namespace Maneuver
                   d_err_y = t_err_y;
               }
             }
-            vd_err(0) = d_err_x;
-            vd_err(1) = d_err_y;
-            vd_err = md_rot*vd_err;
 
             //! UAV-pair - Regulation of control importance
-            d_des_dist = vd_inter_uav_des_pos.norm_2();
+            d_des_dist = std::sqrt(d_des_pos_x * d_des_pos_x + d_des_pos_y * d_des_pos_y);
             d_dist2confl = d_inter_uav_dist-d_deconfliction_dist;
             d_vel_gain = 1 + (d_deriv_err_x*d_deriv_err_x/d_accel_max_proj_x -
               d_dist2confl)/d_control_margin*k_deconfl_vel;
@@ -1716,106 +1706,60 @@ namespace Maneuver
               d_dist_gain = 0;
             vd_weight_gain(ind_uav2) = std::max(d_vel_gain, d_dist_gain);
 
-            //! Sliding Surface parameters - Inter-UAV Y axis
-            if (d_err_y < 0)
+            if (vd_weight_gain(ind_uav2) > 0)
             {
-              //! Avoid negative maximum relative velocities - Minimum is hard-coded with "vel_lim" m/s
-              d_c3 = std::max(d_airspeed_max - d_vel_proj_y, vel_lim);
-              d_c4 = 4 * (1+d_acc_saf_marg) * d_c3*d_c3/(27 * d_accel_max_proj_y);
-            }
-            else
-            {
-              //! Avoid positive minimum relative velocities - Maximum is hard-coded with -"vel_lim" m/s
-              d_c3 = std::min(- d_airspeed_max - d_vel_proj_y, -vel_lim);
-              d_c4 = - 4 * (1+d_acc_saf_marg) * d_c3*d_c3/(27 * d_accel_max_proj_y);
-            }
+              //! Sliding Surface parameters - Inter-UAV Y axis
+              if (d_err_y < 0)
+              {
+                //! Avoid negative maximum relative velocities - Minimum is hard-coded with "vel_lim" m/s
+                d_c3 = std::max(d_airspeed_max - d_vel_proj_y, vel_lim);
+                d_c4 = 4 * (1+d_acc_saf_marg) * d_c3*d_c3/(27 * d_accel_max_proj_y);
+              }
+              else
+              {
+                //! Avoid positive minimum relative velocities - Maximum is hard-coded with -"vel_lim" m/s
+                d_c3 = std::min(- d_airspeed_max - d_vel_proj_y, -vel_lim);
+                d_c4 = - 4 * (1+d_acc_saf_marg) * d_c3*d_c3/(27 * d_accel_max_proj_y);
+              }
 
-            //! ======= Sliding surface ==============
-
-            t_surf_x = d_c1 * d_err_x/(d_err_x - d_c2);
-            t_surf_y = d_c3 * d_err_y/(d_err_y - d_c4);
-            //! Sliding surface deviation
-            vd_surf_uav.set(0, 1, ind_uav2, ind_uav2,
-                            vd_deriv_err - t_surf_x * vd_inter_uav_x - t_surf_y * vd_inter_uav_y);
-
-            //! ======= Virtual error and feedback linearization ================
-            d_inter_uav_angle_dot = Matrix::dot(vd_inter_uav_state.get(3, 4, 0, 0),
-                vd_inter_uav_y/d_inter_uav_dist);
-            // d_inter_uav_angle_dot = 0;
-            vt_surf_deriv(0) = d_c1*d_c2*d_deriv_err_x/((d_err_x_s_conv - d_c2)*(d_err_x_s_conv - d_c2)) +
-                t_surf_y * d_inter_uav_angle_dot;
-            vt_surf_deriv(1) = d_c3 * d_c4 * d_deriv_err_y/((d_err_y - d_c4)*(d_err_y - d_c4)) -
-                t_surf_x * d_inter_uav_angle_dot;
-            vt_virt_err_uav.set(0, 1, ind_uav2, ind_uav2,
-                                md_uav_accel.get(0, 1, ind_uav2, ind_uav2) +
-                                vd_inter_uav_des_acc - md_rot * vt_surf_deriv);
-
-            //! Tracking output
-            /*
-            if (b_debug)
-            {
-              //IMC::FormationEval form_eval;
-              IMC::FormationEval<IMC::RelativeState> form_rel_state;
-              IMC::RelativeState* rel_state;
-
-              rel_state = new IMC::RelativeState();
-
-              //! Distance between vehicles
-              rel_state->Dist = d_inter_uav_dist;
-              // // ======== Formation perturbation test - Mesh stability =======
-              // if (ind_uav == 2)
-              //   vd_orig_err += vd_Pert;
-              // end
-              // // ======== Formation perturbation test - Mesh stability =======
-              //! Relative position error norm
-              rel_state->Err =  vd_orig_err.norm_2();
-              //! Inter-vehicle direction vector
-              rel_state->RelDirX = vd_inter_uav_x(0);
-              rel_state->RelDirY = vd_inter_uav_x(1);
-              //rel_state->RelDirZ = vd_inter_uav_x(2);
-              //! Relative position error - Ground reference frame
-              // // ======== Formation perturbation test - Mesh stability =======
-              // if ind_UAV == 2
-              //   vd_err = vd_err + vd_Pert;
-              // end
-              // // ======== Formation perturbation test - Mesh stability =======
-              rel_state->ErrX = vd_err(0);
-              rel_state->ErrY = vd_err(1);
-              //rel_state->ErrZ = vd_err(2);
-              //! Relative position error - Inter-vehicle reference frame
-              rel_state->RFErrX = Matrix::dot(vd_err ,vd_inter_uav_x);
-              rel_state->RFErrY = Matrix::dot(vd_err, vd_inter_uav_y);
-              //rel_state->RFErrZ = Matrix::dot(vd_err, vd_inter_uav_z);
-              //! Relative velocity error - Inter-vehicle reference frame
-              rel_state->RFErrVX = Matrix::dot(vd_deriv_err, vd_inter_uav_x);
-              rel_state->RFErrVY = Matrix::dot(vd_deriv_err, vd_inter_uav_y);
-              //rel_state->RFErrVZ = Matrix::dot(vd_deriv_err, vd_inter_uav_z);
-              //! Deviation from convergence (sliding surface) - Inter-vehicle reference frame
-              rel_state->SSX = Matrix::dot(vd_surf_uav.get(0, 1, ind_uav2, ind_uav2), vd_inter_uav_x);
-              rel_state->SSY = Matrix::dot(vd_surf_uav.get(0, 1, ind_uav2, ind_uav2), vd_inter_uav_y);
-              //rel_state->SSZ = Matrix::dot(vd_surf_uav.get(0, 1, ind_uav2, ind_uav2), vd_inter_uav_z);
-              //! Inter-vehicle virtual error - Ground reference frame
-              rel_state->VirtErrX = vt_virt_err_uav(0, ind_uav2);
-              rel_state->VirtErrY = vt_virt_err_uav(1, ind_uav2);
-              //rel_state->VirtErrZ = vt_virt_err_uav(2, ind_uav2);
-
-              form_rel_state.push_back(rel_state);
+              //! ======= Sliding surface ==============
+
+              t_surf_x = d_c1 * d_err_x/(d_err_x - d_c2);
+              t_surf_y = d_c3 * d_err_y/(d_err_y - d_c4);
+              //! Sliding surface deviation
+              vd_surf_uav(0, ind_uav2) = d_vel_err_n - t_surf_x * d_cos_inter_uav_angle +
+                  t_surf_y * d_sin_inter_uav_angle;
+              vd_surf_uav(1, ind_uav2) = d_vel_err_e - t_surf_x * d_sin_inter_uav_angle -
+                  t_surf_y * d_cos_inter_uav_angle;
+
+              //! ======= Virtual error and feedback linearization ================
+              d_inter_uav_angle_dot = (-d_rel_vx * d_sin_inter_uav_angle +
+                                       d_rel_vy * d_cos_inter_uav_angle) / d_inter_uav_dist;
+              double d_surf_deriv_x = d_c1*d_c2*d_deriv_err_x/((d_err_x_s_conv - d_c2)*(d_err_x_s_conv - d_c2)) +
+                  t_surf_y * d_inter_uav_angle_dot;
+              double d_surf_deriv_y = d_c3 * d_c4 * d_deriv_err_y/((d_err_y - d_c4)*(d_err_y - d_c4)) -
+                  t_surf_x * d_inter_uav_angle_dot;
+              vt_virt_err_uav(0, ind_uav2) = other.ax + d_des_acc_x -
+                  (d_cos_inter_uav_angle * d_surf_deriv_x - d_sin_inter_uav_angle * d_surf_deriv_y);
+              vt_virt_err_uav(1, ind_uav2) = other.ay + d_des_acc_y -
+                  (d_sin_inter_uav_angle * d_surf_deriv_x + d_cos_inter_uav_angle * d_surf_deriv_y);
             }
-            */
+
             // ========= Spew ===========
             if (b_debug && d_time >= m_last_time_spew + 0.5)
             {
               spew("Relative to UAV %d - Distance: %1.2fm", ind_uav2, d_inter_uav_dist);
-              spew("Relative to UAV %d - Total position error: %1.2fm", ind_uav2, vd_err.norm_2());
-              //spew("Relative to UAV %d - Position error - North: %1.2fm - East: %1.2fm",
-              //     ind_uav2, vd_err(0), vd_err(1));
+              spew("Relative to UAV %d - Total position error: %1.2fm", ind_uav2,
+                   std::sqrt(d_err_x * d_err_x + d_err_y * d_err_y));
               spew("Relative to UAV %d - Position error - X: %1.2fm     - Y: %1.2fm",
-                  ind_uav2, Matrix::dot(vd_err ,vd_inter_uav_x), Matrix::dot(vd_err ,vd_inter_uav_y));
+                  ind_uav2, d_err_x, d_err_y);
               spew("Relative to UAV %d - Velocity error - X: %1.2fm/s   - Y: %1.2fm/s",
-                  ind_uav2, Matrix::dot(vd_deriv_err ,vd_inter_uav_x), Matrix::dot(vd_deriv_err ,vd_inter_uav_y));
+                  ind_uav2, d_deriv_err_x, d_deriv_err_y);
               spew("Relative to the leader - SS deviation - X: %1.2fm/s - Y: %1.2fm/s",
-                  Matrix::dot(vd_surf_uav.get(0, 1, ind_uav2, ind_uav2), vd_inter_uav_x),
-                  Matrix::dot(vd_surf_uav.get(0, 1, ind_uav2, ind_uav2), vd_inter_uav_y));
+                  vd_surf_uav(0, ind_uav2) * d_cos_inter_uav_angle +
+                  vd_surf_uav(1, ind_uav2) * d_sin_inter_uav_angle,
+                  -vd_surf_uav(0, ind_uav2) * d_sin_inter_uav_angle +
+                  vd_surf_uav(1, ind_uav2) * d_cos_inter_uav_angle);
             }
           }
 
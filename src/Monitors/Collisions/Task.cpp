@@ -85,8 +85,8 @@ namespace Monitors
       IMC::VehicleMedium m_vm;
       //! Device entity id.
       unsigned m_device_eid;
-      //! Depth value
-      float m_depth;
+      //! Latest estimated state.
+      Concurrency::Snapshot<IMC::EstimatedState>::Reader m_estate;
       //! True if braking
       bool m_braking;
       //! Motor's rpms
@@ -100,6 +100,7 @@ namespace Monitors
         m_avg_z_innov(NULL),
         m_avg_x_abs(NULL),
         m_avg_z_abs(NULL),
+        m_estate(ctx.state.estate),
         m_braking(false),
         m_rpms(0)
       {
@@ -157,7 +158,6 @@ namespace Monitors
         // Register consumers.
         bind<IMC::Acceleration>(this);
         bind<IMC::Brake>(this);
-        bind<IMC::EstimatedState>(this);
         bind<IMC::Rpm>(this);
         bind<IMC::VehicleMedium>(this);
       }
@@ -275,12 +275,6 @@ namespace Monitors
         }
       }
 
-      void
-      consume(const IMC::EstimatedState* msg)
-      {
-        m_depth = msg->depth;
-      }
-
       void
       consume(const IMC::Brake* msg)
       {
@@ -307,7 +301,7 @@ namespace Monitors
       bool
       ignoreCollision(void)
       {
-        if (m_depth < m_args.min_depth)
+        if (m_estate->depth < m_args.min_depth)
           return true;
 
         if (m_braking)
@@ -343,6 +337,7 @@ namespace Monitors
         while (!stopping())
         {
           waitForMessages(1.0);
+          m_estate.refresh();
 
           if (getEntityState() == IMC::EntityState::ESTA_ERROR)
           {
@@ -95,11 +95,18 @@ namespace Monitors
       EIdSet m_current;
       //! Ids of monitored entities for default settings.
       EIdSet m_defaults;
+      //! Ids of monitored entities still booting.
+      EIdSet m_booting;
+      //! Ids of monitored entities in fault, error or failure.
+      EIdSet m_critical;
+      //! True if the entity lists of m_ems must be rebuilt.
+      bool m_ems_dirty;
       //! Task arguments.
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
-        DUNE::Tasks::Task(name, ctx)
+        DUNE::Tasks::Task(name, ctx),
+        m_ems_dirty(true)
       {
         param("Report Timeout", m_args.report_timeout)
         .units(Units::Second)
@@ -227,6 +234,7 @@ namespace Monitors
 
         r.time = Clock::get();
         r.state = msg->state;
+        updateMembership(msg->getSourceEntity());
 
         if (noteworthy)
         {
@@ -302,6 +310,8 @@ namespace Monitors
 
           m_current.insert(eid);
           r.monitor = true;
+          m_ems_dirty = true;
+          updateMembership(eid);
 
           if (r.state != IMC::EntityState::ESTA_NORMAL && !startup)
             err(DTR("%s - current state not normal - %s"), DTR(r.label.c_str()), DTR(c_state_desc[r.state]));
@@ -325,6 +335,8 @@ namespace Monitors
 
           m_current.erase(eid);
           r.monitor = false;
+          m_ems_dirty = true;
+          updateMembership(eid);
         }
         else
         {
@@ -375,22 +387,17 @@ namespace Monitors
         }
       }
 
-      //! Dispatch Entity Monitoring State
+      //! Update the state lists an entity belongs to.
+      //! @param[in] eid entity ID
       void
-      reportState(void)
+      updateMembership(uint8_t eid)
       {
-        m_ems.mcount = m_ems.ecount = m_ems.ccount = 0;
-        m_ems.mnames = m_ems.enames = m_ems.cnames = "";
+        ESRecord& r = m_record[eid];
+        bool booting = false;
+        bool critical = false;
 
-        for (EIdSet::iterator itr = m_current.begin(); itr != m_current.end(); ++itr)
+        if (r.monitor)
         {
-          ESRecord& r = m_record[*itr];
-
-          if (m_ems.mcount++ > 0)
-            m_ems.mnames += ',';
-
-          m_ems.mnames += r.label;
-
           switch ((IMC::EntityState::StateEnum)r.state)
           {
             case IMC::EntityState::ESTA_NORMAL:
@@ -398,17 +405,68 @@ namespace Monitors
             case IMC::EntityState::ESTA_FAULT:
             case IMC::EntityState::ESTA_ERROR:
             case IMC::EntityState::ESTA_FAILURE:
-              if (m_ems.ccount++ > 0)
-                m_ems.cnames += ',';
-              m_ems.cnames += r.label;
+              critical = true;
               break;
             case IMC::EntityState::ESTA_BOOT:
-              if (m_ems.ecount++ > 0)
-                m_ems.enames += ',';
-              m_ems.enames += r.label;
+              booting = true;
               break;
           }
         }
+
+        if (setMember(m_booting, eid, booting))
+          m_ems_dirty = true;
+        if (setMember(m_critical, eid, critical))
+          m_ems_dirty = true;
+      }
+
+      //! Insert or remove an entity from a state list.
+      //! @param[in] set state list.
+      //! @param[in] eid entity ID.
+      //! @param[in] member true if the entity belongs to the list.
+      //! @return true if the list changed, false otherwise.
+      bool
+      setMember(EIdSet& set, uint8_t eid, bool member)
+      {
+        if (member)
+          return set.insert(eid).second;
+
+        return set.erase(eid) > 0;
+      }
+
+      //! Join the labels of a set of entities.
+      //! @param[in] set entity IDs.
+      //! @return comma separated labels.
+      std::string
+      joinLabels(const EIdSet& set)
+      {
+        std::string names;
+
+        for (EIdSet::const_iterator itr = set.begin(); itr != set.end(); ++itr)
+        {
+          if (itr != set.begin())
+            names += ',';
+          names += m_record[*itr].label;
+        }
+
+        return names;
+      }
+
+      //! Dispatch Entity Monitoring State, rebuilding the entity lists
+      //! only if they changed since the last dispatch.
+      void
+      reportState(void)
+      {
+        if (m_ems_dirty)
+        {
+          m_ems.mcount = m_current.size();
+          m_ems.ecount = m_booting.size();
+          m_ems.ccount = m_critical.size();
+          m_ems.mnames = joinLabels(m_current);
+          m_ems.enames = joinLabels(m_booting);
+          m_ems.cnames = joinLabels(m_critical);
+          m_ems_dirty = false;
+        }
+
         dispatch(m_ems);
       }
 
@@ -435,6 +493,7 @@ namespace Monitors
 
             r.time = now;
             r.state = IMC::EntityState::ESTA_FAILURE;
+            updateMembership(i);
           }
         }
       }
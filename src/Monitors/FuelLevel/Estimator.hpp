@@ -0,0 +1,232 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef MONITORS_FUELLEVEL_ESTIMATOR_HPP_INCLUDED_
+#define MONITORS_FUELLEVEL_ESTIMATOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Monitors
+{
+  namespace FuelLevel
+  {
+    using DUNE_NAMESPACES;
+
+    //! Number of entries of the voltage lookup tables.
+    static const unsigned c_table_size = 128;
+
+    //! Recursive estimator of the energy left in the batteries. A
+    //! scalar extended Kalman filter predicts the energy with the
+    //! measured power drawn and corrects it with the measured
+    //! voltage. The voltage expected for a given energy and electric
+    //! current is interpolated between two discharge curves measured
+    //! at different currents, which accounts for the voltage drop
+    //! caused by the internal resistance. The curves are sampled
+    //! into uniform lookup tables, so each sample is processed in
+    //! constant time.
+    class Estimator
+    {
+    public:
+      //! Constructor.
+      Estimator(void):
+        m_capacity(0),
+        m_step(0),
+        m_hi_current(0),
+        m_lo_current(0),
+        m_energy(0),
+        m_variance(0),
+        m_process(0),
+        m_measurement(1)
+      { }
+
+      //! Set the discharge curves of the battery.
+      //! @param[in] hi_voltage voltage values of the low current curve.
+      //! @param[in] hi_energy energy values of the low current curve.
+      //! @param[in] hi_current electric current of the low current curve.
+      //! @param[in] lo_voltage voltage values of the high current curve.
+      //! @param[in] lo_energy energy values of the high current curve.
+      //! @param[in] lo_current electric current of the high current curve.
+      //! @param[in] capacity energy capacity of the batteries (Wh).
+      void
+      setModel(const std::vector<float>& hi_voltage, const std::vector<float>& hi_energy,
+               float hi_current, const std::vector<float>& lo_voltage,
+               const std::vector<float>& lo_energy, float lo_current, float capacity)
+      {
+        m_capacity = capacity;
+        m_step = capacity / (c_table_size - 1);
+        m_hi_current = hi_current;
+        m_lo_current = lo_current;
+
+        for (unsigned i = 0; i < c_table_size; ++i)
+        {
+          float energy = i * m_step;
+          m_hi[i] = piecewiseLI(hi_voltage, hi_energy, energy);
+          m_lo[i] = piecewiseLI(lo_voltage, lo_energy, energy);
+        }
+      }
+
+      //! Set the noise of the filter.
+      //! @param[in] process standard deviation of the energy drift
+      //! after one hour of operation (Wh).
+      //! @param[in] measurement standard deviation of voltage
+      //! measurements (V).
+      void
+      setNoise(float process, float measurement)
+      {
+        m_process = process * process;
+        m_measurement = measurement * measurement;
+      }
+
+      //! Reset the estimate.
+      //! @param[in] energy energy left in the batteries (Wh).
+      //! @param[in] deviation standard deviation of the energy (Wh).
+      void
+      reset(float energy, float deviation)
+      {
+        m_energy = trimValue(energy, 0.0f, m_capacity);
+        m_variance = deviation * deviation;
+      }
+
+      //! Propagate the estimate with the energy consumed.
+      //! @param[in] drop energy consumed (Wh).
+      //! @param[in] delta elapsed time (s).
+      void
+      predict(float drop, float delta)
+      {
+        m_energy = std::max(m_energy - drop, 0.0f);
+        m_variance += m_process * delta / 3600.0f;
+      }
+
+      //! Correct the estimate with a voltage measurement.
+      //! @param[in] voltage measured voltage (V).
+      //! @param[in] current measured electric current (A).
+      void
+      correct(float voltage, float current)
+      {
+        float slope = 0;
+        float expected = getVoltage(m_energy, current, slope);
+
+        float innovation = slope * slope * m_variance + m_measurement;
+        if (innovation <= 0)
+          return;
+
+        float gain = m_variance * slope / innovation;
+        m_energy = trimValue(m_energy + gain * (voltage - expected), 0.0f, m_capacity);
+        m_variance = std::max((1.0f - gain * slope) * m_variance, 0.0f);
+      }
+
+      //! Retrieve the energy left in the batteries.
+      //! @return energy (Wh).
+      float
+      getEnergy(void) const
+      {
+        return m_energy;
+      }
+
+      //! Retrieve the standard deviation of the energy estimate.
+      //! @return standard deviation (Wh).
+      float
+      getDeviation(void) const
+      {
+        return std::sqrt(m_variance);
+      }
+
+      //! Project the remaining endurance at a given power.
+      //! @param[in] power power consumption (W).
+      //! @return remaining time (s).
+      float
+      getEndurance(float power) const
+      {
+        if (power <= 0)
+          return 0;
+
+        return m_energy / power * 3600.0f;
+      }
+
+      //! Compute the voltage expected for a given energy and
+      //! electric current.
+      //! @param[in] energy energy left in the batteries (Wh).
+      //! @param[in] current electric current (A).
+      //! @param[out] slope derivative of the voltage with respect to
+      //! the energy (V/Wh).
+      //! @return expected voltage (V).
+      float
+      getVoltage(float energy, float current, float& slope) const
+      {
+        if (m_step <= 0)
+        {
+          slope = 0;
+          return 0;
+        }
+
+        float pos = trimValue(energy / m_step, 0.0f, (float)(c_table_size - 1));
+        unsigned idx = std::min((unsigned)pos, c_table_size - 2);
+        float frac = pos - idx;
+
+        float weight = 0;
+        if (m_lo_current != m_hi_current)
+          weight = (current - m_hi_current) / (m_lo_current - m_hi_current);
+
+        float v0 = m_hi[idx] + weight * (m_lo[idx] - m_hi[idx]);
+        float v1 = m_hi[idx + 1] + weight * (m_lo[idx + 1] - m_hi[idx + 1]);
+
+        slope = (v1 - v0) / m_step;
+        return v0 + frac * (v1 - v0);
+      }
+
+    private:
+      //! Energy capacity (Wh).
+      float m_capacity;
+      //! Energy step between table entries (Wh).
+      float m_step;
+      //! Electric current of the low current curve (A).
+      float m_hi_current;
+      //! Electric current of the high current curve (A).
+      float m_lo_current;
+      //! Voltage of the low current curve by energy.
+      float m_hi[c_table_size];
+      //! Voltage of the high current curve by energy.
+      float m_lo[c_table_size];
+      //! Energy estimate (Wh).
+      float m_energy;
+      //! Variance of the energy estimate (Wh^2).
+      float m_variance;
+      //! Energy drift variance per hour (Wh^2).
+      float m_process;
+      //! Voltage measurement variance (V^2).
+      float m_measurement;
+    };
+  }
+}
+
+#endif
@@ -34,6 +34,7 @@
 
 // Local headers.
 #include "BatteryData.hpp"
+#include "Estimator.hpp"
 
 namespace Monitors
 {
@@ -121,6 +122,12 @@ namespace Monitors
       float low_confidence;
       //! Acceptable temperature level for estimating.
       float acceptable_temperature;
+      //! Correct the energy estimate online with voltage measurements.
+      bool online;
+      //! Energy drift after one hour of operation.
+      float process_noise;
+      //! Voltage measurement noise.
+      float voltage_noise;
     };
 
     struct Task: public DUNE::Tasks::Periodic
@@ -149,6 +156,8 @@ namespace Monitors
       Time::Counter<float> m_sane_timer;
       //! True if maneuvering. Start as true.
       bool m_is_maneuvering;
+      //! Online energy estimator.
+      Estimator m_estimator;
       //! Task arguments.
       Arguments m_args;
 
@@ -249,6 +258,26 @@ namespace Monitors
         .units(Units::DegreeCelsius)
         .description("Acceptable temperature level for estimating.");
 
+        param("Online Estimation", m_args.online)
+        .visibility(Tasks::Parameter::VISIBILITY_DEVELOPER)
+        .defaultValue("false")
+        .description("Correct the energy estimate with every voltage measurement"
+                     " instead of integrating consumed energy only");
+
+        param("Energy Process Noise", m_args.process_noise)
+        .visibility(Tasks::Parameter::VISIBILITY_DEVELOPER)
+        .defaultValue("5.0")
+        .minimumValue("0.0")
+        .units(Units::WattHour)
+        .description("Standard deviation of the energy drift after one hour of operation");
+
+        param("Voltage Measurement Noise", m_args.voltage_noise)
+        .visibility(Tasks::Parameter::VISIBILITY_DEVELOPER)
+        .defaultValue("0.2")
+        .minimumValue("0.001")
+        .units(Units::Volt)
+        .description("Standard deviation of voltage measurements");
+
         // Register listeners.
         bind<IMC::Voltage>(this);
         bind<IMC::Current>(this);
@@ -288,6 +317,13 @@ namespace Monitors
             throw std::runtime_error(msg_inv);
           }
         }
+
+        m_estimator.setModel(m_args.models[MDL_OPT].voltage, m_args.models[MDL_OPT].energy,
+                             m_args.models[MDL_OPT].current,
+                             m_args.models[MDL_PES].voltage, m_args.models[MDL_PES].energy,
+                             m_args.models[MDL_PES].current,
+                             m_args.full_capacity * (1 - m_args.decay_factor));
+        m_estimator.setNoise(m_args.process_noise, m_args.voltage_noise);
       }
 
       void
@@ -344,7 +380,14 @@ namespace Monitors
               return;
 
             // integrate energy consumed even if there is no estimate yet
-            m_energy_consumed += m_bdata->getEnergyDrop(delta);
+            float drop = m_bdata->getEnergyDrop(delta);
+            m_energy_consumed += drop;
+
+            if (m_args.online && m_has_initial_estimate)
+            {
+              m_estimator.predict(drop, delta);
+              m_estimator.correct(m_bdata->getVoltage(), m_bdata->getCurrent());
+            }
           }
         }
       }
@@ -381,13 +424,24 @@ namespace Monitors
         }
       }
 
+      //! Retrieve the estimated energy left in the batteries
+      //! @return energy left in Wh
+      inline float
+      getEnergyLeft(void) const
+      {
+        if (m_args.online)
+          return m_estimator.getEnergy();
+
+        return m_initial_estimate - m_energy_consumed;
+      }
+
       //! Compute deviation from model
       //! @param[in] model model to be used to compute deviation
       //! @return deviation from given model
       inline float
       getDeviationFromModel(const Models model)
       {
-        return (m_initial_estimate - m_energy_consumed - getModelEstimate(model)) / getModelEstimate(model) * 100.0f;
+        return (getEnergyLeft() - getModelEstimate(model)) / getModelEstimate(model) * 100.0f;
       }
 
       //! Compute deviation from a merged model
@@ -396,7 +450,7 @@ namespace Monitors
       inline float
       getDeviationMergedModel(const MergedModels model)
       {
-        return (m_initial_estimate - m_energy_consumed - getMergedEstimate(model)) / getMergedEstimate(model) * 100.0f;
+        return (getEnergyLeft() - getMergedEstimate(model)) / getMergedEstimate(model) * 100.0f;
       }
 
       //! Compute an estimate based on a current discharge model
@@ -539,7 +593,7 @@ namespace Monitors
       inline float
       getRemainingTime(float power_rate)
       {
-        return (m_initial_estimate - m_energy_consumed) / power_rate * 3600.0;
+        return getEnergyLeft() / power_rate * 3600.0;
       }
 
       //! Compute an initial estimate for the energy left in batteries
@@ -636,7 +690,7 @@ namespace Monitors
       float
       computeConfidence(void)
       {
-        return computeConfidence(m_initial_estimate - m_energy_consumed);
+        return computeConfidence(getEnergyLeft());
       }
 
       void
@@ -658,6 +712,10 @@ namespace Monitors
           m_initial_estimate = computeInitialEstimate();
           m_has_initial_estimate = true;
 
+          // The spread of the discharge models bounds the initial error.
+          m_estimator.reset(m_initial_estimate,
+                            0.5f * std::fabs(getModelEstimate(MDL_OPT) - getModelEstimate(MDL_PES)));
+
           setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
 
           debug("Initial estimate: %.2f Wh, Optimistic: %.2f Wh, Pessimistic: %.2f Wh.",
@@ -665,10 +723,12 @@ namespace Monitors
         }
 
         // Check if we should refresh the initial estimate
+        // if the online estimator is not correcting it already
         // if Temperature is reliable
         // if we have low electric currents
         // if vehicle is not maneuvering atm
-        if ((m_bdata->getTemperature() > m_args.acceptable_temperature) &&
+        if (!m_args.online &&
+            (m_bdata->getTemperature() > m_args.acceptable_temperature) &&
             (m_bdata->getCurrent() < c_stable_current) &&
             !m_is_maneuvering && m_sane_timer.overflow())
         {
@@ -705,7 +765,7 @@ namespace Monitors
         }
 
         // fill value with estimated percentage of battery
-        m_fuel.value = (m_initial_estimate - m_energy_consumed) / m_args.full_capacity * 100;
+        m_fuel.value = getEnergyLeft() / m_args.full_capacity * 100;
         m_fuel.confidence = computeConfidence();
 
         std::stringstream ss;
@@ -715,7 +775,7 @@ namespace Monitors
         for (unsigned i = 0; i < m_args.op_labels.size(); ++i)
         {
           ss << m_args.op_labels[i] << "="
-             << (m_initial_estimate - m_energy_consumed) / m_args.op_values[i]
+             << getEnergyLeft() / m_args.op_values[i]
              << ";";
         }
 
@@ -737,7 +797,7 @@ namespace Monitors
           trace("Operation modes are: %s\nPercentage is %.2f\nConfidence level is %.2f\n",
                 m_fuel.opmodes.c_str(), m_fuel.value, m_fuel.confidence);
 
-          trace("Energy Left %.2f Wh", m_initial_estimate - m_energy_consumed);
+          trace("Energy Left %.2f Wh", getEnergyLeft());
 
           trace("Energy value deviates %.1f from pessimistic model and %1.f"
                 " from optimistic model.", getDeviationFromModel(MDL_PES),
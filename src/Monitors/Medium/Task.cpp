@@ -79,6 +79,10 @@ namespace Monitors
       Time::Counter<float> m_init;
       //! GPS validation bits.
       uint16_t m_gps_val_bits;
+      //! Latest estimated state.
+      Concurrency::Snapshot<IMC::EstimatedState>::Reader m_estate;
+      //! Latest GPS fix.
+      Concurrency::Snapshot<IMC::GpsFix>::Reader m_gps_fix;
       //! Vehicle depth.
       float m_depth;
       //! Vehicle airspeed.
@@ -87,7 +91,11 @@ namespace Monitors
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
-        Tasks::Periodic(name, ctx)
+        Tasks::Periodic(name, ctx),
+        m_estate(ctx.state.estate),
+        m_gps_fix(ctx.state.gps_fix),
+        m_depth(0),
+        m_airspeed(0)
       {
         param("Initialization Time", m_args.init_time)
         .units(Units::Second)
@@ -143,8 +151,6 @@ namespace Monitors
         m_water_presence.setTop(c_water_presence);
 
         // Register consumers.
-        bind<IMC::EstimatedState>(this);
-        bind<IMC::GpsFix>(this);
         bind<IMC::Salinity>(this);
         bind<IMC::SoundSpeed>(this);
         bind<IMC::IndicatedSpeed>(this);
@@ -159,12 +165,6 @@ namespace Monitors
         m_gps_status.setTop(m_args.gps_timeout);
       }
 
-      void
-      consume(const IMC::EstimatedState* msg)
-      {
-        m_depth = msg->depth;
-      }
-
       void
       consume(const IMC::IndicatedSpeed* msg)
       {
@@ -177,11 +177,18 @@ namespace Monitors
         m_airspeed = msg->value;
       }
 
+      //! Pick up the latest estimated state and GPS fix.
       void
-      consume(const IMC::GpsFix* msg)
+      refreshState(void)
       {
-        if ((msg->validity & m_gps_val_bits) == m_gps_val_bits)
-          m_gps_status.reset();
+        if (m_estate.refresh())
+          m_depth = m_estate->depth;
+
+        if (m_gps_fix.refresh())
+        {
+          if ((m_gps_fix->validity & m_gps_val_bits) == m_gps_val_bits)
+            m_gps_status.reset();
+        }
       }
 
       void
@@ -262,6 +269,8 @@ namespace Monitors
       void
       task(void)
       {
+        refreshState();
+
         // Wait to stabilize at beginning.
         if (!m_init.overflow())
           return;
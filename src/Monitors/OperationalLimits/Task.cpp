@@ -29,8 +29,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
-#include <map>
-#include <iostream>
+#include <iomanip>
 #include <sstream>
 
 // DUNE headers.
@@ -75,8 +74,42 @@ namespace Monitors
       fp32_t min_depth;
     };
 
-    //! Period for testing the area operational limits
-    static const double c_atest_period = 1.0;
+    //! Values checked by the operational limits.
+    enum Input
+    {
+      //! Speed over ground.
+      IN_SPEED,
+      //! Depth.
+      IN_DEPTH,
+      //! Absolute vertical rate.
+      IN_VRATE,
+      //! Altitude.
+      IN_ALTITUDE,
+      //! Signed distance to the operational area boundary.
+      IN_AREA,
+      //! Number of inputs.
+      IN_TOTAL
+    };
+
+    //! Compiled operational limit.
+    struct Rule
+    {
+      //! Limit bit.
+      uint8_t mask;
+      //! Error description.
+      const char* desc;
+      //! Checked value.
+      Input input;
+      //! Limit value.
+      double limit;
+      //! Hysteresis applied when clearing the error.
+      double hyst;
+      //! True if the limit is breached below the limit value.
+      bool lower;
+    };
+
+    //! Maximum number of compiled rules (one per limit bit).
+    static const unsigned c_max_rules = 8;
 
     struct Task: public DUNE::Tasks::Periodic
     {
@@ -84,36 +117,61 @@ namespace Monitors
       struct LError
       {
         //! Error description
-        std::string desc;
+        const char* desc;
         //! Value 1
         double v1;
         //! Value 2
         double v2;
       };
 
-      //! Mapping of error bitmask to op limits error.
-      typedef std::map<uint8_t, LError> LErrorMap;
-
       //! Task arguments.
       Arguments m_args;
-      //! Error map.
-      LErrorMap m_errs;
+      //! Error of each limit bit.
+      LError m_errs[c_max_rules];
+      //! Compiled rules.
+      Rule m_rules[c_max_rules];
+      //! Number of compiled rules.
+      unsigned m_nrules;
+      //! Inputs used by the compiled rules.
+      unsigned m_inputs;
       //! Limits in use.
       IMC::OperationalLimits m_ol;
-      //! Last EstimatedState message
-      IMC::EstimatedState m_estate;
+      //! Latest estimated state.
+      Concurrency::Snapshot<IMC::EstimatedState>::Reader m_estate;
       //! Error mask.
       uint8_t m_emask;
       //! Cache control message.
       IMC::CacheControl m_cc;
-      //! Time of next area limit test.
-      double m_atest_time;
+      //! Sine and cosine of the area orientation.
+      double m_area_sin;
+      double m_area_cos;
+      //! Displacement from the area centre to the navigation origin.
+      double m_area_x;
+      double m_area_y;
+      //! Navigation origin of the cached area displacement.
+      double m_area_lat;
+      double m_area_lon;
+      //! True if the cached area displacement is valid.
+      bool m_area_valid;
+      //! True if the rules changed since they were last evaluated.
+      bool m_recompiled;
       //! Use configuration flag.
       bool m_use_cfg;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Periodic(name, ctx),
-        m_atest_time(0),
+        m_nrules(0),
+        m_inputs(0),
+        m_estate(ctx.state.estate),
+        m_emask(0),
+        m_area_sin(0),
+        m_area_cos(1),
+        m_area_x(0),
+        m_area_y(0),
+        m_area_lat(0),
+        m_area_lon(0),
+        m_area_valid(false),
+        m_recompiled(true),
         m_use_cfg(true)
       {
         param("Initial Setting - Maximum Depth", m_args.i_max_depth)
@@ -159,7 +217,6 @@ namespace Monitors
         .defaultValue("0.2")
         .description("Minimum depth required to check altitude operational limits");
 
-        bind<IMC::EstimatedState>(this);
         bind<IMC::GetOperationalLimits>(this);
         bind<IMC::OperationalLimits>(this);
       }
@@ -190,8 +247,14 @@ namespace Monitors
           init(m_ol.min_altitude, m_args.i_min_altitude, IMC::OPL_MIN_ALT);
           init(m_ol.max_altitude, m_args.i_max_altitude, IMC::OPL_MAX_ALT);
           init(m_ol.min_speed, m_args.i_min_speed, IMC::OPL_MIN_SPEED);
-          init(m_ol.min_speed, m_args.i_max_speed, IMC::OPL_MAX_SPEED);
+          init(m_ol.max_speed, m_args.i_max_speed, IMC::OPL_MAX_SPEED);
           init(m_ol.max_vrate, m_args.i_max_vrate, IMC::OPL_MAX_VRATE);
+          compile();
+        }
+        else
+        {
+          // Hysteresis values may have changed.
+          compile();
         }
       }
 
@@ -199,10 +262,11 @@ namespace Monitors
       void
       reset(void)
       {
-        m_atest_time = 0;
         m_emask = 0;
         m_ol.mask = 0;
-        m_errs.clear();
+        m_nrules = 0;
+        m_inputs = 0;
+        m_area_valid = false;
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
@@ -216,6 +280,7 @@ namespace Monitors
         m_ol.setSource(IMC::AddressResolver::invalid());
         m_ol.setDestination(IMC::AddressResolver::invalid());
         m_ol.setSourceEntity(getEntityId());
+        compile();
         inf("%s", DTR(Status::getString(Status::CODE_ACTIVE)));
 
         // Store it in cache
@@ -224,6 +289,50 @@ namespace Monitors
         dispatch(m_cc);
       }
 
+      //! Add a rule to the evaluation program if its limit is enabled.
+      //! @param[in] lmask limit bit.
+      //! @param[in] ldesc error description.
+      //! @param[in] input checked value.
+      //! @param[in] limit limit value.
+      //! @param[in] hyst hysteresis factor to avoid chattering.
+      //! @param[in] lower true if breached below the limit value.
+      void
+      addRule(uint8_t lmask, const char* ldesc, Input input, double limit, double hyst, bool lower)
+      {
+        if (!(m_ol.mask & lmask))
+          return;
+
+        Rule& r = m_rules[m_nrules++];
+        r.mask = lmask;
+        r.desc = ldesc;
+        r.input = input;
+        r.limit = limit;
+        r.hyst = hyst;
+        r.lower = lower;
+        m_inputs |= (1 << input);
+      }
+
+      //! Compile the limits in use into the evaluation program.
+      void
+      compile(void)
+      {
+        m_nrules = 0;
+        m_inputs = 0;
+
+        addRule(IMC::OPL_MIN_SPEED, DTR("minimum speed"), IN_SPEED, m_ol.min_speed, 0.0, true);
+        addRule(IMC::OPL_MAX_SPEED, DTR("maximum speed"), IN_SPEED, m_ol.max_speed, 0.0, false);
+        addRule(IMC::OPL_MAX_DEPTH, DTR("depth"), IN_DEPTH, m_ol.max_depth, m_args.h_max_depth, false);
+        addRule(IMC::OPL_MAX_VRATE, DTR("vertical rate"), IN_VRATE, m_ol.max_vrate, 0.0, false);
+        addRule(IMC::OPL_MAX_ALT, DTR("maximum altitude"), IN_ALTITUDE, m_ol.max_altitude, 0.0, false);
+        addRule(IMC::OPL_MIN_ALT, DTR("minimum altitude"), IN_ALTITUDE, m_ol.min_altitude, m_args.h_min_altitude, true);
+        addRule(IMC::OPL_AREA, DTR("Operational Area"), IN_AREA, 0.0, 0.0, false);
+
+        m_area_sin = std::sin(m_ol.orientation);
+        m_area_cos = std::cos(m_ol.orientation);
+        m_area_valid = false;
+        m_recompiled = true;
+      }
+
       //! Set an op limit to error mode
       //! @param[in] lmask new error bitmask
       //! @param[in] ldesc error description
@@ -234,7 +343,7 @@ namespace Monitors
       {
         m_emask |= lmask;
 
-        LError& le = m_errs[lmask];
+        LError& le = m_errs[bit(lmask)];
         le.desc = ldesc;
         le.v1 = v1;
         le.v2 = v2;
@@ -251,44 +360,66 @@ namespace Monitors
       clearError(uint8_t lmask, const char* ldesc, double v1, double v2)
       {
         m_emask &= ~lmask;
-        m_errs.erase(lmask);
         war(DTR("%s -- operational limit now sane: %0.2f <= %0.2f"), ldesc, v1, v2);
       }
 
-      //! Clear an op limit from error state
-      //! @param[in] lmask new error bitmask
-      //! @param[in] ldesc error description
-      //! @param[in] v1 current value
-      //! @param[in] v2 limit value
-      //! @param[in] hyst hysteresis factor to avoid chattering
-      //! @return true if in error mode
-      bool
-      test(uint8_t lmask, const char* ldesc, double v1, double v2, double hyst = 0.0)
+      //! Index of a limit bit.
+      //! @param[in] lmask limit bit.
+      //! @return bit index.
+      static unsigned
+      bit(uint8_t lmask)
       {
-        if (!(m_ol.mask & lmask))
-          return false;
+        unsigned i = 0;
+        while ((lmask >>= 1) != 0)
+          ++i;
+        return i;
+      }
 
-        bool limit_breached = v1 > v2;
-        bool error = (m_emask & lmask) != 0;
+      //! Evaluate a rule. Errors are only raised or cleared, and the
+      //! corresponding messages only formatted, when the value
+      //! crosses the limit or leaves its hysteresis band.
+      //! @param[in] r rule.
+      //! @param[in] value current value.
+      void
+      evaluate(const Rule& r, double value)
+      {
+        double v1 = r.lower ? r.limit : value;
+        double v2 = r.lower ? value : r.limit;
+        bool error = (m_emask & r.mask) != 0;
 
-        if (limit_breached)
+        if (v1 > v2)
         {
           if (!error)
-          {
-            setError(lmask, ldesc, v1, v2);
-          }
+            setError(r.mask, r.desc, v1, v2);
         }
-        else if (error && (v1 + hyst < v2))
+        else if (error && (v1 + r.hyst < v2))
         {
-          clearError(lmask, ldesc, v1, v2);
+          clearError(r.mask, r.desc, v1, v2);
         }
-        return limit_breached;
       }
 
-      void
-      consume(const IMC::EstimatedState* msg)
+      //! Compute the signed distance to the operational area boundary.
+      //! @param[in] es estimated state.
+      //! @return distance to the boundary, positive if outside.
+      double
+      distanceToArea(const IMC::EstimatedState& es)
       {
-        m_estate = *msg;
+        // The displacement to the navigation origin only changes
+        // when the origin moves.
+        if (!m_area_valid || m_area_lat != es.lat || m_area_lon != es.lon)
+        {
+          WGS84::displacement(m_ol.lat, m_ol.lon, 0, es.lat, es.lon, 0, &m_area_x, &m_area_y);
+          m_area_lat = es.lat;
+          m_area_lon = es.lon;
+          m_area_valid = true;
+        }
+
+        double x0 = m_area_x + es.x;
+        double y0 = m_area_y + es.y;
+        double x = x0 * m_area_cos + y0 * m_area_sin;
+        double y = -x0 * m_area_sin + y0 * m_area_cos;
+
+        return std::max(std::fabs(x) - 0.5 * m_ol.length, std::fabs(y) - 0.5 * m_ol.width);
       }
 
       void
@@ -306,12 +437,14 @@ namespace Monitors
         {
           std::string desc = "";
 
-          for (LErrorMap::iterator itr = m_errs.begin(); itr != m_errs.end(); ++itr)
+          std::stringstream ss;
+          ss << std::fixed << std::setprecision(2);
+          for (unsigned i = 0; i < c_max_rules; ++i)
           {
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(2) << itr->second.desc << ':' << itr->second.v1 << " > " << itr->second.v2 << ';';
-            desc += ss.str();
+            if (m_emask & (1 << i))
+              ss << m_errs[i].desc << ':' << m_errs[i].v1 << " > " << m_errs[i].v2 << ';';
           }
+          desc = ss.str();
 
           setEntityState(IMC::EntityState::ESTA_FAILURE, desc);
         }
@@ -324,51 +457,40 @@ namespace Monitors
       void
       task(void)
       {
-        double speed = std::sqrt(m_estate.vx * m_estate.vx + m_estate.vy * m_estate.vy + m_estate.vz * m_estate.vz);
-        uint8_t omask = m_emask;
+        // Rules only need to be evaluated for new states.
+        if (!m_estate.refresh() && !m_recompiled)
+          return;
 
-        test(IMC::OPL_MIN_SPEED, DTR("minimum speed"), m_ol.min_speed, speed);
-        test(IMC::OPL_MAX_SPEED, DTR("maximum speed"), speed, m_ol.max_speed);
-        test(IMC::OPL_MAX_DEPTH, DTR("depth"), m_estate.depth, m_ol.max_depth, m_args.h_max_depth);
-        test(IMC::OPL_MAX_VRATE, DTR("vertical rate"), std::fabs(m_estate.vz), m_ol.max_vrate);
+        m_recompiled = false;
 
-        if (m_estate.alt >= 0 && m_estate.depth >= m_args.min_depth)
-        {
-          test(IMC::OPL_MAX_ALT, DTR("maximum altitude"), m_estate.alt, m_ol.max_altitude);
-          test(IMC::OPL_MIN_ALT, DTR("minimum altitude"), m_ol.min_altitude, m_estate.alt, m_args.h_min_altitude);
-        }
-        else
-        {
-          // Clear altitude errors if they exist.
-          if (m_emask & IMC::OPL_MAX_ALT)
-          {
-            m_emask &= ~IMC::OPL_MAX_ALT;
-            m_errs.erase(IMC::OPL_MAX_ALT);
-          }
+        const IMC::EstimatedState& es = m_estate.get();
+        uint8_t omask = m_emask;
+        double in[IN_TOTAL];
 
-          if (m_emask & IMC::OPL_MIN_ALT)
-          {
-            m_emask &= ~IMC::OPL_MIN_ALT;
-            m_errs.erase(IMC::OPL_MIN_ALT);
-          }
-        }
+        if (m_inputs & (1 << IN_SPEED))
+          in[IN_SPEED] = std::sqrt(es.vx * es.vx + es.vy * es.vy + es.vz * es.vz);
 
-        if ((m_ol.mask & IMC::OPL_AREA) && (Clock::get() >= m_atest_time))
-        {
-          double x, y;
+        in[IN_DEPTH] = es.depth;
+        in[IN_VRATE] = std::fabs(es.vz);
+        in[IN_ALTITUDE] = es.alt;
 
-          WGS84::displacement(m_ol.lat, m_ol.lon, 0, m_estate.lat, m_estate.lon, 0, &x, &y);
+        if (m_inputs & (1 << IN_AREA))
+          in[IN_AREA] = distanceToArea(es);
 
-          x += m_estate.x;
-          y += m_estate.y;
+        bool check_alt = es.alt >= 0 && es.depth >= m_args.min_depth;
 
-          Angles::rotate(m_ol.orientation, true, x, y);
+        for (unsigned i = 0; i < m_nrules; ++i)
+        {
+          const Rule& r = m_rules[i];
 
-          double d2limits =
-          std::max(std::fabs(x) - 0.5 * m_ol.length, std::fabs(y) - 0.5 * m_ol.width);
-          test(IMC::OPL_AREA, DTR("Operational Area"), d2limits, 0);
+          if (r.input == IN_ALTITUDE && !check_alt)
+          {
+            // Clear altitude errors if they exist.
+            m_emask &= ~r.mask;
+            continue;
+          }
 
-          m_atest_time += c_atest_period;
+          evaluate(r, in[r.input]);
         }
 
         if (m_emask != omask)
@@ -83,9 +83,12 @@ namespace Navigation
       {
         //! Task arguments.
         Arguments m_args;
+        //! Transition matrix workspace.
+        Matrix m_a;
 
         Task(const std::string& name, Tasks::Context& ctx):
-          DUNE::Navigation::BasicNavigation(name, ctx)
+          DUNE::Navigation::BasicNavigation(name, ctx),
+          m_a(NUM_STATE, NUM_STATE, 0.0)
         {
           //! Declare configuration parameters.
           param("Maximum expected currents", m_args.max_current)
@@ -120,6 +123,7 @@ namespace Navigation
 
           // Extended Kalman Filter initialization.
           m_kal.reset(NUM_STATE, NUM_OUT);
+          m_kal.setUpdateMode(KalmanFilter::UPDATE_SEQUENTIAL);
         }
 
         void
@@ -202,7 +206,11 @@ namespace Navigation
           m_kal.setObservation(OUT_LBL, STATE_X, dx / exp_range);
           m_kal.setObservation(OUT_LBL, STATE_Y, dy / exp_range);
 
-          double k = (m_kal.getObservation() * m_kal.getCovariance() * transpose (m_kal.getObservation()))(0);
+          double hx = dx / exp_range;
+          double hy = dy / exp_range;
+          double k = hx * hx * m_kal.getCovariance(STATE_X, STATE_X)
+          + 2.0 * hx * hy * m_kal.getCovariance(STATE_X, STATE_Y)
+          + hy * hy * m_kal.getCovariance(STATE_Y, STATE_Y);
           m_navdata.lbl_rej_level = std::max(getLblRejectionValue(exp_range), k);
 
           m_kal.setMeasurementNoise(OUT_LBL, OUT_LBL, m_navdata.lbl_rej_level);
@@ -269,16 +277,17 @@ namespace Navigation
             m_kal.setProcessNoise(STATE_WY, m_process_noise[1] * tstep);
 
           // Reset and discretize transition matrix function.
-          Matrix a(NUM_STATE, NUM_STATE, 0.0);
-
-          a(STATE_X, STATE_K) = m_rpm * std::cos(m_estate.theta) * std::cos(m_estate.psi);
-          a(STATE_Y, STATE_K) = m_rpm * std::cos(m_estate.theta) * std::sin(m_estate.psi);
-          a(STATE_X, STATE_WX) = 1.0;
-          a(STATE_Y, STATE_WY) = 1.0;
-          m_kal.setTransitions((a * tstep).expmts());
+          m_a.fill(0.0);
+          m_a(STATE_X, STATE_K) = m_rpm * std::cos(m_estate.theta) * std::cos(m_estate.psi);
+          m_a(STATE_Y, STATE_K) = m_rpm * std::cos(m_estate.theta) * std::sin(m_estate.psi);
+          m_a(STATE_X, STATE_WX) = 1.0;
+          m_a(STATE_Y, STATE_WY) = 1.0;
+          m_kal.setTransitions((m_a * tstep).expmts());
 
           // Run EKF prediction.
+          profileBegin(PROFILE_PREDICT);
           m_kal.predict();
+          profileEnd(PROFILE_PREDICT);
 
           checkUncertainty();
 
@@ -156,10 +156,13 @@ namespace Navigation
         MovingAverage<double>* m_avg_speed;
         //! Task arguments.
         Arguments m_args;
+        //! Transition matrix workspace.
+        Matrix m_a;
 
         Task(const std::string& name, Tasks::Context& ctx):
           DUNE::Navigation::BasicNavigation(name, ctx),
-          m_avg_speed(NULL)
+          m_avg_speed(NULL),
+          m_a(NUM_STATE, NUM_STATE, 0.0)
         {
           // Declare configuration parameters.
           param("Position Noise Covariance with IMU", m_args.position_noise_with_imu)
@@ -219,6 +222,7 @@ namespace Navigation
 
           // Extended Kalman Filter initialization.
           m_kal.reset(NUM_STATE, NUM_OUT);
+          m_kal.setUpdateMode(KalmanFilter::UPDATE_SEQUENTIAL);
           resetKalman();
 
           // Register callbacks
@@ -487,26 +491,26 @@ namespace Navigation
 
           // Kalman Filter
           // Reset and Discretize A matrix
-          Matrix a(NUM_STATE, NUM_STATE, 0.0);
-          setTransition(a);
+          setTransition(m_a);
 
-          Matrix x(NUM_STATE, 1, 0.0);
-          x = m_kal.getState();
+          const Matrix x = m_kal.getState();
 
-          m_kal.setStateTransition((a * tstep).expmts());
+          m_kal.setStateTransition((m_a * tstep).expmts());
 
           // Modify covariance state transition matrix.
           double yaw = m_kal.getState(STATE_PSI);
 
-          a(STATE_X, STATE_PSI) = (- x(STATE_U) * std::sin(yaw)
-                                   - x(STATE_V) * std::cos(yaw));
-          a(STATE_Y, STATE_PSI) = (x(STATE_U) * std::cos(yaw)
-                                   - x(STATE_V) * std::sin(yaw));
+          m_a(STATE_X, STATE_PSI) = (- x(STATE_U) * std::sin(yaw)
+                                     - x(STATE_V) * std::cos(yaw));
+          m_a(STATE_Y, STATE_PSI) = (x(STATE_U) * std::cos(yaw)
+                                     - x(STATE_V) * std::sin(yaw));
 
-          m_kal.setCovarianceTransition((a * tstep).expmts());
+          m_kal.setCovarianceTransition((m_a * tstep).expmts());
 
           // Kalman Prediction.
+          profileBegin(PROFILE_PREDICT);
           m_kal.predict();
+          profileEnd(PROFILE_PREDICT);
 
           // Euler Angles update modes.
           double hrate = getHeadingRate();
@@ -541,7 +545,9 @@ namespace Navigation
           // Speed innovation matrix.
           if (m_valid_gv || m_valid_wv)
           {
+            profileBegin(PROFILE_DVL);
             runKalmanDVL();
+            profileEnd(PROFILE_DVL);
             m_kal.setInnovation(OUT_U, m_kal.getOutput(OUT_U) - m_kal.getState(STATE_U));
             m_kal.setInnovation(OUT_V, m_kal.getOutput(OUT_V) - m_kal.getState(STATE_V));
           }
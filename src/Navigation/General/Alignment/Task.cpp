@@ -197,7 +197,15 @@ namespace Navigation
           {
             war(DTR("failed to resolve entity '%s': %s"), m_args.elabel_imu.c_str(), e.what());
             m_imu_eid = UINT_MAX;
+            return;
           }
+
+          // Only the IMU's measurements are of interest.
+          IMC::SubscriptionFilter imu;
+          imu.setSourceEntity(m_imu_eid);
+          bind<IMC::Acceleration>(this, imu);
+          bind<IMC::AngularVelocity>(this, imu);
+          bind<IMC::EntityActivationState>(this, imu);
         }
 
         void
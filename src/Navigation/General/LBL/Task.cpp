@@ -66,6 +66,12 @@ namespace Navigation
         std::vector<float> k_rej;
         //! Distance between LBL and GPS.
         float dist_lbl_gps;
+        //! Beacon position estimator.
+        std::string estimator;
+        //! Number of ranges of the batch estimator.
+        unsigned batch_window;
+        //! Huber loss threshold of the batch estimator.
+        float batch_loss_scale;
       };
 
       struct Task: public Tasks::Task
@@ -90,6 +96,8 @@ namespace Navigation
         Time::Counter<double> m_time_without_gps;
         //! Kalman Filter matrices.
         KalmanFilter m_kal;
+        //! Batch position estimators.
+        DUNE::Navigation::Trilateration m_batch[DUNE::Navigation::c_max_transponders];
         //! Task arguments.
         Arguments m_args;
 
@@ -139,6 +147,24 @@ namespace Navigation
           .minimumValue("0.0")
           .description("Distance between LBL receiver and GPS in the vehicle");
 
+          param("Estimator", m_args.estimator)
+          .defaultValue("Kalman Filter")
+          .values("Kalman Filter, Batch")
+          .description("Beacon position estimator. 'Batch' solves a robust least"
+                       " squares problem over the most recent ranges of each beacon");
+
+          param("Batch Window", m_args.batch_window)
+          .defaultValue("32")
+          .minimumValue("3")
+          .description("Number of recent ranges used by the batch estimator");
+
+          param("Batch Loss Scale", m_args.batch_loss_scale)
+          .units(Units::Meter)
+          .defaultValue("5.0")
+          .minimumValue("0.1")
+          .description("Range residual above which the batch estimator"
+                       " reduces the weight of a range");
+
           for (unsigned i = 0; i < DUNE::Navigation::c_max_transponders; ++i)
             m_estimate[i] = NULL;
 
@@ -268,6 +294,12 @@ namespace Navigation
 
           float range = msg->range;
 
+          if (m_args.estimator == "Batch")
+          {
+            updateBatch(msg->id, range);
+            return;
+          }
+
           double dx = m_args.dist_lbl_gps * std::cos(m_yaw) - m_last_n + m_kal.getState(msg->id * 2);
           double dy = m_args.dist_lbl_gps * std::sin(m_yaw) - m_last_e + m_kal.getState(msg->id * 2 + 1);
           double dz = m_ranging.getDepth(msg->id) - m_last_depth;
@@ -300,33 +332,8 @@ namespace Navigation
             // Run Kalman Filter.
             m_kal.update(0.0);
 
-            // Use displacement to get current position fix.
-            double x = m_kal.getState(msg->id * 2);
-            double y = m_kal.getState(msg->id * 2 + 1);
-
-            double lat = m_origin->lat;
-            double lon = m_origin->lon;
-            Coordinates::WGS84::displace(x, y, &lat, &lon);
-
-            // Update estimate.
-            m_estimate[msg->id]->beacon->lat = lat;
-            m_estimate[msg->id]->beacon->lon = lon;
-            m_estimate[msg->id]->x = m_kal.getState(msg->id * 2);
-            m_estimate[msg->id]->y = m_kal.getState(msg->id * 2 + 1);
-            m_estimate[msg->id]->var_x = m_kal.getCovariance(msg->id * 2);
-            m_estimate[msg->id]->var_y = m_kal.getCovariance(msg->id * 2 + 1);
-            m_estimate[msg->id]->distance = Coordinates::WGS84::distance(lat, lon, 0.0, m_ranging.getLat(msg->id),
-                                                                         m_ranging.getLon(msg->id), 0.0);
-            dispatch(m_estimate[msg->id]);
-
-            spew("beacon %d WGS: %f | %f", msg->id, lat, lon);
-            spew("beacon %d COV: %f | %f", msg->id,
-                 std::sqrt(m_estimate[msg->id]->var_x),
-                 std::sqrt(m_estimate[msg->id]->var_y));
-            spew("beacon %d NE: %f | %f :: distance: %f", msg->id,
-                 m_estimate[msg->id]->x, m_estimate[msg->id]->y,
-                 m_estimate[msg->id]->distance);
-
+            updateEstimate(msg->id, m_kal.getState(msg->id * 2), m_kal.getState(msg->id * 2 + 1),
+                           m_kal.getCovariance(msg->id * 2), m_kal.getCovariance(msg->id * 2 + 1));
           }
           else
             spew("rejected range from %d", msg->id);
@@ -334,6 +341,79 @@ namespace Navigation
           m_kal.resetOutputs();
         }
 
+        //! Update the batch estimator of a beacon with a new range.
+        //! @param[in] id beacon id.
+        //! @param[in] range measured range.
+        void
+        updateBatch(unsigned id, float range)
+        {
+          DUNE::Navigation::Trilateration& batch = m_batch[id];
+
+          // Position of the LBL transducer.
+          double ax = m_last_n - m_args.dist_lbl_gps * std::cos(m_yaw);
+          double ay = m_last_e - m_args.dist_lbl_gps * std::sin(m_yaw);
+
+          // Same rejection scheme of the Kalman filter, using the
+          // variance of the batch solution.
+          if (batch.hasSolution())
+          {
+            double exp_range = batch.getExpectedRange(ax, ay, m_last_depth);
+            if (exp_range > 0)
+            {
+              double hx = (batch.getX() - ax) / exp_range;
+              double hy = (batch.getY() - ay) / exp_range;
+              double hph = hx * hx * batch.getVarianceX() + hy * hy * batch.getVarianceY();
+              double reject = m_args.k_rej[0] + m_args.k_rej[1] * std::pow(exp_range, 2);
+              double d = range - exp_range;
+
+              if (d * d / (hph + std::max(reject, hph)) >= m_args.lbl_threshold)
+              {
+                spew("rejected range from %u", id);
+                return;
+              }
+            }
+          }
+
+          if (!batch.add(ax, ay, m_last_depth, range))
+            return;
+
+          updateEstimate(id, batch.getX(), batch.getY(), batch.getVarianceX(), batch.getVarianceY());
+        }
+
+        //! Dispatch the position estimate of a beacon.
+        //! @param[in] id beacon id.
+        //! @param[in] x North displacement.
+        //! @param[in] y East displacement.
+        //! @param[in] var_x variance of North displacement.
+        //! @param[in] var_y variance of East displacement.
+        void
+        updateEstimate(unsigned id, double x, double y, double var_x, double var_y)
+        {
+          // Use displacement to get current position fix.
+          double lat = m_origin->lat;
+          double lon = m_origin->lon;
+          Coordinates::WGS84::displace(x, y, &lat, &lon);
+
+          // Update estimate.
+          m_estimate[id]->beacon->lat = lat;
+          m_estimate[id]->beacon->lon = lon;
+          m_estimate[id]->x = x;
+          m_estimate[id]->y = y;
+          m_estimate[id]->var_x = var_x;
+          m_estimate[id]->var_y = var_y;
+          m_estimate[id]->distance = Coordinates::WGS84::distance(lat, lon, 0.0, m_ranging.getLat(id),
+                                                                  m_ranging.getLon(id), 0.0);
+          dispatch(m_estimate[id]);
+
+          spew("beacon %u WGS: %f | %f", id, lat, lon);
+          spew("beacon %u COV: %f | %f", id,
+               std::sqrt(m_estimate[id]->var_x),
+               std::sqrt(m_estimate[id]->var_y));
+          spew("beacon %u NE: %f | %f :: distance: %f", id,
+               m_estimate[id]->x, m_estimate[id]->y,
+               m_estimate[id]->distance);
+        }
+
         //! Setup filter.
         //! @return true if successful, false otherwise.
         void
@@ -367,6 +447,11 @@ namespace Navigation
 
             m_kal.setState(i * 2, x);
             m_kal.setState(i * 2 + 1, y);
+
+            m_batch[i].setWindow(m_args.batch_window);
+            m_batch[i].setLossScale(m_args.batch_loss_scale);
+            m_batch[i].setDepth(z);
+            m_batch[i].reset(x, y);
           }
 
           setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
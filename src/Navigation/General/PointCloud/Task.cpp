@@ -0,0 +1,286 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+namespace Navigation
+{
+  namespace General
+  {
+    //! Seafloor point cloud decimation.
+    //!
+    //! This task georeferences the beams of distance sensors
+    //! (echosounders, altimeters, DVL and multibeam beams) with the
+    //! current navigation state and accumulates the seafloor points
+    //! in a sparse voxel grid. Voxels changed since the last cloud
+    //! are periodically dispatched, as their centroids, in a
+    //! PointCloud message.
+    //!
+    //! @author Ricardo Martins
+    namespace PointCloud
+    {
+      //! Maximum age of the navigation state used to georeference beams.
+      static const double c_max_state_age = 1.0;
+
+      //! %Task arguments.
+      struct Arguments
+      {
+        //! Entity labels of distance sensors.
+        std::vector<std::string> elabels;
+        //! Voxel size.
+        double voxel;
+        //! Maximum number of voxels.
+        unsigned max_voxels;
+        //! Period of point clouds.
+        double period;
+        //! Maximum number of points per cloud.
+        unsigned max_points;
+      };
+
+      struct Task: public Tasks::Task
+      {
+        //! Task arguments.
+        Arguments m_args;
+        //! Entity ids of distance sensors.
+        std::vector<unsigned> m_eids;
+        //! Voxel grid.
+        DUNE::Navigation::VoxelGrid* m_grid;
+        //! Last navigation state.
+        IMC::EstimatedState m_estate;
+        //! Time of last navigation state.
+        double m_estate_time;
+        //! Point cloud.
+        IMC::PointCloud m_cloud;
+        //! Point cloud timer.
+        Time::Counter<double> m_timer;
+        //! Centroids of the next cloud.
+        std::vector<DUNE::Navigation::VoxelGrid::Point> m_points;
+        //! Number of discarded points.
+        unsigned m_discarded;
+
+        Task(const std::string& name, Tasks::Context& ctx):
+          Tasks::Task(name, ctx),
+          m_grid(NULL),
+          m_estate_time(-1.0),
+          m_discarded(0)
+        {
+          param("Entity Labels - Distance", m_args.elabels)
+          .defaultValue("")
+          .description("Entity labels of the distance sensors");
+
+          param("Voxel Size", m_args.voxel)
+          .defaultValue("1.0")
+          .minimumValue("0.05")
+          .units(Units::Meter)
+          .description("Edge length of the voxels");
+
+          param("Maximum Voxels", m_args.max_voxels)
+          .defaultValue("500000")
+          .description("Maximum number of voxels kept in memory");
+
+          param("Cloud Period", m_args.period)
+          .defaultValue("10.0")
+          .units(Units::Second)
+          .description("Period of point clouds");
+
+          param("Maximum Points Per Cloud", m_args.max_points)
+          .defaultValue("500")
+          .minimumValue("1")
+          .description("Maximum number of points in one point cloud");
+
+          bind<IMC::Distance>(this);
+          bind<IMC::EstimatedState>(this);
+        }
+
+        void
+        onUpdateParameters(void)
+        {
+          m_timer.setTop(m_args.period);
+        }
+
+        void
+        onEntityResolution(void)
+        {
+          m_eids.clear();
+          for (unsigned i = 0; i < m_args.elabels.size(); ++i)
+          {
+            try
+            {
+              m_eids.push_back(resolveEntity(m_args.elabels[i]));
+            }
+            catch (...)
+            {
+              war(DTR("distance sensor '%s' not found"), m_args.elabels[i].c_str());
+            }
+          }
+        }
+
+        void
+        onResourceAcquisition(void)
+        {
+          m_grid = new DUNE::Navigation::VoxelGrid(m_args.voxel, m_args.max_voxels);
+          m_cloud.voxel = m_args.voxel;
+        }
+
+        void
+        onResourceRelease(void)
+        {
+          Memory::clear(m_grid);
+        }
+
+        void
+        consume(const IMC::EstimatedState* msg)
+        {
+          if (msg->getSource() != getSystemId())
+            return;
+
+          // The grid is anchored at the first navigation reference.
+          if (m_estate_time < 0)
+          {
+            m_cloud.lat = msg->lat;
+            m_cloud.lon = msg->lon;
+          }
+
+          m_estate = *msg;
+          m_estate_time = Clock::get();
+        }
+
+        void
+        consume(const IMC::Distance* msg)
+        {
+          if (msg->validity != IMC::Distance::DV_VALID)
+            return;
+
+          if (std::find(m_eids.begin(), m_eids.end(), msg->getSourceEntity()) == m_eids.end())
+            return;
+
+          if (m_estate_time < 0 || Clock::get() - m_estate_time > c_max_state_age)
+            return;
+
+          // Beam axis in the vehicle frame, pointing down by default.
+          double bx = 0.0;
+          double by = 0.0;
+          double bz = msg->value;
+
+          if (msg->location.size() > 0)
+          {
+            const IMC::DeviceState* dev = *msg->location.begin();
+            BodyFixedFrame::toInertialFrame(dev->phi, dev->theta, dev->psi,
+                                            0.0, 0.0, (double)msg->value,
+                                            &bx, &by, &bz);
+            bx += dev->x;
+            by += dev->y;
+            bz += dev->z;
+          }
+
+          double n = 0.0;
+          double e = 0.0;
+          double d = 0.0;
+          BodyFixedFrame::toInertialFrame(m_estate.phi, m_estate.theta, m_estate.psi,
+                                          bx, by, bz, &n, &e, &d);
+
+          // Offsets of the vehicle from the grid origin.
+          double lat = 0.0;
+          double lon = 0.0;
+          Coordinates::toWGS84(m_estate, lat, lon);
+
+          double vn = 0.0;
+          double ve = 0.0;
+          WGS84::displacement(m_cloud.lat, m_cloud.lon, 0.0, lat, lon, 0.0, &vn, &ve);
+
+          if (!m_grid->add(vn + n, ve + e, m_estate.depth + d))
+          {
+            if (m_discarded++ == 0)
+              war(DTR("voxel grid is full, discarding new points"));
+          }
+        }
+
+        //! Write a little-endian fp32_t.
+        //! @param[in] value value.
+        //! @param[out] dst destination buffer.
+        //! @return number of bytes written.
+        static unsigned
+        packFloat(double value, uint8_t* dst)
+        {
+          fp32_t f = (fp32_t)value;
+          uint32_t bits = 0;
+          std::memcpy(&bits, &f, sizeof(bits));
+          return ByteCopy::toLE(bits, dst);
+        }
+
+        //! Dispatch the centroids of changed voxels.
+        void
+        dispatchCloud(void)
+        {
+          m_points.clear();
+          m_grid->takeChanged(m_points, m_args.max_points);
+          if (m_points.empty())
+            return;
+
+          m_cloud.points.resize(m_points.size() * 12);
+          uint8_t* ptr = (uint8_t*)&m_cloud.points[0];
+          for (size_t i = 0; i < m_points.size(); ++i)
+          {
+            ptr += packFloat(m_points[i].x, ptr);
+            ptr += packFloat(m_points[i].y, ptr);
+            ptr += packFloat(m_points[i].z, ptr);
+          }
+
+          dispatch(m_cloud);
+
+          debug("dispatched %u points, %u voxels, %u pending",
+                (unsigned)m_points.size(), m_grid->getVoxels(), m_grid->getChanged());
+        }
+
+        void
+        onMain(void)
+        {
+          while (!stopping())
+          {
+            waitForMessages(1.0);
+
+            if (m_timer.overflow())
+            {
+              m_timer.reset();
+              dispatchCloud();
+            }
+          }
+        }
+      };
+    }
+  }
+}
+
+DUNE_TASK
@@ -289,7 +289,9 @@ namespace Navigation
           m_kal.setStateTransition((a * tstep).expmts());
 
           // Kalman Prediction.
+          profileBegin(PROFILE_PREDICT);
           m_kal.predict();
+          profileEnd(PROFILE_PREDICT);
 
           // GPS innovation matrix.
           if (m_gps_reading)
@@ -308,7 +310,9 @@ namespace Navigation
           // Speed innovation matrix.
           if (m_valid_gv || m_valid_wv)
           {
+            profileBegin(PROFILE_DVL);
             runKalmanDVL();
+            profileEnd(PROFILE_DVL);
             m_kal.setInnovation(OUT_U, m_kal.getOutput(OUT_U) - m_kal.getState(STATE_U));
             m_kal.setInnovation(OUT_V, m_kal.getOutput(OUT_V) - m_kal.getState(STATE_V));
           }
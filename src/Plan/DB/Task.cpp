@@ -27,6 +27,8 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <map>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -56,6 +58,7 @@ namespace Plan
     "select change_time, change_sid, change_sname, md5, length(data)"
     "from Plan where plan_id=?";
     static const char* c_get_plan_stmt = "select data from Plan where plan_id=?";
+    static const char* c_get_all_plans_stmt = "select data from Plan order by plan_id";
     static const char* c_delete_all_plans_stmt = "delete from Plan";
 
     static const char* c_lastchange_table_stmt =
@@ -73,7 +76,8 @@ namespace Plan
     static const char* c_op_desc[] = {DTR_RT("set plan"), DTR_RT("delete plan"),
                                       DTR_RT("get plan"), DTR_RT("get plan info"),
                                       DTR_RT("clear database"), DTR_RT("database state"),
-                                      DTR_RT("database initialization")};
+                                      DTR_RT("database state"), DTR_RT("database initialization"),
+                                      DTR_RT("set plans"), DTR_RT("get plans")};
 
     struct Arguments
     {
@@ -81,6 +85,14 @@ namespace Plan
       bool trace;
       // Path to DB file
       std::string db_path;
+      // SQLite journal mode.
+      std::string journal_mode;
+      // Maximum time changes are kept in a transaction.
+      double batch_window;
+      // Maximum number of changes in a transaction.
+      unsigned batch_size;
+      // Period of background WAL checkpoints.
+      double checkpoint_period;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -93,22 +105,23 @@ namespace Plan
       IMC::PlanDB m_reply;
       // In progress reply message.
       IMC::PlanDBInformation m_plan_info;
-      // Statements
-      Database::Statement* m_insert_plan_stmt;
-      Database::Statement* m_delete_plan_stmt;
-      Database::Statement* m_plan_iterator_stmt;
-      Database::Statement* m_query_plan_stmt;
-      Database::Statement* m_get_plan_stmt;
-      Database::Statement* m_delete_all_plans_stmt;
-      Database::Statement* m_lastchange_update_stmt;
-      Database::Statement* m_lastchange_query_stmt;
       // Local request counter
       uint16_t m_local_reqid;
+      // True if a transaction is open.
+      bool m_in_batch;
+      // Time at which the open transaction must be committed.
+      double m_batch_deadline;
+      // Success replies waiting for the open transaction to commit.
+      std::vector<IMC::PlanDB*> m_pending;
+      // Stored plans that were already read or written.
+      std::map<std::string, IMC::PlanSpecification*> m_plans;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
         m_db(NULL),
-        m_local_reqid(0)
+        m_local_reqid(0),
+        m_in_batch(false),
+        m_batch_deadline(0)
       {
         param("Trace", m_args.trace)
         .defaultValue("false")
@@ -118,6 +131,30 @@ namespace Plan
         .defaultValue("")
         .description("Path to DB file");
 
+        param("Journal Mode", m_args.journal_mode)
+        .defaultValue("WAL")
+        .values("DELETE, WAL")
+        .description("SQLite journal mode. With WAL, commits do not"
+                     " synchronize the database file");
+
+        param("Batch Window", m_args.batch_window)
+        .defaultValue("0.1")
+        .units(Units::Second)
+        .description("Maximum time changes are kept in a transaction"
+                     " before being committed and acknowledged");
+
+        param("Batch Size", m_args.batch_size)
+        .defaultValue("32")
+        .minimumValue("1")
+        .description("Maximum number of changes committed in a single transaction");
+
+        param("Checkpoint Period", m_args.checkpoint_period)
+        .defaultValue("5.0")
+        .minimumValue("0.0")
+        .units(Units::Second)
+        .description("Period of background checkpoints of the WAL journal."
+                     " Zero lets commits checkpoint the journal themselves");
+
         bind<IMC::PlanControl>(this);
         bind<IMC::PlanDB>(this);
         bind<IMC::PowerOperation>(this);
@@ -144,23 +181,22 @@ namespace Plan
 
         inf(DTR("database file: '%s'"), db_file.c_str());
 
-        m_db = new Database::Connection(db_file.c_str(), true);
+        Database::Connection::Options options;
+        options.journal_mode = m_args.journal_mode;
+        if (m_args.journal_mode == "WAL")
+        {
+          options.synchronous = "NORMAL";
+          options.checkpoint_period = m_args.checkpoint_period;
+        }
+
+        m_db = new Database::Connection(db_file.c_str(), true, options);
 
-        // Create Plan table and initialize associated statements
+        // Create Plan and LastChange tables.
         m_db->execute(c_plan_table_stmt);
-        m_insert_plan_stmt = new Database::Statement(c_insert_plan_stmt, *m_db);
-        m_delete_plan_stmt = new Database::Statement(c_delete_plan_stmt, *m_db);
-        m_plan_iterator_stmt = new Database::Statement(c_plan_iterator_stmt, *m_db);
-        m_query_plan_stmt = new Database::Statement(c_query_plan_stmt, *m_db);
-        m_get_plan_stmt = new Database::Statement(c_get_plan_stmt, *m_db);
-        m_delete_all_plans_stmt = new Database::Statement(c_delete_all_plans_stmt, *m_db);
-
-        // Create Plan table and initialize associated statements
         m_db->execute(c_lastchange_table_stmt);
-        m_lastchange_update_stmt = new Database::Statement(c_lastchange_update_stmt, *m_db);
-        m_lastchange_query_stmt = new Database::Statement(c_lastchange_query_stmt, *m_db);
 
-        if (!m_lastchange_query_stmt->execute())
+        Database::Statement& lastchange_query = m_db->prepare(c_lastchange_query_stmt);
+        if (!lastchange_query.execute())
         {
           Database::Statement initial_insert("insert into LastChange values(?,?,?)", *m_db);
           double now = Clock::getSinceEpoch();
@@ -168,7 +204,7 @@ namespace Plan
           initial_insert.execute();
         }
 
-        m_lastchange_query_stmt->reset();
+        lastchange_query.reset();
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
 
@@ -181,14 +217,9 @@ namespace Plan
         if (m_db == NULL)
           return;
 
-        delete m_insert_plan_stmt;
-        delete m_delete_plan_stmt;
-        delete m_plan_iterator_stmt;
-        delete m_query_plan_stmt;
-        delete m_get_plan_stmt;
-        delete m_delete_all_plans_stmt;
-        delete m_lastchange_update_stmt;
-        delete m_lastchange_query_stmt;
+        commitBatch();
+        clearPlans();
+
         delete m_db;
 
         m_db = NULL;
@@ -269,6 +300,10 @@ namespace Plan
           return;
         }
 
+        // Replies to reads follow the replies to earlier changes.
+        if (!isChange(req->op))
+          commitBatch();
+
         try
         {
           // Handle requested operation
@@ -277,6 +312,14 @@ namespace Plan
             case IMC::PlanDB::DBOP_SET:
               setPlan(*req);
               break;
+            case IMC::PlanDB::DBOP_SET_BULK:
+              m_reply.plan_id.clear();
+              setPlans(*req);
+              break;
+            case IMC::PlanDB::DBOP_GET_BULK:
+              m_reply.plan_id.clear();
+              getPlans(*req);
+              break;
             case IMC::PlanDB::DBOP_DEL:
               deletePlan(*req);
               break;
@@ -323,8 +366,9 @@ namespace Plan
         // Update LastChange table information.
         int count = 0;
 
-        *m_lastchange_update_stmt << time << sid << sname;
-        m_lastchange_update_stmt->execute(&count);
+        Database::Statement& lastchange_update = m_db->prepare(c_lastchange_update_stmt);
+        lastchange_update << time << sid << sname;
+        lastchange_update.execute(&count);
 
         if (count != 1)
           throw std::runtime_error(DTR("database is corrupt"));
@@ -359,7 +403,51 @@ namespace Plan
       }
 
       void
-      storeInDB(const IMC::PlanSpecification* spec)
+      setPlans(const IMC::PlanDB& req)
+      {
+        const IMC::PlanDBBulk* bulk = 0;
+
+        if (!req.arg.get(bulk))
+        {
+          onFailure(DTR("no plans given"));
+          return;
+        }
+
+        IMC::MessageList<IMC::PlanSpecification>::const_iterator itr = bulk->plans.begin();
+        for (; itr != bulk->plans.end(); ++itr)
+        {
+          if (*itr == NULL || (*itr)->plan_id.empty())
+          {
+            onFailure(DTR("undefined plan id"));
+            return;
+          }
+        }
+
+        inProgress();
+
+        try
+        {
+          beginBatch();
+
+          for (itr = bulk->plans.begin(); itr != bulk->plans.end(); ++itr)
+            store(*itr);
+        }
+        catch (std::runtime_error& e)
+        {
+          rollbackBatch();
+          onFailure(e.what());
+          return;
+        }
+
+        onSuccess(String::str(DTR("OK (%u plans)"), (unsigned)bulk->plans.size()).c_str());
+        checkBatch();
+      }
+
+      //! Write a plan in the open transaction.
+      //! @param[in] spec plan specification.
+      //! @return true if a previous plan was replaced.
+      bool
+      store(const IMC::PlanSpecification* spec)
       {
         m_plan_info.plan_size = spec->getPayloadSerializationSize();
         m_plan_info.plan_id = spec->plan_id;
@@ -373,37 +461,50 @@ namespace Plan
         m_plan_info.md5.resize(16);
         MD5::compute((uint8_t*)&plan_data[0], m_plan_info.plan_size, (uint8_t*)&m_plan_info.md5[0]);
 
-        m_db->beginTransaction();
-
         int count = 0;
+        Database::Statement& delete_plan = m_db->prepare(c_delete_plan_stmt);
+        delete_plan << m_plan_info.plan_id;
+        delete_plan.execute(&count);
+        delete_plan.reset();
+
+        Database::Statement& insert_plan = m_db->prepare(c_insert_plan_stmt);
+        insert_plan << m_plan_info.plan_id
+                    << m_plan_info.change_time
+                    << m_plan_info.change_sid
+                    << m_plan_info.change_sname
+                    << m_plan_info.md5
+                    << plan_data;
+        insert_plan.execute();
+        onChange(m_plan_info.change_time, m_plan_info.change_sid, m_plan_info.change_sname);
+
+        cachePlan(static_cast<IMC::PlanSpecification*>(spec->clone()));
+
+        return count != 0;
+      }
+
+      void
+      storeInDB(const IMC::PlanSpecification* spec)
+      {
+        bool updated = false;
+
         try
         {
-          *m_delete_plan_stmt << m_plan_info.plan_id;
-          m_delete_plan_stmt->execute(&count);
-          m_delete_plan_stmt->reset();
-
-          *m_insert_plan_stmt << m_plan_info.plan_id
-                              << m_plan_info.change_time
-                              << m_plan_info.change_sid
-                              << m_plan_info.change_sname
-                              << m_plan_info.md5
-                              << plan_data;
-          m_insert_plan_stmt->execute();
-          onChange(m_plan_info.change_time, m_plan_info.change_sid, m_plan_info.change_sname);
+          beginBatch();
+          updated = store(spec);
         }
         catch (std::runtime_error& e)
         {
+          rollbackBatch();
           onFailure(e.what());
-          m_db->rollback();
+          return;
         }
 
-        m_db->commit();
-
         if (m_args.trace)
           m_plan_info.toText(std::cerr);
 
         m_reply.arg.set(m_plan_info);
-        onSuccess(count ? DTR("OK (updated)") : DTR("OK (new entry)"));
+        onSuccess(updated ? DTR("OK (updated)") : DTR("OK (new entry)"));
+        checkBatch();
       }
 
       void
@@ -416,29 +517,36 @@ namespace Plan
         }
 
         inProgress();
-        m_db->beginTransaction();
 
         int count = 0;
         try
         {
-          *m_delete_plan_stmt << req.plan_id;
-          m_delete_plan_stmt->execute(&count);
+          beginBatch();
+
+          Database::Statement& delete_plan = m_db->prepare(c_delete_plan_stmt);
+          delete_plan << req.plan_id;
+          delete_plan.execute(&count);
           if (count)
             onChange(req);
         }
         catch (std::runtime_error& e)
         {
+          rollbackBatch();
           onFailure(e.what());
-          m_db->rollback();
           return;
         }
 
-        m_db->commit();
+        uncachePlan(req.plan_id);
 
         if (!count)
+        {
           onFailure(DTR("undefined plan"));
+        }
         else
+        {
           onSuccess();
+          checkBatch();
+        }
       }
 
       void
@@ -450,30 +558,61 @@ namespace Plan
           return;
         }
 
-        *m_get_plan_stmt << req.plan_id;
+        std::map<std::string, IMC::PlanSpecification*>::const_iterator itr = m_plans.find(req.plan_id);
 
-        bool found = m_get_plan_stmt->execute();
+        if (itr == m_plans.end())
+        {
+          Database::Statement& get_plan = m_db->prepare(c_get_plan_stmt);
+          get_plan << req.plan_id;
 
+          bool found = get_plan.execute();
+
+          if (!found)
+          {
+            onFailure(DTR("undefined plan"));
+            return;
+          }
 
-        if (!found)
-        {
-          onFailure(DTR("undefined plan"));
-        }
-        else
-        {
           Database::Blob data;
-          *m_get_plan_stmt >> data;
+          get_plan >> data;
+          get_plan.reset();
 
           IMC::PlanSpecification* spec = new IMC::PlanSpecification;
           spec->deserializeFields((const uint8_t*)&data[0], data.size());
-          m_reply.arg.set(spec);
+          itr = cachePlan(spec);
+        }
 
-          if (m_args.trace)
-            spec->toText(std::cerr);
+        m_reply.arg.set(*itr->second);
 
-          onSuccess();
+        if (m_args.trace)
+          itr->second->toText(std::cerr);
+
+        onSuccess();
+      }
+
+      void
+      getPlans(const IMC::PlanDB& req)
+      {
+        (void)req;
+
+        // Fill the reply in place instead of copying a bulk of plans.
+        IMC::PlanDBBulk* bulk = NULL;
+        m_reply.arg.set(IMC::PlanDBBulk());
+        m_reply.arg.get(bulk);
+
+        Database::Statement& get_all_plans = m_db->prepare(c_get_all_plans_stmt);
+        while (get_all_plans.execute())
+        {
+          Database::Blob data;
+          get_all_plans >> data;
+
+          IMC::PlanSpecification* spec = new IMC::PlanSpecification;
+          spec->deserializeFields((const uint8_t*)&data[0], data.size());
+          bulk->plans.push_back(*spec);
+          cachePlan(spec);
         }
-        m_get_plan_stmt->reset();
+
+        onSuccess(String::str(DTR("OK (%u plans)"), (unsigned)bulk->plans.size()).c_str());
       }
 
       void
@@ -485,9 +624,10 @@ namespace Plan
           return;
         }
 
-        *m_query_plan_stmt << req.plan_id;
+        Database::Statement& query_plan = m_db->prepare(c_query_plan_stmt);
+        query_plan << req.plan_id;
 
-        bool found = m_query_plan_stmt->execute();
+        bool found = query_plan.execute();
 
         if (!found)
         {
@@ -496,14 +636,14 @@ namespace Plan
         }
 
         m_plan_info.plan_id = req.plan_id;
-        *m_query_plan_stmt >> m_plan_info.change_time
-                           >> m_plan_info.change_sid
-                           >> m_plan_info.change_sname
-                           >> m_plan_info.md5
-                           >> m_plan_info.plan_size;
+        query_plan >> m_plan_info.change_time
+                   >> m_plan_info.change_sid
+                   >> m_plan_info.change_sname
+                   >> m_plan_info.md5
+                   >> m_plan_info.plan_size;
 
         m_reply.arg.set(m_plan_info);
-        m_query_plan_stmt->reset();
+        query_plan.reset();
 
         if (m_args.trace)
           m_plan_info.toText(std::cerr);
@@ -515,22 +655,24 @@ namespace Plan
       clearDatabase(const IMC::PlanDB& req)
       {
         inProgress();
-        m_db->beginTransaction();
 
         try
         {
-          m_delete_all_plans_stmt->execute();
+          beginBatch();
+          Database::Statement& delete_all_plans = m_db->prepare(c_delete_all_plans_stmt);
+          delete_all_plans.execute();
           onChange(req);
         }
         catch (std::runtime_error& e)
         {
+          rollbackBatch();
           onFailure(e.what());
-          m_db->rollback();
           return;
         }
 
-        m_db->commit();
+        clearPlans();
         onSuccess();
+        checkBatch();
       }
 
       void
@@ -546,16 +688,17 @@ namespace Plan
 
         IMC::MessageList<PlanDBInformation>* plandbinfo = &state->plans_info;
 
-        while (m_plan_iterator_stmt->execute())
+        Database::Statement& plan_iterator = m_db->prepare(c_plan_iterator_stmt);
+        while (plan_iterator.execute())
         {
           IMC::PlanDBInformation* pinfo = new IMC::PlanDBInformation;
 
-          *m_plan_iterator_stmt >> pinfo->plan_id
-                                >> pinfo->change_time
-                                >> pinfo->change_sid
-                                >> pinfo->change_sname
-                                >> pinfo->md5
-                                >> pinfo->plan_size;
+          plan_iterator >> pinfo->plan_id
+                        >> pinfo->change_time
+                        >> pinfo->change_sid
+                        >> pinfo->change_sname
+                        >> pinfo->md5
+                        >> pinfo->plan_size;
 
           md5sum.update((const uint8_t*)&pinfo->md5[0], 16); // the MD5 of all MD5s ordered by plan_id
           state->plan_size += pinfo->plan_size;
@@ -568,17 +711,18 @@ namespace Plan
 
           delete pinfo;
         }
-        m_plan_iterator_stmt->reset();
+        plan_iterator.reset();
 
         // Finalized MD5 digest
         state->md5.resize(16);
         md5sum.finalize((uint8_t*)&state->md5[0]);
 
-        m_lastchange_query_stmt->execute();
-        *m_lastchange_query_stmt >> state->change_time
-                                 >> state->change_sid
-                                 >> state->change_sname;
-        m_lastchange_query_stmt->reset();
+        Database::Statement& lastchange_query = m_db->prepare(c_lastchange_query_stmt);
+        lastchange_query.execute();
+        lastchange_query >> state->change_time
+                         >> state->change_sid
+                         >> state->change_sname;
+        lastchange_query.reset();
 
         if (m_args.trace)
           state->toText(std::cerr);
@@ -588,28 +732,183 @@ namespace Plan
         delete state;
       }
 
+      //! Check if an operation changes the database.
+      //! @param[in] op operation.
+      //! @return true if the operation changes the database.
+      static bool
+      isChange(uint8_t op)
+      {
+        switch (op)
+        {
+          case IMC::PlanDB::DBOP_SET:
+          case IMC::PlanDB::DBOP_DEL:
+          case IMC::PlanDB::DBOP_CLEAR:
+          case IMC::PlanDB::DBOP_SET_BULK:
+            return true;
+          default:
+            return false;
+        }
+      }
+
+      //! Open a transaction, unless one is already open. Changes are
+      //! committed together by commitBatch().
+      void
+      beginBatch(void)
+      {
+        if (m_in_batch)
+          return;
+
+        m_db->beginTransaction();
+        m_in_batch = true;
+        m_batch_deadline = Clock::get() + m_args.batch_window;
+      }
+
+      //! Commit the open transaction if it is full.
+      void
+      checkBatch(void)
+      {
+        if (m_pending.size() >= m_args.batch_size)
+          commitBatch();
+      }
+
+      //! Commit the open transaction and send the replies of the
+      //! changes it contains.
+      void
+      commitBatch(void)
+      {
+        if (!m_in_batch)
+          return;
+
+        m_in_batch = false;
+
+        try
+        {
+          m_db->commit();
+        }
+        catch (std::runtime_error& e)
+        {
+          failBatch(e.what());
+          return;
+        }
+
+        for (size_t i = 0; i < m_pending.size(); ++i)
+        {
+          report(*m_pending[i]);
+          delete m_pending[i];
+        }
+
+        m_pending.clear();
+      }
+
+      //! Roll back the open transaction. The changes it contains
+      //! are reported as failed.
+      void
+      rollbackBatch(void)
+      {
+        if (!m_in_batch)
+          return;
+
+        m_in_batch = false;
+        failBatch(DTR("transaction rolled back"));
+      }
+
+      //! Report the changes of a failed transaction.
+      //! @param[in] desc failure description.
+      void
+      failBatch(const char* desc)
+      {
+        try
+        {
+          m_db->rollback();
+        }
+        catch (...)
+        { }
+
+        clearPlans();
+
+        for (size_t i = 0; i < m_pending.size(); ++i)
+        {
+          m_pending[i]->type = IMC::PlanDB::DBT_FAILURE;
+          m_pending[i]->info = desc;
+          m_pending[i]->arg.clear();
+          report(*m_pending[i]);
+          delete m_pending[i];
+        }
+
+        m_pending.clear();
+      }
+
+      //! Add a plan to the plan cache.
+      //! @param[in] spec plan specification (ownership is transferred).
+      //! @return iterator to cached plan.
+      std::map<std::string, IMC::PlanSpecification*>::const_iterator
+      cachePlan(IMC::PlanSpecification* spec)
+      {
+        uncachePlan(spec->plan_id);
+        return m_plans.insert(std::make_pair(spec->plan_id, spec)).first;
+      }
+
+      //! Remove a plan from the plan cache.
+      //! @param[in] plan_id plan identifier.
+      void
+      uncachePlan(const std::string& plan_id)
+      {
+        std::map<std::string, IMC::PlanSpecification*>::iterator itr = m_plans.find(plan_id);
+        if (itr == m_plans.end())
+          return;
+
+        delete itr->second;
+        m_plans.erase(itr);
+      }
+
+      //! Clear the plan cache.
+      void
+      clearPlans(void)
+      {
+        std::map<std::string, IMC::PlanSpecification*>::iterator itr = m_plans.begin();
+        for (; itr != m_plans.end(); ++itr)
+          delete itr->second;
+
+        m_plans.clear();
+      }
+
       void
       answer(uint8_t type, const char* desc)
       {
         m_reply.type = type;
         m_reply.info = desc;
-        dispatch(m_reply);
 
-        switch (m_reply.op)
+        // Changes are acknowledged once committed.
+        if (m_in_batch && type == IMC::PlanDB::DBT_SUCCESS)
+        {
+          m_pending.push_back(static_cast<IMC::PlanDB*>(m_reply.clone()));
+          return;
+        }
+
+        report(m_reply);
+      }
+
+      void
+      report(IMC::PlanDB& reply)
+      {
+        dispatch(reply);
+
+        switch (reply.op)
         {
           case IMC::PlanDB::DBOP_SET:
           case IMC::PlanDB::DBOP_DEL:
           case IMC::PlanDB::DBOP_CLEAR:
+          case IMC::PlanDB::DBOP_SET_BULK:
             {
-              if (type == IMC::PlanDB::DBT_FAILURE)
-                err("%s (%s) -- %s", DTR(c_op_desc[m_reply.op]),
-                    m_reply.plan_id.c_str(), desc);
-              else if (type == IMC::PlanDB::DBT_SUCCESS)
-                inf("%s (%s) -- %s", DTR(c_op_desc[m_reply.op]),
-                    m_reply.plan_id.c_str(), desc);
+              if (reply.type == IMC::PlanDB::DBT_FAILURE)
+                err("%s (%s) -- %s", DTR(c_op_desc[reply.op]),
+                    reply.plan_id.c_str(), reply.info.c_str());
+              else if (reply.type == IMC::PlanDB::DBT_SUCCESS)
+                inf("%s (%s) -- %s", DTR(c_op_desc[reply.op]),
+                    reply.plan_id.c_str(), reply.info.c_str());
               else
-                debug("%s (%s) -- %s", DTR(c_op_desc[m_reply.op]),
-                      m_reply.plan_id.c_str(), desc);
+                debug("%s (%s) -- %s", DTR(c_op_desc[reply.op]),
+                      reply.plan_id.c_str(), reply.info.c_str());
             }
         }
       }
@@ -637,7 +936,13 @@ namespace Plan
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          if (m_in_batch)
+            waitForMessages(std::max(0.0, m_batch_deadline - Clock::get()));
+          else
+            waitForMessages(1.0);
+
+          if (m_in_batch && Clock::get() >= m_batch_deadline)
+            commitBatch();
         }
       }
     };
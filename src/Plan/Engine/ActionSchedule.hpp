@@ -34,6 +34,7 @@
 #include <stack>
 #include <map>
 #include <set>
+#include <queue>
 #include <utility>
 
 // DUNE headers.
@@ -80,6 +81,35 @@ namespace Plan
       //! Stack of timed actions
       typedef std::stack<TimedAction> TimedStack;
 
+      //! Timed action bound to the entity it targets
+      struct ScheduledAction
+      {
+        //! Entity label
+        std::string name;
+        //! Timed action
+        TimedAction action;
+        //! Insertion order, used to break ties
+        unsigned seq;
+      };
+
+      //! Heap ordering: the action with the largest time relative to
+      //! the plan's eta fires first, ties fire in reverse insertion order
+      struct ScheduledLater
+      {
+        bool
+        operator()(const ScheduledAction& a, const ScheduledAction& b) const
+        {
+          if (a.action.sched_time != b.action.sched_time)
+            return a.action.sched_time < b.action.sched_time;
+
+          return a.seq < b.seq;
+        }
+      };
+
+      //! Time ordered heap of scheduled actions
+      typedef std::priority_queue<ScheduledAction, std::vector<ScheduledAction>,
+                                  ScheduledLater> TimedQueue;
+
       //! Actions that should be fired on plan and maneuver start or end
       struct EventActions
       {
@@ -110,7 +140,9 @@ namespace Plan
                      const Duration::ManeuverDuration::const_iterator last_dur,
                      const std::map<std::string, IMC::EntityInfo>& cinfo):
         m_task(task),
-        m_cinfo(&cinfo)
+        m_cinfo(&cinfo),
+        m_time_left(-1.0),
+        m_seq(0)
       {
         // Get plan duration
         if (last_dur == durations.end())
@@ -159,13 +191,10 @@ namespace Plan
         // Create a proper schedule from the unscheduled set of actions
         scheduleTimed();
 
-        std::map<std::string, TimedStack>::const_iterator next;
-        next = nextSchedule();
+        m_earliest = getNextDeadline();
 
-        if (next == m_timed.end())
+        if (m_earliest < 0.0)
           m_earliest = 0.0;
-        else
-          m_earliest = next->second.top().sched_time;
       }
 
       //! Alternative constructor for when plan is not sequential.
@@ -178,7 +207,9 @@ namespace Plan
                      const std::vector<IMC::PlanManeuver*>& nodes,
                      const std::map<std::string, IMC::EntityInfo>& cinfo):
         m_task(task),
-        m_cinfo(&cinfo)
+        m_cinfo(&cinfo),
+        m_time_left(-1.0),
+        m_seq(0)
       {
         m_plan_duration = -1.0;
 
@@ -214,56 +245,18 @@ namespace Plan
 
         m_time_left = time_left;
 
-        while (1)
-        {
-          std::map<std::string, TimedStack>::iterator next;
-          next = nextSchedule();
-
-          if (next == m_timed.end())
-            break;
-
-          TimedStack* q = &next->second;
-
-          // Check if the time is right
-          if (q->top().sched_time < time_left)
-            break;
-
-          dispatchActions(q->top().list);
-
-          processRequest(next->first, q->top());
-
-          q->pop();
-
-          if (q->empty())
-            m_timed.erase(next);
-        }
+        // Check if the time is right
+        while (!m_timed.empty() && m_timed.top().action.sched_time >= time_left)
+          fireNext();
       }
 
       //! Flush all remaining timed actions in the schedule
       void
       flushTimed(void)
       {
-        while (1)
-        {
-          std::map<std::string, TimedStack>::iterator next;
-          next = nextSchedule();
-
-          if (next == m_timed.end())
-            break;
-
-          TimedStack* q = &next->second;
-
-          // do not check if the time is right
-
-          dispatchActions(q->top().list);
-
-          processRequest(next->first, q->top());
-
-          q->pop();
-
-          if (q->empty())
-            m_timed.erase(next);
-        }
+        // do not check if the time is right
+        while (!m_timed.empty())
+          fireNext();
       }
 
       //! The plan has started
@@ -336,6 +329,17 @@ namespace Plan
         return m_earliest;
       }
 
+      //! Get the time, relative to the plan's eta, of the next timed action
+      //! @return time of the next timed action, -1 if none is pending
+      float
+      getNextDeadline(void) const
+      {
+        if (m_timed.empty())
+          return -1.0;
+
+        return m_timed.top().action.sched_time;
+      }
+
       //! Check if the activation and deactivation requests are being complied
       //! @param[in] id entity label
       //! @param[in] msg pointer to EntityActivationState message
@@ -399,12 +403,9 @@ namespace Plan
         if (!m_reqs.empty())
           return true;
 
-        std::map<std::string, TimedStack>::const_iterator next;
-        next = nextSchedule();
-
-        if (next != m_timed.end())
+        if (!m_timed.empty())
         {
-          if (next->second.top().sched_time >= m_plan_duration)
+          if (m_timed.top().action.sched_time >= m_plan_duration)
             return true;
         }
 
@@ -419,11 +420,8 @@ namespace Plan
         if (!m_reqs.empty())
           return -1.0;
 
-        std::map<std::string, TimedStack>::const_iterator next;
-        next = nextSchedule();
-
-        if (next != m_timed.end())
-          return next->second.top().sched_time - m_plan_duration;
+        if (!m_timed.empty())
+          return m_timed.top().action.sched_time - m_plan_duration;
 
         return -1.0;
       }
@@ -584,19 +582,14 @@ namespace Plan
         itr->second = msg->state;
       }
 
-      //! Add action to map
-      //! @param[in] action_map map of actions to which the action will be added
+      //! Add action to the schedule
       //! @param[in] name name of the entity
       //! @param[in] action action that will be added
       //! @param[in] preschedule true if scheduled time should take activation into account
       void
-      addTimedAction(std::map<std::string, TimedStack>& action_map,
-                     const std::string& name, const TimedAction& action,
+      addTimedAction(const std::string& name, const TimedAction& action,
                      bool preschedule = false)
       {
-        std::map<std::string, TimedStack>::iterator itr;
-        itr = action_map.find(name);
-
         TimedAction mod_action = action;
 
         // If we need to preschedule, add activation time
@@ -610,17 +603,23 @@ namespace Plan
           mod_action.prescheduled = false;
         }
 
-        // Adding action to stack
-        if (itr != action_map.end())
-        {
-          itr->second.push(mod_action);
-        }
-        else
-        {
-          TimedStack q;
-          q.push(mod_action);
-          action_map.insert(std::pair<std::string, TimedStack>(name, q));
-        }
+        ScheduledAction entry;
+        entry.name = name;
+        entry.action = mod_action;
+        entry.seq = m_seq++;
+
+        m_timed.push(entry);
+      }
+
+      //! Fire the earliest scheduled action and remove it from the schedule
+      void
+      fireNext(void)
+      {
+        ScheduledAction next = m_timed.top();
+        m_timed.pop();
+
+        dispatchActions(next.action.list);
+        processRequest(next.name, next.action);
       }
 
       //! Add action request
@@ -675,8 +674,9 @@ namespace Plan
         action.type = type;
         action.list = sep;
         action.sched_time = eta;
+        action.prescheduled = false;
 
-        addTimedAction(m_unsched, sep->name, action);
+        m_unsched[sep->name].push(action);
       }
 
       //! Schedule timed actions
@@ -704,7 +704,7 @@ namespace Plan
               if (us->empty())
               {
                 // pre-schedule
-                addTimedAction(m_timed, itr->first, action, true);
+                addTimedAction(itr->first, action, true);
               }
               else
               {
@@ -722,7 +722,7 @@ namespace Plan
                     // check if the gap between 'de' and activation is big enough
                     if (prev_action.sched_time > act_eta)
                     {
-                      addTimedAction(m_timed, itr->first, action, true);
+                      addTimedAction(itr->first, action, true);
                       break;
                     }
                     else // previous action deactivation is voided
@@ -731,7 +731,7 @@ namespace Plan
 
                       // if stack becomes empty, then pre-schedule
                       if (us->empty())
-                        addTimedAction(m_timed, itr->first, action, true);
+                        addTimedAction(itr->first, action, true);
 
                       // proceed in inner loop to check previous action
                     }
@@ -739,7 +739,7 @@ namespace Plan
                   else // previous action is activation
                   {
                     // if previous action is activation, do not pre-schedule
-                    addTimedAction(m_timed, itr->first, action);
+                    addTimedAction(itr->first, action);
                     break;
                   }
                 }
@@ -747,7 +747,7 @@ namespace Plan
             }
             else // if deactivation never pre-schedule
             {
-              addTimedAction(m_timed, itr->first, action);
+              addTimedAction(itr->first, action);
             }
           }
         }
@@ -770,55 +770,23 @@ namespace Plan
           m_task->dispatch(actions[i]);
       }
 
-      //! Find the stack with the next scheduled action
-      //! @return iterator to the stack with the next scheduled action
-      std::map<std::string, TimedStack>::iterator
-      nextSchedule(void)
-      {
-        if (!m_timed.size())
-          return m_timed.end();
-
-        float earliest = 0.0;
-
-        std::map<std::string, TimedStack>::iterator itr, next;
-        itr = m_timed.begin();
-        next = m_timed.end();
-
-        for (; itr != m_timed.end(); ++itr)
-        {
-          if (itr->second.top().sched_time >= earliest)
-          {
-            earliest = itr->second.top().sched_time;
-            next = itr;
-          }
-        }
-
-        return next;
-      }
-
       //! Printed timed actions
       void
       printTimed(void)
       {
-        std::map<std::string, TimedStack> clone = m_timed;
+        TimedQueue clone = m_timed;
 
-        std::map<std::string, TimedStack>::iterator itr = clone.begin();
-        for (; itr != clone.end(); ++itr)
+        while (!clone.empty())
         {
-          m_task->war("--- %s ---", itr->first.c_str());
-          while (!itr->second.empty())
-          {
-            m_task->war(DTR("scheduled for: %.1f"), itr->second.top().sched_time);
-            itr->second.top().list->toText(std::cerr);
-            itr->second.pop();
-          }
-          m_task->war(DTR("END %s ---"), itr->first.c_str());
+          m_task->war("--- %s ---", clone.top().name.c_str());
+          m_task->war(DTR("scheduled for: %.1f"), clone.top().action.sched_time);
+          clone.top().action.list->toText(std::cerr);
+          clone.pop();
         }
       }
 
-      //! Map of entity labels to TimedStack's
-      //! This means we'll have one stack per component
-      std::map<std::string, TimedStack> m_timed;
+      //! Time ordered heap of actions for all components
+      TimedQueue m_timed;
       //! Map of entity labels to unscheduled stack
       std::map<std::string, TimedStack> m_unsched;
       //! Map of event based maneuver actions
@@ -839,6 +807,8 @@ namespace Plan
       std::map<std::string, TimedAction> m_reqs;
       //! Expected plan duration disregarding calibration time
       float m_plan_duration;
+      //! Insertion counter for scheduled actions
+      unsigned m_seq;
     };
   }
 }
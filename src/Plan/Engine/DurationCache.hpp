@@ -0,0 +1,151 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_PLAN_ENGINE_DURATION_CACHE_HPP_INCLUDED_
+#define DUNE_PLAN_ENGINE_DURATION_CACHE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Graph.hpp"
+
+namespace Plan
+{
+  namespace Engine
+  {
+    using DUNE_NAMESPACES;
+
+    //! Profiles (see Plans::Duration::Profile) and compiled graphs of
+    //! plans indexed by the MD5 of the plan specification, as stored
+    //! in the plan database. This class is thread-safe.
+    class DurationCache
+    {
+    public:
+      //! Compute the key of a plan.
+      //! @param[in] spec plan specification.
+      //! @return MD5 of the serialized plan.
+      static std::string
+      getKey(const IMC::PlanSpecification& spec)
+      {
+        std::vector<uint8_t> data(spec.getPayloadSerializationSize() + 1);
+        spec.serializeFields(&data[0]);
+
+        std::string key(16, '\0');
+        MD5::compute(&data[0], data.size() - 1, (uint8_t*)&key[0]);
+        return key;
+      }
+
+      //! Get the profile of a plan.
+      //! @param[in] key plan key.
+      //! @param[out] profile plan profile.
+      //! @return true if the plan was found, false otherwise.
+      bool
+      get(const std::string& key, Plans::Duration::Profile& profile) const
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+
+        std::map<std::string, Plans::Duration::Profile>::const_iterator itr = m_profiles.find(key);
+        if (itr == m_profiles.end())
+          return false;
+
+        profile = itr->second;
+        return true;
+      }
+
+      //! Store the profile of a plan.
+      //! @param[in] key plan key.
+      //! @param[in] profile plan profile.
+      void
+      put(const std::string& key, const Plans::Duration::Profile& profile)
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+        m_profiles[key] = profile;
+      }
+
+      //! Get the compiled graph of a plan.
+      //! @param[in] key plan key.
+      //! @param[out] graph plan graph.
+      //! @return true if the plan was found, false otherwise.
+      bool
+      getGraph(const std::string& key, Graph& graph) const
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+
+        std::map<std::string, Graph>::const_iterator itr = m_graphs.find(key);
+        if (itr == m_graphs.end())
+          return false;
+
+        graph = itr->second;
+        return true;
+      }
+
+      //! Store the compiled graph of a plan.
+      //! @param[in] key plan key.
+      //! @param[in] graph plan graph.
+      void
+      putGraph(const std::string& key, const Graph& graph)
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+        m_graphs[key] = graph;
+      }
+
+      //! Remove all profiles and graphs.
+      void
+      clear(void)
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+        m_profiles.clear();
+        m_graphs.clear();
+      }
+
+      //! Get the number of cached profiles.
+      //! @return number of profiles.
+      size_t
+      size(void) const
+      {
+        Concurrency::ScopedMutex l(m_mutex);
+        return m_profiles.size();
+      }
+
+    private:
+      //! Profiles by key.
+      std::map<std::string, Plans::Duration::Profile> m_profiles;
+      //! Graphs by key.
+      std::map<std::string, Graph> m_graphs;
+      //! Lock.
+      mutable Concurrency::Mutex m_mutex;
+    };
+  }
+}
+
+#endif
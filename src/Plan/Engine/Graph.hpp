@@ -0,0 +1,184 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef DUNE_PLAN_ENGINE_GRAPH_HPP_INCLUDED_
+#define DUNE_PLAN_ENGINE_GRAPH_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Plan
+{
+  namespace Engine
+  {
+    using DUNE_NAMESPACES;
+
+    //! Plan graph with maneuvers and transitions resolved to their
+    //! position in the plan specification. It does not hold pointers,
+    //! so it remains valid for any copy of the same specification.
+    struct Graph
+    {
+      //! Special values of next maneuver.
+      enum NextNode
+      {
+        //! Transition to the end of the plan.
+        c_done = -1,
+        //! Transition to a maneuver that does not exist.
+        c_unknown = -2
+      };
+
+      //! Index of the start maneuver.
+      unsigned start;
+      //! Outgoing transitions of each maneuver.
+      std::vector<std::vector<unsigned> > trans;
+      //! Destination of the first transition of each maneuver.
+      std::vector<int> next;
+      //! Maneuvers visited from the start following first transitions.
+      std::vector<unsigned> sequence;
+      //! True if the sequence reaches the end of the plan.
+      bool sequential;
+
+      Graph(void):
+        start(0),
+        sequential(false)
+      { }
+
+      //! Compile a plan specification.
+      //! @param[in] spec plan specification.
+      //! @param[out] desc description of the failure if any.
+      //! @return true if the plan graph is valid, false otherwise.
+      bool
+      compile(const IMC::PlanSpecification& spec, std::string& desc)
+      {
+        std::map<std::string, unsigned> index;
+        std::vector<const IMC::PlanManeuver*> mans;
+
+        IMC::MessageList<IMC::PlanManeuver>::const_iterator mitr = spec.maneuvers.begin();
+        for (; mitr != spec.maneuvers.end(); ++mitr)
+        {
+          if (*mitr != NULL)
+            index[(*mitr)->maneuver_id] = mans.size();
+
+          mans.push_back(*mitr);
+        }
+
+        trans.assign(mans.size(), std::vector<unsigned>());
+        next.assign(mans.size(), c_done);
+        sequence.clear();
+        sequential = false;
+
+        std::vector<bool> incoming(mans.size(), false);
+        std::vector<const IMC::PlanTransition*> trs;
+
+        IMC::MessageList<IMC::PlanTransition>::const_iterator titr = spec.transitions.begin();
+        for (; titr != spec.transitions.end(); ++titr)
+        {
+          trs.push_back(*titr);
+
+          if (*titr == NULL)
+            continue;
+
+          std::map<std::string, unsigned>::const_iterator itr;
+
+          itr = index.find((*titr)->source_man);
+          if (itr != index.end())
+            trans[itr->second].push_back(trs.size() - 1);
+
+          itr = index.find((*titr)->dest_man);
+          if (itr != index.end())
+            incoming[itr->second] = true;
+        }
+
+        for (unsigned i = 0; i < mans.size(); ++i)
+        {
+          if (mans[i] == NULL)
+            continue;
+
+          const std::string& id = mans[i]->maneuver_id;
+
+          // if a match was not found and this is not the start maneuver
+          if (!incoming[index[id]] && (id != spec.start_man_id))
+          {
+            desc = id + DTR(": maneuver has no incoming transition"
+                            " and it's not the initial maneuver");
+            return false;
+          }
+
+          if (trans[i].empty())
+            continue;
+
+          const std::string& dest = trs[trans[i][0]]->dest_man;
+          if (dest == "_done_")
+            continue;
+
+          std::map<std::string, unsigned>::const_iterator itr = index.find(dest);
+          next[i] = (itr == index.end()) ? c_unknown : (int)itr->second;
+        }
+
+        std::map<std::string, unsigned>::const_iterator sitr = index.find(spec.start_man_id);
+        if (sitr == index.end())
+        {
+          desc = spec.start_man_id + DTR(": invalid start maneuver");
+          return false;
+        }
+
+        start = sitr->second;
+
+        std::vector<bool> visited(mans.size(), false);
+        int node = start;
+
+        while (true)
+        {
+          sequence.push_back(node);
+          visited[node] = true;
+
+          if (next[node] == c_done)
+          {
+            sequential = true;
+            break;
+          }
+
+          // Plan is cyclical or refers to an unknown maneuver.
+          if (next[node] == c_unknown || visited[next[node]])
+            break;
+
+          node = next[node];
+        }
+
+        return true;
+      }
+    };
+  }
+}
+
+#endif
@@ -37,6 +37,7 @@
 #include <DUNE/Plans.hpp>
 #include "Calibration.hpp"
 #include "ActionSchedule.hpp"
+#include "DurationCache.hpp"
 
 namespace Plan
 {
@@ -58,10 +59,11 @@ namespace Plan
         IMC::PlanManeuver* pman;
         //! Vector of pointers to plan transitions
         std::vector<IMC::PlanTransition*> trans;
+        //! Index of the next node (see Graph::next)
+        int next;
+        //! Durations of the maneuver, if any
+        const std::vector<float>* durations;
       };
-
-      //! Mapping between maneuver IDs and graph nodes
-      typedef std::map<std::string, Node> PlanMap;
       //! Iterator
       typedef std::vector<IMC::PlanManeuver*>::const_iterator const_iterator;
 
@@ -70,8 +72,10 @@ namespace Plan
       //! @param[in] compute_progress true if progress should be computed
       //! @param[in] speed_rpm_factor factor to convert from RPMs to m/s
       //! @param[in] speed_act_factor factor to convert from actuation to m/s
+      //! @param[in] cache cache of plan durations, if any
       Plan(const IMC::PlanSpecification* spec, bool compute_progress,
-           float speed_rpm_factor, float speed_act_factor):
+           float speed_rpm_factor, float speed_act_factor,
+           DurationCache* cache = NULL):
         m_spec(spec),
         m_curr_node(NULL),
         m_sequential(false),
@@ -79,7 +83,8 @@ namespace Plan
         m_progress(0.0),
         m_calibration(0),
         m_beyond_dur(false),
-        m_sched(NULL)
+        m_sched(NULL),
+        m_cache(cache)
       {
         m_speed_conv.rpm_factor = speed_rpm_factor;
         m_speed_conv.act_factor = speed_act_factor;
@@ -102,7 +107,8 @@ namespace Plan
       void
       clear(void)
       {
-        m_graph.clear();
+        m_nodes.clear();
+        m_curr_node = NULL;
         m_seq_nodes.clear();
         m_sequential = false;
         m_durations.clear();
@@ -125,8 +131,6 @@ namespace Plan
             bool plan_startup, const std::map<std::string, IMC::EntityInfo>& cinfo,
             Tasks::Task* task, const IMC::EstimatedState* state = NULL)
       {
-        bool start_maneuver_ok = false;
-
         clear();
 
         if (!m_spec->maneuvers.size())
@@ -138,14 +142,11 @@ namespace Plan
         IMC::MessageList<IMC::PlanManeuver>::const_iterator mitr;
         mitr = m_spec->maneuvers.begin();
 
-        // parse maneuvers and transitions
-        do
+        // check maneuvers
+        for (; mitr != m_spec->maneuvers.end(); ++mitr)
         {
           if (*mitr == NULL)
-          {
-            ++mitr;
             continue;
-          }
 
           if ((*mitr)->data.isNull())
           {
@@ -160,49 +161,10 @@ namespace Plan
             desc = (*mitr)->maneuver_id + DTR(": maneuver is not supported");
             return false;
           }
-
-          if ((*mitr)->maneuver_id == m_spec->start_man_id)
-            start_maneuver_ok = true;
-
-          Node node;
-          bool matched = false;
-
-          node.pman = (*mitr);
-
-          IMC::MessageList<IMC::PlanTransition>::const_iterator tritr;
-          tritr = m_spec->transitions.begin();
-
-          for (; tritr != m_spec->transitions.end(); ++tritr)
-          {
-            if (*tritr == NULL)
-              continue;
-
-            if ((*tritr)->dest_man == (*mitr)->maneuver_id)
-              matched = true;
-
-            if ((*tritr)->source_man == (*mitr)->maneuver_id)
-              node.trans.push_back((*tritr));
-          }
-
-          // if a match was not found and this is not the start maneuver
-          if (!matched && ((*mitr)->maneuver_id != m_spec->start_man_id))
-          {
-            std::string str = DTR(": maneuver has no incoming transition"
-                                  " and it's not the initial maneuver");
-            desc = (*mitr)->maneuver_id + str;
-            return false;
-          }
-
-          m_graph[(*mitr)->maneuver_id] = node;
-          ++mitr;
         }
-        while (mitr != m_spec->maneuvers.end());
 
-        if (!start_maneuver_ok)
-        {
-          desc = m_spec->start_man_id + DTR(": invalid start maneuver");
+        if (!compile(desc))
           return false;
-        }
 
         if (m_compute_progress && plan_startup)
         {
@@ -234,6 +196,29 @@ namespace Plan
         return true;
       }
 
+      //! Compute the durations of the plan that do not depend on the
+      //! vehicle's state and store them in the duration cache
+      //! @param[in] supported_maneuvers list of supported maneuvers
+      //! @return true if the plan is valid and sequential
+      bool
+      precompute(const std::set<uint16_t>* supported_maneuvers)
+      {
+        std::string desc;
+        std::map<std::string, IMC::EntityInfo> cinfo;
+
+        if (!parse(desc, supported_maneuvers, false, cinfo, NULL))
+          return false;
+
+        sequenceNodes();
+
+        if (!m_sequential)
+          return false;
+
+        Duration::Profile profile;
+        getProfile(profile);
+        return true;
+      }
+
       //! Signal that the plan has started
       void
       planStarted(void)
@@ -312,10 +297,8 @@ namespace Plan
           return false;
         else if (!m_curr_node->trans.size())
           return true;
-        else if (m_curr_node->trans[0]->dest_man == "_done_")
-          return true;
         else
-          return false;
+          return m_curr_node->next == Graph::c_done;
       }
 
       //! Get start maneuver message
@@ -325,7 +308,7 @@ namespace Plan
       {
         m_last_id = m_spec->start_man_id;
 
-        return loadManeuverFromId(m_last_id);
+        return loadNode(m_graph.start);
       }
 
       //! Get next maneuver message
@@ -335,7 +318,7 @@ namespace Plan
       {
         m_last_id = m_curr_node->trans[0]->dest_man;
 
-        return loadManeuverFromId(m_last_id);
+        return loadNode(m_curr_node->next);
       }
 
       //! Get current maneuver id
@@ -410,6 +393,23 @@ namespace Plan
           return true;
       }
 
+      //! Get the time until the next timed action is due
+      //! @return seconds until the next timed action, -1 if none is pending
+      float
+      getScheduleDelay(void) const
+      {
+        if (m_sched == NULL || m_beyond_dur)
+          return -1.0;
+
+        float eta = getPlanEta();
+        float deadline = m_sched->getNextDeadline();
+
+        if (eta < 0.0 || deadline < 0.0)
+          return -1.0;
+
+        return std::max(0.0f, eta - deadline);
+      }
+
       //! Check if scheduler is waiting for a device
       //! @return true if waiting for device
       bool
@@ -476,47 +476,65 @@ namespace Plan
       }
 
     private:
-      //! Check if a maneuver exists in the sequential nodes
-      //! @param[in] id string id of the maneuver
-      //! @return true if it already exists in the seq nodes vector
+      //! Compile the plan graph, or fetch it from the cache, and
+      //! bind it to the plan specification
+      //! @param[out] desc description of the failure if any
+      //! @return true if the plan graph is valid
       bool
-      maneuverExists(const std::string id) const
+      compile(std::string& desc)
       {
-        std::vector<IMC::PlanManeuver*>::const_iterator itr = m_seq_nodes.begin();
+        m_key.clear();
 
-        for (; itr != m_seq_nodes.end(); ++itr)
-          if (!(*itr)->maneuver_id.compare(id))
-            return true;
+        if (m_cache != NULL)
+          m_key = DurationCache::getKey(*m_spec);
 
-        return false;
-      }
+        if (m_key.empty() || !m_cache->getGraph(m_key, m_graph))
+        {
+          if (!m_graph.compile(*m_spec, desc))
+            return false;
 
-      //! Sequence plan nodes if possible
-      void
-      sequenceNodes(void)
-      {
-        PlanMap::iterator itr = m_graph.find(m_spec->start_man_id);
+          if (!m_key.empty())
+            m_cache->putGraph(m_key, m_graph);
+        }
 
-        while (true)
+        IMC::MessageList<IMC::PlanManeuver>::const_iterator mitr;
+        mitr = m_spec->maneuvers.begin();
+
+        for (; mitr != m_spec->maneuvers.end(); ++mitr)
         {
-          m_seq_nodes.push_back(itr->second.pman);
+          Node node;
+          node.pman = *mitr;
+          node.next = m_graph.next[m_nodes.size()];
+          node.durations = NULL;
+          m_nodes.push_back(node);
+        }
 
-          if (!itr->second.trans.size())
-            break;
-          else if (itr->second.trans[0]->dest_man == "_done_")
-            break;
+        std::vector<IMC::PlanTransition*> trs;
+        IMC::MessageList<IMC::PlanTransition>::const_iterator titr;
+        titr = m_spec->transitions.begin();
 
-          // Check if plan is cyclical
-          if (maneuverExists(itr->second.trans[0]->dest_man))
-          {
-            m_sequential = false;
-            return;
-          }
+        for (; titr != m_spec->transitions.end(); ++titr)
+          trs.push_back(*titr);
 
-          itr = m_graph.find(itr->second.trans[0]->dest_man);
+        for (unsigned i = 0; i < m_nodes.size(); ++i)
+        {
+          for (unsigned j = 0; j < m_graph.trans[i].size(); ++j)
+            m_nodes[i].trans.push_back(trs[m_graph.trans[i][j]]);
         }
 
-        m_sequential = true;
+        return true;
+      }
+
+      //! Sequence plan nodes if possible
+      void
+      sequenceNodes(void)
+      {
+        m_seq_nodes.clear();
+
+        for (unsigned i = 0; i < m_graph.sequence.size(); ++i)
+          m_seq_nodes.push_back(m_nodes[m_graph.sequence[i]].pman);
+
+        m_sequential = m_graph.sequential;
       }
 
       //! Compute durations of each point in the plan
@@ -524,26 +542,54 @@ namespace Plan
       void
       computeDurations(const IMC::EstimatedState* state)
       {
-        m_last_dur = Duration::parse(m_seq_nodes, state, m_durations, m_speed_conv);
-      }
+        Duration::Profile profile;
+        getProfile(profile);
 
-      //! Get maneuver from id
-      //! @param[in] id name of the maneuver to load
-      //! @return NULL if maneuver id is invalid
-      inline IMC::PlanManeuver*
-      loadManeuverFromId(const std::string id)
-      {
-        PlanMap::iterator itr = m_graph.find(id);
+        m_last_dur = Duration::parse(m_seq_nodes, state, profile, m_durations, m_speed_conv);
 
-        if (itr == m_graph.end())
+        for (unsigned i = 0; i < m_nodes.size(); ++i)
         {
-          return NULL;
+          if (m_nodes[i].pman == NULL)
+            continue;
+
+          Duration::ManeuverDuration::const_iterator itr;
+          itr = m_durations.find(m_nodes[i].pman->maneuver_id);
+
+          if (itr != m_durations.end())
+            m_nodes[i].durations = &itr->second;
         }
-        else
+      }
+
+      //! Get the profile of the plan from the duration cache, or
+      //! compute it and add it to the cache
+      //! @param[out] profile plan profile
+      void
+      getProfile(Duration::Profile& profile)
+      {
+        if (m_cache == NULL)
         {
-          m_curr_node = &itr->second;
-          return m_curr_node->pman;
+          Duration::computeProfile(m_seq_nodes, profile, m_speed_conv);
+          return;
         }
+
+        if (m_cache->get(m_key, profile))
+          return;
+
+        Duration::computeProfile(m_seq_nodes, profile, m_speed_conv);
+        m_cache->put(m_key, profile);
+      }
+
+      //! Get maneuver from node index
+      //! @param[in] index index of the node to load
+      //! @return NULL if node index is invalid
+      inline IMC::PlanManeuver*
+      loadNode(int index)
+      {
+        if (index < 0 || index >= (int)m_nodes.size())
+          return NULL;
+
+        m_curr_node = &m_nodes[index];
+        return m_curr_node->pman;
       }
 
       //! Compute current progress
@@ -580,11 +626,13 @@ namespace Plan
             mcs->eta == 0)
           return m_progress;
 
-        Duration::ManeuverDuration::const_iterator itr;
-        itr = m_durations.find(getCurrentId());
+        const std::vector<float>* durations = NULL;
+
+        if (m_curr_node != NULL)
+          durations = m_curr_node->durations;
 
         // If not found
-        if (itr == m_durations.end())
+        if (durations == NULL)
         {
           // If beyond the last maneuver with valid duration
           if (m_beyond_dur)
@@ -599,13 +647,13 @@ namespace Plan
         }
 
         // If durations vector for this maneuver is empty
-        if (!itr->second.size())
+        if (!durations->size())
           return m_progress;
 
-        IMC::Message* man = m_graph.find(getCurrentId())->second.pman->data.get();
+        IMC::Message* man = m_curr_node->pman->data.get();
 
         // Get execution progress
-        float exec_prog = Progress::compute(man, mcs, itr->second, exec_duration);
+        float exec_prog = Progress::compute(man, mcs, *durations, exec_duration);
 
         float prog = 100.0 - getExecutionPercentage() * (1.0 - exec_prog / 100.0);
 
@@ -627,8 +675,12 @@ namespace Plan
 
       //! Pointer to plan specification
       const IMC::PlanSpecification* m_spec;
-      //! Plan graph of maneuvers and transitions
-      PlanMap m_graph;
+      //! Compiled plan graph
+      Graph m_graph;
+      //! Graph nodes, in the order of the plan specification
+      std::vector<Node> m_nodes;
+      //! Key of the plan in the duration cache, if any
+      std::string m_key;
       //! Pointer to current node
       Node* m_curr_node;
       //! Last maneuver id
@@ -655,6 +707,8 @@ namespace Plan
       ActionSchedule* m_sched;
       //! Vector of entity labels to push and pop entity parameters
       std::vector<std::string> m_affected_ents;
+      //! Cache of plan durations
+      DurationCache* m_cache;
     };
   }
 }
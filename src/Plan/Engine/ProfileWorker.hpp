@@ -0,0 +1,118 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef DUNE_PLAN_ENGINE_PROFILE_WORKER_HPP_INCLUDED_
+#define DUNE_PLAN_ENGINE_PROFILE_WORKER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <set>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "DurationCache.hpp"
+#include "Plan.hpp"
+
+namespace Plan
+{
+  namespace Engine
+  {
+    using DUNE_NAMESPACES;
+
+    //! Thread that computes the profiles of a list of stored plans
+    //! and adds them to a duration cache.
+    class ProfileWorker: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] cache duration cache.
+      //! @param[in] supported_maneuvers list of supported maneuvers.
+      //! @param[in] speed_rpm_factor factor to convert from RPMs to m/s
+      //! @param[in] speed_act_factor factor to convert from actuation to m/s
+      ProfileWorker(DurationCache& cache, const std::set<uint16_t>& supported_maneuvers,
+                    float speed_rpm_factor, float speed_act_factor):
+        m_cache(cache),
+        m_supported_maneuvers(supported_maneuvers),
+        m_speed_rpm_factor(speed_rpm_factor),
+        m_speed_act_factor(speed_act_factor)
+      { }
+
+      ~ProfileWorker(void)
+      {
+        stopAndJoin();
+      }
+
+      //! Add a plan. Must be called before the thread starts.
+      //! @param[in] data serialized plan specification.
+      void
+      add(const Database::Blob& data)
+      {
+        m_plans.push_back(data);
+      }
+
+    private:
+      //! Duration cache.
+      DurationCache& m_cache;
+      //! List of supported maneuvers.
+      std::set<uint16_t> m_supported_maneuvers;
+      //! Factor to convert from RPMs to meters per second.
+      float m_speed_rpm_factor;
+      //! Factor to convert from actuation to meters per second.
+      float m_speed_act_factor;
+      //! Serialized plans.
+      std::vector<Database::Blob> m_plans;
+
+      void
+      run(void)
+      {
+        for (size_t i = 0; i < m_plans.size() && !isStopping(); ++i)
+        {
+          if (m_plans[i].empty())
+            continue;
+
+          IMC::PlanSpecification spec;
+
+          try
+          {
+            spec.deserializeFields((const uint8_t*)&m_plans[i][0], m_plans[i].size());
+          }
+          catch (...)
+          {
+            continue;
+          }
+
+          Plan plan(&spec, true, m_speed_rpm_factor, m_speed_act_factor, &m_cache);
+          plan.precompute(&m_supported_maneuvers);
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -32,6 +32,8 @@
 // Local headers.
 #include "Plan.hpp"
 #include "Calibration.hpp"
+#include "DurationCache.hpp"
+#include "ProfileWorker.hpp"
 
 namespace Plan
 {
@@ -43,6 +45,8 @@ namespace Plan
     const double c_vc_reply_timeout = 2.5;
     //! Timeout for the vehicle state
     const double c_vs_timeout = 2.5;
+    //! Minimum wait for the next timed action
+    const double c_sched_min_wait = 0.1;
     //! Plan Command operation descriptions
     const char* c_op_desc[] = {DTR_RT("Start Plan"), DTR_RT("Stop Plan"),
                                DTR_RT("Load Plan"), DTR_RT("Get Plan")};
@@ -51,6 +55,8 @@ namespace Plan
                                   DTR_RT("INITIALIZING"), DTR_RT("EXECUTING")};
     //! DataBase statement
     static const char* c_get_plan_stmt = "select data from Plan where plan_id=?";
+    //! DataBase statement to iterate all plans
+    static const char* c_get_plans_stmt = "select data from Plan";
 
     struct Arguments
     {
@@ -66,6 +72,8 @@ namespace Plan
       uint16_t calibration_time;
       //! Abort when a payload fails to activate
       bool actfail_abort;
+      //! Number of threads estimating the duration of stored plans.
+      unsigned duration_threads;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -87,6 +95,8 @@ namespace Plan
       uint16_t m_vreq_ctr;
       double m_vc_reply_deadline;
       double m_last_vstate;
+      //! Time at which the next timed action is due
+      double m_sched_deadline;
       IMC::VehicleCommand m_vc;
       //! PlanSpecification message
       IMC::PlanSpecification m_spec;
@@ -105,6 +115,10 @@ namespace Plan
       Time::Counter<float> m_report_timer;
       //! Map of component names to entityinfo
       std::map<std::string, IMC::EntityInfo> m_cinfo;
+      //! Cache of plan durations.
+      DurationCache m_cache;
+      //! Threads estimating the duration of stored plans.
+      std::vector<ProfileWorker*> m_workers;
       //! Task arguments.
       Arguments m_args;
 
@@ -143,6 +157,12 @@ namespace Plan
         .defaultValue("false")
         .description("Abort when a payload fails to activate");
 
+        param("Duration Estimation Threads", m_args.duration_threads)
+        .defaultValue("2")
+        .maximumValue("8")
+        .description("Number of threads estimating the duration of stored plans"
+                     " when the plan database is loaded (0 to disable)");
+
         bind<IMC::PlanControl>(this);
         bind<IMC::PlanDB>(this);
         bind<IMC::EstimatedState>(this);
@@ -157,6 +177,7 @@ namespace Plan
 
       ~Task()
       {
+        clearWorkers();
         closeDB();
       }
 
@@ -170,6 +191,7 @@ namespace Plan
       void
       onResourceRelease(void)
       {
+        clearWorkers();
         Memory::clear(m_plan);
         Memory::clear(m_calib);
       }
@@ -177,8 +199,9 @@ namespace Plan
       void
       onResourceAcquisition(void)
       {
+        m_cache.clear();
         m_plan = new Plan(&m_spec, m_args.progress,
-                          m_args.speed_conv_rpm, m_args.speed_conv_act);
+                          m_args.speed_conv_rpm, m_args.speed_conv_act, &m_cache);
 
         m_calib = new Calibration(m_args.calibration_time);
       }
@@ -292,11 +315,69 @@ namespace Plan
         debug("database file: '%s'", db_file.c_str());
 
         m_db = new Database::Connection(db_file.c_str(), true);
+        // Plan DB keeps changes in a transaction for a short while,
+        // read them instead of waiting on its table lock.
+        m_db->execute("pragma read_uncommitted=1");
         m_get_plan_stmt = new Database::Statement(c_get_plan_stmt, *m_db);
 
+        precomputeDurations();
+
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
+      //! Estimate the duration of all stored plans in the background,
+      //! so that starting them does not require a full estimation.
+      void
+      precomputeDurations(void)
+      {
+        clearWorkers();
+
+        if (!m_args.progress || m_args.duration_threads == 0)
+          return;
+
+        for (unsigned i = 0; i < m_args.duration_threads; ++i)
+        {
+          m_workers.push_back(new ProfileWorker(m_cache, m_supported_maneuvers,
+                                                m_args.speed_conv_rpm,
+                                                m_args.speed_conv_act));
+        }
+
+        unsigned count = 0;
+
+        try
+        {
+          Database::Statement stmt(c_get_plans_stmt, *m_db);
+
+          while (stmt.execute())
+          {
+            Database::Blob data;
+            stmt >> data;
+            m_workers[count++ % m_workers.size()]->add(data);
+          }
+        }
+        catch (std::runtime_error& e)
+        {
+          war(DTR("unable to estimate plan durations: %s"), e.what());
+          clearWorkers();
+          return;
+        }
+
+        for (unsigned i = 0; i < m_workers.size(); ++i)
+          m_workers[i]->start();
+
+        debug("estimating duration of %u plans", count);
+      }
+
+      //! Stop and destroy duration estimation threads.
+      void
+      clearWorkers(void)
+      {
+        for (unsigned i = 0; i < m_workers.size(); ++i)
+          delete m_workers[i];
+
+        m_workers.clear();
+      }
+
       void
       closeDB(void)
       {
@@ -963,18 +1044,26 @@ namespace Plan
         m_vreq_ctr = 0;
         m_vc_reply_deadline = -1;
         m_last_vstate = Clock::get();
+        m_sched_deadline = -1;
       }
 
       //! Report progress
       void
       reportProgress(void)
       {
+        m_sched_deadline = -1;
+
         // Must be executing or calibrating to be able to compute progress
         if (m_plan == NULL || (!execMode() && !initMode()))
           return;
 
         m_pcs.plan_progress = m_plan->updateProgress(&m_mcs, m_calib);
         m_pcs.plan_eta = (int32_t)m_plan->getPlanEta();
+
+        float delay = m_plan->getScheduleDelay();
+
+        if (delay >= 0.0)
+          m_sched_deadline = Clock::get() + std::max(c_sched_min_wait, (double)delay);
       }
 
       void
@@ -996,6 +1085,10 @@ namespace Plan
 
           double now = Clock::get();
 
+          // Fire timed actions on their deadline instead of the next report
+          if (m_sched_deadline >= 0 && now >= m_sched_deadline)
+            reportProgress();
+
           if ((getEntityState() == IMC::EntityState::ESTA_NORMAL) &&
               (now - m_last_vstate >= c_vs_timeout))
           {
@@ -1007,7 +1100,12 @@ namespace Plan
 
           if (delta > 0)
           {
-            waitForMessages(std::min(1.0, delta));
+            double wait = std::min(1.0, delta);
+
+            if (m_sched_deadline >= 0)
+              wait = std::min(wait, std::max(0.0, m_sched_deadline - now));
+
+            waitForMessages(wait);
             continue;
           }
 
@@ -26,7 +26,9 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <list>
 #include <stdexcept>
+#include <utility>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -58,8 +60,13 @@ namespace Plan
       int dive_time;
       //! The speed (in RPMS) to be commanded when generating maneuvers.
       int speed_rpms;
+      //! Number of generated plans to keep.
+      unsigned cache_size;
     };
 
+    //! Generated plan and the inputs it was generated from.
+    typedef std::pair<std::string, IMC::PlanSpecification> CachedPlan;
+
     struct Task: public DUNE::Tasks::Task
     {
       //! Task arguments.
@@ -70,6 +77,8 @@ namespace Plan
       IMC::LblConfig* m_last_lbl_config;
       //! map for storing last received announces
       std::map<unsigned int, IMC::Announce> m_last_announces;
+      //! Generated plans, most recently used first.
+      std::list<CachedPlan> m_cache;
 
       //! Class constructor
       Task(const std::string& name, Tasks::Context& ctx):
@@ -97,12 +106,24 @@ namespace Plan
         .description("Speed in RPMs to be used in the generated maneuvers")
         .defaultValue("1000");
 
+        param("Cache Size", m_args.cache_size)
+        .description("Number of generated plans kept to answer repeated requests"
+                     " with the same template and resolved parameters")
+        .defaultValue("16");
+
         bind<IMC::Announce>(this);
         bind<IMC::PlanGeneration>(this);
         bind<IMC::EstimatedState>(this);
         bind<IMC::LblConfig>(this);
       }
 
+      //! Generated plans depend on the configuration.
+      void
+      onUpdateParameters(void)
+      {
+        m_cache.clear();
+      }
+
       //! Frees memory associated with stored messages.
       void
       onResourceRelease(void)
@@ -332,6 +353,44 @@ namespace Plan
         }
       }
 
+      //! Look up a plan generated from the same inputs.
+      //! @param[in] key template and resolved inputs.
+      //! @param[out] result where to store the plan specification.
+      //! @returns true if the plan was found.
+      bool
+      lookup(const std::string& key, IMC::PlanSpecification& result)
+      {
+        std::list<CachedPlan>::iterator itr = m_cache.begin();
+        for (; itr != m_cache.end(); ++itr)
+        {
+          if (itr->first != key)
+            continue;
+
+          m_cache.splice(m_cache.begin(), m_cache, itr);
+          result = itr->second;
+          debug("reusing plan generated from '%s'", key.c_str());
+          return true;
+        }
+
+        return false;
+      }
+
+      //! Keep a generated plan, discarding the least recently used
+      //! one if the cache is full.
+      //! @param[in] key template and resolved inputs.
+      //! @param[in] spec plan specification.
+      void
+      store(const std::string& key, const IMC::PlanSpecification& spec)
+      {
+        if (m_args.cache_size == 0)
+          return;
+
+        if (m_cache.size() >= m_args.cache_size)
+          m_cache.pop_back();
+
+        m_cache.push_front(CachedPlan(key, spec));
+      }
+
       //! This method parses a string and a list of parameters and
       //! eventually generates a corresponding plan.
       //! @param[in] plan_id the string to be parsed (command).
@@ -396,6 +455,10 @@ namespace Plan
           // if some latitude / longitude was given, goes there
           if (lat != 0 || lon != 0)
           {
+            std::string key = String::str("%s %.10f %.10f %.3f", plan_id.c_str(), lat, lon, depth);
+            if (lookup(key, result))
+              return true;
+
             IMC::MessageList<IMC::Maneuver> maneuvers;
 
             // only generates a goto if the template is go, otherwise generates only a station keeping
@@ -427,6 +490,7 @@ namespace Plan
             delete at_surface;
 
             sequentialPlan(plan_id, &maneuvers, result);
+            store(key, result);
 
             return true;
           }
@@ -445,6 +509,11 @@ namespace Plan
           near_lat = home_lat = m_estate->lat;
           near_lon = home_lon = m_estate->lon;
 
+          std::string key = String::str("%s %.10f %.10f %.10f %.10f", plan_id.c_str(),
+                                        cur_lat, cur_lon, home_lat, home_lon);
+          if (lookup(key, result))
+            return true;
+
           WGS84::getNEBearingAndRange(cur_lat, cur_lon, home_lat, home_lon, &bearing, &range);
 
           if (range > 50)
@@ -483,6 +552,7 @@ namespace Plan
           delete at_surface;
 
           sequentialPlan(plan_id, &maneuvers, result);
+          store(key, result);
 
           return true;
         }
@@ -495,6 +565,10 @@ namespace Plan
           getCurrentPosition(&lat, &lon, &depth);
           depth = params.get("depth", m_args.dive_depth);
 
+          std::string key = String::str("%s %.10f %.10f %.3f", plan_id.c_str(), lat, lon, depth);
+          if (lookup(key, result))
+            return true;
+
           IMC::MessageList<IMC::Maneuver> maneuvers;
 
           IMC::Loiter* loiter = new IMC::Loiter();
@@ -512,6 +586,7 @@ namespace Plan
           delete loiter;
 
           sequentialPlan(plan_id, &maneuvers, result);
+          store(key, result);
 
           return true;
         }
@@ -520,11 +595,15 @@ namespace Plan
         // above its current position
         if (plan_id == "surface")
         {
-          IMC::MessageList<IMC::Maneuver> maneuvers;
-
           double lat, lon, depth;
           getCurrentPosition(&lat, &lon, &depth);
 
+          std::string key = String::str("%s %.10f %.10f", plan_id.c_str(), lat, lon);
+          if (lookup(key, result))
+            return true;
+
+          IMC::MessageList<IMC::Maneuver> maneuvers;
+
           IMC::Elevator* surface = new IMC::Elevator();
           surface->flags = IMC::Elevator::FLG_CURR_POS;
           surface->end_z = 0;
@@ -552,6 +631,7 @@ namespace Plan
           delete at_surface;
 
           sequentialPlan(plan_id, &maneuvers, result);
+          store(key, result);
 
           return true;
         }
@@ -50,8 +50,16 @@ namespace Power
         m_i2c = new DUNE::Hardware::I2C(dev);
         m_i2c->connect(adr);
 
-        m_gpios = getPortValue(0);
-        m_gpios |= getPortValue(1) << 8;
+        uint8_t cmds[] = {c_mcp23017_r_gpioa, c_mcp23017_r_gpioa + 1};
+        uint8_t values[2] = {0, 0};
+        DUNE::Hardware::I2C::Transaction trans;
+        trans.write(m_adr, &cmds[0], 1);
+        trans.read(m_adr, &values[0], 1);
+        trans.write(m_adr, &cmds[1], 1);
+        trans.read(m_adr, &values[1], 1);
+        m_i2c->submit(trans);
+
+        m_gpios = values[0] | (values[1] << 8);
       }
 
       ~MCP23017(void)
@@ -69,8 +77,12 @@ namespace Power
       void
       setGPIOs(uint16_t gpios)
       {
-        setPortValue(0, (uint8_t)gpios);
-        setPortValue(1, (uint8_t)(gpios >> 8));
+        uint8_t porta[] = {c_mcp23017_r_gpioa, (uint8_t)gpios};
+        uint8_t portb[] = {c_mcp23017_r_gpioa + 1, (uint8_t)(gpios >> 8)};
+        DUNE::Hardware::I2C::Transaction trans;
+        trans.write(m_adr, porta, sizeof(porta));
+        trans.write(m_adr, portb, sizeof(portb));
+        m_i2c->submit(trans);
         m_gpios = gpios;
       }
 
@@ -78,21 +90,6 @@ namespace Power
       DUNE::Hardware::I2C* m_i2c;
       uint8_t m_adr;
       uint16_t m_gpios;
-
-      uint8_t
-      getPortValue(uint8_t port)
-      {
-        uint8_t value = 0;
-        m_i2c->transfer(m_adr, c_mcp23017_r_gpioa + port, 0, 0, &value, 1, 0);
-        return value;
-      }
-
-      void
-      setPortValue(uint8_t port, uint8_t value)
-      {
-        uint8_t cmd[] = {(uint8_t)(c_mcp23017_r_gpioa + port), value};
-        m_i2c->write(cmd, sizeof(cmd));
-      }
     };
   }
 }
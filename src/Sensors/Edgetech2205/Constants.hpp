@@ -108,6 +108,7 @@ namespace Sensors
     enum SonarDataIndices
     {
       SDATA_IDX_TIME = 0,
+      SDATA_IDX_PING_NUMBER = 8,
       SDATA_IDX_MSB = 16,
       SDATA_IDX_VALIDITY = 30,
       SDATA_IDX_DATA_FORMAT = 34,
@@ -115,6 +116,7 @@ namespace Sensors
       SDATA_IDX_LATITUDE = 84,
       SDATA_IDX_COORDINATE_UNITS = 88,
       SDATA_IDX_DATA_SAMPLES  = 114,
+      SDATA_IDX_SAMPLE_INTERVAL = 116,
       SDATA_IDX_PULSE_START_FREQ = 126,
       SDATA_IDX_PULSE_END_FREQ = 128,
       SDATA_IDX_DEPTH = 136,
@@ -0,0 +1,475 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef SENSORS_EDGETECH2205_RECORDER_HPP_INCLUDED_
+#define SENSORS_EDGETECH2205_RECORDER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace Sensors
+{
+  namespace Edgetech2205
+  {
+    using DUNE_NAMESPACES;
+
+    //! Recorder of raw sonar data. The task thread copies packets
+    //! into large aligned blocks, that are handed over to the
+    //! recorder thread through lock-free queues and written with
+    //! O_DIRECT, bypassing the page cache, so that hundreds of
+    //! megabytes of sidescan data do not evict everything else from
+    //! memory. If the file system does not support direct I/O, the
+    //! file is written normally and pages are dropped from the cache
+    //! after being written. Data is never dropped: if all blocks are
+    //! waiting to be written the task waits for the recorder.
+    class Recorder: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] block_size size of blocks in bytes (rounded up to
+      //! the direct I/O alignment).
+      //! @param[in] block_count number of blocks.
+      Recorder(unsigned block_size, unsigned block_count):
+        m_block_size(roundUp(std::max(block_size, (unsigned)c_alignment))),
+        m_block(NULL),
+        m_requests(block_count + c_extra_requests),
+        m_free(block_count),
+        m_stalls(0),
+        m_opened(false),
+        m_fd(-1),
+        m_size(0),
+        m_direct(false)
+      {
+        for (unsigned i = 0; i < block_count; ++i)
+        {
+          m_blocks.push_back(new Block(m_block_size));
+          m_free.push(m_blocks.back());
+        }
+      }
+
+      //! Destructor.
+      ~Recorder(void)
+      {
+        if (isCreated())
+        {
+          stop();
+          m_requests.wakeup();
+          join();
+        }
+
+        closeFile();
+
+        for (unsigned i = 0; i < m_blocks.size(); ++i)
+          delete m_blocks[i];
+      }
+
+      //! Write subsequent data to a new file. The current file is
+      //! closed after all its data is written.
+      //! @param[in] path path of the file.
+      void
+      open(const Path& path)
+      {
+        Request req(OP_OPEN);
+        req.path = path.str();
+        submit(req);
+        m_opened = true;
+      }
+
+      //! Close the current file after all its data is written.
+      void
+      close(void)
+      {
+        if (!m_opened)
+          return;
+
+        submit(Request(OP_CLOSE));
+        m_opened = false;
+      }
+
+      //! Test if a file is open.
+      //! @return true if a file is open, false otherwise.
+      bool
+      isOpen(void) const
+      {
+        return m_opened;
+      }
+
+      //! Append data to the current file.
+      //! @param[in] data data.
+      //! @param[in] size size of data.
+      void
+      write(const uint8_t* data, unsigned size)
+      {
+        if (!m_opened)
+          return;
+
+        while (size > 0)
+        {
+          if (m_block == NULL)
+            m_block = getBlock();
+
+          unsigned len = std::min(size, m_block_size - m_block->size);
+          std::memcpy(m_block->data + m_block->size, data, len);
+          m_block->size += len;
+          data += len;
+          size -= len;
+
+          if (m_block->size == m_block_size)
+            submitBlock();
+        }
+      }
+
+      //! Retrieve and reset the number of times the task waited for
+      //! the recorder thread.
+      //! @return number of waits.
+      unsigned
+      getStalls(void)
+      {
+        unsigned rv = m_stalls;
+        m_stalls = 0;
+        return rv;
+      }
+
+      //! Retrieve the first error reported by the recorder thread.
+      //! @param[out] error error message.
+      //! @return true if an error happened, false otherwise.
+      bool
+      getError(std::string& error)
+      {
+        ScopedMutex l(m_error_lock);
+        error = m_error;
+        return !m_error.empty();
+      }
+
+    private:
+      //! Block of data, aligned for direct I/O.
+      struct Block
+      {
+        //! Storage.
+        std::vector<uint8_t> storage;
+        //! Aligned start of storage.
+        uint8_t* data;
+        //! Amount of data.
+        unsigned size;
+
+        Block(unsigned capacity):
+          storage(capacity + c_alignment),
+          size(0)
+        {
+          uintptr_t addr = reinterpret_cast<uintptr_t>(&storage[0]);
+          data = &storage[0] + (c_alignment - addr % c_alignment) % c_alignment;
+        }
+      };
+
+      //! Request operations.
+      enum Operation
+      {
+        //! Write a block.
+        OP_WRITE,
+        //! Switch to a new file.
+        OP_OPEN,
+        //! Close file.
+        OP_CLOSE
+      };
+
+      //! Request to the recorder thread.
+      struct Request
+      {
+        //! Operation.
+        Operation op;
+        //! Block to write.
+        Block* block;
+        //! Path of file to open.
+        std::string path;
+
+        Request(Operation o = OP_WRITE):
+          op(o),
+          block(NULL)
+        { }
+      };
+
+      enum
+      {
+        //! Alignment of buffers, sizes and offsets for direct I/O.
+        c_alignment = 4096,
+        //! Number of requests besides blocks that may be pending.
+        c_extra_requests = 16
+      };
+
+      //! Size of blocks.
+      unsigned m_block_size;
+      //! Block being filled by the task.
+      Block* m_block;
+      //! All allocated blocks.
+      std::vector<Block*> m_blocks;
+      //! Requests to the recorder thread.
+      Concurrency::MPSCQueue<Request> m_requests;
+      //! Blocks written by the recorder thread.
+      Concurrency::MPSCQueue<Block*> m_free;
+      //! Number of waits for free blocks.
+      unsigned m_stalls;
+      //! True if the task opened a file.
+      bool m_opened;
+      //! Error message.
+      std::string m_error;
+      //! Error message lock.
+      Concurrency::Mutex m_error_lock;
+      //! Current file descriptor (only used by the recorder thread).
+      int m_fd;
+      //! Path of current file (only used by the recorder thread).
+      std::string m_path;
+      //! Amount of data in the current file.
+      uint64_t m_size;
+      //! True if the current file is written with direct I/O.
+      bool m_direct;
+
+      //! Round a size up to the direct I/O alignment.
+      //! @param[in] size size.
+      //! @return rounded size.
+      static unsigned
+      roundUp(unsigned size)
+      {
+        return (size + c_alignment - 1) / c_alignment * c_alignment;
+      }
+
+      //! Get an empty block, waiting for the recorder thread if
+      //! needed.
+      //! @return block.
+      Block*
+      getBlock(void)
+      {
+        Block* block = NULL;
+        if (!m_free.pop(block))
+        {
+          ++m_stalls;
+          while (!m_free.pop(block))
+            Delay::wait(0.001);
+        }
+
+        block->size = 0;
+        return block;
+      }
+
+      //! Hand the current block over to the recorder thread.
+      void
+      submitBlock(void)
+      {
+        if (m_block == NULL || m_block->size == 0)
+          return;
+
+        Request req(OP_WRITE);
+        req.block = m_block;
+        m_block = NULL;
+
+        while (!m_requests.push(req))
+          Delay::wait(0.001);
+      }
+
+      //! Submit a request, preceded by the current block.
+      //! @param[in] req request.
+      void
+      submit(const Request& req)
+      {
+        submitBlock();
+
+        while (!m_requests.push(req))
+          Delay::wait(0.001);
+      }
+
+      //! Open a file, with direct I/O if possible.
+      //! @param[in] path path of the file.
+      void
+      openFile(const std::string& path)
+      {
+        closeFile();
+
+        m_path = path;
+        m_size = 0;
+        m_direct = false;
+
+#if defined(O_DIRECT)
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        if (m_fd != -1)
+        {
+          m_direct = true;
+          return;
+        }
+#endif
+
+        m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (m_fd == -1)
+          throw std::runtime_error(String::str(DTR("failed to open '%s': %s"),
+                                               path.c_str(), std::strerror(errno)));
+      }
+
+      //! Stop using direct I/O for the current file.
+      void
+      disableDirect(void)
+      {
+#if defined(O_DIRECT)
+        int flags = fcntl(m_fd, F_GETFL);
+        if (flags != -1)
+          fcntl(m_fd, F_SETFL, flags & ~O_DIRECT);
+#endif
+        m_direct = false;
+      }
+
+      //! Write a block to the current file. Direct I/O needs whole
+      //! aligned blocks, so a partial block (the last of a file) is
+      //! padded and the file truncated to its true size on close.
+      //! @param[in] block block.
+      void
+      writeBlock(Block* block)
+      {
+        if (m_fd == -1)
+          return;
+
+        // Data after a padded block would land at an unaligned offset.
+        if (m_direct && (m_size % c_alignment) != 0)
+          disableDirect();
+
+        unsigned len = block->size;
+        if (m_direct)
+        {
+          len = roundUp(block->size);
+          std::memset(block->data + block->size, 0, len - block->size);
+        }
+
+        off_t offset = static_cast<off_t>(m_size);
+        ssize_t rv = pwrite(m_fd, block->data, len, offset);
+        if (rv == -1 && errno == EINVAL && m_direct)
+        {
+          // Some file systems accept O_DIRECT but reject the writes.
+          disableDirect();
+          len = block->size;
+          rv = pwrite(m_fd, block->data, len, offset);
+        }
+
+        if (rv != static_cast<ssize_t>(len))
+          throw std::runtime_error(String::str(DTR("failed to write to '%s': %s"),
+                                               m_path.c_str(),
+                                               rv == -1 ? std::strerror(errno) : DTR("short write")));
+
+        m_size += block->size;
+
+#if defined(POSIX_FADV_DONTNEED)
+        if (!m_direct)
+          posix_fadvise(m_fd, 0, offset, POSIX_FADV_DONTNEED);
+#endif
+      }
+
+      //! Close the current file, removing it if empty.
+      void
+      closeFile(void)
+      {
+        if (m_fd == -1)
+          return;
+
+        bool error = ftruncate(m_fd, static_cast<off_t>(m_size)) != 0;
+        error = (::close(m_fd) != 0) || error;
+        m_fd = -1;
+
+        if (m_size == 0)
+          Path(m_path).remove();
+
+        if (error)
+          throw std::runtime_error(String::str(DTR("failed to close '%s'"), m_path.c_str()));
+      }
+
+      void
+      handle(Request& req)
+      {
+        switch (req.op)
+        {
+          case OP_WRITE:
+            writeBlock(req.block);
+            m_free.push(req.block);
+            break;
+
+          case OP_OPEN:
+            openFile(req.path);
+            break;
+
+          case OP_CLOSE:
+            closeFile();
+            break;
+        }
+      }
+
+      void
+      run(void)
+      {
+        Request req;
+
+        while (true)
+        {
+          if (!m_requests.pop(req))
+          {
+            if (isStopping())
+              break;
+
+            m_requests.waitForItems(1.0);
+            continue;
+          }
+
+          try
+          {
+            handle(req);
+          }
+          catch (std::exception& e)
+          {
+            ScopedMutex l(m_error_lock);
+            if (m_error.empty())
+              m_error = e.what();
+
+            // Keep returning blocks so that the task never stalls.
+            if (req.op == OP_WRITE)
+              m_free.push(req.block);
+          }
+        }
+      }
+    };
+  }
+}
+
+#endif
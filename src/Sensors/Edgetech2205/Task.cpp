@@ -26,6 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <cmath>
 #include <cstring>
 #include <string>
 
@@ -35,6 +36,7 @@
 // Local headers.
 #include "Parser.hpp"
 #include "CommandLink.hpp"
+#include "Recorder.hpp"
 
 namespace Sensors
 {
@@ -64,8 +66,21 @@ namespace Sensors
       unsigned autosel_mode;
       //! Trigger divisor.
       unsigned trg_div;
+      //! Size of recorder blocks in KiB.
+      unsigned rec_block_size;
+      //! Number of recorder blocks.
+      unsigned rec_blocks;
+      //! Preview one out of this many pings (0 to disable).
+      unsigned preview_dec;
+      //! Maximum number of samples per preview trace.
+      unsigned preview_samples;
     };
 
+    //! Speed of sound used to compute preview ranges.
+    static const double c_sound_speed = 1500.0;
+    //! Number of sidescan subsystems.
+    static const unsigned c_subsys_ss_count = 2;
+
     struct Task: public Tasks::Task
     {
       //! Buffer size.
@@ -78,10 +93,18 @@ namespace Sensors
       Parser m_parser;
       //! Command link.
       CommandLink* m_cmd;
-      //! Log file.
-      std::ofstream m_log_file;
+      //! Data recorder.
+      Recorder* m_rec;
       //! Log filename
       Path m_log_path;
+      //! Preview message.
+      IMC::SonarData m_preview;
+      //! Recycled preview messages.
+      IMC::SharedMessagePool<IMC::SonarData> m_preview_pool;
+      //! Ping number of the port preview trace of each subsystem.
+      uint32_t m_preview_ping[c_subsys_ss_count];
+      //! Port preview trace of each subsystem.
+      std::vector<char> m_preview_port[c_subsys_ss_count];
       //! Time difference.
       int64_t m_time_diff;
       //! Estimated state.
@@ -103,6 +126,7 @@ namespace Sensors
         Tasks::Task(name, ctx),
         m_sock_dat(NULL),
         m_cmd(NULL),
+        m_rec(NULL),
         m_time_diff(0),
         m_activating(false),
         m_deactivating(false),
@@ -180,8 +204,36 @@ namespace Sensors
         .defaultValue("Sidescan")
         .description("Name of sidescan's power channel");
 
+        param("Recorder - Block Size", m_args.rec_block_size)
+        .defaultValue("1024")
+        .minimumValue("4")
+        .units(Units::Kibibyte)
+        .description("Size of the blocks written to storage");
+
+        param("Recorder - Blocks", m_args.rec_blocks)
+        .defaultValue("16")
+        .minimumValue("2")
+        .description("Number of blocks buffered while waiting for storage");
+
+        param("Preview Decimation", m_args.preview_dec)
+        .defaultValue("0")
+        .visibility(Tasks::Parameter::VISIBILITY_USER)
+        .description("Dispatch one out of this many pings as SonarData"
+                     " for operators (0 to disable)");
+
+        param("Preview Samples", m_args.preview_samples)
+        .defaultValue("500")
+        .minimumValue("16")
+        .description("Maximum number of samples per channel of preview pings");
+
         m_bfr.resize(c_buffer_size);
 
+        m_preview.type = IMC::SonarData::ST_SIDESCAN;
+        m_preview.bits_per_point = 16;
+        m_preview.min_range = 0;
+        for (unsigned i = 0; i < c_subsys_ss_count; ++i)
+          m_preview_ping[i] = 0;
+
         m_pwr_ss.op = IMC::PowerChannelControl::PCC_OP_TURN_OFF;
 
         bind<IMC::EstimatedState>(this);
@@ -208,11 +260,19 @@ namespace Sensors
         }
       }
 
+      void
+      onResourceAcquisition(void)
+      {
+        m_rec = new Recorder(m_args.rec_block_size * 1024, m_args.rec_blocks);
+        m_rec->start();
+      }
+
       void
       onResourceRelease(void)
       {
         requestDeactivation();
         closeLog();
+        Memory::clear(m_rec);
       }
 
       void
@@ -491,6 +551,107 @@ namespace Sensors
           writeToLog(pkt);
         else
           m_first_shot = false;
+
+        if (pkt->getMessageType() == MSG_ID_SONAR_DATA && m_args.preview_dec > 0)
+          handlePreview(pkt);
+      }
+
+      //! Reduce a trace to the preview size, keeping the strongest
+      //! return of each group of samples.
+      //! @param[in] pkt sonar data packet.
+      //! @param[in] samples number of samples of the trace.
+      //! @param[in] reverse true to store the farthest sample first.
+      //! @param[out] out preview trace (16-bit samples).
+      void
+      decimateTrace(Packet* pkt, unsigned samples, bool reverse, std::vector<char>& out)
+      {
+        unsigned count = std::min(samples, m_args.preview_samples);
+        unsigned group = (samples + count - 1) / count;
+        count = (samples + group - 1) / group;
+        out.resize(count * 2);
+
+        const uint8_t* trace = pkt->getMessageData() + SDATA_IDX_TRACE_DATA;
+        for (unsigned i = 0; i < count; ++i)
+        {
+          uint16_t peak = 0;
+          unsigned end = std::min((i + 1) * group, samples);
+          for (unsigned j = i * group; j < end; ++j)
+          {
+            uint16_t value = 0;
+            ByteCopy::fromLE(value, trace + j * 2);
+            peak = std::max(peak, value);
+          }
+
+          unsigned idx = reverse ? (count - 1 - i) : i;
+          ByteCopy::toLE(peak, (uint8_t*)&out[idx * 2]);
+        }
+      }
+
+      //! Dispatch decimated pings as SonarData. Port and starboard
+      //! traces of the same ping arrive in separate packets and are
+      //! joined, port first, as other sidescan drivers do.
+      //! @param[in] pkt sonar data packet.
+      void
+      handlePreview(Packet* pkt)
+      {
+        uint32_t ping = 0;
+        pkt->get(ping, SDATA_IDX_PING_NUMBER);
+        if (ping % m_args.preview_dec != 0)
+          return;
+
+        uint8_t subsys = pkt->getSubsystemNumber();
+        if (subsys != SUBSYS_SSL && subsys != SUBSYS_SSH)
+          return;
+
+        // Only envelope data is previewed.
+        uint16_t format = 0;
+        uint16_t samples = 0;
+        pkt->get(format, SDATA_IDX_DATA_FORMAT);
+        pkt->get(samples, SDATA_IDX_DATA_SAMPLES);
+        if (format != 0 || samples == 0)
+          return;
+
+        if (pkt->getMessageSize() < SDATA_IDX_TRACE_DATA + samples * 2u)
+          return;
+
+        unsigned idx = subsys - c_subsys_ss_offset;
+        const std::string& channels = (subsys == SUBSYS_SSH) ? m_args.channels_hf : m_args.channels_lf;
+        bool port = pkt->getChannel() == CHAN_PORT;
+
+        if (channels == "Both")
+        {
+          if (port)
+          {
+            decimateTrace(pkt, samples, true, m_preview_port[idx]);
+            m_preview_ping[idx] = ping;
+            return;
+          }
+
+          if (m_preview_port[idx].empty() || m_preview_ping[idx] != ping)
+            return;
+
+          std::vector<char> stbd;
+          decimateTrace(pkt, samples, false, stbd);
+          m_preview.data.swap(m_preview_port[idx]);
+          m_preview.data.insert(m_preview.data.end(), stbd.begin(), stbd.end());
+          m_preview_port[idx].clear();
+        }
+        else
+        {
+          decimateTrace(pkt, samples, port, m_preview.data);
+        }
+
+        int16_t weight = 0;
+        uint16_t freq = 0;
+        uint32_t interval = 0;
+        pkt->get(weight, SDATA_IDX_WEIGHT_FACTOR);
+        pkt->get(freq, SDATA_IDX_PULSE_START_FREQ);
+        pkt->get(interval, SDATA_IDX_SAMPLE_INTERVAL);
+
+        m_preview.frequency = freq * 10;
+        m_preview.max_range = static_cast<uint16_t>(samples * interval * 1e-9 * c_sound_speed / 2.0);
+        m_preview.scale_factor = static_cast<fp32_t>(std::pow(2.0, -weight));
+        dispatch(m_preview_pool.take(m_preview, &IMC::SonarData::data));
       }
 
       bool
@@ -546,35 +707,39 @@ namespace Sensors
       void
       openLog(const Path& path)
       {
-        if (path == m_log_path)
+        if (m_rec == NULL || (m_rec->isOpen() && path == m_log_path))
           return;
 
-        closeLog();
-
         m_log_path = path;
-        m_log_file.open(m_log_path.c_str(), std::ios::binary);
+        m_rec->open(m_log_path);
         debug("opening %s", m_log_path.c_str());
       }
 
       void
       writeToLog(const Packet* pkt)
       {
-        m_log_file.write((const char*)pkt->getData(), pkt->getSize());
+        if (m_rec != NULL)
+          m_rec->write(pkt->getData(), pkt->getSize());
       }
 
+      //! Close the log. The recorder removes it if it is empty.
       void
       closeLog(void)
       {
-        if (m_log_file.is_open())
-        {
-          m_log_file.close();
-          int64_t size = m_log_path.size();
-          if (size == 0)
-          {
-            debug("removing empty log '%s'", m_log_path.c_str());
-            m_log_path.remove();
-          }
-        }
+        if (m_rec != NULL)
+          m_rec->close();
+      }
+
+      void
+      checkRecorder(void)
+      {
+        unsigned stalls = m_rec->getStalls();
+        if (stalls > 0)
+          debug("waited %u times for storage", stalls);
+
+        std::string error;
+        if (m_rec->getError(error))
+          throw RestartNeeded(error, 5);
       }
 
       void
@@ -587,6 +752,7 @@ namespace Sensors
           if (isActive() && (m_sock_dat != NULL))
           {
             readData();
+            checkRecorder();
 
             try
             {
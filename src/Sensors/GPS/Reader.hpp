@@ -37,12 +37,23 @@ namespace Sensors
   {
     using DUNE_NAMESPACES;
 
-    //! Read buffer size.
-    static const size_t c_read_buffer_size = 4096;
     //! Line termination character.
     static const char c_line_term = '\n';
+    //! RTCM 3 preamble.
+    static const uint8_t c_rtcm3_preamble = 0xd3;
+    //! RTCM 3 header size.
+    static const unsigned c_rtcm3_header_size = 3;
+    //! RTCM 3 CRC size.
+    static const unsigned c_rtcm3_crc_size = 3;
+    //! Maximum size of a binary frame.
+    static const unsigned c_max_frame_size = 1200;
 
-    class Reader: public Concurrency::Thread
+    //! Splits input received through the shared I/O reactor into
+    //! lines and loops them back to the parent task as DevDataText
+    //! messages stamped with the time of arrival of their first byte.
+    //! Binary UBX and RTCM 3 frames interleaved with the sentences are
+    //! looped back whole as DevDataBinary messages.
+    class Reader: public IO::Reactor::Listener
     {
     public:
       //! Constructor.
@@ -50,9 +61,23 @@ namespace Sensors
       //! @param[in] handle I/O handle.
       Reader(Tasks::Task* task, IO::Handle* handle):
         m_task(task),
-        m_handle(handle)
+        m_handle(handle),
+        m_line_tstamp(0),
+        m_frame_size(0)
+      { }
+
+      //! Start receiving input.
+      void
+      start(void)
+      {
+        IO::Reactor::getShared().add(*m_handle, this);
+      }
+
+      //! Stop receiving input.
+      void
+      stop(void)
       {
-        m_buffer.resize(c_read_buffer_size);
+        IO::Reactor::getShared().remove(*m_handle);
       }
 
     private:
@@ -60,61 +85,142 @@ namespace Sensors
       Tasks::Task* m_task;
       //! I/O handle.
       IO::Handle* m_handle;
-      //! Internal read buffer.
-      std::vector<char> m_buffer;
       //! Current line.
       std::string m_line;
+      //! Arrival time of the current line.
+      double m_line_tstamp;
+      //! Current binary frame.
+      std::vector<char> m_frame;
+      //! Expected size of the current binary frame, or zero if unknown.
+      size_t m_frame_size;
 
       void
       dispatch(IMC::Message& msg)
       {
         msg.setDestination(m_task->getSystemId());
         msg.setDestinationEntity(m_task->getEntityId());
-        m_task->dispatch(msg, DF_LOOP_BACK);
+        m_task->dispatch(msg, DF_LOOP_BACK | DF_KEEP_TIME);
+      }
+
+      //! Compute the size of the binary frame being received.
+      //! @return frame size, zero if not yet known.
+      size_t
+      getFrameSize(void) const
+      {
+        const uint8_t* bfr = (const uint8_t*)&m_frame[0];
+
+        if (bfr[0] == Parsers::UBX::c_sync0)
+          return Parsers::UBX::getFrameSize(bfr, m_frame.size());
+
+        if (m_frame.size() < c_rtcm3_header_size)
+          return 0;
+
+        return c_rtcm3_header_size + (((bfr[1] & 0x03) << 8) | bfr[2]) + c_rtcm3_crc_size;
+      }
+
+      //! Check if the bytes received so far may start a binary frame.
+      //! @return true if they may, false otherwise.
+      bool
+      isFramePrefix(void) const
+      {
+        const uint8_t* bfr = (const uint8_t*)&m_frame[0];
+
+        if (bfr[0] == Parsers::UBX::c_sync0)
+          return m_frame.size() < 2 || bfr[1] == Parsers::UBX::c_sync1;
+
+        // The six most significant bits after the preamble are reserved.
+        return m_frame.size() < 2 || (bfr[1] & 0xfc) == 0;
       }
 
+      //! Add a byte to the current binary frame.
+      //! @param[in] byte byte.
       void
-      read(void)
+      addFrameByte(uint8_t byte)
       {
-        if (!Poll::poll(*m_handle, 1.0))
+        m_frame.push_back((char)byte);
+
+        if (!isFramePrefix())
+        {
+          // Not a frame after all: hand the bytes over to the line.
+          std::vector<char> bytes;
+          bytes.swap(m_frame);
+          m_frame_size = 0;
+          for (size_t i = 0; i < bytes.size(); ++i)
+            addLineByte((uint8_t)bytes[i]);
           return;
+        }
 
-        size_t rv = m_handle->read(&m_buffer[0], m_buffer.size());
-        if (rv == 0)
-          throw std::runtime_error(DTR("invalid read size"));
+        if (m_frame_size == 0)
+          m_frame_size = getFrameSize();
 
-        for (size_t i = 0; i < rv; ++i)
+        if (m_frame_size > c_max_frame_size)
         {
-          m_line.push_back(m_buffer[i]);
-          if (m_buffer[i] == c_line_term)
-          {
-            IMC::DevDataText line;
-            line.value = m_line;
-            dispatch(line);
-            m_line.clear();
-          }
+          m_frame.clear();
+          m_frame_size = 0;
+          return;
         }
+
+        if (m_frame_size == 0 || m_frame.size() < m_frame_size)
+          return;
+
+        IMC::DevDataBinary frame;
+        frame.setTimeStamp(m_line_tstamp);
+        frame.value.swap(m_frame);
+        dispatch(frame);
+        m_frame.clear();
+        m_frame_size = 0;
       }
 
+      //! Add a byte to the current line.
+      //! @param[in] byte byte.
       void
-      run(void)
+      addLineByte(uint8_t byte)
       {
-        while (!isStopping())
+        m_line.push_back((char)byte);
+        if (byte == c_line_term)
         {
-          try
+          IMC::DevDataText line;
+          line.setTimeStamp(m_line_tstamp);
+          line.value = m_line;
+          dispatch(line);
+          m_line.clear();
+        }
+      }
+
+      void
+      onData(const uint8_t* data, size_t size, double tstamp)
+      {
+        for (size_t i = 0; i < size; ++i)
+        {
+          if (!m_frame.empty())
           {
-            read();
+            addFrameByte(data[i]);
+            continue;
           }
-          catch (std::runtime_error& e)
+
+          if (m_line.empty())
           {
-            IMC::IoEvent evt;
-            evt.type = IMC::IoEvent::IOV_TYPE_INPUT_ERROR;
-            evt.error = e.what();
-            dispatch(evt);
-            break;
+            m_line_tstamp = tstamp;
+
+            if (data[i] == Parsers::UBX::c_sync0 || data[i] == c_rtcm3_preamble)
+            {
+              addFrameByte(data[i]);
+              continue;
+            }
           }
+
+          addLineByte(data[i]);
         }
       }
+
+      void
+      onError(const std::string& error)
+      {
+        IMC::IoEvent evt;
+        evt.type = IMC::IoEvent::IOV_TYPE_INPUT_ERROR;
+        evt.error = error;
+        dispatch(evt);
+      }
     };
   }
 }
@@ -26,8 +26,8 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <cmath>
 #include <cstring>
-#include <algorithm>
 #include <cstddef>
 
 // DUNE headers.
@@ -63,6 +63,8 @@ namespace Sensors
     static const unsigned c_gprot_fields = 3;
     //! Minimum number of fields of PSATHPR sentence.
     static const unsigned c_psathpr_fields = 7;
+    //! Maximum number of fields of a sentence.
+    static const unsigned c_max_fields = 32;
     //! Power on delay.
     static const double c_pwr_on_delay = 5.0;
 
@@ -82,6 +84,17 @@ namespace Sensors
       std::string init_rpls[c_max_init_cmds];
       //! Power channels.
       std::vector<std::string> pwr_channels;
+      //! Use pulses as time reference.
+      bool pulse_ref;
+    };
+
+    //! Arrival of the first frame of a UBX epoch.
+    struct EpochArrival
+    {
+      //! GPS time of week of the epoch (ms).
+      uint32_t itow;
+      //! Arrival time.
+      double tstamp;
     };
 
     struct Task: public Tasks::Task
@@ -104,15 +117,22 @@ namespace Sensors
       bool m_has_euler;
       //! Last initialization line read.
       std::string m_init_line;
-      //! Reader thread.
+      //! Input reader.
       Reader* m_reader;
+      //! UBX decoder.
+      Parsers::UBX m_ubx;
+      //! Arrival of the current and previous UBX epochs.
+      EpochArrival m_arrival[2];
+      //! Time of the last pulse.
+      double m_pulse;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
         m_handle(NULL),
         m_has_agvel(false),
         m_has_euler(false),
-        m_reader(NULL)
+        m_reader(NULL),
+        m_pulse(-1)
       {
         // Define configuration parameters.
         param("Serial Port - Device", m_args.uart_dev)
@@ -137,6 +157,12 @@ namespace Sensors
         .defaultValue("")
         .description("Sentence order");
 
+        param("Pulse Time Reference", m_args.pulse_ref)
+        .defaultValue("false")
+        .description("Timestamp fixes with the time of the last pulse"
+                     " (e.g., from the PPS task) plus the fraction of second"
+                     " of the fix, instead of the arrival time of the data");
+
         for (unsigned i = 0; i < c_max_init_cmds; ++i)
         {
           std::string cmd_label = String::str("Initialization String %u - Command", i);
@@ -151,8 +177,16 @@ namespace Sensors
         // Initialize messages.
         clearMessages();
 
+        for (unsigned i = 0; i < 2; ++i)
+        {
+          m_arrival[i].itow = 0;
+          m_arrival[i].tstamp = 0;
+        }
+
+        bind<IMC::DevDataBinary>(this);
         bind<IMC::DevDataText>(this);
         bind<IMC::IoEvent>(this);
+        bind<IMC::Pulse>(this);
       }
 
       void
@@ -207,7 +241,7 @@ namespace Sensors
       {
         if (m_reader != NULL)
         {
-          m_reader->stopAndJoin();
+          m_reader->stop();
           delete m_reader;
           m_reader = NULL;
         }
@@ -255,7 +289,54 @@ namespace Sensors
         if (getEntityState() == IMC::EntityState::ESTA_BOOT)
           m_init_line = msg->value;
         else
-          processSentence(msg->value);
+          processSentence(msg->value, msg->getTimeStamp());
+      }
+
+      void
+      consume(const IMC::DevDataBinary* msg)
+      {
+        if (msg->getDestination() != getSystemId())
+          return;
+
+        if (msg->getDestinationEntity() != getEntityId())
+          return;
+
+        if (getEntityState() == IMC::EntityState::ESTA_BOOT)
+          return;
+
+        // RTCM 3 frames are not interpreted.
+        Parsers::UBX::Frame frame;
+        const uint8_t* bfr = (const uint8_t*)&msg->value[0];
+        if (msg->value.empty() || !Parsers::UBX::decode(bfr, msg->value.size(), frame))
+          return;
+
+        if (frame.cls == Parsers::UBX::CLS_NAV && frame.size >= 4)
+        {
+          uint32_t itow = 0;
+          ByteCopy::fromLE(itow, frame.payload);
+          if (itow != m_arrival[0].itow)
+          {
+            m_arrival[1] = m_arrival[0];
+            m_arrival[0].itow = itow;
+            m_arrival[0].tstamp = msg->getTimeStamp();
+          }
+        }
+
+        if (!m_ubx.add(frame))
+          return;
+
+        const Parsers::UBX::Solution& sol = m_ubx.getSolution();
+        if (sol.itow == m_arrival[0].itow)
+          interpretSolution(sol, m_arrival[0].tstamp);
+        else
+          interpretSolution(sol, m_arrival[1].tstamp);
+      }
+
+      void
+      consume(const IMC::Pulse* msg)
+      {
+        if (m_args.pulse_ref)
+          m_pulse = msg->getTimeStamp();
       }
 
       void
@@ -304,20 +385,19 @@ namespace Sensors
       //! @param[out] dst time.
       //! @return true if successful, false otherwise.
       bool
-      readTime(const std::string& str, float& dst)
+      readTime(const StringView& str, float& dst)
       {
-        unsigned h = 0;
-        unsigned m = 0;
-        unsigned s = 0;
-        double sfp = 0;
-
-        if (std::sscanf(str.c_str(), "%02u%02u%lf", &h, &m, &sfp) != 3)
-        {
-          if (std::sscanf(str.c_str(), "%02u%02u%02u", &h, &m, &s) != 3)
-            return false;
-        }
+        uint8_t h = 0;
+        uint8_t m = 0;
+        double s = 0;
+
+        if (str.size() < 6
+            || !str.substr(0, 2).toNumber(h)
+            || !str.substr(2, 2).toNumber(m)
+            || !str.substr(4).toNumber(s))
+          return false;
 
-        dst = (h * 3600) + (m * 60) + s + sfp;
+        dst = (h * 3600) + (m * 60) + s;
 
         return true;
       }
@@ -328,12 +408,12 @@ namespace Sensors
       //! @param[out] dst latitude.
       //! @return true if successful, false otherwise.
       bool
-      readLatitude(const std::string& str, const std::string& h, double& dst)
+      readLatitude(const StringView& str, const StringView& h, double& dst)
       {
-        int degrees = 0;
+        uint8_t degrees = 0;
         double minutes = 0;
 
-        if (std::sscanf(str.c_str(), "%02d%lf", &degrees, &minutes) != 2)
+        if (!str.substr(0, 2).toNumber(degrees) || !str.substr(2).toNumber(minutes))
           return false;
 
         dst = Angles::convertDMSToDecimal(degrees, minutes);
@@ -349,13 +429,13 @@ namespace Sensors
       //! @param[in] h either West (W) or East (E).
       //! @param[out] dst longitude.
       //! @return true if successful, false otherwise.
-      double
-      readLongitude(const std::string& str, const std::string& h, double& dst)
+      bool
+      readLongitude(const StringView& str, const StringView& h, double& dst)
       {
-        int degrees = 0;
+        uint8_t degrees = 0;
         double minutes = 0;
 
-        if (std::sscanf(str.c_str(), "%03d%lf", &degrees, &minutes) != 2)
+        if (!str.substr(0, 3).toNumber(degrees) || !str.substr(3).toNumber(minutes))
           return false;
 
         dst = Angles::convertDMSToDecimal(degrees, minutes);
@@ -372,13 +452,9 @@ namespace Sensors
       //! @return true if successful, false otherwise.
       template <typename T>
       bool
-      readDecimal(const std::string& str, T& dst)
+      readDecimal(const StringView& str, T& dst)
       {
-        unsigned idx = 0;
-        while (str[idx] == '0')
-          ++idx;
-
-        return castLexical(std::string(str, idx), dst);
+        return str.toNumber(dst);
       }
 
       //! Read number from input string.
@@ -387,131 +463,221 @@ namespace Sensors
       //! @return true if successful, false otherwise.
       template <typename T>
       bool
-      readNumber(const std::string& str, T& dst)
+      readNumber(const StringView& str, T& dst)
       {
-        return castLexical(str, dst);
+        return str.toNumber(dst);
       }
 
       //! Process sentence.
       //! @param[in] line line.
+      //! @param[in] tstamp arrival time of the line.
       void
-      processSentence(const std::string& line)
+      processSentence(const std::string& line, double tstamp)
       {
-        // Discard leading noise.
-        size_t sidx = 0;
-        for (sidx = 0; sidx < line.size(); ++sidx)
-        {
-          if (line[sidx] == '$')
-            break;
-        }
-
-        // Discard trailing noise.
-        size_t eidx = 0;
-        for (eidx = line.size() - 1; eidx > sidx; --eidx)
-        {
-          if (line[eidx] == '*')
-            break;
-        }
-
-        if (sidx >= eidx)
-          return;
-
-        // Compute checksum.
-        uint8_t ccsum = 0;
-        for (size_t i = sidx + 1; i < eidx; ++i)
-          ccsum ^= line[i];
-
-        // Validate checksum.
-        unsigned rcsum = 0;
-        if (std::sscanf(&line[0] + eidx + 1, "%02X", &rcsum) != 1)
+        // Discard noise and sentences with invalid checksums.
+        StringView body;
+        if (!NMEAParser::validate(line, body))
           return;
 
         // Split sentence
-        std::vector<std::string> parts;
-        String::split(line.substr(sidx + 1, eidx - sidx - 1), ",", parts);
+        StringView parts[c_max_fields];
+        unsigned count = Tokenizer(body, ',').split(parts, c_max_fields);
+        if (count > c_max_fields)
+          count = c_max_fields;
 
-        if (std::find(m_args.stn_order.begin(), m_args.stn_order.end(), parts[0]) != m_args.stn_order.end())
-          interpretSentence(parts);
+        for (unsigned i = 0; i < m_args.stn_order.size(); ++i)
+        {
+          if (parts[0] == m_args.stn_order[i])
+          {
+            interpretSentence(parts, count, tstamp);
+            break;
+          }
+        }
       }
 
       //! Interpret given sentence.
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
+      //! @param[in] tstamp arrival time of the sentence.
       void
-      interpretSentence(std::vector<std::string>& parts)
+      interpretSentence(const StringView* parts, unsigned count, double tstamp)
       {
         if (parts[0] == m_args.stn_order.front())
         {
           clearMessages();
-          m_fix.setTimeStamp();
+          m_fix.setTimeStamp(tstamp);
           m_euler.setTimeStamp(m_fix.getTimeStamp());
           m_agvel.setTimeStamp(m_fix.getTimeStamp());
         }
 
         if (parts[0] == "GPZDA")
         {
-          interpretGPZDA(parts);
+          interpretGPZDA(parts, count);
         }
         else if (parts[0] == "GPGGA")
         {
-          interpretGPGGA(parts);
+          interpretGPGGA(parts, count);
         }
         else if (parts[0] == "GPVTG")
         {
-          interpretGPVTG(parts);
+          interpretGPVTG(parts, count);
         }
         else if (parts[0] == "PSAT")
         {
-          if (parts[1] == "HPR")
-            interpretPSATHPR(parts);
+          if (count > 1 && parts[1] == "HPR")
+            interpretPSATHPR(parts, count);
         }
         else if (parts[0] == "PUBX")
         {
-          if (parts[1] == "00")
-            interpretPUBX00(parts);
+          if (count > 1 && parts[1] == "00")
+            interpretPUBX00(parts, count);
         }
         else if (parts[0] == "GPHDM")
         {
-          interpretGPHDM(parts);
+          interpretGPHDM(parts, count);
         }
         else if (parts[0] == "GPHDT")
         {
-          interpretGPHDT(parts);
+          interpretGPHDT(parts, count);
         }
         else if (parts[0] == "GPROT")
         {
-          interpretGPROT(parts);
+          interpretGPROT(parts, count);
         }
 
         if (parts[0] == m_args.stn_order.back())
+          dispatchFix();
+      }
+
+      //! Compute the time of a fix. When pulses are used as time
+      //! reference, the fix is placed at the fraction of second of its
+      //! UTC time after the last pulse.
+      //! @param[in] utc_time UTC time of the fix.
+      //! @param[in] tstamp arrival time of the fix.
+      //! @return time of the fix.
+      double
+      getFixTime(double utc_time, double tstamp)
+      {
+        if (!m_args.pulse_ref || m_pulse < 0
+            || !(m_fix.validity & IMC::GpsFix::GFV_VALID_TIME))
+          return tstamp;
+
+        double time = m_pulse + (utc_time - std::floor(utc_time));
+        if (time > tstamp)
+          time -= 1.0;
+
+        // Stale pulse.
+        if (tstamp - time >= 1.0)
+          return tstamp;
+
+        return time;
+      }
+
+      //! Dispatch the fix and attitude of the current epoch.
+      void
+      dispatchFix(void)
+      {
+        double tstamp = getFixTime(m_fix.utc_time, m_fix.getTimeStamp());
+        m_fix.setTimeStamp(tstamp);
+        m_euler.setTimeStamp(tstamp);
+        m_agvel.setTimeStamp(tstamp);
+
+        m_wdog.reset();
+        dispatch(m_fix, DF_KEEP_TIME);
+
+        if (m_has_euler)
+        {
+          dispatch(m_euler, DF_KEEP_TIME);
+          m_has_euler = false;
+        }
+
+        if (m_has_agvel)
         {
-          m_wdog.reset();
-          dispatch(m_fix);
+          dispatch(m_agvel, DF_KEEP_TIME);
+          m_has_agvel = false;
+        }
+
+        if (m_fix.validity & IMC::GpsFix::GFV_VALID_POS)
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+        else
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_WAIT_GPS_FIX);
+      }
+
+      //! Interpret a UBX navigation solution, which carries a whole
+      //! epoch.
+      //! @param[in] sol navigation solution.
+      //! @param[in] tstamp arrival time of the solution.
+      void
+      interpretSolution(const Parsers::UBX::Solution& sol, double tstamp)
+      {
+        clearMessages();
+        m_fix.setTimeStamp(tstamp);
 
-          if (m_has_euler)
+        if (sol.has_pvt)
+        {
+          if (sol.valid_date)
+          {
+            m_fix.utc_year = sol.year;
+            m_fix.utc_month = sol.month;
+            m_fix.utc_day = sol.day;
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_DATE;
+          }
+
+          if (sol.valid_time)
           {
-            dispatch(m_euler);
-            m_has_euler = false;
+            m_fix.utc_time = sol.utc_time;
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_TIME;
           }
 
-          if (m_has_agvel)
+          m_fix.satellites = sol.satellites;
+          m_fix.hacc = sol.hacc;
+          m_fix.vacc = sol.vacc;
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_HACC | IMC::GpsFix::GFV_VALID_VACC;
+
+          switch (sol.fix_type)
           {
-            dispatch(m_agvel);
-            m_has_agvel = false;
+            case Parsers::UBX::FIX_2D:
+            case Parsers::UBX::FIX_3D:
+            case Parsers::UBX::FIX_GNSS_DEAD_RECKONING:
+              m_fix.type = sol.differential ? IMC::GpsFix::GFT_DIFFERENTIAL : IMC::GpsFix::GFT_STANDALONE;
+              break;
+            case Parsers::UBX::FIX_DEAD_RECKONING:
+              m_fix.type = IMC::GpsFix::GFT_DEAD_RECKONING;
+              break;
+            default:
+              break;
           }
 
-          if (m_fix.validity & IMC::GpsFix::GFV_VALID_POS)
-            setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
-          else
-            setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_WAIT_GPS_FIX);
+          if (sol.fix_ok && sol.fix_type >= Parsers::UBX::FIX_2D
+              && sol.fix_type <= Parsers::UBX::FIX_GNSS_DEAD_RECKONING)
+          {
+            m_fix.lat = sol.lat;
+            m_fix.lon = sol.lon;
+            m_fix.height = sol.height;
+            m_fix.sog = sol.sog;
+            m_fix.cog = sol.cog;
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_POS;
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_SOG | IMC::GpsFix::GFV_VALID_COG;
+          }
         }
+
+        if (sol.has_dop)
+        {
+          m_fix.hdop = sol.hdop;
+          m_fix.vdop = sol.vdop;
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_HDOP | IMC::GpsFix::GFV_VALID_VDOP;
+        }
+
+        dispatchFix();
       }
 
       //! Interpret GPZDA sentence (UTC date and time).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretGPZDA(const std::vector<std::string>& parts)
+      interpretGPZDA(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_gpzda_fields)
+        if (count < c_gpzda_fields)
         {
           war(DTR("invalid GPZDA sentence"));
           return;
@@ -531,11 +697,12 @@ namespace Sensors
       }
 
       //! Interpret GPGGA sentence (GPS fix data).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretGPGGA(const std::vector<std::string>& parts)
+      interpretGPGGA(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_gpgga_fields)
+        if (count < c_gpgga_fields)
         {
           war(DTR("invalid GPGGA sentence"));
           return;
@@ -579,11 +746,12 @@ namespace Sensors
       }
 
       //! Interpret PUBX00 sentence (navstar position).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretPUBX00(const std::vector<std::string>& parts)
+      interpretPUBX00(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_pubx00_fields)
+        if (count < c_pubx00_fields)
         {
           war(DTR("invalid PUBX,00 sentence"));
           return;
@@ -630,11 +798,12 @@ namespace Sensors
       }
 
       //! Interpret GPVTG sentence (course over ground).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretGPVTG(const std::vector<std::string>& parts)
+      interpretGPVTG(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_gpvtg_fields)
+        if (count < c_gpvtg_fields)
         {
           war(DTR("invalid GPVTG sentence"));
           return;
@@ -654,11 +823,12 @@ namespace Sensors
       }
 
       //! Interpret GPVTG sentence (true heading).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretGPHDT(const std::vector<std::string>& parts)
+      interpretGPHDT(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_gphdt_fields)
+        if (count < c_gphdt_fields)
         {
           war(DTR("invalid GPHDT sentence"));
           return;
@@ -670,11 +840,12 @@ namespace Sensors
 
       //! Interpret GPHDM sentence (Magnetic heading of
       //! the vessel derived from the true heading calculated).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretGPHDM(const std::vector<std::string>& parts)
+      interpretGPHDM(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_gphdm_fields)
+        if (count < c_gphdm_fields)
         {
           war(DTR("invalid GPHDM sentence"));
           return;
@@ -688,11 +859,12 @@ namespace Sensors
       }
 
       //! Interpret GPROT sentence (rate of turn).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretGPROT(const std::vector<std::string>& parts)
+      interpretGPROT(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_gprot_fields)
+        if (count < c_gprot_fields)
         {
           war(DTR("invalid GPROT sentence"));
           return;
@@ -707,11 +879,12 @@ namespace Sensors
 
       //! Interpret PSATHPR sentence (Proprietary NMEA message that
       //! provides the heading, pitch, roll, and time in a single message).
-      //! @param[in] parts vector of strings from sentence.
+      //! @param[in] parts fields of the sentence.
+      //! @param[in] count number of fields.
       void
-      interpretPSATHPR(const std::vector<std::string>& parts)
+      interpretPSATHPR(const StringView* parts, unsigned count)
       {
-        if (parts.size() < c_psathpr_fields)
+        if (count < c_psathpr_fields)
         {
           war(DTR("invalid PSATHPR sentence"));
           return;
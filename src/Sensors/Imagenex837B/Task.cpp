@@ -198,6 +198,8 @@ namespace Sensors
       uint8_t m_rdata_ftr[c_rdata_ftr_size];
       //! Single sidescan ping.
       IMC::SonarData m_ping;
+      //! Recycled sidescan pings.
+      IMC::SharedMessagePool<IMC::SonarData> m_ping_pool;
       //! Estimated state.
       IMC::EstimatedState m_estate;
       //! Log file.
@@ -760,7 +762,7 @@ namespace Sensors
               if (m_args.save_to_file)
                 handleSonarData();
               else
-                dispatch(m_ping);
+                dispatch(m_ping_pool.take(m_ping, &IMC::SonarData::data));
 
               if (m_args.range_modifier)
               {
@@ -136,6 +136,8 @@ namespace Sensors
       IMC::Distance m_dist;
       //! Profile message.
       IMC::SonarData m_profile;
+      //! Recycled profile messages.
+      IMC::SharedMessagePool<IMC::SonarData> m_profile_pool;
       //! Task arguments.
       Arguments m_args;
       //! Watchdog.
@@ -472,7 +474,7 @@ namespace Sensors
               m_profile.setTimeStamp(m_dist.getTimeStamp());
               m_profile.min_range = static_cast<uint16_t>(m_switch.getProfileMinRange());
               m_profile.max_range = m_parser.getRange();
-              dispatch(m_profile);
+              dispatch(m_profile_pool.take(m_profile, &IMC::SonarData::data));
             }
 
             if (m_hand.isKnown())
@@ -170,6 +170,8 @@ namespace Sensors
       IMC::Distance m_distance;
       //! Profile message.
       IMC::SonarData m_sonar;
+      //! Recycled profile messages.
+      IMC::SharedMessagePool<IMC::SonarData> m_sonar_pool;
       //! Device State message.
       IMC::DeviceState m_device_state;
       // Output switch data.
@@ -677,7 +679,7 @@ namespace Sensors
                 m_sonar.setTimeStamp(m_distance.getTimeStamp());
                 m_sonar.min_range = static_cast<uint16_t>(m_distance.value);
                 m_sonar.max_range = m_parser.getRange();
-                dispatch(m_sonar);
+                dispatch(m_sonar_pool.take(m_sonar, &IMC::SonarData::data));
               }
 
               // Extract and dispatch data.
@@ -74,6 +74,8 @@ namespace Sensors
       std::string pwr_name;
       //! Hard-iron correction factors.
       std::vector<double> hard_iron;
+      //! Number of samples per dispatched block.
+      unsigned decimation;
     };
 
     struct Task: public Tasks::Task
@@ -110,11 +112,14 @@ namespace Sensors
       Counter<double> m_wdog;
       //! Error counts.
       ErrorCounts m_err_counts;
+      //! Inertial output.
+      InertialOutput m_imu;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
         m_uart(NULL),
-        m_ctl(NULL)
+        m_ctl(NULL),
+        m_imu(this, ctx.state.imu)
       {
         // Define configuration parameters.
         param("Serial Port - Device", m_args.uart_dev)
@@ -141,12 +146,21 @@ namespace Sensors
         .defaultValue("false")
         .description("Set to true to enable raw data output");
 
+        param("Publish Decimation", m_args.decimation)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of samples averaged in each dispatched angular"
+                     " velocity and acceleration. Navigation still receives"
+                     " every sample");
+
         bind<IMC::MagneticField>(this);
       }
 
       void
       onUpdateParameters(void)
       {
+        m_imu.setDecimation(m_args.decimation);
+
         if (m_ctl == NULL)
           return;
 
@@ -299,7 +313,7 @@ namespace Sensors
       void
       decodeOutputData(const UCTK::Frame& frame)
       {
-        double imc_tstamp = Clock::getSinceEpoch();
+        double imc_tstamp = m_uart->getReadTimeStamp();
         float tmp = 0;
         uint16_t tmp_u16 = 0;
         const uint8_t* ptr = frame.getPayload();
@@ -317,7 +331,6 @@ namespace Sensors
         m_ang_vel.z = Angles::radians(tmp);
         m_ang_vel.time = dev_tstamp;
         m_ang_vel.setTimeStamp(imc_tstamp);
-        dispatch(m_ang_vel, DF_KEEP_TIME);
 
         // Acceleration.
         ptr += ByteCopy::fromLE(tmp, ptr);
@@ -328,7 +341,7 @@ namespace Sensors
         m_accel.z = tmp;
         m_accel.time = dev_tstamp;
         m_accel.setTimeStamp(imc_tstamp);
-        dispatch(m_accel, DF_KEEP_TIME);
+        m_imu.push(m_ang_vel, m_accel);
 
         // Delta Angles.
         ptr += ByteCopy::fromLE(tmp, ptr);
@@ -58,6 +58,9 @@ namespace Sensors
     static const unsigned c_code_sys_restart = 0x01a6;
     //! Restart system ack code.
     static const unsigned c_code_sys_restart_ack = 0x01a7;
+    //! Maximum age of the position estimate used to predict
+    //! travel times (s).
+    static const double c_estate_max_age = 5.0;
 
     enum EntityStates
     {
@@ -136,6 +139,19 @@ namespace Sensors
       std::string sound_speed_elabel;
       // Turn around time (ms).
       unsigned turn_around_time;
+      // Margin added to predicted travel times (ms).
+      unsigned ping_margin;
+    };
+
+    //! Beacons interrogated by a single ping. The modem interrogates
+    //! up to Navigation::c_max_transponders beacons sharing a query
+    //! frequency at once.
+    struct PingGroup
+    {
+      //! Query frequency.
+      unsigned query_freq;
+      //! Indices of beacons in the group.
+      std::vector<unsigned> beacons;
     };
 
     struct Beacon
@@ -189,6 +205,12 @@ namespace Sensors
       static const int c_bfr_size = 256;
       // Beacons.
       std::vector<Beacon> m_beacons;
+      //! Ping schedule.
+      std::vector<PingGroup> m_groups;
+      //! Group being pinged.
+      unsigned m_group;
+      //! Time of last position estimate.
+      double m_estate_time;
       // Serial port handle.
       SerialPort* m_uart;
       // Range.
@@ -219,6 +241,8 @@ namespace Sensors
       double m_sound_speed;
       //! Sound speed entity id.
       int m_sound_speed_eid;
+      //! Sound speed profile.
+      SoundSpeedProfile m_ssp;
       // Estimated state.
       IMC::EstimatedState m_estate;
       //! Report timer.
@@ -234,6 +258,8 @@ namespace Sensors
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
+        m_group(0),
+        m_estate_time(-1),
         m_uart(NULL),
         m_last_range(0),
         m_result(RS_NONE),
@@ -279,7 +305,15 @@ namespace Sensors
         param("Ping Periodicity", m_args.ping_period)
         .units(Units::Second)
         .defaultValue("2")
-        .minimumValue("2");
+        .minimumValue("2")
+        .description("Maximum amount of time to wait for the replies to a ping");
+
+        param("Ping Timeout Margin", m_args.ping_margin)
+        .units(Units::Millisecond)
+        .defaultValue("200")
+        .description("Margin added to the travel times predicted from the"
+                     " position estimate. The ping timeout is never larger"
+                     " than 'Ping Timeout'");
 
         param(DTR_RT("Enable Reports"), m_args.report)
         .visibility(Tasks::Parameter::VISIBILITY_USER)
@@ -376,6 +410,7 @@ namespace Sensors
       onUpdateParameters(void)
       {
         m_sound_speed = m_args.sound_speed_def;
+        m_ssp.setDefault(m_args.sound_speed_def);
         m_report_timer.setTop(m_args.report_period);
       }
 
@@ -674,8 +709,14 @@ namespace Sensors
       {
         m_range.setTimeStamp();
 
-        for (unsigned i = 0; i < Navigation::c_max_transponders; ++i)
+        // Travel times are reported in the order of the pinged group.
+        const std::vector<unsigned> none;
+        const std::vector<unsigned>& group = (m_group < m_groups.size()) ? m_groups[m_group].beacons : none;
+
+        for (unsigned j = 0; j < group.size(); ++j)
         {
+          unsigned i = group[j];
+
           try
           {
             double travel = 0;
@@ -686,7 +727,7 @@ namespace Sensors
             dispatch(m_detect);
 
             // Compute range and dispatch message.
-            double range = travel * m_sound_speed;
+            double range = travel * getSoundSpeed(m_beacons[i]);
             if (range > 0.0)
             {
               m_last_range = m_range.getTimeStamp();
@@ -710,13 +751,19 @@ namespace Sensors
         addResult(RS_PNG_TIME);
       }
 
+      //! Process input from the modem.
+      //! @param[in] timeout amount of time to process input.
+      //! @param[in] until stop as soon as these results are available.
       void
-      processInput(double timeout = c_cmd_reply_tout)
+      processInput(double timeout = c_cmd_reply_tout, unsigned until = RS_NONE)
       {
         double deadline = Clock::get() + timeout;
 
         while (Clock::get() <= deadline)
         {
+          if (until != RS_NONE && (m_result & until) == until)
+            break;
+
           consumeMessages();
 
           if (!Poll::poll(*m_uart, 0.01))
@@ -756,26 +803,87 @@ namespace Sensors
         }
       }
 
+      //! Split beacons in groups that can be interrogated by a single
+      //! ping.
       void
-      ping(void)
+      buildSchedule(void)
       {
-        std::vector<unsigned> freqs;
-        for (unsigned i = 0; i < Navigation::c_max_transponders; ++i)
+        m_groups.clear();
+        m_group = 0;
+
+        for (unsigned i = 0; i < m_beacons.size(); ++i)
         {
-          if (i < m_beacons.size())
-            freqs.push_back(m_beacons[i].tx_frequency);
-          else
-            freqs.push_back(0);
+          unsigned g = 0;
+          for (; g < m_groups.size(); ++g)
+          {
+            if (m_groups[g].query_freq == m_beacons[i].rx_frequency
+                && m_groups[g].beacons.size() < Navigation::c_max_transponders)
+              break;
+          }
+
+          if (g == m_groups.size())
+          {
+            m_groups.push_back(PingGroup());
+            m_groups.back().query_freq = m_beacons[i].rx_frequency;
+          }
+
+          m_groups[g].beacons.push_back(i);
         }
 
+        debug("%u beacons in %u ping groups", (unsigned)m_beacons.size(), (unsigned)m_groups.size());
+      }
+
+      //! Compute the ping timeout of a group from the travel times
+      //! predicted by the position estimate.
+      //! @param[in] group ping group.
+      //! @return timeout in milliseconds.
+      unsigned
+      getPingTimeout(const PingGroup& group)
+      {
+        if (m_estate_time < 0 || Clock::get() - m_estate_time > c_estate_max_age)
+          return m_args.ping_tout;
+
+        double lat = 0;
+        double lon = 0;
+        Coordinates::toWGS84(m_estate, lat, lon);
+
+        double travel = 0;
+        for (unsigned i = 0; i < group.beacons.size(); ++i)
+        {
+          const Beacon& beacon = m_beacons[group.beacons[i]];
+          double range = WGS84::distance(lat, lon, -m_estate.depth,
+                                         beacon.lat, beacon.lon, -beacon.depth);
+          travel = std::max(travel, 2.0 * range / m_sound_speed + beacon.delay / 1000.0);
+        }
+
+        unsigned tout = (unsigned)(travel * 1000.0) + m_args.ping_margin;
+        return std::min(tout, m_args.ping_tout);
+      }
+
+      //! Ping the next group of beacons. Replies are awaited only until
+      //! the modem reports travel times, so the next group is pinged
+      //! as soon as the acoustic channel is free.
+      void
+      ping(void)
+      {
+        if (m_groups.empty())
+          return;
+
+        m_group = (m_group + 1) % m_groups.size();
+        const PingGroup& group = m_groups[m_group];
+
+        unsigned freqs[Navigation::c_max_transponders] = {0};
+        for (unsigned i = 0; i < group.beacons.size(); ++i)
+          freqs[i] = m_beacons[group.beacons[i]].tx_frequency;
+
         std::string cmd = String::str("$CCPNT,%u,%u,%u,%u,%u,%u,%u,%u,1\r\n",
-                                      m_beacons[0].rx_frequency, m_args.tx_length,
-                                      m_args.rx_length, m_args.ping_tout,
+                                      group.query_freq, m_args.tx_length,
+                                      m_args.rx_length, getPingTimeout(group),
                                       freqs[0], freqs[1], freqs[2], freqs[3]);
 
         m_uart->writeString(cmd.c_str());
 
-        processInput(m_args.ping_period);
+        processInput(m_args.ping_period, RS_PNG_ACKD | RS_PNG_TIME);
         if (consumeResult(RS_PNG_ACKD) && consumeResult(RS_PNG_TIME))
         {
           m_state = STA_ACTIVE;
@@ -871,6 +979,8 @@ namespace Sensors
               m_beacons.push_back(beacon);
             }
 
+            buildSchedule();
+
             if (m_state != STA_ERR_COM && m_state != STA_ERR_SRC && m_state != STA_ERR_STP)
               m_state = isActive() ? STA_ACTIVE : STA_IDLE;
         }
@@ -916,12 +1026,28 @@ namespace Sensors
           return;
 
         m_sound_speed = msg->value;
+
+        if (m_estate_time >= 0 && Clock::get() - m_estate_time <= c_estate_max_age)
+          m_ssp.add(m_estate.depth, msg->value);
+      }
+
+      //! Get mean sound speed along the path to a beacon.
+      //! @param[in] beacon beacon.
+      //! @return sound speed (m/s).
+      double
+      getSoundSpeed(const Beacon& beacon) const
+      {
+        if (m_ssp.isEmpty() || m_estate_time < 0)
+          return m_sound_speed;
+
+        return m_ssp.getMeanSpeed(m_estate.depth, beacon.depth);
       }
 
       void
       consume(const IMC::EstimatedState* msg)
       {
         m_estate = *msg;
+        m_estate_time = Clock::get();
       }
 
       void
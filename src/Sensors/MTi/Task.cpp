@@ -62,6 +62,10 @@ namespace Sensors
       std::string uart_dev;
       // Serial port baud rate.
       unsigned uart_baud;
+      // Number of samples per dispatched block.
+      unsigned decimation;
+      // Dispatch compensated increments.
+      bool increments;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -96,13 +100,16 @@ namespace Sensors
       IMC::AngularVelocity m_agvel;
       // Temperature message.
       IMC::Temperature m_temp;
+      // Inertial output.
+      InertialOutput m_imu;
       // Task parameters.
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
         m_state(PS_NONE),
-        m_uart(NULL)
+        m_uart(NULL),
+        m_imu(this, ctx.state.imu)
       {
         param("Serial Port - Device", m_args.uart_dev)
         .defaultValue("")
@@ -112,6 +119,18 @@ namespace Sensors
         .defaultValue("115200")
         .description("Serial port baud rate");
 
+        param("Publish Decimation", m_args.decimation)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of samples averaged in each dispatched angular"
+                     " velocity and acceleration. Navigation still receives"
+                     " every sample");
+
+        param("Compensated Increments", m_args.increments)
+        .defaultValue("false")
+        .description("Dispatch angle and velocity increments with coning"
+                     " and sculling compensation for each block of samples");
+
         m_bfr = new uint8_t[c_max_bfr_len];
 
         bind<IMC::Pulse>(this);
@@ -122,6 +141,13 @@ namespace Sensors
         delete [] m_bfr;
       }
 
+      void
+      onUpdateParameters(void)
+      {
+        m_imu.setDecimation(m_args.decimation);
+        m_imu.setIncrements(m_args.increments, true);
+      }
+
       void
       onResourceAcquisition(void)
       {
@@ -190,8 +216,7 @@ namespace Sensors
               m_euler.psi_magnetic = m_euler.psi;
 
               dispatch(m_euler, DF_KEEP_TIME);
-              dispatch(m_accel, DF_KEEP_TIME);
-              dispatch(m_agvel, DF_KEEP_TIME);
+              m_imu.push(m_agvel, m_accel);
               dispatch(m_temp, DF_KEEP_TIME);
 
               uint64_t time_diff = Clock::getMsec() - time_start;
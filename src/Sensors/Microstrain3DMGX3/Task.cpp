@@ -98,6 +98,10 @@ namespace Sensors
       std::vector<float> hard_iron;
       // Rotation matrix values.
       std::vector<double> rotation_mx;
+      //! Number of samples per dispatched block.
+      unsigned decimation;
+      //! Dispatch compensated increments.
+      bool increments;
     };
 
     //! %Microstrain3DMGX3 software driver.
@@ -133,13 +137,16 @@ namespace Sensors
       double m_tstamp;
       //! Watchdog.
       Counter<double> m_wdog;
+      //! Inertial output.
+      InertialOutput m_imu;
       //! Task arguments.
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Periodic(name, ctx),
         m_uart(NULL),
-        m_tstamp(0)
+        m_tstamp(0),
+        m_imu(this, ctx.state.imu)
       {
         param("Serial Port - Device", m_args.uart_dev)
         .defaultValue("")
@@ -171,6 +178,18 @@ namespace Sensors
         .size(9)
         .description("IMU rotation matrix which is dependent of the mounting position");
 
+        param("Publish Decimation", m_args.decimation)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of samples averaged in each dispatched angular"
+                     " velocity and acceleration. Navigation still receives"
+                     " every sample");
+
+        param("Compensated Increments", m_args.increments)
+        .defaultValue("false")
+        .description("Dispatch angle and velocity increments with coning"
+                     " and sculling compensation for each block of samples");
+
         m_timer.setTop(c_reset_tout);
 
         // Magnetic calibration addresses.
@@ -184,6 +203,9 @@ namespace Sensors
       void
       onUpdateParameters(void)
       {
+        m_imu.setDecimation(m_args.decimation);
+        m_imu.setIncrements(m_args.increments, true);
+
         m_rotation.fill(3, 3, &m_args.rotation_mx[0]);
 
         // Rotate calibration parameters.
@@ -324,7 +346,7 @@ namespace Sensors
 
         // Read response.
         size_t rv = m_uart->read(m_bfr, c_bfr_size);
-        m_tstamp = Clock::getSinceEpoch();
+        m_tstamp = m_uart->getReadTimeStamp();
 
         if (rv == 0)
           return false;
@@ -617,8 +639,7 @@ namespace Sensors
 
           // Dispatch messages.
           dispatch(m_euler, DF_KEEP_TIME);
-          dispatch(m_accel, DF_KEEP_TIME);
-          dispatch(m_agvel, DF_KEEP_TIME);
+          m_imu.push(m_agvel, m_accel);
           dispatch(m_magfield, DF_KEEP_TIME);
 
           // Clear entity state.
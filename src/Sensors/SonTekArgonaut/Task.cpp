@@ -243,7 +243,7 @@ namespace Sensors
         int wvval = 0;
         int gvval = 0;
 
-        double tstamp = Clock::getSinceEpoch();
+        double tstamp = m_uart->getReadTimeStamp();
 
         int rv = std::sscanf(m_buffer,
                         "%*d %*d %*d %*d %*d %*d" // Date
@@ -26,6 +26,8 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <cstring>
+#include <fstream>
 #include <string>
 
 // DUNE headers.
@@ -66,6 +68,79 @@ namespace Sensors
       std::vector<float> position;
       //! DVL orientation.
       std::vector<float> orientation;
+      //! Number of ensembles averaged per dispatched sample.
+      unsigned decimation;
+      //! Save raw ensembles.
+      bool save_raw;
+    };
+
+    //! Read buffer size.
+    static const unsigned c_bfr_size = 1024;
+    //! Name of the raw ensemble log.
+    static const char* c_raw_log_name = "Data.pd4";
+
+    //! Average of consecutive ensembles. Each component and beam is
+    //! averaged over the ensembles where it is valid.
+    struct Aggregate
+    {
+      //! Number of ensembles.
+      unsigned count;
+      //! Bottom velocity sums.
+      double vel_btm[3];
+      //! Number of valid bottom velocity samples per component.
+      unsigned vel_btm_count[3];
+      //! Water velocity sums.
+      double vel_wtr[3];
+      //! Number of valid water velocity samples per component.
+      unsigned vel_wtr_count[3];
+      //! Beam range sums.
+      double rng_btm[PD4::c_beams];
+      //! Number of valid ranges per beam.
+      unsigned rng_btm_count[PD4::c_beams];
+
+      Aggregate(void)
+      {
+        clear();
+      }
+
+      void
+      clear(void)
+      {
+        std::memset(this, 0, sizeof(*this));
+      }
+
+      void
+      add(const PD4::Data* data)
+      {
+        const double vel_btm_in[3] = {data->x_vel_btm, data->y_vel_btm, data->z_vel_btm};
+        const double vel_wtr_in[3] = {data->x_vel_wtr, data->y_vel_wtr, data->z_vel_wtr};
+
+        for (unsigned i = 0; i < 3; ++i)
+        {
+          if (data->vel_btm_validity & (1 << i))
+          {
+            vel_btm[i] += vel_btm_in[i];
+            ++vel_btm_count[i];
+          }
+
+          if (data->vel_wtr_validity & (1 << i))
+          {
+            vel_wtr[i] += vel_wtr_in[i];
+            ++vel_wtr_count[i];
+          }
+        }
+
+        for (unsigned i = 0; i < PD4::c_beams; ++i)
+        {
+          if (data->rng_btm_validity & (1 << i))
+          {
+            rng_btm[i] += data->rng_btm[i];
+            ++rng_btm_count[i];
+          }
+        }
+
+        ++count;
+      }
     };
 
     //! Device beam width
@@ -81,9 +156,13 @@ namespace Sensors
       // Water velocity message.
       IMC::WaterVelocity m_wvel;
       // Bottom ranges.
-      IMC::Distance m_brange[4];
+      IMC::Distance m_brange[PD4::c_beams];
       // Sample count.
       unsigned m_samples;
+      //! Ensembles waiting to be dispatched.
+      Aggregate m_aggr;
+      //! Raw ensemble log.
+      std::ofstream m_raw_log;
       // Task arguments.
       Arguments m_args;
 
@@ -118,6 +197,15 @@ namespace Sensors
         .size(3)
         .description("Device orientation");
 
+        param("Decimation", m_args.decimation)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of ensembles averaged in each dispatched sample");
+
+        param("Save Raw Data", m_args.save_raw)
+        .defaultValue("false")
+        .description("Write every ensemble to a binary log, regardless of decimation");
+
         IMC::BeamConfig bc;
         bc.beam_width = Math::Angles::radians(c_beam_width);
         bc.beam_height = Math::Angles::radians(c_beam_width);
@@ -130,13 +218,15 @@ namespace Sensors
         ds.theta = Math::Angles::radians(m_args.orientation[1]);
         ds.psi = Math::Angles::radians(m_args.orientation[2]);
 
-        for (unsigned i = 0; i < 5; i++)
+        for (unsigned i = 0; i < PD4::c_beams; i++)
         {
           m_brange[i].location.clear();
           m_brange[i].location.push_back(ds);
           m_brange[i].beam_config.clear();
           m_brange[i].beam_config.push_back(bc);
         }
+
+        bind<IMC::LoggingControl>(this);
       }
 
       void
@@ -144,11 +234,46 @@ namespace Sensors
       {
         if (paramChanged(m_args.rotation))
           m_args.rotation = Angles::radians(m_args.rotation);
+
+        if (paramChanged(m_args.decimation))
+          m_aggr.clear();
+      }
+
+      void
+      consume(const IMC::LoggingControl* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        switch (msg->op)
+        {
+          case IMC::LoggingControl::COP_STARTED:
+            closeRawLog();
+            if (m_args.save_raw)
+            {
+              Path path = m_ctx.dir_log / msg->name / c_raw_log_name;
+              m_raw_log.open(path.c_str(), std::ios::binary);
+            }
+            break;
+
+          case IMC::LoggingControl::COP_STOPPED:
+            closeRawLog();
+            break;
+        }
+      }
+
+      void
+      closeRawLog(void)
+      {
+        if (m_raw_log.is_open())
+          m_raw_log.close();
       }
 
       void
       onResourceRelease(void)
       {
+        closeRawLog();
+
         if (m_uart != NULL)
         {
           onResourceDeactivation();
@@ -291,11 +416,66 @@ namespace Sensors
         m_uart->setCanonicalInput(false);
       }
 
+      //! Dispatch the average of the aggregated ensembles.
+      void
+      dispatchAggregate(void)
+      {
+        double vel[3];
+        uint8_t validity = 0;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+          vel[i] = 0;
+          if (m_aggr.vel_btm_count[i] > 0)
+          {
+            vel[i] = m_aggr.vel_btm[i] / m_aggr.vel_btm_count[i];
+            validity |= (1 << i);
+          }
+        }
+
+        m_gvel.validity = validity;
+        m_gvel.x = vel[0] * std::cos(m_args.rotation) + vel[1] * std::sin(m_args.rotation);
+        m_gvel.y = vel[0] * std::sin(m_args.rotation) - vel[1] * std::cos(m_args.rotation);
+        m_gvel.z = -vel[2];
+        dispatch(m_gvel);
+
+        validity = 0;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+          vel[i] = 0;
+          if (m_aggr.vel_wtr_count[i] > 0)
+          {
+            vel[i] = m_aggr.vel_wtr[i] / m_aggr.vel_wtr_count[i];
+            validity |= (1 << i);
+          }
+        }
+
+        m_wvel.validity = validity;
+        m_wvel.x = vel[0] * std::cos(m_args.rotation) + vel[1] * std::sin(m_args.rotation);
+        m_wvel.y = vel[0] * std::sin(m_args.rotation) - vel[1] * std::cos(m_args.rotation);
+        m_wvel.z = -vel[2];
+        dispatch(m_wvel);
+
+        for (unsigned i = 0; i < PD4::c_beams; ++i)
+        {
+          m_brange[i].validity = IMC::Distance::DV_INVALID;
+          m_brange[i].value = 0;
+          if (m_aggr.rng_btm_count[i] > 0)
+          {
+            m_brange[i].validity = IMC::Distance::DV_VALID;
+            m_brange[i].value = m_aggr.rng_btm[i] / m_aggr.rng_btm_count[i];
+          }
+
+          dispatch(m_brange[i]);
+        }
+
+        m_aggr.clear();
+      }
+
       void
       onMain(void)
       {
         Parsers::PD4 parser;
-        uint8_t bfr[128];
+        uint8_t bfr[c_bfr_size];
 
         while (!stopping())
         {
@@ -313,33 +493,27 @@ namespace Sensors
           if (!Poll::poll(*m_uart, 1.0))
             continue;
 
+          // All ensembles read at once are processed before messages
+          // are consumed again.
           size_t rv = m_uart->read(bfr, sizeof(bfr));
-          for (size_t i = 0; i < rv; ++i)
+          size_t offset = 0;
+          while (offset < rv)
           {
-            if (parser.parse(bfr[i]))
+            size_t consumed = 0;
+            bool ready = parser.parse(bfr + offset, rv - offset, consumed);
+            offset += consumed;
+            if (!ready)
+              continue;
+
+            if (m_raw_log.is_open())
+              m_raw_log.write((const char*)parser.getEnsemble(), parser.getEnsembleSize());
+
+            m_aggr.add(parser.data());
+            ++m_samples;
+
+            if (m_aggr.count >= m_args.decimation)
             {
-              const PD4::Data* data = parser.data();
-              m_gvel.validity = data->vel_btm_validity;
-              m_gvel.x = data->x_vel_btm * std::cos(m_args.rotation) + data->y_vel_btm * std::sin(m_args.rotation);
-              m_gvel.y = data->x_vel_btm * std::sin(m_args.rotation) - data->y_vel_btm * std::cos(m_args.rotation);
-              m_gvel.z = -data->z_vel_btm;
-              dispatch(m_gvel);
-
-              m_wvel.validity = data->vel_wtr_validity;
-              m_wvel.x = data->x_vel_wtr * std::cos(m_args.rotation) + data->y_vel_wtr * std::sin(m_args.rotation);
-              m_wvel.y = data->x_vel_wtr * std::sin(m_args.rotation) - data->y_vel_wtr * std::cos(m_args.rotation);
-              m_wvel.z = -data->z_vel_wtr;
-              dispatch(m_wvel);
-
-              m_brange[0].value = data->bm1_rng_btm;
-              m_brange[1].value = data->bm2_rng_btm;
-              m_brange[2].value = data->bm3_rng_btm;
-              m_brange[3].value = data->bm4_rng_btm;
-              dispatch(m_brange[0]);
-              dispatch(m_brange[1]);
-              dispatch(m_brange[2]);
-              dispatch(m_brange[3]);
-              ++m_samples;
+              dispatchAggregate();
               setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
             }
           }
@@ -87,7 +87,7 @@ namespace Simulators
       void
       onResourceAcquisition(void)
       {
-        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed);
+        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed, getEntityId());
       }
 
       //! Release resources.
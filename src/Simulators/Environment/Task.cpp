@@ -31,6 +31,7 @@
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
+#include <DUNE/Simulation/GriddedField.hpp>
 
 // Local headers.
 #include "QuadTree.hpp"
@@ -59,6 +60,8 @@ namespace Simulators
       // Bottom distance arguments
       //! Location.
       std::string location;
+      //! Gridded bathymetry file.
+      std::string grid;
       //! Fixed value for the tide level
       float tide;
       //! Standard deviation of bottom distance estimates.
@@ -113,6 +116,8 @@ namespace Simulators
       Random::Generator* m_prng;
       //! The tree.
       QuadTree* m_qtree;
+      //! Gridded bathymetry, replacing the tree when configured.
+      DUNE::Simulation::GriddedField* m_grid;
       //! Reference latitude and longitude for data points.
       double m_ref_lat, m_ref_lon;
       //! NE offsets in regard to navigational reference.
@@ -123,7 +128,8 @@ namespace Simulators
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Periodic(name, ctx),
         m_prng(NULL),
-        m_qtree(NULL)
+        m_qtree(NULL),
+        m_grid(NULL)
       {
         // Define configuration parameters.
         param("Entity Label - Bottom Distance", m_args.label_bd)
@@ -135,6 +141,12 @@ namespace Simulators
         param("Location", m_args.location)
         .defaultValue("APDL");
 
+        param("Bathymetry Grid", m_args.grid)
+        .defaultValue("")
+        .description("Gridded bathymetry file, relative to the simulation"
+                     " configuration folder. When set, it is used instead"
+                     " of the bathymetry of 'Location'");
+
         param("Tide Level", m_args.tide)
         .defaultValue("0.0")
         .units(Units::Meter)
@@ -225,7 +237,7 @@ namespace Simulators
       void
       onResourceAcquisition(void)
       {
-        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed);
+        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed, getEntityId());
       }
 
       void
@@ -233,6 +245,7 @@ namespace Simulators
       {
         Memory::clear(m_prng);
         Memory::clear(m_qtree);
+        Memory::clear(m_grid);
       }
 
       void
@@ -262,6 +275,33 @@ namespace Simulators
 
       void
       onResourceInitialization(void)
+      {
+        if (m_args.grid.empty())
+          loadBathymetry();
+        else
+          loadGrid();
+
+        initializeBeams();
+      }
+
+      //! Load gridded bathymetry.
+      void
+      loadGrid(void)
+      {
+        Path path = m_ctx.dir_cfg / "simulation" / m_args.grid;
+        m_grid = new DUNE::Simulation::GriddedField(path.c_str());
+
+        const DUNE::Simulation::GriddedField::Layout& l = m_grid->getLayout();
+        m_ref_lat = l.lat;
+        m_ref_lon = l.lon;
+
+        debug("%s | %u x %u cells of %0.1f x %0.1f m", path.c_str(),
+              l.nx, l.ny, l.dx, l.dy);
+      }
+
+      //! Load scattered bathymetry of the configured location.
+      void
+      loadBathymetry(void)
       {
         Utils::String::toLowerCase(m_args.location);
         Path path = m_ctx.dir_cfg / "simulation" / ("bathymetry-" + m_args.location + ".ini");
@@ -308,7 +348,12 @@ namespace Simulators
         ss.clear();
         ss << *m_qtree;
         trace("tree elements: %s", ss.str().c_str());
+      }
 
+      //! Initialize beam configuration of distance messages.
+      void
+      initializeBeams(void)
+      {
         m_bd.beam_config.clear();
         m_bd.location.clear();
 
@@ -422,6 +467,18 @@ namespace Simulators
       double
       depthAt(double x, double y)
       {
+        if (m_grid)
+        {
+          double depth;
+          if (!m_grid->sample(x, y, 0, depth))
+          {
+            trace("out of bounds");
+            return m_args.oob_depth;
+          }
+
+          return depth + m_args.tide;
+        }
+
         Point p(x, y);
         Bounds search_area(p, m_args.interp_radius);
 
@@ -534,6 +591,36 @@ namespace Simulators
         return range;
       }
 
+      //! Compute depths of c_forward_points evenly spaced ahead of the
+      //! vehicle, in a single query when bathymetry is gridded.
+      //! @param[in] step distance between points.
+      //! @param[out] depths depth at each point.
+      void
+      depthsAhead(double step, double* depths)
+      {
+        double x[c_forward_points];
+        double y[c_forward_points];
+
+        for (unsigned i = 0; i < c_forward_points; ++i)
+        {
+          x[i] = m_sstate.x + m_off_n + (double)i * step * cos(m_sstate.psi);
+          y[i] = m_sstate.y + m_off_e + (double)i * step * sin(m_sstate.psi);
+        }
+
+        if (!m_grid)
+        {
+          for (unsigned i = 0; i < c_forward_points; ++i)
+            depths[i] = depthAt(x[i], y[i]);
+          return;
+        }
+
+        bool valid[c_forward_points];
+        m_grid->sample(x, y, NULL, c_forward_points, depths, valid);
+
+        for (unsigned i = 0; i < c_forward_points; ++i)
+          depths[i] = valid[i] ? depths[i] + m_args.tide : m_args.oob_depth;
+      }
+
       //! Compute the depths of c_forward_points in front of the vehicle
       //! Use connections between these points as line segments
       //! and intersect them with lower beam part of the echo sounder.
@@ -545,9 +632,8 @@ namespace Simulators
 
         double x_step = m_args.max_range / (double)c_forward_points;
 
-        std::vector<float> fwd_depths(c_forward_points);
-
-        fwd_depths[0] = depthAt(m_sstate.x + m_off_n, m_sstate.y + m_off_e);
+        double fwd_depths[c_forward_points];
+        depthsAhead(x_step, fwd_depths);
 
         // x and z coordinates of the end of the forward beam
         double x_target, z_target;
@@ -558,11 +644,6 @@ namespace Simulators
 
         for (unsigned i = 1; i < c_forward_points; i++)
         {
-          double xe = (double)i * x_step * cos(m_sstate.psi);
-          double ye = (double)i * x_step * sin(m_sstate.psi);
-
-          fwd_depths[i] = depthAt(m_sstate.x + m_off_n + xe, m_sstate.y + m_off_e + ye);
-
           double bottom_x_1 = (double)(i - 1) * x_step;
           double bottom_z_1 = fwd_depths[i - 1];
 
@@ -130,7 +130,7 @@ namespace Simulators
       void
       onResourceAcquisition(void)
       {
-        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed);
+        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed, getEntityId());
         m_heading_offset = m_prng->gaussian() * Angles::radians(m_args.stdev_heading_offset);
       }
 
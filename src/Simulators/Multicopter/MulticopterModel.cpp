@@ -36,27 +36,54 @@ namespace Simulators
 {
   namespace Multicopter
   {
+    //! Cross product.
+    static inline void
+    cross(const double* a, const double* b, double* c)
+    {
+      c[0] = a[1] * b[2] - a[2] * b[1];
+      c[1] = a[2] * b[0] - a[0] * b[2];
+      c[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
     MulticopterModel::MulticopterModel(const MulticopterModelParameters& param):
       m_mass(param.mass),
       m_hover_throttle(param.hover_throttle),
-      m_k(param.k),
-      m_l(param.l),
-      m_b(param.b),
       m_linear_actuator_dynamics(param.linear_actuator_dynamics),
-      m_frame(param.frame),
-      m_configuration(param.configuration),
-      m_cog(param.cog),
-      m_inertia(param.inertia),
-      m_ldrag(param.ldrag),
-      m_qdrag(param.qdrag),
-      m_motors(NULL)
+      m_n_motors(0)
     {
+      for (unsigned i = 0; i < 3; i++)
+      {
+        m_cog[i] = param.cog(i);
+        m_inertia[i] = param.inertia(i, i);
+      }
+
+      for (unsigned i = 0; i < 6; i++)
+      {
+        m_ldrag[i] = param.ldrag(i, i);
+        m_qdrag[i] = param.qdrag(i, i);
+      }
+
       // This does not change.
-      m_matrix_mass = computeM();
+      Matrix mass_inv = inverse(computeM());
+      for (unsigned i = 0; i < 6; i++)
+      {
+        for (unsigned j = 0; j < 6; j++)
+          m_mass_inv[i][j] = mass_inv(i, j);
+      }
 
       // Generate motors
       generateMotors(param.frame, param.configuration);
 
+      // Lever arms.
+      // DID: Reversed yaw rate, switched sin and cos.
+      for (unsigned int i = 0; i < m_n_motors; i++)
+      {
+        double angle = Angles::radians(m_motors[i].angle);
+        m_moment[i][0] = param.k * param.l * -std::sin(angle);
+        m_moment[i][1] = param.k * param.l * std::cos(angle);
+        m_moment[i][2] = m_motors[i].clockwise ? -param.b : param.b;
+      }
+
       // Calculate thrust scale
       // Must be run after generateMOtors, since it calculates m_n_motors.
       if (m_linear_actuator_dynamics)
@@ -70,82 +97,104 @@ namespace Simulators
     }
 
     MulticopterModel::~MulticopterModel()
-    {
-      if (m_motors != NULL)
-        std::free(m_motors);
-    }
+    { }
 
-    Matrix
-    MulticopterModel::stepInv(const Matrix& servo_speed, const Matrix& nu, const Matrix& eta)
+    void
+    MulticopterModel::stepInv(const double* servo_speed, const double* nu, const double* eta, double* accel) const
     {
+      double tau[6];
+      double c[6];
+      double d[6];
+      double g[6];
+
+      computeTau(servo_speed, tau);
+      computeC(nu, c);
+      computeD(nu, d);
+      computeG(eta, g);
 
-      Matrix tau = computeTau(servo_speed);
-      return inverse(m_matrix_mass) * (tau - computeC(nu) * nu - computeD(nu) * nu - computeG(eta));
+      double f[6];
+      for (unsigned i = 0; i < 6; i++)
+        f[i] = tau[i] - c[i] - d[i] - g[i];
+
+      for (unsigned i = 0; i < 6; i++)
+      {
+        accel[i] = 0.0;
+        for (unsigned j = 0; j < 6; j++)
+          accel[i] += m_mass_inv[i][j] * f[j];
+      }
     }
 
     //! Compute mass matrix
-    Math::Matrix MulticopterModel::computeM(void)
+    Math::Matrix
+    MulticopterModel::computeM(void) const
     {
-      Matrix cog = -skew(m_cog) * m_mass;
+      double cog[3] = {m_cog[0], m_cog[1], m_cog[2]};
+      double inertia[3] = {m_inertia[0], m_inertia[1], m_inertia[2]};
+      Matrix scog = -skew(Matrix(cog, 3, 1)) * m_mass;
       Matrix Mrb = Matrix(3) * m_mass;
-      Mrb.vertCat(-cog);
-      Mrb.horzCat(cog.vertCat(m_inertia));
+      Mrb.vertCat(-scog);
+      Mrb.horzCat(scog.vertCat(Matrix(inertia, 3)));
       return Mrb;
     }
 
-    //! Computes linear damping matrix
-    Math::Matrix
-    MulticopterModel::computeD(const Math::Matrix& nu)
+    //! Computes linear damping forces
+    void
+    MulticopterModel::computeD(const double* nu, double* d) const
     {
-      (void)nu;
-      return m_ldrag;
+      for (unsigned i = 0; i < 6; i++)
+        d[i] = m_ldrag[i] * nu[i];
     }
 
-    //! Computes quadratic damping matrix
-    Math::Matrix
-    MulticopterModel::computeQ(const Math::Matrix& nu)
+    //! Computes quadratic damping forces
+    void
+    MulticopterModel::computeQ(const double* nu, double* q) const
     {
-      Math::Matrix nu_signsquare = Matrix(6, 1);
-      for (int i = 0; i < 6; i++)
-      {
-        nu_signsquare(i) = std::abs(nu(i)) * nu(i);
-      }
-
-      return m_qdrag * nu_signsquare;
+      for (unsigned i = 0; i < 6; i++)
+        q[i] = m_qdrag[i] * std::abs(nu[i]) * nu[i];
     }
 
     // Compute Gravity
-    Math::Matrix
-    MulticopterModel::computeG(const Math::Matrix& eta)
+    void
+    MulticopterModel::computeG(const double* eta, double* g) const
     {
-      double phi = eta(3);
-      double theta = eta(4);
+      double sphi = std::sin(eta[3]);
+      double cphi = std::cos(eta[3]);
+      double stheta = std::sin(eta[4]);
+      double ctheta = std::cos(eta[4]);
       double W = m_mass * Math::c_gravity;
-      double g[6] = { W * std::sin(theta), -W * std::cos(theta) * std::sin(phi), -W * std::cos(theta)
-                                                                  * std::cos(phi),
-                      -m_cog(1) * W * std::cos(theta) * std::cos(phi)
-                      + m_cog(2) * W * std::cos(theta) * std::sin(phi),
-                      m_cog(2) * W * std::sin(theta)
-                      + m_cog(0) * W * std::cos(theta) * std::cos(phi),
-                      -m_cog(0) * W * std::cos(theta)
-                      * std::sin(phi) - m_cog(1) * W * std::sin(theta) };
-      return Matrix(g, 6, 1);
+
+      g[0] = W * stheta;
+      g[1] = -W * ctheta * sphi;
+      g[2] = -W * ctheta * cphi;
+      g[3] = -m_cog[1] * W * ctheta * cphi + m_cog[2] * W * ctheta * sphi;
+      g[4] = m_cog[2] * W * stheta + m_cog[0] * W * ctheta * cphi;
+      g[5] = -m_cog[0] * W * ctheta * sphi - m_cog[1] * W * stheta;
     }
 
     // (3.56) i Fossen
-    // Coreolis force matrix.
-    Math::Matrix
-    MulticopterModel::computeC(const Math::Matrix& nu)
+    // Coriolis and centripetal forces, C(nu) * nu.
+    void
+    MulticopterModel::computeC(const double* nu, double* c) const
     {
-      Matrix skew_cog = skew(m_cog);
-      Matrix skew_v1 = skew(nu.get(0, 2, 0, 0));
-      Matrix skew_v2 = skew(nu.get(3, 5, 0, 0));
-      Matrix crb(3, 3, 0.0);
-      crb.vertCat(-m_mass * skew_v1 + m_mass * skew_cog * skew_v2);
-      Matrix crb2 = -m_mass * skew_v1 - m_mass * skew_v2 * skew_cog;
-      crb2.vertCat(-skew(m_inertia * nu.get(3, 5, 0, 0)));
-      crb.horzCat(crb2);
-      return crb;
+      const double* v1 = nu;
+      const double* v2 = nu + 3;
+      double a[3];
+      double b[3];
+
+      // -m * (v1 x v2 + v2 x (cog x v2))
+      cross(m_cog, v2, a);
+      cross(v2, a, b);
+      cross(v1, v2, a);
+      for (unsigned i = 0; i < 3; i++)
+        c[i] = -m_mass * (a[i] + b[i]);
+
+      // m * cog x (v2 x v1) - (I * v2) x v2
+      cross(v2, v1, a);
+      cross(m_cog, a, b);
+      double iv2[3] = {m_inertia[0] * v2[0], m_inertia[1] * v2[1], m_inertia[2] * v2[2]};
+      cross(iv2, v2, a);
+      for (unsigned i = 0; i < 3; i++)
+        c[3 + i] = m_mass * b[i] - a[i];
     }
 
     void
@@ -155,7 +204,6 @@ namespace Simulators
       if (frame == Frame_quad)
       {
         m_n_motors = 4;
-        m_motors = (CopterMotor*)std::malloc(m_n_motors * sizeof(CopterMotor));
 
         m_motors[0] = CopterMotor(90, false, 1);
         m_motors[1] = CopterMotor(270, false, 2);
@@ -174,7 +222,6 @@ namespace Simulators
       {
         // HEX
         m_n_motors = 6;
-        m_motors = (CopterMotor*)std::malloc(m_n_motors * sizeof(CopterMotor));
 
         m_motors[0] = CopterMotor(0, true, 1);
         m_motors[1] = CopterMotor(180, false, 2);
@@ -194,63 +241,24 @@ namespace Simulators
     }
 
     // Compute forces from motors
-    Math::Matrix
-    MulticopterModel::computeTau(const Math::Matrix& servo_speed)
+    void
+    MulticopterModel::computeTau(const double* servo_speed, double* tau) const
     {
-
-      double thrust = 0.0;
-
-      if (servo_speed.rows() < (int)m_n_motors)
-      {
-        throw(Exception("Invalid servo matrix in multicopter:generateTau"));
-        return Matrix(6, 1, 0.0);
-      }
+      for (unsigned i = 0; i < 6; i++)
+        tau[i] = 0.0;
 
       for (unsigned int i = 0; i < m_n_motors; i++)
       {
-        if (m_linear_actuator_dynamics)
-        {
+        double u = servo_speed[i];
+        if (!m_linear_actuator_dynamics)
+          u *= servo_speed[i];
 
-          // Positive thrust negative on NED upwards.
-          thrust -= servo_speed(i) * m_thrust_scale;
-        }
-        else
-        {
-          thrust -= servo_speed(i) * servo_speed(i) * m_thrust_scale;
-        }
-      }
-
-      Matrix F = Matrix(3, 1, 0.0);
-      F(2) = thrust;
-
-      double m[3] = { 0.0 };
-      for (unsigned int i = 0; i < m_n_motors; i++)
-      {
-        // DID: Reversed yaw rate, switched sin and cos.
-
-        if (m_linear_actuator_dynamics)
-        {
-          m[0] += m_k * m_l * -std::sin(Angles::radians(m_motors[i].angle)) * servo_speed(i);
-          m[1] += m_k * m_l * std::cos(Angles::radians(m_motors[i].angle)) * servo_speed(i);
-          if (m_motors[i].clockwise)
-            m[2] -= m_b * servo_speed(i);
-          else
-            m[2] += m_b * servo_speed(i);
-        }
-        else
-        {
-          m[0] += m_k * m_l * -std::sin(Angles::radians(m_motors[i].angle)) * servo_speed(i) * servo_speed(i);
-          m[1] += m_k * m_l * std::cos(Angles::radians(m_motors[i].angle)) * servo_speed(i) * servo_speed(i);
-          if (m_motors[i].clockwise)
-            m[2] -= m_b * servo_speed(i) * servo_speed(i);
-          else
-            m[2] += m_b * servo_speed(i) * servo_speed(i);
-        }
+        // Positive thrust negative on NED upwards.
+        tau[2] -= u * m_thrust_scale;
+        tau[3] += m_moment[i][0] * u;
+        tau[4] += m_moment[i][1] * u;
+        tau[5] += m_moment[i][2] * u;
       }
-
-      Matrix M = Matrix(m, 3, 1);
-
-      return F.vertCat(M);
     }
   }
 }
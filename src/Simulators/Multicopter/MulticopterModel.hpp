@@ -55,8 +55,18 @@ namespace Simulators
       Configuration_plus
     };
 
+    //! Maximum number of motors of a frame.
+    static const unsigned c_max_motors = 6;
+
     struct CopterMotor
     {
+      CopterMotor(void):
+        angle(0.0),
+        clockwise(false),
+        servo_id(0),
+        speed(0.0)
+      { }
+
       CopterMotor(double a_angle, bool a_clockwise, unsigned int a_servo_id):
         angle(a_angle),
         clockwise(a_clockwise),
@@ -99,6 +109,11 @@ namespace Simulators
     //b = 1.1e-7*1e6;
     //double l = 0.25;
 
+    //! Multicopter rigid-body model. Everything that does not depend
+    //! on the vehicle state (inverse mass matrix, motor lever arms) is
+    //! computed once, and a step only uses fixed-size arrays, so it
+    //! does not allocate and can be called concurrently for different
+    //! vehicles sharing the same model.
     class MulticopterModel
     {
     private:
@@ -106,52 +121,48 @@ namespace Simulators
       double m_mass;
       //! Models hover throttle
       double m_hover_throttle;
-      //! Models pitch/roll motor coefficient
-      double m_k;
-      //! Models length from centre to motor
-      double m_l;
-      //! Models yaw motor coefficient
-      double m_b;
       //! True if actuator dynamics are modeled as linear (as opposed to quadratic)
       bool m_linear_actuator_dynamics;
-      //! Models frame type
-      Frame m_frame;
-      //! Models frame configuration;
-      Configuration m_configuration;
       //! Center of gravity's coordinates
-      Math::Matrix m_cog;
-      //! Inertia coeficients
-      Math::Matrix m_inertia;
-      //! Model's linear damping coefficients
-      Math::Matrix m_ldrag;
-      //! Models quadratic (sign(x)*x) coefficients
-      Math::Matrix m_qdrag;
+      double m_cog[3];
+      //! Inertia coeficients (main diagonal)
+      double m_inertia[3];
+      //! Model's linear damping coefficients (main diagonal)
+      double m_ldrag[6];
+      //! Models quadratic (sign(x)*x) coefficients (main diagonal)
+      double m_qdrag[6];
 
       //! Calculated in constructor.
       //! From input to newton.
       double m_thrust_scale;
-      //! Model's matrix of mass moments and added inertia
-      Math::Matrix m_matrix_mass;
+      //! Inverse of the matrix of mass moments and added inertia
+      double m_mass_inv[6][6];
       //! Holds information about helicopters motors.
-      CopterMotor* m_motors;
+      CopterMotor m_motors[c_max_motors];
       unsigned int m_n_motors;
+      //! Roll, pitch and yaw moment of each motor per unit of actuation.
+      double m_moment[c_max_motors][3];
 
     public:
       MulticopterModel(const MulticopterModelParameters& param);
       virtual ~MulticopterModel();
 
       //! Routine to compute the next step, yet compute the acceleration instead of forces
-      Math::Matrix
-      stepInv(const Math::Matrix& servo_speed, const Math::Matrix& nu, const Math::Matrix& eta);
+      //! @param[in] servo_speed actuation of each motor (at least getNMotors() values).
+      //! @param[in] nu body-fixed linear and angular velocity (6 values).
+      //! @param[in] eta position and attitude (6 values).
+      //! @param[out] accel body-fixed linear and angular acceleration (6 values).
+      void
+      stepInv(const double* servo_speed, const double* nu, const double* eta, double* accel) const;
 
       double
-      getThrustScale(void)
+      getThrustScale(void) const
       {
         return m_thrust_scale;
       };
 
       unsigned int
-      getNMotors(void)
+      getNMotors(void) const
       {
         return m_n_motors;
       };
@@ -163,27 +174,27 @@ namespace Simulators
 
       //! Computes added mass and inertia
       Math::Matrix
-      computeM(void);
+      computeM(void) const;
 
       //! Computes vector of gravitational forces
-      Math::Matrix
-      computeG(const Math::Matrix& eta);
+      void
+      computeG(const double* eta, double* g) const;
 
-      //! Computes rigid body coriolis and centripetal matrix
-      Math::Matrix
-      computeC(const Math::Matrix& nu);
+      //! Computes rigid body coriolis and centripetal forces
+      void
+      computeC(const double* nu, double* c) const;
 
       //! Compute the resulting tau using thruster actuation and servo positions
-      Math::Matrix
-      computeTau(const Math::Matrix& servo_pos);
+      void
+      computeTau(const double* servo_speed, double* tau) const;
 
-      //! Computes linear damping matrix
-      Math::Matrix
-      computeD(const Math::Matrix& nu);
+      //! Computes linear damping forces
+      void
+      computeD(const double* nu, double* d) const;
 
-      //! Computes quadratic damping matrix
-      Math::Matrix
-      computeQ(const Math::Matrix& nu);
+      //! Computes quadratic damping forces
+      void
+      computeQ(const double* nu, double* q) const;
     };
   }
 }
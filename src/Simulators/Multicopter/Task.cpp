@@ -25,6 +25,9 @@
 // Author: Kristian                                                         *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
@@ -37,6 +40,9 @@ namespace Simulators
   {
     using DUNE_NAMESPACES;
 
+    //! Maximum number of servos driven by the SITL layer.
+    static const unsigned c_max_servos = 8;
+
     struct Arguments
     {
       double mass;
@@ -54,29 +60,175 @@ namespace Simulators
       Math::Matrix inertia;
       Math::Matrix ldrag;
       Math::Matrix qdrag;
+
+      //! Names of the systems of additional simulated copters.
+      std::vector<std::string> systems;
+      //! East offset between consecutive copters.
+      double spacing;
+      //! Number of stepping threads.
+      unsigned threads;
+      //! Maximum integration step.
+      double max_step;
+    };
+
+    //! State of one simulated copter.
+    struct Copter
+    {
+      //! System identifier.
+      unsigned system;
+      //! Vehicle position and attitude.
+      double position[6];
+      //! Vehicle velocity vector.
+      double velocity[6];
+      //! Set servo positions.
+      double servo[c_max_servos];
+      //! Last computed acceleration.
+      double accel[6];
+      //! Simulated state.
+      IMC::SimulatedState sstate;
+      //! Acceleration.
+      IMC::Acceleration acc;
+
+      Copter(void):
+        system(0)
+      {
+        for (unsigned i = 0; i < 6; ++i)
+        {
+          position[i] = 0.0;
+          velocity[i] = 0.0;
+          accel[i] = 0.0;
+        }
+
+        for (unsigned i = 0; i < c_max_servos; ++i)
+          servo[i] = 0.0;
+      }
+    };
+
+    //! Integrate one copter over a time step.
+    //! @param[in] model multicopter model.
+    //! @param[in,out] copter copter state.
+    //! @param[in] timestep time step.
+    static void
+    integrate(const MulticopterModel& model, Copter& copter, double timestep)
+    {
+      double* pos = copter.position;
+      double* vel = copter.velocity;
+
+      // Find the derivative of the position in the earth fixed frame.
+      double dx, dy, dz;
+      BodyFixedFrame::toInertialFrame(pos[3], pos[4], pos[5],
+                                      vel[0], vel[1], vel[2],
+                                      &dx, &dy, &dz);
+
+      double sphi = std::sin(pos[3]);
+      double cphi = std::cos(pos[3]);
+      double ttheta = std::tan(pos[4]);
+      double ctheta = std::cos(pos[4]);
+      double dphi = vel[3] + (sphi * vel[4] + cphi * vel[5]) * ttheta;
+      double dtheta = cphi * vel[4] - sphi * vel[5];
+      double dpsi = (sphi * vel[4] + cphi * vel[5]) / ctheta;
+
+      // Integrate using Euler method
+      pos[0] += timestep * dx;
+      pos[1] += timestep * dy;
+      pos[2] += timestep * dz;
+      pos[3] += timestep * dphi;
+      pos[4] += timestep * dtheta;
+      pos[5] += timestep * dpsi;
+
+      model.stepInv(copter.servo, vel, pos, copter.accel);
+
+      // TODO: Add more sophisticated ground behaviour
+      // Remember, we use a NED-convention, so z is negative when we are in the air
+      if (pos[2] > 0)
+      {
+        // Set position on ground
+        pos[2] = 0;
+
+        // If we are moving downwards, positive z in the ned-frame
+        double vx, vy, vz;
+        BodyFixedFrame::toInertialFrame(pos[3], pos[4], pos[5],
+                                        vel[0], vel[1], vel[2],
+                                        &vx, &vy, &vz);
+
+        if (vz > 0)
+        {
+          // create simple bouncing-feature
+          vz = -0.3 * vz;
+
+          // Update body-velocities
+          BodyFixedFrame::toBodyFrame(pos[3], pos[4], pos[5],
+                                      vx, vy, vz,
+                                      &vel[0], &vel[1], &vel[2]);
+        }
+      }
+
+      // Compute velocity in the vehicle frame that will be used in the next iteration
+      for (unsigned i = 0; i < 6; ++i)
+        vel[i] += timestep * copter.accel[i];
+
+      pos[5] = Angles::normalizeRadian(pos[5]);
+    }
+
+    //! Integrate a range of copters, splitting the time step in
+    //! sub-steps no longer than the given maximum.
+    static void
+    integrate(const MulticopterModel& model, std::vector<Copter>& copters,
+              unsigned begin, unsigned end, double timestep, double max_step)
+    {
+      unsigned steps = 1;
+      if (max_step > 0.0 && timestep > max_step)
+        steps = (unsigned)std::ceil(timestep / max_step);
+
+      double h = timestep / steps;
+      for (unsigned i = begin; i < end; ++i)
+      {
+        for (unsigned j = 0; j < steps; ++j)
+          integrate(model, copters[i], h);
+      }
+    }
+
+    struct Task;
+
+    //! Thread stepping a slice of the simulated copters.
+    class Stepper: public Concurrency::Thread
+    {
+    public:
+      Stepper(Task& task, unsigned begin, unsigned end):
+        m_task(task),
+        m_begin(begin),
+        m_end(end)
+      { }
+
+    private:
+      Task& m_task;
+      unsigned m_begin;
+      unsigned m_end;
+
+      void
+      run(void);
     };
 
     struct Task : public Tasks::Periodic
     {
       //! Simulation vehicle.
       MulticopterModel* m_model;
-      //! Simulated position (X,Y,Z).
-      IMC::SimulatedState m_sstate;
-      IMC::EstimatedState m_estate;
-      //! Accelleration
-      IMC::Acceleration m_acc;
-      //! Start time.
-      double m_start_time;
+      //! Simulated copters.
+      std::vector<Copter> m_copters;
+      //! Stepping threads.
+      std::vector<Stepper*> m_steppers;
+      //! Barrier releasing the stepping threads.
+      Concurrency::Barrier* m_start;
+      //! Barrier waiting for the stepping threads.
+      Concurrency::Barrier* m_done;
+      //! Time step being integrated.
+      double m_timestep;
       //! Last time update was ran
       double m_last_update;
-      //! Set Servo positions
-      Matrix m_servo_speed;
-      //! Vehicle position
-      Matrix m_position;
-      //! Vehicle velocity vector
-      Matrix m_velocity;
       //! Task arguments.
       Arguments m_args;
+      //! Entity id of the SITL layer.
+      unsigned m_sitl_eid;
 
       //! Constructor.
       //! @param[in] name task name.
@@ -84,23 +236,12 @@ namespace Simulators
       Task(const std::string& name, Tasks::Context& ctx):
         Periodic(name, ctx),
         m_model(NULL),
-        m_start_time(Clock::get()),
+        m_start(NULL),
+        m_done(NULL),
+        m_timestep(0.0),
         m_last_update(Clock::get()),
-        m_servo_speed(8, 1, 0.0), // max 8 servos.
-        m_position(6, 1, 0.0),
-        m_velocity(6, 1, 0.0)
+        m_sitl_eid(DUNE_IMC_CONST_UNK_EID)
       {
-        // init positions
-
-        // at trondheim
-        m_sstate.lat = Angles::radians(63.45515289);
-        m_sstate.lon = Angles::radians(10.91983723);
-
-        // USA
-        m_sstate.lat = Angles::radians(37.61);
-        m_sstate.lon = Angles::radians(-122.38);
-        m_sstate.height = 0;
-
         param("Mass", m_args.mass)
         .defaultValue("3.0")
         .units(Units::Kilogram)
@@ -152,6 +293,25 @@ namespace Simulators
         .defaultValue("")
         .description("Quadratic (abs(x)*x) drag of the vehicle (6 elements of main diagonal)");
 
+        param("Additional Systems", m_args.systems)
+        .defaultValue("")
+        .description("Systems of additional copters simulated by this task");
+
+        param("Spacing", m_args.spacing)
+        .defaultValue("5.0")
+        .units(Units::Meter)
+        .description("East offset between the initial positions of consecutive copters");
+
+        param("Threads", m_args.threads)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of threads stepping the simulated copters");
+
+        param("Maximum Step", m_args.max_step)
+        .defaultValue("0.01")
+        .units(Units::Second)
+        .description("Longest integration step, longer periods are split in sub-steps");
+
         bind<IMC::SetPWM>(this);
 
         // Set OK status
@@ -174,6 +334,14 @@ namespace Simulators
       void
       onEntityResolution(void)
       {
+        try
+        {
+          m_sitl_eid = resolveEntity("Sitl Layer");
+        }
+        catch (...)
+        {
+          m_sitl_eid = DUNE_IMC_CONST_UNK_EID;
+        }
       }
 
       //! Acquire resources.
@@ -225,7 +393,41 @@ namespace Simulators
 
         m_model = new MulticopterModel(par);
 
-        inf(DTR("Multicopter simulation started."));
+        m_copters.resize(m_args.systems.size() + 1);
+        m_copters[0].system = getSystemId();
+        for (unsigned i = 1; i < m_copters.size(); ++i)
+          m_copters[i].system = resolveSystemName(m_args.systems[i - 1]);
+
+        for (unsigned i = 0; i < m_copters.size(); ++i)
+        {
+          Copter& c = m_copters[i];
+          c.position[1] = i * m_args.spacing;
+          c.sstate.setSource(c.system);
+          c.acc.setSource(c.system);
+
+          // USA
+          c.sstate.lat = Angles::radians(37.61);
+          c.sstate.lon = Angles::radians(-122.38);
+          c.sstate.height = 0;
+        }
+
+        unsigned threads = std::min(m_args.threads, (unsigned)m_copters.size());
+        if (threads > 1)
+        {
+          m_start = new Concurrency::Barrier(threads);
+          m_done = new Concurrency::Barrier(threads);
+
+          unsigned slice = m_copters.size() / threads;
+          for (unsigned i = 1; i < threads; ++i)
+          {
+            unsigned end = (i == threads - 1) ? m_copters.size() : (i + 1) * slice;
+            Stepper* stepper = new Stepper(*this, i * slice, end);
+            stepper->start();
+            m_steppers.push_back(stepper);
+          }
+        }
+
+        inf(DTR("Multicopter simulation started with %u copters."), (unsigned)m_copters.size());
       }
 
       //! Initialize resources.
@@ -238,69 +440,79 @@ namespace Simulators
       void
       onResourceRelease(void)
       {
-        // Release model
-        Memory::clear(m_model);
-      }
+        if (!m_steppers.empty())
+        {
+          for (unsigned i = 0; i < m_steppers.size(); ++i)
+            m_steppers[i]->stop();
 
-      Matrix
-      matrixJ(float roll, float pitch, float yaw)
-      {
-        double cx_elements[9] = { 1, 0, 0,
-                                  0, std::cos(roll), std::sin(roll),
-                                  0, -std::sin(roll), std::cos(roll) };
+          m_start->wait();
+
+          for (unsigned i = 0; i < m_steppers.size(); ++i)
+          {
+            m_steppers[i]->join();
+            delete m_steppers[i];
+          }
 
-        double cy_elements[9] = { std::cos(pitch), 0, -std::sin(pitch),
-                                  0, 1, 0,
-                                  std::sin(pitch), 0, std::cos(pitch) };
+          m_steppers.clear();
+        }
 
-        double cz_elements[9] = { std::cos(yaw), std::sin(yaw), 0,
-                                  -std::sin(yaw), std::cos(yaw), 0,
-                                  0, 0, 1 };
+        Memory::clear(m_start);
+        Memory::clear(m_done);
 
-        Matrix J1 = transpose(Matrix(cz_elements, 3, 3)) * transpose(Matrix(cy_elements, 3, 3)) * transpose(Matrix(cx_elements, 3, 3));
+        // Release model
+        Memory::clear(m_model);
+      }
 
-        double j2_elements[9] = { 1, std::sin(roll) * std::tan(pitch), std::cos(roll) * std::tan(pitch),
-                                  0, std::cos(roll), -std::sin(roll),
-                                  0, std::sin(roll) / std::cos(pitch), std::cos(roll) / std::cos(pitch) };
+      //! Integrate a slice of the copters over the current time step.
+      void
+      step(unsigned begin, unsigned end)
+      {
+        integrate(*m_model, m_copters, begin, end, m_timestep, m_args.max_step);
+      }
 
-        J1.vertCat(Matrix(3, 3, 0.0));
-        Matrix cols456 = Matrix(3, 3, 0.0);
-        cols456.vertCat(Matrix(j2_elements, 3, 3));
-        J1.horzCat(cols456);
+      //! Wait for the next time step and integrate a slice of the copters.
+      //! @return false if the stepping thread must stop.
+      bool
+      stepSlice(Concurrency::Thread& thread, unsigned begin, unsigned end)
+      {
+        m_start->wait();
+        if (thread.isStopping())
+          return false;
 
-        return J1;
+        step(begin, end);
+        m_done->wait();
+        return true;
       }
 
       void
       consume(const IMC::SetPWM* msg)
       {
-        if (resolveEntity(msg->getSourceEntity()) == "Sitl Layer")
+        if (msg->getSourceEntity() != m_sitl_eid)
         {
-          int id = 0;
-          bool got_relevant_message = true;
-
-          // This implements the strange mapping APM has to motors.
-          // Also remember channels are 1-indexed.
-          // [1:1, 2:2, 3:3, 4:4, 5:7, 6:8, 7:10, 8:11]
+          trace(DTR("Got a SetPWM message from another source. Ignoring."));
+          return;
+        }
 
-          /*
-        // Note: Intentionally skipping chan. 5,6 and 9.
-        m_servo_speed(0) = msg->chan1;
-        m_servo_speed(1) = msg->chan2;
-        m_servo_speed(2) = msg->chan3;
-        m_servo_speed(3) = msg->chan4;
-        m_servo_speed(4) = msg->chan7;
-        m_servo_speed(5) = msg->chan8;
-        m_servo_speed(6) = msg->chan10;
-        m_servo_speed(7) = msg->chan11;
-           *
-           */
-
-          switch (msg->id)
+        Copter* copter = NULL;
+        for (unsigned i = 0; i < m_copters.size(); ++i)
+        {
+          if (m_copters[i].system == msg->getSource())
           {
-          default:
-            got_relevant_message = false;
+            copter = &m_copters[i];
             break;
+          }
+        }
+
+        if (copter == NULL)
+          return;
+
+        // This implements the strange mapping APM has to motors.
+        // Also remember channels are 1-indexed.
+        // [1:1, 2:2, 3:3, 4:4, 5:7, 6:8, 7:10, 8:11]
+        // Note: Intentionally skipping chan. 5,6 and 9.
+        int id = 0;
+        switch (msg->id)
+        {
           case 1:
           case 2:
           case 3:
@@ -319,102 +531,79 @@ namespace Simulators
           case 11:
             id = 8;
             break;
-          }
-
-          if (got_relevant_message)
-          {
-            // this is zero-indexed.
-            m_servo_speed(id - 1) = (msg->duty_cycle - 1000) / 1000.0;
-          }
-        }
-        else
-        {
-          trace(DTR("Got a SetPWM message from another source. Ignoring."));
+          default:
+            return;
         }
+
+        // this is zero-indexed.
+        copter->servo[id - 1] = (msg->duty_cycle - 1000) / 1000.0;
       }
 
+      //! Fill and dispatch the state of a copter.
       void
-      task(void)
+      report(Copter& c)
       {
-        // compute the timestep
-        double timestep = Clock::get() - m_last_update;
-        m_last_update = Clock::get();
-
-        // Find the derivative of the position in the earth fixed frame
-        Matrix dposition(6, 1, 0.0);
-        dposition = matrixJ(m_position(3), m_position(4), m_position(5)) * m_velocity;
-
-        // Integrate using Euler method
-        m_position += timestep * dposition;
-
-        Matrix accel;
-        accel = m_model->stepInv(m_servo_speed, m_velocity, m_position);
-        trace("Resulting z-acc: %f", accel(2));
-
-        // TODO: Add more sophisticated ground behaviour
-        // Remember, we use a NED-convention, so z is negative when we are in the air
-        spew("Moving at z: %f, height: %f", m_velocity(2), m_position(2));
-        if (m_position(2) > 0)
-        {
-          trace(DTR("On ground!"));
-          // Set position on ground
-          m_position(2) = 0;
-
-          // If we are moving downwards, positive z in the ned-frame
-          fp32_t vx, vy, vz;
-          BodyFixedFrame::toInertialFrame(m_position(3), m_position(4), m_position(5),
-                                          m_velocity(0), m_velocity(1), m_velocity(2),
-                                          &vx, &vy, &vz);
-
-          if (vz > 0)
-          {
-            // create simple bouncing-feature
-            vz = -0.3 * vz;
-
-            trace(DTR("Bounce!"));
-
-            // Update body-velocities
-            BodyFixedFrame::toBodyFrame(m_position(3), m_position(4), m_position(5),
-                                        vx, vy, vz,
-                                        &m_velocity(0), &m_velocity(1), &m_velocity(2));
-          }
-        }
-
-        // Compute velocity in the vehicle frame that will be used in the next iteration
-        m_velocity += timestep * accel;
-
         // Fill position.
-        double sim_time = Clock::get() - m_start_time;
-        (void)sim_time;
-        m_sstate.x = m_position(0); // + sim_time * m_args.wx;
-        m_sstate.y = m_position(1); // + sim_time * m_args.wy;
-        m_sstate.z = m_position(2);
+        c.sstate.x = c.position[0];
+        c.sstate.y = c.position[1];
+        c.sstate.z = c.position[2];
 
         // Fill attitude.
-        m_sstate.phi = m_position(3);
-        m_sstate.theta = m_position(4);
-        m_position(5) = Angles::normalizeRadian(m_position(5));
-        m_sstate.psi = m_position(5);
+        c.sstate.phi = c.position[3];
+        c.sstate.theta = c.position[4];
+        c.sstate.psi = c.position[5];
 
         // Fill linear velocity.
-        m_sstate.u = m_velocity(0);
-        m_sstate.v = m_velocity(1);
-        m_sstate.w = m_velocity(2);
+        c.sstate.u = c.velocity[0];
+        c.sstate.v = c.velocity[1];
+        c.sstate.w = c.velocity[2];
 
         // Fill angular velocity.
-        m_sstate.p = m_velocity(3);
-        m_sstate.q = m_velocity(4);
-        m_sstate.r = m_velocity(5);
+        c.sstate.p = c.velocity[3];
+        c.sstate.q = c.velocity[4];
+        c.sstate.r = c.velocity[5];
 
         // Fill acceleration
-        m_acc.x = accel(0);
-        m_acc.y = accel(1);
-        m_acc.z = accel(2);
+        c.acc.x = c.accel[0];
+        c.acc.y = c.accel[1];
+        c.acc.z = c.accel[2];
 
-        dispatch(m_acc);
-        dispatch(m_sstate);
+        dispatch(c.acc);
+        dispatch(c.sstate);
+      }
+
+      void
+      task(void)
+      {
+        // compute the timestep
+        double now = Clock::get();
+        m_timestep = now - m_last_update;
+        m_last_update = now;
+
+        if (m_steppers.empty())
+        {
+          step(0, m_copters.size());
+        }
+        else
+        {
+          m_start->wait();
+          step(0, m_copters.size() / (m_steppers.size() + 1));
+          m_done->wait();
+        }
+
+        spew("Moving at z: %f, height: %f", m_copters[0].velocity[2], m_copters[0].position[2]);
+
+        for (unsigned i = 0; i < m_copters.size(); ++i)
+          report(m_copters[i]);
       }
     };
+
+    void
+    Stepper::run(void)
+    {
+      while (m_task.stepSlice(*this, m_begin, m_end))
+      { }
+    }
   }
 }
 
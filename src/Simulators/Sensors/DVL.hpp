@@ -0,0 +1,120 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef SIMULATORS_SENSORS_DVL_HPP_INCLUDED_
+#define SIMULATORS_SENSORS_DVL_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Sensor.hpp"
+
+namespace Simulators
+{
+  namespace Sensors
+  {
+    using DUNE_NAMESPACES;
+
+    //! %DVL arguments.
+    struct DVLArguments
+    {
+      //! Water velocity standard deviation.
+      double stdev_wvel;
+      //! Ground velocity standard deviation.
+      double stdev_gvel;
+      //! Invalid reading probability (0 to 1).
+      double ir_prob;
+    };
+
+    //! Simulated %DVL reporting water and ground velocities, with
+    //! randomly invalid readings.
+    class DVL: public Sensor
+    {
+    public:
+      DVL(Tasks::Task& task, unsigned eid, double frequency, const DVLArguments& args):
+        Sensor(task, eid, frequency),
+        m_args(args)
+      { }
+
+      unsigned
+      getGaussianCount(void) const
+      {
+        return 6;
+      }
+
+      unsigned
+      getUniformCount(void) const
+      {
+        return 1;
+      }
+
+      void
+      sample(State& state, const double* gaussian, const double* uniform)
+      {
+        const IMC::SimulatedState& sstate = state.get();
+
+        if (uniform[0] >= m_args.ir_prob)
+        {
+          m_wvel.x = sstate.u + gaussian[0] * m_args.stdev_wvel;
+          m_wvel.y = sstate.v + gaussian[1] * m_args.stdev_wvel;
+          m_wvel.z = sstate.w + gaussian[2] * m_args.stdev_wvel;
+          m_wvel.validity = (IMC::WaterVelocity::VAL_VEL_X
+                             | IMC::WaterVelocity::VAL_VEL_Y
+                             | IMC::WaterVelocity::VAL_VEL_Z);
+
+          double bf[3];
+          state.getStreamVelocity(bf);
+          m_gvel.x = sstate.u + gaussian[3] * m_args.stdev_gvel + bf[0];
+          m_gvel.y = sstate.v + gaussian[4] * m_args.stdev_gvel + bf[1];
+          m_gvel.z = sstate.w + gaussian[5] * m_args.stdev_gvel + bf[2];
+          m_gvel.validity = (IMC::GroundVelocity::VAL_VEL_X
+                             | IMC::GroundVelocity::VAL_VEL_Y
+                             | IMC::GroundVelocity::VAL_VEL_Z);
+        }
+        else
+        {
+          m_wvel.validity = 0;
+          m_gvel.validity = 0;
+        }
+
+        dispatch(m_wvel, state.getTime());
+        dispatch(m_gvel, state.getTime());
+      }
+
+    private:
+      //! Arguments.
+      DVLArguments m_args;
+      //! Water velocity.
+      IMC::WaterVelocity m_wvel;
+      //! Ground velocity.
+      IMC::GroundVelocity m_gvel;
+    };
+  }
+}
+
+#endif
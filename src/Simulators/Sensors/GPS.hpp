@@ -0,0 +1,151 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef SIMULATORS_SENSORS_GPS_HPP_INCLUDED_
+#define SIMULATORS_SENSORS_GPS_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Sensor.hpp"
+
+namespace Simulators
+{
+  namespace Sensors
+  {
+    using DUNE_NAMESPACES;
+
+    //! GpsFix validity flags of valid fixes.
+    static const uint16_t c_gps_valid = (IMC::GpsFix::GFV_VALID_TIME
+                                         | IMC::GpsFix::GFV_VALID_POS
+                                         | IMC::GpsFix::GFV_VALID_COG
+                                         | IMC::GpsFix::GFV_VALID_SOG
+                                         | IMC::GpsFix::GFV_VALID_HACC
+                                         | IMC::GpsFix::GFV_VALID_HDOP);
+
+    //! %GPS arguments.
+    struct GPSArguments
+    {
+      //! Ground velocity report flag.
+      bool report_gv;
+      //! Yaw report flag.
+      bool report_yaw;
+      //! Activation depth.
+      double act_depth;
+      //! Horizontal Dilution of Precision.
+      double hdop;
+      //! Horizontal Accuracy.
+      double hacc;
+      //! Number of satellites.
+      uint16_t n_sat;
+    };
+
+    //! Simulated %GPS. Fixes are invalid while the origin of the
+    //! simulated state is unknown or the vehicle is underwater.
+    class GPS: public Sensor
+    {
+    public:
+      GPS(Tasks::Task& task, unsigned eid, double frequency, const GPSArguments& args):
+        Sensor(task, eid, frequency),
+        m_args(args),
+        m_last(-1)
+      {
+        m_fix.clear();
+        m_gv.clear();
+        m_euler.clear();
+        m_gv.validity = (IMC::GroundVelocity::VAL_VEL_X
+                         | IMC::GroundVelocity::VAL_VEL_Y
+                         | IMC::GroundVelocity::VAL_VEL_Z);
+      }
+
+      void
+      sample(State& state, const double* gaussian, const double* uniform)
+      {
+        (void)gaussian;
+        (void)uniform;
+
+        const IMC::SimulatedState& sstate = state.get();
+        double now = state.getTime();
+        double elapsed = (m_last < 0) ? 0 : now - m_last;
+        m_last = now;
+
+        if (!state.hasOrigin() || sstate.z > m_args.act_depth)
+        {
+          m_fix.satellites = 0;
+          m_fix.validity = 0;
+          m_fix.sog = 0.0;
+          m_fix.cog = 0.0;
+          m_fix.hdop += elapsed;
+          m_fix.hacc += elapsed;
+          dispatch(m_fix, now);
+          return;
+        }
+
+        m_fix.sog = state.getSpeedOverGround();
+        m_fix.cog = sstate.psi;
+        m_fix.validity = c_gps_valid;
+        m_fix.satellites = m_args.n_sat;
+        m_fix.hdop = m_args.hdop;
+        m_fix.hacc = m_args.hacc;
+        double height = 0;
+        state.getPosition(m_fix.lat, m_fix.lon, height);
+        m_fix.height = height;
+        m_fix.utc_time = ((uint32_t)now) % 86400;
+        dispatch(m_fix, now);
+
+        if (m_args.report_gv)
+        {
+          m_gv.x = sstate.u;
+          m_gv.y = sstate.v;
+          m_gv.z = sstate.z;
+          dispatch(m_gv, now);
+        }
+
+        if (m_args.report_yaw)
+        {
+          m_euler.psi = sstate.psi;
+          dispatch(m_euler, now);
+        }
+      }
+
+    private:
+      //! Arguments.
+      GPSArguments m_args;
+      //! Time of the last sample.
+      double m_last;
+      //! GPS fix.
+      IMC::GpsFix m_fix;
+      //! Ground velocity.
+      IMC::GroundVelocity m_gv;
+      //! Euler angles.
+      IMC::EulerAngles m_euler;
+    };
+  }
+}
+
+#endif
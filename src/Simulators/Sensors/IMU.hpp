@@ -0,0 +1,146 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef SIMULATORS_SENSORS_IMU_HPP_INCLUDED_
+#define SIMULATORS_SENSORS_IMU_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Sensor.hpp"
+
+namespace Simulators
+{
+  namespace Sensors
+  {
+    using DUNE_NAMESPACES;
+
+    //! %IMU arguments.
+    struct IMUArguments
+    {
+      //! Euler angles standard deviation.
+      double stdev_euler;
+      //! Angular velocity standard deviation.
+      double stdev_agvel;
+      //! Heading offset standard deviation.
+      double stdev_heading_offset;
+      //! Gyro rate bias.
+      double gyro_bias;
+      //! Measures Euler angles.
+      bool euler;
+    };
+
+    //! Simulated %IMU with white noise and a heading offset that
+    //! drifts with the gyro rate bias.
+    class IMU: public Sensor
+    {
+    public:
+      //! Constructor.
+      //! @param[in] heading_offset standard normal deviate used to
+      //! draw the initial heading offset.
+      IMU(Tasks::Task& task, unsigned eid, double frequency, const IMUArguments& args,
+          double heading_offset):
+        Sensor(task, eid, frequency),
+        m_args(args),
+        m_heading_offset(heading_offset * Angles::radians(args.stdev_heading_offset)),
+        m_last(-1)
+      { }
+
+      unsigned
+      getGaussianCount(void) const
+      {
+        return m_args.euler ? 6 : 3;
+      }
+
+      void
+      sample(State& state, const double* gaussian, const double* uniform)
+      {
+        (void)uniform;
+
+        const IMC::SimulatedState& sstate = state.get();
+        double tstep = (m_last < 0) ? 0 : state.getTime() - m_last;
+        m_last = state.getTime();
+
+        if (tstep <= 0)
+        {
+          m_vel[0] = sstate.u;
+          m_vel[1] = sstate.v;
+          m_vel[2] = sstate.w;
+          return;
+        }
+
+        double tstamp = sstate.getTimeStamp();
+        double stdev_euler = Angles::radians(m_args.stdev_euler);
+        double stdev_agvel = Angles::radians(m_args.stdev_agvel);
+
+        if (m_args.euler)
+        {
+          m_euler.phi = Angles::normalizeRadian(sstate.phi + gaussian[3] * stdev_euler);
+          m_euler.theta = Angles::normalizeRadian(sstate.theta + gaussian[4] * stdev_euler);
+          m_euler.psi_magnetic = Angles::normalizeRadian(sstate.psi + gaussian[5] * stdev_euler);
+          m_euler.psi = Angles::normalizeRadian(m_euler.psi_magnetic + m_heading_offset);
+          m_heading_offset += Angles::radians(m_args.gyro_bias / 3600) * tstep;
+          dispatch(m_euler, tstamp);
+        }
+
+        m_agvel.x = Angles::normalizeRadian(sstate.p + gaussian[0] * stdev_agvel);
+        m_agvel.y = Angles::normalizeRadian(sstate.q + gaussian[1] * stdev_agvel);
+        m_agvel.z = Angles::normalizeRadian(sstate.r + gaussian[2] * stdev_agvel);
+
+        m_accel.x = (sstate.u - m_vel[0]) / tstep;
+        m_accel.y = (sstate.v - m_vel[1]) / tstep;
+        m_accel.z = (sstate.w - m_vel[2]) / tstep;
+
+        m_vel[0] = sstate.u;
+        m_vel[1] = sstate.v;
+        m_vel[2] = sstate.w;
+
+        dispatch(m_agvel, tstamp);
+        dispatch(m_accel, tstamp);
+      }
+
+    private:
+      //! Arguments.
+      IMUArguments m_args;
+      //! Heading offset.
+      double m_heading_offset;
+      //! Time of the last sample.
+      double m_last;
+      //! Velocity at the last sample.
+      double m_vel[3];
+      //! Euler angles.
+      IMC::EulerAngles m_euler;
+      //! Angular velocity.
+      IMC::AngularVelocity m_agvel;
+      //! Acceleration.
+      IMC::Acceleration m_accel;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,82 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef SIMULATORS_SENSORS_SVS_HPP_INCLUDED_
+#define SIMULATORS_SENSORS_SVS_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Sensor.hpp"
+
+namespace Simulators
+{
+  namespace Sensors
+  {
+    using DUNE_NAMESPACES;
+
+    //! Simulated sound velocity sensor.
+    class SVS: public Sensor
+    {
+    public:
+      //! Constructor.
+      //! @param[in] mean mean sound speed.
+      //! @param[in] std_dev standard deviation of measurements.
+      SVS(Tasks::Task& task, unsigned eid, double frequency, double mean, double std_dev):
+        Sensor(task, eid, frequency),
+        m_mean(mean),
+        m_std_dev(std_dev)
+      { }
+
+      unsigned
+      getGaussianCount(void) const
+      {
+        return 1;
+      }
+
+      void
+      sample(State& state, const double* gaussian, const double* uniform)
+      {
+        (void)uniform;
+
+        m_sspeed.value = m_mean + gaussian[0] * m_std_dev;
+        dispatch(m_sspeed, state.getTime());
+      }
+
+    private:
+      //! Mean sound speed.
+      double m_mean;
+      //! Standard deviation of measurements.
+      double m_std_dev;
+      //! Sound speed.
+      IMC::SoundSpeed m_sspeed;
+    };
+  }
+}
+
+#endif
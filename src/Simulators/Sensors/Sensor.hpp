@@ -0,0 +1,265 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef SIMULATORS_SENSORS_SENSOR_HPP_INCLUDED_
+#define SIMULATORS_SENSORS_SENSOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Simulators
+{
+  namespace Sensors
+  {
+    using DUNE_NAMESPACES;
+
+    //! Simulated state shared by all sensors. Derived quantities are
+    //! computed on first use and kept until the next state update.
+    class State
+    {
+    public:
+      State(void):
+        m_origin_valid(false),
+        m_time(-1)
+      {
+        clearCache();
+      }
+
+      //! Store a new simulated state.
+      //! @param[in] msg simulated state.
+      //! @param[in] now Epoch time of the update.
+      void
+      update(const IMC::SimulatedState& msg, double now)
+      {
+        m_sstate = msg;
+        m_time = now;
+        clearCache();
+      }
+
+      //! Check if a simulated state was received.
+      //! @return true if valid, false otherwise.
+      bool
+      isValid(void) const
+      {
+        return m_time >= 0;
+      }
+
+      const IMC::SimulatedState&
+      get(void) const
+      {
+        return m_sstate;
+      }
+
+      //! Epoch time of the last update.
+      double
+      getTime(void) const
+      {
+        return m_time;
+      }
+
+      //! Define the WGS-84 origin of the simulated state.
+      void
+      setOrigin(double lat, double lon, double height)
+      {
+        m_origin[0] = lat;
+        m_origin[1] = lon;
+        m_origin[2] = height;
+        m_origin_valid = true;
+        m_pos_valid = false;
+      }
+
+      bool
+      hasOrigin(void) const
+      {
+        return m_origin_valid;
+      }
+
+      //! WGS-84 coordinates of the vehicle.
+      //! @param[out] lat latitude.
+      //! @param[out] lon longitude.
+      //! @param[out] height height above ellipsoid.
+      void
+      getPosition(double& lat, double& lon, double& height)
+      {
+        if (!m_pos_valid)
+        {
+          m_pos[0] = m_origin[0];
+          m_pos[1] = m_origin[1];
+          m_pos[2] = m_origin[2];
+          WGS84::displace(m_sstate.x, m_sstate.y, m_sstate.z, &m_pos[0], &m_pos[1], &m_pos[2]);
+          m_pos_valid = true;
+        }
+
+        lat = m_pos[0];
+        lon = m_pos[1];
+        height = m_pos[2];
+      }
+
+      //! Stream velocity in the body-fixed frame.
+      //! @param[out] bf velocity vector.
+      void
+      getStreamVelocity(double bf[3])
+      {
+        if (!m_stream_valid)
+        {
+          BodyFixedFrame::toBodyFrame(m_sstate.phi, m_sstate.theta, m_sstate.psi,
+                                      m_sstate.svx, m_sstate.svy, m_sstate.svz,
+                                      &m_stream[0], &m_stream[1], &m_stream[2]);
+          m_stream_valid = true;
+        }
+
+        bf[0] = m_stream[0];
+        bf[1] = m_stream[1];
+        bf[2] = m_stream[2];
+      }
+
+      //! Horizontal speed in the body-fixed frame.
+      double
+      getSpeedOverGround(void)
+      {
+        if (m_sog < 0)
+          m_sog = std::sqrt(m_sstate.u * m_sstate.u + m_sstate.v * m_sstate.v);
+
+        return m_sog;
+      }
+
+    private:
+      //! Simulated state.
+      IMC::SimulatedState m_sstate;
+      //! WGS-84 origin.
+      double m_origin[3];
+      //! True if the origin is known.
+      bool m_origin_valid;
+      //! Epoch time of the last update.
+      double m_time;
+      //! Cached WGS-84 position.
+      double m_pos[3];
+      bool m_pos_valid;
+      //! Cached body-fixed stream velocity.
+      double m_stream[3];
+      bool m_stream_valid;
+      //! Cached speed over ground (negative if not computed).
+      double m_sog;
+
+      void
+      clearCache(void)
+      {
+        m_pos_valid = false;
+        m_stream_valid = false;
+        m_sog = -1;
+      }
+    };
+
+    //! Virtual sensor sampled from the shared simulated state.
+    class Sensor
+    {
+    public:
+      //! Constructor.
+      //! @param[in] task owner task.
+      //! @param[in] eid entity id of the sensor.
+      //! @param[in] frequency sampling frequency (zero to sample
+      //! every state update).
+      Sensor(Tasks::Task& task, unsigned eid, double frequency):
+        m_task(task),
+        m_eid(eid),
+        m_period(frequency > 0 ? 1.0 / frequency : 0),
+        m_next(-1)
+      { }
+
+      virtual
+      ~Sensor(void)
+      { }
+
+      //! Check if the sensor must be sampled, scheduling the next
+      //! sample.
+      //! @param[in] now current time.
+      //! @return true if due, false otherwise.
+      bool
+      isDue(double now)
+      {
+        if (m_period <= 0)
+          return true;
+
+        if (now < m_next)
+          return false;
+
+        // Keep the phase unless the sensor fell behind.
+        m_next = (m_next < 0 || now - m_next > m_period) ? now + m_period : m_next + m_period;
+        return true;
+      }
+
+      //! Number of standard normal deviates used by each sample.
+      virtual unsigned
+      getGaussianCount(void) const
+      {
+        return 0;
+      }
+
+      //! Number of uniform deviates used by each sample.
+      virtual unsigned
+      getUniformCount(void) const
+      {
+        return 0;
+      }
+
+      //! Produce one sample.
+      //! @param[in] state simulated state.
+      //! @param[in] gaussian standard normal deviates.
+      //! @param[in] uniform uniform deviates in [0, 1).
+      virtual void
+      sample(State& state, const double* gaussian, const double* uniform) = 0;
+
+    protected:
+      //! Owner task.
+      Tasks::Task& m_task;
+
+      //! Dispatch a message from the sensor's entity.
+      //! @param[in] msg message.
+      //! @param[in] tstamp message time stamp.
+      void
+      dispatch(IMC::Message& msg, double tstamp)
+      {
+        msg.setTimeStamp(tstamp);
+        msg.setSourceEntity(m_eid);
+        m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+      }
+
+    private:
+      //! Entity id.
+      unsigned m_eid;
+      //! Sampling period.
+      double m_period;
+      //! Time of the next sample.
+      double m_next;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,387 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Sensor.hpp"
+#include "GPS.hpp"
+#include "IMU.hpp"
+#include "DVL.hpp"
+#include "DepthSensor.hpp"
+#include "SVS.hpp"
+
+namespace Simulators
+{
+  //! Simulation engine for the GPS, IMU, DVL, depth and sound speed
+  //! sensors.
+  //!
+  //! All configured sensors are sampled from a single subscription
+  //! to SimulatedState, so a simulated vehicle needs one thread for
+  //! its navigation sensors instead of one per sensor. Each sensor
+  //! has its own entity and sampling frequency. Derived quantities
+  //! (WGS-84 position, body-fixed stream velocity) are computed at
+  //! most once per state update and the noise of all sensors due at
+  //! an update is drawn in one bulk call to the generator.
+  //!
+  //! @author Ricardo Martins
+  namespace Sensors
+  {
+    using DUNE_NAMESPACES;
+
+    //! Common sensor arguments.
+    struct SensorArguments
+    {
+      //! True to simulate the sensor.
+      bool enabled;
+      //! Entity label.
+      std::string label;
+      //! Sampling frequency.
+      double frequency;
+    };
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! GPS.
+      SensorArguments gps;
+      GPSArguments gps_args;
+      //! IMU.
+      SensorArguments imu;
+      IMUArguments imu_args;
+      //! DVL.
+      SensorArguments dvl;
+      DVLArguments dvl_args;
+      //! Depth sensor.
+      SensorArguments depth;
+      double depth_std_dev;
+      //! Sound speed sensor.
+      SensorArguments svs;
+      double svs_mean;
+      double svs_std_dev;
+      //! PRNG type.
+      std::string prng_type;
+      //! PRNG seed.
+      int prng_seed;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Shared simulated state.
+      Sensors::State m_sim;
+      //! Simulated sensors.
+      std::vector<Sensor*> m_sensors;
+      //! Sensors due at the current update.
+      std::vector<Sensor*> m_due;
+      //! Gaussian deviates of the current update.
+      std::vector<double> m_gaussian;
+      //! Uniform deviates of the current update.
+      std::vector<double> m_uniform;
+      //! Entity ids of each sensor.
+      unsigned m_gps_eid;
+      unsigned m_imu_eid;
+      unsigned m_dvl_eid;
+      unsigned m_depth_eid;
+      unsigned m_svs_eid;
+      //! Pseudo-random generator.
+      Random::Generator* m_prng;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_gps_eid(DUNE_IMC_CONST_UNK_EID),
+        m_imu_eid(DUNE_IMC_CONST_UNK_EID),
+        m_dvl_eid(DUNE_IMC_CONST_UNK_EID),
+        m_depth_eid(DUNE_IMC_CONST_UNK_EID),
+        m_svs_eid(DUNE_IMC_CONST_UNK_EID),
+        m_prng(NULL)
+      {
+        paramSensor("GPS", m_args.gps, "GPS", "1");
+
+        param("GPS - Report Ground Velocity", m_args.gps_args.report_gv)
+        .defaultValue("false")
+        .description("Activate output of Ground Velocity messages");
+
+        param("GPS - Report Yaw", m_args.gps_args.report_yaw)
+        .defaultValue("false")
+        .description("Activate output of Euler Angles messages");
+
+        param("GPS - Activation Depth", m_args.gps_args.act_depth)
+        .units(Units::Meter)
+        .minimumValue("0.0")
+        .maximumValue("1.0")
+        .defaultValue("0.20")
+        .description("Minimum depth at which the GPS is unable to produce accurate fixes");
+
+        param("GPS - HDOP", m_args.gps_args.hdop)
+        .minimumValue("0.0")
+        .defaultValue("0.9")
+        .description("Horizontal Dilution of Position index");
+
+        param("GPS - HACC", m_args.gps_args.hacc)
+        .minimumValue("0.0")
+        .defaultValue("2.0")
+        .description("Horizontal Accuracy index");
+
+        param("GPS - Number of Satellites", m_args.gps_args.n_sat)
+        .defaultValue("8")
+        .description("Number of available satellites");
+
+        paramSensor("IMU", m_args.imu, "AHRS", "0");
+
+        param("IMU - Standard Deviation - Euler Angles", m_args.imu_args.stdev_euler)
+        .units(Units::Degree)
+        .defaultValue("0.3")
+        .description("White noise added to angular readings");
+
+        param("IMU - Standard Deviation - Angular Velocity", m_args.imu_args.stdev_agvel)
+        .units(Units::DegreePerSecond)
+        .defaultValue("0.03")
+        .description("White noise added to angular velocity readings");
+
+        param("IMU - Standard Deviation - Heading Offset", m_args.imu_args.stdev_heading_offset)
+        .units(Units::Degree)
+        .defaultValue("0.0")
+        .description("Heading bias from the compass");
+
+        param("IMU - Gyro Rate Bias", m_args.imu_args.gyro_bias)
+        .units(Units::Degree)
+        .defaultValue("1.0")
+        .description("Gyro rate bias from the IMU");
+
+        param("IMU - Measures Euler Angles", m_args.imu_args.euler)
+        .defaultValue("true")
+        .description("Some IMUs do not output Euler Angles measurements");
+
+        paramSensor("DVL", m_args.dvl, "DVL", "5");
+
+        param("DVL - Standard Deviation - Ground Velocity", m_args.dvl_args.stdev_gvel)
+        .units(Units::MeterPerSecond)
+        .defaultValue("0.004")
+        .description("White noise added to ground velocity readings");
+
+        param("DVL - Standard Deviation - Water Velocity", m_args.dvl_args.stdev_wvel)
+        .units(Units::MeterPerSecond)
+        .defaultValue("0.004")
+        .description("White noise added to water velocity readings");
+
+        param("DVL - Invalid Reading Probability", m_args.dvl_args.ir_prob)
+        .units(Units::Percentage)
+        .minimumValue("0")
+        .maximumValue("100")
+        .defaultValue("10")
+        .description("Probability of a reading being invalid");
+
+        paramSensor("Depth Sensor", m_args.depth, "Depth Sensor", "10");
+
+        param("Depth Sensor - Standard Deviation", m_args.depth_std_dev)
+        .units(Units::Meter)
+        .defaultValue("0.05")
+        .description("White noise added to depth readings");
+
+        paramSensor("SVS", m_args.svs, "Sound Speed Sensor", "1");
+
+        param("SVS - Mean Value", m_args.svs_mean)
+        .units(Units::MeterPerSecond)
+        .defaultValue("1500.0")
+        .description("Mean value for the sound speed");
+
+        param("SVS - Standard Deviation", m_args.svs_std_dev)
+        .units(Units::MeterPerSecond)
+        .defaultValue("0.1")
+        .description("White noise added to sound speed readings");
+
+        param("PRNG Type", m_args.prng_type)
+        .defaultValue(Random::Factory::c_default);
+
+        param("PRNG Seed", m_args.prng_seed)
+        .defaultValue("-1");
+
+        bind<IMC::GpsFix>(this);
+        bind<IMC::SimulatedState>(this);
+      }
+
+      //! Define the parameters shared by all sensors.
+      //! @param[in] name sensor name.
+      //! @param[out] args sensor arguments.
+      //! @param[in] label default entity label.
+      //! @param[in] frequency default sampling frequency.
+      void
+      paramSensor(const std::string& name, SensorArguments& args,
+                  const char* label, const char* frequency)
+      {
+        param(name + " - Enabled", args.enabled)
+        .defaultValue("true")
+        .description("Simulate this sensor");
+
+        param(name + " - Entity Label", args.label)
+        .defaultValue(label)
+        .description("Entity label of this sensor");
+
+        param(name + " - Frequency", args.frequency)
+        .units(Units::Hertz)
+        .minimumValue("0")
+        .defaultValue(frequency)
+        .description("Sampling frequency, zero to sample at every"
+                     " simulated state update");
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if (paramChanged(m_args.dvl_args.ir_prob))
+          m_args.dvl_args.ir_prob *= 0.01;
+      }
+
+      void
+      onEntityReservation(void)
+      {
+        if (m_args.gps.enabled)
+          m_gps_eid = reserveEntity(m_args.gps.label);
+        if (m_args.imu.enabled)
+          m_imu_eid = reserveEntity(m_args.imu.label);
+        if (m_args.dvl.enabled)
+          m_dvl_eid = reserveEntity(m_args.dvl.label);
+        if (m_args.depth.enabled)
+          m_depth_eid = reserveEntity(m_args.depth.label);
+        if (m_args.svs.enabled)
+          m_svs_eid = reserveEntity(m_args.svs.label);
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed, getEntityId());
+
+        if (m_args.gps.enabled)
+          m_sensors.push_back(new GPS(*this, m_gps_eid, m_args.gps.frequency, m_args.gps_args));
+
+        if (m_args.imu.enabled)
+          m_sensors.push_back(new IMU(*this, m_imu_eid, m_args.imu.frequency, m_args.imu_args,
+                                      m_prng->gaussian()));
+
+        if (m_args.dvl.enabled)
+          m_sensors.push_back(new DVL(*this, m_dvl_eid, m_args.dvl.frequency, m_args.dvl_args));
+
+        if (m_args.depth.enabled)
+          m_sensors.push_back(new DepthSensor(*this, m_depth_eid, m_args.depth.frequency,
+                                              m_args.depth_std_dev));
+
+        if (m_args.svs.enabled)
+          m_sensors.push_back(new SVS(*this, m_svs_eid, m_args.svs.frequency,
+                                      m_args.svs_mean, m_args.svs_std_dev));
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        for (unsigned i = 0; i < m_sensors.size(); ++i)
+          delete m_sensors[i];
+        m_sensors.clear();
+
+        Memory::clear(m_prng);
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        setEntityState(IMC::EntityState::ESTA_BOOT, Status::CODE_WAIT_GPS_FIX);
+      }
+
+      void
+      consume(const IMC::GpsFix* msg)
+      {
+        if (msg->getSource() == getSystemId() && msg->getSourceEntity() == m_gps_eid)
+          return;
+
+        m_sim.setOrigin(msg->lat, msg->lon, msg->height);
+      }
+
+      void
+      consume(const IMC::SimulatedState* msg)
+      {
+        if (!isActive())
+        {
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+          requestActivation();
+        }
+
+        double now = Clock::getSinceEpoch();
+        m_sim.update(*msg, now);
+
+        if (!isActive())
+          return;
+
+        // Collect due sensors and the number of deviates they need.
+        unsigned n_gaussian = 0;
+        unsigned n_uniform = 0;
+        m_due.clear();
+        for (unsigned i = 0; i < m_sensors.size(); ++i)
+        {
+          if (!m_sensors[i]->isDue(now))
+            continue;
+
+          m_due.push_back(m_sensors[i]);
+          n_gaussian += m_sensors[i]->getGaussianCount();
+          n_uniform += m_sensors[i]->getUniformCount();
+        }
+
+        if (m_due.empty())
+          return;
+
+        // One extra element keeps the buffers addressable.
+        m_gaussian.resize(n_gaussian + 1);
+        m_uniform.resize(n_uniform + 1);
+        m_prng->fillGaussian(&m_gaussian[0], n_gaussian);
+        m_prng->fillUniform(&m_uniform[0], n_uniform);
+
+        const double* gaussian = &m_gaussian[0];
+        const double* uniform = &m_uniform[0];
+        for (unsigned i = 0; i < m_due.size(); ++i)
+        {
+          m_due[i]->sample(m_sim, gaussian, uniform);
+          gaussian += m_due[i]->getGaussianCount();
+          uniform += m_due[i]->getUniformCount();
+        }
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+          waitForMessages(1.0);
+      }
+    };
+  }
+}
+
+DUNE_TASK
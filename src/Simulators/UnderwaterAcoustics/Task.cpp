@@ -26,10 +26,12 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 #include <map>
 #include <iomanip>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -51,7 +53,31 @@ namespace Simulators
     };
 
     static const double c_sound_speed = 1500;
-    static const double c_max_range = 3000;
+    //! Maximum period between deliveries checks (s).
+    static const double c_max_wait = 0.1;
+
+    //! Frame propagating towards this node.
+    struct Arrival
+    {
+      //! Time at which the first bit reaches this node.
+      double start;
+      //! Time at which the last bit reaches this node (delivery time).
+      double end;
+      //! Frame.
+      IMC::UASimulation* msg;
+      //! True if the frame overlapped another frame or a transmission.
+      bool collided;
+    };
+
+    //! Order arrivals by delivery time, earliest on top of the heap.
+    struct ArrivalOrder
+    {
+      bool
+      operator()(const Arrival& a, const Arrival& b) const
+      {
+        return a.end > b.end;
+      }
+    };
 
     struct Task: public Tasks::Task
     {
@@ -68,9 +94,8 @@ namespace Simulators
       RStateMap m_positions;
 
       // Handling of simulated traffic.
-      IMC::UASimulation* m_pending; // Pending delivery to self
-      double m_busy_till; // Time until underwater medium is busy (for collision detection)
-      double m_send_time;
+      std::vector<Arrival> m_arrivals; // Heap of frames in flight to self
+      double m_tx_till; // Time until own transmission ends (half-duplex)
 
       // UDP socket and related auxilliary data.
       UDPSocket* m_sock;
@@ -80,7 +105,7 @@ namespace Simulators
         Tasks::Task(name, ctx),
         m_setup(false),
         m_fixed_location(false),
-        m_pending(0),
+        m_tx_till(-1),
         m_sock(0)
       {
         param("UDP Communications -- Multicast Address", m_args.udp_maddr)
@@ -149,11 +174,9 @@ namespace Simulators
       void
       onResourceRelease(void)
       {
-        if (m_pending)
-        {
-          delete m_pending;
-          m_pending = 0;
-        }
+        for (size_t i = 0; i < m_arrivals.size(); ++i)
+          delete m_arrivals[i].msg;
+        m_arrivals.clear();
 
         if (m_sock)
         {
@@ -234,40 +257,73 @@ namespace Simulators
         double stime = Clock::get();
         double trip_time = d / c_sound_speed;
         double transm_time = ((double)bits) / (double)m->speed;
-        double etime = stime + trip_time + transm_time;
 
-        double btime = etime;
+        if (src == m_local_imc_addr)
+        {
+          // Half-duplex: anything reaching us while transmitting is lost.
+          double tx_end = stime + transm_time;
+          for (size_t i = 0; i < m_arrivals.size(); ++i)
+          {
+            if (m_arrivals[i].start < tx_end && m_arrivals[i].end > stime)
+              m_arrivals[i].collided = true;
+          }
+
+          m_tx_till = std::max(m_tx_till, tx_end);
+          return;
+        }
 
-        if (d < c_max_range)
-          btime += (c_max_range - d) / c_sound_speed;
+        Arrival a;
+        a.start = stime + trip_time;
+        a.end = a.start + transm_time;
+        a.collided = a.start < m_tx_till;
 
-        if (src != m_local_imc_addr)
+        // Frames collide if their receptions overlap at this node.
+        for (size_t i = 0; i < m_arrivals.size(); ++i)
         {
-          debug("%s | distance %0.3f m | trip time %0.3f s | %d bits at %d bps | data transm. %0.3f | total time %0.3f s",
-                resolveSystemId(src), d, trip_time,
-                bits, m->speed, transm_time, etime - stime);
+          if (a.start < m_arrivals[i].end && m_arrivals[i].start < a.end)
+          {
+            m_arrivals[i].collided = true;
+            a.collided = true;
+          }
         }
 
-        if (stime < m_busy_till)
+        debug("%s | distance %0.3f m | trip time %0.3f s | %d bits at %d bps | data transm. %0.3f | total time %0.3f s",
+              resolveSystemId(src), d, trip_time,
+              bits, m->speed, transm_time, a.end - stime);
+
+        a.msg = new IMC::UASimulation(*m);
+        m_arrivals.push_back(a);
+        std::push_heap(m_arrivals.begin(), m_arrivals.end(), ArrivalOrder());
+      }
+
+      //! Deliver (or drop, if collided) every frame whose reception
+      //! has ended.
+      //! @param[in] now current time.
+      void
+      deliverArrivals(double now)
+      {
+        while (!m_arrivals.empty() && now >= m_arrivals.front().end)
         {
-          err(DTR("collision detected"));
+          std::pop_heap(m_arrivals.begin(), m_arrivals.end(), ArrivalOrder());
+          Arrival a = m_arrivals.back();
+          m_arrivals.pop_back();
 
-          if (m_pending)
+          if (a.collided)
           {
-            delete m_pending;
-            m_pending = 0;
+            err(DTR("collision detected"));
           }
-        }
-        else if (src != m_local_imc_addr)
-        {
-          m_pending = new IMC::UASimulation(*m);
-          m_send_time = etime;
-        }
+          else
+          {
+            debug("delivering | time delivery error: %0.4f",
+                  (now - a.end));
 
-        if (btime > m_busy_till)
-        {
-          debug("collision-prone for %0.2f s", (btime - stime));
-          m_busy_till = btime;
+            if (m_args.trace)
+              a.msg->toText(std::cerr);
+
+            dispatch(a.msg, DF_KEEP_TIME);
+          }
+
+          delete a.msg;
         }
       }
 
@@ -282,7 +338,7 @@ namespace Simulators
 
         m_setup = true;
         m_origin = *msg;
-        m_busy_till = -1;
+        m_tx_till = -1;
       }
 
       void
@@ -336,22 +392,16 @@ namespace Simulators
             last_pos_update = now;
           }
 
-          if (m_pending && now >= m_send_time)
-          {
-            debug("delivering | time delivery error: %0.4f",
-                  (now - m_send_time));
-
-            if (m_args.trace)
-              m_pending->toText(std::cerr);
-
-            dispatch(m_pending, DF_KEEP_TIME);
-            delete m_pending;
-            m_pending = 0;
-          }
+          deliverArrivals(now);
 
           checkIncomingData();
 
-          waitForMessages(0.1);
+          // Wake up in time for the next delivery.
+          double wait = c_max_wait;
+          if (!m_arrivals.empty())
+            wait = std::min(wait, std::max(0.0, m_arrivals.front().end - Clock::get()));
+
+          waitForMessages(wait);
         }
       }
 
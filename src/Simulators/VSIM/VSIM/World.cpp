@@ -33,15 +33,51 @@ namespace Simulators
 {
   namespace VSIM
   {
+    //! Worker thread stepping one partition of the world.
+    class World::Worker: public DUNE::Concurrency::Thread
+    {
+    public:
+      Worker(World& world, unsigned part):
+        m_world(world),
+        m_part(part)
+      { }
+
+    private:
+      //! Parent world.
+      World& m_world;
+      //! Partition index.
+      unsigned m_part;
+
+      void
+      run(void)
+      {
+        while (true)
+        {
+          m_world.m_start->wait();
+
+          if (m_world.m_stopping)
+            break;
+
+          m_world.stepPartition(m_part);
+          m_world.m_done->wait();
+        }
+      }
+    };
+
     World::World(int ident, double grv[3], double tstep):
-      m_timestep(tstep)
+      m_timestep(tstep),
+      m_start(NULL),
+      m_done(NULL),
+      m_stopping(false)
     {
       m_world_id = ident;
       setGravity(grv[0], grv[1], grv[2]);
     }
 
     World::~World(void)
-    {  }
+    {
+      stopWorkers();
+    }
 
     void
     World::setGravity(double x, double y, double z)
@@ -54,49 +90,91 @@ namespace Simulators
     void
     World::addObject(Object* obj)
     {
-      m_objects.push_back(obj);
+      m_bodies.push_back(obj);
       obj->insertInWorld();
     }
 
     void
     World::addVehicle(Vehicle* veh)
     {
-      m_vehicles.push_back(veh);
+      m_bodies.push_back(veh);
       veh->insertInWorld();
     }
 
     void
-    World::applyForces(void)
+    World::setThreads(unsigned count)
+    {
+      if (count < 1)
+        count = 1;
+
+      if (count == getThreads())
+        return;
+
+      stopWorkers();
+
+      if (count == 1)
+        return;
+
+      m_start = new DUNE::Concurrency::Barrier(count);
+      m_done = new DUNE::Concurrency::Barrier(count);
+
+      for (unsigned i = 1; i < count; ++i)
+      {
+        m_workers.push_back(new Worker(*this, i));
+        m_workers.back()->start();
+      }
+    }
+
+    void
+    World::stopWorkers(void)
     {
-      std::list<Object*>::iterator oitr = m_objects.begin();
-      for (; oitr != m_objects.end(); ++oitr)
-        (*oitr)->applyForces();
+      if (m_workers.empty())
+        return;
+
+      m_stopping = true;
+      m_start->wait();
+
+      for (unsigned i = 0; i < m_workers.size(); ++i)
+      {
+        m_workers[i]->join();
+        delete m_workers[i];
+      }
+
+      m_workers.clear();
+      m_stopping = false;
 
-      std::list<Vehicle*>::iterator vitr = m_vehicles.begin();
-      for (; vitr != m_vehicles.end(); ++vitr)
-        (*vitr)->applyForces();
+      delete m_start;
+      m_start = NULL;
+      delete m_done;
+      m_done = NULL;
     }
 
     void
-    World::update(void)
+    World::stepPartition(unsigned part)
     {
-      std::list<Object*>::iterator oitr = m_objects.begin();
-      for (; oitr != m_objects.end(); ++oitr)
-        (*oitr)->update(m_timestep);
+      unsigned parts = getThreads();
+      unsigned begin = m_bodies.size() * part / parts;
+      unsigned end = m_bodies.size() * (part + 1) / parts;
 
-      std::list<Vehicle*>::iterator vitr = m_vehicles.begin();
-      for (; vitr != m_vehicles.end(); ++vitr)
-        (*vitr)->update(m_timestep);
+      for (unsigned i = begin; i < end; ++i)
+      {
+        m_bodies[i]->applyForces();
+        m_bodies[i]->update(m_timestep);
+      }
     }
 
     void
     World::takeStep(void)
     {
-      // Apply forces to vehicle.
-      applyForces();
+      if (m_workers.empty())
+      {
+        stepPartition(0);
+        return;
+      }
 
-      // Update vehicle state.
-      update();
+      m_start->wait();
+      stepPartition(0);
+      m_done->wait();
     }
   }
 }
@@ -30,7 +30,11 @@
 #define SIMULATORS_VSIM_WORLD_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
-#include <list>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Concurrency/Barrier.hpp>
+#include <DUNE/Concurrency/Thread.hpp>
 
 // VSIM headers.
 #include <VSIM/Object.hpp>
@@ -40,7 +44,13 @@ namespace Simulators
 {
   namespace VSIM
   {
-    //! Virtual %World properties
+    //! Virtual %World properties.
+    //!
+    //! Bodies do not interact with each other, so a step applies
+    //! forces to and integrates every body independently. Bodies are
+    //! kept in a contiguous array that can be split among a pool of
+    //! worker threads (see setThreads()), allowing a single world to
+    //! host a large number of vehicles.
     class World
     {
     public:
@@ -76,18 +86,44 @@ namespace Simulators
       void
       addVehicle(Vehicle*);
 
+      //! Define number of threads used to step the world. The
+      //! calling thread is one of them.
+      //! @param[in] count number of threads.
+      void
+      setThreads(unsigned count);
+
+      //! Returns number of threads used to step the world.
+      //! @return number of threads.
+      unsigned
+      getThreads(void) const
+      {
+        return m_workers.size() + 1;
+      }
+
+      //! Returns number of bodies (objects and vehicles) in the world.
+      //! @return number of bodies.
+      unsigned
+      getBodyCount(void) const
+      {
+        return m_bodies.size();
+      }
+
       //! Simulation's tick.
       void
       takeStep(void);
 
     private:
-      //! Applies forces to all objects/vehicles.
+      // Forward declarations.
+      class Worker;
+
+      //! Applies forces to and integrates one partition of the bodies.
+      //! @param[in] part partition index.
       void
-      applyForces(void);
+      stepPartition(unsigned part);
 
-      //! Fetches all objects and vehicles data from simulator.
+      //! Stop and join worker threads.
       void
-      update(void);
+      stopWorkers(void);
 
       //! Set world's gravity.
       //! @param[in] x set world gravity in the x-axis.
@@ -100,12 +136,25 @@ namespace Simulators
       int m_world_id;
       //! World's gravity.
       double m_gravity[3];
-      //! World's vehicles.
-      std::list<Object*> m_objects;
-      //! World's objects.
-      std::list<Vehicle*> m_vehicles;
+      //! World's objects and vehicles.
+      std::vector<Object*> m_bodies;
       //! Integration timestep.
       double m_timestep;
+      //! Worker threads.
+      std::vector<Worker*> m_workers;
+      //! Barrier releasing workers at the start of a step.
+      DUNE::Concurrency::Barrier* m_start;
+      //! Barrier joining workers at the end of a step.
+      DUNE::Concurrency::Barrier* m_done;
+      //! True if workers must exit.
+      volatile bool m_stopping;
+
+      //! Non-copyable.
+      World(const World&);
+
+      //! Non-assignable.
+      World&
+      operator=(const World&);
     };
   }
 }
@@ -71,11 +71,18 @@ namespace Supervisors
         //! Timer started
         STATE_STARTED,
         //! Lost comms plan sent
-        STATE_EXEC
+        STATE_EXEC,
+        //! Number of states
+        STATE_COUNT
       };
 
       struct Task: public DUNE::Tasks::Periodic
       {
+        //! State machine.
+        typedef Utils::TransitionTable<Task, STATE_COUNT> Table;
+
+        //! Transitions of the lost comms state machine.
+        static const Table::Transition c_table[4];
         //! Lost communications timer.
         Counter<double> m_lost_coms_timer;
         //! Vehicle state is error or service
@@ -87,7 +94,7 @@ namespace Supervisors
         //! Availability of data
         unsigned m_dr;
         //! State of the task
-        LostCommsState m_lcs;
+        Table m_lcs;
         //! Plan specification for lost comms
         IMC::PlanSpecification m_plan;
         //! Task arguments.
@@ -97,7 +104,7 @@ namespace Supervisors
           Tasks::Periodic(name, ctx),
           m_serv_err(false),
           m_dr(GOT_NOTHING),
-          m_lcs(STATE_NOT_MET)
+          m_lcs(c_table, sizeof(c_table) / sizeof(c_table[0]), STATE_NOT_MET)
         {
           param("Plan Name", m_args.plan_name)
           .defaultValue("lostcomms")
@@ -149,7 +156,7 @@ namespace Supervisors
           if ((msg->getSource() & 0x4000) == 0)
             return;
 
-          if (m_lcs == STATE_STARTED)
+          if (m_lcs.current() == STATE_STARTED)
             m_lost_coms_timer.reset();
         }
 
@@ -264,6 +271,12 @@ namespace Supervisors
           return testVehicleState() && testPlanControlState() && in_water;
         }
 
+        bool
+        cannotKeepTimer(void)
+        {
+          return !canKeepTimer();
+        }
+
         bool
         canTakeAction(void)
         {
@@ -283,6 +296,48 @@ namespace Supervisors
           return false;
         }
 
+        bool
+        stoppedExecuting(void)
+        {
+          return !isStillExecuting();
+        }
+
+        void
+        onStartTimer(void)
+        {
+          debug("conditions are met to start timer");
+
+          m_lost_coms_timer.setTop(m_args.timeout);
+        }
+
+        void
+        onLostConditions(void)
+        {
+          trace("lost conditions to keep timer");
+        }
+
+        void
+        onStartPlan(void)
+        {
+          war(DTR("starting lost comms plan"));
+
+          IMC::PlanControl pc;
+          pc.type = IMC::PlanControl::PC_REQUEST;
+          pc.op = IMC::PlanControl::PC_START;
+          pc.request_id = 0;
+          pc.plan_id = m_args.plan_name;
+          pc.flags = IMC::PlanControl::FLG_IGNORE_ERRORS;
+          pc.arg.set(m_plan);
+
+          dispatch(pc);
+        }
+
+        void
+        onStoppedExecuting(void)
+        {
+          trace("no longer executing lost comms");
+        }
+
         void
         task(void)
         {
@@ -292,53 +347,20 @@ namespace Supervisors
           if (m_dr != GOT_ALL)
             return;
 
-          switch (m_lcs)
-          {
-            case STATE_NOT_MET:
-              if (canStartTimer())
-              {
-                debug("conditions are met to start timer");
-
-                m_lost_coms_timer.setTop(m_args.timeout);
-
-                m_lcs = STATE_STARTED;
-              }
-              break;
-            case STATE_STARTED:
-              trace("time left is %.1f", m_lost_coms_timer.getRemaining());
-
-              if (!canKeepTimer())
-              {
-                trace("lost conditions to keep timer");
-                m_lcs = STATE_NOT_MET;
-              }
-              else if (canTakeAction())
-              {
-                war(DTR("starting lost comms plan"));
-
-                IMC::PlanControl pc;
-                pc.type = IMC::PlanControl::PC_REQUEST;
-                pc.op = IMC::PlanControl::PC_START;
-                pc.request_id = 0;
-                pc.plan_id = m_args.plan_name;
-                pc.flags = IMC::PlanControl::FLG_IGNORE_ERRORS;
-                pc.arg.set(m_plan);
-
-                dispatch(pc);
-
-                m_lcs = STATE_EXEC;
-              }
-              break;
-            case STATE_EXEC:
-              if (!isStillExecuting())
-              {
-                trace("no longer executing lost comms");
-                m_lcs = STATE_NOT_MET;
-              }
-              break;
-          }
+          if (m_lcs.current() == STATE_STARTED)
+            trace("time left is %.1f", m_lost_coms_timer.getRemaining());
+
+          m_lcs.step(*this);
         }
       };
+
+      const Task::Table::Transition Task::c_table[4] =
+      {
+        {STATE_NOT_MET, &Task::canStartTimer, &Task::onStartTimer, STATE_STARTED},
+        {STATE_STARTED, &Task::cannotKeepTimer, &Task::onLostConditions, STATE_NOT_MET},
+        {STATE_STARTED, &Task::canTakeAction, &Task::onStartPlan, STATE_EXEC},
+        {STATE_EXEC, &Task::stoppedExecuting, &Task::onStoppedExecuting, STATE_NOT_MET}
+      };
     }
   }
 }
@@ -26,9 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
-#include <cstring>
-#include <queue>
-#include <cmath>
+#include <string>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -51,8 +49,23 @@ namespace Supervisors
         float mission_tout;
       };
 
+      enum LostCommsState
+      {
+        //! Monitoring heartbeats
+        STATE_MONITOR,
+        //! Executing lost comms plan
+        STATE_EXEC,
+        //! Number of states
+        STATE_COUNT
+      };
+
       struct Task: public DUNE::Tasks::Periodic
       {
+        //! State machine.
+        typedef Utils::TransitionTable<Task, STATE_COUNT> Table;
+
+        //! Transitions of the lost comms state machine.
+        static const Table::Transition c_table[3];
         //! Emergency message.
         std::string m_emsg;
         //! Time of last heartbeat.
@@ -61,12 +74,20 @@ namespace Supervisors
         bool m_in_mission;
         //! True if executing LostComms plan
         bool m_in_lc;
+        //! Current time.
+        double m_now;
+        //! State of the task.
+        Table m_lcs;
         //! Task arguments.
         Arguments m_args;
 
         Task(const std::string& name, Tasks::Context& ctx):
           Tasks::Periodic(name, ctx),
-          m_in_mission(false)
+          m_heartbeat_last(0.0),
+          m_in_mission(false),
+          m_in_lc(false),
+          m_now(0.0),
+          m_lcs(c_table, sizeof(c_table) / sizeof(c_table[0]), STATE_MONITOR)
         {
           param("Heartbeat Timeout", m_args.heartbeat_tout)
           .units(Units::Second)
@@ -108,30 +129,54 @@ namespace Supervisors
         consume(const IMC::PlanControlState* msg)
         {
           m_in_mission = (msg->state & IMC::PlanControlState::PCS_EXECUTING) != 0;
-          m_in_lc = (std::strcmp(msg->plan_id.c_str(), m_args.plan.c_str()) == 0);
+          m_in_lc = (msg->plan_id == m_args.plan);
         }
 
-        void
-        task(void)
+        bool
+        inLostComms(void)
         {
-          double now = Clock::get();
+          return m_in_lc;
+        }
 
-          if(m_in_lc)
-            return;
+        bool
+        outOfLostComms(void)
+        {
+          return !m_in_lc;
+        }
 
-          if ((now > (m_heartbeat_last + m_args.mission_tout) && m_in_mission) ||
-              now > (m_heartbeat_last + m_args.heartbeat_tout))
-          {
-            IMC::PlanControl p_control;
-            p_control.plan_id = m_args.plan;
-            p_control.op = IMC::PlanControl::PC_START;
-            p_control.type = IMC::PlanControl::PC_REQUEST;
-            p_control.flags = IMC::PlanControl::FLG_IGNORE_ERRORS;
-
-            dispatch(p_control);
-            m_heartbeat_last = now;
-          }
+        bool
+        heartbeatTimeout(void)
+        {
+          return (m_in_mission && m_now > (m_heartbeat_last + m_args.mission_tout)) ||
+          m_now > (m_heartbeat_last + m_args.heartbeat_tout);
         }
+
+        void
+        onStartPlan(void)
+        {
+          IMC::PlanControl p_control;
+          p_control.plan_id = m_args.plan;
+          p_control.op = IMC::PlanControl::PC_START;
+          p_control.type = IMC::PlanControl::PC_REQUEST;
+          p_control.flags = IMC::PlanControl::FLG_IGNORE_ERRORS;
+
+          dispatch(p_control);
+          m_heartbeat_last = m_now;
+        }
+
+        void
+        task(void)
+        {
+          m_now = Clock::get();
+          m_lcs.step(*this);
+        }
+      };
+
+      const Task::Table::Transition Task::c_table[3] =
+      {
+        {STATE_MONITOR, &Task::inLostComms, NULL, STATE_EXEC},
+        {STATE_MONITOR, &Task::heartbeatTimeout, &Task::onStartPlan, STATE_MONITOR},
+        {STATE_EXEC, &Task::outOfLostComms, NULL, STATE_MONITOR}
       };
     }
   }
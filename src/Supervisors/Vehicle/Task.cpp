@@ -26,9 +26,9 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <bitset>
 #include <string>
 #include <vector>
-#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -53,6 +53,9 @@ namespace Supervisors
     //! Cooldown before checking control loops after change into service mode
     static const float c_loops_check_time = 2.0;
 
+    //! Set of entity identifiers.
+    typedef std::bitset<256> EntitySet;
+
     struct Arguments
     {
       //! Relevant entities when performing a safe plan.
@@ -81,8 +84,13 @@ namespace Supervisors
       IMC::IdleManeuver m_idle;
       //! Control loops last reference
       uint32_t m_scope_ref;
-      //! Vector of labels from entities in error
-      std::vector<std::string> m_ents_in_error;
+      //! Entities in error.
+      EntitySet m_ents_in_error;
+      //! Entities relevant when performing a safe plan.
+      EntitySet m_safe_ents;
+      //! Last critical and booting entity lists received.
+      std::string m_cnames;
+      std::string m_enames;
       //! Last vehicle state operation mode
       IMC::VehicleState::OperationModeEnum m_last_op;
       //! Entities booting
@@ -114,6 +122,14 @@ namespace Supervisors
         bind<IMC::PlanControl>(this);
       }
 
+      void
+      onEntityResolution(void)
+      {
+        m_safe_ents.reset();
+        for (unsigned i = 0; i < m_args.safe_ents.size(); ++i)
+          resolveLabel(m_args.safe_ents[i], m_safe_ents);
+      }
+
       void
       onResourceInitialization(void)
       {
@@ -158,7 +174,9 @@ namespace Supervisors
         m_last_op = (IMC::VehicleState::OperationModeEnum)m_vs.op_mode;
         m_eboot = 0;
 
-        m_ents_in_error.clear();
+        m_ents_in_error.reset();
+        m_cnames.clear();
+        m_enames.clear();
       }
 
       void
@@ -283,6 +301,35 @@ namespace Supervisors
         }
       }
 
+      //! Add the entity with a given label to a set.
+      //! @param[in] label entity label.
+      //! @param[in,out] set entity set.
+      void
+      resolveLabel(const std::string& label, EntitySet& set)
+      {
+        try
+        {
+          set.set(resolveEntity(label) & 0xff);
+        }
+        catch (...)
+        {
+          debug("unknown entity '%s'", label.c_str());
+        }
+      }
+
+      //! Add the entities of a comma separated list of labels to a set.
+      //! @param[in] list comma separated list of entity labels.
+      //! @param[in,out] set entity set.
+      void
+      resolveLabels(const std::string& list, EntitySet& set)
+      {
+        std::vector<std::string> elist;
+        String::split(list, ",", elist);
+
+        for (unsigned i = 0; i < elist.size(); ++i)
+          resolveLabel(elist[i], set);
+      }
+
       //! Split comma separated list and translate labels, then join again
       //! @param[in] list comma separated list of entity labels
       //! @return 'comma + white space' separated list of translated entity labels
@@ -311,20 +358,27 @@ namespace Supervisors
           m_vs.last_error_time = msg->last_error_time;
         }
 
-        m_vs.error_ents = "";
-        m_ents_in_error.clear();
         m_eboot = msg->ecount;
 
-        if (msg->ccount)
-          m_vs.error_ents = msg->cnames;
+        const std::string& cnames = msg->ccount ? msg->cnames : std::string();
+        const std::string& enames = msg->ecount ? msg->enames : std::string();
+
+        // Entity lists are only parsed when they change.
+        if (cnames != m_cnames || enames != m_enames)
+        {
+          m_cnames = cnames;
+          m_enames = enames;
 
-        if (msg->ecount)
-          m_vs.error_ents += (msg->ccount ? "," : "") + msg->enames;
+          std::string names = m_cnames;
+          if (!m_enames.empty())
+            names += (names.empty() ? "" : ",") + m_enames;
 
-        // copy list to vector
-        String::split(m_vs.error_ents, ",", m_ents_in_error);
-        // translate list for vehicle state message
-        m_vs.error_ents = splitAndTranslate(m_vs.error_ents);
+          m_ents_in_error.reset();
+          resolveLabels(names, m_ents_in_error);
+
+          // translate list for vehicle state message
+          m_vs.error_ents = splitAndTranslate(names);
+        }
 
         if (prev_count && !m_vs.error_count)
         {
@@ -616,19 +670,7 @@ namespace Supervisors
         if (!m_args.safe_ents.size() || !m_in_safe_plan)
           return true;
 
-        std::vector<std::string>::const_iterator it_ents = m_ents_in_error.begin();
-
-        for (; it_ents != m_ents_in_error.end(); ++it_ents)
-        {
-          std::vector<std::string>::const_iterator it_safe = m_args.safe_ents.begin();
-          for (; it_safe != m_args.safe_ents.end(); ++it_safe)
-          {
-            if (!(*it_ents).compare((*it_safe)))
-              return true;
-          }
-        }
-
-        return false;
+        return (m_ents_in_error & m_safe_ents).any();
       }
 
       inline bool
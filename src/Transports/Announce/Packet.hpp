@@ -0,0 +1,109 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_ANNOUNCE_PACKET_HPP_INCLUDED_
+#define TRANSPORTS_ANNOUNCE_PACKET_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Announce
+  {
+    using DUNE_NAMESPACES;
+
+    //! Serialized Announce message whose time stamp and position can
+    //! be updated in place, without serializing the (mostly static)
+    //! system name and service list again.
+    class Packet
+    {
+    public:
+      Packet(void):
+        m_size(0),
+        m_position(0)
+      { }
+
+      //! Serialize an announce message.
+      //! @param[in] msg announce message.
+      void
+      build(const IMC::Announce& msg)
+      {
+        m_size = IMC::Packet::serialize(&msg, m_bfr, sizeof(m_bfr));
+
+        // Offset of the position fields: header, sys_name, sys_type
+        // and owner.
+        m_position = DUNE_IMC_CONST_HEADER_SIZE
+        + IMC::getSerializationSize(msg.sys_name)
+        + sizeof(msg.sys_type) + sizeof(msg.owner);
+      }
+
+      //! Update the time stamp and position of the serialized message.
+      //! @param[in] msg announce message holding the new values.
+      void
+      update(const IMC::Announce& msg)
+      {
+        if (m_size == 0)
+          return;
+
+        IMC::serialize(msg.getTimeStamp(), m_bfr + c_time_offset);
+
+        uint8_t* ptr = m_bfr + m_position;
+        ptr += IMC::serialize(msg.lat, ptr);
+        ptr += IMC::serialize(msg.lon, ptr);
+        IMC::serialize(msg.height, ptr);
+
+        uint16_t footer = m_size - DUNE_IMC_CONST_FOOTER_SIZE;
+        IMC::serialize(Algorithms::CRC16::compute(m_bfr, footer), m_bfr + footer);
+      }
+
+      const uint8_t*
+      getData(void) const
+      {
+        return m_bfr;
+      }
+
+      uint16_t
+      getSize(void) const
+      {
+        return m_size;
+      }
+
+    private:
+      //! Offset of the time stamp in the header.
+      static const unsigned c_time_offset = 6;
+      //! Serialized message.
+      uint8_t m_bfr[4096];
+      //! Serialized message size.
+      uint16_t m_size;
+      //! Offset of the position fields.
+      unsigned m_position;
+    };
+  }
+}
+
+#endif
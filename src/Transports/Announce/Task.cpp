@@ -34,22 +34,15 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Packet.hpp"
+
 namespace Transports
 {
   namespace Announce
   {
     using DUNE_NAMESPACES;
 
-    struct Destination
-    {
-      // Destination address.
-      Address addr;
-      // Destination port.
-      unsigned port;
-      // True if address is local.
-      bool local;
-    };
-
     struct Arguments
     {
       // Delay between announcements.
@@ -76,16 +69,22 @@ namespace Transports
 
     struct Task: public DUNE::Tasks::Task
     {
-      // Local advertising buffer.
-      uint8_t m_bfr_loc[4096];
-      // External advertising buffer.
-      uint8_t m_bfr_ext[4096];
-      // Last received estimated state.
-      IMC::EstimatedState* m_estate;
+      // Serialized local announce.
+      Packet m_pkt_loc;
+      // Serialized external announce.
+      Packet m_pkt_ext;
+      // True if the serialized announces must be rebuilt.
+      bool m_pkt_dirty;
       // Socket.
       UDPSocket m_sock;
-      // List of destinations.
-      std::vector<Destination> m_dsts;
+      // Local destinations.
+      std::vector<UDPSocket::Destination> m_dsts_loc;
+      // External destinations.
+      std::vector<UDPSocket::Destination> m_dsts_ext;
+      // Network interface changes.
+      InterfaceMonitor m_itf_monitor;
+      // Active network interfaces.
+      std::vector<Interface> m_itfs;
       // Task arguments.
       Arguments m_args;
       // Local announce message.
@@ -103,7 +102,7 @@ namespace Transports
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
-        m_estate(0),
+        m_pkt_dirty(true),
         m_last_announce(-1)
       {
         // Define configuration parameters.
@@ -149,14 +148,10 @@ namespace Transports
         .description("List of interfaces whose services will not be announced");
 
         // Register listeners.
-        bind<IMC::EstimatedState>(this);
         bind<IMC::AnnounceService>(this);
-      }
 
-      ~Task(void)
-      {
-        if (m_estate)
-          delete m_estate;
+        // The latest estimated state is read from the blackboard.
+        ctx.blackboard.track(DUNE_IMC_ESTIMATEDSTATE);
       }
 
       void
@@ -200,6 +195,12 @@ namespace Transports
         m_uris_loc.insert(imcvers.str());
         m_uris_ext.insert(imcvers.str());
 
+        // Consoles that already hold this IMC document need not fetch it.
+        std::ostringstream imcmd5;
+        imcmd5 << "imc+info://0.0.0.0/md5/" << IMC::Blob::getDigest();
+        m_uris_loc.insert(imcmd5.str());
+        m_uris_ext.insert(imcmd5.str());
+
         generateServiceStrings();
 
         // Add additional services defined statically.
@@ -208,18 +209,9 @@ namespace Transports
 
         for (unsigned i = 0; i < m_args.adi_services_ext.size(); ++i)
           m_uris_ext.insert(m_args.adi_services_ext[i]);
-      }
 
-      void
-      consume(const IMC::EstimatedState* msg)
-      {
-        if (msg->getSource() != getSystemId())
-          return;
-
-        if (m_estate)
-          *m_estate = *msg;
-        else
-          m_estate = new IMC::EstimatedState(*msg);
+        // Destinations depend on the announce parameters.
+        probeInterfaces();
       }
 
       void
@@ -229,15 +221,15 @@ namespace Transports
         char domain[128] = {0};
         std::sscanf(msg->service.c_str(), "%*[^/]//%[^:]:", domain);
 
-        std::vector<Interface> interfaces = Interface::get();
+        updateInterfaces();
         for (unsigned i = 0; i < m_args.ignored_interfaces.size(); ++i)
         {
-          for (unsigned j = 0; j < interfaces.size(); ++j)
+          for (unsigned j = 0; j < m_itfs.size(); ++j)
           {
-            if (m_args.ignored_interfaces[i] != interfaces[j].name())
+            if (m_args.ignored_interfaces[i] != m_itfs[j].name())
               continue;
 
-            if (interfaces[j].address() == domain)
+            if (m_itfs[j].address() == domain)
               return;
           }
         }
@@ -261,6 +253,7 @@ namespace Transports
       void
       generateServiceStrings(void)
       {
+        m_pkt_dirty = true;
         m_announce_loc.services.clear();
         m_announce_ext.services.clear();
 
@@ -322,22 +315,27 @@ namespace Transports
         m_announce_ext.services.append(uri);
       }
 
+      //! Refresh the list of interfaces and destinations if the
+      //! network configuration changed.
+      void
+      updateInterfaces(void)
+      {
+        if (m_itf_monitor.changed())
+          probeInterfaces();
+      }
+
       void
       probeInterfaces(void)
       {
-        m_dsts.clear();
+        m_itfs = Interface::get();
+        m_dsts_loc.clear();
+        m_dsts_ext.clear();
 
         // Setup loopback.
         if (m_args.enable_lback)
         {
           for (unsigned i = 0; i < m_args.ports.size(); ++i)
-          {
-            Destination dst;
-            dst.port = m_args.ports[i];
-            dst.addr = "127.0.0.1";
-            dst.local = true;
-            m_dsts.push_back(dst);
-          }
+            m_dsts_loc.push_back(UDPSocket::Destination("127.0.0.1", m_args.ports[i]));
         }
 
         // Setup multicast.
@@ -345,13 +343,7 @@ namespace Transports
         {
           m_sock.setMulticastLoop(false);
           for (unsigned i = 0; i < m_args.ports.size(); ++i)
-          {
-            Destination dst;
-            dst.port = m_args.ports[i];
-            dst.addr = m_args.addr_mcast;
-            dst.local = false;
-            m_dsts.push_back(dst);
-          }
+            m_dsts_ext.push_back(UDPSocket::Destination(m_args.addr_mcast, m_args.ports[i]));
         }
 
         // Setup broadcast.
@@ -360,29 +352,16 @@ namespace Transports
           m_sock.enableBroadcast(true);
 
           for (unsigned j = 0; j < m_args.ports.size(); ++j)
-          {
-            Destination dst;
-            dst.port = m_args.ports[j];
-            dst.addr = "255.255.255.255";
-            dst.local = false;
-            m_dsts.push_back(dst);
-          }
+            m_dsts_ext.push_back(UDPSocket::Destination("255.255.255.255", m_args.ports[j]));
 
-          std::vector<Interface> itfs = Interface::get();
-          for (unsigned i = 0; i < itfs.size(); ++i)
+          for (unsigned i = 0; i < m_itfs.size(); ++i)
           {
             // Discard loopback addresses.
-            if (itfs[i].address().isLoopback() || itfs[i].broadcast().isAny())
+            if (m_itfs[i].address().isLoopback() || m_itfs[i].broadcast().isAny())
               continue;
 
             for (unsigned j = 0; j < m_args.ports.size(); ++j)
-            {
-              Destination dst;
-              dst.port = m_args.ports[j];
-              dst.addr = itfs[i].broadcast();
-              dst.local = false;
-              m_dsts.push_back(dst);
-            }
+              m_dsts_ext.push_back(UDPSocket::Destination(m_itfs[i].broadcast(), m_args.ports[j]));
           }
         }
       }
@@ -390,42 +369,41 @@ namespace Transports
       void
       announce(void)
       {
-        if (m_estate)
+        IMC::SharedMessage* estate = m_ctx.blackboard.getLatest(DUNE_IMC_ESTIMATEDSTATE);
+        if (estate != NULL)
         {
           float hae;
-          Coordinates::toWGS84(*m_estate, m_announce_loc.lat, m_announce_loc.lon, hae);
+          Coordinates::toWGS84(*static_cast<const IMC::EstimatedState*>(estate->get()),
+                               m_announce_loc.lat, m_announce_loc.lon, hae);
           m_announce_loc.height = hae;
+          estate->release();
         }
 
         m_announce_ext.lat = m_announce_loc.lat;
         m_announce_ext.lon = m_announce_loc.lon;
         m_announce_ext.height = m_announce_loc.height;
 
-        // We do this everytime because the number and configuration of
-        // network interfaces might have changed.
-        probeInterfaces();
-
-        // Refresh serialized Announce message.
-        m_announce_loc.setTimeStamp();
-        uint16_t bfr_len_loc = IMC::Packet::serialize(&m_announce_loc, m_bfr_loc, sizeof(m_bfr_loc));
-        m_announce_ext.setTimeStamp();
-        uint16_t bfr_len_ext = IMC::Packet::serialize(&m_announce_ext, m_bfr_ext, sizeof(m_bfr_ext));
+        updateInterfaces();
 
         dispatch(m_announce_loc);
         dispatch(m_announce_ext);
 
-        for (unsigned i = 0; i < m_dsts.size(); ++i)
+        // Serialize only when services or parameters changed;
+        // otherwise patch the time stamp and position.
+        if (m_pkt_dirty)
         {
-          try
-          {
-            if (m_dsts[i].local)
-              m_sock.write(m_bfr_loc, bfr_len_loc, m_dsts[i].addr, m_dsts[i].port);
-            else
-              m_sock.write(m_bfr_ext, bfr_len_ext, m_dsts[i].addr, m_dsts[i].port);
-          }
-          catch (...)
-          { }
+          m_pkt_loc.build(m_announce_loc);
+          m_pkt_ext.build(m_announce_ext);
+          m_pkt_dirty = false;
         }
+        else
+        {
+          m_pkt_loc.update(m_announce_loc);
+          m_pkt_ext.update(m_announce_ext);
+        }
+
+        m_sock.write(m_pkt_loc.getData(), m_pkt_loc.getSize(), m_dsts_loc);
+        m_sock.write(m_pkt_ext.getData(), m_pkt_ext.getSize(), m_dsts_ext);
       }
 
       void
@@ -0,0 +1,231 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_ARDUPILOT_SITL_INSTANCE_HPP_INCLUDED_
+#define TRANSPORTS_ARDUPILOT_SITL_INSTANCE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// POSIX headers.
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace ArdupilotSITL
+  {
+    using DUNE_NAMESPACES;
+
+    //! Struct defined by APM SITL interface
+    struct SITL_rc_control
+    {
+      uint16_t pwm[11];
+      uint16_t speed, direction, turbulance;
+    };
+
+    struct SITL_fdm
+    {
+      // this is the packet sent by the simulator
+      // to the APM executable to update the simulator state
+      // All values are little-endian
+      double latitude, longitude; // degrees
+      double altitude; // MSL
+      double heading; // degrees
+      double speedN, speedE, speedD; // m/s
+      double xAccel, yAccel, zAccel; // m/s/s in body frame
+      double rollRate, pitchRate, yawRate; // degrees/s/s in earth frame
+      double rollDeg, pitchDeg, yawDeg; // euler angles, degrees
+      double airspeed; // m/s
+      uint32_t magic; // 0x4c56414f
+    };
+
+    struct SITL_pwm_packet
+    {
+      uint16_t pwm[8];
+    };
+
+    //! One simulated autopilot: its UDP link, the IMC system it
+    //! stands for and, optionally, the child process running it.
+    class Instance
+    {
+    public:
+      //! Last PWM values received for this instance.
+      SITL_pwm_packet pwm;
+      //! Last acceleration of this instance.
+      IMC::Acceleration accel;
+      //! Holdings for outgoing motor pwm values.
+      IMC::SetPWM motor_pwm[11];
+
+      //! Constructor.
+      //! @param[in] index instance index.
+      //! @param[in] system IMC system id.
+      //! @param[in] port_in port of data from the simulator.
+      //! @param[in] port_out port of data to the simulator.
+      Instance(unsigned index, unsigned system, uint16_t port_in, uint16_t port_out):
+        m_index(index),
+        m_system(system),
+        m_port_in(port_in),
+        m_port_out(port_out),
+        m_sock(NULL),
+        m_pid(-1)
+      {
+        std::memset(&pwm, 0, sizeof(pwm));
+
+        for (int i = 0; i < 11; ++i)
+        {
+          motor_pwm[i].id = i + 1;
+          motor_pwm[i].period = 20000;
+          motor_pwm[i].duty_cycle = 1500;
+          motor_pwm[i].setSource(system);
+        }
+      }
+
+      //! Destructor.
+      ~Instance(void)
+      {
+        terminate();
+        Memory::clear(m_sock);
+      }
+
+      //! Bind the socket of data from the simulator.
+      void
+      open(void)
+      {
+        Memory::clear(m_sock);
+        m_sock = new UDPSocket;
+        m_sock->bind(m_port_in, "");
+      }
+
+      //! Run the simulator as a child process. The command is run by
+      //! the shell with SITL_INSTANCE, SITL_PORT_IN and SITL_PORT_OUT
+      //! set in its environment.
+      //! @param[in] command shell command.
+      void
+      spawn(const std::string& command)
+      {
+        m_pid = fork();
+        if (m_pid == 0)
+        {
+          close(STDIN_FILENO);
+          setenv("SITL_INSTANCE", String::str(m_index).c_str(), 1);
+          setenv("SITL_PORT_IN", String::str(m_port_in).c_str(), 1);
+          setenv("SITL_PORT_OUT", String::str(m_port_out).c_str(), 1);
+          execl("/bin/sh", "/bin/sh", "-c", command.c_str(), (char*)NULL);
+          _exit(127);
+        }
+      }
+
+      //! Test if the child process, if any, has exited.
+      //! @return true if the child process exited, false otherwise.
+      bool
+      hasExited(void)
+      {
+        if (m_pid <= 0)
+          return false;
+
+        int status = 0;
+        if (waitpid(m_pid, &status, WNOHANG) <= 0)
+          return false;
+
+        m_pid = -1;
+        return true;
+      }
+
+      //! Terminate the child process, if any.
+      void
+      terminate(void)
+      {
+        if (m_pid <= 0)
+          return;
+
+        kill(m_pid, SIGTERM);
+        waitpid(m_pid, NULL, 0);
+        m_pid = -1;
+      }
+
+      //! Send a packet to the simulator.
+      //! @param[in] addr simulator address.
+      //! @param[in] data packet.
+      //! @param[in] size packet size.
+      void
+      send(const Address& addr, const void* data, unsigned size)
+      {
+        if (m_sock != NULL)
+          m_sock->write((const uint8_t*)data, size, addr, m_port_out);
+      }
+
+      UDPSocket*
+      getSocket(void)
+      {
+        return m_sock;
+      }
+
+      unsigned
+      getIndex(void) const
+      {
+        return m_index;
+      }
+
+      unsigned
+      getSystem(void) const
+      {
+        return m_system;
+      }
+
+    private:
+      //! Instance index.
+      unsigned m_index;
+      //! IMC system id.
+      unsigned m_system;
+      //! Port of data from the simulator.
+      uint16_t m_port_in;
+      //! Port of data to the simulator.
+      uint16_t m_port_out;
+      //! Socket of data from and to the simulator.
+      UDPSocket* m_sock;
+      //! Child process id.
+      pid_t m_pid;
+
+      //! Non-copyable.
+      Instance(const Instance&);
+
+      //! Non-assignable.
+      Instance&
+      operator=(const Instance&);
+    };
+  }
+}
+
+#endif
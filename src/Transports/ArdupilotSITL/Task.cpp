@@ -27,44 +27,20 @@
 
 // ISO C++ 98 headers
 #include <cmath>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Instance.hpp"
+
 namespace Transports
 {
   namespace ArdupilotSITL
   {
     using DUNE_NAMESPACES;
 
-    //! Struct defined by APM SITL interface
-    struct SITL_rc_control
-    {
-      uint16_t pwm[11];
-      uint16_t speed, direction, turbulance;
-    };
-
-    struct SITL_fdm
-    {
-      // this is the packet sent by the simulator
-      // to the APM executable to update the simulator state
-      // All values are little-endian
-      double latitude, longitude; // degrees
-      double altitude; // MSL
-      double heading; // degrees
-      double speedN, speedE, speedD; // m/s
-      double xAccel, yAccel, zAccel; // m/s/s in body frame
-      double rollRate, pitchRate, yawRate; // degrees/s/s in earth frame
-      double rollDeg, pitchDeg, yawDeg; // euler angles, degrees
-      double airspeed; // m/s
-      uint32_t magic; // 0x4c56414f
-    };
-
-    struct SITL_pwm_packet
-    {
-      uint16_t pwm[8];
-    };
-
     //! %Task arguments.
     struct Arguments
     {
@@ -74,6 +50,14 @@ namespace Transports
       uint16_t sitl_port_out;
       //! Address of ardupilot sitl application
       Address sitl_addr;
+      //! Number of simulator instances.
+      unsigned instances;
+      //! Port offset between consecutive instances.
+      unsigned port_stride;
+      //! IMC systems of the additional instances.
+      std::vector<std::string> systems;
+      //! Command running each simulator instance.
+      std::string command;
     };
 
     // Interface between %DUNE, Ardupilot control and APM SITL.
@@ -82,33 +66,23 @@ namespace Transports
       //! Arguments
       Arguments m_args;
 
-      //! Port from SITL.
-      uint16_t m_sitl_port_in;
-      //! Port to sitl
-      uint16_t m_sitl_port_out;
       //! Address of ardupilot sitl application
       Address m_sitl_addr;
-
-      //! UDP Socket for input from apm.
-      UDPSocket* m_udp_sock_rc_in;
-      //! UDP socket for simulation output.
-      UDPSocket* m_udp_sock_out;
+      //! Simulator instances.
+      std::vector<Instance*> m_instances;
+      //! Sockets of all instances.
+      IO::Poll m_poll;
       //! Buffer
       uint8_t m_buf[512];
-
-      //! Ready to send packet, updated for each new pwm IMC message.
-      SITL_pwm_packet m_pwm;
-      //! Holdings for outgoing motor pwm values
-      IMC::SetPWM m_motor_pwm[11];
-
-      IMC::SimulatedState m_sstate;
-      IMC::Acceleration m_accel;
+      //! Entity id of the RC PWM source.
+      unsigned m_rc_eid;
 
       //! Constructor.
       //! @param[in] name task name.
       //! @param[in] ctx context.
       Task(const std::string& name, Tasks::Context& ctx):
-        DUNE::Tasks::Task(name, ctx)
+        DUNE::Tasks::Task(name, ctx),
+        m_rc_eid(DUNE_IMC_CONST_UNK_EID)
       {
         param("SITL - Port In", m_args.sitl_port_in)
         .defaultValue("5502")
@@ -122,19 +96,32 @@ namespace Transports
         .defaultValue("127.0.0.1")
         .description("Address of the sitl application.");
 
+        param("SITL - Instances", m_args.instances)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of sitl applications bridged by this task");
+
+        param("SITL - Port Stride", m_args.port_stride)
+        .defaultValue("10")
+        .description("Port offset between consecutive sitl applications");
+
+        param("SITL - Systems", m_args.systems)
+        .defaultValue("")
+        .description("IMC system names of the second and following sitl"
+                     " applications. The first one is this system");
+
+        param("SITL - Command", m_args.command)
+        .defaultValue("")
+        .description("Shell command starting each sitl application, with"
+                     " SITL_INSTANCE, SITL_PORT_IN and SITL_PORT_OUT in its"
+                     " environment. Leave empty if started externally");
+
         bind<IMC::PWM>(this);
         bind<IMC::SimulatedState>(this);
         bind<IMC::Acceleration>(this);
 
         // Set OK status
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
-
-        for (int i = 0; i < 11; ++i)
-        {
-          m_motor_pwm[i].id = i + 1;
-          m_motor_pwm[i].period = 20000;
-          m_motor_pwm[i].duty_cycle = 1500;
-        }
       }
 
       //! Update internal state with new parameter values.
@@ -153,6 +140,14 @@ namespace Transports
       void
       onEntityResolution(void)
       {
+        try
+        {
+          m_rc_eid = resolveEntity("RcViaArdupilot");
+        }
+        catch (...)
+        {
+          m_rc_eid = DUNE_IMC_CONST_UNK_EID;
+        }
       }
 
       //! Acquire resources.
@@ -160,17 +155,51 @@ namespace Transports
       onResourceAcquisition(void)
       {
         m_sitl_addr = m_args.sitl_addr;
-        m_sitl_port_in = m_args.sitl_port_in;
-        m_sitl_port_out = m_args.sitl_port_out;
 
-        m_udp_sock_out = new UDPSocket;
-        openConnection();
+        for (unsigned i = 0; i < m_args.instances; ++i)
+        {
+          unsigned system = getSystemId();
+          if (i > 0)
+          {
+            if (i > m_args.systems.size())
+              throw std::runtime_error(String::str(DTR("no system for sitl instance %u"), i));
+
+            system = m_ctx.resolver.resolve(m_args.systems[i - 1]);
+          }
+
+          uint16_t offset = i * m_args.port_stride;
+          Instance* instance = new Instance(i, system,
+                                            m_args.sitl_port_in + offset,
+                                            m_args.sitl_port_out + offset);
+          m_instances.push_back(instance);
+          openConnection(instance);
+
+          if (!m_args.command.empty())
+            instance->spawn(m_args.command);
+        }
+      }
+
+      //! Find the instance simulating a system.
+      //! @param[in] system IMC system id.
+      //! @return instance or NULL if the system is not simulated.
+      Instance*
+      getInstance(unsigned system)
+      {
+        for (unsigned i = 0; i < m_instances.size(); ++i)
+        {
+          if (m_instances[i]->getSystem() == system)
+            return m_instances[i];
+        }
+
+        return NULL;
       }
 
       void
       consume(const IMC::SimulatedState* simstate)
       {
-        m_sstate = *simstate;
+        Instance* instance = getInstance(simstate->getSource());
+        if (instance == NULL)
+          return;
 
         // Create sitl struct and send over socket.
         SITL_fdm fdm;
@@ -184,12 +213,6 @@ namespace Transports
         WGS84::displace(simstate->x, simstate->y, simstate->z,
                         &rcv_lat, &rcv_lon, &rcv_hei);
 
-        IMC::SimulatedState sim = *simstate;
-
-        sim.lat = rcv_lat;
-        sim.lon = rcv_lon;
-        sim.height = rcv_hei;
-
         fdm.latitude = Math::Angles::degrees(rcv_lat);
         fdm.longitude = Math::Angles::degrees(rcv_lon);
         fdm.altitude = rcv_hei;
@@ -213,28 +236,24 @@ namespace Transports
         fdm.speedD = vz;
 
         // Need to rotate gravity to body frame.
-        Matrix gravity = Matrix(3, 1, 0.0);
-        gravity(2) = -Math::c_gravity;
         fp32_t gx, gy, gz;
         BodyFixedFrame::toBodyFrame(simstate->phi, simstate->theta, simstate->psi,
-                                    gravity(0), gravity(1), gravity(2),
+                                    0.0, 0.0, -Math::c_gravity,
                                     &gx, &gy, &gz);
 
-        fdm.xAccel = m_accel.x + gx;
-        fdm.yAccel = m_accel.y + gy;
-        fdm.zAccel = m_accel.z + gz;
+        fdm.xAccel = instance->accel.x + gx;
+        fdm.yAccel = instance->accel.y + gy;
+        fdm.zAccel = instance->accel.z + gz;
 
-        Matrix speeds(3, 1, 0.0);
-        speeds(0) = simstate->u;
-        speeds(1) = simstate->v;
-        speeds(2) = simstate->w;
-        fdm.airspeed = std::sqrt(squaresum(speeds));
+        fdm.airspeed = std::sqrt(simstate->u * simstate->u
+                                 + simstate->v * simstate->v
+                                 + simstate->w * simstate->w);
 
         // Send to ardupilot
         try
         {
           trace(DTR("Sending FDM to ardupilot.."));
-          m_udp_sock_out->write((unsigned char*)&fdm, sizeof(SITL_fdm), m_sitl_addr.c_str(), m_sitl_port_out);
+          instance->send(m_sitl_addr, &fdm, sizeof(SITL_fdm));
         }
         catch (...)
         {
@@ -245,51 +264,57 @@ namespace Transports
       void
       consume(const IMC::Acceleration* msg)
       {
-        m_accel = *msg;
+        Instance* instance = getInstance(msg->getSource());
+        if (instance != NULL)
+          instance->accel = *msg;
       }
 
       void
       consume(const IMC::PWM* msg)
       {
-        // Check source entity label
-        if (resolveEntity(msg->getSourceEntity()) == "RcViaArdupilot")
+        Instance* instance = getInstance(msg->getSource());
+        if (instance == NULL)
+          return;
+
+        // Check source entity.
+        if (instance->getIndex() == 0 && msg->getSourceEntity() != m_rc_eid)
         {
+          trace(DTR("Got PWM message from unknown entity."));
+          return;
+        }
 
-          spew(DTR("Got PWM packet of ID: %d"), msg->id);
+        spew(DTR("Got PWM packet of ID: %d"), msg->id);
 
-          // Only accept 8 values. Ids are 1-indexed.
-          if (msg->id > 8)
-            return;
+        // Only accept 8 values. Ids are 1-indexed.
+        if (msg->id < 1 || msg->id > 8)
+          return;
 
-          m_pwm.pwm[msg->id - 1] = msg->duty_cycle;
+        instance->pwm.pwm[msg->id - 1] = msg->duty_cycle;
 
-          // When we receive ID 8, send
-          // Not optimal way of doing things though..
-          if (msg->id == 8)
+        // When we receive ID 8, send
+        // Not optimal way of doing things though..
+        if (msg->id == 8)
+        {
+          spew(DTR("Sending raw pwm data.."));
+          try
           {
-            spew(DTR("Sending raw pwm data.."));
-            try
-            {
-              m_udp_sock_out->write((unsigned char*)&m_pwm, sizeof(SITL_pwm_packet), m_sitl_addr.c_str(), m_sitl_port_out);
-            }
-            catch (...)
-            {
-              inf(DTR("Unable to send."));
-            }
+            instance->send(m_sitl_addr, &instance->pwm, sizeof(SITL_pwm_packet));
+          }
+          catch (...)
+          {
+            inf(DTR("Unable to send."));
           }
-        }
-        else
-        {
-          trace(DTR("Got PWM message from unknown entity."));
         }
       }
 
       void
-      openConnection()
+      openConnection(Instance* instance)
       {
-        Memory::clear(m_udp_sock_rc_in);
-        m_udp_sock_rc_in = new UDPSocket;
-        m_udp_sock_rc_in->bind(m_sitl_port_in, "");
+        if (instance->getSocket() != NULL)
+          m_poll.remove(*instance->getSocket());
+
+        instance->open();
+        m_poll.add(*instance->getSocket());
       }
 
       //! Initialize resources.
@@ -302,36 +327,47 @@ namespace Transports
       void
       onResourceRelease(void)
       {
-        Memory::clear(m_udp_sock_rc_in);
-      }
-
-      int
-      receiveData(uint8_t* buf, size_t blen)
-      {
-        if (m_udp_sock_rc_in)
+        for (unsigned i = 0; i < m_instances.size(); ++i)
         {
-          try
-          {
-            return m_udp_sock_rc_in->read(buf, blen);
-          }
-          catch (...)
-          {
-            war(DTR("Connection lost, retrying..."));
-            Memory::clear(m_udp_sock_rc_in);
+          if (m_instances[i]->getSocket() != NULL)
+            m_poll.remove(*m_instances[i]->getSocket());
 
-            openConnection();
-            return 0;
-          }
+          delete m_instances[i];
         }
-        return 0;
+
+        m_instances.clear();
       }
 
-      bool
-      poll(double timeout)
+      //! Read and dispatch the RC packets of an instance.
+      //! @param[in] instance simulator instance.
+      void
+      receiveData(Instance* instance)
       {
-        if (m_udp_sock_rc_in != NULL)
-          return Poll::poll(*m_udp_sock_rc_in, timeout);
-        return false;
+        int n = 0;
+
+        try
+        {
+          n = instance->getSocket()->read(m_buf, sizeof(m_buf));
+        }
+        catch (...)
+        {
+          war(DTR("Connection lost, retrying..."));
+          openConnection(instance);
+          return;
+        }
+
+        spew(DTR("Got data from ardpilot SIL."));
+
+        if (n != sizeof(SITL_rc_control))
+          return;
+
+        SITL_rc_control* rc_in = (SITL_rc_control*)&m_buf;
+
+        for (int i = 0; i < 11; ++i)
+        {
+          instance->motor_pwm[i].duty_cycle = rc_in->pwm[i];
+          dispatch(instance->motor_pwm[i]);
+        }
       }
 
       //! Main loop.
@@ -340,28 +376,23 @@ namespace Transports
       {
         while (!stopping())
         {
-          // Poll socket for incomming RC messages
-          if (m_udp_sock_rc_in != NULL)
+          // Wait for incoming RC messages of any instance.
+          if (m_poll.poll(0.01))
           {
-
-            while (poll(0.0))
+            for (unsigned i = 0; i < m_instances.size(); ++i)
             {
+              Instance* instance = m_instances[i];
+              if (m_poll.wasTriggered(*instance->getSocket()))
+                receiveData(instance);
+            }
+          }
 
-              spew(DTR("Got data from ardpilot SIL."));
-              int n = receiveData(m_buf, sizeof(m_buf));
-
-              if (n == sizeof(SITL_rc_control))
-              {
-                SITL_rc_control* rc_in = (SITL_rc_control*)&m_buf;
-
-                for (int i = 0; i < 11; ++i)
-                {
-                  m_motor_pwm[i].duty_cycle = rc_in->pwm[i];
-                  dispatch(m_motor_pwm[i]);
-                }
-              }
-            } // end while
+          for (unsigned i = 0; i < m_instances.size(); ++i)
+          {
+            if (m_instances[i]->hasExited())
+              war(DTR("sitl instance %u exited"), i);
           }
+
           consumeMessages();
         }
       }
@@ -0,0 +1,217 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_CACHE_JOURNAL_HPP_INCLUDED_
+#define TRANSPORTS_CACHE_JOURNAL_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace Transports
+{
+  namespace Cache
+  {
+    using DUNE_NAMESPACES;
+
+    //! Append-only journal of cached messages.
+    //!
+    //! Each record is a serialized IMC packet, so records are
+    //! delimited by their headers and checked by their CRC. Stored
+    //! messages are appended and synchronized with storage; a record
+    //! torn by a power loss is detected when loading and dropped. The
+    //! journal is compacted by writing the current messages to a
+    //! temporary file that atomically replaces it.
+    class Journal
+    {
+    public:
+      //! Constructor.
+      //! @param[in] path journal file.
+      Journal(const Path& path):
+        m_path(path),
+        m_records(0)
+      { }
+
+      //! Get the number of records in the journal.
+      //! @return number of records.
+      unsigned
+      getRecordCount(void) const
+      {
+        return m_records;
+      }
+
+      //! Test if the journal file exists.
+      //! @return true if the file exists, false otherwise.
+      bool
+      exists(void) const
+      {
+        return m_path.isFile();
+      }
+
+      //! Read all valid records of the journal. Reading stops at the
+      //! first truncated or corrupted record.
+      //! @param[out] msgs messages, in journal order (to be deleted
+      //! by the caller).
+      //! @return true if the whole journal is valid, false otherwise.
+      bool
+      load(std::vector<IMC::Message*>& msgs)
+      {
+        m_records = 0;
+
+        int64_t size = m_path.size();
+        if (size <= 0)
+          return true;
+
+        std::vector<uint8_t> data((size_t)size);
+        std::ifstream ifs(m_path.c_str(), std::ios::binary);
+        ifs.read((char*)&data[0], size);
+        size = ifs.gcount();
+
+        int64_t offset = 0;
+        while (offset < size)
+        {
+          unsigned avail = (unsigned)std::min<int64_t>(size - offset, 0xffff);
+          const uint8_t* ptr = &data[(size_t)offset];
+
+          try
+          {
+            IMC::Header hdr;
+            IMC::Packet::deserializeHeader(hdr, ptr, avail);
+
+            unsigned len = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+            if (len > avail)
+              return false;
+
+            msgs.push_back(IMC::Packet::deserializePayload(hdr, ptr, len, NULL));
+            offset += len;
+            ++m_records;
+          }
+          catch (std::exception& e)
+          {
+            (void)e;
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      //! Append a message and synchronize the journal with storage.
+      //! @param[in] msg message.
+      void
+      append(const IMC::Message* msg)
+      {
+        IMC::Packet::serialize(msg, m_bfr);
+
+        std::ofstream ofs(m_path.c_str(), std::ios::binary | std::ios::app);
+        ofs.write(m_bfr.getBufferSigned(), m_bfr.getSize());
+        ofs.close();
+
+        if (ofs.fail())
+          throw std::runtime_error(String::str(DTR("failed to write to '%s'"), m_path.c_str()));
+
+        sync(m_path);
+        ++m_records;
+      }
+
+      //! Replace the journal with one record per message.
+      //! @param[in] msgs messages.
+      void
+      rewrite(const std::vector<const IMC::Message*>& msgs)
+      {
+        Path tmp(m_path.str() + ".tmp");
+
+        std::ofstream ofs(tmp.c_str(), std::ios::binary | std::ios::trunc);
+        for (unsigned i = 0; i < msgs.size(); ++i)
+        {
+          IMC::Packet::serialize(msgs[i], m_bfr);
+          ofs.write(m_bfr.getBufferSigned(), m_bfr.getSize());
+        }
+        ofs.close();
+
+        if (ofs.fail())
+        {
+          tmp.remove();
+          throw std::runtime_error(String::str(DTR("failed to write to '%s'"), tmp.c_str()));
+        }
+
+        sync(tmp);
+
+        if (std::rename(tmp.c_str(), m_path.c_str()) != 0)
+        {
+          // Platforms that do not replace existing files.
+          m_path.remove();
+          if (std::rename(tmp.c_str(), m_path.c_str()) != 0)
+            throw std::runtime_error(String::str(DTR("failed to replace '%s'"), m_path.c_str()));
+        }
+
+        m_records = msgs.size();
+      }
+
+    private:
+      //! Journal file.
+      Path m_path;
+      //! Number of records.
+      unsigned m_records;
+      //! Serialization buffer.
+      Utils::ByteBuffer m_bfr;
+
+      //! Synchronize a file with storage.
+      //! @param[in] path file.
+      static void
+      sync(const Path& path)
+      {
+#if defined(DUNE_SYS_HAS_FDATASYNC)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+          return;
+
+        fdatasync(fd);
+        ::close(fd);
+#else
+        (void)path;
+#endif
+      }
+    };
+  }
+}
+
+#endif
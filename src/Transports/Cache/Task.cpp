@@ -30,10 +30,15 @@
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <map>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Journal.hpp"
+
 namespace Transports
 {
   namespace Cache
@@ -44,39 +49,47 @@ namespace Transports
     {
       // Loading order.
       std::vector<std::string> order;
+      // Superseded journal records tolerated before compaction.
+      unsigned slack;
     };
 
+    // Cached messages of one type, by sub identifier.
+    typedef std::map<uint16_t, IMC::Message*> Entries;
+
     struct Task: public DUNE::Tasks::Task
     {
       // Cache directory path.
       Path m_path;
-      // Path to snapshot file.
-      Path m_snapshot;
-      // Internal buffer.
-      uint8_t* m_buffer;
-      // Internal buffer size.
-      uint16_t m_buffer_size;
+      // Journal of cached messages.
+      Journal* m_journal;
+      // Cached messages, by message name.
+      std::map<std::string, Entries> m_cache;
+      // Number of cached messages.
+      unsigned m_count;
       // Task arguments.
       Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
-        DUNE::Tasks::Task(name, ctx)
+        DUNE::Tasks::Task(name, ctx),
+        m_journal(NULL),
+        m_count(0)
       {
         // Define configuration parameters.
         param("Loading Order", m_args.order)
         .defaultValue("")
         .description("List of messages ordered by loading order");
 
-        // Initialize internal buffer.
-        m_buffer_size = 128;
-        m_buffer = new uint8_t[m_buffer_size];
+        param("Journal Slack", m_args.slack)
+        .defaultValue("64")
+        .description("Number of superseded journal records tolerated"
+                     " before the journal is compacted");
 
         // Create cache directory.
         m_path = m_ctx.dir_db / "Cache";
         m_path.create();
 
-        // Set snapshot file path.
-        m_snapshot = m_path / (std::string(DUNE_IMC_CONST_MD5) + ".lsf");
+        // Journals are specific to an IMC version.
+        m_journal = new Journal(m_path / (std::string(DUNE_IMC_CONST_MD5) + ".jnl"));
 
         // Bind messages.
         bind<IMC::CacheControl>(this);
@@ -84,7 +97,8 @@ namespace Transports
 
       ~Task(void)
       {
-        delete [] m_buffer;
+        reset();
+        delete m_journal;
       }
 
       void
@@ -116,179 +130,220 @@ namespace Transports
         }
       }
 
+      //! Delete all cached messages.
       void
-      getMessageFiles(std::vector<std::string>& files)
+      reset(void)
       {
-        std::vector<std::string> msgs = m_args.order;
+        std::map<std::string, Entries>::iterator itr = m_cache.begin();
+        for (; itr != m_cache.end(); ++itr)
+        {
+          Entries::iterator eitr = itr->second.begin();
+          for (; eitr != itr->second.end(); ++eitr)
+            delete eitr->second;
+        }
+
+        m_cache.clear();
+        m_count = 0;
+      }
+
+      //! Replace the cached message with the same name and sub
+      //! identifier.
+      //! @param[in] msg message (owned by the cache).
+      void
+      insert(IMC::Message* msg)
+      {
+        IMC::Message*& entry = m_cache[msg->getName()][msg->getSubId()];
+
+        if (entry == NULL)
+          ++m_count;
+        else
+          delete entry;
+
+        entry = msg;
+      }
+
+      //! Get all cached messages in loading order.
+      //! @param[out] msgs messages.
+      void
+      getMessages(std::vector<const IMC::Message*>& msgs)
+      {
+        std::vector<std::string> names = m_args.order;
+
+        std::map<std::string, Entries>::const_iterator itr = m_cache.begin();
+        for (; itr != m_cache.end(); ++itr)
+        {
+          if (std::find(names.begin(), names.end(), itr->first) == names.end())
+            names.push_back(itr->first);
+        }
+
+        for (unsigned i = 0; i < names.size(); ++i)
+        {
+          itr = m_cache.find(names[i]);
+          if (itr == m_cache.end())
+            continue;
+
+          Entries::const_iterator eitr = itr->second.begin();
+          for (; eitr != itr->second.end(); ++eitr)
+            msgs.push_back(eitr->second);
+        }
+      }
+
+      //! Rewrite the journal with the cached messages only.
+      void
+      compact(void)
+      {
+        std::vector<const IMC::Message*> msgs;
+        getMessages(msgs);
+
+        try
+        {
+          m_journal->rewrite(msgs);
+        }
+        catch (std::exception& e)
+        {
+          err(DTR("failed to compact cache: %s"), e.what());
+        }
+      }
+
+      //! Import messages cached in per message files by earlier
+      //! versions, removing the files afterwards.
+      void
+      importFiles(void)
+      {
+        std::vector<Path> dirs;
         const char* fname = 0;
 
-        // Retrieve the name of all cached messages that are not in the
-        // loading order list.
         try
         {
           Directory dir(m_path);
 
-          while ((fname = dir.readEntry(Directory::RD_FILE_NAME)))
+          while ((fname = dir.readEntry(Directory::RD_FULL_NAME)))
           {
-            if (std::find(msgs.begin(), msgs.end(), fname) == msgs.end()
-                && ((m_path / fname).type() == Path::PT_DIRECTORY))
-            {
-              msgs.push_back(fname);
-            }
+            if (Path(fname).type() == Path::PT_DIRECTORY)
+              dirs.push_back(fname);
           }
         }
         catch (...)
         { }
 
-        // Load cached messages.
-        for (unsigned int i = 0; i < msgs.size(); ++i)
+        for (unsigned i = 0; i < dirs.size(); ++i)
         {
           try
           {
-            Directory md(m_path / msgs[i]);
+            Directory md(dirs[i]);
             while ((fname = md.readEntry(Directory::RD_FULL_NAME)))
-              files.push_back(fname);
+            {
+              std::ifstream ifs(fname, std::ios::binary);
+              IMC::Message* msg = IMC::Packet::deserialize(ifs);
+              if (msg)
+                insert(msg);
+            }
           }
           catch (...)
           { }
         }
+
+        compact();
+
+        for (unsigned i = 0; i < dirs.size(); ++i)
+          dirs[i].remove(Path::MODE_RECURSIVE);
       }
 
+      //! Read the cached messages from the journal.
       void
-      growBuffer(int size)
+      open(void)
       {
-        if (size > m_buffer_size)
+        if (!m_journal->exists())
         {
-          delete [] m_buffer;
-          m_buffer_size = size;
-          m_buffer = new uint8_t[m_buffer_size];
+          importFiles();
+          return;
         }
-      }
 
-      void
-      store(const IMC::Message* msg)
-      {
-        std::string id = String::str(msg->getSubId());
-        uint16_t size = msg->getSerializationSize();
-
-        // Create destination directory.
-        Path path = m_path / msg->getName();
-        path.create();
+        std::vector<IMC::Message*> msgs;
+        bool valid = m_journal->load(msgs);
 
-        // Open file for writing.
-        path = path / id;
-        std::ofstream ofs(path.c_str(), std::ios::binary);
+        for (unsigned i = 0; i < msgs.size(); ++i)
+          insert(msgs[i]);
 
-        growBuffer(size);
+        if (!valid)
+          war(DTR("dropped incomplete cache records"));
 
-        // Write message to file.
-        IMC::Packet::serialize(msg, m_buffer, size);
-        ofs.write((char*)m_buffer, size);
-        ofs.close();
+        // Drop superseded and incomplete records now so that appends
+        // follow valid data.
+        if (!valid || m_journal->getRecordCount() > m_count)
+          compact();
 
-        storeSnapshot();
+        debug("loaded %u cached messages", m_count);
       }
 
       void
-      loadSnapshot(void)
+      store(const IMC::Message* msg)
       {
-        if (m_snapshot.type() != Path::PT_FILE)
-        {
-          clear();
-          return;
-        }
-
-        std::ifstream ifs(m_snapshot.c_str(), std::ios::binary);
-
-        if (!ifs.is_open())
-          return;
+        insert(msg->clone());
 
-        while (!ifs.eof())
+        try
         {
-          IMC::Message* msg = IMC::Packet::deserialize(ifs);
-          if (msg)
-          {
-            dispatch(msg, DF_KEEP_TIME);
-            delete msg;
-          }
+          m_journal->append(msg);
         }
-      }
-
-      void
-      storeSnapshot(void)
-      {
-        // Retrieve file list.
-        std::vector<std::string> files;
-        getMessageFiles(files);
-
-        std::ofstream ofs(m_snapshot.c_str(), std::ios::binary);
-
-        // Copy all cached messages to a single file.
-        for (unsigned int i = 0; i < files.size(); ++i)
+        catch (std::exception& e)
         {
-          int64_t size = Path(files[i]).size();
-
-          if (size < 0)
-            continue;
-
-          growBuffer(size);
-
-          std::ifstream ifs(files[i].c_str(), std::ios::binary);
-          ifs.read((char*)m_buffer, size);
-          ofs.write((char*)m_buffer, size);
+          err(DTR("failed to store message in cache: %s"), e.what());
         }
+
+        unsigned superseded = m_journal->getRecordCount() - m_count;
+        if (superseded > std::max(m_count, m_args.slack))
+          compact();
       }
 
       void
       copySnapshot(Path destination)
       {
-        if (!Path(m_snapshot).exists())
-          return;
+        std::vector<const IMC::Message*> msgs;
+        getMessages(msgs);
 
-        try
-        {
-          Path(m_snapshot).copy(destination);
-          IMC::CacheControl cc;
-          cc.op = IMC::CacheControl::COP_COPY_COMPLETE;
-          cc.snapshot = destination.str();
-          dispatch(cc);
-        }
-        catch (System::Error& e)
+        std::ofstream ofs(destination.c_str(), std::ios::binary);
+        for (unsigned i = 0; i < msgs.size(); ++i)
+          IMC::Packet::serialize(msgs[i], ofs);
+        ofs.close();
+
+        if (ofs.fail())
         {
-          err(DTR("failed to copy cache snapshot: %s"), e.what());
+          err(DTR("failed to copy cache snapshot: %s"), destination.c_str());
+          return;
         }
+
+        IMC::CacheControl cc;
+        cc.op = IMC::CacheControl::COP_COPY_COMPLETE;
+        cc.snapshot = destination.str();
+        dispatch(cc);
       }
 
       void
       load(void)
       {
-        std::vector<std::string> files;
-        getMessageFiles(files);
+        std::vector<const IMC::Message*> msgs;
+        getMessages(msgs);
 
-        for (unsigned int i = 0; i < files.size(); ++i)
+        for (unsigned i = 0; i < msgs.size(); ++i)
         {
-          std::ifstream ifs(files[i].c_str(), std::ios::binary);
-          IMC::Message* msg = IMC::Packet::deserialize(ifs);
-          if (msg)
-          {
-            dispatch(msg, DF_KEEP_TIME);
-            delete msg;
-          }
+          IMC::Message* msg = msgs[i]->clone();
+          dispatch(msg, DF_KEEP_TIME);
+          delete msg;
         }
       }
 
       void
       clear(void)
       {
-        // Remove cache directory and create a new one.
-        m_path.remove(Path::MODE_RECURSIVE);
-        m_path.create();
+        reset();
+        compact();
       }
 
       void
       onMain(void)
       {
-        loadSnapshot();
+        open();
+        load();
 
         while (!stopping())
         {
@@ -62,9 +62,12 @@ namespace Transports
       std::map<Address, double> m_tstamps;
       // Deserialization buffer.
       uint8_t m_bfr[4096];
+      // Message trace channel.
+      uint8_t m_trace_channel;
 
       Task(const std::string& name, Tasks::Context& ctx):
-        DUNE::Tasks::Task(name, ctx)
+        DUNE::Tasks::Task(name, ctx),
+        m_trace_channel(IMC::dune_trace.getChannel(name))
       {
         // Define configuration parameters.
         param("Ports", m_args.ports)
@@ -77,7 +80,7 @@ namespace Transports
 
         param("Print Incoming Messages", m_args.trace_in)
         .defaultValue("false")
-        .description("Print incoming messages (Debug)");
+        .description("Record incoming messages in the message trace (Debug)");
 
         // Initialize DUNE's UID URL.
         std::ostringstream os;
@@ -204,7 +207,7 @@ namespace Transports
         dispatch(msg, DF_KEEP_TIME);
 
         if (m_args.trace_in)
-          msg->toText(std::cerr);
+          IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_IN);
 
         delete msg;
       }
@@ -26,6 +26,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <list>
 #include <vector>
 
 // DUNE headers.
@@ -67,6 +68,12 @@ namespace Transports
       std::string sound_speed_elabel;
       //! Keep-alive timeout.
       double kalive_tout;
+      //! Maximum number of queued frames.
+      unsigned queue_size;
+      //! Maximum number of frames handed to the modem at once.
+      unsigned max_inflight;
+      //! Transmission timeout.
+      double tx_tout;
     };
 
     // Type definition for mapping addresses.
@@ -93,8 +100,10 @@ namespace Transports
       double m_sound_speed;
       //! Sound speed entity id.
       int m_sound_speed_eid;
-      //! Current transmission ticket.
-      Ticket* m_ticket;
+      //! Frames waiting for transmission.
+      std::list<Ticket> m_queue;
+      //! Frames handed to the modem, oldest first.
+      std::list<Ticket> m_inflight;
       //! Keep-alive counter.
       Counter<double> m_kalive_counter;
       //! Task arguments.
@@ -105,8 +114,7 @@ namespace Transports
         m_sock(NULL),
         m_address(0),
         m_driver(NULL),
-        m_sound_speed_eid(-1),
-        m_ticket(NULL)
+        m_sound_speed_eid(-1)
       {
         param("IPv4 Address", m_args.address)
         .defaultValue("192.168.0.147")
@@ -169,6 +177,24 @@ namespace Transports
         .units(Units::Second)
         .description("Keep-alive timeout");
 
+        param("Transmission Queue Size", m_args.queue_size)
+        .defaultValue("8")
+        .minimumValue("0")
+        .description("Number of frames waiting for the modem before new"
+                     " frames are rejected as busy");
+
+        param("Maximum In-flight Frames", m_args.max_inflight)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of frames handed to the modem before it reports"
+                     " their completion. Only raise this if the firmware"
+                     " queues instant messages");
+
+        param("Transmission Timeout", m_args.tx_tout)
+        .defaultValue("60.0")
+        .units(Units::Second)
+        .description("Time to wait for completion of a frame handed to the modem");
+
         // Process modem addresses.
         std::string system = getSystemName();
         std::vector<std::string> addrs = ctx.config.options("Evologics Addresses");
@@ -251,7 +277,7 @@ namespace Transports
         }
 
         Memory::clear(m_sock);
-        clearTicket(IMC::UamTxStatus::UTS_CANCELED);
+        clearTickets(IMC::UamTxStatus::UTS_CANCELED);
       }
 
       void
@@ -322,22 +348,93 @@ namespace Transports
           handleSendEnd(msg->value);
       }
 
+      //! Drop all queued and in-flight frames.
+      //! @param[in] reason status to report.
+      void
+      clearTickets(IMC::UamTxStatus::ValueEnum reason)
+      {
+        while (!m_inflight.empty())
+        {
+          sendTxStatus(m_inflight.front(), reason);
+          m_inflight.pop_front();
+        }
+
+        while (!m_queue.empty())
+        {
+          sendTxStatus(m_queue.front(), reason);
+          m_queue.pop_front();
+        }
+      }
+
+      //! Take the oldest in-flight frame matching a completion.
+      //! @param[in] ack true for acknowledged frames, false otherwise.
+      //! @param[in] addr destination modem address or -1 for any.
+      //! @param[out] ticket frame.
+      //! @return true if a frame was found, false otherwise.
+      bool
+      takeInflight(bool ack, int addr, Ticket& ticket)
+      {
+        std::list<Ticket>::iterator itr = m_inflight.begin();
+        for (; itr != m_inflight.end(); ++itr)
+        {
+          if (itr->ack != ack)
+            continue;
+
+          if (addr >= 0 && itr->addr != (unsigned)addr)
+            continue;
+
+          ticket = *itr;
+          m_inflight.erase(itr);
+          m_driver->setBusy(!m_inflight.empty());
+          return true;
+        }
+
+        return false;
+      }
+
+      //! Hand queued frames to the modem while it has room for them,
+      //! so that the next frame goes out as soon as the previous one
+      //! completes.
       void
-      clearTicket(IMC::UamTxStatus::ValueEnum reason, const std::string& error = "")
+      processQueue(void)
       {
-        if (m_ticket != NULL)
+        while (!m_queue.empty() && m_inflight.size() < m_args.max_inflight)
         {
-          sendTxStatus(*m_ticket, reason, error);
-          delete m_ticket;
-          m_ticket = NULL;
+          Ticket& ticket = m_queue.front();
+
+          try
+          {
+            m_driver->sendIM(&ticket.data[0], ticket.data.size(), ticket.addr, ticket.ack);
+          }
+          catch (UnexpectedReply& e)
+          {
+            // Modem refused it: retry on the next completion.
+            debug("frame deferred: %s", e.what());
+            m_driver->setBusy(!m_inflight.empty());
+            return;
+          }
+
+          ticket.tstamp = Clock::get();
+          sendTxStatus(ticket, IMC::UamTxStatus::UTS_IP);
+          m_inflight.push_back(ticket);
+          m_queue.pop_front();
+          m_kalive_counter.reset();
         }
       }
 
+      //! Fail in-flight frames without completion for too long.
       void
-      replaceTicket(const Ticket& ticket)
+      checkTimeouts(void)
       {
-        clearTicket(IMC::UamTxStatus::UTS_CANCELED);
-        m_ticket = new Ticket(ticket);
+        double now = Clock::get();
+        while (!m_inflight.empty() && now - m_inflight.front().tstamp > m_args.tx_tout)
+        {
+          sendTxStatus(m_inflight.front(), IMC::UamTxStatus::UTS_FAILED, DTR("timeout"));
+          m_inflight.pop_front();
+          m_driver->setBusy(!m_inflight.empty());
+        }
+
+        processQueue();
       }
 
       void
@@ -383,35 +480,56 @@ namespace Transports
           return;
         }
 
-        // Fail if busy.
-        if (m_driver->isBusy())
+        if (msg->data.empty())
+        {
+          sendTxStatus(ticket, IMC::UamTxStatus::UTS_FAILED, DTR("empty frame"));
+          return;
+        }
+
+        // Fail if the queue is full.
+        if (m_queue.size() >= m_args.queue_size && m_inflight.size() >= m_args.max_inflight)
         {
           sendTxStatus(ticket, IMC::UamTxStatus::UTS_BUSY);
           return;
         }
 
-        // Replace ticket and transmit.
-        replaceTicket(ticket);
-        sendTxStatus(ticket, IMC::UamTxStatus::UTS_IP);
-        m_driver->sendIM((uint8_t*)&msg->data[0], msg->data.size(), ticket.addr, ticket.ack);
-        m_kalive_counter.reset();
+        ticket.data.assign((const uint8_t*)&msg->data[0], (const uint8_t*)&msg->data[0] + msg->data.size());
+        m_queue.push_back(ticket);
+        processQueue();
       }
 
       void
       handleInstantMessageFailed(const std::string& str)
       {
-        (void)str;
+        int dst = -1;
+        if (std::sscanf(str.c_str(), "FAILEDIM,%d", &dst) != 1)
+          std::sscanf(str.c_str(), "CANCELEDIM,%d", &dst);
+
+        Ticket ticket;
+        bool found = takeInflight(true, dst, ticket) || takeInflight(true, -1, ticket);
+        processQueue();
 
-        m_driver->setBusy(false);
-        clearTicket(IMC::UamTxStatus::UTS_FAILED);
+        if (found)
+          sendTxStatus(ticket, IMC::UamTxStatus::UTS_FAILED);
       }
 
       void
       handleInstantMessageDelivered(const std::string& str)
       {
-        //! Query propagation time.
-        unsigned dst = 0;
-        if (std::sscanf(str.c_str(), "DELIVEREDIM,%u", &dst) == 1)
+        int dst = -1;
+        std::sscanf(str.c_str(), "DELIVEREDIM,%d", &dst);
+
+        Ticket ticket;
+        bool found = takeInflight(true, dst, ticket) || takeInflight(true, -1, ticket);
+
+        // Start the next frame before querying the range: the modem
+        // keeps the last propagation time until it is delivered.
+        processQueue();
+
+        if (!found)
+          return;
+
+        if (dst >= 0)
         {
           try
           {
@@ -420,7 +538,7 @@ namespace Transports
             {
               IMC::UamRxRange range;
               range.sys = lookupSystemName(dst);
-              range.seq = m_ticket->seq;
+              range.seq = ticket.seq;
               range.value = (ptime * m_sound_speed) / 1000000.0;
               dispatch(range);
             }
@@ -429,9 +547,7 @@ namespace Transports
           { }
         }
 
-        // Clear ticket.
-        m_driver->setBusy(false);
-        clearTicket(IMC::UamTxStatus::UTS_DONE);
+        sendTxStatus(ticket, IMC::UamTxStatus::UTS_DONE);
       }
 
       void
@@ -439,14 +555,12 @@ namespace Transports
       {
         (void)str;
 
-        if (m_ticket == NULL)
+        Ticket ticket;
+        if (!takeInflight(false, -1, ticket))
           return;
 
-        if (!m_ticket->ack)
-        {
-          m_driver->setBusy(false);
-          clearTicket(IMC::UamTxStatus::UTS_DONE);
-        }
+        processQueue();
+        sendTxStatus(ticket, IMC::UamTxStatus::UTS_DONE);
       }
 
       void
@@ -512,6 +626,7 @@ namespace Transports
         while (!stopping())
         {
           waitForMessages(1.0);
+          checkTimeouts();
           keepAlive();
         }
       }
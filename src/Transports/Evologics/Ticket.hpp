@@ -31,6 +31,7 @@
 // ISO C++ 98 headers.
 #include <sstream>
 #include <string>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -41,6 +42,15 @@ namespace Transports
   {
     struct Ticket
     {
+      Ticket(void):
+        imc_sid(0),
+        imc_eid(0),
+        seq(0),
+        addr(0),
+        ack(false),
+        tstamp(-1)
+      { }
+
       //! IMC source address.
       uint16_t imc_sid;
       //! IMC source entity.
@@ -51,6 +61,10 @@ namespace Transports
       uint16_t addr;
       //! Wait for ack.
       bool ack;
+      //! Data to transmit.
+      std::vector<uint8_t> data;
+      //! Time of transmission.
+      double tstamp;
     };
   }
 }
@@ -26,11 +26,18 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <sstream>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+#if defined(DUNE_SYS_HAS_LINUX_SENDFILE)
+#  include <sys/sendfile.h>
+#endif
+
 // Local headers.
 #include "Session.hpp"
 
@@ -77,13 +84,24 @@ namespace Transports
       "----------"
     };
 
+    //! Size of file blocks.
+    static const size_t c_block_size = 256 * 1024;
+
     Session::Session(const FileSystem::Path& root, TCPSocket* sock, const Address& local_addr, double timeout):
       m_sock(sock),
       m_local_addr(local_addr),
+      m_sock_xfer(NULL),
       m_data_pasv(false),
-      m_rest_offset(-1),
-      m_timer(timeout)
+      m_rest_offset(0),
+      m_timer(timeout),
+      m_xfer_active(false),
+      m_closed(false)
     {
+      m_xfer.sent = 0;
+      m_xfer.file = NULL;
+      m_xfer.offset = 0;
+      m_xfer.end = 0;
+
       m_root = root;
       m_path = "/";
 
@@ -98,11 +116,25 @@ namespace Transports
       m_sock_data->setSendTimeout(5);
       m_sock_data->bind(0, local_addr);
       m_sock_data->listen(5);
+
+      try
+      {
+        sendReply(220, "DUNE FTP server ready.");
+      }
+      catch (std::exception&)
+      {
+        m_closed = true;
+      }
     }
 
     Session::~Session(void)
     {
+      if (m_xfer.file != NULL)
+        std::fclose(m_xfer.file);
+
+      closeDataConnection();
       closeControlConnection();
+      delete m_sock;
 
       if (m_sock_data != NULL)
         delete m_sock_data;
@@ -119,7 +151,7 @@ namespace Transports
     void
     Session::closeControlConnection(void)
     {
-      if (m_sock == NULL)
+      if (m_closed)
         return;
 
       try
@@ -129,23 +161,19 @@ namespace Transports
       catch (...)
       { }
 
-      delete m_sock;
-      m_sock = NULL;
+      m_closed = true;
     }
 
     void
-    Session::sendFileInfoMLSD(const Path& path, TCPSocket* sock)
+    Session::appendFileInfoMLSD(const DirectoryIndex::Entry& entry, std::string& out)
     {
-      Path::Type type = path.type();
-      int64_t size = 0;
       std::ostringstream os;
 
-      if (type == Path::PT_FILE)
+      if (entry.type == Path::PT_FILE)
       {
-        size = path.size();
-        os << "Type=file;Size=" << size << ";";
+        os << "Type=file;Size=" << entry.size << ";";
       }
-      else if (type == Path::PT_DIRECTORY)
+      else if (entry.type == Path::PT_DIRECTORY)
       {
         os << "Type=dir;";
       }
@@ -154,23 +182,23 @@ namespace Transports
         return;
       }
 
-      os << " " << path.basename() << "\r\n";
-      sock->write(os.str().c_str(), os.str().size());
+      os << " " << entry.name << "\r\n";
+      out += os.str();
     }
 
     void
-    Session::sendFileInfo(const Path& path, TCPSocket* sock, Time::BrokenDown& time_ref)
+    Session::appendFileInfo(const DirectoryIndex::Entry& entry, std::string& out,
+                            Time::BrokenDown& time_ref)
     {
-      Path::Type type = path.type();
-      int64_t size = 0;
+      long long size = 0;
       const char* perm = NULL;
 
-      if (type == Path::PT_FILE)
+      if (entry.type == Path::PT_FILE)
       {
         perm = c_perms[PERM_FILE];
-        size = path.size();
+        size = entry.size;
       }
-      else if (type == Path::PT_DIRECTORY)
+      else if (entry.type == Path::PT_DIRECTORY)
       {
         perm = c_perms[PERM_FOLDER];
       }
@@ -179,9 +207,8 @@ namespace Transports
         perm = c_perms[PERM_UNKNOWN];
       }
 
-      time_t mod_time = path.getLastModifiedTime();
-      Time::BrokenDown time_mod(mod_time);
-      std::string path_name = path.basename().str();
+      Time::BrokenDown time_mod(entry.mtime);
+      const std::string& path_name = entry.name;
 
       m_bfr[0] = '\0';
       if (time_ref.year == time_mod.year)
@@ -208,7 +235,32 @@ namespace Transports
                        path_name.c_str());
                        }
 
-      sock->write(m_bfr, strlen(m_bfr));
+      out += m_bfr;
+    }
+
+    bool
+    Session::listPath(const Path& path, std::vector<DirectoryIndex::Entry>& entries)
+    {
+      entries.clear();
+
+      DirectoryIndex::Entry entry;
+      if (!DirectoryIndex::stat(path, entry))
+        return false;
+
+      // Repeated listings of large log directories are served from
+      // the shared index. Links are listed as the directory they point
+      // to, if any.
+      if (entry.type == Path::PT_DIRECTORY || entry.type == Path::PT_LINK)
+      {
+        if (DirectoryIndex::getShared().list(path, entries))
+          return true;
+
+        if (entry.type == Path::PT_DIRECTORY)
+          return false;
+      }
+
+      entries.push_back(entry);
+      return true;
     }
 
     void
@@ -224,30 +276,158 @@ namespace Transports
       sendReply(200, "OK");
     }
 
-    TCPSocket*
-    Session::openDataConnection(void)
+    void
+    Session::closeDataConnection(void)
     {
-      TCPSocket* sock = NULL;
+      delete m_sock_xfer;
+      m_sock_xfer = NULL;
+    }
 
-      if (m_data_pasv)
+    void
+    Session::acceptData(void)
+    {
+      TCPSocket* sock = m_sock_data->accept();
+
+      // Only one data connection at a time.
+      if (m_sock_xfer != NULL)
       {
-        sock = m_sock_data->accept();
+        delete sock;
+        return;
       }
-      else
+
+      m_sock_xfer = sock;
+      m_sock_xfer->setNoDelay(true);
+      m_sock_xfer->setNonBlocking(true);
+    }
+
+    void
+    Session::startTransfer(void)
+    {
+      m_xfer_active = true;
+
+      if (!m_data_pasv)
       {
-        sock = new TCPSocket;
-        sock->connect(m_data_addr, m_data_port);
-        sock->setKeepAlive(true);
+        closeDataConnection();
+        m_sock_xfer = new TCPSocket;
+        m_sock_xfer->connect(m_data_addr, m_data_port);
+        m_sock_xfer->setKeepAlive(true);
+        m_sock_xfer->setNonBlocking(true);
       }
 
-      return sock;
+      // Passive transfers start when the client connects.
     }
 
     void
-    Session::closeDataConnection(DUNE::Network::TCPSocket* sock)
+    Session::endTransfer(bool success)
+    {
+      if (m_xfer.file != NULL)
+      {
+        std::fclose(m_xfer.file);
+        m_xfer.file = NULL;
+      }
+
+      m_xfer.data.clear();
+      m_xfer.sent = 0;
+      m_xfer_active = false;
+      closeDataConnection();
+      m_timer.reset();
+
+      if (success)
+        sendReply(226, "Closing data connection.");
+      else
+        sendReply(426, "Connection closed; transfer aborted.");
+    }
+
+    bool
+    Session::flushFile(void)
     {
-      sendReply(226, "Closing data connection.");
-      delete sock;
+#if defined(DUNE_SYS_HAS_LINUX_SENDFILE)
+      while (m_xfer.offset < m_xfer.end)
+      {
+        off64_t offset = m_xfer.offset;
+        size_t len = (size_t)std::min((int64_t)c_block_size, m_xfer.end - m_xfer.offset);
+        ssize_t rv = sendfile64(m_sock_xfer->getNative(), fileno(m_xfer.file), &offset, len);
+
+        if (rv < 0)
+        {
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return false;
+          throw NetworkError(DTR("error sending file"), System::Error::getLastMessage());
+        }
+
+        if (rv == 0)
+          throw std::runtime_error(DTR("file is shorter than expected"));
+
+        m_xfer.offset = offset;
+      }
+
+      return true;
+
+#else
+      while (true)
+      {
+        if (m_xfer.sent == m_xfer.data.size())
+        {
+          if (m_xfer.offset >= m_xfer.end)
+            return true;
+
+          size_t len = (size_t)std::min((int64_t)c_block_size, m_xfer.end - m_xfer.offset);
+          m_xfer.data.resize(len);
+
+          if (std::fseek(m_xfer.file, (long)m_xfer.offset, SEEK_SET) != 0)
+            throw std::runtime_error(DTR("failed to read file"));
+
+          size_t rv = std::fread(&m_xfer.data[0], 1, len, m_xfer.file);
+          if (rv == 0)
+            throw std::runtime_error(DTR("file is shorter than expected"));
+
+          m_xfer.data.resize(rv);
+          m_xfer.sent = 0;
+          m_xfer.offset += rv;
+        }
+
+        if (!flushMemory())
+          return false;
+      }
+#endif
+    }
+
+    bool
+    Session::flushMemory(void)
+    {
+      while (m_xfer.sent < m_xfer.data.size())
+      {
+        size_t rv = m_sock_xfer->write(m_xfer.data.data() + m_xfer.sent,
+                                       m_xfer.data.size() - m_xfer.sent);
+        if (rv == 0)
+          return false;
+
+        m_xfer.sent += rv;
+      }
+
+      return true;
+    }
+
+    bool
+    Session::flush(void)
+    {
+      if (!m_xfer_active || m_sock_xfer == NULL)
+        return m_xfer_active;
+
+      try
+      {
+        bool done = (m_xfer.file != NULL) ? flushFile() : flushMemory();
+        if (!done)
+          return true;
+
+        endTransfer(true);
+      }
+      catch (std::runtime_error&)
+      {
+        endTransfer(false);
+      }
+
+      return false;
     }
 
     void
@@ -275,32 +455,21 @@ namespace Transports
       if (String::startsWith(m_root.str(), path.str()))
         path = m_root;
 
-      Path::Type type = path.type();
-      if (type == Path::PT_INVALID)
+      Time::BrokenDown time_ref;
+      m_xfer.data.clear();
+
+      std::vector<DirectoryIndex::Entry> entries;
+      if (!listPath(path, entries))
       {
         sendReply(450, "Requested file action not taken.");
         return;
       }
 
-      sendReply(150, "File status okay; about to open data connection.");
+      for (size_t i = 0; i < entries.size(); ++i)
+        appendFileInfo(entries[i], m_xfer.data, time_ref);
 
-      Time::BrokenDown time_ref;
-      TCPSocket* data = openDataConnection();
-      if (type == Path::PT_FILE)
-      {
-        sendFileInfo(path, data, time_ref);
-      }
-      else
-      {
-        Directory dir(path);
-        const char* entry = NULL;
-        while ((entry = dir.readEntry(Directory::RD_FULL_NAME)))
-        {
-          sendFileInfo(entry, data, time_ref);
-        }
-      }
-
-      closeDataConnection(data);
+      sendReply(150, "File status okay; about to open data connection.");
+      startTransfer();
     }
 
     void
@@ -332,7 +501,7 @@ namespace Transports
 
       if (path.isFile())
       {
-        sendReply(212, String::str("%llu", path.size()));
+        sendReply(213, String::str("%lld", (long long)path.size()));
       }
       else
       {
@@ -344,7 +513,7 @@ namespace Transports
     Session::handleRETR(const std::string& arg)
     {
       int64_t rest_offset = m_rest_offset;
-      m_rest_offset = -1;
+      m_rest_offset = 0;
 
       Path path = getAbsolutePath(arg);
       if (!path.isFile())
@@ -353,24 +522,43 @@ namespace Transports
         return;
       }
 
-      sendReply(150, "File status okay; about to open data connection.");
-
-      TCPSocket* data = openDataConnection();
+      int64_t size = path.size();
+      if (rest_offset > size)
+      {
+        sendReply(554, "Requested action not taken: invalid REST parameter.");
+        return;
+      }
 
-      if (!data->writeFile(path.c_str(), path.size() - 1, rest_offset))
+      std::FILE* file = std::fopen(path.c_str(), "rb");
+      if (file == NULL)
+      {
+        sendReply(450, "Requested file action not taken.");
         return;
+      }
 
-      closeDataConnection(data);
-      m_rest_offset = 0;
+      m_xfer.data.clear();
+      m_xfer.sent = 0;
+      m_xfer.file = file;
+      m_xfer.offset = rest_offset;
+      m_xfer.end = size;
+
+      sendReply(150, "File status okay; about to open data connection.");
+      startTransfer();
     }
 
     void
     Session::handleREST(const std::string& arg)
     {
-      std::istringstream is(arg);
-      is >> m_rest_offset;
+      long long offset = -1;
+      char extra = 0;
+      if (std::sscanf(arg.c_str(), "%lld%c", &offset, &extra) != 1 || offset < 0)
+      {
+        sendReply(501, "Syntax error in parameters or arguments.");
+        return;
+      }
 
-      sendReply(350, "Requested file action pending further information.");
+      m_rest_offset = offset;
+      sendReply(350, String::str("Restarting at %lld. Send RETR to initiate transfer.", offset));
     }
 
     void
@@ -453,8 +641,15 @@ namespace Transports
     Session::handleQUIT(const std::string& arg)
     {
       (void)arg;
-      sendReply(221, "Service closing control connection");
-      stop();
+      closeControlConnection();
+    }
+
+    void
+    Session::handleFEAT(const std::string& arg)
+    {
+      (void)arg;
+      std::string reply = "211-Features:\r\n MLSD\r\n REST STREAM\r\n SIZE\r\n211 End\r\n";
+      m_sock->write(reply.c_str(), reply.size());
     }
 
     void
@@ -472,32 +667,20 @@ namespace Transports
       if (String::startsWith(m_root.str(), path.str()))
         path = m_root;
 
-      Path::Type type = path.type();
-      if (type == Path::PT_INVALID)
+      m_xfer.data.clear();
+
+      std::vector<DirectoryIndex::Entry> entries;
+      if (!listPath(path, entries))
       {
         sendReply(450, "Requested file action not taken.");
         return;
       }
 
-      sendReply(150, "File status okay; about to open data connection.");
-
-      Time::BrokenDown time_ref;
-      TCPSocket* data = openDataConnection();
-      if (type == Path::PT_FILE)
-      {
-        sendFileInfoMLSD(path, data);
-      }
-      else
-      {
-        Directory dir(path);
-        const char* entry = NULL;
-        while ((entry = dir.readEntry(Directory::RD_FULL_NAME)))
-        {
-          sendFileInfoMLSD(entry, data);
-        }
-      }
+      for (size_t i = 0; i < entries.size(); ++i)
+        appendFileInfoMLSD(entries[i], m_xfer.data);
 
-      closeDataConnection(data);
+      sendReply(150, "File status okay; about to open data connection.");
+      startTransfer();
     }
 
     void
@@ -574,52 +757,54 @@ namespace Transports
         handleQUIT(arg);
       else if (cmd == "MLSD")
         handleMLSD(arg);
+      else if (cmd == "FEAT")
+        handleFEAT(arg);
       else
         handleNotImplemented(arg);
     }
 
     void
-    Session::run(void)
+    Session::handleInput(void)
     {
-      sendReply(220, "DUNE FTP server ready.");
-
-      Poll poll;
-      poll.add(*m_sock);
-      poll.add(*m_sock_data);
+      if (m_closed)
+        return;
 
-      while (!isStopping())
+      try
       {
-        if (m_timer.overflow())
-          break;
+        int rv = m_sock->read(m_bfr, sizeof(m_bfr));
+        if (rv <= 0)
+          throw std::runtime_error(DTR("connection closed"));
 
-        try
+        for (int i = 0; i < rv && !m_closed; ++i)
         {
-          if (!poll.poll(1.0))
-            continue;
-
-          if (!poll.wasTriggered(*m_sock))
-            continue;
-
-          int rv = m_sock->read(m_bfr, sizeof(m_bfr));
-          if (rv <= 0)
-            break;
-
-          for (int i = 0; i < rv; ++i)
+          if (m_parser.parse(m_bfr[i]))
           {
-            if (m_parser.parse(m_bfr[i]))
+            m_timer.reset();
+
+            // Commands must wait for the current transfer.
+            if (m_xfer_active && m_parser.getCode() != "NOOP")
             {
-              handleCommand(m_parser.getCode(), m_parser.getParameters());
-              m_timer.reset();
+              sendReply(425, "Transfer in progress.");
+              continue;
             }
+
+            handleCommand(m_parser.getCode(), m_parser.getParameters());
           }
         }
-        catch (...)
+      }
+      catch (std::exception&)
+      {
+        if (m_xfer.file != NULL)
         {
-          break;
+          std::fclose(m_xfer.file);
+          m_xfer.file = NULL;
         }
-      }
 
-      closeControlConnection();
+        m_xfer_active = false;
+        closeDataConnection();
+
+        m_closed = true;
+      }
     }
   }
 }
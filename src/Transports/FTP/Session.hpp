@@ -29,8 +29,11 @@
 #define TRANSPORTS_FTP_SESSION_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <cstdio>
 #include <map>
 #include <queue>
+#include <string>
+#include <vector>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -42,7 +45,13 @@ namespace Transports
 {
   namespace FTP
   {
-    class Session: public DUNE::Concurrency::Thread
+    //! FTP session driven by the event loop of the task. Commands
+    //! are handled as they arrive on the control connection and data
+    //! transfers are written to a non-blocking data connection as
+    //! the client accepts them, so that many sessions share one
+    //! thread. File contents are sent with sendfile() where
+    //! available.
+    class Session
     {
     public:
       Session(const DUNE::FileSystem::Path& root,
@@ -52,13 +61,79 @@ namespace Transports
 
       ~Session(void);
 
+      //! Get the control socket.
+      //! @return control socket.
+      DUNE::Network::TCPSocket*
+      getControlSocket(void)
+      {
+        return m_sock;
+      }
+
+      //! Get the socket listening for passive data connections.
+      //! @return passive data socket.
+      DUNE::Network::TCPSocket*
+      getPassiveSocket(void)
+      {
+        return m_sock_data;
+      }
+
+      //! Read and handle commands from the control connection.
+      void
+      handleInput(void);
+
+      //! Accept a passive data connection.
+      void
+      acceptData(void);
+
+      //! Continue the current data transfer.
+      //! @return true if the transfer is still pending.
+      bool
+      flush(void);
+
+      //! Test if a transfer is in progress.
+      //! @return true if a transfer is in progress.
+      bool
+      isTransferring(void) const
+      {
+        return m_xfer_active;
+      }
+
+      //! Test if the session ended (QUIT, closed connection or idle
+      //! timeout).
+      //! @return true if the session can be destroyed.
+      bool
+      isDone(void)
+      {
+        if (m_closed)
+          return true;
+
+        return !m_xfer_active && m_timer.overflow();
+      }
+
     private:
+      //! Data transfer, either memory (listings) or a file region.
+      struct Transfer
+      {
+        //! Memory data.
+        std::string data;
+        //! Offset of the first unsent byte of memory data.
+        size_t sent;
+        //! File (NULL for memory data).
+        std::FILE* file;
+        //! Offset of the next file byte.
+        int64_t offset;
+        //! Offset after the last file byte.
+        int64_t end;
+      };
+
       //! Control socket.
       DUNE::Network::TCPSocket* m_sock;
       //! Address of the local interface.
       const DUNE::Network::Address m_local_addr;
-      //! Data socket.
+      //! Listening socket for passive data connections.
       DUNE::Network::TCPSocket* m_sock_data;
+      //! Connected data socket.
+      DUNE::Network::TCPSocket* m_sock_xfer;
       //! Root folder of the FTP server.
       DUNE::FileSystem::Path m_root;
       //! Current working folder (relative to root folder).
@@ -77,6 +152,12 @@ namespace Transports
       int64_t m_rest_offset;
       //! Idle timer.
       DUNE::Time::Counter<double> m_timer;
+      //! Current data transfer.
+      Transfer m_xfer;
+      //! True if a transfer was requested and is not finished.
+      bool m_xfer_active;
+      //! True if the control connection was closed.
+      bool m_closed;
 
       DUNE::FileSystem::Path
       getAbsolutePath(const std::string& path);
@@ -88,19 +169,45 @@ namespace Transports
       sendOK(void);
 
       void
-      sendFileInfo(const DUNE::FileSystem::Path& path, DUNE::Network::TCPSocket* sock, DUNE::Time::BrokenDown& time_ref);
+      appendFileInfo(const DUNE::FileSystem::DirectoryIndex::Entry& entry, std::string& out,
+                     DUNE::Time::BrokenDown& time_ref);
 
       void
-      sendFileInfoMLSD(const DUNE::FileSystem::Path& path, DUNE::Network::TCPSocket* sock);
+      appendFileInfoMLSD(const DUNE::FileSystem::DirectoryIndex::Entry& entry, std::string& out);
+
+      //! List a path: the file itself or the entries of a directory.
+      //! @param[in] path path.
+      //! @param[out] entries entries.
+      //! @return false if the path does not exist.
+      bool
+      listPath(const DUNE::FileSystem::Path& path,
+               std::vector<DUNE::FileSystem::DirectoryIndex::Entry>& entries);
 
       void
       closeControlConnection(void);
 
-      DUNE::Network::TCPSocket*
-      openDataConnection(void);
+      void
+      closeDataConnection(void);
 
+      //! Start a data transfer as soon as the data connection is
+      //! established.
       void
-      closeDataConnection(DUNE::Network::TCPSocket* sock);
+      startTransfer(void);
+
+      //! End the current data transfer.
+      //! @param[in] success true if all data was sent.
+      void
+      endTransfer(bool success);
+
+      //! Write file data to the data connection.
+      //! @return true if all data was sent.
+      bool
+      flushFile(void);
+
+      //! Write memory data to the data connection.
+      //! @return true if all data was sent.
+      bool
+      flushMemory(void);
 
       void
       handleUSER(const std::string& arg);
@@ -108,6 +215,9 @@ namespace Transports
       void
       handleNOOP(const std::string& arg);
 
+      void
+      handleFEAT(const std::string& arg);
+
       void
       handleMLSD(const std::string& arg);
 
@@ -159,11 +269,12 @@ namespace Transports
       void
       handleCommand(const std::string& cmd, const std::string& arg);
 
-      void
-      handleCommandSocket(void);
+      //! Non-copyable.
+      Session(const Session&);
 
-      void
-      run(void);
+      //! Non-assignable.
+      Session&
+      operator=(const Session&);
     };
   }
 }
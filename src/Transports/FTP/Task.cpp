@@ -42,6 +42,9 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
+    //! Poll period while data transfers are pending (s).
+    static const double c_output_period = 0.01;
+
     //! Task arguments
     struct Arguments
     {
@@ -65,8 +68,6 @@ namespace Transports
       Poll m_poll;
       //! List of busy sessions.
       std::list<Session*> m_busy_list;
-      //! Concurrency lock for list of busy sessions.
-      Mutex m_busy_list_lock;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx)
@@ -156,7 +157,8 @@ namespace Transports
         {
           Session* session = m_busy_list.front();
           m_busy_list.pop_front();
-          session->stopAndJoin();
+          m_poll.remove(*session->getControlSocket());
+          m_poll.remove(*session->getPassiveSocket());
           delete session;
         }
 
@@ -179,7 +181,8 @@ namespace Transports
           debug("accepted connection from '%s'", addr.c_str());
           Session* handler = new Session(m_ctx.dir_log, client, local_addr,
                                          m_args.session_tout);
-          handler->start();
+          m_poll.add(*handler->getControlSocket());
+          m_poll.add(*handler->getPassiveSocket());
           m_busy_list.push_back(handler);
         }
         catch (std::runtime_error& e)
@@ -194,10 +197,11 @@ namespace Transports
         std::list<Session*>::iterator itr = m_busy_list.begin();
         while (itr != m_busy_list.end())
         {
-          if ((*itr)->isDead())
+          if ((*itr)->isDone())
           {
             debug("cleaning client");
-            (*itr)->stopAndJoin();
+            m_poll.remove(*(*itr)->getControlSocket());
+            m_poll.remove(*(*itr)->getPassiveSocket());
             delete *itr;
             itr = m_busy_list.erase(itr);
           }
@@ -208,23 +212,66 @@ namespace Transports
         }
       }
 
+      //! Handle session I/O and continue pending transfers.
+      //! @return true if at least one transfer is pending.
+      bool
+      serviceSessions(bool triggered)
+      {
+        bool pending = false;
+
+        std::list<Session*>::iterator itr = m_busy_list.begin();
+        for (; itr != m_busy_list.end(); ++itr)
+        {
+          Session* session = *itr;
+
+          if (triggered)
+          {
+            if (m_poll.wasTriggered(*session->getControlSocket()))
+              session->handleInput();
+
+            if (m_poll.wasTriggered(*session->getPassiveSocket()))
+            {
+              try
+              {
+                session->acceptData();
+              }
+              catch (std::runtime_error& e)
+              {
+                err(DTR("error accepting data connection: %s"), e.what());
+              }
+            }
+          }
+
+          if (session->flush())
+            pending = true;
+        }
+
+        return pending;
+      }
+
       void
       onMain(void)
       {
+        bool pending = false;
+
         while (!stopping())
         {
           consumeMessages();
 
-          if (!m_poll.poll(1.0))
-            continue;
+          // Transfers only wait for writability, poll them frequently.
+          bool triggered = m_poll.poll(pending ? c_output_period : 1.0);
 
-          std::list<TCPSocket*>::iterator itr = m_sockets.begin();
-          for (; itr != m_sockets.end(); ++itr)
+          if (triggered)
           {
-            if (m_poll.wasTriggered(*(*itr)))
-              acceptNewClient(*itr, (*itr)->getBoundAddress());
+            std::list<TCPSocket*>::iterator itr = m_sockets.begin();
+            for (; itr != m_sockets.end(); ++itr)
+            {
+              if (m_poll.wasTriggered(*(*itr)))
+                acceptNewClient(*itr, (*itr)->getBoundAddress());
+            }
           }
 
+          pending = serviceSessions(triggered);
           cleanBusyList();
         }
       }
@@ -0,0 +1,189 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_FLIGHT_RECORDER_DUMPER_HPP_INCLUDED_
+#define TRANSPORTS_FLIGHT_RECORDER_DUMPER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace FlightRecorder
+  {
+    using DUNE_NAMESPACES;
+
+    //! Recorded traffic waiting to be written.
+    struct Dump
+    {
+      //! Log directory.
+      Path dir;
+      //! Reason of the dump.
+      std::string reason;
+      //! Packets written before the recorded traffic.
+      Utils::ByteBuffer header;
+      //! Recorded packets.
+      std::vector<char> data;
+      //! Number of bytes used in the data buffer.
+      unsigned size;
+      //! Error message, empty on success.
+      std::string error;
+    };
+
+    //! Writes dumps of the ring to disk in a separate thread, so the
+    //! task keeps recording while the log is written. There is a
+    //! single dump buffer, allocated once with the capacity of the
+    //! ring, and only one dump can be in progress.
+    class Dumper: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity capacity of the ring in bytes.
+      Dumper(unsigned capacity):
+        m_jobs(1),
+        m_done(1),
+        m_busy(false)
+      {
+        m_dump.data.resize(capacity);
+        m_dump.size = 0;
+      }
+
+      //! Destructor.
+      ~Dumper(void)
+      {
+        if (isCreated())
+        {
+          stop();
+          m_jobs.wakeup();
+          join();
+        }
+      }
+
+      //! Get the dump buffer.
+      //! @return dump or NULL if a dump is in progress.
+      Dump*
+      acquire(void)
+      {
+        if (m_busy)
+          return NULL;
+
+        m_busy = true;
+        m_dump.header.setSize(0);
+        m_dump.size = 0;
+        m_dump.error.clear();
+        return &m_dump;
+      }
+
+      //! Write a dump.
+      //! @param[in] dump dump obtained with acquire().
+      void
+      submit(Dump* dump)
+      {
+        m_jobs.push(dump);
+      }
+
+      //! Retrieve a written dump, which can be acquired again.
+      //! @return dump or NULL if no dump was written since the last
+      //! call.
+      Dump*
+      poll(void)
+      {
+        Dump* dump = NULL;
+        if (!m_done.pop(dump))
+          return NULL;
+
+        m_busy = false;
+        return dump;
+      }
+
+    private:
+      //! Dump buffer.
+      Dump m_dump;
+      //! Dumps to write.
+      Concurrency::MPSCQueue<Dump*> m_jobs;
+      //! Written dumps.
+      Concurrency::MPSCQueue<Dump*> m_done;
+      //! True if the dump buffer is in use (only used by the task).
+      bool m_busy;
+
+      //! Create the log directory and write its files.
+      //! @param[in] dump dump.
+      void
+      write(Dump* dump)
+      {
+        dump->dir.create();
+
+        Path imc_path = dump->dir / "IMC.xml.gz";
+        std::ofstream imc_ofs(imc_path.c_str(), std::ios::binary);
+        imc_ofs.write((const char*)Blob::getData(), Blob::getSize());
+        imc_ofs.close();
+
+        Path lsf_path = dump->dir / "Data.lsf";
+        std::ofstream lsf_ofs(lsf_path.c_str(), std::ios::binary);
+        lsf_ofs.write(dump->header.getBufferSigned(), dump->header.getSize());
+        lsf_ofs.write(&dump->data[0], dump->size);
+        lsf_ofs.close();
+
+        if (imc_ofs.fail() || lsf_ofs.fail())
+          throw std::runtime_error(String::str(DTR("failed to write to '%s'"), dump->dir.c_str()));
+      }
+
+      void
+      run(void)
+      {
+        Dump* dump = NULL;
+
+        while (!isStopping())
+        {
+          if (!m_jobs.pop(dump))
+          {
+            m_jobs.waitForItems(1.0);
+            continue;
+          }
+
+          try
+          {
+            write(dump);
+          }
+          catch (std::exception& e)
+          {
+            dump->error = e.what();
+          }
+
+          m_done.push(dump);
+        }
+      }
+    };
+  }
+}
+
+#endif
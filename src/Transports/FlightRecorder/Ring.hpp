@@ -0,0 +1,259 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_FLIGHT_RECORDER_RING_HPP_INCLUDED_
+#define TRANSPORTS_FLIGHT_RECORDER_RING_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace FlightRecorder
+  {
+    using DUNE_NAMESPACES;
+
+    //! Ring of serialized packets in a buffer allocated once. Packets
+    //! are stored contiguously in the order they were pushed and the
+    //! oldest packets are overwritten when the buffer is full. Packets
+    //! never wrap around the end of the buffer: when a packet does not
+    //! fit in the space left at the end it is stored at the beginning
+    //! and the end of the stored data is remembered.
+    class Ring
+    {
+    public:
+      //! Constructor.
+      //! @param[in] capacity size of the buffer in bytes.
+      Ring(unsigned capacity):
+        m_data(capacity),
+        m_begin(0),
+        m_end(0),
+        m_limit(0),
+        m_wrapped(false),
+        m_count(0)
+      { }
+
+      //! Append a message, overwriting the oldest packets if needed.
+      //! Messages shared by the bus keep their serialized form, so
+      //! this is usually a copy.
+      //! @param[in] msg message.
+      //! @return true if the message was stored, false if it does
+      //! not fit in the buffer.
+      bool
+      push(const IMC::Message* msg)
+      {
+        unsigned size = msg->getSerializationSize();
+        if (!reserve(size))
+          return false;
+
+        m_end += IMC::Packet::serialize(msg, (uint8_t*)&m_data[m_end], size);
+        ++m_count;
+        return true;
+      }
+
+      //! Copy the stored packets, oldest first.
+      //! @param[out] dst destination buffer, at least as large as the
+      //! capacity of the ring.
+      //! @param[in] since time stamp of the oldest packet to copy.
+      //! @return number of bytes copied.
+      unsigned
+      copy(char* dst, double since) const
+      {
+        unsigned n = 0;
+
+        if (m_wrapped)
+        {
+          n += copy(dst, m_begin, m_limit, since);
+          n += copy(dst + n, 0, m_end, since);
+        }
+        else
+        {
+          n += copy(dst, m_begin, m_end, since);
+        }
+
+        return n;
+      }
+
+      //! Get the number of stored packets.
+      //! @return number of packets.
+      unsigned
+      getCount(void) const
+      {
+        return m_count;
+      }
+
+      //! Get the number of bytes used by stored packets.
+      //! @return number of bytes.
+      unsigned
+      getSize(void) const
+      {
+        if (m_wrapped)
+          return (m_limit - m_begin) + m_end;
+
+        return m_end - m_begin;
+      }
+
+      //! Get the size of the buffer.
+      //! @return size in bytes.
+      unsigned
+      getCapacity(void) const
+      {
+        return m_data.size();
+      }
+
+      //! Get the time stamp of the oldest packet.
+      //! @return time stamp or negative if the ring is empty.
+      double
+      getOldest(void) const
+      {
+        if (m_count == 0)
+          return -1;
+
+        IMC::Header hdr;
+        IMC::Packet::deserializeHeader(hdr, (const uint8_t*)&m_data[m_begin], DUNE_IMC_CONST_HEADER_SIZE);
+        return hdr.timestamp;
+      }
+
+    private:
+      //! Buffer.
+      std::vector<char> m_data;
+      //! Offset of the oldest packet.
+      unsigned m_begin;
+      //! Offset past the newest packet.
+      unsigned m_end;
+      //! Offset past the last packet before the end of the buffer,
+      //! when packets continue at the beginning.
+      unsigned m_limit;
+      //! True if packets continue at the beginning of the buffer.
+      bool m_wrapped;
+      //! Number of stored packets.
+      unsigned m_count;
+
+      //! Get the size of the packet at a given offset.
+      //! @param[in] offset offset of the packet.
+      //! @param[out] timestamp time stamp of the packet.
+      //! @return size of the packet.
+      unsigned
+      getPacket(unsigned offset, double& timestamp) const
+      {
+        IMC::Header hdr;
+        IMC::Packet::deserializeHeader(hdr, (const uint8_t*)&m_data[offset], DUNE_IMC_CONST_HEADER_SIZE);
+        timestamp = hdr.timestamp;
+        return DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+      }
+
+      //! Discard the oldest packet.
+      void
+      evict(void)
+      {
+        double timestamp = 0;
+        m_begin += getPacket(m_begin, timestamp);
+        --m_count;
+
+        if (m_wrapped && m_begin == m_limit)
+        {
+          m_begin = 0;
+          m_wrapped = false;
+        }
+        else if (!m_wrapped && m_begin == m_end)
+        {
+          m_begin = 0;
+          m_end = 0;
+        }
+      }
+
+      //! Make room for a packet at the end of the stored data.
+      //! @param[in] size size of the packet.
+      //! @return true if there is room, false if the packet is larger
+      //! than the buffer.
+      bool
+      reserve(unsigned size)
+      {
+        if (size > m_data.size())
+          return false;
+
+        while (true)
+        {
+          if (!m_wrapped)
+          {
+            if (m_end + size <= m_data.size())
+              return true;
+
+            if (m_count == 0)
+            {
+              m_begin = 0;
+              m_end = 0;
+              return true;
+            }
+
+            // Continue at the beginning of the buffer.
+            m_limit = m_end;
+            m_end = 0;
+            m_wrapped = true;
+          }
+
+          if (m_end + size <= m_begin)
+            return true;
+
+          evict();
+        }
+      }
+
+      //! Copy the packets of a contiguous range.
+      //! @param[out] dst destination buffer.
+      //! @param[in] begin offset of the first packet.
+      //! @param[in] end offset past the last packet.
+      //! @param[in] since time stamp of the oldest packet to copy.
+      //! @return number of bytes copied.
+      unsigned
+      copy(char* dst, unsigned begin, unsigned end, double since) const
+      {
+        // Skip packets older than requested.
+        while (begin < end)
+        {
+          double timestamp = 0;
+          unsigned size = getPacket(begin, timestamp);
+          if (timestamp >= since)
+            break;
+          begin += size;
+        }
+
+        if (begin >= end)
+          return 0;
+
+        std::memcpy(dst, &m_data[begin], end - begin);
+        return end - begin;
+      }
+    };
+  }
+}
+
+#endif
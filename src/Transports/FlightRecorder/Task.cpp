@@ -0,0 +1,348 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Dumper.hpp"
+#include "Ring.hpp"
+
+namespace Transports
+{
+  //! Keeps the most recent bus traffic in memory and writes it to a
+  //! log after an incident.
+  //!
+  //! All messages are stored as serialized packets in a ring
+  //! allocated once ('Buffer Size'), overwriting the oldest packets.
+  //! Messages shared by the bus keep their serialized form, so
+  //! recording is a copy. The last 'Duration' seconds of traffic are
+  //! written to a new log directory on Abort, when a local entity
+  //! enters an error or failure state, or when requested with
+  //! FlightRecorderControl. Logs are written by a separate thread
+  //! while recording goes on.
+  namespace FlightRecorder
+  {
+    using DUNE_NAMESPACES;
+
+    //! Bytes per Kibibyte.
+    static const unsigned c_bytes_per_kib = 1024U;
+
+    struct Arguments
+    {
+      //! Amount of traffic written on a dump.
+      double duration;
+      //! Size of the ring.
+      unsigned buffer_size;
+      //! Dump on Abort.
+      bool trigger_abort;
+      //! Dump on entity errors.
+      bool trigger_errors;
+      //! Minimum time between automatic dumps.
+      double min_interval;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Recorded packets.
+      Ring* m_ring;
+      //! Log writer.
+      Dumper* m_dumper;
+      //! Last state of local entities.
+      std::map<unsigned, unsigned> m_states;
+      //! Time of the last automatic dump.
+      double m_last_dump;
+      //! Requester of the dump in progress, if any.
+      uint16_t m_requester;
+      //! Entity of the requester of the dump in progress.
+      uint8_t m_requester_ent;
+      //! Name of the log being written.
+      std::string m_log;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_ring(NULL),
+        m_dumper(NULL),
+        m_last_dump(-1),
+        m_requester(DUNE_IMC_CONST_NULL_ID),
+        m_requester_ent(DUNE_IMC_CONST_UNK_EID)
+      {
+        param("Duration", m_args.duration)
+        .defaultValue("60")
+        .minimumValue("1")
+        .units(Units::Second)
+        .description("Amount of recorded traffic written on a dump,"
+                     " limited by the size of the buffer");
+
+        param("Buffer Size", m_args.buffer_size)
+        .defaultValue("8192")
+        .minimumValue("128")
+        .units(Units::Kibibyte)
+        .description("Size of the buffer holding recorded packets."
+                     " The same amount is allocated for dumps");
+
+        param("Dump on Abort", m_args.trigger_abort)
+        .defaultValue("true")
+        .description("Write the recorded traffic when an Abort is seen");
+
+        param("Dump on Entity Errors", m_args.trigger_errors)
+        .defaultValue("true")
+        .description("Write the recorded traffic when a local entity"
+                     " enters an error or failure state");
+
+        param("Minimum Interval", m_args.min_interval)
+        .defaultValue("30")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Minimum time between dumps triggered by Abort or"
+                     " entity errors. Requested dumps are not limited");
+
+        std::vector<uint32_t> ids;
+        IMC::Factory::getIds(ids);
+        bind(this, ids);
+      }
+
+      ~Task(void)
+      {
+        onResourceRelease();
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_ring = new Ring(m_args.buffer_size * c_bytes_per_kib);
+        m_dumper = new Dumper(m_args.buffer_size * c_bytes_per_kib);
+        m_dumper->start();
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        Memory::clear(m_dumper);
+        Memory::clear(m_ring);
+      }
+
+      //! Report the state of a dump.
+      //! @param[in] op operation (FRC_*).
+      //! @param[in] reason reason of the dump or error message.
+      //! @param[in] dst destination.
+      //! @param[in] dst_ent destination entity.
+      void
+      sendState(uint8_t op, const std::string& reason, uint16_t dst, uint8_t dst_ent)
+      {
+        IMC::FlightRecorderControl msg;
+        msg.op = op;
+        msg.reason = reason;
+        msg.log = m_log;
+        msg.setDestination(dst);
+        msg.setDestinationEntity(dst_ent);
+        dispatch(msg);
+      }
+
+      //! Write the recorded traffic to a new log.
+      //! @param[in] reason reason of the dump.
+      //! @param[in] requester requester of the dump, or NULL.
+      void
+      dump(const std::string& reason, const IMC::Message* requester = NULL)
+      {
+        uint16_t dst = requester ? requester->getSource() : DUNE_IMC_CONST_NULL_ID;
+        uint8_t dst_ent = requester ? requester->getSourceEntity() : DUNE_IMC_CONST_UNK_EID;
+
+        Dump* d = m_dumper->acquire();
+        if (d == NULL)
+        {
+          debug("dump in progress, ignoring: %s", reason.c_str());
+          if (requester != NULL)
+            sendState(IMC::FlightRecorderControl::FRC_DUMP_FAILED, DTR("dump in progress"), dst, dst_ent);
+          return;
+        }
+
+        double now = Clock::getSinceEpoch();
+        d->dir = m_ctx.dir_log
+        / Time::Format::getDateSafe(now)
+        / Time::Format::getTimeSafe(now) + "_flight_recorder";
+        d->reason = reason;
+
+        // Entity names, as in regular logs.
+        std::vector<EntityDataBase::Entity*> devs;
+        m_ctx.entities.contents(devs);
+        Utils::ByteBuffer packet;
+        for (unsigned i = 0; i < devs.size(); ++i)
+        {
+          IMC::EntityInfo info;
+          info.setTimeStamp(now);
+          info.setSource(getSystemId());
+          info.id = devs[i]->id;
+          info.label = devs[i]->label;
+          info.component = devs[i]->task_name;
+          IMC::Packet::serialize(&info, packet);
+          d->header.append(packet.getBuffer(), packet.getSize());
+        }
+
+        d->size = m_ring->copy(&d->data[0], now - m_args.duration);
+        m_dumper->submit(d);
+
+        m_log = m_ctx.dir_log.suffix(d->dir);
+        m_requester = dst;
+        m_requester_ent = dst_ent;
+
+        war(DTR("dumping %u bytes of recorded traffic to '%s': %s"),
+            d->size, m_log.c_str(), reason.c_str());
+        sendState(IMC::FlightRecorderControl::FRC_DUMP_STARTED, reason, dst, dst_ent);
+      }
+
+      //! Dump after an incident, unless a dump was made recently.
+      //! @param[in] reason reason of the dump.
+      void
+      trigger(const std::string& reason)
+      {
+        double now = Clock::get();
+        if (m_last_dump >= 0 && now - m_last_dump < m_args.min_interval)
+          return;
+
+        m_last_dump = now;
+        dump(reason);
+      }
+
+      //! Get the label of a local entity.
+      //! @param[in] id entity id.
+      //! @return label, or the id if the entity is unknown.
+      std::string
+      getLabel(unsigned id)
+      {
+        try
+        {
+          return resolveEntity(id);
+        }
+        catch (std::runtime_error&)
+        {
+          return String::str(id);
+        }
+      }
+
+      //! Check if a message is an incident.
+      //! @param[in] msg message.
+      void
+      inspect(const IMC::Message* msg)
+      {
+        switch (msg->getId())
+        {
+          case DUNE_IMC_ABORT:
+            if (m_args.trigger_abort)
+              trigger(DTR("abort"));
+            break;
+
+          case DUNE_IMC_ENTITYSTATE:
+            if (m_args.trigger_errors && msg->getSource() == getSystemId())
+            {
+              const IMC::EntityState* state = static_cast<const IMC::EntityState*>(msg);
+              bool error = (state->state == IMC::EntityState::ESTA_ERROR
+                            || state->state == IMC::EntityState::ESTA_FAILURE);
+
+              std::map<unsigned, unsigned>::iterator itr = m_states.find(msg->getSourceEntity());
+              bool was_error = (itr != m_states.end()
+                                && (itr->second == IMC::EntityState::ESTA_ERROR
+                                    || itr->second == IMC::EntityState::ESTA_FAILURE));
+              m_states[msg->getSourceEntity()] = state->state;
+
+              if (error && !was_error)
+                trigger(String::str(DTR("entity error: %s"), getLabel(msg->getSourceEntity()).c_str()));
+            }
+            break;
+
+          case DUNE_IMC_FLIGHTRECORDERCONTROL:
+            {
+              const IMC::FlightRecorderControl* ctl = static_cast<const IMC::FlightRecorderControl*>(msg);
+              if (ctl->op == IMC::FlightRecorderControl::FRC_REQUEST_DUMP
+                  && ctl->getDestination() == getSystemId())
+              {
+                dump(ctl->reason.empty() ? DTR("requested") : ctl->reason, ctl);
+              }
+            }
+            break;
+        }
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        if (m_ring == NULL)
+          return;
+
+        m_ring->push(msg);
+        inspect(msg);
+      }
+
+      //! Report written dumps.
+      void
+      checkDumper(void)
+      {
+        Dump* d = m_dumper->poll();
+        if (d == NULL)
+          return;
+
+        if (d->error.empty())
+        {
+          inf(DTR("recorded traffic written to '%s'"), m_log.c_str());
+          sendState(IMC::FlightRecorderControl::FRC_DUMP_COMPLETED, d->reason,
+                    m_requester, m_requester_ent);
+        }
+        else
+        {
+          err(DTR("failed to write recorded traffic: %s"), d->error.c_str());
+          sendState(IMC::FlightRecorderControl::FRC_DUMP_FAILED, d->error,
+                    m_requester, m_requester_ent);
+        }
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(1.0);
+          checkDumper();
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
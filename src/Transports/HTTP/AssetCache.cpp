@@ -0,0 +1,171 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "AssetCache.hpp"
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    //! Compressed contents must save at least this fraction of the size.
+    static const double c_min_saving = 0.1;
+
+    AssetCache::AssetCache(size_t max_file, size_t max_total):
+      m_max_file(max_file),
+      m_max_total(max_total),
+      m_size(0)
+    { }
+
+    const AssetCache::Asset*
+    AssetCache::get(const Path& path)
+    {
+      int64_t size = path.size();
+      std::time_t mtime = path.getLastModifiedTime();
+
+      Table::iterator itr = m_table.find(path.str());
+      if (itr != m_table.end())
+      {
+        if (itr->second.mtime == mtime && itr->second.size == size)
+          return &itr->second;
+
+        erase(itr);
+      }
+
+      if (size < 0 || (uint64_t)size > m_max_file || path.isDirectory())
+        return NULL;
+
+      Asset asset;
+      asset.mtime = mtime;
+      asset.size = size;
+      if (!load(path, asset))
+        return NULL;
+
+      size_t used = asset.data.size() + asset.gzip.size();
+      if (m_size + used > m_max_total)
+        return NULL;
+
+      m_size += used;
+      itr = m_table.insert(std::make_pair(path.str(), Asset())).first;
+      itr->second.mtime = asset.mtime;
+      itr->second.size = asset.size;
+      itr->second.type.swap(asset.type);
+      itr->second.etag.swap(asset.etag);
+      itr->second.data.swap(asset.data);
+      itr->second.gzip.swap(asset.gzip);
+      return &itr->second;
+    }
+
+    void
+    AssetCache::clear(void)
+    {
+      m_table.clear();
+      m_size = 0;
+    }
+
+    std::string
+    AssetCache::getContentType(const std::string& ext)
+    {
+      if (ext == "html")
+        return "text/html";
+      if (ext == "css")
+        return "text/css";
+      if (ext == "js")
+        return "text/javascript";
+      if (ext == "json")
+        return "application/json";
+      if (ext == "xml")
+        return "text/xml";
+      if (ext == "svg")
+        return "image/svg+xml";
+      if (ext == "png")
+        return "image/png";
+      if (ext == "jpg")
+        return "image/jpeg";
+      if (ext == "bmp")
+        return "image/bmp";
+      return "";
+    }
+
+    void
+    AssetCache::erase(Table::iterator itr)
+    {
+      m_size -= itr->second.data.size() + itr->second.gzip.size();
+      m_table.erase(itr);
+    }
+
+    bool
+    AssetCache::load(const Path& path, Asset& asset)
+    {
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+      if (!ifs)
+        return false;
+
+      asset.data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+      if (ifs.bad() || (int64_t)asset.data.size() != asset.size)
+        return false;
+
+      asset.type = getContentType(path.extension());
+
+      uint8_t digest[16];
+      Algorithms::MD5::compute((const uint8_t*)asset.data.data(), asset.data.size(), digest);
+
+      char etag[35];
+      etag[0] = '"';
+      for (unsigned i = 0; i < sizeof(digest); ++i)
+        std::sprintf(etag + 1 + i * 2, "%02x", digest[i]);
+      etag[33] = '"';
+      etag[34] = 0;
+      asset.etag = etag;
+
+      // Images are already compressed.
+      bool text = String::startsWith(asset.type, "text/")
+      || asset.type == "application/json"
+      || asset.type == "image/svg+xml";
+
+      if (text && !asset.data.empty())
+      {
+        ByteBuffer bfr;
+        GzipCompressor cmp;
+        cmp.compress(bfr, (char*)asset.data.data(), asset.data.size());
+
+        if (bfr.getSize() < asset.data.size() * (1.0 - c_min_saving))
+          asset.gzip.assign(bfr.getBufferSigned(), bfr.getSize());
+      }
+
+      return true;
+    }
+  }
+}
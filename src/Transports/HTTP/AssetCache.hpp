@@ -0,0 +1,125 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_HTTP_ASSET_CACHE_HPP_INCLUDED_
+#define TRANSPORTS_HTTP_ASSET_CACHE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <ctime>
+#include <map>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    using DUNE_NAMESPACES;
+
+    //! In-memory cache of static files. Files are loaded and gzip
+    //! compressed once and reloaded when their modification time or
+    //! size changes.
+    class AssetCache
+    {
+    public:
+      //! Cached file.
+      struct Asset
+      {
+        //! Modification time.
+        std::time_t mtime;
+        //! Size on disk.
+        int64_t size;
+        //! MIME type.
+        std::string type;
+        //! Entity tag (quoted).
+        std::string etag;
+        //! File contents.
+        std::string data;
+        //! Gzip compressed contents (empty if not worth it).
+        std::string gzip;
+      };
+
+      //! Constructor.
+      //! @param[in] max_file maximum size of a cached file.
+      //! @param[in] max_total maximum size of all cached data.
+      AssetCache(size_t max_file, size_t max_total);
+
+      //! Retrieve a file, loading it if it is not cached or changed
+      //! on disk.
+      //! @param[in] path file path.
+      //! @return asset or NULL if the file does not exist or cannot
+      //! be cached.
+      const Asset*
+      get(const Path& path);
+
+      //! Discard all cached files.
+      void
+      clear(void);
+
+      //! Get size of all cached data.
+      //! @return size in bytes.
+      size_t
+      getSize(void) const
+      {
+        return m_size;
+      }
+
+      //! Get MIME type of a file.
+      //! @param[in] ext file extension.
+      //! @return MIME type or empty string if unknown.
+      static std::string
+      getContentType(const std::string& ext);
+
+    private:
+      typedef std::map<std::string, Asset> Table;
+      //! Maximum size of a cached file.
+      size_t m_max_file;
+      //! Maximum size of all cached data.
+      size_t m_max_total;
+      //! Size of all cached data.
+      size_t m_size;
+      //! Cached files.
+      Table m_table;
+
+      //! Forget a cached file.
+      //! @param[in] itr file entry.
+      void
+      erase(Table::iterator itr);
+
+      //! Load a file.
+      //! @param[in] path file path.
+      //! @param[out] asset asset.
+      //! @return true if loaded, false otherwise.
+      bool
+      load(const Path& path, Asset& asset);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,332 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+#if defined(DUNE_SYS_HAS_LINUX_SENDFILE)
+#  include <sys/sendfile.h>
+#endif
+
+// Local headers.
+#include "Connection.hpp"
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    //! Maximum size of a request header.
+    static const size_t c_max_request_size = 2048;
+    //! Maximum size of a request body.
+    static const size_t c_max_body_size = 1024 * 1024;
+    //! Maximum amount of data pending in a streaming response.
+    static const size_t c_max_stream_backlog = 1024 * 1024;
+    //! Size of socket reads.
+    static const size_t c_read_size = 4096;
+    //! Size of file blocks.
+    static const size_t c_block_size = 64 * 1024;
+
+    Connection::Connection(TCPSocket* sock):
+      m_sock(sock),
+      m_header_size(0),
+      m_body_size(0),
+      m_request(false),
+      m_output_size(0),
+      m_streaming(false),
+      m_keep_alive(false),
+      m_closing(false),
+      m_last_io(Clock::get())
+    {
+      m_sock->setNonBlocking(true);
+      m_sock->setNoDelay(true);
+    }
+
+    Connection::~Connection(void)
+    {
+      while (!m_output.empty())
+      {
+        if (m_output.front().file)
+          std::fclose(m_output.front().file);
+        m_output.pop_front();
+      }
+
+      delete m_sock;
+    }
+
+    bool
+    Connection::fill(void)
+    {
+      char bfr[c_read_size];
+
+      try
+      {
+        // Stop reading while a complete request is pending.
+        while (!m_request && m_input.size() < c_max_request_size + c_max_body_size)
+        {
+          size_t rv = m_sock->read(bfr, sizeof(bfr));
+          if (rv == 0)
+            break;
+
+          m_input.append(bfr, rv);
+          m_last_io = Clock::get();
+
+          if (rv < sizeof(bfr))
+            break;
+        }
+      }
+      catch (ConnectionClosed&)
+      {
+        return false;
+      }
+
+      return true;
+    }
+
+    bool
+    Connection::hasRequest(void)
+    {
+      if (m_request)
+        return true;
+
+      size_t eoh = m_input.find("\r\n\r\n");
+      if (eoh == std::string::npos)
+      {
+        if (m_input.size() > c_max_request_size)
+          throw std::runtime_error(DTR("request header too large"));
+        return false;
+      }
+
+      if (eoh > c_max_request_size)
+        throw std::runtime_error(DTR("request header too large"));
+
+      m_header.assign(m_input, 0, eoh);
+      m_header_size = eoh + 4;
+      m_body_size = 0;
+
+      // Find body length.
+      size_t bol = 0;
+      while (bol < m_header.size())
+      {
+        size_t eol = m_header.find("\r\n", bol);
+        if (eol == std::string::npos)
+          eol = m_header.size();
+
+        std::string line = m_header.substr(bol, eol - bol);
+        String::toLowerCase(line);
+        if (String::startsWith(line, "content-length:"))
+        {
+          m_body_size = std::strtoul(line.c_str() + 15, NULL, 10);
+          break;
+        }
+
+        bol = eol + 2;
+      }
+
+      if (m_body_size > c_max_body_size)
+        throw std::runtime_error(DTR("request body too large"));
+
+      m_request = (m_input.size() >= m_header_size + m_body_size);
+      return m_request;
+    }
+
+    void
+    Connection::finishRequest(void)
+    {
+      m_input.erase(0, m_header_size + m_body_size);
+      m_header.clear();
+      m_header_size = 0;
+      m_body_size = 0;
+      m_request = false;
+    }
+
+    void
+    Connection::write(const char* data, size_t size)
+    {
+      if (m_output.empty() || m_output.back().file != NULL)
+      {
+        Segment seg;
+        seg.sent = 0;
+        seg.file = NULL;
+        seg.offset = 0;
+        seg.end = 0;
+        m_output.push_back(seg);
+      }
+
+      m_output.back().data.append(data, size);
+      m_output_size += size;
+    }
+
+    bool
+    Connection::writeFile(const std::string& file, int64_t off_beg, int64_t off_end)
+    {
+      std::FILE* fd = std::fopen(file.c_str(), "rb");
+      if (fd == NULL)
+        return false;
+
+      Segment seg;
+      seg.sent = 0;
+      seg.file = fd;
+      seg.offset = off_beg;
+      seg.end = off_end + 1;
+      m_output.push_back(seg);
+      return true;
+    }
+
+    void
+    Connection::writeChunk(const char* data, size_t size)
+    {
+      if (size == 0)
+        return;
+
+      // Drop peers that cannot keep up with the stream.
+      if (m_output_size > c_max_stream_backlog)
+      {
+        close();
+        return;
+      }
+
+      char bfr[32];
+      int rv = std::sprintf(bfr, "%lx\r\n", (unsigned long)size);
+      write(bfr, rv);
+      write(data, size);
+      write("\r\n", 2);
+    }
+
+    void
+    Connection::endStream(void)
+    {
+      if (!m_streaming)
+        return;
+
+      write("0\r\n\r\n", 5);
+      m_streaming = false;
+    }
+
+    bool
+    Connection::flush(void)
+    {
+      while (!m_output.empty())
+      {
+        Segment& seg = m_output.front();
+        bool done = seg.file ? flushFile(seg) : flushMemory(seg);
+        if (!done)
+          return false;
+
+        if (seg.file)
+          std::fclose(seg.file);
+        m_output.pop_front();
+      }
+
+      return true;
+    }
+
+    bool
+    Connection::flushMemory(Segment& seg)
+    {
+      while (seg.sent < seg.data.size())
+      {
+        size_t rv = m_sock->write(seg.data.data() + seg.sent, seg.data.size() - seg.sent);
+        if (rv == 0)
+          return false;
+
+        seg.sent += rv;
+        m_output_size -= rv;
+        m_last_io = Clock::get();
+      }
+
+      return true;
+    }
+
+    bool
+    Connection::flushFile(Segment& seg)
+    {
+#if defined(DUNE_SYS_HAS_LINUX_SENDFILE)
+      while (seg.offset < seg.end)
+      {
+        off64_t offset = seg.offset;
+        size_t len = (size_t)std::min((int64_t)c_block_size, seg.end - seg.offset);
+        ssize_t rv = sendfile64(m_sock->getNative(), fileno(seg.file), &offset, len);
+
+        if (rv < 0)
+        {
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return false;
+          throw NetworkError(DTR("error sending file"), System::Error::getLastMessage());
+        }
+
+        if (rv == 0)
+          throw std::runtime_error(DTR("file is shorter than expected"));
+
+        seg.offset = offset;
+        m_last_io = Clock::get();
+      }
+
+      return true;
+
+#else
+      while (true)
+      {
+        if (seg.sent == seg.data.size())
+        {
+          if (seg.offset >= seg.end)
+            return true;
+
+          size_t len = (size_t)std::min((int64_t)c_block_size, seg.end - seg.offset);
+          seg.data.resize(len);
+
+          if (std::fseek(seg.file, (long)seg.offset, SEEK_SET) != 0)
+            throw std::runtime_error(DTR("failed to read file"));
+
+          size_t rv = std::fread(&seg.data[0], 1, len, seg.file);
+          if (rv == 0)
+            throw std::runtime_error(DTR("file is shorter than expected"));
+
+          seg.data.resize(rv);
+          seg.sent = 0;
+          seg.offset += rv;
+        }
+
+        size_t rv = m_sock->write(seg.data.data() + seg.sent, seg.data.size() - seg.sent);
+        if (rv == 0)
+          return false;
+
+        seg.sent += rv;
+        m_last_io = Clock::get();
+      }
+#endif
+    }
+  }
+}
@@ -0,0 +1,264 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef TRANSPORTS_HTTP_CONNECTION_HPP_INCLUDED_
+#define TRANSPORTS_HTTP_CONNECTION_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <deque>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace HTTP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Non-blocking HTTP connection. Incoming data is buffered until
+    //! a complete request (header and body) is available and
+    //! responses are queued and written as the peer accepts them.
+    class Connection
+    {
+    public:
+      //! Constructor.
+      //! @param[in] sock accepted socket (ownership is transferred).
+      Connection(TCPSocket* sock);
+
+      //! Destructor.
+      ~Connection(void);
+
+      //! Get underlying socket.
+      //! @return socket.
+      TCPSocket*
+      getSocket(void)
+      {
+        return m_sock;
+      }
+
+      //! Read pending data from the socket.
+      //! @return false if the peer closed the connection.
+      bool
+      fill(void);
+
+      //! Check if a complete request is buffered.
+      //! @return true if a request is available.
+      bool
+      hasRequest(void);
+
+      //! Discard the current request.
+      void
+      finishRequest(void);
+
+      //! Get header of the current request.
+      //! @return request header (without the terminating empty line).
+      const std::string&
+      getHeader(void) const
+      {
+        return m_header;
+      }
+
+      //! Get body of the current request.
+      //! @return pointer to request body.
+      const char*
+      getBody(void) const
+      {
+        return m_input.data() + m_header_size;
+      }
+
+      //! Get size of the body of the current request.
+      //! @return size of the body in bytes.
+      size_t
+      getBodySize(void) const
+      {
+        return m_body_size;
+      }
+
+      //! Queue data for transmission.
+      //! @param[in] data data.
+      //! @param[in] size size of data.
+      void
+      write(const char* data, size_t size);
+
+      //! Queue a file region for transmission.
+      //! @param[in] file file path.
+      //! @param[in] off_beg first byte.
+      //! @param[in] off_end last byte.
+      //! @return false if the file could not be opened.
+      bool
+      writeFile(const std::string& file, int64_t off_beg, int64_t off_end);
+
+      //! Start a streaming response, which remains active after the
+      //! request handler returns. The response header must request
+      //! chunked transfer encoding.
+      void
+      beginStream(void)
+      {
+        m_streaming = true;
+      }
+
+      //! Queue one chunk of a streaming response.
+      //! @param[in] data data.
+      //! @param[in] size size of data.
+      void
+      writeChunk(const char* data, size_t size);
+
+      //! Terminate a streaming response.
+      void
+      endStream(void);
+
+      //! Check if a streaming response is active.
+      //! @return true if streaming.
+      bool
+      isStreaming(void) const
+      {
+        return m_streaming;
+      }
+
+      //! Define if the connection persists after the current response.
+      //! @param[in] value true to keep the connection open.
+      void
+      setKeepAlive(bool value)
+      {
+        m_keep_alive = value;
+      }
+
+      //! Check if the connection persists after the current response.
+      //! @return true if the connection is kept open.
+      bool
+      isKeepAlive(void) const
+      {
+        return m_keep_alive;
+      }
+
+      //! Close the connection after pending data is written.
+      void
+      close(void)
+      {
+        m_closing = true;
+        m_streaming = false;
+      }
+
+      //! Check if the connection is closing.
+      //! @return true if closing.
+      bool
+      isClosing(void) const
+      {
+        return m_closing;
+      }
+
+      //! Write as much pending data as the peer accepts.
+      //! @return true if no data is pending.
+      bool
+      flush(void);
+
+      //! Check if there is data pending transmission.
+      //! @return true if data is pending.
+      bool
+      hasOutput(void) const
+      {
+        return !m_output.empty();
+      }
+
+      //! Get amount of data pending transmission from memory.
+      //! @return size in bytes.
+      size_t
+      getOutputSize(void) const
+      {
+        return m_output_size;
+      }
+
+      //! Get time elapsed since the last successful I/O operation.
+      //! @return time in seconds.
+      double
+      getIdleTime(void) const
+      {
+        return Clock::get() - m_last_io;
+      }
+
+    private:
+      //! Pending output, either memory or a file region.
+      struct Segment
+      {
+        //! Memory data.
+        std::string data;
+        //! Offset of the first unsent byte of memory data.
+        size_t sent;
+        //! File (NULL for memory data).
+        std::FILE* file;
+        //! Offset of the next file byte.
+        int64_t offset;
+        //! Offset after the last file byte.
+        int64_t end;
+      };
+
+      //! Socket.
+      TCPSocket* m_sock;
+      //! Input buffer.
+      std::string m_input;
+      //! Header of the current request.
+      std::string m_header;
+      //! Size of header of the current request including terminator.
+      size_t m_header_size;
+      //! Size of body of the current request.
+      size_t m_body_size;
+      //! True if a request is available.
+      bool m_request;
+      //! Output queue.
+      std::deque<Segment> m_output;
+      //! Amount of memory data pending.
+      size_t m_output_size;
+      //! True if a streaming response is active.
+      bool m_streaming;
+      //! True if the connection persists.
+      bool m_keep_alive;
+      //! True if the connection must be closed.
+      bool m_closing;
+      //! Time of last I/O.
+      double m_last_io;
+
+      bool
+      flushFile(Segment& seg);
+
+      bool
+      flushMemory(Segment& seg);
+
+      //! Non-copyable.
+      Connection(const Connection&);
+
+      //! Non-assignable.
+      Connection&
+      operator=(const Connection&);
+    };
+  }
+}
+
+#endif
@@ -25,6 +25,9 @@
 // Author: Ricardo Martins                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <string>
+
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
@@ -39,7 +42,9 @@ namespace Transports
 
     MessageMonitor::MessageMonitor(const std::string& system, uint64_t uid):
       m_uid(uid),
-      m_last_msgs_json(0)
+      m_last_msgs_json(0),
+      m_msgs_json_seq(0),
+      m_seq(0)
     {
       // Initialize meta information.
       std::ostringstream os;
@@ -52,20 +57,7 @@ namespace Transports
     }
 
     MessageMonitor::~MessageMonitor(void)
-    {
-      ScopedMutex l(m_mutex);
-
-      {
-        std::map<unsigned, IMC::Message*>::iterator itr = m_msgs.begin();
-        for (; itr != m_msgs.end(); ++itr)
-          delete itr->second;
-      }
-
-      {
-        for (PowerChannelMap::iterator itr = m_power_channels.begin(); itr != m_power_channels.end(); ++itr)
-          delete itr->second;
-      }
-    }
+    { }
 
     void
     MessageMonitor::setEntities(const std::map<unsigned, std::string>& entities)
@@ -77,58 +69,57 @@ namespace Transports
     ByteBuffer*
     MessageMonitor::messagesJSON(void)
     {
-      ScopedMutex l(m_mutex);
-
-      uint64_t now = Clock::getMsec();
-
-      if ((now - m_last_msgs_json) > 2000)
-        m_last_msgs_json = now;
-      else
-        return &m_msgs_json;
-
-      if (m_msgs.empty())
-        return &m_msgs_json;
-
       std::ostringstream os;
-      os << m_meta
-         << "  'dune_time_current': '" << std::setprecision(12) << Clock::getSinceEpoch() << "',\n";
 
-      if (m_entities.empty())
       {
-        os << "  'dune_entities': { },\n";
-      }
-      else
-      {
-        os << "  'dune_entities': {\n";
-        EntityMap::iterator itr = m_entities.begin();
-        os << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
+        ScopedMutex l(m_mutex);
+
+        uint64_t now = Clock::getMsec();
+
+        if ((now - m_last_msgs_json) > 2000)
+          m_last_msgs_json = now;
+        else
+          return &m_msgs_json;
+
+        if (m_msgs.empty() || m_seq == m_msgs_json_seq)
+          return &m_msgs_json;
+
+        m_msgs_json_seq = m_seq;
+
+        os << m_meta
+           << "  'dune_time_current': '" << std::setprecision(12) << Clock::getSinceEpoch() << "',\n";
+
+        if (m_entities.empty())
+        {
+          os << "  'dune_entities': { },\n";
+        }
+        else
+        {
+          os << "  'dune_entities': {\n";
+          EntityMap::iterator itr = m_entities.begin();
+          os << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
+          ++itr;
+          for (; itr != m_entities.end(); ++itr)
+            os << ",\n" << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
+          os << "\n},";
+        }
+
+        os << "  'dune_messages': [\n";
+
+        MessageMap::iterator itr = m_msgs.begin();
+        os << itr->second.json;
         ++itr;
-        for (; itr != m_entities.end(); ++itr)
-          os << ",\n" << itr->first << " : {" << "\"label\": \"" << itr->second << "\"}";
-        os << "\n},";
-      }
 
-      os << "  'dune_messages': [\n";
-
-      std::map<unsigned, IMC::Message*>::iterator itr = m_msgs.begin();
-      itr->second->toJSON(os);
-      ++itr;
+        for (; itr != m_msgs.end(); ++itr)
+          os << ",\n" << itr->second.json;
 
-      for (; itr != m_msgs.end(); ++itr)
-      {
-        os << ",\n";
-        itr->second->toJSON(os);
-      }
+        for (PowerChannelMap::iterator pitr = m_power_channels.begin(); pitr != m_power_channels.end(); ++pitr)
+          os << ",\n" << pitr->second.json;
 
-      for (PowerChannelMap::iterator pitr = m_power_channels.begin(); pitr != m_power_channels.end(); ++pitr)
-      {
-        os << ",\n";
-        pitr->second->toJSON(os);
+        os << "\n]"
+           << "\n};";
       }
 
-      os << "\n]"
-         << "\n};";
-
       GzipCompressor cmp;
       std::string str = os.str();
       cmp.compress(m_msgs_json, (char*)str.c_str(), (unsigned long)str.size());
@@ -136,31 +127,63 @@ namespace Transports
       return &m_msgs_json;
     }
 
+    bool
+    MessageMonitor::messagesSince(uint64_t seq, std::string& json, uint64_t& last)
+    {
+      ScopedMutex l(m_mutex);
+
+      UpdateMap::iterator itr = m_updates.upper_bound(seq);
+      if (itr == m_updates.end())
+        return false;
+
+      json = "[";
+      json.append(itr->second->json);
+      for (++itr; itr != m_updates.end(); ++itr)
+      {
+        json.push_back(',');
+        json.append(itr->second->json);
+      }
+      json.push_back(']');
+
+      last = m_seq;
+      return true;
+    }
+
     void
     MessageMonitor::updateMessage(const IMC::Message* msg)
     {
-      ScopedMutex l(m_mutex);
+      // Serialize outside of the lock.
+      ByteBuffer bfr(512);
+      msg->toJSON(bfr);
+      std::string json(bfr.getBufferSigned(), bfr.getSize());
 
-      if (msg->getId() == DUNE_IMC_POWERCHANNELSTATE)
-        updatePowerChannel(static_cast<const IMC::PowerChannelState*>(msg));
+      unsigned key = msg->getId() << 24 | msg->getSubId() << 8 | msg->getSourceEntity();
 
-      IMC::Message* tmsg = msg->clone();
-      unsigned key = tmsg->getId() << 24 | tmsg->getSubId() << 8 | tmsg->getSourceEntity();
+      ScopedMutex l(m_mutex);
 
-      if (m_msgs[key])
-        delete m_msgs[key];
+      // Power channels are streamed by name.
+      if (msg->getId() == DUNE_IMC_POWERCHANNELSTATE)
+      {
+        const IMC::PowerChannelState* pcs = static_cast<const IMC::PowerChannelState*>(msg);
+        update(m_power_channels[pcs->name], json, true);
+        update(m_msgs[key], json, false);
+        return;
+      }
 
-      m_msgs[key] = tmsg;
+      update(m_msgs[key], json, true);
     }
 
     void
-    MessageMonitor::updatePowerChannel(const IMC::PowerChannelState* msg)
+    MessageMonitor::update(Entry& entry, const std::string& json, bool streamed)
     {
-      std::map<std::string, IMC::PowerChannelState*>::iterator itr = m_power_channels.find(msg->name);
-      if (itr != m_power_channels.end())
-        *itr->second = *msg;
-      else
-        m_power_channels[msg->name] = new IMC::PowerChannelState(*msg);
+      if (entry.seq != 0)
+        m_updates.erase(entry.seq);
+
+      entry.json = json;
+      entry.seq = ++m_seq;
+
+      if (streamed)
+        m_updates[entry.seq] = &entry;
     }
   }
 }
@@ -52,6 +52,16 @@ namespace Transports
       DUNE::Utils::ByteBuffer*
       messagesJSON(void);
 
+      //! Get the JSON of messages updated after a given sequence
+      //! number.
+      //! @param[in] seq sequence number of the last update known by
+      //! the caller (zero for all messages).
+      //! @param[out] json JSON array of messages.
+      //! @param[out] last sequence number of the last update.
+      //! @return true if there are updated messages, false otherwise.
+      bool
+      messagesSince(uint64_t seq, std::string& json, uint64_t& last);
+
       void
       updateMessage(const DUNE::IMC::Message* msg);
 
@@ -68,14 +78,31 @@ namespace Transports
       }
 
     private:
+      //! Serialized message.
+      struct Entry
+      {
+        //! JSON object.
+        std::string json;
+        //! Sequence number of the last update.
+        uint64_t seq;
+
+        Entry(void):
+          seq(0)
+        { }
+      };
+
       //! Convenience type definition for a map of power channels.
-      typedef std::map<std::string, DUNE::IMC::PowerChannelState*> PowerChannelMap;
+      typedef std::map<std::string, Entry> PowerChannelMap;
       // Convenience type definition for a map of entity labels.
       typedef std::map<unsigned, std::string> EntityMap;
+      //! Convenience type definition for a map of messages.
+      typedef std::map<unsigned, Entry> MessageMap;
+      //! Convenience type definition for the update index.
+      typedef std::map<uint64_t, const Entry*> UpdateMap;
       // Software meta information.
       std::string m_meta;
       // Table of messages.
-      std::map<unsigned, DUNE::IMC::Message*> m_msgs;
+      MessageMap m_msgs;
       // Entity map.
       EntityMap m_entities;
       // Concurrency mutex.
@@ -86,11 +113,18 @@ namespace Transports
       DUNE::Utils::ByteBuffer m_msgs_json;
       // Last JSON messages refresh.
       uint64_t m_last_msgs_json;
+      //! Sequence number of the last JSON messages refresh.
+      uint64_t m_msgs_json_seq;
       //! Power channels.
       PowerChannelMap m_power_channels;
+      //! Sequence number of the last update.
+      uint64_t m_seq;
+      //! Streamed entries ordered by sequence number.
+      UpdateMap m_updates;
 
       void
-      updatePowerChannel(const DUNE::IMC::PowerChannelState* msg);
+      update(Entry& entry, const std::string& json, bool streamed);
+
     };
   }
 }
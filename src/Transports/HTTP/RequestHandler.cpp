@@ -43,37 +43,47 @@
 #include "RequestHandler.hpp"
 
 #define SERVER_VERSION "Server: DUNE/" DUNE_VERSION_STR "\r\n"
-#define STATUS_LINE_100 "HTTP/1.0 100 Continue\r\n"
-#define STATUS_LINE_200 "HTTP/1.0 200 OK\r\n"
-#define STATUS_LINE_201 "HTTP/1.0 201 Created\r\n"
-#define STATUS_LINE_206 "HTTP/1.0 206 Partial Content\r\n"
-#define STATUS_LINE_403 "HTTP/1.0 403 Forbidden\r\n"
-#define STATUS_LINE_404 "HTTP/1.0 404 Not Found\r\n"
-#define STATUS_LINE_416 "HTTP/1.0 416 Requested Range Not Satisfiable\r\n"
-#define STATUS_LINE_500 "HTTP/1.0 500 Internal Server Error\r\n"
-#define STATUS_LINE_503 "HTTP/1.0 503 Service Unavailable\r\n"
+#define STATUS_LINE_100 "HTTP/1.1 100 Continue\r\n"
+#define STATUS_LINE_200 "HTTP/1.1 200 OK\r\n"
+#define STATUS_LINE_201 "HTTP/1.1 201 Created\r\n"
+#define STATUS_LINE_206 "HTTP/1.1 206 Partial Content\r\n"
+#define STATUS_LINE_304 "HTTP/1.1 304 Not Modified\r\n"
+#define STATUS_LINE_403 "HTTP/1.1 403 Forbidden\r\n"
+#define STATUS_LINE_404 "HTTP/1.1 404 Not Found\r\n"
+#define STATUS_LINE_416 "HTTP/1.1 416 Requested Range Not Satisfiable\r\n"
+#define STATUS_LINE_500 "HTTP/1.1 500 Internal Server Error\r\n"
+#define STATUS_LINE_503 "HTTP/1.1 503 Service Unavailable\r\n"
 
 namespace Transports
 {
   namespace HTTP
   {
-    // Maximum size of a request.
-    static const unsigned c_max_request_size = 2048;
-
     void
-    RequestHandler::sendHeader(TCPSocket* sock, const char* status_line, int64_t length, HeaderFieldsMap* hdr_fields)
+    RequestHandler::sendHeader(Connection* conn, const char* status_line, int64_t length, HeaderFieldsMap* hdr_fields)
     {
       std::string now = Time::Format::getRFC1123();
 
       // Start header.
       std::stringstream ss;
       ss << status_line
-         << SERVER_VERSION
-         << "Content-Length: " << length << "\r\n"
-         << "Cache-Control: " << "max-age=1, must-revalidate" << "\r\n"
-         << "Last-Modified: " << now << "\r\n"
-         << "Expires: " << now << "\r\n"
-         << "Accept-Ranges: " << "bytes" << "\r\n";
+         << SERVER_VERSION;
+
+      if (length < 0)
+        ss << "Transfer-Encoding: chunked\r\n";
+      else
+        ss << "Content-Length: " << length << "\r\n";
+
+      ss << "Connection: " << (conn->isKeepAlive() ? "keep-alive" : "close") << "\r\n";
+
+      // Responses are not cached unless the caller says otherwise.
+      if (hdr_fields == 0 || hdr_fields->find("Cache-Control") == hdr_fields->end())
+      {
+        ss << "Cache-Control: " << "max-age=1, must-revalidate" << "\r\n"
+           << "Last-Modified: " << now << "\r\n"
+           << "Expires: " << now << "\r\n";
+      }
+
+      ss << "Accept-Ranges: " << "bytes" << "\r\n";
 
       // Add extra header fields.
       if (hdr_fields)
@@ -87,112 +97,113 @@ namespace Transports
       ss << "\r\n";
 
       std::string res = ss.str();
-      sock->write(res.c_str(), res.size());
+      conn->write(res.c_str(), res.size());
     }
 
     void
-    RequestHandler::sendResponse100(TCPSocket* sock)
+    RequestHandler::sendStreamHeader(Connection* conn, HeaderFieldsMap* hdr_fields)
     {
-      sendHeader(sock, STATUS_LINE_100, 8);
-      sock->write("Continue", 8);
+      sendHeader(conn, STATUS_LINE_200, -1, hdr_fields);
+      conn->beginStream();
     }
 
     void
-    RequestHandler::sendResponse200(TCPSocket* sock)
+    RequestHandler::sendResponse100(Connection* conn)
     {
-      sendHeader(sock, STATUS_LINE_200, 2);
-      sock->write("OK", 2);
+      sendHeader(conn, STATUS_LINE_100, 8);
+      conn->write("Continue", 8);
     }
 
     void
-    RequestHandler::sendResponse201(TCPSocket* sock)
+    RequestHandler::sendResponse200(Connection* conn)
     {
-      sendHeader(sock, STATUS_LINE_201, 7);
-      sock->write("Created", 7);
+      sendHeader(conn, STATUS_LINE_200, 2);
+      conn->write("OK", 2);
     }
 
     void
-    RequestHandler::sendResponse403(TCPSocket* sock)
+    RequestHandler::sendResponse304(Connection* conn, HeaderFieldsMap* hdr_fields)
     {
-      sendHeader(sock, STATUS_LINE_403, 9);
-      sock->write("Forbidden", 9);
+      sendHeader(conn, STATUS_LINE_304, 0, hdr_fields);
     }
 
     void
-    RequestHandler::sendResponse404(TCPSocket* sock, const std::string& message)
+    RequestHandler::sendResponse201(Connection* conn)
     {
-      sendHeader(sock, STATUS_LINE_404, message.size());
-      sock->write(message.c_str(), message.size());
+      sendHeader(conn, STATUS_LINE_201, 7);
+      conn->write("Created", 7);
     }
 
     void
-    RequestHandler::sendResponse416(TCPSocket* sock)
+    RequestHandler::sendResponse403(Connection* conn)
     {
-      sendHeader(sock, STATUS_LINE_416, 31);
-      sock->write("Requested Range Not Satisfiable", 31);
+      sendHeader(conn, STATUS_LINE_403, 9);
+      conn->write("Forbidden", 9);
     }
 
     void
-    RequestHandler::sendResponse500(TCPSocket* sock)
+    RequestHandler::sendResponse404(Connection* conn, const std::string& message)
     {
-      sendHeader(sock, STATUS_LINE_500, 21);
-      sock->write("Internal Server Error", 21);
+      sendHeader(conn, STATUS_LINE_404, message.size());
+      conn->write(message.c_str(), message.size());
     }
 
     void
-    RequestHandler::sendResponse503(TCPSocket* sock)
+    RequestHandler::sendResponse416(Connection* conn)
     {
-      sendHeader(sock, STATUS_LINE_503, 19);
-      sock->write("Service unavailable", 19);
+      sendHeader(conn, STATUS_LINE_416, 31);
+      conn->write("Requested Range Not Satisfiable", 31);
     }
 
     void
-    RequestHandler::sendData(TCPSocket* sock, const char* data, int size, HeaderFieldsMap* hdr_fields)
+    RequestHandler::sendResponse500(Connection* conn)
     {
-      sendHeader(sock, STATUS_LINE_200, size, hdr_fields);
-
-      int remaining = size;
-      int rv = 0;
-
-      while (remaining > 0)
-      {
-        rv = sock->write(data, size);
+      sendHeader(conn, STATUS_LINE_500, 21);
+      conn->write("Internal Server Error", 21);
+    }
 
-        if (rv < 0)
-        {
-          DUNE_ERR("RequestHandler", "error sending data: " << rv);
-          return;
-        }
+    void
+    RequestHandler::sendResponse503(Connection* conn)
+    {
+      sendHeader(conn, STATUS_LINE_503, 19);
+      conn->write("Service unavailable", 19);
+    }
 
-        remaining -= rv;
-      }
+    void
+    RequestHandler::sendData(Connection* conn, const char* data, int size, HeaderFieldsMap* hdr_fields)
+    {
+      sendHeader(conn, STATUS_LINE_200, size, hdr_fields);
+      conn->write(data, size);
     }
 
     void
-    RequestHandler::sendFile(TCPSocket* sock, const std::string& file, HeaderFieldsMap& hdr_fields, int64_t off_beg, int64_t off_end)
+    RequestHandler::sendFile(Connection* conn, const std::string& file, HeaderFieldsMap& hdr_fields, int64_t off_beg, int64_t off_end)
     {
       int64_t size = FileSystem::Path(file).size();
 
       // File doesn't exist or isn't accessible.
       if (size < 0)
       {
-        sendResponse404(sock);
+        sendResponse404(conn);
         return;
       }
 
       // Requested end offset is larger than file size.
       if (off_end > size)
       {
-        sendResponse416(sock);
+        sendResponse416(conn);
         return;
       }
 
       // Send full file.
       if ((off_beg < 0) && (off_end < 0))
       {
-        sendHeader(sock, STATUS_LINE_200, size, &hdr_fields);
-        if (!sock->writeFile(file.c_str(), size - 1))
+        sendHeader(conn, STATUS_LINE_200, size, &hdr_fields);
+        if (!conn->writeFile(file, 0, size - 1))
+        {
           DUNE_ERR("HTTPHandle", "failed to send file: " << System::Error::getLastMessage());
+          conn->close();
+        }
         return;
       }
 
@@ -209,106 +220,90 @@ namespace Transports
          << "/" << size;
 
       hdr_fields.insert(std::make_pair("Content-Range", os.str()));
-      sendHeader(sock, STATUS_LINE_206, off_end - off_beg + 1, &hdr_fields);
+      sendHeader(conn, STATUS_LINE_206, off_end - off_beg + 1, &hdr_fields);
 
-      if (!sock->writeFile(file.c_str(), off_end, off_beg))
+      if (!conn->writeFile(file, off_beg, off_end))
+      {
         DUNE_ERR("HTTPHandle", "failed to send file: " << System::Error::getLastMessage());
+        conn->close();
+      }
     }
 
     void
-    RequestHandler::handleGET(TCPSocket* sock, Utils::TupleList& headers, const char* uri)
+    RequestHandler::handleGET(Connection* conn, Utils::TupleList& headers, const char* uri)
     {
       (void)headers;
       (void)uri;
-      sendResponse404(sock);
+      sendResponse404(conn);
     }
 
     void
-    RequestHandler::handlePOST(TCPSocket* sock, Utils::TupleList& headers, const char* uri)
+    RequestHandler::handlePOST(Connection* conn, Utils::TupleList& headers, const char* uri)
     {
       (void)headers;
       (void)uri;
-      sendResponse404(sock);
+      sendResponse404(conn);
     }
 
     void
-    RequestHandler::handlePUT(TCPSocket* sock, Utils::TupleList& headers, const char* uri)
+    RequestHandler::handlePUT(Connection* conn, Utils::TupleList& headers, const char* uri)
     {
       (void)headers;
       (void)uri;
-      sendResponse404(sock);
+      sendResponse404(conn);
     }
 
     void
-    RequestHandler::handleRequest(TCPSocket* sock)
+    RequestHandler::handleRequest(Connection* conn)
     {
       char mtd[16];
       char uri[512];
-      char bfr[c_max_request_size] = {0};
-
-      // Search for end of request.
-      unsigned idx = 0;
-      unsigned didx = 0;
-      bool eor = false;
-      while (!eor && (idx < (c_max_request_size - 1)))
-      {
-        int rv = sock->read(bfr + idx, 1);
-
-        if (rv <= 0)
-          throw ConnectionClosed();
-
-        if (didx == 0 && bfr[idx] == '\r')
-          didx = 1;
-        else if (didx == 1 && bfr[idx] == '\n')
-          didx = 2;
-        else if (didx == 2 && bfr[idx] == '\r')
-          didx = 3;
-        else if (didx == 3 && bfr[idx] == '\n')
-        {
-          eor = true;
-          didx = 0;
-        }
-        else
-          didx = 0;
+      char ver[16];
 
-        ++idx;
-      }
-
-      // Get header.
-      int size = idx - 4;
-      if (size <= 0)
+      const std::string& hdr = conn->getHeader();
+      if (hdr.empty())
       {
         DUNE_WRN("HTTP", "request too short");
+        conn->close();
         return;
       }
 
-      char* hdr = new char[size + 1];
-      std::memcpy(hdr, bfr, size);
-      hdr[size] = 0;
-
       Utils::TupleList headers(hdr, ":", "\r\n", true);
 
       // Parse request line.
-      if (std::sscanf(hdr, "%s %s %*s", mtd, uri) == 2)
+      if (std::sscanf(hdr.c_str(), "%15s %511s %15s", mtd, uri, ver) != 3)
       {
-        std::string uri_dec = URL::decode(uri);
-        const char* uri_clean = uri_dec.c_str();
-
-        if (std::strcmp(mtd, "GET") == 0)
-        {
-          handleGET(sock, headers, uri_clean);
-        }
-        else if (std::strcmp(mtd, "POST") == 0)
-        {
-          handlePOST(sock, headers, uri_clean);
-        }
-        else if (std::strcmp(mtd, "PUT") == 0)
-        {
-          handlePUT(sock, headers, uri_clean);
-        }
+        conn->close();
+        return;
       }
 
-      delete[] hdr;
+      // HTTP/1.1 connections are persistent unless stated otherwise.
+      std::string connection = headers.get("connection");
+      String::toLowerCase(connection);
+      if (std::strcmp(ver, "HTTP/1.1") == 0)
+        conn->setKeepAlive(connection.find("close") == std::string::npos);
+      else
+        conn->setKeepAlive(connection.find("keep-alive") != std::string::npos);
+
+      std::string uri_dec = URL::decode(uri);
+      const char* uri_clean = uri_dec.c_str();
+
+      if (std::strcmp(mtd, "GET") == 0)
+      {
+        handleGET(conn, headers, uri_clean);
+      }
+      else if (std::strcmp(mtd, "POST") == 0)
+      {
+        handlePOST(conn, headers, uri_clean);
+      }
+      else if (std::strcmp(mtd, "PUT") == 0)
+      {
+        handlePUT(conn, headers, uri_clean);
+      }
+      else
+      {
+        conn->close();
+      }
     }
   }
 }
@@ -36,6 +36,9 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Connection.hpp"
+
 namespace Transports
 {
   namespace HTTP
@@ -55,61 +58,88 @@ namespace Transports
       { }
 
       virtual void
-      handleGET(TCPSocket* sock, Utils::TupleList& headers, const char* uri);
+      handleGET(Connection* conn, Utils::TupleList& headers, const char* uri);
 
       virtual void
-      handlePOST(TCPSocket* sock, Utils::TupleList& headers, const char* uri);
+      handlePOST(Connection* conn, Utils::TupleList& headers, const char* uri);
 
       virtual void
-      handlePUT(TCPSocket* sock, Utils::TupleList& headers, const char* uri);
+      handlePUT(Connection* conn, Utils::TupleList& headers, const char* uri);
+
+      //! Queue a response header.
+      //! @param[in] conn connection.
+      //! @param[in] status_line status line.
+      //! @param[in] length length of the body or -1 for chunked
+      //! transfer encoding.
+      //! @param[in] hdr_fields extra header fields. If these include
+      //! Cache-Control the default caching fields are omitted.
+      void
+      sendHeader(Connection* conn, const char* status_line, int64_t length, HeaderFieldsMap* hdr_fields = 0);
+
+      //! Start a streaming response with chunked transfer encoding.
+      //! Data is then sent with Connection::writeChunk().
+      //! @param[in] conn connection.
+      //! @param[in] hdr_fields extra header fields.
+      void
+      sendStreamHeader(Connection* conn, HeaderFieldsMap* hdr_fields = 0);
 
       void
-      sendHeader(TCPSocket* sock, const char* status_line, int64_t length, HeaderFieldsMap* hdr_fields = 0);
+      sendResponse100(Connection* conn);
 
       void
-      sendResponse100(TCPSocket* sock);
+      sendResponse201(Connection* conn);
 
       void
-      sendResponse201(TCPSocket* sock);
+      sendResponse200(Connection* conn);
 
       void
-      sendResponse200(TCPSocket* sock);
+      sendResponse304(Connection* conn, HeaderFieldsMap* hdr_fields = 0);
 
       void
-      sendResponse403(TCPSocket* sock);
+      sendResponse403(Connection* conn);
 
       void
-      sendResponse404(TCPSocket* sock, const std::string& message);
+      sendResponse404(Connection* conn, const std::string& message);
 
       inline void
-      sendResponse404(TCPSocket* sock)
+      sendResponse404(Connection* conn)
       {
-        sendResponse404(sock, "Not Found");
+        sendResponse404(conn, "Not Found");
       }
 
       void
-      sendResponse416(TCPSocket* sock);
+      sendResponse416(Connection* conn);
 
       void
-      sendResponse500(TCPSocket* sock);
+      sendResponse500(Connection* conn);
 
       void
-      sendResponse503(TCPSocket* sock);
+      sendResponse503(Connection* conn);
 
       void
-      sendData(TCPSocket* sock, const char* data, int size, HeaderFieldsMap* hdr_fields = 0);
+      sendData(Connection* conn, const char* data, int size, HeaderFieldsMap* hdr_fields = 0);
 
       inline void
-      sendData(TCPSocket* sock, const std::string& data, HeaderFieldsMap* hdr_fields = 0)
+      sendData(Connection* conn, const std::string& data, HeaderFieldsMap* hdr_fields = 0)
       {
-        sendData(sock, data.c_str(), (int)data.size(), hdr_fields);
+        sendData(conn, data.c_str(), (int)data.size(), hdr_fields);
       }
 
       void
-      sendFile(TCPSocket* sock, const std::string& file, HeaderFieldsMap& hdr_fields, int64_t off_beg = -1, int64_t off_end = -1);
+      sendFile(Connection* conn, const std::string& file, HeaderFieldsMap& hdr_fields, int64_t off_beg = -1, int64_t off_end = -1);
 
+      //! Handle the request buffered in a connection.
+      //! @param[in] conn connection.
       void
-      handleRequest(TCPSocket* sock);
+      handleRequest(Connection* conn);
+
+      //! Called before a connection is destroyed.
+      //! @param[in] conn connection.
+      virtual void
+      handleClose(Connection* conn)
+      {
+        (void)conn;
+      }
     };
   }
 }
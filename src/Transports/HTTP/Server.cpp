@@ -26,16 +26,10 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
-#include <sstream>
-#include <fstream>
-#include <queue>
-#include <iostream>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/Streams/Terminal.hpp>
-#include <DUNE/Concurrency/TSQueue.hpp>
-#include <DUNE/Concurrency/Condition.hpp>
-#include <DUNE/Concurrency/Mutex.hpp>
 #include <DUNE/Network.hpp>
 
 // Local headers.
@@ -45,104 +39,149 @@ namespace Transports
 {
   namespace HTTP
   {
-    class Handler: public Concurrency::Thread
-    {
-    public:
-      Handler(RequestHandler& hdler, Concurrency::TSQueue<TCPSocket*>& queue):
-        m_handler(hdler),
-        m_queue(queue)
-      { }
-
-    private:
-      RequestHandler& m_handler;
-      Concurrency::TSQueue<TCPSocket*>& m_queue;
-
-      void
-      run(void)
-      {
-        while (!isStopping())
-        {
-          if (!m_queue.waitForItems(1.0))
-            continue;
-
-          if (m_queue.closed())
-            break;
-
-          TCPSocket* sock = m_queue.pop();
-          if (!sock)
-            continue;
-
-          try
-          {
-            m_handler.handleRequest(sock);
-          }
-          catch (std::runtime_error& e)
-          {
-            DUNE_ERR("Handler", e.what());
-          }
-
-          delete sock;
-        }
-      }
-    };
+    //! Polling period while output is pending.
+    static const double c_output_period = 0.01;
 
-    Server::Server(int port, unsigned threads, RequestHandler& handler):
-      m_handler(handler)
+    Server::Server(int port, unsigned max_conns, double timeout, RequestHandler& handler):
+      m_handler(handler),
+      m_max_conns(max_conns),
+      m_timeout(timeout)
     {
       m_sock.bind(port);
       m_sock.listen(1024);
       m_poll.add(m_sock);
+    }
 
-      for (unsigned int i = 0; i < threads; ++i)
+    Server::~Server(void)
+    {
+      while (!m_conns.empty())
       {
-        Concurrency::Thread* t = new Handler(handler, m_queue);
-        m_pool.push_back(t);
-        t->start();
+        destroy(m_conns.front());
+        m_conns.pop_front();
       }
     }
 
-    Server::~Server(void)
+    void
+    Server::poll(double timeout)
     {
-      m_queue.close();
+      // Poll only notifies readable handles, retry pending output often.
+      bool output = false;
+      std::list<Connection*>::iterator itr = m_conns.begin();
+      for (; itr != m_conns.end(); ++itr)
+      {
+        if ((*itr)->hasOutput())
+        {
+          output = true;
+          break;
+        }
+      }
+
+      if (output)
+        timeout = std::min(timeout, c_output_period);
 
-      for (unsigned i = 0; i < m_pool.size(); ++i)
+      if (m_poll.poll(timeout) && m_poll.wasTriggered(m_sock))
+        accept();
+
+      itr = m_conns.begin();
+      while (itr != m_conns.end())
       {
-        try
+        if (process(*itr))
         {
-          m_pool[i]->stopAndJoin();
+          ++itr;
+          continue;
         }
-        catch (...)
-        { }
 
-        delete m_pool[i];
+        destroy(*itr);
+        itr = m_conns.erase(itr);
       }
+    }
 
-      while (!m_queue.empty())
+    void
+    Server::accept(void)
+    {
+      TCPSocket* sock = NULL;
+
+      try
+      {
+        sock = m_sock.accept();
+      }
+      catch (std::runtime_error& e)
+      {
+        DUNE_ERR("Server", e.what());
+        return;
+      }
+
+      if (m_conns.size() >= m_max_conns)
       {
-        TCPSocket* sock = m_queue.pop();
-        if (sock)
-          delete sock;
+        DUNE_WRN("Server", DTR("too many connections"));
+        delete sock;
+        return;
+      }
+
+      try
+      {
+        Connection* conn = new Connection(sock);
+        m_conns.push_back(conn);
+        m_poll.add(*sock);
+      }
+      catch (std::runtime_error& e)
+      {
+        DUNE_ERR("Server", e.what());
       }
     }
 
-    void
-    Server::poll(double timeout)
+    bool
+    Server::process(Connection* conn)
     {
-      if (m_poll.poll(timeout))
+      try
       {
-        if (m_poll.wasTriggered(m_sock))
+        if (m_poll.wasTriggered(*conn->getSocket()))
+        {
+          if (!conn->fill())
+            return false;
+        }
+
+        // Handle requests in order, one response at a time.
+        while (!conn->isStreaming() && !conn->isClosing() && conn->hasRequest())
         {
           try
           {
-            TCPSocket* nc = m_sock.accept();
-            m_queue.push(nc);
+            m_handler.handleRequest(conn);
           }
           catch (std::runtime_error& e)
           {
             DUNE_ERR("Server", e.what());
+            conn->close();
           }
+
+          conn->finishRequest();
+
+          if (!conn->isStreaming() && !conn->isKeepAlive())
+            conn->close();
         }
+
+        if (conn->flush() && conn->isClosing())
+          return false;
+
+        // Streams are bounded by their backlog instead.
+        if (!conn->isStreaming() && conn->getIdleTime() > m_timeout)
+          return false;
       }
+      catch (std::runtime_error& e)
+      {
+        DUNE_DBG("Server", e.what());
+        return false;
+      }
+
+      return true;
+    }
+
+    void
+    Server::destroy(Connection* conn)
+    {
+      m_handler.handleClose(conn);
+      m_poll.remove(*conn->getSocket());
+      delete conn;
     }
   }
 }
@@ -29,30 +29,36 @@
 #define TRANSPORTS_HTTP_SERVER_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
-#include <vector>
+#include <list>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
+#include "Connection.hpp"
 #include "RequestHandler.hpp"
 
 namespace Transports
 {
   namespace HTTP
   {
+    //! Single-threaded HTTP server. Connections are non-blocking and
+    //! multiplexed with IO::Poll, so slow peers do not delay others.
     class Server
     {
     public:
       //! Constructor.
       //! @param port listening port.
-      //! @param threads number of worker threads.
+      //! @param max_conns maximum number of simultaneous connections.
+      //! @param timeout idle connection timeout in seconds.
       //! @param handler HTTP request handler.
-      Server(int port, unsigned threads, RequestHandler& handler);
+      Server(int port, unsigned max_conns, double timeout, RequestHandler& handler);
 
       //! Destructor.
       ~Server(void);
 
+      //! Wait for and process I/O events.
+      //! @param timeout maximum amount of time to wait.
       void
       poll(double timeout);
 
@@ -61,12 +67,23 @@ namespace Transports
       RequestHandler& m_handler;
       //! Server socket.
       TCPSocket m_sock;
-      //! Worker threads pool.
-      std::vector<Concurrency::Thread*> m_pool;
-      //! Socket queue.
-      Concurrency::TSQueue<TCPSocket*> m_queue;
+      //! Maximum number of connections.
+      unsigned m_max_conns;
+      //! Idle connection timeout.
+      double m_timeout;
+      //! Active connections.
+      std::list<Connection*> m_conns;
       //! I/O multiplexing.
       IO::Poll m_poll;
+
+      void
+      accept(void);
+
+      bool
+      process(Connection* conn);
+
+      void
+      destroy(Connection* conn);
     };
   }
 }
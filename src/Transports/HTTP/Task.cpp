@@ -26,10 +26,12 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <map>
 #include <vector>
 #include <stdexcept>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <cstdlib>
 #include <algorithm>
 #include <cstddef>
@@ -38,6 +40,7 @@
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
+#include "AssetCache.hpp"
 #include "MessageMonitor.hpp"
 #include "RequestHandler.hpp"
 #include "Server.hpp"
@@ -55,21 +58,46 @@ namespace Transports
     {
       //! Start port.
       unsigned port;
-      //! Number of worker threads.
-      unsigned threads;
+      //! Maximum number of simultaneous connections.
+      unsigned max_conns;
+      //! Idle connection timeout.
+      double conn_timeout;
+      //! Period of message streams.
+      double stream_period;
       //! List of messages to transport.
       std::vector<std::string> messages;
+      //! Maximum size of cached static files.
+      unsigned cache_size;
+      //! Lifetime of static files in browser caches.
+      unsigned cache_lifetime;
     };
 
     //! Buffer length.
     static const unsigned c_buffer_len = 4096;
     //! Maximum number of ports to try before giving up.
     static const int c_max_port_tries = 10;
+    //! Maximum size of a cached static file.
+    static const size_t c_asset_max_file = 1024 * 1024;
+    //! Time to wait for the reply of a time series query.
+    static const double c_series_timeout = 5.0;
+
+    //! Time series query waiting for its reply.
+    struct SeriesQuery
+    {
+      //! Connection of the request.
+      Connection* conn;
+      //! True if the request lists the stored series.
+      bool index;
+      //! Time after which the query is abandoned.
+      double deadline;
+    };
 
     struct Task: public Tasks::Task, public RequestHandler
     {
       //! HTTP server.
       Server* m_server;
+      //! Cache of static files.
+      AssetCache* m_assets;
       //! Configuration directory.
       std::string m_cfg_dir;
       //! Agent name.
@@ -78,33 +106,74 @@ namespace Transports
       MessageMonitor m_msg_mon;
       //! Task arguments.
       Arguments m_args;
+      //! Message streams and last sequence number sent to each.
+      std::map<Connection*, uint64_t> m_streams;
+      //! Message streams timer.
+      Time::Counter<double> m_stream_timer;
+      //! Catalog of stored logs.
+      IMC::LogCatalog m_logs;
+      //! Time series queries waiting for replies, by request identifier.
+      std::map<uint16_t, SeriesQuery> m_series_queries;
+      //! Identifier of the next time series query.
+      uint16_t m_series_req_id;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
         RequestHandler(),
         m_server(NULL),
-        m_msg_mon(getSystemName(), ctx.uid)
+        m_assets(NULL),
+        m_msg_mon(getSystemName(), ctx.uid),
+        m_logs(ctx.dir_log),
+        m_series_req_id(0)
       {
         // Define configuration parameters.
         param("Port", m_args.port)
         .defaultValue("8080")
         .description("TCP port to listen on");
 
-        param("Threads", m_args.threads)
-        .defaultValue("5")
-        .description("Number of worker threads");
+        param("Maximum Connections", m_args.max_conns)
+        .defaultValue("32")
+        .minimumValue("1")
+        .description("Maximum number of simultaneous connections");
+
+        param("Connection Timeout", m_args.conn_timeout)
+        .defaultValue("30.0")
+        .units(Units::Second)
+        .description("Time after which idle connections are closed");
+
+        param("Stream Period", m_args.stream_period)
+        .defaultValue("0.25")
+        .units(Units::Second)
+        .description("Period of message updates pushed to event streams");
 
         param("Transports", m_args.messages)
         .defaultValue("")
         .description("List of messages to transport");
 
+        param("Asset Cache Size", m_args.cache_size)
+        .defaultValue("4096")
+        .units(Units::Kibibyte)
+        .description("Memory used to keep static files and their compressed"
+                     " versions, zero to read them from disk on each request");
+
+        param("Asset Cache Lifetime", m_args.cache_lifetime)
+        .defaultValue("86400")
+        .units(Units::Second)
+        .description("Time browsers may reuse static files without revalidation."
+                     " HTML pages are always revalidated");
+
         m_cfg_dir = ctx.dir_cfg.str();
         m_agent = getSystemName();
+
+        bind<IMC::TimeSeriesReply>(this);
       }
 
       void
       onResourceAcquisition(void)
       {
+        if (m_args.cache_size > 0)
+          m_assets = new AssetCache(c_asset_max_file, m_args.cache_size * 1024);
+
         uint16_t last_port = m_args.port + c_max_port_tries;
 
         for (uint16_t port = m_args.port; port < last_port; ++port)
@@ -112,7 +181,7 @@ namespace Transports
           try
           {
             inf(DTR("listening on %s:%u"), Address(Address::Any).c_str(), port);
-            m_server = new Server(port, m_args.threads, *this);
+            m_server = new Server(port, m_args.max_conns, m_args.conn_timeout, *this);
 
             // Initialize and dispatch AnnounceService.
             std::vector<Interface> itfs = Interface::get();
@@ -146,6 +215,7 @@ namespace Transports
       onResourceRelease(void)
       {
         Memory::clear(m_server);
+        Memory::clear(m_assets);
       }
 
       void
@@ -158,6 +228,7 @@ namespace Transports
       onUpdateParameters(void)
       {
         bind(this, m_args.messages);
+        m_stream_timer.setTop(m_args.stream_period);
       }
 
       void
@@ -186,24 +257,34 @@ namespace Transports
       }
 
       void
-      handleGET(TCPSocket* sock, TupleList& headers, const char* uri)
+      handleGET(Connection* conn, TupleList& headers, const char* uri)
       {
         debug("GET request: %s", uri);
 
         if (isSpecialURI(uri))
         {
           if (matchURL(uri, "/dune/time/set", true))
-            setTime(sock, headers, uri);
+            setTime(conn, headers, uri);
           else if (matchURL(uri, "/dune/version.js"))
-            sendVersionJSON(sock, headers, uri);
+            sendVersionJSON(conn, headers, uri);
           else if (matchURL(uri, "/dune/agent.js"))
-            sendAgentJSON(sock, headers, uri);
+            sendAgentJSON(conn, headers, uri);
+          else if (matchURL(uri, "/dune/imc/IMC.xml"))
+            sendSchema(conn, headers, uri);
           else if (matchURL(uri, "/dune/state/messages.js"))
-            showMessages(sock, headers, uri);
+            showMessages(conn, headers, uri);
+          else if (matchURL(uri, "/dune/state/messages/stream"))
+            streamMessages(conn, headers, uri);
           else if (matchURL(uri, "/dune/power/channel/", true))
-            handlePowerChannel(sock, headers, uri);
+            handlePowerChannel(conn, headers, uri);
+          else if (matchURL(uri, "/dune/logs/index.js"))
+            sendLogIndex(conn, headers, uri);
+          else if (matchURL(uri, "/dune/products/", true))
+            sendProduct(conn, headers, uri);
+          else if (matchURL(uri, "/dune/series/", true))
+            querySeries(conn, headers, uri);
           else
-            sendResponse404(sock);
+            sendResponse404(conn);
         }
         else
         {
@@ -213,30 +294,30 @@ namespace Transports
           else
             path = m_ctx.dir_www / uri;
 
-          sendStaticFile(sock, headers, path);
+          sendAsset(conn, headers, path);
         }
       }
 
       void
-      handlePOST(TCPSocket* sock, TupleList& headers, const char* uri)
+      handlePOST(Connection* conn, TupleList& headers, const char* uri)
       {
         debug("POST request: %s", uri);
 
         if (isSpecialURI(uri))
         {
           if (matchURL(uri, "/dune/messages/imc/", true))
-            getMessage(sock, headers, uri);
+            getMessage(conn, headers, uri);
           else
-            sendResponse403(sock);
+            sendResponse403(conn);
         }
         else
         {
-          sendResponse403(sock);
+          sendResponse403(conn);
         }
       }
 
       void
-      handlePUT(TCPSocket* sock, TupleList& headers, const char* uri)
+      handlePUT(Connection* conn, TupleList& headers, const char* uri)
       {
         debug("PUT request: %s", uri);
 
@@ -244,16 +325,16 @@ namespace Transports
 
         if (isSpecialURI(uri))
         {
-          sendResponse403(sock);
+          sendResponse403(conn);
         }
         else
         {
-          sendResponse403(sock);
+          sendResponse403(conn);
         }
       }
 
       void
-      sendStaticFile(TCPSocket* sock, TupleList& headers, const Path& file)
+      sendStaticFile(Connection* conn, TupleList& headers, const Path& file)
       {
         int64_t beg = -1;
         int64_t end = -1;
@@ -272,34 +353,95 @@ namespace Transports
         }
 
         RequestHandler::HeaderFieldsMap hdr;
-        std::string ext = file.extension();
-        if (ext == "html")
-          hdr["Content-Type"] = "text/html";
-        else if (ext == "css")
-          hdr["Content-Type"] = "text/css";
-        else if (ext == "js")
-          hdr["Content-Type"] = "text/javascript";
+        std::string type = AssetCache::getContentType(file.extension());
+        if (!type.empty())
+          hdr["Content-Type"] = type;
+
+        sendFile(conn, file.str(), hdr, beg, end);
+      }
+
+      //! Send a file of the web interface from the asset cache,
+      //! falling back to the disk for ranges and uncacheable files.
+      void
+      sendAsset(Connection* conn, TupleList& headers, const Path& file)
+      {
+        const AssetCache::Asset* asset = NULL;
+        if (m_assets != NULL && headers.get("range").empty())
+          asset = m_assets->get(file);
+
+        if (asset == NULL)
+        {
+          sendStaticFile(conn, headers, file);
+          return;
+        }
+
+        bool gzip = !asset->gzip.empty()
+        && headers.get("accept-encoding").find("gzip") != std::string::npos;
+
+        // Each representation has its own entity tag.
+        std::string etag = asset->etag;
+        if (gzip)
+          etag.insert(etag.size() - 1, "-gz");
+
+        RequestHandler::HeaderFieldsMap hdr;
+        hdr["ETag"] = etag;
+        hdr["Vary"] = "Accept-Encoding";
+        if (asset->type == "text/html")
+          hdr["Cache-Control"] = "no-cache";
+        else
+          hdr["Cache-Control"] = String::str("public, max-age=%u", m_args.cache_lifetime);
 
-        sendFile(sock, file.str(), hdr, beg, end);
+        if (headers.get("if-none-match").find(etag) != std::string::npos)
+        {
+          sendResponse304(conn, &hdr);
+          return;
+        }
+
+        if (!asset->type.empty())
+          hdr["Content-Type"] = asset->type;
+
+        if (gzip)
+        {
+          hdr["Content-Encoding"] = "gzip";
+          sendData(conn, asset->gzip.data(), (int)asset->gzip.size(), &hdr);
+        }
+        else
+        {
+          sendData(conn, asset->data.data(), (int)asset->data.size(), &hdr);
+        }
       }
 
+      //! Send a file from the products folder of the log directory
+      //! (e.g., sonar previews).
       void
-      getMessage(TCPSocket* sock, TupleList& headers, const char* uri)
+      sendProduct(Connection* conn, TupleList& headers, const char* uri)
       {
+        std::string file(uri + std::strlen("/dune/products/"));
+        if (file.empty() || file.find("..") != std::string::npos)
+        {
+          sendResponse403(conn);
+          return;
+        }
+
+        sendStaticFile(conn, headers, m_ctx.dir_log / "products" / file);
+      }
+
+      void
+      getMessage(Connection* conn, TupleList& headers, const char* uri)
+      {
+        (void)headers;
         (void)uri;
 
-        unsigned int size = headers.get("content-length", 0);
-        char* bfr = new char[size];
-        sock->read(bfr, size);
-        IMC::Message* msg = IMC::Packet::deserialize((uint8_t*)bfr, size);
+        IMC::Message* msg = IMC::Packet::deserialize((const uint8_t*)conn->getBody(), conn->getBodySize());
         dispatch(msg, DF_KEEP_TIME);
         std::ostringstream ss;
         msg->toText(ss);
-        sendData(sock, ss.str());
+        delete msg;
+        sendData(conn, ss.str());
       }
 
       void
-      setTime(TCPSocket* sock, TupleList& headers, const char* uri)
+      setTime(Connection* conn, TupleList& headers, const char* uri)
       {
         (void)headers;
 
@@ -310,16 +452,16 @@ namespace Transports
         ss >> secs;
         if (ss.fail())
         {
-          sendResponse500(sock);
+          sendResponse500(conn);
           return;
         }
 
-        sendResponse200(sock);
+        sendResponse200(conn);
         Clock::set(secs);
       }
 
       void
-      showMessages(TCPSocket* sock, TupleList& headers, const char* uri)
+      showMessages(Connection* conn, TupleList& headers, const char* uri)
       {
         (void)headers;
         (void)uri;
@@ -329,11 +471,285 @@ namespace Transports
         hdr["Content-Encoding"] = "gzip";
 
         ByteBuffer* bfr = m_msg_mon.messagesJSON();
-        sendData(sock, bfr->getBufferSigned(), bfr->getSize(), &hdr);
+        sendData(conn, bfr->getBufferSigned(), bfr->getSize(), &hdr);
       }
 
+      //! Start a Server-Sent Events stream of message updates. The
+      //! first event holds all messages newer than the
+      //! Last-Event-ID header (all messages if absent), later events
+      //! only the ones updated since.
       void
-      sendVersionJSON(TCPSocket* sock, TupleList& headers, const char* uri)
+      streamMessages(Connection* conn, TupleList& headers, const char* uri)
+      {
+        (void)uri;
+
+        RequestHandler::HeaderFieldsMap hdr;
+        hdr["Content-Type"] = "text/event-stream";
+        hdr["Cache-Control"] = "no-cache";
+        sendStreamHeader(conn, &hdr);
+
+        m_streams[conn] = headers.get("last-event-id", (uint64_t)0);
+        pushMessages(conn, m_streams[conn]);
+      }
+
+      //! Push pending message updates to a stream.
+      //! @param[in] conn connection.
+      //! @param[in,out] seq last sequence number sent.
+      void
+      pushMessages(Connection* conn, uint64_t& seq)
+      {
+        std::string json;
+        if (!m_msg_mon.messagesSince(seq, json, seq))
+          return;
+
+        std::ostringstream os;
+        os << "id: " << seq << "\n"
+           << "data: " << json << "\n\n";
+
+        std::string event = os.str();
+        conn->writeChunk(event.c_str(), event.size());
+      }
+
+      void
+      handleClose(Connection* conn)
+      {
+        m_streams.erase(conn);
+
+        std::map<uint16_t, SeriesQuery>::iterator itr = m_series_queries.begin();
+        while (itr != m_series_queries.end())
+        {
+          if (itr->second.conn == conn)
+            m_series_queries.erase(itr++);
+          else
+            ++itr;
+        }
+      }
+
+      //! Decode the arguments of a query string.
+      //! @param[in] query query string (without '?').
+      //! @param[out] args arguments by name.
+      static void
+      parseQueryString(const std::string& query, std::map<std::string, std::string>& args)
+      {
+        std::vector<std::string> pairs;
+        String::split(query, "&", pairs);
+
+        for (unsigned i = 0; i < pairs.size(); ++i)
+        {
+          size_t eq = pairs[i].find('=');
+          if (eq == std::string::npos)
+            continue;
+
+          std::string value;
+          const std::string& enc = pairs[i];
+          for (size_t j = eq + 1; j < enc.size(); ++j)
+          {
+            if (enc[j] == '+')
+              value += ' ';
+            else if (enc[j] == '%' && j + 2 < enc.size())
+            {
+              value += (char)std::strtol(enc.substr(j + 1, 2).c_str(), NULL, 16);
+              j += 2;
+            }
+            else
+              value += enc[j];
+          }
+
+          args[enc.substr(0, eq)] = value;
+        }
+      }
+
+      //! Forward a time series query to the time series store. The
+      //! reply is sent when the matching TimeSeriesReply arrives.
+      //!   /dune/series/index.js lists the stored series.
+      //!   /dune/series/query.js?series=S&start=T0&end=T1&step=N&aggregate=A
+      //! queries series S (start and end as in TimeSeriesQuery,
+      //! aggregate is one of mean, min, max or last).
+      void
+      querySeries(Connection* conn, TupleList& headers, const char* uri)
+      {
+        (void)headers;
+
+        std::string path(uri);
+        size_t mark = path.find('?');
+        std::string name = path.substr(0, mark);
+
+        IMC::TimeSeriesQuery query;
+        SeriesQuery pending;
+        pending.conn = conn;
+        pending.index = (name == "/dune/series/index.js");
+
+        if (!pending.index)
+        {
+          std::map<std::string, std::string> args;
+          if (mark != std::string::npos)
+            parseQueryString(path.substr(mark + 1), args);
+
+          query.series = args["series"];
+          query.start_time = -3600;
+          query.end_time = 0;
+          query.step = 0;
+          query.aggregate = IMC::TimeSeriesQuery::TSA_MEAN;
+
+          if (args.count("start"))
+            castLexical(args["start"], query.start_time);
+          if (args.count("end"))
+            castLexical(args["end"], query.end_time);
+          if (args.count("step"))
+            castLexical(args["step"], query.step);
+
+          const std::string& aggregate = args["aggregate"];
+          if (aggregate == "min")
+            query.aggregate = IMC::TimeSeriesQuery::TSA_MIN;
+          else if (aggregate == "max")
+            query.aggregate = IMC::TimeSeriesQuery::TSA_MAX;
+          else if (aggregate == "last")
+            query.aggregate = IMC::TimeSeriesQuery::TSA_LAST;
+
+          if (name != "/dune/series/query.js" || query.series.empty())
+          {
+            sendResponse404(conn);
+            return;
+          }
+        }
+
+        RequestHandler::HeaderFieldsMap hdr;
+        hdr["Content-Type"] = "application/json";
+        hdr["Cache-Control"] = "no-cache";
+        sendStreamHeader(conn, &hdr);
+
+        query.req_id = m_series_req_id++;
+        pending.deadline = Clock::get() + c_series_timeout;
+        m_series_queries[query.req_id] = pending;
+        dispatch(query);
+      }
+
+      //! Write a JSON string.
+      static void
+      writeString(std::ostream& os, const std::string& str)
+      {
+        os << '"';
+        for (size_t i = 0; i < str.size(); ++i)
+        {
+          if (str[i] == '"' || str[i] == '\\')
+            os << '\\' << str[i];
+          else if ((unsigned char)str[i] < 0x20)
+            os << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+               << (unsigned)str[i] << std::dec << std::setfill(' ');
+          else
+            os << str[i];
+        }
+        os << '"';
+      }
+
+      //! Write a JSON number, or null if it is not finite.
+      static void
+      writeNumber(std::ostream& os, double value)
+      {
+        if (value == value && value - value == 0)
+          os << value;
+        else
+          os << "null";
+      }
+
+      //! Complete the response of a time series query.
+      //! @param[in] pending query.
+      //! @param[in] json response body.
+      void
+      finishSeriesQuery(const SeriesQuery& pending, const std::string& json)
+      {
+        pending.conn->writeChunk(json.c_str(), json.size());
+        pending.conn->endStream();
+        if (!pending.conn->isKeepAlive())
+          pending.conn->close();
+      }
+
+      void
+      consume(const IMC::TimeSeriesReply* msg)
+      {
+        if (msg->getDestination() != getSystemId() || msg->getDestinationEntity() != getEntityId())
+          return;
+
+        std::map<uint16_t, SeriesQuery>::iterator itr = m_series_queries.find(msg->req_id);
+        if (itr == m_series_queries.end())
+          return;
+
+        std::ostringstream os;
+        os << std::setprecision(10);
+
+        if (itr->second.index)
+        {
+          std::vector<std::string> names;
+          if (!msg->series.empty())
+            String::split(msg->series, ",", names);
+
+          os << "{\"series\":[";
+          for (unsigned i = 0; i < names.size(); ++i)
+          {
+            os << (i ? "," : "");
+            writeString(os, names[i]);
+          }
+          os << "]}";
+        }
+        else
+        {
+          static const char* c_status[] = {"success", "truncated", "unknown"};
+
+          os << "{\"series\":";
+          writeString(os, msg->series);
+          os << ",\"status\":\"" << c_status[std::min(msg->status, (uint8_t)2)] << "\","
+             << "\"step\":" << msg->step << ","
+             << "\"count\":" << msg->count << ","
+             << "\"min\":";
+          writeNumber(os, msg->min);
+          os << ",\"max\":";
+          writeNumber(os, msg->max);
+          os << ",\"mean\":";
+          writeNumber(os, msg->mean);
+          os << ",\"samples\":[";
+
+          if (!msg->data.empty())
+          {
+            Compression::TimeSeriesChunk::Reader reader((const uint8_t*)&msg->data[0], msg->data.size());
+            int64_t time = 0;
+            double value = 0;
+            for (unsigned i = 0; reader.next(time, value); ++i)
+            {
+              os << (i ? ",[" : "[") << time << ",";
+              writeNumber(os, value);
+              os << "]";
+            }
+          }
+
+          os << "]}";
+        }
+
+        finishSeriesQuery(itr->second, os.str());
+        m_series_queries.erase(itr);
+      }
+
+      //! Answer time series queries that timed out.
+      void
+      expireSeriesQueries(void)
+      {
+        double now = Clock::get();
+        std::map<uint16_t, SeriesQuery>::iterator itr = m_series_queries.begin();
+        while (itr != m_series_queries.end())
+        {
+          if (itr->second.deadline < now)
+          {
+            finishSeriesQuery(itr->second, "{\"status\":\"timeout\"}");
+            m_series_queries.erase(itr++);
+          }
+          else
+          {
+            ++itr;
+          }
+        }
+      }
+
+      void
+      sendVersionJSON(Connection* conn, TupleList& headers, const char* uri)
       {
         (void)headers;
         (void)uri;
@@ -342,11 +758,78 @@ namespace Transports
         os << "var systemVersion = '" << getFullVersion() << " - " << getCompileDate() << "';";
         RequestHandler::HeaderFieldsMap hdr;
         hdr["Content-Type"] = "text/javascript";
-        sendData(sock, os.str(), &hdr);
+        sendData(conn, os.str(), &hdr);
       }
 
+      //! Send the summaries of the stored logs as a JSON array.
+      //! Message counts are keyed by message identification number.
       void
-      sendAgentJSON(TCPSocket* sock, TupleList& headers, const char* uri)
+      sendLogIndex(Connection* conn, TupleList& headers, const char* uri)
+      {
+        (void)headers;
+        (void)uri;
+
+        std::vector<IMC::LogCatalog::Summary> logs;
+        m_logs.get(logs);
+
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3) << "[";
+        for (size_t i = 0; i < logs.size(); ++i)
+        {
+          const IMC::LogCatalog::Summary& log = logs[i];
+          if (i > 0)
+            os << ",";
+
+          os << "{\"name\":\"" << log.name << "\""
+             << ",\"file\":\"" << log.file << "\""
+             << ",\"size\":" << log.size;
+
+          if (log.indexed)
+          {
+            os << ",\"start\":" << log.start
+               << ",\"end\":" << log.end
+               << ",\"counts\":{";
+
+            std::map<uint16_t, uint32_t>::const_iterator itr = log.counts.begin();
+            for (; itr != log.counts.end(); ++itr)
+            {
+              if (itr != log.counts.begin())
+                os << ",";
+              os << "\"" << itr->first << "\":" << itr->second;
+            }
+
+            os << "}";
+          }
+
+          os << "}";
+        }
+        os << "]";
+
+        RequestHandler::HeaderFieldsMap hdr;
+        hdr["Content-Type"] = "application/json";
+        sendData(conn, os.str(), &hdr);
+      }
+
+      void
+      sendSchema(Connection* conn, TupleList& headers, const char* uri)
+      {
+        (void)uri;
+
+        RequestHandler::HeaderFieldsMap hdr;
+        hdr["ETag"] = String::str("\"%s\"", IMC::Blob::getDigest());
+
+        if (headers.get("if-none-match") == hdr["ETag"])
+        {
+          sendResponse304(conn, &hdr);
+          return;
+        }
+
+        hdr["Content-Type"] = "text/xml";
+        sendData(conn, IMC::Schema::getDocument(), &hdr);
+      }
+
+      void
+      sendAgentJSON(Connection* conn, TupleList& headers, const char* uri)
       {
         (void)headers;
         (void)uri;
@@ -355,11 +838,11 @@ namespace Transports
         os << "var systemName = '" << m_agent << "';";
         RequestHandler::HeaderFieldsMap hdr;
         hdr["Content-Type"] = "text/javascript";
-        sendData(sock, os.str(), &hdr);
+        sendData(conn, os.str(), &hdr);
       }
 
       void
-      handlePowerChannel(TCPSocket* sock, TupleList& headers, const char* uri)
+      handlePowerChannel(Connection* conn, TupleList& headers, const char* uri)
       {
         (void)headers;
 
@@ -369,7 +852,7 @@ namespace Transports
 
         if (parts.size() != 2 && parts.size() != 5)
         {
-          sendResponse500(sock);
+          sendResponse500(conn);
           return;
         }
 
@@ -379,7 +862,7 @@ namespace Transports
           unsigned t = 0;
           if (!castLexical(parts[2], t))
           {
-            sendResponse500(sock);
+            sendResponse500(conn);
             return;
           }
           else
@@ -387,7 +870,7 @@ namespace Transports
 
           if (!castLexical(parts[3], t))
           {
-            sendResponse500(sock);
+            sendResponse500(conn);
             return;
           }
           else
@@ -395,7 +878,7 @@ namespace Transports
 
           if (!castLexical(parts[4], t))
           {
-            sendResponse500(sock);
+            sendResponse500(conn);
             return;
           }
           else
@@ -422,7 +905,7 @@ namespace Transports
           pcc.sched_time = sched_time;
         }
 
-        sendResponse200(sock);
+        sendResponse200(conn);
         dispatch(pcc);
       }
 
@@ -432,8 +915,22 @@ namespace Transports
         while (!stopping())
         {
           setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
-          m_server->poll(1.0);
+          double timeout = m_streams.empty() ? 1.0 : m_stream_timer.getRemaining();
+          if (!m_series_queries.empty())
+            timeout = std::min(timeout, 0.1);
+
+          m_server->poll(timeout);
           consumeMessages();
+          expireSeriesQueries();
+
+          if (m_stream_timer.overflow())
+          {
+            m_stream_timer.reset();
+
+            std::map<Connection*, uint64_t>::iterator itr = m_streams.begin();
+            for (; itr != m_streams.end(); ++itr)
+              pushMessages(itr->first, itr->second);
+          }
         }
       }
     };
@@ -156,8 +156,26 @@ namespace Transports
       void
       consume(const IMC::IridiumMsgRx* msg)
       {
-        DUNE::IMC::IridiumMessage * m = DUNE::IMC::IridiumMessage::deserialize(msg);
+        handleIridiumMessage(DUNE::IMC::IridiumMessage::deserialize(msg));
+      }
+
+      void
+      handleIridiumBundle(IridiumBundle * bundle)
+      {
+        debug("received Iridium bundle with %d messages", (int)bundle->parts.size());
+        for (size_t i = 0; i < bundle->parts.size(); ++i)
+        {
+          if (bundle->parts[i].empty())
+            continue;
 
+          const std::vector<uint8_t>& part = bundle->parts[i];
+          handleIridiumMessage(DUNE::IMC::IridiumMessage::parse(&part[0], part.size()));
+        }
+      }
+
+      void
+      handleIridiumMessage(DUNE::IMC::IridiumMessage * m)
+      {
         if (m == NULL)
         {
           war(DTR("error while parsing Iridium message"));
@@ -166,6 +184,9 @@ namespace Transports
 
         switch (m->msg_id)
         {
+          case (ID_BUNDLE):
+            handleIridiumBundle(dynamic_cast<IridiumBundle *>(m));
+            break;
           case (ID_ACTIVATESUB):
             debug("Received an Iridium subscription request. WTF?");
             break;
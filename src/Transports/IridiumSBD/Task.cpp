@@ -26,7 +26,9 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
-#include <queue>
+#include <algorithm>
+#include <list>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -44,6 +46,8 @@ namespace Transports
 
     //! Power on delay.
     static const double c_pwr_on_delay = 5.0;
+    //! Maximum size of MO messages.
+    static const unsigned c_mo_size = 340;
 
     //! %Task arguments.
     struct Arguments
@@ -58,6 +62,18 @@ namespace Transports
       unsigned max_tx_rate;
       //! Power channel name.
       std::string pwr_name;
+      //! Messages sent ahead of others.
+      std::vector<std::string> urgent_msgs;
+      //! Messages made obsolete by newer ones.
+      std::vector<std::string> superseded_msgs;
+      //! Send several messages per session.
+      bool pack;
+      //! Minimum signal quality to transmit non urgent messages.
+      float rssi_min;
+      //! Minimum delay after a failed session.
+      double retry_min;
+      //! Maximum delay after a failed session.
+      double retry_max;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -74,8 +90,18 @@ namespace Transports
       Counter<double> m_mbox_check_timer;
       //! Task arguments.
       Arguments m_args;
-      //! Active transmission request.
-      TxRequest* m_tx_request;
+      //! Transmission requests of the active session.
+      std::list<TxRequest*> m_tx_active;
+      //! Data of the active session.
+      std::vector<uint8_t> m_tx_data;
+      //! Identifiers of urgent messages.
+      std::set<uint16_t> m_urgent;
+      //! Identifiers of superseded messages.
+      std::set<uint16_t> m_superseded;
+      //! Delay after the last failed session.
+      double m_retry_delay;
+      //! Retry timer.
+      Counter<double> m_retry_timer;
 
       //! Constructor.
       //! @param[in] name task name.
@@ -84,7 +110,7 @@ namespace Transports
         DUNE::Tasks::Task(name, ctx),
         m_uart(NULL),
         m_driver(NULL),
-        m_tx_request(NULL)
+        m_retry_delay(0)
       {
         param("Serial Port - Device", m_args.uart_dev)
         .defaultValue("")
@@ -109,6 +135,41 @@ namespace Transports
         .defaultValue("0")
         .description("");
 
+        param("Urgent Messages", m_args.urgent_msgs)
+        .defaultValue("Abort, TextMessage")
+        .description("Messages transmitted ahead of all others");
+
+        param("Superseded Messages", m_args.superseded_msgs)
+        .defaultValue("EstimatedState, GpsFix, FuelLevel, PlanControlState, VehicleState")
+        .description("Messages discarded when a newer one for the same"
+                     " systems is queued (device updates always are)");
+
+        param("Pack Messages", m_args.pack)
+        .defaultValue("false")
+        .description("Send several queued messages in each session, as an"
+                     " Iridium bundle. Receivers must understand bundles");
+
+        param("Minimum Signal Quality", m_args.rssi_min)
+        .units(Units::Percentage)
+        .minimumValue("0")
+        .maximumValue("100")
+        .defaultValue("20")
+        .description("Signal quality needed to transmit non urgent messages."
+                     " Urgent messages are transmitted with any signal");
+
+        param("Retry Delay - Minimum", m_args.retry_min)
+        .units(Units::Second)
+        .minimumValue("0")
+        .defaultValue("15")
+        .description("Delay after a failed session, doubled after each"
+                     " consecutive failure");
+
+        param("Retry Delay - Maximum", m_args.retry_max)
+        .units(Units::Second)
+        .minimumValue("0")
+        .defaultValue("600")
+        .description("Maximum delay after failed sessions");
+
         bind<IMC::IridiumMsgTx>(this);
         bind<IMC::IoEvent>(this);
       }
@@ -116,7 +177,11 @@ namespace Transports
       //! Destructor.
       ~Task(void)
       {
-        Memory::clear(m_tx_request);
+        while (!m_tx_active.empty())
+        {
+          delete m_tx_active.front();
+          m_tx_active.pop_front();
+        }
 
         while (!m_tx_requests.empty())
         {
@@ -135,6 +200,15 @@ namespace Transports
         m_mbox_check_timer.setTop(m_args.mbox_check_per);
         if (m_driver != NULL)
           m_driver->setTxRateMax(m_args.max_tx_rate);
+
+        m_urgent.clear();
+        for (size_t i = 0; i < m_args.urgent_msgs.size(); ++i)
+          m_urgent.insert(IMC::Factory::getIdFromAbbrev(m_args.urgent_msgs[i]));
+
+        m_superseded.clear();
+        m_superseded.insert(IMC::ID_DEVICEUPDATE);
+        for (size_t i = 0; i < m_args.superseded_msgs.size(); ++i)
+          m_superseded.insert(IMC::Factory::getIdFromAbbrev(m_args.superseded_msgs[i]));
       }
 
       //! Reserve entity identifiers.
@@ -217,17 +291,52 @@ namespace Transports
       consume(const IMC::IridiumMsgTx* msg)
       {
         // FIXME: check if req_id already exists.
-        // FIXME: check MTU.
         debug("queueing message");
         unsigned src_adr = msg->getSource();
         unsigned src_eid = msg->getSourceEntity();
         TxRequest* request = new TxRequest(src_adr, src_eid, msg->req_id,
                                            msg->ttl, msg->data);
 
+        if (msg->data.size() > c_mo_size)
+        {
+          sendTxRequestStatus(request, IMC::IridiumTxStatus::TXSTATUS_ERROR,
+                              String::str(DTR("message is larger than %u bytes"), c_mo_size));
+          delete request;
+          return;
+        }
+
+        if (m_urgent.find(request->getMessageId()) != m_urgent.end())
+          request->setPriority(1);
+
+        if (m_superseded.find(request->getMessageId()) != m_superseded.end())
+          removeSuperseded(request);
+
         enqueueTxRequest(request);
         sendTxRequestStatus(request, IMC::IridiumTxStatus::TXSTATUS_QUEUED);
       }
 
+      //! Remove queued requests made obsolete by a new one.
+      //! @param[in] request new request.
+      void
+      removeSuperseded(const TxRequest* request)
+      {
+        std::list<TxRequest*>::iterator itr = m_tx_requests.begin();
+        while (itr != m_tx_requests.end())
+        {
+          if (!request->supersedes(**itr))
+          {
+            ++itr;
+            continue;
+          }
+
+          spew("removing superseded");
+          sendTxRequestStatus(*itr, IMC::IridiumTxStatus::TXSTATUS_EXPIRED,
+                              DTR("superseded by a newer message"));
+          delete *itr;
+          itr = m_tx_requests.erase(itr);
+        }
+      }
+
       void
       sendTxRequestStatus(const TxRequest* request,
                           IMC::IridiumTxStatus::StatusCodeEnum code,
@@ -242,13 +351,18 @@ namespace Transports
         dispatch(status);
       }
 
+      //! Queue a request by priority and, within the same priority,
+      //! by expiration time.
+      //! @param[in] request transmission request.
       void
       enqueueTxRequest(TxRequest* request)
       {
         std::list<TxRequest*>::iterator itr = m_tx_requests.begin();
         for ( ; itr != m_tx_requests.end(); ++itr)
         {
-          if (request->getExpiration() < (*itr)->getExpiration())
+          if (request->getPriority() > (*itr)->getPriority()
+              || (request->getPriority() == (*itr)->getPriority()
+                  && request->getExpiration() < (*itr)->getExpiration()))
           {
             m_tx_requests.insert(itr, request);
             return;
@@ -258,38 +372,104 @@ namespace Transports
         m_tx_requests.insert(m_tx_requests.end(), request);
       }
 
+      //! Select the requests of the next session: the first queued
+      //! request and, if packing is enabled, as many of the following
+      //! ones as fit in an Iridium bundle.
+      void
+      selectTxRequests(void)
+      {
+        TxRequest* first = m_tx_requests.front();
+        m_tx_requests.pop_front();
+        m_tx_active.push_back(first);
+        m_tx_data = first->getData();
+
+        if (!m_args.pack)
+          return;
+
+        // Bundle header and size of the first message.
+        unsigned size = 6 + 2 + first->getData().size();
+        std::list<TxRequest*>::iterator itr = m_tx_requests.begin();
+        while (itr != m_tx_requests.end())
+        {
+          unsigned part = 2 + (*itr)->getData().size();
+          if (size + part > c_mo_size)
+          {
+            ++itr;
+            continue;
+          }
+
+          size += part;
+          m_tx_active.push_back(*itr);
+          itr = m_tx_requests.erase(itr);
+        }
+
+        if (m_tx_active.size() == 1)
+          return;
+
+        IMC::IridiumBundle bundle;
+        bundle.source = getSystemId();
+        bundle.destination = 0xFFFF;
+        for (itr = m_tx_active.begin(); itr != m_tx_active.end(); ++itr)
+          bundle.parts.push_back((*itr)->getData());
+
+        m_tx_data.resize(c_mo_size);
+        m_tx_data.resize(bundle.serialize(&m_tx_data[0]));
+        debug("packed %u messages in %u bytes", (unsigned)m_tx_active.size(),
+              (unsigned)m_tx_data.size());
+      }
+
       void
       dequeueTxRequest(unsigned msn)
       {
-        if (m_tx_request == NULL)
+        if (m_tx_active.empty())
           return;
 
-        if (!m_tx_request->hasValidMSN() || (m_tx_request->getMSN() != msn))
+        TxRequest* first = m_tx_active.front();
+        if (!first->hasValidMSN() || (first->getMSN() != msn))
           return;
 
         debug("dequeing message");
         m_driver->clearBufferMO();
-        sendTxRequestStatus(m_tx_request, IMC::IridiumTxStatus::TXSTATUS_OK);
-        Memory::clear(m_tx_request);
+        while (!m_tx_active.empty())
+        {
+          sendTxRequestStatus(m_tx_active.front(), IMC::IridiumTxStatus::TXSTATUS_OK);
+          delete m_tx_active.front();
+          m_tx_active.pop_front();
+        }
       }
 
       void
       invalidateTxRequest(unsigned msn, unsigned err_code)
       {
-        if (m_tx_request == NULL)
+        if (m_tx_active.empty())
           return;
 
-        if (!m_tx_request->hasValidMSN() || (m_tx_request->getMSN() != msn))
+        TxRequest* first = m_tx_active.front();
+        if (!first->hasValidMSN() || (first->getMSN() != msn))
           return;
 
         debug("invalidating MSN");
-        m_tx_request->invalidateMSN();
-
-        sendTxRequestStatus(m_tx_request, IMC::IridiumTxStatus::TXSTATUS_ERROR,
-                            String::str(DTR("failed with error %u"), err_code));
+        while (!m_tx_active.empty())
+        {
+          TxRequest* request = m_tx_active.front();
+          m_tx_active.pop_front();
+          request->invalidateMSN();
+          sendTxRequestStatus(request, IMC::IridiumTxStatus::TXSTATUS_ERROR,
+                              String::str(DTR("failed with error %u"), err_code));
+          enqueueTxRequest(request);
+        }
+      }
 
-        enqueueTxRequest(m_tx_request);
-        m_tx_request = NULL;
+      //! Test if the signal is good enough to transmit.
+      //! @param[in] priority priority of the next request.
+      //! @return true to transmit, false otherwise.
+      bool
+      canTransmit(int priority)
+      {
+        float rssi = m_driver->getRSSI();
+        if (priority > 0)
+          return rssi > 0.1;
+        return rssi > 0.1 && rssi >= m_args.rssi_min;
       }
 
       void
@@ -317,6 +497,7 @@ namespace Transports
 
         if (res.isSuccessMO())
         {
+          m_retry_delay = 0;
           m_mbox_check_timer.reset();
           dequeueTxRequest(res.getSequenceMO());
           if (m_driver->hasRingAlert())
@@ -327,6 +508,10 @@ namespace Transports
           war(DTR("transmission failed: %s"),
               SessionResultCode::translate(res.getStatusMO()).c_str());
 
+          // Back off while the link is bad.
+          m_retry_delay = std::max(m_args.retry_min, std::min(m_args.retry_max, m_retry_delay * 2.0));
+          m_retry_timer.setTop(m_retry_delay);
+
           invalidateTxRequest(res.getSequenceMO(), res.getStatusMO());
         }
 
@@ -340,8 +525,12 @@ namespace Transports
         std::list<TxRequest*>::iterator itr = m_tx_requests.begin();
         while (itr != m_tx_requests.end())
         {
+          // Queue is sorted by priority first.
           if (!(*itr)->hasExpired())
-            break;
+          {
+            ++itr;
+            continue;
+          }
 
           spew("removing expired");
           sendTxRequestStatus(*itr, IMC::IridiumTxStatus::TXSTATUS_EXPIRED);
@@ -361,30 +550,38 @@ namespace Transports
         if (m_driver->hasSessionResult())
           handleSessionResult();
 
-        if (m_driver->getRSSI() <= 0.1)
+        if (m_driver->isCooling())
           return;
 
-        if (m_driver->isCooling())
+        if (m_retry_delay > 0 && !m_retry_timer.overflow())
           return;
 
-        if (m_tx_request != NULL)
+        if (m_tx_active.empty() && !m_tx_requests.empty())
         {
+          if (!canTransmit(m_tx_requests.front()->getPriority()))
+            return;
+
+          selectTxRequests();
+        }
+
+        if (!m_tx_active.empty())
+        {
+          if (!canTransmit(m_tx_active.front()->getPriority()))
+            return;
+
           unsigned msn = m_driver->getMOMSN();
-          m_tx_request->setMSN(msn);
-          m_driver->sendSBD(m_tx_request->getData());
+          std::list<TxRequest*>::iterator itr = m_tx_active.begin();
+          for (; itr != m_tx_active.end(); ++itr)
+            (*itr)->setMSN(msn);
+          m_driver->sendSBD(m_tx_data);
         }
-        else if (m_tx_requests.empty())
+        else if (m_driver->getRSSI() > 0.1)
         {
           if (m_driver->hasRingAlert())
             m_driver->checkMailBoxAlert();
           else if ((m_driver->getQueuedMT()) > 0 || m_mbox_check_timer.overflow())
             m_driver->checkMailBox();
         }
-        else
-        {
-          m_tx_request = m_tx_requests.front();
-          m_tx_requests.pop_front();
-        }
       }
 
       //! Main loop.
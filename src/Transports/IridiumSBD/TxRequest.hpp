@@ -28,6 +28,10 @@
 #ifndef TRANSPORTS_IRIDIUM_SBD_TX_REQUEST_HPP_INCLUDED_
 #define TRANSPORTS_IRIDIUM_SBD_TX_REQUEST_HPP_INCLUDED_
 
+// ISO C++ 98 headers.
+#include <cstring>
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
@@ -50,10 +54,15 @@ namespace Transports
         m_src_adr(src_adr),
         m_src_eid(src_eid),
         m_req_id(req_id),
-        m_msn(-1)
+        m_msn(-1),
+        m_msg_src(0),
+        m_msg_dst(0),
+        m_msg_id(c_unknown_id),
+        m_priority(0)
       {
         m_expiration = DUNE::Time::Clock::get() + ttl;
         m_data.insert(m_data.end(), data.begin(), data.end());
+        parseHeader();
       }
 
       //! Retrieve the IMC address of the requester.
@@ -125,6 +134,48 @@ namespace Transports
         return m_expiration;
       }
 
+      //! Retrieve the identifier of the Iridium message being
+      //! transmitted (for compact messages, the identifier of the
+      //! IMC message).
+      //! @return message identifier or c_unknown_id.
+      uint16_t
+      getMessageId(void) const
+      {
+        return m_msg_id;
+      }
+
+      //! Retrieve priority.
+      //! @return priority (higher is more urgent).
+      int
+      getPriority(void) const
+      {
+        return m_priority;
+      }
+
+      //! Set priority.
+      //! @param[in] priority priority (higher is more urgent).
+      void
+      setPriority(int priority)
+      {
+        m_priority = priority;
+      }
+
+      //! Test if this request makes another obsolete, i.e., both
+      //! carry the same message, between the same systems, for the
+      //! same requester.
+      //! @param[in] other older request.
+      //! @return true if this request supersedes the other.
+      bool
+      supersedes(const TxRequest& other) const
+      {
+        return m_msg_id != c_unknown_id
+        && m_msg_id == other.m_msg_id
+        && m_msg_src == other.m_msg_src
+        && m_msg_dst == other.m_msg_dst
+        && m_src_adr == other.m_src_adr
+        && m_src_eid == other.m_src_eid;
+      }
+
       //! Test if request expired.
       //! @return true if request expired, false otherwise.
       bool
@@ -133,6 +184,9 @@ namespace Transports
         return DUNE::Time::Clock::get() > getExpiration();
       }
 
+      //! Identifier of messages of unknown type.
+      static const uint16_t c_unknown_id = 0xFFFF;
+
     private:
       //! Requester IMC address.
       uint16_t m_src_adr;
@@ -146,6 +200,33 @@ namespace Transports
       double m_expiration;
       //! Data to be transmitted.
       std::vector<uint8_t> m_data;
+      //! Source of the Iridium message.
+      uint16_t m_msg_src;
+      //! Destination of the Iridium message.
+      uint16_t m_msg_dst;
+      //! Identifier of the Iridium message.
+      uint16_t m_msg_id;
+      //! Priority.
+      int m_priority;
+
+      //! Read the header of the Iridium message (see
+      //! IridiumMessageDefinitions) to identify the message.
+      void
+      parseHeader(void)
+      {
+        if (m_data.size() < 6)
+          return;
+
+        std::memcpy(&m_msg_src, &m_data[0], 2);
+        std::memcpy(&m_msg_dst, &m_data[2], 2);
+        std::memcpy(&m_msg_id, &m_data[4], 2);
+
+        if (m_msg_id != DUNE::IMC::ID_COMPACT)
+          return;
+
+        if (m_data.size() < 7 || !DUNE::IMC::CompactCodec::getMessageId(m_data[6], m_msg_id))
+          m_msg_id = c_unknown_id;
+      }
     };
   }
 }
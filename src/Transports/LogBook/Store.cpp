@@ -0,0 +1,154 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+
+// Local headers.
+#include "Store.hpp"
+
+namespace Transports
+{
+  namespace LogBook
+  {
+    //! Order entries by search key.
+    struct KeyLess
+    {
+      template <typename Entry>
+      bool
+      operator()(const Entry& entry, double key) const
+      {
+        return entry.key < key;
+      }
+    };
+
+    Store::Store(size_t capacity, size_t err_capacity)
+    {
+      m_capacity[VIEW_ALL] = capacity;
+      m_capacity[VIEW_ERRORS] = err_capacity;
+    }
+
+    void
+    Store::setCapacity(size_t capacity, size_t err_capacity)
+    {
+      m_capacity[VIEW_ALL] = capacity;
+      m_capacity[VIEW_ERRORS] = err_capacity;
+      trim(VIEW_ALL);
+      trim(VIEW_ERRORS);
+    }
+
+    void
+    Store::add(const IMC::LogBookEntry& entry)
+    {
+      Entry e;
+      e.htime = entry.htime;
+      e.key = entry.htime;
+      e.type = entry.type;
+      e.context = intern(entry.context);
+      e.text = intern(entry.text);
+      push(VIEW_ALL, e);
+
+      if (entry.type != IMC::LogBookEntry::LBET_INFO)
+      {
+        ++e.context->second;
+        ++e.text->second;
+        push(VIEW_ERRORS, e);
+      }
+    }
+
+    void
+    Store::clear(void)
+    {
+      m_rings[VIEW_ALL].clear();
+      m_rings[VIEW_ERRORS].clear();
+      m_pool.clear();
+    }
+
+    Store::Slice
+    Store::select(View view, double since) const
+    {
+      const Ring& ring = m_rings[view];
+
+      Slice slice;
+      slice.view = view;
+      slice.begin = std::lower_bound(ring.begin(), ring.end(), since, KeyLess()) - ring.begin();
+      slice.end = ring.size();
+      return slice;
+    }
+
+    void
+    Store::get(View view, size_t pos, IMC::LogBookEntry& entry) const
+    {
+      const Entry& e = m_rings[view][pos];
+      entry.type = e.type;
+      entry.htime = e.htime;
+      entry.context = e.context->first;
+      entry.text = e.text->first;
+    }
+
+    Store::Pool::iterator
+    Store::intern(const std::string& str)
+    {
+      Pool::iterator itr = m_pool.insert(std::make_pair(str, 0u)).first;
+      ++itr->second;
+      return itr;
+    }
+
+    void
+    Store::release(Pool::iterator itr)
+    {
+      if (--itr->second == 0)
+        m_pool.erase(itr);
+    }
+
+    void
+    Store::push(View view, const Entry& entry)
+    {
+      Ring& ring = m_rings[view];
+
+      Entry e = entry;
+      if (!ring.empty())
+        e.key = std::max(e.htime, ring.back().key);
+
+      ring.push_back(e);
+      trim(view);
+    }
+
+    void
+    Store::trim(View view)
+    {
+      Ring& ring = m_rings[view];
+
+      while (ring.size() > m_capacity[view])
+      {
+        release(ring.front().context);
+        release(ring.front().text);
+        ring.pop_front();
+      }
+    }
+  }
+}
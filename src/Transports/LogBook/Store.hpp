@@ -0,0 +1,183 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_LOG_BOOK_STORE_HPP_INCLUDED_
+#define TRANSPORTS_LOG_BOOK_STORE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <map>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace LogBook
+  {
+    using DUNE_NAMESPACES;
+
+    //! Bounded store of logbook entries. Entries are kept in two
+    //! rings, one with all entries and one with entries other than
+    //! information, sharing a pool of interned context and text
+    //! strings. Queries select a contiguous slice of a ring without
+    //! copying and entries are converted to messages on demand.
+    class Store
+    {
+    public:
+      //! Entry views.
+      enum View
+      {
+        //! All entries.
+        VIEW_ALL = 0,
+        //! Entries other than information.
+        VIEW_ERRORS = 1
+      };
+
+      //! Range [begin, end) of positions of a view, oldest first.
+      struct Slice
+      {
+        View view;
+        size_t begin;
+        size_t end;
+
+        size_t
+        size(void) const
+        {
+          return end - begin;
+        }
+      };
+
+      //! Constructor.
+      //! @param[in] capacity maximum number of entries.
+      //! @param[in] err_capacity maximum number of entries other
+      //! than information.
+      Store(size_t capacity, size_t err_capacity);
+
+      //! Change store capacity, evicting the oldest entries if needed.
+      //! @param[in] capacity maximum number of entries.
+      //! @param[in] err_capacity maximum number of entries other
+      //! than information.
+      void
+      setCapacity(size_t capacity, size_t err_capacity);
+
+      //! Add an entry.
+      //! @param[in] entry logbook entry.
+      void
+      add(const IMC::LogBookEntry& entry);
+
+      //! Discard all entries.
+      void
+      clear(void);
+
+      //! Select entries not older than a given time.
+      //! @param[in] view entry view.
+      //! @param[in] since Epoch time.
+      //! @return slice of entries.
+      Slice
+      select(View view, double since) const;
+
+      //! Get number of entries of a view.
+      //! @param[in] view entry view.
+      //! @return number of entries.
+      size_t
+      getSize(View view) const
+      {
+        return m_rings[view].size();
+      }
+
+      //! Get number of distinct strings in the pool.
+      //! @return number of strings.
+      size_t
+      getPoolSize(void) const
+      {
+        return m_pool.size();
+      }
+
+      //! Convert an entry to a message.
+      //! @param[in] view entry view.
+      //! @param[in] pos position of the entry in the view.
+      //! @param[out] entry logbook entry.
+      void
+      get(View view, size_t pos, IMC::LogBookEntry& entry) const;
+
+    private:
+      //! Interned strings and their reference counts.
+      typedef std::map<std::string, unsigned> Pool;
+
+      //! Compact entry.
+      struct Entry
+      {
+        //! Timestamp.
+        double htime;
+        //! Largest timestamp up to this entry, used to search by time
+        //! when timestamps are not monotonic.
+        double key;
+        //! Type.
+        uint8_t type;
+        //! Context.
+        Pool::iterator context;
+        //! Text.
+        Pool::iterator text;
+      };
+
+      typedef std::deque<Entry> Ring;
+
+      //! Rings of each view.
+      Ring m_rings[2];
+      //! Capacity of each view.
+      size_t m_capacity[2];
+      //! String pool.
+      Pool m_pool;
+
+      //! Add a reference to a string.
+      //! @param[in] str string.
+      //! @return pool entry.
+      Pool::iterator
+      intern(const std::string& str);
+
+      //! Drop a reference to a string.
+      //! @param[in] itr pool entry.
+      void
+      release(Pool::iterator itr);
+
+      //! Add an entry to a ring, evicting the oldest if full.
+      //! @param[in] view entry view.
+      //! @param[in] entry compact entry.
+      void
+      push(View view, const Entry& entry);
+
+      //! Evict the oldest entries of a ring exceeding its capacity.
+      //! @param[in] view entry view.
+      void
+      trim(View view);
+    };
+  }
+}
+
+#endif
@@ -28,34 +28,57 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Store.hpp"
+
 namespace Transports
 {
   namespace LogBook
   {
     using DUNE_NAMESPACES;
 
+    struct Arguments
+    {
+      // Maximum number of entries.
+      unsigned capacity;
+      // Maximum number of entries other than information.
+      unsigned err_capacity;
+      // Maximum number of entries per reply.
+      unsigned page_size;
+    };
+
     struct Task: public DUNE::Tasks::Task
     {
-      // Convenience typedef.
-      typedef CircularBuffer<IMC::LogBookEntry> LBEBuffer;
-      // Size for logbook buffer.
-      static const uint32_t c_logbook_sz = 128;
-      // Size for error logbook buffer.
-      static const uint32_t c_elogbook_sz = 32;
       // Start time.
       double m_start_time;
-      // General logbook buffer.
-      LBEBuffer m_logbook;
-      // Error logbook buffer.
-      LBEBuffer m_elogbook;
+      // Logbook entries.
+      Store m_store;
       // Reply message.
       IMC::LogBookControl m_reply;
+      // Task arguments.
+      Arguments m_args;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
-        m_logbook(c_logbook_sz),
-        m_elogbook(c_elogbook_sz)
+        m_store(128, 32)
       {
+        param("Capacity", m_args.capacity)
+        .defaultValue("1024")
+        .minimumValue("1")
+        .description("Maximum number of entries kept");
+
+        param("Error Capacity", m_args.err_capacity)
+        .defaultValue("256")
+        .minimumValue("1")
+        .description("Maximum number of warnings, errors and other"
+                     " non-informative entries kept");
+
+        param("Entries per Reply", m_args.page_size)
+        .defaultValue("32")
+        .minimumValue("1")
+        .description("Maximum number of entries in each reply. Larger"
+                     " results are split across several replies");
+
         m_reply.command = IMC::LogBookControl::LBC_REPLY;
         m_start_time = Time::Clock::getSinceEpoch();
 
@@ -63,6 +86,12 @@ namespace Transports
         bind<IMC::LogBookControl>(this);
       }
 
+      void
+      onUpdateParameters(void)
+      {
+        m_store.setCapacity(m_args.capacity, m_args.err_capacity);
+      }
+
       void
       onResourceInitialization(void)
       {
@@ -72,11 +101,7 @@ namespace Transports
       void
       consume(const IMC::LogBookEntry* h)
       {
-        m_logbook.add(*h);
-
-        if (h->type != IMC::LogBookEntry::LBET_INFO)
-          m_elogbook.add(*h);
-
+        m_store.add(*h);
         report(*h);
       }
 
@@ -86,15 +111,13 @@ namespace Transports
         switch (hc->command)
         {
           case IMC::LogBookControl::LBC_GET:
-            provide(hc->htime, m_logbook);
+            provide(hc->htime, Store::VIEW_ALL);
             break;
           case IMC::LogBookControl::LBC_GET_ERR:
-            // @todo specialize
-            provide(hc->htime, m_elogbook);
+            provide(hc->htime, Store::VIEW_ERRORS);
             break;
           case IMC::LogBookControl::LBC_CLEAR:
-            m_logbook.clear();
-            m_elogbook.clear();
+            m_store.clear();
             inf(DTR("cleared logbook"));
             break;
           default:
@@ -103,25 +126,42 @@ namespace Transports
         }
       }
 
+      //! Send entries not older than a given time, newest first,
+      //! in replies of at most the configured number of entries.
       void
-      provide(double since, LBEBuffer& b)
+      provide(double since, Store::View view)
       {
+        Store::Slice slice = m_store.select(view, since);
         uint32_t count = 0;
-        uint32_t n = b.getSize();
-        int32_t pos;
+        IMC::LogBookEntry entry;
 
-        IMC::MessageList<LogBookEntry>* ml = &m_reply.msg;
+        for (size_t pos = slice.end; pos > slice.begin; --pos)
+        {
+          m_store.get(view, pos - 1, entry);
 
-        for (pos = n-1; pos >= 0; pos--) {
-          if (b(pos).htime < since)
-            break;
-          ml->push_back(b(pos));
-          count++;
+          // Slices may hold entries with out of order timestamps.
+          if (entry.htime < since)
+            continue;
+
+          m_reply.msg.push_back(entry);
+          ++count;
+
+          if (m_reply.msg.size() >= m_args.page_size)
+            sendReply();
         }
 
+        if (m_reply.msg.size() > 0 || count == 0)
+          sendReply();
+
         trace("sending history since %s | %u out of %u messages reported",
-            Time::Format::getTimeDate(since).c_str(), count, n);
+              Time::Format::getTimeDate(since).c_str(), count,
+              (unsigned)m_store.getSize(view));
+      }
 
+      //! Dispatch the reply and clear its entries.
+      void
+      sendReply(void)
+      {
         m_reply.setTimeStamp();
         m_reply.htime = Time::Clock::getSinceEpoch();
         dispatch(m_reply, DF_KEEP_TIME);
@@ -0,0 +1,355 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <list>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Transfer.hpp"
+
+namespace Transports
+{
+  //! Serves the packets of LSF logs over the message bus, so that
+  //! parts of a log can be retrieved through any transport.
+  //!
+  //! Requests (LogTransferRequest) select a log, a time range and a
+  //! set of messages. Matching packets are grouped in compressed
+  //! chunks (LogTransferChunk) sent at a limited rate, and the state
+  //! of the transfer is reported with LogTransferState. Chunks are
+  //! numbered deterministically, so interrupted transfers are resumed
+  //! by requesting them again from the first missing chunk. Logs with
+  //! an index (block logs or logs with Data.lsf.idx) only have the
+  //! blocks that hold matching packets read.
+  namespace LogTransfer
+  {
+    using DUNE_NAMESPACES;
+
+    //! Names of log files, by order of preference.
+    static const char* c_log_files[] =
+    {
+      "Data.lsf.blk",
+      "Data.lsf",
+      "Data.lsf.gz",
+      "Data.lsf.bz2"
+    };
+    //! Number of log file names.
+    static const unsigned c_log_files_count = sizeof(c_log_files) / sizeof(c_log_files[0]);
+
+    struct Arguments
+    {
+      //! Maximum size of uncompressed chunks.
+      unsigned chunk_size;
+      //! Maximum transfer rate.
+      unsigned max_rate;
+      //! Compression method.
+      std::string compression;
+      //! Maximum number of simultaneous transfers.
+      unsigned max_transfers;
+    };
+
+    //! Active transfer.
+    struct Active
+    {
+      //! Chunk producer.
+      Transfer* transfer;
+      //! Source of the request.
+      uint16_t src;
+      //! Source entity of the request.
+      uint8_t src_ent;
+      //! Transfer rate.
+      double rate;
+      //! Time at which the next chunk can be sent.
+      double next;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Compression method.
+      BlockLog::Method m_method;
+      //! Active transfers.
+      std::list<Active> m_transfers;
+      //! Chunk message.
+      IMC::LogTransferChunk m_chunk;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_method(BlockLog::METHOD_ZLIB)
+      {
+        param("Chunk Size", m_args.chunk_size)
+        .defaultValue("4096")
+        .minimumValue("256")
+        .maximumValue("32768")
+        .units(Units::Byte)
+        .description("Maximum size of chunks before compression");
+
+        param("Maximum Rate", m_args.max_rate)
+        .defaultValue("2048")
+        .minimumValue("1")
+        .units(Units::Byte)
+        .description("Maximum rate of each transfer in bytes per second,"
+                     " requests can only ask for lower rates");
+
+        param("Compression", m_args.compression)
+        .defaultValue("zlib")
+        .values("none, lz4, zlib")
+        .description("Compression method of chunks");
+
+        param("Maximum Transfers", m_args.max_transfers)
+        .defaultValue("4")
+        .minimumValue("1")
+        .description("Maximum number of simultaneous transfers");
+
+        bind<IMC::LogTransferRequest>(this);
+      }
+
+      ~Task(void)
+      {
+        onResourceRelease();
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if (!BlockLog::parseMethod(m_args.compression, m_method))
+          throw std::runtime_error(String::str(DTR("invalid compression method: %s"),
+                                               m_args.compression.c_str()));
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        while (!m_transfers.empty())
+        {
+          delete m_transfers.front().transfer;
+          m_transfers.pop_front();
+        }
+      }
+
+      //! Report the state of a transfer.
+      void
+      sendState(uint16_t dst, uint8_t dst_ent, uint16_t req_id, uint8_t state,
+                uint32_t chunks, const std::string& info)
+      {
+        IMC::LogTransferState msg;
+        msg.setDestination(dst);
+        msg.setDestinationEntity(dst_ent);
+        msg.req_id = req_id;
+        msg.state = state;
+        msg.chunks = chunks;
+        msg.info = info;
+        dispatch(msg);
+      }
+
+      //! Find the transfer of a request.
+      std::list<Active>::iterator
+      find(uint16_t src, uint16_t req_id)
+      {
+        std::list<Active>::iterator itr = m_transfers.begin();
+        for (; itr != m_transfers.end(); ++itr)
+        {
+          if (itr->src == src && itr->transfer->getRequest().req_id == req_id)
+            break;
+        }
+
+        return itr;
+      }
+
+      //! Find the file of a log.
+      //! @param[in] name log name.
+      //! @return path of the log file or empty if not found.
+      Path
+      findLog(const std::string& name)
+      {
+        // Only logs below the log directory can be transferred.
+        if (name.empty() || name.find("..") != std::string::npos)
+          return Path();
+
+        Path dir = m_ctx.dir_log / name;
+        for (unsigned i = 0; i < c_log_files_count; ++i)
+        {
+          Path file = dir / c_log_files[i];
+          if (file.isFile())
+            return file;
+        }
+
+        return Path();
+      }
+
+      void
+      consume(const IMC::LogTransferRequest* msg)
+      {
+        if (msg->getDestination() != getSystemId())
+          return;
+
+        std::list<Active>::iterator itr = find(msg->getSource(), msg->req_id);
+        if (itr != m_transfers.end())
+        {
+          // Repeated requests replace the previous ones.
+          delete itr->transfer;
+          m_transfers.erase(itr);
+
+          if (msg->op == IMC::LogTransferRequest::LTR_CANCEL)
+          {
+            sendState(msg->getSource(), msg->getSourceEntity(), msg->req_id,
+                      IMC::LogTransferState::LTS_CANCELLED, 0, DTR("cancelled"));
+          }
+        }
+
+        if (msg->op != IMC::LogTransferRequest::LTR_FETCH)
+          return;
+
+        if (m_transfers.size() >= m_args.max_transfers)
+        {
+          sendState(msg->getSource(), msg->getSourceEntity(), msg->req_id,
+                    IMC::LogTransferState::LTS_ERROR, 0, DTR("too many transfers"));
+          return;
+        }
+
+        Path file = findLog(msg->log);
+        if (file.str().empty())
+        {
+          sendState(msg->getSource(), msg->getSourceEntity(), msg->req_id,
+                    IMC::LogTransferState::LTS_ERROR, 0, DTR("log not found"));
+          return;
+        }
+
+        Active active;
+        try
+        {
+          active.transfer = new Transfer(file.str(), *msg, m_args.chunk_size, m_method);
+        }
+        catch (std::exception& e)
+        {
+          sendState(msg->getSource(), msg->getSourceEntity(), msg->req_id,
+                    IMC::LogTransferState::LTS_ERROR, 0, e.what());
+          return;
+        }
+
+        active.src = msg->getSource();
+        active.src_ent = msg->getSourceEntity();
+        active.rate = m_args.max_rate;
+        if (msg->rate > 0)
+          active.rate = std::min(active.rate, (double)msg->rate);
+        active.next = Clock::get();
+        m_transfers.push_back(active);
+
+        inf(DTR("transferring log '%s' to %s"), msg->log.c_str(),
+            resolveSystemId(msg->getSource()));
+
+        sendState(msg->getSource(), msg->getSourceEntity(), msg->req_id,
+                  IMC::LogTransferState::LTS_ACCEPTED, msg->first_chunk, file.str());
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      //! Send the next chunk of a transfer.
+      //! @param[in] active transfer.
+      //! @param[in] now current time.
+      //! @return false if the transfer ended.
+      bool
+      sendChunk(Active& active, double now)
+      {
+        const IMC::LogTransferRequest& req = active.transfer->getRequest();
+
+        try
+        {
+          if (!active.transfer->next(m_chunk))
+          {
+            sendState(active.src, active.src_ent, req.req_id, IMC::LogTransferState::LTS_DONE,
+                      active.transfer->getChunkCount(), DTR("done"));
+            return false;
+          }
+        }
+        catch (std::exception& e)
+        {
+          sendState(active.src, active.src_ent, req.req_id, IMC::LogTransferState::LTS_ERROR,
+                    active.transfer->getChunkCount(), e.what());
+          return false;
+        }
+
+        m_chunk.setDestination(active.src);
+        m_chunk.setDestinationEntity(active.src_ent);
+        dispatch(m_chunk);
+
+        active.next = now + m_chunk.data.size() / active.rate;
+        return true;
+      }
+
+      //! Send the chunks that are due.
+      //! @return time until the next chunk is due.
+      double
+      serviceTransfers(void)
+      {
+        double now = Clock::get();
+        double wait = 1.0;
+
+        std::list<Active>::iterator itr = m_transfers.begin();
+        while (itr != m_transfers.end())
+        {
+          if (itr->next <= now && !sendChunk(*itr, now))
+          {
+            delete itr->transfer;
+            itr = m_transfers.erase(itr);
+
+            if (m_transfers.empty())
+              setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
+            continue;
+          }
+
+          wait = std::min(wait, itr->next - now);
+          ++itr;
+        }
+
+        return std::max(wait, 0.0);
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          double wait = serviceTransfers();
+          waitForMessages(wait);
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -0,0 +1,192 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_LOG_TRANSFER_TRANSFER_HPP_INCLUDED_
+#define TRANSPORTS_LOG_TRANSFER_TRANSFER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace LogTransfer
+  {
+    using DUNE_NAMESPACES;
+
+    //! Splits the packets of a log that match a request in chunks.
+    //! Chunks hold whole packets and are only closed when the next
+    //! packet does not fit, so the same request always produces the
+    //! same chunks and transfers can be resumed by number.
+    class Transfer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] path path of the log.
+      //! @param[in] req transfer request.
+      //! @param[in] chunk_size maximum size of uncompressed chunks.
+      //! @param[in] method compression method of chunks.
+      Transfer(const std::string& path, const IMC::LogTransferRequest& req,
+               unsigned chunk_size, BlockLog::Method method):
+        m_reader(path),
+        m_req(req),
+        m_chunk_size(chunk_size),
+        m_method(method),
+        m_comp(BlockLog::createCompressor(method)),
+        m_chunk(0),
+        m_done(false)
+      {
+        std::set<uint16_t> ids;
+        std::vector<std::string> abbrevs;
+        String::split(req.msgs, ",", abbrevs);
+        for (unsigned i = 0; i < abbrevs.size(); ++i)
+          ids.insert(IMC::Factory::getIdFromAbbrev(abbrevs[i]));
+
+        m_reader.setFilter(ids);
+        m_reader.setTimeRange(req.start_time, req.end_time);
+      }
+
+      ~Transfer(void)
+      {
+        delete m_comp;
+      }
+
+      //! Get the request of the transfer.
+      //! @return transfer request.
+      const IMC::LogTransferRequest&
+      getRequest(void) const
+      {
+        return m_req;
+      }
+
+      //! Get the number of chunks produced so far.
+      //! @return number of chunks.
+      uint32_t
+      getChunkCount(void) const
+      {
+        return m_chunk;
+      }
+
+      //! Test if all chunks were produced.
+      //! @return true if the transfer is finished.
+      bool
+      isDone(void) const
+      {
+        return m_done;
+      }
+
+      //! Produce the next chunk that must be sent, skipping chunks
+      //! before the first requested one.
+      //! @param[out] msg chunk message.
+      //! @return true if a chunk was produced, false at the end of
+      //! the transfer.
+      bool
+      next(IMC::LogTransferChunk& msg)
+      {
+        while (fill())
+        {
+          uint32_t number = m_chunk++;
+          if (number < m_req.first_chunk)
+            continue;
+
+          msg.req_id = m_req.req_id;
+          msg.chunk = number;
+          msg.method = m_method;
+          msg.usize = m_data.size();
+
+          if (m_comp == NULL)
+          {
+            msg.data = m_data;
+          }
+          else
+          {
+            m_comp->compress(m_bfr, &m_data[0], m_data.size());
+            msg.data.assign(m_bfr.getBufferSigned(), m_bfr.getBufferSigned() + m_bfr.getSize());
+          }
+
+          return true;
+        }
+
+        m_done = true;
+        return false;
+      }
+
+    private:
+      //! Log reader.
+      LogReader m_reader;
+      //! Transfer request.
+      IMC::LogTransferRequest m_req;
+      //! Maximum size of uncompressed chunks.
+      unsigned m_chunk_size;
+      //! Compression method.
+      BlockLog::Method m_method;
+      //! Compressor (NULL for uncompressed chunks).
+      Compression::Compressor* m_comp;
+      //! Number of the next chunk.
+      uint32_t m_chunk;
+      //! True if the end of the log was reached.
+      bool m_done;
+      //! Uncompressed chunk data.
+      std::vector<char> m_data;
+      //! Packet that did not fit in the previous chunk.
+      std::vector<char> m_carry;
+      //! Compressed chunk data.
+      Utils::ByteBuffer m_bfr;
+
+      //! Collect the packets of the next chunk.
+      //! @return true if the chunk has packets.
+      bool
+      fill(void)
+      {
+        m_data.swap(m_carry);
+        m_carry.clear();
+
+        const LogReader::Record* rec = NULL;
+        while ((rec = m_reader.next()) != NULL)
+        {
+          const char* data = reinterpret_cast<const char*>(rec->getData());
+
+          if (!m_data.empty() && m_data.size() + rec->getSize() > m_chunk_size)
+          {
+            m_carry.assign(data, data + rec->getSize());
+            break;
+          }
+
+          m_data.insert(m_data.end(), data, data + rec->getSize());
+        }
+
+        return !m_data.empty();
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,375 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_LOGGING_BLOCK_OUTPUT_HPP_INCLUDED_
+#define TRANSPORTS_LOGGING_BLOCK_OUTPUT_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Logging
+  {
+    using DUNE_NAMESPACES;
+
+    //! Output of block logs (see IMC::BlockLog). Blocks are indexed
+    //! by the writer thread and compressed by a pool of worker
+    //! threads, compressed blocks are written in submission order.
+    //! All functions must be called from the writer thread.
+    class BlockOutput
+    {
+    public:
+      //! Block of serialized data.
+      typedef Utils::ByteBuffer Block;
+
+      //! Constructor.
+      //! @param[in] path file path.
+      //! @param[in] method compression method.
+      //! @param[in] workers number of compression threads.
+      //! @param[in] free queue that receives blocks once their data
+      //! is no longer needed.
+      BlockOutput(const std::string& path, BlockLog::Method method, unsigned workers,
+                  Concurrency::MPSCQueue<Block*>& free):
+        m_ofs(path.c_str(), std::ios::binary),
+        m_method(method),
+        m_free(free),
+        m_done(c_max_jobs_per_worker * std::max(workers, 1U)),
+        m_next(0),
+        m_max_pending(c_max_jobs_per_worker * std::max(workers, 1U)),
+        m_offset(0),
+        m_error(false),
+        m_closed(false)
+      {
+        BlockLog::writeHeader(m_ofs, m_method);
+        m_offset = m_ofs.tellp();
+
+        if (m_method == BlockLog::METHOD_NONE)
+          return;
+
+        for (unsigned i = 0; i < std::max(workers, 1U); ++i)
+        {
+          Worker* worker = new Worker(m_method, m_done, m_free);
+          m_workers.push_back(worker);
+          worker->start();
+        }
+      }
+
+      //! Destructor. Writes all pending blocks and the index.
+      ~BlockOutput(void)
+      {
+        try
+        {
+          close();
+        }
+        catch (...)
+        { }
+
+        for (unsigned i = 0; i < m_workers.size(); ++i)
+          delete m_workers[i];
+
+        for (unsigned i = 0; i < m_jobs.size(); ++i)
+          delete m_jobs[i];
+      }
+
+      //! Write a block.
+      //! @param[in] block block, returned through the free queue.
+      void
+      write(Block* block)
+      {
+        Job* job = getJob();
+        job->block = block;
+        index(job->entry, block->getBuffer(), block->getSize());
+
+        if (m_workers.empty())
+        {
+          job->data.write(block->getBuffer(), block->getSize());
+          job->entry.size = block->getSize();
+          job->done = true;
+          m_free.push(block);
+          m_pending.push_back(job);
+          writeCompleted();
+          return;
+        }
+
+        m_pending.push_back(job);
+        Worker* worker = m_workers[m_next];
+        m_next = (m_next + 1) % m_workers.size();
+        // Worker queues hold at least m_max_pending jobs.
+        worker->push(job);
+
+        while (m_pending.size() >= m_max_pending)
+          waitCompleted();
+
+        writeCompleted();
+      }
+
+      //! Write all pending blocks and flush the file.
+      void
+      flush(void)
+      {
+        while (!m_pending.empty())
+          waitCompleted();
+
+        m_ofs.flush();
+      }
+
+      //! Write all pending blocks and the index, and close the file.
+      void
+      close(void)
+      {
+        if (m_closed)
+          return;
+
+        flush();
+        m_closed = true;
+        BlockLog::writeIndex(m_ofs, m_index);
+        m_ofs.close();
+      }
+
+      //! Test if an error happened.
+      //! @return true if writing or compressing failed.
+      bool
+      fail(void)
+      {
+        return m_error || m_ofs.fail();
+      }
+
+    private:
+      //! Maximum number of jobs in flight per worker.
+      static const unsigned c_max_jobs_per_worker = 4;
+
+      //! Block compression job.
+      struct Job
+      {
+        //! Uncompressed block.
+        Block* block;
+        //! Compressed data.
+        Utils::ByteBuffer data;
+        //! Index entry.
+        BlockLog::Entry entry;
+        //! True if compression failed.
+        bool error;
+        //! True if the worker is done (only used by the writer thread).
+        bool done;
+      };
+
+      //! Compression thread.
+      class Worker: public Concurrency::Thread
+      {
+      public:
+        Worker(BlockLog::Method method, Concurrency::MPSCQueue<Job*>& done,
+               Concurrency::MPSCQueue<Block*>& free):
+          m_jobs(c_max_jobs_per_worker * 2),
+          m_done(done),
+          m_free(free),
+          m_compressor(BlockLog::createCompressor(method))
+        { }
+
+        ~Worker(void)
+        {
+          stop();
+          m_jobs.wakeup();
+          join();
+          delete m_compressor;
+        }
+
+        void
+        push(Job* job)
+        {
+          while (!m_jobs.push(job))
+            Delay::wait(0.001);
+        }
+
+      private:
+        //! Jobs to compress.
+        Concurrency::MPSCQueue<Job*> m_jobs;
+        //! Compressed jobs.
+        Concurrency::MPSCQueue<Job*>& m_done;
+        //! Free blocks.
+        Concurrency::MPSCQueue<Block*>& m_free;
+        //! Compressor.
+        Compression::Compressor* m_compressor;
+
+        void
+        run(void)
+        {
+          Job* job = NULL;
+
+          while (!isStopping())
+          {
+            if (!m_jobs.pop(job))
+            {
+              m_jobs.waitForItems(1.0);
+              continue;
+            }
+
+            try
+            {
+              m_compressor->compress(job->data, job->block->getBufferSigned(), job->block->getSize());
+              job->entry.size = job->data.getSize();
+            }
+            catch (...)
+            {
+              job->error = true;
+            }
+
+            m_free.push(job->block);
+            job->block = NULL;
+
+            while (!m_done.push(job))
+              Delay::wait(0.001);
+          }
+        }
+      };
+
+      //! Output file.
+      std::ofstream m_ofs;
+      //! Compression method.
+      BlockLog::Method m_method;
+      //! Free blocks.
+      Concurrency::MPSCQueue<Block*>& m_free;
+      //! Jobs compressed by workers.
+      Concurrency::MPSCQueue<Job*> m_done;
+      //! Compression threads.
+      std::vector<Worker*> m_workers;
+      //! Next worker.
+      unsigned m_next;
+      //! Maximum number of pending jobs.
+      unsigned m_max_pending;
+      //! Jobs waiting to be written, in submission order.
+      std::deque<Job*> m_pending;
+      //! Unused jobs.
+      std::vector<Job*> m_idle;
+      //! All allocated jobs.
+      std::vector<Job*> m_jobs;
+      //! Block index.
+      std::vector<BlockLog::Entry> m_index;
+      //! Offset of the next block.
+      uint64_t m_offset;
+      //! Packet scanner.
+      IMC::PacketScanner m_scanner;
+      //! Packets of the last scanned block.
+      std::vector<IMC::PacketScanner::Location> m_packets;
+      //! True if compression failed.
+      bool m_error;
+      //! True if the file is closed.
+      bool m_closed;
+
+      //! Get an unused job.
+      //! @return job.
+      Job*
+      getJob(void)
+      {
+        Job* job = NULL;
+        if (m_idle.empty())
+        {
+          job = new Job;
+          m_jobs.push_back(job);
+        }
+        else
+        {
+          job = m_idle.back();
+          m_idle.pop_back();
+        }
+
+        job->block = NULL;
+        job->entry = BlockLog::Entry();
+        job->error = false;
+        job->done = false;
+        return job;
+      }
+
+      //! Record the packets that start in a block.
+      //! @param[out] entry index entry.
+      //! @param[in] data block data.
+      //! @param[in] size block size.
+      void
+      index(BlockLog::Entry& entry, const uint8_t* data, uint32_t size)
+      {
+        entry.usize = size;
+        entry.first = size;
+
+        m_scanner.scan(data, size, m_packets);
+        for (unsigned i = 0; i < m_packets.size(); ++i)
+          entry.add(m_packets[i].pos, m_packets[i].id, m_packets[i].time);
+      }
+
+      //! Wait for at least one job to be compressed.
+      void
+      waitCompleted(void)
+      {
+        if (!m_pending.empty() && !m_pending.front()->done)
+        {
+          m_done.waitForItems(1.0);
+          Job* job = NULL;
+          while (m_done.pop(job))
+            job->done = true;
+        }
+
+        writeCompleted();
+      }
+
+      //! Write compressed jobs, in submission order.
+      void
+      writeCompleted(void)
+      {
+        Job* job = NULL;
+        while (m_done.pop(job))
+          job->done = true;
+
+        while (!m_pending.empty() && m_pending.front()->done)
+        {
+          job = m_pending.front();
+          m_pending.pop_front();
+
+          m_idle.push_back(job);
+
+          if (job->error)
+          {
+            m_error = true;
+            continue;
+          }
+
+          job->entry.offset = m_offset;
+          BlockLog::writeBlockHeader(m_ofs, job->entry);
+          m_ofs.write(job->data.getBufferSigned(), job->data.getSize());
+          m_offset += BlockLog::c_block_header_size + job->data.getSize();
+          m_index.push_back(job->entry);
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -31,10 +31,14 @@
 #include <fstream>
 #include <algorithm>
 #include <cstddef>
+#include <sstream>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Writer.hpp"
+
 namespace Transports
 {
   namespace Logging
@@ -43,6 +47,8 @@ namespace Transports
 
     // Bytes per Mebibyte.
     static const unsigned c_bytes_per_mib = 1048576U;
+    // Bytes per Kibibyte.
+    static const unsigned c_bytes_per_kib = 1024U;
 
     struct Arguments
     {
@@ -54,30 +60,56 @@ namespace Transports
       std::vector<std::string> lsf_volumes;
       // Volume size.
       unsigned lsf_volume_size;
+      // Volume duration.
+      float lsf_volume_duration;
       // Compression method.
       std::string lsf_compression;
+      // Compression dictionary.
+      std::string lsf_dictionary;
+      // Block compression method.
+      std::string lsf_block_compression;
+      // Number of block compression threads.
+      unsigned compression_threads;
+      // True to write log indexes.
+      bool lsf_index;
+      // Size of write blocks.
+      unsigned block_size;
+      // Maximum number of write blocks.
+      unsigned max_blocks;
+      // Interval between storage synchronizations.
+      float sync_interval;
     };
 
     struct Task: public Tasks::Task
     {
       // Timestamp of last flush.
       double m_last_flush;
+      // Timestamp of last storage synchronization.
+      double m_last_sync;
       // Label of current log.
       std::string m_label;
       // Current log directory.
       Path m_dir;
       // Reference time of log.
       double m_ref_time;
+      // Time at which the current LSF volume was started.
+      double m_volume_start;
       // Current LSF volume directory.
       std::string m_volume_dir;
       // Compression format.
       Compression::Methods m_compression;
-      // Output file stream for LSF/LSF_GZ formats.
-      std::ostream* m_lsf;
+      // Contents of the compression dictionary.
+      std::string m_dictionary;
+      // True to write block logs.
+      bool m_block_log;
+      // Block log compression method.
+      BlockLog::Method m_block_method;
+      // Log writer.
+      Writer* m_writer;
+      // True if a LSF file is open.
+      bool m_lsf_open;
       // Path to LSF file.
       Path m_lsf_file;
-      // Serialization buffer.
-      ByteBuffer m_buffer;
       // Logging control message.
       IMC::LoggingControl m_log_ctl;
       // True if logging is enabled.
@@ -88,7 +120,10 @@ namespace Transports
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
         m_last_flush(0),
-        m_lsf(NULL),
+        m_last_sync(0),
+        m_volume_start(0),
+        m_writer(NULL),
+        m_lsf_open(false),
         m_active(true)
       {
         // Define configuration parameters.
@@ -99,18 +134,66 @@ namespace Transports
 
         param("LSF Compression Method", m_args.lsf_compression)
         .defaultValue("none")
-        .description("Compression method");
+        .description("Compression method: none, zlib, gzip, bzip2, lz4 or zstd."
+                     " LZ4 is the fastest and zstd compresses better than gzip"
+                     " at a lower cost");
+
+        param("LSF Compression Dictionary", m_args.lsf_dictionary)
+        .defaultValue("")
+        .description("Dictionary used with zstd, e.g., trained with 'zstd --train'"
+                     " on samples of LSF logs. Relative paths are relative to the"
+                     " configuration folder. A copy is stored next to each log");
+
+        param("LSF Block Compression", m_args.lsf_block_compression)
+        .defaultValue("disabled")
+        .values("disabled, none, lz4, zlib")
+        .description("Compression method of block logs, made of independently"
+                     " compressed blocks of 'Write Block Size' bytes and a block"
+                     " index. When enabled, 'LSF Compression Method' is ignored");
+
+        param("LSF Index", m_args.lsf_index)
+        .defaultValue("true")
+        .description("Write an index of LSF logs (Data.lsf.idx) with the time"
+                     " range and message counts of each block, used by log"
+                     " readers to seek");
+
+        param("Compression Threads", m_args.compression_threads)
+        .defaultValue("2")
+        .minimumValue("1")
+        .description("Number of threads compressing blocks of block logs");
 
         param("LSF Volume Size", m_args.lsf_volume_size)
         .units(Units::Mebibyte)
         .defaultValue("0");
 
+        param("LSF Volume Duration", m_args.lsf_volume_duration)
+        .units(Units::Second)
+        .defaultValue("0")
+        .description("Start a new log after logging for this long (0 to disable)");
+
         param("LSF Volume Directories", m_args.lsf_volumes)
         .defaultValue("");
 
         param("Transports", m_args.messages)
         .defaultValue("");
 
+        param("Write Block Size", m_args.block_size)
+        .units(Units::Kibibyte)
+        .defaultValue("256")
+        .minimumValue("4")
+        .description("Size of the blocks of serialized messages handed to the writer thread");
+
+        param("Maximum Write Blocks", m_args.max_blocks)
+        .defaultValue("16")
+        .minimumValue("2")
+        .description("Maximum number of blocks waiting to be written."
+                     " Messages are dropped when all blocks are in use");
+
+        param("Synchronization Interval", m_args.sync_interval)
+        .defaultValue("0.0")
+        .units(Units::Second)
+        .description("Number of seconds to wait before synchronizing log data with storage (0 to disable)");
+
         m_log_ctl.setSource(getSystemId());
 
         bind<IMC::CacheControl>(this);
@@ -130,16 +213,44 @@ namespace Transports
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
 
+      void
+      onResourceAcquisition(void)
+      {
+        m_writer = new Writer(m_args.block_size * c_bytes_per_kib, m_args.max_blocks,
+                              m_ctx.dir_log / "schemas");
+        m_writer->start();
+      }
+
       void
       onResourceRelease(void)
       {
-        Memory::clear(m_lsf);
+        Memory::clear(m_writer);
+        m_lsf_open = false;
       }
 
       void
       onUpdateParameters(void)
       {
         m_compression = Compression::Factory::method(m_args.lsf_compression);
+
+        m_dictionary.clear();
+        if (m_compression == Compression::METHOD_ZSTD && !m_args.lsf_dictionary.empty())
+        {
+          Path path(m_args.lsf_dictionary);
+          if (!path.isAbsolute())
+            path = m_ctx.dir_cfg / path;
+
+          std::ifstream ifs(path.c_str(), std::ios::binary);
+          std::ostringstream oss;
+          oss << ifs.rdbuf();
+          if (!ifs || oss.str().empty())
+            throw std::runtime_error(String::str(DTR("unable to read compression dictionary '%s'"), path.c_str()));
+          m_dictionary = oss.str();
+        }
+
+        // Fail now if the method is not supported by this build.
+        delete Compression::Factory::compressor(m_compression, m_dictionary);
+        m_block_log = BlockLog::parseMethod(m_args.lsf_block_compression, m_block_method);
         if (m_args.lsf_volumes.empty())
           m_args.lsf_volumes.push_back("");
 
@@ -233,18 +344,6 @@ namespace Transports
         cc.snapshot = (m_ctx.dir_log / String::str("cache-%0.6f.lsf", time_ref)).str();
         dispatch(cc);
 
-        // Copy IMC XML to log directory.
-        Path imc_dst = m_dir / "IMC.xml.gz";
-        std::ofstream imc_ofs(imc_dst.c_str(), std::ios::binary);
-        imc_ofs.write((char*)Blob::getData(), Blob::getSize());
-        imc_ofs.close();
-
-        // Copy current configuration file to log directory.
-        Path cfg_path = m_dir / "Config.ini";
-        Path out_path = m_dir / "Output.txt";
-        m_ctx.config.writeToFile(cfg_path.c_str());
-        dune_term.open(out_path.c_str());
-
         // Log entities.
         std::vector<EntityDataBase::Entity*> devs;
         m_ctx.entities.contents(devs);
@@ -282,7 +381,7 @@ namespace Transports
         while (!ifs.eof())
         {
           ifs.read(bfr, sizeof(bfr));
-          m_lsf->write(bfr, ifs.gcount());
+          m_writer->write(bfr, ifs.gcount());
         }
       }
 
@@ -293,7 +392,7 @@ namespace Transports
         if (!m_active)
           return;
 
-        if (m_lsf == NULL)
+        if (!m_lsf_open)
           return;
 
         m_active = keep_logging;
@@ -310,7 +409,8 @@ namespace Transports
         inf(DTR("log stopped '%s'"), m_log_ctl.name.c_str());
         m_log_ctl.name.clear();
 
-        onResourceRelease();
+        m_writer->close();
+        m_lsf_open = false;
       }
 
       void
@@ -332,18 +432,28 @@ namespace Transports
         / Time::Format::getDateSafe(m_ref_time)
         / Time::Format::getTimeSafe(m_ref_time) + dir_label;
 
-        // Create log directory.
-        m_dir.create();
-
         // Stop current log.
         stopLog();
 
-        m_lsf_file = m_dir / "Data.lsf" + Compression::Factory::extension(m_compression);
+        // The log directory, its files and the new LSF file are
+        // created by the writer thread, in order with log data.
+        std::ostringstream config;
+        config << m_ctx.config;
+        m_writer->prepare(m_dir, config.str());
 
-        if (m_compression == METHOD_UNKNOWN)
-          m_lsf = new std::ofstream(m_lsf_file.c_str(), std::ios::binary);
+        if (m_block_log)
+        {
+          m_lsf_file = m_dir / "Data.lsf.blk";
+          m_writer->open(m_lsf_file, m_block_method, m_args.compression_threads);
+        }
         else
-          m_lsf = new Compression::FileOutput(m_lsf_file.c_str(), m_compression);
+        {
+          m_lsf_file = m_dir / "Data.lsf" + Compression::Factory::extension(m_compression);
+          m_writer->open(m_lsf_file, m_compression, m_args.lsf_index, m_dictionary);
+        }
+
+        m_lsf_open = true;
+        m_volume_start = Clock::get();
 
         // Log LoggingControl to facilitate posterior conversion to LLF.
         m_log_ctl.op = IMC::LoggingControl::COP_STARTED;
@@ -368,24 +478,44 @@ namespace Transports
         {
           tryRotate();
           m_last_flush = now;
+
+          unsigned dropped = m_writer->getDropped();
+          if (dropped > 0)
+            war(DTR("storage is too slow, dropped %u messages"), dropped);
         }
       }
 
       void
       tryRotate(void)
       {
-        if (m_lsf == NULL)
+        if (!m_lsf_open)
           return;
 
-        int64_t mib = Path(m_lsf_file).size();
+        std::string error;
+        if (m_writer->getError(error))
+          throw std::runtime_error(error);
+
+        // File sizes are gathered by the writer thread when flushing.
+        int64_t mib = 0;
+        int64_t available_mib = -1;
+        bool current = m_writer->getStatus(mib, available_mib);
         mib /= c_bytes_per_mib;
 
-        m_lsf->flush();
+        double now = Clock::get();
+        bool sync = (m_args.sync_interval > 0) && (now > (m_last_sync + m_args.sync_interval));
+        if (sync)
+          m_last_sync = now;
+
+        m_writer->flush(sync);
 
-        if ((m_args.lsf_volume_size > 0) && (mib >= m_args.lsf_volume_size))
+        if (current && (m_args.lsf_volume_size > 0) && (mib >= m_args.lsf_volume_size))
           tryStartLog(m_label);
+        else if ((m_args.lsf_volume_duration > 0) && (now - m_volume_start >= m_args.lsf_volume_duration))
+          tryStartLog(m_label);
+
+        if (available_mib < 0)
+          return;
 
-        int64_t available_mib = Path::storageAvailable(m_dir);
         available_mib /= c_bytes_per_mib;
 
         if (available_mib < (m_args.lsf_volume_size * 2))
@@ -411,8 +541,7 @@ namespace Transports
       void
       logMessage(const IMC::Message* msg)
       {
-        IMC::Packet::serialize(msg, m_buffer);
-        m_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
+        m_writer->write(msg);
       }
 
       void
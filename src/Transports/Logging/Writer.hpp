@@ -0,0 +1,716 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+
+#ifndef TRANSPORTS_LOGGING_WRITER_HPP_INCLUDED_
+#define TRANSPORTS_LOGGING_WRITER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "BlockOutput.hpp"
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace Transports
+{
+  namespace Logging
+  {
+    using DUNE_NAMESPACES;
+
+    //! Writer of log data. The task thread serializes messages into
+    //! blocks, that are handed over to the writer thread through
+    //! lock-free queues, together with requests to create log
+    //! directories and to switch, flush and close output streams.
+    //! Requests are handled in order, so switching to a new log is
+    //! atomic with respect to the messages written. Compression and
+    //! all file system operations only happen in the writer thread
+    //! (and its compression threads for block logs).
+    class Writer: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] block_size size of blocks in bytes.
+      //! @param[in] max_blocks maximum number of blocks.
+      //! @param[in] schemas folder holding one copy of each IMC
+      //! document, linked from log directories.
+      Writer(unsigned block_size, unsigned max_blocks, const Path& schemas):
+        m_block_size(block_size),
+        m_max_blocks(max_blocks),
+        m_block(NULL),
+        m_requests(max_blocks + c_extra_requests),
+        m_free(max_blocks),
+        m_dropped(0),
+        m_opened(0),
+        m_status_opened(0),
+        m_status_size(0),
+        m_status_available(-1),
+        m_stream(NULL),
+        m_block_output(NULL),
+        m_index(NULL),
+        m_offset(0),
+        m_schemas(schemas)
+      {
+        m_block = getBlock();
+      }
+
+      //! Destructor.
+      ~Writer(void)
+      {
+        if (isCreated())
+        {
+          stop();
+          m_requests.wakeup();
+          join();
+        }
+
+        delete m_stream;
+        delete m_block_output;
+        delete m_index;
+
+        for (unsigned i = 0; i < m_blocks.size(); ++i)
+          delete m_blocks[i];
+      }
+
+      //! Append a message to the log.
+      //! @param[in] msg message.
+      void
+      write(const IMC::Message* msg)
+      {
+        unsigned size = msg->getSerializationSize();
+        if (!reserve(size))
+          return;
+
+        uint16_t rv = IMC::Packet::serialize(msg, m_block->getBuffer() + m_block->getSize(), size);
+        m_block->setSize(m_block->getSize() + rv);
+      }
+
+      //! Append raw data to the log. Unlike messages, raw data is
+      //! never dropped and this function waits for blocks if needed.
+      //! @param[in] data data.
+      //! @param[in] size size of data.
+      void
+      write(const char* data, unsigned size)
+      {
+        while (size > 0)
+        {
+          unsigned len = std::min(size, m_block_size);
+          while (!reserve(len, true))
+            Delay::wait(0.001);
+
+          m_block->appendSigned(data, len);
+          data += len;
+          size -= len;
+        }
+      }
+
+      //! Create a log directory and the files describing the log:
+      //! the IMC definitions, the configuration and the output of
+      //! the daemon.
+      //! @param[in] dir log directory.
+      //! @param[in] config configuration.
+      void
+      prepare(const Path& dir, const std::string& config)
+      {
+        Request req(OP_PREPARE);
+        req.path = dir.str();
+        req.config = config;
+        submit(req);
+      }
+
+      //! Write subsequent data to a new file. The current stream is
+      //! closed after all its data is written.
+      //! @param[in] path path of the file.
+      //! @param[in] compression compression method of the file.
+      //! @param[in] index true to write a log index (see
+      //! IMC::LogIndex) next to the file.
+      //! @param[in] dictionary compression dictionary (empty for
+      //! none), stored next to the file.
+      void
+      open(const Path& path, Compression::Methods compression, bool index,
+           const std::string& dictionary = std::string())
+      {
+        Request req(OP_OPEN);
+        req.path = path.str();
+        req.compression = compression;
+        req.index = index;
+        req.dictionary = dictionary;
+        ++m_opened;
+        submit(req);
+      }
+
+      //! Write subsequent data to a new block log (see
+      //! IMC::BlockLog). The current stream is closed after all its
+      //! data is written.
+      //! @param[in] path path of the block log.
+      //! @param[in] method compression method.
+      //! @param[in] workers number of compression threads.
+      void
+      open(const Path& path, BlockLog::Method method, unsigned workers)
+      {
+        Request req(OP_OPEN_BLOCKS);
+        req.path = path.str();
+        req.method = method;
+        req.workers = workers;
+        ++m_opened;
+        submit(req);
+      }
+
+      //! Close the current stream after all its data is written.
+      void
+      close(void)
+      {
+        submit(Request(OP_CLOSE));
+      }
+
+      //! Write all pending data to the current stream and flush it.
+      //! @param[in] sync true to also synchronize file data with
+      //! storage.
+      void
+      flush(bool sync)
+      {
+        submit(Request(sync ? OP_SYNC : OP_FLUSH));
+      }
+
+      //! Retrieve and reset the number of messages dropped because
+      //! all blocks were waiting to be written.
+      //! @return number of dropped messages.
+      unsigned
+      getDropped(void)
+      {
+        unsigned rv = m_dropped;
+        m_dropped = 0;
+        return rv;
+      }
+
+      //! Retrieve the state of the current file, as of its last
+      //! flush.
+      //! @param[out] size file size in bytes.
+      //! @param[out] available storage available in bytes (negative
+      //! if unknown).
+      //! @return true if the state refers to the file opened last,
+      //! false if that file was not flushed yet.
+      bool
+      getStatus(int64_t& size, int64_t& available)
+      {
+        ScopedMutex l(m_error_lock);
+        size = m_status_size;
+        available = m_status_available;
+        return m_status_opened == m_opened;
+      }
+
+      //! Retrieve the first error reported by the writer thread.
+      //! @param[out] error error message.
+      //! @return true if an error happened, false otherwise.
+      bool
+      getError(std::string& error)
+      {
+        ScopedMutex l(m_error_lock);
+        error = m_error;
+        return !m_error.empty();
+      }
+
+    private:
+      //! Block of serialized data.
+      typedef Utils::ByteBuffer Block;
+
+      //! Request operations.
+      enum Operation
+      {
+        //! Write a block.
+        OP_WRITE,
+        //! Create a log directory.
+        OP_PREPARE,
+        //! Switch to a new stream.
+        OP_OPEN,
+        //! Switch to a new block log.
+        OP_OPEN_BLOCKS,
+        //! Close stream.
+        OP_CLOSE,
+        //! Flush stream.
+        OP_FLUSH,
+        //! Flush stream and synchronize file with storage.
+        OP_SYNC
+      };
+
+      //! Request to the writer thread.
+      struct Request
+      {
+        //! Operation.
+        Operation op;
+        //! Block to write.
+        Block* block;
+        //! Path of log directory or file to open.
+        std::string path;
+        //! Configuration of log directory.
+        std::string config;
+        //! Compression method of block log to open.
+        BlockLog::Method method;
+        //! Number of compression threads of block log to open.
+        unsigned workers;
+        //! Compression method of the stream to open.
+        Compression::Methods compression;
+        //! True to index the stream to open.
+        bool index;
+        //! Compression dictionary of the stream to open.
+        std::string dictionary;
+
+        Request(Operation o = OP_WRITE):
+          op(o),
+          block(NULL),
+          method(BlockLog::METHOD_NONE),
+          workers(0),
+          compression(METHOD_UNKNOWN),
+          index(false)
+        { }
+      };
+
+      //! Number of requests besides blocks that may be pending.
+      static const unsigned c_extra_requests = 64;
+      //! Size of blocks.
+      unsigned m_block_size;
+      //! Maximum number of blocks.
+      unsigned m_max_blocks;
+      //! Block being filled by the task.
+      Block* m_block;
+      //! All allocated blocks.
+      std::vector<Block*> m_blocks;
+      //! Requests to the writer thread.
+      Concurrency::MPSCQueue<Request> m_requests;
+      //! Blocks written by the writer thread.
+      Concurrency::MPSCQueue<Block*> m_free;
+      //! Number of dropped messages.
+      unsigned m_dropped;
+      //! Number of files opened by the task.
+      unsigned m_opened;
+      //! Number of files opened by the writer thread.
+      unsigned m_status_opened;
+      //! Size of the current file.
+      int64_t m_status_size;
+      //! Storage available for the current file.
+      int64_t m_status_available;
+      //! Error message.
+      std::string m_error;
+      //! Error message and status lock.
+      Concurrency::Mutex m_error_lock;
+      //! Current stream (only used by the writer thread).
+      std::ostream* m_stream;
+      //! Current block log (only used by the writer thread).
+      BlockOutput* m_block_output;
+      //! Path of current stream (only used by the writer thread).
+      std::string m_path;
+      //! Index of current stream (only used by the writer thread).
+      std::ofstream* m_index;
+      //! Offset of the next block in the current stream.
+      uint64_t m_offset;
+      //! Packet scanner of the current stream.
+      IMC::PacketScanner m_scanner;
+      //! Packets of the last block.
+      std::vector<IMC::PacketScanner::Location> m_packets;
+      //! Folder holding IMC documents by digest.
+      Path m_schemas;
+
+      //! Get an empty block.
+      //! @return block or NULL if all blocks are in use.
+      Block*
+      getBlock(void)
+      {
+        Block* block = NULL;
+        if (m_free.pop(block))
+        {
+          block->setSize(0);
+          return block;
+        }
+
+        if (m_blocks.size() >= m_max_blocks)
+          return NULL;
+
+        block = new Block(m_block_size + DUNE_IMC_CONST_MAX_SIZE);
+        m_blocks.push_back(block);
+        return block;
+      }
+
+      //! Make room for data in the current block.
+      //! @param[in] size amount of data.
+      //! @param[in] retry true if the caller retries instead of
+      //! dropping data.
+      //! @return true if there is room, false otherwise.
+      bool
+      reserve(unsigned size, bool retry = false)
+      {
+        if (m_block != NULL && m_block->getSize() + size > m_block_size)
+          submitBlock();
+
+        if (m_block == NULL)
+          m_block = getBlock();
+
+        if (m_block == NULL)
+        {
+          if (!retry)
+            ++m_dropped;
+          return false;
+        }
+
+        return true;
+      }
+
+      //! Hand the current block over to the writer thread.
+      void
+      submitBlock(void)
+      {
+        if (m_block == NULL || m_block->getSize() == 0)
+          return;
+
+        Request req(OP_WRITE);
+        req.block = m_block;
+        m_block = NULL;
+
+        // Only a burst of control requests can fill the queue.
+        while (!m_requests.push(req))
+          Delay::wait(0.001);
+      }
+
+      //! Submit a request, preceded by the current block.
+      //! @param[in] req request.
+      void
+      submit(const Request& req)
+      {
+        submitBlock();
+
+        // Control requests are rare, wait for room if needed.
+        while (!m_requests.push(req))
+          Delay::wait(0.001);
+      }
+
+      void
+      handle(Request& req)
+      {
+        switch (req.op)
+        {
+          case OP_WRITE:
+            if (m_block_output != NULL)
+            {
+              m_block_output->write(req.block);
+            }
+            else
+            {
+              if (m_stream != NULL)
+                writeBlock(req.block);
+              m_free.push(req.block);
+            }
+            req.block = NULL;
+            break;
+
+          case OP_PREPARE:
+            prepareDirectory(req.path, req.config);
+            break;
+
+          case OP_OPEN:
+            closeOutput();
+            opened(req.path);
+
+            if (req.compression == METHOD_UNKNOWN)
+            {
+              m_stream = new std::ofstream(m_path.c_str(), std::ios::binary);
+            }
+            else
+            {
+              m_stream = new Compression::FileOutput(m_path.c_str(), req.compression, req.dictionary);
+
+              // The dictionary is needed to read the file.
+              if (!req.dictionary.empty())
+              {
+                std::ofstream dict(Compression::Factory::dictionaryPath(m_path).c_str(), std::ios::binary);
+                dict.write(req.dictionary.data(), req.dictionary.size());
+              }
+            }
+
+            if (req.index)
+            {
+              m_index = new std::ofstream(LogIndex::getPath(m_path).c_str(), std::ios::binary);
+              LogIndex::writeHeader(*m_index, req.compression);
+              m_scanner.reset();
+              m_offset = 0;
+            }
+            break;
+
+          case OP_OPEN_BLOCKS:
+            closeOutput();
+            opened(req.path);
+            m_block_output = new BlockOutput(m_path, req.method, req.workers, m_free);
+            break;
+
+          case OP_CLOSE:
+            closeOutput();
+            break;
+
+          case OP_FLUSH:
+          case OP_SYNC:
+            if (m_stream != NULL)
+            {
+              m_stream->flush();
+              if (m_index != NULL)
+                m_index->flush();
+            }
+            else if (m_block_output != NULL)
+              m_block_output->flush();
+            else
+              break;
+
+            if (req.op == OP_SYNC)
+              sync();
+
+            updateStatus();
+            break;
+        }
+
+        if (failed())
+          throw std::runtime_error(String::str(DTR("failed to write to '%s'"), m_path.c_str()));
+      }
+
+      //! Create a log directory and its description files.
+      //! @param[in] path log directory.
+      //! @param[in] config configuration.
+      void
+      prepareDirectory(const Path& path, const std::string& config)
+      {
+        path.create();
+
+        // Link IMC XML to log directory, or copy it if linking fails.
+        Path imc_dst = path / "IMC.xml.gz";
+        std::ofstream imc_ofs;
+        if (!linkSchema(imc_dst))
+        {
+          imc_ofs.open(imc_dst.c_str(), std::ios::binary);
+          imc_ofs.write((char*)Blob::getData(), Blob::getSize());
+          imc_ofs.close();
+        }
+
+        // Copy current configuration to log directory.
+        Path cfg_path = path / "Config.ini";
+        std::ofstream cfg_ofs(cfg_path.c_str(), std::ios::binary);
+        cfg_ofs.write(config.data(), config.size());
+        cfg_ofs.close();
+
+        Path out_path = path / "Output.txt";
+        dune_term.open(out_path.c_str());
+
+        if (imc_ofs.fail() || cfg_ofs.fail())
+          throw std::runtime_error(String::str(DTR("failed to write to '%s'"), path.c_str()));
+      }
+
+      //! Link the IMC XML document to a log directory. The document
+      //! is stored once in the schema folder, named after its digest.
+      //! @param[in] dst destination file.
+      //! @return true if the document was linked, false otherwise.
+      bool
+      linkSchema(const Path& dst)
+      {
+#if defined(DUNE_SYS_HAS_LINK)
+        Path src = m_schemas / String::str("%s.xml.gz", Blob::getDigest());
+
+        if (!src.exists())
+        {
+          try
+          {
+            m_schemas.create();
+          }
+          catch (std::runtime_error& e)
+          {
+            (void)e;
+            return false;
+          }
+
+          Path tmp = src + ".tmp";
+          std::ofstream ofs(tmp.c_str(), std::ios::binary);
+          ofs.write((char*)Blob::getData(), Blob::getSize());
+          ofs.close();
+
+          if (ofs.fail() || std::rename(tmp.c_str(), src.c_str()) != 0)
+          {
+            std::remove(tmp.c_str());
+            return false;
+          }
+        }
+
+        return link(src.c_str(), dst.c_str()) == 0;
+#else
+        (void)dst;
+        return false;
+#endif
+      }
+
+      //! Record the switch to a new file.
+      //! @param[in] path path of the file.
+      void
+      opened(const std::string& path)
+      {
+        m_path = path;
+
+        ScopedMutex l(m_error_lock);
+        ++m_status_opened;
+        m_status_size = 0;
+      }
+
+      //! Update the state of the current file.
+      void
+      updateStatus(void)
+      {
+        Path path(m_path);
+        int64_t size = std::max<int64_t>(path.size(), 0);
+        int64_t available = Path::storageAvailable(path.dirname());
+
+        ScopedMutex l(m_error_lock);
+        m_status_size = size;
+        m_status_available = available;
+      }
+
+      //! Write a block to the current stream.
+      //! @param[in] block block.
+      void
+      writeBlock(Block* block)
+      {
+        m_stream->write(block->getBufferSigned(), block->getSize());
+
+        if (m_index == NULL)
+          return;
+
+        LogIndex::Entry entry;
+        entry.offset = m_offset;
+        entry.usize = block->getSize();
+        entry.first = entry.usize;
+
+        m_scanner.scan(block->getBuffer(), block->getSize(), m_packets);
+        for (unsigned i = 0; i < m_packets.size(); ++i)
+          entry.add(m_packets[i].pos, m_packets[i].id, m_packets[i].time);
+
+        // Flushing ends the compressed stream, so that reading can
+        // start at the next block.
+        m_stream->flush();
+        m_offset = std::max<int64_t>(Path(m_path).size(), 0);
+
+        LogIndex::writeEntry(*m_index, entry);
+      }
+
+      //! Test if writing to the current output failed.
+      //! @return true if writing failed, false otherwise.
+      bool
+      failed(void)
+      {
+        if (m_stream != NULL)
+          return m_stream->fail();
+
+        if (m_block_output != NULL)
+          return m_block_output->fail();
+
+        return false;
+      }
+
+      //! Close the current output, writing all its pending data.
+      void
+      closeOutput(void)
+      {
+        if (m_block_output != NULL)
+          m_block_output->close();
+
+        bool error = failed();
+
+        Memory::clear(m_stream);
+        Memory::clear(m_block_output);
+        Memory::clear(m_index);
+
+        if (error)
+          throw std::runtime_error(String::str(DTR("failed to write to '%s'"), m_path.c_str()));
+      }
+
+      //! Synchronize the current file with storage.
+      void
+      sync(void)
+      {
+#if defined(DUNE_SYS_HAS_FDATASYNC)
+        // Any descriptor of the file selects the same data to write.
+        int fd = ::open(m_path.c_str(), O_RDONLY);
+        if (fd == -1)
+          return;
+
+        fdatasync(fd);
+        ::close(fd);
+#endif
+      }
+
+      void
+      run(void)
+      {
+        Request req;
+
+        while (true)
+        {
+          if (!m_requests.pop(req))
+          {
+            if (isStopping())
+              break;
+
+            m_requests.waitForItems(1.0);
+            continue;
+          }
+
+          try
+          {
+            handle(req);
+          }
+          catch (std::exception& e)
+          {
+            ScopedMutex l(m_error_lock);
+            if (m_error.empty())
+              m_error = e.what();
+
+            // Keep returning blocks so that the task never stalls.
+            if (req.block != NULL)
+              m_free.push(req.block);
+          }
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,270 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_LOGGING_DIGEST_CHANGE_DETECTOR_HPP_INCLUDED_
+#define TRANSPORTS_LOGGING_DIGEST_CHANGE_DETECTOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace LoggingDigest
+  {
+    using DUNE_NAMESPACES;
+
+    //! Compares consecutive samples of a message. Numeric fields may
+    //! have a deadband, configured per message or per field: changes
+    //! inside the deadband are not significant. Any change of other
+    //! fields is significant.
+    class ChangeDetector
+    {
+    public:
+      //! Result of a comparison.
+      enum Change
+      {
+        //! Payloads are identical.
+        CHANGE_NONE,
+        //! All changes are inside the deadbands.
+        CHANGE_MINOR,
+        //! At least one change is outside the deadbands.
+        CHANGE_SIGNIFICANT
+      };
+
+      ChangeDetector(void):
+        m_schema(NULL)
+      { }
+
+      ~ChangeDetector(void)
+      {
+        delete m_schema;
+      }
+
+      //! Configure deadbands. Each entry has the form
+      //! 'Message:value', applying to all numeric fields of the
+      //! message, or 'Message.field:value'.
+      //! @param[in] spec deadband entries.
+      void
+      setup(const std::vector<std::string>& spec)
+      {
+        m_deadbands.clear();
+
+        for (unsigned i = 0; i < spec.size(); ++i)
+        {
+          std::vector<std::string> parts;
+          String::split(spec[i], ":", parts);
+
+          double value = 0;
+          if (parts.size() != 2 || std::sscanf(parts[1].c_str(), "%lf", &value) != 1 || value < 0)
+            throw std::runtime_error(String::str(DTR("invalid deadband: %s"), spec[i].c_str()));
+
+          std::string field;
+          size_t dot = parts[0].find('.');
+          if (dot != std::string::npos)
+          {
+            field = parts[0].substr(dot + 1);
+            parts[0].resize(dot);
+          }
+
+          const IMC::Schema::Definition* def = getSchema().find(IMC::Factory::getIdFromAbbrev(parts[0]));
+          if (def == NULL)
+            throw std::runtime_error(String::str(DTR("invalid deadband: %s"), spec[i].c_str()));
+
+          std::vector<fp64_t>& bands = m_deadbands[def->id];
+          if (bands.empty())
+            bands.resize(def->fields.size(), 0);
+
+          bool found = false;
+          for (unsigned j = 0; j < def->fields.size(); ++j)
+          {
+            if (field.empty() || def->fields[j].abbrev == field)
+            {
+              // Field deadbands override message deadbands.
+              if (field.empty() && bands[j] > 0)
+                continue;
+
+              bands[j] = value;
+              found = true;
+            }
+          }
+
+          if (!field.empty() && !found)
+            throw std::runtime_error(String::str(DTR("invalid deadband: %s"), spec[i].c_str()));
+        }
+      }
+
+      //! Compare two samples of the same message.
+      //! @param[in] last previous sample.
+      //! @param[in] msg new sample.
+      //! @return type of change.
+      Change
+      compare(const IMC::Message* last, const IMC::Message* msg)
+      {
+        serialize(last, m_last);
+        serialize(msg, m_next);
+
+        if (m_last == m_next)
+          return CHANGE_NONE;
+
+        std::map<uint16_t, std::vector<fp64_t> >::const_iterator itr = m_deadbands.find(msg->getId());
+        if (itr == m_deadbands.end() || m_last.size() != m_next.size())
+          return CHANGE_SIGNIFICANT;
+
+        const IMC::Schema::Definition* def = m_schema->find(msg->getId());
+        const std::vector<fp64_t>& bands = itr->second;
+        const uint8_t* a = &m_last[0];
+        const uint8_t* b = &m_next[0];
+        const uint8_t* end = a + m_last.size();
+
+        for (unsigned i = 0; i < def->fields.size(); ++i)
+        {
+          IMC::Schema::Type type = def->fields[i].type;
+          unsigned size = IMC::Schema::getSize(type);
+
+          if (size == 0)
+          {
+            // Variable size fields, and all that follow them, are
+            // compared as a whole.
+            return std::memcmp(a, b, end - a) ? CHANGE_SIGNIFICANT : CHANGE_MINOR;
+          }
+
+          if (std::memcmp(a, b, size) != 0
+              && !(std::fabs(getValue(type, a) - getValue(type, b)) <= bands[i]))
+            return CHANGE_SIGNIFICANT;
+
+          a += size;
+          b += size;
+        }
+
+        return CHANGE_MINOR;
+      }
+
+    private:
+      //! Message definitions, loaded with the first deadband.
+      IMC::Schema* m_schema;
+      //! Field deadbands by message identifier.
+      std::map<uint16_t, std::vector<fp64_t> > m_deadbands;
+      //! Serialized payload of the previous sample.
+      std::vector<uint8_t> m_last;
+      //! Serialized payload of the new sample.
+      std::vector<uint8_t> m_next;
+
+      const IMC::Schema&
+      getSchema(void)
+      {
+        if (m_schema == NULL)
+          m_schema = new IMC::Schema();
+
+        return *m_schema;
+      }
+
+      static void
+      serialize(const IMC::Message* msg, std::vector<uint8_t>& bfr)
+      {
+        bfr.resize(msg->getPayloadSerializationSize() + 1);
+        bfr.resize(msg->serializeFields(&bfr[0]) - &bfr[0]);
+      }
+
+      //! Read a serialized numeric field.
+      static fp64_t
+      getValue(IMC::Schema::Type type, const uint8_t* bfr)
+      {
+        uint16_t len = 8;
+
+        switch (type)
+        {
+          case IMC::Schema::TYPE_INT8:
+            {
+              int8_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_UINT8:
+            {
+              uint8_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_INT16:
+            {
+              int16_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_UINT16:
+            {
+              uint16_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_INT32:
+            {
+              int32_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_UINT32:
+            {
+              uint32_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_INT64:
+            {
+              int64_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return (fp64_t)v;
+            }
+          case IMC::Schema::TYPE_FP32:
+            {
+              fp32_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_FP64:
+            {
+              fp64_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          default:
+            return 0;
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -28,6 +28,9 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "ChangeDetector.hpp"
+
 namespace Transports
 {
   namespace LoggingDigest
@@ -40,6 +43,12 @@ namespace Transports
       float sample_interval;
       //! Flush interval.
       float flush_interval;
+      //! Refresh interval.
+      float refresh_interval;
+      //! Burst interval.
+      float burst_interval;
+      //! Deadbands.
+      std::vector<std::string> deadbands;
       //! List of messages to log.
       std::vector<std::string> messages;
       //! Log file name.
@@ -48,12 +57,51 @@ namespace Transports
       std::string log_folder;
     };
 
+    //! Samples of one message.
+    struct Entry
+    {
+      //! Latest sample not yet logged (or NULL).
+      IMC::SharedMessage* pending;
+      //! Last logged sample (or NULL).
+      IMC::SharedMessage* logged;
+      //! Time of the last logged sample.
+      double logged_time;
+
+      Entry(void):
+        pending(NULL),
+        logged(NULL),
+        logged_time(0)
+      { }
+    };
+
+    //! Message type read from the blackboard.
+    struct Source
+    {
+      //! Message identification number.
+      uint16_t id;
+      //! Blackboard sequence number of the last poll.
+      uint32_t seq;
+    };
+
+    //! Release a shared message handle and clear the pointer.
+    static inline void
+    release(IMC::SharedMessage*& msg)
+    {
+      if (msg != NULL)
+        msg->release();
+      msg = NULL;
+    }
+
     struct Task: public DUNE::Tasks::Task
     {
       //! Log file.
       Compression::FileOutput* m_log;
       //! Map of messages.
-      std::map<uint32_t, IMC::Message*> m_messages;
+      std::map<uint32_t, Entry> m_messages;
+      //! Message types to log.
+      std::vector<Source> m_sources;
+      //! Sample change detector.
+      ChangeDetector m_detector;
       //! Sampling timer.
       Counter<double> m_sample_timer;
       //! Flush timer.
@@ -80,6 +128,25 @@ namespace Transports
         .units(Units::Second)
         .description("Number of seconds to wait before forcing data to be written to disk");
 
+        param("Refresh Interval", m_args.refresh_interval)
+        .defaultValue("60.0")
+        .units(Units::Second)
+        .description("Maximum time between samples of a message whose"
+                     " changes stay inside its deadbands");
+
+        param("Burst Interval", m_args.burst_interval)
+        .defaultValue("0.0")
+        .units(Units::Second)
+        .description("Minimum time between samples of a message that are"
+                     " logged as soon as they change significantly,"
+                     " instead of on the next sample. Zero disables");
+
+        param("Deadbands", m_args.deadbands)
+        .defaultValue("")
+        .description("Deadbands of numeric fields, as 'Message:value'"
+                     " or 'Message.field:value'. Changes inside a deadband"
+                     " are logged only on refresh");
+
         param("Log Folder", m_args.log_folder)
         .defaultValue("");
 
@@ -97,9 +164,12 @@ namespace Transports
       {
         stopLog();
 
-        std::map<uint32_t, IMC::Message*>::iterator itr = m_messages.begin();
+        std::map<uint32_t, Entry>::iterator itr = m_messages.begin();
         for (; itr != m_messages.end(); ++itr)
-          delete itr->second;
+        {
+          release(itr->second.pending);
+          release(itr->second.logged);
+        }
 
         m_messages.clear();
       }
@@ -117,7 +187,44 @@ namespace Transports
       {
         m_sample_timer.setTop(m_args.sample_interval);
         m_flush_timer.setTop(m_args.flush_interval);
-        bind(this, m_args.messages);
+
+        if (paramChanged(m_args.deadbands))
+          m_detector.setup(m_args.deadbands);
+
+        if (paramChanged(m_args.messages))
+        {
+          m_sources.clear();
+          for (unsigned i = 0; i < m_args.messages.size(); ++i)
+          {
+            Source src;
+            src.id = IMC::Factory::getIdFromAbbrev(m_args.messages[i]);
+            src.seq = 0;
+            m_ctx.blackboard.track(src.id);
+            m_sources.push_back(src);
+          }
+        }
+
+        // Samples are read from the blackboard; messages only need to
+        // be consumed to log bursts as they happen.
+        if (m_args.burst_interval > 0)
+          bind(this, m_args.messages);
+      }
+
+      //! Pick up the samples of a message type stored since the last
+      //! poll.
+      //! @param[in] src message type.
+      void
+      poll(Source& src)
+      {
+        std::vector<IMC::SharedMessage*> changes;
+        src.seq = m_ctx.blackboard.getChanges(src.id, src.seq, changes);
+
+        for (unsigned i = 0; i < changes.size(); ++i)
+        {
+          Entry& entry = m_messages[getKey(changes[i]->get())];
+          release(entry.pending);
+          entry.pending = changes[i];
+        }
       }
 
       uint32_t
@@ -172,6 +279,11 @@ namespace Transports
       stopLog(void)
       {
         Memory::clear(m_log);
+
+        // Every log starts with full samples.
+        std::map<uint32_t, Entry>::iterator itr = m_messages.begin();
+        for (; itr != m_messages.end(); ++itr)
+          release(itr->second.logged);
       }
 
       void
@@ -203,18 +315,54 @@ namespace Transports
       void
       consume(const IMC::Message* msg)
       {
-        uint32_t key = getKey(msg);
+        if (m_log == NULL || m_args.burst_interval <= 0)
+          return;
 
-        std::map<uint32_t, IMC::Message*>::iterator itr = m_messages.find(key);
-        if (itr == m_messages.end())
+        // The bus stores messages in the blackboard before delivering
+        // them, so the sample is already there.
+        for (unsigned i = 0; i < m_sources.size(); ++i)
         {
-          m_messages[key] = msg->clone();
-        }
-        else
-        {
-          delete itr->second;
-          itr->second = msg->clone();
+          if (m_sources[i].id == msg->getId())
+            poll(m_sources[i]);
         }
+
+        Entry& entry = m_messages[getKey(msg)];
+        if (entry.pending == NULL)
+          return;
+
+        // Log significant changes as they arrive, so that bursts are
+        // not reduced to a single sample.
+        double now = Clock::get();
+        if (now - entry.logged_time >= m_args.burst_interval
+            && getChange(entry) == ChangeDetector::CHANGE_SIGNIFICANT)
+          logSample(entry, now);
+      }
+
+      //! Compare the pending sample of a message with the last logged
+      //! one.
+      //! @param[in] entry message samples.
+      //! @return type of change.
+      ChangeDetector::Change
+      getChange(const Entry& entry)
+      {
+        if (entry.logged == NULL)
+          return ChangeDetector::CHANGE_SIGNIFICANT;
+
+        return m_detector.compare(entry.logged->get(), entry.pending->get());
+      }
+
+      //! Log the pending sample of a message.
+      //! @param[in] entry message samples.
+      //! @param[in] now current time.
+      void
+      logSample(Entry& entry, double now)
+      {
+        logMessage(entry.pending->get());
+
+        release(entry.logged);
+        entry.logged = entry.pending;
+        entry.pending = NULL;
+        entry.logged_time = now;
       }
 
       void
@@ -226,14 +374,26 @@ namespace Transports
         if (!m_sample_timer.overflow())
           return;
 
-        std::map<uint32_t, IMC::Message*>::iterator itr = m_messages.begin();
+        double now = Clock::get();
+
+        for (unsigned i = 0; i < m_sources.size(); ++i)
+          poll(m_sources[i]);
+
+        std::map<uint32_t, Entry>::iterator itr = m_messages.begin();
         for (; itr != m_messages.end(); ++itr)
         {
-          logMessage(itr->second);
-          delete itr->second;
+          Entry& entry = itr->second;
+          if (entry.pending == NULL)
+            continue;
+
+          ChangeDetector::Change change = getChange(entry);
+
+          // Unchanged and slightly changed values are only refreshed.
+          if (change == ChangeDetector::CHANGE_SIGNIFICANT
+              || now - entry.logged_time >= m_args.refresh_interval)
+            logSample(entry, now);
         }
 
-        m_messages.clear();
         m_sample_timer.reset();
       }
 
@@ -0,0 +1,129 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_MULTICAST_FRAME_HPP_INCLUDED_
+#define TRANSPORTS_MULTICAST_FRAME_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Multicast
+  {
+    using DUNE_NAMESPACES;
+
+    //! Frame synchronization number.
+    static const uint16_t c_sync = 0xFE4D;
+    //! Size of frame header.
+    static const unsigned c_header_size = 11;
+    //! Size of a NACK frame.
+    static const unsigned c_nack_size = c_header_size + 2;
+
+    //! Frame types.
+    enum FrameType
+    {
+      //! Message sent once.
+      FT_DATA = 0,
+      //! Message with a sequence number, retransmitted on request.
+      FT_RELIABLE = 1,
+      //! Last sequence number sent, to detect losses at the end of
+      //! a burst.
+      FT_HEARTBEAT = 2,
+      //! Retransmission request.
+      FT_NACK = 3
+    };
+
+    //! Frame header. Every frame starts with the synchronization
+    //! number, the frame type, the system that sent the reliable
+    //! stream (the target of a NACK) and the session and sequence
+    //! numbers of that stream. Data frames are followed by one IMC
+    //! packet and NACK frames by the number of missing sequence
+    //! numbers, starting at 'seq'.
+    struct Frame
+    {
+      //! Frame type.
+      uint8_t type;
+      //! System identifier.
+      uint16_t system;
+      //! Session of the reliable stream.
+      uint16_t session;
+      //! Sequence number.
+      uint32_t seq;
+
+      Frame(void):
+        type(FT_DATA),
+        system(0),
+        session(0),
+        seq(0)
+      { }
+
+      //! Write the frame header.
+      //! @param[out] bfr destination buffer, with at least
+      //! c_header_size bytes.
+      //! @return number of bytes written.
+      unsigned
+      serialize(uint8_t* bfr) const
+      {
+        uint8_t* ptr = bfr;
+        ptr += IMC::serialize(c_sync, ptr);
+        ptr += IMC::serialize(type, ptr);
+        ptr += IMC::serialize(system, ptr);
+        ptr += IMC::serialize(session, ptr);
+        ptr += IMC::serialize(seq, ptr);
+        return ptr - bfr;
+      }
+
+      //! Read the frame header.
+      //! @param[in] bfr frame.
+      //! @param[in] size size of frame.
+      //! @return number of bytes read.
+      //! @throw IMC::BufferTooShort if the frame is truncated.
+      //! @throw IMC::InvalidSync if the frame is not valid.
+      unsigned
+      deserialize(const uint8_t* bfr, uint16_t size)
+      {
+        if (size < c_header_size)
+          throw IMC::BufferTooShort();
+
+        uint16_t sync = 0;
+        const uint8_t* ptr = bfr;
+        ptr += IMC::deserialize(sync, ptr, size);
+        if (sync != c_sync)
+          throw IMC::InvalidSync(sync);
+
+        ptr += IMC::deserialize(type, ptr, size);
+        ptr += IMC::deserialize(system, ptr, size);
+        ptr += IMC::deserialize(session, ptr, size);
+        ptr += IMC::deserialize(seq, ptr, size);
+        return ptr - bfr;
+      }
+    };
+  }
+}
+
+#endif
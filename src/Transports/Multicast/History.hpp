@@ -0,0 +1,125 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_MULTICAST_HISTORY_HPP_INCLUDED_
+#define TRANSPORTS_MULTICAST_HISTORY_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Multicast
+  {
+    using DUNE_NAMESPACES;
+
+    //! Last frames of the reliable stream, kept for retransmission.
+    class History
+    {
+    public:
+      History(void):
+        m_capacity(256),
+        m_first(0)
+      { }
+
+      //! Set the number of frames kept.
+      //! @param[in] capacity number of frames.
+      void
+      setCapacity(unsigned capacity)
+      {
+        m_capacity = capacity;
+        while (m_frames.size() > m_capacity)
+          pop();
+      }
+
+      //! Remove all frames.
+      void
+      clear(void)
+      {
+        m_frames.clear();
+        m_first = 0;
+      }
+
+      //! Add a frame, discarding the oldest one if the history is
+      //! full. Sequence numbers must be consecutive.
+      //! @param[in] seq sequence number.
+      //! @param[in] data frame.
+      //! @param[in] size size of frame.
+      void
+      add(uint32_t seq, const uint8_t* data, unsigned size)
+      {
+        if (m_capacity == 0)
+          return;
+
+        if (m_frames.empty() || seq != m_first + m_frames.size())
+        {
+          m_frames.clear();
+          m_first = seq;
+        }
+
+        if (m_frames.size() == m_capacity)
+          pop();
+
+        m_frames.push_back(std::vector<uint8_t>(data, data + size));
+      }
+
+      //! Find a frame.
+      //! @param[in] seq sequence number.
+      //! @return frame or NULL if the frame is no longer available.
+      const std::vector<uint8_t>*
+      find(uint32_t seq) const
+      {
+        uint32_t index = seq - m_first;
+        if (m_frames.empty() || index >= m_frames.size())
+          return NULL;
+
+        return &m_frames[index];
+      }
+
+    private:
+      //! Maximum number of frames.
+      unsigned m_capacity;
+      //! Sequence number of the oldest frame.
+      uint32_t m_first;
+      //! Frames.
+      std::deque<std::vector<uint8_t> > m_frames;
+
+      void
+      pop(void)
+      {
+        m_frames.pop_front();
+        ++m_first;
+      }
+    };
+  }
+}
+
+#endif
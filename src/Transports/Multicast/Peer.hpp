@@ -0,0 +1,224 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_MULTICAST_PEER_HPP_INCLUDED_
+#define TRANSPORTS_MULTICAST_PEER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <vector>
+#include <utility>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Multicast
+  {
+    using DUNE_NAMESPACES;
+
+    //! Range of missing sequence numbers: first and count.
+    typedef std::pair<uint32_t, uint16_t> NackRange;
+
+    //! Reception state of the reliable stream of one sender.
+    class Peer
+    {
+    public:
+      Peer(void):
+        m_session(0),
+        m_next(0),
+        m_synced(false)
+      { }
+
+      //! Get the session of the stream.
+      //! @return session.
+      uint16_t
+      getSession(void) const
+      {
+        return m_session;
+      }
+
+      //! Register a reliable frame.
+      //! @param[in] session session of the stream.
+      //! @param[in] seq sequence number.
+      //! @param[in] due time at which missing frames are requested.
+      //! @return true if the frame was not received before, false
+      //! if it is a duplicate.
+      bool
+      receive(uint16_t session, uint32_t seq, double due)
+      {
+        if (resync(session, seq))
+          return true;
+
+        int32_t diff = (int32_t)(seq - m_next);
+        if (diff >= 0)
+        {
+          addMissing(seq, due);
+          m_next = seq + 1;
+          return true;
+        }
+
+        Missing::iterator itr = m_missing.find(seq);
+        if (itr == m_missing.end())
+          return false;
+
+        m_missing.erase(itr);
+        return true;
+      }
+
+      //! Register a heartbeat.
+      //! @param[in] session session of the stream.
+      //! @param[in] last last sequence number sent.
+      //! @param[in] due time at which missing frames are requested.
+      void
+      heartbeat(uint16_t session, uint32_t last, double due)
+      {
+        if (resync(session, last))
+          return;
+
+        if ((int32_t)(last - m_next) >= 0)
+        {
+          addMissing(last + 1, due);
+          m_next = last + 1;
+        }
+      }
+
+      //! Postpone requests of frames already requested by another
+      //! receiver.
+      //! @param[in] range requested frames.
+      //! @param[in] due new time of the requests.
+      void
+      suppress(const NackRange& range, double due)
+      {
+        Missing::iterator itr = m_missing.lower_bound(range.first);
+        for (; itr != m_missing.end() && itr->first - range.first < range.second; ++itr)
+        {
+          if (itr->second.due < due)
+            itr->second.due = due;
+        }
+      }
+
+      //! Get the frames that should be requested now.
+      //! @param[in] now current time.
+      //! @param[in] interval time between requests of the same frame.
+      //! @param[in] tries maximum number of requests of a frame.
+      //! @param[out] ranges missing frames.
+      //! @return number of frames given up.
+      unsigned
+      getNacks(double now, double interval, unsigned tries, std::vector<NackRange>& ranges)
+      {
+        unsigned lost = 0;
+        Missing::iterator itr = m_missing.begin();
+        while (itr != m_missing.end())
+        {
+          if (itr->second.due > now)
+          {
+            ++itr;
+            continue;
+          }
+
+          if (itr->second.tries >= tries)
+          {
+            m_missing.erase(itr++);
+            ++lost;
+            continue;
+          }
+
+          itr->second.due = now + interval;
+          ++itr->second.tries;
+
+          if (!ranges.empty()
+              && ranges.back().first + ranges.back().second == itr->first
+              && ranges.back().second < 0xffff)
+            ++ranges.back().second;
+          else
+            ranges.push_back(NackRange(itr->first, 1));
+
+          ++itr;
+        }
+
+        return lost;
+      }
+
+    private:
+      //! Maximum number of missing frames tracked at once.
+      static const unsigned c_max_gap = 1024;
+
+      struct Request
+      {
+        //! Time of the next request.
+        double due;
+        //! Number of requests sent.
+        unsigned tries;
+      };
+
+      typedef std::map<uint32_t, Request> Missing;
+
+      //! Session of the stream.
+      uint16_t m_session;
+      //! Next expected sequence number.
+      uint32_t m_next;
+      //! True if the stream is being tracked.
+      bool m_synced;
+      //! Missing frames.
+      Missing m_missing;
+
+      //! Start tracking a stream if it is new, restarted or too
+      //! far ahead. Frames sent before are not requested.
+      //! @return true if the stream was resynchronized.
+      bool
+      resync(uint16_t session, uint32_t seq)
+      {
+        if (m_synced && session == m_session
+            && (int32_t)(seq - m_next) < (int32_t)c_max_gap)
+          return false;
+
+        m_synced = true;
+        m_session = session;
+        m_next = seq + 1;
+        m_missing.clear();
+        return true;
+      }
+
+      //! Mark the frames between the next expected one and a given
+      //! one (exclusive) as missing.
+      void
+      addMissing(uint32_t end, double due)
+      {
+        Request req;
+        req.due = due;
+        req.tries = 0;
+
+        for (uint32_t seq = m_next; seq != end; ++seq)
+          m_missing[seq] = req;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,224 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_MULTICAST_SUBSCRIBER_TABLE_HPP_INCLUDED_
+#define TRANSPORTS_MULTICAST_SUBSCRIBER_TABLE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <cstdio>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Multicast
+  {
+    using DUNE_NAMESPACES;
+
+    //! Messages wanted by the receivers of a multicast group, as
+    //! advertised in their Announce services with the form
+    //! 'imc+mcast://<group>:<port>/<Message>,<Message>,...'.
+    class SubscriberTable
+    {
+    public:
+      SubscriberTable(void):
+        m_port(0)
+      { }
+
+      //! Set the multicast group of interest.
+      //! @param[in] group multicast address.
+      //! @param[in] port port.
+      void
+      setGroup(const Address& group, unsigned port)
+      {
+        m_group = group;
+        m_port = port;
+        m_nodes.clear();
+        m_ids.clear();
+      }
+
+      //! Create the service advertising a list of subscriptions.
+      //! @param[in] group multicast address.
+      //! @param[in] port port.
+      //! @param[in] msgs message abbreviations.
+      //! @return service URL.
+      static std::string
+      getService(const Address& group, unsigned port, const std::vector<std::string>& msgs)
+      {
+        std::string service = String::str("imc+mcast://%s:%u/", group.str().c_str(), port);
+        for (unsigned i = 0; i < msgs.size(); ++i)
+        {
+          if (i > 0)
+            service += ",";
+          service += msgs[i];
+        }
+        return service;
+      }
+
+      //! Update the subscriptions of a node.
+      //! @param[in] system node identifier.
+      //! @param[in] services announced services.
+      //! @param[in] now current time.
+      //! @return true if the set of subscribed messages changed.
+      bool
+      update(uint16_t system, const std::string& services, double now)
+      {
+        std::set<uint32_t> ids;
+        std::vector<std::string> list;
+        String::split(services, ";", list);
+
+        for (unsigned i = 0; i < list.size(); ++i)
+        {
+          if (list[i].compare(0, 12, "imc+mcast://", 12) != 0)
+            continue;
+
+          char address[128] = {0};
+          unsigned port = 0;
+          int offset = 0;
+          if (std::sscanf(list[i].c_str(), "%*[^:]://%127[^:]:%u/%n", address, &port, &offset) != 2
+              || offset == 0)
+            continue;
+
+          if (port != m_port || Address(address) != m_group)
+            continue;
+
+          std::vector<std::string> msgs;
+          String::split(list[i].substr(offset), ",", msgs);
+          for (unsigned j = 0; j < msgs.size(); ++j)
+          {
+            try
+            {
+              ids.insert(IMC::Factory::getIdFromAbbrev(msgs[j]));
+            }
+            catch (...)
+            { }
+          }
+        }
+
+        if (ids.empty())
+        {
+          if (m_nodes.erase(system) == 0)
+            return false;
+        }
+        else
+        {
+          Subscriber& sub = m_nodes[system];
+          sub.last = now;
+          if (sub.ids == ids)
+            return false;
+          sub.ids = ids;
+        }
+
+        return refresh();
+      }
+
+      //! Remove nodes that were not heard from for a while.
+      //! @param[in] deadline time before which nodes are removed.
+      //! @return true if the set of subscribed messages changed.
+      bool
+      expire(double deadline)
+      {
+        bool removed = false;
+        Nodes::iterator itr = m_nodes.begin();
+        while (itr != m_nodes.end())
+        {
+          if (itr->second.last < deadline)
+          {
+            m_nodes.erase(itr++);
+            removed = true;
+          }
+          else
+          {
+            ++itr;
+          }
+        }
+
+        return removed ? refresh() : false;
+      }
+
+      //! Test if a message is wanted by some receiver.
+      //! @param[in] id message identification number.
+      //! @return true if the message is wanted, false otherwise.
+      bool
+      isSubscribed(uint32_t id) const
+      {
+        return m_ids.find(id) != m_ids.end();
+      }
+
+      //! Get the number of receivers.
+      //! @return number of receivers.
+      unsigned
+      getCount(void) const
+      {
+        return m_nodes.size();
+      }
+
+    private:
+      struct Subscriber
+      {
+        //! Subscribed messages.
+        std::set<uint32_t> ids;
+        //! Time of the last announce.
+        double last;
+      };
+
+      typedef std::map<uint16_t, Subscriber> Nodes;
+
+      //! Multicast group.
+      Address m_group;
+      //! Multicast port.
+      unsigned m_port;
+      //! Subscribers by system identifier.
+      Nodes m_nodes;
+      //! Messages subscribed by any node.
+      std::set<uint32_t> m_ids;
+
+      //! Recompute the set of subscribed messages.
+      //! @return true if the set changed.
+      bool
+      refresh(void)
+      {
+        std::set<uint32_t> ids;
+        for (Nodes::iterator itr = m_nodes.begin(); itr != m_nodes.end(); ++itr)
+          ids.insert(itr->second.ids.begin(), itr->second.ids.end());
+
+        if (ids == m_ids)
+          return false;
+
+        m_ids.swap(ids);
+        return true;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,503 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Frame.hpp"
+#include "History.hpp"
+#include "Peer.hpp"
+#include "SubscriberTable.hpp"
+
+namespace Transports
+{
+  //! Multicast transport of IMC messages.
+  //!
+  //! Each message is sent once to a multicast group, whatever the
+  //! number of receivers, and only if some receiver subscribed to
+  //! it. Receivers advertise their subscriptions in their Announce
+  //! services. Selected messages are sent reliably: they are
+  //! numbered, kept for a while and sent again when a receiver
+  //! reports a gap with a NACK. NACKs are also sent to the group,
+  //! so that receivers missing the same frames do not all ask for
+  //! them.
+  //!
+  //! @author Ricardo Martins
+  namespace Multicast
+  {
+    using DUNE_NAMESPACES;
+
+    //! Size of datagram buffers.
+    static const unsigned c_bfr_size = 65535;
+    //! Maximum number of datagrams read at once.
+    static const unsigned c_dgrams = 8;
+    //! Socket poll timeout (s).
+    static const double c_poll_tout = 0.02;
+
+    struct Arguments
+    {
+      // Multicast address.
+      Address addr;
+      // Multicast port.
+      unsigned port;
+      // Multicast time to live.
+      unsigned ttl;
+      // Messages to send.
+      std::vector<std::string> messages;
+      // Messages sent reliably.
+      std::vector<std::string> reliable;
+      // Messages to receive.
+      std::vector<std::string> subscriptions;
+      // Number of reliable frames kept for retransmission.
+      unsigned history;
+      // Delay before requesting missing frames.
+      double nack_delay;
+      // Interval between requests of the same frame.
+      double nack_interval;
+      // Maximum number of requests of the same frame.
+      unsigned nack_tries;
+      // Heartbeat period.
+      double hb_period;
+      // Subscription timeout.
+      double sub_timeout;
+      // Trace incoming messages.
+      bool trace_in;
+      // Trace outgoing messages.
+      bool trace_out;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      // Task arguments.
+      Arguments m_args;
+      // Multicast socket.
+      UDPSocket m_sock;
+      // Transmission buffer.
+      uint8_t* m_bfr;
+      // Reception buffers.
+      uint8_t* m_rx;
+      // Session of our reliable stream.
+      uint16_t m_session;
+      // Next sequence number of our reliable stream.
+      uint32_t m_seq;
+      // True if a reliable frame was sent.
+      bool m_reliable_sent;
+      // Reliable frames kept for retransmission.
+      History m_history;
+      // Reliable streams of other nodes.
+      std::map<uint16_t, Peer> m_peers;
+      // Subscriptions of other nodes.
+      SubscriberTable m_subs;
+      // Messages sent reliably.
+      std::set<uint32_t> m_reliable_ids;
+      // Messages we subscribe to.
+      std::set<uint32_t> m_sub_ids;
+      // Heartbeat timer.
+      Time::Counter<double> m_hb_timer;
+      // Missing frames to request.
+      std::vector<NackRange> m_nacks;
+      // Message trace channel.
+      uint8_t m_trace_channel;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_bfr(NULL),
+        m_rx(NULL),
+        m_session(0),
+        m_seq(0),
+        m_reliable_sent(false),
+        m_trace_channel(IMC::dune_trace.getChannel(name))
+      {
+        param("Multicast Address", m_args.addr)
+        .defaultValue("224.0.75.70")
+        .description("Multicast address of the group");
+
+        param("Port", m_args.port)
+        .defaultValue("6100")
+        .description("UDP port of the group");
+
+        param("Time To Live", m_args.ttl)
+        .defaultValue("1")
+        .maximumValue("255")
+        .description("Time to live of multicast datagrams");
+
+        param("Transports", m_args.messages)
+        .defaultValue("")
+        .description("List of messages sent to the group. Messages are only"
+                     " sent if some receiver subscribed to them");
+
+        param("Reliable Messages", m_args.reliable)
+        .defaultValue("")
+        .description("List of messages retransmitted when receivers report"
+                     " losses");
+
+        param("Subscriptions", m_args.subscriptions)
+        .defaultValue("")
+        .description("List of messages received from the group");
+
+        param("History Size", m_args.history)
+        .defaultValue("512")
+        .description("Number of reliable frames kept for retransmission");
+
+        param("NACK Delay", m_args.nack_delay)
+        .defaultValue("0.05")
+        .minimumValue("0.0")
+        .units(Units::Second)
+        .description("Time to wait for reordered frames before requesting"
+                     " missing ones");
+
+        param("NACK Interval", m_args.nack_interval)
+        .defaultValue("0.5")
+        .minimumValue("0.01")
+        .units(Units::Second)
+        .description("Time between requests of the same frame");
+
+        param("Maximum NACKs", m_args.nack_tries)
+        .defaultValue("5")
+        .description("Number of requests of a missing frame before giving up");
+
+        param("Heartbeat Period", m_args.hb_period)
+        .defaultValue("1.0")
+        .minimumValue("0.1")
+        .units(Units::Second)
+        .description("Interval between announcements of the last reliable"
+                     " frame, used to detect losses at the end of bursts");
+
+        param("Subscription Timeout", m_args.sub_timeout)
+        .defaultValue("60")
+        .units(Units::Second)
+        .description("Time after which subscriptions of silent nodes are"
+                     " dropped");
+
+        param("Print Outgoing Messages", m_args.trace_out)
+        .defaultValue("false")
+        .description("Record outgoing messages in the message trace (Debug)");
+
+        param("Print Incoming Messages", m_args.trace_in)
+        .defaultValue("false")
+        .description("Record incoming messages in the message trace (Debug)");
+
+        m_bfr = new uint8_t[c_bfr_size];
+        m_rx = new uint8_t[c_bfr_size * c_dgrams];
+
+        // Sessions tell receivers that we restarted.
+        m_session = (uint16_t)Clock::getSinceEpochMsec();
+
+        bind<IMC::Announce>(this);
+      }
+
+      ~Task(void)
+      {
+        delete [] m_bfr;
+        delete [] m_rx;
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_reliable_ids.clear();
+        for (unsigned i = 0; i < m_args.reliable.size(); ++i)
+          m_reliable_ids.insert(IMC::Factory::getIdFromAbbrev(m_args.reliable[i]));
+
+        m_sub_ids.clear();
+        for (unsigned i = 0; i < m_args.subscriptions.size(); ++i)
+          m_sub_ids.insert(IMC::Factory::getIdFromAbbrev(m_args.subscriptions[i]));
+
+        m_history.setCapacity(m_args.history);
+        m_subs.setGroup(m_args.addr, m_args.port);
+        m_hb_timer.setTop(m_args.hb_period);
+
+        bind(this, m_args.messages);
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_sock.setMulticastTTL(m_args.ttl);
+        // Other nodes on this computer are members of the group too,
+        // our own frames are recognized by their system identifier.
+        m_sock.setMulticastLoop(true);
+
+        std::vector<Interface> itfs = Interface::get();
+        for (unsigned i = 0; i < itfs.size(); ++i)
+          m_sock.joinMulticastGroup(m_args.addr, itfs[i].address());
+
+        m_sock.bind(m_args.port, Address::Any, true);
+        inf(DTR("listening on %s:%u"), m_args.addr.c_str(), m_args.port);
+
+        if (!m_args.subscriptions.empty())
+        {
+          IMC::AnnounceService announce;
+          announce.service = SubscriberTable::getService(m_args.addr, m_args.port,
+                                                         m_args.subscriptions);
+          announce.service_type = IMC::AnnounceService::SRV_TYPE_EXTERNAL;
+          dispatch(announce);
+        }
+
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      consume(const IMC::Announce* msg)
+      {
+        if (msg->getSource() == getSystemId())
+          return;
+
+        if (m_subs.update(msg->getSource(), msg->services, Clock::get()))
+          debug("subscriptions of %u receivers changed", m_subs.getCount());
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        // Only our own messages are sent, to avoid relaying messages
+        // received from other nodes back to the network.
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (!m_subs.isSubscribed(msg->getId()))
+          return;
+
+        Frame frame;
+        frame.system = getSystemId();
+        frame.session = m_session;
+
+        bool reliable = m_reliable_ids.find(msg->getId()) != m_reliable_ids.end();
+        if (reliable)
+        {
+          frame.type = FT_RELIABLE;
+          frame.seq = m_seq;
+        }
+
+        unsigned size = frame.serialize(m_bfr);
+        size += IMC::Packet::serialize(msg, m_bfr + size, c_bfr_size - size);
+
+        if (reliable)
+        {
+          m_history.add(m_seq++, m_bfr, size);
+          m_reliable_sent = true;
+        }
+
+        if (m_args.trace_out)
+          IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_OUT, size);
+
+        m_sock.write(m_bfr, size, m_args.addr, m_args.port);
+      }
+
+      //! Send again the frames requested by a NACK.
+      //! @param[in] range requested frames.
+      void
+      retransmit(const NackRange& range)
+      {
+        unsigned missing = 0;
+        for (uint32_t i = 0; i < range.second; ++i)
+        {
+          const std::vector<uint8_t>* frame = m_history.find(range.first + i);
+          if (frame == NULL)
+          {
+            ++missing;
+            continue;
+          }
+
+          m_sock.write(&(*frame)[0], frame->size(), m_args.addr, m_args.port);
+        }
+
+        if (missing > 0)
+          debug("%u requested frames are no longer available", missing);
+      }
+
+      //! Handle a frame received from the group.
+      //! @param[in] data frame.
+      //! @param[in] size size of frame.
+      //! @param[in] now current time.
+      void
+      handleFrame(const uint8_t* data, uint16_t size, double now)
+      {
+        Frame frame;
+        unsigned offset = frame.deserialize(data, size);
+
+        if (frame.type == FT_NACK)
+        {
+          if (size < c_nack_size)
+            throw IMC::BufferTooShort();
+
+          uint16_t length = size - offset;
+          NackRange range(frame.seq, 0);
+          IMC::deserialize(range.second, data + offset, length);
+
+          if (frame.system == getSystemId())
+          {
+            if (frame.session == m_session)
+              retransmit(range);
+            return;
+          }
+
+          std::map<uint16_t, Peer>::iterator itr = m_peers.find(frame.system);
+          if (itr != m_peers.end() && itr->second.getSession() == frame.session)
+            itr->second.suppress(range, now + m_args.nack_interval);
+          return;
+        }
+
+        if (frame.system == getSystemId())
+          return;
+
+        double due = now + m_args.nack_delay;
+
+        if (frame.type == FT_HEARTBEAT)
+        {
+          m_peers[frame.system].heartbeat(frame.session, frame.seq, due);
+          return;
+        }
+
+        if (frame.type == FT_RELIABLE)
+        {
+          if (!m_peers[frame.system].receive(frame.session, frame.seq, due))
+            return;
+        }
+
+        IMC::Message* msg = IMC::Packet::deserialize(data + offset, size - offset);
+        if (msg == NULL)
+          return;
+
+        if (m_sub_ids.find(msg->getId()) != m_sub_ids.end())
+        {
+          dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+
+          if (m_args.trace_in)
+            IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_IN, size - offset);
+        }
+
+        delete msg;
+      }
+
+      //! Read all pending datagrams.
+      void
+      readFrames(void)
+      {
+        size_t sizes[c_dgrams];
+        Address addrs[c_dgrams];
+        unsigned count = m_sock.read(m_rx, c_bfr_size, c_dgrams, sizes, addrs);
+        double now = Clock::get();
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+          try
+          {
+            handleFrame(m_rx + i * c_bfr_size, sizes[i], now);
+          }
+          catch (std::exception& e)
+          {
+            debug("error while unpacking frame from %s: %s", addrs[i].c_str(), e.what());
+          }
+        }
+      }
+
+      //! Request missing frames of other nodes.
+      void
+      sendNacks(void)
+      {
+        double now = Clock::get();
+        std::map<uint16_t, Peer>::iterator itr = m_peers.begin();
+        for (; itr != m_peers.end(); ++itr)
+        {
+          m_nacks.clear();
+          unsigned lost = itr->second.getNacks(now, m_args.nack_interval,
+                                               m_args.nack_tries, m_nacks);
+          if (lost > 0)
+            debug("gave up %u frames of '%s'", lost, resolveSystemId(itr->first));
+
+          Frame frame;
+          frame.type = FT_NACK;
+          frame.system = itr->first;
+          frame.session = itr->second.getSession();
+
+          for (unsigned i = 0; i < m_nacks.size(); ++i)
+          {
+            frame.seq = m_nacks[i].first;
+            unsigned size = frame.serialize(m_bfr);
+            size += IMC::serialize(m_nacks[i].second, m_bfr + size);
+            m_sock.write(m_bfr, size, m_args.addr, m_args.port);
+          }
+        }
+      }
+
+      //! Announce the last reliable frame sent.
+      void
+      sendHeartbeat(void)
+      {
+        Frame frame;
+        frame.type = FT_HEARTBEAT;
+        frame.system = getSystemId();
+        frame.session = m_session;
+        frame.seq = m_seq - 1;
+
+        unsigned size = frame.serialize(m_bfr);
+        m_sock.write(m_bfr, size, m_args.addr, m_args.port);
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          try
+          {
+            if (Poll::poll(m_sock, c_poll_tout))
+              readFrames();
+          }
+          catch (std::exception& e)
+          {
+            debug("error while receiving frames: %s", e.what());
+          }
+
+          consumeMessages();
+          sendNacks();
+
+          if (m_hb_timer.overflow())
+          {
+            m_hb_timer.reset();
+
+            if (m_reliable_sent)
+              sendHeartbeat();
+
+            if (m_subs.expire(Clock::get() - m_args.sub_timeout))
+              debug("subscriptions of %u receivers changed", m_subs.getCount());
+          }
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -29,7 +29,8 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <fstream>
+#include <set>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
@@ -45,9 +46,13 @@ namespace Transports
       std::string startup_file;
       std::vector<std::string> msgs;
       std::vector<std::string> ents;
+      bool accelerated;
+      double consume_timeout;
     };
 
     static const int c_stats_period = 10;
+    //! Period to check if recipients consumed a message (s).
+    static const double c_consume_period = 1e-04;
 
     struct Task: public DUNE::Tasks::Task
     {
@@ -59,21 +64,21 @@ namespace Transports
       typedef std::map<uint8_t, std::string> Eid2Name;
       Eid2Name m_eid2name;
 
-      typedef std::map<uint8_t, uint8_t> Eid2Eid;
-      Eid2Eid m_eid2eid;
+      //! Entity ids of the log file mapped to local entity ids.
+      uint8_t m_eid2eid[256];
 
       typedef std::map<std::string, bool> ReplayMsg;
       ReplayMsg m_replay;
+      //! Replayed messages, indexed by message id.
+      std::vector<bool> m_replay_ids;
 
       double m_ts_delta;
       double m_start_time;
 
-      // Replay file handle
-      std::ifstream* m_ifs;
+      // Replay file reader.
+      IMC::LogReader* m_reader;
       // last state from replay file
       IMC::EstimatedState m_estate;
-      // IMC parser handle
-      IMC::Parser m_parser;
 
       struct Stats
       {
@@ -96,8 +101,11 @@ namespace Transports
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
-        m_ifs(0)
+        m_replay_ids(0x10000, false),
+        m_reader(0)
       {
+        std::memset(m_eid2eid, DUNE_IMC_CONST_UNK_EID, sizeof(m_eid2eid));
+
         param("Load At Start", m_args.startup_file)
         .defaultValue("")
         .description("File to load for replay at startup");
@@ -110,6 +118,20 @@ namespace Transports
         .defaultValue("")
         .description("Entities for which state should be reported");
 
+        param("Accelerated Playback", m_args.accelerated)
+        .defaultValue("false")
+        .description("Replay messages as fast as they are consumed. The clock "
+                     "of all tasks is held at the time of the last replayed "
+                     "message, which is only replaced after all its "
+                     "recipients consumed it");
+
+        param("Consumption Timeout", m_args.consume_timeout)
+        .units(Units::Second)
+        .defaultValue("5.0")
+        .minimumValue("0.01")
+        .description("Maximum time to wait for recipients to consume each "
+                     "message in accelerated playback");
+
         bind<IMC::ReplayControl>(this);
       }
 
@@ -119,6 +141,17 @@ namespace Transports
         for (unsigned i = 0; i < m_args.msgs.size(); ++i)
           m_replay[m_args.msgs[i]] = true;
 
+        m_replay_ids.assign(0x10000, false);
+        for (ReplayMsg::iterator itr = m_replay.begin(); itr != m_replay.end(); ++itr)
+        {
+          try
+          {
+            m_replay_ids[IMC::Factory::getIdFromAbbrev(itr->first)] = true;
+          }
+          catch (...)
+          { }
+        }
+
         if (m_replay.find("EstimatedState") == m_replay.end())
           bind<IMC::EstimatedState>(this);
 
@@ -184,12 +217,7 @@ namespace Transports
       mapEntity(uint8_t eid)
       {
         // Convert ent. id read from file to local context
-        Eid2Eid::iterator itr = m_eid2eid.find(eid);
-
-        if (itr == m_eid2eid.end())
-          return DUNE_IMC_CONST_UNK_EID;
-
-        return itr->second;
+        return m_eid2eid[eid];
       }
 
       void
@@ -206,7 +234,8 @@ namespace Transports
 
         try
         {
-          m_ifs = new std::ifstream(file.c_str(), std::ios::binary);
+          m_reader = new IMC::LogReader(file);
+          m_reader->setFilter(getReplayedIds());
         }
         catch (std::exception& e)
         {
@@ -218,7 +247,7 @@ namespace Transports
 
         try
         {
-          m = IMC::Packet::deserialize(*m_ifs);
+          m = m_reader->read();
         }
         catch (std::exception& e)
         {
@@ -261,8 +290,36 @@ namespace Transports
 
         requestActivation();
 
-        war("%s '%s'", DTR("started replay of"), file.c_str());
-        m_parser.reset();
+        if (m_args.accelerated)
+          war("%s '%s' (%s)", DTR("started replay of"), file.c_str(), DTR("accelerated"));
+        else
+          war("%s '%s'", DTR("started replay of"), file.c_str());
+      }
+
+      //! Get the identifiers of messages read from replay files.
+      //! @return message identifiers.
+      std::set<uint16_t>
+      getReplayedIds(void)
+      {
+        std::set<uint16_t> ids;
+        ids.insert(DUNE_IMC_LOGGINGCONTROL);
+        ids.insert(DUNE_IMC_ESTIMATEDSTATE);
+        ids.insert(DUNE_IMC_ENTITYINFO);
+        ids.insert(DUNE_IMC_ENTITYSTATE);
+
+        for (ReplayMsg::iterator itr = m_replay.begin(); itr != m_replay.end(); ++itr)
+        {
+          try
+          {
+            ids.insert(IMC::Factory::getIdFromAbbrev(itr->first));
+          }
+          catch (std::exception& e)
+          {
+            war("%s", e.what());
+          }
+        }
+
+        return ids;
       }
 
       void
@@ -310,17 +367,46 @@ namespace Transports
       {
         requestDeactivation();
 
-        if (m_ifs)
-        {
-          delete m_ifs;
-          m_ifs = 0;
-        }
-        m_eid2eid.clear();
+        Memory::clear(m_reader);
+        std::memset(m_eid2eid, DUNE_IMC_CONST_UNK_EID, sizeof(m_eid2eid));
         m_name2eid.clear();
         m_eid2name.clear();
         m_tstats.clear();
         m_tgstats = Stats();
-        m_parser.reset();
+
+        // Let time run again from the last replayed message.
+        if (Clock::isHeld())
+          Clock::release();
+      }
+
+      //! Dispatch a message and wait until all its recipients
+      //! consumed it.
+      //! @param[in] msg message (ownership is transferred).
+      void
+      dispatchAndWait(IMC::Message* msg)
+      {
+        // Same as dispatch() with DF_KEEP_TIME.
+        if (!IMC::AddressResolver::isValid(msg->getSource()))
+          msg->setSource(getSystemId());
+
+        if (msg->getSourceEntity() == DUNE_IMC_CONST_UNK_EID)
+          msg->setSourceEntity(getEntityId());
+
+        IMC::SharedMessage* shared = IMC::SharedMessage::adopt(msg);
+        m_ctx.mbus.dispatch(shared, this);
+
+        // The clock is held, poll in system time.
+        double waited = 0;
+        while (shared->isShared() && waited < m_args.consume_timeout)
+        {
+          Delay::waitSystem(c_consume_period);
+          waited += c_consume_period;
+        }
+
+        if (shared->isShared())
+          war(DTR("%s was not consumed in time"), shared->get()->getName());
+
+        shared->release();
       }
 
       void
@@ -344,11 +430,13 @@ namespace Transports
 
           IMC::Message* m = 0;
 
-          while (!m_ifs->eof() && !m)
+          try
+          {
+            m = m_reader->read();
+          }
+          catch (std::exception& e)
           {
-            char c;
-            m_ifs->get(c);
-            m = m_parser.parse((uint8_t)c);
+            err("%s: %s", DTR("deserialization error"), e.what());
           }
 
           if (!m)
@@ -378,7 +466,7 @@ namespace Transports
           m->setSourceEntity(mapEntity(m->getSourceEntity()));
           m->setDestinationEntity(mapEntity(m->getDestinationEntity()));
 
-          if ((m->getId() == DUNE_IMC_ENTITYSTATE && m->getSourceEntity() != DUNE_IMC_CONST_UNK_EID) || m_replay.find(m->getName()) != m_replay.end())
+          if ((m->getId() == DUNE_IMC_ENTITYSTATE && m->getSourceEntity() != DUNE_IMC_CONST_UNK_EID) || m_replay_ids[m->getId()])
           {
             double original_ts;
 
@@ -390,40 +478,52 @@ namespace Transports
             double new_ts = original_ts + m_ts_delta;
             m->setTimeStamp(new_ts);
 
-            // Wait till the time is right
             double now = Clock::getSinceEpoch();
-            double delta = new_ts - now;
+            double delay = 0;
 
-            double delay;
-
-            if (delta >= 1e-03)
+            if (m_args.accelerated)
             {
-              // Delay::wait does not behave satisfactorily otherwise
-              // in some systems
-              Delay::wait(delta);
-              delay = Clock::getSinceEpoch() - new_ts;
+              // Time moves to the message as soon as the previous
+              // one was consumed.
+              Clock::hold(new_ts);
             }
             else
             {
-              delay = 0;
-              delta = 0;
+              // Wait till the time is right
+              double delta = new_ts - now;
+
+              if (delta >= 1e-03)
+              {
+                // Delay::wait does not behave satisfactorily otherwise
+                // in some systems
+                Delay::wait(delta);
+                delay = Clock::getSinceEpoch() - new_ts;
+              }
             }
 
             // Counter for delay before bus delivery
             updateStats(m_tstats[m->getName()], delay);
             updateStats(m_tgstats, delay);
 
+            trace("%s %0.4f %s", m->getName(), (new_ts - m_start_time),
+                  m_eid2name[m->getSourceEntity()].c_str());
+
             // Dispatch message
-            dispatch(m, DF_KEEP_TIME);
+            if (m_args.accelerated)
+            {
+              dispatchAndWait(m);
+              m = NULL;
+            }
+            else
+            {
+              dispatch(m, DF_KEEP_TIME);
+            }
 
             if (now >= m_next_stats)
             {
               displayStats();
               m_next_stats += c_stats_period;
             }
-
-            trace("%s %0.4f %s", m->getName(), (new_ts - m_start_time),
-                  m_eid2name[m->getSourceEntity()].c_str());
           }
 
           // Clean up
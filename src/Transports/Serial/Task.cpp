@@ -65,6 +65,8 @@ namespace Transports
         param("Serial Port - Baud Rate", m_args.baud_rate)
         .defaultValue("9600")
         .description("Serial port baud rate");
+
+        m_parser.setReuse(true);
       }
 
       void
@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_SHARED_MEMORY_READER_HPP_INCLUDED_
+#define TRANSPORTS_SHARED_MEMORY_READER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Ring.hpp"
+
+namespace Transports
+{
+  namespace SharedMemory
+  {
+    using DUNE_NAMESPACES;
+
+    //! Time between attempts to open the ring of the peer (s).
+    static const double c_attach_period = 1.0;
+    //! Maximum time waiting for the doorbell (s).
+    static const double c_doorbell_wait = 1.0;
+
+    //! Thread that attaches to the ring written by the peer and
+    //! dispatches its messages.
+    class Reader: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] task parent task.
+      //! @param[in] name name of the ring.
+      //! @param[in] capacity size of the ring.
+      //! @param[in] subs messages wanted from the peer (empty for all).
+      //! @param[in] timeout time without signs of life from the peer
+      //! after which the ring is opened again.
+      //! @param[in] trace true to record incoming messages in the
+      //! message trace.
+      Reader(Tasks::Task& task, const std::string& name, unsigned capacity,
+             const std::vector<uint32_t>& subs, double timeout, bool trace):
+        m_task(task),
+        m_name(name),
+        m_capacity(capacity),
+        m_subs(subs),
+        m_timeout(timeout),
+        m_trace(trace),
+        m_trace_channel(IMC::dune_trace.getChannel(task.getName())),
+        m_ring(NULL),
+        m_beat(0),
+        m_beat_time(0)
+      { }
+
+      ~Reader(void)
+      {
+        Memory::clear(m_ring);
+      }
+
+    private:
+      //! Parent task.
+      Tasks::Task& m_task;
+      //! Ring name.
+      std::string m_name;
+      //! Ring size.
+      unsigned m_capacity;
+      //! Subscribed messages.
+      std::vector<uint32_t> m_subs;
+      //! Peer timeout.
+      double m_timeout;
+      //! True to record incoming messages in the message trace.
+      bool m_trace;
+      //! Message trace channel.
+      uint8_t m_trace_channel;
+      //! Ring written by the peer.
+      Ring* m_ring;
+      //! Last liveness counter of the peer.
+      uint32_t m_beat;
+      //! Time at which the liveness counter last changed.
+      double m_beat_time;
+
+      //! Open the ring of the peer.
+      //! @return true if the ring was opened.
+      bool
+      attach(void)
+      {
+        m_ring = new Ring(m_name, m_capacity);
+
+        try
+        {
+          m_ring->open();
+        }
+        catch (std::exception& e)
+        {
+          Memory::clear(m_ring);
+          return false;
+        }
+
+        m_ring->setSubscriptions(m_subs);
+        m_beat = m_ring->getBeat();
+        m_beat_time = Clock::get();
+        m_task.inf(DTR("attached to ring '%s'"), m_ring->getName().c_str());
+        return true;
+      }
+
+      //! Test if the peer stopped updating its ring.
+      //! @return true if the peer is gone.
+      bool
+      isPeerGone(void)
+      {
+        if (m_ring->isClosed())
+          return true;
+
+        double now = Clock::get();
+        uint32_t beat = m_ring->getBeat();
+        if (beat != m_beat)
+        {
+          m_beat = beat;
+          m_beat_time = now;
+          return false;
+        }
+
+        return now - m_beat_time > m_timeout;
+      }
+
+      //! Dispatch all messages in the ring.
+      void
+      drain(void)
+      {
+        uint32_t size = 0;
+        const uint8_t* data = NULL;
+        while ((data = m_ring->peek(size)) != NULL)
+        {
+          try
+          {
+            IMC::Message* msg = IMC::Packet::deserialize(data, size);
+            if (msg != NULL)
+            {
+              m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+
+              if (m_trace)
+                IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_IN, size);
+
+              delete msg;
+            }
+          }
+          catch (std::exception& e)
+          {
+            m_task.debug("error while unpacking message: %s", e.what());
+          }
+
+          m_ring->release(size);
+        }
+      }
+
+      void
+      run(void)
+      {
+        while (!isStopping())
+        {
+          if (m_ring == NULL && !attach())
+          {
+            Delay::wait(c_attach_period);
+            continue;
+          }
+
+          drain();
+
+          if (isPeerGone())
+          {
+            m_task.war(DTR("detached from ring '%s'"), m_ring->getName().c_str());
+            Memory::clear(m_ring);
+            continue;
+          }
+
+          m_ring->wait(c_doorbell_wait);
+        }
+      }
+    };
+  }
+}
+
+#endif
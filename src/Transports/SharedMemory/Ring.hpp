@@ -0,0 +1,410 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_SHARED_MEMORY_RING_HPP_INCLUDED_
+#define TRANSPORTS_SHARED_MEMORY_RING_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SEMAPHORE_H)
+#  include <semaphore.h>
+#endif
+
+namespace Transports
+{
+  namespace SharedMemory
+  {
+    using DUNE_NAMESPACES;
+
+    //! Ring identification number.
+    static const uint32_t c_ring_magic = 0x444D5252;
+    //! Length of records used to skip the end of the ring.
+    static const uint32_t c_ring_pad = 0xFFFFFFFF;
+    //! Number of bytes of the subscription bitmap.
+    static const unsigned c_ring_subs = 65536 / 8;
+
+    //! Control block at the start of a ring.
+    struct RingHeader
+    {
+      //! Set to c_ring_magic after initialization.
+      volatile uint32_t magic;
+      //! Size of the data area (a power of two).
+      uint32_t capacity;
+      //! Bytes written (modulo 2^32).
+      volatile uint32_t head;
+      //! Bytes read (modulo 2^32).
+      volatile uint32_t tail;
+      //! Non-zero while the reader waits for the doorbell.
+      volatile uint32_t sleeping;
+      //! Non-zero after the writer closes the ring.
+      volatile uint32_t closed;
+      //! Incremented periodically while the writer is alive.
+      volatile uint32_t beat;
+      //! Records dropped because the ring was full.
+      volatile uint32_t dropped;
+#if defined(DUNE_SYS_HAS_SEMAPHORE_H)
+      //! Doorbell rung by the writer when the reader is sleeping.
+      sem_t doorbell;
+#endif
+      //! Messages wanted by the reader, one bit per identifier.
+      volatile uint8_t subs[c_ring_subs];
+    };
+
+    //! Single-producer, single-consumer ring of IMC packets in shared
+    //! memory. The process that writes the ring creates it and the
+    //! other one opens it. Records are a 32-bit length followed by
+    //! the packet, always contiguous, so that packets are serialized
+    //! and deserialized in place. The reader sleeps on a
+    //! process-shared semaphore that the writer only posts when the
+    //! reader announced it is sleeping.
+    class Ring
+    {
+    public:
+      //! Constructor.
+      //! @param[in] name ring name.
+      //! @param[in] capacity data area size (rounded up to the next
+      //! power of two).
+      Ring(const std::string& name, unsigned capacity):
+        m_shm(NULL),
+        m_hdr(NULL),
+        m_data(NULL),
+        m_capacity(2),
+        m_creator(false)
+      {
+        while (m_capacity < capacity)
+          m_capacity <<= 1;
+
+        // The capacity is part of the name so that rings of
+        // different sizes are never mapped over each other.
+        m_name = String::str("%s-%u", name.c_str(), m_capacity);
+      }
+
+      ~Ring(void)
+      {
+        // The doorbell is not destroyed: the reader may still be
+        // waiting on it and will notice that the ring is closed.
+        if (m_shm != NULL && m_creator)
+        {
+          m_hdr->closed = 1;
+          ring();
+        }
+
+        delete m_shm;
+      }
+
+      //! Create the ring, to be written by this process.
+      void
+      create(void)
+      {
+        m_creator = true;
+        map();
+
+        m_hdr->magic = 0;
+        m_hdr->capacity = m_capacity;
+        m_hdr->head = 0;
+        m_hdr->tail = 0;
+        m_hdr->sleeping = 0;
+        m_hdr->closed = 0;
+        m_hdr->beat = 0;
+        m_hdr->dropped = 0;
+        std::memset((void*)m_hdr->subs, 0, c_ring_subs);
+
+#if defined(DUNE_SYS_HAS_SEMAPHORE_H)
+        if (sem_init(&m_hdr->doorbell, 1, 0) != 0)
+          throw System::Error(errno, DTR("failed to initialize doorbell"));
+#endif
+
+        __sync_synchronize();
+        m_hdr->magic = c_ring_magic;
+      }
+
+      //! Open a ring created by another process, to be read by this
+      //! process.
+      //! @throw std::runtime_error if the ring does not exist or is
+      //! not initialized.
+      void
+      open(void)
+      {
+        m_creator = false;
+        map();
+
+        __sync_synchronize();
+        if (m_hdr->magic != c_ring_magic || m_hdr->capacity != m_capacity)
+          throw std::runtime_error(DTR("ring is not initialized"));
+      }
+
+      //! Get the ring name.
+      //! @return ring name.
+      const std::string&
+      getName(void) const
+      {
+        return m_name;
+      }
+
+      //! Test if the writer closed the ring.
+      //! @return true if the ring is closed.
+      bool
+      isClosed(void) const
+      {
+        return m_hdr->closed != 0;
+      }
+
+      //! Get the liveness counter of the writer.
+      //! @return liveness counter.
+      uint32_t
+      getBeat(void) const
+      {
+        return m_hdr->beat;
+      }
+
+      //! Increment the liveness counter (writer only).
+      void
+      beat(void)
+      {
+        ++m_hdr->beat;
+      }
+
+      //! Get and reset the number of dropped records (writer only).
+      //! @return number of dropped records.
+      uint32_t
+      takeDropped(void)
+      {
+        uint32_t dropped = m_hdr->dropped;
+        m_hdr->dropped = 0;
+        return dropped;
+      }
+
+      //! Test if the reader wants a message (writer only).
+      //! @param[in] id message identification number.
+      //! @return true if the message is wanted.
+      bool
+      isSubscribed(uint16_t id) const
+      {
+        return (m_hdr->subs[id >> 3] & (1 << (id & 7))) != 0;
+      }
+
+      //! Set the messages wanted by the reader (reader only).
+      //! @param[in] ids message identification numbers, or empty for
+      //! all messages.
+      void
+      setSubscriptions(const std::vector<uint32_t>& ids)
+      {
+        if (ids.empty())
+        {
+          std::memset((void*)m_hdr->subs, 0xff, c_ring_subs);
+          return;
+        }
+
+        std::memset((void*)m_hdr->subs, 0, c_ring_subs);
+        for (unsigned i = 0; i < ids.size(); ++i)
+          m_hdr->subs[(ids[i] >> 3) & (c_ring_subs - 1)] |= 1 << (ids[i] & 7);
+      }
+
+      //! Reserve contiguous space for a record (writer only).
+      //! @param[in] size record size.
+      //! @return pointer to the record or NULL if the ring is full.
+      uint8_t*
+      reserve(uint32_t size)
+      {
+        uint32_t need = align(size + 4);
+        uint32_t head = m_hdr->head;
+        uint32_t offset = head & (m_capacity - 1);
+        uint32_t pad = (offset + need > m_capacity) ? m_capacity - offset : 0;
+
+        __sync_synchronize();
+        if (need + pad > m_capacity - (head - m_hdr->tail))
+        {
+          ++m_hdr->dropped;
+          return NULL;
+        }
+
+        if (pad > 0)
+        {
+          // Record with no payload: the reader skips to the start.
+          std::memcpy(m_data + offset, &c_ring_pad, 4);
+          __sync_synchronize();
+          m_hdr->head = head + pad;
+          offset = 0;
+        }
+
+        std::memcpy(m_data + offset, &size, 4);
+        return m_data + offset + 4;
+      }
+
+      //! Publish the record returned by the last call to reserve()
+      //! (writer only).
+      //! @param[in] size record size.
+      void
+      commit(uint32_t size)
+      {
+        __sync_synchronize();
+        m_hdr->head = m_hdr->head + align(size + 4);
+        __sync_synchronize();
+
+        if (m_hdr->sleeping)
+          ring();
+      }
+
+      //! Get the oldest record (reader only).
+      //! @param[out] size record size.
+      //! @return pointer to the record or NULL if the ring is empty.
+      const uint8_t*
+      peek(uint32_t& size)
+      {
+        while (true)
+        {
+          uint32_t tail = m_hdr->tail;
+          __sync_synchronize();
+          if (m_hdr->head == tail)
+            return NULL;
+
+          uint32_t offset = tail & (m_capacity - 1);
+          std::memcpy(&size, m_data + offset, 4);
+
+          if (size == c_ring_pad)
+          {
+            __sync_synchronize();
+            m_hdr->tail = tail + (m_capacity - offset);
+            continue;
+          }
+
+          return m_data + offset + 4;
+        }
+      }
+
+      //! Remove the record returned by peek() (reader only).
+      //! @param[in] size record size.
+      void
+      release(uint32_t size)
+      {
+        __sync_synchronize();
+        m_hdr->tail = m_hdr->tail + align(size + 4);
+      }
+
+      //! Wait for records (reader only).
+      //! @param[in] timeout maximum amount of time to wait (s).
+      void
+      wait(double timeout)
+      {
+        m_hdr->sleeping = 1;
+        __sync_synchronize();
+
+        if (m_hdr->head == m_hdr->tail && !isClosed())
+        {
+#if defined(DUNE_SYS_HAS_SEMAPHORE_H)
+          struct timespec ts;
+          clock_gettime(CLOCK_REALTIME, &ts);
+          uint64_t nsec = ts.tv_nsec + (uint64_t)(timeout * 1e9);
+          ts.tv_sec += nsec / 1000000000;
+          ts.tv_nsec = nsec % 1000000000;
+          sem_timedwait(&m_hdr->doorbell, &ts);
+#else
+          Delay::wait(std::min(timeout, 0.01));
+#endif
+        }
+
+        m_hdr->sleeping = 0;
+      }
+
+    private:
+      //! Shared memory area.
+      Concurrency::SharedMemory* m_shm;
+      //! Control block.
+      RingHeader* m_hdr;
+      //! Data area.
+      uint8_t* m_data;
+      //! Size of the data area.
+      uint32_t m_capacity;
+      //! Ring name.
+      std::string m_name;
+      //! True if this process created the ring.
+      bool m_creator;
+
+      static uint32_t
+      align(uint32_t size)
+      {
+        return (size + 3) & ~3U;
+      }
+
+      //! Map the shared memory area.
+      void
+      map(void)
+      {
+        delete m_shm;
+        m_shm = new Concurrency::SharedMemory(m_name.c_str(), sizeof(RingHeader) + m_capacity);
+
+        try
+        {
+          if (m_creator)
+            m_shm->create();
+          else
+            m_shm->open();
+        }
+        catch (...)
+        {
+          Memory::clear(m_shm);
+          throw;
+        }
+
+        if (**m_shm == NULL)
+        {
+          Memory::clear(m_shm);
+          throw std::runtime_error(DTR("shared memory is not supported"));
+        }
+
+        m_hdr = static_cast<RingHeader*>(**m_shm);
+        m_data = reinterpret_cast<uint8_t*>(m_hdr + 1);
+      }
+
+      //! Wake up the reader.
+      void
+      ring(void)
+      {
+#if defined(DUNE_SYS_HAS_SEMAPHORE_H)
+        sem_post(&m_hdr->doorbell);
+#endif
+      }
+
+      // Non-copyable.
+      Ring(const Ring&);
+      Ring& operator=(const Ring&);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,211 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Ring.hpp"
+#include "Reader.hpp"
+
+namespace Transports
+{
+  //! Bridge between the buses of two DUNE instances running on the
+  //! same computer. Each instance writes its messages to a ring in
+  //! shared memory that the other one reads, so messages are
+  //! serialized and deserialized in place, without sockets or
+  //! intermediate buffers. Each instance tells the other which
+  //! messages it wants through its ring, and only those are written.
+  //!
+  //! @author Ricardo Martins
+  namespace SharedMemory
+  {
+    using DUNE_NAMESPACES;
+
+    struct Arguments
+    {
+      // Name of the ring written by this instance.
+      std::string outbound;
+      // Name of the ring written by the peer.
+      std::string inbound;
+      // Size of rings.
+      unsigned size;
+      // Messages to send.
+      std::vector<std::string> messages;
+      // Messages wanted from the peer.
+      std::vector<std::string> subscriptions;
+      // Time without signs of life from the peer.
+      double peer_timeout;
+      // Trace incoming messages.
+      bool trace_in;
+      // Trace outgoing messages.
+      bool trace_out;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      // Task arguments.
+      Arguments m_args;
+      // Ring written by this instance.
+      Ring* m_ring;
+      // Reader of the ring of the peer.
+      Reader* m_reader;
+      // Liveness timer.
+      Time::Counter<double> m_beat_timer;
+      // Message trace channel.
+      uint8_t m_trace_channel;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_ring(NULL),
+        m_reader(NULL),
+        m_trace_channel(IMC::dune_trace.getChannel(name))
+      {
+        param("Outbound Ring", m_args.outbound)
+        .defaultValue("")
+        .description("Name of the ring written by this instance");
+
+        param("Inbound Ring", m_args.inbound)
+        .defaultValue("")
+        .description("Name of the ring written by the other instance");
+
+        param("Ring Size", m_args.size)
+        .defaultValue("1048576")
+        .minimumValue("65536")
+        .units(Units::Byte)
+        .description("Size of rings, must be the same in both instances");
+
+        param("Transports", m_args.messages)
+        .defaultValue("")
+        .description("List of messages sent to the other instance");
+
+        param("Subscriptions", m_args.subscriptions)
+        .defaultValue("")
+        .description("List of messages wanted from the other instance"
+                     " (empty for all)");
+
+        param("Peer Timeout", m_args.peer_timeout)
+        .defaultValue("5.0")
+        .units(Units::Second)
+        .description("Time without signs of life after which the ring of"
+                     " the other instance is opened again");
+
+        param("Print Outgoing Messages", m_args.trace_out)
+        .defaultValue("false")
+        .description("Record outgoing messages in the message trace (Debug)");
+
+        param("Print Incoming Messages", m_args.trace_in)
+        .defaultValue("false")
+        .description("Record incoming messages in the message trace (Debug)");
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        bind(this, m_args.messages);
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        if (m_args.outbound.empty() || m_args.inbound.empty())
+          throw std::runtime_error(DTR("ring names are not configured"));
+
+        std::vector<uint32_t> subs;
+        for (unsigned i = 0; i < m_args.subscriptions.size(); ++i)
+          subs.push_back(IMC::Factory::getIdFromAbbrev(m_args.subscriptions[i]));
+
+        m_ring = new Ring(m_args.outbound, m_args.size);
+        m_ring->create();
+        inf(DTR("created ring '%s'"), m_ring->getName().c_str());
+
+        m_reader = new Reader(*this, m_args.inbound, m_args.size, subs,
+                              m_args.peer_timeout, m_args.trace_in);
+        m_reader->start();
+
+        m_beat_timer.setTop(m_args.peer_timeout / 4.0);
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        if (m_reader != NULL)
+        {
+          m_reader->stopAndJoin();
+          delete m_reader;
+          m_reader = NULL;
+        }
+
+        Memory::clear(m_ring);
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        if (m_ring == NULL || !m_ring->isSubscribed(msg->getId()))
+          return;
+
+        unsigned size = msg->getSerializationSize();
+        uint8_t* bfr = m_ring->reserve(size);
+        if (bfr == NULL)
+          return;
+
+        IMC::Packet::serialize(msg, bfr, size);
+        m_ring->commit(size);
+
+        if (m_args.trace_out)
+          IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_OUT, size);
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(m_beat_timer.getRemaining());
+
+          if (m_beat_timer.overflow())
+          {
+            m_beat_timer.reset();
+            m_ring->beat();
+
+            uint32_t dropped = m_ring->takeDropped();
+            if (dropped > 0)
+              war(DTR("ring is full, dropped %u messages"), dropped);
+          }
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -65,6 +65,8 @@ namespace Transports
           param("Server - Port", m_args.port)
           .defaultValue("7001")
           .description("Remote server port");
+
+          m_parser.setReuse(true);
         }
 
         ~Task(void)
@@ -0,0 +1,222 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_TCP_SERVER_OUTPUT_QUEUE_HPP_INCLUDED_
+#define TRANSPORTS_TCP_SERVER_OUTPUT_QUEUE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace TCP
+  {
+    namespace Server
+    {
+      using DUNE_NAMESPACES;
+
+      //! Serialized message shared by the queues of all clients.
+      struct OutputPacket
+      {
+        //! Packet data.
+        std::vector<uint8_t> data;
+        //! Number of queues holding the packet.
+        unsigned refs;
+
+        OutputPacket(const uint8_t* p, unsigned n):
+          data(p, p + n),
+          refs(0)
+        { }
+      };
+
+      //! Packets waiting to be written to one client. Pending packets
+      //! are written together with one gathered write whenever the
+      //! socket accepts more data.
+      class OutputQueue
+      {
+      public:
+        OutputQueue(void):
+          m_offset(0),
+          m_size(0)
+        { }
+
+        ~OutputQueue(void)
+        {
+          clear();
+        }
+
+        //! Get the number of bytes waiting to be written.
+        //! @return number of bytes.
+        size_t
+        getSize(void) const
+        {
+          return m_size;
+        }
+
+        //! Test if the queue is empty.
+        //! @return true if there is nothing to write.
+        bool
+        empty(void) const
+        {
+          return m_packets.empty();
+        }
+
+        //! Add a packet to the end of the queue.
+        //! @param[in] pkt packet.
+        void
+        push(OutputPacket* pkt)
+        {
+          ++pkt->refs;
+          m_packets.push_back(pkt);
+          m_size += pkt->data.size();
+        }
+
+        //! Drop the oldest packets until some space is freed. A packet
+        //! that is partially written is kept, since the client would
+        //! otherwise receive a truncated packet.
+        //! @param[in] bytes number of bytes to free.
+        //! @return number of dropped packets.
+        unsigned
+        dropOldest(size_t bytes)
+        {
+          unsigned dropped = 0;
+          size_t freed = 0;
+          std::deque<OutputPacket*>::iterator itr = m_packets.begin();
+          if (m_offset > 0 && itr != m_packets.end())
+            ++itr;
+
+          while (itr != m_packets.end() && freed < bytes)
+          {
+            freed += (*itr)->data.size();
+            release(*itr);
+            itr = m_packets.erase(itr);
+            ++dropped;
+          }
+
+          m_size -= freed;
+          return dropped;
+        }
+
+        //! Remove all packets.
+        void
+        clear(void)
+        {
+          for (size_t i = 0; i < m_packets.size(); ++i)
+            release(m_packets[i]);
+
+          m_packets.clear();
+          m_offset = 0;
+          m_size = 0;
+        }
+
+        //! Write as many packets as the socket accepts.
+        //! @param[in] sock non-blocking client socket.
+        //! @return number of bytes written.
+        size_t
+        flush(TCPSocket& sock)
+        {
+          size_t total = 0;
+
+          while (!m_packets.empty())
+          {
+            unsigned count = std::min((size_t)c_max_bfrs, m_packets.size());
+            size_t size = 0;
+            for (unsigned i = 0; i < count; ++i)
+            {
+              const std::vector<uint8_t>& data = m_packets[i]->data;
+              size_t offset = (i == 0) ? m_offset : 0;
+              m_bfrs[i] = &data[offset];
+              m_sizes[i] = data.size() - offset;
+              size += m_sizes[i];
+            }
+
+            size_t rv = sock.writeVector(m_bfrs, m_sizes, count);
+            total += rv;
+            consume(rv);
+
+            // The socket buffer is full.
+            if (rv < size)
+              break;
+          }
+
+          return total;
+        }
+
+      private:
+        //! Maximum number of packets per write.
+        static const unsigned c_max_bfrs = 64;
+        //! Pending packets.
+        std::deque<OutputPacket*> m_packets;
+        //! Bytes of the first packet already written.
+        size_t m_offset;
+        //! Bytes waiting to be written.
+        size_t m_size;
+        //! Buffers of the current write.
+        const uint8_t* m_bfrs[c_max_bfrs];
+        //! Sizes of the current write.
+        size_t m_sizes[c_max_bfrs];
+
+        //! Remove written bytes from the queue.
+        //! @param[in] bytes number of bytes written.
+        void
+        consume(size_t bytes)
+        {
+          m_size -= bytes;
+          bytes += m_offset;
+
+          while (!m_packets.empty() && bytes >= m_packets.front()->data.size())
+          {
+            bytes -= m_packets.front()->data.size();
+            release(m_packets.front());
+            m_packets.pop_front();
+          }
+
+          m_offset = bytes;
+        }
+
+        static void
+        release(OutputPacket* pkt)
+        {
+          if (--pkt->refs == 0)
+            delete pkt;
+        }
+
+        // Non-copyable.
+        OutputQueue(const OutputQueue&);
+        OutputQueue& operator=(const OutputQueue&);
+      };
+    }
+  }
+}
+
+#endif
@@ -25,9 +25,18 @@
 // Author: Eduardo Marques                                                  *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "OutputQueue.hpp"
+
 namespace Transports
 {
   namespace TCP
@@ -43,6 +52,25 @@ namespace Transports
         uint16_t port;
         //! True to announce service.
         bool announce;
+        //! Maximum number of bytes queued per client.
+        unsigned buffer_size;
+        //! What to do when a client queue is full.
+        std::string overflow;
+        //! Disable Nagle algorithm.
+        bool no_delay;
+        //! Cork client sockets while writing.
+        bool cork;
+      };
+
+      //! Overflow policies.
+      enum OverflowPolicy
+      {
+        //! Discard the message being sent.
+        OP_DROP_NEWEST,
+        //! Discard the oldest queued messages.
+        OP_DROP_OLDEST,
+        //! Close the connection.
+        OP_DISCONNECT
       };
 
       struct Task: public Tasks::SimpleTransport
@@ -63,15 +91,24 @@ namespace Transports
           Address address; // Client address.
           uint16_t port; // Client port.
           IMC::Parser parser; // Parser handle
+          OutputQueue* queue; // Outgoing packets.
+          std::set<uint32_t> subs; // Subscribed messages (empty for all).
+          unsigned dropped; // Messages dropped since the queue was last empty.
         };
 
         // Client list.
         typedef std::list<Client> ClientList;
         ClientList m_clients;
+        // Overflow policy.
+        OverflowPolicy m_overflow;
+        // Client whose data is being parsed.
+        Client* m_reading;
 
         Task(const std::string& name, Tasks::Context& ctx):
           Tasks::SimpleTransport(name, ctx),
-          m_sock(0)
+          m_sock(0),
+          m_overflow(OP_DROP_OLDEST),
+          m_reading(NULL)
         {
           param("Port", m_args.port)
           .defaultValue("7001")
@@ -80,6 +117,37 @@ namespace Transports
           param("Announce Service", m_args.announce)
           .defaultValue("true")
           .description("Set to true to announce the service");
+
+          param("Client Buffer Size", m_args.buffer_size)
+          .defaultValue("262144")
+          .minimumValue("4096")
+          .units(Units::Byte)
+          .description("Maximum number of bytes queued for each client");
+
+          param("Overflow Policy", m_args.overflow)
+          .defaultValue("Drop Oldest")
+          .values("Drop Newest, Drop Oldest, Disconnect")
+          .description("What to do with messages for a client whose queue is full");
+
+          param("TCP No Delay", m_args.no_delay)
+          .defaultValue("true")
+          .description("Send small segments without waiting (disable Nagle algorithm)");
+
+          param("TCP Cork", m_args.cork)
+          .defaultValue("false")
+          .description("Hold partial segments while writing queued messages,"
+                       " so that each write leaves as few segments as possible");
+        }
+
+        void
+        onUpdateParameters(void)
+        {
+          if (m_args.overflow == "Drop Newest")
+            m_overflow = OP_DROP_NEWEST;
+          else if (m_args.overflow == "Disconnect")
+            m_overflow = OP_DISCONNECT;
+          else
+            m_overflow = OP_DROP_OLDEST;
         }
 
         ~Task(void)
@@ -171,6 +239,7 @@ namespace Transports
 
           m_poll.remove(*c.socket);
           delete c.socket;
+          delete c.queue;
         }
 
         void
@@ -180,6 +249,7 @@ namespace Transports
           {
             m_poll.remove(*itr->socket);
             delete itr->socket;
+            delete itr->queue;
           }
 
           m_clients.clear();
@@ -192,16 +262,98 @@ namespace Transports
           }
         }
 
+        //! Test if there is room for a packet in the queue of a client,
+        //! applying the overflow policy otherwise.
+        //! @param[in] c client.
+        //! @param[in] n packet size.
+        //! @return true if the packet can be queued.
+        bool
+        makeRoom(Client& c, unsigned n)
+        {
+          size_t size = c.queue->getSize();
+          if (size + n <= m_args.buffer_size)
+            return true;
+
+          if (c.dropped == 0)
+            war(DTR("client %s:%u is not keeping up, dropping messages"),
+                c.address.c_str(), c.port);
+
+          if (m_overflow == OP_DROP_OLDEST)
+          {
+            c.dropped += c.queue->dropOldest(size + n - m_args.buffer_size);
+            if (c.queue->getSize() + n <= m_args.buffer_size)
+              return true;
+          }
+
+          ++c.dropped;
+          return false;
+        }
+
         void
         onDataTransmission(const uint8_t* p, unsigned int n)
         {
+          if (m_clients.empty())
+            return;
+
+          IMC::Header hdr;
+          IMC::Packet::deserializeHeader(hdr, p, n);
+
+          OutputPacket* pkt = NULL;
           ClientList::iterator itr = m_clients.begin();
 
           while (itr != m_clients.end())
           {
+            if (!itr->subs.empty() && itr->subs.find(hdr.mgid) == itr->subs.end())
+            {
+              ++itr;
+              continue;
+            }
+
+            if (!makeRoom(*itr, n))
+            {
+              if (m_overflow == OP_DISCONNECT)
+              {
+                std::runtime_error e(DTR("client queue is full"));
+                closeConnection(*itr, e);
+                itr = m_clients.erase(itr);
+                continue;
+              }
+
+              ++itr;
+              continue;
+            }
+
+            if (pkt == NULL)
+              pkt = new OutputPacket(p, n);
+
+            itr->queue->push(pkt);
+            ++itr;
+          }
+        }
+
+        //! Write queued packets to all clients.
+        void
+        flushClients(void)
+        {
+          ClientList::iterator itr = m_clients.begin();
+
+          while (itr != m_clients.end())
+          {
+            if (itr->queue->empty())
+            {
+              ++itr;
+              continue;
+            }
+
             try
             {
-              itr->socket->write((char*)p, n);
+              if (m_args.cork)
+                itr->socket->setCork(true);
+
+              itr->queue->flush(*itr->socket);
+
+              if (m_args.cork)
+                itr->socket->setCork(false);
             }
             catch (std::runtime_error& e)
             {
@@ -209,13 +361,53 @@ namespace Transports
               itr = m_clients.erase(itr);
               continue;
             }
+
+            if (itr->queue->empty() && itr->dropped > 0)
+            {
+              inf(DTR("client %s:%u caught up, %u messages were dropped"),
+                  itr->address.c_str(), itr->port, itr->dropped);
+              itr->dropped = 0;
+            }
+
             ++itr;
           }
         }
 
+        bool
+        onMessageReception(const IMC::Message* msg)
+        {
+          if (msg->getId() != DUNE_IMC_SESSIONSUBSCRIPTION || m_reading == NULL)
+            return true;
+
+          // Subscriptions only select what is sent to this client.
+          const IMC::SessionSubscription* sub = static_cast<const IMC::SessionSubscription*>(msg);
+          std::vector<std::string> names;
+          String::split(sub->messages, ",", names);
+
+          m_reading->subs.clear();
+          for (unsigned i = 0; i < names.size(); ++i)
+          {
+            try
+            {
+              m_reading->subs.insert(IMC::Factory::getIdFromAbbrev(String::trim(names[i])));
+            }
+            catch (std::exception& e)
+            {
+              debug("%s", e.what());
+            }
+          }
+
+          debug("client %s:%u subscribed to %u messages", m_reading->address.c_str(),
+                m_reading->port, (unsigned)m_reading->subs.size());
+          return false;
+        }
+
         void
         onDataReception(uint8_t* buf, unsigned int cap, double timeout)
         {
+          // Write messages consumed since the last call.
+          flushClients();
+
           // Poll for connections and client data
           if (!m_poll.poll(timeout))
             return;
@@ -233,13 +425,16 @@ namespace Transports
         {
           Client c;
           c.socket = 0;
+          c.queue = NULL;
+          c.dropped = 0;
+          c.parser.setReuse(true);
           try
           {
             c.socket = m_sock->accept(&c.address, &c.port);
             c.socket->setKeepAlive(true);
-            c.socket->setNoDelay(true);
-            c.socket->setReceiveTimeout(5);
-            c.socket->setSendTimeout(5);
+            c.socket->setNoDelay(m_args.no_delay);
+            c.socket->setNonBlocking(true);
+            c.queue = new OutputQueue;
             m_poll.add(*c.socket);
             m_clients.push_back(c);
             updateEntityState(m_clients.size());
@@ -251,6 +446,7 @@ namespace Transports
           {
             if (c.socket)
               delete c.socket;
+            delete c.queue;
             err(DTR("error accepting new client connection: %s"), e.what());
           }
         }
@@ -283,7 +479,11 @@ namespace Transports
             }
 
             if (n > 0)
+            {
+              m_reading = &(*itr);
               handleData(itr->parser, buf, n);
+              m_reading = NULL;
+            }
 
             ++itr;
           }
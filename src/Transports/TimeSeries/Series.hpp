@@ -0,0 +1,431 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_TIME_SERIES_SERIES_HPP_INCLUDED_
+#define TRANSPORTS_TIME_SERIES_SERIES_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace TimeSeries
+  {
+    using DUNE_NAMESPACES;
+
+    //! Maximum size of the data of a reply.
+    static const size_t c_max_reply_size = 32768;
+
+    //! Aggregate of the samples of an interval.
+    struct Bucket
+    {
+      //! Start of the interval (ms).
+      int64_t start;
+      //! Number of samples.
+      uint32_t count;
+      //! Minimum value.
+      double min;
+      //! Maximum value.
+      double max;
+      //! Sum of values.
+      double sum;
+      //! Last value.
+      double last;
+
+      Bucket(void):
+        start(0),
+        count(0),
+        min(0),
+        max(0),
+        sum(0),
+        last(0)
+      { }
+
+      //! Add a sample.
+      //! @param[in] value sample value.
+      void
+      add(double value)
+      {
+        if (count == 0)
+        {
+          min = value;
+          max = value;
+        }
+        else
+        {
+          min = std::min(min, value);
+          max = std::max(max, value);
+        }
+
+        sum += value;
+        last = value;
+        ++count;
+      }
+
+      //! Add the samples of a later bucket.
+      //! @param[in] other bucket.
+      void
+      merge(const Bucket& other)
+      {
+        if (other.count == 0)
+          return;
+
+        if (count == 0)
+        {
+          min = other.min;
+          max = other.max;
+        }
+        else
+        {
+          min = std::min(min, other.min);
+          max = std::max(max, other.max);
+        }
+
+        sum += other.sum;
+        last = other.last;
+        count += other.count;
+      }
+
+      //! Get an aggregate value.
+      //! @param[in] aggregate aggregate function (TimeSeriesQuery::TSA_*).
+      //! @return aggregate value.
+      double
+      get(unsigned aggregate) const
+      {
+        switch (aggregate)
+        {
+          case IMC::TimeSeriesQuery::TSA_MIN:
+            return min;
+          case IMC::TimeSeriesQuery::TSA_MAX:
+            return max;
+          case IMC::TimeSeriesQuery::TSA_LAST:
+            return last;
+          default:
+            return count ? sum / count : 0;
+        }
+      }
+    };
+
+    //! Result of a query.
+    struct Result
+    {
+      //! Length of the aggregation intervals (ms), zero for raw samples.
+      int64_t step;
+      //! Statistics of the covered samples.
+      Bucket stats;
+      //! Samples.
+      Compression::TimeSeriesChunk data;
+      //! True if samples were left out.
+      bool truncated;
+
+      Result(void):
+        step(0),
+        truncated(false)
+      { }
+    };
+
+    //! Samples of one series: raw samples in compressed chunks and
+    //! aggregates at one or more coarser resolutions (tiers), each
+    //! kept for its own retention period.
+    class Series
+    {
+    public:
+      //! Constructor.
+      //! @param[in] name series name.
+      //! @param[in] chunk_size number of samples per chunk.
+      //! @param[in] steps intervals of the aggregation tiers (ms),
+      //! in increasing order.
+      Series(const std::string& name, unsigned chunk_size, const std::vector<int64_t>& steps):
+        m_name(name),
+        m_chunk_size(chunk_size)
+      {
+        m_chunks.push_back(new Compression::TimeSeriesChunk);
+
+        m_tiers.resize(steps.size());
+        for (unsigned i = 0; i < steps.size(); ++i)
+          m_tiers[i].step = steps[i];
+      }
+
+      ~Series(void)
+      {
+        for (unsigned i = 0; i < m_chunks.size(); ++i)
+          delete m_chunks[i];
+      }
+
+      //! Get the series name.
+      //! @return series name.
+      const std::string&
+      getName(void) const
+      {
+        return m_name;
+      }
+
+      //! Add a sample. Samples older than the last one are ignored.
+      //! @param[in] time time stamp (ms).
+      //! @param[in] value value.
+      void
+      add(int64_t time, double value)
+      {
+        Compression::TimeSeriesChunk* open = m_chunks.back();
+        if (open->getCount() > 0 && time < open->getLastTime())
+          return;
+
+        if (open->getCount() >= m_chunk_size)
+        {
+          open->shrink();
+          open = new Compression::TimeSeriesChunk;
+          m_chunks.push_back(open);
+        }
+
+        open->append(time, value);
+
+        for (unsigned i = 0; i < m_tiers.size(); ++i)
+        {
+          Tier& tier = m_tiers[i];
+          int64_t start = time - mod(time, tier.step);
+
+          if (tier.current.count > 0 && tier.current.start != start)
+          {
+            tier.buckets.push_back(tier.current);
+            tier.current = Bucket();
+          }
+
+          tier.current.start = start;
+          tier.current.add(value);
+        }
+      }
+
+      //! Discard old data.
+      //! @param[in] raw_before discard raw samples older than this (ms).
+      //! @param[in] tier_before discard aggregates older than this (ms).
+      void
+      expire(int64_t raw_before, int64_t tier_before)
+      {
+        while (m_chunks.size() > 1 && m_chunks.front()->getLastTime() < raw_before)
+          dropOldest();
+
+        if (m_chunks.size() == 1 && m_chunks.front()->getCount() > 0
+            && m_chunks.front()->getLastTime() < raw_before)
+          m_chunks.front()->clear();
+
+        for (unsigned i = 0; i < m_tiers.size(); ++i)
+        {
+          std::deque<Bucket>& buckets = m_tiers[i].buckets;
+          while (!buckets.empty() && buckets.front().start + m_tiers[i].step <= tier_before)
+            buckets.pop_front();
+        }
+      }
+
+      //! Get the time stamp of the oldest chunk that can be dropped.
+      //! @param[out] time time stamp (ms).
+      //! @return false if only the open chunk is left.
+      bool
+      getOldest(int64_t& time) const
+      {
+        if (m_chunks.size() < 2)
+          return false;
+
+        time = m_chunks.front()->getFirstTime();
+        return true;
+      }
+
+      //! Drop the oldest chunk of raw samples.
+      void
+      dropOldest(void)
+      {
+        delete m_chunks.front();
+        m_chunks.pop_front();
+      }
+
+      //! Get the memory used by the series.
+      //! @return approximate size in bytes.
+      size_t
+      getMemory(void) const
+      {
+        size_t size = sizeof(*this);
+
+        for (unsigned i = 0; i < m_chunks.size(); ++i)
+          size += sizeof(Compression::TimeSeriesChunk) + m_chunks[i]->getSize();
+
+        for (unsigned i = 0; i < m_tiers.size(); ++i)
+          size += m_tiers[i].buckets.size() * sizeof(Bucket);
+
+        return size;
+      }
+
+      //! Get the number of raw samples.
+      //! @return number of samples.
+      size_t
+      getCount(void) const
+      {
+        size_t count = 0;
+        for (unsigned i = 0; i < m_chunks.size(); ++i)
+          count += m_chunks[i]->getCount();
+        return count;
+      }
+
+      //! Query samples in a time range. Raw samples are used when
+      //! they cover the range, otherwise the finest tier that fits
+      //! the requested step.
+      //! @param[in] start start of range (ms).
+      //! @param[in] end end of range (ms).
+      //! @param[in] step requested step (ms), zero for raw samples.
+      //! @param[in] aggregate aggregate function (TimeSeriesQuery::TSA_*).
+      //! @param[in] max_points maximum number of output samples.
+      //! @param[out] result result.
+      void
+      query(int64_t start, int64_t end, int64_t step, unsigned aggregate,
+            unsigned max_points, Result& result) const
+      {
+        const Tier* tier = NULL;
+
+        if (m_chunks.front()->getCount() == 0 || m_chunks.front()->getFirstTime() > start)
+        {
+          for (unsigned i = 0; i < m_tiers.size(); ++i)
+          {
+            if (tier == NULL || m_tiers[i].step <= step)
+              tier = &m_tiers[i];
+          }
+        }
+
+        if (tier != NULL)
+          step = std::max(step, tier->step) / tier->step * tier->step;
+
+        result.step = step;
+        result.truncated = false;
+        result.stats = Bucket();
+        result.data.clear();
+
+        Bucket out;
+        out.start = start;
+
+        if (tier != NULL)
+        {
+          for (unsigned i = 0; i < tier->buckets.size() && !result.truncated; ++i)
+            collect(tier->buckets[i], start, end, aggregate, max_points, out, result);
+          collect(tier->current, start, end, aggregate, max_points, out, result);
+        }
+        else
+        {
+          for (unsigned i = 0; i < m_chunks.size() && !result.truncated; ++i)
+          {
+            const Compression::TimeSeriesChunk* chunk = m_chunks[i];
+            if (chunk->getCount() == 0 || chunk->getLastTime() < start || chunk->getFirstTime() > end)
+              continue;
+
+            Compression::TimeSeriesChunk::Reader reader(chunk->getData(), chunk->getSize());
+            Bucket sample;
+            double value = 0;
+            while (!result.truncated && reader.next(sample.start, value))
+            {
+              sample.count = 0;
+              sample.sum = 0;
+              sample.add(value);
+              collect(sample, start, end, aggregate, max_points, out, result);
+            }
+          }
+        }
+
+        if (out.count > 0 && !result.truncated)
+          emit(out, aggregate, max_points, result);
+      }
+
+    private:
+      //! Aggregation tier.
+      struct Tier
+      {
+        //! Interval (ms).
+        int64_t step;
+        //! Complete intervals.
+        std::deque<Bucket> buckets;
+        //! Current interval.
+        Bucket current;
+      };
+
+      //! Series name.
+      std::string m_name;
+      //! Number of samples per chunk.
+      unsigned m_chunk_size;
+      //! Chunks of raw samples, the last one being filled.
+      std::deque<Compression::TimeSeriesChunk*> m_chunks;
+      //! Aggregation tiers.
+      std::vector<Tier> m_tiers;
+
+      //! Positive remainder of a division.
+      static int64_t
+      mod(int64_t a, int64_t b)
+      {
+        int64_t r = a % b;
+        return r < 0 ? r + b : r;
+      }
+
+      //! Add a raw sample or bucket to the output.
+      void
+      collect(const Bucket& in, int64_t start, int64_t end, unsigned aggregate,
+              unsigned max_points, Bucket& out, Result& result) const
+      {
+        if (in.count == 0 || in.start < start || in.start > end)
+          return;
+
+        int64_t ostart = (result.step == 0) ? in.start : in.start - mod(in.start, result.step);
+        if (out.count > 0 && out.start != ostart)
+        {
+          if (!emit(out, aggregate, max_points, result))
+            return;
+          out = Bucket();
+        }
+
+        out.start = ostart;
+        out.merge(in);
+      }
+
+      //! Append an output sample.
+      //! @return false if the output is full.
+      bool
+      emit(const Bucket& out, unsigned aggregate, unsigned max_points, Result& result) const
+      {
+        if (result.data.getCount() >= max_points || result.data.getSize() >= c_max_reply_size)
+        {
+          result.truncated = true;
+          return false;
+        }
+
+        result.data.append(out.start, out.get(aggregate));
+        result.stats.merge(out);
+        return true;
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,472 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Series.hpp"
+
+namespace Transports
+{
+  //! Onboard store of selected telemetry, so that recent history
+  //! ("last hour of depth") can be queried without downloading logs.
+  //!
+  //! Each series is one numeric field of one message, optionally
+  //! from a single entity. Raw samples are kept in chunks compressed
+  //! with delta-of-delta time stamps and XOR-encoded values
+  //! (DUNE::Compression::TimeSeriesChunk), and are also aggregated
+  //! in coarser tiers that are kept longer. Retention periods and a
+  //! memory limit bound the memory used; when over the limit the
+  //! oldest raw chunks of any series are dropped first.
+  //!
+  //! Queries (TimeSeriesQuery) select a series, a time range, a
+  //! step and an aggregate function, and are answered with a
+  //! TimeSeriesReply. The HTTP task exposes the same queries.
+  namespace TimeSeries
+  {
+    using DUNE_NAMESPACES;
+
+    struct Arguments
+    {
+      //! Series definitions.
+      std::vector<std::string> series;
+      //! Number of samples per chunk.
+      unsigned chunk_size;
+      //! Retention period of raw samples.
+      unsigned raw_retention;
+      //! Intervals of the aggregation tiers.
+      std::vector<unsigned> steps;
+      //! Retention period of aggregates.
+      unsigned tier_retention;
+      //! Memory limit.
+      unsigned memory_limit;
+      //! Maximum number of samples per reply.
+      unsigned max_points;
+    };
+
+    //! Field of a message feeding a series.
+    struct Source
+    {
+      //! Series index.
+      unsigned series;
+      //! Entity id (DUNE_IMC_CONST_UNK_EID for any entity).
+      unsigned entity;
+      //! Field type.
+      IMC::Schema::Type type;
+      //! Offset of the field in the serialized payload.
+      unsigned offset;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Series.
+      std::vector<Series*> m_series;
+      //! Sources by message identifier.
+      std::map<uint16_t, std::vector<Source> > m_sources;
+      //! Serialized payload of the current message.
+      std::vector<uint8_t> m_payload;
+      //! Reply message.
+      IMC::TimeSeriesReply m_reply;
+      //! Query result.
+      Result m_result;
+      //! Retention timer.
+      Time::Counter<double> m_expire_timer;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx)
+      {
+        param("Series", m_args.series)
+        .defaultValue("")
+        .description("Stored series, in the form 'Message.field' or"
+                     " 'Message[Entity Label].field'. Fields must be numeric"
+                     " and can only follow fixed size fields");
+
+        param("Chunk Size", m_args.chunk_size)
+        .defaultValue("512")
+        .minimumValue("16")
+        .description("Number of raw samples per compressed chunk");
+
+        param("Raw Retention", m_args.raw_retention)
+        .defaultValue("3600")
+        .units(Units::Second)
+        .description("Time raw samples are kept");
+
+        param("Aggregation Steps", m_args.steps)
+        .defaultValue("10, 60, 600")
+        .units(Units::Second)
+        .description("Intervals of the aggregation tiers, in increasing order");
+
+        param("Aggregate Retention", m_args.tier_retention)
+        .defaultValue("86400")
+        .units(Units::Second)
+        .description("Time aggregates are kept");
+
+        param("Memory Limit", m_args.memory_limit)
+        .defaultValue("4096")
+        .units(Units::Kibibyte)
+        .description("Memory used by all series, after which the oldest"
+                     " raw samples are dropped");
+
+        param("Maximum Reply Samples", m_args.max_points)
+        .defaultValue("4096")
+        .minimumValue("1")
+        .description("Maximum number of samples of a reply");
+
+        m_expire_timer.setTop(1.0);
+
+        bind<IMC::TimeSeriesQuery>(this);
+      }
+
+      ~Task(void)
+      {
+        onResourceRelease();
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        std::vector<std::string> msgs;
+        for (unsigned i = 0; i < m_args.series.size(); ++i)
+          msgs.push_back(m_args.series[i].substr(0, m_args.series[i].find_first_of("[.")));
+
+        bind(this, msgs);
+      }
+
+      void
+      onEntityResolution(void)
+      {
+        IMC::Schema schema;
+        m_sources.clear();
+
+        for (unsigned i = 0; i < m_args.series.size(); ++i)
+        {
+          const std::string& spec = m_args.series[i];
+          size_t dot = spec.rfind('.');
+          size_t bracket = spec.find('[');
+          if (dot == std::string::npos || (bracket != std::string::npos && spec.find(']') + 1 != dot))
+            throw std::runtime_error(String::str(DTR("invalid series: %s"), spec.c_str()));
+
+          Source src;
+          src.series = i;
+          src.entity = DUNE_IMC_CONST_UNK_EID;
+
+          std::string abbrev = spec.substr(0, std::min(dot, bracket));
+          if (bracket != std::string::npos)
+            src.entity = resolveEntity(spec.substr(bracket + 1, dot - bracket - 2));
+
+          const IMC::Schema::Definition* def = schema.find(IMC::Factory::getIdFromAbbrev(abbrev));
+          if (def == NULL || !findField(*def, spec.substr(dot + 1), src))
+            throw std::runtime_error(String::str(DTR("invalid series: %s"), spec.c_str()));
+
+          m_sources[def->id].push_back(src);
+        }
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        std::vector<int64_t> steps;
+        for (unsigned i = 0; i < m_args.steps.size(); ++i)
+        {
+          if (m_args.steps[i] > 0)
+            steps.push_back((int64_t)m_args.steps[i] * 1000);
+        }
+        std::sort(steps.begin(), steps.end());
+
+        for (unsigned i = 0; i < m_args.series.size(); ++i)
+          m_series.push_back(new Series(m_args.series[i], m_args.chunk_size, steps));
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        for (unsigned i = 0; i < m_series.size(); ++i)
+          delete m_series[i];
+        m_series.clear();
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      //! Locate a numeric field in the serialized payload.
+      //! @param[in] def message definition.
+      //! @param[in] field field abbreviation.
+      //! @param[out] src source to fill.
+      //! @return true if the field can be stored.
+      static bool
+      findField(const IMC::Schema::Definition& def, const std::string& field, Source& src)
+      {
+        unsigned offset = 0;
+        for (unsigned i = 0; i < def.fields.size(); ++i)
+        {
+          unsigned size = IMC::Schema::getSize(def.fields[i].type);
+          if (size == 0)
+            return false;
+
+          if (def.fields[i].abbrev == field)
+          {
+            src.type = def.fields[i].type;
+            src.offset = offset;
+            return true;
+          }
+
+          offset += size;
+        }
+
+        return false;
+      }
+
+      //! Read a serialized numeric field.
+      static fp64_t
+      getValue(IMC::Schema::Type type, const uint8_t* bfr)
+      {
+        uint16_t len = 8;
+
+        switch (type)
+        {
+          case IMC::Schema::TYPE_INT8:
+            {
+              int8_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_UINT8:
+            {
+              uint8_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_INT16:
+            {
+              int16_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_UINT16:
+            {
+              uint16_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_INT32:
+            {
+              int32_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_UINT32:
+            {
+              uint32_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_INT64:
+            {
+              int64_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return (fp64_t)v;
+            }
+          case IMC::Schema::TYPE_FP32:
+            {
+              fp32_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          case IMC::Schema::TYPE_FP64:
+            {
+              fp64_t v = 0;
+              IMC::deserialize(v, bfr, len);
+              return v;
+            }
+          default:
+            return 0;
+        }
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        std::map<uint16_t, std::vector<Source> >::const_iterator itr = m_sources.find(msg->getId());
+        if (itr == m_sources.end() || m_series.empty())
+          return;
+
+        m_payload.resize(msg->getPayloadSerializationSize() + 1);
+        size_t size = msg->serializeFields(&m_payload[0]) - &m_payload[0];
+        int64_t time = (int64_t)(msg->getTimeStamp() * 1000.0);
+
+        for (unsigned i = 0; i < itr->second.size(); ++i)
+        {
+          const Source& src = itr->second[i];
+          if (src.entity != DUNE_IMC_CONST_UNK_EID && src.entity != msg->getSourceEntity())
+            continue;
+
+          if (src.offset + IMC::Schema::getSize(src.type) > size)
+            continue;
+
+          m_series[src.series]->add(time, getValue(src.type, &m_payload[src.offset]));
+        }
+      }
+
+      void
+      consume(const IMC::TimeSeriesQuery* msg)
+      {
+        m_reply.req_id = msg->req_id;
+        m_reply.status = IMC::TimeSeriesReply::TSR_SUCCESS;
+        m_reply.series.clear();
+        m_reply.step = 0;
+        m_reply.count = 0;
+        m_reply.min = 0;
+        m_reply.max = 0;
+        m_reply.mean = 0;
+        m_reply.data.clear();
+
+        if (msg->series.empty())
+        {
+          for (unsigned i = 0; i < m_series.size(); ++i)
+          {
+            if (i > 0)
+              m_reply.series += ',';
+            m_reply.series += m_series[i]->getName();
+          }
+
+          dispatchReply(*msg, m_reply);
+          return;
+        }
+
+        m_reply.series = msg->series;
+
+        const Series* series = NULL;
+        for (unsigned i = 0; i < m_series.size() && series == NULL; ++i)
+        {
+          if (m_series[i]->getName() == msg->series)
+            series = m_series[i];
+        }
+
+        if (series == NULL)
+        {
+          m_reply.status = IMC::TimeSeriesReply::TSR_UNKNOWN;
+          dispatchReply(*msg, m_reply);
+          return;
+        }
+
+        double now = Clock::getSinceEpoch();
+        double start = (msg->start_time < 0) ? now + msg->start_time : msg->start_time;
+        double end = (msg->end_time <= 0) ? now : msg->end_time;
+
+        series->query((int64_t)(start * 1000.0), (int64_t)(end * 1000.0),
+                      (int64_t)msg->step * 1000, msg->aggregate,
+                      m_args.max_points, m_result);
+
+        if (m_result.truncated)
+          m_reply.status = IMC::TimeSeriesReply::TSR_TRUNCATED;
+
+        m_reply.step = (uint32_t)(m_result.step / 1000);
+        m_reply.count = m_result.stats.count;
+        m_reply.min = m_result.stats.min;
+        m_reply.max = m_result.stats.max;
+        m_reply.mean = m_result.stats.get(IMC::TimeSeriesQuery::TSA_MEAN);
+
+        const char* data = (const char*)m_result.data.getData();
+        m_reply.data.assign(data, data + m_result.data.getSize());
+
+        dispatchReply(*msg, m_reply);
+      }
+
+      //! Apply the retention periods and the memory limit.
+      void
+      expire(void)
+      {
+        int64_t now = (int64_t)(Clock::getSinceEpoch() * 1000.0);
+        int64_t raw_before = now - (int64_t)m_args.raw_retention * 1000;
+        int64_t tier_before = now - (int64_t)m_args.tier_retention * 1000;
+
+        size_t memory = 0;
+        for (unsigned i = 0; i < m_series.size(); ++i)
+        {
+          m_series[i]->expire(raw_before, tier_before);
+          memory += m_series[i]->getMemory();
+        }
+
+        size_t limit = (size_t)m_args.memory_limit * 1024;
+        while (memory > limit)
+        {
+          Series* oldest = NULL;
+          int64_t oldest_time = 0;
+
+          for (unsigned i = 0; i < m_series.size(); ++i)
+          {
+            int64_t time = 0;
+            if (m_series[i]->getOldest(time) && (oldest == NULL || time < oldest_time))
+            {
+              oldest = m_series[i];
+              oldest_time = time;
+            }
+          }
+
+          if (oldest == NULL)
+            break;
+
+          memory -= oldest->getMemory();
+          oldest->dropOldest();
+          memory += oldest->getMemory();
+        }
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(m_expire_timer.getRemaining());
+
+          if (m_expire_timer.overflow())
+          {
+            expire();
+            m_expire_timer.reset();
+          }
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
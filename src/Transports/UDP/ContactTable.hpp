@@ -59,6 +59,14 @@ namespace Transports
           list.push_back(itr->second);
       }
 
+      void
+      setTimeout(float tout)
+      {
+        m_tout = tout;
+        for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
+          itr->second.setTimeout(m_tout);
+      }
+
       void
       update(unsigned id, const Address& addr)
       {
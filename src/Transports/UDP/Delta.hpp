@@ -0,0 +1,307 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_UDP_DELTA_HPP_INCLUDED_
+#define TRANSPORTS_UDP_DELTA_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <vector>
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace UDP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Synchronization number of delta frames.
+    static const uint16_t c_delta_sync = 0xFD54;
+    //! Size of the header of delta frames: synchronization number,
+    //! source, source entity, destination, destination entity,
+    //! timestamp and keyframe tag.
+    static const uint16_t c_delta_header_size = 18;
+
+    //! Compute the tag that identifies a keyframe in delta frames.
+    //! @param[in] tstamp keyframe timestamp.
+    //! @return keyframe tag.
+    inline uint16_t
+    getKeyframeTag(double tstamp)
+    {
+      return (uint16_t)((uint64_t)(tstamp * 1000.0) & 0xffff);
+    }
+
+    //! Delta encoding of outgoing state messages. Each stream
+    //! (message type and source entity) periodically sends a
+    //! keyframe, which is a plain IMC packet, and in between sends
+    //! delta frames: the message compact encoded (see
+    //! IMC::CompactCodec) against the last keyframe. Since deltas
+    //! always refer to a keyframe, losing a delta frame only loses
+    //! that sample and losing a keyframe is recovered at the next
+    //! one.
+    class DeltaEncoder
+    {
+    public:
+      DeltaEncoder(void):
+        m_period(5.0)
+      { }
+
+      ~DeltaEncoder(void)
+      {
+        clear();
+      }
+
+      //! Set the interval between keyframes.
+      //! @param[in] period keyframe period (s).
+      void
+      setKeyframePeriod(double period)
+      {
+        m_period = period;
+      }
+
+      //! Send a keyframe as the next message of every stream.
+      void
+      reset(void)
+      {
+        Streams::iterator itr = m_streams.begin();
+        for (; itr != m_streams.end(); ++itr)
+          itr->second->valid = false;
+      }
+
+      //! Remove all streams.
+      void
+      clear(void)
+      {
+        Streams::iterator itr = m_streams.begin();
+        for (; itr != m_streams.end(); ++itr)
+          delete itr->second;
+        m_streams.clear();
+      }
+
+      //! Serialize a message either as a keyframe or as a delta
+      //! frame.
+      //! @param[in] msg message, must be compact encodable.
+      //! @param[out] bfr destination buffer.
+      //! @param[in] size size of destination buffer.
+      //! @return number of bytes used.
+      uint16_t
+      encode(const IMC::Message* msg, uint8_t* bfr, uint16_t size)
+      {
+        uint32_t key = (msg->getId() << 8) | msg->getSourceEntity();
+        Stream*& stream = m_streams[key];
+        if (stream == NULL)
+          stream = new Stream;
+
+        double tstamp = msg->getTimeStamp();
+        if (!stream->valid || tstamp < stream->keyframe
+            || tstamp - stream->keyframe >= m_period)
+        {
+          stream->codec.setReference(*msg);
+          stream->keyframe = tstamp;
+          stream->tag = getKeyframeTag(tstamp);
+          stream->valid = true;
+          return IMC::Packet::serialize(msg, bfr, size);
+        }
+
+        m_data.clear();
+        stream->codec.encode(*msg, m_data);
+
+        unsigned total = c_delta_header_size + m_data.size();
+        if (total > size)
+          throw IMC::BufferTooShort();
+
+        uint8_t* ptr = bfr;
+        ptr += IMC::serialize(c_delta_sync, ptr);
+        ptr += IMC::serialize(msg->getSource(), ptr);
+        ptr += IMC::serialize(msg->getSourceEntity(), ptr);
+        ptr += IMC::serialize(msg->getDestination(), ptr);
+        ptr += IMC::serialize(msg->getDestinationEntity(), ptr);
+        ptr += IMC::serialize(tstamp, ptr);
+        ptr += IMC::serialize(stream->tag, ptr);
+        std::memcpy(ptr, &m_data[0], m_data.size());
+
+        return total;
+      }
+
+    private:
+      struct Stream
+      {
+        //! Codec holding the last keyframe as reference.
+        IMC::CompactCodec codec;
+        //! Timestamp of the last keyframe.
+        double keyframe;
+        //! Tag of the last keyframe.
+        uint16_t tag;
+        //! True if a keyframe was sent.
+        bool valid;
+
+        Stream(void):
+          keyframe(0),
+          tag(0),
+          valid(false)
+        { }
+      };
+
+      typedef std::map<uint32_t, Stream*> Streams;
+
+      //! Streams by message type and source entity.
+      Streams m_streams;
+      //! Interval between keyframes.
+      double m_period;
+      //! Compact encoding scratch buffer.
+      std::vector<char> m_data;
+    };
+
+    //! Reconstruction of messages sent by DeltaEncoder. Keyframes
+    //! are remembered per peer (source system, source entity and
+    //! message type) as they are received; delta frames that do
+    //! not match the last keyframe of their peer are rejected.
+    class DeltaDecoder
+    {
+    public:
+      ~DeltaDecoder(void)
+      {
+        Streams::iterator itr = m_streams.begin();
+        for (; itr != m_streams.end(); ++itr)
+          delete itr->second;
+      }
+
+      //! Test if a packet is a delta frame.
+      //! @param[in] bfr packet.
+      //! @param[in] bfr_len size of packet.
+      //! @return true if the packet is a delta frame, false otherwise.
+      static bool
+      isDelta(const uint8_t* bfr, uint16_t bfr_len)
+      {
+        if (bfr_len < 2)
+          return false;
+
+        uint16_t sync = 0;
+        IMC::deserialize(sync, bfr, bfr_len);
+        return sync == c_delta_sync;
+      }
+
+      //! Remember a message as the keyframe of its peer, if it can
+      //! be used as one.
+      //! @param[in] msg received message.
+      void
+      setKeyframe(const IMC::Message* msg)
+      {
+        if (!IMC::CompactCodec::isSupported(msg->getId()))
+          return;
+
+        uint64_t key = getKey(msg->getSource(), msg->getSourceEntity(), msg->getId());
+        Stream*& stream = m_streams[key];
+        if (stream == NULL)
+          stream = new Stream;
+
+        stream->codec.setReference(*msg);
+        stream->tag = getKeyframeTag(msg->getTimeStamp());
+      }
+
+      //! Reconstruct the message of a delta frame.
+      //! @param[in] bfr delta frame.
+      //! @param[in] bfr_len size of buffer.
+      //! @param[out] used number of bytes used by the frame.
+      //! @return reconstructed message, owned by the caller.
+      //! @throw IMC::MissingReference if the keyframe of the delta
+      //! frame was not received.
+      IMC::Message*
+      decode(const uint8_t* bfr, uint16_t bfr_len, uint16_t& used)
+      {
+        if (bfr_len <= c_delta_header_size)
+          throw IMC::BufferTooShort();
+
+        uint16_t sync = 0;
+        uint16_t src = 0;
+        uint8_t src_ent = 0;
+        uint16_t dst = 0;
+        uint8_t dst_ent = 0;
+        double tstamp = 0;
+        uint16_t tag = 0;
+
+        const uint8_t* ptr = bfr;
+        uint16_t left = bfr_len;
+        ptr += IMC::deserialize(sync, ptr, left);
+        ptr += IMC::deserialize(src, ptr, left);
+        ptr += IMC::deserialize(src_ent, ptr, left);
+        ptr += IMC::deserialize(dst, ptr, left);
+        ptr += IMC::deserialize(dst_ent, ptr, left);
+        ptr += IMC::deserialize(tstamp, ptr, left);
+        ptr += IMC::deserialize(tag, ptr, left);
+
+        uint16_t id = 0;
+        if (!IMC::CompactCodec::getMessageId(*ptr, id))
+          throw IMC::InvalidMessageId(*ptr);
+
+        Streams::iterator itr = m_streams.find(getKey(src, src_ent, id));
+        if (itr == m_streams.end() || itr->second->tag != tag)
+          throw IMC::MissingReference(id);
+
+        unsigned size = 0;
+        IMC::Message* msg = itr->second->codec.decode((const char*)ptr, left, size);
+        msg->setSource(src);
+        msg->setSourceEntity(src_ent);
+        msg->setDestination(dst);
+        msg->setDestinationEntity(dst_ent);
+        msg->setTimeStamp(tstamp);
+
+        used = c_delta_header_size + size;
+        return msg;
+      }
+
+    private:
+      struct Stream
+      {
+        //! Codec holding the last keyframe as reference.
+        IMC::CompactCodec codec;
+        //! Tag of the last keyframe.
+        uint16_t tag;
+
+        Stream(void):
+          tag(0)
+        { }
+      };
+
+      typedef std::map<uint64_t, Stream*> Streams;
+
+      //! Streams by source, source entity and message type.
+      Streams m_streams;
+
+      static uint64_t
+      getKey(uint16_t src, uint8_t src_ent, uint16_t id)
+      {
+        return ((uint64_t)src << 24) | ((uint64_t)src_ent << 16) | id;
+      }
+    };
+  }
+}
+
+#endif
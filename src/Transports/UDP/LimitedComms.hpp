@@ -45,12 +45,17 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
+    //! Height below which a node is underwater.
+    static const double c_underwater_height = -0.5;
+
     class LimitedComms
     {
     public:
       LimitedComms(float comm_range, unsigned local_id):
         m_comm_range(comm_range),
-        m_local_id(local_id)
+        m_local_id(local_id),
+        m_active(false),
+        m_underwater_comms(false)
       {
         m_last_calc.setTop(SECONDS_BETWEEN_CALCULATIONS);
         std::memset(m_position, 0, sizeof(m_position));
@@ -66,6 +71,12 @@ namespace Transports
           setNodePosition(msg->getSource(), msg->lat, msg->lon, msg->height);
       }
 
+      void
+      setRemoteState(const IMC::RemoteState* msg)
+      {
+        setNodePosition(msg->getSource(), msg->lat, msg->lon, -(double)msg->depth);
+      }
+
       void
       setMyEstimatedState(const IMC::EstimatedState* msg)
       {
@@ -165,6 +176,29 @@ namespace Transports
                                 m_position[0], m_position[1], m_position[2]);
       }
 
+      //! Get the state of the link to a node.
+      //! @param[in] id node identifier.
+      //! @param[out] distance distance to the node (negative if
+      //! unknown).
+      //! @param[out] underwater true if either end is underwater.
+      void
+      getLinkState(unsigned id, double& distance, bool& underwater)
+      {
+        ScopedRWLock l(m_positions_lock);
+        underwater = m_position[2] < c_underwater_height;
+
+        std::map<unsigned, NodePosition>::iterator itr = m_node_positions.find(id);
+        if (id == m_local_id || itr == m_node_positions.end())
+        {
+          distance = (id == m_local_id) ? 0 : -1;
+          return;
+        }
+
+        underwater = underwater || itr->second.hae < c_underwater_height;
+        distance = WGS84::distance(itr->second.lat, itr->second.lon, itr->second.hae,
+                                   m_position[0], m_position[1], m_position[2]);
+      }
+
       float
       getCommRange(void)
       {
@@ -226,7 +260,7 @@ namespace Transports
       bool
       isReachable(double lat, double lon, double hae)
       {
-        if (m_position[2] < -0.5)
+        if (m_position[2] < c_underwater_height && !m_underwater_comms)
           return false;
 
         if (m_comm_range > 0)
@@ -0,0 +1,211 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef TRANSPORTS_UDP_LINK_EMULATOR_HPP_INCLUDED_
+#define TRANSPORTS_UDP_LINK_EMULATOR_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace UDP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Characteristics of an emulated link.
+    struct LinkModel
+    {
+      //! Bandwidth in bits per second (0 for unlimited).
+      double bandwidth;
+      //! Propagation latency in seconds.
+      double latency;
+      //! Maximum random delay added to the latency in seconds.
+      double jitter;
+      //! Probability of losing a packet at zero distance.
+      double loss;
+
+      LinkModel(void):
+        bandwidth(0),
+        latency(0),
+        jitter(0),
+        loss(0)
+      { }
+    };
+
+    //! Delays and drops received messages according to the model of
+    //! the link they arrived through. Each source node owns a link
+    //! whose bandwidth is shared by all its messages and deliveries are
+    //! kept in a heap ordered by delivery time.
+    class LinkEmulator
+    {
+    public:
+      //! Constructor.
+      //! @param[in] radio model of surface links.
+      //! @param[in] acoustic model of underwater links.
+      //! @param[in] range communication range (0 for infinite). The
+      //! loss probability grows quadratically with distance and reaches
+      //! one at this range.
+      //! @param[in] prng_type pseudo-random number generator type.
+      //! @param[in] prng_seed pseudo-random number generator seed.
+      LinkEmulator(const LinkModel& radio, const LinkModel& acoustic, double range,
+                   const std::string& prng_type, int prng_seed):
+        m_radio(radio),
+        m_acoustic(acoustic),
+        m_range(range),
+        m_seq(0)
+      {
+        m_prng = Random::Factory::create(prng_type, prng_seed);
+      }
+
+      ~LinkEmulator(void)
+      {
+        while (!m_queue.empty())
+        {
+          delete m_queue.top().msg;
+          m_queue.pop();
+        }
+
+        delete m_prng;
+      }
+
+      //! Schedule the delivery of a message.
+      //! @param[in] msg received message, owned by the emulator if it
+      //! is scheduled.
+      //! @param[in] distance distance to the source node (negative if
+      //! unknown).
+      //! @param[in] underwater true if the link is underwater.
+      //! @param[in] now current time.
+      //! @return true if the message was scheduled, false if it was
+      //! lost.
+      bool
+      schedule(IMC::Message* msg, double distance, bool underwater, double now)
+      {
+        const LinkModel& model = underwater ? m_acoustic : m_radio;
+
+        double loss = model.loss;
+        if (m_range > 0 && distance > 0)
+        {
+          double ratio = std::min(distance / m_range, 1.0);
+          loss += (1.0 - loss) * ratio * ratio;
+        }
+
+        if (m_prng->uniform() < loss)
+          return false;
+
+        // Messages from the same node are serialized on its link.
+        double start = now;
+        std::map<unsigned, double>::iterator itr = m_link_free.find(msg->getSource());
+        if (itr != m_link_free.end())
+          start = std::max(start, itr->second);
+
+        double end = start;
+        if (model.bandwidth > 0)
+          end += msg->getSerializationSize() * 8.0 / model.bandwidth;
+        m_link_free[msg->getSource()] = end;
+
+        Delivery d;
+        d.time = end + model.latency + m_prng->uniform(0, model.jitter);
+        d.seq = m_seq++;
+        d.msg = msg;
+        m_queue.push(d);
+        return true;
+      }
+
+      //! Get the time of the next delivery.
+      //! @return delivery time or negative if there are no pending
+      //! messages.
+      double
+      getNextDelivery(void) const
+      {
+        if (m_queue.empty())
+          return -1;
+
+        return m_queue.top().time;
+      }
+
+      //! Get the next message due for delivery.
+      //! @param[in] now current time.
+      //! @return message (owned by the caller) or NULL.
+      IMC::Message*
+      pop(double now)
+      {
+        if (m_queue.empty() || m_queue.top().time > now)
+          return NULL;
+
+        IMC::Message* msg = m_queue.top().msg;
+        m_queue.pop();
+        return msg;
+      }
+
+    private:
+      //! Scheduled delivery.
+      struct Delivery
+      {
+        //! Delivery time.
+        double time;
+        //! Sequence number to keep the order of simultaneous deliveries.
+        uint64_t seq;
+        //! Message.
+        IMC::Message* msg;
+
+        //! Order by latest first, as required by the heap.
+        bool
+        operator<(const Delivery& other) const
+        {
+          if (time != other.time)
+            return time > other.time;
+
+          return seq > other.seq;
+        }
+      };
+
+      //! Model of surface links.
+      LinkModel m_radio;
+      //! Model of underwater links.
+      LinkModel m_acoustic;
+      //! Communication range.
+      double m_range;
+      //! Pseudo-random number generator.
+      Random::Generator* m_prng;
+      //! Time at which each link finishes its last transmission.
+      std::map<unsigned, double> m_link_free;
+      //! Pending deliveries.
+      std::priority_queue<Delivery> m_queue;
+      //! Next sequence number.
+      uint64_t m_seq;
+    };
+  }
+}
+
+#endif
@@ -29,6 +29,7 @@
 #define TRANSPORTS_UDP_LISTENER_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -37,7 +38,9 @@
 
 // Local headers.
 #include "ContactTable.hpp"
+#include "Delta.hpp"
 #include "LimitedComms.hpp"
+#include "LinkEmulator.hpp"
 
 namespace Transports
 {
@@ -45,16 +48,33 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
+    //! Run-time settings of the listener.
+    struct ListenerSettings
+    {
+      ListenerSettings(void):
+        contact_timeout(30.0f),
+        trace(false)
+      { }
+
+      // Contact timeout.
+      float contact_timeout;
+      // True to record incoming messages in the message trace.
+      bool trace;
+    };
+
     class Listener: public Concurrency::Thread
     {
     public:
       Listener(Tasks::Task& task, UDPSocket& sock, LimitedComms* lcomms,
-               float contact_timeout, bool trace = false):
+               Snapshot<ListenerSettings>& settings,
+               LinkEmulator* emulator = NULL):
         m_task(task),
         m_sock(sock),
-        m_trace(trace),
-        m_contacts(contact_timeout),
-        m_lcomms(lcomms)
+        m_settings(settings),
+        m_contacts(m_settings->contact_timeout),
+        m_lcomms(lcomms),
+        m_emulator(emulator),
+        m_trace_channel(IMC::dune_trace.getChannel(task.getName()))
       {  }
 
       void
@@ -78,67 +98,220 @@ namespace Transports
     private:
       // Buffer capacity.
       static const int c_bfr_size = 65535;
+      // Maximum number of datagrams read at once.
+      static const unsigned c_dgrams = 8;
       // Poll timeout in milliseconds.
       static const int c_poll_tout = 1000;
       // Parent task.
       Tasks::Task& m_task;
       // Reference to socket used for sending data.
       UDPSocket& m_sock;
-      // True to print incoming messages.
-      bool m_trace;
+      // Settings, picked up once per poll iteration.
+      Snapshot<ListenerSettings>::Reader m_settings;
       // Table of contacts.
       ContactTable m_contacts;
       // Lock to serialize access to m_contacts.
       RWLock m_contacts_lock;
       // LimitedComms object
       LimitedComms* m_lcomms;
+      // Link emulator (NULL if disabled).
+      LinkEmulator* m_emulator;
+      // Messages decoded in the current batch.
+      std::vector<IMC::Message*> m_msgs;
+      // Reconstruction of delta frames.
+      DeltaDecoder m_delta;
+      // Message trace channel.
+      uint8_t m_trace_channel;
+
+      // Decode all packets of a datagram.
+      // @param[in] bfr datagram.
+      // @param[in] bfr_len datagram size.
+      void
+      decode(const uint8_t* bfr, uint16_t bfr_len)
+      {
+        // A datagram may carry several packets.
+        uint16_t offset = 0;
+        do
+        {
+          if (DeltaDecoder::isDelta(bfr + offset, bfr_len - offset))
+          {
+            uint16_t used = 0;
+            IMC::Message* msg = m_delta.decode(bfr + offset, bfr_len - offset, used);
+            offset += used;
+
+            if (m_lcomms->isActive()
+                && !m_lcomms->isNodeWithinRange(msg->getSource(), msg->getId()))
+            {
+              delete msg;
+              continue;
+            }
+
+            m_msgs.push_back(msg);
+            continue;
+          }
+
+          IMC::Header hdr;
+          IMC::Packet::deserializeHeader(hdr, bfr + offset, bfr_len - offset);
+          uint16_t size = DUNE_IMC_CONST_HEADER_SIZE + hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+
+          if (size > bfr_len - offset)
+            throw IMC::BufferTooShort();
+
+          const uint8_t* data = bfr + offset;
+          offset += size;
+
+          // Packets from nodes out of range are discarded by header,
+          // announces are needed to track node positions.
+          if (m_lcomms->isActive() && hdr.mgid != DUNE_IMC_ANNOUNCE
+              && !m_lcomms->isNodeWithinRange(hdr.src, hdr.mgid))
+            continue;
+
+          IMC::Message* msg = IMC::Packet::deserializePayload(hdr, data, size, NULL);
+
+          if (m_lcomms->isActive() && msg->getId() == DUNE_IMC_ANNOUNCE)
+          {
+            m_lcomms->setAnnounce(static_cast<IMC::Announce*>(msg));
+
+            if (!m_lcomms->isNodeWithinRange(msg->getSource(), msg->getId()))
+            {
+              delete msg;
+              continue;
+            }
+          }
+
+          m_delta.setKeyframe(msg);
+          m_msgs.push_back(msg);
+        }
+        while (bfr_len - offset >= c_delta_header_size);
+      }
+
+      // Dispatch a received message.
+      // @param[in] msg message.
+      void
+      deliver(IMC::Message* msg)
+      {
+        m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+
+        if (m_settings->trace)
+          IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_IN);
+      }
+
+      // Hand messages of the current batch to the link emulator.
+      void
+      emulate(void)
+      {
+        double now = Clock::get();
+
+        for (size_t i = 0; i < m_msgs.size(); ++i)
+        {
+          double distance = 0;
+          bool underwater = false;
+          m_lcomms->getLinkState(m_msgs[i]->getSource(), distance, underwater);
+
+          if (!m_emulator->schedule(m_msgs[i], distance, underwater, now))
+            delete m_msgs[i];
+
+          m_msgs[i] = NULL;
+        }
+      }
+
+      // Dispatch messages whose emulated delivery time has passed.
+      void
+      deliverDue(void)
+      {
+        double now = Clock::get();
+
+        IMC::Message* msg = NULL;
+        while ((msg = m_emulator->pop(now)) != NULL)
+        {
+          deliver(msg);
+          delete msg;
+        }
+      }
 
       void
       run(void)
       {
-        Address addr;
-        uint8_t* bfr = new uint8_t[c_bfr_size];
+        uint8_t* bfr = new uint8_t[c_bfr_size * c_dgrams];
+        size_t sizes[c_dgrams];
+        size_t firsts[c_dgrams + 1];
+        Address addrs[c_dgrams];
         double poll_tout = c_poll_tout / 1000.0;
 
         while (!isStopping())
         {
+          if (m_settings.refresh())
+          {
+            m_contacts_lock.lockWrite();
+            m_contacts.setTimeout(m_settings->contact_timeout);
+            m_contacts_lock.unlock();
+          }
+
           try
           {
-            if (!Poll::poll(m_sock, poll_tout))
+            double tout = poll_tout;
+            if (m_emulator != NULL)
+            {
+              deliverDue();
+
+              double next = m_emulator->getNextDelivery();
+              if (next >= 0)
+                tout = std::max(0.0, std::min(tout, next - Clock::get()));
+            }
+
+            if (!Poll::poll(m_sock, tout))
               continue;
 
-            uint16_t rv = m_sock.read(bfr, c_bfr_size, &addr);
-            IMC::Message* msg = IMC::Packet::deserialize(bfr, rv);
+            unsigned count = m_sock.read(bfr, c_bfr_size, c_dgrams, sizes, addrs);
 
-            if (m_lcomms->isActive())
+            // Decode all datagrams and remember the source address of
+            // the first message of each one.
+            for (unsigned i = 0; i < count; ++i)
             {
-              if (msg->getId() == DUNE_IMC_ANNOUNCE)
+              firsts[i] = m_msgs.size();
+
+              try
               {
-                m_lcomms->setAnnounce(static_cast<IMC::Announce*>(msg));
+                decode(bfr + i * c_bfr_size, sizes[i]);
               }
-
-              if (!m_lcomms->isNodeWithinRange(msg->getSource(), msg->getId()))
+              catch (std::exception& e)
               {
-                delete msg;
-                continue;
+                m_task.debug("error while unpacking message: %s", e.what());
               }
             }
+            firsts[count] = m_msgs.size();
 
+            // Update contacts once per batch.
             m_contacts_lock.lockWrite();
-            m_contacts.update(msg->getSource(), addr);
+            for (unsigned i = 0; i < count; ++i)
+            {
+              for (size_t j = firsts[i]; j < firsts[i + 1]; ++j)
+                m_contacts.update(m_msgs[j]->getSource(), addrs[i]);
+            }
             m_contacts_lock.unlock();
 
-            m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
-
-            if (m_trace)
-              msg->toText(std::cerr);
-
-            delete msg;
+            if (m_emulator != NULL)
+            {
+              emulate();
+            }
+            else
+            {
+              for (size_t i = 0; i < m_msgs.size(); ++i)
+              {
+                deliver(m_msgs[i]);
+                delete m_msgs[i];
+                m_msgs[i] = NULL;
+              }
+            }
           }
           catch (std::exception & e)
           {
-            m_task.debug("error while unpacking message: %s",e.what());
+            m_task.debug("error while receiving message: %s", e.what());
           }
+
+          for (size_t i = 0; i < m_msgs.size(); ++i)
+            delete m_msgs[i];
+          m_msgs.clear();
         }
 
         delete [] bfr;
@@ -43,10 +43,19 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
+    //! Number of bits in each word of the subscription bitmap.
+    static const unsigned c_word_bits = 32;
+    //! Number of words in the subscription bitmap.
+    static const unsigned c_words = 65536 / c_word_bits;
+
     class Node
     {
     public:
-      Node(const std::string& name, const std::string& services):
+      //! Subscription bitmap, empty if every message is wanted.
+      typedef std::vector<uint32_t> Bitmap;
+
+      Node(unsigned id, const std::string& name, const std::string& services):
+        m_id(id),
         m_name(name),
         m_active(m_addrs.end())
       {
@@ -64,13 +73,20 @@ namespace Transports
 
           if (std::sscanf(list[i].c_str(), "%*[^:]://%127[^:]:%u", address, &port) == 2)
             m_addrs.insert(std::pair<Address, unsigned>(address, port));
+
+          // Optional subscription: imc+udp://host:port/?subscribe=A,B
+          size_t pos = list[i].find("?subscribe=");
+          if (pos != std::string::npos)
+            setSubscription(list[i].substr(pos + 11));
         }
       }
 
       Node(const Node& node)
       {
+        m_id = node.m_id;
         m_name = node.m_name;
         m_addrs = node.m_addrs;
+        m_wanted = node.m_wanted;
 
         if (node.m_active == node.m_addrs.end())
           m_active = m_addrs.end();
@@ -78,12 +94,74 @@ namespace Transports
           m_active = m_addrs.find(node.m_active->first);
       }
 
+      unsigned
+      getId(void) const
+      {
+        return m_id;
+      }
+
       const std::string&
       getName(void) const
       {
         return m_name;
       }
 
+      //! Replace the set of wanted messages.
+      //! @param[in] list comma separated list of message abbreviations,
+      //! empty to receive every message.
+      void
+      setSubscription(const std::string& list)
+      {
+        std::vector<std::string> names;
+        String::split(list, ",", names);
+
+        m_wanted.clear();
+        for (unsigned i = 0; i < names.size(); ++i)
+        {
+          std::string name = String::trim(names[i]);
+          if (name.empty())
+            continue;
+
+          try
+          {
+            unsigned id = IMC::Factory::getIdFromAbbrev(name);
+            if (m_wanted.empty())
+              m_wanted.resize(c_words, 0);
+            m_wanted[id / c_word_bits] |= 1u << (id % c_word_bits);
+          }
+          catch (...)
+          { }
+        }
+      }
+
+      //! Subscription bitmap.
+      //! @return bitmap, empty if every message is wanted.
+      const Bitmap&
+      getSubscription(void) const
+      {
+        return m_wanted;
+      }
+
+      //! Test if the node wants a given message.
+      //! @param[in] msgid message identifier.
+      //! @return true if the message is wanted, false otherwise.
+      bool
+      wants(unsigned msgid) const
+      {
+        if (m_wanted.empty() || msgid >= DUNE_IMC_CONST_NULL_ID)
+          return true;
+
+        return (m_wanted[msgid / c_word_bits] & (1u << (msgid % c_word_bits))) != 0;
+      }
+
+      //! Test if the node has an active address.
+      //! @return true if active, false otherwise.
+      bool
+      isActive(void) const
+      {
+        return m_active != m_addrs.end();
+      }
+
       bool
       activate(const Address& addr)
       {
@@ -111,26 +189,25 @@ namespace Transports
       }
 
       void
-      send(UDPSocket& sock, const uint8_t* data, unsigned data_len)
+      getDestination(std::vector<UDPSocket::Destination>& dsts)
       {
         if (m_active == m_addrs.end())
           return;
 
-        try
-        {
-          sock.write(data, data_len, m_active->first, m_active->second);
-        }
-        catch (...)
-        { }
+        dsts.push_back(UDPSocket::Destination(m_active->first, m_active->second));
       }
 
     private:
+      // Node identifier.
+      unsigned m_id;
       // Node name.
       std::string m_name;
       // Addresses
       std::map<Address, unsigned> m_addrs;
       // Active address.
       std::map<Address, unsigned>::iterator m_active;
+      // Bitmap of wanted messages.
+      Bitmap m_wanted;
     };
   }
 }
@@ -31,6 +31,7 @@
 // ISO C++ 98 headers.
 #include <string>
 #include <map>
+#include <vector>
 #include <cstdio>
 
 // DUNE headers.
@@ -50,14 +51,29 @@ namespace Transports
     {
     public:
       NodeTable(void):
-        m_active_count(0),
         m_lcomms(NULL)
       { }
 
       void
       addNode(unsigned id, const std::string& name, const std::string& services)
       {
-        m_table.insert(std::pair<unsigned, Node>(id, Node(name, services)));
+        m_table.insert(std::pair<unsigned, Node>(id, Node(id, name, services)));
+      }
+
+      //! Replace the set of messages wanted by a node.
+      //! @param[in] id node identifier.
+      //! @param[in] list comma separated list of message abbreviations.
+      //! @return true if the node is known, false otherwise.
+      bool
+      subscribe(unsigned id, const std::string& list)
+      {
+        Table::iterator itr = m_table.find(id);
+        if (itr == m_table.end())
+          return false;
+
+        itr->second.setSubscription(list);
+        rebuild();
+        return true;
       }
 
       bool
@@ -70,7 +86,7 @@ namespace Transports
         if (!itr->second.activate(addr))
           return false;
 
-        ++m_active_count;
+        rebuild();
         return true;
       }
 
@@ -84,35 +100,50 @@ namespace Transports
         if (!itr->second.deactivate(addr))
           return false;
 
-        --m_active_count;
+        rebuild();
         return true;
       }
 
       unsigned
       getActiveCount(void)
       {
-        return m_active_count;
+        return m_active.size();
       }
 
+      //! Test if a message is wanted by every active node, in which
+      //! case it can share a datagram with other messages.
+      //! @param[in] msgid message identifier.
+      //! @return true if wanted by all active nodes, false otherwise.
+      bool
+      isWantedByAll(unsigned msgid) const
+      {
+        if (m_common.empty() || msgid >= DUNE_IMC_CONST_NULL_ID)
+          return true;
+
+        return (m_common[msgid / c_word_bits] & (1u << (msgid % c_word_bits))) != 0;
+      }
+
+      //! Append the destinations of a message.
+      //! @param[out] dsts destinations.
+      //! @param[in] msgid message identifier, DUNE_IMC_CONST_NULL_ID
+      //! for datagrams wanted by every node.
       void
-      send(UDPSocket& sock, const uint8_t* data, unsigned data_len, unsigned msgid)
+      getDestinations(std::vector<UDPSocket::Destination>& dsts, unsigned msgid)
       {
-        if (m_lcomms != NULL)
+        bool lcomms = (m_lcomms != NULL) && m_lcomms->isActive();
+
+        for (unsigned i = 0; i < m_active.size(); ++i)
         {
-          if (m_lcomms->isActive())
-          {
-            for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
-            {
-              if (m_lcomms->isNodeWithinRange(itr->first, msgid))
-                itr->second.send(sock, data, data_len);
-            }
+          Node* node = m_active[i];
 
-            return;
-          }
-        }
+          if (!node->wants(msgid))
+            continue;
 
-        for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
-          itr->second.send(sock, data, data_len);
+          if (lcomms && !m_lcomms->isNodeWithinRange(node->getId(), msgid))
+            continue;
+
+          node->getDestination(dsts);
+        }
       }
 
       void
@@ -123,12 +154,44 @@ namespace Transports
 
     private:
       typedef std::map<unsigned, Node> Table;
-      // Number of active nodes.
-      unsigned m_active_count;
       // Node table.
       Table m_table;
+      // Active nodes.
+      std::vector<Node*> m_active;
+      // Messages wanted by every active node, empty if all.
+      Node::Bitmap m_common;
       // Limited Comms object
       LimitedComms* m_lcomms;
+
+      //! Refresh the list of active nodes and the set of messages
+      //! wanted by all of them.
+      void
+      rebuild(void)
+      {
+        m_active.clear();
+        m_common.clear();
+
+        for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
+        {
+          if (!itr->second.isActive())
+            continue;
+
+          m_active.push_back(&itr->second);
+
+          const Node::Bitmap& wanted = itr->second.getSubscription();
+          if (wanted.empty())
+            continue;
+
+          if (m_common.empty())
+          {
+            m_common = wanted;
+            continue;
+          }
+
+          for (unsigned i = 0; i < c_words; ++i)
+            m_common[i] &= wanted[i];
+        }
+      }
     };
   }
 }
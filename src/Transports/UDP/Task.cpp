@@ -31,11 +31,13 @@
 #include <set>
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
+#include "Delta.hpp"
 #include "NodeAddress.hpp"
 #include "NodeTable.hpp"
 #include "Listener.hpp"
@@ -47,14 +49,6 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
-    struct RateInfo
-    {
-      // Interval between sending the same message (s).
-      double rate;
-      // Last time a given message type was sent.
-      double last;
-    };
-
     struct Arguments
     {
       // Contact timeout.
@@ -81,6 +75,24 @@ namespace Transports
       bool underwater_comms;
       // Messages that will always be transmitted, disregarding comm limitations
       std::vector<std::string> allowed_messages;
+      // Maximum time messages wait in the batch before being sent.
+      double batch_period;
+      // Maximum size of batched datagrams.
+      unsigned batch_size;
+      // Messages sent as keyframes and deltas.
+      std::vector<std::string> delta_msgs;
+      // Interval between keyframes.
+      double delta_keyframe;
+      // Emulate link bandwidth, latency, jitter and loss.
+      bool link_emulation;
+      // Model of surface links.
+      LinkModel radio;
+      // Model of underwater links.
+      LinkModel acoustic;
+      // PRNG type.
+      std::string prng_type;
+      // PRNG seed.
+      int prng_seed;
     };
 
     // Internal buffer size.
@@ -92,13 +104,14 @@ namespace Transports
     {
       // Serialization buffer.
       uint8_t* m_bfr;
+      // Gathered serialization of the current message.
+      IMC::ScatterPacket m_packet;
       // UDP Socket.
       UDPSocket m_sock;
       // Set of static nodes.
       std::set<NodeAddress> m_static_dsts;
-      // Message rate information.
-      std::map<uint32_t, double> m_rates_per_id;
-      std::map<uint32_t, RateInfo> m_rates;
+      // Message rate limiters.
+      Tasks::RateLimiters m_limits;
       // Set of destination nodes.
       NodeTable m_node_table;
       // Task arguments.
@@ -109,16 +122,38 @@ namespace Transports
       bool m_underwater_comms;
       // Listener thread.
       Listener* m_listener;
+      // Settings published to the listener thread.
+      Concurrency::Snapshot<ListenerSettings> m_listener_settings;
       // Contact refresh counter.
       Time::Counter<float> m_contacts_refresh_counter;
       // LimitedComms object
       LimitedComms* m_lcomms;
+      // Link emulator.
+      LinkEmulator* m_emulator;
+      // Batch of serialized packets.
+      uint8_t* m_batch;
+      // Number of bytes in batch.
+      unsigned m_batch_used;
+      // Batch flush timer.
+      Time::Counter<double> m_batch_timer;
+      // Destinations of the current datagram.
+      std::vector<UDPSocket::Destination> m_dsts;
+      // Identifiers of delta encoded messages.
+      std::set<uint32_t> m_delta_ids;
+      // Delta encoder.
+      DeltaEncoder m_delta;
+      // Message trace channel.
+      uint8_t m_trace_channel;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
         m_bfr(NULL),
         m_listener(NULL),
-        m_lcomms(NULL)
+        m_lcomms(NULL),
+        m_emulator(NULL),
+        m_batch(NULL),
+        m_batch_used(0),
+        m_trace_channel(IMC::dune_trace.getChannel(name))
       {
         param("Local Port", m_args.port)
         .defaultValue("6002")
@@ -134,11 +169,11 @@ namespace Transports
 
         param("Print Outgoing Messages", m_args.trace_out)
         .defaultValue("false")
-        .description("Print outgoing messages (Debug)");
+        .description("Record outgoing messages in the message trace (Debug)");
 
         param("Print Incoming Messages", m_args.trace_in)
         .defaultValue("false")
-        .description("Print incoming messages (Debug)");
+        .description("Record incoming messages in the message trace (Debug)");
 
         param("Static Destinations", m_args.destinations)
         .description("List of <IPv4>:<Port> destinations that will always receive outgoing messages");
@@ -167,17 +202,116 @@ namespace Transports
         .defaultValue("")
         .description("List of messages that will always be transmitted disregarding communication limitations");
 
-        // Allocate space for internal buffer.
+        param("Batching Period", m_args.batch_period)
+        .defaultValue("0")
+        .units(Units::Second)
+        .description("Maximum amount of time outgoing messages are held to be sent"
+                     " together in one datagram (0 to disable). Receivers must"
+                     " support multiple messages per datagram");
+
+        param("Batching Datagram Size", m_args.batch_size)
+        .defaultValue("1400")
+        .minimumValue("256")
+        .maximumValue("65000")
+        .units(Units::Byte)
+        .description("Maximum size of datagrams with batched messages");
+
+        param("Delta Messages", m_args.delta_msgs)
+        .defaultValue("")
+        .description("List of messages sent as periodic keyframes followed by"
+                     " compact deltas to the last keyframe. Only messages with"
+                     " a compact encoding are supported. Receivers must support"
+                     " delta frames");
+
+        param("Delta Keyframe Period", m_args.delta_keyframe)
+        .defaultValue("5.0")
+        .minimumValue("0.0")
+        .units(Units::Second)
+        .description("Interval between keyframes of delta encoded messages");
+
+        param("Link Emulation", m_args.link_emulation)
+        .defaultValue("false")
+        .description("Delay and drop received messages according to the"
+                     " bandwidth, latency, jitter and loss of the simulated"
+                     " link to their source. Only used with the Simulation profile");
+
+        param("Radio Bandwidth", m_args.radio.bandwidth)
+        .defaultValue("115200")
+        .minimumValue("0")
+        .units(Units::BitPerSecond)
+        .description("Bandwidth of surface links (0 for unlimited)");
+
+        param("Radio Latency", m_args.radio.latency)
+        .defaultValue("0.01")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Latency of surface links");
+
+        param("Radio Jitter", m_args.radio.jitter)
+        .defaultValue("0.01")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Maximum random delay added to surface links");
+
+        param("Radio Loss", m_args.radio.loss)
+        .defaultValue("0.01")
+        .minimumValue("0")
+        .maximumValue("1")
+        .description("Probability of losing a message at short range on"
+                     " surface links. Losses grow with distance up to"
+                     " the communication range");
+
+        param("Acoustic Bandwidth", m_args.acoustic.bandwidth)
+        .defaultValue("300")
+        .minimumValue("0")
+        .units(Units::BitPerSecond)
+        .description("Bandwidth of underwater links (0 for unlimited)");
+
+        param("Acoustic Latency", m_args.acoustic.latency)
+        .defaultValue("1.0")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Latency of underwater links");
+
+        param("Acoustic Jitter", m_args.acoustic.jitter)
+        .defaultValue("0.5")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Maximum random delay added to underwater links");
+
+        param("Acoustic Loss", m_args.acoustic.loss)
+        .defaultValue("0.1")
+        .minimumValue("0")
+        .maximumValue("1")
+        .description("Probability of losing a message at short range on"
+                     " underwater links. Losses grow with distance up to"
+                     " the communication range");
+
+        param("PRNG Type", m_args.prng_type)
+        .defaultValue(Random::Factory::c_default)
+        .description("Pseudo-random number generator used by the link emulation");
+
+        param("PRNG Seed", m_args.prng_seed)
+        .defaultValue("-1")
+        .description("Seed of the link emulation generator (-1 for random)");
+
+        // Allocate space for internal buffers.
         m_bfr = new uint8_t[c_bfr_size];
+        m_batch = new uint8_t[c_bfr_size];
 
         // Register listeners.
         bind<IMC::Announce>(this);
+        bind<IMC::RemoteState>(this);
+        bind<IMC::SessionSubscription>(this);
       }
 
       ~Task(void)
       {
         if (m_bfr != NULL)
           delete[] m_bfr;
+
+        if (m_batch != NULL)
+          delete[] m_batch;
       }
 
       void
@@ -185,31 +319,41 @@ namespace Transports
       {
         m_contacts_refresh_counter.setTop(m_args.contact_refresh_per);
 
+        ListenerSettings settings;
+        settings.contact_timeout = m_args.contact_timeout;
+        settings.trace = m_args.trace_in;
+        m_listener_settings.publish(settings);
+
         // Initialize set of static destinations.
         m_static_dsts.clear();
         for (unsigned int i = 0; i < m_args.destinations.size(); ++i)
           m_static_dsts.insert(NodeAddress(m_args.destinations[i]));
 
-        // Process rate limiters.
-        m_rates_per_id.clear();
-        m_rates.clear();
-        for (unsigned int i = 0; i < m_args.rate_lims.size(); ++i)
+        // Process rate limiters, enforced by the message bus.
+        m_limits.setup(m_args.rate_lims);
+
+        // Process delta encoded messages.
+        m_delta_ids.clear();
+        for (unsigned i = 0; i < m_args.delta_msgs.size(); ++i)
         {
-          std::vector<std::string> parts;
-          String::split(m_args.rate_lims[i], ":", parts);
-          if (parts.size() != 2)
+          uint32_t id = IMC::Factory::getIdFromAbbrev(m_args.delta_msgs[i]);
+          if (!IMC::CompactCodec::isSupported(id))
+          {
+            war(DTR("message '%s' cannot be delta encoded"), m_args.delta_msgs[i].c_str());
             continue;
+          }
 
-          uint32_t id = IMC::Factory::getIdFromAbbrev(parts[0]);
-          float rate = 0;
-          std::sscanf(parts[1].c_str(), "%f", &rate);
-          m_rates_per_id[id] = 1.0 / rate;
+          m_delta_ids.insert(id);
         }
 
+        m_delta.setKeyframePeriod(m_args.delta_keyframe);
+        m_delta.clear();
+
         m_underwater_comms = m_args.underwater_comms;
 
         // Initialize communication limitations parameters.
-        if (m_ctx.profiles.isSelected("Simulation") && m_args.comm_range > 0)
+        if (m_ctx.profiles.isSelected("Simulation")
+            && (m_args.comm_range > 0 || m_args.link_emulation))
         {
           debug("simulating limited radio communications with maximum communication range of %f m",
                 m_args.comm_range);
@@ -224,7 +368,7 @@ namespace Transports
         }
 
         // Register normal messages.
-        bind(this, m_args.messages);
+        bind(this, m_args.messages, m_limits);
       }
 
       void
@@ -278,11 +422,19 @@ namespace Transports
         // Initialize limited comms object
         m_lcomms = new LimitedComms(m_args.comm_range, getSystemId());
         m_lcomms->setActive(m_comm_limitations);
+        m_lcomms->setUnderwaterComms(m_underwater_comms);
         m_node_table.setLimitedComms(m_lcomms);
 
+        if (m_comm_limitations && m_args.link_emulation)
+        {
+          debug("emulating link bandwidth, latency and losses");
+          m_emulator = new LinkEmulator(m_args.radio, m_args.acoustic, m_args.comm_range,
+                                        m_args.prng_type, m_args.prng_seed);
+        }
+
         // Start listener thread.
-        m_listener = new Listener(*this, m_sock, m_lcomms,
-                                  m_args.contact_timeout, m_args.trace_in);
+        m_listener = new Listener(*this, m_sock, m_lcomms, m_listener_settings,
+                                  m_emulator);
         m_listener->start();
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
@@ -291,6 +443,8 @@ namespace Transports
       void
       onResourceRelease(void)
       {
+        flushBatch();
+
         if (m_listener != NULL)
         {
           m_listener->stopAndJoin();
@@ -298,6 +452,7 @@ namespace Transports
           m_listener = NULL;
         }
 
+        Memory::clear(m_emulator);
         Memory::clear(m_lcomms);
       }
 
@@ -313,40 +468,100 @@ namespace Transports
         if (m_node_table.getActiveCount() == 0 && m_static_dsts.size() == 0)
           return;
 
-        uint32_t key = (msg->getId() << 16) + (msg->getSourceEntity() << 8) + (msg->getSubId() & 0xff);
+        // Large data fields are sent from the message itself.
+        uint16_t rv = 0;
+        bool delta = m_delta_ids.find(msg->getId()) != m_delta_ids.end();
+        if (delta)
+          rv = m_delta.encode(msg, m_bfr, c_bfr_size);
+        else
+          rv = IMC::Packet::serialize(msg, m_packet);
 
-        if (m_rates.find(key) == m_rates.end())
+        if (m_args.trace_out)
+          IMC::dune_trace.record(msg, m_trace_channel, IMC::TraceRing::DIR_OUT, rv);
+
+        // Messages cannot be batched if destinations depend on the
+        // message.
+        if (m_args.batch_period <= 0 || m_lcomms->isActive()
+            || !m_node_table.isWantedByAll(msg->getId()))
         {
-          m_rates[key].rate = m_rates_per_id[msg->getId()];
-          m_rates[key].last = 0.0;
+          flushBatch();
+          sendMessage(delta, rv, msg->getId());
+          return;
         }
-        else
+
+        if (m_batch_used + rv > m_args.batch_size)
+          flushBatch();
+
+        if (rv >= m_args.batch_size)
         {
-          double now = Clock::get();
-          if (m_rates[key].last + m_rates[key].rate >= now)
-            return;
-          m_rates[key].last = now;
+          sendMessage(delta, rv, msg->getId());
+          return;
         }
 
-        if (m_args.trace_out)
-          msg->toText(std::cerr);
+        if (m_batch_used == 0)
+          m_batch_timer.setTop(m_args.batch_period);
 
-        uint16_t rv = IMC::Packet::serialize(msg, m_bfr, c_bfr_size);
+        if (delta)
+          std::memcpy(m_batch + m_batch_used, m_bfr, rv);
+        else
+          m_packet.copy(m_batch + m_batch_used);
+
+        m_batch_used += rv;
+      }
+
+      //! Send the last serialized message in a datagram of its own.
+      //! @param[in] delta true if the message was delta encoded.
+      //! @param[in] size size of the serialized message.
+      //! @param[in] msgid message identifier.
+      void
+      sendMessage(bool delta, uint16_t size, unsigned msgid)
+      {
+        if (delta)
+          send(m_bfr, size, msgid);
+        else
+          send(m_packet.getBuffers(), m_packet.getSizes(), m_packet.getCount(), msgid);
+      }
+
+      //! Send a datagram to all static and dynamic nodes.
+      //! @param[in] data datagram.
+      //! @param[in] data_len datagram size.
+      //! @param[in] msgid identifier of the message in the datagram.
+      void
+      send(const uint8_t* data, unsigned data_len, unsigned msgid)
+      {
+        size_t size = data_len;
+        send(&data, &size, 1, msgid);
+      }
+
+      //! Send a datagram gathered from several buffers to all static
+      //! and dynamic nodes.
+      //! @param[in] bfrs buffers.
+      //! @param[in] sizes size of each buffer.
+      //! @param[in] count number of buffers.
+      //! @param[in] msgid identifier of the message in the datagram.
+      void
+      send(const uint8_t* const* bfrs, const size_t* sizes, unsigned count, unsigned msgid)
+      {
+        m_dsts.clear();
 
-        // Send to static nodes.
         std::set<NodeAddress>::iterator itr = m_static_dsts.begin();
         for (; itr != m_static_dsts.end(); ++itr)
-        {
-          try
-          {
-            m_sock.write(m_bfr, rv, itr->getAddress(), itr->getPort());
-          }
-          catch (...)
-          { }
-        }
+          m_dsts.push_back(UDPSocket::Destination(itr->getAddress(), itr->getPort()));
 
-        // Send to dynamic nodes.
-        m_node_table.send(m_sock, m_bfr, rv, msg->getId());
+        m_node_table.getDestinations(m_dsts, msgid);
+
+        m_sock.writeVector(bfrs, sizes, count, m_dsts);
+      }
+
+      //! Send batched messages.
+      void
+      flushBatch(void)
+      {
+        if (m_batch_used == 0)
+          return;
+
+        send(m_batch, m_batch_used, DUNE_IMC_CONST_NULL_ID);
+        m_batch_used = 0;
       }
 
       void
@@ -356,6 +571,24 @@ namespace Transports
         m_lcomms->setAnnounce(msg);
       }
 
+      void
+      consume(const IMC::SessionSubscription* msg)
+      {
+        if (msg->getSource() == getSystemId())
+          return;
+
+        if (m_node_table.subscribe(msg->getSource(), msg->messages))
+          debug("node '%s' subscribed to '%s'",
+                resolveSystemId(msg->getSource()), msg->messages.c_str());
+      }
+
+      void
+      consume(const IMC::RemoteState* msg)
+      {
+        if (m_lcomms->isActive() && msg->getSource() != getSystemId())
+          m_lcomms->setRemoteState(msg);
+      }
+
       void
       refreshContacts(void)
       {
@@ -372,7 +605,11 @@ namespace Transports
           if (itr->isActive())
           {
             if (m_node_table.activate(itr->getId(), itr->getAddress()))
+            {
               inf(DTR("activating transmission to node '%s'"), name.c_str());
+              // New peers need keyframes to decode deltas.
+              m_delta.reset();
+            }
           }
           else
           {
@@ -389,7 +626,13 @@ namespace Transports
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          if (m_batch_used > 0)
+            waitForMessages(std::min(1.0, m_batch_timer.getRemaining()));
+          else
+            waitForMessages(1.0);
+
+          if (m_batch_used > 0 && m_batch_timer.overflow())
+            flushBatch();
 
           // Check if it's time to update the contact list.
           if (m_contacts_refresh_counter.overflow())
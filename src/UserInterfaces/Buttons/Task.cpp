@@ -92,7 +92,8 @@ namespace UserInterfaces
             {
               m_button_event.button = m_args.button_numbers[i];
               m_button_event.value = m_buttons->value(m_args.button_numbers[i]);
-              dispatch(m_button_event);
+              m_button_event.setTimeStamp(m_buttons->getTimeStamp());
+              dispatch(m_button_event, DF_KEEP_TIME);
             }
           }
         }
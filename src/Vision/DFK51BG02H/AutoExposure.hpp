@@ -29,6 +29,7 @@
 #define VISION_DFK51BG02H_AUTO_EXPOSURE_HPP_INCLUDED_
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstring>
 
 // DUNE headers.
@@ -50,22 +51,18 @@ namespace Vision
       { }
 
       //! Calculate the gain update
-      //! @param[in] data RGB24 image.
-      //! @param[in] count number of RGB24 pixels in data.
+      //! @param[in] luma luma plane of the image.
+      //! @param[in] count number of pixels in luma.
       float
-      exposureCorrection(uint8_t* data, unsigned count)
+      exposureCorrection(const uint8_t* luma, unsigned count)
       {
         // Accumulate pixel values
-        float ar = 0, ag = 0, ab = 0;
+        uint64_t sum = 0;
         for (unsigned i = 0; i < count; i++)
-        {
-          ar += data[3 * i];
-          ag += data[3 * i + 1];
-          ab += data[3 * i + 2];
-        }
+          sum += luma[i];
 
         // Calculate the exposure time multiplier
-        return  (128.0 * count)/(0.299 * ar + 0.587 * ag + 0.114 * ab);
+        return (128.0 * count) / std::max<uint64_t>(sum, 1);
       }
 
     private:
@@ -159,8 +159,8 @@ namespace Vision
       GVCP* m_gvcp;
       //! %GVSP.
       GVSP* m_gvsp;
-      //! RGB24 buffer.
-      uint8_t* m_rgb24_bfr;
+      //! YCbCr 4:2:0 buffer (luma followed by chroma planes).
+      uint8_t* m_yuv_bfr;
       //! Keep-alive counter.
       Counter<double> m_kalive;
       //! %Destination log folder.
@@ -282,7 +282,7 @@ namespace Vision
         param("White Balance - R Factor", m_args.r_factor)
         .defaultValue("1.0");
 
-        m_rgb24_bfr = new uint8_t[c_width * c_height * 3];
+        m_yuv_bfr = new uint8_t[c_width * c_height * 3 / 2];
 
         // Initialize PGM header.
         m_pgm_header = String::str("P5 %u %u 255\n", c_width, c_height);
@@ -293,7 +293,7 @@ namespace Vision
       //! Destructor.
       ~Task(void)
       {
-        delete [] m_rgb24_bfr;
+        delete [] m_yuv_bfr;
       }
 
       //! Update internal parameters.
@@ -314,7 +314,6 @@ namespace Vision
       {
         // Initialize JPEG compressor.
         m_jpeg.setInputDimensions(c_width, c_height);
-        m_jpeg.setInputColorSpace(JPEGCompressor::CS_RGB);
         m_jpeg.setOutputColorSpace(JPEGCompressor::CS_YUV);
 
         m_gvcp = new GVCP(m_args.raddr);
@@ -481,9 +480,13 @@ namespace Vision
             double timestamp = frame->getTimeStamp();
             Path file = m_log_dir / String::str("%0.4f.jpg", timestamp);
 
+            uint8_t* luma = m_yuv_bfr;
+            uint8_t* cb = luma + c_width * c_height;
+            uint8_t* cr = cb + c_width * c_height / 4;
+
             {
-              m_debayer.decodeToRGB24(frame->getData(), m_rgb24_bfr, c_width, c_height);
-              m_jpeg.compress(m_rgb24_bfr, m_args.jpeg_quality);
+              m_debayer.decodeToYCbCr420(frame->getData(), luma, cb, cr, c_width, c_height);
+              m_jpeg.compressYCbCr420(luma, cb, cr, m_args.jpeg_quality);
               std::ofstream jpg(file.c_str(), std::ios::binary);
               jpg.write((char*)m_jpeg.imageData(), m_jpeg.imageSize());
             }
@@ -498,7 +501,7 @@ namespace Vision
 
             if (m_args.ae)
             {
-              float correction = m_ae.exposureCorrection(m_rgb24_bfr, c_width * c_height);
+              float correction = m_ae.exposureCorrection(luma, c_width * c_height);
               // Smooth out the exposure (make it slower varying), halve the deltaEV
               correction = std::sqrt(correction);
               m_exposure = Math::trimValue(m_exposure * correction, 0.0001, m_args.exposure_time);
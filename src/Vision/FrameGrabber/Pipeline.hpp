@@ -0,0 +1,332 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef VISION_FRAME_GRABBER_PIPELINE_HPP_INCLUDED_
+#define VISION_FRAME_GRABBER_PIPELINE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Vision
+{
+  namespace FrameGrabber
+  {
+    using DUNE_NAMESPACES;
+
+    //! Captured frame travelling through the pipeline.
+    struct Frame
+    {
+      //! Capture buffer holding the raw RGB24 image.
+      int buffer;
+      //! Raw RGB24 image (in the capture buffer).
+      const uint8_t* raw;
+      //! Compressed image.
+      std::vector<char> jpeg;
+      //! Capture sequence number.
+      unsigned seq;
+      //! Capture time.
+      double tstamp;
+      //! JPEG quality.
+      unsigned quality;
+    };
+
+    //! Compression thread. Each worker owns a JPEG compressor and
+    //! compresses the frames it is given in order, straight from
+    //! their capture buffers, which are returned to the driver as
+    //! soon as they are compressed.
+    class Worker: public Concurrency::Thread
+    {
+    public:
+      //! Constructor.
+      //! @param[in] video video capture device.
+      //! @param[in] frames maximum number of frames in flight.
+      //! @param[in] done queue of compressed frames.
+      Worker(Media::VideoCapture& video, unsigned frames, Concurrency::MPSCQueue<Frame*>& done):
+        m_video(video),
+        m_in(frames),
+        m_done(done)
+      {
+        m_jpeg.setInputDimensions(video.frameWidth(), video.frameHeight());
+        m_jpeg.setInputColorSpace(Media::JPEGCompressor::CS_RGB);
+        m_jpeg.setOutputColorSpace(Media::JPEGCompressor::CS_RGB);
+      }
+
+      //! Destructor.
+      ~Worker(void)
+      {
+        if (isCreated())
+        {
+          stop();
+          m_in.wakeup();
+          join();
+        }
+      }
+
+      //! Compress a frame.
+      //! @param[in] frame frame.
+      void
+      submit(Frame* frame)
+      {
+        // There are never more frames in flight than queue cells.
+        m_in.push(frame);
+      }
+
+    private:
+      //! Video capture device.
+      Media::VideoCapture& m_video;
+      //! Frames to compress.
+      Concurrency::MPSCQueue<Frame*> m_in;
+      //! Compressed frames.
+      Concurrency::MPSCQueue<Frame*>& m_done;
+      //! JPEG compressor.
+      Media::JPEGCompressor m_jpeg;
+
+      void
+      run(void)
+      {
+        Frame* frame = NULL;
+
+        while (!isStopping())
+        {
+          if (!m_in.pop(frame))
+          {
+            m_in.waitForItems(1.0);
+            continue;
+          }
+
+          m_jpeg.compress(const_cast<uint8_t*>(frame->raw), frame->quality);
+          m_video.releaseFrame(frame->buffer);
+
+          const char* img = (const char*)m_jpeg.imageData();
+          frame->jpeg.assign(img, img + m_jpeg.imageSize());
+          m_done.push(frame);
+        }
+      }
+    };
+
+    //! Capture, compression and output pipeline. The task acquires
+    //! captured frames and hands them over to compression threads in
+    //! turn, without copying them; this thread restores capture
+    //! order and outputs frames through a listener, so that slow
+    //! consumers (e.g., disk writes) never delay capture. A frame
+    //! captured while all frames are in flight is dropped.
+    class Pipeline: public Concurrency::Thread
+    {
+    public:
+      //! Receiver of compressed frames, called from the pipeline
+      //! thread in capture order.
+      class Listener
+      {
+      public:
+        virtual
+        ~Listener(void)
+        { }
+
+        //! Output a compressed frame.
+        //! @param[in] frame frame.
+        virtual void
+        onFrame(const Frame& frame) = 0;
+      };
+
+      //! Constructor. Compression threads are started immediately.
+      //! @param[in] listener receiver of compressed frames.
+      //! @param[in] video video capture device.
+      //! @param[in] threads number of compression threads.
+      //! @param[in] frames maximum number of frames in flight.
+      Pipeline(Listener* listener, Media::VideoCapture& video, unsigned threads, unsigned frames):
+        m_listener(listener),
+        m_done(frames),
+        m_free(frames),
+        m_seq(0),
+        m_next(0),
+        m_captured(0),
+        m_dropped(0),
+        m_output(0),
+        m_lat_sum(0),
+        m_lat_max(0)
+      {
+        for (unsigned i = 0; i < frames; ++i)
+        {
+          m_frames.push_back(new Frame);
+          m_free.push(m_frames.back());
+        }
+
+        for (unsigned i = 0; i < threads; ++i)
+        {
+          m_workers.push_back(new Worker(video, frames, m_done));
+          m_workers.back()->start();
+        }
+      }
+
+      //! Destructor.
+      ~Pipeline(void)
+      {
+        if (isCreated())
+        {
+          stop();
+          m_done.wakeup();
+          join();
+        }
+
+        for (unsigned i = 0; i < m_workers.size(); ++i)
+          delete m_workers[i];
+
+        for (unsigned i = 0; i < m_frames.size(); ++i)
+          delete m_frames[i];
+      }
+
+      //! Compress and output a captured frame.
+      //! @param[in] video video capture device.
+      //! @param[in] buffer capture buffer returned by
+      //! VideoCapture::acquireFrame().
+      //! @param[in] tstamp capture time.
+      //! @param[in] quality JPEG quality.
+      //! @return true if the frame was accepted, false if it was
+      //! dropped (and its buffer released).
+      bool
+      submit(Media::VideoCapture& video, int buffer, double tstamp, unsigned quality)
+      {
+        Frame* frame = NULL;
+        ++m_captured;
+        if (!m_free.pop(frame))
+        {
+          ++m_dropped;
+          video.releaseFrame(buffer);
+          return false;
+        }
+
+        frame->buffer = buffer;
+        frame->raw = video.getBufferData(buffer);
+        frame->seq = m_seq++;
+        frame->tstamp = tstamp;
+        frame->quality = quality;
+        m_workers[frame->seq % m_workers.size()]->submit(frame);
+        return true;
+      }
+
+      //! Count frames dropped before being captured.
+      //! @param[in] count number of frames.
+      void
+      countDropped(unsigned count)
+      {
+        m_captured += count;
+        m_dropped += count;
+      }
+
+      //! Retrieve and reset the pipeline statistics.
+      //! @param[out] stats statistics.
+      void
+      getStatistics(IMC::ImagePipelineStatistics& stats)
+      {
+        stats.captured = m_captured;
+        stats.dropped = m_dropped;
+        m_captured = 0;
+        m_dropped = 0;
+
+        ScopedMutex l(m_stats_lock);
+        stats.output = m_output;
+        stats.lat_mean = (m_output > 0) ? m_lat_sum / m_output : 0;
+        stats.lat_max = m_lat_max;
+        m_output = 0;
+        m_lat_sum = 0;
+        m_lat_max = 0;
+      }
+
+    private:
+      //! Receiver of compressed frames.
+      Listener* m_listener;
+      //! All frame buffers.
+      std::vector<Frame*> m_frames;
+      //! Compression threads.
+      std::vector<Worker*> m_workers;
+      //! Compressed frames.
+      Concurrency::MPSCQueue<Frame*> m_done;
+      //! Frame buffers available for capture.
+      Concurrency::MPSCQueue<Frame*> m_free;
+      //! Compressed frames waiting for earlier ones, by sequence.
+      std::map<unsigned, Frame*> m_pending;
+      //! Sequence number of the next captured frame.
+      unsigned m_seq;
+      //! Sequence number of the next frame to output.
+      unsigned m_next;
+      //! Number of captured frames (task thread).
+      unsigned m_captured;
+      //! Number of dropped frames (task thread).
+      unsigned m_dropped;
+      //! Number of output frames.
+      unsigned m_output;
+      //! Sum of output latencies.
+      double m_lat_sum;
+      //! Maximum output latency.
+      double m_lat_max;
+      //! Lock of output statistics.
+      Concurrency::Mutex m_stats_lock;
+
+      void
+      run(void)
+      {
+        Frame* frame = NULL;
+
+        while (!isStopping())
+        {
+          if (!m_done.pop(frame))
+          {
+            m_done.waitForItems(1.0);
+            continue;
+          }
+
+          m_pending[frame->seq] = frame;
+
+          std::map<unsigned, Frame*>::iterator itr = m_pending.begin();
+          while (itr != m_pending.end() && itr->first == m_next)
+          {
+            m_listener->onFrame(*itr->second);
+
+            double latency = Clock::getSinceEpoch() - itr->second->tstamp;
+            {
+              ScopedMutex l(m_stats_lock);
+              ++m_output;
+              m_lat_sum += latency;
+              m_lat_max = std::max(m_lat_max, latency);
+            }
+
+            m_free.push(itr->second);
+            m_pending.erase(itr++);
+            ++m_next;
+          }
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -38,6 +38,9 @@
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
+// Local headers.
+#include "Pipeline.hpp"
+
 namespace Vision
 {
   namespace FrameGrabber
@@ -56,20 +59,65 @@ namespace Vision
       unsigned jpeg_quality;
       //! Video standard (PAL or NTSC).
       std::string standard;
+      //! Number of compression threads.
+      unsigned threads;
+      //! Maximum number of frames in flight.
+      unsigned frames;
+      //! True to save frames in the current log.
+      bool save;
+      //! Statistics report period.
+      double stats_period;
+      //! Video encoding.
+      std::string encoding;
+      //! H.264 encoder device.
+      std::string enc_dev;
+      //! H.264 bit rate.
+      unsigned bitrate;
+      //! Number of frames between H.264 key frames.
+      unsigned gop;
+      //! Maximum size of H.264 chunks.
+      unsigned chunk_size;
     };
 
-    struct Task: public DUNE::Tasks::Periodic
+    struct Task: public DUNE::Tasks::Periodic, public Pipeline::Listener
     {
       IMC::CompressedImage m_frame;
       Media::VideoCapture* m_video;
-      Media::JPEGCompressor m_jpeg;
       Media::VideoCapture::Standard m_standard;
       Arguments m_args;
+      //! Compression and output pipeline.
+      Pipeline* m_pipeline;
+      //! Pipeline statistics.
+      IMC::ImagePipelineStatistics m_stats;
+      //! Statistics report timer.
+      Counter<double> m_stats_timer;
+      //! Folder of saved frames (empty if not logging).
+      Path m_log_dir;
+      //! Lock of the folder of saved frames.
+      Concurrency::Mutex m_log_lock;
+      //! Driver sequence number of the last frame.
+      uint32_t m_sequence;
+      //! True if no frame was captured yet.
+      bool m_first;
+      //! H.264 encoder (NULL when compressing JPEG).
+      Media::H264Encoder* m_encoder;
+      //! Encoded video chunk.
+      IMC::CompressedVideo m_chunk;
+      //! Encoded frame.
+      std::vector<char> m_encoded;
+      //! Encoded video file of the current log.
+      std::ofstream m_log_video;
+      //! Statistics of the H.264 encoder.
+      IMC::ImagePipelineStatistics m_enc_stats;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Periodic(name, ctx),
         m_video(NULL),
-        m_standard(Media::VideoCapture::STANDARD_PAL)
+        m_standard(Media::VideoCapture::STANDARD_PAL),
+        m_pipeline(NULL),
+        m_sequence(0),
+        m_first(true),
+        m_encoder(NULL)
       {
         // Retrieve configuration values.
         param("Video Device", m_args.vid_dev)
@@ -98,7 +146,57 @@ namespace Vision
         .values("PAL, NTSC")
         .description("Video standard");
 
+        param("Encoding", m_args.encoding)
+        .defaultValue("JPEG")
+        .values("JPEG, H.264")
+        .description("Compress individual frames in JPEG or encode a H.264"
+                     " video stream with a hardware encoder");
+
+        param("H.264 - Encoder Device", m_args.enc_dev)
+        .defaultValue("/dev/video11")
+        .description("Video4Linux2 memory-to-memory H.264 encoder");
+
+        param("H.264 - Bit Rate", m_args.bitrate)
+        .defaultValue("250000")
+        .minimumValue("10000")
+        .description("Target bit rate of the video stream in bits per second");
+
+        param("H.264 - Key Frame Interval", m_args.gop)
+        .defaultValue("30")
+        .minimumValue("1")
+        .description("Number of frames between key frames. Receivers can only"
+                     " join the stream or recover from losses at key frames");
+
+        param("H.264 - Maximum Chunk Size", m_args.chunk_size)
+        .defaultValue("1000")
+        .minimumValue("100")
+        .units(Units::Byte)
+        .description("Encoded frames are sent in chunks of up to this size");
+
+        param("Compression Threads", m_args.threads)
+        .defaultValue("2")
+        .minimumValue("1")
+        .description("Number of threads compressing frames");
+
+        param("Frame Buffers", m_args.frames)
+        .defaultValue("6")
+        .minimumValue("2")
+        .description("Number of frames being compressed or output at once."
+                     " Frames captured while this many are in flight are dropped");
+
+        param("Save to Log", m_args.save)
+        .defaultValue("false")
+        .description("Save frames as JPEG files in the 'Photos' folder of the current log"
+                     " or the H.264 stream as 'Video.h264'");
+
+        param("Statistics Period", m_args.stats_period)
+        .defaultValue("10.0")
+        .minimumValue("0.0")
+        .units(Units::Second)
+        .description("Period of pipeline statistics reports (zero to disable)");
+
         bind<IMC::ImageTxSettings>(this);
+        bind<IMC::LoggingControl>(this);
       }
 
       void
@@ -108,20 +206,42 @@ namespace Vision
           m_standard = Media::VideoCapture::STANDARD_NTSC;
         else
           m_standard = Media::VideoCapture::STANDARD_PAL;
+
+        if (m_encoder != NULL && paramChanged(m_args.bitrate))
+          m_encoder->setBitRate(m_args.bitrate);
+      }
+
+      //! True if encoding a H.264 stream.
+      bool
+      isVideo(void) const
+      {
+        return m_args.encoding == "H.264";
       }
 
       void
       onResourceAcquisition(void)
       {
-        m_video = new VideoCapture(m_args.vid_dev, m_args.pic_w, m_args.pic_h);
+        // Frames are compressed in place: keep two buffers for the
+        // driver besides those in flight.
+        m_video = new VideoCapture(m_args.vid_dev, m_args.pic_w, m_args.pic_h, m_args.frames + 2);
+
+        if (isVideo())
+        {
+          m_encoder = new Media::H264Encoder(m_args.enc_dev, m_video->frameWidth(), m_video->frameHeight(),
+                                             m_args.bitrate, m_args.gop, m_args.frames);
+        }
       }
 
       void
       onResourceInitialization(void)
       {
-        m_jpeg.setInputDimensions(m_video->frameWidth(), m_video->frameHeight());
-        m_jpeg.setInputColorSpace(m_jpeg.CS_RGB);
-        m_jpeg.setOutputColorSpace(m_jpeg.CS_RGB);
+        if (!isVideo())
+        {
+          m_pipeline = new Pipeline(this, *m_video, m_args.threads, m_args.frames);
+          m_pipeline->start();
+        }
+
+        m_stats_timer.setTop(m_args.stats_period);
         m_video->setStandard(m_standard);
         m_video->start();
       }
@@ -129,6 +249,8 @@ namespace Vision
       void
       onResourceRelease(void)
       {
+        Memory::clear(m_pipeline);
+        Memory::clear(m_encoder);
         Memory::clear(m_video);
       }
 
@@ -137,18 +259,180 @@ namespace Vision
       {
         setFrequency(msg->fps);
         m_args.jpeg_quality = msg->quality;
+
+        // A new viewer needs a key frame to start decoding.
+        if (m_encoder != NULL)
+          m_encoder->requestKeyFrame();
+      }
+
+      void
+      consume(const IMC::LoggingControl* msg)
+      {
+        if (!m_args.save || msg->getSource() != getSystemId())
+          return;
+
+        ScopedMutex l(m_log_lock);
+        switch (msg->op)
+        {
+          case IMC::LoggingControl::COP_STARTED:
+            if (isVideo())
+            {
+              m_log_video.close();
+              m_log_dir = m_ctx.dir_log / msg->name;
+              break;
+            }
+
+            m_log_dir = m_ctx.dir_log / msg->name / "Photos";
+            m_log_dir.create();
+            break;
+
+          case IMC::LoggingControl::COP_STOPPED:
+            m_log_video.close();
+            m_log_dir = Path();
+            break;
+        }
+      }
+
+      //! Dispatch and save a compressed frame (pipeline thread).
+      void
+      onFrame(const Frame& frame)
+      {
+        m_frame.data = frame.jpeg;
+        m_frame.frameid = frame.seq % 255;
+        m_frame.setTimeStamp(frame.tstamp);
+        dispatch(m_frame, DF_KEEP_TIME);
+
+        Path file;
+        {
+          ScopedMutex l(m_log_lock);
+          if (m_log_dir.str().empty())
+            return;
+          file = m_log_dir / String::str("%0.4f.jpg", frame.tstamp);
+        }
+
+        std::ofstream jpg(file.c_str(), std::ios::binary);
+        jpg.write(&frame.jpeg[0], frame.jpeg.size());
+      }
+
+      //! Save an encoded frame to the current log. The file starts
+      //! at a key frame, so that it can be decoded.
+      void
+      saveVideo(bool key)
+      {
+        ScopedMutex l(m_log_lock);
+        if (m_log_dir.str().empty())
+          return;
+
+        if (!m_log_video.is_open())
+        {
+          if (!key)
+            return;
+          m_log_video.open((m_log_dir / "Video.h264").c_str(), std::ios::binary | std::ios::app);
+        }
+
+        m_log_video.write(&m_encoded[0], m_encoded.size());
+      }
+
+      //! Dispatch an encoded frame in chunks.
+      void
+      sendVideo(bool key, double tstamp)
+      {
+        size_t size = m_encoded.size();
+        size_t chunk_size = std::max((size_t)m_args.chunk_size, (size + 254) / 255);
+        unsigned chunks = (size + chunk_size - 1) / chunk_size;
+
+        m_chunk.codec = IMC::CompressedVideo::CODEC_H264;
+        m_chunk.flags = key ? IMC::CompressedVideo::CVF_KEYFRAME : 0;
+        m_chunk.chunks = chunks;
+        m_chunk.setTimeStamp(tstamp);
+
+        for (unsigned i = 0; i < chunks; ++i)
+        {
+          size_t begin = i * chunk_size;
+          size_t end = std::min(size, begin + chunk_size);
+          m_chunk.chunk = i;
+          m_chunk.data.assign(m_encoded.begin() + begin, m_encoded.begin() + end);
+          dispatch(m_chunk, DF_KEEP_TIME);
+        }
+
+        m_chunk.frameid = (m_chunk.frameid + 1) & 0xffff;
+        saveVideo(key);
+
+        double latency = Clock::getSinceEpoch() - tstamp;
+        m_enc_stats.lat_mean += latency;
+        m_enc_stats.lat_max = std::max(m_enc_stats.lat_max, (fp32_t)latency);
+        ++m_enc_stats.output;
+      }
+
+      //! Encode a captured frame and send the frames that the
+      //! encoder finished.
+      void
+      encode(int buffer, double tstamp)
+      {
+        ++m_enc_stats.captured;
+        if (!m_encoder->submit(m_video->getBufferData(buffer), tstamp))
+          ++m_enc_stats.dropped;
+        m_video->releaseFrame(buffer);
+
+        bool key = false;
+        while (m_encoder->receive(m_encoded, key, tstamp, 0.0))
+          sendVideo(key, tstamp);
+      }
+
+      void
+      reportStatistics(void)
+      {
+        if (m_args.stats_period <= 0 || !m_stats_timer.overflow())
+          return;
+
+        m_stats_timer.reset();
+        if (m_encoder != NULL)
+        {
+          m_stats = m_enc_stats;
+          if (m_stats.output > 0)
+            m_stats.lat_mean /= m_stats.output;
+          m_enc_stats.clear();
+        }
+        else
+        {
+          m_pipeline->getStatistics(m_stats);
+        }
+
+        dispatch(m_stats);
+
+        if (m_stats.dropped > 0)
+          war(DTR("dropped %u of %u frames"), m_stats.dropped, m_stats.captured);
       }
 
       void
       task(void)
       {
-        m_video->frameCapture();
-        m_jpeg.compress(m_video->frameData(), m_args.jpeg_quality);
+        int buffer = m_video->acquireFrame(1.0);
+        if (buffer >= 0)
+        {
+          double tstamp = Clock::getSinceEpoch();
+
+          // Gaps in the sequence are frames the driver had no buffer for.
+          uint32_t sequence = m_video->getBufferSequence(buffer);
+          unsigned gap = (!m_first && sequence - m_sequence > 1) ? sequence - m_sequence - 1 : 0;
+          m_sequence = sequence;
+          m_first = false;
+
+          if (m_encoder != NULL)
+          {
+            m_enc_stats.captured += gap;
+            m_enc_stats.dropped += gap;
+            encode(buffer, tstamp);
+          }
+          else
+          {
+            if (gap > 0)
+              m_pipeline->countDropped(gap);
+            m_pipeline->submit(*m_video, buffer, tstamp, m_args.jpeg_quality);
+          }
+        }
 
-        const char* img = (const char*)(m_jpeg.imageData());
-        m_frame.data.assign(img, img + m_jpeg.imageSize());
-        m_frame.frameid = getRunCount() % 255;
-        dispatch(m_frame);
+        reportStatistics();
       }
     };
   }
@@ -0,0 +1,304 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef VISION_SONAR_MOSAIC_BITMAP_HPP_INCLUDED_
+#define VISION_SONAR_MOSAIC_BITMAP_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+#if defined(DUNE_SYS_HAS_SYS_MMAN_H)
+#  include <sys/mman.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_FCNTL_H)
+#  include <fcntl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+namespace Vision
+{
+  namespace SonarMosaic
+  {
+    using DUNE_NAMESPACES;
+
+    //! Size of the file and information headers.
+    static const unsigned c_bmp_header_size = 54;
+    //! Size of the palette.
+    static const unsigned c_bmp_palette_size = 256 * 4;
+
+    //! 8-bit palettized BMP image kept in a file. Browsers display
+    //! BMP files natively and their pixels live uncompressed at a
+    //! fixed offset, so the file is memory-mapped and pixels are
+    //! written in place; readers of the file see updates once the
+    //! mapping is flushed. Rows are stored top-down and pixel value
+    //! zero is reserved for "no data".
+    class Bitmap
+    {
+    public:
+      //! Open an image, creating it if it does not exist or does not
+      //! have the expected dimensions.
+      //! @param[in] path image file.
+      //! @param[in] width image width (pixels).
+      //! @param[in] height image height (pixels).
+      Bitmap(const Path& path, unsigned width, unsigned height):
+        m_path(path),
+        m_width(width),
+        m_height(height),
+        m_stride((width + 3) & ~3u),
+        m_map(NULL),
+        m_dirty(false)
+      {
+        m_size = c_bmp_header_size + c_bmp_palette_size + m_stride * m_height;
+
+        std::vector<uint8_t> header;
+        createHeader(header);
+
+        bool valid = (path.size() == (int64_t)m_size) && checkHeader(header);
+
+#if defined(DUNE_SYS_HAS_MMAP)
+        int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd >= 0)
+        {
+          if (!valid && ftruncate(fd, 0) == 0 && ftruncate(fd, m_size) == 0)
+          {
+            if (pwrite(fd, &header[0], header.size(), 0) == (ssize_t)header.size())
+              valid = true;
+          }
+
+          if (valid)
+          {
+            void* ptr = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (ptr != MAP_FAILED)
+              m_map = (uint8_t*)ptr;
+          }
+
+          close(fd);
+        }
+#endif
+
+        if (m_map != NULL)
+          return;
+
+        // Without memory mapping the image is kept in memory and
+        // rewritten on flush.
+        m_data.assign(m_size, 0);
+        if (valid)
+        {
+          std::ifstream ifs(path.c_str(), std::ios::binary);
+          ifs.read((char*)&m_data[0], m_size);
+        }
+
+        std::memcpy(&m_data[0], &header[0], header.size());
+        m_dirty = !valid;
+      }
+
+      //! Destructor.
+      ~Bitmap(void)
+      {
+        flush();
+
+#if defined(DUNE_SYS_HAS_MMAP)
+        if (m_map != NULL)
+          munmap(m_map, m_size);
+#endif
+      }
+
+      //! Get image width.
+      //! @return width (pixels).
+      unsigned
+      getWidth(void) const
+      {
+        return m_width;
+      }
+
+      //! Get image height.
+      //! @return height (pixels).
+      unsigned
+      getHeight(void) const
+      {
+        return m_height;
+      }
+
+      //! Get pixels of one row.
+      //! @param[in] y row index, top to bottom.
+      //! @return row pixels.
+      uint8_t*
+      row(unsigned y)
+      {
+        m_dirty = true;
+        return getPixels() + y * m_stride;
+      }
+
+      //! Set one pixel.
+      //! @param[in] x column index.
+      //! @param[in] y row index, top to bottom.
+      //! @param[in] value pixel value.
+      void
+      set(unsigned x, unsigned y, uint8_t value)
+      {
+        m_dirty = true;
+        getPixels()[y * m_stride + x] = value;
+      }
+
+      //! Get one pixel.
+      //! @param[in] x column index.
+      //! @param[in] y row index, top to bottom.
+      //! @return pixel value.
+      uint8_t
+      get(unsigned x, unsigned y) const
+      {
+        return getPixels()[y * m_stride + x];
+      }
+
+      //! Move all rows down, discarding the last ones and clearing
+      //! the first ones.
+      //! @param[in] rows number of rows.
+      void
+      scroll(unsigned rows)
+      {
+        rows = std::min(rows, m_height);
+        uint8_t* pixels = getPixels();
+        std::memmove(pixels + rows * m_stride, pixels, (m_height - rows) * m_stride);
+        std::memset(pixels, 0, rows * m_stride);
+        m_dirty = true;
+      }
+
+      //! Write pending changes to the file.
+      void
+      flush(void)
+      {
+        if (!m_dirty)
+          return;
+
+#if defined(DUNE_SYS_HAS_MMAP)
+        if (m_map != NULL)
+        {
+          msync(m_map, m_size, MS_ASYNC);
+          m_dirty = false;
+          return;
+        }
+#endif
+
+        std::ofstream ofs(m_path.c_str(), std::ios::binary | std::ios::trunc);
+        ofs.write((const char*)&m_data[0], m_size);
+        m_dirty = false;
+      }
+
+    private:
+      //! Image file.
+      Path m_path;
+      //! Image width.
+      unsigned m_width;
+      //! Image height.
+      unsigned m_height;
+      //! Bytes per row.
+      unsigned m_stride;
+      //! File size.
+      size_t m_size;
+      //! Memory-mapped file.
+      uint8_t* m_map;
+      //! In-memory file, when memory mapping is not available.
+      std::vector<uint8_t> m_data;
+      //! True if there are changes not flushed.
+      bool m_dirty;
+
+      uint8_t*
+      getPixels(void)
+      {
+        uint8_t* base = (m_map != NULL) ? m_map : &m_data[0];
+        return base + c_bmp_header_size + c_bmp_palette_size;
+      }
+
+      const uint8_t*
+      getPixels(void) const
+      {
+        const uint8_t* base = (m_map != NULL) ? m_map : &m_data[0];
+        return base + c_bmp_header_size + c_bmp_palette_size;
+      }
+
+      //! Build file header, information header and palette.
+      //! @param[out] hdr header bytes.
+      void
+      createHeader(std::vector<uint8_t>& hdr) const
+      {
+        hdr.assign(c_bmp_header_size + c_bmp_palette_size, 0);
+        uint8_t* p = &hdr[0];
+
+        // File header.
+        p[0] = 'B';
+        p[1] = 'M';
+        ByteCopy::toLE((uint32_t)m_size, p + 2);
+        ByteCopy::toLE((uint32_t)(c_bmp_header_size + c_bmp_palette_size), p + 10);
+
+        // Information header (negative height means top-down rows).
+        ByteCopy::toLE((uint32_t)40, p + 14);
+        ByteCopy::toLE((int32_t)m_width, p + 18);
+        ByteCopy::toLE(-(int32_t)m_height, p + 22);
+        ByteCopy::toLE((uint16_t)1, p + 26);
+        ByteCopy::toLE((uint16_t)8, p + 28);
+        ByteCopy::toLE((uint32_t)(m_stride * m_height), p + 34);
+        ByteCopy::toLE((uint32_t)256, p + 46);
+
+        // Amber palette, the usual sidescan colouring.
+        for (unsigned i = 0; i < 256; ++i)
+        {
+          uint8_t* e = p + c_bmp_header_size + i * 4;
+          e[0] = (uint8_t)(i * 2 / 5);
+          e[1] = (uint8_t)(i * 4 / 5);
+          e[2] = (uint8_t)i;
+        }
+      }
+
+      //! Check if the file starts with a given header.
+      //! @param[in] hdr expected header.
+      //! @return true if headers match, false otherwise.
+      bool
+      checkHeader(const std::vector<uint8_t>& hdr) const
+      {
+        std::vector<uint8_t> bfr(hdr.size());
+        std::ifstream ifs(m_path.c_str(), std::ios::binary);
+        if (!ifs.read((char*)&bfr[0], bfr.size()))
+          return false;
+
+        return bfr == hdr;
+      }
+    };
+  }
+}
+
+#endif
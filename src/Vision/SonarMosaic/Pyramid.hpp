@@ -0,0 +1,235 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+#ifndef VISION_SONAR_MOSAIC_PYRAMID_HPP_INCLUDED_
+#define VISION_SONAR_MOSAIC_PYRAMID_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <list>
+#include <map>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Bitmap.hpp"
+
+namespace Vision
+{
+  namespace SonarMosaic
+  {
+    using DUNE_NAMESPACES;
+
+    //! Mosaic tile pyramid. Level zero has the finest resolution
+    //! and each following level halves it. Tiles are square images,
+    //! north up, stored as '<level>/<column>_<row>.bmp' where tile
+    //! (0, 0) of every level has its top left corner at the origin
+    //! of the mosaic. Points are written to all levels as they
+    //! arrive, so every level is always up to date. A bounded number
+    //! of tiles is kept open, the least recently used being closed
+    //! first.
+    class Pyramid
+    {
+    public:
+      //! Constructor.
+      //! @param[in] dir output directory.
+      //! @param[in] resolution size of a level zero pixel (m).
+      //! @param[in] levels number of levels.
+      //! @param[in] tile tile size (pixels).
+      //! @param[in] cache maximum number of open tiles.
+      Pyramid(const Path& dir, double resolution, unsigned levels, unsigned tile, unsigned cache):
+        m_dir(dir),
+        m_levels(std::max(levels, 1u)),
+        m_tile(tile),
+        m_cache(std::max(cache, m_levels)),
+        m_last(NULL)
+      {
+        for (unsigned i = 0; i < m_levels; ++i)
+        {
+          m_scale.push_back(1.0 / (resolution * (1 << i)));
+          (m_dir / String::str(i)).create();
+        }
+      }
+
+      //! Destructor.
+      ~Pyramid(void)
+      {
+        TileMap::iterator itr = m_tiles.begin();
+        for (; itr != m_tiles.end(); ++itr)
+          delete itr->second.bitmap;
+      }
+
+      //! Draw points in all levels.
+      //! @param[in] x north offsets from the origin (m).
+      //! @param[in] y east offsets from the origin (m).
+      //! @param[in] v pixel values (zero is promoted to one).
+      //! @param[in] count number of points.
+      void
+      draw(const double* x, const double* y, const uint8_t* v, unsigned count)
+      {
+        for (unsigned level = 0; level < m_levels; ++level)
+        {
+          double scale = m_scale[level];
+          m_last = NULL;
+
+          for (unsigned i = 0; i < count; ++i)
+          {
+            int px = (int)std::floor(y[i] * scale);
+            int py = (int)std::floor(-x[i] * scale);
+            Key key(level, floorDiv(px), floorDiv(py));
+
+            Bitmap* bmp = (m_last != NULL && key == m_last_key) ? m_last : getTile(key);
+            bmp->set(px - key.x * (int)m_tile, py - key.y * (int)m_tile, std::max(v[i], (uint8_t)1));
+          }
+        }
+      }
+
+      //! Flush all open tiles.
+      void
+      flush(void)
+      {
+        TileMap::iterator itr = m_tiles.begin();
+        for (; itr != m_tiles.end(); ++itr)
+          itr->second.bitmap->flush();
+      }
+
+      //! Get number of open tiles.
+      //! @return number of tiles.
+      unsigned
+      getOpenTiles(void) const
+      {
+        return m_tiles.size();
+      }
+
+    private:
+      //! Tile identifier.
+      struct Key
+      {
+        int level;
+        int x;
+        int y;
+
+        Key(int l = 0, int tx = 0, int ty = 0):
+          level(l), x(tx), y(ty)
+        { }
+
+        bool
+        operator<(const Key& other) const
+        {
+          if (level != other.level)
+            return level < other.level;
+          if (x != other.x)
+            return x < other.x;
+          return y < other.y;
+        }
+
+        bool
+        operator==(const Key& other) const
+        {
+          return level == other.level && x == other.x && y == other.y;
+        }
+      };
+
+      //! Open tile.
+      struct Entry
+      {
+        //! Tile image.
+        Bitmap* bitmap;
+        //! Position in the usage list.
+        std::list<Key>::iterator usage;
+      };
+
+      typedef std::map<Key, Entry> TileMap;
+
+      //! Output directory.
+      Path m_dir;
+      //! Number of levels.
+      unsigned m_levels;
+      //! Tile size.
+      unsigned m_tile;
+      //! Maximum number of open tiles.
+      unsigned m_cache;
+      //! Pixels per meter of each level.
+      std::vector<double> m_scale;
+      //! Open tiles.
+      TileMap m_tiles;
+      //! Open tiles, most recently used first.
+      std::list<Key> m_usage;
+      //! Last tile used.
+      Bitmap* m_last;
+      //! Identifier of last tile used.
+      Key m_last_key;
+
+      //! Get index of the tile containing a pixel.
+      //! @param[in] p pixel index.
+      //! @return tile index.
+      int
+      floorDiv(int p) const
+      {
+        int t = (int)m_tile;
+        return (p >= 0) ? (p / t) : -((-p + t - 1) / t);
+      }
+
+      //! Get a tile, opening it if needed.
+      //! @param[in] key tile identifier.
+      //! @return tile image.
+      Bitmap*
+      getTile(const Key& key)
+      {
+        TileMap::iterator itr = m_tiles.find(key);
+        if (itr != m_tiles.end())
+        {
+          m_usage.splice(m_usage.begin(), m_usage, itr->second.usage);
+        }
+        else
+        {
+          if (m_tiles.size() >= m_cache)
+          {
+            TileMap::iterator old = m_tiles.find(m_usage.back());
+            delete old->second.bitmap;
+            m_tiles.erase(old);
+            m_usage.pop_back();
+          }
+
+          Path file = m_dir / String::str(key.level) / String::str("%d_%d.bmp", key.x, key.y);
+          Entry entry;
+          entry.bitmap = new Bitmap(file, m_tile, m_tile);
+          m_usage.push_front(key);
+          entry.usage = m_usage.begin();
+          itr = m_tiles.insert(std::make_pair(key, entry)).first;
+        }
+
+        m_last = itr->second.bitmap;
+        m_last_key = key;
+        return m_last;
+      }
+    };
+  }
+}
+
+#endif
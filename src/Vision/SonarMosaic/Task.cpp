@@ -0,0 +1,452 @@
+//***************************************************************************
+// Copyright 2007-2014 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Universidade do Porto. For licensing   *
+// terms, conditions, and further information contact lsts@fe.up.pt.        *
+//                                                                          *
+// European Union Public Licence - EUPL v.1.1 Usage                         *
+// Alternatively, this file may be used under the terms of the EUPL,        *
+// Version 1.1 only (the "Licence"), appearing in the file LICENCE.md       *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://www.lsts.pt/dune/licence.                                        *
+//***************************************************************************
+// Author: Ricardo Martins                                                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Bitmap.hpp"
+#include "Pyramid.hpp"
+
+namespace Vision
+{
+  //! Onboard sonar preview products.
+  //!
+  //! This task consumes SonarData pings and incrementally builds a
+  //! waterfall image and a georeferenced mosaic tile pyramid of
+  //! sidescan data in the 'products' folder of the log directory,
+  //! which the HTTP transport serves under '/dune/products/'. Each
+  //! ping is converted to 8-bit intensities and projected on the
+  //! seafloor once, using the last navigation state, and written
+  //! directly into memory-mapped BMP tiles.
+  //!
+  //! The mosaic origin and geometry are described in 'index.js'.
+  //!
+  //! @author Ricardo Martins
+  namespace SonarMosaic
+  {
+    using DUNE_NAMESPACES;
+
+    //! Maximum age of the navigation state used to project pings.
+    static const double c_max_state_age = 1.0;
+
+    struct Arguments
+    {
+      //! Entity label of the sonar.
+      std::string elabel;
+      //! Output folder.
+      std::string folder;
+      //! Mosaic resolution.
+      double resolution;
+      //! Number of mosaic levels.
+      unsigned levels;
+      //! Tile size.
+      unsigned tile;
+      //! Maximum number of open tiles.
+      unsigned cache;
+      //! Waterfall width.
+      unsigned wf_width;
+      //! Waterfall height.
+      unsigned wf_height;
+      //! Flush period.
+      double flush_period;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Sonar entity id.
+      int m_sonar_eid;
+      //! Output directory.
+      Path m_dir;
+      //! Mosaic tile pyramid.
+      std::auto_ptr<Pyramid> m_mosaic;
+      //! Waterfall image.
+      std::auto_ptr<Bitmap> m_waterfall;
+      //! Last navigation state.
+      IMC::EstimatedState m_estate;
+      //! Time of last navigation state.
+      double m_estate_time;
+      //! Mosaic origin latitude (rad).
+      double m_lat;
+      //! Mosaic origin longitude (rad).
+      double m_lon;
+      //! Number of pings in the mosaic.
+      unsigned m_pings;
+      //! Intensities of the current ping.
+      std::vector<uint8_t> m_pixels;
+      //! North offsets of the current ping samples.
+      std::vector<double> m_x;
+      //! East offsets of the current ping samples.
+      std::vector<double> m_y;
+      //! Intensities of the current ping samples on the seafloor.
+      std::vector<uint8_t> m_v;
+      //! Intensity table of 16-bit samples.
+      std::vector<uint8_t> m_lut;
+      //! Flush timer.
+      Counter<double> m_flush_timer;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_sonar_eid(-1),
+        m_estate_time(-1.0),
+        m_pings(0)
+      {
+        param("Entity Label - Sonar", m_args.elabel)
+        .defaultValue("")
+        .description("Entity label of the sonar, all sonars if empty");
+
+        param("Output Folder", m_args.folder)
+        .defaultValue("sonar")
+        .description("Output folder, relative to the products folder of the log directory");
+
+        param("Mosaic Resolution", m_args.resolution)
+        .defaultValue("0.25")
+        .minimumValue("0.01")
+        .units(Units::Meter)
+        .description("Pixel size of the finest mosaic level");
+
+        param("Mosaic Levels", m_args.levels)
+        .defaultValue("5")
+        .minimumValue("1")
+        .maximumValue("16")
+        .description("Number of mosaic levels, each halving the resolution");
+
+        param("Tile Size", m_args.tile)
+        .defaultValue("256")
+        .minimumValue("16")
+        .units(Units::Pixel)
+        .description("Width and height of mosaic tiles");
+
+        param("Open Tiles", m_args.cache)
+        .defaultValue("64")
+        .description("Maximum number of mosaic tiles kept open");
+
+        param("Waterfall Width", m_args.wf_width)
+        .defaultValue("512")
+        .minimumValue("16")
+        .units(Units::Pixel)
+        .description("Width of the waterfall image");
+
+        param("Waterfall Height", m_args.wf_height)
+        .defaultValue("512")
+        .minimumValue("16")
+        .units(Units::Pixel)
+        .description("Number of pings in the waterfall image");
+
+        param("Flush Period", m_args.flush_period)
+        .defaultValue("2.0")
+        .units(Units::Second)
+        .description("Period of updates of the products on disk");
+
+        bind<IMC::EstimatedState>(this);
+        bind<IMC::SonarData>(this);
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_flush_timer.setTop(m_args.flush_period);
+      }
+
+      void
+      onEntityResolution(void)
+      {
+        m_sonar_eid = -1;
+        if (m_args.elabel.empty())
+          return;
+
+        try
+        {
+          m_sonar_eid = resolveEntity(m_args.elabel);
+        }
+        catch (...)
+        {
+          war(DTR("sonar entity '%s' not found, using all sonars"), m_args.elabel.c_str());
+        }
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_dir = m_ctx.dir_log / "products" / m_args.folder;
+        m_dir.create();
+
+        m_waterfall.reset(new Bitmap(m_dir / "waterfall.bmp", m_args.wf_width, m_args.wf_height));
+
+        m_lut.resize(65536);
+        double k = 255.0 / std::log(65536.0);
+        for (unsigned i = 0; i < m_lut.size(); ++i)
+          m_lut[i] = (uint8_t)(std::log(1.0 + i) * k);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        m_mosaic.reset();
+        m_waterfall.reset();
+      }
+
+      void
+      consume(const IMC::EstimatedState* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        m_estate = *msg;
+        m_estate_time = Clock::get();
+      }
+
+      void
+      consume(const IMC::SonarData* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (m_sonar_eid >= 0 && (int)msg->getSourceEntity() != m_sonar_eid)
+          return;
+
+        if (msg->type == IMC::SonarData::ST_MULTIBEAM)
+          return;
+
+        if (!convert(*msg))
+          return;
+
+        updateWaterfall();
+
+        if (msg->type == IMC::SonarData::ST_SIDESCAN)
+          updateMosaic(*msg);
+      }
+
+      //! Convert ping samples to 8-bit intensities, on a logarithmic
+      //! scale of the full range of the samples.
+      //! @param[in] msg sonar data.
+      //! @return true if ping has samples, false otherwise.
+      bool
+      convert(const IMC::SonarData& msg)
+      {
+        unsigned bytes = msg.bits_per_point / 8;
+        if (bytes != 1 && bytes != 2 && bytes != 4)
+          return false;
+
+        unsigned count = msg.data.size() / bytes;
+        if (count == 0)
+          return false;
+
+        m_pixels.resize(count);
+        const uint8_t* data = (const uint8_t*)&msg.data[0];
+
+        if (bytes == 1)
+        {
+          for (unsigned i = 0; i < count; ++i)
+            m_pixels[i] = m_lut[(unsigned)data[i] * 257];
+        }
+        else if (bytes == 2)
+        {
+          for (unsigned i = 0; i < count; ++i)
+          {
+            uint16_t value = 0;
+            ByteCopy::fromLE(value, data + i * 2);
+            m_pixels[i] = m_lut[value];
+          }
+        }
+        else
+        {
+          double k = 255.0 / std::log(4294967296.0);
+          for (unsigned i = 0; i < count; ++i)
+          {
+            uint32_t value = 0;
+            ByteCopy::fromLE(value, data + i * 4);
+            m_pixels[i] = (uint8_t)(std::log(1.0 + value) * k);
+          }
+        }
+
+        return true;
+      }
+
+      //! Add the current ping to the top of the waterfall.
+      void
+      updateWaterfall(void)
+      {
+        m_waterfall->scroll(1);
+
+        uint8_t* row = m_waterfall->row(0);
+        unsigned width = m_waterfall->getWidth();
+        unsigned count = m_pixels.size();
+
+        for (unsigned i = 0; i < width; ++i)
+        {
+          unsigned beg = i * count / width;
+          unsigned end = std::max(beg + 1, (i + 1) * count / width);
+          uint8_t peak = 0;
+          for (unsigned j = beg; j < end; ++j)
+            peak = std::max(peak, m_pixels[j]);
+          row[i] = peak;
+        }
+      }
+
+      //! Project the current sidescan ping on the seafloor and draw
+      //! it in the mosaic. Port samples come first, far to near,
+      //! followed by starboard samples, near to far.
+      //! @param[in] msg sonar data.
+      void
+      updateMosaic(const IMC::SonarData& msg)
+      {
+        if (m_estate_time < 0 || Clock::get() - m_estate_time > c_max_state_age)
+          return;
+
+        double lat = 0;
+        double lon = 0;
+        Coordinates::toWGS84(m_estate, lat, lon);
+
+        if (m_mosaic.get() == NULL)
+          createMosaic(lat, lon);
+
+        double n = 0;
+        double e = 0;
+        WGS84::displacement(m_lat, m_lon, 0.0, lat, lon, 0.0, &n, &e);
+
+        unsigned half = m_pixels.size() / 2;
+        if (half == 0)
+          return;
+
+        double alt = (m_estate.alt > 0) ? m_estate.alt : 0.0;
+        double span = msg.max_range - msg.min_range;
+        double port_n = std::cos(m_estate.psi - c_half_pi);
+        double port_e = std::sin(m_estate.psi - c_half_pi);
+
+        m_x.resize(half * 2);
+        m_y.resize(half * 2);
+        m_v.resize(half * 2);
+        unsigned count = 0;
+
+        for (unsigned i = 0; i < half; ++i)
+        {
+          // Slant range and ground range of sample i of each side.
+          double slant = msg.min_range + span * (i + 0.5) / half;
+          if (slant <= alt)
+            continue;
+
+          double ground = std::sqrt(slant * slant - alt * alt);
+
+          m_x[count] = n + ground * port_n;
+          m_y[count] = e + ground * port_e;
+          m_v[count] = m_pixels[half - 1 - i];
+          ++count;
+
+          m_x[count] = n - ground * port_n;
+          m_y[count] = e - ground * port_e;
+          m_v[count] = m_pixels[half + i];
+          ++count;
+        }
+
+        m_mosaic->draw(&m_x[0], &m_y[0], &m_v[0], count);
+        ++m_pings;
+      }
+
+      //! Create the mosaic with its origin at a given location.
+      //! @param[in] lat origin latitude (rad).
+      //! @param[in] lon origin longitude (rad).
+      void
+      createMosaic(double lat, double lon)
+      {
+        m_lat = lat;
+        m_lon = lon;
+        m_pings = 0;
+
+        Path dir = m_dir / "mosaic";
+        if (dir.exists())
+          dir.remove(Path::MODE_RECURSIVE);
+
+        m_mosaic.reset(new Pyramid(dir, m_args.resolution, m_args.levels,
+                                   m_args.tile, m_args.cache));
+        writeIndex();
+
+        inf(DTR("mosaic origin at %0.6f, %0.6f"),
+            Angles::degrees(lat), Angles::degrees(lon));
+      }
+
+      //! Write mosaic description.
+      void
+      writeIndex(void)
+      {
+        Path file = m_dir / "index.js";
+        std::ofstream ofs(file.c_str(), std::ios::trunc);
+        ofs << "{\n"
+            << "  \"origin\": {\"lat\": " << String::str("%0.8f", Angles::degrees(m_lat))
+            << ", \"lon\": " << String::str("%0.8f", Angles::degrees(m_lon)) << "},\n"
+            << "  \"resolution\": " << m_args.resolution << ",\n"
+            << "  \"levels\": " << m_args.levels << ",\n"
+            << "  \"tile\": " << m_args.tile << ",\n"
+            << "  \"pings\": " << m_pings << ",\n"
+            << "  \"waterfall\": \"waterfall.bmp\",\n"
+            << "  \"tiles\": \"mosaic/{level}/{x}_{y}.bmp\"\n"
+            << "}\n";
+      }
+
+      //! Write pending changes of all products.
+      void
+      flush(void)
+      {
+        if (m_waterfall.get() != NULL)
+          m_waterfall->flush();
+
+        if (m_mosaic.get() != NULL)
+        {
+          m_mosaic->flush();
+          writeIndex();
+        }
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(0.5);
+
+          if (m_flush_timer.overflow())
+          {
+            flush();
+            m_flush_timer.reset();
+          }
+        }
+
+        flush();
+      }
+    };
+  }
+}
+
+DUNE_TASK